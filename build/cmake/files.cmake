@@ -390,6 +390,7 @@ set(OPENGL_QT_SRC
 )
 
 set(BASE_CMN_SRC
+    src/common/alloctrack.cpp
     src/common/any.cpp
     src/common/appbase.cpp
     src/common/arcall.cpp
@@ -440,6 +441,7 @@ set(BASE_CMN_SRC
     src/common/platinfo.cpp
     src/common/powercmn.cpp
     src/common/process.cpp
+    src/common/profiler.cpp
     src/common/regex.cpp
     src/common/secretstore.cpp
     src/common/stdpbase.cpp
@@ -457,6 +459,7 @@ set(BASE_CMN_SRC
     src/common/textbuf.cpp
     src/common/textfile.cpp
     src/common/threadinfo.cpp
+    src/common/threadpool.cpp
     src/common/time.cpp
     src/common/timercmn.cpp
     src/common/timerimpl.cpp
@@ -490,6 +493,7 @@ set(BASE_AND_GUI_CMN_SRC
 
 set(BASE_CMN_HDR
     wx/afterstd.h
+    wx/alloctrack.h
     wx/any.h
     wx/anystr.h
     wx/app.h
@@ -575,10 +579,12 @@ set(BASE_CMN_HDR
     wx/mstream.h
     wx/numformatter.h
     wx/object.h
+    wx/opctx.h
     wx/platform.h
     wx/platinfo.h
     wx/power.h
     wx/process.h
+    wx/profiler.h
     wx/ptr_scpd.h
     wx/ptr_shrd.h
     wx/recguard.h
@@ -608,6 +614,7 @@ set(BASE_CMN_HDR
     wx/textbuf.h
     wx/textfile.h
     wx/thread.h
+    wx/threadpool.h
     wx/thrimpl.cpp
     wx/time.h
     wx/timer.h
@@ -0,0 +1,124 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/alloctrack.h
+// Purpose:     Production-safe per-subsystem allocation tracking
+// Author:      wxWidgets team
+// Created:     2022-04-10
+// Copyright:   (c) 2022 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_ALLOCTRACK_H_
+#define _WX_ALLOCTRACK_H_
+
+#include "wx/defs.h"
+#include "wx/longlong.h"
+#include "wx/arrstr.h"
+
+// ----------------------------------------------------------------------------
+// constants
+// ----------------------------------------------------------------------------
+
+// The subsystems whose allocations can be tracked.
+enum wxAllocTag
+{
+    wxALLOC_TAG_STRINGS,    // wxString character buffers
+    wxALLOC_TAG_EVENTS,     // dynamically allocated wxEvent objects
+    wxALLOC_TAG_IMAGES,     // wxImage pixel and alpha buffers
+    wxALLOC_TAG_SIZERS,     // wxSizerItem objects
+    wxALLOC_TAG_OTHER,      // anything else, usable by application code
+
+    wxALLOC_TAG_MAX
+};
+
+// ----------------------------------------------------------------------------
+// wxAllocationStats: counters for a single subsystem tag
+// ----------------------------------------------------------------------------
+
+struct wxAllocationStats
+{
+    wxAllocationStats()
+    {
+        allocCount =
+        freeCount = 0;
+    }
+
+    // numbers of tracked allocations and deallocations
+    unsigned long allocCount,
+                  freeCount;
+
+    // total bytes allocated and freed since tracking was enabled
+    wxULongLong allocBytes,
+                freedBytes;
+
+    // highest value reached by GetCurrentBytes() so far
+    wxULongLong peakBytes;
+
+    // bytes currently allocated and not yet freed
+    wxULongLong GetCurrentBytes() const
+    {
+        // frees of the blocks allocated before tracking was enabled can make
+        // the balance negative, clamp it to 0 in this case
+        return freedBytes < allocBytes ? allocBytes - freedBytes
+                                       : wxULongLong(0);
+    }
+};
+
+// ----------------------------------------------------------------------------
+// wxAllocationTracker: counts the allocations made by wx subsystems
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxAllocationTracker
+{
+public:
+    // start or stop counting: unlike wxDebugContext this works in release
+    // builds too, the instrumented allocation paths just check a flag when
+    // tracking is disabled
+    static void Enable(bool enable = true) { ms_enabled = enable; }
+    static bool IsEnabled() { return ms_enabled; }
+
+    // reset all the counters and discard the sampled call stacks
+    static void Reset();
+
+    // return the counters collected so far for the given subsystem
+    static wxAllocationStats GetStats(wxAllocTag tag);
+
+    // return a short human-readable name of the given tag, e.g. "strings"
+    static wxString GetTagName(wxAllocTag tag);
+
+    // capture the call stack of every interval-th tracked allocation and
+    // keep the most recent captures for each tag; 0, the default, disables
+    // the capture entirely
+    //
+    // this only does something if wxUSE_STACKWALKER==1
+    static void SetStackSampleInterval(unsigned long interval);
+
+    // return the call stacks sampled for the given tag so far, the most
+    // recent one last
+    static wxArrayString GetSampledStacks(wxAllocTag tag);
+
+    // record one allocation or deallocation: called from the instrumented
+    // allocation paths inside wx, but may also be used by the application
+    // for its own allocations, typically with wxALLOC_TAG_OTHER
+    static void OnAlloc(wxAllocTag tag, size_t size)
+    {
+        if ( ms_enabled )
+            DoRecordAlloc(tag, size);
+    }
+
+    static void OnFree(wxAllocTag tag, size_t size)
+    {
+        if ( ms_enabled )
+            DoRecordFree(tag, size);
+    }
+
+private:
+    static void DoRecordAlloc(wxAllocTag tag, size_t size);
+    static void DoRecordFree(wxAllocTag tag, size_t size);
+
+    static bool ms_enabled;
+
+    // this class has static methods only
+    wxAllocationTracker();
+};
+
+#endif // _WX_ALLOCTRACK_H_
@@ -17,6 +17,8 @@
 #include "wx/image.h"
 #include "wx/animdecod.h"
 #include "wx/dynarray.h"
+#include "wx/buffer.h"
+#include "wx/vector.h"
 
 
 class /*WXDLLIMPEXP_CORE*/ wxANIFrameInfo;      // private implementation detail
@@ -59,13 +61,26 @@ protected:
             // modifies current stream position (see wxAnimationDecoder::CanRead)
 
 private:
-    // frames stored as wxImage(s): ANI files are meant to be used mostly for animated
-    // cursors and thus they do not use any optimization to encode differences between
-    // two frames: they are just a list of images to display sequentially.
-    wxImageArray m_images;
-
-    // the info about each image stored in m_images.
-    // NB: m_info.GetCount() may differ from m_images.GetCount()!
+    // return the given icon, decoding it from m_iconData first if needed and
+    // evicting the least recently used icon when the cache is full
+    const wxImage& GetIcon(unsigned int idx) const;
+
+    // the raw contents of the "icon" chunks of the file: ANI files are meant
+    // to be used mostly for animated cursors and thus they do not use any
+    // optimization to encode differences between two frames, they are just a
+    // list of icons to display sequentially, decoded on demand into m_images.
+    wxVector<wxMemoryBuffer> m_iconData;
+
+    // cache of decoded icons, using the same indices as m_iconData; mutable
+    // because decoding happens on demand from the const accessors
+    mutable wxImageArray m_images;
+
+    // indices of the currently decoded icons, in LRU order (the most
+    // recently used one is at the back)
+    mutable wxVector<unsigned int> m_iconLRU;
+
+    // the info about each frame of the animation.
+    // NB: m_info.GetCount() may differ from m_iconData.size()!
     wxANIFrameInfoArray m_info;
 
     // this is the wxCURHandler used to load the ICON chunk of the ANI files
@@ -386,6 +386,18 @@ public:
     // return true if the object is scheduled for destruction
     bool IsScheduledForDestruction(wxObject *object) const;
 
+    // Specify how much time, in milliseconds, ProcessIdle() may spend
+    // destroying the objects scheduled for destruction during a single event
+    // loop pass: when the budget is exhausted the remaining objects are
+    // destroyed during the following passes instead, keeping the UI
+    // responsive during mass teardown. The default value of 0 means no
+    // limit, i.e. all pending objects are destroyed at once.
+    static void SetPendingDeleteBudget(long milliseconds)
+        { ms_pendingDeleteBudget = milliseconds; }
+
+    // Returns the pending object destruction budget
+    static long GetPendingDeleteBudget() { return ms_pendingDeleteBudget; }
+
 
     // wxEventLoop-related methods
     // ---------------------------
@@ -482,10 +494,19 @@ protected:
     // called from ProcessPendingEvents()
     void DeletePendingObjects();
 
+    // delete the objects in wxPendingDelete list for at most the given number
+    // of milliseconds (0 means no limit) and return true if any objects
+    // remain in it, i.e. if another call is needed to finish the job
+    bool DoDeletePendingObjects(long budget);
+
     // the function which creates the traits object when GetTraits() needs it
     // for the first time
     virtual wxAppTraits *CreateTraits();
 
+    // time, in ms, that ProcessIdle() may spend destroying pending objects
+    // during a single pass (0 = unlimited)
+    static long ms_pendingDeleteBudget;
+
     // function used for dynamic wxApp creation
     static wxAppInitializerFunction ms_appInitFn;
 
@@ -95,6 +95,17 @@ public:
         wxArrayStringBase::Add(string, copies);
         return size() - copies;
     }
+
+    void Shrink(bool shrinkStrings = false)
+    {
+        wxArrayStringBase::Shrink();
+
+        if ( shrinkStrings )
+        {
+            for ( size_t n = 0; n < size(); n++ )
+                (*this)[n].Shrink();
+        }
+    }
 };
 
 // Unlike all the other sorted arrays, this one uses a comparison function
@@ -136,6 +147,10 @@ public:
 
     int Index(const wxString& str, bool bCase = true, bool bFromEnd = false) const;
 
+    // add all the items at once: much faster than calling Add() for each of
+    // them as this sorts the new items and merges them in a single pass
+    void AddBulk(const wxArrayString& items);
+
 private:
     void Insert()
     {
@@ -196,8 +211,9 @@ public:
   void Clear();
     // preallocates memory for given number of items
   void Alloc(size_t nCount);
-    // minimizes the memory usage (by freeing all extra memory)
-  void Shrink();
+    // minimizes the memory usage (by freeing all extra memory), also shrinks
+    // the stored strings themselves if shrinkStrings is true
+  void Shrink(bool shrinkStrings = false);
 
   // simple accessors
     // number of elements in the array
@@ -390,6 +406,9 @@ protected:
   void Init(bool autoSort);             // common part of all ctors
   void Copy(const wxArrayString& src);  // copies the contents of another array
 
+    // implementation of wxSortedArrayString::AddBulk()
+  void DoAddBulk(const wxArrayString& items);
+
   CompareFunction m_compareFunction;    // set only from wxSortedArrayString
 
 private:
@@ -422,6 +441,10 @@ public:
   explicit wxSortedArrayString(CompareFunction compareFunction)
       : wxArrayString(true)
     { m_compareFunction = compareFunction; }
+
+    // add all the items at once: much faster than calling Add() for each of
+    // them as this sorts the new items and merges them in a single pass
+  void AddBulk(const wxArrayString& items) { DoAddBulk(items); }
 };
 
 #endif // !wxUSE_STD_CONTAINERS
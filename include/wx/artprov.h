@@ -16,6 +16,7 @@
 #include "wx/icon.h"
 #include "wx/iconbndl.h"
 #include "wx/bmpbndl.h"
+#include "wx/vector.h"
 
 class WXDLLIMPEXP_FWD_CORE wxArtProvidersList;
 class WXDLLIMPEXP_FWD_CORE wxArtProviderCache;
@@ -166,6 +167,15 @@ public:
                     const wxArtClient& client = wxASCII_STR(wxART_OTHER),
                     const wxSize& size = wxDefaultSize);
 
+    // Warm up the cache for all the given art ids at once: this is
+    // equivalent to calling GetBitmap() for each of them but allows doing
+    // all the (possibly expensive) rasterization in one batch, e.g. before
+    // rebuilding the toolbars of many windows, instead of paying for it
+    // lazily during the rebuild itself.
+    static void Prefetch(const wxVector<wxArtID>& ids,
+                         const wxArtClient& client = wxASCII_STR(wxART_OTHER),
+                         const wxSize& size = wxDefaultSize);
+
     // Query the providers for icon with given ID and return it. Return
     // wxNullIcon if no provider provides it.
     static wxIcon GetIcon(const wxArtID& id,
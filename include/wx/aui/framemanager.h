@@ -601,6 +601,12 @@ protected:
     wxRect m_lastRect;
     wxAuiDockUIPart* m_hoverButton;// button uipart being hovered over
     wxRect m_lastHint;          // last hint rectangle
+
+    // cached result of the last CalculateHintRect() call; reused while the
+    // drag stays over the same drop target, invalidated by Update()
+    wxRect m_hintCalcRect;      // in screen coordinates; empty when invalid
+    size_t m_hintCalcSig;       // signature of the layout the rect was calculated for
+
     wxPoint m_lastMouseMove;   // last mouse move position (see OnMotion)
     int  m_currentDragItem;
     bool m_hasMaximized;
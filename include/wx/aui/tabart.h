@@ -26,6 +26,7 @@
 #include "wx/pen.h"
 #include "wx/brush.h"
 #include "wx/bitmap.h"
+#include "wx/hashmap.h"
 
 
 class wxAuiNotebookPage;
@@ -115,6 +116,21 @@ public:
 };
 
 
+// A single tab pre-rendered into a bitmap, cached by
+// wxAuiGenericTabArt::DrawTab().
+
+struct WXDLLIMPEXP_AUI wxAuiTabArtCachedTab
+{
+    wxBitmap bitmap;     // the rendered tab
+    wxRect tabRect;      // tab rectangle, relative to the bitmap
+    wxRect buttonRect;   // close button rectangle, relative to the bitmap
+};
+
+WX_DECLARE_STRING_HASH_MAP_WITH_DECL(wxAuiTabArtCachedTab,
+                                     wxAuiTabArtTabCache,
+                                     class WXDLLIMPEXP_AUI);
+
+
 class WXDLLIMPEXP_AUI wxAuiGenericTabArt : public wxAuiTabArt
 {
 
@@ -193,6 +209,17 @@ public:
 
 protected:
 
+    // The tab drawing code proper, used by DrawTab() to fill its cache of
+    // pre-rendered tabs.
+    void DoDrawTab(wxDC& dc,
+                   wxWindow* wnd,
+                   const wxAuiNotebookPage& pane,
+                   const wxRect& inRect,
+                   int closeButtonState,
+                   wxRect* outTabRect,
+                   wxRect* outButtonRect,
+                   int* xExtent);
+
     wxFont m_normalFont;
     wxFont m_selectedFont;
     wxFont m_measuringFont;
@@ -213,6 +240,10 @@ protected:
     int m_fixedTabWidth;
     int m_tabCtrlHeight;
     unsigned int m_flags;
+
+    // Pre-rendered tabs, keyed by everything their rendering depends on;
+    // cleared whenever a setter changes the art's appearance.
+    wxAuiTabArtTabCache m_tabCache;
 };
 
 
@@ -118,6 +118,60 @@ wxBase64Decode(const wxString& src,
     return wxBase64Decode(src.ToAscii(), wxNO_LEN, mode, posErr);
 }
 
+// ----------------------------------------------------------------------------
+// incremental decoding
+// ----------------------------------------------------------------------------
+
+// this class allows decoding base64 chunk by chunk, without keeping the whole
+// input in memory: feed each chunk to Decode() as it arrives and check
+// IsComplete() after the last one
+class WXDLLIMPEXP_BASE wxBase64Decoder
+{
+public:
+    explicit wxBase64Decoder(wxBase64DecodeMode mode = wxBase64DecodeMode_Strict)
+    {
+        m_mode = mode;
+        Reset();
+    }
+
+    // decode the next chunk of input into the provided buffer
+    //
+    // returns the number of bytes written to dst or wxCONV_FAILED if the
+    // input is invalid or the buffer too small: as a quartet started in a
+    // previous chunk may be completed by this one, the buffer must have room
+    // for wxBase64DecodedSize(srcLen) + 3 bytes (as with wxBase64Decode(),
+    // dst may be NULL to just compute the size)
+    size_t Decode(void *dst, size_t dstLen, const char *src, size_t srcLen);
+
+    // return true if the input fed so far forms a complete base64 text and
+    // doesn't stop in the middle of a quartet
+    bool IsComplete() const { return m_n == 0 && !m_needPad; }
+
+    // the position, relative to the start of the whole input, of the
+    // character on which Decode() returned wxCONV_FAILED
+    size_t GetErrorPos() const { return m_posErr; }
+
+    // discard all state to decode another stream from the beginning
+    void Reset()
+    {
+        m_n = 0;
+        m_end =
+        m_needPad = false;
+        m_pos =
+        m_posErr = 0;
+    }
+
+private:
+    wxBase64DecodeMode m_mode;
+
+    unsigned char m_in[4];  // the current, possibly incomplete, quartet
+    int m_n;                // number of valid characters in m_in
+    bool m_end;             // true once padding has been seen
+    bool m_needPad;         // true if the next character must be '='
+    size_t m_pos;           // total characters consumed so far
+    size_t m_posErr;        // position of the invalid character, if any
+};
+
 #endif // wxUSE_BASE64
 
 #endif // _WX_BASE64_H_
@@ -92,6 +92,13 @@ public:
     static wxBitmapBundle FromFiles(const wxString& fullpathname);
     static wxBitmapBundle FromFiles(const wxString& path, const wxString& filename, const wxString& extension = wxASCII_STR("png"));
 
+    // Configure the memory budget, in bytes, of the process-wide cache of
+    // bitmaps decoded from files by FromFiles(): entries are invalidated
+    // when the file changes and evicted in LRU order when the budget is
+    // exceeded. Passing 0 disables caching. Returns the previous value.
+    static size_t SetFileCacheCapacity(size_t bytes);
+    static size_t GetFileCacheCapacity();
+
     // Create from existing implementation
     static wxBitmapBundle FromImpl(wxBitmapBundleImpl* impl);
 
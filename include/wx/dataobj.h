@@ -436,6 +436,18 @@ private:
 
     wxString m_text;
 
+    // The result of the conversion done by the last GetDataSize() call: the
+    // ports always ask for the size immediately before retrieving the data,
+    // so GetDataHere() can reuse it instead of converting the (possibly huge)
+    // text a second time. The cache is consumed by GetDataHere(), it is never
+    // kept after it to avoid returning stale data if the text changes.
+#if defined(wxNEEDS_UTF8_FOR_TEXT_DATAOBJ) || defined(wxNEEDS_UTF16_FOR_TEXT_DATAOBJ)
+    mutable wxCharBuffer m_convCache;
+    mutable wxDataFormat m_convCacheFormat;
+#else
+    mutable wxString m_translateCache;
+#endif
+
     wxDECLARE_NO_COPY_CLASS(wxTextDataObject);
 };
 
@@ -60,6 +60,7 @@ class WXDLLIMPEXP_FWD_CORE wxDataViewCtrl;
 class WXDLLIMPEXP_FWD_CORE wxDataViewColumn;
 class WXDLLIMPEXP_FWD_CORE wxDataViewRenderer;
 class WXDLLIMPEXP_FWD_CORE wxDataViewModelNotifier;
+class wxDataViewModelBatch;
 #if wxUSE_ACCESSIBILITY
 class WXDLLIMPEXP_FWD_CORE wxDataViewCtrlAccessible;
 #endif // wxUSE_ACCESSIBILITY
@@ -265,6 +266,14 @@ public:
     bool BeforeReset();
     bool AfterReset();
 
+    // The notifications above are not sent immediately inside a BeginBatch()
+    // and EndBatch() pair but queued and coalesced into as few ItemsAdded(),
+    // ItemsDeleted() and ItemsChanged() calls as possible when the outermost
+    // EndBatch() is called. Use this when making many modifications to the
+    // model at once to let the views update themselves only once at the end.
+    void BeginBatch();
+    void EndBatch();
+
 
     // delegated action
     virtual void Resort();
@@ -296,7 +305,13 @@ protected:
     }
 
 private:
+    // send all the notifications queued in the given batch
+    void SendBatchedNotifications(wxDataViewModelBatch& batch);
+
     wxDataViewModelNotifiers  m_notifiers;
+
+    // non-NULL while inside a BeginBatch()/EndBatch() pair
+    wxDataViewModelBatch *m_batch;
 };
 
 // ----------------------------------------------------------------------------
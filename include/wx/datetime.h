@@ -24,6 +24,7 @@
 #include "wx/anystr.h"
 
 class WXDLLIMPEXP_FWD_BASE wxDateTime;
+class WXDLLIMPEXP_FWD_BASE wxDateTimeFormat;
 class WXDLLIMPEXP_FWD_BASE wxTimeSpan;
 class WXDLLIMPEXP_FWD_BASE wxDateSpan;
 #ifdef __WINDOWS__
@@ -31,6 +32,7 @@ struct _SYSTEMTIME;
 #endif
 
 #include "wx/dynarray.h"
+#include "wx/vector.h"
 
 // not all c-runtimes are based on 1/1/1970 being (time_t) 0
 // set this to the corresponding value in seconds 1/1/1970 has on your
@@ -952,6 +954,21 @@ public:
         return ParseFormat(date, format, wxDefaultDateTime, end);
     }
 
+        // the same as above but using a format compiled once in advance,
+        // which is noticeably faster when parsing many strings with the same
+        // format
+    bool ParseFormat(const wxString& date,
+                     const wxDateTimeFormat& format,
+                     const wxDateTime& dateDef,
+                     wxString::const_iterator *end);
+
+    bool ParseFormat(const wxString& date,
+                     const wxDateTimeFormat& format,
+                     wxString::const_iterator *end)
+    {
+        return ParseFormat(date, format, wxDefaultDateTime, end);
+    }
+
     bool ParseFormat(const wxString& date,
                      wxString::const_iterator *end)
     {
@@ -1002,6 +1019,11 @@ public:
         // resulting text representation
     wxString Format(const wxString& format = wxASCII_STR(wxDefaultDateTimeFormat),
                     const TimeZone& tz = Local) const;
+        // the same as above but using a format compiled once in advance,
+        // which is noticeably faster when formatting many dates with the
+        // same format
+    wxString Format(const wxDateTimeFormat& format,
+                    const TimeZone& tz = Local) const;
         // preferred date representation for the current locale
     wxString FormatDate() const { return Format(wxS("%x")); }
         // preferred time representation for the current locale
@@ -1156,6 +1178,78 @@ private:
     wxLongLong m_time;
 };
 
+// ----------------------------------------------------------------------------
+// wxDateTimeFormat: a date/time format string compiled once and reusable with
+// wxDateTime::Format() and wxDateTime::ParseFormat(), avoiding re-scanning
+// the format and re-querying the locale for the month and weekday names on
+// every call. This is worthwhile when formatting or parsing many dates using
+// the same format.
+//
+// Notice that the cached locale data is filled on first use, so a single
+// object shouldn't be used from multiple threads concurrently.
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxDateTimeFormat
+{
+public:
+    wxDateTimeFormat() { Init(); }
+    explicit wxDateTimeFormat(const wxString& format) { Compile(format); }
+
+        // pre-parse the given format string, replacing the previously
+        // compiled one, if any
+    void Compile(const wxString& format);
+
+        // get the original format string
+    const wxString& GetFormat() const { return m_format; }
+
+        // return true if a non-empty format has been compiled
+    bool IsOk() const { return !m_ops.empty(); }
+
+private:
+    // only wxDateTime itself interprets the compiled representation
+    friend class wxDateTime;
+
+    // a single element of the compiled format: either a run of literal
+    // characters or a single "%" specification
+    struct Op
+    {
+        Op() : spec(0), width(0), parseable(true) { }
+
+        wxString text;      // literal text or, for a specification, the
+                            // printf() format used for the numeric fields
+        wxUniChar spec;     // the format specifier or 0 for a literal
+        size_t width;       // field width used when parsing numeric fields
+        bool parseable;     // false if the specification used printf() flags
+                            // which are not supported when parsing
+    };
+
+    void Init();
+
+    // return the (lazily filled) array of 12 localized month names or 7
+    // localized weekday names in the given form
+    const wxString* GetMonthNames(wxDateTime::NameFlags flags) const;
+    const wxString* GetWeekDayNames(wxDateTime::NameFlags flags) const;
+
+    // return the (lazily filled) localized AM/PM strings
+    void GetCachedAmPmStrings(wxString* am, wxString* pm) const;
+
+    wxString m_format;
+    wxVector<Op> m_ops;
+
+    // true if the format can be handled by strftime() directly
+    bool m_canUseStrftime;
+
+    // cached locale-dependent names, see the accessors above: the first index
+    // is 0 for the full and 1 for the abbreviated forms
+    mutable wxString m_monthNames[2][12];
+    mutable wxString m_weekDayNames[2][7];
+    mutable wxString m_amString,
+                     m_pmString;
+    mutable bool m_haveMonthNames,
+                 m_haveWeekDayNames,
+                 m_haveAmPmStrings;
+};
+
 // ----------------------------------------------------------------------------
 // This class contains a difference between 2 wxDateTime values, so it makes
 // sense to add it to wxDateTime and it is the result of subtraction of 2
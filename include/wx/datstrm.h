@@ -109,6 +109,12 @@ public:
     void ReadDouble(double *buffer, size_t size);
     void ReadFloat(float *buffer, size_t size);
 
+    // Read the given number of bytes without any conversion at all: this is
+    // the fastest way to read many fixed-layout records at once, but the
+    // caller is then entirely responsible for their format, including the
+    // byte order.
+    void ReadRaw(void *buffer, size_t size);
+
     wxDataInputStream& operator>>(wxString& s);
     wxDataInputStream& operator>>(wxInt8& c);
     wxDataInputStream& operator>>(wxInt16& i);
@@ -173,6 +179,10 @@ public:
     void WriteDouble(const double *buffer, size_t size);
     void WriteFloat(const float *buffer, size_t size);
 
+    // Write the given number of bytes without any conversion at all, see
+    // wxDataInputStream::ReadRaw().
+    void WriteRaw(const void *buffer, size_t size);
+
     wxDataOutputStream& operator<<(const wxString& string);
     wxDataOutputStream& operator<<(wxInt8 c);
     wxDataOutputStream& operator<<(wxInt16 i);
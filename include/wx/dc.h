@@ -29,6 +29,7 @@
 #include "wx/image.h"
 #include "wx/region.h"
 #include "wx/affinematrix2d.h"
+#include "wx/longlong.h"        // for wxULongLong used by wxDCStats
 
 #define wxUSE_NEW_DC 1
 
@@ -255,6 +256,92 @@ public:
 #endif
 };
 
+//-----------------------------------------------------------------------------
+// wxDCStats: counts the draw calls made through any wxDC
+//-----------------------------------------------------------------------------
+
+// The categories of draw calls counted by wxDCStats.
+enum wxDCStatsCategory
+{
+    wxDC_STATS_LINES,           // lines, points and splines
+    wxDC_STATS_RECTANGLES,      // plain and rounded rectangles
+    wxDC_STATS_ELLIPSES,        // ellipses, circles and elliptic arcs
+    wxDC_STATS_POLYGONS,        // polygons and polypolygons
+    wxDC_STATS_BITMAPS,         // bitmaps and icons
+    wxDC_STATS_TEXT,            // text drawing
+    wxDC_STATS_TEXT_EXTENTS,    // text measurement
+    wxDC_STATS_BLITS,           // Blit() and StretchBlit()
+    wxDC_STATS_CLIP_CHANGES,    // clipping region changes
+    wxDC_STATS_OTHER,           // everything else
+
+    wxDC_STATS_MAX
+};
+
+// This class counts the calls made through the drawing API of all wxDC
+// objects, allowing to see at a glance what an expensive paint handler is
+// actually doing. Counting is disabled by default and then only costs a
+// flag check per draw call.
+//
+// The counters are global and are not reset automatically: to get per-paint
+// numbers, call Reset() at the start of the paint handler and examine the
+// counters, or call DrawOverlay(), at its end.
+class WXDLLIMPEXP_CORE wxDCStats
+{
+public:
+    // start or stop counting draw calls (also resets the counters when
+    // starting)
+    static void Enable(bool enable = true);
+    static bool IsEnabled() { return ms_enabled; }
+
+    // reset all the counters
+    static void Reset();
+
+    // return the number of draw calls in the given category, or in all of
+    // them, since the last Reset()
+    static unsigned long GetCount(wxDCStatsCategory cat);
+    static unsigned long GetTotalCount();
+
+    // return the approximate number of pixels covered by the counted
+    // rectangle, bitmap and blit calls
+    static wxULongLong GetPixelsTouched();
+
+    // return a short human-readable name of the given category
+    static wxString GetCategoryName(wxDCStatsCategory cat);
+
+    // return a single line summarizing the counters, suitable for logging
+    static wxString GetSummary();
+
+    // draw the counters as a translucent frame-stats overlay: call this at
+    // the very end of a paint handler with its own DC (the overlay draw
+    // calls themselves are not counted)
+    static void DrawOverlay(wxDC& dc, const wxPoint& pos = wxPoint(4, 4));
+
+    // called from the drawing API wrappers, not meant to be used directly
+    static void OnCall(wxDCStatsCategory cat)
+    {
+        if ( ms_enabled )
+            ms_counts[cat]++;
+    }
+
+    static void OnCallArea(wxDCStatsCategory cat, wxCoord w, wxCoord h)
+    {
+        if ( ms_enabled )
+        {
+            ms_counts[cat]++;
+            DoAddPixels(w, h);
+        }
+    }
+
+private:
+    static void DoAddPixels(wxCoord w, wxCoord h);
+
+    static bool ms_enabled;
+    static unsigned long ms_counts[wxDC_STATS_MAX];
+
+    // this class has static methods only
+    wxDCStats();
+};
+
 //-----------------------------------------------------------------------------
 // wxDCImpl
 //-----------------------------------------------------------------------------
@@ -771,6 +858,54 @@ private:
 };
 
 
+// ----------------------------------------------------------------------------
+// wxTextExtentCache: global cache of text measurement results
+// ----------------------------------------------------------------------------
+
+// Measuring text is surprisingly expensive and custom-drawn controls often
+// measure the same strings with the same fonts over and over again for every
+// repaint, so wxDC (and hence wxGCDC) can optionally remember the extents it
+// computed and reuse them. The cache entries are keyed by the full font
+// description and the DC scale factors, so changing the font, the mapping
+// mode or the DPI can never yield stale results.
+class WXDLLIMPEXP_CORE wxTextExtentCache
+{
+public:
+    // Globally enable or disable the cache: it is disabled by default.
+    static void Enable(bool enable = true);
+    static bool IsEnabled();
+
+    // Change the maximal number of cached strings: when it is reached, the
+    // least recently used half of the entries is discarded.
+    static void SetMaxSize(size_t maxSize);
+
+    // Discard all cached extents.
+    static void Clear();
+
+    // Counters useful for choosing an appropriate cache size.
+    struct Stats
+    {
+        unsigned long hits,      // look-ups satisfied from the cache
+                      misses,    // look-ups which had to measure the text
+                      evictions; // entries discarded to bound the cache size
+    };
+
+    static Stats GetStats();
+    static void ResetStats();
+
+private:
+    // Only wxDC itself consults the cache contents.
+    friend class wxDC;
+
+    static wxString BuildKey(const wxDC& dc,
+                             const wxFont& font,
+                             const wxString& string);
+    static bool Find(const wxString& key, wxSize& extent,
+                     wxCoord& descent, wxCoord& externalLeading);
+    static void Add(const wxString& key, const wxSize& extent,
+                    wxCoord descent, wxCoord externalLeading);
+};
+
 class WXDLLIMPEXP_CORE wxDC : public wxObject
 {
 public:
@@ -931,14 +1066,13 @@ public:
                        wxCoord *x, wxCoord *y,
                        wxCoord *descent = NULL,
                        wxCoord *externalLeading = NULL,
-                       const wxFont *theFont = NULL) const
-        { m_pimpl->DoGetTextExtent(string, x, y, descent, externalLeading, theFont); }
+                       const wxFont *theFont = NULL) const;
 
     wxSize GetTextExtent(const wxString& string) const
     {
-        wxCoord w, h;
-        m_pimpl->DoGetTextExtent(string, &w, &h);
-        return wxSize(w, h);
+        wxSize size;
+        GetTextExtent(string, &size.x, &size.y);
+        return size;
     }
 
     void GetMultiLineTextExtent(const wxString& string,
@@ -946,36 +1080,43 @@ public:
                                         wxCoord *height,
                                         wxCoord *heightLine = NULL,
                                         const wxFont *font = NULL) const
-        { m_pimpl->GetMultiLineTextExtent( string, width, height, heightLine, font ); }
+        { wxDCStats::OnCall(wxDC_STATS_TEXT_EXTENTS);
+          m_pimpl->GetMultiLineTextExtent( string, width, height, heightLine, font ); }
 
     wxSize GetMultiLineTextExtent(const wxString& string) const
     {
+        wxDCStats::OnCall(wxDC_STATS_TEXT_EXTENTS);
         wxCoord w, h;
         m_pimpl->GetMultiLineTextExtent(string, &w, &h);
         return wxSize(w, h);
     }
 
     bool GetPartialTextExtents(const wxString& text, wxArrayInt& widths) const
-        { return m_pimpl->DoGetPartialTextExtents(text, widths); }
+        { wxDCStats::OnCall(wxDC_STATS_TEXT_EXTENTS);
+          return m_pimpl->DoGetPartialTextExtents(text, widths); }
 
     // clearing
 
     void Clear()
-        { m_pimpl->Clear(); }
+        { wxDCStats::OnCall(wxDC_STATS_OTHER); m_pimpl->Clear(); }
 
     // clipping
 
     void SetClippingRegion(wxCoord x, wxCoord y, wxCoord width, wxCoord height)
-        { m_pimpl->DoSetClippingRegion(x, y, width, height); }
+        { wxDCStats::OnCall(wxDC_STATS_CLIP_CHANGES);
+          m_pimpl->DoSetClippingRegion(x, y, width, height); }
     void SetClippingRegion(const wxPoint& pt, const wxSize& sz)
-        { m_pimpl->DoSetClippingRegion(pt.x, pt.y, sz.x, sz.y); }
+        { wxDCStats::OnCall(wxDC_STATS_CLIP_CHANGES);
+          m_pimpl->DoSetClippingRegion(pt.x, pt.y, sz.x, sz.y); }
     void SetClippingRegion(const wxRect& rect)
-        { m_pimpl->DoSetClippingRegion(rect.x, rect.y, rect.width, rect.height); }
+        { wxDCStats::OnCall(wxDC_STATS_CLIP_CHANGES);
+          m_pimpl->DoSetClippingRegion(rect.x, rect.y, rect.width, rect.height); }
 
     // unlike the functions above, the coordinates of the region used in this
     // one are in device coordinates, not the logical ones
     void SetDeviceClippingRegion(const wxRegion& region)
-        { m_pimpl->DoSetDeviceClippingRegion(region); }
+        { wxDCStats::OnCall(wxDC_STATS_CLIP_CHANGES);
+          m_pimpl->DoSetDeviceClippingRegion(region); }
 
     // this function is deprecated because its name is confusing: you may
     // expect it to work with logical coordinates but, in fact, it does exactly
@@ -988,7 +1129,8 @@ public:
                         SetDeviceClippingRegion(region); )
 
     void DestroyClippingRegion()
-        { m_pimpl->DestroyClippingRegion(); }
+        { wxDCStats::OnCall(wxDC_STATS_CLIP_CHANGES);
+          m_pimpl->DestroyClippingRegion(); }
 
     bool GetClippingBox(wxCoord *x, wxCoord *y, wxCoord *w, wxCoord *h) const
     {
@@ -1131,9 +1273,11 @@ public:
         { return m_pimpl->DoGetPixel(pt.x, pt.y, col); }
 
     void DrawLine(wxCoord x1, wxCoord y1, wxCoord x2, wxCoord y2)
-        { m_pimpl->DoDrawLine(x1, y1, x2, y2); }
+        { wxDCStats::OnCall(wxDC_STATS_LINES);
+          m_pimpl->DoDrawLine(x1, y1, x2, y2); }
     void DrawLine(const wxPoint& pt1, const wxPoint& pt2)
-        { m_pimpl->DoDrawLine(pt1.x, pt1.y, pt2.x, pt2.y); }
+        { wxDCStats::OnCall(wxDC_STATS_LINES);
+          m_pimpl->DoDrawLine(pt1.x, pt1.y, pt2.x, pt2.y); }
 
     void CrossHair(wxCoord x, wxCoord y)
         { m_pimpl->DoCrossHair(x, y); }
@@ -1142,9 +1286,11 @@ public:
 
     void DrawArc(wxCoord x1, wxCoord y1, wxCoord x2, wxCoord y2,
                  wxCoord xc, wxCoord yc)
-        { m_pimpl->DoDrawArc(x1, y1, x2, y2, xc, yc); }
+        { wxDCStats::OnCall(wxDC_STATS_ELLIPSES);
+          m_pimpl->DoDrawArc(x1, y1, x2, y2, xc, yc); }
     void DrawArc(const wxPoint& pt1, const wxPoint& pt2, const wxPoint& centre)
-        { m_pimpl->DoDrawArc(pt1.x, pt1.y, pt2.x, pt2.y, centre.x, centre.y); }
+        { wxDCStats::OnCall(wxDC_STATS_ELLIPSES);
+          m_pimpl->DoDrawArc(pt1.x, pt1.y, pt2.x, pt2.y, centre.x, centre.y); }
 
     void DrawCheckMark(wxCoord x, wxCoord y,
                        wxCoord width, wxCoord height)
@@ -1154,22 +1300,28 @@ public:
 
     void DrawEllipticArc(wxCoord x, wxCoord y, wxCoord w, wxCoord h,
                          double sa, double ea)
-        { m_pimpl->DoDrawEllipticArc(x, y, w, h, sa, ea); }
+        { wxDCStats::OnCall(wxDC_STATS_ELLIPSES);
+          m_pimpl->DoDrawEllipticArc(x, y, w, h, sa, ea); }
     void DrawEllipticArc(const wxPoint& pt, const wxSize& sz,
                          double sa, double ea)
-        { m_pimpl->DoDrawEllipticArc(pt.x, pt.y, sz.x, sz.y, sa, ea); }
+        { wxDCStats::OnCall(wxDC_STATS_ELLIPSES);
+          m_pimpl->DoDrawEllipticArc(pt.x, pt.y, sz.x, sz.y, sa, ea); }
 
     void DrawPoint(wxCoord x, wxCoord y)
-        { m_pimpl->DoDrawPoint(x, y); }
+        { wxDCStats::OnCall(wxDC_STATS_LINES);
+          m_pimpl->DoDrawPoint(x, y); }
     void DrawPoint(const wxPoint& pt)
-        { m_pimpl->DoDrawPoint(pt.x, pt.y); }
+        { wxDCStats::OnCall(wxDC_STATS_LINES);
+          m_pimpl->DoDrawPoint(pt.x, pt.y); }
 
     void DrawLines(int n, const wxPoint points[],
                    wxCoord xoffset = 0, wxCoord yoffset = 0)
-        { m_pimpl->DoDrawLines(n, points, xoffset, yoffset); }
+        { wxDCStats::OnCall(wxDC_STATS_LINES);
+          m_pimpl->DoDrawLines(n, points, xoffset, yoffset); }
     void DrawLines(const wxPointList *list,
                    wxCoord xoffset = 0, wxCoord yoffset = 0)
-        { m_pimpl->DrawLines( list, xoffset, yoffset ); }
+        { wxDCStats::OnCall(wxDC_STATS_LINES);
+          m_pimpl->DrawLines( list, xoffset, yoffset ); }
 #if WXWIN_COMPATIBILITY_2_8
     wxDEPRECATED( void DrawLines(const wxList *list,
                                  wxCoord xoffset = 0, wxCoord yoffset = 0) );
@@ -1178,15 +1330,18 @@ public:
     void DrawPolygon(int n, const wxPoint points[],
                      wxCoord xoffset = 0, wxCoord yoffset = 0,
                      wxPolygonFillMode fillStyle = wxODDEVEN_RULE)
-        { m_pimpl->DoDrawPolygon(n, points, xoffset, yoffset, fillStyle); }
+        { wxDCStats::OnCall(wxDC_STATS_POLYGONS);
+          m_pimpl->DoDrawPolygon(n, points, xoffset, yoffset, fillStyle); }
     void DrawPolygon(const wxPointList *list,
                      wxCoord xoffset = 0, wxCoord yoffset = 0,
                      wxPolygonFillMode fillStyle = wxODDEVEN_RULE)
-        { m_pimpl->DrawPolygon( list, xoffset, yoffset, fillStyle ); }
+        { wxDCStats::OnCall(wxDC_STATS_POLYGONS);
+          m_pimpl->DrawPolygon( list, xoffset, yoffset, fillStyle ); }
     void DrawPolyPolygon(int n, const int count[], const wxPoint points[],
                          wxCoord xoffset = 0, wxCoord yoffset = 0,
                          wxPolygonFillMode fillStyle = wxODDEVEN_RULE)
-        { m_pimpl->DoDrawPolyPolygon(n, count, points, xoffset, yoffset, fillStyle); }
+        { wxDCStats::OnCall(wxDC_STATS_POLYGONS);
+          m_pimpl->DoDrawPolyPolygon(n, count, points, xoffset, yoffset, fillStyle); }
 #if WXWIN_COMPATIBILITY_2_8
     wxDEPRECATED( void DrawPolygon(const wxList *list,
                      wxCoord xoffset = 0, wxCoord yoffset = 0,
@@ -1194,54 +1349,75 @@ public:
 #endif  // WXWIN_COMPATIBILITY_2_8
 
     void DrawRectangle(wxCoord x, wxCoord y, wxCoord width, wxCoord height)
-        { m_pimpl->DoDrawRectangle(x, y, width, height); }
+        { wxDCStats::OnCallArea(wxDC_STATS_RECTANGLES, width, height);
+          m_pimpl->DoDrawRectangle(x, y, width, height); }
     void DrawRectangle(const wxPoint& pt, const wxSize& sz)
-        { m_pimpl->DoDrawRectangle(pt.x, pt.y, sz.x, sz.y); }
+        { wxDCStats::OnCallArea(wxDC_STATS_RECTANGLES, sz.x, sz.y);
+          m_pimpl->DoDrawRectangle(pt.x, pt.y, sz.x, sz.y); }
     void DrawRectangle(const wxRect& rect)
-        { m_pimpl->DoDrawRectangle(rect.x, rect.y, rect.width, rect.height); }
+        { wxDCStats::OnCallArea(wxDC_STATS_RECTANGLES, rect.width, rect.height);
+          m_pimpl->DoDrawRectangle(rect.x, rect.y, rect.width, rect.height); }
 
     void DrawRoundedRectangle(wxCoord x, wxCoord y, wxCoord width, wxCoord height,
                               double radius)
-        { m_pimpl->DoDrawRoundedRectangle(x, y, width, height, radius); }
+        { wxDCStats::OnCallArea(wxDC_STATS_RECTANGLES, width, height);
+          m_pimpl->DoDrawRoundedRectangle(x, y, width, height, radius); }
     void DrawRoundedRectangle(const wxPoint& pt, const wxSize& sz,
                              double radius)
-        { m_pimpl->DoDrawRoundedRectangle(pt.x, pt.y, sz.x, sz.y, radius); }
+        { wxDCStats::OnCallArea(wxDC_STATS_RECTANGLES, sz.x, sz.y);
+          m_pimpl->DoDrawRoundedRectangle(pt.x, pt.y, sz.x, sz.y, radius); }
     void DrawRoundedRectangle(const wxRect& r, double radius)
-        { m_pimpl->DoDrawRoundedRectangle(r.x, r.y, r.width, r.height, radius); }
+        { wxDCStats::OnCallArea(wxDC_STATS_RECTANGLES, r.width, r.height);
+          m_pimpl->DoDrawRoundedRectangle(r.x, r.y, r.width, r.height, radius); }
 
     void DrawCircle(wxCoord x, wxCoord y, wxCoord radius)
-        { m_pimpl->DoDrawEllipse(x - radius, y - radius, 2*radius, 2*radius); }
+        { wxDCStats::OnCall(wxDC_STATS_ELLIPSES);
+          m_pimpl->DoDrawEllipse(x - radius, y - radius, 2*radius, 2*radius); }
     void DrawCircle(const wxPoint& pt, wxCoord radius)
-        { m_pimpl->DoDrawEllipse(pt.x - radius, pt.y - radius, 2*radius, 2*radius); }
+        { wxDCStats::OnCall(wxDC_STATS_ELLIPSES);
+          m_pimpl->DoDrawEllipse(pt.x - radius, pt.y - radius, 2*radius, 2*radius); }
 
     void DrawEllipse(wxCoord x, wxCoord y, wxCoord width, wxCoord height)
-        { m_pimpl->DoDrawEllipse(x, y, width, height); }
+        { wxDCStats::OnCall(wxDC_STATS_ELLIPSES);
+          m_pimpl->DoDrawEllipse(x, y, width, height); }
     void DrawEllipse(const wxPoint& pt, const wxSize& sz)
-        { m_pimpl->DoDrawEllipse(pt.x, pt.y, sz.x, sz.y); }
+        { wxDCStats::OnCall(wxDC_STATS_ELLIPSES);
+          m_pimpl->DoDrawEllipse(pt.x, pt.y, sz.x, sz.y); }
     void DrawEllipse(const wxRect& rect)
-        { m_pimpl->DoDrawEllipse(rect.x, rect.y, rect.width, rect.height); }
+        { wxDCStats::OnCall(wxDC_STATS_ELLIPSES);
+          m_pimpl->DoDrawEllipse(rect.x, rect.y, rect.width, rect.height); }
 
+    // Note: only count the calls, without the area, for the icons: wxIcon is
+    // still incomplete here, and icons are small anyhow.
     void DrawIcon(const wxIcon& icon, wxCoord x, wxCoord y)
-        { m_pimpl->DoDrawIcon(icon, x, y); }
+        { wxDCStats::OnCall(wxDC_STATS_BITMAPS);
+          m_pimpl->DoDrawIcon(icon, x, y); }
     void DrawIcon(const wxIcon& icon, const wxPoint& pt)
-        { m_pimpl->DoDrawIcon(icon, pt.x, pt.y); }
+        { wxDCStats::OnCall(wxDC_STATS_BITMAPS);
+          m_pimpl->DoDrawIcon(icon, pt.x, pt.y); }
 
     void DrawBitmap(const wxBitmap &bmp, wxCoord x, wxCoord y,
                     bool useMask = false)
-        { m_pimpl->DoDrawBitmap(bmp, x, y, useMask); }
+        { wxDCStats::OnCallArea(wxDC_STATS_BITMAPS, bmp.GetWidth(), bmp.GetHeight());
+          m_pimpl->DoDrawBitmap(bmp, x, y, useMask); }
     void DrawBitmap(const wxBitmap &bmp, const wxPoint& pt,
                     bool useMask = false)
-        { m_pimpl->DoDrawBitmap(bmp, pt.x, pt.y, useMask); }
+        { wxDCStats::OnCallArea(wxDC_STATS_BITMAPS, bmp.GetWidth(), bmp.GetHeight());
+          m_pimpl->DoDrawBitmap(bmp, pt.x, pt.y, useMask); }
 
     void DrawText(const wxString& text, wxCoord x, wxCoord y)
-        { m_pimpl->DoDrawText(text, x, y); }
+        { wxDCStats::OnCall(wxDC_STATS_TEXT);
+          m_pimpl->DoDrawText(text, x, y); }
     void DrawText(const wxString& text, const wxPoint& pt)
-        { m_pimpl->DoDrawText(text, pt.x, pt.y); }
+        { wxDCStats::OnCall(wxDC_STATS_TEXT);
+          m_pimpl->DoDrawText(text, pt.x, pt.y); }
 
     void DrawRotatedText(const wxString& text, wxCoord x, wxCoord y, double angle)
-        { m_pimpl->DoDrawRotatedText(text, x, y, angle); }
+        { wxDCStats::OnCall(wxDC_STATS_TEXT);
+          m_pimpl->DoDrawRotatedText(text, x, y, angle); }
     void DrawRotatedText(const wxString& text, const wxPoint& pt, double angle)
-        { m_pimpl->DoDrawRotatedText(text, pt.x, pt.y, angle); }
+        { wxDCStats::OnCall(wxDC_STATS_TEXT);
+          m_pimpl->DoDrawRotatedText(text, pt.x, pt.y, angle); }
 
     // this version puts both optional bitmap and the text into the given
     // rectangle and aligns is as specified by alignment parameter; it also
@@ -1264,6 +1440,7 @@ public:
               wxRasterOperationMode rop = wxCOPY, bool useMask = false,
               wxCoord xsrcMask = wxDefaultCoord, wxCoord ysrcMask = wxDefaultCoord)
     {
+        wxDCStats::OnCallArea(wxDC_STATS_BLITS, width, height);
         return m_pimpl->DoBlit(xdest, ydest, width, height,
                       source, xsrc, ysrc, rop, useMask, xsrcMask, ysrcMask);
     }
@@ -1272,6 +1449,7 @@ public:
               wxRasterOperationMode rop = wxCOPY, bool useMask = false,
               const wxPoint& srcPtMask = wxDefaultPosition)
     {
+        wxDCStats::OnCallArea(wxDC_STATS_BLITS, sz.x, sz.y);
         return m_pimpl->DoBlit(destPt.x, destPt.y, sz.x, sz.y,
                       source, srcPt.x, srcPt.y, rop, useMask, srcPtMask.x, srcPtMask.y);
     }
@@ -1284,6 +1462,7 @@ public:
                      wxRasterOperationMode rop = wxCOPY, bool useMask = false,
                      wxCoord srcMaskX = wxDefaultCoord, wxCoord srcMaskY = wxDefaultCoord)
     {
+        wxDCStats::OnCallArea(wxDC_STATS_BLITS, dstWidth, dstHeight);
         return m_pimpl->DoStretchBlit(dstX, dstY, dstWidth, dstHeight,
                       source, srcX, srcY, srcWidth, srcHeight, rop, useMask, srcMaskX, srcMaskY);
     }
@@ -1292,6 +1471,7 @@ public:
                      wxRasterOperationMode rop = wxCOPY, bool useMask = false,
                      const wxPoint& srcMaskPt = wxDefaultPosition)
     {
+        wxDCStats::OnCallArea(wxDC_STATS_BLITS, dstSize.x, dstSize.y);
         return m_pimpl->DoStretchBlit(dstPt.x, dstPt.y, dstSize.x, dstSize.y,
                       source, srcPt.x, srcPt.y, srcSize.x, srcSize.y, rop, useMask, srcMaskPt.x, srcMaskPt.y);
     }
@@ -40,6 +40,15 @@
 // is private style and not returned by GetStyle.
 #define wxBUFFER_USES_SHARED_BUFFER 0x04
 
+// Limit the buffer to the current update region of the window instead of its
+// entire client area: the buffer is sized to the bounding box of the damaged
+// area and only this part is blitted back, making minor repaints of large
+// windows much cheaper. Drawing outside of the update region is clipped
+// away, just as it would be when drawing on a plain wxPaintDC. This style
+// only makes sense together with wxBUFFER_CLIENT_AREA and without a
+// user-supplied buffer bitmap.
+#define wxBUFFER_UPDATE_AREA        0x08
+
 class WXDLLIMPEXP_CORE wxBufferedDC : public wxMemoryDC
 {
 public:
@@ -69,6 +78,15 @@ public:
         Init(dc, area, style);
     }
 
+    // Construct a wxBufferedDC with an internal buffer covering only the
+    // given part of the total area, e.g. the currently damaged rectangle of
+    // the window being repainted.
+    wxBufferedDC(wxDC *dc, const wxRect& area, int style = wxBUFFER_CLIENT_AREA)
+        : m_dc(NULL), m_buffer(NULL)
+    {
+        Init(dc, area, style);
+    }
+
     // The usually desired  action in the dtor is to blit the buffer.
     virtual ~wxBufferedDC()
     {
@@ -95,6 +113,22 @@ public:
         UseBuffer(area.x, area.y);
     }
 
+    void Init(wxDC *dc, const wxRect &area, int style = wxBUFFER_CLIENT_AREA)
+    {
+        InitCommon(dc, style | wxBUFFER_UPDATE_AREA);
+
+        m_bufferedPos = area.GetPosition();
+
+        UseBuffer(area.width, area.height);
+
+        // Map the window coordinates of the buffered rectangle onto the top
+        // left corner of the buffer. Use the logical and not the device
+        // origin so that preparing this DC for a scrolled window later
+        // doesn't undo the mapping.
+        if ( m_bufferedPos != wxPoint(0, 0) )
+            SetLogicalOrigin(m_bufferedPos.x, m_bufferedPos.y);
+    }
+
     // Blits the buffer to the dc, and detaches the dc from the buffer (so it
     // can be effectively used once only).
     //
@@ -135,6 +169,10 @@ private:
 
     wxSize m_area;
 
+    // position of the buffered rectangle, always (0, 0) unless the
+    // wxBUFFER_UPDATE_AREA style is used
+    wxPoint m_bufferedPos;
+
     wxDECLARE_DYNAMIC_CLASS(wxBufferedDC);
     wxDECLARE_NO_COPY_CLASS(wxBufferedDC);
 };
@@ -162,7 +200,7 @@ public:
         if( buffer.IsOk() )
             Init(&m_paintdc, buffer, style);
         else
-            Init(&m_paintdc, GetBufferedSize(window, style), style);
+            InitWithoutBuffer(window, style);
     }
 
     // If no bitmap is supplied by the user, a temporary one will be created.
@@ -175,7 +213,7 @@ public:
         if (style & wxBUFFER_VIRTUAL_AREA)
             window->PrepareDC( m_paintdc );
 
-        Init(&m_paintdc, GetBufferedSize(window, style), style);
+        InitWithoutBuffer(window, style);
     }
 
     // default copy ctor ok.
@@ -196,6 +234,25 @@ protected:
                                              : window->GetClientSize();
     }
 
+private:
+    void InitWithoutBuffer(wxWindow *window, int style)
+    {
+        // When asked to buffer only the damaged part of the window, size the
+        // buffer to the bounding box of the update region: anything outside
+        // of it would be clipped away when blitting anyhow.
+        if ( style & wxBUFFER_UPDATE_AREA )
+        {
+            const wxRect rect = window->GetUpdateClientRect();
+            if ( !rect.IsEmpty() )
+            {
+                Init(&m_paintdc, rect, style);
+                return;
+            }
+        }
+
+        Init(&m_paintdc, GetBufferedSize(window, style), style);
+    }
+
 private:
     wxPaintDC m_paintdc;
 
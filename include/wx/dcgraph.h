@@ -36,6 +36,16 @@ public:
     wxGCDC();
     virtual ~wxGCDC();
 
+    // Draw many polylines in a single call, optionally with one pen per
+    // polyline: see wxGraphicsContext::StrokeLinesBatch(). The overload
+    // taking a flat array reads the coordinates as x0, y0, x1, y1, ...
+    void DrawLinesBatch(size_t count, const size_t* sizes,
+                        const wxPoint2DDouble* points,
+                        const wxPen* pens = NULL);
+    void DrawLinesBatch(size_t count, const size_t* sizes,
+                        const wxDouble* coords,
+                        const wxPen* pens = NULL);
+
 #ifdef __WXMSW__
     // override wxDC virtual functions to provide access to HDC associated with
     // underlying wxGraphicsContext
@@ -202,6 +212,12 @@ public:
                                    wxCoord xoffset, wxCoord yoffset,
                                    wxPolygonFillMode fillStyle) wxOVERRIDE;
 
+    // not overrides: batched polyline drawing forwarded from wxGCDC
+    void DrawLinesBatch(size_t count, const size_t* sizes,
+                        const wxPoint2DDouble* points, const wxPen* pens);
+    void DrawLinesBatch(size_t count, const size_t* sizes,
+                        const wxDouble* coords, const wxPen* pens);
+
     virtual void DoSetDeviceClippingRegion(const wxRegion& region) wxOVERRIDE;
     virtual void DoSetClippingRegion(wxCoord x, wxCoord y,
         wxCoord width, wxCoord height) wxOVERRIDE;
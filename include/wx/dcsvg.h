@@ -14,6 +14,7 @@
 #if wxUSE_SVG
 
 #include "wx/string.h"
+#include "wx/buffer.h"
 #include "wx/filename.h"
 #include "wx/dc.h"
 #include "wx/scopedptr.h"
@@ -253,6 +254,17 @@ private:
 
     void write(const wxString& s);
 
+    // Lower-level helpers appending raw data to m_outBuffer, which is only
+    // flushed to the file in large chunks: used to stream potentially very
+    // long path data without building any intermediate wxString.
+    void writeData(const void* data, size_t len);
+    void writeLiteral(const char* s);
+    void writeNumber(wxCoord n);
+    void writeNumber(double f);
+
+    // Write out everything accumulated in m_outBuffer so far.
+    void FlushOutput();
+
 private:
     // If m_graphics_changed is true, close the current <g> element and start a
     // new one for the last pen/brush change.
@@ -268,6 +280,7 @@ private:
     int                 m_width, m_height;
     double              m_dpi;
     wxScopedPtr<wxFileOutputStream> m_outfile;
+    wxMemoryBuffer      m_outBuffer;
     wxScopedPtr<wxSVGBitmapHandler> m_bmp_handler; // class to handle bitmaps
     wxSVGShapeRenderingMode m_renderingMode;
 
@@ -14,8 +14,10 @@
 #include "wx/longlong.h"
 #include "wx/string.h"
 #include "wx/filefn.h"      // for wxS_DIR_DEFAULT
+#include "wx/vector.h"
 
 class WXDLLIMPEXP_FWD_BASE wxArrayString;
+class wxOperationContext;
 
 // ----------------------------------------------------------------------------
 // constants
@@ -50,6 +52,35 @@ enum wxDirTraverseResult
 extern WXDLLIMPEXP_DATA_BASE(const wxULongLong) wxInvalidSize;
 #endif // wxUSE_LONGLONG
 
+// ----------------------------------------------------------------------------
+// wxDirEntry: the result of the batched enumeration functions
+// ----------------------------------------------------------------------------
+
+// Unlike GetFirst/GetNext(), which return just the names, the batched
+// functions capture the metadata of each entry while reading the directory,
+// avoiding a separate stat() call per file in the caller.
+struct wxDirEntry
+{
+    wxDirEntry() : size(wxInvalidOffset), mtime(0), isDir(false) { }
+
+    // the name of the entry: just the basename for GetEntries(), the full
+    // path for GetAllEntries()
+    wxString name;
+
+    // the size of the file in bytes or wxInvalidOffset for directories or if
+    // it couldn't be retrieved
+    wxFileOffset size;
+
+    // the time of the last modification or 0 if it couldn't be retrieved
+    time_t mtime;
+
+    // true if this entry is a (possibly symlinked, unless wxDIR_NO_FOLLOW
+    // was used) directory
+    bool isDir;
+};
+
+typedef wxVector<wxDirEntry> wxDirEntries;
+
 // ----------------------------------------------------------------------------
 // wxDirTraverser: helper class for wxDir::Traverse()
 // ----------------------------------------------------------------------------
@@ -141,10 +172,21 @@ public:
 
     // enumerate all files in this directory and its subdirectories
     //
+    // if a context is given, the traversal can be cancelled from another
+    // thread and reports its progress (in visited entries) through it, see
+    // wx/opctx.h
+    //
     // return the number of files found
     size_t Traverse(wxDirTraverser& sink,
                     const wxString& filespec = wxEmptyString,
-                    int flags = wxDIR_DEFAULT) const;
+                    int flags = wxDIR_DEFAULT,
+                    wxOperationContext* context = NULL) const;
+
+    // get all the entries of this directory together with their metadata in
+    // a single pass, return the number of entries or (size_t)-1 on error
+    size_t GetEntries(wxDirEntries *entries,
+                      const wxString& filespec = wxEmptyString,
+                      int flags = wxDIR_DEFAULT) const;
 
     // simplest version of Traverse(): get the names of all files under this
     // directory into filenames array, return the number of files
@@ -153,6 +195,15 @@ public:
                               const wxString& filespec = wxEmptyString,
                               int flags = wxDIR_DEFAULT);
 
+    // recursive version of GetEntries(): get all the entries under dirname
+    // (with full paths) and, if threads > 1 (or -1 to use as many threads as
+    // there are CPUs), scan independent subdirectories in parallel
+    static size_t GetAllEntries(const wxString& dirname,
+                                wxDirEntries *entries,
+                                const wxString& filespec = wxEmptyString,
+                                int flags = wxDIR_DEFAULT,
+                                int threads = 1);
+
     // check if there any files matching the given filespec under the given
     // directory (i.e. searches recursively), return the file path if found or
     // empty string otherwise
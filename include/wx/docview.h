@@ -64,6 +64,56 @@ typedef wxVector<wxDocument*> wxDocVector;
 typedef wxVector<wxView*> wxViewVector;
 typedef wxVector<wxDocTemplate*> wxDocTemplateVector;
 
+// Special value for wxDocumentUpdateHint categories including all of the
+// application-defined ones.
+enum
+{
+    wxDOC_UPDATE_ALL_CATEGORIES = -1
+};
+
+// Typed hint which can be passed to wxDocument::UpdateAllViews(): it carries
+// the categories of the change (an application-defined bitmask) and
+// optionally the affected region, allowing the views subscribed to other
+// categories only (see wxView::SetUpdateCategories()) to skip the update
+// entirely. Applications needing to pass more information can derive from
+// this class.
+class WXDLLIMPEXP_CORE wxDocumentUpdateHint : public wxObject
+{
+public:
+    explicit
+    wxDocumentUpdateHint(int categories = wxDOC_UPDATE_ALL_CATEGORIES,
+                         const wxRect& region = wxRect())
+        : m_categories(categories),
+          m_region(region)
+    {
+    }
+
+    int GetCategories() const { return m_categories; }
+
+    // The changed region in document coordinates: an empty rectangle means
+    // that any part of the document may be affected.
+    wxRect GetRegion() const { return m_region; }
+
+    // Combine this hint with another one, used when coalescing several
+    // updates into a single one.
+    void Merge(const wxDocumentUpdateHint& hint)
+    {
+        m_categories |= hint.m_categories;
+
+        // an empty region means "everything", which subsumes any union
+        if ( m_region.IsEmpty() || hint.m_region.IsEmpty() )
+            m_region = wxRect();
+        else
+            m_region.Union(hint.m_region);
+    }
+
+private:
+    int m_categories;
+    wxRect m_region;
+
+    wxDECLARE_DYNAMIC_CLASS(wxDocumentUpdateHint);
+};
+
 class WXDLLIMPEXP_CORE wxDocument : public wxEvtHandler
 {
 public:
@@ -156,6 +206,14 @@ public:
     wxView *GetFirstView() const;
 
     virtual void UpdateAllViews(wxView *sender = NULL, wxObject *hint = NULL);
+
+    // Coalescing version of UpdateAllViews(): all the updates scheduled by
+    // this function before the event loop runs again are merged together
+    // (see wxDocumentUpdateHint::Merge()) and delivered as a single
+    // UpdateAllViews() call.
+    void UpdateAllViewsLater(wxView *sender = NULL,
+                             const wxDocumentUpdateHint& hint = wxDocumentUpdateHint());
+
     virtual void NotifyClosing();
 
     // Remove all views (because we're closing the document)
@@ -213,11 +271,26 @@ protected:
     // the default implementation of GetUserReadableName()
     wxString DoGetUserReadableName() const;
 
+#if !wxUSE_STD_IOSTREAM
+    // common part of DoOpenDocument() calling LoadObject() on the given
+    // stream, which may be a memory-mapped or a plain file stream
+    bool DoLoadDocument(wxInputStream& store, const wxString& file);
+#endif
+
 private:
     // list of all documents whose m_documentParent is this one
     typedef wxDList<wxDocument> DocsList;
     DocsList m_childDocuments;
 
+    // deliver the update coalesced by UpdateAllViewsLater()
+    void FlushUpdateAllViews();
+
+    // the update scheduled by UpdateAllViewsLater(), only valid while
+    // m_hasPendingUpdate is true
+    wxDocumentUpdateHint m_pendingUpdateHint;
+    wxView* m_pendingUpdateSender;
+    bool m_hasPendingUpdate;
+
     wxDECLARE_ABSTRACT_CLASS(wxDocument);
     wxDECLARE_NO_COPY_CLASS(wxDocument);
 };
@@ -246,6 +319,13 @@ public:
     virtual void OnClosingDocument() {}
     virtual void OnChangeFilename();
 
+    // Subscribe to the given categories of document changes: OnUpdate() is
+    // then not called at all for the updates whose wxDocumentUpdateHint
+    // carries none of these categories. By default a view receives all the
+    // updates, including those without any (typed) hint.
+    void SetUpdateCategories(int categories) { m_updateCategories = categories; }
+    int GetUpdateCategories() const { return m_updateCategories; }
+
     // Called by framework if created automatically by the default document
     // manager class: gives view a chance to initialise
     virtual bool OnCreate(wxDocument *WXUNUSED(doc), long WXUNUSED(flags))
@@ -288,6 +368,8 @@ protected:
     wxString          m_viewTypeName;
     wxWindow*         m_viewFrame;
 
+    int               m_updateCategories;
+
     wxDocChildFrameAnyBase *m_docChildFrame;
 
 private:
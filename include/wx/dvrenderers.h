@@ -303,7 +303,8 @@ public:
     wxDataViewCustomRendererBase(const wxString& varianttype = wxASCII_STR("string"),
                                  wxDataViewCellMode mode = wxDATAVIEW_CELL_INERT,
                                  int align = wxDVR_DEFAULT_ALIGNMENT)
-        : wxDataViewCustomRendererRealBase(varianttype, mode, align)
+        : wxDataViewCustomRendererRealBase(varianttype, mode, align),
+          m_effectiveFontFlags(-1)
     {
     }
 
@@ -389,9 +390,21 @@ protected:
     wxSize GetTextExtent(const wxString& str) const;
 
 private:
+    // Return the font obtained by applying the font modifiers of the current
+    // attribute to the given base font, caching the result: creating a font
+    // is relatively expensive and the cells repainted in one go typically
+    // use just a few distinct fonts.
+    const wxFont& GetEffectiveFontWithCache(const wxFont& font) const;
+
     wxDataViewItemAttr m_attr;
     bool m_enabled;
 
+    // The cache used by GetEffectiveFontWithCache(): the last base font, the
+    // font modifiers applied to it (-1 if the cache is empty) and the result.
+    mutable wxFont m_effectiveFontBase,
+                   m_effectiveFont;
+    mutable int m_effectiveFontFlags;
+
     wxDECLARE_NO_COPY_CLASS(wxDataViewCustomRendererBase);
 };
 
@@ -976,6 +976,16 @@ class WXDLLIMPEXP_BASE wxEvent : public wxObject
 public:
     wxEvent(int winid = 0, wxEventType commandType = wxEVT_NULL );
 
+#if !wxUSE_MEMORY_TRACING
+    // Class-specific allocation operators recycling the memory of recently
+    // deleted events: heap-allocated events are overwhelmingly short-lived
+    // (Clone() in AddPendingEvent()/wxPostEvent() followed by deletion after
+    // processing), so this avoids hitting the heap for steady-state event
+    // traffic. See wxEventMemoryPool in event.cpp.
+    void* operator new(size_t size);
+    void operator delete(void* ptr, size_t size);
+#endif // !wxUSE_MEMORY_TRACING
+
     void SetEventType(wxEventType typ) { m_eventType = typ; }
     wxEventType GetEventType() const { return m_eventType; }
 
@@ -1098,6 +1108,11 @@ public:
     // m_callbackUserData is for internal usage only
     wxObject*         m_callbackUserData;
 
+    // Implementation only: intrusive link used by the queue of the events
+    // posted with wxEvtHandler::QueueEvent(), see event.cpp. Non-NULL only
+    // while the event is in the queue.
+    wxEvent*          m_nextPending;
+
 private:
     // If this handler
     wxEvtHandler *m_handlerToProcessOnlyIn;
@@ -1349,9 +1364,21 @@ public:
     // Returns the idle event mode
     static wxIdleMode GetMode() { return sm_idleMode; }
 
+    // Specify how much time, in milliseconds, wxApp::ProcessIdle() may
+    // spend sending idle events during a single event loop pass: when the
+    // budget is exhausted the remaining windows are processed during the
+    // following passes instead. The default value of 0 means no limit, i.e.
+    // all windows are processed in every pass.
+    static void SetDispatchBudget(long milliseconds)
+        { sm_dispatchBudget = milliseconds; }
+
+    // Returns the idle dispatch budget
+    static long GetDispatchBudget() { return sm_dispatchBudget; }
+
 protected:
     bool m_requestMore;
     static wxIdleMode sm_idleMode;
+    static long sm_dispatchBudget;
 
 private:
     wxDECLARE_DYNAMIC_CLASS_NO_ASSIGN(wxIdleEvent);
@@ -3045,9 +3072,9 @@ private:
 class WXDLLIMPEXP_CORE wxSysColourChangedEvent : public wxEvent
 {
 public:
-    wxSysColourChangedEvent()
-        : wxEvent(0, wxEVT_SYS_COLOUR_CHANGED)
-        { }
+    // non-inline because creating this event invalidates the settings cached
+    // by wxSystemSettings, before any handler can re-query them
+    wxSysColourChangedEvent();
 
     virtual wxEvent *Clone() const wxOVERRIDE { return new wxSysColourChangedEvent(*this); }
 
@@ -3116,9 +3143,9 @@ private:
     wxDECLARE_DYNAMIC_CLASS_NO_ASSIGN(wxDisplayChangedEvent);
 
 public:
-    wxDisplayChangedEvent()
-        : wxEvent(0, wxEVT_DISPLAY_CHANGED)
-        { }
+    // non-inline because creating this event invalidates the settings cached
+    // by wxSystemSettings, before any handler can re-query them
+    wxDisplayChangedEvent();
 
     virtual wxEvent *Clone() const wxOVERRIDE { return new wxDisplayChangedEvent(*this); }
 };
@@ -3129,13 +3156,11 @@ public:
 class WXDLLIMPEXP_CORE wxDPIChangedEvent : public wxEvent
 {
 public:
+    // non-inline because creating this event invalidates the settings cached
+    // by wxSystemSettings, before any handler can re-query them
     explicit
     wxDPIChangedEvent(const wxSize& oldDPI = wxDefaultSize,
-                      const wxSize& newDPI = wxDefaultSize)
-        : wxEvent(0, wxEVT_DPI_CHANGED),
-          m_oldDPI(oldDPI),
-          m_newDPI(newDPI)
-        { }
+                      const wxSize& newDPI = wxDefaultSize);
 
     wxSize GetOldDPI() const { return m_oldDPI; }
     wxSize GetNewDPI() const { return m_newDPI; }
@@ -4044,6 +4069,20 @@ protected:
     typedef wxVector<wxDynamicEventTableEntry*> DynamicEvents;
     DynamicEvents* m_dynamicEvents;
 
+    // hash index over m_dynamicEvents keyed by event type, defined and
+    // documented in event.cpp; created together with m_dynamicEvents
+    class DynamicEventsIndex;
+    DynamicEventsIndex* m_dynamicEventsIndex;
+
+    // lock-free queue filled by QueueEvent() and drained into
+    // m_pendingEvents, under m_pendingEventsLock, by DrainPendingQueue();
+    // defined and documented in event.cpp, NULL if the compiler doesn't
+    // support the primitives needed to implement it
+    class PendingEventsQueue;
+    PendingEventsQueue* m_pendingQueue;
+
+    void DrainPendingQueue();
+
     wxList*             m_pendingEvents;
 
 #if wxUSE_THREADS
@@ -56,6 +56,52 @@
     will process all pending events as usual.
 */
 
+// ----------------------------------------------------------------------------
+// wxEventLoopStats: statistics collected by an instrumented event loop
+// ----------------------------------------------------------------------------
+
+// All the times are expressed in microseconds, see
+// wxEventLoopBase::EnableStats().
+struct WXDLLIMPEXP_BASE wxEventLoopStats
+{
+    // the number of buckets in the handler execution time histogram
+    enum { HistogramSize = 20 };
+
+    wxEventLoopStats() { Reset(); }
+
+    // reset all the counters to zero
+    void Reset();
+
+    // the number of event loop iterations completed so far
+    unsigned long iterations;
+
+    // the number of events dispatched from the wx pending events queue
+    unsigned long eventsProcessed;
+
+    // the number of handlers which exceeded the slow handler threshold
+    unsigned long slowHandlers;
+
+    // cumulative time spent dispatching native events, processing wx pending
+    // events and running the idle handlers respectively
+    wxLongLong dispatchTime;
+    wxLongLong pendingTime;
+    wxLongLong idleTime;
+
+    // histogram of the individual event handler execution times: the bucket
+    // with index N counts the handlers which took at least 2^N but less than
+    // 2^(N+1) microseconds to run, with the last bucket also counting
+    // everything slower
+    unsigned long handlerTimes[HistogramSize];
+};
+
+// Type of the callback invoked for the handlers exceeding the slow handler
+// threshold, see wxEventLoopBase::SetSlowHandlerCallback(). Only the class
+// name of the handler is provided because the handler itself may have been
+// destroyed while processing the event.
+typedef void (*wxEventLoopSlowHandlerCallback)(const wxString& handlerClass,
+                                               wxEventType eventType,
+                                               const wxLongLong& timeMicro);
+
 // ----------------------------------------------------------------------------
 // wxEventLoopBase: interface for wxEventLoop
 // ----------------------------------------------------------------------------
@@ -158,6 +204,17 @@ public:
     // should override DoYieldFor() and not YieldFor() itself
     virtual bool YieldFor(long eventsToProcess);
 
+    // bounded version of YieldFor(): process the events of the given
+    // categories for at most the given number of milliseconds
+    //
+    // this is meant to be called periodically from long computations to keep
+    // the UI alive without the unbounded latency of Yield(): by default only
+    // wxEVT_CATEGORY_UI events (e.g. paint and low level GUI events) are
+    // dispatched, so user input can't unexpectedly reenter the application
+    // code, and the call returns once the budget is exhausted even if more
+    // events are pending
+    bool PumpFor(long milliseconds, long eventsToProcess = wxEVT_CATEGORY_UI);
+
     // returns true if the main thread is inside a Yield() call
     virtual bool IsYielding() const
         { return m_yieldLevel != 0; }
@@ -171,6 +228,41 @@ public:
     // no SafeYield hooks since it uses wxWindow which is not available when wxUSE_GUI=0
 
 
+    // instrumentation
+    // ---------------
+
+    // collect timing statistics about the loop iterations and the events
+    // dispatched by this loop: this is off by default as it adds a small
+    // overhead to every iteration
+    void EnableStats(bool enable = true) { m_statsEnabled = enable; }
+    bool AreStatsEnabled() const { return m_statsEnabled; }
+
+    // return the statistics collected since the last ResetStats() call
+    //
+    // native dispatch, pending and idle phase times are currently only
+    // collected by the loops based on wxEventLoopManual, handler times are
+    // collected for all the events dispatched from the wx pending events
+    // queue
+    const wxEventLoopStats& GetStats() const { return m_stats; }
+    void ResetStats() { m_stats.Reset(); }
+
+    // if the threshold is positive, every event handler taking longer than
+    // this number of milliseconds is counted in the stats and reported via
+    // the callback set below or, in its absence, wxLogDebug()
+    void SetSlowHandlerThreshold(int milliseconds)
+        { m_slowHandlerThreshold = milliseconds; }
+    int GetSlowHandlerThreshold() const { return m_slowHandlerThreshold; }
+
+    void SetSlowHandlerCallback(wxEventLoopSlowHandlerCallback callback)
+        { m_slowHandlerCallback = callback; }
+
+    // this is called by wxEvtHandler itself to account for the time taken by
+    // processing one event, don't use it from the application code
+    void RecordHandlerTime(const wxString& handlerClass,
+                           wxEventType eventType,
+                           const wxLongLong& timeMicro);
+
+
     // active loop
     // -----------
 
@@ -195,6 +287,11 @@ protected:
     // be affected by pending events dispatching).
     virtual void DoYieldFor(long eventsToProcess) = 0;
 
+    // Return true if the time budget given to the current PumpFor() call, if
+    // any, is exhausted: the DoYieldFor() implementations should check this
+    // periodically and stop dispatching events when it returns true.
+    bool YieldDeadlineExpired() const;
+
     // this function should be called before the event loop terminates, whether
     // this happens normally (because of Exit() call) or abnormally (because of
     // an exception thrown from inside the loop)
@@ -218,6 +315,22 @@ protected:
     // the argument of the last call to YieldFor()
     long m_eventsToProcessInsideYield;
 
+    // if non-zero, the moment (in milliseconds since Epoch) at which the
+    // current PumpFor() call must stop dispatching events
+    wxLongLong m_yieldDeadline;
+
+    // the statistics collected while m_statsEnabled is true
+    wxEventLoopStats m_stats;
+
+    // true if the statistics above should be updated
+    bool m_statsEnabled;
+
+    // threshold in milliseconds for reporting slow handlers, 0 if disabled
+    int m_slowHandlerThreshold;
+
+    // the callback reporting slow handlers or NULL to use wxLogDebug()
+    wxEventLoopSlowHandlerCallback m_slowHandlerCallback;
+
 private:
     // this flag is set on entry into Run() and reset before leaving it
     bool m_isInsideRun;
@@ -20,6 +20,7 @@
 #include "wx/string.h"
 #include "wx/confbase.h"
 #include "wx/filename.h"
+#include "wx/hashmap.h"
 
 // ----------------------------------------------------------------------------
 // wxFileConfig
@@ -93,6 +94,10 @@ class WXDLLIMPEXP_FWD_BASE wxFileConfigGroup;
 class WXDLLIMPEXP_FWD_BASE wxFileConfigEntry;
 class WXDLLIMPEXP_FWD_BASE wxFileConfigLineList;
 
+WX_DECLARE_STRING_HASH_MAP_WITH_DECL(wxFileConfigGroup *,
+                                     wxFileConfigGroupHashMap,
+                                     class WXDLLIMPEXP_BASE);
+
 #if wxUSE_STREAMS
 class WXDLLIMPEXP_FWD_BASE wxInputStream;
 class WXDLLIMPEXP_FWD_BASE wxOutputStream;
@@ -185,6 +190,14 @@ public:
   void EnableAutoSave() { m_autosave = true; }
   void DisableAutoSave() { m_autosave = false; }
 
+  // write-behind mode: instead of rewriting the file synchronously, changes
+  // are coalesced and written out atomically by a background thread at most
+  // once per the given interval; calling Flush() explicitly still writes the
+  // file synchronously and the destructor waits for any pending write
+  bool EnableWriteBehind(int intervalMs = 1000);
+  void DisableWriteBehind();
+  bool IsWriteBehindEnabled() const { return m_writer != NULL; }
+
 public:
   // functions to work with this list
   wxFileConfigLineList *LineListAppend(const wxString& str);
@@ -228,8 +241,11 @@ private:
   // if path doesn't exist and createMissingComponents == false
   bool DoSetPath(const wxString& strPath, bool createMissingComponents);
 
+  // get the whole file contents as a single string
+  wxString GetFileText() const;
+
   // set/test the dirty flag
-  void SetDirty() { m_isDirty = true; }
+  void SetDirty();
   void ResetDirty() { m_isDirty = false; }
   bool IsDirty() const { return m_isDirty; }
 
@@ -243,6 +259,9 @@ private:
               m_fnGlobalFile;           // global
   wxString    m_strPath;                // current path (not '/' terminated)
 
+  wxFileConfigGroupHashMap m_pathCache; // cache used by DoSetPath(): maps
+                                        // normalized paths to their groups
+
   wxFileConfigGroup *m_pRootGroup,      // the top (unnamed) group
                     *m_pCurrentGroup;   // the current group
 
@@ -255,6 +274,8 @@ private:
   bool m_isDirty;                       // if true, we have unsaved changes
   bool m_autosave;                      // if true, save changes on destruction
 
+  class wxFileConfigWriterThread *m_writer; // non-NULL in write-behind mode
+
   wxDECLARE_NO_COPY_CLASS(wxFileConfig);
   wxDECLARE_ABSTRACT_CLASS(wxFileConfig);
 };
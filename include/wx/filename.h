@@ -509,17 +509,17 @@ public:
     void RemoveLastDir() { RemoveDir(GetDirCount() - 1); }
 
     // Other accessors
-    void SetExt( const wxString &ext )          { m_ext = ext; m_hasExt = !m_ext.empty(); }
-    void ClearExt()                             { m_ext.clear(); m_hasExt = false; }
-    void SetEmptyExt()                          { m_ext.clear(); m_hasExt = true; }
+    void SetExt( const wxString &ext )          { m_ext = ext; m_hasExt = !m_ext.empty(); InvalidateCache(); }
+    void ClearExt()                             { m_ext.clear(); m_hasExt = false; InvalidateCache(); }
+    void SetEmptyExt()                          { m_ext.clear(); m_hasExt = true; InvalidateCache(); }
     wxString GetExt() const                     { return m_ext; }
     bool HasExt() const                         { return m_hasExt; }
 
-    void SetName( const wxString &name )        { m_name = name; }
+    void SetName( const wxString &name )        { m_name = name; InvalidateCache(); }
     wxString GetName() const                    { return m_name; }
     bool HasName() const                        { return !m_name.empty(); }
 
-    void SetVolume( const wxString &volume )    { m_volume = volume; }
+    void SetVolume( const wxString &volume )    { m_volume = volume; InvalidateCache(); }
     wxString GetVolume() const                  { return m_volume; }
     bool HasVolume() const                      { return !m_volume.empty(); }
 
@@ -637,6 +637,14 @@ private:
     void DoSetPath(const wxString& path, wxPathFormat format,
                    int flags = SetPath_MayHaveVolume);
 
+    // drop the memoized full path and normalization state, must be called
+    // by every operation modifying the path components
+    void InvalidateCache()
+    {
+        m_fullpathValid = false;
+        m_normFlags = 0;
+    }
+
     // the drive/volume/device specification (always empty for Unix)
     //
     // for the drive letters, contains just the letter itself, but for MSW UNC
@@ -671,6 +679,18 @@ private:
     // DontFollowLink() to change this and make different operations work on
     // this file path itself instead of the target of the symlink
     bool            m_dontFollowLinks;
+
+    // the full path in m_fullpathFormat as last built by GetFullPath(),
+    // valid while m_fullpathValid is true; rebuilding the path string is
+    // relatively expensive so it is memoized until the next modification
+    mutable wxString        m_fullpath;
+    mutable wxPathFormat    m_fullpathFormat;
+    mutable bool            m_fullpathValid;
+
+    // the wxPATH_NORM_XXX flags already applied since the last
+    // modification: normalization is idempotent, so Normalize() can return
+    // immediately when called again with the same (or fewer) flags
+    int             m_normFlags;
 };
 
 #endif // _WX_FILENAME_H_
@@ -146,6 +146,9 @@ protected:
     // {it returns "/README.txt" for "file:subdir/archive.tar.gz#tar:/README.txt"}
     static wxString GetRightLocation(const wxString& location);
 
+    // it uses GetProtocol() to key its protocol-to-handler cache
+    friend class wxFileSystem;
+
     wxDECLARE_ABSTRACT_CLASS(wxFileSystemHandler);
 };
 
@@ -223,6 +226,14 @@ public:
 protected:
     wxFileSystemHandler *MakeLocal(wxFileSystemHandler *h);
 
+    // opens the given location using the first handler able to open it,
+    // returns NULL if it couldn't be opened at all
+    wxFSFile *DoOpenFile(const wxString& location);
+
+    // returns the first handler able to open the given location, using the
+    // protocol-to-handler cache when possible, or NULL if there is none
+    static wxFileSystemHandler *FindHandler(const wxString& location);
+
     wxString m_Path;
             // the path (location) we are currently in
             // this is path, not file!
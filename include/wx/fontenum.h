@@ -74,6 +74,12 @@ public:
     // in the user's system
     static bool IsValidFacename(const wxString &str);
 
+    // fill the cache used by GetFacenames() and IsValidFacename() if it
+    // hadn't been done yet: this can be called early (e.g. from an idle
+    // handler after start-up) to avoid stalling the UI the first time a font
+    // selection control enumerates the available fonts
+    static void CacheFacenames();
+
     // Invalidate cache used by some of the methods of this class internally.
     // This should be called if the list of the fonts available on the system
     // changes, for whatever reason.
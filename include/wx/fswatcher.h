@@ -88,6 +88,7 @@ public:
     wxFileSystemWatcherEvent(int changeType = 0, int watchid = wxID_ANY) :
         wxEvent(watchid, wxEVT_FSWATCHER),
         m_changeType(changeType),
+        m_changeCount(1),
         m_warningType(wxFSW_WARNING_NONE)
     {
     }
@@ -99,6 +100,7 @@ public:
                              int watchid = wxID_ANY) :
         wxEvent(watchid, wxEVT_FSWATCHER),
         m_changeType(changeType),
+        m_changeCount(1),
         m_warningType(warningType),
         m_errorMsg(errorMsg)
     {
@@ -110,6 +112,7 @@ public:
                              int watchid = wxID_ANY) :
          wxEvent(watchid, wxEVT_FSWATCHER),
          m_changeType(changeType),
+         m_changeCount(1),
          m_warningType(wxFSW_WARNING_NONE),
          m_path(path),
          m_newPath(newPath)
@@ -159,6 +162,22 @@ public:
         return m_changeType;
     }
 
+    /**
+     * Returns the number of identical consecutive changes represented by
+     * this event: backends may coalesce bursts of identical native events
+     * (e.g. repeated modifications of the same file) into a single event
+     * instead of flooding the event loop. This is always at least 1.
+     */
+    int GetChangeCount() const
+    {
+        return m_changeCount;
+    }
+
+    void SetChangeCount(int count)
+    {
+        m_changeCount = count;
+    }
+
     virtual wxEvent* Clone() const wxOVERRIDE
     {
         wxFileSystemWatcherEvent* evt = new wxFileSystemWatcherEvent(*this);
@@ -200,6 +219,7 @@ public:
 
 protected:
     int m_changeType;
+    int m_changeCount;
     wxFSWWarningType m_warningType;
     wxFileName m_path;
     wxFileName m_newPath;
@@ -281,6 +301,20 @@ protected:
 
 WX_DECLARE_STRING_HASH_MAP(wxFSWatchInfo, wxFSWatchInfoMap);
 
+// Stores the net effect of the changes to one path accumulated during the
+// coalescing window, see wxFileSystemWatcherBase::SetCoalesceInterval().
+struct wxFSWPendingChange
+{
+    wxFSWPendingChange() : flags(0), count(0) { }
+
+    int flags;      // net change type, 0 if the changes cancelled out
+    int count;      // number of raw changes merged into this one
+};
+
+WX_DECLARE_STRING_HASH_MAP(wxFSWPendingChange, wxFSWPendingChangeMap);
+
+class WXDLLIMPEXP_FWD_BASE wxTimer;
+
 /**
  * Encapsulation of platform-specific file system event mechanism
  */
@@ -345,6 +379,21 @@ public:
      */
     int GetWatchedPaths(wxArrayString* paths) const;
 
+    /**
+     * Sets the length in milliseconds of the window during which events for
+     * the same path are merged into a single event carrying their net
+     * effect before being delivered, e.g. a creation followed by a deletion
+     * cancels out and a burst of modifications becomes one event.
+     *
+     * The default value of 0 delivers every event immediately.
+     */
+    void SetCoalesceInterval(int milliseconds);
+
+    int GetCoalesceInterval() const
+    {
+        return m_coalesceInterval;
+    }
+
     wxEvtHandler* GetOwner() const
     {
         return m_owner;
@@ -366,6 +415,13 @@ public:
     bool AddAny(const wxFileName& path, int events, wxFSWPathType type,
                 const wxString& filespec = wxString());
 
+    // These are semi-private too: they're used by the implementations to
+    // deliver an event to the owner, merging it with the other events for
+    // the same path first if a coalescing interval is set, and to deliver
+    // everything accumulated so far when the window ends.
+    void DeliverEvent(wxFileSystemWatcherEvent& event);
+    void FlushCoalescedEvents();
+
 protected:
 
     static wxString GetCanonicalPath(const wxFileName& path)
@@ -378,6 +434,10 @@ protected:
     wxFSWatcherImpl* m_service;     // file system events service
     wxEvtHandler* m_owner;             // handler for file system events
 
+    int m_coalesceInterval;            // SetCoalesceInterval() value in ms
+    wxFSWPendingChangeMap m_pendingChanges; // events being coalesced
+    wxTimer* m_coalesceTimer;          // flushes them when the window ends
+
     friend class wxFSWatcherImpl;
 };
 
@@ -177,6 +177,24 @@ private:
     friend class wxDataViewHeaderWindowMSW;
 };
 
+// ---------------------------------------------------------
+// wxDataViewFilter
+// ---------------------------------------------------------
+
+// This class defines the predicate deciding which items of the model are
+// shown by the control when a filter is set, see wxDataViewCtrl::SetFilter().
+//
+// This class is only available in the generic version.
+class WXDLLIMPEXP_CORE wxDataViewFilter
+{
+public:
+    virtual ~wxDataViewFilter() { }
+
+    // Return true if the given item of the model should be shown.
+    virtual bool Matches(const wxDataViewModel* model,
+                         const wxDataViewItem& item) const = 0;
+};
+
 // ---------------------------------------------------------
 // wxDataViewCtrl
 // ---------------------------------------------------------
@@ -304,6 +322,18 @@ public:
     // This method is only available in the generic versions.
     wxHeaderCtrl* GenericGetHeader() const;
 
+    // Set the filter restricting the items shown by the control or remove it
+    // if the pointer is null. The control does not take ownership of the
+    // filter object, which must remain valid for as long as it is used.
+    //
+    // The filter is re-evaluated for all items whenever this function is
+    // called, so it must also be called after changing the criteria used by
+    // an already set filter, e.g. for every change of a search string.
+    //
+    // These methods are only available in the generic version.
+    void SetFilter(wxDataViewFilter* filter);
+    wxDataViewFilter* GetFilter() const { return m_filter; }
+
 protected:
     void EnsureVisibleRowCol( int row, int column );
 
@@ -409,6 +439,9 @@ private:
     // if true, allow sorting by more than one column
     bool m_allowMultiColumnSort;
 
+    // the filter restricting the shown items, may be null (not owned)
+    wxDataViewFilter *m_filter;
+
 private:
     void OnSize( wxSizeEvent &event );
     virtual wxSize GetSizeAvailableForScrollTarget(const wxSize& size) wxOVERRIDE;
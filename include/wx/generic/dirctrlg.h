@@ -20,6 +20,7 @@
 #include "wx/dialog.h"
 #include "wx/dirdlg.h"
 #include "wx/choice.h"
+#include "wx/hashmap.h"
 
 //-----------------------------------------------------------------------------
 // classes
@@ -72,6 +73,20 @@ public:
     bool m_isDir;
 };
 
+//-----------------------------------------------------------------------------
+// wxDirCtrlChildLists: the cached child lists of an already visited
+// directory, see wxGenericDirCtrl::EnableChildListCache()
+//-----------------------------------------------------------------------------
+
+struct wxDirCtrlChildLists
+{
+    time_t mtime;
+    wxArrayString dirs;
+    wxArrayString filenames;
+};
+
+WX_DECLARE_STRING_HASH_MAP(wxDirCtrlChildLists, wxDirCtrlChildListsMap);
+
 //-----------------------------------------------------------------------------
 // wxDirCtrl
 //-----------------------------------------------------------------------------
@@ -148,6 +163,14 @@ public:
     virtual int GetFilterIndex() const { return m_currentFilter; }
     virtual void SetFilterIndex(int n);
 
+    // Enable caching the child lists of the visited directories: while the
+    // cache is enabled, re-expanding a directory whose modification time
+    // hasn't changed reuses the last enumeration result instead of hitting
+    // the file system again, which makes a big difference for slow (e.g.
+    // network) file systems at the price of not noticing the (rare) changes
+    // not updating the directory modification time.
+    void EnableChildListCache(bool enable = true);
+
     virtual wxTreeItemId GetRootId() { return m_rootId; }
 
     virtual wxTreeCtrl* GetTreeCtrl() const { return m_treeCtrl; }
@@ -195,6 +218,13 @@ protected:
 
 private:
     void PopulateNode(wxTreeItemId node);
+
+    // enumerate the children of the given directory into the sorted dirs and
+    // filenames arrays, using the current filter and hidden files setting
+    void FindChildren(const wxString& dirName,
+                      wxArrayString& dirs,
+                      wxArrayString& filenames);
+
     wxDirItemData* GetItemData(wxTreeItemId itemId);
 
     bool            m_showHidden;
@@ -207,6 +237,9 @@ private:
     wxTreeCtrl*     m_treeCtrl;
     wxDirFilterListCtrl* m_filterListCtrl;
 
+    bool            m_useChildListCache;
+    wxDirCtrlChildListsMap m_childListCache;
+
 private:
     wxDECLARE_EVENT_TABLE();
     wxDECLARE_DYNAMIC_CLASS(wxGenericDirCtrl);
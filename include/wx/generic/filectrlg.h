@@ -17,7 +17,9 @@
 #include "wx/listctrl.h"
 #include "wx/filectrl.h"
 #include "wx/filename.h"
+#include "wx/timer.h"
 
+class WXDLLIMPEXP_FWD_BASE wxDir;
 class WXDLLIMPEXP_FWD_CORE wxCheckBox;
 class WXDLLIMPEXP_FWD_CORE wxChoice;
 class WXDLLIMPEXP_FWD_CORE wxStaticText;
@@ -178,6 +180,27 @@ protected:
     wxFileData::fileListFieldType m_sort_field;
 
 private:
+    // Incremental directory population, see UpdateFiles(): the first chunk of
+    // entries is added directly from it and the remaining ones, if any, from
+    // timer events, so that showing a huge directory doesn't freeze the UI.
+
+    // stop any population still in progress and free its state
+    void AbortPendingUpdate();
+
+    // add up to maxEntries more entries, return true if the enumeration is
+    // now complete
+    bool DoUpdateChunk(size_t maxEntries);
+
+    void OnUpdateTimer(wxTimerEvent& event);
+
+    wxDir *m_updateDir;             // non-NULL while populating
+    wxString m_updatePrefix;        // directory path with trailing separator
+    wxArrayString m_updateWild;     // wildcards not yet enumerated
+    int m_updateFlags;              // extra flags for wxDir enumeration
+    bool m_updateEnumDirs;          // enumerating directories or files?
+    bool m_updateEnumStarted;       // GetFirst() already called?
+    wxTimer m_updateTimer;
+
     wxDECLARE_DYNAMIC_CLASS(wxFileListCtrl);
     wxDECLARE_EVENT_TABLE();
 };
@@ -676,6 +676,11 @@ public:
         return wxELLIPSIZE_NONE;
     }
 
+    bool operator==(const wxGridFitMode& other) const
+        { return m_mode == other.m_mode; }
+    bool operator!=(const wxGridFitMode& other) const
+        { return m_mode != other.m_mode; }
+
     // This one is used in the implementation only.
     static wxGridFitMode FromOverflowFlag(bool allow)
         { return allow ? Overflow() : Clip(); }
@@ -741,6 +746,16 @@ public:
     wxGridCellAttr *Clone() const;
     void MergeWith(wxGridCellAttr *mergefrom);
 
+    // return true if this attribute specifies exactly the same appearance and
+    // behaviour as the other one; note that the renderer and editor pointers
+    // are compared, not the objects they point to, and that any client data
+    // associated with the attributes is not taken into account
+    bool IsSameAs(const wxGridCellAttr& other) const;
+
+    // return true if this attribute may be shared between several cells: it
+    // may not be if it carries any client data, which can't be compared
+    bool CanBeShared() const { return m_clientDataType == wxClientData_None; }
+
     // setters
     void SetTextColour(const wxColour& colText) { m_colText = colText; }
     void SetBackgroundColour(const wxColour& colBack) { m_colBack = colBack; }
@@ -901,6 +916,35 @@ public:
     virtual void SetRowAttr(wxGridCellAttr *attr, int row);
     virtual void SetColAttr(wxGridCellAttr *attr, int col);
 
+    // set the attribute for several consecutive rows or columns or for a
+    // rectangular block of cells at once: this is much more compact than
+    // setting it row by row or cell by cell when styling whole bands of the
+    // grid identically; the attributes set for individual cells take
+    // precedence over the block ones which in turn take precedence over the
+    // row and column ones (as above, ownership of the pointer is taken)
+    virtual void SetRowsAttr(wxGridCellAttr *attr, int rowFirst, int rowLast);
+    virtual void SetColsAttr(wxGridCellAttr *attr, int colFirst, int colLast);
+    virtual void SetBlockAttr(wxGridCellAttr *attr,
+                              int topRow, int leftCol,
+                              int bottomRow, int rightCol);
+
+    // temporarily cache the merged attributes returned by GetAttr(): this is
+    // done by the grid itself while repainting, when the attributes can't
+    // change, to avoid creating a new merged attribute for every cell of an
+    // identically styled region (calls to these functions can be nested but
+    // must be balanced)
+    void BeginAttrCaching();
+    void EndAttrCaching();
+
+    // replace the attribute of the given cell with its private copy if it is
+    // shared with any other cells because of the interning done by SetAttr():
+    // this is called by the grid itself before modifying an existing cell
+    // attribute in place, as otherwise the change would affect all the cells
+    // sharing it; returns either attr itself or the copy, with a reference
+    // which the caller must release in either case (the reference to attr is
+    // released if the copy is returned)
+    wxGridCellAttr *UnshareAttr(wxGridCellAttr *attr, int row, int col);
+
     // these functions must be called whenever some rows/cols are deleted
     // because the internal data must be updated then
     void UpdateAttrRows( size_t pos, int numRows );
@@ -1175,6 +1219,8 @@ WX_DECLARE_OBJARRAY_WITH_DECL(wxGridCellCoords, wxGridCellCoordsArray,
 // ----------------------------------------------------------------------------
 
 // the abstract base class
+class WXDLLIMPEXP_CORE wxGridStringArray;
+
 class WXDLLIMPEXP_CORE wxGridTableBase : public wxObject,
                                         public wxClientDataContainer
 {
@@ -1212,6 +1258,17 @@ public:
     virtual wxString GetValue( int row, int col ) = 0;
     virtual void SetValue( int row, int col, const wxString& value ) = 0;
 
+    // Fetch a rectangular block of values at once: the output array is
+    // filled with rowLast - rowFirst + 1 rows of colLast - colFirst + 1
+    // values each. The default implementation just calls GetValue() for
+    // every cell, override it if a block can be fetched more efficiently,
+    // e.g. with a single query to an external data source: the grid fetches
+    // all the cells of the repainted area with one call to this function
+    // when drawing.
+    virtual void GetValues( int rowFirst, int rowLast,
+                            int colFirst, int colLast,
+                            wxGridStringArray& values );
+
     // Data type determination and value access
     virtual wxString GetTypeName( int row, int col );
     virtual bool CanGetValueAs( int row, int col, const wxString& typeName );
@@ -1412,6 +1469,78 @@ private:
     wxDECLARE_DYNAMIC_CLASS_NO_COPY(wxGridStringTable);
 };
 
+// ----------------------------------------------------------------------------
+// wxGridSparseStringTable: string table using hash maps, so that the memory
+// used is proportional to the number of non-empty cells and not to the total
+// grid size, for use with very large mostly-empty grids. Created by
+// wxGrid::CreateSparseGrid().
+// ----------------------------------------------------------------------------
+
+WX_DECLARE_HASH_MAP_WITH_DECL( int, wxString, wxIntegerHash, wxIntegerEqual,
+                               wxGridSparseCellMap, class WXDLLIMPEXP_CORE );
+
+WX_DECLARE_HASH_MAP_WITH_DECL( int, wxGridSparseCellMap,
+                               wxIntegerHash, wxIntegerEqual,
+                               wxGridSparseRowMap, class WXDLLIMPEXP_CORE );
+
+class WXDLLIMPEXP_CORE wxGridSparseStringTable : public wxGridTableBase
+{
+public:
+    wxGridSparseStringTable();
+    wxGridSparseStringTable( int numRows, int numCols );
+
+    // these are pure virtual in wxGridTableBase
+    //
+    virtual int GetNumberRows() wxOVERRIDE { return m_numRows; }
+    virtual int GetNumberCols() wxOVERRIDE { return m_numCols; }
+    virtual wxString GetValue( int row, int col ) wxOVERRIDE;
+    virtual void SetValue( int row, int col, const wxString& s ) wxOVERRIDE;
+
+    // overridden functions from wxGridTableBase
+    //
+    bool IsEmptyCell( int row, int col ) wxOVERRIDE;
+    void Clear() wxOVERRIDE;
+    bool InsertRows( size_t pos = 0, size_t numRows = 1 ) wxOVERRIDE;
+    bool AppendRows( size_t numRows = 1 ) wxOVERRIDE;
+    bool DeleteRows( size_t pos = 0, size_t numRows = 1 ) wxOVERRIDE;
+    bool InsertCols( size_t pos = 0, size_t numCols = 1 ) wxOVERRIDE;
+    bool AppendCols( size_t numCols = 1 ) wxOVERRIDE;
+    bool DeleteCols( size_t pos = 0, size_t numCols = 1 ) wxOVERRIDE;
+
+    void SetRowLabelValue( int row, const wxString& ) wxOVERRIDE;
+    void SetColLabelValue( int col, const wxString& ) wxOVERRIDE;
+    void SetCornerLabelValue( const wxString& ) wxOVERRIDE;
+    wxString GetRowLabelValue( int row ) wxOVERRIDE;
+    wxString GetColLabelValue( int col ) wxOVERRIDE;
+    wxString GetCornerLabelValue() const wxOVERRIDE;
+
+private:
+    // Renumber the keys not less than pos by the given offset in the row map
+    // (used for row insertion/deletion) or in all the cell maps (for column
+    // insertion/deletion). Entries for which the new key would be out of
+    // range are dropped.
+    void ShiftRows( int pos, int offset );
+    void ShiftCols( int pos, int offset );
+
+    // only the non-empty cells of the non-empty rows are present here
+    wxGridSparseRowMap m_rows;
+
+    // unlike in wxGridStringTable, neither dimension can be recovered from
+    // the data, so store both
+    int m_numRows;
+    int m_numCols;
+
+    // these only get used if you set your own labels, otherwise the
+    // GetRow/ColLabelValue functions return wxGridTableBase defaults
+    //
+    wxArrayString     m_rowLabels;
+    wxArrayString     m_colLabels;
+
+    wxString m_cornerLabel;
+
+    wxDECLARE_DYNAMIC_CLASS_NO_COPY(wxGridSparseStringTable);
+};
+
 
 
 // ============================================================================
@@ -1512,6 +1641,12 @@ public:
     //
     //   AssignTable(new wxGridStringTable(numRows, numCols), selmode)
     //
+    // Same as CreateGrid() but uses wxGridSparseStringTable for the storage,
+    // so that a huge mostly-empty grid only uses memory proportional to the
+    // number of non-empty cells.
+    bool CreateSparseGrid( int numRows, int numCols,
+                           wxGridSelectionModes selmode = wxGridSelectCells );
+
     bool CreateGrid( int numRows, int numCols,
                      wxGridSelectionModes selmode = wxGridSelectCells );
 
@@ -1590,6 +1725,13 @@ public:
     bool IsFrozen() const;
 
     void DrawGridCellArea( wxDC& dc , const wxGridCellCoordsArray& cells );
+
+    // Prefetch the values of the bounding block of the given cells with
+    // wxGridTableBase::GetValues() for use by GetCellValue() during
+    // repainting. Returns true if the values were prefetched and
+    // ClearPrefetchedCellValues() must be called after drawing.
+    bool PrefetchCellValues( const wxGridCellCoordsArray& cells );
+    void ClearPrefetchedCellValues();
     void DrawGridSpace( wxDC& dc, wxGridWindow *gridWindow );
     void DrawCellBorder( wxDC& dc, const wxGridCellCoords& );
     void DrawAllGridLines();
@@ -2183,6 +2325,15 @@ public:
     {
         if ( m_table )
         {
+            // during repainting the values of the drawn area are prefetched
+            // with wxGridTableBase::GetValues(), so look there first
+            if ( m_prefetchActive )
+            {
+                const wxString* const s = GetPrefetchedValue( row, col );
+                if ( s )
+                    return *s;
+            }
+
             return m_table->GetValue( row, col );
         }
         else
@@ -2552,6 +2703,17 @@ protected:
     wxGridTableBase          *m_table;
     bool                      m_ownTable;
 
+    // values prefetched for the duration of a repaint, see
+    // PrefetchCellValues(); only used when m_prefetchActive is true
+    wxGridStringArray         m_prefetchedValues;
+    int                       m_prefetchedRowFirst;
+    int                       m_prefetchedColFirst;
+    bool                      m_prefetchActive;
+
+    // returns the address of the prefetched value or NULL if the cell is
+    // outside of the prefetched block
+    const wxString *GetPrefetchedValue( int row, int col ) const;
+
     int m_numRows;
     int m_numCols;
 
@@ -2599,6 +2761,32 @@ protected:
     wxArrayInt m_colWidths;
     wxArrayInt m_colRights;
 
+    // return true if all the rows/columns have the default size even though
+    // the arrays above were created: this allows using simple arithmetic
+    // instead of a binary search when converting positions to indices
+    //
+    // the result is cached in the variables below which contain -1 if it
+    // needs to be recomputed
+    bool HasUniformRowSizes() const;
+    bool HasUniformColSizes() const;
+
+    mutable int m_uniformRows;
+    mutable int m_uniformCols;
+
+    // resizing a single row/column doesn't update all the following entries
+    // of m_rowBottoms/m_colRights immediately as this would make interactive
+    // resizing quadratic: instead, the index of the first affected line and
+    // the size delta are stored here, taken into account by the accessors
+    // and folded into the arrays by the functions below as soon as a
+    // different line is resized or the arrays are rebuilt
+    void FlushPendingRowBottoms();
+    void FlushPendingColRights();
+
+    int m_rowBottomsPendingFrom;
+    int m_rowBottomsPendingDiff;
+    int m_colRightsPendingFrom;
+    int m_colRightsPendingDiff;
+
     int m_sortCol;
     bool m_sortIsAscending;
 
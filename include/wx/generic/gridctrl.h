@@ -20,9 +20,15 @@
 
 
 // the default renderer for the cells containing string data
+// private helper caching the extents of the already measured strings
+class wxGridCellStringExtentCache;
+
 class WXDLLIMPEXP_ADV wxGridCellStringRenderer : public wxGridCellRenderer
 {
 public:
+    wxGridCellStringRenderer();
+    wxGridCellStringRenderer(const wxGridCellStringRenderer& other);
+
     // draw the string
     virtual void Draw(wxGrid& grid,
                       wxGridCellAttr& attr,
@@ -41,10 +47,18 @@ public:
         { return new wxGridCellStringRenderer; }
 
 protected:
-    // calc the string extent for given string/font
+    virtual ~wxGridCellStringRenderer();
+
+    // calc the string extent for given string/font, using the cache of the
+    // already measured strings
     wxSize DoGetBestSize(const wxGridCellAttr& attr,
                          wxDC& dc,
                          const wxString& text);
+
+private:
+    // measuring text is by far the most expensive part of painting string
+    // cells, so cache the results between the repaints
+    wxGridCellStringExtentCache * const m_extentCache;
 };
 
 // the default renderer for the cells containing numeric (long) data
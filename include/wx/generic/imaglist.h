@@ -17,6 +17,7 @@
 class WXDLLIMPEXP_FWD_CORE wxDC;
 class WXDLLIMPEXP_FWD_CORE wxIcon;
 class WXDLLIMPEXP_FWD_CORE wxColour;
+class WXDLLIMPEXP_FWD_CORE wxMemoryDC;
 
 
 class WXDLLIMPEXP_CORE wxGenericImageList: public wxObject
@@ -58,9 +59,23 @@ public:
 private:
     const wxBitmap *DoGetPtr(int index) const;
 
+    // Pack all the images into a single backing bitmap used by Draw(): with
+    // it, drawing many images only blits sub-rectangles of one bitmap
+    // instead of setting up the DC state for every image separately.
+    void BuildAtlas() const;
+
+    // Discard the atlas, it will be rebuilt on demand by the next Draw().
+    void InvalidateAtlas();
+
     wxVector<wxBitmap> m_images;
     bool m_useMask;
 
+    // The atlas is just a cache rebuilt from m_images whenever the list
+    // changes, hence all these fields are mutable.
+    mutable wxBitmap m_atlas;
+    mutable wxMemoryDC *m_atlasDC;
+    mutable bool m_atlasValid;
+
     // Size of a single bitmap in the list.
     wxSize m_size;
     // Images in the list should have the same scale factor.
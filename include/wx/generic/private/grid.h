@@ -453,14 +453,154 @@ private:
     wxArrayAttrs m_attrs;
 };
 
-// NB: this is just a wrapper around 3 objects: one which stores cell
-//     attributes, and 2 others for row/col ones
+// this class stores attributes set for contiguous intervals of rows or
+// columns, which is much more compact than storing them row by row when whole
+// bands of the grid are styled identically
+class WXDLLIMPEXP_ADV wxGridRowOrColIntervalAttrData
+{
+public:
+    wxGridRowOrColIntervalAttrData() {}
+    ~wxGridRowOrColIntervalAttrData();
+
+    // set (or, if attr is NULL, reset) the attribute for all rows or columns
+    // in the inclusive interval [first, last]
+    void SetAttr(wxGridCellAttr *attr, int first, int last);
+    wxGridCellAttr *GetAttr(int rowOrCol) const;
+    void UpdateAttrRowsOrCols( size_t pos, int numRowsOrCols );
+
+private:
+    // an interval [first, last] of rows or columns sharing the same attribute
+    struct wxGridAttrInterval
+    {
+        wxGridAttrInterval(int first_, int last_, wxGridCellAttr *attr_)
+            : first(first_), last(last_), attr(attr_) {}
+
+        int first, last;
+        wxGridCellAttr *attr;
+    };
+
+    // return the index of the first interval with last >= rowOrCol or the
+    // number of intervals if there is none
+    size_t FindInterval(int rowOrCol) const;
+
+    // the intervals, sorted by their first element and non-overlapping
+    wxVector<wxGridAttrInterval> m_intervals;
+};
+
+// this class stores attributes set for rectangular blocks of cells
+class WXDLLIMPEXP_ADV wxGridBlockAttrData
+{
+public:
+    wxGridBlockAttrData() {}
+    ~wxGridBlockAttrData();
+
+    void SetAttr(wxGridCellAttr *attr,
+                 int topRow, int leftCol, int bottomRow, int rightCol);
+    wxGridCellAttr *GetAttr(int row, int col) const;
+    void UpdateAttrRows( size_t pos, int numRows );
+    void UpdateAttrCols( size_t pos, int numCols );
+
+private:
+    struct wxGridAttrBlock
+    {
+        int topRow, leftCol, bottomRow, rightCol;
+        wxGridCellAttr *attr;
+    };
+
+    // the blocks in the order they were set: the ones set later take
+    // precedence over the earlier ones in GetAttr()
+    wxVector<wxGridAttrBlock> m_blocks;
+};
+
+// this class caches the merged attributes while the grid is being painted:
+// creating a new merged attribute for every cell is wasteful when entire
+// rows, columns or blocks are styled identically, so remember the result for
+// each distinct combination of the component attributes instead
+class WXDLLIMPEXP_ADV wxGridMergedAttrCache
+{
+public:
+    wxGridMergedAttrCache() : m_enableCount(0) {}
+    ~wxGridMergedAttrCache() { Clear(); }
+
+    // the cache is only used in between Enable() and the matching Disable()
+    // call, i.e. while the attributes are known not to change
+    bool IsEnabled() const { return m_enableCount != 0; }
+    void Enable() { m_enableCount++; }
+    void Disable();
+
+    // return a new reference to the merged attribute cached for this
+    // combination of component attributes or NULL if there is none
+    wxGridCellAttr *Find(const wxGridCellAttr *cell,
+                         const wxGridCellAttr *block,
+                         const wxGridCellAttr *col,
+                         const wxGridCellAttr *row) const;
+
+    // remember the merged attribute for this combination of component
+    // attributes (takes a new reference on it)
+    void Add(const wxGridCellAttr *cell,
+             const wxGridCellAttr *block,
+             const wxGridCellAttr *col,
+             const wxGridCellAttr *row,
+             wxGridCellAttr *merged);
+
+    // forget all cached attributes, e.g. because an attribute changed
+    void Clear();
+
+private:
+    struct wxGridMergedAttrEntry
+    {
+        const wxGridCellAttr *cell, *block, *col, *row;
+        wxGridCellAttr *merged;
+    };
+
+    wxVector<wxGridMergedAttrEntry> m_entries;
+
+    int m_enableCount;
+};
+
+// this class keeps a pool of the cell attributes already stored by the
+// provider so that setting equal (by value) attributes for many individual
+// cells shares a single object between all of them instead of keeping
+// thousands of identical copies alive
+class WXDLLIMPEXP_ADV wxGridAttrInternPool
+{
+public:
+    wxGridAttrInternPool() {}
+    ~wxGridAttrInternPool();
+
+    // return the canonical attribute equal to the given one: if an equal
+    // attribute is already pooled, a new reference to it is returned and the
+    // reference to attr is released, otherwise attr itself is pooled (if
+    // possible) and returned unchanged
+    wxGridCellAttr *Intern(wxGridCellAttr *attr);
+
+    // return true if the given attribute is one of the pooled canonical ones
+    // and so may be shared between several cells
+    bool Contains(const wxGridCellAttr *attr) const;
+
+private:
+    // drop the pooled attributes not referenced from outside any more
+    void Prune();
+
+    // the canonical attributes, each with one reference held by the pool
+    wxArrayAttrs m_attrs;
+
+    wxDECLARE_NO_COPY_CLASS(wxGridAttrInternPool);
+};
+
+// NB: this is just a wrapper around the objects storing the cell, block,
+//     row and column attributes and the cache of the merged ones
 class WXDLLIMPEXP_ADV wxGridCellAttrProviderData
 {
 public:
     wxGridCellAttrData m_cellAttrs;
+    wxGridBlockAttrData m_blockAttrs;
     wxGridRowOrColAttrData m_rowAttrs,
                            m_colAttrs;
+    wxGridRowOrColIntervalAttrData m_rowIntervalAttrs,
+                                   m_colIntervalAttrs;
+    wxGridMergedAttrCache m_mergedAttrs;
+    wxGridAttrInternPool m_attrPool;
 };
 
 // ----------------------------------------------------------------------------
@@ -554,6 +694,9 @@ public:
     // Get wxGrid::m_rowBottoms/m_colRights array
     virtual const wxArrayInt& GetLineEnds(const wxGrid *grid) const = 0;
 
+    // Return true if all the lines have the default size
+    virtual bool HasUniformLineSizes(const wxGrid *grid) const = 0;
+
     // Get default height row height or column width
     virtual int GetDefaultLineSize(const wxGrid *grid) const = 0;
 
@@ -651,6 +794,8 @@ public:
         { return grid->GetRowHeight(line); }
     virtual const wxArrayInt& GetLineEnds(const wxGrid *grid) const wxOVERRIDE
         { return grid->m_rowBottoms; }
+    virtual bool HasUniformLineSizes(const wxGrid *grid) const wxOVERRIDE
+        { return grid->HasUniformRowSizes(); }
     virtual int GetDefaultLineSize(const wxGrid *grid) const wxOVERRIDE
         { return grid->GetDefaultRowSize(); }
     virtual int GetMinimalAcceptableLineSize(const wxGrid *grid) const wxOVERRIDE
@@ -732,6 +877,8 @@ public:
         { return grid->GetColWidth(line); }
     virtual const wxArrayInt& GetLineEnds(const wxGrid *grid) const wxOVERRIDE
         { return grid->m_colRights; }
+    virtual bool HasUniformLineSizes(const wxGrid *grid) const wxOVERRIDE
+        { return grid->HasUniformColSizes(); }
     virtual int GetDefaultLineSize(const wxGrid *grid) const wxOVERRIDE
         { return grid->GetDefaultColSize(); }
     virtual int GetMinimalAcceptableLineSize(const wxGrid *grid) const wxOVERRIDE
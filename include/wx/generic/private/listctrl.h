@@ -60,7 +60,7 @@ public:
 
     bool HasText() const { return !m_text.empty(); }
     const wxString& GetText() const { return m_text; }
-    void SetText(const wxString& text) { m_text = text; }
+    void SetText(const wxString& text) { m_text = text; m_extentsGeneration = 0; }
 
     // we can't use empty string for measuring the string width/height, so
     // always return something
@@ -73,6 +73,10 @@ public:
         return s;
     }
 
+    // return the extent of the text as it is drawn, remeasuring it with the
+    // given DC only if the cached value is not valid any more
+    void GetTextExtentCached(wxDC& dc, wxCoord *width, wxCoord *height);
+
     bool IsHit( int x, int y ) const;
 
     int GetX() const;
@@ -105,6 +109,14 @@ public:
     // custom attributes or NULL
     wxItemAttr *m_attr;
 
+    // cached extent of m_text as returned by GetTextExtentCached(): only
+    // valid while m_extentsGeneration matches the generation counter of the
+    // owner window (0 is never used as a generation, so it marks the cache
+    // as invalid)
+    wxCoord m_textWidth,
+            m_textHeight;
+    wxUint32 m_extentsGeneration;
+
 protected:
     // common part of all ctors
     void Init();
@@ -303,10 +315,11 @@ private:
                          bool highlighted,
                          bool current);
 
-    // draw the text on the DC with the correct justification; also add an
-    // ellipsis if the text is too large to fit in the current width
+    // draw the text of the given item on the DC with the correct
+    // justification; also add an ellipsis if the text is too large to fit in
+    // the current width
     void DrawTextFormatted(wxDC *dc,
-                           const wxString &text,
+                           wxListItemData *item,
                            int col,
                            int x,
                            int yMid,    // this is middle, not top, of the text
@@ -713,6 +726,10 @@ public:
     void InsertItem( wxListItem &item );
     long InsertColumn( long col, const wxListItem &item );
     int GetItemWidthWithImage(wxListItem * item);
+
+    // as above, but for an existing item and using the cached text extent,
+    // so that e.g. auto-sizing a column doesn't remeasure all the strings
+    int GetItemWidthWithImage(wxListItemData *itemData, wxDC& dc);
     void SortItems( wxListCtrlCompare fn, wxIntPtr data );
 
     size_t GetItemCount() const;
@@ -736,10 +753,23 @@ public:
             return false;
 
         m_lineHeight = 0;
+        InvalidateExtents();
 
         return true;
     }
 
+    // the generation of the cached item text extents: it is incremented
+    // whenever all the cached extents become invalid at once, e.g. because
+    // the font changed, and the items then remeasure themselves lazily, see
+    // wxListItemData::GetTextExtentCached()
+    wxUint32 GetExtentsGeneration() const { return m_extentsGeneration; }
+    void InvalidateExtents()
+    {
+        // skip 0 on wrap around as it is used to mark invalid cached extents
+        if ( !++m_extentsGeneration )
+            ++m_extentsGeneration;
+    }
+
     void ExtendRulesAndAlternateColour(bool extend)
     {
         m_extendRulesAndAlternateColour = extend;
@@ -929,6 +959,10 @@ private:
     // the height of one line using the current font
     wxCoord m_lineHeight;
 
+    // the current generation of the cached item text extents, see
+    // GetExtentsGeneration()
+    wxUint32 m_extentsGeneration;
+
     // the total header width or 0 if not calculated yet
     wxCoord m_headerWidth;
 
@@ -29,6 +29,8 @@ struct RowRange
 class WXDLLIMPEXP_CORE RowRanges
 {
 public:
+    RowRanges() : m_countsValid(false) {}
+
     /**
         Adds a row index to this group by adding it to an existing RowRange
         or by creating a new one.
@@ -40,6 +42,14 @@ public:
     */
     void Remove(unsigned int row);
 
+    /**
+        Removes only the given row index from this group, splitting the
+        RowRange containing it if necessary.
+
+        Unlike Remove(), the indices after the given one are kept.
+    */
+    void RemoveSingle(unsigned int row);
+
     /**
         Checks whether a row index is contained in this group.
     */
@@ -68,12 +78,35 @@ public:
 private:
     wxVector<RowRange> m_ranges;
 
+    /**
+        The cumulative number of rows contained in the ranges up to and
+        including each one of them.
+
+        This is only a cache used to answer CountAll() and CountTo() queries
+        quickly, it is rebuilt by UpdateCounts() whenever it is invalidated by
+        a modification of m_ranges.
+    */
+    mutable wxVector<unsigned int> m_countTo;
+    mutable bool m_countsValid;
+
     /**
         If a new row index was inserted, Cleanup() checks if the neighbour
         ranges of idx can includes the same row indices and discards
         unnecessary RowRange objects.
     */
     void CleanUp(unsigned int idx);
+
+    /**
+        Returns the index of the first RowRange ending after the given row,
+        i.e. the only one which could contain it, or the number of ranges if
+        there is none.
+    */
+    size_t FindRange(unsigned int row) const;
+
+    /**
+        Rebuilds m_countTo after a modification of m_ranges.
+    */
+    void UpdateCounts() const;
 };
 
 WX_DECLARE_HASH_MAP(unsigned int, RowRanges*, wxIntegerHash, wxIntegerEqual,
@@ -145,6 +178,17 @@ public:
     */
     void Remove(unsigned int row);
 
+    /**
+        Removes only the stored height of the given row from the cache,
+        keeping the rows after it cached.
+
+        This should be used when an existing item changed and so may have a
+        different height now: the rows after it keep their heights and their
+        positions are recomputed automatically, so only the changed row needs
+        to be measured again.
+    */
+    void InvalidateRow(unsigned int row);
+
     void Clear();
 
 private:
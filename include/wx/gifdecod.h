@@ -18,6 +18,7 @@
 #include "wx/image.h"
 #include "wx/animdecod.h"
 #include "wx/dynarray.h"
+#include "wx/vector.h"
 
 // internal utility used to store a frame in 8bit-per-pixel format
 class GIFImage;
@@ -52,7 +53,7 @@ public:
     wxGIFDecoder();
     ~wxGIFDecoder();
 
-    // get data of current frame
+    // get data of current frame (decoded on demand, returns NULL on error)
     unsigned char* GetData(unsigned int frame) const;
     unsigned char* GetPalette(unsigned int frame) const;
     unsigned int GetNcolours(unsigned int frame) const;
@@ -95,10 +96,18 @@ private:
     wxGIFErrorCode dgif(wxInputStream& stream,
                         GIFImage *img, int interl, int bits);
 
+    // decompress the raster data of the given frame if not done yet,
+    // evicting the least recently used frame when the cache is full
+    wxGIFErrorCode EnsureFrameDecoded(unsigned int frame);
+
 
     // array of all frames
     wxArrayPtrVoid m_frames;
 
+    // indices of the currently decoded frames, in LRU order (the most
+    // recently used one is at the back)
+    wxVector<unsigned int> m_cachedFrames;
+
     // decoder state vars
     int           m_restbits;       // remaining valid bits
     unsigned int  m_restbyte;       // remaining bytes in this block
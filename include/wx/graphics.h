@@ -90,6 +90,7 @@ class WXDLLIMPEXP_FWD_CORE wxPrinterDC;
 class WXDLLIMPEXP_FWD_CORE wxEnhMetaFileDC;
 #endif
 #endif
+class WXDLLIMPEXP_FWD_CORE wxGraphicsCommandList;
 class WXDLLIMPEXP_FWD_CORE wxGraphicsContext;
 class WXDLLIMPEXP_FWD_CORE wxGraphicsPath;
 class WXDLLIMPEXP_FWD_CORE wxGraphicsMatrix;
@@ -502,6 +503,11 @@ public:
     // closes the current sub-path
     virtual void CloseSubpath();
 
+    // removes all points and subpaths, retaining the backend allocations
+    // where possible so that the path can be rebuilt without paying the
+    // creation cost again
+    virtual void Clear();
+
     // gets the last point of the current path, (0,0) if not yet set
     virtual void GetCurrentPoint( wxDouble* x, wxDouble* y) const;
     wxPoint2DDouble GetCurrentPoint() const;
@@ -602,6 +608,14 @@ public:
     // create a context that can be used for measuring texts only, no drawing allowed
     static wxGraphicsContext * Create();
 
+    // create a context recording all the drawing commands into the given
+    // command list instead of executing them, so that they can be replayed
+    // later with wxGraphicsCommandList::Replay(); the default renderer is
+    // used if none is explicitly specified
+    static wxGraphicsContext *
+    CreateRecording(wxGraphicsCommandList& commands,
+                    wxGraphicsRenderer* renderer = NULL);
+
     // Return the window this context is associated with, if any.
     wxWindow* GetWindow() const { return m_window; }
 
@@ -804,6 +818,13 @@ public:
     // draws a path by first filling and then stroking
     virtual void DrawPath( const wxGraphicsPath& path, wxPolygonFillMode fillStyle = wxODDEVEN_RULE );
 
+    // draws the same path at each of the n offsets in a single call, which
+    // is much cheaper than recreating the path for every instance when
+    // drawing many identical small shapes, e.g. plot markers
+    virtual void DrawPath( const wxGraphicsPath& path, size_t n,
+                           const wxPoint2DDouble* offsets,
+                           wxPolygonFillMode fillStyle = wxODDEVEN_RULE );
+
     // paints a transparent rectangle (only useful for bitmaps or windows)
     virtual void ClearRectangle(wxDouble x, wxDouble y, wxDouble w, wxDouble h);
 
@@ -854,6 +875,22 @@ public:
     // stroke disconnected lines from begin to end points
     virtual void StrokeLines( size_t n, const wxPoint2DDouble *beginPoints, const wxPoint2DDouble *endPoints);
 
+    // stroke many polylines in a single call: sizes[i] is the number of
+    // points of the i-th polyline and points contains the points of all the
+    // polylines one after the other; if pens is non-NULL it contains one pen
+    // per polyline and consecutive polylines using the same pen are
+    // accumulated into a single path, so the backend is called once per pen
+    // change instead of once per polyline
+    virtual void StrokeLinesBatch( size_t count, const size_t* sizes,
+                                   const wxPoint2DDouble* points,
+                                   const wxPen* pens = NULL );
+
+    // as above, but taking the coordinates from a flat array containing
+    // x0, y0, x1, y1, ... thus avoiding any conversion of the points
+    virtual void StrokeLinesBatch( size_t count, const size_t* sizes,
+                                   const wxDouble* coords,
+                                   const wxPen* pens = NULL );
+
     // draws a polygon
     virtual void DrawLines( size_t n, const wxPoint2DDouble *points, wxPolygonFillMode fillStyle = wxODDEVEN_RULE );
 
@@ -926,6 +963,52 @@ private:
     wxDECLARE_ABSTRACT_CLASS(wxGraphicsContext);
 };
 
+//
+// Represents a retained sequence of drawing commands: the commands issued on
+// the context returned by wxGraphicsContext::CreateRecording() are stored in
+// the command list instead of being executed and can be replayed any number
+// of times on another context, optionally under an extra transform. This
+// allows creating the expensive parts of a largely static scene (paths,
+// brushes, fonts) just once and re-issuing them cheaply on every repaint.
+//
+
+class wxGraphicsRecordedCommand;
+
+class WXDLLIMPEXP_CORE wxGraphicsCommandList
+{
+public:
+    wxGraphicsCommandList();
+    ~wxGraphicsCommandList();
+
+    // Return true if nothing has been recorded (yet).
+    bool IsEmpty() const { return m_commands.empty(); }
+
+    // Discard all the recorded commands, allowing to record anew.
+    void Clear();
+
+    // Re-issue all the recorded commands on the given context, which must
+    // use the same renderer as the one used for recording. The overload
+    // taking a matrix applies it to all the replayed commands. The context
+    // clip and transform are preserved, but its pen, brush and font change
+    // just as if the recorded calls had been made on it directly.
+    void Replay(wxGraphicsContext* gc) const;
+    void Replay(wxGraphicsContext* gc, const wxGraphicsMatrix& transform) const;
+
+private:
+    // Only the recording context may append commands.
+    friend class wxGraphicsRecordingContext;
+
+    void Append(wxGraphicsRecordedCommand* command);
+
+    wxVector<wxGraphicsRecordedCommand*> m_commands;
+
+    // The renderer used for recording, set by the recording context: the
+    // recorded objects can only be used with this renderer.
+    wxGraphicsRenderer* m_renderer;
+
+    wxDECLARE_NO_COPY_CLASS(wxGraphicsCommandList);
+};
+
 #if 0
 
 //
@@ -961,6 +1044,51 @@ private:
 
 #endif
 
+//
+// Micro-benchmark support: the platforms providing several renderers (e.g.
+// GDI+, Direct2D and Cairo under MSW) can differ wildly in the relative
+// speed of the various operations, so an application caring about drawing
+// performance can measure them at startup and choose its renderer
+// accordingly instead of always using the default one.
+//
+
+// The classes of operations measured by wxGraphicsRenderer::Benchmark().
+enum wxGraphicsBenchmarkOp
+{
+    wxGRAPHICS_BENCHMARK_LINES,
+    wxGRAPHICS_BENCHMARK_RECTANGLES,
+    wxGRAPHICS_BENCHMARK_ELLIPSES,
+    wxGRAPHICS_BENCHMARK_CURVES,
+    wxGRAPHICS_BENCHMARK_BITMAPS,
+    wxGRAPHICS_BENCHMARK_TEXT,
+
+    wxGRAPHICS_BENCHMARK_OP_COUNT
+};
+
+struct wxGraphicsBenchmarkResult
+{
+    wxGraphicsBenchmarkResult()
+    {
+        for ( int op = 0; op < wxGRAPHICS_BENCHMARK_OP_COUNT; op++ )
+            ms[op] = 0.0;
+    }
+
+    // The sum of the timings of all the operation classes.
+    double Total() const
+    {
+        double total = 0.0;
+        for ( int op = 0; op < wxGRAPHICS_BENCHMARK_OP_COUNT; op++ )
+            total += ms[op];
+        return total;
+    }
+
+    // Time, in milliseconds, taken by a fixed number of operations of each
+    // class, so smaller is better. Only comparable between renderers, not
+    // between operation classes, as different classes use different numbers
+    // of operations.
+    double ms[wxGRAPHICS_BENCHMARK_OP_COUNT];
+};
+
 //
 // The graphics renderer is the instance corresponding to the rendering engine used, eg there is ONE core graphics renderer
 // instance on OSX. This instance is pointed back to by all objects created by it. Therefore you can create eg additional
@@ -988,6 +1116,29 @@ public:
 #endif
 #endif
 
+    // Return all the renderers available in this build, with the default
+    // renderer always coming first.
+    static wxVector<wxGraphicsRenderer*> GetAllRenderers();
+
+#if wxUSE_IMAGE
+    // Run a micro-benchmark of this renderer on an offscreen image surface
+    // of the given size and return the per-operation timings.
+    wxGraphicsBenchmarkResult Benchmark(int width = 256, int height = 256);
+
+    // Benchmark all the available renderers and return the one with the
+    // smallest total time, remembering the fastest renderer for each
+    // operation class for GetFastestRenderer(). If the output parameter is
+    // non-NULL, it is filled with the individual results, in
+    // GetAllRenderers() order.
+    static wxGraphicsRenderer*
+    BenchmarkAll(wxVector<wxGraphicsBenchmarkResult>* results = NULL);
+
+    // Return the fastest renderer for the given operation class as measured
+    // by the last call to BenchmarkAll() or the default renderer if it
+    // hasn't been called yet.
+    static wxGraphicsRenderer* GetFastestRenderer(wxGraphicsBenchmarkOp op);
+#endif // wxUSE_IMAGE
+
     // Context
 
     virtual wxGraphicsContext * CreateContext( const wxWindowDC& dc) = 0;
@@ -288,6 +288,46 @@ public: \
     size_type size() const { return m_items; } \
     size_type max_size() const { return size_type(-1); } \
     bool empty() const { return size() == 0; } \
+ \
+    /* grow the table in advance so that sz items can be inserted without */ \
+    /* any rehashing, as with the standard unordered containers */ \
+    void reserve( size_type sz ) \
+    { \
+        /* the table is grown when the load factor reaches 0.85, stay */ \
+        /* safely below that */ \
+        const size_type buckets = sz + sz/4 + 1; \
+        if( buckets > m_tableBuckets ) \
+            ResizeTable( buckets - 1 ); \
+    } \
+ \
+    /* exchange the contents with another hash table without copying any */ \
+    /* elements, as with the standard unordered containers */ \
+    void swap( Self& ht ) \
+    { \
+        _wxHashTable_NodeBase** const table = m_table; \
+        m_table = ht.m_table; \
+        ht.m_table = table; \
+ \
+        const size_t tableBuckets = m_tableBuckets; \
+        m_tableBuckets = ht.m_tableBuckets; \
+        ht.m_tableBuckets = tableBuckets; \
+ \
+        const size_t items = m_items; \
+        m_items = ht.m_items; \
+        ht.m_items = items; \
+ \
+        const hasher hfun = m_hasher; \
+        m_hasher = ht.m_hasher; \
+        ht.m_hasher = hfun; \
+ \
+        const key_equal k_eq = m_equals; \
+        m_equals = ht.m_equals; \
+        ht.m_equals = k_eq; \
+ \
+        const key_extractor k_ex = m_getKey; \
+        m_getKey = ht.m_getKey; \
+        ht.m_getKey = k_ex; \
+    } \
  \
     const_iterator end() const { return const_iterator(NULL, this); } \
     iterator end() { return iterator(NULL, this); } \
@@ -194,7 +194,8 @@ public:
     const wxHtmlBookRecArray& GetBookRecArray() const { return m_bookRecords; }
 
     const wxHtmlHelpDataItems& GetContentsArray() const { return m_contents; }
-    const wxHtmlHelpDataItems& GetIndexArray() const { return m_index; }
+    const wxHtmlHelpDataItems& GetIndexArray() const
+        { SortIndexIfNeeded(); return m_index; }
 
 protected:
     wxString m_tempPath;
@@ -203,9 +204,17 @@ protected:
     wxHtmlBookRecArray m_bookRecords;
 
     wxHtmlHelpDataItems m_contents; // list of all available books and pages
-    wxHtmlHelpDataItems m_index; // list of index items
+
+    // list of index items; sorted lazily, use SortIndexIfNeeded() before
+    // accessing it directly
+    mutable wxHtmlHelpDataItems m_index;
+    mutable bool m_indexSorted;
 
 protected:
+    // Sorts the index if any books were added since it was sorted the last
+    // time (sorting it after adding every book is a waste of time).
+    void SortIndexIfNeeded() const;
+
     // Imports .hhp files (MS HTML Help Workshop)
     bool LoadMSProject(wxHtmlBookRecord *book, wxFileSystem& fsys,
                        const wxString& indexfile, const wxString& contentsfile);
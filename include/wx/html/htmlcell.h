@@ -277,6 +277,12 @@ public:
                                int WXUNUSED(x), int WXUNUSED(y),
                                wxHtmlRenderingInfo& WXUNUSED(info)) {}
 
+    // returns true if DrawInvisible() of this cell does anything, i.e. if it
+    // must be called even when the cell is scrolled out of view: any cell
+    // overriding DrawInvisible() non-trivially must override this too, as
+    // otherwise its DrawInvisible() may be skipped when drawing
+    virtual bool AffectsRenderingState() const { return false; }
+
     // This method returns pointer to the FIRST cell for that
     // the condition
     // is true. It first checks if the condition is true for this
@@ -492,6 +498,9 @@ public:
     virtual void DrawInvisible(wxDC& dc, int x, int y,
                                wxHtmlRenderingInfo& info) wxOVERRIDE;
 
+    virtual bool AffectsRenderingState() const wxOVERRIDE
+        { return m_nStateCells != 0; }
+
     virtual bool AdjustPagebreak(int *pagebreak, int pageHeight) const wxOVERRIDE;
 
     // insert cell at the end of m_Cells list
@@ -524,7 +533,12 @@ public:
     void SetWidthFloat(int w, int units) {m_WidthFloat = w; m_WidthFloatUnits = units; m_LastLayout = -1;}
     void SetWidthFloat(const wxHtmlTag& tag, double pixel_scale = 1.0);
     // sets minimal height of this container.
-    void SetMinHeight(int h, int align = wxHTML_ALIGN_TOP) {m_MinHeight = h; m_MinHeightAlign = align; m_LastLayout = -1;}
+    void SetMinHeight(int h, int align = wxHTML_ALIGN_TOP)
+    {
+        if (h == m_MinHeight && align == m_MinHeightAlign)
+            return;
+        m_MinHeight = h; m_MinHeightAlign = align; m_LastLayout = -1;
+    }
 
     void SetBackgroundColour(const wxColour& clr) {m_BkColour = clr;}
     // returns background colour (of wxNullColour if none set), so that widgets can
@@ -592,8 +606,23 @@ protected:
     int m_LastLayout;
             // if != -1 then call to Layout may be no-op
             // if previous call to Layout has same argument
+    int m_LastLayoutWidth;
+            // the width computed for m_LastLayout from m_WidthFloat, before
+            // it could be grown to fit overlong content: if the new call to
+            // Layout computes the same width, the cached layout is reused
     int m_MaxTotalWidth;
             // Maximum possible length if ignoring line wrap
+    int m_nStateCells;
+            // number of direct children for which AffectsRenderingState()
+            // returns true, updated by Layout(): when it drops to 0 the rest
+            // of an invisible cell range doesn't need to be walked at all;
+            // -1 until it is computed (e.g. in classes overriding Layout()
+            // without calling the base class version), meaning that nothing
+            // may be skipped when drawing
+    bool m_ChildrenYSorted;
+            // true if the children are sorted by their vertical position,
+            // also updated by Layout(): allows Draw() to stop the loop as
+            // soon as a child below the visible area is found
 
 
     wxDECLARE_ABSTRACT_CLASS(wxHtmlContainerCell);
@@ -615,6 +644,7 @@ public:
                       wxHtmlRenderingInfo& info) wxOVERRIDE;
     virtual void DrawInvisible(wxDC& dc, int x, int y,
                                wxHtmlRenderingInfo& info) wxOVERRIDE;
+    virtual bool AffectsRenderingState() const wxOVERRIDE { return true; }
 
     virtual wxString GetDescription() const wxOVERRIDE;
 
@@ -642,6 +672,7 @@ public:
                       wxHtmlRenderingInfo& info) wxOVERRIDE;
     virtual void DrawInvisible(wxDC& dc, int x, int y,
                                wxHtmlRenderingInfo& info) wxOVERRIDE;
+    virtual bool AffectsRenderingState() const wxOVERRIDE { return true; }
 
     virtual wxString GetDescription() const wxOVERRIDE;
 
@@ -677,6 +708,7 @@ public:
                       wxHtmlRenderingInfo& info) wxOVERRIDE;
     virtual void DrawInvisible(wxDC& dc, int x, int y,
                                wxHtmlRenderingInfo& info) wxOVERRIDE;
+    virtual bool AffectsRenderingState() const wxOVERRIDE { return true; }
     virtual void Layout(int w) wxOVERRIDE;
 
 protected:
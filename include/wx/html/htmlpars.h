@@ -31,9 +31,6 @@ WX_DECLARE_HASH_SET_WITH_DECL_PTR(wxHtmlTagHandler*,
                                   wxPointerHash, wxPointerEqual,
                                   wxHtmlTagHandlersSet,
                                   class WXDLLIMPEXP_HTML);
-WX_DECLARE_STRING_HASH_MAP_WITH_DECL(wxHtmlTagHandler*,
-                                     wxHtmlTagHandlersHash,
-                                     class WXDLLIMPEXP_HTML);
 
 
 enum wxHtmlURLType
@@ -117,6 +114,12 @@ public:
     const wxString* GetSource() {return m_Source;}
     void SetSource(const wxString& src);
 
+    // Replaces the stored source without reparsing it. May only be called
+    // when parsing is not in progress; it is used to keep GetSource()
+    // consistent when the output was updated incrementally (see
+    // wxHtmlWindow::AppendToPage).
+    void ReplaceSource(const wxString& src);
+
     // Sets HTML source and remembers current parser's state so that it can
     // later be restored. This is useful for on-line modifications of
     // HTML source (for example, <pre> handler replaces spaces with &nbsp;
@@ -178,24 +181,37 @@ protected:
 
     wxHtmlParserState *m_SavedStates;
 
-    // handlers that handle particular tags. The table is accessed by
-    // key = tag's name.
+    // handlers that handle particular tags. The table is indexed by the
+    // small integer id assigned to each tag name by GetTagNameId().
     // This attribute MUST be filled by derived class otherwise it would
     // be empty and no tags would be recognized
     // (see wxHtmlWinParser for details about filling it)
-    // m_HandlersHash is for random access based on knowledge of tag name (BR, P, etc.)
-    //      it may (and often does) contain more references to one object
-    // m_HandlersList is list of all handlers and it is guaranteed to contain
+    // m_HandlersById is for random access based on the id of the tag name
+    //      (BR, P, etc.), it may (and often does) contain more references
+    //      to one object
+    // m_HandlersSet is list of all handlers and it is guaranteed to contain
     //      only one reference to each handler instance.
     wxHtmlTagHandlersSet m_HandlersSet;
-    wxHtmlTagHandlersHash m_HandlersHash;
+    wxVector<wxHtmlTagHandler*> m_HandlersById;
+
+    // ids assigned to the tag names seen by this parser: they are handed
+    // out when registering the handlers and when building the DOM tree, so
+    // that dispatching a tag to its handler doesn't hash its name again
+    wxStringToNumHashMap m_TagNameIds;
+
+    // returns the id of the given tag name (which must be in upper case),
+    // assigning a new one if this name wasn't seen yet
+    int GetTagNameId(const wxString& name);
+
+    // makes the given handler handle the tag with the given name
+    void SetHandlerForTag(const wxString& name, wxHtmlTagHandler *handler);
 
     wxDECLARE_NO_COPY_CLASS(wxHtmlParser);
 
     // class for opening files (file system)
     wxFileSystem *m_FS;
     // handlers stack used by PushTagHandler and PopTagHandler
-    wxVector<wxHtmlTagHandlersHash*> m_HandlersStack;
+    wxVector<wxVector<wxHtmlTagHandler*>*> m_HandlersStack;
 
     // entity parse
     wxHtmlEntitiesParser *m_entitiesParser;
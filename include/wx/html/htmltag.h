@@ -147,6 +147,12 @@ public:
 
 private:
     wxString m_Name;
+
+    // id assigned to m_Name by the parser which created this tag, used to
+    // find the tag handler without hashing the name again (wxNOT_FOUND if
+    // the parser didn't fill it in)
+    int m_NameId;
+
     bool m_hasEnding;
     wxString::const_iterator m_Begin, m_End1, m_End2;
     wxArrayString m_ParamNames, m_ParamValues;
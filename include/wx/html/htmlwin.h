@@ -22,6 +22,7 @@
 #include "wx/html/htmlfilt.h"
 #include "wx/filename.h"
 #include "wx/bitmap.h"
+#include "wx/timer.h"
 
 class wxHtmlProcessor;
 class wxHtmlWinModule;
@@ -405,6 +406,9 @@ protected:
     void OnPaint(wxPaintEvent& event);
     void OnEraseBackground(wxEraseEvent& event);
     void OnSize(wxSizeEvent& event);
+#if wxUSE_TIMER
+    void OnRelayoutTimer(wxTimerEvent& event);
+#endif // wxUSE_TIMER
     void OnDPIChanged(wxDPIChangedEvent& event);
     void OnMouseMove(wxMouseEvent& event);
     void OnMouseDown(wxMouseEvent& event);
@@ -467,6 +471,10 @@ public:
     // implementation of SetPage()
     bool DoSetPage(const wxString& source);
 
+    // incremental implementation of AppendToPage(): parses only the new
+    // fragment and splices the resulting cells into the existing page
+    bool DoAppendPage(const wxString& source);
+
 protected:
     // This is pointer to the first cell in parsed data.  (Note: the first cell
     // is usually top one = all other cells are sub-cells of this one)
@@ -518,6 +526,10 @@ private:
     // don't have any background image
     void DoEraseBackground(wxDC& dc);
 
+    // relayout the page after a size change and update everything depending
+    // on the layout (selection, shown part of the page)
+    void DoSizeRelayout();
+
     // window content for double buffered rendering, may be invalid until it is
     // really initialized in OnPaint()
     wxBitmap m_backBuffer;
@@ -552,6 +564,18 @@ private:
     // the comments near its use.
     bool m_isBgReallyErased;
 
+    // time, in milliseconds, the last CreateLayout() took: used by OnSize()
+    // to decide whether relaying the page out is cheap enough to be redone
+    // for every size event during interactive resizing or whether the
+    // relayouts should be coalesced until the size stops changing
+    long m_lastLayoutTime;
+
+#if wxUSE_TIMER
+    // the timer used for the coalesced relayouts: (re)started by OnSize(),
+    // does the single relayout when the size settles
+    wxTimer m_timerRelayout;
+#endif // wxUSE_TIMER
+
     // standard mouse cursors
     static wxCursor *ms_cursorLink;
     static wxCursor *ms_cursorText;
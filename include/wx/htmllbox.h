@@ -18,6 +18,7 @@
 #include "wx/vlbox.h"               // base class
 #include "wx/html/htmlwin.h"
 #include "wx/ctrlsub.h"
+#include "wx/vector.h"
 
 #if wxUSE_FILESYSTEM
     #include "wx/filesys.h"
@@ -77,6 +78,13 @@ public:
     virtual void RefreshAll() wxOVERRIDE;
     virtual void SetItemCount(size_t count) wxOVERRIDE;
 
+    // change the number of the parsed items we cache: the default of 50 is
+    // enough for the visible items of a typical listbox, but a bigger cache
+    // avoids re-parsing when scrolling through a long list; changing the
+    // size drops the current contents of the cache
+    void SetCellCacheSize(size_t size);
+    size_t GetCellCacheSize() const;
+
 #if wxUSE_FILESYSTEM
     // retrieve the file system used by the wxHtmlWinParser: if you use
     // relative paths in your HTML, you should use its ChangePathTo() method
@@ -155,6 +163,17 @@ private:
     // Create the cell for the given item, caller is responsible for freeing it.
     wxHtmlCell* CreateCellForItem(size_t n) const;
 
+    // remember the measured height of the given item so that scrolling over
+    // it doesn't need to parse it again
+    void CacheRowHeight(size_t n, const wxHtmlCell *cell) const;
+
+    // forget the cached heights of the items in the given (inclusive) range
+    void InvalidateRowHeights(size_t from, size_t to);
+
+    // parse one not yet cached item adjacent to the visible area, return
+    // true if this was done or false if there is nothing left to do
+    bool PreCacheAdjacentItem();
+
     // return physical coordinates of root wxHtmlCell of n-th item
     wxPoint GetRootCellCoords(size_t n) const;
 
@@ -173,6 +192,11 @@ private:
     // this class caches the pre-parsed HTML to speed up display
     wxHtmlListBoxCache *m_cache;
 
+    // the measured heights of the items, kept for all of them (unlike the
+    // parsed cells themselves) as long as the items don't change; an entry
+    // is wxDefaultCoord if the corresponding item wasn't measured yet
+    mutable wxVector<wxCoord> m_rowHeights;
+
     // HTML parser we use
     wxHtmlWinParser *m_htmlParser;
 
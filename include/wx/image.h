@@ -128,6 +128,16 @@ public:
                            bool WXUNUSED(verbose)=true )
         { return false; }
 
+    // Load only the given region of the image, with rect expressed in full
+    // resolution image coordinates, reducing it by the given integer
+    // factor: on success, the image is rect.GetSize()/downscale big. The
+    // base class version decodes the complete image and extracts the region
+    // from it afterwards; handlers of formats allowing partial decoding
+    // override it to decode only (approximately) what is needed.
+    virtual bool LoadRegion( wxImage *image, wxInputStream& stream,
+                             const wxRect& rect, int downscale = 1,
+                             bool verbose = true, int index = -1 );
+
     int GetImageCount( wxInputStream& stream );
         // save the stream position, call DoGetImageCount() and restore the position
 
@@ -165,6 +175,12 @@ protected:
 
     // save the stream position, call DoCanRead() and restore the position
     bool CallDoCanRead(wxInputStream& stream);
+
+    // helper for LoadRegion() implementations: clamp rect to the image (in
+    // its current, possibly already reduced, coordinates), crop the image
+    // to it and rescale the result to the given size
+    static bool ExtractRegion(wxImage *image, const wxRect& rect,
+                              const wxSize& sizeTarget);
 #endif // wxUSE_STREAMS
 
     // helper for the derived classes SaveFile() implementations: returns the
@@ -297,6 +313,8 @@ public:
         { Create( width, height, data, static_data ); }
     wxImage( int width, int height, unsigned char* data, unsigned char* alpha, bool static_data = false )
         { Create( width, height, data, alpha, static_data ); }
+    wxImage( int width, int height, unsigned char* data, size_t stride, bool static_data = false )
+        { Create( width, height, data, stride, static_data ); }
 
     // ctor variants using wxSize:
     wxImage( const wxSize& sz, bool clear = true )
@@ -326,6 +344,14 @@ public:
     bool Create( int width, int height, unsigned char* data, bool static_data = false );
     bool Create( int width, int height, unsigned char* data, unsigned char* alpha, bool static_data = false );
 
+    // Use a caller-provided RGB buffer whose rows are stride bytes apart:
+    // when stride is exactly width*3 this is equivalent to the overload
+    // above, i.e. the buffer is used directly without copying it (and not
+    // even freed if static_data is true); otherwise the rows are copied,
+    // without their padding, into a packed buffer of our own.
+    bool Create( int width, int height, unsigned char* data, size_t stride,
+                 bool static_data = false );
+
     // Create() variants using wxSize:
     bool Create( const wxSize& sz, bool clear = true )
         { return Create(sz.GetWidth(), sz.GetHeight(), clear); }
@@ -346,6 +372,15 @@ public:
     // return the new image with size width*height
     wxImage GetSubImage( const wxRect& rect) const;
 
+    // Return a sub image sharing the pixel buffer of this one instead of
+    // copying it, which is only possible if rect spans the full image
+    // width as the rows of an image must be contiguous (otherwise this
+    // simply returns GetSubImage()). The view doesn't own the shared
+    // buffer: it must not be used after this image has been destroyed or
+    // reallocated, and writing to the view modifies this image directly,
+    // bypassing the usual copy-on-write.
+    wxImage SubImageView( const wxRect& rect ) const;
+
     // Paste the image or part of this image into an image of the given size at the pos
     //  any newly exposed areas will be filled with the rgb colour
     //  by default if r = g = b = -1 then fill with this image's mask colour or find and
@@ -466,6 +501,14 @@ public:
     static void SetDefaultLoadFlags(int flags);
     static int GetDefaultLoadFlags();
 
+    // Set the number of threads used by the resampling methods called from
+    // Scale(): 1 (default) keeps the traditional serial loops, 0 means "use
+    // as many threads as there are CPUs" and any other value gives the
+    // number of threads to use. The results are bit-identical whatever the
+    // number of threads.
+    static void SetResampleThreadCount(int count);
+    static int GetResampleThreadCount();
+
     void SetLoadFlags(int flags);
     int GetLoadFlags() const;
 
@@ -518,6 +561,25 @@ public:
     void InitAlpha();
     void ClearAlpha();
 
+    // premultiplied alpha support: images normally store straight RGB
+    // values, but storing them premultiplied by the alpha channel lets the
+    // conversion to the native bitmap formats wanting premultiplied data
+    // (e.g. for ::AlphaBlend() under MSW) copy the pixels directly instead
+    // of multiplying each of them again for every conversion
+
+    // return true if the image has an alpha channel and its RGB data is
+    // premultiplied by it
+    bool HasPremultipliedAlpha() const;
+
+    // multiply (or divide again) the RGB values by the alpha channel in
+    // place; these are no-ops if the image is already in the wanted form
+    void PremultiplyAlpha();
+    void UnpremultiplyAlpha();
+
+    // just mark the data as (not) premultiplied without converting it, for
+    // use with externally produced buffers which already are
+    void SetPremultipliedAlpha(bool premultiplied = true);
+
     // return true if this pixel is masked or has alpha less than specified
     // threshold
     bool IsTransparent(int x, int y,
@@ -582,10 +644,20 @@ public:
     // corresponds to +100 percent.
     void ChangeHSV(double angleH, double factorS, double factorV);
 
-    static wxList& GetHandlers() { return sm_handlers; }
+    static wxList& GetHandlers();
     static void AddHandler( wxImageHandler *handler );
     static void InsertHandler( wxImageHandler *handler );
     static bool RemoveHandler( const wxString& name );
+
+    // register a handler of the given type lazily: the factory function is
+    // only called to create it when the handler is first needed; signature
+    // may contain the leading magic bytes of the format (NULL for formats
+    // without any signature), allowing the format of a stream to be
+    // recognized, and the right handler created, from a single header read
+    static void AddLazyHandler( wxImageHandler *(*factory)(),
+                                wxBitmapType type,
+                                const void *signature = NULL,
+                                size_t sigLength = 0 );
     static wxImageHandler *FindHandler( const wxString& name );
     static wxImageHandler *FindHandler( const wxString& extension, wxBitmapType imageType );
     static wxImageHandler *FindHandler( wxBitmapType imageType );
@@ -600,6 +672,17 @@ public:
     static HSVValue RGBtoHSV(const RGBValue& rgb);
     static RGBValue HSVtoRGB(const HSVValue& hsv);
 
+    // batch versions of the HSV adjustments above operating on a raw buffer
+    // of numPixels interleaved RGB triplets, usable without a wxImage; the
+    // parameters have the same meaning as for the methods with the same name
+    static void RotateHue(unsigned char *rgb, size_t numPixels, double angle);
+    static void ChangeSaturation(unsigned char *rgb, size_t numPixels,
+                                 double factor);
+    static void ChangeBrightness(unsigned char *rgb, size_t numPixels,
+                                 double factor);
+    static void ChangeHSV(unsigned char *rgb, size_t numPixels,
+                          double angleH, double factorS, double factorV);
+
 #if WXWIN_COMPATIBILITY_2_8
     wxDEPRECATED_CONSTRUCTOR(
         wxImage(const wxString& name, long type, int index = -1)
@@ -676,6 +759,10 @@ protected:
     template <typename T>
     void ApplyToAllPixels(void (*filter)(wxImage *, unsigned char *, T), T value);
 
+    // common part of RotateHue() and Change{Saturation,Brightness,HSV}()
+    // applying the adjustments to all pixels, possibly in parallel
+    void DoAdjustHSV(double angleH, double factorS, double factorV);
+
 private:
     friend class WXDLLIMPEXP_FWD_CORE wxImageHandler;
 
@@ -20,6 +20,12 @@
 #include "wx/image.h"
 #include "wx/versioninfo.h"
 
+// Reduced-scale decoding: set this option on the image before loading to
+// decode at 1/2, 1/4 or 1/8 of the full resolution, which is much faster
+// and uses correspondingly less memory, e.g. for generating thumbnails.
+// Other values are rounded down to the nearest supported scale.
+#define wxIMAGE_OPTION_JPEG_SCALE_DENOM  wxString(wxS("JpegScaleDenom"))
+
 class WXDLLIMPEXP_CORE wxJPEGHandler: public wxImageHandler
 {
 public:
@@ -38,6 +44,12 @@ public:
 #if wxUSE_STREAMS
     virtual bool LoadFile( wxImage *image, wxInputStream& stream, bool verbose=true, int index=-1 ) wxOVERRIDE;
     virtual bool SaveFile( wxImage *image, wxOutputStream& stream, bool verbose=true ) wxOVERRIDE;
+
+    // Uses DCT-domain scaling to decode at the nearest of 1/2, 1/4 or 1/8
+    // of the full resolution before extracting the region.
+    virtual bool LoadRegion( wxImage *image, wxInputStream& stream,
+                             const wxRect& rect, int downscale = 1,
+                             bool verbose = true, int index = -1 ) wxOVERRIDE;
 protected:
     virtual bool DoCanRead( wxInputStream& stream ) wxOVERRIDE;
 #endif
@@ -27,6 +27,7 @@
 #define wxIMAGE_OPTION_PNG_COMPRESSION_MEM_LEVEL   wxT("PngZM")
 #define wxIMAGE_OPTION_PNG_COMPRESSION_STRATEGY    wxT("PngZS")
 #define wxIMAGE_OPTION_PNG_COMPRESSION_BUFFER_SIZE wxT("PngZB")
+#define wxIMAGE_OPTION_PNG_THREADS wxT("PngThreads")
 
 enum
 {
@@ -60,6 +61,63 @@ private:
     wxDECLARE_DYNAMIC_CLASS(wxPNGHandler);
 };
 
+#if wxUSE_STREAMS
+
+//-----------------------------------------------------------------------------
+// wxPNGStreamEncoder
+//-----------------------------------------------------------------------------
+
+class wxPNGEncoderImpl;
+
+// This class writes a PNG file incrementally, band by band, so that a
+// (possibly huge) image can be encoded without its full pixel data ever
+// existing in memory at once: Start() writes the header, each WriteRows()
+// call compresses the next rows and Finish() completes the file.
+//
+// Only 8-bit RGB and RGBA data can be written like this, use
+// wxPNGHandler::SaveFile() for the other formats.
+class WXDLLIMPEXP_CORE wxPNGStreamEncoder
+{
+public:
+    wxPNGStreamEncoder();
+
+    // the dtor abandons the file if Finish() hasn't been called
+    ~wxPNGStreamEncoder();
+
+    // set the zlib compression level (0..9), -1 by default meaning to use
+    // the zlib default; must be called before Start() to have any effect
+    void SetCompressionLevel(int level) { m_compressionLevel = level; }
+
+    // set the number of threads used for preparing the rows for libpng:
+    // 0 (default) to use one per available CPU, 1 to do everything in the
+    // calling thread
+    void SetThreadCount(int count) { m_numThreads = count; }
+
+    // start writing an image of the given total size to the stream, which
+    // must remain alive until Finish() is called; if withAlpha is true,
+    // WriteRows() expects an alpha channel as well
+    bool Start(wxOutputStream& stream, int width, int height,
+               bool withAlpha = false);
+
+    // encode the next numRows rows of the image: rgb points to
+    // numRows*width RGB triplets and alpha, used only if the encoder was
+    // started with an alpha channel, to numRows*width alpha bytes
+    bool WriteRows(const unsigned char *rgb, const unsigned char *alpha,
+                   int numRows);
+
+    // write the PNG trailer after all the rows have been written
+    bool Finish();
+
+private:
+    wxPNGEncoderImpl *m_impl;
+    int m_compressionLevel;
+    int m_numThreads;
+
+    wxDECLARE_NO_COPY_CLASS(wxPNGStreamEncoder);
+};
+
+#endif // wxUSE_STREAMS
+
 #endif
   // wxUSE_LIBPNG
 
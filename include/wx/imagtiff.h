@@ -44,6 +44,12 @@ public:
     virtual bool LoadFile( wxImage *image, wxInputStream& stream, bool verbose=true, int index=-1 ) wxOVERRIDE;
     virtual bool SaveFile( wxImage *image, wxOutputStream& stream, bool verbose=true ) wxOVERRIDE;
 
+    // Decodes only the strips or tiles overlapping the requested region, so
+    // viewing a small part of a huge image doesn't decode all of it.
+    virtual bool LoadRegion( wxImage *image, wxInputStream& stream,
+                             const wxRect& rect, int downscale = 1,
+                             bool verbose = true, int index = -1 ) wxOVERRIDE;
+
 protected:
     virtual int DoGetImageCount( wxInputStream& stream ) wxOVERRIDE;
     virtual bool DoCanRead( wxInputStream& stream ) wxOVERRIDE;
@@ -0,0 +1,96 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/lazypanel.h
+// Purpose:     wxLazyPanel: a panel creating its children on first show
+// Author:      wxWidgets team
+// Copyright:   (c) wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_LAZYPANEL_H_
+#define _WX_LAZYPANEL_H_
+
+#include "wx/panel.h"
+
+// ----------------------------------------------------------------------------
+// wxLazyPanel: a panel which defers creating its children until it is shown
+// ----------------------------------------------------------------------------
+
+// This class is useful for the pages of the book controls (and, more
+// generally, any panes which may never become visible at all): deriving the
+// pages from it and creating their controls in the overridden CreateContent()
+// means that only the pages actually visited by the user are ever fully
+// created, which can speed up the creation of dialogs with many pages
+// considerably.
+
+class WXDLLIMPEXP_CORE wxLazyPanel : public wxPanel
+{
+public:
+    wxLazyPanel() { Init(); }
+
+    wxLazyPanel(wxWindow *parent,
+                wxWindowID winid = wxID_ANY,
+                const wxPoint& pos = wxDefaultPosition,
+                const wxSize& size = wxDefaultSize,
+                long style = wxTAB_TRAVERSAL | wxNO_BORDER,
+                const wxString& name = wxASCII_STR(wxPanelNameStr))
+    {
+        Init();
+
+        Create(parent, winid, pos, size, style, name);
+    }
+
+    // return true if CreateContent() had already been called
+    bool IsRealized() const { return m_realized; }
+
+    // create the contents now if this hadn't been done yet: this is done
+    // automatically when the panel is shown, but may also be called
+    // explicitly, e.g. before accessing the panel children from code
+    void Realize()
+    {
+        if ( m_realized )
+            return;
+
+        // set the flag first to prevent CreateContent() from being called
+        // again if creating the children shows the panel recursively
+        m_realized = true;
+
+        CreateContent();
+
+        Layout();
+    }
+
+    virtual bool Show(bool show = true) wxOVERRIDE
+    {
+        if ( show )
+            Realize();
+
+        return wxPanel::Show(show);
+    }
+
+    virtual void OnInternalIdle() wxOVERRIDE
+    {
+        // catch the cases in which the panel becomes visible without going
+        // through our Show(), e.g. when it is the initially selected page
+        // of a native book control
+        if ( !m_realized && IsShownOnScreen() )
+            Realize();
+
+        wxPanel::OnInternalIdle();
+    }
+
+protected:
+    // called at most once, just before the panel becomes visible for the
+    // first time, and must create the panel children
+    virtual void CreateContent() = 0;
+
+private:
+    void Init() { m_realized = false; }
+
+    // true if CreateContent() had already been called
+    bool m_realized;
+
+    wxDECLARE_ABSTRACT_CLASS(wxLazyPanel);
+    wxDECLARE_NO_COPY_CLASS(wxLazyPanel);
+};
+
+#endif // _WX_LAZYPANEL_H_
@@ -63,6 +63,7 @@ class WXDLLIMPEXP_FWD_BASE wxObject;
 #include "wx/hashmap.h"
 #include "wx/msgout.h"
 #include "wx/time.h"
+#include "wx/vector.h"
 
 #if wxUSE_THREADS
     #include "wx/thread.h"
@@ -731,6 +732,56 @@ private:
 };
 
 
+// log target keeping the last N records, with all their fields (level,
+// timestamp, component, ...), in a fixed size ring buffer: appending is O(1)
+// however long the program has been running, which makes it suitable for an
+// always-on in-application log console, e.g. together with a wxListCtrl in
+// virtual mode displaying the stored records
+class WXDLLIMPEXP_BASE wxLogRingBuffer : public wxLog
+{
+public:
+    // maxRecords is the maximal number of records stored, the oldest records
+    // are overwritten once it is reached
+    explicit wxLogRingBuffer(size_t maxRecords = 1000)
+        : m_maxRecords(maxRecords ? maxRecords : 1),
+          m_next(0)
+    {
+    }
+
+    // the number of records currently stored, at most GetMaxRecords()
+    size_t GetCount() const { return m_records.size(); }
+
+    size_t GetMaxRecords() const { return m_maxRecords; }
+
+    // get the n-th record, n must be less than GetCount(); the records are
+    // ordered from the oldest one still stored to the most recent one
+    const wxLogRecord& GetRecord(size_t n) const;
+
+    // remove all stored records
+    void Clear();
+
+protected:
+    virtual void DoLogRecord(wxLogLevel level,
+                             const wxString& msg,
+                             const wxLogRecordInfo& info) wxOVERRIDE;
+
+    // called after each stored record, override it to e.g. refresh a window
+    // displaying the records
+    virtual void OnRecordAdded() { }
+
+private:
+    const size_t m_maxRecords;
+
+    // the position which will be overwritten next once the buffer is full,
+    // i.e. the index of the oldest stored record, always 0 until then
+    size_t m_next;
+
+    wxVector<wxLogRecord> m_records;
+
+    wxDECLARE_NO_COPY_CLASS(wxLogRingBuffer);
+};
+
+
 // log everything to a "FILE *", stderr by default
 class WXDLLIMPEXP_BASE wxLogStderr : public wxLog,
                                      protected wxMessageOutputStderr
@@ -770,6 +821,66 @@ protected:
 
 #endif // wxUSE_STD_IOSTREAM
 
+#if wxUSE_THREADS
+
+// ----------------------------------------------------------------------------
+// asynchronous log target: queue the records and let a dedicated thread
+// format and write them to the real target, so that logging from time
+// critical threads never blocks on the output
+// ----------------------------------------------------------------------------
+
+class wxLogAsyncThread;
+
+class WXDLLIMPEXP_BASE wxLogAsync : public wxLog
+{
+public:
+    // what to do when records are produced faster than the worker thread
+    // writes them out and the queue is full
+    enum Overflow
+    {
+        Overflow_Drop,  // discard the new records, count them and log how
+                        // many were lost once there is space again
+        Overflow_Wait   // block until the worker catches up
+    };
+
+    // create the target forwarding the records to the given one, which must
+    // not be NULL and which we take ownership of, from a worker thread
+    //
+    // at most capacity records are queued, see Overflow for what happens
+    // when the queue is full
+    explicit wxLogAsync(wxLog *target,
+                        size_t capacity = 16384,
+                        Overflow overflow = Overflow_Drop);
+
+    // the dtor writes out all still queued records before destroying the
+    // target
+    virtual ~wxLogAsync();
+
+    // the target all records end up in
+    wxLog *GetTarget() const { return m_target; }
+
+    // wait until everything queued so far has been given to the target and
+    // flush the latter; called automatically when a fatal error is logged
+    virtual void Flush() wxOVERRIDE;
+
+protected:
+    // queue the record for the worker thread
+    virtual void DoLogRecord(wxLogLevel level,
+                             const wxString& msg,
+                             const wxLogRecordInfo& info) wxOVERRIDE;
+
+private:
+    // the real target, owned by us
+    wxLog* const m_target;
+
+    // the worker thread writing the records out, created in the ctor
+    wxLogAsyncThread *m_thread;
+
+    wxDECLARE_NO_COPY_CLASS(wxLogAsync);
+};
+
+#endif // wxUSE_THREADS
+
 // ----------------------------------------------------------------------------
 // /dev/null log target: suppress logging until this object goes out of scope
 // ----------------------------------------------------------------------------
@@ -20,6 +20,7 @@
 // ----------------------------------------------------------------------------
 
 #include "wx/list.h"        // for "template" list classes
+#include "wx/hashmap.h"     // for the item lookup map of wxMenuBar
 #include "wx/window.h"      // base class for wxMenuBar
 
 // also include this one to ensure compatibility with old code which only
@@ -36,6 +37,12 @@ class WXDLLIMPEXP_FWD_CORE wxMenuItem;
 WX_DECLARE_EXPORTED_LIST(wxMenu, wxMenuList);
 WX_DECLARE_EXPORTED_LIST(wxMenuItem, wxMenuItemList);
 
+// map used by wxMenuBar to find the items by id without traversing all the
+// menus linearly every time
+WX_DECLARE_EXPORTED_HASH_MAP(int, wxMenuItem *,
+                             wxIntegerHash, wxIntegerEqual,
+                             wxMenuItemIdMap);
+
 // ----------------------------------------------------------------------------
 // wxMenu
 // ----------------------------------------------------------------------------
@@ -559,6 +566,16 @@ public:
 
     virtual bool CanBeOutsideClientArea() const wxOVERRIDE { return true; }
 
+    // forget the cached id -> item map used by FindItem(), it is rebuilt
+    // during the next search; this is called by wxMenu code whenever the
+    // contents of any of our menus changes and normally doesn't need to be
+    // called directly
+    void InvalidateFindItemCache()
+    {
+        m_itemsById.clear();
+        m_itemsByIdValid = false;
+    }
+
 #if wxUSE_EXTENDED_RTTI
     // XTI helpers:
     bool AppendMenuInfo( const wxMenuInfoHelper *info )
@@ -586,6 +603,16 @@ protected:
     // the frame we are attached to (may be NULL)
     wxFrame *m_menuBarFrame;
 
+private:
+    // add all the items of the given menu and its submenus to the map
+    void DoCacheMenuItems(const wxMenuBase *menu) const;
+
+    // map allowing to find the items by id in O(1) instead of traversing all
+    // the menus each time, filled on demand by FindItem() and invalidated by
+    // InvalidateFindItemCache() whenever the menus change
+    mutable wxMenuItemIdMap m_itemsById;
+    mutable bool m_itemsByIdValid;
+
     wxDECLARE_NO_COPY_CLASS(wxMenuBarBase);
 };
 #endif
@@ -24,7 +24,7 @@ typedef wxVector<wxModule*> wxModuleList;
 class WXDLLIMPEXP_BASE wxModule : public wxObject
 {
 public:
-    wxModule() {}
+    wxModule() { m_lazy = false; }
     virtual ~wxModule() {}
 
     // if module init routine returns false the application
@@ -50,6 +50,12 @@ public:
     static void CleanUpModules();
     static bool AreInitialized() { return ms_areInitialized; }
 
+    // initialize the module of the given class, and its dependencies, right
+    // now if this hadn't been done yet: this must be called before using a
+    // subsystem whose module declared itself as initialized on demand (see
+    // InitializeOnDemand()), returns false on initialization failure
+    static bool EnsureInitialized(wxClassInfo *classInfo);
+
     // used by wxObjectLoader when unloading shared libs's
 
     static void UnregisterModule(wxModule *module);
@@ -76,6 +82,14 @@ protected:
         m_namedDependencies.push_back(wxASCII_STR(className));
     }
 
+    // a module calling this function from its constructor is not initialized
+    // at startup by InitializeModules() but only by the first call to
+    // EnsureInitialized() for it (or when another module depends on it),
+    // cutting the startup time of the programs never using its subsystem;
+    // only use it for modules whose users are guaranteed to call
+    // EnsureInitialized() before relying on them
+    void InitializeOnDemand() { m_lazy = true; }
+
 
 private:
     // initialize module and Append it to initializedModules list recursively
@@ -109,6 +123,10 @@ private:
         State_Initialized   // module initialized successfully
     } m_state;
 
+    // true if the module is initialized on demand only, see
+    // InitializeOnDemand()
+    bool m_lazy;
+
 
     wxDECLARE_CLASS(wxModule);
 };
@@ -28,7 +28,8 @@ enum wxMessageQueueError
 {
     wxMSGQUEUE_NO_ERROR = 0, // operation completed successfully
     wxMSGQUEUE_TIMEOUT,      // no messages received before timeout expired
-    wxMSGQUEUE_MISC_ERROR    // some unexpected (and fatal) error has occurred
+    wxMSGQUEUE_MISC_ERROR,   // some unexpected (and fatal) error has occurred
+    wxMSGQUEUE_FULL          // no space left in a bounded queue (wxSpscQueue)
 };
 
 // ---------------------------------------------------------------------------
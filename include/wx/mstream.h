@@ -45,6 +45,18 @@ public:
     wxStreamBuffer *GetInputStreamBuffer() const { return m_i_streambuf; }
 
 protected:
+    // ctor for the derived classes initializing the buffer later using
+    // InitBuffer()
+    wxMemoryInputStream()
+    {
+        m_i_streambuf = NULL;
+        m_length = 0;
+    }
+
+    // initialize the stream to read from the given buffer, which must remain
+    // valid for the lifetime of the stream
+    void InitBuffer(const void *data, size_t len);
+
     wxStreamBuffer *m_i_streambuf;
 
     size_t OnSysRead(void *buffer, size_t nbytes) wxOVERRIDE;
@@ -62,6 +74,64 @@ private:
     wxDECLARE_NO_ASSIGN_CLASS(wxMemoryInputStream);
 };
 
+// ----------------------------------------------------------------------------
+// wxMappedInputStream: read-only stream on top of a memory-mapped file
+// ----------------------------------------------------------------------------
+
+#if defined(__WINDOWS__) || defined(__UNIX__)
+    #define wxHAS_MAPPED_INPUT_STREAM
+#endif
+
+#ifdef wxHAS_MAPPED_INPUT_STREAM
+
+// Hints for wxMappedInputStream::Advise() about the expected access pattern.
+enum wxMappedAccess
+{
+    wxMAPPED_ACCESS_NORMAL,     // no particular access pattern
+    wxMAPPED_ACCESS_SEQUENTIAL, // the data will be read once from the start
+    wxMAPPED_ACCESS_RANDOM,     // the data will be accessed in random order
+    wxMAPPED_ACCESS_WILLNEED    // the data will be needed soon, prefetch it
+};
+
+// Unlike wxFileInputStream, this stream doesn't copy anything: the file
+// contents are mapped into the address space of the process and paged in by
+// the OS on demand, so even huge files can be opened without reading them
+// upfront. The stream is invalid (IsOk() returns false) if the file couldn't
+// be opened or mapped.
+class WXDLLIMPEXP_BASE wxMappedInputStream : public wxMemoryInputStream
+{
+public:
+    wxMappedInputStream(const wxString& filename);
+    virtual ~wxMappedInputStream();
+
+    // Direct zero-copy access to the mapped file contents: the pointer
+    // remains valid for the lifetime of this stream.
+    const void *GetData() const { return m_addr; }
+    size_t GetDataLen() const { return m_mapLength; }
+
+    // Hint the OS about the expected access pattern: this can make paging
+    // the data in much more efficient. Does nothing on the platforms
+    // without an equivalent of madvise().
+    void Advise(wxMappedAccess access);
+
+private:
+    // unmap the file if it had been mapped successfully
+    void Unmap();
+
+    void *m_addr;
+    size_t m_mapLength;
+
+#ifdef __WINDOWS__
+    WXHANDLE m_hFile;
+    WXHANDLE m_hMapping;
+#endif
+
+    wxDECLARE_ABSTRACT_CLASS(wxMappedInputStream);
+    wxDECLARE_NO_COPY_CLASS(wxMappedInputStream);
+};
+
+#endif // wxHAS_MAPPED_INPUT_STREAM
+
 class WXDLLIMPEXP_BASE wxMemoryOutputStream : public wxOutputStream
 {
 public:
@@ -87,6 +157,52 @@ protected:
     wxDECLARE_NO_COPY_CLASS(wxMemoryOutputStream);
 };
 
+// ----------------------------------------------------------------------------
+// wxMappedOutputStream: stream writing into a memory-mapped file
+// ----------------------------------------------------------------------------
+
+#ifdef wxHAS_MAPPED_INPUT_STREAM
+
+// This stream (re)creates a file of the given, fixed, size and writes to it
+// directly through a memory mapping, without any intermediate buffers.
+// Writing past the end of the preallocated size fails, so it is only useful
+// when the final file size (or at least an upper bound for it) is known in
+// advance. The stream is invalid (IsOk() returns false) if the file couldn't
+// be created or mapped.
+class WXDLLIMPEXP_BASE wxMappedOutputStream : public wxMemoryOutputStream
+{
+public:
+    wxMappedOutputStream(const wxString& filename, wxFileOffset len);
+    virtual ~wxMappedOutputStream();
+
+    // Direct zero-copy access to the mapped file contents: the pointer
+    // remains valid for the lifetime of this stream.
+    void *GetData() const { return m_addr; }
+    size_t GetDataLen() const { return m_mapLength; }
+
+    // Synchronously flush the data written so far to disk. Notice that the
+    // OS writes the modified pages back in any case, this only needs to be
+    // called if durability is required at a particular moment.
+    bool Flush();
+
+private:
+    // unmap the file if it had been mapped successfully
+    void Unmap();
+
+    void *m_addr;
+    size_t m_mapLength;
+
+#ifdef __WINDOWS__
+    WXHANDLE m_hFile;
+    WXHANDLE m_hMapping;
+#endif
+
+    wxDECLARE_ABSTRACT_CLASS(wxMappedOutputStream);
+    wxDECLARE_NO_COPY_CLASS(wxMappedOutputStream);
+};
+
+#endif // wxHAS_MAPPED_INPUT_STREAM
+
 #endif
   // wxUSE_STREAMS
 
@@ -17,6 +17,7 @@
 // ----------------------------------------------------------------------------
 
 #include "wx/memory.h"
+#include "wx/atomic.h"
 
 #define wxDECLARE_CLASS_INFO_ITERATORS()                                     \
 class WXDLLIMPEXP_BASE const_iterator                                    \
@@ -225,6 +226,18 @@ inline T *wxCheckCast(const void *ptr)
 // wxRefCounter: ref counted data "manager"
 // ----------------------------------------------------------------------------
 
+// Use an atomic reference count on the platforms providing cheap lock-free
+// operations for it: this makes sharing the reference counted objects, and
+// so the COW classes using them such as the GDI objects, between threads
+// safe as long as the shared instances themselves are not modified. The
+// only platforms without wxHAS_ATOMIC_OPS would have to take a critical
+// section for every IncRef() and DecRef(), so they keep using a plain int
+// and must clone the objects before passing them to another thread, as
+// before.
+#ifdef wxHAS_ATOMIC_OPS
+    #define wxHAS_ATOMIC_REF_COUNT
+#endif
+
 class WXDLLIMPEXP_BASE wxRefCounter
 {
 public:
@@ -232,7 +245,11 @@ public:
 
     int GetRefCount() const { return m_count; }
 
+#ifdef wxHAS_ATOMIC_REF_COUNT
+    void IncRef() { wxAtomicInc(m_count); }
+#else
     void IncRef() { m_count++; }
+#endif
     void DecRef();
 
 protected:
@@ -242,7 +259,11 @@ protected:
 
 private:
     // our refcount:
+#ifdef wxHAS_ATOMIC_REF_COUNT
+    wxAtomicInt m_count;
+#else
     int m_count;
+#endif
 
     // It doesn't make sense to copy the reference counted objects, a new ref
     // counter should be created for a new object instead and compilation
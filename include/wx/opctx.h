@@ -0,0 +1,195 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/opctx.h
+// Purpose:     wxOperationContext class
+// Created:     2022-04-20
+// Copyright:   (c) 2022 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_OPCTX_H_
+#define _WX_OPCTX_H_
+
+#include "wx/defs.h"
+#include "wx/longlong.h"
+#include "wx/stopwatch.h"
+#include "wx/thread.h"
+
+// ----------------------------------------------------------------------------
+// wxOperationContext: cooperative cancellation and progress for long calls
+// ----------------------------------------------------------------------------
+
+// An object of this class can be passed to the functions supporting it (e.g.
+// wxInputStream::Read(wxOutputStream&) overload or wxDir::Traverse()) to
+// allow interrupting them from another thread and monitoring their progress
+// without any per-iteration wxYield() hacks: the operation periodically calls
+// AddProgress() and stops as soon as possible after Cancel() was called.
+//
+// To be notified about the progress, derive from this class and override
+// OnProgress(): it is called, from the thread running the operation, at most
+// once per progress interval (100ms by default) however often the operation
+// itself updates the counter.
+class wxOperationContext
+{
+public:
+    wxOperationContext()
+        : m_timeLastNotify(0),
+          m_total(0, 0),
+          m_done(0, 0),
+          m_progressInterval(100),
+          m_cancelled(false),
+          m_notifiedOnce(false)
+    {
+    }
+
+    virtual ~wxOperationContext() { }
+
+
+    // cancellation
+    // ------------
+
+    // ask the running operation to stop: it will return, without finishing
+    // its work, as soon as it checks the flag; can be called from any thread
+    void Cancel()
+    {
+#if wxUSE_THREADS
+        wxCriticalSectionLocker lock(m_cs);
+#endif
+        m_cancelled = true;
+    }
+
+    // return true if Cancel() was called
+    bool IsCancelled() const
+    {
+#if wxUSE_THREADS
+        wxCriticalSectionLocker lock(m_cs);
+#endif
+        return m_cancelled;
+    }
+
+
+    // progress
+    // --------
+
+    // set the total amount of work, in operation-defined units (bytes,
+    // files, ...), if it is known in advance; 0, the default, means that the
+    // total is unknown
+    void SetProgressTotal(wxULongLong total)
+    {
+#if wxUSE_THREADS
+        wxCriticalSectionLocker lock(m_cs);
+#endif
+        m_total = total;
+    }
+
+    wxULongLong GetProgressTotal() const
+    {
+#if wxUSE_THREADS
+        wxCriticalSectionLocker lock(m_cs);
+#endif
+        return m_total;
+    }
+
+    // the amount of work done so far
+    wxULongLong GetProgressDone() const
+    {
+#if wxUSE_THREADS
+        wxCriticalSectionLocker lock(m_cs);
+#endif
+        return m_done;
+    }
+
+    // set the minimal interval, in milliseconds, between two OnProgress()
+    // calls; 0 means to call it every time the counter advances
+    void SetProgressInterval(long milliseconds)
+    {
+#if wxUSE_THREADS
+        wxCriticalSectionLocker lock(m_cs);
+#endif
+        m_progressInterval = milliseconds;
+    }
+
+    long GetProgressInterval() const
+    {
+#if wxUSE_THREADS
+        wxCriticalSectionLocker lock(m_cs);
+#endif
+        return m_progressInterval;
+    }
+
+    // called by the operation itself: advance the progress counter by the
+    // given number of units and return true if the operation should
+    // continue, i.e. false if it was cancelled
+    bool AddProgress(wxULongLong increment = wxULongLong(0, 1))
+    {
+        wxULongLong done, total;
+        bool notify = false;
+
+        {
+#if wxUSE_THREADS
+            wxCriticalSectionLocker lock(m_cs);
+#endif
+            if ( m_cancelled )
+                return false;
+
+            m_done += increment;
+
+            // Throttle the notifications: always deliver the first one and
+            // the one reaching the known total, otherwise respect the
+            // interval.
+            if ( !m_notifiedOnce ||
+                    (m_total != wxULongLong(0, 0) && m_done >= m_total) ||
+                        m_stopWatch.Time() - m_timeLastNotify >=
+                            m_progressInterval )
+            {
+                m_notifiedOnce = true;
+                m_timeLastNotify = m_stopWatch.Time();
+
+                done = m_done;
+                total = m_total;
+                notify = true;
+            }
+        }
+
+        // call the handler outside of the critical section to allow it to
+        // use the other methods of this object freely
+        if ( notify )
+            OnProgress(done, total);
+
+        return true;
+    }
+
+protected:
+    // override this to be notified about the progress of the operation; it
+    // is called from the thread running the operation, so use CallAfter() or
+    // an event if the handler needs to update the UI
+    virtual void OnProgress(const wxULongLong& WXUNUSED(done),
+                            const wxULongLong& WXUNUSED(total))
+    {
+    }
+
+private:
+#if wxUSE_THREADS
+    // protects all the fields below
+    mutable wxCriticalSection m_cs;
+#endif
+
+    // measures the time since the creation of the context, used for
+    // throttling the notifications
+    wxStopWatch m_stopWatch;
+
+    // the time of the last OnProgress() call, only valid if m_notifiedOnce
+    long m_timeLastNotify;
+
+    wxULongLong m_total,
+                m_done;
+
+    long m_progressInterval;
+
+    bool m_cancelled;
+
+    bool m_notifiedOnce;
+
+    wxDECLARE_NO_COPY_CLASS(wxOperationContext);
+};
+
+#endif // _WX_OPCTX_H_
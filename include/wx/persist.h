@@ -18,6 +18,25 @@ class wxPersistentObject;
 
 WX_DECLARE_VOIDPTR_HASH_MAP(wxPersistentObject *, wxPersistentObjectsMap);
 
+// helper struct used by wxPersistenceManager to buffer the values saved
+// during a save batch, see BeginSaveBatch(); not for use outside of it
+struct wxPersistenceBatchedValue
+{
+    enum Type
+    {
+        Type_Bool,
+        Type_Long,
+        Type_String
+    };
+
+    Type type;
+    long numValue;
+    wxString strValue;
+};
+
+WX_DECLARE_STRING_HASH_MAP(wxPersistenceBatchedValue,
+                           wxPersistenceBatchedValuesMap);
+
 // ----------------------------------------------------------------------------
 // global functions
 // ----------------------------------------------------------------------------
@@ -96,6 +115,17 @@ public:
     void Save(void *obj);
     bool Restore(void *obj);
 
+    // batch the saves: between BeginSaveBatch() and the matching
+    // EndSaveBatch() the values passed to SaveValue() are only buffered in
+    // memory and are written to the config, which is then flushed a single
+    // time, by the outermost EndSaveBatch() only -- this is much faster
+    // than doing one config write per value when saving the state of many
+    // objects at once, e.g. when the application exits
+    //
+    // the calls to these functions can be nested but must be balanced
+    void BeginSaveBatch();
+    void EndSaveBatch();
+
     // combines both Save() and Unregister() calls
     void SaveAndUnregister(void *obj)
     {
@@ -144,6 +174,8 @@ protected:
     {
         m_doSave =
         m_doRestore = true;
+
+        m_saveBatchDepth = 0;
     }
 
 
@@ -163,6 +195,14 @@ private:
     // wxPersistentObjects as values
     wxPersistentObjectsMap m_persistentObjects;
 
+    // the values buffered while a save batch is active, keyed by the full
+    // config paths returned by GetKey()
+    wxPersistenceBatchedValuesMap m_batchedValues;
+
+    // number of nested BeginSaveBatch() calls without matching
+    // EndSaveBatch() yet, the values are buffered while it is non-null
+    int m_saveBatchDepth;
+
     // true if we should restore/save the settings (it doesn't make much sense
     // to use this class when both of them are false but setting one of them to
     // false may make sense in some situations)
@@ -19,7 +19,15 @@ enum wxFDIODispatcherEntryFlags
     wxFDIO_INPUT = 1,
     wxFDIO_OUTPUT = 2,
     wxFDIO_EXCEPTION = 4,
-    wxFDIO_ALL = wxFDIO_INPUT | wxFDIO_OUTPUT | wxFDIO_EXCEPTION
+    wxFDIO_ALL = wxFDIO_INPUT | wxFDIO_OUTPUT | wxFDIO_EXCEPTION,
+
+    // this is not another event set but a modifier for the other flags: it
+    // requests edge-triggered notifications from the dispatchers supporting
+    // them (epoll and kqueue), i.e. a single notification per readiness
+    // change instead of one per poll while the condition lasts -- which
+    // scales better but requires the handler to always drain the descriptor
+    // until it would block; it is simply ignored by wxSelectDispatcher
+    wxFDIO_EDGE_TRIGGERED = 8
 };
 
 // base class for wxSelectDispatcher and wxEpollDispatcher
@@ -28,6 +36,33 @@ class WXDLLIMPEXP_BASE wxFDIODispatcher
 public:
     enum { TIMEOUT_INFINITE = -1 };
 
+    // the kind of the implementation used by the global dispatcher
+    enum Kind
+    {
+        Kind_Default,   // the best one available on this system
+        Kind_Select,    // wxSelectDispatcher
+        Kind_Epoll,     // wxEpollDispatcher (Linux only)
+        Kind_Kqueue     // wxKqueueDispatcher (BSD systems including OS X)
+    };
+
+    // simple statistics about the events dispatched by this dispatcher,
+    // useful for tuning servers handling many connections
+    struct Stats
+    {
+        Stats() { Reset(); }
+
+        void Reset()
+        {
+            numWakeups =
+            numEvents = 0;
+            maxEventsPerWakeup = 0;
+        }
+
+        wxULongLong_t numWakeups;       // Dispatch() calls finding any events
+        wxULongLong_t numEvents;        // total number of events dispatched
+        size_t maxEventsPerWakeup;      // largest batch dispatched at once
+    };
+
     // return the global dispatcher to be used for IO events, can be NULL only
     // if wxSelectDispatcher wasn't compiled into the library at all as
     // creating it never fails
@@ -35,6 +70,15 @@ public:
     // don't delete the returned pointer
     static wxFDIODispatcher *Get();
 
+    // choose the implementation to be created by Get(): must be called before
+    // the first call to Get(), returns false (without changing anything) if
+    // the given kind is not supported in this build
+    static bool SetKind(Kind kind);
+
+    // return the kind of the global dispatcher actually in use or
+    // Kind_Default if Get() hadn't been called yet
+    static Kind GetKind();
+
     // if we have any registered handlers, check for any pending events to them
     // and dispatch them -- this is used from wxX11 and wxDFB event loops
     // implementation
@@ -58,7 +102,29 @@ public:
     // -1 if an error occurred
     virtual int Dispatch(int timeout = TIMEOUT_INFINITE) = 0;
 
+    // get the statistics accumulated since the creation of this dispatcher
+    // (or the last call to ResetStats())
+    const Stats& GetStats() const { return m_stats; }
+    void ResetStats() { m_stats.Reset(); }
+
     virtual ~wxFDIODispatcher() { }
+
+protected:
+    // should be called by the derived classes Dispatch() with the number of
+    // events just delivered to the handlers
+    void UpdateStats(size_t numEvents)
+    {
+        if ( !numEvents )
+            return;
+
+        m_stats.numWakeups++;
+        m_stats.numEvents += numEvents;
+        if ( numEvents > m_stats.maxEventsPerWakeup )
+            m_stats.maxEventsPerWakeup = numEvents;
+    }
+
+private:
+    Stats m_stats;
 };
 
 //entry for wxFDIOHandlerMap
@@ -30,9 +30,18 @@ public:
 
     // Takes ownership of stream. If the stream is smaller than bufsize, the
     // backing file is never created and the backing is done with memory.
+    //
+    // bufsize is also the size of the chunks in which the parent stream is
+    // read and spilled to the backing file. If highWatermark is non-zero
+    // (and threads are available), the spilling is done by a background
+    // writer thread: the reader continues from memory until highWatermark
+    // bytes are waiting to be written and then blocks until the writer has
+    // drained the queue to lowWatermark bytes (highWatermark/2 by default).
     wxBackingFile(wxInputStream *stream,
                   size_t bufsize = DefaultBufSize,
-                  const wxString& prefix = wxT("wxbf"));
+                  const wxString& prefix = wxT("wxbf"),
+                  size_t highWatermark = 0,
+                  size_t lowWatermark = 0);
 
     wxBackingFile() : m_impl(NULL) { }
     ~wxBackingFile();
@@ -119,6 +119,10 @@ public :
     // closes the current sub-path
     virtual void CloseSubpath() = 0;
 
+    // removes all points and subpaths, retaining the backend allocations
+    // where possible
+    virtual void Clear() = 0;
+
     // gets the last point of the current path, (0,0) if not yet set
     virtual void GetCurrentPoint( wxDouble* x, wxDouble* y) const = 0;
 
@@ -59,6 +59,11 @@ private:
     int m_width ;
     int m_height ;
     wxWindow* m_window ;
+
+    // the extent of the drawing done since the last Clear(), in the same
+    // (logical) coordinates as m_x and m_y: only this part of the saved
+    // bitmap needs to be restored by the next Clear()
+    wxRect m_rectDrawn ;
 };
 
 #endif // wxHAS_NATIVE_OVERLAY/!wxHAS_NATIVE_OVERLAY
@@ -0,0 +1,141 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/private/parallelsort.h
+// Purpose:     Stable sort using multiple threads for large ranges
+// Author:      wxWidgets team
+// Copyright:   (c) wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_PRIVATE_PARALLELSORT_H_
+#define _WX_PRIVATE_PARALLELSORT_H_
+
+#include "wx/defs.h"
+
+#if wxUSE_THREADS
+    #include "wx/thread.h"
+    #include "wx/vector.h"
+#endif
+
+#include <algorithm>
+
+#if wxUSE_THREADS
+
+namespace wxPrivate
+{
+
+// Sorting fewer elements than this is always done serially, as the overhead
+// of creating the worker threads would exceed any possible gain.
+const size_t wxPARALLEL_SORT_MIN_COUNT = 100000;
+
+// Worker thread sorting one chunk of the full range.
+template <typename It, typename Cmp>
+class wxSortChunkThread : public wxThread
+{
+public:
+    wxSortChunkThread(It first, It last, const Cmp& cmp)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_first(first),
+          m_last(last),
+          m_cmp(cmp)
+    {
+    }
+
+    virtual ExitCode Entry() wxOVERRIDE
+    {
+        std::stable_sort(m_first, m_last, m_cmp);
+        return 0;
+    }
+
+private:
+    const It m_first;
+    const It m_last;
+    const Cmp m_cmp;
+};
+
+} // namespace wxPrivate
+
+#endif // wxUSE_THREADS
+
+// Stable sort of the [first, last) range of a random access iterator, using
+// multiple threads when the range is large enough for this to pay off and
+// falling back to a simple serial sort otherwise.
+//
+// Note that the comparator may be called concurrently from several threads,
+// so it must not have any side effects nor depend on anything other than the
+// compared values themselves.
+template <typename It, typename Cmp>
+void wxParallelStableSort(It first, It last, const Cmp& cmp)
+{
+#if wxUSE_THREADS
+    const size_t count = last - first;
+    const int numCPUs = wxThread::GetCPUCount();
+    if ( count >= wxPrivate::wxPARALLEL_SORT_MIN_COUNT && numCPUs > 1 )
+    {
+        // Don't create more chunks than necessary to keep every chunk
+        // reasonably big.
+        const size_t
+            numChunks = wxMin(static_cast<size_t>(numCPUs),
+                              count / (wxPrivate::wxPARALLEL_SORT_MIN_COUNT / 2));
+        if ( numChunks > 1 )
+        {
+            // Split the range into equal chunks: the first one is sorted in
+            // this thread, the other ones in the workers.
+            wxVector<size_t> bounds;
+            bounds.reserve(numChunks + 1);
+            for ( size_t n = 0; n <= numChunks; n++ )
+                bounds.push_back((count * n) / numChunks);
+
+            typedef wxPrivate::wxSortChunkThread<It, Cmp> SortThread;
+            wxVector<SortThread*> threads;
+            threads.reserve(numChunks - 1);
+            for ( size_t n = 1; n < numChunks; n++ )
+            {
+                SortThread* const
+                    thread = new SortThread(first + bounds[n],
+                                            first + bounds[n + 1],
+                                            cmp);
+                if ( thread->Run() == wxTHREAD_NO_ERROR )
+                {
+                    threads.push_back(thread);
+                }
+                else // not enough resources for one more thread
+                {
+                    // Sort this chunk in the calling thread too.
+                    delete thread;
+                    std::stable_sort(first + bounds[n],
+                                     first + bounds[n + 1],
+                                     cmp);
+                }
+            }
+
+            std::stable_sort(first, first + bounds[1], cmp);
+
+            for ( size_t n = 0; n < threads.size(); n++ )
+            {
+                threads[n]->Wait();
+                delete threads[n];
+            }
+
+            // Merge the sorted chunks pairwise until a single sorted range
+            // remains; std::inplace_merge() preserves stability.
+            for ( size_t step = 1; step < numChunks; step *= 2 )
+            {
+                for ( size_t n = 0; n + step < numChunks; n += 2*step )
+                {
+                    std::inplace_merge(first + bounds[n],
+                                       first + bounds[n + step],
+                                       first + bounds[wxMin(n + 2*step,
+                                                            numChunks)],
+                                       cmp);
+                }
+            }
+
+            return;
+        }
+    }
+#endif // wxUSE_THREADS
+
+    std::stable_sort(first, last, cmp);
+}
+
+#endif // _WX_PRIVATE_PARALLELSORT_H_
@@ -0,0 +1,132 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/private/rowband.h
+// Purpose:     Run a per-row worker over bands of rows, possibly in parallel
+// Author:      wxWidgets team
+// Copyright:   (c) wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_PRIVATE_ROWBAND_H_
+#define _WX_PRIVATE_ROWBAND_H_
+
+#include "wx/utils.h"           // for wxMin()
+
+#if wxUSE_THREADS
+    #include "wx/thread.h"
+    #include "wx/vector.h"
+#endif
+
+#if wxUSE_THREADS
+
+namespace wxPrivate
+{
+
+// Processing fewer pixels than this is always done serially, as the overhead
+// of creating the worker threads would exceed any possible gain.
+const unsigned long wxROW_BANDS_MIN_PIXELS = 256*1024;
+
+// A joinable thread running a row-band worker over [rowFirst, rowLast).
+template <typename Params>
+class wxRowBandThread : public wxThread
+{
+public:
+    typedef void (*Worker)(const Params& params, int rowFirst, int rowLast);
+
+    wxRowBandThread(Worker worker, const Params& params,
+                    int rowFirst, int rowLast)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_worker(worker),
+          m_params(params),
+          m_rowFirst(rowFirst),
+          m_rowLast(rowLast)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() wxOVERRIDE
+    {
+        (*m_worker)(m_params, m_rowFirst, m_rowLast);
+
+        return NULL;
+    }
+
+private:
+    const Worker m_worker;
+    const Params& m_params;
+    const int m_rowFirst,
+              m_rowLast;
+};
+
+} // namespace wxPrivate
+
+#endif // wxUSE_THREADS
+
+// Run the given worker over all the rows [0, height), splitting them into up
+// to numThreads (0 means one per available CPU) bands processed concurrently
+// if there are enough pixels for this to pay off. The worker is called with
+// the shared, read-only params and a sub-range of the rows; it must write
+// each row independently of the others so that the results are bit-identical
+// to those of the serial loop whatever the number of threads used.
+template <typename Params>
+void wxRunRowBands(void (*worker)(const Params&, int, int),
+                   const Params& params,
+                   int height,
+                   int width,
+                   int numThreads)
+{
+#if wxUSE_THREADS
+    if ( numThreads == 0 )
+        numThreads = wxThread::GetCPUCount();
+    if ( numThreads > height )
+        numThreads = height;
+
+    if ( numThreads > 1 &&
+            (unsigned long)height*width >= wxPrivate::wxROW_BANDS_MIN_PIXELS )
+    {
+        typedef wxPrivate::wxRowBandThread<Params> BandThread;
+        wxVector<BandThread*> threads;
+        threads.reserve(numThreads - 1);
+
+        // The first band is processed by this thread, the others each by
+        // their own one.
+        const int rowsPerBand = (height + numThreads - 1)/numThreads;
+        for ( int band = 1; band < numThreads; band++ )
+        {
+            const int rowFirst = band*rowsPerBand;
+            if ( rowFirst >= height )
+                break;
+
+            const int rowLast = wxMin(rowFirst + rowsPerBand, height);
+
+            BandThread* const
+                thread = new BandThread(worker, params, rowFirst, rowLast);
+            if ( thread->Run() != wxTHREAD_NO_ERROR )
+            {
+                // thread creation failed, just do its work ourselves
+                delete thread;
+                (*worker)(params, rowFirst, rowLast);
+                continue;
+            }
+
+            threads.push_back(thread);
+        }
+
+        (*worker)(params, 0, wxMin(rowsPerBand, height));
+
+        for ( size_t n = 0; n < threads.size(); n++ )
+        {
+            threads[n]->Wait();
+            delete threads[n];
+        }
+
+        return;
+    }
+#else // !wxUSE_THREADS
+    wxUnusedVar(width);
+    wxUnusedVar(numThreads);
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+
+    (*worker)(params, 0, height);
+}
+
+#endif // _WX_PRIVATE_ROWBAND_H_
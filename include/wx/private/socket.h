@@ -256,6 +256,11 @@ public:
     int Read(void *buffer, int size);
     int Write(const void *buffer, int size);
 
+    // scatter/gather IO: as Read()/Write() above but transfer the data
+    // from/to several buffers using a single system call
+    int ReadV(const wxSocketIOVec *buffers, int count);
+    int WriteV(const wxSocketIOVec *buffers, int count);
+
     // basically a wrapper for select(): returns the condition of the socket,
     // blocking for not longer than timeout if it is specified (otherwise just
     // poll without blocking at all)
@@ -364,6 +369,12 @@ private:
     int SendStream(const void *buffer, int size);
     int SendDgram(const void *buffer, int size);
 
+    // and their scatter/gather counterparts used by ReadV/WriteV()
+    int RecvStreamV(const wxSocketIOVec *buffers, int count);
+    int RecvDgramV(const wxSocketIOVec *buffers, int count);
+    int SendStreamV(const wxSocketIOVec *buffers, int count);
+    int SendDgramV(const wxSocketIOVec *buffers, int count);
+
 
     // set in ctor and never changed except that it's reset to NULL when the
     // socket is shut down
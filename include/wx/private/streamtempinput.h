@@ -45,6 +45,7 @@ public:
         m_stream = NULL;
         m_buffer = NULL;
         m_size = 0;
+        m_capacity = 0;
     }
 
     // call to associate a stream with this buffer, otherwise nothing happens
@@ -56,7 +57,8 @@ public:
         m_stream = stream;
     }
 
-    // check for input on our stream and cache it in our buffer if any
+    // check for input on our stream and cache it in our buffer if any,
+    // draining everything which can be read without blocking
     //
     // return true if anything was done
     bool Update()
@@ -64,20 +66,33 @@ public:
         if ( !m_stream || !m_stream->CanRead() )
             return false;
 
-        // realloc in blocks of 4Kb: this is the default (and minimal) buffer
-        // size of the Unix pipes so it should be the optimal step
-        //
-        // NB: don't use "static int" in this inline function, some compilers
-        //     (e.g. IBM xlC) don't like it
-        enum { incSize = 4096 };
-
-        void *buf = realloc(m_buffer, m_size + incSize);
-        if ( !buf )
-            return false;
-
-        m_buffer = buf;
-        m_stream->Read((char *)m_buffer + m_size, incSize);
-        m_size += m_stream->LastRead();
+        do
+        {
+            // Grow the buffer geometrically: reallocating it in fixed size
+            // steps would copy the already accumulated data O(size/step)
+            // times, which is prohibitively slow for processes producing
+            // megabytes of output.
+            //
+            // NB: don't use "static int" in this inline function, some
+            //     compilers (e.g. IBM xlC) don't like it
+            enum { minSize = 4096 };
+
+            if ( m_capacity - m_size < minSize )
+            {
+                const size_t capacity = m_capacity ? 2*m_capacity : minSize;
+
+                void *buf = realloc(m_buffer, capacity);
+                if ( !buf )
+                    return false;
+
+                m_buffer = buf;
+                m_capacity = capacity;
+            }
+
+            m_stream->Read((char *)m_buffer + m_size, m_capacity - m_size);
+            m_size += m_stream->LastRead();
+        }
+        while ( m_stream->CanRead() );
 
         return true;
     }
@@ -125,9 +140,12 @@ private:
     // the buffer of size m_size (NULL if m_size == 0)
     void *m_buffer;
 
-    // the size of the buffer
+    // the size of the data in the buffer
     size_t m_size;
 
+    // the allocated size of the buffer, grows geometrically
+    size_t m_capacity;
+
     wxDECLARE_NO_COPY_CLASS(wxStreamTempInputBuffer);
 };
 
@@ -69,6 +69,12 @@ public:
 
     wxWebRequest::Storage GetStorage() const { return m_storage; }
 
+    // Takes ownership of the sink and switches to Storage_Sink.
+    bool SetSink(wxOutputStream* sink);
+
+    // May return NULL if SetSink() hadn't been called.
+    wxOutputStream* GetSink() const { return m_sink.get(); }
+
     // Precondition for this method checked by caller: current state is idle.
     virtual void Start() = 0;
 
@@ -76,6 +82,11 @@ public:
     // cancelled.
     void Cancel();
 
+    // Suspend and restart the transfer: overridden by the backends supporting
+    // this, the base class versions simply do nothing and return false.
+    virtual bool Pause() { return false; }
+    virtual bool Resume() { return false; }
+
     virtual wxWebResponseImplPtr GetResponse() const = 0;
 
     virtual wxWebAuthChallengeImplPtr GetAuthChallenge() const = 0;
@@ -121,6 +132,7 @@ protected:
     wxWebRequestHeaderMap m_headers;
     wxFileOffset m_dataSize;
     wxScopedPtr<wxInputStream> m_dataStream;
+    wxScopedPtr<wxOutputStream> m_sink;
     bool m_peerVerifyDisabled;
 
     wxWebRequestImpl(wxWebSession& session,
@@ -194,6 +206,12 @@ protected:
 
     void ReportDataReceived(size_t sizeReceived);
 
+    // Pass the given buffer directly to the sink stream, without copying it
+    // anywhere: can, and should, be used by the backends able to do it
+    // instead of GetDataBuffer() when Storage_Sink is used. Returns false if
+    // writing to the sink failed and the transfer should be aborted.
+    bool SinkData(const void* buffer, size_t size);
+
     // This function can optionally be called to preallocate the read buffer,
     // if the total amount of data to be downloaded is known in advance.
     void PreAllocBuffer(size_t sizeNeeded);
@@ -248,6 +266,30 @@ public:
 
     wxString GetTempDir() const;
 
+    // Connection pooling configuration: the values are just stored here, it's
+    // up to the backends to apply them (currently only the libcurl one does).
+    void SetMaxConnections(int maxTotal, int maxPerHost)
+    {
+        m_maxConnections = maxTotal;
+        m_maxConnectionsPerHost = maxPerHost;
+    }
+
+    void SetKeepAliveTimes(int idleSeconds, int intervalSeconds)
+    {
+        m_keepAliveIdle = idleSeconds;
+        m_keepAliveInterval = intervalSeconds;
+    }
+
+    void EnableHTTP2(bool enable) { m_enableHTTP2 = enable; }
+
+    // All values are 0 if they were never set and shouldn't be applied then.
+    int GetMaxConnections() const { return m_maxConnections; }
+    int GetMaxConnectionsPerHost() const { return m_maxConnectionsPerHost; }
+    int GetKeepAliveIdle() const { return m_keepAliveIdle; }
+    int GetKeepAliveInterval() const { return m_keepAliveInterval; }
+
+    bool IsHTTP2Enabled() const { return m_enableHTTP2; }
+
     const wxWebRequestHeaderMap& GetHeaders() const { return m_headers; }
 
     virtual wxWebSessionHandle GetNativeHandle() const = 0;
@@ -262,6 +304,12 @@ private:
     wxWebRequestHeaderMap m_headers;
     wxString m_tempDir;
 
+    int m_maxConnections;
+    int m_maxConnectionsPerHost;
+    int m_keepAliveIdle;
+    int m_keepAliveInterval;
+    bool m_enableHTTP2;
+
     wxDECLARE_NO_COPY_CLASS(wxWebSessionImpl);
 };
 
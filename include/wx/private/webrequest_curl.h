@@ -53,6 +53,10 @@ public:
 
     void Start() wxOVERRIDE;
 
+    bool Pause() wxOVERRIDE;
+
+    bool Resume() wxOVERRIDE;
+
     wxWebResponseImplPtr GetResponse() const wxOVERRIDE
         { return m_response; }
 
@@ -150,6 +154,8 @@ public:
 
     bool StartRequest(wxWebRequestCURL& request);
 
+    bool ResumeRequest(wxWebRequestCURL& request);
+
     void CancelRequest(wxWebRequestCURL* request);
 
     void RequestHasTerminated(wxWebRequestCURL* request);
@@ -22,6 +22,7 @@
 #include "wx/dialog.h"
 #include "wx/frame.h"
 #include "wx/dc.h"
+#include "wx/vector.h"
 
 class WXDLLIMPEXP_FWD_CORE wxDC;
 class WXDLLIMPEXP_FWD_CORE wxButton;
@@ -279,6 +280,24 @@ public:
     virtual bool OnPrintPage(int page) = 0;
     virtual void GetPageInfo(int *minPage, int *maxPage, int *pageFrom, int *pageTo);
 
+    // Called by the printing framework instead of OnPrintPage(): prints the
+    // page in horizontal bands of the configured height with the DC clipped
+    // to each band in turn, or simply calls OnPrintPage() once if banded
+    // printing is not enabled (as it isn't by default).
+    bool PrintPage(int page);
+
+    // Enable banded printing using bands of the given height in device
+    // pixels, bounding the peak memory used by backends rasterizing the
+    // page: OnPrintPage() is then called once per band and must be able to
+    // redraw the same page several times. Use 0 (the default) to disable.
+    void SetBandHeight(int height) { m_bandHeight = height; }
+    int GetBandHeight() const { return m_bandHeight; }
+
+    // The band being printed, in device pixels: only non-empty inside
+    // OnPrintPage() during banded printing, can be used to skip drawing
+    // entirely outside of the band.
+    wxRect GetBandRect() const { return m_bandRect; }
+
     virtual wxString GetTitle() const { return m_printoutTitle; }
 
     // Port-specific code should call this function to initialize this object
@@ -343,6 +362,9 @@ private:
 
     wxRect           m_paperRectPixels;
 
+    int              m_bandHeight;
+    wxRect           m_bandRect;
+
 private:
     wxDECLARE_ABSTRACT_CLASS(wxPrintout);
     wxDECLARE_NO_COPY_CLASS(wxPrintout);
@@ -622,6 +644,13 @@ public:
     virtual void SetZoom(int percent);
     virtual int GetZoom() const;
 
+    // Set the number of rendered pages kept in the cache used by
+    // UpdatePageRendering() to pre-render the pages adjacent to the current
+    // one at idle time, including the current page itself. Using 1 disables
+    // pre-rendering entirely.
+    virtual void SetPageCacheSize(int count);
+    virtual int GetPageCacheSize() const { return m_pageCacheSize; }
+
     virtual wxPrintDialogData& GetPrintDialogData();
 
     virtual int GetMaxPage() const;
@@ -652,6 +681,15 @@ protected:
 
     void InvalidatePreviewBitmap();
 
+    // Return the cached rendering of the given page at the given size,
+    // rendering it now and adding it to the cache if it isn't there yet.
+    // Returns false (without any error message) if rendering failed.
+    bool GetRenderedPage(int pageNum, const wxSize& size, wxBitmap& bmp);
+
+    // Render one not yet cached page adjacent to the current one, if any:
+    // called from UpdatePageRendering() when the current page is up to date.
+    void PreRenderAdjacentPage();
+
 protected:
     wxPrintDialogData m_printDialogData;
     wxPreviewCanvas*  m_previewCanvas;
@@ -677,6 +715,21 @@ protected:
 private:
     void Init(wxPrintout *printout, wxPrintout *printoutForPrinting);
 
+    // Element of the cache of rendered pages used by GetRenderedPage():
+    // wxBitmap is reference-counted, so storing it by value is cheap.
+    struct CachedPage
+    {
+        int page;
+        wxBitmap bitmap;
+    };
+
+    // Find the cache entry of the given page with a bitmap of the given
+    // size, returning m_pageCache.size() if there is none.
+    size_t FindCachedPage(int pageNum, const wxSize& size) const;
+
+    wxVector<CachedPage> m_pageCache;
+    int               m_pageCacheSize;
+
     wxDECLARE_NO_COPY_CLASS(wxPrintPreviewBase);
     wxDECLARE_CLASS(wxPrintPreviewBase);
 };
@@ -714,6 +767,9 @@ public:
     virtual void SetZoom(int percent) wxOVERRIDE;
     virtual int GetZoom() const wxOVERRIDE;
 
+    virtual void SetPageCacheSize(int count) wxOVERRIDE;
+    virtual int GetPageCacheSize() const wxOVERRIDE;
+
     virtual bool Print(bool interactive) wxOVERRIDE;
     virtual void DetermineScaling() wxOVERRIDE;
 
@@ -0,0 +1,117 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/profiler.h
+// Purpose:     Lightweight zone profiler producing chrome://tracing output
+// Author:      wxWidgets team
+// Created:     2022-04-10
+// Copyright:   (c) 2022 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_PROFILER_H_
+#define _WX_PROFILER_H_
+
+#include "wx/defs.h"
+#include "wx/string.h"
+#include "wx/time.h"
+
+// ----------------------------------------------------------------------------
+// wxProfilerZone: a single zone recorded by the profiler
+// ----------------------------------------------------------------------------
+
+struct wxProfilerZone
+{
+    // the name passed to wxPROFILE_ZONE(), must be a string literal or at
+    // least outlive the profiler as only the pointer is stored
+    const char *name;
+
+    // start and end timestamps in microseconds since the epoch
+    wxLongLong_t start,
+                 end;
+};
+
+// ----------------------------------------------------------------------------
+// wxProfiler: collects the zones recorded by wxPROFILE_ZONE()
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxProfiler
+{
+public:
+    // start collecting zones: each thread records into its own fixed-size
+    // ring buffer holding up to the given number of zones, with the oldest
+    // ones silently overwritten when it overflows
+    //
+    // notice that this function, as well as Disable(), DumpToFile() and
+    // Clear() below, must be called from the main thread, only recording
+    // the zones themselves is safe from any thread
+    static void Enable(size_t zonesPerThread = 65536);
+
+    // stop collecting zones, the zones recorded so far are kept until
+    // Clear() is called and can still be dumped
+    static void Disable();
+
+    // return true if zones are currently being collected
+    static bool IsEnabled() { return ms_enabled; }
+
+    // write all the zones collected so far to the given file in the JSON
+    // format understood by the chrome://tracing viewer, return false on
+    // error
+    static bool DumpToFile(const wxString& filename);
+
+    // discard all the zones collected so far
+    static void Clear();
+
+    // for wxProfileZone only, don't call directly
+    static void RecordZone(const char *name,
+                           wxLongLong_t start,
+                           wxLongLong_t end);
+
+private:
+    static bool ms_enabled;
+
+    // this class has static methods only
+    wxProfiler();
+};
+
+// ----------------------------------------------------------------------------
+// wxProfileZone: RAII helper recording the time spent in a scope
+// ----------------------------------------------------------------------------
+
+// Don't use this class directly, use wxPROFILE_ZONE() instead.
+class wxProfileZone
+{
+public:
+    wxEXPLICIT wxProfileZone(const char *name)
+    {
+        // remember the name only when enabled so that the destructor does
+        // nothing at all in the common disabled case
+        m_name = wxProfiler::IsEnabled() ? name : NULL;
+        if ( m_name )
+            m_start = wxGetUTCTimeUSec().GetValue();
+    }
+
+    ~wxProfileZone()
+    {
+        if ( m_name )
+            wxProfiler::RecordZone(m_name, m_start, wxGetUTCTimeUSec().GetValue());
+    }
+
+private:
+    const char *m_name;
+    wxLongLong_t m_start;
+
+    wxDECLARE_NO_COPY_CLASS(wxProfileZone);
+};
+
+// Record the time spent between this point and the end of the enclosing
+// scope as a zone with the given name, which must be a string literal. The
+// name is written to the dump as is, so it shouldn't contain any characters
+// which would have to be escaped in JSON, e.g. quotes or backslashes.
+#define wxPROFILE_ZONE(name) \
+    wxProfileZone wxMAKE_UNIQUE_NAME(wxProfileZoneObj)(name)
+
+// Same as wxPROFILE_ZONE() but uses the name of the current function.
+// Nothing is recorded if the compiler doesn't provide the function name,
+// i.e. if __WXFUNCTION__ is NULL.
+#define wxPROFILE_FUNCTION() wxPROFILE_ZONE(__WXFUNCTION__)
+
+#endif // _WX_PROFILER_H_
@@ -580,6 +580,14 @@ protected:
     // Mark sub-properties as being deleted.
     void DoMarkChildrenAsDeleted(wxPGProperty* p, bool recursive);
 
+    // Add the full name of the property, and those of all of its
+    // children (recursively), to the name lookup dictionary.
+    void DoAddToNameDict( wxPGProperty* p );
+
+    // Remove the full name of the property, and those of all of its
+    // children (recursively), from the name lookup dictionary.
+    void DoRemoveFromNameDict( wxPGProperty* p );
+
     // Rename the property
     // so it won't remain in the way of the user code.
     void DoInvalidatePropertyName(wxPGProperty* p);
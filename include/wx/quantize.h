@@ -50,15 +50,20 @@ public:
     // Specify an optional palette pointer to receive the resulting palette.
     // This palette may be passed to ConvertImageToBitmap, for example.
     // If you pass a palette pointer, you must free the palette yourself.
+    // The histogram accumulation pass can use numThreads threads: the default
+    // of 1 keeps it serial, while passing 0 uses as many threads as there are
+    // CPUs in the system.
 
     static bool Quantize(const wxImage& src, wxImage& dest, wxPalette** pPalette, int desiredNoColours = 236,
-        unsigned char** eightBitData = NULL, int flags = wxQUANTIZE_INCLUDE_WINDOWS_COLOURS|wxQUANTIZE_FILL_DESTINATION_IMAGE|wxQUANTIZE_RETURN_8BIT_DATA);
+        unsigned char** eightBitData = NULL, int flags = wxQUANTIZE_INCLUDE_WINDOWS_COLOURS|wxQUANTIZE_FILL_DESTINATION_IMAGE|wxQUANTIZE_RETURN_8BIT_DATA,
+        int numThreads = 1);
 
     // This version sets a palette in the destination image so you don't
     // have to manage it yourself.
 
     static bool Quantize(const wxImage& src, wxImage& dest, int desiredNoColours = 236,
-        unsigned char** eightBitData = NULL, int flags = wxQUANTIZE_INCLUDE_WINDOWS_COLOURS|wxQUANTIZE_FILL_DESTINATION_IMAGE|wxQUANTIZE_RETURN_8BIT_DATA);
+        unsigned char** eightBitData = NULL, int flags = wxQUANTIZE_INCLUDE_WINDOWS_COLOURS|wxQUANTIZE_FILL_DESTINATION_IMAGE|wxQUANTIZE_RETURN_8BIT_DATA,
+        int numThreads = 1);
 
 //// Helpers
 
@@ -67,7 +72,7 @@ public:
     // in_rows and out_rows are arrays [0..h-1] of pointer to rows
     // (in_rows contains w * 3 bytes per row, out_rows w bytes per row)
     // fills out_rows with indexes into palette (which is also stored into palette variable)
-    static void DoQuantize(unsigned w, unsigned h, unsigned char **in_rows, unsigned char **out_rows, unsigned char *palette, int desiredNoColours);
+    static void DoQuantize(unsigned w, unsigned h, unsigned char **in_rows, unsigned char **out_rows, unsigned char *palette, int desiredNoColours, int numThreads = 1);
 
 };
 
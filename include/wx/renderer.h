@@ -387,6 +387,11 @@ public:
     // return the currently used renderer
     static wxRendererNative& Get();
 
+    // return a caching proxy for the currently used renderer: it renders
+    // each part only once per (part, state, size, DPI) combination and
+    // blits the cached bitmap afterwards
+    static wxRendererNative& GetCached();
+
     // return the generic implementation of the renderer
     static wxRendererNative& GetGeneric();
 
@@ -601,6 +606,94 @@ protected:
     wxDECLARE_NO_COPY_CLASS(wxDelegateRendererNative);
 };
 
+// ----------------------------------------------------------------------------
+// wxCachedRendererNative: caches the rendered parts as bitmaps
+// ----------------------------------------------------------------------------
+
+class wxRendererPartCache;      // private implementation detail
+
+// This renderer delegates to another one but renders each part only once per
+// (part, state, size, DPI) combination, blitting the cached bitmap on the
+// subsequent calls instead of re-invoking the theme engine. The cache is
+// dropped automatically whenever the system colours change.
+//
+// Parts which don't completely fill their rectangle (e.g. check boxes) are
+// composed on the target window background colour, so this renderer should
+// only be used when the parts are drawn directly over the window background,
+// as is the case for the header and grid label windows.
+class WXDLLIMPEXP_CORE wxCachedRendererNative : public wxDelegateRendererNative
+{
+public:
+    explicit wxCachedRendererNative(wxRendererNative& rendererNative);
+    virtual ~wxCachedRendererNative();
+
+    virtual int  DrawHeaderButton(wxWindow *win,
+                                  wxDC& dc,
+                                  const wxRect& rect,
+                                  int flags = 0,
+                                  wxHeaderSortIconType sortArrow = wxHDR_SORT_ICON_NONE,
+                                  wxHeaderButtonParams* params = NULL) wxOVERRIDE;
+
+    virtual void DrawTreeItemButton(wxWindow *win,
+                                    wxDC& dc,
+                                    const wxRect& rect,
+                                    int flags = 0) wxOVERRIDE;
+
+    virtual void DrawComboBoxDropButton(wxWindow *win,
+                                        wxDC& dc,
+                                        const wxRect& rect,
+                                        int flags = 0) wxOVERRIDE;
+
+    virtual void DrawCheckBox(wxWindow *win,
+                              wxDC& dc,
+                              const wxRect& rect,
+                              int flags = 0) wxOVERRIDE;
+
+    virtual void DrawCheckMark(wxWindow *win,
+                               wxDC& dc,
+                               const wxRect& rect,
+                               int flags = 0) wxOVERRIDE;
+
+    virtual void DrawCollapseButton(wxWindow *win,
+                                    wxDC& dc,
+                                    const wxRect& rect,
+                                    int flags = 0) wxOVERRIDE;
+
+    virtual void DrawRadioBitmap(wxWindow* win,
+                                 wxDC& dc,
+                                 const wxRect& rect,
+                                 int flags = 0) wxOVERRIDE;
+
+    // drop all cached part bitmaps; this is done automatically when a
+    // wxSysColourChangedEvent is generated
+    void InvalidateCache();
+
+private:
+    // the parts which can be cached
+    enum CachedPart
+    {
+        Part_HeaderButton,
+        Part_TreeItemButton,
+        Part_ComboBoxDropButton,
+        Part_CheckBox,
+        Part_CheckMark,
+        Part_CollapseButton,
+        Part_RadioBitmap
+    };
+
+    // look up the bitmap of the given part, rendering it first if it's not
+    // cached yet; returns an invalid bitmap if it couldn't be rendered, in
+    // which case the caller should fall back to drawing the part directly
+    wxBitmap CachePart(CachedPart part,
+                       wxWindow *win,
+                       const wxSize& size,
+                       int flags);
+
+    wxRendererPartCache * const m_cache;
+
+    wxDECLARE_NO_COPY_CLASS(wxCachedRendererNative);
+};
+
 // ----------------------------------------------------------------------------
 // inline functions implementation
 // ----------------------------------------------------------------------------
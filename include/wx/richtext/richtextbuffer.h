@@ -115,7 +115,8 @@ enum wxRichTextFileType
     wxRICHTEXT_TYPE_XML,
     wxRICHTEXT_TYPE_HTML,
     wxRICHTEXT_TYPE_RTF,
-    wxRICHTEXT_TYPE_PDF
+    wxRICHTEXT_TYPE_PDF,
+    wxRICHTEXT_TYPE_BINARY
 };
 
 /*
@@ -2654,6 +2655,14 @@ public:
     */
     virtual void Dump(wxTextOutputStream& stream);
 
+    /**
+        Returns a rough estimate of the amount of memory used by this object
+        and its children, in bytes. The estimate doesn't need to be accurate,
+        only roughly proportional to the actual memory use: it is used to keep
+        the undo history within its memory budget (see wxRichTextCommandProcessor).
+    */
+    virtual size_t GetApproximateSize() const { return 512; }
+
     /**
         Returns @true if we can edit the object's properties via a GUI.
     */
@@ -3132,6 +3141,8 @@ public:
 
     virtual void Dump(wxTextOutputStream& stream) wxOVERRIDE;
 
+    virtual size_t GetApproximateSize() const wxOVERRIDE;
+
     virtual void Invalidate(const wxRichTextRange& invalidRange = wxRICHTEXT_ALL) wxOVERRIDE;
 
 // Accessors
@@ -4513,6 +4524,12 @@ public:
 
     virtual bool Layout(wxDC& dc, wxRichTextDrawingContext& context, const wxRect& rect, const wxRect& parentRect, int style) wxOVERRIDE;
 
+    virtual bool LayoutToBestSize(wxDC& dc, wxRichTextDrawingContext& context, wxRichTextBuffer* buffer,
+                    const wxRichTextAttr& parentAttr, const wxRichTextAttr& attr,
+                    const wxRect& availableParentSpace, const wxRect& availableContainerSpace, int style) wxOVERRIDE;
+
+    virtual void Invalidate(const wxRichTextRange& invalidRange = wxRICHTEXT_ALL) wxOVERRIDE;
+
     virtual bool GetRangeSize(const wxRichTextRange& range, wxSize& size, int& descent, wxDC& dc, wxRichTextDrawingContext& context, int flags, const wxPoint& position = wxPoint(0,0), const wxSize& parentSize = wxDefaultSize, wxArrayInt* partialExtents = NULL) const wxOVERRIDE;
 
     virtual bool FindPosition(wxDC& dc, wxRichTextDrawingContext& context, long index, wxPoint& pt, int* height, bool forceLineStart) wxOVERRIDE;
@@ -4656,6 +4673,14 @@ protected:
     wxRichTextLineList  m_cachedLines;
     wxVector<wxRichTextLine*> m_cachedLinesVect;
 
+    // The available width used for the last layout of m_cachedLines, or 0 if
+    // they have never been laid out; together with m_layoutDirty, this
+    // determines whether the cached lines can be reused by Layout().
+    int                 m_cachedLayoutWidth;
+
+    // true if the content or style changed since the last layout
+    bool                m_layoutDirty;
+
     // Whether the paragraph is impacted by floating objects from above
     int                 m_impactedByFloatingObjects;
 
@@ -4718,6 +4743,8 @@ public:
 
     virtual void Dump(wxTextOutputStream& stream) wxOVERRIDE;
 
+    virtual size_t GetApproximateSize() const wxOVERRIDE { return wxRichTextObject::GetApproximateSize() + m_text.length() * sizeof(wxChar); }
+
     virtual bool CanSplit(wxRichTextDrawingContext& context) const wxOVERRIDE;
 
     virtual wxRichTextObject* Split(wxRichTextDrawingContext& context) wxOVERRIDE;
@@ -5009,6 +5036,8 @@ public:
 
     virtual bool UsesParagraphAttributes() const wxOVERRIDE { return false; }
 
+    virtual size_t GetApproximateSize() const wxOVERRIDE { return wxRichTextObject::GetApproximateSize() + m_imageBlock.GetDataSize(); }
+
 #if wxUSE_XML
     virtual bool ImportFromXML(wxRichTextBuffer* buffer, wxXmlNode* node, wxRichTextXMLHandler* handler, bool* recurse) wxOVERRIDE;
 #endif
@@ -5137,6 +5166,19 @@ public:
     */
     wxCommandProcessor* GetCommandProcessor() const { return m_commandProcessor; }
 
+    /**
+        Sets the approximate maximum amount of memory that the undo history
+        may use, in bytes. Zero (the default) means no limit.
+        See wxRichTextCommandProcessor.
+    */
+    void SetUndoMemoryBudget(size_t budget);
+
+    /**
+        Returns the undo history memory budget in bytes, or zero if the
+        history is unlimited.
+    */
+    size_t GetUndoMemoryBudget() const;
+
     /**
         Sets style sheet, if any. This will allow the application to use named character and paragraph
         styles found in the style sheet.
@@ -6385,10 +6427,22 @@ public:
     bool GetFreeze() const { return m_freeze; }
     void SetFreeze(bool freeze) { m_freeze = freeze; }
 
+    /**
+        Returns a rough estimate of the amount of memory used by this command,
+        in bytes. The result is cached, since the undo history memory budget
+        looks at it every time a command is stored.
+    */
+    size_t GetApproximateSize() const;
+
 protected:
 
     wxList  m_actions;
     bool    m_freeze;
+
+    // Cached result of GetApproximateSize(), or 0 if not yet calculated
+    mutable size_t m_cachedSize;
+
+    wxDECLARE_CLASS(wxRichTextCommand);
 };
 
 /**
@@ -6552,6 +6606,12 @@ public:
     */
     bool GetIgnoreFirstTime() const { return m_ignoreThis; }
 
+    /**
+        Returns a rough estimate of the amount of memory used by this action,
+        in bytes, including the stored paragraph fragments.
+    */
+    size_t GetApproximateSize() const;
+
 protected:
     // Action name
     wxString                        m_name;
@@ -6599,6 +6659,64 @@ protected:
     wxRichTextCommandId             m_cmdId;
 };
 
+/**
+    @class wxRichTextCommandProcessor
+
+    The command processor created by wxRichTextBuffer, extending
+    wxCommandProcessor with an optional memory budget for the undo history.
+
+    Since each command stores copies of the paragraphs it affects, the undo
+    history of a long editing session on a large document can grow very big.
+    When a budget is set with SetMemoryBudget(), the oldest commands are
+    dropped whenever a new command is stored so that the approximate amount of
+    memory used by the history stays within the budget. By default the budget
+    is zero, meaning that the history is unlimited, as before.
+
+    @library{wxrichtext}
+    @category{richtext}
+
+    @see wxRichTextCommand
+*/
+
+class WXDLLIMPEXP_RICHTEXT wxRichTextCommandProcessor: public wxCommandProcessor
+{
+public:
+    wxRichTextCommandProcessor(int maxCommands = -1): wxCommandProcessor(maxCommands) { m_memoryBudget = 0; }
+
+    /**
+        Sets the approximate maximum amount of memory that the undo history
+        may use, in bytes. Zero (the default) means no limit. Takes effect
+        immediately, dropping the oldest commands if the history is already
+        over the new budget.
+    */
+    void SetMemoryBudget(size_t budget) { m_memoryBudget = budget; TrimCommands(); }
+
+    /**
+        Returns the undo history memory budget in bytes, or zero if the
+        history is unlimited.
+    */
+    size_t GetMemoryBudget() const { return m_memoryBudget; }
+
+    /**
+        Returns a rough estimate of the amount of memory used by the stored
+        commands, in bytes.
+    */
+    size_t GetApproximateSize() const;
+
+    virtual void Store(wxCommand* command) wxOVERRIDE;
+
+protected:
+    /// Drops the oldest commands until the history is within the memory budget
+    void TrimCommands();
+
+    /// Returns the approximate size of a single stored command
+    static size_t GetCommandSize(wxCommand* command);
+
+    size_t  m_memoryBudget;
+
+    wxDECLARE_DYNAMIC_CLASS(wxRichTextCommandProcessor);
+};
+
 /*!
  * Handler flags
  */
@@ -110,13 +110,17 @@ public:
     virtual ~wxRichTextPrintout();
 
     /// The buffer to print
-    void SetRichTextBuffer(wxRichTextBuffer* buffer) { m_richTextBuffer = buffer; }
+    void SetRichTextBuffer(wxRichTextBuffer* buffer) { m_richTextBuffer = buffer; InvalidatePagination(); }
     wxRichTextBuffer* GetRichTextBuffer() const { return m_richTextBuffer; }
 
     /// Set/get header/footer data
-    void SetHeaderFooterData(const wxRichTextHeaderFooterData& data) { m_headerFooterData = data; }
+    void SetHeaderFooterData(const wxRichTextHeaderFooterData& data) { m_headerFooterData = data; InvalidatePagination(); }
     const wxRichTextHeaderFooterData& GetHeaderFooterData() const { return m_headerFooterData; }
 
+    /// Invalidate the cached page break table, forcing the next call to
+    /// OnPreparePrinting() to relayout and repaginate the buffer
+    void InvalidatePagination() { m_pageBreaksValid = false; }
+
     /// Sets margins in 10ths of millimetre. Defaults to 1 inch for margins.
     void SetMargins(int top = 254, int bottom = 254, int left = 254, int right = 254);
 
@@ -147,6 +151,12 @@ private:
     wxArrayInt                  m_pageYOffsets;
     int                         m_marginLeft, m_marginTop, m_marginRight, m_marginBottom;
 
+    // Cached pagination state: the page break table above is only
+    // recomputed when the buffer or the page setup changed
+    bool                        m_pageBreaksValid;
+    wxRect                      m_cachedTextRect;
+    double                      m_cachedBufferScale;
+
     wxRichTextHeaderFooterData  m_headerFooterData;
 
     wxDECLARE_NO_COPY_CLASS(wxRichTextPrintout);
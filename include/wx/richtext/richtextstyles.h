@@ -30,6 +30,8 @@
 #endif
 
 #include "wx/choice.h"
+#include "wx/hashmap.h"
+#include "wx/vector.h"
 
 /*!
  * Forward declarations
@@ -286,6 +288,40 @@ public:
 protected:
 };
 
+/*!
+ * Hash map from style names to definitions, used by wxRichTextStyleSheet to
+ * avoid scanning the style lists linearly on every lookup.
+ */
+
+WX_DECLARE_STRING_HASH_MAP_WITH_DECL(wxRichTextStyleDefinition*,
+                                     wxRichTextStyleDefinitionHashMap,
+                                     class WXDLLIMPEXP_RICHTEXT);
+
+/*!
+ * wxRichTextMergedStyle: a cached result of merging a style definition with
+ * its base styles, together with the attributes it was computed from so that
+ * entries that became stale after a definition was modified in place can be
+ * detected and recomputed.
+ */
+
+class WXDLLIMPEXP_RICHTEXT wxRichTextMergedStyle
+{
+public:
+    /// The fully merged attributes
+    wxRichTextAttr              m_mergedStyle;
+
+    /// The attributes of the base style chain, in the order of application
+    wxVector<wxRichTextAttr>    m_sourceStyles;
+};
+
+typedef const wxRichTextStyleDefinition* wxRichTextStyleDefinitionConstPtr;
+
+WX_DECLARE_HASH_MAP_WITH_DECL(wxRichTextStyleDefinitionConstPtr,
+                              wxRichTextMergedStyle,
+                              wxPointerHash, wxPointerEqual,
+                              wxRichTextMergedStyleHashMap,
+                              class WXDLLIMPEXP_RICHTEXT);
+
 /*!
  * The style sheet
  */
@@ -348,16 +384,16 @@ public:
     bool RemoveStyle(wxRichTextStyleDefinition* def, bool deleteStyle = false);
 
     /// Find a character definition by name
-    wxRichTextCharacterStyleDefinition* FindCharacterStyle(const wxString& name, bool recurse = true) const { return (wxRichTextCharacterStyleDefinition*) FindStyle(m_characterStyleDefinitions, name, recurse); }
+    wxRichTextCharacterStyleDefinition* FindCharacterStyle(const wxString& name, bool recurse = true) const { return (wxRichTextCharacterStyleDefinition*) FindStyle(m_characterStyleDefinitions, m_characterStyleCache, name, recurse); }
 
     /// Find a paragraph definition by name
-    wxRichTextParagraphStyleDefinition* FindParagraphStyle(const wxString& name, bool recurse = true) const { return (wxRichTextParagraphStyleDefinition*) FindStyle(m_paragraphStyleDefinitions, name, recurse); }
+    wxRichTextParagraphStyleDefinition* FindParagraphStyle(const wxString& name, bool recurse = true) const { return (wxRichTextParagraphStyleDefinition*) FindStyle(m_paragraphStyleDefinitions, m_paragraphStyleCache, name, recurse); }
 
     /// Find a list definition by name
-    wxRichTextListStyleDefinition* FindListStyle(const wxString& name, bool recurse = true) const { return (wxRichTextListStyleDefinition*) FindStyle(m_listStyleDefinitions, name, recurse); }
+    wxRichTextListStyleDefinition* FindListStyle(const wxString& name, bool recurse = true) const { return (wxRichTextListStyleDefinition*) FindStyle(m_listStyleDefinitions, m_listStyleCache, name, recurse); }
 
     /// Find a box definition by name
-    wxRichTextBoxStyleDefinition* FindBoxStyle(const wxString& name, bool recurse = true) const { return (wxRichTextBoxStyleDefinition*) FindStyle(m_boxStyleDefinitions, name, recurse); }
+    wxRichTextBoxStyleDefinition* FindBoxStyle(const wxString& name, bool recurse = true) const { return (wxRichTextBoxStyleDefinition*) FindStyle(m_boxStyleDefinitions, m_boxStyleCache, name, recurse); }
 
     /// Find any definition by name
     wxRichTextStyleDefinition* FindStyle(const wxString& name, bool recurse = true) const;
@@ -440,6 +476,21 @@ public:
     /// Find a definition by name
     wxRichTextStyleDefinition* FindStyle(const wxList& list, const wxString& name, bool recurse = true) const;
 
+    /// Find a definition by name, using and updating the given lookup cache
+    wxRichTextStyleDefinition* FindStyle(const wxList& list,
+                                         wxRichTextStyleDefinitionHashMap& cache,
+                                         const wxString& name,
+                                         bool recurse = true) const;
+
+    /// Return the result of applying all the styles in the given list in
+    /// order, reusing a cached result if the styles didn't change since it
+    /// was computed (see wxRichTextStyleDefinition::GetStyleMergedWithBase)
+    wxRichTextAttr GetMergedStyle(const wxRichTextStyleDefinition* def,
+                                  const wxList& styles) const;
+
+    /// Clear the name lookup and merged style caches
+    void ClearStyleCaches();
+
 protected:
 
     wxString                m_description;
@@ -450,6 +501,17 @@ protected:
     wxList                  m_listStyleDefinitions;
     wxList                  m_boxStyleDefinitions;
 
+    // Lookup caches for FindStyle(), filled lazily; entries are verified
+    // against the definition's current name, so that renaming a definition
+    // in place cannot return stale results.
+    mutable wxRichTextStyleDefinitionHashMap m_characterStyleCache;
+    mutable wxRichTextStyleDefinitionHashMap m_paragraphStyleCache;
+    mutable wxRichTextStyleDefinitionHashMap m_listStyleCache;
+    mutable wxRichTextStyleDefinitionHashMap m_boxStyleCache;
+
+    // Cache of styles merged with their base styles, keyed by definition
+    mutable wxRichTextMergedStyleHashMap m_mergedStyleCache;
+
     wxRichTextStyleSheet*   m_previousSheet;
     wxRichTextStyleSheet*   m_nextSheet;
     wxRichTextProperties    m_properties;
@@ -54,6 +54,15 @@ public:
     // (i.e. without knowing the exact address class)
     virtual wxSockAddress *Clone() const = 0;
 
+    // configuration of the process-wide cache of successful host name lookup
+    // results: entries stay valid for the given TTL, in seconds (60 by
+    // default), setting it to 0 disables caching entirely
+    static void SetNameLookupCacheTTL(int seconds);
+    static int GetNameLookupCacheTTL();
+
+    // forget all the previously cached lookup results
+    static void ClearNameLookupCache();
+
 
     // implementation only, don't use
     const wxSockAddressImpl& GetAddress() const { return *m_impl; }
@@ -32,6 +32,36 @@ enum wxScrollbarVisibility
     wxSHOW_SB_ALWAYS        // always show scrollbar, even if not needed
 };
 
+// statistics about the scrolls done in pixel reuse mode, see
+// wxScrollHelper::EnablePixelReuse()
+struct wxScrollPixelReuseStats
+{
+    // use the widest available type for the pixel counters, which can grow
+    // quickly on big windows
+#ifdef wxLongLong_t
+    typedef wxULongLong_t PixelCount;
+#else
+    typedef unsigned long PixelCount;
+#endif
+
+    wxScrollPixelReuseStats() { Reset(); }
+
+    void Reset()
+    {
+        scrolls = 0;
+        pixelsBlitted =
+        pixelsRedrawn = 0;
+    }
+
+    // the number of scroll operations done in pixel reuse mode
+    unsigned long scrolls;
+
+    // the total number of pixels reused by blitting them to their new
+    // position and the total number of pixels which had to be redrawn
+    PixelCount pixelsBlitted,
+               pixelsRedrawn;
+};
+
 // ----------------------------------------------------------------------------
 // The hierarchy of scrolling classes is a bit complicated because we want to
 // put as much functionality as possible in a mix-in class not deriving from
@@ -167,6 +197,28 @@ public:
     // which it is implemented to not use wxWindow::ScrollWindow().
     virtual void EnableScrolling(bool x_scrolling, bool y_scrolling);
 
+    // Enable reusing the still valid contents of the target window when
+    // scrolling in a direction for which wxWindow::ScrollWindow() is not used
+    // because EnableScrolling() was called with false argument: instead of
+    // refreshing the full window, the helper blits the overlapping part of
+    // its contents to the new position and refreshes only the newly exposed
+    // strips, each with its own clip rectangle, so the paint handler redraws
+    // just what is really needed.
+    //
+    // This only gives correct results if the window contents depends on the
+    // scroll position via the DC origin only, just as when using
+    // ScrollWindow() itself -- but, unlike the latter, reusing the pixels
+    // doesn't physically move any children of the window.
+    void EnablePixelReuse(bool enable = true) { m_pixelReuseEnabled = enable; }
+    bool IsPixelReuseEnabled() const { return m_pixelReuseEnabled; }
+
+    // Statistics about the scrolls done in pixel reuse mode, allowing to
+    // check how much really is redrawn: full refreshes falling back from this
+    // mode (e.g. after scrolling by a whole window) are counted too.
+    const wxScrollPixelReuseStats& GetPixelReuseStats() const
+        { return m_pixelReuseStats; }
+    void ResetPixelReuseStats() { m_pixelReuseStats.Reset(); }
+
     // Get the view start
     void GetViewStart(int *x, int *y) const { DoGetViewStart(x, y); }
 
@@ -293,6 +345,12 @@ protected:
     // delete the event handler we installed
     void DeleteEvtHandler();
 
+    // scroll the target window contents by the given amounts by blitting the
+    // overlapping part to its new position and refreshing the exposed strips
+    // only, falling back to a full refresh if nothing at all can be reused;
+    // used instead of Refresh() when pixel reuse mode is enabled
+    void ScrollByPixelReuse(int dx, int dy);
+
     // this function should be overridden to return the size available for
     // m_targetWindow inside m_win of the given size
     //
@@ -348,6 +406,10 @@ protected:
     bool                  m_xScrollingEnabled;
     bool                  m_yScrollingEnabled;
 
+    bool                  m_pixelReuseEnabled;
+
+    wxScrollPixelReuseStats m_pixelReuseStats;
+
 #if wxUSE_MOUSEWHEEL
     int m_wheelRotation;
 #endif // wxUSE_MOUSEWHEEL
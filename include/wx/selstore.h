@@ -12,6 +12,7 @@
 #define _WX_SELSTORE_H_
 
 #include "wx/dynarray.h"
+#include "wx/vector.h"
 
 // ----------------------------------------------------------------------------
 // wxSelectedIndices is just a sorted array of indices
@@ -24,28 +25,47 @@ inline int CMPFUNC_CONV wxUIntCmp(unsigned n1, unsigned n2)
 
 WX_DEFINE_SORTED_EXPORTED_ARRAY_CMP_INT(unsigned, wxUIntCmp, wxSelectedIndices);
 
+// ----------------------------------------------------------------------------
+// wxSelectedRange: an inclusive range of selected items
+// ----------------------------------------------------------------------------
+
+struct wxSelectedRange
+{
+    wxSelectedRange(unsigned first_ = 0, unsigned last_ = 0)
+        : first(first_), last(last_)
+    {
+    }
+
+    // the number of items in the range
+    unsigned GetLength() const { return last - first + 1; }
+
+    unsigned first,
+             last;
+};
+
+typedef wxVector<wxSelectedRange> wxSelectedRangeArray;
+
 // ----------------------------------------------------------------------------
 // wxSelectionStore is used to store the selected items in the virtual
 // controls, i.e. it is well suited for storing even when the control contains
 // a huge (practically infinite) number of items.
 //
-// Of course, internally it still has to store the selected items somehow (as
-// an array currently) but the advantage is that it can handle the selection
-// of all items (common operation) efficiently and that it could be made even
-// smarter in the future (e.g. store the selections as an array of ranges +
-// individual items) without changing its API.
+// Internally the selection is stored as a sorted array of disjoint item
+// ranges, so the common operations of selecting everything or selecting a
+// contiguous block of items only take space proportional to the number of
+// ranges and not to the number of selected items.
 // ----------------------------------------------------------------------------
 
 class WXDLLIMPEXP_CORE wxSelectionStore
 {
 public:
-    wxSelectionStore() : m_itemsSel(wxUIntCmp) { Init(); }
+    wxSelectionStore() { Init(); }
 
     // set the total number of items we handle
     void SetItemCount(unsigned count);
 
     // special case of SetItemCount(0)
-    void Clear() { m_itemsSel.Clear(); m_count = 0; m_defaultState = false; }
+    void Clear() { m_ranges.clear(); m_selectedCount = 0; m_count = 0; }
 
     // must be called when new items are inserted/added
     void OnItemsInserted(unsigned item, unsigned numItems);
@@ -76,18 +96,10 @@ public:
     bool IsSelected(unsigned item) const;
 
     // return true if no items are currently selected
-    bool IsEmpty() const
-    {
-        return m_defaultState ? m_itemsSel.size() == m_count
-                              : m_itemsSel.empty();
-    }
+    bool IsEmpty() const { return m_ranges.empty(); }
 
     // return the total number of selected items
-    unsigned GetSelectedCount() const
-    {
-        return m_defaultState ? m_count - m_itemsSel.GetCount()
-                              : m_itemsSel.GetCount();
-    }
+    unsigned GetSelectedCount() const { return m_selectedCount; }
 
     // type of a "cookie" used to preserve the iteration state, this is an
     // opaque type, don't rely on its current representation
@@ -104,21 +116,33 @@ public:
 
 private:
     // (re)init
-    void Init() { m_count = 0; m_defaultState = false; }
+    void Init() { m_count = 0; m_selectedCount = 0; }
+
+    // return the index in m_ranges of the only range which could contain the
+    // given item, i.e. the first one ending at or after it: the item is
+    // selected if this index is valid and the range really starts at or
+    // before the item
+    size_t FindRange(unsigned item) const;
+
+    // make all the items of the given inclusive range selected, merging the
+    // ranges it overlaps or touches into a single bigger one
+    void DoSelectRange(unsigned itemFrom, unsigned itemTo);
+
+    // make all the items of the given inclusive range deselected, removing,
+    // truncating or splitting the existing ranges as needed
+    void DoDeselectRange(unsigned itemFrom, unsigned itemTo);
 
     // the total number of items we handle
     unsigned m_count;
 
-    // the default state: normally, false (i.e. off) but maybe set to true if
-    // there are more selected items than non selected ones - this allows to
-    // handle selection of all items efficiently
-    bool m_defaultState;
+    // the total number of selected items, always kept in sync with m_ranges
+    unsigned m_selectedCount;
 
-    // the array of items whose selection state is different from default
-    wxSelectedIndices m_itemsSel;
+    // the selected items, stored as a sorted array of disjoint and
+    // non-adjacent inclusive ranges
+    wxSelectedRangeArray m_ranges;
 
     wxDECLARE_NO_COPY_CLASS(wxSelectionStore);
 };
 
 #endif // _WX_SELSTORE_H_
-
@@ -241,7 +241,27 @@ public:
     // some metrics are toolkit-dependent and provided by wxUniv, some are
     // lowlevel
     static int GetMetric(wxSystemMetric index, const wxWindow* win = NULL);
-#endif // __WXUNIVERSAL__
+#else // !__WXUNIVERSAL__
+    // same as the base class versions, but cache the returned values as
+    // querying the native theme engine can be slow on some platforms and
+    // the drawing code may call these functions for every repaint: the
+    // cache is invalidated whenever the system notifies us about a colour,
+    // display or DPI change
+    static wxColour GetColour(wxSystemColour index);
+
+    // only the global, i.e. window-independent, values are cached: the
+    // queries for a specific window always go to the native implementation
+    static int GetMetric(wxSystemMetric index, const wxWindow* win = NULL);
+#endif // __WXUNIVERSAL__/!__WXUNIVERSAL__
+
+    // cached version of the base class GetFont()
+    static wxFont GetFont(wxSystemFont index);
+
+    // flush all the values cached by the functions above; this is called
+    // automatically when a wxSysColourChangedEvent, wxDisplayChangedEvent
+    // or wxDPIChangedEvent is generated and normally doesn't need to be
+    // called directly
+    static void InvalidateCache();
 
     // Get system screen design (desktop, pda, ..) used for
     // laying out various dialogs.
@@ -13,6 +13,8 @@
 
 #include "wx/defs.h"
 
+#include "wx/vector.h"
+
 #include "wx/window.h"
 
 //---------------------------------------------------------------------------
@@ -357,6 +359,8 @@ public:
         if ( IsWindow() )
             m_window->SetMinSize(size);
         m_minSize = size;
+
+        InvalidateContainingSizer();
     }
     void SetMinSize( int x, int y )
         { SetMinSize(wxSize(x, y)); }
@@ -366,11 +370,11 @@ public:
     // if either of dimensions is zero, ratio is assumed to be 1
     // to avoid "divide by zero" errors
     void SetRatio(int width, int height)
-        { m_ratio = (width && height) ? ((float) width / (float) height) : 1; }
+        { SetRatio((width && height) ? ((float) width / (float) height) : 1); }
     void SetRatio(const wxSize& size)
         { SetRatio(size.x, size.y); }
     void SetRatio(float ratio)
-        { m_ratio = ratio; }
+        { m_ratio = ratio; InvalidateContainingSizer(); }
     float GetRatio() const
         { return m_ratio; }
 
@@ -386,15 +390,15 @@ public:
     bool IsSpacer() const { return m_kind == Item_Spacer; }
 
     void SetProportion( int proportion )
-        { m_proportion = proportion; }
+        { m_proportion = proportion; InvalidateContainingSizer(); }
     int GetProportion() const
         { return m_proportion; }
     void SetFlag( int flag )
-        { m_flag = flag; }
+        { m_flag = flag; InvalidateContainingSizer(); }
     int GetFlag() const
         { return m_flag; }
     void SetBorder( int border )
-        { m_border = border; }
+        { m_border = border; InvalidateContainingSizer(); }
     int GetBorder() const
         { return m_border; }
 
@@ -447,6 +451,11 @@ public:
 
     void AssignSpacer(int w, int h) { AssignSpacer(wxSize(w, h)); }
 
+    // Called by the containing sizer itself when the item is added to or
+    // removed from it, this is not meant to be used from outside.
+    void SetContainingSizer(wxSizer *sizer) { m_containingSizer = sizer; }
+    wxSizer *GetContainingSizer() const { return m_containingSizer; }
+
 #if WXWIN_COMPATIBILITY_2_8
     // these functions do not free the old sizer/spacer and so can easily
     // provoke the memory leaks and so shouldn't be used, use Assign() instead
@@ -458,7 +467,7 @@ public:
 
 protected:
     // common part of several ctors
-    void Init() { m_userData = NULL; m_kind = Item_None; }
+    void Init() { m_userData = NULL; m_containingSizer = NULL; m_kind = Item_None; }
 
     // common part of ctors taking wxSizerFlags
     void Init(const wxSizerFlags& flags);
@@ -508,7 +517,15 @@ protected:
 
     wxObject    *m_userData;
 
+    // the sizer this item belongs to, if any (weak reference, maintained by
+    // the containing sizer itself)
+    wxSizer     *m_containingSizer;
+
 private:
+    // discard the cached min size of the containing sizer, called by all the
+    // setters affecting the result of CalcMin()
+    void InvalidateContainingSizer();
+
     wxDECLARE_CLASS(wxSizerItem);
     wxDECLARE_NO_COPY_CLASS(wxSizerItem);
 };
@@ -523,7 +540,12 @@ WX_DECLARE_EXPORTED_LIST( wxSizerItem, wxSizerItemList );
 class WXDLLIMPEXP_CORE wxSizer: public wxObject, public wxClientDataContainer
 {
 public:
-    wxSizer() { m_containingWindow = NULL; }
+    wxSizer()
+    {
+        m_containingWindow = NULL;
+        m_parentSizer = NULL;
+        m_cachedMinSizeValid = false;
+    }
     virtual ~wxSizer();
 
     // methods for adding elements to the sizer: there are Add/Insert/Prepend
@@ -633,6 +655,18 @@ public:
     virtual void Clear( bool delete_windows = false );
     virtual void DeleteWindows();
 
+    // update the sizer to manage exactly the given windows, in the given
+    // order, changing as little as possible: the windows already managed
+    // keep their items (and hence their flags), those absent from the list
+    // are detached (and destroyed if delete_windows is true) and the new
+    // ones are inserted at the corresponding positions using the given
+    // flags; any spacers and subsizers are left alone
+    //
+    // returns true if anything was changed
+    bool ReconcileWindows( const wxVector<wxWindow*>& windows,
+                           const wxSizerFlags& flags = wxSizerFlags(),
+                           bool delete_windows = false );
+
     // Inform sizer about the first direction that has been decided (by parent item)
     // Returns true if it made use of the information (and recalculated min size)
     //
@@ -672,6 +706,13 @@ public:
     // Calculate the minimal size or return m_minSize if bigger.
     wxSize GetMinSize();
 
+    // Discard the cached result of the last CalcMin() call for this sizer
+    // and for all the sizers containing it. This is done automatically
+    // whenever the contents of the sizer change or the best size of a
+    // contained window is invalidated, so calling it explicitly should
+    // rarely, if ever, be necessary.
+    void InvalidateCachedMinSize();
+
     // These virtual functions are used by the layout algorithm: first
     // CalcMin() is called to calculate the minimal size of the sizer and
     // prepare for laying it out and then RepositionChildren() is called with
@@ -721,7 +762,8 @@ public:
 
         // This call is required for wxWrapSizer to be able to calculate its
         // minimal size correctly.
-        InformFirstDirection(wxHORIZONTAL, size.x, size.y);
+        if ( InformFirstDirection(wxHORIZONTAL, size.x, size.y) )
+            InvalidateCachedMinSize();
     }
     void SetDimension(int x, int y, int width, int height)
         { SetDimension(wxPoint(x, y), wxSize(width, height)); }
@@ -769,6 +811,19 @@ protected:
     // the window this sizer is used in, can be NULL
     wxWindow *m_containingWindow;
 
+    // the sizer containing this one as a sub-sizer, if any (weak reference,
+    // maintained by the containing sizer itself)
+    wxSizer *m_parentSizer;
+
+    // cached result of the last CalcMin() call, only valid if
+    // m_cachedMinSizeValid is true
+    wxSize m_cachedMinSize;
+    bool m_cachedMinSizeValid;
+
+    // return the result of CalcMin(), recomputing it only if the cached
+    // value is not valid any more
+    wxSize CalcMinCached();
+
     wxSize GetMaxClientSize( wxWindow *window ) const;
     wxSize GetMinClientSize( wxWindow *window );
     wxSize VirtualFitSize( wxWindow *window );
@@ -783,6 +838,9 @@ protected:
     virtual wxSizerItem* DoInsert(size_t index, wxSizerItem *item);
 
 private:
+    // it updates m_parentSizer of the sub-sizers assigned to its items
+    friend class wxSizerItem;
+
     wxDECLARE_CLASS(wxSizer);
 };
 
@@ -110,6 +110,18 @@ enum wxSocketType
 class WXDLLIMPEXP_FWD_NET wxSocketEvent;
 wxDECLARE_EXPORTED_EVENT(WXDLLIMPEXP_NET, wxEVT_SOCKET, wxSocketEvent);
 
+// --------------------------------------------------------------------------
+// wxSocketIOVec
+// --------------------------------------------------------------------------
+
+// describes one buffer for the scatter/gather ReadV() and WriteV(): "buf"
+// points to the data to be written or to the memory to read into
+struct wxSocketIOVec
+{
+    void *buf;
+    wxUint32 len;
+};
+
 // --------------------------------------------------------------------------
 // wxSocketBase
 // --------------------------------------------------------------------------
@@ -154,9 +166,11 @@ public:
     wxSocketBase& Peek(void* buffer, wxUint32 nbytes);
     wxSocketBase& Read(void* buffer, wxUint32 nbytes);
     wxSocketBase& ReadMsg(void *buffer, wxUint32 nbytes);
+    wxSocketBase& ReadV(const wxSocketIOVec *buffers, size_t count);
     wxSocketBase& Unread(const void *buffer, wxUint32 nbytes);
     wxSocketBase& Write(const void *buffer, wxUint32 nbytes);
     wxSocketBase& WriteMsg(const void *buffer, wxUint32 nbytes);
+    wxSocketBase& WriteV(const wxSocketIOVec *buffers, size_t count);
 
     // all Wait() functions wait until their condition is satisfied or the
     // timeout expires; if seconds == -1 (default) then m_timeout value is used
@@ -243,6 +257,8 @@ private:
     // low level IO
     wxUint32 DoRead(void* buffer, wxUint32 nbytes);
     wxUint32 DoWrite(const void *buffer, wxUint32 nbytes);
+    wxUint32 DoReadV(const wxSocketIOVec *buffers, size_t count);
+    wxUint32 DoWriteV(const wxSocketIOVec *buffers, size_t count);
 
     // wait until the given flags are set for this socket or the given timeout
     // (or m_timeout) expires
@@ -343,12 +359,27 @@ class WXDLLIMPEXP_NET wxSocketClient : public wxSocketBase
 {
 public:
     wxSocketClient(wxSocketFlags flags = wxSOCKET_NONE);
+    virtual ~wxSocketClient();
 
     virtual bool Connect(const wxSockAddress& addr, bool wait = true);
     bool Connect(const wxSockAddress& addr,
                  const wxSockAddress& local,
                  bool wait = true);
 
+#if wxUSE_THREADS
+    // Resolve the given host name in a background thread, without blocking
+    // the caller, and then start a non-blocking connection attempt to it:
+    // wxSOCKET_CONNECTION event is generated once connected or wxSOCKET_LOST
+    // if either the name resolution or the connection failed. Returns false
+    // only if the resolution couldn't even be started. Requires a running
+    // event loop and may only be called from the main thread.
+    bool ConnectAsync(const wxString& host, unsigned short port);
+
+    // implementation only, don't use: called in the main thread with the
+    // result of the asynchronous name lookup started by ConnectAsync()
+    void OnAsyncResolveDone(bool ok, wxUint32 hostAddress, unsigned short port);
+#endif // wxUSE_THREADS
+
     bool WaitOnConnect(long seconds = -1, long milliseconds = 0);
 
     // Sets initial socket buffer sizes using the SO_SNDBUF and SO_RCVBUF
@@ -365,6 +396,15 @@ private:
                            const wxSockAddress* local,
                            bool wait = true);
 
+#if wxUSE_THREADS
+    // forget about the lookup still in progress, if any: its result will be
+    // simply discarded when it becomes available
+    void CancelAsyncResolve();
+
+    // identifies the pending ConnectAsync() lookup, 0 if none
+    long m_asyncResolveToken;
+#endif // wxUSE_THREADS
+
     // buffer sizes, -1 if unset and defaults should be used
     int m_initialRecvBufferSize;
     int m_initialSendBufferSize;
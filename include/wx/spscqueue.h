@@ -0,0 +1,184 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/spscqueue.h
+// Purpose:     Bounded lock-free single-producer single-consumer queue
+// Created:     2022-04-19
+// Copyright:   (c) 2022 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_SPSCQUEUE_H_
+#define _WX_SPSCQUEUE_H_
+
+#include "wx/thread.h"
+
+#if wxUSE_THREADS
+
+// we need the error codes shared with wxMessageQueue
+#include "wx/msgqueue.h"
+
+// This class is only available if the compiler provides the atomic
+// primitives needed for it, test for wxHAS_SPSC_QUEUE before using it.
+#if __cplusplus >= 201103L || wxCHECK_VISUALC_VERSION(14)
+
+#include <atomic>
+
+#define wxHAS_SPSC_QUEUE
+
+// ---------------------------------------------------------------------------
+// Bounded lock-free queue for passing messages from exactly one producer
+// thread to exactly one consumer thread.
+//
+// Unlike wxMessageQueue, which can be used from any number of threads but
+// takes a mutex for every operation, this queue stores the messages in a
+// fixed size ring buffer updated using only atomic operations: Post() never
+// blocks (it fails with wxMSGQUEUE_FULL if there is no space left), which
+// makes it usable from latency-sensitive producers such as audio callbacks,
+// while the consumer blocks on a semaphore which is only posted to, and
+// never waited on, by the producer.
+//
+// The queue can hold objects of any type T with a default constructor and
+// an assignment operator, just as with wxMessageQueue.
+// ---------------------------------------------------------------------------
+template <typename T>
+class wxSpscQueue
+{
+public:
+    // Create a queue able to hold the given number of messages, which is
+    // rounded up to the next power of 2.
+    explicit wxSpscQueue(size_t capacity)
+        : m_head(0),
+          m_tail(0)
+    {
+        size_t size = 1;
+        while ( size < capacity )
+            size *= 2;
+
+        m_mask = size - 1;
+        m_items = new T[size];
+    }
+
+    ~wxSpscQueue()
+    {
+        delete [] m_items;
+    }
+
+    // Returns true if the object had been initialized successfully, false
+    // if an error occurred.
+    bool IsOk() const
+    {
+        return m_items && m_semaphore.IsOk();
+    }
+
+    // Add a message to the queue, never blocking: this is the only method
+    // which may be called from the producer thread.
+    //
+    // Returns wxMSGQUEUE_NO_ERROR if the message was queued or
+    // wxMSGQUEUE_FULL if the consumer didn't keep up and there is no space
+    // left in the buffer.
+    wxMessageQueueError Post(const T& msg)
+    {
+        wxCHECK( IsOk(), wxMSGQUEUE_MISC_ERROR );
+
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+
+        // the consumer may be about to free a slot, but we can't wait for
+        // it: just report the queue as full
+        if ( tail - m_head.load(std::memory_order_acquire) > m_mask )
+            return wxMSGQUEUE_FULL;
+
+        m_items[tail & m_mask] = msg;
+
+        // publish the message before signalling the consumer
+        m_tail.store(tail + 1, std::memory_order_release);
+
+        return m_semaphore.Post() == wxSEMA_NO_ERROR ? wxMSGQUEUE_NO_ERROR
+                                                     : wxMSGQUEUE_MISC_ERROR;
+    }
+
+    // Block until a message becomes available in the queue and return it.
+    // Must be called from the consumer thread only.
+    wxMessageQueueError Receive(T& msg)
+    {
+        wxCHECK( IsOk(), wxMSGQUEUE_MISC_ERROR );
+
+        if ( m_semaphore.Wait() != wxSEMA_NO_ERROR )
+            return wxMSGQUEUE_MISC_ERROR;
+
+        Fetch(msg);
+
+        return wxMSGQUEUE_NO_ERROR;
+    }
+
+    // Same as Receive(), but waits at most the given number of milliseconds
+    // and returns wxMSGQUEUE_TIMEOUT if no message arrived in time.
+    wxMessageQueueError ReceiveTimeout(long timeout, T& msg)
+    {
+        wxCHECK( IsOk(), wxMSGQUEUE_MISC_ERROR );
+
+        switch ( m_semaphore.WaitTimeout(timeout) )
+        {
+            case wxSEMA_NO_ERROR:
+                break;
+
+            case wxSEMA_TIMEOUT:
+                return wxMSGQUEUE_TIMEOUT;
+
+            default:
+                return wxMSGQUEUE_MISC_ERROR;
+        }
+
+        Fetch(msg);
+
+        return wxMSGQUEUE_NO_ERROR;
+    }
+
+    // Discard all the messages currently in the queue. Must be called from
+    // the consumer thread only.
+    wxMessageQueueError Clear()
+    {
+        wxCHECK( IsOk(), wxMSGQUEUE_MISC_ERROR );
+
+        T msg;
+        while ( m_semaphore.TryWait() == wxSEMA_NO_ERROR )
+            Fetch(msg);
+
+        return wxMSGQUEUE_NO_ERROR;
+    }
+
+    // Number of messages the queue can hold.
+    size_t GetCapacity() const { return m_mask + 1; }
+
+private:
+    // remove the oldest message from the ring buffer, the semaphore must
+    // have been successfully acquired before calling this
+    void Fetch(T& msg)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+
+        msg = m_items[head & m_mask];
+
+        // release the slot to the producer
+        m_head.store(head + 1, std::memory_order_release);
+    }
+
+    // the ring buffer of (one more than) m_mask elements
+    T* m_items;
+    size_t m_mask;
+
+    // the read index, only incremented by the consumer, and the write
+    // index, only incremented by the producer; both only ever grow and are
+    // reduced modulo the buffer size when indexing m_items
+    std::atomic<size_t> m_head;
+    std::atomic<size_t> m_tail;
+
+    // counts the messages in the buffer, the consumer blocks on it
+    wxSemaphore m_semaphore;
+
+    wxDECLARE_NO_COPY_TEMPLATE_CLASS(wxSpscQueue, T);
+};
+
+#endif // C++11 atomics available
+
+#endif // wxUSE_THREADS
+
+#endif // _WX_SPSCQUEUE_H_
@@ -5082,6 +5082,13 @@ public:
     // Returns the line number of the line with the caret.
     int GetCurrentLine();
 
+    // Set the time budget, in seconds, spent styling text in one idle event
+    // when idle styling is enabled with SetIdleStyling().
+    void SetIdleStylingBudget(double seconds);
+
+    // Get the time budget, in seconds, spent styling text in one idle event.
+    double GetIdleStylingBudget() const;
+
     // Extract style settings from a spec-string which is composed of one or
     // more of the following comma separated elements:
     //
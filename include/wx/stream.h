@@ -23,6 +23,7 @@
 class WXDLLIMPEXP_FWD_BASE wxStreamBase;
 class WXDLLIMPEXP_FWD_BASE wxInputStream;
 class WXDLLIMPEXP_FWD_BASE wxOutputStream;
+class wxOperationContext;
 
 typedef wxInputStream& (*__wxInputManip)(wxInputStream&);
 typedef wxOutputStream& (*__wxOutputManip)(wxOutputStream&);
@@ -136,6 +137,11 @@ public:
     // when EOF is reached or an error occurs
     wxInputStream& Read(wxOutputStream& streamOut);
 
+    // same as above, but the copy can be interrupted, and its progress
+    // monitored, using the given context, see wx/opctx.h: this allows e.g.
+    // cancelling the extraction of a huge archive entry from another thread
+    wxInputStream& Read(wxOutputStream& streamOut, wxOperationContext& context);
+
 
     // status functions
     // ----------------
@@ -210,6 +216,10 @@ protected:
     // bytes read
     size_t GetWBack(void *buf, size_t size);
 
+    // common part of both Read(wxOutputStream&) overloads
+    wxInputStream& DoCopyTo(wxOutputStream& streamOut,
+                            wxOperationContext* context);
+
     // write back buffer or NULL if none
     char *m_wback;
 
@@ -417,6 +427,9 @@ private:
 // wxBufferedStreams to implement custom buffering
 // ---------------------------------------------------------------------------
 
+// private worker thread used by wxStreamBuffer::EnableReadAhead()
+class wxStreamBufferReadAhead;
+
 class WXDLLIMPEXP_BASE wxStreamBuffer
 {
 public:
@@ -485,6 +498,18 @@ public:
     void Fixed(bool fixed) { m_fixed = fixed; }
     void Flushable(bool f) { m_flushable = f; }
 
+    // let the buffer of a read stream grow automatically (up to 256KiB) while
+    // it keeps being exhausted by sequential reads, which reduces the number
+    // of calls to the underlying stream; only works if the buffer was
+    // allocated by us, any seek on the stream resets the growth
+    void Adaptive(bool adaptive) { m_adaptive = adaptive; }
+
+    // start reading the next block from the underlying stream on a worker
+    // thread while the already buffered data is being consumed; returns false
+    // if this is not a read buffer with its own memory or if the thread
+    // can't be created (also always fails in wxUSE_THREADS==0 build)
+    bool EnableReadAhead(bool enable = true);
+
     bool FlushBuffer();
     bool FillBuffer();
     size_t GetDataLeft();
@@ -495,6 +520,7 @@ public:
 
     bool IsFixed() const { return m_fixed; }
     bool IsFlushable() const { return m_flushable; }
+    bool IsAdaptive() const { return m_adaptive; }
 
     // only for input/output buffers respectively, returns NULL otherwise
     wxInputStream *GetInputStream() const;
@@ -523,6 +549,26 @@ protected:
     // free the buffer (always safe to call)
     void FreeBuffer();
 
+    // grow the buffer if the last fills consumed it entirely, used in
+    // adaptive mode only
+    void GrowIfSequential();
+
+    // implementation of EnableReadAhead(): cancel any outstanding read ahead
+    // (seeking the stream back over the bytes read in advance) and stop and
+    // delete the worker thread respectively; both are safe to call always
+    void CancelReadAhead();
+    void StopReadAhead();
+
+    // refill the buffer using the read ahead thread
+    bool FillBufferFromReadAhead();
+
+    // read from/seek the underlying stream, also called by the read ahead
+    // thread
+    size_t ReadFromStream(void *buffer, size_t size);
+    void SeekStreamBack(size_t size);
+
+    friend class wxStreamBufferReadAhead;
+
     // the buffer itself: the pointers to its start and end and the current
     // position in the buffer
     char *m_buffer_start,
@@ -535,10 +581,23 @@ protected:
     // its mode
     BufMode m_mode;
 
+    // the worker thread reading ahead or NULL (always NULL if !wxUSE_THREADS)
+    wxStreamBufferReadAhead *m_readAhead;
+
+    // the allocated size of the buffer when read ahead is used: we can't use
+    // GetBufferSize() for it as m_buffer_end points to the end of the data,
+    // and not of the buffer, after a short read
+    size_t m_readAheadCapacity;
+
+    // number of times the buffer was refilled without an intervening seek,
+    // used in adaptive mode only
+    size_t m_nConsecutiveFills;
+
     // flags
     bool m_destroybuf,      // deallocate buffer?
          m_fixed,
-         m_flushable;
+         m_flushable,
+         m_adaptive;
 
 
     wxDECLARE_NO_ASSIGN_CLASS(wxStreamBuffer);
@@ -2296,6 +2296,18 @@ public:
   int Find(const wxScopedWCharBuffer& sub) const
     { return Find(sub.data()); }
 
+      // case-insensitive substring search (return starting index, or -1 if
+      // not found)
+  int FindNoCase(const wxString& sub) const;
+#ifndef wxNO_IMPLICIT_WXSTRING_ENCODING
+  int FindNoCase(const char *sub) const
+    { return FindNoCase(wxString(sub)); }
+#endif // wxNO_IMPLICIT_WXSTRING_ENCODING
+  int FindNoCase(const wchar_t *sub) const
+    { return FindNoCase(wxString(sub)); }
+  int FindNoCase(const wxCStrData& sub) const
+    { return FindNoCase(sub.AsString()); }
+
       // replace first (or all of bReplaceAll) occurrences of substring with
       // another string, returns the number of replacements made
   size_t Replace(const wxString& strOld,
@@ -3612,6 +3624,13 @@ private:
           return true;
       }
 
+      // release the buffer, it will be reallocated if needed again
+      void Free()
+      {
+          free(m_str);
+          m_str = NULL;
+      }
+
       const wxScopedCharTypeBuffer<T> AsScopedBuffer() const
       {
           return wxScopedCharTypeBuffer<T>::CreateNonOwned(m_str, m_len);
@@ -4074,6 +4093,41 @@ public:
 };
 #endif // wxUSE_UNICODE_UTF8/wxUSE_UNICODE_WCHAR
 
+// ---------------------------------------------------------------------------
+// wxStringInterner: a table of canonical string instances
+// ---------------------------------------------------------------------------
+
+// This class can be used to deduplicate a large number of strings taking only
+// a few distinct values: Intern() returns a reference to the canonical
+// instance equal to its argument, so all the callers end up with the same
+// string. When wxString is reference-counted (i.e. when wxUSE_STD_STRING==0)
+// copies of the canonical instance share a single buffer too.
+class WXDLLIMPEXP_BASE wxStringInterner
+{
+public:
+    wxStringInterner();
+    ~wxStringInterner();
+
+    // Return the canonical instance equal to the given string, adding it to
+    // the table if not already present. The returned reference remains valid
+    // for the lifetime of this object (or until Clear() is called).
+    const wxString& Intern(const wxString& s);
+
+    // Return the number of distinct strings in the table.
+    size_t GetCount() const;
+
+    // Forget all the interned strings.
+    void Clear();
+
+    // Return the global interner object, created on first use.
+    static wxStringInterner& GetDefault();
+
+private:
+    class wxStringInternerData *m_data;
+
+    wxDECLARE_NO_COPY_CLASS(wxStringInterner);
+};
+
 
 // ---------------------------------------------------------------------------
 // wxString comparison functions: operator versions are always case sensitive
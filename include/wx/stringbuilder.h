@@ -0,0 +1,297 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/stringbuilder.h
+// Purpose:     wxStringBuilder class for incremental string construction
+// Created:     2022-05-14
+// Copyright:   (c) 2022 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_STRINGBUILDER_H_
+#define _WX_STRINGBUILDER_H_
+
+#include "wx/string.h"
+#include "wx/vector.h"
+#include "wx/crt.h"         // for wxSnprintf()
+
+// ----------------------------------------------------------------------------
+// wxStringBuilder: efficiently build a long string from many small pieces
+// ----------------------------------------------------------------------------
+
+// Unlike appending to a wxString, which periodically reallocates its buffer
+// and copies all the data accumulated so far into it, this class stores the
+// appended data in a list of chunks of exponentially increasing size, so
+// building a string of total length N never copies already appended data and
+// allocates only O(log N) times. The complete string is assembled in a single
+// pass by GetString() or the chunks can be retrieved one by one, e.g. for
+// writing them out to a stream without ever concatenating them at all.
+//
+// The data is stored in the native wxString representation, so appending a
+// wxString or a wide character literal doesn't convert anything in wchar_t
+// builds, while appending narrow strings converts them using the current
+// locale, exactly as the corresponding wxString operations do. Numbers are
+// converted to text directly, without going through wxString::Format(), and
+// their appending doesn't allocate any memory at all (except for the
+// non-default UTF-8 build, where floating point values take a slower path).
+class wxStringBuilder
+{
+public:
+    // The size hint is the size of the first allocated chunk, in characters.
+    explicit wxStringBuilder(size_t sizeHint = 1024)
+        : m_sizeHint(sizeHint ? sizeHint : 1),
+          m_length(0)
+    {
+    }
+
+    ~wxStringBuilder() { Clear(); }
+
+    // Delete all the data appended so far.
+    void Clear()
+    {
+        for ( size_t n = 0; n < m_chunks.size(); n++ )
+            delete [] m_chunks[n].data;
+        m_chunks.clear();
+        m_length = 0;
+    }
+
+    // Append a string, without any conversion if it's free to do so.
+    wxStringBuilder& Append(const wxString& str)
+    {
+#if wxUSE_UNICODE_UTF8
+        // This buffer just points to the internal string data, using it
+        // instead of wx_str() also gives us the length in code units, which
+        // is not the same as str.length() in this build.
+        const wxScopedCharBuffer buf(str.utf8_str());
+        DoAppend(buf.data(), buf.length());
+#else
+        DoAppend(str.wx_str(), str.length());
+#endif
+        return *this;
+    }
+
+    // Append a single character.
+    wxStringBuilder& Append(wxUniChar ch)
+    {
+        if ( ch.IsAscii() )
+        {
+            const wxStringCharType c = (wxStringCharType)(char)ch;
+            DoAppend(&c, 1);
+        }
+        else // may need encoding or a surrogate pair, let wxString do it
+        {
+            Append(wxString(ch));
+        }
+
+        return *this;
+    }
+
+    // Stream-like operators mirroring those of wxString.
+    wxStringBuilder& operator<<(const wxString& str) { return Append(str); }
+    wxStringBuilder& operator<<(const wxCStrData& str)
+        { return Append(str.AsString()); }
+#ifndef wxNO_IMPLICIT_WXSTRING_ENCODING
+    wxStringBuilder& operator<<(const char *psz)
+        { return Append(wxString(psz)); }
+#endif
+#if wxUSE_UNICODE_WCHAR
+    // In this build no conversion is needed, so don't create a temporary
+    // wxString just to copy the characters from it.
+    wxStringBuilder& operator<<(const wchar_t *pwz)
+        { DoAppend(pwz, wxStrlen(pwz)); return *this; }
+#else
+    wxStringBuilder& operator<<(const wchar_t *pwz)
+        { return Append(wxString(pwz)); }
+#endif
+
+    wxStringBuilder& operator<<(wxUniChar ch) { return Append(ch); }
+    wxStringBuilder& operator<<(wxUniCharRef ch)
+        { return Append(wxUniChar(ch)); }
+    wxStringBuilder& operator<<(char ch) { return Append(wxUniChar(ch)); }
+    wxStringBuilder& operator<<(unsigned char ch)
+        { return Append(wxUniChar(ch)); }
+    wxStringBuilder& operator<<(wchar_t ch) { return Append(wxUniChar(ch)); }
+
+    wxStringBuilder& operator<<(int i)
+        { return AppendSigned(i); }
+    wxStringBuilder& operator<<(unsigned int ui)
+        { return AppendUnsigned(ui); }
+    wxStringBuilder& operator<<(long l)
+        { return AppendSigned(l); }
+    wxStringBuilder& operator<<(unsigned long ul)
+        { return AppendUnsigned(ul); }
+#ifdef wxHAS_LONG_LONG_T_DIFFERENT_FROM_LONG
+    wxStringBuilder& operator<<(wxLongLong_t ll)
+        { return AppendSigned(ll); }
+    wxStringBuilder& operator<<(wxULongLong_t ull)
+        { return AppendUnsigned(ull); }
+#endif // wxHAS_LONG_LONG_T_DIFFERENT_FROM_LONG
+
+    // These use the same formats as the corresponding wxString operators.
+    wxStringBuilder& operator<<(float f)
+        { return AppendDouble(wxS("%f"), static_cast<double>(f)); }
+    wxStringBuilder& operator<<(double d)
+        { return AppendDouble(wxS("%g"), d); }
+
+    // The total length of the data appended so far, in code units of the
+    // native string representation (which is the same as characters except
+    // for non-BMP characters in UTF-16 builds and non-ASCII ones in UTF-8
+    // builds).
+    size_t GetLength() const { return m_length; }
+    bool IsEmpty() const { return m_length == 0; }
+
+    // Assemble and return the complete string: this is the only place where
+    // all the data is copied, exactly once, into a buffer of exactly the
+    // right size.
+    wxString GetString() const
+    {
+        wxString result;
+        if ( m_length )
+        {
+            wxStringInternalBufferLength buf(result, m_length + 1);
+            wxStringCharType *p = buf;
+            for ( size_t n = 0; n < m_chunks.size(); n++ )
+            {
+                const Chunk& chunk = m_chunks[n];
+                memcpy(p, chunk.data, chunk.len*sizeof(wxStringCharType));
+                p += chunk.len;
+            }
+            *p = 0;
+            buf.SetLength(m_length);
+        }
+
+        return result;
+    }
+
+    // Access to the individual chunks, allowing to consume the data without
+    // building the full string, e.g. for streaming it out: note that the
+    // chunk data is not NUL-terminated and, in UTF-8 builds, chunk boundaries
+    // may fall in the middle of a multibyte encoding sequence.
+    size_t GetChunkCount() const { return m_chunks.size(); }
+    const wxStringCharType* GetChunkData(size_t n) const
+        { return m_chunks[n].data; }
+    size_t GetChunkLength(size_t n) const { return m_chunks[n].len; }
+
+private:
+    // Widest available integer types used for the digit generation.
+#ifdef wxLongLong_t
+    typedef wxLongLong_t SignedValue;
+    typedef wxULongLong_t UnsignedValue;
+#else
+    typedef long SignedValue;
+    typedef unsigned long UnsignedValue;
+#endif
+
+    struct Chunk
+    {
+        wxStringCharType *data;
+        size_t len;         // the used part of the chunk
+        size_t capacity;    // its total size
+    };
+
+    // Chunk sizes double with each allocation up to this limit (in
+    // characters), which bounds the memory wasted in the last chunk.
+    static const size_t MAX_CHUNK_SIZE = 16*1024*1024;
+
+    void AddChunk()
+    {
+        Chunk chunk;
+        if ( m_chunks.empty() )
+        {
+            chunk.capacity = m_sizeHint;
+        }
+        else
+        {
+            chunk.capacity = m_chunks.back().capacity;
+            if ( chunk.capacity < MAX_CHUNK_SIZE )
+                chunk.capacity *= 2;
+        }
+
+        chunk.data = new wxStringCharType[chunk.capacity];
+        chunk.len = 0;
+
+        m_chunks.push_back(chunk);
+    }
+
+    void DoAppend(const wxStringCharType *src, size_t len)
+    {
+        m_length += len;
+
+        while ( len )
+        {
+            if ( m_chunks.empty() || m_chunks.back().len == m_chunks.back().capacity )
+                AddChunk();
+
+            Chunk& chunk = m_chunks.back();
+
+            size_t n = chunk.capacity - chunk.len;
+            if ( n > len )
+                n = len;
+
+            memcpy(chunk.data + chunk.len, src, n*sizeof(wxStringCharType));
+            chunk.len += n;
+            src += n;
+            len -= n;
+        }
+    }
+
+    wxStringBuilder& AppendUnsigned(UnsignedValue val)
+    {
+        // long enough for the decimal form of the largest 64 bit value
+        wxStringCharType buf[24];
+        wxStringCharType *p = buf + WXSIZEOF(buf);
+        do
+        {
+            *--p = (wxStringCharType)(wxT('0') + (int)(val % 10));
+            val /= 10;
+        }
+        while ( val );
+
+        DoAppend(p, buf + WXSIZEOF(buf) - p);
+
+        return *this;
+    }
+
+    wxStringBuilder& AppendSigned(SignedValue val)
+    {
+        UnsignedValue u;
+        if ( val < 0 )
+        {
+            const wxStringCharType minus = (wxStringCharType)wxT('-');
+            DoAppend(&minus, 1);
+
+            // compute the absolute value without overflowing for the most
+            // negative value
+            u = (UnsignedValue)(-(val + 1)) + 1;
+        }
+        else
+        {
+            u = (UnsignedValue)val;
+        }
+
+        return AppendUnsigned(u);
+    }
+
+    wxStringBuilder& AppendDouble(const wxChar *fmt, double val)
+    {
+#if wxUSE_UNICODE_UTF8
+        // The formatted value could, in principle, contain a non-ASCII
+        // locale-specific decimal separator, so take the safe path here.
+        return Append(wxString::Format(fmt, val));
+#else
+        // Format into a buffer on the stack to avoid allocating anything:
+        // even "%f" output for the largest doubles fits into this buffer.
+        wxChar buf[384];
+        wxSnprintf(buf, WXSIZEOF(buf), fmt, val);
+        DoAppend(buf, wxStrlen(buf));
+
+        return *this;
+#endif
+    }
+
+    wxVector<Chunk> m_chunks;
+    size_t m_sizeHint;
+    size_t m_length;
+
+    wxDECLARE_NO_COPY_CLASS(wxStringBuilder);
+};
+
+#endif // _WX_STRINGBUILDER_H_
@@ -119,15 +119,13 @@ struct WXDLLIMPEXP_BASE wxStringData
 #if defined(__VISUALC__)
   __forceinline
 #endif
-  // VC++ free must take place in same DLL as allocation when using non dll
-  // run-time library (e.g. Multithreaded instead of Multithreaded DLL)
-#if defined(__VISUALC__) && defined(_MT) && !defined(_DLL)
   void  Unlock() { if ( !IsEmpty() && --nRefs == 0) Free();  }
-  // we must not inline deallocation since allocation is not inlined
+
+  // defined in stringimpl.cpp: deallocation is never inlined as it may give
+  // the block back to the per-thread small string cache instead of really
+  // freeing it (this also ensures that, with VC++ non-DLL run-time library,
+  // the free takes place in the same DLL as the allocation)
   void  Free();
-#else
-  void  Unlock() { if ( !IsEmpty() && --nRefs == 0) free(this);  }
-#endif
 
   // if we had taken control over string memory (GetWriteBuf), it's
   // intentionally put in invalid state
@@ -150,6 +150,7 @@ private:
 // wxTarInputStream
 
 WX_DECLARE_STRING_HASH_MAP(wxString, wxTarHeaderRecords);
+WX_DECLARE_STRING_HASH_MAP(wxTarEntry*, wxTarIndex);
 
 class WXDLLIMPEXP_BASE wxTarInputStream : public wxArchiveInputStream
 {
@@ -165,6 +166,18 @@ public:
 
     wxTarEntry *GetNextEntry();
 
+    // index mode: scan all the remaining headers once, skipping over the
+    // entry data using seeks, then entries can be opened directly by name
+    bool BuildIndex();
+    bool HasIndex() const               { return m_index != NULL; }
+    wxTarEntry *FindEntry(const wxString& name) const;
+    bool OpenEntry(const wxString& name);
+
+    // save/reload the index, e.g. to a file alongside the archive, so that
+    // repeat accesses don't need to rescan the headers
+    bool SaveIndex(wxOutputStream& stream) const;
+    bool LoadIndex(wxInputStream& stream);
+
     wxFileOffset GetLength() const wxOVERRIDE      { return m_size; }
     bool IsSeekable() const wxOVERRIDE { return m_parent_i_stream->IsSeekable(); }
 
@@ -180,6 +193,8 @@ private:
     bool OpenEntry(wxArchiveEntry& entry) wxOVERRIDE;
     bool IsOpened() const               { return m_pos != wxInvalidOffset; }
 
+    void ClearIndex();
+
     wxStreamError ReadHeaders();
     bool ReadExtendedHeader(wxTarHeaderRecords*& recs);
 
@@ -198,6 +213,7 @@ private:
     class wxTarHeaderBlock *m_hdr;
     wxTarHeaderRecords *m_HeaderRecs;
     wxTarHeaderRecords *m_GlobalHeaderRecs;
+    wxTarIndex *m_index;
 
     wxDECLARE_NO_COPY_CLASS(wxTarInputStream);
 };
@@ -35,6 +35,7 @@ enum wxTextFileType
 #if wxUSE_TEXTBUFFER
 
 #include "wx/dynarray.h"
+#include "wx/vector.h"
 
 // ----------------------------------------------------------------------------
 // wxTextBuffer
@@ -86,47 +87,69 @@ public:
     // same as Open() but with (another) buffer name
     bool Open(const wxString& strBufferName, const wxMBConv& conv = wxConvAuto());
 
+    // as Open() but tries to map the buffer contents into memory instead of
+    // loading and converting everything at once: the lines are then converted
+    // lazily, on first access, and only an index of the line offsets is kept
+    // in memory, so even huge buffers can be opened cheaply -- but they are
+    // read-only in this mode, any modifications to the lines are discarded
+    //
+    // falls back to a normal Open() if mapping is not supported (e.g. for
+    // wxMemoryText or if the encoding is not ASCII-compatible)
+    bool OpenMapped(const wxMBConv& conv = wxConvAuto());
+
+    // same as OpenMapped() but with (another) buffer name
+    bool OpenMapped(const wxString& strBufferName,
+                    const wxMBConv& conv = wxConvAuto());
+
     // closes the buffer and frees memory, losing all changes
     bool Close();
 
     // is buffer currently opened?
     bool IsOpened() const { return m_isOpened; }
 
+    // was the buffer mapped into memory by OpenMapped()?
+    bool IsMapped() const { return m_mapData != NULL; }
+
     // accessors
     // ---------
 
     // get the number of lines in the buffer
-    size_t GetLineCount() const { return m_aLines.size(); }
+    size_t GetLineCount() const
+        { return IsMapped() ? GetMappedLineCount() : m_aLines.size(); }
 
     // the returned line may be modified (but don't add CR/LF at the end!)
-          wxString& GetLine(size_t n)          { return m_aLines[n]; }
-    const wxString& GetLine(size_t n)    const { return m_aLines[n]; }
-          wxString& operator[](size_t n)       { return m_aLines[n]; }
-    const wxString& operator[](size_t n) const { return m_aLines[n]; }
+    // unless the buffer is mapped, in which case modifications are discarded
+          wxString& GetLine(size_t n)
+        { return IsMapped() ? GetMappedLine(n) : m_aLines[n]; }
+    const wxString& GetLine(size_t n)    const
+        { return IsMapped() ? GetMappedLine(n) : m_aLines[n]; }
+          wxString& operator[](size_t n)       { return GetLine(n); }
+    const wxString& operator[](size_t n) const { return GetLine(n); }
 
     // the current line has meaning only when you're using
     // GetFirstLine()/GetNextLine() functions, it doesn't get updated when
     // you're using "direct access" i.e. GetLine()
     size_t GetCurrentLine() const { return m_nCurLine; }
     void GoToLine(size_t n) { m_nCurLine = n; }
-    bool Eof() const { return m_nCurLine == m_aLines.size(); }
+    bool Eof() const { return m_nCurLine == GetLineCount(); }
 
     // these methods allow more "iterator-like" traversal of the list of
     // lines, i.e. you may write something like:
     //  for ( str = GetFirstLine(); !Eof(); str = GetNextLine() ) { ... }
 
     wxString& GetFirstLine()
-        { return m_aLines.empty() ? ms_eof : m_aLines[m_nCurLine = 0]; }
+        { return GetLineCount() == 0 ? ms_eof : GetLine(m_nCurLine = 0); }
     wxString& GetNextLine()
-        { return ++m_nCurLine == m_aLines.size() ? ms_eof
-                                                 : m_aLines[m_nCurLine]; }
+        { return ++m_nCurLine == GetLineCount() ? ms_eof
+                                                : GetLine(m_nCurLine); }
     wxString& GetPrevLine()
-        { wxASSERT(m_nCurLine > 0); return m_aLines[--m_nCurLine]; }
+        { wxASSERT(m_nCurLine > 0); return GetLine(--m_nCurLine); }
     wxString& GetLastLine()
-        { return m_aLines.empty() ? ms_eof : m_aLines[m_nCurLine = m_aLines.size() - 1]; }
+        { return GetLineCount() == 0 ? ms_eof : GetLine(m_nCurLine = GetLineCount() - 1); }
 
     // get the type of the line (see also GetEOL)
-    wxTextFileType GetLineType(size_t n) const { return m_aTypes[n]; }
+    wxTextFileType GetLineType(size_t n) const
+        { return IsMapped() ? GetMappedLineType(n) : m_aTypes[n]; }
 
     // guess the type of buffer
     wxTextFileType GuessType() const;
@@ -139,12 +162,16 @@ public:
 
     // add a line to the end
     void AddLine(const wxString& str, wxTextFileType type = typeDefault)
-        { m_aLines.push_back(str); m_aTypes.push_back(type); }
+    {
+        wxCHECK_RET( !IsMapped(), wxT("mapped text buffer is read-only") );
+        m_aLines.push_back(str); m_aTypes.push_back(type);
+    }
     // insert a line before the line number n
     void InsertLine(const wxString& str,
                   size_t n,
                   wxTextFileType type = typeDefault)
     {
+        wxCHECK_RET( !IsMapped(), wxT("mapped text buffer is read-only") );
         m_aLines.insert(m_aLines.begin() + n, str);
         m_aTypes.insert(m_aTypes.begin()+n, type);
     }
@@ -152,12 +179,14 @@ public:
     // delete one line
     void RemoveLine(size_t n)
     {
+        wxCHECK_RET( !IsMapped(), wxT("mapped text buffer is read-only") );
         m_aLines.erase(m_aLines.begin() + n);
         m_aTypes.erase(m_aTypes.begin() + n);
     }
 
     // remove all lines
-    void Clear() { m_aLines.clear(); m_aTypes.clear(); m_nCurLine = 0; }
+    void Clear()
+        { UnmapIfNeeded(); m_aLines.clear(); m_aTypes.clear(); m_nCurLine = 0; }
 
     // change the buffer (default argument means "don't change type")
     // possibly in another format
@@ -172,7 +201,7 @@ protected:
     // -----
 
     // default ctor, use Open(string)
-    wxTextBuffer() { m_nCurLine = 0; m_isOpened = false; }
+    wxTextBuffer() { Init(); }
 
     // ctor from filename
     wxTextBuffer(const wxString& strBufferName);
@@ -187,16 +216,61 @@ protected:
     virtual bool OnRead(const wxMBConv& conv) = 0;
     virtual bool OnWrite(wxTextFileType typeNew, const wxMBConv& conv) = 0;
 
+    // May be overridden to support OpenMapped(): map the buffer contents into
+    // memory (the buffer is opened for reading when this is called) and
+    // return the pointer to it and its length in bytes or NULL if mapping is
+    // not supported or failed -- OpenMapped() degrades to Open() then.
+    virtual const char *OnMap(size_t *WXUNUSED(len)) { return NULL; }
+
+    // Undo OnMap(): called with the pointer and length it returned.
+    virtual void OnUnmap(const char *WXUNUSED(data), size_t WXUNUSED(len)) { }
+
+    // release the mapping, if any, and reset the associated state: must be
+    // called from the derived class dtor as the base class one can't call the
+    // OnUnmap() override any more
+    void UnmapIfNeeded();
+
     static wxString ms_eof;     // dummy string returned at EOF
     wxString m_strBufferName;   // name of the buffer
 
 private:
+    // common part of all ctors
+    void Init();
+
+    // build m_mapLineStarts/m_mapLineTypes if not done yet
+    void BuildMappedIndex() const;
+
+    // mapped counterparts of the accessors above, only valid if IsMapped()
+    size_t GetMappedLineCount() const;
+    wxString& GetMappedLine(size_t n) const;
+    wxTextFileType GetMappedLineType(size_t n) const;
+
     wxArrayLinesType m_aTypes;   // type of each line
     wxArrayString    m_aLines;   // lines of file
 
     size_t        m_nCurLine; // number of current line in the buffer
 
     bool          m_isOpened; // was the buffer successfully opened the last time?
+
+    // everything below is only used when the buffer is mapped: the lines then
+    // live in the mapped region and are converted on demand instead of being
+    // stored in m_aLines
+    const char   *m_mapData;  // start of the mapped region or NULL
+    size_t        m_mapLen;   // length of the mapped region in bytes
+    wxMBConv     *m_mapConv;  // our clone of the conversion to use
+
+    // the index of the lines, built on first access only
+    mutable wxVector<size_t> m_mapLineStarts;  // byte offset of each line
+    mutable wxArrayLinesType m_mapLineTypes;   // and its terminator type
+    mutable bool  m_mapIndexBuilt;
+
+    // a small cache of the most recently converted lines, replaced in a round
+    // robin fashion (so the references returned by GetLine() stay valid only
+    // for this many calls)
+    enum { MappedCacheSize = 8 };
+    mutable size_t   m_mapCacheLine[MappedCacheSize]; // line cached in slot
+    mutable wxString m_mapCacheStr[MappedCacheSize];
+    mutable size_t   m_mapCacheNext; // next slot to replace
 #endif // wxUSE_TEXTBUFFER
 
     // copy ctor/assignment operator not implemented
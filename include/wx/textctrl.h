@@ -756,7 +756,13 @@ public:
     // creation
     // --------
 
-    wxTextCtrlBase() { }
+    wxTextCtrlBase()
+    {
+        m_coalesceAppend =
+        m_appendFlushScheduled = false;
+        m_appendMaxLines =
+        m_appendPendingLines = 0;
+    }
     virtual ~wxTextCtrlBase() { }
 
 
@@ -814,6 +820,30 @@ public:
        wxTextEntry::SetValue(value);
     }
 
+    virtual void AppendText(const wxString& text) wxOVERRIDE
+    {
+        if ( !DoCoalesceAppend(text) )
+            wxTextEntry::AppendText(text);
+    }
+
+    // append coalescing: when enabled, AppendText() doesn't modify the
+    // control immediately any more but buffers the appended text and inserts
+    // all of it at once, with a single refresh and scroll, during the next
+    // event loop iteration, which is much faster when many lines are appended
+    // in a row, e.g. when showing the output of a build or a log
+    //
+    // if maxLines is non-zero, it also limits the total number of lines kept
+    // in the control: the oldest lines are discarded during each flush
+    //
+    // note that the buffered text is not taken into account by the other
+    // methods, e.g. GetValue(), until it is flushed, use FlushAppendedText()
+    // if this matters; disabling coalescing flushes the pending text too
+    void EnableAppendCoalescing(bool enable = true, unsigned long maxLines = 0);
+    bool IsAppendCoalescing() const { return m_coalesceAppend; }
+
+    // insert any still buffered appended text into the control immediately
+    void FlushAppendedText();
+
     // wxWindow overrides
     virtual wxVisualAttributes GetDefaultAttributes() const wxOVERRIDE
     {
@@ -861,6 +891,26 @@ protected:
     // implement the wxTextEntry pure virtual method
     virtual wxWindow *GetEditableWindow() wxOVERRIDE { return this; }
 
+    // buffer the given text if append coalescing is enabled and return true,
+    // or return false if it should be appended directly: ports overriding
+    // AppendText() must call this first and return immediately if it returns
+    // true
+    bool DoCoalesceAppend(const wxString& text);
+
+private:
+    // the text buffered by DoCoalesceAppend() and not yet inserted into the
+    // control and the number of line breaks in it
+    wxString m_appendPending;
+    unsigned long m_appendPendingLines;
+
+    // scrollback limit enforced during the flush, 0 if none
+    unsigned long m_appendMaxLines;
+
+    bool m_coalesceAppend;
+
+    // true if a FlushAppendedText() call is already scheduled
+    bool m_appendFlushScheduled;
+
     wxDECLARE_NO_COPY_CLASS(wxTextCtrlBase);
     wxDECLARE_ABSTRACT_CLASS(wxTextCtrlBase);
 };
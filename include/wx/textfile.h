@@ -32,6 +32,9 @@ public:
     wxTextFile() { }
     wxTextFile(const wxString& strFileName);
 
+    // dtor releases the mapping created by OpenMapped(), if any
+    virtual ~wxTextFile() { UnmapIfNeeded(); }
+
 protected:
     // implement the base class pure virtuals
     virtual bool OnExists() const wxOVERRIDE;
@@ -41,6 +44,10 @@ protected:
     virtual bool OnRead(const wxMBConv& conv) wxOVERRIDE;
     virtual bool OnWrite(wxTextFileType typeNew, const wxMBConv& conv) wxOVERRIDE;
 
+    // map the file into memory if the platform supports it
+    virtual const char *OnMap(size_t *len) wxOVERRIDE;
+    virtual void OnUnmap(const char *data, size_t len) wxOVERRIDE;
+
 private:
 
     wxFile m_file;
@@ -119,6 +119,7 @@ enum wxMutexType
 };
 
 // forward declarations
+class WXDLLIMPEXP_FWD_BASE wxArrayInt;
 class WXDLLIMPEXP_FWD_BASE wxThreadHelper;
 class WXDLLIMPEXP_FWD_BASE wxConditionInternal;
 class WXDLLIMPEXP_FWD_BASE wxMutexInternal;
@@ -564,6 +565,17 @@ public:
         // Get the current priority.
     unsigned int GetPriority() const;
 
+    // affinity
+        // Bind the thread to the given set of logical CPUs: it will only be
+        // scheduled to run on them from now on. The CPU indices must be in
+        // the 0..GetCPUCount()-1 range and the array must not be empty; the
+        // thread must have been created already.
+        //
+        // Returns true on success, false if binding threads to CPUs is not
+        // supported on this platform (currently it's implemented for Linux
+        // and MSW only) or if it failed.
+    bool SetAffinity(const wxArrayInt& cpus);
+
     // thread status inquiries
         // Returns true if the thread is alive: i.e. running or suspended
     bool IsAlive() const;
@@ -646,6 +658,40 @@ private:
     bool m_isDetached;
 };
 
+// ----------------------------------------------------------------------------
+// wxCpuTopology: static queries about the CPUs the threads can run on,
+// allowing the code creating many worker threads to place them deliberately,
+// e.g. one per physical core or near the memory they're going to use
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxCpuTopology
+{
+public:
+    // number of logical CPUs: as wxThread::GetCPUCount() but never negative,
+    // returns 1 if the real value cannot be determined
+    static int GetLogicalCpuCount();
+
+    // number of physical cores, i.e. logical CPUs without counting the SMT
+    // ("hyper-threading") siblings; falls back to GetLogicalCpuCount() if the
+    // topology information is unavailable
+    static int GetCoreCount();
+
+    // the logical CPUs sharing a physical core with the given one, including
+    // the given CPU itself (which is the only element if the topology
+    // information is unavailable or if the core is not SMT)
+    static wxArrayInt GetSmtSiblings(int cpu);
+
+    // number of NUMA memory nodes, 1 for non-NUMA (and unknown) systems
+    static int GetNumaNodeCount();
+
+    // the NUMA node the given logical CPU belongs to, 0 if unknown
+    static int GetCpuNumaNode(int cpu);
+
+private:
+    // this class has static methods only
+    wxCpuTopology();
+};
+
 // wxThreadHelperThread class
 // --------------------------
 
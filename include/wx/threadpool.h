@@ -0,0 +1,337 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/threadpool.h
+// Purpose:     wxThreadPool and wxThreadPoolTask classes
+// Created:     2022-04-18
+// Copyright:   (c) 2022 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_THREADPOOL_H_
+#define _WX_THREADPOOL_H_
+
+#include "wx/thread.h"
+
+#if wxUSE_THREADS
+
+#include "wx/atomic.h"
+#include "wx/vector.h"
+
+#include "wx/beforestd.h"
+#include <deque>
+#include "wx/afterstd.h"
+
+class wxTaskGraph;
+class wxTaskGraphRunner;
+class wxThreadPool;
+class wxThreadPoolWorker;
+
+// ----------------------------------------------------------------------------
+// wxThreadPoolTask: a unit of work executed by wxThreadPool
+// ----------------------------------------------------------------------------
+
+// To run something in a pool, derive from this class, put the inputs (and
+// later the results) of the computation into the fields of the derived class
+// and override Execute() which is called from one of the pool worker threads.
+//
+// Task objects are reference counted: the pool keeps its own reference while
+// the task is queued or running, so the caller may simply call DecRef() right
+// after wxThreadPool::AddTask() if it's not interested in the task any more,
+// or keep its reference and use Wait()/GetState() to retrieve the results.
+class WXDLLIMPEXP_BASE wxThreadPoolTask
+{
+public:
+    // the life cycle of a task: it starts pending, is running while Execute()
+    // is being called and ends up either completed or, if it was still
+    // pending when the pool was destroyed, cancelled
+    enum State
+    {
+        State_Pending,
+        State_Running,
+        State_Completed,
+        State_Cancelled
+    };
+
+    wxThreadPoolTask();
+
+    // override this to do the actual work, it is called from a worker thread
+    // and must not throw
+    virtual void Execute() = 0;
+
+    // called in the context of the main thread after Execute() finishes if
+    // there is an application object to deliver the notification through
+    // (and directly from the worker thread otherwise), default version does
+    // nothing
+    virtual void OnCompleted() { }
+
+    // get the current state of the task; note that, as the task may be
+    // running concurrently, the state can change at any moment
+    State GetState() const;
+
+    // block until the task is completed or cancelled and return true if it
+    // ran to completion, beware of calling this from the main thread of a
+    // GUI application as it would block the user interface
+    bool Wait();
+
+    // reference counting: DecRef() must be called exactly once for each
+    // IncRef() and once for the initial reference of a newly created task
+    void IncRef();
+    void DecRef();
+
+protected:
+    // the dtor is protected, call DecRef() instead of deleting the task
+    virtual ~wxThreadPoolTask();
+
+private:
+    // the pool and the task graph transition the task between the states
+    friend class wxThreadPool;
+    friend class wxTaskGraph;
+
+    // change the state and wake up any threads blocked in Wait()
+    void SetState(State state);
+
+    wxAtomicInt m_refCount;
+
+    State m_state;
+
+    // protect m_state and signal its changes to Wait()
+    wxMutex m_stateMutex;
+    wxCondition m_stateCond;
+
+    wxDECLARE_NO_COPY_CLASS(wxThreadPoolTask);
+};
+
+// ----------------------------------------------------------------------------
+// wxThreadPool: run tasks on a fixed set of lazily created worker threads
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxThreadPool
+{
+public:
+    // create a pool using up to the given number of worker threads or as many
+    // threads as there are processors in the system by default; the threads
+    // themselves are only started when there is work for them to do
+    explicit wxThreadPool(int numThreads = -1);
+
+    // the dtor cancels all still pending tasks but waits for the tasks
+    // already being executed to finish
+    ~wxThreadPool();
+
+    // queue a task for execution, taking a new reference to it: tasks
+    // submitted from outside of the pool are started in order of decreasing
+    // priority, tasks submitted by another task of the same pool go to the
+    // work-stealing queue of the worker submitting them and ignore the
+    // priority
+    //
+    // returns false if the task couldn't be queued (e.g. the pool is being
+    // destroyed)
+    bool AddTask(wxThreadPoolTask* task, int priority = wxPRIORITY_DEFAULT);
+
+    // block until all currently queued and running tasks have finished
+    void WaitForAll();
+
+    // maximal number of worker threads used by the pool
+    size_t GetThreadCount() const { return m_maxThreads; }
+
+    // return the process-wide default pool, creating it on first use
+    static wxThreadPool& GetDefault();
+
+private:
+    friend class wxThreadPoolWorker;
+
+    // a task queued from outside of the pool together with its priority
+    struct QueuedTask
+    {
+        QueuedTask(wxThreadPoolTask* task_, int priority_)
+            : task(task_), priority(priority_)
+        {
+        }
+
+        wxThreadPoolTask* task;
+        int priority;
+    };
+
+    // main loop of the worker with the given index, runs until shutdown
+    void WorkerLoop(size_t indexWorker);
+
+    // get the next task to execute for this worker or NULL if there is
+    // nothing to do right now; must be called with m_mutex locked
+    wxThreadPoolTask* FindWork(size_t indexWorker);
+
+    // return the index of the worker corresponding to the current thread or
+    // wxNOT_FOUND if we're not called from one of our workers; must be
+    // called with m_mutex locked
+    int GetCurrentWorkerIndex() const;
+
+    // execute the given task and deliver its completion notification
+    void RunTask(wxThreadPoolTask* task);
+
+
+    // maximal number of workers, fixed at creation time
+    const size_t m_maxThreads;
+
+    // protects all the variables below
+    mutable wxMutex m_mutex;
+
+    // signalled when a task is added or the pool shuts down
+    wxCondition m_condHasWork;
+
+    // signalled when the pool may have become idle
+    wxCondition m_condIdle;
+
+    // the workers created so far, only grows up to m_maxThreads
+    wxVector<wxThreadPoolWorker*> m_workers;
+
+    // tasks queued from outside of the pool, kept sorted by decreasing
+    // priority (FIFO within the same priority)
+    std::deque<QueuedTask> m_queue;
+
+    // per worker deques of tasks submitted by the tasks running on this
+    // worker: the owner pops from the back, the other workers steal from
+    // the front
+    wxVector< std::deque<wxThreadPoolTask*> > m_workerQueues;
+
+    // number of tasks currently being executed
+    size_t m_numActive;
+
+    // number of workers waiting for work inside FindWork()
+    size_t m_numIdle;
+
+    // set by the dtor to make the workers exit
+    bool m_shuttingDown;
+
+    wxDECLARE_NO_COPY_CLASS(wxThreadPool);
+};
+
+// ----------------------------------------------------------------------------
+// wxTaskGraph: execute interdependent tasks on a wxThreadPool
+// ----------------------------------------------------------------------------
+
+// An opaque handle to a task added to a wxTaskGraph, only used for declaring
+// the dependencies between the tasks.
+class WXDLLIMPEXP_BASE wxTaskGraphNode
+{
+private:
+    // nodes are created, manipulated and destroyed by the graph only
+    friend class wxTaskGraph;
+
+    wxTaskGraphNode(wxThreadPoolTask* task, size_t index, bool runInMain)
+        : m_task(task),
+          m_index(index),
+          m_runInMain(runInMain),
+          m_numPendingPreds(0),
+          m_cancelled(false)
+    {
+    }
+
+    // the task to execute, the graph keeps a reference to it
+    wxThreadPoolTask* const m_task;
+
+    // index of this node in wxTaskGraph::m_nodes
+    const size_t m_index;
+
+    // if true, the task runs in the main thread and not in a pool worker
+    const bool m_runInMain;
+
+    // number of predecessors that didn't finish yet, the node becomes ready
+    // to run when this drops to 0
+    size_t m_numPendingPreds;
+
+    // set when a predecessor is cancelled: this node won't run either
+    bool m_cancelled;
+
+    // the nodes that can't run before this one finishes
+    wxVector<wxTaskGraphNode*> m_dependents;
+
+    wxDECLARE_NO_COPY_CLASS(wxTaskGraphNode);
+};
+
+// A task graph turns one-off thread dances into declarative parallel
+// pipelines: add the tasks of the pipeline, declare the dependencies between
+// them and call Submit() to let the pool execute them in a valid order,
+// running independent tasks in parallel. Tasks submitted by already running
+// tasks of the same pool use its work-stealing queues, see
+// wxThreadPool::AddTask().
+//
+// Tasks marked as GUI-affine, typically the terminal ones delivering the
+// pipeline results, are executed in the main thread, via the pending events
+// mechanism, instead of a worker.
+class WXDLLIMPEXP_BASE wxTaskGraph
+{
+public:
+    // create a graph executing its tasks in the given pool or in
+    // wxThreadPool::GetDefault() by default; the pool must outlive the graph
+    explicit wxTaskGraph(wxThreadPool* pool = NULL);
+
+    // the dtor waits for all tasks of a submitted graph to finish; the tasks
+    // of a graph that was never submitted are cancelled
+    ~wxTaskGraph();
+
+    // add a task to the graph, taking a new reference to it, and return the
+    // node to use with AddDependency(); if runInMainThread is true, the task
+    // is executed in the main thread when it becomes ready
+    //
+    // can only be called before Submit()
+    wxTaskGraphNode* AddTask(wxThreadPoolTask* task,
+                             bool runInMainThread = false);
+
+    // declare that the given node can only start running after the
+    // predecessor node has finished; both nodes must belong to this graph
+    //
+    // can only be called before Submit()
+    void AddDependency(wxTaskGraphNode* node, wxTaskGraphNode* predecessor);
+
+    // start executing the graph: all tasks without predecessors are queued
+    // immediately and the others as their dependencies complete
+    //
+    // returns false without running anything if the dependencies contain a
+    // cycle
+    bool Submit();
+
+    // block until all tasks of the graph have finished; beware of calling
+    // this from the main thread if the graph contains GUI-affine tasks as
+    // they would never get a chance to run
+    void Wait();
+
+private:
+    friend class wxTaskGraphRunner;
+
+    // queue the newly ready node for execution
+    void StartNode(wxTaskGraphNode* node);
+
+    // execute the task of the given node, called from a pool worker or, for
+    // the GUI-affine nodes, the main thread
+    void RunNode(wxTaskGraphNode* node);
+
+    // cancel the node (and, recursively, its dependents) which can't be run,
+    // e.g. because the pool is shutting down
+    void CancelNode(wxTaskGraphNode* node);
+
+    // account for a finished node and collect the nodes it made ready; must
+    // be called with m_mutex locked
+    void CompleteNode(wxTaskGraphNode* node, wxVector<wxTaskGraphNode*>& ready);
+
+
+    // the pool executing our tasks
+    wxThreadPool* const m_pool;
+
+    // protects the variables below
+    wxMutex m_mutex;
+
+    // signalled when the last task finishes
+    wxCondition m_condDone;
+
+    // all the nodes of the graph, owned by it
+    wxVector<wxTaskGraphNode*> m_nodes;
+
+    // number of nodes that didn't finish yet, only meaningful after Submit()
+    size_t m_numRemaining;
+
+    // set once Submit() has been called successfully
+    bool m_submitted;
+
+    wxDECLARE_NO_COPY_CLASS(wxTaskGraph);
+};
+
+#endif // wxUSE_THREADS
+
+#endif // _WX_THREADPOOL_H_
@@ -69,6 +69,8 @@ class WXDLLIMPEXP_FWD_BASE wxArrayString;
 class WXDLLIMPEXP_FWD_BASE wxTranslationsLoader;
 class WXDLLIMPEXP_FWD_BASE wxLocale;
 
+class wxMsgCatalogFile;
+
 class wxPluralFormsCalculator;
 wxDECLARE_SCOPED_PTR(wxPluralFormsCalculator, wxPluralFormsCalculatorPtr)
 
@@ -81,9 +83,7 @@ class WXDLLIMPEXP_BASE wxMsgCatalog
 public:
     // Ctor is protected, because CreateFromXXX functions must be used,
     // but destruction should be unrestricted
-#if !wxUSE_UNICODE
     ~wxMsgCatalog();
-#endif
 
     // load the catalog from disk or from data; caller is responsible for
     // deleting them if not NULL
@@ -105,6 +105,7 @@ protected:
 #if !wxUSE_UNICODE
         , m_conv(NULL)
 #endif
+        , m_file(NULL)
     {}
 
 private:
@@ -112,7 +113,10 @@ private:
     wxMsgCatalog *m_pNext;
     friend class wxTranslations;
 
-    wxStringToStringHashMap m_messages; // all messages in the catalog
+    // all messages in the catalog or, if m_file is used, just those fetched
+    // so far (hence "mutable": GetString() adds to it on first fetch)
+    mutable wxStringToStringHashMap m_messages;
+
     wxString                m_domain;   // name of the domain
 
 #if !wxUSE_UNICODE
@@ -121,6 +125,10 @@ private:
     wxCSConv *m_conv;
 #endif
 
+    // the catalog data itself, non-NULL only if the strings are looked up in
+    // it directly instead of being all converted into m_messages upfront
+    wxMsgCatalogFile *m_file;
+
     wxPluralFormsCalculatorPtr m_pluralFormsCalculator;
 };
 
@@ -9,10 +9,17 @@
 
 /* THIS IS A C FILE, DON'T USE C++ FEATURES (IN PARTICULAR COMMENTS) IN IT */
 
+/* this option is new in 3.1.7, define it for the configurations not updated
+   to do it themselves yet */
+#ifndef wxUSE_KQUEUE_DISPATCHER
+#   define wxUSE_KQUEUE_DISPATCHER 0
+#endif
+
 #if wxUSE_CONSOLE_EVENTLOOP
-#   if !wxUSE_SELECT_DISPATCHER && !wxUSE_EPOLL_DISPATCHER
+#   if !wxUSE_SELECT_DISPATCHER && !wxUSE_EPOLL_DISPATCHER && \
+        !wxUSE_KQUEUE_DISPATCHER
 #       ifdef wxABORT_ON_CONFIG_ERROR
-#           error "wxSelect/EpollDispatcher needed for console event loop"
+#           error "wxSelect/Epoll/KqueueDispatcher needed for console event loop"
 #       else
 #           undef wxUSE_SELECT_DISPATCHER
 #           define wxUSE_SELECT_DISPATCHER 1
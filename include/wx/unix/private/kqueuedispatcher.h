@@ -0,0 +1,64 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        wx/unix/private/kqueuedispatcher.h
+// Purpose:     wxKqueueDispatcher class
+// Created:     2022-04-18
+// Copyright:   (c) 2022 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_PRIVATE_KQUEUEDISPATCHER_H_
+#define _WX_PRIVATE_KQUEUEDISPATCHER_H_
+
+#include "wx/defs.h"
+
+#if wxUSE_KQUEUE_DISPATCHER
+
+#include "wx/private/fdiodispatcher.h"
+
+struct kevent;
+
+// dispatcher implementation using kqueue(2), available under the BSD systems
+// including OS X
+//
+// we derive from wxMappedFDIODispatcher and not wxFDIODispatcher directly
+// because we need to know the currently registered flags in ModifyFD() to be
+// able to remove the filters which are not used any more
+class WXDLLIMPEXP_BASE wxKqueueDispatcher : public wxMappedFDIODispatcher
+{
+public:
+    // create a new instance of this class, can return NULL if kqueue() is not
+    // supported on this system
+    //
+    // the caller should delete the returned pointer
+    static wxKqueueDispatcher *Create();
+
+    virtual ~wxKqueueDispatcher();
+
+    // implement base class pure virtual methods
+    virtual bool RegisterFD(int fd, wxFDIOHandler* handler, int flags = wxFDIO_ALL) wxOVERRIDE;
+    virtual bool ModifyFD(int fd, wxFDIOHandler* handler, int flags = wxFDIO_ALL) wxOVERRIDE;
+    virtual bool UnregisterFD(int fd) wxOVERRIDE;
+    virtual bool HasPending() const wxOVERRIDE;
+    virtual int Dispatch(int timeout = TIMEOUT_INFINITE) wxOVERRIDE;
+
+private:
+    // ctor is private, use Create()
+    wxKqueueDispatcher(int kqueueDescriptor);
+
+    // register or modify the kqueue filters for the given fd so that they
+    // correspond to the given flags (oldFlags contains the currently
+    // registered ones, possibly 0)
+    bool DoUpdateFilters(int fd, wxFDIOHandler* handler,
+                         int flags, int oldFlags);
+
+    // common part of HasPending() and Dispatch(): calls kevent() with the
+    // given timeout
+    int DoPoll(struct kevent *events, int numEvents, int timeout) const;
+
+
+    int m_kqueueDescriptor;
+};
+
+#endif // wxUSE_KQUEUE_DISPATCHER
+
+#endif // _WX_PRIVATE_KQUEUEDISPATCHER_H_
@@ -14,10 +14,14 @@
 
 #include "wx/private/timer.h"
 
+#include "wx/vector.h"
+
 // the type used for milliseconds is large enough for microseconds too but
 // introduce a synonym for it to avoid confusion
 typedef wxMilliClock_t wxUsecClock_t;
 
+struct wxTimerSchedule;
+
 // ----------------------------------------------------------------------------
 // wxTimer implementation class for Unix platforms
 // ----------------------------------------------------------------------------
@@ -43,8 +47,16 @@ public:
         m_isRunning = false;
     }
 
+    // for wxTimerScheduler only: the schedule of this timer while it is
+    // running, allows the scheduler to find the timer in its heap in
+    // constant time
+    wxTimerSchedule *GetSchedule() const { return m_schedule; }
+    void SetSchedule(wxTimerSchedule *schedule) { m_schedule = schedule; }
+
 private:
     bool m_isRunning;
+
+    wxTimerSchedule *m_schedule;
 };
 
 // ----------------------------------------------------------------------------
@@ -55,7 +67,8 @@ struct wxTimerSchedule
 {
     wxTimerSchedule(wxUnixTimerImpl *timer, wxUsecClock_t expiration)
         : m_timer(timer),
-          m_expiration(expiration)
+          m_expiration(expiration),
+          m_heapIndex(0)
     {
     }
 
@@ -64,10 +77,11 @@ struct wxTimerSchedule
 
     // the time of its next expiration, in usec
     wxUsecClock_t m_expiration;
-};
 
-// the linked list of all active timers, we keep it sorted by expiration time
-WX_DECLARE_LIST(wxTimerSchedule, wxTimerList);
+    // the current position of this entry in the scheduler heap, maintained
+    // by wxTimerScheduler
+    size_t m_heapIndex;
+};
 
 // ----------------------------------------------------------------------------
 // wxTimerScheduler: class responsible for updating all timers
@@ -121,14 +135,29 @@ private:
     wxTimerScheduler() { }
     ~wxTimerScheduler();
 
-    // add the given timer schedule to the list in the right place
+    // add the given timer schedule to the heap
     //
     // we take ownership of the pointer "s" which must be heap-allocated
     void DoAddTimer(wxTimerSchedule *s);
 
+    // remove the entry with the given index from the heap (without deleting
+    // it) and restore the heap invariant
+    wxTimerSchedule *DoRemoveAt(size_t index);
+
+    // move the entry at the given index towards the root/the leaves for as
+    // long as it violates the heap ordering
+    void SiftUp(size_t index);
+    void SiftDown(size_t index);
+
+    // exchange two heap entries, updating their indices
+    void Swap(size_t index1, size_t index2);
+
 
-    // the list of all currently active timers sorted by expiration
-    wxTimerList m_timers;
+    // binary min-heap of all currently active timers ordered by expiration
+    // time: the next timer to expire is at the root, (re)scheduling and
+    // stopping a timer are O(log n) and expiring all due timers is a single
+    // sequence of root removals instead of a list scan
+    wxVector<wxTimerSchedule *> m_timers;
 
     static wxTimerScheduler *ms_instance;
 };
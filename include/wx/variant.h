@@ -131,14 +131,25 @@ public:
 
     // For compatibility with wxWidgets <= 2.6, this doesn't increase
     // reference count.
+    //
+    // Note that values of the small standard types (bool, long, double and
+    // wxString) are normally stored inside the variant itself and only
+    // spilled into a heap-allocated wxVariantData when this function is
+    // called, see the comment before m_small below.
     wxVariantData* GetData() const
     {
+        if ( m_small.m_type != Small_None )
+            const_cast<wxVariant*>(this)->MaterializeSmallData();
         return (wxVariantData*) m_refData;
     }
     void SetData(wxVariantData* data) ;
 
     // make a 'clone' of the object
-    void Ref(const wxVariant& clone) { wxObject::Ref(clone); }
+    void Ref(const wxVariant& clone);
+
+    // destroy a reference: this hides wxObject::UnRef() in order to also
+    // clear the inline small value storage
+    void UnRef();
 
     // ensure that the data is exclusive to this variant, and not shared
     bool Unshare();
@@ -393,6 +404,45 @@ protected:
     wxString        m_name;
 
 private:
+    // The values of the standard scalar types are stored directly inside
+    // the variant instead of in a heap-allocated wxVariantData: this matters
+    // for code such as wxDataViewModel which creates huge numbers of
+    // short-lived scalar variants. A wxVariantData object is only created on
+    // demand, when GetData() is called, at which point the inline value is
+    // moved into it and the variant behaves exactly as it did before this
+    // optimization existed.
+    enum SmallType
+    {
+        Small_None,
+        Small_Bool,
+        Small_Long,
+        Small_Double,
+        Small_String
+    };
+
+    struct SmallValue
+    {
+        SmallValue() : m_type(Small_None) { }
+
+        SmallType m_type;
+        union
+        {
+            bool m_bool;
+            long m_long;
+            double m_double;
+        };
+    };
+
+    // Spill the inline value into a heap-allocated wxVariantData stored in
+    // m_refData and reset m_small, see GetData().
+    void MaterializeSmallData();
+
+    SmallValue      m_small;
+
+    // Only used when m_small.m_type == Small_String: kept outside of the
+    // union above as wxString is not a POD.
+    wxString        m_smallString;
+
     wxDECLARE_DYNAMIC_CLASS(wxVariant);
 };
 
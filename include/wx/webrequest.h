@@ -142,7 +142,8 @@ public:
     {
         Storage_Memory,
         Storage_File,
-        Storage_None
+        Storage_None,
+        Storage_Sink
     };
 
     wxWebRequest();
@@ -164,10 +165,16 @@ public:
 
     Storage GetStorage() const;
 
+    bool SetSink(wxOutputStream* sink);
+
     void Start();
 
     void Cancel();
 
+    bool Pause();
+
+    bool Resume();
+
     wxWebResponse GetResponse() const;
 
     wxWebAuthChallenge GetAuthChallenge() const;
@@ -235,6 +242,13 @@ public:
     void SetTempDir(const wxString& dir);
     wxString GetTempDir() const;
 
+    // Connection pooling configuration: must be called before creating the
+    // first request in this session and is currently only honoured by the
+    // libcurl-based backend, the other ones use their own defaults.
+    void SetMaxConnections(int maxTotal, int maxPerHost = 0);
+    void SetKeepAliveTimes(int idleSeconds, int intervalSeconds);
+    void EnableHTTP2(bool enable = true);
+
     bool IsOpened() const;
 
     void Close();
@@ -65,6 +65,8 @@ class WXDLLIMPEXP_FWD_CORE wxLayoutConstraints;
 class WXDLLIMPEXP_FWD_CORE wxSizer;
 class WXDLLIMPEXP_FWD_CORE wxTextEntry;
 class WXDLLIMPEXP_FWD_CORE wxToolTip;
+class wxWindowLookupIndex;
+class wxWindowRefreshScheduler;
 class WXDLLIMPEXP_FWD_CORE wxWindowBase;
 class WXDLLIMPEXP_FWD_CORE wxWindow;
 class WXDLLIMPEXP_FWD_CORE wxScrollHelper;
@@ -218,7 +220,7 @@ public:
 
         // the window name is used for resource setting in X, it is not the
         // same as the window title/label
-    virtual void SetName( const wxString &name ) { m_windowName = name; }
+    virtual void SetName( const wxString &name );
     virtual wxString GetName() const { return m_windowName; }
 
         // sets the window variant, calls internally DoSetVariant if variant
@@ -243,7 +245,7 @@ public:
 
         // window id uniquely identifies the window among its siblings unless
         // it is wxID_ANY which means "don't care"
-    virtual void SetId( wxWindowID winid ) { m_windowId = winid; }
+    virtual void SetId( wxWindowID winid );
     wxWindowID GetId() const { return m_windowId; }
 
         // generate a unique id (or count of them consecutively), returns a
@@ -691,7 +693,7 @@ public:
 
         // extra style: the less often used style bits which can't be set with
         // SetWindowStyleFlag()
-    virtual void SetExtraStyle(long exStyle) { m_exStyle = exStyle; }
+    virtual void SetExtraStyle(long exStyle);
     long GetExtraStyle() const { return m_exStyle; }
 
     bool HasExtraStyle(int exFlag) const { return (m_exStyle & exFlag) != 0; }
@@ -852,6 +854,13 @@ public:
     wxWindow *FindWindow(long winid) const;
     wxWindow *FindWindow(const wxString& name) const;
 
+        // enable (or disable) a hash index mapping the ids and names of all
+        // the descendants of this window to the windows themselves, making
+        // the FindWindow() lookups in it O(1) instead of O(children); it is
+        // meant to be used with (big) top level windows and is kept up to
+        // date automatically when children are added, removed or renamed
+    void EnableChildLookupIndex(bool enable = true);
+
         // Find a window among any window (all return NULL if not found)
     static wxWindow *FindWindowById( long winid, const wxWindow *parent = NULL );
     static wxWindow *FindWindowByName( const wxString& name,
@@ -1116,6 +1125,20 @@ public:
         // return true if window had been frozen and not unthawed yet
     bool IsFrozen() const { return m_freezeCount != 0; }
 
+#if wxUSE_TIMER
+        // rate limit the refreshes of this window: if milliseconds > 0, at
+        // most one native refresh per this interval is done and all the
+        // other Refresh() calls just accumulate the damaged area until then
+    void SetRefreshRateLimit(int milliseconds);
+
+        // return the current rate limit, 0 if refreshes are not limited
+    int GetRefreshRateLimit() const;
+
+        // total number of Refresh() calls coalesced into deferred refreshes
+        // because of the rate limit, useful for tuning it
+    unsigned int GetCoalescedRefreshCount() const;
+#endif // wxUSE_TIMER
+
         // adjust DC for drawing on this window
     virtual void PrepareDC( wxDC & WXUNUSED(dc) ) { }
 
@@ -1508,6 +1531,17 @@ public:
         // lay out the window and its children
     virtual bool Layout();
 
+        // defer laying out this window and its children: all Layout() calls
+        // made until the matching EndDeferLayout() are coalesced into a
+        // single layout pass done by the latter
+    void BeginDeferLayout();
+
+        // perform the layout passes deferred since BeginDeferLayout()
+    void EndDeferLayout();
+
+        // return true if layout of this window is currently deferred
+    bool IsLayoutDeferred() const { return m_deferLayoutCount != 0; }
+
         // sizers
     void SetSizer(wxSizer *sizer, bool deleteOld = true );
     void SetSizerAndFit( wxSizer *sizer, bool deleteOld = true );
@@ -1560,6 +1594,12 @@ public:
     // Returns true if more idle time is requested.
     virtual bool SendIdleEvents(wxIdleEvent& event);
 
+    // Windows which requested idle events with the wxWS_EX_PROCESS_IDLE
+    // extra style: the list is maintained by SetExtraStyle() and is used by
+    // wxApp::ProcessIdle() in wxIDLE_PROCESS_SPECIFIED mode to send idle
+    // events to these windows only instead of walking the whole window tree.
+    static const wxWindowList& GetIdleWindows() { return ms_idleWindows; }
+
     // Send wxContextMenuEvent and return true if it was processed.
     //
     // Note that the event may end up being sent to a different window, if this
@@ -1774,6 +1814,9 @@ protected:
     // Layout() window automatically when its size changes?
     bool                 m_autoLayout:1;
 
+    // was Layout() called while it was deferred?
+    bool                 m_layoutDirty:1;
+
     // window state
     bool                 m_isShown:1;
     bool                 m_isEnabled:1;
@@ -1795,6 +1838,10 @@ protected:
     // window attributes
     long                 m_windowStyle,
                          m_exStyle;
+
+    // the windows with the wxWS_EX_PROCESS_IDLE extra style, see
+    // GetIdleWindows()
+    static wxWindowList  ms_idleWindows;
     wxString             m_windowName;
     bool                 m_themeEnabled;
     wxBackgroundStyle    m_backgroundStyle;
@@ -1947,6 +1994,17 @@ protected:
     virtual void DoFreeze() { }
     virtual void DoThaw() { }
 
+#if wxUSE_TIMER
+    // return true if the refresh of the given area was deferred because of
+    // the rate limit set with SetRefreshRateLimit() and the caller shouldn't
+    // do anything else, or false if the refresh should proceed as usual;
+    // this is called from the ports Refresh() implementations
+    bool QueueThrottledRefresh(bool eraseBackground, const wxRect *rect);
+
+    // immediately do the refresh deferred by QueueThrottledRefresh(), if any
+    void FlushPendingRefresh();
+#endif // wxUSE_TIMER
+
 
     // Must be called when mouse capture is lost to send
     // wxMouseCaptureLostEvent to windows on capture stack.
@@ -1979,6 +2037,31 @@ private:
     // (i.e. not being updated) if it is positive
     unsigned int m_freezeCount;
 
+    // number of BeginDeferLayout() calls minus the number of EndDeferLayout()
+    // calls: layout is deferred if it is positive
+    unsigned int m_deferLayoutCount;
+
+#if wxUSE_TIMER
+    // the refresh rate limiting state, only allocated if it was ever used
+    wxWindowRefreshScheduler *m_refreshScheduler;
+
+    // the scheduler calls FlushPendingRefresh() when its timer expires
+    friend class wxWindowRefreshScheduler;
+#endif // wxUSE_TIMER
+
+    // the id/name lookup index created by EnableChildLookupIndex(), NULL for
+    // (almost) all windows
+    wxWindowLookupIndex *m_childLookupIndex;
+
+    // mark the indexes of this window and all its ancestors, if any, as
+    // needing to be rebuilt; must be called whenever the ids, names or
+    // hierarchy of the children change
+    void InvalidateChildLookupIndex();
+
+    // return the up to date index covering this window, i.e. the one of the
+    // nearest ancestor (or self) having one, or NULL
+    wxWindowLookupIndex *GetChildLookupIndex() const;
+
     wxDECLARE_ABSTRACT_CLASS(wxWindowBase);
     wxDECLARE_NO_COPY_CLASS(wxWindowBase);
     wxDECLARE_EVENT_TABLE();
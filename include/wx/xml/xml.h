@@ -17,6 +17,7 @@
 
 #include "wx/string.h"
 #include "wx/object.h"
+#include "wx/arrstr.h"
 #include "wx/list.h"
 #include "wx/textbuf.h"
 #include "wx/versioninfo.h"
@@ -63,26 +64,62 @@ enum wxXmlNodeType
 class WXDLLIMPEXP_XML wxXmlAttribute
 {
 public:
-    wxXmlAttribute() : m_next(NULL) {}
+    wxXmlAttribute() : m_nameHash(HashName(wxString())), m_next(NULL) {}
     wxXmlAttribute(const wxString& name, const wxString& value,
                   wxXmlAttribute *next = NULL)
-            : m_name(name), m_value(value), m_next(next) {}
+            : m_name(name), m_value(value), m_nameHash(HashName(name)),
+              m_next(next) {}
     virtual ~wxXmlAttribute() {}
 
+#if !wxUSE_MEMORY_TRACING
+    // Attributes are created in great numbers when loading documents, so
+    // their allocation goes through a pool of fixed-size blocks, see xml.cpp.
+    void* operator new(size_t size);
+    void operator delete(void* ptr, size_t size);
+#endif // !wxUSE_MEMORY_TRACING
+
     const wxString& GetName() const { return m_name; }
     const wxString& GetValue() const { return m_value; }
     wxXmlAttribute *GetNext() const { return m_next; }
 
-    void SetName(const wxString& name) { m_name = name; }
+    void SetName(const wxString& name)
+        { m_name = name; m_nameHash = HashName(name); }
     void SetValue(const wxString& value) { m_value = value; }
     void SetNext(wxXmlAttribute *next) { m_next = next; }
 
+    // Implementation only: the hash of the attribute name, precomputed once
+    // so that looking up attributes by name doesn't need to compare the full
+    // strings for the names which can't possibly match.
+    wxUint32 GetNameHash() const { return m_nameHash; }
+
+    // Return the hash used by GetNameHash() for an arbitrary name.
+    static wxUint32 HashName(const wxString& name);
+
 private:
     wxString m_name;
     wxString m_value;
+    wxUint32 m_nameHash;
     wxXmlAttribute *m_next;
 };
 
+// Represents a pre-hashed attribute name: constructing an object of this
+// class once, e.g. as a local static, and passing it to wxXmlNode attribute
+// lookup functions instead of the name itself avoids re-hashing the name on
+// every call.
+class wxXmlAttrName
+{
+public:
+    explicit wxXmlAttrName(const wxString& name)
+        : m_name(name), m_hash(wxXmlAttribute::HashName(name)) {}
+
+    const wxString& GetName() const { return m_name; }
+    wxUint32 GetHash() const { return m_hash; }
+
+private:
+    wxString m_name;
+    wxUint32 m_hash;
+};
+
 #if WXWIN_COMPATIBILITY_2_8
     // NB: #define is used instead of typedef so that forward declarations
     //     continue to work
@@ -115,6 +152,12 @@ public:
 
     virtual ~wxXmlNode();
 
+#if !wxUSE_MEMORY_TRACING
+    // Like wxXmlAttribute, nodes are pool-allocated, see xml.cpp.
+    void* operator new(size_t size);
+    void operator delete(void* ptr, size_t size);
+#endif // !wxUSE_MEMORY_TRACING
+
     // copy ctor & operator=. Note that this does NOT copy siblings
     // and parent pointer, i.e. m_parent and m_next will be NULL
     // after using copy ctor and are never unmodified by operator=.
@@ -158,6 +201,13 @@ public:
                           const wxString& defaultVal = wxEmptyString) const;
     bool HasAttribute(const wxString& attrName) const;
 
+    // Same functions taking a pre-hashed name, which is slightly more
+    // efficient when looking up the same attribute many times.
+    bool GetAttribute(const wxXmlAttrName& attrName, wxString *value) const;
+    wxString GetAttribute(const wxXmlAttrName& attrName,
+                          const wxString& defaultVal = wxEmptyString) const;
+    bool HasAttribute(const wxXmlAttrName& attrName) const;
+
     int GetLineNumber() const { return m_lineNo; }
 
     void SetType(wxXmlNodeType type) { m_type = type; }
@@ -305,6 +355,13 @@ public:
     virtual bool Save(const wxString& filename, int indentstep = 2) const;
     virtual bool Save(wxOutputStream& stream, int indentstep = 2) const;
 
+    // Saves/loads the document using a compact binary representation which
+    // is much faster to load than XML as no parsing is needed. Load() above
+    // recognizes documents in this format automatically.
+    virtual bool SaveBinary(const wxString& filename) const;
+    virtual bool SaveBinary(wxOutputStream& stream) const;
+    virtual bool LoadBinary(wxInputStream& stream);
+
     bool IsOk() const { return GetRoot() != NULL; }
 
     // Returns root node of the document.
@@ -357,10 +414,87 @@ private:
     wxString m_eol;
 
     void DoCopy(const wxXmlDocument& doc);
+    bool DoLoadBinary(wxInputStream& stream);
 
     wxDECLARE_CLASS(wxXmlDocument);
 };
 
+// ----------------------------------------------------------------------------
+// wxXmlSaxParser: streaming parser which doesn't build the document tree
+// ----------------------------------------------------------------------------
+
+// Attributes of the element being parsed, stored as a flat interleaved list
+// of names and values. The object passed to OnStartElement() is only valid
+// for the duration of the callback.
+class WXDLLIMPEXP_XML wxXmlSaxAttributes
+{
+public:
+    wxXmlSaxAttributes() { }
+
+    size_t GetCount() const { return m_att.size() / 2; }
+    const wxString& GetName(size_t n) const { return m_att[2*n]; }
+    const wxString& GetValue(size_t n) const { return m_att[2*n + 1]; }
+
+    // Returns the value of the attribute with the given name or an empty
+    // string if there is no such attribute.
+    wxString GetValueByName(const wxString& name) const;
+
+    // implementation only from now on
+    void Clear() { m_att.clear(); }
+    void Add(const wxString& name, const wxString& value)
+        { m_att.push_back(name); m_att.push_back(value); }
+
+private:
+    wxArrayString m_att;
+
+    wxDECLARE_NO_COPY_CLASS(wxXmlSaxAttributes);
+};
+
+// Derive from this class and override its virtual methods to process a
+// document in streaming mode: unlike wxXmlDocument, only the element
+// currently being parsed is kept in memory, so a few fields can be extracted
+// from arbitrarily big documents in O(1) space.
+class WXDLLIMPEXP_XML wxXmlSaxParser
+{
+public:
+    wxXmlSaxParser() { m_stopped = false; }
+    virtual ~wxXmlSaxParser() { }
+
+    // Parse the entire stream or file. Returns false if a parsing error
+    // occurred or if parsing was aborted with Stop().
+    bool Parse(wxInputStream& stream,
+               const wxString& encoding = wxT("UTF-8"));
+    bool ParseFile(const wxString& filename,
+                   const wxString& encoding = wxT("UTF-8"));
+
+    // Can be called from any of the callbacks to abort parsing, e.g. once
+    // all the interesting fields have been seen.
+    void Stop() { m_stopped = true; }
+    bool IsStopped() const { return m_stopped; }
+
+    // Description of the last parsing error, empty if there was none.
+    const wxString& GetErrorMessage() const { return m_error; }
+
+    // Called for each element start tag with its attributes.
+    virtual void OnStartElement(const wxString& WXUNUSED(name),
+                                const wxXmlSaxAttributes& WXUNUSED(attrs)) { }
+
+    // Called for each element end tag.
+    virtual void OnEndElement(const wxString& WXUNUSED(name)) { }
+
+    // Called with the character data contained in an element; adjacent data
+    // is merged and delivered in a single call.
+    virtual void OnText(const wxString& WXUNUSED(text)) { }
+
+private:
+    wxString m_error;
+    bool m_stopped;
+
+    friend struct wxXmlSaxContext;
+
+    wxDECLARE_NO_COPY_CLASS(wxXmlSaxParser);
+};
+
 #endif // wxUSE_XML
 
 #endif // _WX_XML_H_
@@ -26,6 +26,7 @@
 #include "wx/artprov.h"
 #include "wx/colour.h"
 #include "wx/vector.h"
+#include "wx/hashmap.h"
 
 #include "wx/xrc/xmlreshandler.h"
 
@@ -80,6 +81,13 @@ enum wxXmlResourceFlags
     wxXRC_USE_ENVVARS    = 8
 };
 
+// Hash table mapping the value of the "class" attribute to the handler which
+// was last used to create an object of this class, used to avoid querying all
+// the registered handlers for every node.
+WX_DECLARE_STRING_HASH_MAP_WITH_DECL(wxXmlResourceHandler*,
+                                     wxXmlResourceHandlerMap,
+                                     class WXDLLIMPEXP_XRC);
+
 // This class holds XML resources from one or more .xml files
 // (or derived forms, either binary or zipped -- see manual for
 // details).
@@ -411,6 +419,11 @@ private:
 
     int m_flags;
     wxVector<wxXmlResourceHandler*> m_handlers;
+
+    // Lazily filled by DoCreateResFromNode() and must be cleared whenever the
+    // set of registered handlers changes as the cached handlers could be
+    // deleted or shadowed by newly inserted ones.
+    wxXmlResourceHandlerMap m_handlerByClass;
     wxXmlResourceDataRecords *m_data;
 #if wxUSE_FILESYSTEM
     wxFileSystem m_curFileSystem;
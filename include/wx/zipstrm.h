@@ -321,6 +321,11 @@ public:
     int  GetLevel() const                       { return m_level; }
     void WXZIPFIX SetLevel(int level);
 
+    // compress entry data on a pool of background threads, -1 to use one
+    // thread per available CPU, 0 or 1 for the default serial compression
+    bool WXZIPFIX SetCompressionThreads(int count);
+    int  GetCompressionThreads() const          { return m_numThreads; }
+
     void SetFormat(wxZipArchiveFormat format)   { m_format = format; }
     wxZipArchiveFormat GetFormat() const        { return m_format; }
 
@@ -353,6 +358,7 @@ private:
 
     class wxStoredOutputStream *m_store;
     class wxZlibOutputStream2 *m_deflate;
+    class wxParallelZlibOutputStream *m_parallel;
     class wxZipStreamLink *m_backlink;
     wxZipEntryList_ m_entries;
     char *m_initialData;
@@ -365,6 +371,7 @@ private:
     wxUint32 m_crcAccumulator;
     wxOutputStream *m_comp;
     int m_level;
+    int m_numThreads;
     wxFileOffset m_offsetAdjustment;
     wxString m_Comment;
     bool m_endrecWritten;
@@ -388,6 +395,7 @@ public:
     virtual WXZIPFIX ~wxZipInputStream();
 
     bool OpenEntry(wxZipEntry& entry)   { return DoOpen(&entry); }
+    bool OpenEntry(const wxString& name);
     bool WXZIPFIX CloseEntry() wxOVERRIDE;
 
     wxZipEntry *GetNextEntry();
@@ -428,6 +436,7 @@ private:
 
     bool DoOpen(wxZipEntry *entry = NULL, bool raw = false);
     bool OpenDecompressor(bool raw = false);
+    bool BuildNameIndex();
 
     class wxStoredInputStream *m_store;
     class wxZlibInputStream2 *m_inflate;
@@ -442,9 +451,11 @@ private:
     class wxZipStreamLink *m_streamlink;
     wxFileOffset m_offsetAdjustment;
     wxFileOffset m_position;
+    wxFileOffset m_centralOffset;
     wxUint32 m_signature;
     size_t m_TotalEntries;
     wxString m_Comment;
+    class wxZipEntryIndex *m_index;
 
     friend bool wxZipOutputStream::CopyEntry(
                     wxZipEntry *entry, wxZipInputStream& inputStream);
@@ -0,0 +1,163 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        wx/alloctrack.h
+// Purpose:     interface of wxAllocationTracker
+// Author:      wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+    The subsystems whose allocations can be tracked by wxAllocationTracker.
+
+    @since 3.1.7
+*/
+enum wxAllocTag
+{
+    /// wxString character buffers.
+    wxALLOC_TAG_STRINGS,
+
+    /// Dynamically allocated wxEvent objects.
+    wxALLOC_TAG_EVENTS,
+
+    /// wxImage pixel and alpha buffers.
+    wxALLOC_TAG_IMAGES,
+
+    /// wxSizerItem objects.
+    wxALLOC_TAG_SIZERS,
+
+    /// Anything else, usable by the application code.
+    wxALLOC_TAG_OTHER,
+
+    /// The number of valid tags, not a valid tag itself.
+    wxALLOC_TAG_MAX
+};
+
+/**
+    Counters collected by wxAllocationTracker for a single subsystem tag.
+
+    @library{wxbase}
+    @category{debugging}
+
+    @since 3.1.7
+*/
+struct wxAllocationStats
+{
+    /// Default constructor initializes all the counters to zero.
+    wxAllocationStats();
+
+    /// Number of tracked allocations.
+    unsigned long allocCount;
+
+    /// Number of tracked deallocations.
+    unsigned long freeCount;
+
+    /// Total bytes allocated since tracking was enabled.
+    wxULongLong allocBytes;
+
+    /// Total bytes freed since tracking was enabled.
+    wxULongLong freedBytes;
+
+    /// Highest value reached by GetCurrentBytes() so far.
+    wxULongLong peakBytes;
+
+    /**
+        Returns the bytes currently allocated and not yet freed.
+
+        If blocks allocated before tracking was enabled are freed while it is
+        active, the balance is clamped to 0.
+    */
+    wxULongLong GetCurrentBytes() const;
+};
+
+/**
+    @class wxAllocationTracker
+
+    Counts the memory allocated by the instrumented wxWidgets subsystems.
+
+    Unlike wxDebugContext, this class also works in release builds, so it can
+    be used to attribute the memory usage of an application to the wx
+    subsystems on end user machines, without any external heap profiler. It
+    is disabled by default and the instrumented allocation paths then only
+    check a single flag.
+
+    @code
+    wxAllocationTracker::Enable();
+
+    ... exercise the application ...
+
+    for ( int tag = 0; tag < wxALLOC_TAG_MAX; tag++ )
+    {
+        const wxAllocationStats
+            stats = wxAllocationTracker::GetStats(wxAllocTag(tag));
+        wxLogMessage("%s: %s bytes live",
+                     wxAllocationTracker::GetTagName(wxAllocTag(tag)),
+                     stats.GetCurrentBytes().ToString());
+    }
+    @endcode
+
+    Optionally, the call stack of every N-th tracked allocation can be
+    captured using SetStackSampleInterval() to find the code responsible for
+    the allocations of a subsystem.
+
+    Note that enabling tracking serializes the instrumented allocation paths
+    and so has a measurable cost: it is meant for diagnostics, not for being
+    permanently enabled.
+
+    @library{wxbase}
+    @category{debugging}
+
+    @see wxDebugContext
+
+    @since 3.1.7
+*/
+class wxAllocationTracker
+{
+public:
+    /**
+        Starts or stops counting allocations.
+
+        Tracking is disabled by default.
+    */
+    static void Enable(bool enable = true);
+
+    /// Returns @true if tracking is currently enabled.
+    static bool IsEnabled();
+
+    /// Resets all the counters and discards the sampled call stacks.
+    static void Reset();
+
+    /// Returns the counters collected so far for the given subsystem.
+    static wxAllocationStats GetStats(wxAllocTag tag);
+
+    /// Returns a short human-readable name of the given tag, e.g. "strings".
+    static wxString GetTagName(wxAllocTag tag);
+
+    /**
+        Captures the call stack of every @a interval-th tracked allocation.
+
+        The most recent captures are kept for each tag and can be retrieved
+        with GetSampledStacks(). The default value of 0 disables the capture.
+
+        This only does something if @c wxUSE_STACKWALKER is 1.
+    */
+    static void SetStackSampleInterval(unsigned long interval);
+
+    /**
+        Returns the call stacks sampled for the given tag so far.
+
+        The most recent one is last.
+    */
+    static wxArrayString GetSampledStacks(wxAllocTag tag);
+
+    /**
+        Records one allocation.
+
+        This is called from the instrumented allocation paths inside wx, but
+        may also be used by the application for its own allocations,
+        typically with ::wxALLOC_TAG_OTHER. Every call should be matched by
+        an OnFree() call with the same size when the memory is freed.
+    */
+    static void OnAlloc(wxAllocTag tag, size_t size);
+
+    /// Records one deallocation, see OnAlloc().
+    static void OnFree(wxAllocTag tag, size_t size);
+};
@@ -219,6 +219,45 @@ public:
      */
     bool IsScheduledForDestruction(wxObject *object) const;
 
+    /**
+        Limit the time spent destroying the scheduled objects per event loop
+        pass.
+
+        By default all the objects scheduled for destruction with
+        ScheduleForDestruction() are destroyed during the next idle phase of
+        the event loop, which can make the UI noticeably unresponsive when
+        many windows are torn down at once, e.g. when closing a notebook with
+        dozens of pages. Setting a non-zero budget spreads the destruction
+        over several event loop passes instead: once @a milliseconds have
+        elapsed, the remaining objects are kept until the next pass, for which
+        another idle event is requested automatically, so all of them are
+        still destroyed as soon as possible.
+
+        The objects are always destroyed in the order in which they were
+        scheduled.
+
+        The budget only applies while the event loop is running: all the
+        remaining objects are unconditionally destroyed during the application
+        shutdown.
+
+        @param milliseconds
+            The maximal time, in milliseconds, to spend destroying pending
+            objects per event loop pass or 0 (default) to always destroy all
+            of them at once.
+
+        @since 3.1.7
+     */
+    static void SetPendingDeleteBudget(long milliseconds);
+
+    /**
+        Return the currently used pending destruction budget.
+
+        @see SetPendingDeleteBudget()
+
+        @since 3.1.7
+     */
+    static long GetPendingDeleteBudget();
+
     //@}
 
 
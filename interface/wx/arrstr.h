@@ -199,13 +199,25 @@ public:
         Releases the extra memory allocated by the array.
         This function is useful to minimize the array memory consumption.
 
+        If @a shrinkStrings is @true, wxString::Shrink() is also called for
+        every string in the array, releasing any extra memory allocated by the
+        strings themselves. This can recover a significant amount of memory
+        for long-lived arrays whose elements were built by concatenation.
+
+        The @a shrinkStrings parameter is only available since wxWidgets
+        3.1.7.
+
         @see Alloc()
     */
-    void Shrink();
+    void Shrink(bool shrinkStrings = false);
 
     /**
         Sorts the array in alphabetical order or in reverse alphabetical order if
         @a reverseOrder is @true. The sort is case-sensitive.
+
+        Since wxWidgets 3.1.7 this function uses a radix sort specialized for
+        string keys, which is much faster than a general purpose sort for the
+        large arrays, and sorts very large arrays using multiple threads.
     */
     void Sort(bool reverseOrder = false);
 
@@ -323,6 +335,17 @@ public:
     */
     size_t Add(const wxString& str, size_t copies = 1);
 
+    /**
+        Adds all the items of the given array at once.
+
+        This is equivalent to calling Add() for each item of @a items, but is
+        much faster when adding many items to a big array as it sorts the new
+        items once and then merges them with the existing contents in a single
+        pass, instead of doing a linear-time insertion for every item.
+
+        @since 3.1.7
+    */
+    void AddBulk(const wxArrayString& items);
 
     /**
         @copydoc wxArrayString::Index()
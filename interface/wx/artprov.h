@@ -319,6 +319,34 @@ public:
                                           const wxArtClient& client = wxART_OTHER,
                                           const wxSize& size = wxDefaultSize);
 
+    /**
+        Warm up the internal cache for all the given art identifiers at once.
+
+        This is equivalent to calling GetBitmap() for each element of @a ids
+        but allows performing all the possibly expensive work, such as
+        rasterizing the art provided as bitmap bundles, in one batch, e.g.
+        before rebuilding the toolbars of many windows after a theme or DPI
+        change, instead of paying for it lazily during the rebuild itself.
+
+        Notice that, like all the other methods of this class, this function
+        must be called from the main thread, as creating bitmaps is not
+        thread-safe.
+
+        @param ids
+            The identifiers of the art to prefetch.
+        @param client
+            wxArtClient identifier of the client (i.e. who is asking for the
+            bitmaps).
+        @param size
+            Size of the prefetched bitmaps or wxDefaultSize if size doesn't
+            matter.
+
+        @since 3.1.7
+    */
+    static void Prefetch(const wxVector<wxArtID>& ids,
+                         const wxArtClient& client = wxART_OTHER,
+                         const wxSize& size = wxDefaultSize);
+
     /**
         Same as wxArtProvider::GetBitmap, but return a wxIcon object
         (or ::wxNullIcon on failure).
@@ -189,3 +189,82 @@ wxMemoryBuffer wxBase64Decode(const wxString& src,
 
 //@}
 
+/**
+    Allows decoding Base64 data incrementally, chunk by chunk.
+
+    Unlike wxBase64Decode(), which requires the whole input to be available,
+    this class keeps the state between the calls to its Decode() method and so
+    can be used to decode data arriving in chunks, e.g. from the network,
+    without buffering all of it first:
+
+    @code
+    wxBase64Decoder decoder;
+    unsigned char buf[4096 + 3];
+    while ( ... more input ... )
+    {
+        const size_t len = decoder.Decode(buf, sizeof(buf), chunk, chunkLen);
+        if ( len == wxCONV_FAILED )
+            ... error ...
+
+        ... use the len decoded bytes in buf ...
+    }
+
+    if ( !decoder.IsComplete() )
+        ... input was truncated ...
+    @endcode
+
+    @since 3.1.7
+
+    @library{wxbase}
+    @category{data}
+
+    @header{wx/base64.h}
+*/
+class wxBase64Decoder
+{
+public:
+    /**
+        Create a decoder using the given error handling mode.
+
+        @see wxBase64DecodeMode
+    */
+    explicit wxBase64Decoder(wxBase64DecodeMode mode = wxBase64DecodeMode_Strict);
+
+    /**
+        Decode the next chunk of input into the provided buffer.
+
+        Note that a Base64 quartet started in a previous chunk may be
+        completed by this one, so the buffer must have room for
+        wxBase64DecodedSize(@a srcLen) + 3 bytes. As with wxBase64Decode(),
+        @a dst may be @NULL in order to just compute the needed size.
+
+        @return The number of bytes written to @a dst or @c wxCONV_FAILED if
+            the input is invalid or the buffer too small; in the former case
+            GetErrorPos() returns the position of the offending character.
+    */
+    size_t Decode(void* dst, size_t dstLen, const char* src, size_t srcLen);
+
+    /**
+        Return @true if the input fed so far forms a complete Base64 text.
+
+        This should be checked after the last chunk has been decoded to
+        detect truncated input, which otherwise goes unnoticed as Decode()
+        simply waits for the rest of the quartet to arrive.
+    */
+    bool IsComplete() const;
+
+    /**
+        Return the position of the invalid character in the input.
+
+        Only valid after Decode() returns @c wxCONV_FAILED. The position is
+        relative to the start of the whole input, not of the last chunk.
+    */
+    size_t GetErrorPos() const;
+
+    /**
+        Discard all state so that the object can be reused for decoding
+        another stream.
+    */
+    void Reset();
+};
+
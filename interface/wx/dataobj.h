@@ -717,6 +717,12 @@ public:
     wxStrings is already a very efficient operation (data is not actually
     copied because wxStrings are reference counted).
 
+    Also note that the major ports (wxGTK, wxMSW, wxOSX) ask the data object
+    for a format's data only when a paste actually requests it, so overriding
+    GetText() is sufficient to delay rendering expensive formats entirely
+    until they are used: putting such an object on the clipboard is cheap
+    even if the selection it describes is huge.
+
     @library{wxcore}
     @category{dnd}
 
@@ -887,6 +887,53 @@ wxEventType wxEVT_DATAVIEW_ITEM_BEGIN_DRAG;
 wxEventType wxEVT_DATAVIEW_ITEM_DROP_POSSIBLE;
 wxEventType wxEVT_DATAVIEW_ITEM_DROP;
 
+/**
+    @class wxDataViewFilter
+
+    A filter deciding which items of a wxDataViewModel are shown in the
+    associated wxDataViewCtrl.
+
+    To use it, derive a class from wxDataViewFilter, override its Matches()
+    method and pass an object of this class to wxDataViewCtrl::SetFilter().
+    Items for which Matches() returns @false are simply not shown in the
+    control, without being removed from the model.
+
+    Filtering is currently only available in the generic version of
+    wxDataViewCtrl, i.e. under MSW but not GTK nor macOS.
+
+    @library{wxcore}
+    @category{dvc}
+
+    @see wxDataViewCtrl::SetFilter()
+
+    @since 3.1.7
+*/
+class wxDataViewFilter
+{
+public:
+    /**
+        Virtual destructor.
+
+        The filter is not owned by the control using it and must be destroyed
+        by the caller.
+    */
+    virtual ~wxDataViewFilter();
+
+    /**
+        Return @true if the given item should be shown.
+
+        This method must be overridden and is called for every item of the
+        model, so it should be reasonably fast.
+
+        @param model
+            The model containing the item, never @NULL.
+        @param item
+            A valid item of the model.
+    */
+    virtual bool Matches(const wxDataViewModel* model,
+                         const wxDataViewItem& item) const = 0;
+};
+
 /**
     @class wxDataViewCtrl
 
@@ -1468,6 +1515,17 @@ public:
      */
     wxDataViewColumn *GetCurrentColumn() const;
 
+    /**
+        Returns the filter currently used by the control.
+
+        May return @NULL if no filter is used.
+
+        @see SetFilter()
+
+        @since 3.1.7
+    */
+    wxDataViewFilter* GetFilter() const;
+
     /**
         Returns indentation.
     */
@@ -1659,6 +1717,29 @@ public:
      */
     void SetCurrentItem(const wxDataViewItem& item);
 
+    /**
+        Set the filter determining which items of the model are shown.
+
+        Only the items for which wxDataViewFilter::Matches() returns @true are
+        shown in the control, the other ones are hidden without being removed
+        from the model. The filter is re-evaluated incrementally whenever the
+        values of the model change and fully when the filter itself changes,
+        i.e. on every call to this method.
+
+        Note that the control does not take ownership of the filter, which
+        must remain alive for as long as it is used and be destroyed by the
+        caller afterwards, and that changing the filter resets the selection.
+
+        Filtering is currently only implemented in the generic version, i.e.
+        this method does nothing when using the native wxDataViewCtrl
+        implementation in wxGTK nor wxOSX.
+
+        @param filter The filter to use or @NULL to show all the items again.
+
+        @since 3.1.7
+    */
+    void SetFilter(wxDataViewFilter* filter);
+
     /**
         Set custom colours and/or font to use for the header.
 
@@ -870,6 +870,19 @@ public:
     wxString Format(const wxString& format = wxDefaultDateTimeFormat,
                     const TimeZone& tz = Local) const;
 
+    /**
+        Same as Format(const wxString&, const TimeZone&) const but using a
+        format compiled in advance.
+
+        Compiling the format once with wxDateTimeFormat and reusing it is
+        noticeably faster than passing the format string itself when
+        formatting many dates with the same format.
+
+        @since 3.1.7
+    */
+    wxString Format(const wxDateTimeFormat& format,
+                    const TimeZone& tz = Local) const;
+
     /**
         Identical to calling Format() with @c "%x" argument (which means
         "preferred date representation for the current locale").
@@ -1002,6 +1015,30 @@ public:
     */
     bool ParseFormat(const wxString& date, wxString::const_iterator *end);
 
+    /**
+        Same as ParseFormat(const wxString&, const wxString&, const wxDateTime&, wxString::const_iterator*)
+        but using a format compiled in advance.
+
+        Compiling the format once with wxDateTimeFormat and reusing it is
+        noticeably faster than passing the format string itself when parsing
+        many strings with the same format.
+
+        @since 3.1.7
+    */
+    bool ParseFormat(const wxString& date,
+                     const wxDateTimeFormat& format,
+                     const wxDateTime& dateDef,
+                     wxString::const_iterator *end);
+
+    /**
+        @overload
+
+        @since 3.1.7
+    */
+    bool ParseFormat(const wxString& date,
+                     const wxDateTimeFormat& format,
+                     wxString::const_iterator *end);
+
     /**
         This function parses the string containing the date and time in ISO
         8601 combined format @c "YYYY-MM-DDTHH:MM:SS". The separator between
@@ -1597,6 +1634,74 @@ const wxDateTime wxDefaultDateTime;
 #define wxInvalidDateTime wxDefaultDateTime
 
 
+/**
+    @class wxDateTimeFormat
+
+    Represents a date/time format string compiled once and reusable with
+    wxDateTime::Format() and wxDateTime::ParseFormat().
+
+    Formatting or parsing a date using a format string requires scanning the
+    format and, for the specifiers such as @c "%b" or @c "%a", querying the
+    current locale for the month and weekday names every time. When many dates
+    are formatted or parsed using the same format, e.g. when filling a big
+    table with timestamps, this overhead can be avoided by compiling the
+    format once into an object of this class and reusing it:
+
+    @code
+        const wxDateTimeFormat fmt("%d %b %Y %H:%M:%S");
+        for ( size_t n = 0; n < rows.size(); n++ )
+            rows[n].timestamp = dates[n].Format(fmt);
+    @endcode
+
+    The compiled format supports exactly the same specifiers as the
+    corresponding wxDateTime functions taking format strings.
+
+    Notice that the locale data cached inside the object is filled on first
+    use, so a single object shouldn't be used from multiple threads
+    concurrently. Also note that a compiled format doesn't notice locale
+    changes happening after the names were cached, so don't reuse objects of
+    this class across locale changes.
+
+    @library{wxbase}
+    @category{data}
+
+    @since 3.1.7
+
+    @see wxDateTime::Format(), wxDateTime::ParseFormat()
+*/
+class wxDateTimeFormat
+{
+public:
+    /**
+        Default constructor creates an object which can't be used for
+        formatting or parsing until Compile() is called.
+    */
+    wxDateTimeFormat();
+
+    /**
+        Constructor compiling the given format string.
+    */
+    explicit wxDateTimeFormat(const wxString& format);
+
+    /**
+        Pre-parses the given format string, replacing the previously compiled
+        one, if any.
+    */
+    void Compile(const wxString& format);
+
+    /**
+        Returns the original format string passed to the constructor or
+        Compile().
+    */
+    const wxString& GetFormat() const;
+
+    /**
+        Returns @true if a non-empty format has been compiled.
+    */
+    bool IsOk() const;
+};
+
+
 /**
     @class wxDateTimeWorkDays
 
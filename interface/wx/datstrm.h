@@ -188,6 +188,19 @@ public:
     */
     void WriteDouble(const double* buffer, size_t size);
 
+    /**
+        Writes the given number of bytes to the stream without any conversion.
+
+        This is the fastest way to write out many fixed-layout records at
+        once, but no endianness conversion of any kind is performed, so the
+        caller is entirely responsible for the portability of the data format.
+
+        @see wxDataInputStream::ReadRaw()
+
+        @since 3.1.7
+    */
+    void WriteRaw(const void* buffer, size_t size);
+
     /**
         Writes @a string to the stream. Actually, this method writes the size
         of the string before writing @a string itself.
@@ -361,6 +374,20 @@ public:
     */
     void ReadDouble(double* buffer, size_t size);
 
+    /**
+        Reads the given number of bytes from the stream without any
+        conversion.
+
+        This is the fastest way to read many fixed-layout records at once,
+        but no endianness conversion of any kind is performed, so the caller
+        is entirely responsible for interpreting the data correctly.
+
+        @see wxDataOutputStream::WriteRaw()
+
+        @since 3.1.7
+    */
+    void ReadRaw(void* buffer, size_t size);
+
     /**
         Reads a string from a stream. Actually, this function first reads a
         long integer specifying the length of the string (without the last null
@@ -111,6 +111,73 @@ struct wxFontMetrics
 };
 
 
+/**
+    @class wxTextExtentCache
+
+    Global cache of text measurement results.
+
+    Measuring text can be surprisingly expensive and custom-drawn controls
+    often measure the same strings with the same fonts for every repaint, so
+    wxDC (and hence wxGCDC) can optionally remember the extents it computed
+    and reuse them instead of asking the underlying toolkit again.
+
+    The cache is disabled by default, call Enable() to turn it on. Cache
+    entries are keyed by the full font description and the DC scale factors,
+    so changing the font, the mapping mode or the display DPI never returns
+    stale results and no explicit invalidation is needed. The number of
+    cached strings is bounded, see SetMaxSize(), with the least recently
+    used entries being discarded first, and GetStats() can be used to check
+    whether the chosen size is appropriate for the application.
+
+    All the methods of this class are static.
+
+    @since 3.1.7
+
+    @library{wxcore}
+    @category{dc,gdi}
+
+    @see wxDC::GetTextExtent()
+*/
+class wxTextExtentCache
+{
+public:
+    /**
+        Globally enable or disable the cache.
+
+        The cache is disabled by default.
+    */
+    static void Enable(bool enable = true);
+
+    /// Return @true if the cache is currently enabled.
+    static bool IsEnabled();
+
+    /**
+        Change the maximal number of cached strings.
+
+        When the limit is reached, the least recently used half of the
+        entries is discarded. The default limit is 4096 strings.
+    */
+    static void SetMaxSize(size_t maxSize);
+
+    /// Discard all cached extents.
+    static void Clear();
+
+    /// Cache effectiveness counters returned by GetStats().
+    struct Stats
+    {
+        unsigned long hits,      ///< Look-ups satisfied from the cache.
+                      misses,    ///< Look-ups which had to measure the text.
+                      evictions; ///< Entries discarded to bound the cache size.
+    };
+
+    /// Return the counters accumulated since the last ResetStats() call.
+    static Stats GetStats();
+
+    /// Reset all the counters returned by GetStats() to zero.
+    static void ResetStats();
+};
+
+
 /**
     @class wxDC
 
@@ -2167,3 +2234,142 @@ public:
     ~wxDCFontChanger();
 };
 
+
+
+/**
+    The categories of draw calls counted by wxDCStats.
+
+    @since 3.1.7
+*/
+enum wxDCStatsCategory
+{
+    /// Lines, points and splines.
+    wxDC_STATS_LINES,
+
+    /// Plain and rounded rectangles.
+    wxDC_STATS_RECTANGLES,
+
+    /// Ellipses, circles and elliptic arcs.
+    wxDC_STATS_ELLIPSES,
+
+    /// Polygons and polypolygons.
+    wxDC_STATS_POLYGONS,
+
+    /// Bitmaps and icons.
+    wxDC_STATS_BITMAPS,
+
+    /// Text drawing.
+    wxDC_STATS_TEXT,
+
+    /// Text measurement.
+    wxDC_STATS_TEXT_EXTENTS,
+
+    /// wxDC::Blit() and wxDC::StretchBlit().
+    wxDC_STATS_BLITS,
+
+    /// Clipping region changes.
+    wxDC_STATS_CLIP_CHANGES,
+
+    /// Everything else.
+    wxDC_STATS_OTHER,
+
+    /// The number of valid categories, not a valid category itself.
+    wxDC_STATS_MAX
+};
+
+/**
+    @class wxDCStats
+
+    Counts the calls made through the drawing API of all wxDC objects.
+
+    This class makes it possible to see at a glance what an expensive paint
+    handler is actually doing, e.g. whether a painting regression is due to
+    more draw calls being made, bigger areas being redrawn or text being
+    measured over and over. Counting is disabled by default and then only
+    costs a single flag check per draw call.
+
+    The counters are global and are not reset automatically, so to see the
+    cost of a single paint, reset them at the start of the paint handler and
+    examine them, or draw them on top of the window contents, at its end:
+
+    @code
+    void MyWindow::OnPaint(wxPaintEvent&)
+    {
+        wxDCStats::Reset();
+
+        wxPaintDC dc(this);
+
+        ... the usual painting code ...
+
+        if ( m_showPaintStats )
+            wxDCStats::DrawOverlay(dc);
+    }
+    @endcode
+
+    @library{wxcore}
+    @category{gdi}
+
+    @see wxDC
+
+    @since 3.1.7
+*/
+class wxDCStats
+{
+public:
+    /**
+        Starts or stops counting draw calls.
+
+        The counters are reset when counting is started.
+    */
+    static void Enable(bool enable = true);
+
+    /// Returns @true if draw calls are currently being counted.
+    static bool IsEnabled();
+
+    /// Resets all the counters to zero.
+    static void Reset();
+
+    /// Returns the number of draw calls in the given category since the
+    /// last Reset().
+    static unsigned long GetCount(wxDCStatsCategory cat);
+
+    /// Returns the number of draw calls in all the categories since the
+    /// last Reset().
+    static unsigned long GetTotalCount();
+
+    /**
+        Returns the approximate number of pixels covered by the counted
+        draw calls.
+
+        Only the calls whose area is readily available, i.e. rectangles,
+        bitmaps and blits, contribute to this counter, so it is a lower
+        bound for the real number of the pixels touched.
+    */
+    static wxULongLong GetPixelsTouched();
+
+    /// Returns a short human-readable name of the given category, e.g.
+    /// "rectangles".
+    static wxString GetCategoryName(wxDCStatsCategory cat);
+
+    /// Returns a single line of text summarizing all the counters,
+    /// suitable for logging.
+    static wxString GetSummary();
+
+    /**
+        Draws the counters on the given DC as a translucent frame-stats
+        overlay.
+
+        Call this at the very end of a paint handler to show the cost of
+        the paint on top of the window contents. The draw calls made by the
+        overlay itself are not counted.
+
+        The background is really translucent only on the DCs supporting
+        alpha colours and solid black elsewhere.
+
+        @param dc
+            The DC to draw the overlay on.
+        @param pos
+            The position of the top left corner of the overlay.
+    */
+    static void DrawOverlay(wxDC& dc, const wxPoint& pos = wxPoint(4, 4));
+};
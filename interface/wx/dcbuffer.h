@@ -17,6 +17,12 @@
 // is private style and not returned by GetStyle.
 #define wxBUFFER_USES_SHARED_BUFFER 0x04
 
+// Limits the buffer to the current update region of the window instead of
+// its entire client area, making minor repaints of large windows cheaper.
+// Only makes sense together with wxBUFFER_CLIENT_AREA and without a
+// user-supplied buffer bitmap. Available since wxWidgets 3.1.7.
+#define wxBUFFER_UPDATE_AREA        0x08
+
 
 /**
     @class wxBufferedDC
@@ -101,6 +107,19 @@ public:
     wxBufferedDC(wxDC* dc, wxBitmap& buffer = wxNullBitmap,
                  int style = wxBUFFER_CLIENT_AREA);
 
+    /**
+        Creates a buffer covering only the given part of the total area, e.g.
+        the currently damaged rectangle of the window being repainted.
+
+        Drawing is translated so that the same coordinates can be used as
+        with a full-sized buffer, but anything outside of @a area is clipped
+        away and only this rectangle is blitted back to the underlying DC.
+
+        @since 3.1.7
+    */
+    wxBufferedDC(wxDC* dc, const wxRect& area,
+                 int style = wxBUFFER_CLIENT_AREA);
+
     /**
         Copies everything drawn on the DC so far to the underlying DC
         associated with this object, if any.
@@ -114,6 +133,8 @@ public:
     */
     void Init(wxDC* dc, const wxSize& area,
               int style = wxBUFFER_CLIENT_AREA);
+    void Init(wxDC* dc, const wxRect& area,
+              int style = wxBUFFER_CLIENT_AREA);
     void Init(wxDC* dc, wxBitmap& buffer = wxNullBitmap,
               int style = wxBUFFER_CLIENT_AREA);
     //@}
@@ -212,7 +233,11 @@ public:
         Pass wxBUFFER_CLIENT_AREA for the @a style parameter to indicate that
         just the client area of the window is buffered, or
         wxBUFFER_VIRTUAL_AREA to indicate that the buffer bitmap covers the
-        virtual area.
+        virtual area. Combine wxBUFFER_CLIENT_AREA with wxBUFFER_UPDATE_AREA
+        (and no user-supplied bitmap) to size the buffer to the bounding box
+        of the current update region instead of the full client area, which
+        makes minor repaints of large windows much cheaper (since wxWidgets
+        3.1.7).
     */
     wxBufferedPaintDC(wxWindow* window, wxBitmap& buffer,
                       int style = wxBUFFER_CLIENT_AREA);
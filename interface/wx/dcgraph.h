@@ -90,6 +90,32 @@ public:
     wxGCDC();
     virtual ~wxGCDC();
 
+    /**
+       Draws many polylines in a single call, optionally with one pen per
+       polyline.
+
+       This simply forwards to wxGraphicsContext::StrokeLinesBatch(), see its
+       documentation for the description of the parameters. It is much faster
+       than calling DrawLines() once per polyline when drawing many of them,
+       e.g. in plotting code.
+
+       The overload taking a flat array reads the coordinates as
+       <code>x0, y0, x1, y1, ...</code>, avoiding any conversion of the
+       points.
+
+       @since 3.1.7
+    */
+    void DrawLinesBatch(size_t count, const size_t* sizes,
+                        const wxPoint2DDouble* points,
+                        const wxPen* pens = NULL);
+
+    /**
+        @overload
+    */
+    void DrawLinesBatch(size_t count, const size_t* sizes,
+                        const wxDouble* coords,
+                        const wxPen* pens = NULL);
+
     /**
        Retrieves associated wxGraphicsContext
     */
@@ -133,6 +133,68 @@ enum wxDirFlags
     wxDIR_DEFAULT   = wxDIR_FILES | wxDIR_DIRS | wxDIR_HIDDEN
 };
 
+/**
+    Contains the name and the metadata of a single directory entry.
+
+    Objects of this struct are filled by wxDir::GetEntries() and
+    wxDir::GetAllEntries() which retrieve the metadata while reading the
+    directory itself, which is much faster than calling e.g.
+    wxFileName::GetSize() separately for every file when enumerating large
+    directories.
+
+    @since 3.1.7
+
+    @library{wxbase}
+    @category{file}
+*/
+struct wxDirEntry
+{
+    /**
+        Default constructor creates an entry with empty name, invalid size and
+        zero modification time.
+    */
+    wxDirEntry();
+
+    /**
+        The name of the entry.
+
+        This is just the basename, without the path, for the entries returned
+        by wxDir::GetEntries() but the full path for those returned by
+        wxDir::GetAllEntries().
+    */
+    wxString name;
+
+    /**
+        The size of the file in bytes.
+
+        This is ::wxInvalidOffset for the directories or if the size couldn't
+        be retrieved.
+    */
+    wxFileOffset size;
+
+    /**
+        The time of the last modification of this entry.
+
+        This is 0 if the file times couldn't be retrieved.
+    */
+    time_t mtime;
+
+    /**
+        @true if this entry is a directory.
+
+        Note that, unless ::wxDIR_NO_FOLLOW is used, a symbolic link pointing
+        to a directory counts as a directory here.
+    */
+    bool isDir;
+};
+
+/**
+    Type of the array filled by the batched wxDir enumeration functions.
+
+    @since 3.1.7
+*/
+typedef wxVector<wxDirEntry> wxDirEntries;
+
 /**
     @class wxDir
 
@@ -246,6 +308,55 @@ public:
                               const wxString& filespec = wxEmptyString,
                               int flags = wxDIR_DEFAULT);
 
+    /**
+        Appends all the entries of this directory, together with their
+        metadata, to the array @a entries in a single pass.
+
+        This function applies the same @a filespec and @a flags filters as
+        GetFirst() but, unlike enumerating the names one by one and then
+        querying the metadata of each file separately, it captures the type,
+        size and modification time of each entry while the directory itself is
+        being read, which is typically much faster for big directories.
+
+        @return The number of entries appended to the array or @c (size_t)-1
+                on error.
+
+        @see GetAllEntries()
+
+        @since 3.1.7
+    */
+    size_t GetEntries(wxDirEntries* entries,
+                      const wxString& filespec = wxEmptyString,
+                      int flags = wxDIR_DEFAULT) const;
+
+    /**
+        Recursive version of GetEntries(): appends all the entries under the
+        directory @a dirname, with their full paths, to the array @a entries.
+
+        As with GetAllFiles(), only the files matching @a filespec are taken,
+        but the traversal always descends into all the subdirectories. The
+        directories themselves are included in the results only if @a flags
+        contains ::wxDIR_DIRS.
+
+        If @a threads is greater than 1 (or is @c -1, meaning to use as many
+        threads as there are CPUs in the system), independent subdirectories
+        are scanned in parallel by a pool of worker threads, which can speed
+        up the scan of very large directory trees considerably, especially on
+        network file systems. Note that in this case the order of the
+        returned entries is unpredictable. If wxWidgets was compiled without
+        thread support, the scan is always done by the calling thread alone.
+
+        @return The number of entries appended to the array or @c (size_t)-1
+                on error.
+
+        @since 3.1.7
+    */
+    static size_t GetAllEntries(const wxString& dirname,
+                                wxDirEntries* entries,
+                                const wxString& filespec = wxEmptyString,
+                                int flags = wxDIR_DEFAULT,
+                                int threads = 1);
+
     /**
         Start enumerating all files matching @a filespec (or all files if it is
         empty) and @e flags, return @true on success.
@@ -370,10 +481,16 @@ public:
 
         See ::wxDirFlags for the full list of the possible flags.
 
+        If @a context is non-@NULL, the traversal can be cancelled from
+        another thread using wxOperationContext::Cancel() and reports its
+        progress, counted in visited directory entries, through the context.
+        The @a context parameter is only available since wxWidgets 3.1.7.
+
         @see GetAllFiles()
     */
     size_t Traverse(wxDirTraverser& sink,
                     const wxString& filespec = wxEmptyString,
-                    int flags = wxDIR_DEFAULT) const;
+                    int flags = wxDIR_DEFAULT,
+                    wxOperationContext* context = NULL) const;
 };
 
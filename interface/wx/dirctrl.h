@@ -206,6 +206,25 @@ public:
     */
     virtual void Init();
 
+    /**
+        Enable or disable caching the child lists of visited directories.
+
+        While the cache is enabled, re-expanding a directory whose
+        modification time hasn't changed since it was last shown reuses the
+        result of the previous enumeration instead of listing the directory
+        contents again. This makes re-visiting recently shown directories
+        almost instant, which is especially noticeable for network shares,
+        at the price of not reflecting the (rare) changes which don't update
+        the directory modification time until it is changed in some other
+        way.
+
+        The cache is disabled by default and is automatically flushed
+        whenever the filter or the hidden files setting changes.
+
+        @since 3.1.7
+    */
+    void EnableChildListCache(bool enable = true);
+
     /**
         Collapse and expand the tree, thus re-creating it from scratch. May be
         used to update the displayed directory content.
@@ -1022,12 +1022,39 @@ public:
             no single view requested the update (for instance, when the
             document is opened).
         @param hint
-            This is unused currently, but may in future contain
-            application-specific information for making updating more
-            efficient.
+            An optional application-specific hint describing the change. If
+            it is a wxDocumentUpdateHint (or derived from it), the framework
+            uses it to skip calling OnUpdate() at all for the views not
+            subscribed to any of its categories, see SetUpdateCategories().
     */
     virtual void OnUpdate(wxView* sender, wxObject* hint = 0);
 
+    /**
+        Subscribes this view to the given categories of document changes.
+
+        When wxDocument::UpdateAllViews() is called with a
+        wxDocumentUpdateHint carrying none of these categories, OnUpdate()
+        is not called for this view at all, avoiding useless repaints in
+        documents with many specialized views. The categories themselves are
+        an application-defined bitmask.
+
+        By default a view is subscribed to ::wxDOC_UPDATE_ALL_CATEGORIES,
+        i.e. receives every update. Updates without any hint, or with a hint
+        not derived from wxDocumentUpdateHint, are always delivered to all
+        views.
+
+        @since 3.1.7
+    */
+    void SetUpdateCategories(int categories);
+
+    /**
+        Returns the categories of document changes this view is subscribed
+        to, see SetUpdateCategories().
+
+        @since 3.1.7
+    */
+    int GetUpdateCategories() const;
+
     /**
         Associates the given document with the view. Normally called by the
         framework.
@@ -1203,6 +1230,78 @@ public:
 
 
 
+/**
+    Special value for wxDocumentUpdateHint categories including all of the
+    application-defined ones.
+
+    @since 3.1.7
+*/
+enum
+{
+    wxDOC_UPDATE_ALL_CATEGORIES = -1
+};
+
+/**
+    @class wxDocumentUpdateHint
+
+    Typed hint which can be passed to wxDocument::UpdateAllViews() to
+    describe a document change.
+
+    The hint carries the categories of the change, which are an
+    application-defined bitmask, and optionally the affected region. The
+    framework uses the categories to skip updating the views not subscribed
+    to any of them, see wxView::SetUpdateCategories(); the region (and any
+    extra information added by deriving from this class) can be used by the
+    views themselves to repaint only what actually changed.
+
+    @library{wxcore}
+    @category{docview}
+
+    @since 3.1.7
+
+    @see wxDocument::UpdateAllViews(), wxDocument::UpdateAllViewsLater()
+*/
+class wxDocumentUpdateHint : public wxObject
+{
+public:
+    /**
+        Constructor.
+
+        @param categories
+            Application-defined bitmask of the change categories, by default
+            all of them.
+        @param region
+            The changed region in document coordinates; an empty rectangle,
+            which is the default, means that any part of the document may be
+            affected.
+    */
+    explicit
+    wxDocumentUpdateHint(int categories = wxDOC_UPDATE_ALL_CATEGORIES,
+                         const wxRect& region = wxRect());
+
+    /**
+        Returns the categories of this change.
+    */
+    int GetCategories() const;
+
+    /**
+        Returns the changed region, which is empty if any part of the
+        document may be affected.
+    */
+    wxRect GetRegion() const;
+
+    /**
+        Combines this hint with another one.
+
+        The resulting categories are the union of the categories of both
+        hints and the resulting region is the union of their regions, or
+        empty (i.e. "everything") if either of them was empty. This is used
+        by wxDocument::UpdateAllViewsLater() when coalescing several updates
+        into a single one.
+    */
+    void Merge(const wxDocumentUpdateHint& hint);
+};
+
 /**
     @class wxDocument
 
@@ -1648,9 +1747,30 @@ public:
         Updates all views. If @a sender is non-@NULL, does not update this
         view. @a hint represents optional information to allow a view to
         optimize its update.
+
+        If @a hint is a wxDocumentUpdateHint (or derived from it), the views
+        not subscribed to any of its categories are skipped entirely, see
+        wxView::SetUpdateCategories().
     */
     virtual void UpdateAllViews(wxView* sender = NULL, wxObject* hint = NULL);
 
+    /**
+        Coalescing version of UpdateAllViews().
+
+        All the updates scheduled with this function before the event loop
+        runs again are merged together, using wxDocumentUpdateHint::Merge(),
+        and delivered as a single UpdateAllViews() call, so code performing
+        many small modifications in a row doesn't repaint every view once
+        per modification.
+
+        If the pending updates were scheduled by different senders, the
+        combined update is delivered with a @NULL sender, i.e. to all views.
+
+        @since 3.1.7
+    */
+    void UpdateAllViewsLater(wxView* sender = NULL,
+                             const wxDocumentUpdateHint& hint = wxDocumentUpdateHint());
+
 protected:
     /**
         This method is called by OnSaveDocument() to really save the document
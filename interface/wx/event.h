@@ -4245,6 +4245,34 @@ public:
             The default is wxIDLE_PROCESS_ALL.
     */
     static void SetMode(wxIdleMode mode);
+
+    /**
+        Static function for specifying how much time, in milliseconds,
+        wxApp::ProcessIdle() may spend sending idle events during a single
+        event loop pass.
+
+        When the budget is exhausted, the remaining windows are processed
+        during the following passes in round robin fashion, so every window
+        still receives its idle events, just not necessarily all during the
+        same pass. This can be used to keep the application responsive even
+        if it has a very large number of windows with non-trivial idle
+        handlers.
+
+        @param milliseconds
+            The budget for one pass. The default value of 0 means no limit,
+            i.e. all windows are processed in every pass.
+
+        @since 3.1.7
+    */
+    static void SetDispatchBudget(long milliseconds);
+
+    /**
+        Static function returning the idle dispatch budget, see
+        SetDispatchBudget().
+
+        @since 3.1.7
+    */
+    static long GetDispatchBudget();
 };
 
 #endif // wxUSE_BASE
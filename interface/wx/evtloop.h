@@ -6,6 +6,79 @@
 // Licence:     wxWindows licence
 /////////////////////////////////////////////////////////////////////////////
 
+/**
+    @struct wxEventLoopStats
+
+    Timing and dispatch statistics collected by an instrumented event loop.
+
+    An object of this type is returned by wxEventLoopBase::GetStats() when
+    statistics collection has been enabled with
+    wxEventLoopBase::EnableStats(). All the times are expressed in
+    microseconds.
+
+    @library{wxbase}
+    @category{appmanagement}
+
+    @see wxEventLoopBase::EnableStats(), wxEventLoopBase::GetStats()
+
+    @since 3.1.7
+*/
+struct wxEventLoopStats
+{
+    /// The number of buckets in the handlerTimes histogram.
+    enum { HistogramSize = 20 };
+
+    /// Default constructor calls Reset().
+    wxEventLoopStats();
+
+    /// Resets all the counters to zero.
+    void Reset();
+
+    /// The number of event loop iterations completed so far.
+    unsigned long iterations;
+
+    /// The number of events dispatched from the wx pending events queue.
+    unsigned long eventsProcessed;
+
+    /// The number of handlers which exceeded the slow handler threshold.
+    unsigned long slowHandlers;
+
+    /**
+        Cumulative time spent dispatching native events.
+
+        Note that this includes the time spent waiting for new events to
+        arrive when the queue is empty.
+    */
+    wxLongLong dispatchTime;
+
+    /// Cumulative time spent processing wx pending events.
+    wxLongLong pendingTime;
+
+    /// Cumulative time spent generating and processing idle events.
+    wxLongLong idleTime;
+
+    /**
+        Histogram of the individual event handler execution times.
+
+        The bucket with index @c N counts the handlers which took at least
+        2^N but less than 2^(N+1) microseconds to run, with the last bucket
+        also counting everything slower.
+    */
+    unsigned long handlerTimes[HistogramSize];
+};
+
+/**
+    Type of the callback invoked for the handlers exceeding the slow handler
+    threshold.
+
+    @see wxEventLoopBase::SetSlowHandlerCallback()
+
+    @since 3.1.7
+*/
+typedef void (*wxEventLoopSlowHandlerCallback)(const wxString& handlerClass,
+                                               wxEventType eventType,
+                                               const wxLongLong& timeMicro);
+
 /**
     @class wxEventLoopBase
 
@@ -256,6 +329,41 @@ public:
     */
     bool YieldFor(long eventsToProcess);
 
+    /**
+        Process the events of the given categories for at most the given
+        number of milliseconds.
+
+        This is a bounded version of YieldFor() meant to be called
+        periodically from long computations to keep the user interface alive:
+        unlike Yield(), it returns as soon as the time budget is exhausted
+        even if more events are pending, so the latency added to the
+        computation is predictable, and by default it only dispatches
+        ::wxEVT_CATEGORY_UI events (e.g. repainting), so user input can't
+        unexpectedly reenter the application code.
+
+        For example, a compute loop repainting a progress display at roughly
+        60 frames per second could do:
+
+        @code
+        for ( int step = 0; step < numSteps; ++step )
+        {
+            ComputeStep(step);
+
+            wxEventLoopBase::GetActive()->PumpFor(16);
+        }
+        @endcode
+
+        Note that, as with YieldFor(), only wxMSW, wxGTK and wxQt support
+        selectively dispatching the native events: the other ports dispatch
+        all pending native events within the given budget.
+
+        @return @true if events were processed, @false if the call was made
+            from a non-main thread and did nothing.
+
+        @since 3.1.7
+    */
+    bool PumpFor(long milliseconds, long eventsToProcess = wxEVT_CATEGORY_UI);
+
     /**
         Returns @true if the given event category is allowed inside
         a YieldFor() call (i.e. compares the given category against the
@@ -268,6 +376,96 @@ public:
     //@}
 
 
+    /**
+        @name Instrumentation
+
+        These methods allow collecting timing statistics about the work done
+        by the event loop, which can help to find out why an application is
+        unresponsive or misses frames.
+    */
+    //@{
+
+    /**
+        Enables or disables the collection of the statistics returned by
+        GetStats().
+
+        Statistics collection is disabled by default as it adds a small
+        overhead to every loop iteration and every dispatched event.
+
+        @since 3.1.7
+    */
+    void EnableStats(bool enable = true);
+
+    /**
+        Returns @true if statistics collection is currently enabled.
+
+        @since 3.1.7
+    */
+    bool AreStatsEnabled() const;
+
+    /**
+        Returns the statistics collected since the last call to ResetStats().
+
+        Note that the per-phase timings of wxEventLoopStats are currently
+        only collected by the ports using the generic event loop
+        implementation, i.e. wxMSW and the Unix console ports, while the
+        handler execution times are collected whenever an event queued with
+        wxEvtHandler::QueueEvent() or wxEvtHandler::AddPendingEvent() is
+        dispatched.
+
+        @since 3.1.7
+    */
+    const wxEventLoopStats& GetStats() const;
+
+    /**
+        Resets all the counters returned by GetStats() to zero.
+
+        @since 3.1.7
+    */
+    void ResetStats();
+
+    /**
+        Sets the threshold, in milliseconds, above which an event handler is
+        considered to be slow.
+
+        When statistics collection is enabled and an event handler takes
+        longer than the given threshold, it is counted in
+        wxEventLoopStats::slowHandlers and reported via the callback set with
+        SetSlowHandlerCallback() or, if no callback is set, with a
+        wxLogDebug() message identifying the handler class and the event
+        type.
+
+        The default value of 0 disables slow handler reporting.
+
+        @since 3.1.7
+    */
+    void SetSlowHandlerThreshold(int milliseconds);
+
+    /**
+        Returns the current slow handler threshold, see
+        SetSlowHandlerThreshold().
+
+        @since 3.1.7
+    */
+    int GetSlowHandlerThreshold() const;
+
+    /**
+        Sets the callback invoked whenever an event handler exceeds the slow
+        handler threshold.
+
+        The callback receives the class name of the handler which processed
+        the event, the event type and the time taken in microseconds. Only
+        the class name is provided because the handler itself may have
+        already been destroyed while processing the event. Pass @NULL to
+        revert to the default wxLogDebug() report.
+
+        @since 3.1.7
+    */
+    void SetSlowHandlerCallback(wxEventLoopSlowHandlerCallback callback);
+
+    //@}
+
+
 protected:
     /**
         This function is called before the event loop terminates, whether this
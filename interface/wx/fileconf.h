@@ -118,6 +118,56 @@ public:
     */
     void DisableAutoSave();
 
+    /**
+        Enables write-behind mode, in which changes are saved to the file by a
+        background thread instead of being written synchronously.
+
+        Normally Flush() rewrites the whole file immediately, which can
+        noticeably stall the program if it is called after every change and
+        the file lives on a slow (e.g. network) file system. In write-behind
+        mode every change schedules a snapshot of the new contents for a
+        background thread which writes the most recent snapshot to the file
+        (atomically, using a temporary file which is then renamed) at most
+        once per @a intervalMs milliseconds, so that a burst of changes
+        results in a single rewrite of the file.
+
+        Calling Flush() explicitly still writes the file synchronously and
+        the destructor of this class waits until any scheduled write has been
+        done, so no changes are lost on shutdown.
+
+        @param intervalMs
+            The minimal interval between two background writes, in
+            milliseconds.
+
+        @return @true if write-behind mode is now active or @false if it
+            couldn't be enabled, e.g. because this object has no associated
+            local file or wxWidgets was built without thread support.
+
+        @see DisableWriteBehind()
+
+        @since 3.1.7
+    */
+    bool EnableWriteBehind(int intervalMs = 1000);
+
+    /**
+        Disables write-behind mode, writing out any still pending changes
+        synchronously.
+
+        Does nothing if EnableWriteBehind() hadn't been called.
+
+        @since 3.1.7
+    */
+    void DisableWriteBehind();
+
+    /**
+        Returns @true if write-behind mode is currently active.
+
+        @see EnableWriteBehind()
+
+        @since 3.1.7
+    */
+    bool IsWriteBehindEnabled() const;
+
     /**
         Allows setting the mode to be used for the config file creation. For example, to
         create a config file which is not readable by other users (useful if it stores
@@ -369,6 +369,11 @@ public:
         @endcode
 
         Must be overridden in derived handlers.
+
+        Note that wxFileSystem remembers which handler accepted a given
+        protocol in order to avoid querying all the handlers for every
+        location it opens, so the result of this function should depend on
+        the protocol of @a location only, as in the example above.
     */
     virtual bool CanOpen(const wxString& location) = 0;
 
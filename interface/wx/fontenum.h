@@ -73,6 +73,22 @@ public:
     */
     static bool IsValidFacename(const wxString& facename);
 
+    /**
+        Fill the facename cache used internally by this class if this hadn't
+        been done yet.
+
+        The full list of facenames returned by GetFacenames() with default
+        parameters is cached and reused by the subsequent calls, but the
+        initial enumeration can still be slow enough to noticeably delay
+        e.g. the first opening of a dialog containing a font selection
+        control. Applications may call this function at a convenient moment
+        after start-up, for example from an idle handler, to pay this cost in
+        advance.
+
+        @since 3.1.7
+     */
+    static void CacheFacenames();
+
     /**
         Invalidate cache used by some of the methods of this class internally.
 
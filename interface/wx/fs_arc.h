@@ -10,6 +10,11 @@
     @class wxArchiveFSHandler
 
     A file system handler for accessing files inside of archives.
+
+    The catalogs of the archives opened by this handler are cached and the
+    cache is shared by all its instances, so an archive used from several
+    wxFileSystem objects, e.g. a help file or a resource archive, is only
+    scanned once during the life-time of the program.
 */
 class wxArchiveFSHandler : public wxFileSystemHandler
 {
@@ -141,6 +141,38 @@ public:
         owner.
      */
     void SetOwner(wxEvtHandler* handler);
+
+    /**
+        Sets the length in milliseconds of the window during which the events
+        for the same path are merged into a single event before delivery.
+
+        During bulk operations, e.g. a version control system updating the
+        working tree, a single path typically generates a whole storm of
+        events; with a non-zero coalescing interval only their net effect is
+        delivered once the window ends: a creation followed by modifications
+        is delivered as a single creation event, a creation cancelled by a
+        deletion is not delivered at all, and a burst of modifications
+        becomes one event whose
+        wxFileSystemWatcherEvent::GetChangeCount() returns the number of
+        changes merged into it. Rename, warning and error events are never
+        coalesced and flush any pending events to preserve the delivery
+        order; the relative order of events for different paths within one
+        window is however not preserved.
+
+        The default value of 0 delivers every event immediately. Coalescing
+        is currently implemented for the inotify and kqueue based watchers;
+        elsewhere this setting is ignored.
+
+        @since 3.1.7
+     */
+    void SetCoalesceInterval(int milliseconds);
+
+    /**
+        Returns the current coalescing interval, see SetCoalesceInterval().
+
+        @since 3.1.7
+     */
+    int GetCoalesceInterval() const;
 };
 
 
@@ -194,6 +226,20 @@ public:
      */
     int GetChangeType() const;
 
+    /**
+        Returns the number of identical consecutive changes represented by
+        this event.
+
+        Some backends coalesce bursts of identical native events, e.g. the
+        repeated modification events generated while a large file is being
+        written, into a single event carrying their count instead of
+        flooding the event loop with one event per change. The returned
+        value is always at least 1.
+
+        @since 3.1.7
+     */
+    int GetChangeCount() const;
+
     /**
         Returns @c true if this error is an error event
 
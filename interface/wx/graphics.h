@@ -144,6 +144,18 @@ public:
     virtual void AddRoundedRectangle(wxDouble x, wxDouble y, wxDouble w,
                                      wxDouble h, wxDouble radius);
 
+    /**
+        Removes all points and sub-paths from the path.
+
+        Unlike creating a new path, this keeps the allocations made by the
+        native backend where possible, so repeatedly building small paths,
+        e.g. for drawing many plot markers, is much cheaper with a single
+        cleared and re-filled path than with a new path every time.
+
+        @since 3.1.7
+    */
+    virtual void Clear();
+
     /**
         Closes the current sub-path. After this call the current point will be
         at the joined endpoint of the sub-path.
@@ -518,6 +530,27 @@ public:
     */
     static wxGraphicsContext* Create();
 
+    /**
+        Create a context recording all the drawing commands into the given
+        command list instead of executing them.
+
+        The returned context supports the full drawing API, but nothing is
+        actually drawn: the commands are stored in @a commands and can be
+        replayed later, any number of times, on another context using
+        wxGraphicsCommandList::Replay(). If no renderer is specified, the
+        default one is used; the recorded commands can only be replayed on a
+        context using the same renderer.
+
+        The caller is responsible for deleting the returned context after the
+        recording is finished, the command list itself is not affected by its
+        destruction.
+
+        @since 3.1.7
+    */
+    static wxGraphicsContext*
+    CreateRecording(wxGraphicsCommandList& commands,
+                    wxGraphicsRenderer* renderer = NULL);
+
     /** @}
     */
 
@@ -778,6 +811,20 @@ public:
     virtual void DrawPath(const wxGraphicsPath& path,
                           wxPolygonFillMode fillStyle = wxODDEVEN_RULE);
 
+    /**
+        Draws the same path at each of the @a n offsets in a single call.
+
+        This is equivalent to calling DrawPath() once per offset with the
+        context translated by it, but much cheaper than recreating the path
+        for every instance when drawing many identical small shapes such as
+        scatter plot markers.
+
+        @since 3.1.7
+    */
+    virtual void DrawPath(const wxGraphicsPath& path, size_t n,
+                          const wxPoint2DDouble* offsets,
+                          wxPolygonFillMode fillStyle = wxODDEVEN_RULE);
+
     /**
         Draws a rectangle.
     */
@@ -872,6 +919,34 @@ public:
     */
     virtual void StrokeLines(size_t n, const wxPoint2DDouble* points);
 
+    /**
+        Strokes many polylines in a single call.
+
+        @a sizes contains the number of points of each of the @a count
+        polylines and @a points contains the points of all the polylines one
+        after the other. If @a pens is non-@NULL, it must contain one pen per
+        polyline; consecutive polylines using the same pen are accumulated
+        into a single path, so the backend is only called once per pen change
+        and not once per polyline, which is considerably faster when drawing
+        thousands of polylines, e.g. in plotting code.
+
+        The overload taking a flat array reads the coordinates as
+        <code>x0, y0, x1, y1, ...</code>, avoiding any intermediate
+        conversion of the points.
+
+        @since 3.1.7
+    */
+    virtual void StrokeLinesBatch(size_t count, const size_t* sizes,
+                                  const wxPoint2DDouble* points,
+                                  const wxPen* pens = NULL);
+
+    /**
+        @overload
+    */
+    virtual void StrokeLinesBatch(size_t count, const size_t* sizes,
+                                  const wxDouble* coords,
+                                  const wxPen* pens = NULL);
+
     /**
         Strokes along a path with the current pen.
     */
@@ -1160,6 +1235,75 @@ public:
     */
 };
 
+/**
+    @class wxGraphicsCommandList
+
+    Represents a retained sequence of wxGraphicsContext drawing commands.
+
+    The commands issued on the context returned by
+    wxGraphicsContext::CreateRecording() are stored in the command list
+    instead of being executed and can be replayed any number of times on
+    another context, optionally under an extra transform. This allows
+    creating the expensive parts of a largely static scene (paths, brushes,
+    fonts) just once and re-issuing them cheaply on every repaint, e.g. when
+    scrolling:
+
+    @code
+    // Record the scene once.
+    wxGraphicsCommandList commands;
+    wxGraphicsContext* rec = wxGraphicsContext::CreateRecording(commands);
+    DrawSchematic(rec); // any normal wxGraphicsContext drawing code
+    delete rec;
+
+    // Replay it on every repaint, shifted by the scroll offset.
+    wxGraphicsContext* gc = wxGraphicsContext::Create(dc);
+    wxGraphicsMatrix m = gc->CreateMatrix();
+    m.Translate(-scrollX, -scrollY);
+    commands.Replay(gc, m);
+    delete gc;
+    @endcode
+
+    Notice that the recorded commands reference renderer-specific objects, so
+    they can only be replayed on a context using the same renderer as the one
+    the recording context was created with.
+
+    @since 3.1.7
+
+    @library{wxcore}
+    @category{gdi}
+
+    @see wxGraphicsContext::CreateRecording()
+*/
+class wxGraphicsCommandList
+{
+public:
+    /// Default constructor creates an empty command list.
+    wxGraphicsCommandList();
+
+    /// Destructor frees all the recorded commands.
+    ~wxGraphicsCommandList();
+
+    /// Return @true if nothing has been recorded (yet).
+    bool IsEmpty() const;
+
+    /// Discard all the recorded commands, allowing to record anew.
+    void Clear();
+
+    //@{
+    /**
+        Re-issue all the recorded commands on the given context.
+
+        The context must use the same renderer as the one used for recording.
+        The overload taking a matrix applies this transform to all the
+        replayed commands. The clip and transform of @a gc are preserved, but
+        its pen, brush and font change just as if the recorded calls had been
+        made on it directly.
+    */
+    void Replay(wxGraphicsContext* gc) const;
+    void Replay(wxGraphicsContext* gc, const wxGraphicsMatrix& transform) const;
+    //@}
+};
+
 /**
     Represents a single gradient stop in a collection of gradient stops as
     represented by wxGraphicsGradientStops.
@@ -1273,6 +1417,47 @@ public:
     wxColour GetEndColour() const;
 };
 
+/**
+    The classes of operations measured by wxGraphicsRenderer::Benchmark().
+
+    @since 3.1.7
+*/
+enum wxGraphicsBenchmarkOp
+{
+    wxGRAPHICS_BENCHMARK_LINES,
+    wxGRAPHICS_BENCHMARK_RECTANGLES,
+    wxGRAPHICS_BENCHMARK_ELLIPSES,
+    wxGRAPHICS_BENCHMARK_CURVES,
+    wxGRAPHICS_BENCHMARK_BITMAPS,
+    wxGRAPHICS_BENCHMARK_TEXT,
+
+    /** The number of operation classes, not a valid class itself. */
+    wxGRAPHICS_BENCHMARK_OP_COUNT
+};
+
+/**
+    Holds the timings measured by wxGraphicsRenderer::Benchmark().
+
+    @since 3.1.7
+*/
+struct wxGraphicsBenchmarkResult
+{
+    /**
+        Returns the sum of the timings of all the operation classes.
+    */
+    double Total() const;
+
+    /**
+        Time, in milliseconds, taken by a fixed number of operations of each
+        class, so smaller is better.
+
+        The values are only comparable between renderers and not between
+        operation classes, as different classes use different numbers of
+        operations.
+    */
+    double ms[wxGRAPHICS_BENCHMARK_OP_COUNT];
+};
+
 /**
     @class wxGraphicsRenderer
 
@@ -1576,6 +1761,63 @@ public:
         Returns Direct2D renderer (MSW only).
     */
     static wxGraphicsRenderer* GetDirect2DRenderer();
+
+    /**
+        Returns all the renderers available in this build.
+
+        The default renderer always comes first. Note that the vector can
+        contain a single element on the platforms providing only one
+        renderer.
+
+        @since 3.1.7
+    */
+    static wxVector<wxGraphicsRenderer*> GetAllRenderers();
+
+    /**
+        Runs a micro-benchmark of this renderer and returns the results.
+
+        A fixed number of operations of each class enumerated by
+        wxGraphicsBenchmarkOp is performed on an offscreen image surface of
+        the given size and the time taken by each class is returned, making
+        it possible to compare the speed of the available renderers on the
+        actual hardware the program is running on.
+
+        Only available in wxUSE_IMAGE builds.
+
+        @since 3.1.7
+    */
+    wxGraphicsBenchmarkResult Benchmark(int width = 256, int height = 256);
+
+    /**
+        Benchmarks all the available renderers and returns the overall
+        fastest one.
+
+        This function calls Benchmark() for each element of
+        GetAllRenderers() and returns the renderer with the smallest total
+        time. It also remembers the fastest renderer for each individual
+        operation class, which can be retrieved with GetFastestRenderer()
+        afterwards, allowing an application to pick its renderer per
+        capability.
+
+        @param results
+            If non-@NULL, filled with the individual benchmark results, in
+            GetAllRenderers() order.
+
+        @since 3.1.7
+    */
+    static wxGraphicsRenderer*
+    BenchmarkAll(wxVector<wxGraphicsBenchmarkResult>* results = NULL);
+
+    /**
+        Returns the fastest renderer for the given operation class.
+
+        The result is based on the measurements done by the last call to
+        BenchmarkAll(); if it hasn't been called, the default renderer is
+        returned.
+
+        @since 3.1.7
+    */
+    static wxGraphicsRenderer* GetFastestRenderer(wxGraphicsBenchmarkOp op);
 };
 
 
@@ -1201,6 +1201,18 @@ public:
         ::wxELLIPSIZE_NONE is.
      */
     wxEllipsizeMode GetEllipsizeMode() const;
+
+    /**
+        Compare with another object of the same type.
+
+        Two objects are equal if they specify the same behaviour.
+
+        @since 3.1.7
+     */
+    bool operator==(const wxGridFitMode& other) const;
+
+    /// @overload
+    bool operator!=(const wxGridFitMode& other) const;
 };
 
 /**
@@ -1447,6 +1459,19 @@ public:
 
     void MergeWith(wxGridCellAttr *mergefrom);
 
+    /**
+        Return @true if this attribute specifies exactly the same appearance
+        and behaviour as the other one.
+
+        Note that the renderer and editor pointers are compared, i.e. two
+        attributes using equal, but different, renderer objects are not
+        considered to be the same, and that any client data possibly
+        associated with the attributes is not taken into account.
+
+        @since 3.1.7
+     */
+    bool IsSameAs(const wxGridCellAttr& other) const;
+
     void SetSize(int num_rows, int num_cols);
 
     /**
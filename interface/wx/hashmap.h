@@ -253,6 +253,18 @@ public:
     */
     mapped_type operator[](const key_type& key);
 
+    /**
+        Reserves space for the given number of elements.
+
+        Grows the internal table in advance so that @a size elements can be
+        inserted without any rehashing, which is noticeably faster than
+        letting the table grow incrementally when the final number of
+        elements is known, even only approximately.
+
+        @since 3.1.7
+    */
+    void reserve(size_type size);
+
     /**
         Returns the number of elements in the map.
     */
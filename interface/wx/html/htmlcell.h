@@ -255,6 +255,19 @@ public:
     */
     virtual void DrawInvisible(wxDC& dc, int x , int y, wxHtmlRenderingInfo& info);
 
+    /**
+        Returns @true if DrawInvisible() of this cell does anything, i.e. if it
+        must be called even when the cell is scrolled out of view.
+
+        The default implementation returns @false, allowing the drawing code
+        to skip the cell entirely when it is invisible. Any class overriding
+        DrawInvisible() non-trivially must override this method to return
+        @true as well, as otherwise its DrawInvisible() may not be called.
+
+        @since 3.1.7
+    */
+    virtual bool AffectsRenderingState() const;
+
     /**
         Returns pointer to itself if this cell matches condition (or if any of the
         cells following in the list matches), @NULL otherwise.
@@ -187,6 +187,12 @@ public:
     /**
         Appends HTML fragment to currently displayed text and refreshes the window.
 
+        Since wxWidgets 3.3.0 only the appended fragment is parsed and laid
+        out, making repeated appends to a long page (e.g. a log view) much
+        faster. Note that because of this the fragment is parsed on its own
+        and so cannot rely on tags left unclosed in the previously displayed
+        text.
+
         @param source
             HTML code fragment
 
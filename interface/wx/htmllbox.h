@@ -77,6 +77,38 @@ public:
     const wxFileSystem& GetFileSystem() const;
     //@}
 
+    /**
+        Changes the number of items whose parsed representation is cached.
+
+        The control keeps the parsed HTML of the most recently used items in a
+        cache to avoid parsing them again every time they must be redrawn. The
+        default cache size of 50 items is enough for the visible items of a
+        typical listbox, but enlarging the cache, together with the automatic
+        pre-parsing of the items adjacent to the visible area done when the
+        application is idle, makes scrolling through long lists smoother.
+
+        Notice that the cells are looked up in the cache using a linear scan,
+        so very large cache sizes would defeat its purpose; also note that
+        changing the size discards the currently cached items.
+
+        @param size
+            The number of items to cache, must be at least 1.
+
+        @see GetCellCacheSize()
+
+        @since 3.1.7
+    */
+    void SetCellCacheSize(size_t size);
+
+    /**
+        Returns the number of items whose parsed representation is cached.
+
+        @see SetCellCacheSize()
+
+        @since 3.1.7
+    */
+    size_t GetCellCacheSize() const;
+
 protected:
 
     /**
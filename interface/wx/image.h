@@ -119,6 +119,7 @@ enum wxImagePNGType
 #define wxIMAGE_OPTION_PNG_COMPRESSION_MEM_LEVEL        wxString("PngZM")
 #define wxIMAGE_OPTION_PNG_COMPRESSION_STRATEGY         wxString("PngZS")
 #define wxIMAGE_OPTION_PNG_COMPRESSION_BUFFER_SIZE      wxString("PngZB")
+#define wxIMAGE_OPTION_PNG_THREADS                      wxString("PngThreads")
 
 #define wxIMAGE_OPTION_TIFF_BITSPERSAMPLE               wxString("BitsPerSample")
 #define wxIMAGE_OPTION_TIFF_SAMPLESPERPIXEL             wxString("SamplesPerPixel")
@@ -283,6 +284,48 @@ public:
     virtual bool LoadFile(wxImage* image, wxInputStream& stream,
                           bool verbose = true, int index = -1);
 
+    /**
+        Loads only a region of an image, possibly at reduced resolution.
+
+        This is useful for showing parts of images too big to be decoded as
+        a whole, e.g. tiles of a map: on success, @a image contains the part
+        of the image covered by @a rect, reduced by the integer factor
+        @a downscale, i.e. is rect.GetSize()/downscale pixels big.
+
+        The base class implementation decodes the complete image and
+        extracts the requested region from it, which only saves memory, not
+        time, but the handlers of the formats allowing partial decoding
+        override it to decode only (approximately) what is needed:
+        wxTIFFHandler reads just the strips or tiles overlapping the region
+        and wxJPEGHandler decodes at the nearest of 1/2, 1/4 or 1/8 of the
+        full resolution when @a downscale allows it.
+
+        @param image
+            The image object which is to be affected by this operation.
+        @param stream
+            Opened input stream for reading image data.
+        @param rect
+            The region to load, in full resolution image coordinates. It is
+            clamped to the image size; the function fails if it doesn't
+            intersect the image at all.
+        @param downscale
+            The integer factor, at least 1, by which to reduce the region.
+        @param verbose
+            If set to @true, errors reported by the image handler will produce
+            wxLogMessages.
+        @param index
+            The index of the image in the file (starting from zero).
+
+        @return @true if the operation succeeded, @false otherwise.
+
+        @since 3.1.7
+
+        @see LoadFile()
+    */
+    virtual bool LoadRegion(wxImage* image, wxInputStream& stream,
+                            const wxRect& rect, int downscale = 1,
+                            bool verbose = true, int index = -1);
+
     /**
         Saves an image in the output stream.
 
@@ -602,6 +645,34 @@ public:
     wxImage(const wxSize& sz, unsigned char* data, unsigned char* alpha,
             bool static_data = false);
 
+    /**
+        Creates an image from data in memory with the given row stride.
+
+        This constructor allows using buffers whose rows are @a stride bytes
+        apart, e.g. rows padded to some alignment as commonly produced by
+        cameras and scanners. If @a stride is exactly @c width*3 it behaves
+        as the constructor without a stride, i.e. the buffer is used
+        directly without copying it (and, with @a static_data @true, without
+        ever freeing it); otherwise the rows are copied, without their
+        padding, into a packed buffer owned by the image.
+
+        @param width
+            Specifies the width of the image.
+        @param height
+            Specifies the height of the image.
+        @param data
+            A pointer to RGB data
+        @param stride
+            The distance in bytes between the starts of consecutive rows,
+            at least @c width*3.
+        @param static_data
+            Indicates if the data should be free'd after use
+
+        @since 3.1.7
+    */
+    wxImage(int width, int height, unsigned char* data, size_t stride,
+            bool static_data = false);
+
     /**
         Creates an image from XPM data.
 
@@ -756,6 +827,16 @@ public:
     */
     bool Create( const wxSize& sz, unsigned char* data, unsigned char* alpha, bool static_data = false );
 
+    /**
+        Creates a fresh image from a buffer with the given row stride.
+        See wxImage::wxImage(int,int,unsigned char*,size_t,bool) for more info.
+
+        @return @true if the call succeeded, @false otherwise.
+
+        @since 3.1.7
+    */
+    bool Create( int width, int height, unsigned char* data, size_t stride, bool static_data = false );
+
     /**
         Initialize the image data with zeroes (the default) or with the
         byte value given as @a value.
@@ -934,6 +1015,54 @@ public:
     */
     void ChangeHSV(double angleH, double factorS, double factorV);
 
+    /**
+        Rotates the hue of a raw buffer of @a numPixels interleaved RGB
+        triplets, without needing a wxImage.
+
+        The @a angle parameter has the same meaning as for the overload
+        taking only it.
+
+        @since 3.1.7
+    */
+    static void RotateHue(unsigned char* rgb, size_t numPixels, double angle);
+
+    /**
+        Changes the saturation of a raw buffer of @a numPixels interleaved
+        RGB triplets, without needing a wxImage.
+
+        The @a factor parameter has the same meaning as for the overload
+        taking only it.
+
+        @since 3.1.7
+    */
+    static void ChangeSaturation(unsigned char* rgb, size_t numPixels,
+                                 double factor);
+
+    /**
+        Changes the brightness (value) of a raw buffer of @a numPixels
+        interleaved RGB triplets, without needing a wxImage.
+
+        The @a factor parameter has the same meaning as for the overload
+        taking only it.
+
+        @since 3.1.7
+    */
+    static void ChangeBrightness(unsigned char* rgb, size_t numPixels,
+                                 double factor);
+
+    /**
+        Changes the hue, the saturation and the brightness (value) of a raw
+        buffer of @a numPixels interleaved RGB triplets, without needing a
+        wxImage.
+
+        The last three parameters have the same meaning as for the overload
+        taking only them.
+
+        @since 3.1.7
+    */
+    static void ChangeHSV(unsigned char* rgb, size_t numPixels,
+                          double angleH, double factorS, double factorV);
+
     /**
         Returns a scaled version of the image.
 
@@ -1347,6 +1476,11 @@ public:
             (in bytes) for saving a PNG file. Ideally this should be as big as
             the resulting PNG file. Use this option if your application produces
             images with small size variation.
+        @li @c wxIMAGE_OPTION_PNG_THREADS: Number of threads used for
+            preparing the image rows while saving a PNG file: 0 (the
+            default) to use one thread per available CPU, 1 to do
+            everything in the calling thread. This option is available
+            since wxWidgets 3.1.7.
 
         Options specific to wxTIFFHandler:
         @li @c wxIMAGE_OPTION_TIFF_BITSPERSAMPLE: Number of bits per
@@ -1427,6 +1561,27 @@ public:
     */
     wxImage GetSubImage(const wxRect& rect) const;
 
+    /**
+        Returns a sub image sharing the pixel buffer of this one.
+
+        Unlike GetSubImage(), no pixel data is copied if @a rect spans the
+        full width of the image: the returned image then directly aliases
+        the rows of this one, which makes taking horizontal bands of a big
+        image (e.g. for processing it piecewise) essentially free. If @a
+        rect is narrower than the image this is not possible, as the rows
+        of an image must be contiguous in memory, and this function simply
+        returns GetSubImage().
+
+        Note the unusual sharing semantics, which are the point of this
+        function: the view does not own the shared buffer, so it must not
+        be used after this image has been destroyed or its buffer
+        reallocated, and writing to the view modifies this image directly,
+        bypassing the usual copy-on-write of wxImage.
+
+        @since 3.1.7
+    */
+    wxImage SubImageView(const wxRect& rect) const;
+
     /**
         Gets the type of image found by LoadFile() or specified with SaveFile().
 
@@ -1697,6 +1852,68 @@ public:
     */
     void ClearAlpha();
 
+    /**
+        Returns @true if the RGB data of this image is stored premultiplied by
+        the alpha channel.
+
+        See PremultiplyAlpha() for the description of this storage mode.
+
+        @since 3.1.7
+    */
+    bool HasPremultipliedAlpha() const;
+
+    /**
+        Converts the image to premultiplied alpha storage.
+
+        Multiplies each RGB component by the alpha value of its pixel and
+        marks the image as premultiplied. Platform bitmap formats used for
+        alpha blending (e.g. 32 bpp DIBs used with @c ::AlphaBlend() under
+        MSW) require premultiplied values, so converting an image once with
+        this function avoids redoing the per-pixel multiplications during
+        every subsequent wxImage to wxBitmap conversion.
+
+        The premultiplied state is preserved by the functions creating a
+        modified copy of the image, such as Copy(), Scale(), Mirror(),
+        Rotate90(), Rotate180(), GetSubImage() and SubImageView(). Calling
+        SetAlpha() with a new alpha buffer or ClearAlpha() resets it.
+
+        Note that premultiplication is lossy for pixels with low alpha
+        values, so the original colour values cannot always be recovered by
+        UnpremultiplyAlpha().
+
+        This function does nothing if the image has no alpha channel or is
+        already premultiplied.
+
+        @since 3.1.7
+    */
+    void PremultiplyAlpha();
+
+    /**
+        Converts a premultiplied image back to straight (non-premultiplied)
+        alpha storage.
+
+        This is the inverse of PremultiplyAlpha(), up to the rounding errors
+        inherent in the premultiplication. This function does nothing if the
+        image is not marked as premultiplied.
+
+        @since 3.1.7
+    */
+    void UnpremultiplyAlpha();
+
+    /**
+        Marks the image as storing premultiplied alpha without modifying the
+        pixel values.
+
+        Use this function when the pixel data came from a source which
+        already premultiplies, e.g. a rendering library producing
+        premultiplied surfaces. The image must have an alpha channel.
+
+        @see PremultiplyAlpha()
+
+        @since 3.1.7
+    */
+    void SetPremultipliedAlpha(bool premultiplied = true);
+
     /**
         Sets the image data without performing checks.
 
@@ -1888,6 +2105,43 @@ public:
     */
     static void AddHandler(wxImageHandler* handler);
 
+    /**
+        Register an image handler lazily.
+
+        Unlike with AddHandler(), the handler object is not created until it
+        is actually needed, i.e. when loading or saving an image of the
+        corresponding type or when the handler is looked up explicitly. This
+        can noticeably reduce the startup time of programs supporting many
+        image formats, as ::wxInitAllImageHandlers() uses this function.
+
+        If @a signature is given, it must point to the leading magic bytes
+        identifying the format, allowing the image loading code to recognize
+        the format of a stream, and create only the matching handler, from a
+        single read of its header. Formats without any fixed signature can
+        pass @NULL, in which case the handler is created whenever an image of
+        unknown format needs to be probed.
+
+        @param factory
+            A function creating a new heap-allocated handler object, which
+            will be owned by wxImage as if it had been added with
+            AddHandler().
+        @param type
+            The image type handled by the handler; one of the ::wxBitmapType
+            values.
+        @param signature
+            Pointer to the first bytes of the format signature or @NULL. The
+            pointer must remain valid for the program lifetime, i.e. should
+            normally point to a string literal.
+        @param sigLength
+            The number of bytes in @a signature, currently at most 16.
+
+        @since 3.1.7
+    */
+    static void AddLazyHandler(wxImageHandler* (*factory)(),
+                               wxBitmapType type,
+                               const void* signature = NULL,
+                               size_t sigLength = 0);
+
     /**
         Deletes all image handlers.
         This function is called by wxWidgets on exit.
@@ -1948,6 +2202,10 @@ public:
     /**
         Returns the static list of image format handlers.
 
+        Calling this function creates all the handlers whose creation had
+        been delayed until they are really needed, so that the returned list
+        always contains all the registered handlers.
+
         @see wxImageHandler
     */
     static wxList& GetHandlers();
@@ -12,6 +12,7 @@
 #define wxIMAGE_OPTION_PNG_COMPRESSION_MEM_LEVEL    wxT("PngZM")
 #define wxIMAGE_OPTION_PNG_COMPRESSION_STRATEGY     wxT("PngZS")
 #define wxIMAGE_OPTION_PNG_COMPRESSION_BUFFER_SIZE  wxT("PngZB")
+#define wxIMAGE_OPTION_PNG_THREADS                  wxT("PngThreads")
 
 /* These are already in interface/wx/image.h
     They were likely put there as a stopgap, but they've been there long enough
@@ -50,3 +51,122 @@ public:
 protected:
     virtual bool DoCanRead( wxInputStream& stream );
 };
+
+/**
+    @class wxPNGStreamEncoder
+
+    Writes a PNG file incrementally, band by band.
+
+    Unlike wxPNGHandler::SaveFile(), which requires a complete wxImage, this
+    class encodes the image as its rows are produced, so a huge image can be
+    saved without its full pixel data ever existing in memory at once: call
+    Start() to write the PNG header, then WriteRows() for each band of rows
+    as it becomes available and finally Finish() to complete the file.
+
+    Only 8-bit RGB and RGBA data can be written like this, use
+    wxPNGHandler::SaveFile() for the other PNG formats.
+
+    Example of saving an image produced in bands of 256 rows:
+
+    @code
+    wxFFileOutputStream out("capture.png");
+    wxPNGStreamEncoder enc;
+    if ( !enc.Start(out, width, height) )
+        return;
+
+    wxMemoryBuffer band(256*width*3);
+    for ( int y = 0; y < height; y += 256 )
+    {
+        const int numRows = wxMin(256, height - y);
+        unsigned char* const rgb = (unsigned char*)band.GetData();
+        ProduceRows(rgb, y, numRows); // fill the band with pixel data
+        if ( !enc.WriteRows(rgb, NULL, numRows) )
+            return;
+    }
+
+    enc.Finish();
+    @endcode
+
+    @since 3.1.7
+
+    @library{wxcore}
+    @category{gdi}
+
+    @see wxPNGHandler, wxImage::SaveFile()
+*/
+class wxPNGStreamEncoder
+{
+public:
+    /**
+        Default constructor.
+
+        Call Start() to actually begin writing an image.
+    */
+    wxPNGStreamEncoder();
+
+    /**
+        Destructor.
+
+        If Finish() hasn't been called, the partially written file is
+        abandoned: whatever was already written to the stream remains there
+        but doesn't constitute a valid PNG file.
+    */
+    ~wxPNGStreamEncoder();
+
+    /**
+        Set the zlib compression level used for the file.
+
+        Valid values are 0 (no compression) to 9 (best but slowest
+        compression), the default value of -1 uses the zlib default. This
+        function must be called before Start() to have any effect.
+    */
+    void SetCompressionLevel(int level);
+
+    /**
+        Set the number of threads used for preparing the rows for libpng.
+
+        With the default value of 0, one thread per available CPU is used
+        when a WriteRows() band is big enough for this to pay off. Pass 1 to
+        do all the work in the calling thread.
+    */
+    void SetThreadCount(int count);
+
+    /**
+        Start writing an image of the given total size to the stream.
+
+        The stream must remain alive until Finish() is called. If @a
+        withAlpha is @true, the image is written as RGBA and WriteRows()
+        expects an alpha channel as well.
+
+        @return @true on success, @false if writing the PNG header failed.
+    */
+    bool Start(wxOutputStream& stream, int width, int height,
+               bool withAlpha = false);
+
+    /**
+        Encode the next @a numRows rows of the image.
+
+        @param rgb
+            Points to the pixel data of the rows in the usual wxImage
+            format, i.e. @a numRows times width RGB triplets.
+        @param alpha
+            Points to @a numRows times width alpha bytes if the encoder was
+            started with an alpha channel, ignored (and can be @NULL)
+            otherwise.
+        @param numRows
+            The number of rows to encode, must be positive and not exceed
+            the number of rows still remaining to be written.
+
+        @return @true on success, @false if writing to the stream failed, in
+            which case the file cannot be completed any more.
+    */
+    bool WriteRows(const unsigned char* rgb, const unsigned char* alpha,
+                   int numRows);
+
+    /**
+        Write the PNG trailer after all the rows have been written.
+
+        @return @true if the file was successfully completed.
+    */
+    bool Finish();
+};
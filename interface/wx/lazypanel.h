@@ -0,0 +1,107 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        lazypanel.h
+// Purpose:     interface of wxLazyPanel
+// Author:      wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+    @class wxLazyPanel
+
+    A panel which defers creating its children until it becomes visible.
+
+    This class is useful for the pages of the book controls and, more
+    generally, for any panes which the user may never look at: derive your
+    pages from it and create their controls in the overridden CreateContent()
+    instead of the constructor and only the pages actually visited by the
+    user are ever fully created. For dialogs with many complex pages this can
+    reduce the time needed to open the dialog considerably.
+
+    Example of use:
+
+    @code
+    class MyOptionsPage : public wxLazyPanel
+    {
+    public:
+        MyOptionsPage(wxWindow* parent) : wxLazyPanel(parent) { }
+
+    protected:
+        virtual void CreateContent() wxOVERRIDE
+        {
+            wxSizer* const sizer = new wxBoxSizer(wxVERTICAL);
+            sizer->Add(new wxCheckBox(this, wxID_ANY, "Enable the option"),
+                       wxSizerFlags().Border());
+            ... create the other controls ...
+            SetSizer(sizer);
+        }
+    };
+
+    ...
+
+    notebook->AddPage(new MyOptionsPage(notebook), "Options");
+    @endcode
+
+    CreateContent() may also load the panel contents from XRC, e.g. by
+    calling wxXmlResource::LoadPanel() with this panel as parent and putting
+    the result into a sizer.
+
+    The contents is created automatically when the panel is shown for the
+    first time, in particular when it becomes the selected page of a book
+    control. If the panel children must be accessed from code before this
+    happens, for example to fill them with the current values when the
+    dialog is created, call Realize() explicitly first.
+
+    @library{wxcore}
+    @category{miscwnd}
+
+    @see wxPanel, wxBookCtrlBase
+
+    @since 3.1.7
+*/
+class wxLazyPanel : public wxPanel
+{
+public:
+    /**
+        Default constructor, Create() must be called later.
+    */
+    wxLazyPanel();
+
+    /**
+        Constructor creating the panel window itself, but not its children.
+
+        The parameters have the same meaning as in the wxPanel constructor.
+        Notice that the panel children are only created later, by
+        CreateContent().
+    */
+    wxLazyPanel(wxWindow* parent,
+                wxWindowID winid = wxID_ANY,
+                const wxPoint& pos = wxDefaultPosition,
+                const wxSize& size = wxDefaultSize,
+                long style = wxTAB_TRAVERSAL | wxNO_BORDER,
+                const wxString& name = wxPanelNameStr);
+
+    /**
+        Returns @true if CreateContent() had already been called.
+    */
+    bool IsRealized() const;
+
+    /**
+        Creates the panel contents now if this hadn't been done yet.
+
+        This is called automatically when the panel is shown for the first
+        time, but may also be called explicitly when the panel children must
+        exist, e.g. to transfer data to them before the panel was ever
+        shown. Calling it when the contents had already been created does
+        nothing.
+    */
+    void Realize();
+
+protected:
+    /**
+        Must be overridden to create the panel children.
+
+        This method is called at most once, just before the panel becomes
+        visible for the first time or from the first call to Realize().
+    */
+    virtual void CreateContent() = 0;
+};
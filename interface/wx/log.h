@@ -893,6 +893,171 @@ public:
 
 
 
+/**
+    @class wxLogRingBuffer
+
+    This log target stores the last @e N log records, with all their fields
+    (level, message, timestamp, component and so on, see wxLogRecord), in a
+    ring buffer of fixed size.
+
+    Unlike appending every message to a text control, storing a record is a
+    cheap constant time operation however long the program has been running,
+    so this target is suitable for an always-on in-application log console.
+    The stored records can be conveniently displayed by a wxListCtrl with the
+    @c wxLC_VIRTUAL style, whose overridden wxListCtrl::OnGetItemText()
+    retrieves the visible records with GetRecord(), so that only the records
+    currently shown on screen are ever formatted; override OnRecordAdded() to
+    refresh such a view when a new record arrives.
+
+    @library{wxbase}
+    @category{logging}
+
+    @since 3.1.7
+
+    @see wxLogBuffer
+*/
+class wxLogRingBuffer : public wxLog
+{
+public:
+    /**
+        Constructs the target storing up to @a maxRecords records.
+
+        Once the limit is reached, the oldest records are overwritten by the
+        newly arriving ones.
+    */
+    explicit wxLogRingBuffer(size_t maxRecords = 1000);
+
+    /**
+        Returns the number of records currently stored.
+
+        This can never exceed GetMaxRecords().
+    */
+    size_t GetCount() const;
+
+    /**
+        Returns the maximal number of records stored, as passed to the
+        constructor.
+    */
+    size_t GetMaxRecords() const;
+
+    /**
+        Returns the @a n-th stored record.
+
+        The records are ordered from the oldest record still stored to the
+        most recent one and @a n must be strictly less than GetCount().
+    */
+    const wxLogRecord& GetRecord(size_t n) const;
+
+    /**
+        Removes all the stored records.
+    */
+    void Clear();
+
+protected:
+    /**
+        Called after each record stored by this target.
+
+        This method does nothing by default and can be overridden to e.g.
+        refresh the window displaying the records.
+    */
+    virtual void OnRecordAdded();
+};
+
+
+
+/**
+    @class wxLogAsync
+
+    This log target forwards all the log records to another one, but does it
+    from a dedicated worker thread instead of doing it synchronously.
+
+    Normally formatting a log message and writing it out happens directly in
+    the thread calling wxLogError() or another logging function, while holding
+    an internal lock, so threads logging verbosely can end up serialized on
+    the log output. With wxLogAsync the producing threads only append the raw
+    record to an internal bounded queue and continue immediately; the worker
+    thread then passes the records, in order, to the wrapped target.
+
+    If the producers outrun the worker and the queue fills up, the behaviour
+    is determined by the overflow policy given to the constructor: by default
+    new records are discarded and a warning with the number of lost messages
+    is logged once there is space again, but wxLogAsync::Overflow_Wait can be
+    used to block the producers instead if losing messages is not acceptable.
+
+    Flush() blocks until everything queued so far has been written out, and
+    is called automatically when a @c wxLOG_FatalError record is logged, so
+    fatal messages are never lost even if the program terminates right after
+    logging them. The destructor also drains the queue before destroying the
+    wrapped target.
+
+    This class is only available if @c wxUSE_THREADS is 1.
+
+    @since 3.1.7
+
+    @library{wxbase}
+    @category{logging}
+
+    @see wxLogChain
+*/
+class wxLogAsync : public wxLog
+{
+public:
+    /**
+        The overflow policies used when the queue is full.
+    */
+    enum Overflow
+    {
+        /**
+            Discard the new records.
+
+            The number of discarded records is counted and a warning is
+            logged when space becomes available again.
+         */
+        Overflow_Drop,
+
+        /// Block the producing thread until the worker catches up.
+        Overflow_Wait
+    };
+
+    /**
+        Create the asynchronous target wrapping the given one.
+
+        The worker thread is started immediately.
+
+        @param target
+            The log target which the records are forwarded to, can't be @NULL.
+            wxLogAsync takes ownership of it and deletes it in its destructor.
+        @param capacity
+            The maximal number of records queued but not yet written out.
+        @param overflow
+            What to do when the queue is full, see Overflow.
+    */
+    explicit wxLogAsync(wxLog *target,
+                        size_t capacity = 16384,
+                        Overflow overflow = Overflow_Drop);
+
+    /**
+        Destructor writes out all still queued records, stops the worker
+        thread and destroys the wrapped target.
+    */
+    virtual ~wxLogAsync();
+
+    /**
+        Returns the wrapped log target, which is owned by this object.
+    */
+    wxLog *GetTarget() const;
+
+    /**
+        Wait until all the records queued so far have been passed to the
+        wrapped target and flush the latter.
+
+        This is called automatically whenever a fatal error is logged.
+    */
+    virtual void Flush();
+};
+
+
+
 /**
     @class wxLogNull
 
@@ -98,6 +98,28 @@ public:
     */
     virtual bool OnInit() = 0;
 
+    /**
+        Initializes the module of the given class right now if this hadn't
+        been done yet.
+
+        This only needs to be, and must be, called before using a subsystem
+        whose module declared itself as initialized on demand, see
+        InitializeOnDemand(). Modules not doing this are initialized during
+        the library startup as usual and calling this function for them
+        simply returns @true. Any dependencies of the module are initialized
+        before it, as during startup.
+
+        @param classInfo
+            The class information object of the wxModule-derived class.
+
+        @return @true if the module is initialized (possibly because it
+            already was), @false if its initialization failed or no module of
+            this class is registered.
+
+        @since 3.1.7
+    */
+    static bool EnsureInitialized(wxClassInfo* classInfo);
+
 protected:
 
     /**
@@ -126,5 +148,22 @@ protected:
             The class name of the dependent module.
     */
     void AddDependency(const char* classname);
+
+    /**
+        Call this function from the constructor of the derived class to make
+        the module initialized on demand.
+
+        Such a module is not initialized during the library startup: its
+        OnInit() is only called by the first call to EnsureInitialized() for
+        it, or when a module depending on it is initialized. This cuts the
+        startup time of the programs never using the corresponding subsystem,
+        but may only be used if all the code relying on the module can be
+        trusted to call EnsureInitialized() first.
+
+        @see EnsureInitialized()
+
+        @since 3.1.7
+    */
+    void InitializeOnDemand();
 };
 
@@ -26,7 +26,16 @@ enum wxMessageQueueError
     wxMSGQUEUE_TIMEOUT,
 
     /// Some unexpected (and fatal) error has occurred.
-    wxMSGQUEUE_MISC_ERROR
+    wxMSGQUEUE_MISC_ERROR,
+
+    /**
+        Indicates that there is no space left in a bounded queue.
+
+        This return value is only used by wxSpscQueue<>::Post().
+
+        @since 3.1.7
+     */
+    wxMSGQUEUE_FULL
 };
 
 /**
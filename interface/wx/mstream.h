@@ -134,3 +134,161 @@ public:
     wxStreamBuffer* GetInputStreamBuffer() const;
 };
 
+/**
+    Hints for wxMappedInputStream::Advise() describing the expected access
+    pattern for the mapped data.
+
+    @since 3.1.7
+*/
+enum wxMappedAccess
+{
+    /// No particular access pattern, undo the effect of previous hints.
+    wxMAPPED_ACCESS_NORMAL,
+
+    /// The data will be read once, sequentially from the start.
+    wxMAPPED_ACCESS_SEQUENTIAL,
+
+    /// The data will be accessed in random order.
+    wxMAPPED_ACCESS_RANDOM,
+
+    /// The data will be needed soon, so it is worth prefetching it.
+    wxMAPPED_ACCESS_WILLNEED
+};
+
+/**
+    @class wxMappedInputStream
+
+    A read-only stream on top of a memory-mapped file.
+
+    Unlike wxFileInputStream, this stream doesn't copy anything: the file
+    contents are mapped into the address space of the process and paged in
+    by the OS on demand, so even huge files can be opened without reading
+    them upfront. This also makes seeking in the stream free.
+
+    This class is only available on the platforms supporting file mapping,
+    i.e. MSW and Unix-like systems: the symbol @c wxHAS_MAPPED_INPUT_STREAM
+    is defined when it can be used.
+
+    Use IsOk() to verify that the file was successfully mapped after
+    creating an object of this class: mapping can fail if the file doesn't
+    exist, can't be read or is too big for the address space of the process
+    (e.g. a file larger than 2-3 GiB in 32 bit builds).
+
+    @library{wxbase}
+    @category{streams}
+
+    @since 3.1.7
+
+    @see wxMemoryInputStream, wxFileInputStream
+*/
+class wxMappedInputStream : public wxMemoryInputStream
+{
+public:
+    /**
+        Maps the given file into memory and creates a stream reading from
+        the mapping.
+
+        Use IsOk() to check whether the mapping succeeded.
+    */
+    wxMappedInputStream(const wxString& filename);
+
+    /**
+        Destructor. Unmaps the file.
+    */
+    virtual ~wxMappedInputStream();
+
+    /**
+        Returns a pointer directly into the mapped file contents.
+
+        This allows processing the file data without any copying at all.
+        The pointer remains valid for the lifetime of this stream and may
+        be @NULL for an empty file or if the stream is invalid.
+    */
+    const void* GetData() const;
+
+    /**
+        Returns the length of the mapped data in bytes.
+    */
+    size_t GetDataLen() const;
+
+    /**
+        Hints the OS about the expected access pattern for the mapped data.
+
+        Calling this function can make paging the data in noticeably more
+        efficient, e.g. ::wxMAPPED_ACCESS_SEQUENTIAL enables more aggressive
+        read-ahead while ::wxMAPPED_ACCESS_RANDOM disables it. This is only
+        a hint and does nothing at all on the platforms without an
+        equivalent of the POSIX @c madvise() function.
+    */
+    void Advise(wxMappedAccess access);
+};
+
+/**
+    @class wxMappedOutputStream
+
+    A stream writing into a memory-mapped file.
+
+    This stream (re)creates a file of the given, fixed, size and writes to
+    it directly through a memory mapping, without any intermediate buffers:
+    the OS writes the modified pages back to the file lazily. Writing past
+    the end of the preallocated size fails, so this class is only useful
+    when the final file size, or at least an upper bound for it, is known
+    in advance.
+
+    This class is only available on the platforms supporting file mapping,
+    i.e. MSW and Unix-like systems: the symbol @c wxHAS_MAPPED_INPUT_STREAM
+    is defined when it can be used.
+
+    Use IsOk() to verify that the file was successfully created and mapped
+    after creating an object of this class.
+
+    @library{wxbase}
+    @category{streams}
+
+    @since 3.1.7
+
+    @see wxMappedInputStream, wxFileOutputStream
+*/
+class wxMappedOutputStream : public wxMemoryOutputStream
+{
+public:
+    /**
+        Creates, or overwrites, the given file with the size @a len and
+        maps it into memory for writing.
+
+        Use IsOk() to check whether the file could be created and mapped.
+    */
+    wxMappedOutputStream(const wxString& filename, wxFileOffset len);
+
+    /**
+        Destructor. Unmaps the file.
+
+        Notice that the OS flushes the written data to the file on its own
+        schedule, use Flush() before destroying the stream if the data must
+        be on disk immediately.
+    */
+    virtual ~wxMappedOutputStream();
+
+    /**
+        Returns a pointer directly into the mapped file contents.
+
+        The file contents can also be modified directly through this
+        pointer, bypassing the stream API entirely. The pointer remains
+        valid for the lifetime of this stream and may be @NULL if the
+        stream is invalid.
+    */
+    void* GetData() const;
+
+    /**
+        Returns the length of the mapped data in bytes.
+    */
+    size_t GetDataLen() const;
+
+    /**
+        Synchronously flushes the data written so far to disk.
+
+        @return @true if the data was successfully written to disk.
+    */
+    bool Flush();
+};
+
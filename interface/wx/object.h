@@ -154,6 +154,16 @@ typedef wxRefCounter wxObjectRefData;
     wxObjectRefData is a typedef to wxRefCounter and is used as the
     built-in reference counted storage for wxObject-derived classes.
 
+    On all the common platforms the counter is updated using atomic
+    operations, which is indicated by the @c wxHAS_ATOMIC_REF_COUNT symbol
+    being defined after including @c wx/object.h: when it is, reference
+    counted objects, including the copy-on-write classes built on top of
+    them such as the GDI objects, may be safely passed between threads
+    without cloning, provided the shared instances themselves are not
+    modified concurrently. If the symbol is not defined, each thread must
+    use its own deep copy of the object, as in the previous versions of the
+    library.
+
     @library{wxbase}
     @category{rtti}
 
@@ -0,0 +1,131 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        opctx.h
+// Purpose:     interface of wxOperationContext
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+    @class wxOperationContext
+
+    Cooperative cancellation and progress reporting for long operations.
+
+    An object of this class can be passed to the functions supporting it,
+    currently wxInputStream::Read(wxOutputStream&, wxOperationContext&) and
+    wxDir::Traverse(), to allow interrupting them and monitoring their
+    progress: the operation periodically updates the progress counter and
+    checks for cancellation, so calling Cancel(), typically from another
+    thread, makes it return as soon as possible instead of running to
+    completion.
+
+    To be notified about the progress, derive from this class and override
+    OnProgress(). The notifications are throttled: however often the operation
+    itself advances the counter, OnProgress() is called at most once per
+    progress interval (100ms by default, see SetProgressInterval()). Note that
+    it is called from the thread running the operation, so use
+    wxEvtHandler::CallAfter() or an event if it needs to update the UI.
+
+    Example of extracting an archive entry in a worker thread while allowing
+    the user to cancel the extraction:
+
+    @code
+    // in the worker thread, with m_context a wxOperationContext accessible
+    // from the main thread too:
+    wxFFileOutputStream out(extractedName);
+    zipStream.Read(out, m_context);
+    if ( m_context.IsCancelled() )
+        wxRemoveFile(extractedName);
+
+    // in the main thread, when the user presses "Cancel":
+    m_context.Cancel();
+    @endcode
+
+    @since 3.1.7
+
+    @library{wxbase}
+    @category{threading}
+
+    @see wxDir::Traverse(), wxInputStream::Read()
+*/
+class wxOperationContext
+{
+public:
+    /**
+        Default constructor.
+
+        The context is created not cancelled, with zero progress and an
+        unknown total.
+    */
+    wxOperationContext();
+
+    /**
+        Ask the running operation to stop.
+
+        The operation will return, without finishing its work, as soon as it
+        checks the flag. This function can be called from any thread.
+    */
+    void Cancel();
+
+    /**
+        Return @true if Cancel() was called.
+    */
+    bool IsCancelled() const;
+
+    /**
+        Set the total amount of work if it is known in advance.
+
+        The units (bytes, files, ...) are defined by the operation. The
+        default value of 0 means that the total is unknown.
+    */
+    void SetProgressTotal(wxULongLong total);
+
+    /**
+        Return the total amount of work set by SetProgressTotal() or 0 if it
+        is unknown.
+    */
+    wxULongLong GetProgressTotal() const;
+
+    /**
+        Return the amount of work done so far.
+    */
+    wxULongLong GetProgressDone() const;
+
+    /**
+        Set the minimal interval, in milliseconds, between two OnProgress()
+        calls.
+
+        The default interval is 100ms. Setting it to 0 calls OnProgress()
+        every time the progress counter advances.
+    */
+    void SetProgressInterval(long milliseconds);
+
+    /**
+        Return the current progress notification interval.
+    */
+    long GetProgressInterval() const;
+
+    /**
+        Advance the progress counter, called by the operation itself.
+
+        This function is not meant to be called by the application code, but
+        by the implementation of a cancellable operation: it adds @a increment
+        units to the progress counter, possibly calls OnProgress() and returns
+        @true if the operation should continue or @false if it was cancelled.
+    */
+    bool AddProgress(wxULongLong increment = 1);
+
+protected:
+    /**
+        Called, not more often than the progress interval allows, when the
+        operation advances.
+
+        Override this function to be notified about the progress. It is
+        called from the thread running the operation.
+
+        @param done
+            The amount of work done so far.
+        @param total
+            The total amount of work as set by SetProgressTotal(), 0 if
+            unknown.
+    */
+    virtual void OnProgress(const wxULongLong& done, const wxULongLong& total);
+};
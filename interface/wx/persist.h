@@ -149,6 +149,47 @@ public:
      */
     bool Restore(void *obj);
 
+    /**
+        Start batching the saved values in memory.
+
+        Between this call and the matching EndSaveBatch() the values saved by
+        SaveValue() are only buffered in memory and are written to the config,
+        which is then flushed a single time, by the outermost EndSaveBatch()
+        only. This is much faster than performing one config write per value
+        when saving the state of many objects at once, e.g. when saving the
+        layout of an application with many windows on exit:
+        @code
+            wxPersistenceManager& pm = wxPersistenceManager::Get();
+            pm.BeginSaveBatch();
+            for ( size_t n = 0; n < frames.size(); n++ )
+                pm.SaveAndUnregister(frames[n]);
+            pm.EndSaveBatch();
+        @endcode
+
+        The values buffered by an active batch are still visible to
+        RestoreValue(), which checks the buffer before reading the config.
+
+        The calls to this function can be nested but each of them must be
+        matched by a call to EndSaveBatch().
+
+        @see EndSaveBatch()
+
+        @since 3.1.7
+     */
+    void BeginSaveBatch();
+
+    /**
+        End batching the saved values and write them out.
+
+        The outermost call to this function writes all the values buffered
+        since the matching BeginSaveBatch() to the config and flushes it once.
+
+        @see BeginSaveBatch()
+
+        @since 3.1.7
+     */
+    void EndSaveBatch();
+
     /// Combines both Save() and Unregister() calls.
     void SaveAndUnregister(void *obj);
 
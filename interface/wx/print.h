@@ -429,6 +429,29 @@ public:
         Sets the percentage preview zoom, and refreshes the preview canvas accordingly.
     */
     virtual void SetZoom(int percent);
+
+    /**
+        Sets the number of rendered pages kept by the preview, including the
+        currently shown one.
+
+        The pages adjacent to the current one are pre-rendered at idle time,
+        up to this limit, so that flipping through a long document doesn't
+        have to re-render each page when it is shown. The default value is 5,
+        i.e. the current page and up to two pages on either side of it;
+        passing 1 disables pre-rendering entirely.
+
+        @since 3.1.7
+    */
+    virtual void SetPageCacheSize(int count);
+
+    /**
+        Returns the number of rendered pages kept by the preview.
+
+        @see SetPageCacheSize()
+
+        @since 3.1.7
+    */
+    virtual int GetPageCacheSize() const;
 };
 
 
@@ -897,6 +920,47 @@ public:
     */
     virtual bool OnPrintPage(int pageNum) = 0;
 
+    /**
+        Enables banded printing using horizontal bands of the given height,
+        expressed in device pixels.
+
+        Printing a whole page in one go can require the backend to rasterize
+        it entirely at the printer resolution, which may need a very large
+        amount of memory at high DPI. When banded printing is enabled, the
+        framework calls OnPrintPage() once per band with the DC clipped to
+        the band, so that the backend only ever needs memory for a single
+        band.
+
+        OnPrintPage() must then be able to draw the same page several times:
+        this is normally the case as long as it doesn't update any state of
+        its own while drawing. It can also use GetBandRect() to skip drawing
+        anything entirely outside of the current band.
+
+        Pass 0 (the default value) to disable banded printing.
+
+        @since 3.1.7
+    */
+    void SetBandHeight(int height);
+
+    /**
+        Returns the band height set by SetBandHeight() or 0 if banded
+        printing is not enabled.
+
+        @since 3.1.7
+    */
+    int GetBandHeight() const;
+
+    /**
+        Returns the rectangle of the band currently being printed, in device
+        pixels.
+
+        This is only non-empty when called from OnPrintPage() during banded
+        printing, see SetBandHeight().
+
+        @since 3.1.7
+    */
+    wxRect GetBandRect() const;
+
     /**
         Set the device origin of the associated wxDC so that the current logical point
         becomes the new logical origin.
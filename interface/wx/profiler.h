@@ -0,0 +1,134 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        wx/profiler.h
+// Purpose:     interface of wxProfiler
+// Author:      wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+    A single zone recorded by wxProfiler.
+
+    @library{wxbase}
+    @category{misc}
+
+    @since 3.1.7
+*/
+struct wxProfilerZone
+{
+    /**
+        The name passed to wxPROFILE_ZONE().
+
+        It must be a string literal, or at least outlive the profiler, as
+        only the pointer is stored.
+    */
+    const char *name;
+
+    /// Start timestamp of the zone in microseconds since the epoch.
+    wxLongLong_t start;
+
+    /// End timestamp of the zone in microseconds since the epoch.
+    wxLongLong_t end;
+};
+
+/**
+    @class wxProfiler
+
+    A lightweight zone profiler.
+
+    This class collects the execution times of the scopes annotated with
+    wxPROFILE_ZONE() or wxPROFILE_FUNCTION() and dumps them in the JSON
+    format understood by the @c chrome://tracing viewer (and compatible
+    tools), making it possible to profile both wxWidgets internals and the
+    application code with the same tool:
+
+    @code
+    void MyFrame::OnRebuild(wxCommandEvent&)
+    {
+        wxPROFILE_ZONE("rebuild");
+
+        ... expensive code ...
+    }
+
+    // somewhere at startup
+    wxProfiler::Enable();
+
+    // and later, e.g. when the slowdown being investigated has happened
+    wxProfiler::DumpToFile("trace.json");
+    @endcode
+
+    Each thread records into its own fixed-size ring buffer, so recording a
+    zone doesn't take any locks and the oldest zones are silently discarded
+    when a buffer overflows. When the profiler is disabled, which is the
+    default, an annotated scope only costs a single flag check.
+
+    All functions of this class must be called from the main thread, only
+    recording the zones themselves is safe from any thread.
+
+    @library{wxbase}
+    @category{misc}
+
+    @see wxStopWatch, wxLogTrace()
+
+    @since 3.1.7
+*/
+class wxProfiler
+{
+public:
+    /**
+        Starts collecting zones.
+
+        @param zonesPerThread
+            The number of zones each thread can hold before its oldest zones
+            start being overwritten.
+    */
+    static void Enable(size_t zonesPerThread = 65536);
+
+    /**
+        Stops collecting zones.
+
+        The zones recorded so far are kept until Clear() is called and can
+        still be dumped with DumpToFile().
+    */
+    static void Disable();
+
+    /// Returns @true if zones are currently being collected.
+    static bool IsEnabled();
+
+    /**
+        Writes all the zones collected so far to the given file.
+
+        The output uses the JSON trace event format which can be loaded in
+        the @c chrome://tracing viewer.
+
+        @return @true on success or @false if the file couldn't be written.
+    */
+    static bool DumpToFile(const wxString& filename);
+
+    /// Discards all the zones collected so far.
+    static void Clear();
+};
+
+/**
+    Records the time spent between this point and the end of the enclosing
+    scope as a profiling zone with the given name.
+
+    The name must be a string literal and shouldn't contain any characters
+    which would have to be escaped in JSON, e.g. quotes or backslashes.
+
+    This expands to nothing more than a flag check when the profiler is
+    disabled.
+
+    @see wxProfiler
+
+    @since 3.1.7
+*/
+#define wxPROFILE_ZONE(name)
+
+/**
+    Same as wxPROFILE_ZONE() but uses the name of the current function.
+
+    @see wxProfiler
+
+    @since 3.1.7
+*/
+#define wxPROFILE_FUNCTION()
@@ -1310,6 +1310,13 @@ public:
     @event{EVT_PG_ITEM_EXPANDED(id, func)}
         Respond to @c wxEVT_PG_ITEM_EXPANDED event, generated when user expands
         a property or category.
+    @event{EVT_PG_ITEM_EXPANDING(id, func)}
+        Respond to @c wxEVT_PG_ITEM_EXPANDING event, generated before a
+        property or category is expanded. The handler may populate the
+        children of the property on demand, which allows large grids to be
+        created with empty collapsed categories and materialized only when
+        the user actually opens them, or call wxPropertyGridEvent::Veto() to
+        prevent the expansion. This event is available since wxWidgets 3.1.7.
     @event{EVT_PG_LABEL_EDIT_BEGIN(id, func)}
         Respond to @c wxEVT_PG_LABEL_EDIT_BEGIN event, generated when user is
         about to begin editing a property label. You can veto this event to
@@ -1456,6 +1463,7 @@ wxEventType wxEVT_PG_RIGHT_CLICK;
 wxEventType wxEVT_PG_PAGE_CHANGED;
 wxEventType wxEVT_PG_ITEM_COLLAPSED;
 wxEventType wxEVT_PG_ITEM_EXPANDED;
+wxEventType wxEVT_PG_ITEM_EXPANDING;
 wxEventType wxEVT_PG_DOUBLE_CLICK;
 wxEventType wxEVT_PG_LABEL_EDIT_BEGIN;
 wxEventType wxEVT_PG_LABEL_EDIT_ENDING;
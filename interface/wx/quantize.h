@@ -31,10 +31,17 @@ public:
         (@a in_rows contains @a w * 3 bytes per row, @a out_rows @a w bytes per row).
         Fills @a out_rows with indexes into palette (which is also stored into @a palette
         variable).
+
+        The colour histogram accumulation pass can be parallelized by passing
+        a @a numThreads value different from the default 1: 0 means to use as
+        many threads as there are CPUs in the system. The result is identical
+        whatever the number of threads used. This parameter is only available
+        since wxWidgets 3.1.7 and is ignored in builds without thread support.
     */
     static void DoQuantize(unsigned int w, unsigned int h,
                            unsigned char** in_rows, unsigned char** out_rows,
-                           unsigned char* palette, int desiredNoColours);
+                           unsigned char* palette, int desiredNoColours,
+                           int numThreads = 1);
 
     /**
         Reduce the colours in the source image and put the result into the destination image.
@@ -42,23 +49,31 @@ public:
 
         Specify an optional palette pointer to receive the resulting palette.
         This palette may be passed to ConvertImageToBitmap, for example.
+
+        See DoQuantize() for the meaning of @a numThreads, which is only
+        available since wxWidgets 3.1.7.
     */
     static bool Quantize(const wxImage& src, wxImage& dest,
                          wxPalette** pPalette, int desiredNoColours = 236,
                          unsigned char** eightBitData = 0,
                          int flags = wxQUANTIZE_INCLUDE_WINDOWS_COLOURS|
                                      wxQUANTIZE_FILL_DESTINATION_IMAGE|
-                                     wxQUANTIZE_RETURN_8BIT_DATA);
+                                     wxQUANTIZE_RETURN_8BIT_DATA,
+                         int numThreads = 1);
 
     /**
         This version sets a palette in the destination image so you don't
         have to manage it yourself.
+
+        See DoQuantize() for the meaning of @a numThreads, which is only
+        available since wxWidgets 3.1.7.
     */
     static bool Quantize(const wxImage& src, wxImage& dest,
                          int desiredNoColours = 236,
                          unsigned char** eightBitData = 0,
                          int flags = wxQUANTIZE_INCLUDE_WINDOWS_COLOURS|
                                      wxQUANTIZE_FILL_DESTINATION_IMAGE|
-                                     wxQUANTIZE_RETURN_8BIT_DATA);
+                                     wxQUANTIZE_RETURN_8BIT_DATA,
+                         int numThreads = 1);
 };
 
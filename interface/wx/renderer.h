@@ -149,6 +149,59 @@ enum wxHeaderSortIconType
 
 
 
+/**
+    @class wxCachedRendererNative
+
+    A renderer which caches the rendered parts as bitmaps.
+
+    This class forwards all wxRendererNative methods to the renderer given to
+    its constructor, but renders each part only once per (part, state, size,
+    DPI) combination and blits the cached bitmap afterwards instead of
+    re-invoking the theme engine. The cache is invalidated automatically
+    whenever a wxSysColourChangedEvent or wxDPIChangedEvent is generated, or
+    explicitly by calling InvalidateCache().
+
+    Currently the header button background, tree item button, combo box drop
+    button, check box, check mark, collapse button and radio button parts are
+    cached; all the other methods behave exactly as in the underlying
+    renderer. Header button labels and sort arrows are always drawn directly,
+    as they typically change from column to column.
+
+    Note that the parts which don't completely fill their rectangle are
+    composed on the background colour of the target window, so this renderer
+    should only be used to draw parts directly over the window background.
+    This is the case for wxHeaderCtrl and the wxGrid label windows, which use
+    the shared instance of this class returned by
+    wxRendererNative::GetCached() for their painting.
+
+    @library{wxcore}
+    @category{gdi}
+
+    @since 3.1.7
+
+    @see wxRendererNative::GetCached()
+*/
+class wxCachedRendererNative : public wxDelegateRendererNative
+{
+public:
+    /**
+        Constructs a caching proxy for the given renderer.
+
+        This object does not take ownership of (i.e. won't delete)
+        @a rendererNative.
+    */
+    explicit wxCachedRendererNative(wxRendererNative& rendererNative);
+
+    /**
+        Drop all cached part bitmaps.
+
+        This is done automatically when the system colours or the DPI change,
+        so calling this function explicitly should be rarely, if ever, needed.
+    */
+    void InvalidateCache();
+};
+
+
 /**
     @class wxDelegateRendererNative
 
@@ -561,6 +614,24 @@ public:
     */
     static wxRendererNative& GetDefault();
 
+    /**
+        Return a caching proxy for the currently used renderer.
+
+        The returned renderer forwards all calls to the renderer returned by
+        Get(), but renders each themed part only once per (part, state, size,
+        DPI) combination, blitting a cached bitmap on the subsequent calls.
+        This can speed up painting considerably when the same part is drawn
+        many times, e.g. for the column headers of a control with many
+        columns. See wxCachedRendererNative for the restrictions applying to
+        the use of the cached renderer.
+
+        If the active renderer is changed with Set(), the proxy returned by
+        the next call to this function delegates to the new renderer.
+
+        @since 3.1.7
+    */
+    static wxRendererNative& GetCached();
+
     /**
         Return the generic implementation of the renderer. Under some platforms, this
         is the default renderer implementation, others have platform-specific default
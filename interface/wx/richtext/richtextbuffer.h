@@ -2487,6 +2487,18 @@ public:
     */
     virtual void Dump(wxTextOutputStream& stream);
 
+    /**
+        Returns a rough estimate of the amount of memory used by this object
+        and its children, in bytes.
+
+        The estimate doesn't need to be accurate, only roughly proportional to
+        the actual memory use: it is used to keep the undo history within its
+        memory budget (see wxRichTextCommandProcessor).
+
+        @since 3.1.7
+    */
+    virtual size_t GetApproximateSize() const;
+
     /**
         Returns @true if we can edit the object's properties via a GUI.
     */
@@ -4944,6 +4956,24 @@ public:
     */
     wxCommandProcessor* GetCommandProcessor() const { return m_commandProcessor; }
 
+    /**
+        Sets the approximate maximum amount of memory that the undo history
+        may use, in bytes. Zero (the default) means no limit.
+
+        See wxRichTextCommandProcessor.
+
+        @since 3.1.7
+    */
+    void SetUndoMemoryBudget(size_t budget);
+
+    /**
+        Returns the undo history memory budget in bytes, or zero if the
+        history is unlimited.
+
+        @since 3.1.7
+    */
+    size_t GetUndoMemoryBudget() const;
+
     /**
         Sets style sheet, if any. This will allow the application to use named character and paragraph
         styles found in the style sheet.
@@ -6170,11 +6200,67 @@ public:
     */
     wxList& GetActions() { return m_actions; }
 
+    /**
+        Returns a rough estimate of the amount of memory used by this command,
+        in bytes.
+
+        @since 3.1.7
+    */
+    size_t GetApproximateSize() const;
+
 protected:
 
     wxList  m_actions;
 };
 
+/**
+    @class wxRichTextCommandProcessor
+
+    The command processor created by wxRichTextBuffer, extending
+    wxCommandProcessor with an optional memory budget for the undo history.
+
+    Since each command stores copies of the paragraphs it affects, the undo
+    history of a long editing session on a large document can grow very big.
+    When a budget is set with SetMemoryBudget(), the oldest commands are
+    dropped whenever a new command is stored so that the approximate amount of
+    memory used by the history stays within the budget. By default the budget
+    is zero, meaning that the history is unlimited.
+
+    @since 3.1.7
+
+    @library{wxrichtext}
+    @category{richtext}
+
+    @see wxRichTextCommand
+*/
+
+class wxRichTextCommandProcessor: public wxCommandProcessor
+{
+public:
+    wxRichTextCommandProcessor(int maxCommands = -1);
+
+    /**
+        Sets the approximate maximum amount of memory that the undo history
+        may use, in bytes. Zero (the default) means no limit.
+
+        Takes effect immediately, dropping the oldest commands if the history
+        is already over the new budget.
+    */
+    void SetMemoryBudget(size_t budget);
+
+    /**
+        Returns the undo history memory budget in bytes, or zero if the
+        history is unlimited.
+    */
+    size_t GetMemoryBudget() const;
+
+    /**
+        Returns a rough estimate of the amount of memory used by the stored
+        commands, in bytes.
+    */
+    size_t GetApproximateSize() const;
+};
+
 /**
     @class wxRichTextAction
 
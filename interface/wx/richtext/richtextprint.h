@@ -249,6 +249,18 @@ public:
         it should be managed by the calling code, such as wxRichTextPrinting.
     */
     void SetRichTextBuffer(wxRichTextBuffer* buffer);
+
+    /**
+        Invalidates the cached page break table, forcing the next call to
+        OnPreparePrinting() to relayout and repaginate the buffer.
+
+        This is normally not needed, since the table is invalidated
+        automatically when the buffer, margins, or header and footer data
+        change, and pagination is redone when the text area or scale change.
+
+        @since 3.1.7
+    */
+    void InvalidatePagination();
 };
 
 
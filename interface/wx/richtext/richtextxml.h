@@ -82,3 +82,43 @@ protected:
     virtual bool DoSaveFile(wxRichTextBuffer* buffer, wxOutputStream& stream);
 };
 
+
+/**
+    @class wxRichTextBinaryHandler
+
+    A handler for loading and saving content in a binary format specific
+    to wxRichTextBuffer.
+
+    The format is a binary serialization of the same element tree used by
+    wxRichTextXMLHandler, so it is exactly as lossless as the XML format,
+    but considerably faster to load and save for large documents.
+
+    The handler flags of wxRichTextXMLHandler apply to this handler too.
+
+    @since 3.1.7
+
+    @library{wxrichtext}
+    @category{richtext}
+*/
+class wxRichTextBinaryHandler : public wxRichTextXMLHandler
+{
+public:
+    /**
+        Constructor.
+    */
+    wxRichTextBinaryHandler(const wxString& name = "Binary",
+                            const wxString& ext = "rtb",
+                            int type = wxRICHTEXT_TYPE_BINARY);
+
+protected:
+
+    /**
+        Loads buffer context from the given stream.
+    */
+    virtual bool DoLoadFile(wxRichTextBuffer* buffer, wxInputStream& stream);
+
+    /**
+        Saves buffer context to the given stream.
+    */
+    virtual bool DoSaveFile(wxRichTextBuffer* buffer, wxOutputStream& stream);
+};
@@ -323,6 +323,73 @@ public:
     */
     void EnableScrolling(bool xScrolling, bool yScrolling);
 
+    /**
+        Enable reusing the still valid window contents when physical
+        scrolling is disabled.
+
+        When physical scrolling is disabled with EnableScrolling(), the whole
+        window is normally invalidated by every scroll operation, which can
+        make scrolling large windows with expensive paint handlers slow. If
+        pixel reuse is enabled, the part of the window contents remaining
+        visible after the scroll is blitted to its new position instead and
+        only the newly exposed strips are refreshed, each one with its own
+        clip rectangle, so the paint handler can redraw just the area that
+        really needs it.
+
+        Note that, exactly as with physical scrolling, this only gives
+        correct results if the window contents depends on the scroll position
+        via the device context origin only. Unlike physical scrolling,
+        however, reusing the pixels doesn't move any children of the window,
+        so it can be used when the positions of the children are managed
+        independently.
+
+        This mode has no effect in the directions in which physical
+        scrolling, which already reuses the window contents, is enabled.
+
+        @param enable
+            If @true, reuse the overlapping window contents when scrolling
+            with physical scrolling disabled.
+
+        @see GetPixelReuseStats()
+
+        @since 3.1.7
+    */
+    void EnablePixelReuse(bool enable = true);
+
+    /**
+        Returns @true if pixel reuse mode is enabled.
+
+        @see EnablePixelReuse()
+
+        @since 3.1.7
+    */
+    bool IsPixelReuseEnabled() const;
+
+    /**
+        Returns the statistics about the scrolls done in pixel reuse mode.
+
+        The returned wxScrollPixelReuseStats structure contains the number of
+        scroll operations performed in pixel reuse mode in its @c scrolls
+        field and the total numbers of pixels reused by blitting them and of
+        pixels which had to be redrawn in its @c pixelsBlitted and
+        @c pixelsRedrawn fields respectively, allowing to verify how much
+        repainting is really saved by enabling this mode. Scrolls falling
+        back to a full refresh because nothing could be reused, e.g. after
+        scrolling by more than a whole window, are counted too.
+
+        @see EnablePixelReuse(), ResetPixelReuseStats()
+
+        @since 3.1.7
+    */
+    const wxScrollPixelReuseStats& GetPixelReuseStats() const;
+
+    /**
+        Reset all the counters returned by GetPixelReuseStats() to zero.
+
+        @since 3.1.7
+    */
+    void ResetPixelReuseStats();
+
     /**
         Set the scrollbar visibility.
 
@@ -335,6 +335,11 @@ public:
 
         @return
             The returned colour is always valid.
+
+        @note Since wxWidgets 3.1.7 the returned values are cached, as
+            querying the native theme engine can be slow on some platforms,
+            and the cache is flushed whenever the system colours change, so
+            calling this function from drawing code is cheap.
     */
     static wxColour GetColour(wxSystemColour index);
 
@@ -367,9 +372,26 @@ public:
         better values if given one. If a window does not make sense for a metric,
         one should still be given, as for example it might determine which displays
         cursor width is requested with wxSYS_CURSOR_X.
+
+        @note Since wxWidgets 3.1.7 the global values, i.e. those queried
+            with @a win equal to @NULL, are cached and the cache is flushed
+            whenever the display or DPI changes; the window-specific queries
+            always go to the system.
     */
     static int GetMetric(wxSystemMetric index, wxWindow* win = NULL);
 
+    /**
+        Flushes the values cached by GetColour(), GetFont() and GetMetric().
+
+        This is done automatically whenever a wxSysColourChangedEvent,
+        wxDisplayChangedEvent or wxDPIChangedEvent is generated, i.e. when
+        the system settings change, so calling this function directly is
+        normally unnecessary.
+
+        @since 3.1.7
+    */
+    static void InvalidateCache();
+
     /**
         Returns the screen type.
         The return value is one of the ::wxSystemScreenType enum values.
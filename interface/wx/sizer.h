@@ -745,6 +745,43 @@ public:
     */
     virtual void RepositionChildren(const wxSize& minSize) = 0;
 
+    /**
+        Updates the sizer to manage exactly the given windows, in the given
+        order, changing as little as possible.
+
+        This method provides a cheap alternative to destroying and recreating
+        the contents of a dynamically updated panel: instead of clearing the
+        sizer and re-adding everything, describe the desired contents as a
+        list of windows and let the sizer apply just the differences.
+
+        The windows already managed by the sizer keep their items, and hence
+        the flags, proportion and border stored in them, and are only moved
+        if their relative order changed. The managed windows which do not
+        appear in @a windows are detached, and also destroyed if
+        @a delete_windows is @true. The windows not yet managed by the sizer
+        are inserted at their positions in the list using @a flags. Spacers
+        and child sizers are not touched at all.
+
+        This method does not cause any layout to take place, call Layout()
+        once after applying all the changes.
+
+        @param windows
+            The windows the sizer should manage, in the required order. No
+            window may appear in the list more than once.
+        @param flags
+            The flags to use for the newly inserted windows.
+        @param delete_windows
+            If @true, the windows removed from the sizer are destroyed too.
+
+        @return @true if anything was changed, @false if the sizer already
+            matched the given list.
+
+        @since 3.1.7
+    */
+    bool ReconcileWindows(const wxVector<wxWindow*>& windows,
+                          const wxSizerFlags& flags = wxSizerFlags(),
+                          bool delete_windows = false);
+
     /**
         Removes a child window from the sizer, but does @b not destroy it
         (because windows are owned by their parent window, not the sizer).
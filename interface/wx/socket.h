@@ -372,6 +372,42 @@ public:
     bool Connect(const wxSockAddress& address, const wxSockAddress& local,
                  bool wait = true);
 
+    /**
+        Resolve the given host name without blocking and then connect to it.
+
+        Unlike with Connect(), which requires an already resolved
+        wxSockAddress and where filling the address with
+        wxIPaddress::Hostname() can block the calling thread for several
+        seconds waiting for a slow DNS server, this function performs the name
+        resolution in a background thread and then starts a non-blocking
+        connection attempt, so it never blocks the GUI.
+
+        Catch @b wxSOCKET_CONNECTION events to be notified of the successful
+        connection establishment and @b wxSOCKET_LOST events signalling that
+        either resolving @a host or connecting to it failed.
+
+        Successful lookups are stored in the process-wide cache, see
+        wxSockAddress::SetNameLookupCacheTTL(), so that subsequent connections
+        to the same host don't need to resolve its name again.
+
+        This function is only available if @c wxUSE_THREADS is 1, requires a
+        running event loop and may only be called from the main thread.
+
+        @param host
+            The name, or the address in dotted quad notation, of the server.
+        @param port
+            The port to connect to.
+
+        @return @true if the name resolution was started, @false if it
+                couldn't even begin, e.g. because the worker thread couldn't
+                be created.
+
+        @see Connect(), wxSocketBase::SetNotify(), wxSocketBase::Notify()
+
+        @since 3.1.7
+    */
+    bool ConnectAsync(const wxString& host, unsigned short port);
+
     /**
         Wait until a connection request completes, or until the specified timeout
         elapses. Use this function after issuing a call to Connect() with
@@ -462,6 +498,43 @@ public:
             address.
     */
     int GetAddressDataLen() const;
+
+    /**
+        Set for how long the host name lookup results are cached.
+
+        Successful host name lookups done by wxIPaddress::Hostname() are
+        stored in a process-wide cache to avoid repeatedly blocking on the
+        resolver for the same name: by default, the entries stay valid for 60
+        seconds. Note that the system resolver functions don't provide access
+        to the TTL values of the DNS records, so this single TTL is used for
+        all the entries.
+
+        @param seconds
+            The time, in seconds, during which a cached lookup result is
+            reused. Pass 0 to disable caching entirely.
+
+        @since 3.1.7
+    */
+    static void SetNameLookupCacheTTL(int seconds);
+
+    /**
+        Return the TTL of the host name lookup cache entries, in seconds.
+
+        @see SetNameLookupCacheTTL()
+
+        @since 3.1.7
+    */
+    static int GetNameLookupCacheTTL();
+
+    /**
+        Forget all the previously cached host name lookup results.
+
+        This can be used to force re-resolving names known to have changed,
+        e.g. after a network configuration change.
+
+        @since 3.1.7
+    */
+    static void ClearNameLookupCache();
 };
 
 
@@ -702,6 +775,28 @@ enum
 };
 
 
+/**
+    Describes one buffer used by the scatter/gather IO functions
+    wxSocketBase::ReadV() and wxSocketBase::WriteV().
+
+    This struct plays the same role as the standard @c iovec one: @c buf
+    points to the memory to read the data into or to the data to be written
+    and @c len is its size in bytes.
+
+    @library{wxnet}
+    @category{net}
+
+    @since 3.1.7
+
+    @see wxSocketBase::ReadV(), wxSocketBase::WriteV()
+*/
+struct wxSocketIOVec
+{
+    void* buf;      ///< Pointer to the buffer.
+    wxUint32 len;   ///< Size of the buffer in bytes.
+};
+
+
 /**
     @class wxSocketBase
 
@@ -1092,6 +1187,38 @@ public:
     */
     wxSocketBase& ReadMsg(void* buffer, wxUint32 nbytes);
 
+    /**
+        Read data from the socket into several buffers at once (scatter read).
+
+        This function is the scatter/gather counterpart of Read(): the data is
+        read into the given buffers in order, using a single @c readv() (or
+        @c WSARecv() under MSW) system call where possible instead of one call
+        per buffer, and without copying the data through any intermediate
+        buffer. Data previously returned to the socket with Unread() is
+        consumed first, exactly as with Read().
+
+        Use LastReadCount() to verify the total number of bytes actually read.
+
+        Use Error() to determine if the operation succeeded.
+
+        @param buffers
+            Array of buffer descriptors to read the data into.
+        @param count
+            Number of elements in the @a buffers array.
+
+        @return Returns a reference to the current object.
+
+        @remarks
+            The exact behaviour of ReadV() depends on the combination of
+            flags being used, in the same way as for Read().
+            For a detailed explanation, see SetFlags().
+
+        @since 3.1.7
+
+        @see Error(), LastError(), LastReadCount(), SetFlags(), WriteV()
+    */
+    wxSocketBase& ReadV(const wxSocketIOVec* buffers, size_t count);
+
     /**
         Use SetFlags to customize IO operation for this socket.
 
@@ -1331,6 +1458,41 @@ public:
     */
     wxSocketBase& WriteMsg(const void* buffer, wxUint32 nbytes);
 
+    /**
+        Write data to the socket from several buffers at once (gather write).
+
+        This function is the scatter/gather counterpart of Write(): the
+        contents of all the given buffers is sent in order using a single
+        @c writev() (or @c WSASend() under MSW) system call where possible, so
+        a message composed of several parts, e.g. a fixed header and a
+        payload, can be sent without first coalescing the parts into a
+        temporary buffer.
+
+        For datagram sockets all the buffers always form a single datagram.
+
+        Use LastWriteCount() to verify the total number of bytes actually
+        written.
+
+        Use Error() to determine if the operation succeeded.
+
+        @param buffers
+            Array of buffer descriptors with the data to be sent.
+        @param count
+            Number of elements in the @a buffers array.
+
+        @return Returns a reference to the current object.
+
+        @remarks
+            The exact behaviour of WriteV() depends on the combination of
+            flags being used, in the same way as for Write().
+            For a detailed explanation, see SetFlags().
+
+        @since 3.1.7
+
+        @see Error(), LastError(), LastWriteCount(), SetFlags(), ReadV()
+    */
+    wxSocketBase& WriteV(const wxSocketIOVec* buffers, size_t count);
+
     //@}
 
 
@@ -0,0 +1,97 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        wx/spscqueue.h
+// Purpose:     interface of wxSpscQueue<T>
+// Author:      wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+    wxSpscQueue is a bounded lock-free variant of wxMessageQueue.
+
+    This queue passes messages from exactly one producer thread to exactly
+    one consumer thread using a fixed size ring buffer updated with atomic
+    operations only. Unlike wxMessageQueue, Post() never blocks nor takes
+    any lock: if the consumer didn't keep up and the buffer is full, it
+    simply fails with ::wxMSGQUEUE_FULL. This makes it suitable for use from
+    latency-sensitive producers, such as audio processing callbacks, where
+    blocking on a mutex possibly held by a lower priority thread is not an
+    option.
+
+    The consumer side uses the same Receive() and ReceiveTimeout() API as
+    wxMessageQueue and blocks on a semaphore when the queue is empty.
+
+    This class requires compiler support for C++11 atomic operations and is
+    only defined if this support is available, which is indicated by the
+    @c wxHAS_SPSC_QUEUE symbol being defined after including this header. It
+    is also only available if @c wxUSE_THREADS is 1.
+
+    @tparam T
+        The type of the messages stored in the queue, must have a default
+        constructor and be assignable.
+
+    @since 3.1.7
+
+    @nolibrary
+    @category{threading}
+
+    @see wxMessageQueue
+*/
+template <typename T>
+class wxSpscQueue<T>
+{
+public:
+    /**
+        Create a queue able to hold the given number of messages.
+
+        The capacity is rounded up to the next power of 2, use GetCapacity()
+        to retrieve the effective value.
+
+        Use IsOk() to check if the object was successfully initialized.
+    */
+    explicit wxSpscQueue(size_t capacity);
+
+    /**
+        Returns @true if the object had been initialized successfully, @false
+        if an error occurred.
+    */
+    bool IsOk() const;
+
+    /**
+        Add a message to the queue without ever blocking.
+
+        This is the only method which may be called from the producer thread.
+
+        @return ::wxMSGQUEUE_NO_ERROR if the message was queued or
+            ::wxMSGQUEUE_FULL if there was no space left in the buffer.
+    */
+    wxMessageQueueError Post(const T& msg);
+
+    /**
+        Block until a message becomes available in the queue.
+
+        This method, as all the other methods except Post(), must be called
+        from the consumer thread only.
+    */
+    wxMessageQueueError Receive(T& msg);
+
+    /**
+        Same as Receive(), but waits at most the given number of
+        milliseconds.
+
+        @return ::wxMSGQUEUE_NO_ERROR if a message was received or
+            ::wxMSGQUEUE_TIMEOUT if none arrived in time.
+    */
+    wxMessageQueueError ReceiveTimeout(long timeout, T& msg);
+
+    /**
+        Discard all the messages currently in the queue.
+
+        As with Receive(), this may only be called from the consumer thread.
+    */
+    wxMessageQueueError Clear();
+
+    /**
+        Returns the number of messages the queue can hold.
+    */
+    size_t GetCapacity() const;
+};
@@ -7202,6 +7202,27 @@ public:
     */
     int GetCurrentLine();
 
+    /**
+       Sets the time budget, in seconds, spent styling the text during one
+       idle event when idle styling is enabled with SetIdleStyling().
+
+       The value is clamped to the range between 0.001 and 1. The default
+       budget is 0.02 seconds (a quarter of that while scrolling).
+
+       @since 3.1.7
+    */
+    void SetIdleStylingBudget(double seconds);
+
+    /**
+       Returns the time budget, in seconds, spent styling the text during one
+       idle event.
+
+       @see SetIdleStylingBudget()
+
+       @since 3.1.7
+    */
+    double GetIdleStylingBudget() const;
+
     /**
        Extract style settings from a spec-string which is composed of one or
        more of the following comma separated elements:
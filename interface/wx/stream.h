@@ -249,6 +249,49 @@ public:
     */
     ~wxStreamBuffer();
 
+    /**
+        Toggles the adaptive flag.
+
+        When enabled on a read buffer allocated by the stream buffer itself,
+        the buffer is automatically grown (up to 256KiB) while it keeps being
+        exhausted by sequential reads, reducing the number of calls made to
+        the underlying stream. Seeking on the stream resets the growth
+        heuristics (but not the buffer size).
+
+        This mode is enabled by default for the buffer created by
+        wxBufferedInputStream when no buffer and no explicit buffer size is
+        given to its constructor.
+
+        @since 3.1.7
+    */
+    void Adaptive(bool adaptive);
+
+    /**
+        Enables reading ahead from the underlying stream on a worker thread.
+
+        When enabled, every time the buffer is refilled, the next block is
+        immediately requested from the underlying stream on a helper thread,
+        so that it is typically already available by the time it is needed and
+        sequential reads don't wait for the underlying stream. Seeking works
+        as usual, any data read in advance is discarded then.
+
+        Notice that the read ahead thread reads from the underlying stream
+        concurrently with the code using this buffer, so the underlying stream
+        must not be used directly while the read ahead is active.
+
+        @param enable
+            Enable or disable reading ahead. Disabling it stops the worker
+            thread and repositions the underlying stream as if the data read
+            in advance had never been read.
+        @return
+            @true if reading ahead is now enabled (or was successfully
+            disabled), @false if it couldn't be done, e.g. because this is not
+            a read buffer with its own memory or in wxUSE_THREADS==0 build.
+
+        @since 3.1.7
+    */
+    bool EnableReadAhead(bool enable = true);
+
     /**
         Fill the IO buffer.
     */
@@ -642,6 +685,28 @@ public:
     */
     wxInputStream& Read(wxOutputStream& stream_out);
 
+    /**
+        Reads data from the input queue and stores it in the specified output
+        stream, allowing to interrupt the copy.
+
+        This overload behaves as the one above, but additionally checks the
+        given context after each block of data: if
+        wxOperationContext::Cancel() was called, possibly from another
+        thread, the copy stops as soon as possible instead of continuing
+        until the end of the stream. The progress of the copy, in bytes, is
+        also reported through the context.
+
+        This allows e.g. cancelling the extraction of a huge entry of a
+        wxZipInputStream or wxTarInputStream immediately instead of waiting
+        for it to finish.
+
+        @return This function returns a reference on the current object, so the
+                user can test any states of the stream right away.
+
+        @since 3.1.7
+    */
+    wxInputStream& Read(wxOutputStream& stream_out, wxOperationContext& context);
+
     /**
         Reads exactly the specified number of bytes into the buffer.
 
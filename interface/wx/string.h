@@ -1164,6 +1164,19 @@ public:
     */
     int Find(const wxString& sub) const;
 
+    /**
+        Searches for the given string @a sub without regard to case.
+        Returns the starting position or @c wxNOT_FOUND if not found.
+
+        This function is much faster than using Lower() or MakeLower() on
+        both strings before calling Find() as it avoids creating any
+        temporary strings and uses an optimized code path if both strings
+        only contain ASCII characters.
+
+        @since 3.1.7
+    */
+    int FindNoCase(const wxString& sub) const;
+
     /**
         Same as Find().
 
@@ -1446,6 +1459,11 @@ public:
         This can be useful after a call to Alloc() if too much memory were
         preallocated.
 
+        Since wxWidgets 3.1.7 this function also frees the internal buffers
+        used to cache the results of conversions to other encodings (e.g. by
+        mb_str() or wc_str()) and doesn't reallocate the string buffer at all
+        if it doesn't have any unused capacity.
+
         @return Always returns @true
     */
     bool Shrink();
@@ -2064,6 +2082,89 @@ public:
     wxStringCharType* operator wxStringCharType *();
 };
 
+/**
+    @class wxStringInterner
+
+    A table of canonical string instances used to deduplicate equal strings.
+
+    This class is useful when a program stores a very large number of strings
+    taking only relatively few distinct values, e.g. labels or country names
+    repeated in millions of data rows. Calling Intern() returns a reference to
+    the canonical instance equal to the function argument, so all the callers
+    end up using the same string object:
+
+    @code
+        row.country = wxStringInterner::GetDefault().Intern(countryFromDB);
+    @endcode
+
+    When wxString is implemented using reference counting (i.e. when
+    @c wxUSE_STD_STRING is 0), copies of the canonical instance share a single
+    character buffer, reducing memory consumption proportionally to the number
+    of duplicates. In the default build using @c std::string internally,
+    copying still allocates, but interned strings can be compared cheaply as
+    strings sharing their buffer are recognized as equal by wxString::Cmp(),
+    wxString::CmpNoCase() and the comparison operators without looking at the
+    characters.
+
+    All methods of this class are MT-safe and the same interner may be used
+    concurrently from multiple threads.
+
+    @since 3.1.7
+
+    @library{wxbase}
+    @category{data}
+
+    @see wxString
+*/
+class wxStringInterner
+{
+public:
+    /**
+        Default constructor creates an empty table.
+
+        Note that typically the global instance returned by GetDefault() is
+        used instead of creating a new object of this class.
+    */
+    wxStringInterner();
+
+    /**
+        Destructor frees all the interned strings.
+
+        Any references previously returned by Intern() can't be used any
+        longer after destroying this object.
+    */
+    ~wxStringInterner();
+
+    /**
+        Returns the canonical instance equal to the given string.
+
+        The string is added to the table if it's not already present in it.
+
+        The returned reference remains valid for the lifetime of this object
+        or until Clear() is called.
+    */
+    const wxString& Intern(const wxString& s);
+
+    /**
+        Returns the number of distinct strings in the table.
+    */
+    size_t GetCount() const;
+
+    /**
+        Forgets all the interned strings.
+
+        This invalidates all the references previously returned by Intern().
+    */
+    void Clear();
+
+    /**
+        Returns the global interner object, creating it on first use.
+
+        The global object is destroyed during the library shutdown.
+    */
+    static wxStringInterner& GetDefault();
+};
+
 
 /** @addtogroup group_funcmacro_string */
 //@{
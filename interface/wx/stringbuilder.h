@@ -0,0 +1,149 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        wx/stringbuilder.h
+// Purpose:     interface of wxStringBuilder
+// Author:      wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+    wxStringBuilder efficiently builds a long string from many small pieces.
+
+    Appending to a wxString periodically reallocates its buffer and copies
+    all the data accumulated so far into it, which makes building very long
+    strings, e.g. big file exports, from many small appends unnecessarily
+    slow. This class instead stores the appended data in a list of chunks of
+    exponentially increasing size, so already appended data is never copied
+    and building a string of total length @c N performs only <em>O(log N)</em>
+    allocations. The complete string is assembled exactly once, by
+    GetString(), or the individual chunks can be retrieved one by one with
+    GetChunkData() in order to consume the data, e.g. write it out to a
+    stream, without ever concatenating it at all:
+
+    @code
+    wxStringBuilder sb;
+    for ( size_t row = 0; row < table.GetRowCount(); row++ )
+        sb << table.GetLabel(row) << ';' << table.GetValue(row) << '\n';
+
+    SaveTextToFile(sb.GetString());
+    @endcode
+
+    The data is stored in the native wxString representation, so appending a
+    wxString or a wide character literal doesn't convert anything in the
+    default wide character builds. Integers appended with the stream-like
+    operators are converted to text directly, without going through
+    wxString::Format(), and don't allocate any memory at all. The numeric
+    operators use the same formats as their wxString counterparts, i.e.
+    produce identical output.
+
+    This class is not a string: it doesn't support searching, iteration nor
+    modification of anything except its end, it can only accumulate data and
+    hand it back.
+
+    @since 3.1.7
+
+    @nolibrary
+    @category{data}
+
+    @see wxString
+*/
+class wxStringBuilder
+{
+public:
+    /**
+        Constructs an empty builder.
+
+        @param sizeHint
+            The size of the first allocated chunk, in characters. The default
+            is reasonable for most uses, but passing an estimate of the final
+            length can reduce the number of allocations further.
+    */
+    explicit wxStringBuilder(size_t sizeHint = 1024);
+
+    /**
+        Destructor frees all the accumulated data.
+
+        Note that the chunk pointers returned by GetChunkData() become
+        invalid when the builder is destroyed or Clear()ed.
+    */
+    ~wxStringBuilder();
+
+    /**
+        Delete all the data appended so far.
+    */
+    void Clear();
+
+    /**
+        Append a string.
+
+        Narrow strings are converted using the current locale encoding,
+        exactly as the corresponding wxString operations do, while wide
+        strings are appended without any conversion in wide character builds.
+    */
+    wxStringBuilder& Append(const wxString& str);
+
+    /**
+        Append a single character.
+    */
+    wxStringBuilder& Append(wxUniChar ch);
+
+    /**
+        Stream-like operators appending strings, characters and numbers.
+
+        These operators mirror the wxString ones and produce exactly the same
+        output, but the integer overloads convert the value to text directly,
+        without using printf-like formatting, and don't allocate memory.
+    */
+    wxStringBuilder& operator<<(const wxString& str);
+
+    /**
+        Returns the total length of the data appended so far.
+
+        The length is expressed in code units of the native string
+        representation, i.e. it is the same as the length of the string that
+        GetString() would return in wide character builds.
+    */
+    size_t GetLength() const;
+
+    /**
+        Returns @true if nothing has been appended yet.
+    */
+    bool IsEmpty() const;
+
+    /**
+        Assemble and return the complete string.
+
+        This is the only place where the accumulated data is copied, exactly
+        once, into a string buffer of exactly the right size. The builder
+        contents are not modified, so this function can be called more than
+        once.
+    */
+    wxString GetString() const;
+
+    /**
+        Returns the number of storage chunks used.
+
+        @see GetChunkData()
+    */
+    size_t GetChunkCount() const;
+
+    /**
+        Returns a pointer to the data of the given chunk.
+
+        Together with GetChunkLength(), this allows consuming the accumulated
+        data chunk by chunk without building the full string. Note that the
+        chunk data is not NUL-terminated and that, in UTF-8 builds, chunk
+        boundaries may fall in the middle of a multibyte sequence, so the
+        chunks are generally not valid strings on their own.
+
+        @param n
+            The chunk index, must be less than GetChunkCount().
+    */
+    const wxStringCharType* GetChunkData(size_t n) const;
+
+    /**
+        Returns the length of the given chunk, in code units.
+
+        @see GetChunkData()
+    */
+    size_t GetChunkLength(size_t n) const;
+};
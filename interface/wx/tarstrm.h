@@ -91,6 +91,70 @@ public:
         seekable stream.
     */
     bool OpenEntry(wxTarEntry& entry);
+
+    /**
+        Closes the current entry if one is open, then opens the entry with
+        the given name from the index.
+
+        An index must have been created with BuildIndex() or loaded with
+        LoadIndex() first.
+
+        @since 3.1.7
+    */
+    bool OpenEntry(const wxString& name);
+
+    /**
+        Scans all the remaining headers in the tar and builds an index
+        mapping entry names to their positions, so that entries can then be
+        opened directly with OpenEntry() in any order.
+
+        The entry data is skipped over using seeks, so even for a huge
+        archive only the header blocks are read. The tar must be on a
+        seekable stream.
+
+        Returns @true if the whole archive was scanned successfully.
+
+        @since 3.1.7
+    */
+    bool BuildIndex();
+
+    /**
+        Returns @true if an index has been built or loaded.
+
+        @since 3.1.7
+    */
+    bool HasIndex() const;
+
+    /**
+        Looks up an entry in the index by name.
+
+        Returns @NULL if there is no such entry. Unlike GetNextEntry() the
+        returned object remains owned by the stream, and should not be
+        deleted by the caller.
+
+        @since 3.1.7
+    */
+    wxTarEntry* FindEntry(const wxString& name) const;
+
+    /**
+        Saves the index, e.g. to a file stored alongside the archive, so
+        that on repeat access it can be reloaded with LoadIndex() instead
+        of rescanning the headers.
+
+        @since 3.1.7
+    */
+    bool SaveIndex(wxOutputStream& stream) const;
+
+    /**
+        Loads an index previously written with SaveIndex().
+
+        The loaded entries contain only the name, size and type of each
+        entry, which is sufficient for OpenEntry(); the remaining metadata
+        is available after a full BuildIndex() scan or from GetNextEntry().
+
+        @since 3.1.7
+    */
+    bool LoadIndex(wxInputStream& stream);
 };
 
 
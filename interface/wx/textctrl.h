@@ -1396,6 +1396,51 @@ public:
     */
     virtual void EmptyUndoBuffer();
 
+    /**
+        Enable or disable coalescing of AppendText() calls.
+
+        When coalescing is enabled, AppendText() doesn't modify the control
+        immediately any more: the appended text is buffered and all of it is
+        inserted at once, with a single refresh and scroll, during the next
+        event loop iteration. This is much faster when many lines are appended
+        in a row, as typically happens when the control shows the output of a
+        build or another quickly updated log.
+
+        If @a maxLines is non-zero, it also limits the total number of lines
+        kept in the control: the oldest lines are discarded during each flush,
+        providing a cheap scrollback limit.
+
+        Note that the buffered text is not taken into account by the other
+        methods, e.g. GetValue() or GetNumberOfLines(), until it is actually
+        inserted, use FlushAppendedText() before calling them if this matters.
+        Disabling coalescing flushes any still buffered text, too.
+
+        @since 3.1.7
+    */
+    void EnableAppendCoalescing(bool enable = true, unsigned long maxLines = 0);
+
+    /**
+        Returns @true if coalescing of AppendText() calls is enabled.
+
+        @see EnableAppendCoalescing()
+
+        @since 3.1.7
+    */
+    bool IsAppendCoalescing() const;
+
+    /**
+        Insert any text buffered by EnableAppendCoalescing() into the control
+        immediately.
+
+        This is normally unnecessary as the buffered text is automatically
+        flushed during the next event loop iteration, but can be used before
+        examining the control contents, e.g. with GetValue(), from the same
+        event handler that appended the text.
+
+        @since 3.1.7
+    */
+    void FlushAppendedText();
+
     /**
         This function inserts into the control the character which would have
         been inserted if the given key event had occurred in the text control.
@@ -270,6 +270,36 @@ public:
     */
     bool Open(const wxString& strFile, const wxMBConv& conv = wxConvAuto());
 
+    /**
+        As Open(), but maps the file into memory instead of loading it.
+
+        In this mode the file contents are not read and converted at once:
+        only an index of the line offsets is built, on first access, and
+        GetLine() converts the requested line on demand, so opening even a
+        multi-gigabyte file is cheap and the memory used stays proportional
+        to the number of lines, not to the file size.
+
+        The price is that the file becomes read-only: the references returned
+        by GetLine() point into a small internal cache of recently accessed
+        lines and any modifications made through them are discarded. Use
+        Open() if the file needs to be modified.
+
+        Mapping requires an ASCII-compatible @a conv (e.g. UTF-8 or any
+        single byte encoding): if the file starts with an UTF-16 or UTF-32
+        BOM, or if the platform doesn't support memory mapped files, this
+        function transparently falls back to loading the file as Open() does.
+
+        @since 3.1.7
+    */
+    bool OpenMapped(const wxMBConv& conv = wxConvAuto());
+
+    /**
+        As OpenMapped(), but takes the name of the file to open.
+
+        @since 3.1.7
+    */
+    bool OpenMapped(const wxString& strFile, const wxMBConv& conv = wxConvAuto());
+
     /**
         Delete line number @a n from the file.
     */
@@ -1250,6 +1250,30 @@ public:
     */
     wxThreadError Run();
 
+    /**
+        Binds the thread to the given set of logical CPUs.
+
+        After a successful call to this function the thread will only be
+        scheduled to run on the CPUs whose indices, in the range from 0 to
+        GetCPUCount() - 1 inclusive, are contained in @a cpus, which must not
+        be empty. This can be used to keep the worker threads close to the
+        data they operate on, e.g. on the same NUMA node, see wxCpuTopology.
+
+        The thread must have been created, i.e. Create() must have been
+        called, before calling this function.
+
+        @param cpus
+            The non-empty array of the indices of the CPUs to bind this
+            thread to.
+        @return @true on success or @false otherwise (for example, if this
+            function is not implemented for this platform: currently it is
+            only available under Linux and MSW, where it is limited to the
+            first 64 CPUs).
+
+        @since 3.1.7
+    */
+    bool SetAffinity(const wxArrayInt& cpus);
+
     /**
         Sets the thread concurrency level for this process.
 
@@ -1388,6 +1412,92 @@ protected:
 };
 
 
+/**
+    @class wxCpuTopology
+
+    Static queries about the topology of the CPUs of the current system.
+
+    The functions of this class refine the information returned by
+    wxThread::GetCPUCount() and allow the code creating many worker threads to
+    place them deliberately using wxThread::SetAffinity(), e.g. to run one
+    thread per physical core or to keep the threads near the memory they use
+    on NUMA (non-uniform memory access) systems.
+
+    All functions degrade gracefully: if the detailed topology information is
+    unavailable on the current platform, they return values describing a flat
+    topology, i.e. one NUMA node and one core per logical CPU, so they can
+    always be used without checking for errors.
+
+    Example of creating one worker per physical core:
+    @code
+    const int cores = wxCpuTopology::GetCoreCount();
+    for ( int core = 0; core < cores; core++ )
+    {
+        MyWorkerThread* const thread = new MyWorkerThread;
+        thread->Create();
+
+        // Pin the thread to all SMT siblings of its core.
+        thread->SetAffinity(wxCpuTopology::GetSmtSiblings(core));
+
+        thread->Run();
+    }
+    @endcode
+
+    @library{wxbase}
+    @category{threading}
+
+    @see wxThread::GetCPUCount(), wxThread::SetAffinity()
+
+    @since 3.1.7
+*/
+class wxCpuTopology
+{
+public:
+    /**
+        Returns the number of logical CPUs.
+
+        This is the same value as returned by wxThread::GetCPUCount() except
+        that it is never negative: if the number of CPUs cannot be determined,
+        1 is returned.
+    */
+    static int GetLogicalCpuCount();
+
+    /**
+        Returns the number of physical processor cores.
+
+        Unlike GetLogicalCpuCount(), this function doesn't count the SMT
+        ("hyper-threading") siblings, so its result can be smaller than the
+        number of logical CPUs. If the topology information is unavailable, it
+        returns the same value as GetLogicalCpuCount().
+    */
+    static int GetCoreCount();
+
+    /**
+        Returns the logical CPUs sharing a physical core with the given one.
+
+        The returned array always contains @a cpu itself and is sorted in the
+        ascending order. If the topology information is unavailable, or if the
+        core is not SMT, @a cpu is its only element.
+    */
+    static wxArrayInt GetSmtSiblings(int cpu);
+
+    /**
+        Returns the number of NUMA memory nodes.
+
+        Returns 1 for non-NUMA systems and when the topology information is
+        unavailable.
+    */
+    static int GetNumaNodeCount();
+
+    /**
+        Returns the NUMA node the given logical CPU belongs to.
+
+        Returns 0 if the topology information is unavailable.
+    */
+    static int GetCpuNumaNode(int cpu);
+};
+
+
 /** See wxSemaphore. */
 enum wxSemaError
 {
@@ -0,0 +1,372 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        threadpool.h
+// Purpose:     interface of wxThreadPool and wxThreadPoolTask
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+    A unit of work to be executed by wxThreadPool.
+
+    To use the pool, derive a class from wxThreadPoolTask, store the inputs of
+    the computation in the fields of the derived class and override Execute()
+    to perform the work. The results can then be retrieved from the task
+    fields, either from OnCompleted(), which is called in the context of the
+    main thread, or after Wait() returns.
+
+    Task objects are reference counted and must never be deleted directly:
+    call DecRef() instead. A newly created task has a reference count of one
+    and wxThreadPool::AddTask() takes a reference of its own, so a caller not
+    interested in the task results can release its reference immediately
+    after queuing the task:
+
+    @code
+    MyTask* task = new MyTask(inputs);
+    wxThreadPool::GetDefault().AddTask(task);
+    task->DecRef(); // the pool keeps the task alive while it needs it
+    @endcode
+
+    This class is only available if @c wxUSE_THREADS is 1.
+
+    @since 3.1.7
+
+    @library{wxbase}
+    @category{threading}
+
+    @see wxThreadPool
+*/
+class wxThreadPoolTask
+{
+public:
+    /**
+        States of the task life cycle.
+    */
+    enum State
+    {
+        /// The task was not started yet.
+        State_Pending,
+
+        /// Execute() is currently running.
+        State_Running,
+
+        /// Execute() has finished.
+        State_Completed,
+
+        /// The pool was destroyed before the task could be started.
+        State_Cancelled
+    };
+
+    /**
+        Default constructor.
+
+        The new task has a reference count of one, release it with DecRef()
+        when the task object is not needed any longer.
+    */
+    wxThreadPoolTask();
+
+    /**
+        Override this method to perform the work of the task.
+
+        It is called from one of the pool worker threads, so it must not use
+        any thread-unsafe functionality, e.g. it can't update the GUI, and it
+        must not let any exceptions escape.
+    */
+    virtual void Execute() = 0;
+
+    /**
+        Called once the task has been executed.
+
+        If the program has an application object, this method is called in
+        the context of the main thread, using the same mechanism as
+        wxEvtHandler::CallAfter(), so it may safely update the GUI. In the
+        rare case of a program without any wxApp instance it is called
+        directly from the worker thread.
+
+        The default implementation does nothing.
+    */
+    virtual void OnCompleted();
+
+    /**
+        Return the current state of the task.
+
+        Note that, as the task may be executing concurrently, the state may
+        change at any moment, so the returned value can already be out of
+        date.
+    */
+    State GetState() const;
+
+    /**
+        Block until the task has been executed or cancelled.
+
+        @return @true if the task ran to completion or @false if it was
+            cancelled.
+
+        Avoid calling this method from the main thread of a GUI application
+        as it blocks, without dispatching any events, for potentially long
+        time: prefer overriding OnCompleted() to be notified about the task
+        completion instead.
+    */
+    bool Wait();
+
+    /**
+        Increment the task reference count.
+
+        Each call to IncRef() must be matched by a call to DecRef().
+    */
+    void IncRef();
+
+    /**
+        Decrement the task reference count, deleting the object when it
+        reaches zero.
+    */
+    void DecRef();
+
+protected:
+    /**
+        Destructor is protected, use DecRef() instead of deleting the task.
+    */
+    virtual ~wxThreadPoolTask();
+};
+
+/**
+    A pool of worker threads executing queued tasks.
+
+    Thread pools allow running many small tasks on a bounded number of
+    threads without paying the cost of creating a new thread for each of
+    them. The worker threads are created lazily, only when there are tasks
+    for them to execute, and each worker has its own task queue: tasks
+    submitted by an already running task of the same pool go to the queue of
+    the worker executing it and idle workers steal tasks from the queues of
+    the busy ones, which keeps recursively submitted tasks well balanced
+    across the threads.
+
+    For simple use, a process-wide default pool, sized to the number of
+    processors in the system, is available from GetDefault(); dedicated
+    pools can also be created, e.g. to limit the concurrency of a particular
+    kind of work.
+
+    This class is only available if @c wxUSE_THREADS is 1.
+
+    @since 3.1.7
+
+    @library{wxbase}
+    @category{threading}
+
+    @see wxThreadPoolTask, wxThread
+*/
+class wxThreadPool
+{
+public:
+    /**
+        Create a pool using up to the given number of worker threads.
+
+        @param numThreads
+            The maximal number of worker threads or -1, the default, to use
+            as many threads as there are processors in the system. No threads
+            are actually started until tasks are added to the pool.
+    */
+    explicit wxThreadPool(int numThreads = -1);
+
+    /**
+        Destroy the pool.
+
+        All tasks not yet started are cancelled (see
+        wxThreadPoolTask::State_Cancelled), but the destructor waits for the
+        tasks currently being executed to finish, so it can block for as long
+        as the longest running task takes.
+    */
+    ~wxThreadPool();
+
+    /**
+        Queue a task for execution.
+
+        The pool takes a new reference to the task, which is kept until the
+        task has been executed and its completion notification delivered, so
+        the caller may call wxThreadPoolTask::DecRef() immediately after this
+        function returns if it doesn't need the task object itself.
+
+        Tasks queued from outside of the pool are started in order of
+        decreasing @a priority, with tasks of equal priority started in the
+        order they were added. Tasks queued by another task running in this
+        pool are placed on the queue of the worker executing it and @a
+        priority is ignored for them.
+
+        @param task
+            The task to execute, can't be @NULL.
+        @param priority
+            The task priority in the 0..100 range, see ::wxPRIORITY_DEFAULT.
+        @return @true if the task was queued or @false if it couldn't be
+            done, e.g. because the pool is shutting down.
+    */
+    bool AddTask(wxThreadPoolTask* task, int priority = wxPRIORITY_DEFAULT);
+
+    /**
+        Block until all queued and running tasks have finished.
+
+        This method can't be called from a task running in this pool.
+    */
+    void WaitForAll();
+
+    /**
+        Return the maximal number of worker threads used by the pool.
+    */
+    size_t GetThreadCount() const;
+
+    /**
+        Return the process-wide default pool.
+
+        The default pool is created on first use with as many worker threads
+        as there are processors and is destroyed, waiting for any still
+        running tasks, during the library shutdown.
+    */
+    static wxThreadPool& GetDefault();
+};
+
+/**
+    @class wxTaskGraphNode
+
+    An opaque handle to a task added to a wxTaskGraph.
+
+    Objects of this class are returned by wxTaskGraph::AddTask() and are only
+    used to declare the dependencies between the tasks of the graph with
+    wxTaskGraph::AddDependency(). They are owned by the graph and must not be
+    deleted.
+
+    This class is only available if @c wxUSE_THREADS is 1.
+
+    @since 3.1.7
+
+    @library{wxbase}
+    @category{threading}
+
+    @see wxTaskGraph
+*/
+class wxTaskGraphNode
+{
+};
+
+/**
+    @class wxTaskGraph
+
+    Executes interdependent tasks on a wxThreadPool.
+
+    While wxThreadPool runs independent tasks, many parallel computations are
+    pipelines: e.g. an image must be decoded before it can be transformed and
+    transformed before the result can be shown. A task graph expresses such
+    pipelines declaratively: add the tasks, declare the dependencies between
+    them and call Submit() to let the pool execute them in a valid order,
+    running independent tasks in parallel on the pool workers.
+
+    Tasks can be marked as GUI-affine when adding them: such tasks, typically
+    the terminal ones delivering the pipeline results, are executed in the
+    main thread, using the pending events mechanism, instead of a pool worker,
+    so they can safely update the UI.
+
+    Example of a simple decode/transform/show pipeline:
+    @code
+    DecodeTask* const decode = new DecodeTask(filename);
+    TransformTask* const transform = new TransformTask(decode);
+    ShowTask* const show = new ShowTask(transform);
+
+    wxTaskGraph* const graph = new wxTaskGraph;
+    wxTaskGraphNode* const nodeDecode = graph->AddTask(decode);
+    wxTaskGraphNode* const nodeTransform = graph->AddTask(transform);
+    wxTaskGraphNode* const nodeShow = graph->AddTask(show, true);
+
+    graph->AddDependency(nodeTransform, nodeDecode);
+    graph->AddDependency(nodeShow, nodeTransform);
+
+    graph->Submit();
+
+    decode->DecRef();
+    transform->DecRef();
+    show->DecRef();
+    @endcode
+
+    Note that, as shown above, the graph keeps its own references to the
+    tasks, so the caller doesn't need to keep any if it's not interested in
+    examining them later.
+
+    This class is only available if @c wxUSE_THREADS is 1.
+
+    @since 3.1.7
+
+    @library{wxbase}
+    @category{threading}
+
+    @see wxThreadPool, wxThreadPoolTask
+*/
+class wxTaskGraph
+{
+public:
+    /**
+        Create a graph executing its tasks in the given pool.
+
+        @param pool
+            The pool to use or @NULL, the default, to use
+            wxThreadPool::GetDefault(). In any case, the pool must outlive
+            the graph.
+    */
+    explicit wxTaskGraph(wxThreadPool* pool = NULL);
+
+    /**
+        Destroy the graph.
+
+        If the graph was submitted, the destructor waits for all of its tasks
+        to finish first, as if by calling Wait(). The tasks of a graph that
+        was never submitted are cancelled, see
+        wxThreadPoolTask::State_Cancelled.
+    */
+    ~wxTaskGraph();
+
+    /**
+        Add a task to the graph.
+
+        The graph takes a new reference to the task, which is released when
+        the graph itself is destroyed.
+
+        This function can only be called before Submit().
+
+        @param task
+            The task to execute, can't be @NULL.
+        @param runInMainThread
+            If @true, the task is executed in the main thread, via the
+            pending events mechanism, once it becomes ready, instead of
+            being queued to the pool.
+        @return The node to use with AddDependency(), owned by the graph.
+    */
+    wxTaskGraphNode* AddTask(wxThreadPoolTask* task,
+                             bool runInMainThread = false);
+
+    /**
+        Declare that a task depends on another one.
+
+        After this call, @a node will only start running once @a predecessor
+        has finished. Any number of dependencies may be declared for a node.
+
+        This function can only be called before Submit() and both nodes must
+        have been returned by AddTask() of this graph.
+    */
+    void AddDependency(wxTaskGraphNode* node, wxTaskGraphNode* predecessor);
+
+    /**
+        Start executing the graph.
+
+        All tasks without predecessors are queued to the pool immediately and
+        the remaining ones as the tasks they depend on complete. No tasks or
+        dependencies may be added after calling this function.
+
+        @return @true if the execution started or @false, without running
+            anything, if the declared dependencies contain a cycle.
+    */
+    bool Submit();
+
+    /**
+        Block until all tasks of the graph have finished.
+
+        Can only be called after Submit(). Beware of calling this function
+        from the main thread if the graph contains GUI-affine tasks: they
+        would never get a chance to run, as they are executed from the event
+        loop of the main thread itself, and this function would never return.
+    */
+    void Wait();
+};
@@ -363,6 +363,12 @@ public:
         Returns a pointer to the internal variant data. To take ownership of
         this data, you must call its wxVariantData::IncRef() method. When you
         stop using it, wxVariantData::DecRef() must be called as well.
+
+        Note that values of the small standard types (bool, long, double and
+        wxString) are stored inside the variant object itself and the
+        corresponding wxVariantData is only allocated when this function is
+        called for the first time, so prefer using GetBool(), GetLong() etc.
+        when only the value is needed.
     */
     wxVariantData* GetData() const;
 
@@ -209,7 +209,22 @@ public:
             wxWebRequestEvent::GetDataSize() methods from wxEVT_WEBREQUEST_DATA
             handler.
         */
-        Storage_None
+        Storage_None,
+
+        /**
+            The data is written directly to the stream given to SetSink().
+
+            Unlike with the other storage types, the data is passed to the
+            sink stream as soon as it is received from the network, without
+            being accumulated in memory or written to a temporary file first,
+            making this storage type appropriate for very large downloads.
+
+            This storage type is selected implicitly by calling SetSink() and
+            can't be set using SetStorage() directly.
+
+            @since 3.1.7
+        */
+        Storage_Sink
     };
 
     /**
@@ -275,6 +290,38 @@ public:
     */
     void Cancel();
 
+    /**
+        Temporarily suspend an active request.
+
+        Pausing makes the implementation stop reading from the network, so
+        that the server eventually stops sending once the flow control window
+        fills up: this can be used to apply backpressure when the response
+        data is received faster than it can be consumed, e.g. by the sink
+        stream set with SetSink(). Use Resume() to continue the transfer.
+
+        Pausing may be unsupported by the current backend (currently only the
+        libcurl-based implementation supports it) and can fail, so check the
+        return value: if it is @false, data continues to arrive as usual.
+
+        It is explicitly allowed to call this function from a
+        @c wxEVT_WEBREQUEST_DATA event handler or from the sink stream write
+        function.
+
+        @return @true if the transfer was paused.
+
+        @since 3.1.7
+    */
+    bool Pause();
+
+    /**
+        Resume a request previously suspended with Pause().
+
+        @return @true if the transfer was resumed.
+
+        @since 3.1.7
+    */
+    bool Resume();
+
     /**
         Returns a response object after a successful request.
 
@@ -403,6 +450,34 @@ public:
     */
     void SetStorage(Storage storage);
 
+    /**
+        Set the stream to which the response data is written as it is
+        received.
+
+        Calling this function selects @c Storage_Sink storage type: the data
+        is passed to @a sink directly from the network read buffer as soon as
+        it is received, without accumulating it in memory or writing it to a
+        temporary file first, so this is the most efficient way of downloading
+        very large responses. Providing a custom wxOutputStream-derived class
+        also allows processing the data chunk by chunk as it arrives.
+
+        If writing to the sink fails, i.e. it writes less than requested, the
+        request is aborted and switches to @c State_Failed. If the data
+        arrives faster than the sink can consume it, Pause() can be used to
+        suspend the transfer.
+
+        The sink is closed, flushing any data buffered by the stream itself,
+        when the request completes, fails or is cancelled.
+
+        @param sink
+            The output stream to write to, must be non-@NULL and valid. This
+            object takes ownership of the stream and will delete it.
+        @return @true if the sink was set successfully.
+
+        @since 3.1.7
+    */
+    bool SetSink(wxOutputStream* sink);
+
     /**
         Disable SSL certificate verification.
 
@@ -712,6 +787,69 @@ public:
     */
     wxString GetTempDir() const;
 
+    /**
+        Set limits on the number of connections used by this session.
+
+        Sessions reuse the connections kept alive after the previous requests
+        for the subsequent ones whenever possible. This function allows to
+        configure how many connections may be kept alive and opened in total
+        and to a single host, which is useful when issuing many small requests
+        to the same server.
+
+        This function must be called before creating the first request in this
+        session and is currently only honoured by the libcurl-based backend,
+        the other backends use their own defaults.
+
+        @param maxTotal
+            Maximal total number of connections opened, and kept alive for
+            reuse, by this session or 0 to use the backend default.
+        @param maxPerHost
+            Maximal number of concurrent connections to a single host or 0 to
+            use the backend default.
+
+        @since 3.1.7
+    */
+    void SetMaxConnections(int maxTotal, int maxPerHost = 0);
+
+    /**
+        Configure TCP keep-alives for the connections of this session.
+
+        Enabling keep-alives prevents the pooled idle connections from being
+        silently dropped by the other end or an intermediate proxy, keeping
+        them usable for the next request.
+
+        This function must be called before creating the first request in this
+        session and is currently only honoured by the libcurl-based backend.
+
+        @param idleSeconds
+            Delay, in seconds, of inactivity before the first keep-alive probe
+            is sent or 0 to use the system default.
+        @param intervalSeconds
+            Interval, in seconds, between the subsequent keep-alive probes or
+            0 to use the system default.
+
+        @since 3.1.7
+    */
+    void SetKeepAliveTimes(int idleSeconds, int intervalSeconds);
+
+    /**
+        Allow using HTTP/2 with multiplexing for the requests of this session.
+
+        When enabled, HTTP/2 is negotiated for the requests using TLS and
+        concurrent requests to the same host are multiplexed over a single
+        connection instead of each of them opening its own one, avoiding the
+        repeated handshakes.
+
+        This function must be called before creating the first request in this
+        session and is currently only honoured by the libcurl-based backend,
+        and only has an effect if libcurl was built with HTTP/2 support. The
+        WinHTTP and NSURLSession backends decide on the use of HTTP/2 on their
+        own.
+
+        @since 3.1.7
+    */
+    void EnableHTTP2(bool enable = true);
+
     /**
         Returns the default session
     */
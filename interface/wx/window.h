@@ -617,6 +617,30 @@ public:
     */
     wxWindow* FindWindow(const wxString& name) const;
 
+    /**
+        Enables or disables a hash index speeding up FindWindow() calls.
+
+        By default FindWindow() walks the children tree recursively, so code
+        calling it for many windows of a big dialog (e.g. when binding data to
+        the controls of a generated form) behaves quadratically. After calling
+        this function on a window, typically a top level one, the ids and
+        names of all its descendants are indexed in hash maps and lookups by
+        either of them take constant time. The index is kept up to date
+        automatically when children are added, removed, renamed or change
+        their ids.
+
+        Note that if several descendants share the same id (as is common with
+        @c wxID_ANY) or name, lookups of that particular key fall back to the
+        recursive walk in order to return the same window as before.
+
+        @param enable
+            If @true, create the index, if @false delete it and revert to the
+            recursive lookups.
+
+        @since 3.1.7
+    */
+    void EnableChildLookupIndex(bool enable = true);
+
     /**
         Returns a reference to the list of the window's children. @c wxWindowList
         is a type-safe wxList-like class whose elements are of type @c wxWindow*.
@@ -2221,6 +2245,52 @@ public:
     */
     void RefreshRect(const wxRect& rect, bool eraseBackground = true);
 
+    /**
+        Rate limits the refreshes of this window.
+
+        If @a milliseconds is positive, at most one native repaint request is
+        generated per this interval: the first Refresh() call goes through
+        normally and all the following ones during the interval just
+        accumulate the damaged area, which is invalidated in a single native
+        call when the interval elapses. This is useful for windows refreshed
+        very often from rapidly arriving events (e.g. a ticker updated
+        thousands of times per second), where it bounds the repaint rate
+        without losing any damage; using the frame interval of the display
+        (e.g. 16 for a 60 Hz monitor) is a reasonable choice.
+
+        Passing 0 (the default for every window) disables the rate limiting
+        and immediately flushes any still pending damage.
+
+        This function requires wxWidgets to be compiled with wxUSE_TIMER
+        set to 1.
+
+        @see GetCoalescedRefreshCount()
+
+        @since 3.1.7
+    */
+    void SetRefreshRateLimit(int milliseconds);
+
+    /**
+        Returns the refresh rate limit of this window in milliseconds, 0 if
+        refreshes are not rate limited.
+
+        @see SetRefreshRateLimit()
+
+        @since 3.1.7
+    */
+    int GetRefreshRateLimit() const;
+
+    /**
+        Returns the total number of Refresh() calls which were deferred and
+        coalesced because of the rate limit set with SetRefreshRateLimit().
+
+        This counter is meant to help with tuning the rate limit and finding
+        the windows being refreshed too often.
+
+        @since 3.1.7
+    */
+    unsigned int GetCoalescedRefreshCount() const;
+
     /**
         Calling this method immediately repaints the invalidated area of the window and
         all of its children recursively (this normally only happens when the
@@ -3538,6 +3608,57 @@ public:
     */
     virtual bool Layout();
 
+    /**
+        Defers laying out this window and its children.
+
+        All calls to Layout() made between this call and the matching
+        EndDeferLayout() call, including the implicit ones done when the
+        windows are resized, only mark the corresponding window as needing to
+        be laid out and are coalesced into a single top-down layout pass
+        performed by EndDeferLayout(). This can speed up creating or updating
+        many children of the same window considerably, similarly to how
+        Freeze() and Thaw() batch the repaints:
+
+        @code
+            panel->BeginDeferLayout();
+            for ( size_t n = 0; n < numPages; n++ )
+                AddPluginPage(panel, n);
+            panel->EndDeferLayout(); // does a single layout pass
+        @endcode
+
+        Calls to this function may be nested, layout resumes when
+        EndDeferLayout() has been called as many times as BeginDeferLayout().
+        Children added to this window while layout is deferred are deferred
+        too.
+
+        @see EndDeferLayout(), IsLayoutDeferred()
+
+        @since 3.1.7
+    */
+    void BeginDeferLayout();
+
+    /**
+        Reenables layout after a previous BeginDeferLayout() call and performs
+        the layout passes deferred since then.
+
+        Only the windows which had actually been asked to lay themselves out
+        while layout was deferred are laid out, and each of them just once.
+
+        @see BeginDeferLayout()
+
+        @since 3.1.7
+    */
+    void EndDeferLayout();
+
+    /**
+        Returns @true if layout of this window is currently deferred.
+
+        @see BeginDeferLayout()
+
+        @since 3.1.7
+    */
+    bool IsLayoutDeferred() const;
+
     /**
         Determines whether the Layout() function will be called automatically
         when the window is resized.
@@ -180,6 +180,27 @@ public:
     wxString GetAttribute(const wxString& attrName,
                           const wxString& defaultVal = wxEmptyString) const;
 
+    /**
+        Same as GetAttribute(const wxString&, wxString*) const, but takes a
+        pre-hashed attribute name.
+
+        This is slightly more efficient when looking up the same attribute
+        many times, as the hash of the name is computed only once, when the
+        wxXmlAttrName object is constructed.
+
+        @since 3.1.7
+    */
+    bool GetAttribute(const wxXmlAttrName& attrName, wxString* value) const;
+
+    /**
+        Same as GetAttribute(const wxString&, const wxString&) const, but
+        takes a pre-hashed attribute name.
+
+        @since 3.1.7
+    */
+    wxString GetAttribute(const wxXmlAttrName& attrName,
+                          const wxString& defaultVal = wxEmptyString) const;
+
     /**
         Return a pointer to the first attribute of this node.
     */
@@ -273,6 +294,14 @@ public:
     */
     bool HasAttribute(const wxString& attrName) const;
 
+    /**
+        Same as HasAttribute(const wxString&) const, but takes a pre-hashed
+        attribute name.
+
+        @since 3.1.7
+    */
+    bool HasAttribute(const wxXmlAttrName& attrName) const;
+
     /**
         Inserts the @a child node immediately before @a followingNode in the
         children list. Once inserted, the XML tree takes ownership of the new
@@ -457,6 +486,52 @@ public:
 
 
 
+/**
+    @class wxXmlAttrName
+
+    Represents a pre-hashed attribute name.
+
+    wxXmlNode functions looking up attributes by name hash the name to avoid
+    comparing it with the names of the attributes which can't possibly match.
+    When the same, known in advance, attribute is looked up many times, the
+    hash can be precomputed once by constructing an object of this class,
+    e.g. as a local static variable, and passing it to them instead of the
+    name itself:
+
+    @code
+    static const wxXmlAttrName attrId("id");
+
+    const wxString id = node->GetAttribute(attrId);
+    @endcode
+
+    @library{wxxml}
+    @category{xml}
+
+    @since 3.1.7
+
+    @see wxXmlNode::GetAttribute(), wxXmlNode::HasAttribute()
+*/
+class wxXmlAttrName
+{
+public:
+    /**
+        Creates the pre-hashed name from the given string.
+    */
+    explicit wxXmlAttrName(const wxString& name);
+
+    /**
+        Returns the name passed to the constructor.
+    */
+    const wxString& GetName() const;
+
+    /**
+        Returns the hash of the name.
+    */
+    wxUint32 GetHash() const;
+};
+
+
+
 /**
     @class wxXmlDoctype
 
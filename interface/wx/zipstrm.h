@@ -556,6 +556,39 @@ public:
     void SetLevel(int level);
     //@}
 
+    /**
+        Compress entry data on a pool of background worker threads.
+
+        The data of each entry is split into chunks which are deflated in
+        parallel and written out in order, so large archives can use all
+        available CPUs while the output remains a standard zip readable by
+        any unzip program. The compression ratio can be marginally worse
+        than with serial compression because the chunks are compressed
+        independently.
+
+        @param count
+            The number of worker threads to use, or -1 to use one thread
+            per available CPU. Passing 0 or 1 restores the default
+            single-threaded compression.
+
+        @return @true on success, or @false if an entry is currently open
+            or if wxWidgets was built without thread support. If the worker
+            threads cannot be created at runtime, compression silently
+            falls back to the calling thread.
+
+        @since 3.1.7
+    */
+    bool SetCompressionThreads(int count);
+
+    /**
+        Get the number of threads used for compressing entry data.
+
+        Returns 1 unless SetCompressionThreads() has been called.
+
+        @since 3.1.7
+    */
+    int GetCompressionThreads() const;
+
     /**
         Create a new directory entry (see wxArchiveEntry::IsDir) with the given
         name and timestamp.
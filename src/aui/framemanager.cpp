@@ -574,6 +574,46 @@ static int PaneSortFunc(wxAuiPaneInfo** p1, wxAuiPaneInfo** p2)
     return ((*p1)->dock_pos < (*p2)->dock_pos) ? -1 : 1;
 }
 
+// returns a simple signature of the given docking layout; it is used by
+// CalculateHintRect() to recognize that a drop would result in the same
+// layout as the one the hint rectangle was last calculated for
+static size_t GetDocksSignature(const wxAuiDockInfoArray& docks,
+                                const wxAuiPaneInfo& hint,
+                                const wxSize& client_size)
+{
+    size_t sig = docks.GetCount();
+
+    sig = sig*8171 + (size_t)hint.dock_direction;
+    sig = sig*8171 + (size_t)hint.dock_layer;
+    sig = sig*8171 + (size_t)hint.dock_row;
+    sig = sig*8171 + (size_t)hint.dock_pos;
+    sig = sig*8171 + (size_t)(hint.IsFloating() ? 1 : 0);
+    sig = sig*8171 + (size_t)client_size.x;
+    sig = sig*8171 + (size_t)client_size.y;
+
+    size_t i, j, dock_count, pane_count;
+    for (i = 0, dock_count = docks.GetCount(); i < dock_count; ++i)
+    {
+        const wxAuiDockInfo& dock = docks.Item(i);
+
+        sig = sig*8171 + (size_t)dock.dock_direction;
+        sig = sig*8171 + (size_t)dock.dock_layer;
+        sig = sig*8171 + (size_t)dock.dock_row;
+        sig = sig*8171 + (size_t)dock.size;
+
+        for (j = 0, pane_count = dock.panes.GetCount(); j < pane_count; ++j)
+        {
+            const wxAuiPaneInfo& pane = *dock.panes.Item(j);
+
+            sig = sig*8171 + (size_t)wxPtrToUInt(pane.window);
+            sig = sig*8171 + (size_t)pane.dock_pos;
+            sig = sig*8171 + (size_t)pane.dock_proportion;
+        }
+    }
+
+    return sig;
+}
+
 
 bool wxAuiPaneInfo::IsValid() const
 {
@@ -611,6 +651,7 @@ wxAuiManager::wxAuiManager(wxWindow* managed_wnd, unsigned int flags)
     m_action = actionNone;
     m_actionWindow = NULL;
     m_hoverButton = NULL;
+    m_hintCalcSig = 0;
     m_art = new wxAuiDefaultDockArt;
     m_hintWnd = NULL;
     m_flags = flags;
@@ -2498,6 +2539,9 @@ void wxAuiManager::Update()
     m_hoverButton = NULL;
     m_actionPart = NULL;
 
+    // the layout is changing, so any cached hint rectangle is now stale
+    m_hintCalcRect = wxRect();
+
     wxSizer* sizer;
     int i, pane_count = m_panes.GetCount();
 
@@ -3518,8 +3562,18 @@ wxRect wxAuiManager::CalculateHintRect(wxWindow* pane_window,
 
     panes.Add(hint);
 
-    wxSizer* sizer = LayoutAll(panes, docks, uiparts, true);
+    // During a drag this is called for every mouse move, and the mouse
+    // usually stays over the same drop target for many of them in a row,
+    // so reuse the previously calculated rectangle instead of redoing the
+    // temporary layout below if the drop results in the same layout.
     wxSize client_size = m_frame->GetClientSize();
+    size_t layout_sig = GetDocksSignature(docks, hint, client_size);
+    if (!m_hintCalcRect.IsEmpty() && layout_sig == m_hintCalcSig)
+    {
+        return m_hintCalcRect;
+    }
+
+    wxSizer* sizer = LayoutAll(panes, docks, uiparts, true);
     sizer->SetDimension(0, 0, client_size.x, client_size.y);
     sizer->Layout();
 
@@ -3553,6 +3607,10 @@ wxRect wxAuiManager::CalculateHintRect(wxWindow* pane_window,
         rect.x -= rect.GetWidth();
     }
 
+    // remember the result for subsequent calls with the same drop layout
+    m_hintCalcRect = rect;
+    m_hintCalcSig = layout_sig;
+
     return rect;
 }
 
@@ -4280,7 +4338,11 @@ bool wxAuiManager::DoEndResizeAction(wxMouseEvent& event)
             break;
         }
 
-        Update();
+        // During live resizing this is called for every mouse move, many
+        // of which (e.g. moves along the sash) leave the dock size
+        // unchanged, so don't redo the whole layout unnecessarily.
+        if (m_actionPart->dock->size != old_size)
+            Update();
     }
     else if (m_actionPart &&
         m_actionPart->type == wxAuiDockUIPart::typePaneSizer)
@@ -4445,10 +4507,16 @@ bool wxAuiManager::DoEndResizeAction(wxMouseEvent& event)
         }
 
 
-        dock.panes.Item(borrow_pane)->dock_proportion = prop_borrow;
-        pane.dock_proportion = new_proportion;
+        // Skip the layout update when the proportions did not actually
+        // change, which happens for many mouse moves during live resizing.
+        if (dock.panes.Item(borrow_pane)->dock_proportion != prop_borrow ||
+            pane.dock_proportion != new_proportion)
+        {
+            dock.panes.Item(borrow_pane)->dock_proportion = prop_borrow;
+            pane.dock_proportion = new_proportion;
 
-        Update();
+            Update();
+        }
     }
 
     return true;
@@ -23,6 +23,7 @@
     #include "wx/settings.h"
     #include "wx/bitmap.h"
     #include "wx/menu.h"
+    #include "wx/dcmemory.h"
 #endif
 
 #include "wx/renderer.h"
@@ -219,6 +220,8 @@ void wxAuiGenericTabArt::UpdateColoursFromSystem()
     m_disabledRightBmp = wxAuiBitmapFromBits(right_bits, 16, 16, wxSystemSettings::GetColour(wxSYS_COLOUR_GRAYTEXT));
     m_activeWindowListBmp = wxAuiBitmapFromBits(list_bits, 16, 16, wxSystemSettings::GetColour(wxSYS_COLOUR_WINDOWTEXT));
     m_disabledWindowListBmp = wxAuiBitmapFromBits(list_bits, 16, 16, wxSystemSettings::GetColour(wxSYS_COLOUR_GRAYTEXT));
+
+    m_tabCache.clear();
 }
 
 wxAuiTabArt* wxAuiGenericTabArt::Clone()
@@ -229,6 +232,7 @@ wxAuiTabArt* wxAuiGenericTabArt::Clone()
 void wxAuiGenericTabArt::SetFlags(unsigned int flags)
 {
     m_flags = flags;
+    m_tabCache.clear();
 }
 
 void wxAuiGenericTabArt::SetSizingInfo(const wxSize& tab_ctrl_size,
@@ -342,6 +346,109 @@ void wxAuiGenericTabArt::DrawTab(wxDC& dc,
                                  wxRect* out_tab_rect,
                                  wxRect* out_button_rect,
                                  int* x_extent)
+{
+    // Tabs are pre-rendered into bitmaps so that steady-state repaints
+    // (e.g. hover changes in a notebook with dozens of tabs) reduce to
+    // simple blits. Because DoDrawTab() does not paint every pixel of its
+    // bounding rectangle, the bitmap starts out as a copy of the pixels
+    // underneath the tab; the destination position is part of the cache
+    // key, so a cached tab is only blitted back to the very place it was
+    // rendered for.
+    wxSize tab_size = GetTabSize(dc, wnd, page.caption, page.bitmap,
+                                 page.active, close_button_state, x_extent);
+
+    // this is the area DoDrawTab() may actually paint, see the clipping
+    // region set up there
+    int clip_width = tab_size.x;
+    if (clip_width > in_rect.width)
+        clip_width = in_rect.width;
+    const int cacheW = clip_width + 1;
+    const int cacheH = in_rect.height;
+
+    if (cacheW <= 0 || cacheH <= 0)
+    {
+        DoDrawTab(dc, wnd, page, in_rect, close_button_state,
+                  out_tab_rect, out_button_rect, x_extent);
+        return;
+    }
+
+    // everything the rendering depends on, apart from the art's own
+    // settings (which clear the whole cache when changed), takes part in
+    // the cache key
+    wxString key;
+    key.Printf(wxS("%d,%d,%d,%d,%d;%d;%u;%d;%g;%p;"),
+               in_rect.x, in_rect.y, cacheW, cacheH, m_tabCtrlHeight,
+               (page.active ? 1 : 0) |
+                   (wnd->FindFocus() == wnd ? 2 : 0) |
+                   (wxSystemSettings::GetAppearance().IsUsingDarkBackground() ? 4 : 0) |
+                   (dc.GetLayoutDirection() == wxLayout_RightToLeft ? 8 : 0),
+               m_flags,
+               close_button_state,
+               dc.GetContentScaleFactor(),
+               page.bitmap.IsOk() ? (void*)page.bitmap.GetRefData() : NULL);
+    key += page.caption;
+
+    wxAuiTabArtTabCache::iterator it = m_tabCache.find(key);
+    if (it == m_tabCache.end())
+    {
+        // prevent unbounded growth when captions or positions keep changing
+        if (m_tabCache.size() >= 256)
+            m_tabCache.clear();
+
+        wxAuiTabArtCachedTab cached;
+        cached.bitmap.Create(cacheW, cacheH, dc);
+
+        wxMemoryDC memDC;
+        memDC.SelectObject(cached.bitmap);
+        if (!memDC.IsOk())
+        {
+            // can't render off-screen for some reason, draw directly
+            DoDrawTab(dc, wnd, page, in_rect, close_button_state,
+                      out_tab_rect, out_button_rect, x_extent);
+            return;
+        }
+
+        memDC.SetLayoutDirection(dc.GetLayoutDirection());
+
+        // capture what is currently underneath the tab
+        memDC.Blit(0, 0, cacheW, cacheH, &dc, in_rect.x, in_rect.y);
+
+        int dummy_extent = 0;
+        DoDrawTab(memDC, wnd, page,
+                  wxRect(0, 0, in_rect.width, in_rect.height),
+                  close_button_state,
+                  &cached.tabRect, &cached.buttonRect, &dummy_extent);
+
+        memDC.SelectObject(wxNullBitmap);
+
+        m_tabCache[key] = cached;
+        it = m_tabCache.find(key);
+    }
+
+    const wxAuiTabArtCachedTab& cached = it->second;
+
+    wxMemoryDC srcDC;
+    srcDC.SelectObjectAsSource(cached.bitmap);
+    dc.Blit(in_rect.x, in_rect.y, cacheW, cacheH, &srcDC, 0, 0);
+
+    *out_tab_rect = cached.tabRect;
+    out_tab_rect->Offset(in_rect.x, in_rect.y);
+
+    if (close_button_state != wxAUI_BUTTON_STATE_HIDDEN)
+    {
+        *out_button_rect = cached.buttonRect;
+        out_button_rect->Offset(in_rect.x, in_rect.y);
+    }
+}
+
+void wxAuiGenericTabArt::DoDrawTab(wxDC& dc,
+                                   wxWindow* wnd,
+                                   const wxAuiNotebookPage& page,
+                                   const wxRect& in_rect,
+                                   int close_button_state,
+                                   wxRect* out_tab_rect,
+                                   wxRect* out_button_rect,
+                                   int* x_extent)
 {
     wxCoord normal_textx, normal_texty;
     wxCoord selected_textx, selected_texty;
@@ -874,16 +981,19 @@ int wxAuiGenericTabArt::GetBestTabCtrlSize(wxWindow* wnd,
 void wxAuiGenericTabArt::SetNormalFont(const wxFont& font)
 {
     m_normalFont = font;
+    m_tabCache.clear();
 }
 
 void wxAuiGenericTabArt::SetSelectedFont(const wxFont& font)
 {
     m_selectedFont = font;
+    m_tabCache.clear();
 }
 
 void wxAuiGenericTabArt::SetMeasuringFont(const wxFont& font)
 {
     m_measuringFont = font;
+    m_tabCache.clear();
 }
 
 void wxAuiGenericTabArt::SetColour(const wxColour& colour)
@@ -892,11 +1002,13 @@ void wxAuiGenericTabArt::SetColour(const wxColour& colour)
     m_borderPen = wxPen(m_baseColour.ChangeLightness(75));
     m_baseColourPen = wxPen(m_baseColour);
     m_baseColourBrush = wxBrush(m_baseColour);
+    m_tabCache.clear();
 }
 
 void wxAuiGenericTabArt::SetActiveColour(const wxColour& colour)
 {
     m_activeColour = colour;
+    m_tabCache.clear();
 }
 
 // -- wxAuiSimpleTabArt class implementation --
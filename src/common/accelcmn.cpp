@@ -29,6 +29,8 @@
     #include "wx/crt.h"
 #endif //WX_PRECOMP
 
+#include "wx/hashmap.h"
+
 wxAcceleratorTable wxNullAcceleratorTable;
 
 // ============================================================================
@@ -156,9 +158,9 @@ static int IsNumberedAccelKey(const wxString& str,
     return prefixCode + num - first;
 }
 
-/* static */
-bool
-wxAcceleratorEntry::ParseAccel(const wxString& text, int *flagsOut, int *keyOut)
+// the real parser, the public ParseAccel() below caches its results
+static bool
+DoParseAccel(const wxString& text, int *flagsOut, int *keyOut)
 {
     // the parser won't like trailing spaces
     wxString label = text;
@@ -299,6 +301,61 @@ wxAcceleratorEntry::ParseAccel(const wxString& text, int *flagsOut, int *keyOut)
     return true;
 }
 
+namespace
+{
+
+// the result of parsing an accelerator string, valid or not
+struct wxParsedAccel
+{
+    bool ok;
+    int flags;
+    int keyCode;
+};
+
+WX_DECLARE_STRING_HASH_MAP(wxParsedAccel, wxParsedAccelMap);
+
+} // anonymous namespace
+
+/* static */
+bool
+wxAcceleratorEntry::ParseAccel(const wxString& text, int *flagsOut, int *keyOut)
+{
+    // parsing does quite a lot of string comparisons while the same strings
+    // are parsed over and over again, e.g. whenever a menu item label is set,
+    // so cache the results; this can only return stale values if the active
+    // translations change during the program lifetime, but dynamic language
+    // changes are not supported by the rest of the menu code anyhow (the
+    // existing labels are not retranslated either)
+    static wxParsedAccelMap s_cache;
+
+    wxParsedAccelMap::iterator it = s_cache.find(text);
+    if ( it == s_cache.end() )
+    {
+        wxParsedAccel parsed;
+        parsed.flags =
+        parsed.keyCode = 0;
+        parsed.ok = DoParseAccel(text, &parsed.flags, &parsed.keyCode);
+
+        // don't let the cache grow without bounds if the program generates
+        // many unique labels dynamically
+        if ( s_cache.size() >= 1000 )
+            s_cache.clear();
+
+        it = s_cache.insert(wxParsedAccelMap::value_type(text, parsed)).first;
+    }
+
+    const wxParsedAccel& parsed = it->second;
+    if ( !parsed.ok )
+        return false;
+
+    if ( flagsOut )
+        *flagsOut = parsed.flags;
+    if ( keyOut )
+        *keyOut = parsed.keyCode;
+
+    return true;
+}
+
 /* static */
 wxAcceleratorEntry *wxAcceleratorEntry::Create(const wxString& str)
 {
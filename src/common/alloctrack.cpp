@@ -0,0 +1,288 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/alloctrack.cpp
+// Purpose:     Production-safe per-subsystem allocation tracking
+// Author:      wxWidgets team
+// Created:     2022-04-10
+// Copyright:   (c) 2022 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+
+#include "wx/alloctrack.h"
+
+#ifndef WX_PRECOMP
+    #include "wx/string.h"
+#endif //WX_PRECOMP
+
+#include "wx/thread.h"
+
+#if wxUSE_STACKWALKER
+    #include "wx/stackwalk.h"
+#endif
+
+// ----------------------------------------------------------------------------
+// private data
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// number of sampled call stacks kept per tag
+const size_t wxALLOC_MAX_SAMPLED_STACKS = 8;
+
+struct wxAllocTagData
+{
+    wxAllocationStats stats;
+
+#if wxUSE_STACKWALKER
+    // ring of the most recently sampled call stacks, nextStack is the index
+    // at which the next one will be stored
+    wxString stacks[wxALLOC_MAX_SAMPLED_STACKS];
+    size_t numStacks,
+           nextStack;
+#endif // wxUSE_STACKWALKER
+};
+
+wxAllocTagData gs_allocData[wxALLOC_TAG_MAX];
+
+#if wxUSE_THREADS
+// Protects all the data above and the sampling counters below. The critical
+// section is deliberately never destroyed because strings are still freed,
+// and thus tracked, during the destruction of the other static objects.
+wxCriticalSection& wxAllocLock()
+{
+    static wxCriticalSection* const s_lock = new wxCriticalSection;
+
+    return *s_lock;
+}
+#endif
+
+// Sampling interval set by SetStackSampleInterval() and the number of
+// allocations recorded since the last sample.
+unsigned long gs_stackInterval = 0;
+unsigned long gs_allocsSinceSample = 0;
+
+#if wxUSE_STACKWALKER
+
+// Set while a call stack is being captured: the capture itself allocates
+// strings, which would deadlock on gs_allocLock if they were tracked, so
+// all tracking is skipped for its duration (losing a few samples from the
+// other threads during this short interval doesn't matter).
+bool gs_inStackCapture = false;
+
+// Formats the current call stack as one line per frame.
+class wxAllocStackWalker : public wxStackWalker
+{
+public:
+    wxAllocStackWalker() { }
+
+    const wxString& GetStackTrace() const { return m_trace; }
+
+protected:
+    virtual void OnStackFrame(const wxStackFrame& frame) wxOVERRIDE
+    {
+        m_trace << frame.GetName();
+        if ( frame.HasSourceLocation() )
+        {
+            m_trace << wxS(" (") << frame.GetFileName()
+                    << wxS(':') << frame.GetLine() << wxS(')');
+        }
+        m_trace << wxS('\n');
+    }
+
+private:
+    wxString m_trace;
+
+    wxDECLARE_NO_COPY_CLASS(wxAllocStackWalker);
+};
+
+void wxCaptureAllocStack(wxAllocTag tag)
+{
+    gs_inStackCapture = true;
+
+    wxAllocStackWalker walker;
+
+    // skip the frames inside the tracker itself and don't go too deep, the
+    // top of the stack is what matters for attributing the allocation
+    walker.Walk(3, 32);
+
+    {
+#if wxUSE_THREADS
+        wxCriticalSectionLocker lock(wxAllocLock());
+#endif
+        wxAllocTagData& data = gs_allocData[tag];
+        data.stacks[data.nextStack] = walker.GetStackTrace();
+        if ( ++data.nextStack == wxALLOC_MAX_SAMPLED_STACKS )
+            data.nextStack = 0;
+        if ( data.numStacks < wxALLOC_MAX_SAMPLED_STACKS )
+            data.numStacks++;
+    }
+
+    gs_inStackCapture = false;
+}
+
+#endif // wxUSE_STACKWALKER
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// wxAllocationTracker
+// ----------------------------------------------------------------------------
+
+bool wxAllocationTracker::ms_enabled = false;
+
+void wxAllocationTracker::DoRecordAlloc(wxAllocTag tag, size_t size)
+{
+    wxCHECK_RET( tag < wxALLOC_TAG_MAX, wxS("invalid allocation tag") );
+
+    bool capture = false;
+
+    {
+#if wxUSE_STACKWALKER
+        if ( gs_inStackCapture )
+            return;
+#endif
+
+#if wxUSE_THREADS
+        wxCriticalSectionLocker lock(wxAllocLock());
+#endif
+
+        wxAllocationStats& stats = gs_allocData[tag].stats;
+        stats.allocCount++;
+        stats.allocBytes += size;
+
+        const wxULongLong current = stats.GetCurrentBytes();
+        if ( current > stats.peakBytes )
+            stats.peakBytes = current;
+
+        if ( gs_stackInterval && ++gs_allocsSinceSample >= gs_stackInterval )
+        {
+            gs_allocsSinceSample = 0;
+            capture = true;
+        }
+    }
+
+#if wxUSE_STACKWALKER
+    if ( capture )
+        wxCaptureAllocStack(tag);
+#else
+    wxUnusedVar(capture);
+#endif
+}
+
+void wxAllocationTracker::DoRecordFree(wxAllocTag tag, size_t size)
+{
+    wxCHECK_RET( tag < wxALLOC_TAG_MAX, wxS("invalid allocation tag") );
+
+#if wxUSE_STACKWALKER
+    if ( gs_inStackCapture )
+        return;
+#endif
+
+#if wxUSE_THREADS
+    wxCriticalSectionLocker lock(wxAllocLock());
+#endif
+
+    wxAllocationStats& stats = gs_allocData[tag].stats;
+    stats.freeCount++;
+    stats.freedBytes += size;
+}
+
+void wxAllocationTracker::Reset()
+{
+#if wxUSE_THREADS
+    wxCriticalSectionLocker lock(wxAllocLock());
+#endif
+
+    for ( int n = 0; n < wxALLOC_TAG_MAX; n++ )
+    {
+        wxAllocTagData& data = gs_allocData[n];
+        data.stats = wxAllocationStats();
+
+#if wxUSE_STACKWALKER
+        for ( size_t i = 0; i < wxALLOC_MAX_SAMPLED_STACKS; i++ )
+            data.stacks[i].clear();
+        data.numStacks =
+        data.nextStack = 0;
+#endif
+    }
+
+    gs_allocsSinceSample = 0;
+}
+
+wxAllocationStats wxAllocationTracker::GetStats(wxAllocTag tag)
+{
+    wxCHECK_MSG( tag < wxALLOC_TAG_MAX, wxAllocationStats(),
+                 wxS("invalid allocation tag") );
+
+#if wxUSE_THREADS
+    wxCriticalSectionLocker lock(wxAllocLock());
+#endif
+
+    return gs_allocData[tag].stats;
+}
+
+/* static */
+wxString wxAllocationTracker::GetTagName(wxAllocTag tag)
+{
+    switch ( tag )
+    {
+        case wxALLOC_TAG_STRINGS:
+            return wxS("strings");
+        case wxALLOC_TAG_EVENTS:
+            return wxS("events");
+        case wxALLOC_TAG_IMAGES:
+            return wxS("images");
+        case wxALLOC_TAG_SIZERS:
+            return wxS("sizers");
+        case wxALLOC_TAG_OTHER:
+            return wxS("other");
+        case wxALLOC_TAG_MAX:
+            break;
+    }
+
+    wxFAIL_MSG( wxS("invalid allocation tag") );
+
+    return wxString();
+}
+
+void wxAllocationTracker::SetStackSampleInterval(unsigned long interval)
+{
+#if wxUSE_THREADS
+    wxCriticalSectionLocker lock(wxAllocLock());
+#endif
+
+    gs_stackInterval = interval;
+    gs_allocsSinceSample = 0;
+}
+
+wxArrayString wxAllocationTracker::GetSampledStacks(wxAllocTag tag)
+{
+    wxArrayString stacks;
+
+    wxCHECK_MSG( tag < wxALLOC_TAG_MAX, stacks,
+                 wxS("invalid allocation tag") );
+
+#if wxUSE_STACKWALKER
+#if wxUSE_THREADS
+    wxCriticalSectionLocker lock(wxAllocLock());
+#endif
+
+    const wxAllocTagData& data = gs_allocData[tag];
+
+    // start with the oldest stack if the ring has wrapped around
+    size_t pos = data.numStacks == wxALLOC_MAX_SAMPLED_STACKS ? data.nextStack
+                                                              : 0;
+    for ( size_t n = 0; n < data.numStacks; n++ )
+    {
+        stacks.push_back(data.stacks[pos]);
+        if ( ++pos == wxALLOC_MAX_SAMPLED_STACKS )
+            pos = 0;
+    }
+#endif // wxUSE_STACKWALKER
+
+    return stacks;
+}
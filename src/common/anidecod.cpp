@@ -18,9 +18,16 @@
     #include "wx/palette.h"
 #endif
 
+#include "wx/mstream.h"
+
 #include <stdlib.h>
 #include <string.h>
 
+// Number of decoded icons kept in memory simultaneously: icons are decoded
+// on demand from the compressed chunk data, so this bounds the memory used
+// by a loaded animation.
+static const unsigned int wxANI_ICON_CACHE_SIZE = 4;
+
 // static
 wxCURHandler wxANIDecoder::sm_handler;
 
@@ -60,10 +67,55 @@ wxANIDecoder::~wxANIDecoder()
 bool wxANIDecoder::ConvertToImage(unsigned int frame, wxImage *image) const
 {
     unsigned int idx = m_info[frame].m_imageIndex;
-    *image = m_images[idx];       // copy
+    *image = GetIcon(idx);       // copy
     return image->IsOk();
 }
 
+const wxImage& wxANIDecoder::GetIcon(unsigned int idx) const
+{
+    wxCHECK_MSG( idx < m_iconData.size(), wxNullImage,
+                 wxT("invalid icon index") );
+
+    if ( m_images[idx].IsOk() )
+    {
+        // already decoded, just move it to the most recently used position
+        for ( size_t i = 0; i < m_iconLRU.size(); i++ )
+        {
+            if ( m_iconLRU[i] == idx )
+            {
+                m_iconLRU.erase(m_iconLRU.begin() + i);
+                break;
+            }
+        }
+        m_iconLRU.push_back(idx);
+
+        return m_images[idx];
+    }
+
+    wxMemoryInputStream mstream(m_iconData[idx].GetData(),
+                                m_iconData[idx].GetDataLen());
+
+    wxImage image;
+    // use DoLoadFile() and not LoadFile()!
+    if ( sm_handler.DoLoadFile(&image, mstream, false /* verbose */, -1) )
+    {
+        image.SetType(wxBITMAP_TYPE_ANI);
+
+        // evict the least recently used icon if the cache is full: its
+        // compressed data is kept, so it can always be decoded again later
+        if ( m_iconLRU.size() >= wxANI_ICON_CACHE_SIZE )
+        {
+            m_images[m_iconLRU[0]] = wxImage();
+            m_iconLRU.erase(m_iconLRU.begin());
+        }
+
+        m_images[idx] = image;
+        m_iconLRU.push_back(idx);
+    }
+
+    return m_images[idx];
+}
+
 
 //---------------------------------------------------------------------------
 // Data accessors
@@ -96,12 +148,13 @@ wxColour wxANIDecoder::GetTransparentColour(unsigned int frame) const
 {
     unsigned int idx = m_info[frame].m_imageIndex;
 
-    if (!m_images[idx].HasMask())
+    const wxImage& image = GetIcon(idx);
+    if (!image.HasMask())
         return wxNullColour;
 
-    return wxColour(m_images[idx].GetMaskRed(),
-                    m_images[idx].GetMaskGreen(),
-                    m_images[idx].GetMaskBlue());
+    return wxColour(image.GetMaskRed(),
+                    image.GetMaskGreen(),
+                    image.GetMaskBlue());
 }
 
 
@@ -234,7 +287,9 @@ bool wxANIDecoder::Load( wxInputStream& stream )
     m_nFrames = 0;
     m_szAnimation = wxDefaultSize;
 
+    m_iconData.clear();
     m_images.Clear();
+    m_iconLRU.clear();
     m_info.Clear();
 
     // we have a riff file:
@@ -311,13 +366,17 @@ bool wxANIDecoder::Load( wxInputStream& stream )
         }
         else if ( FCC1 == ico32 )
         {
-            // use DoLoadFile() and not LoadFile()!
-            wxImage image;
-            if (!sm_handler.DoLoadFile(&image, stream, false /* verbose */, -1))
+            // store the still compressed icon data: the corresponding image
+            // is only decoded on demand (see GetIcon), so that loading an
+            // animation costs memory proportional to the file size instead
+            // of the total decoded size of all its frames
+            wxMemoryBuffer data;
+            stream.Read(data.GetWriteBuf(datalen), datalen);
+            if ( stream.LastRead() != datalen )
                 return false;
+            data.UngetWriteBuf(datalen);
 
-            image.SetType(wxBITMAP_TYPE_ANI);
-            m_images.Add(image);
+            m_iconData.push_back(data);
         }
         else
         {
@@ -335,10 +394,13 @@ bool wxANIDecoder::Load( wxInputStream& stream )
         //      exiting this loop (if stream.Eof() == true)
     }
 
-    if (m_nFrames==0)
+    if (m_nFrames==0 || m_iconData.empty())
         return false;
 
-    if (m_nFrames==m_images.GetCount())
+    // the decoded icons cache uses the same indices as m_iconData
+    m_images.Add(wxImage(), m_iconData.size());
+
+    if (m_nFrames==m_iconData.size())
     {
         // if no SEQ chunk is available, display the frames in the order
         // they were loaded
@@ -353,11 +415,18 @@ bool wxANIDecoder::Load( wxInputStream& stream )
         if (m_info[i].m_delay == 0)
             m_info[i].m_delay = globaldelay;
 
+    // decode the first icon now: it is normally shown immediately after
+    // loading anyhow and this validates that the image data can actually
+    // be decoded
+    const wxImage& icon0 = GetIcon(0);
+    if (!icon0.IsOk())
+        return false;
+
     // if the header did not contain a valid frame size, try to grab
     // it from the size of the first frame (all frames are of the same size)
     if (m_szAnimation.GetWidth() == 0 ||
         m_szAnimation.GetHeight() == 0)
-        m_szAnimation = wxSize(m_images[0].GetWidth(), m_images[0].GetHeight());
+        m_szAnimation = wxSize(icon0.GetWidth(), icon0.GetHeight());
 
     return m_szAnimation != wxDefaultSize;
 }
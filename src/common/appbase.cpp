@@ -43,6 +43,7 @@
 #include "wx/tokenzr.h"
 #include "wx/thread.h"
 #include "wx/stdpaths.h"
+#include "wx/stopwatch.h"
 
 #if wxUSE_EXCEPTIONS
     // Do we have a C++ compiler with enough C++11 support for
@@ -145,6 +146,8 @@ wxAppConsole *wxAppConsoleBase::ms_appInstance = NULL;
 
 wxAppInitializerFunction wxAppConsoleBase::ms_appInitFn = NULL;
 
+long wxAppConsoleBase::ms_pendingDeleteBudget = 0;
+
 wxSocketManager *wxAppTraitsBase::ms_manager = NULL;
 
 WXDLLIMPEXP_DATA_BASE(wxList) wxPendingDelete;
@@ -436,8 +439,12 @@ bool wxAppConsoleBase::ProcessIdle()
     wxLog::FlushActive();
 #endif
 
-    // Garbage collect all objects previously scheduled for destruction.
-    DeletePendingObjects();
+    // Garbage collect the objects previously scheduled for destruction: if a
+    // budget is set, only spend that much time destroying them and ask for
+    // another idle event to continue with the rest, this keeps the UI
+    // responsive when many windows are torn down at once.
+    if ( DoDeletePendingObjects(ms_pendingDeleteBudget) )
+        return true;
 
     return event.MoreRequested();
 }
@@ -620,6 +627,15 @@ void wxAppConsoleBase::ScheduleForDestruction(wxObject *object)
 
 void wxAppConsoleBase::DeletePendingObjects()
 {
+    // no budget here: this is notably used during the program shutdown when
+    // all the remaining objects must be destroyed, however long it takes
+    DoDeletePendingObjects(0);
+}
+
+bool wxAppConsoleBase::DoDeletePendingObjects(long budget)
+{
+    wxStopWatch sw;
+
     wxList::compatibility_iterator node = wxPendingDelete.GetFirst();
     while (node)
     {
@@ -633,10 +649,19 @@ void wxAppConsoleBase::DeletePendingObjects()
 
         delete obj;
 
+        if ( budget > 0 && sw.Time() >= budget )
+        {
+            // Out of time: whatever remains in the list will be destroyed
+            // during the next pass.
+            break;
+        }
+
         // Deleting one object may have deleted other pending
         // objects, so start from beginning of list again.
         node = wxPendingDelete.GetFirst();
     }
+
+    return !wxPendingDelete.IsEmpty();
 }
 
 // ----------------------------------------------------------------------------
@@ -36,6 +36,7 @@
 #include "wx/cmdline.h"
 #include "wx/msgout.h"
 #include "wx/richmsgdlg.h"
+#include "wx/stopwatch.h"
 #include "wx/thread.h"
 #include "wx/vidmode.h"
 #include "wx/evtloop.h"
@@ -402,16 +403,102 @@ bool wxAppBase::ProcessIdle()
     // itself
     bool needMore = wxAppConsoleBase::ProcessIdle();
     wxIdleEvent event;
+
+    const long budget = wxIdleEvent::GetDispatchBudget();
+    wxStopWatch sw;
+
+    // Positions at which the previous pass ran out of budget: resuming from
+    // them spreads the idle work evenly over all the windows instead of
+    // always starting at the list head and starving the windows at its tail.
+    static size_t s_nextTopLevel = 0;
+    static size_t s_nextIdleWindow = 0;
+
+    // Walk the top level windows: this sends the idle events to all windows
+    // in wxIDLE_PROCESS_ALL mode and performs the internal idle processing,
+    // e.g. wxUpdateUIEvent handling, of every window in any mode.
+    const size_t tlwCount = wxTopLevelWindows.GetCount();
+    if ( s_nextTopLevel >= tlwCount )
+        s_nextTopLevel = 0;
+
+    size_t pos = 0;
     wxWindowList::compatibility_iterator node = wxTopLevelWindows.GetFirst();
-    while (node)
+    for ( ; pos < s_nextTopLevel; pos++ )
+        node = node->GetNext();
+
+    for ( size_t visited = 0; visited < tlwCount; visited++ )
     {
-        wxWindow* win = node->GetData();
+        if ( !node )
+        {
+            node = wxTopLevelWindows.GetFirst();
+            pos = 0;
+        }
+
+        wxWindow* const win = node->GetData();
+        node = node->GetNext();
+        pos++;
 
         // Don't send idle events to the windows that are about to be destroyed
         // anyhow, this is wasteful and unexpected.
         if ( !wxPendingDelete.Member(win) && win->SendIdleEvents(event) )
             needMore = true;
-        node = node->GetNext();
+
+        if ( budget > 0 && sw.Time() >= budget )
+        {
+            // Out of time: remember where to continue during the next pass
+            // and ask for it to happen as soon as possible.
+            s_nextTopLevel = pos < tlwCount ? pos : 0;
+            wxUpdateUIEvent::ResetUpdateTime();
+            return true;
+        }
+    }
+
+    s_nextTopLevel = 0;
+
+    if ( wxIdleEvent::GetMode() == wxIDLE_PROCESS_SPECIFIED )
+    {
+        // Only the windows which requested idle events using the
+        // wxWS_EX_PROCESS_IDLE extra style get them and they are sent
+        // directly from here instead of walking the window tree again.
+        const wxWindowList& idleWindows = wxWindowBase::GetIdleWindows();
+        const size_t count = idleWindows.GetCount();
+        if ( s_nextIdleWindow >= count )
+            s_nextIdleWindow = 0;
+
+        pos = 0;
+        node = idleWindows.GetFirst();
+        for ( ; pos < s_nextIdleWindow; pos++ )
+            node = node->GetNext();
+
+        for ( size_t visited = 0; visited < count; visited++ )
+        {
+            if ( !node )
+            {
+                node = idleWindows.GetFirst();
+                pos = 0;
+            }
+
+            wxWindow* const win = node->GetData();
+            node = node->GetNext();
+            pos++;
+
+            if ( !wxPendingDelete.Member(win) )
+            {
+                event.SetEventObject(win);
+                win->HandleWindowEvent(event);
+
+                if ( event.MoreRequested() )
+                    needMore = true;
+            }
+
+            if ( budget > 0 && sw.Time() >= budget )
+            {
+                s_nextIdleWindow = pos < count ? pos : 0;
+                wxUpdateUIEvent::ResetUpdateTime();
+                return true;
+            }
+        }
+
+        s_nextIdleWindow = 0;
     }
 
     wxUpdateUIEvent::ResetUpdateTime();
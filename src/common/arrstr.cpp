@@ -18,6 +18,8 @@
 
 #include "wx/arrstr.h"
 #include "wx/scopedarray.h"
+#include "wx/thread.h"
+#include "wx/vector.h"
 #include "wx/wxcrt.h"
 
 #include "wx/beforestd.h"
@@ -25,6 +27,276 @@
 #include <functional>
 #include "wx/afterstd.h"
 
+// ----------------------------------------------------------------------------
+// string sorting helpers
+// ----------------------------------------------------------------------------
+
+// The functions here implement an MSD radix sort (three-way radix quicksort,
+// also known as multikey quicksort) specialized for sorting strings in the
+// default case-sensitive order: unlike std::sort(), it doesn't compare the
+// common prefixes of the strings over and over again, which makes a big
+// difference for the large arrays with many similar strings typically being
+// sorted.
+//
+// The strings themselves are not moved around while sorting: we sort an array
+// of small key structures pointing into them and only apply the resulting
+// permutation to the strings at the end, using O(1) wxString::swap().
+
+namespace
+{
+
+#if wxUSE_UNICODE_UTF8
+// std::string compares its contents as unsigned chars, so we must do the same
+// to sort in exactly the same order as operator<().
+typedef unsigned char wxStringSortUnit;
+#else
+typedef wxStringCharType wxStringSortUnit;
+#endif
+
+struct wxStringSortKey
+{
+    const wxStringSortUnit *data;   // code units of the string
+    size_t len;                     // their number
+    size_t idx;                     // original index of the string
+};
+
+// Return the code unit at the given depth or -1 when past the end of the
+// string, so that shorter strings sort before their extensions.
+inline long wxStringSortUnitAt(const wxStringSortKey& k, size_t depth)
+{
+    return depth < k.len ? static_cast<long>(k.data[depth]) : -1;
+}
+
+// Compare the full keys starting at the given depth (the units before it are
+// already known to be equal).
+int wxCompareSortKeys(const wxStringSortKey& k1,
+                      const wxStringSortKey& k2,
+                      size_t depth)
+{
+    const size_t len = k1.len < k2.len ? k1.len : k2.len;
+    for ( size_t i = depth; i < len; i++ )
+    {
+        if ( k1.data[i] != k2.data[i] )
+            return k1.data[i] < k2.data[i] ? -1 : 1;
+    }
+
+    return k1.len == k2.len ? 0 : k1.len < k2.len ? -1 : 1;
+}
+
+struct wxSortKeyLess
+{
+    bool operator()(const wxStringSortKey& k1, const wxStringSortKey& k2) const
+    {
+        return wxCompareSortKeys(k1, k2, 0) < 0;
+    }
+};
+
+// Simple insertion sort used for the small ranges where the overhead of the
+// recursive partitioning isn't worth it.
+void wxInsertionSortKeys(wxStringSortKey *keys, size_t n, size_t depth)
+{
+    for ( size_t i = 1; i < n; i++ )
+    {
+        const wxStringSortKey key = keys[i];
+        size_t j = i;
+        for ( ; j > 0 && wxCompareSortKeys(keys[j - 1], key, depth) > 0; j-- )
+            keys[j] = keys[j - 1];
+        keys[j] = key;
+    }
+}
+
+const size_t wxRADIX_SORT_CUTOFF = 32;
+
+inline long wxMedian3(long a, long b, long c)
+{
+    if ( a > b )
+        wxSwap(a, b);
+    if ( b > c )
+        b = c;
+    return a > b ? a : b;
+}
+
+void wxMultikeySortKeys(wxStringSortKey *keys, size_t n, size_t depth)
+{
+    for ( ;; )
+    {
+        if ( n <= wxRADIX_SORT_CUTOFF )
+        {
+            wxInsertionSortKeys(keys, n, depth);
+            return;
+        }
+
+        const long pivot = wxMedian3(wxStringSortUnitAt(keys[0], depth),
+                                     wxStringSortUnitAt(keys[n / 2], depth),
+                                     wxStringSortUnitAt(keys[n - 1], depth));
+
+        // Three-way partition on the unit at the current depth.
+        size_t lo = 0,
+               i = 0,
+               hi = n;
+        while ( i < hi )
+        {
+            const long v = wxStringSortUnitAt(keys[i], depth);
+            if ( v < pivot )
+                std::swap(keys[lo++], keys[i++]);
+            else if ( v > pivot )
+                std::swap(keys[i], keys[--hi]);
+            else
+                i++;
+        }
+
+        // Recurse into the "less" and "greater" parts and iterate on the
+        // "equal" one with the next unit, unless it consists of the strings
+        // which all ended at this depth and so are equal to each other.
+        wxMultikeySortKeys(keys, lo, depth);
+        wxMultikeySortKeys(keys + hi, n - hi, depth);
+
+        if ( pivot < 0 )
+            return;
+
+        keys += lo;
+        n = hi - lo;
+        depth++;
+    }
+}
+
+#if wxUSE_THREADS
+
+// Worker thread sorting its part of the keys array.
+class wxStringSortThread : public wxThread
+{
+public:
+    wxStringSortThread(wxStringSortKey *keys, size_t n)
+        : wxThread(wxTHREAD_JOINABLE), m_keys(keys), m_n(n)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() wxOVERRIDE
+    {
+        wxMultikeySortKeys(m_keys, m_n, 0);
+        return NULL;
+    }
+
+private:
+    wxStringSortKey * const m_keys;
+    const size_t m_n;
+
+    wxDECLARE_NO_COPY_CLASS(wxStringSortThread);
+};
+
+// Sorting fewer strings than this in parallel isn't worth the overhead of
+// creating the threads.
+const size_t wxPARALLEL_SORT_THRESHOLD = 100000;
+
+#endif // wxUSE_THREADS
+
+void wxSortKeys(wxStringSortKey *keys, size_t count)
+{
+#if wxUSE_THREADS
+    const int numCPUs = wxThread::GetCPUCount();
+    if ( count >= wxPARALLEL_SORT_THRESHOLD && numCPUs > 1 )
+    {
+        const size_t numParts = numCPUs > 8 ? 8 : numCPUs;
+        const size_t chunk = count / numParts;
+
+        // Sort each chunk in its own thread, except the last (and possibly
+        // slightly bigger) one which is sorted here.
+        wxVector<wxStringSortThread *> threads;
+        for ( size_t i = 0; i < numParts - 1; i++ )
+        {
+            wxStringSortThread * const
+                t = new wxStringSortThread(keys + i*chunk, chunk);
+            if ( t->Run() != wxTHREAD_NO_ERROR )
+            {
+                // Couldn't start the thread, just do its work ourselves.
+                delete t;
+                wxMultikeySortKeys(keys + i*chunk, chunk, 0);
+            }
+            else
+            {
+                threads.push_back(t);
+            }
+        }
+
+        wxMultikeySortKeys(keys + (numParts - 1)*chunk,
+                           count - (numParts - 1)*chunk,
+                           0);
+
+        for ( size_t i = 0; i < threads.size(); i++ )
+        {
+            threads[i]->Wait();
+            delete threads[i];
+        }
+
+        // Now merge the sorted chunks pairwise, bottom-up.
+        for ( size_t width = chunk; width < count; width *= 2 )
+        {
+            for ( size_t pos = 0; pos + width < count; pos += 2*width )
+            {
+                const size_t end = pos + 2*width < count ? pos + 2*width
+                                                         : count;
+                std::inplace_merge(keys + pos, keys + pos + width, keys + end,
+                                   wxSortKeyLess());
+            }
+        }
+
+        return;
+    }
+#endif // wxUSE_THREADS
+
+    wxMultikeySortKeys(keys, count, 0);
+}
+
+// Sort the strings in the default ascending order of operator<().
+void wxSortStringsRadix(wxString *items, size_t count)
+{
+    if ( count < 2 )
+        return;
+
+    wxScopedArray<wxStringSortKey> keys(new wxStringSortKey[count]);
+    for ( size_t i = 0; i < count; i++ )
+    {
+        wxStringSortKey& k = keys[i];
+#if wxUSE_UNICODE_UTF8
+        k.data = reinterpret_cast<const unsigned char *>(items[i].wx_str());
+        k.len = items[i].utf8_length();
+#else
+        k.data = items[i].wx_str();
+        k.len = items[i].length();
+#endif
+        k.idx = i;
+    }
+
+    wxSortKeys(keys.get(), count);
+
+    // Apply the resulting permutation to the strings, cycle by cycle, using
+    // cheap swaps: after this loop items[i] is the string which was
+    // originally at keys[i].idx.
+    for ( size_t i = 0; i < count; i++ )
+    {
+        if ( keys[i].idx == i )
+            continue;
+
+        wxString tmp;
+        tmp.swap(items[i]);
+
+        size_t j = i;
+        while ( keys[j].idx != i )
+        {
+            const size_t next = keys[j].idx;
+            items[j].swap(items[next]);
+            keys[j].idx = j;
+            j = next;
+        }
+
+        items[j].swap(tmp);
+        keys[j].idx = j;
+    }
+}
+
+} // anonymous namespace
+
 // ============================================================================
 // ArrayString
 // ============================================================================
@@ -164,14 +436,35 @@ void wxArrayString::Sort(CompareFunction function)
 
 void wxArrayString::Sort(bool reverseOrder)
 {
-    if (reverseOrder)
-    {
-        std::sort(begin(), end(), std::greater<wxString>());
-    }
-    else
-    {
-        std::sort(begin(), end());
-    }
+    if ( size() > 1 )
+        wxSortStringsRadix(&*begin(), size());
+
+    if ( reverseOrder )
+        std::reverse(begin(), end());
+}
+
+void wxSortedArrayString::AddBulk(const wxArrayString& items)
+{
+    if ( items.empty() )
+        return;
+
+    // Instead of doing a O(N) insertion for each item, append them all, sort
+    // just the new part and merge it with the already sorted one.
+    const size_t mid = size();
+    this->insert(this->end(), items.begin(), items.end());
+
+    SCMPFUNC function = GetCompareFunction();
+#if __cplusplus >= 201103L || wxCHECK_VISUALC_VERSION(14)
+    const auto pred = [function](const wxString& s1, const wxString& s2)
+                      {
+                          return function(s1, s2) < 0;
+                      };
+    std::sort(begin() + mid, end(), pred);
+    std::inplace_merge(begin(), begin() + mid, end(), pred);
+#else // C++98 version
+    std::sort(begin() + mid, end(), wxStringCompare(function));
+    std::inplace_merge(begin(), begin() + mid, end(), wxStringCompare(function));
+#endif // C++11/C++98
 }
 
 int wxSortedArrayString::Index(const wxString& str,
@@ -345,7 +638,7 @@ void wxArrayString::Alloc(size_t nSize)
 }
 
 // minimizes the memory usage by freeing unused memory
-void wxArrayString::Shrink()
+void wxArrayString::Shrink(bool shrinkStrings)
 {
   // only do it if we have some memory to free
   if( m_nCount < m_nSize ) {
@@ -359,6 +652,13 @@ void wxArrayString::Shrink()
     m_pItems = pNew;
     m_nSize = m_nCount;
   }
+
+  // long-lived arrays can also accumulate a lot of slack inside the strings
+  // themselves, so optionally compact them too
+  if ( shrinkStrings ) {
+    for ( size_t j = 0; j < m_nCount; j++ )
+        m_pItems[j].Shrink();
+  }
 }
 
 // Binary search in the sorted array
@@ -582,10 +882,64 @@ void wxArrayString::Sort(CompareFunction2 compareFunction)
 
 void wxArrayString::Sort(bool reverseOrder)
 {
+    wxSortStringsRadix(m_pItems, m_nCount);
+
     if ( reverseOrder )
-        std::sort(m_pItems, m_pItems + m_nCount, std::greater<wxString>());
-    else // normal sort
-        std::sort(m_pItems, m_pItems + m_nCount);
+        std::reverse(m_pItems, m_pItems + m_nCount);
+}
+
+// add many items at once to a sorted array
+void wxArrayString::DoAddBulk(const wxArrayString& items)
+{
+    wxCHECK_RET( m_autoSort, wxT("can only be used with sorted arrays") );
+
+    const size_t nAdd = items.GetCount();
+    if ( !nAdd )
+        return;
+
+    // Instead of doing a O(N) insertion for each item, sort a copy of the new
+    // items once and merge it with the already sorted contents.
+    wxScopedArray<wxString> sorted(new wxString[nAdd]);
+    for ( size_t n = 0; n < nAdd; n++ )
+        sorted[n] = items[n];
+
+    if ( m_compareFunction )
+    {
+        std::sort(sorted.get(), sorted.get() + nAdd,
+                  wxSortPredicateAdaptor(m_compareFunction));
+    }
+    else // default order, use the fast string sort
+    {
+        wxSortStringsRadix(sorted.get(), nAdd);
+    }
+
+    const size_t total = m_nCount + nAdd;
+    wxString * const merged = new wxString[total];
+
+    size_t i = 0,
+           j = 0;
+    for ( size_t k = 0; k < total; k++ )
+    {
+        bool takeOld;
+        if ( i == m_nCount )
+            takeOld = false;
+        else if ( j == nAdd )
+            takeOld = true;
+        else if ( m_compareFunction )
+            takeOld = m_compareFunction(m_pItems[i], sorted[j]) <= 0;
+        else
+            takeOld = m_pItems[i].Cmp(sorted[j]) <= 0;
+
+        if ( takeOld )
+            merged[k].swap(m_pItems[i++]);
+        else
+            merged[k].swap(sorted[j++]);
+    }
+
+    delete [] m_pItems;
+    m_pItems = merged;
+    m_nSize =
+    m_nCount = total;
 }
 
 bool wxArrayString::operator==(const wxArrayString& a) const
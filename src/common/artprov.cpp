@@ -118,6 +118,7 @@ bool wxArtProviderCache::GetIconBundle(const wxString& full_id, wxIconBundle* bm
 void wxArtProviderCache::Clear()
 {
     m_bitmapsHash.clear();
+    m_bitmapsBundlesHash.clear();
     m_iconBundlesHash.clear();
 }
 
@@ -260,6 +261,19 @@ void wxArtProvider::RescaleBitmap(wxBitmap& bmp, const wxSize& sizeNeeded)
         }
 
         wxSize sizeNeeded = size;
+        if ( !bmp.IsOk() )
+        {
+            // the provider may implement CreateBitmapBundle() only, so try
+            // getting a bitmap of the right size from a bundle: this also
+            // ensures that bundle-based art (e.g. rendered from vector data)
+            // is rasterized just once per size and then shared via the cache
+            // by all the windows using it
+            const wxBitmapBundle
+                bitmapbundle = GetBitmapBundle(id, client, size);
+            if ( bitmapbundle.IsOk() )
+                bmp = bitmapbundle.GetBitmap(size);
+        }
+
         if ( !bmp.IsOk() )
         {
             // no bitmap created -- as a fallback, try if we can find desired
@@ -305,7 +319,10 @@ wxBitmapBundle wxArtProvider::GetBitmapBundle(const wxArtID& id,
 
     wxCHECK_MSG( sm_providers, wxNullBitmap, wxT("no wxArtProvider exists") );
 
-    wxString hashId = wxArtProviderCache::ConstructHashID(id, client);
+    // notice that the size is part of the key as it is passed to the
+    // providers as the default size hint, so the bundles created for
+    // different sizes may differ
+    wxString hashId = wxArtProviderCache::ConstructHashID(id, client, size);
 
     wxBitmapBundle bitmapbundle; // (DoGetIconBundle(id, client));
 
@@ -369,6 +386,20 @@ wxIconBundle wxArtProvider::DoGetIconBundle(const wxArtID& id, const wxArtClient
     return iconbundle;
 }
 
+/*static*/ void wxArtProvider::Prefetch(const wxVector<wxArtID>& ids,
+                                        const wxArtClient& client,
+                                        const wxSize& size)
+{
+    // this must be done in the main thread, as the bitmap creation is not
+    // thread-safe in any of the ports, but doing it in one batch before the
+    // bitmaps are actually needed still avoids doing it lazily in the middle
+    // of e.g. rebuilding the toolbars of all the application windows
+    for ( size_t n = 0; n < ids.size(); n++ )
+    {
+        GetBitmap(ids[n], client, size);
+    }
+}
+
 /*static*/ wxIcon wxArtProvider::GetIcon(const wxArtID& id,
                                          const wxArtClient& client,
                                          const wxSize& size)
@@ -13,6 +13,191 @@
 
 #include "wx/base64.h"
 
+#include <string.h>
+
+// ----------------------------------------------------------------------------
+// local helpers
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+const char b64chars[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// special values used in the decoding table below for white space, invalid
+// characters and '=' respectively
+enum
+{
+    WSP = 200,
+    INV,
+    PAD
+};
+
+// this table contains the values, in base 64, of all valid characters and
+// the special values above for everything else
+const unsigned char b64decode[256] =
+{
+    WSP,INV,INV,INV,INV,INV,INV,INV,INV,WSP,WSP,INV,WSP,WSP,INV,INV,
+    INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
+    WSP,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,076,INV,INV,INV,077,
+    064,065,066,067,070,071,072,073,074,075,INV,INV,INV,PAD,INV,INV,
+    INV,000,001,002,003,004,005,006,007,010,011,012,013,014,015,016,
+    017,020,021,022,023,024,025,026,027,030,031,INV,INV,INV,INV,INV,
+    INV,032,033,034,035,036,037,040,041,042,043,044,045,046,047,050,
+    051,052,053,054,055,056,057,060,061,062,063,INV,INV,INV,INV,INV,
+    INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
+    INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
+    INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
+    INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
+    INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
+    INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
+    INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
+    INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
+};
+
+// Vectorized kernels translating whole blocks at once using byte shuffles:
+// as elsewhere in the library, they're only used when the instruction set is
+// enabled at compile time.
+
+#if defined(__SSSE3__)
+
+#include <tmmintrin.h>
+
+#define wxHAVE_BASE64_SSSE3
+
+// Encode 12 input bytes into 16 base64 characters. Note that 16 input bytes
+// are loaded, so the caller must ensure that at least this many are readable.
+inline void wxBase64EncodeBlockSSSE3(char *dst, const unsigned char *src)
+{
+    __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+
+    // duplicate each 3 byte group into a 32 bit lane
+    in = _mm_shuffle_epi8(in, _mm_set_epi8(10,11, 9,10, 7,8, 6,7,
+                                            4, 5, 3, 4, 1,2, 0,1));
+
+    // isolate the four 6 bit indices of each group in separate bytes
+    const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+    const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+    const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    const __m128i indices = _mm_or_si128(t1, t3);
+
+    // translate the indices to ASCII by adding a shift depending on the
+    // alphabet range each one falls into
+    __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+    range = _mm_or_si128(range, _mm_and_si128(less, _mm_set1_epi8(13)));
+
+    const __m128i shiftLUT = _mm_setr_epi8(
+            'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+            '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+            '/' - 63, 'A', 0, 0);
+    const __m128i result =
+        _mm_add_epi8(_mm_shuffle_epi8(shiftLUT, range), indices);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), result);
+}
+
+// Decode 16 base64 characters into 12 bytes, returning false without writing
+// anything if the block contains any character, including white space and
+// padding, outside of the base64 alphabet.
+inline bool wxBase64DecodeBlockSSSE3(unsigned char *dst, const char *src)
+{
+    const __m128i in =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+
+    const __m128i loNibble = _mm_and_si128(in, _mm_set1_epi8(0x0f));
+    const __m128i hiNibble =
+        _mm_and_si128(_mm_srli_epi32(in, 4), _mm_set1_epi8(0x0f));
+
+    // validate all the characters at once: each one is valid only if the bit
+    // corresponding to its high nibble is set in the mask indexed by its low
+    // nibble
+    const __m128i maskLUT = _mm_setr_epi8(
+        /* 0        */ char(0xa8),
+        /* 1 .. 9   */ char(0xf8), char(0xf8), char(0xf8), char(0xf8),
+                       char(0xf8), char(0xf8), char(0xf8), char(0xf8),
+                       char(0xf8),
+        /* 10       */ char(0xf0),
+        /* 11       */ 0x54,
+        /* 12 .. 14 */ 0x50, 0x50, 0x50,
+        /* 15       */ 0x54);
+
+    const __m128i bitposLUT = _mm_setr_epi8(
+        0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, char(0x80),
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00);
+
+    const __m128i mask = _mm_shuffle_epi8(maskLUT, loNibble);
+    const __m128i bit = _mm_shuffle_epi8(bitposLUT, hiNibble);
+
+    const __m128i nonMatch =
+        _mm_cmpeq_epi8(_mm_and_si128(mask, bit), _mm_setzero_si128());
+    if ( _mm_movemask_epi8(nonMatch) )
+        return false;
+
+    // translate ASCII to the 6 bit values by adding a per-range shift
+    const __m128i shiftLUT = _mm_setr_epi8(
+        0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+
+    const __m128i eq2F = _mm_cmpeq_epi8(in, _mm_set1_epi8(0x2f));
+    const __m128i sh = _mm_shuffle_epi8(shiftLUT, hiNibble);
+    const __m128i shift = _mm_or_si128(_mm_andnot_si128(eq2F, sh),
+                                       _mm_and_si128(eq2F, _mm_set1_epi8(16)));
+    const __m128i values = _mm_add_epi8(in, shift);
+
+    // pack the four 6 bit values of each quartet into three bytes
+    const __m128i merged = _mm_madd_epi16(
+        _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140)),
+        _mm_set1_epi32(0x00011000));
+    const __m128i packed = _mm_shuffle_epi8(merged,
+        _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+    unsigned char buf[16];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(buf), packed);
+    memcpy(dst, buf, 12);
+
+    return true;
+}
+
+#elif defined(__aarch64__) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+
+#include <arm_neon.h>
+
+#define wxHAVE_BASE64_NEON
+
+// Encode 48 input bytes into 64 base64 characters using a full table lookup.
+inline void wxBase64EncodeBlockNEON(char *dst, const unsigned char *src)
+{
+    uint8x16x4_t tbl;
+    tbl.val[0] = vld1q_u8(reinterpret_cast<const uint8_t *>(b64chars));
+    tbl.val[1] = vld1q_u8(reinterpret_cast<const uint8_t *>(b64chars) + 16);
+    tbl.val[2] = vld1q_u8(reinterpret_cast<const uint8_t *>(b64chars) + 32);
+    tbl.val[3] = vld1q_u8(reinterpret_cast<const uint8_t *>(b64chars) + 48);
+
+    const uint8x16x3_t in = vld3q_u8(src);
+
+    uint8x16x4_t out;
+    out.val[0] = vqtbl4q_u8(tbl, vshrq_n_u8(in.val[0], 2));
+    out.val[1] = vqtbl4q_u8(tbl,
+            vorrq_u8(vshlq_n_u8(vandq_u8(in.val[0], vdupq_n_u8(0x03)), 4),
+                     vshrq_n_u8(in.val[1], 4)));
+    out.val[2] = vqtbl4q_u8(tbl,
+            vorrq_u8(vshlq_n_u8(vandq_u8(in.val[1], vdupq_n_u8(0x0f)), 2),
+                     vshrq_n_u8(in.val[2], 6)));
+    out.val[3] = vqtbl4q_u8(tbl, vandq_u8(in.val[2], vdupq_n_u8(0x3f)));
+
+    vst4q_u8(reinterpret_cast<uint8_t *>(dst), out);
+}
+
+#endif // __SSSE3__/NEON
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// encoding
+// ----------------------------------------------------------------------------
+
 size_t
 wxBase64Encode(char *dst, size_t dstLen, const void *src_, size_t srcLen)
 {
@@ -20,11 +205,37 @@ wxBase64Encode(char *dst, size_t dstLen, const void *src_, size_t srcLen)
 
     const unsigned char *src = static_cast<const unsigned char *>(src_);
 
-    static const char b64[] =
-        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    size_t encLen = 0;
 
+#if defined(wxHAVE_BASE64_SSSE3)
+    if ( dst )
+    {
+        // the kernel loads 16 bytes even though it only consumes 12, hence
+        // the stricter length condition
+        while ( srcLen >= 16 && dstLen - encLen >= 16 )
+        {
+            wxBase64EncodeBlockSSSE3(dst, src);
 
-    size_t encLen = 0;
+            dst += 16;
+            encLen += 16;
+            src += 12;
+            srcLen -= 12;
+        }
+    }
+#elif defined(wxHAVE_BASE64_NEON)
+    if ( dst )
+    {
+        while ( srcLen >= 48 && dstLen - encLen >= 64 )
+        {
+            wxBase64EncodeBlockNEON(dst, src);
+
+            dst += 64;
+            encLen += 64;
+            src += 48;
+            srcLen -= 48;
+        }
+    }
+#endif // wxHAVE_BASE64_SSSE3/wxHAVE_BASE64_NEON
 
     // encode blocks of 3 bytes into 4 base64 characters
     for ( ; srcLen >= 3; srcLen -= 3, src += 3 )
@@ -35,10 +246,10 @@ wxBase64Encode(char *dst, size_t dstLen, const void *src_, size_t srcLen)
             if ( encLen > dstLen )
                 return wxCONV_FAILED;
 
-            *dst++ = b64[src[0] >> 2];
-            *dst++ = b64[((src[0] & 0x03) << 4) | ((src[1] & 0xf0) >> 4)];
-            *dst++ = b64[((src[1] & 0x0f) << 2) | ((src[2] & 0xc0) >> 6)];
-            *dst++ = b64[src[2] & 0x3f];
+            *dst++ = b64chars[src[0] >> 2];
+            *dst++ = b64chars[((src[0] & 0x03) << 4) | ((src[1] & 0xf0) >> 4)];
+            *dst++ = b64chars[((src[1] & 0x0f) << 2) | ((src[2] & 0xc0) >> 6)];
+            *dst++ = b64chars[src[2] & 0x3f];
         }
     }
 
@@ -53,9 +264,9 @@ wxBase64Encode(char *dst, size_t dstLen, const void *src_, size_t srcLen)
 
             // we have definitely one and maybe two bytes remaining
             unsigned char next = srcLen == 2 ? src[1] : 0;
-            *dst++ = b64[src[0] >> 2];
-            *dst++ = b64[((src[0] & 0x03) << 4) | ((next & 0xf0) >> 4)];
-            *dst++ = srcLen == 2 ? b64[((next & 0x0f) << 2)] : '=';
+            *dst++ = b64chars[src[0] >> 2];
+            *dst++ = b64chars[((src[0] & 0x03) << 4) | ((next & 0xf0) >> 4)];
+            *dst++ = srcLen == 2 ? b64chars[((next & 0x0f) << 2)] : '=';
             *dst = '=';
         }
     }
@@ -63,149 +274,175 @@ wxBase64Encode(char *dst, size_t dstLen, const void *src_, size_t srcLen)
     return encLen;
 }
 
+// ----------------------------------------------------------------------------
+// decoding
+// ----------------------------------------------------------------------------
+
 size_t
-wxBase64Decode(void *dst_, size_t dstLen,
-               const char *src, size_t srcLen,
-               wxBase64DecodeMode mode,
-               size_t *posErr)
+wxBase64Decoder::Decode(void *dst_, size_t dstLen,
+                        const char *src, size_t srcLen)
 {
     wxCHECK_MSG( src, wxCONV_FAILED, wxT("NULL input buffer") );
 
-    unsigned char *dst = static_cast<unsigned char *>(dst_);
+    unsigned char * const dst = static_cast<unsigned char *>(dst_);
 
     size_t decLen = 0;
 
     if ( srcLen == wxNO_LEN )
         srcLen = strlen(src);
 
-    // this table contains the values, in base 64, of all valid characters and
-    // special values WSP or INV for white space and invalid characters
-    // respectively as well as a special PAD value for '='
-    enum
+    for ( const char *p = src; srcLen; p++, srcLen--, m_pos++ )
     {
-        WSP = 200,
-        INV,
-        PAD
-    };
+#ifdef wxHAVE_BASE64_SSSE3
+        // fast path: decode whole blocks at once while the input contains
+        // nothing but base64 characters, falling back to the loop below for
+        // anything else (white space, padding, junk)
+        if ( dst && !m_n && !m_end && !m_needPad )
+        {
+            while ( srcLen >= 16 && dstLen - decLen >= 12 &&
+                        wxBase64DecodeBlockSSSE3(dst + decLen, p) )
+            {
+                p += 16;
+                srcLen -= 16;
+                m_pos += 16;
+                decLen += 12;
+            }
 
-    static const unsigned char decode[256] =
-    {
-        WSP,INV,INV,INV,INV,INV,INV,INV,INV,WSP,WSP,INV,WSP,WSP,INV,INV,
-        INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
-        WSP,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,076,INV,INV,INV,077,
-        064,065,066,067,070,071,072,073,074,075,INV,INV,INV,PAD,INV,INV,
-        INV,000,001,002,003,004,005,006,007,010,011,012,013,014,015,016,
-        017,020,021,022,023,024,025,026,027,030,031,INV,INV,INV,INV,INV,
-        INV,032,033,034,035,036,037,040,041,042,043,044,045,046,047,050,
-        051,052,053,054,055,056,057,060,061,062,063,INV,INV,INV,INV,INV,
-        INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
-        INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
-        INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
-        INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
-        INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
-        INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
-        INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
-        INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
-    };
-
-    // we decode input by groups of 4 characters but things are complicated by
-    // the fact that there can be whitespace and other junk in it too so keep
-    // record of where exactly we're inside the current quartet in this var
-    int n = 0;
-    unsigned char in[4];                    // current quartet
-    bool end = false;                       // set when we find padding
-    size_t padLen = 0;                      // length lost to padding
-    const char *p;
-    for ( p = src; srcLen; p++, srcLen-- )
-    {
-        const unsigned char c = decode[static_cast<unsigned char>(*p)];
+            if ( !srcLen )
+                break;
+        }
+#endif // wxHAVE_BASE64_SSSE3
+
+        const unsigned char c = b64decode[static_cast<unsigned char>(*p)];
         switch ( c )
         {
             case WSP:
-                if ( mode == wxBase64DecodeMode_SkipWS )
+                if ( m_mode == wxBase64DecodeMode_SkipWS )
                     continue;
                 wxFALLTHROUGH;
 
             case INV:
-                if ( mode == wxBase64DecodeMode_Relaxed )
+                if ( m_mode == wxBase64DecodeMode_Relaxed )
                     continue;
 
-                // force the loop to stop and an error to be returned
-                n = -1;
-                srcLen = 1;
-                break;
+                m_posErr = m_pos;
+                return wxCONV_FAILED;
 
             case PAD:
-                // set the flag telling us that we're past the end now
-                end = true;
+                if ( m_needPad )
+                {
+                    // the second half of "==" completing the quartet
+                    m_needPad = false;
+                    continue;
+                }
 
-                // there can be either a single '=' at the end of a quartet or
-                // "==" in positions 2 and 3
-                if ( n == 3 )
+                if ( m_n == 3 )
                 {
-                    padLen = 1;
-                    in[n++] = '\0';
+                    // a single '=': the quartet decodes to two bytes
+                    decLen += 2;
+                    if ( dst )
+                    {
+                        if ( decLen > dstLen )
+                        {
+                            m_posErr = m_pos;
+                            return wxCONV_FAILED;
+                        }
+
+                        unsigned char *q = dst + decLen - 2;
+                        q[0] = m_in[0] << 2 | m_in[1] >> 4;
+                        q[1] = m_in[1] << 4 | m_in[2] >> 2;
+                    }
                 }
-                else if ( (n == 2) && (--srcLen && *++p == '=') )
+                else if ( m_n == 2 )
                 {
-                    padLen = 2;
-                    in[n++] = '\0';
-                    in[n++] = '\0';
+                    // "==": a single byte, the second '=' is still expected
+                    decLen++;
+                    if ( dst )
+                    {
+                        if ( decLen > dstLen )
+                        {
+                            m_posErr = m_pos;
+                            return wxCONV_FAILED;
+                        }
+
+                        dst[decLen - 1] = m_in[0] << 2 | m_in[1] >> 4;
+                    }
+
+                    m_needPad = true;
                 }
                 else // invalid padding
                 {
-                    // force the loop terminate with an error
-                    n = -1;
-                    srcLen = 1;
+                    m_posErr = m_pos;
+                    return wxCONV_FAILED;
                 }
+
+                // we're past the end of the data now
+                m_end = true;
+                m_n = 0;
                 break;
 
             default:
-                if ( end )
+                if ( m_end || m_needPad )
                 {
-                    // nothing is allowed after the end so provoke error return
-                    n = -1;
-                    srcLen = 1;
-                    break;
+                    // nothing is allowed after the padding
+                    m_posErr = m_pos;
+                    return wxCONV_FAILED;
                 }
 
-                in[n++] = c;
+                m_in[m_n++] = c;
+
+                if ( m_n == 4 )
+                {
+                    // got an entire quartet, decode it
+                    decLen += 3;
+                    if ( dst )
+                    {
+                        if ( decLen > dstLen )
+                        {
+                            m_posErr = m_pos;
+                            return wxCONV_FAILED;
+                        }
+
+                        unsigned char *q = dst + decLen - 3;
+                        q[0] = m_in[0] << 2 | m_in[1] >> 4;
+                        q[1] = m_in[1] << 4 | m_in[2] >> 2;
+                        q[2] = m_in[2] << 6 | m_in[3];
+                    }
+
+                    m_n = 0;
+                }
         }
+    }
 
-        if ( n == 4 )
-        {
-            // got entire block, decode
-            decLen += 3 - padLen;
-            if ( dst )
-            {
-                if ( decLen > dstLen )
-                    return wxCONV_FAILED;
+    return decLen;
+}
 
-                // undo the bit shifting done during encoding
-                *dst++ = in[0] << 2 | in[1] >> 4;
+size_t
+wxBase64Decode(void *dst, size_t dstLen,
+               const char *src, size_t srcLen,
+               wxBase64DecodeMode mode,
+               size_t *posErr)
+{
+    wxCHECK_MSG( src, wxCONV_FAILED, wxT("NULL input buffer") );
 
-                // be careful to not overwrite the output buffer with NUL pad
-                // bytes
-                if ( padLen != 2 )
-                {
-                    *dst++ = in[1] << 4 | in[2] >> 2;
-                    if ( !padLen )
-                        *dst++ = in[2] << 6 | in[3];
-                }
-            }
+    if ( srcLen == wxNO_LEN )
+        srcLen = strlen(src);
 
-            n = 0;
-        }
+    wxBase64Decoder decoder(mode);
+    const size_t decLen = decoder.Decode(dst, dstLen, src, srcLen);
+    if ( decLen == wxCONV_FAILED )
+    {
+        if ( posErr )
+            *posErr = decoder.GetErrorPos();
+
+        return wxCONV_FAILED;
     }
 
-    if ( n )
+    if ( !decoder.IsComplete() )
     {
+        // the input stopped in the middle of a quartet
         if ( posErr )
-        {
-            // notice that the error was on a previous position as we did one
-            // extra "p++" in the loop line after it
-            *posErr = p - src - 1;
-        }
+            *posErr = srcLen - 1;
 
         return wxCONV_FAILED;
     }
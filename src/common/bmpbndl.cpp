@@ -25,6 +25,8 @@
 #include "wx/icon.h"
 #include "wx/window.h"
 #include "wx/filename.h"
+#include "wx/hashmap.h"
+#include "wx/module.h"
 
 #include "wx/private/bmpbndl.h"
 
@@ -41,6 +43,154 @@
 namespace
 {
 
+// ----------------------------------------------------------------------------
+// Cache of bitmaps decoded from files
+// ----------------------------------------------------------------------------
+
+// Cached result of loading a bitmap from a file, see wxBitmapFileCache.
+struct wxBitmapCacheEntry
+{
+    wxBitmap bitmap;
+
+    // Modification time and size of the file when it was loaded, used to
+    // invalidate the entry if the file changes.
+    wxDateTime mtime;
+    wxULongLong fileSize;
+
+    // Value of the cache use counter when this entry was last returned,
+    // the entry with the smallest value is the least recently used one.
+    wxUint32 lastUsed;
+};
+
+WX_DECLARE_STRING_HASH_MAP(wxBitmapCacheEntry, wxBitmapCacheMap);
+
+// Process-wide cache of the bitmaps decoded from files, used to avoid
+// re-decoding the same images every time a bundle is created from them.
+class wxBitmapFileCache
+{
+public:
+    // Return the bitmap for the given file, loading it only if there is no
+    // up to date cached copy.
+    static wxBitmap Get(const wxString& path)
+    {
+        if ( !ms_capacity )
+            return wxBitmap(path, wxBITMAP_TYPE_ANY);
+
+        const wxFileName fn(path);
+        wxDateTime mtime;
+        fn.GetTimes(NULL, &mtime, NULL);
+        const wxULongLong fileSize = fn.GetSize();
+
+        wxBitmapCacheMap::iterator it = ms_entries.find(path);
+        if ( it != ms_entries.end() )
+        {
+            wxBitmapCacheEntry& entry = it->second;
+            if ( entry.mtime == mtime && entry.fileSize == fileSize )
+            {
+                entry.lastUsed = ++ms_useCounter;
+                return entry.bitmap;
+            }
+
+            // the file changed since it was cached
+            ms_memory -= MemoryUsed(entry.bitmap);
+            ms_entries.erase(it);
+        }
+
+        wxBitmap bmp(path, wxBITMAP_TYPE_ANY);
+        if ( !bmp.IsOk() )
+            return bmp;
+
+        const size_t memory = MemoryUsed(bmp);
+        if ( memory <= ms_capacity )
+        {
+            EvictDownTo(ms_capacity - memory);
+
+            wxBitmapCacheEntry& entry = ms_entries[path];
+            entry.bitmap = bmp;
+            entry.mtime = mtime;
+            entry.fileSize = fileSize;
+            entry.lastUsed = ++ms_useCounter;
+            ms_memory += memory;
+        }
+
+        return bmp;
+    }
+
+    static size_t SetCapacity(size_t bytes)
+    {
+        const size_t old = ms_capacity;
+        ms_capacity = bytes;
+        EvictDownTo(ms_capacity);
+        return old;
+    }
+
+    static size_t GetCapacity() { return ms_capacity; }
+
+    static void Clear()
+    {
+        ms_entries.clear();
+        ms_memory = 0;
+    }
+
+private:
+    // Approximation of the amount of memory used by the decoded bitmap.
+    static size_t MemoryUsed(const wxBitmap& bmp)
+    {
+        return static_cast<size_t>(bmp.GetWidth())*bmp.GetHeight()*4;
+    }
+
+    // Evict the least recently used entries until at most the given amount
+    // of memory is used.
+    static void EvictDownTo(size_t bytes)
+    {
+        while ( ms_memory > bytes && !ms_entries.empty() )
+        {
+            wxBitmapCacheMap::iterator lru = ms_entries.begin();
+            for ( wxBitmapCacheMap::iterator it = lru;
+                  it != ms_entries.end();
+                  ++it )
+            {
+                if ( it->second.lastUsed < lru->second.lastUsed )
+                    lru = it;
+            }
+
+            ms_memory -= MemoryUsed(lru->second.bitmap);
+            ms_entries.erase(lru);
+        }
+    }
+
+    static wxBitmapCacheMap ms_entries;
+    static size_t ms_capacity;
+    static size_t ms_memory;
+    static wxUint32 ms_useCounter;
+};
+
+wxBitmapCacheMap wxBitmapFileCache::ms_entries;
+
+// Default budget of 8MiB is enough for a few hundred toolbar-sized icons.
+size_t wxBitmapFileCache::ms_capacity = 8*1024*1024;
+
+size_t wxBitmapFileCache::ms_memory = 0;
+wxUint32 wxBitmapFileCache::ms_useCounter = 0;
+
+} // anonymous namespace
+
+// Ensure the cached bitmaps are destroyed before the GDI subsystem is
+// cleaned up and not only during the static objects destruction.
+class wxBitmapFileCacheModule : public wxModule
+{
+public:
+    virtual bool OnInit() wxOVERRIDE { return true; }
+    virtual void OnExit() wxOVERRIDE { wxBitmapFileCache::Clear(); }
+
+    wxDECLARE_DYNAMIC_CLASS(wxBitmapFileCacheModule);
+};
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxBitmapFileCacheModule, wxModule);
+
+namespace
+{
+
 // Simplest possible bundle implementation storing a collection of bitmaps
 class wxBitmapBundleImplSet : public wxBitmapBundleImpl
 {
@@ -406,7 +556,7 @@ wxBitmapBundle wxBitmapBundle::FromFiles(const wxString& path, const wxString& f
 
         if ( fn.FileExists() )
         {
-            wxBitmap bmp(fn.GetFullPath(), wxBITMAP_TYPE_ANY);
+            wxBitmap bmp = wxBitmapFileCache::Get(fn.GetFullPath());
 
             if ( bmp.IsOk() )
             {
@@ -420,6 +570,18 @@ wxBitmapBundle wxBitmapBundle::FromFiles(const wxString& path, const wxString& f
 
 #endif
 
+/* static */
+size_t wxBitmapBundle::SetFileCacheCapacity(size_t bytes)
+{
+    return wxBitmapFileCache::SetCapacity(bytes);
+}
+
+/* static */
+size_t wxBitmapBundle::GetFileCacheCapacity()
+{
+    return wxBitmapFileCache::GetCapacity();
+}
+
 wxSize wxBitmapBundle::GetDefaultSize() const
 {
     if ( !m_impl )
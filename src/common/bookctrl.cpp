@@ -25,6 +25,7 @@
 #include "wx/imaglist.h"
 
 #include "wx/bookctrl.h"
+#include "wx/lazypanel.h"
 
 // ============================================================================
 // implementation
@@ -499,6 +500,11 @@ int wxBookCtrlBase::DoSetSelection(size_t n, int flags)
 
             if ( wxWindow* const page = TryGetNonNullPage(n) )
             {
+                // create the contents of a lazily created page before sizing
+                // it so that its children are laid out correctly
+                if ( wxLazyPanel* const lazy = wxDynamicCast(page, wxLazyPanel) )
+                    lazy->Realize();
+
                 page->SetSize(GetPageRect());
                 DoShowPage(page, true);
             }
@@ -182,6 +182,9 @@ WX_DECLARE_OBJARRAY(wxCmdLineOption, wxArrayOptions);
 WX_DECLARE_OBJARRAY(wxCmdLineParam, wxArrayParams);
 WX_DECLARE_OBJARRAY(wxCmdLineArgImpl, wxArrayArgs);
 
+// maps option names to the indices in wxCmdLineParserData::m_options
+WX_DECLARE_STRING_HASH_MAP(int, wxCmdLineOptionIndexMap);
+
 #include "wx/arrimpl.cpp"
 
 WX_DEFINE_OBJARRAY(wxArrayOptions)
@@ -219,6 +222,16 @@ struct wxCmdLineParserData
     //
     // Asserts and returns NULL if option with this name is not found.
     const wxCmdLineOption* FindOptionByAnyName(const wxString& name);
+
+    // Add the last entry of m_options to the name indices: must be called
+    // whenever a new entry is appended to it.
+    void IndexLastOption();
+
+private:
+    // name indices for m_options, built as the entries are added, so that
+    // looking up an option while parsing doesn't rescan the entire array
+    wxCmdLineOptionIndexMap m_optionsByShortName,
+                            m_optionsByLongName;
 };
 
 // ============================================================================
@@ -477,18 +490,31 @@ void wxCmdLineParserData::SetArguments(const wxString& cmdLine)
     WX_APPEND_ARRAY(m_arguments, args);
 }
 
+void wxCmdLineParserData::IndexLastOption()
+{
+    const int n = (int)m_options.GetCount() - 1;
+    const wxCmdLineOption& opt = m_options[(size_t)n];
+
+    // only remember the first entry with the given name, as the linear scans
+    // used to return it (duplicates are not supposed to exist, but entries
+    // without a short or long name all share the empty string)
+    if ( m_optionsByShortName.find(opt.shortName) == m_optionsByShortName.end() )
+        m_optionsByShortName[opt.shortName] = n;
+
+    if ( m_optionsByLongName.find(opt.longName) == m_optionsByLongName.end() )
+        m_optionsByLongName[opt.longName] = n;
+}
+
 int wxCmdLineParserData::FindOption(const wxString& name)
 {
     if ( !name.empty() )
     {
-        size_t count = m_options.GetCount();
-        for ( size_t n = 0; n < count; n++ )
+        wxCmdLineOptionIndexMap::const_iterator
+            it = m_optionsByShortName.find(name);
+        if ( it != m_optionsByShortName.end() )
         {
-            if ( m_options[n].shortName == name )
-            {
-                // found
-                return n;
-            }
+            // found
+            return it->second;
         }
     }
 
@@ -497,17 +523,10 @@ int wxCmdLineParserData::FindOption(const wxString& name)
 
 int wxCmdLineParserData::FindOptionByLongName(const wxString& name)
 {
-    size_t count = m_options.GetCount();
-    for ( size_t n = 0; n < count; n++ )
-    {
-        if ( m_options[n].longName == name )
-        {
-            // found
-            return n;
-        }
-    }
+    wxCmdLineOptionIndexMap::const_iterator
+        it = m_optionsByLongName.find(name);
 
-    return wxNOT_FOUND;
+    return it != m_optionsByLongName.end() ? it->second : wxNOT_FOUND;
 }
 
 const wxCmdLineOption*
@@ -644,6 +663,7 @@ void wxCmdLineParser::AddSwitch(const wxString& shortName,
                                                   wxCMD_LINE_VAL_NONE, flags);
 
     m_data->m_options.Add(option);
+    m_data->IndexLastOption();
 }
 
 void wxCmdLineParser::AddOption(const wxString& shortName,
@@ -660,6 +680,7 @@ void wxCmdLineParser::AddOption(const wxString& shortName,
                                                   type, flags);
 
     m_data->m_options.Add(option);
+    m_data->IndexLastOption();
 }
 
 void wxCmdLineParser::AddParam(const wxString& desc,
@@ -698,6 +719,7 @@ void wxCmdLineParser::AddUsageText(const wxString& text)
                                                   text, wxCMD_LINE_VAL_NONE, 0);
 
     m_data->m_options.Add(option);
+    m_data->IndexLastOption();
 }
 
 // ----------------------------------------------------------------------------
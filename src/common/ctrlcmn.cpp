@@ -34,6 +34,9 @@
     #include "wx/settings.h"
 #endif
 
+#include "wx/module.h"
+#include "wx/vector.h"
+
 #include "wx/private/markupparser.h"
 
 const char wxControlNameStr[] = "control";
@@ -569,6 +572,49 @@ wxString DoEllipsizeSingleLine(const wxString& curLine, const wxDC& dc,
     return calc.GetEllipsizedText();
 }
 
+// Cache of the most recently computed ellipsizations: a control typically
+// ellipsizes the same label with the same parameters on every repaint, so
+// remembering the last few results avoids remeasuring the text, which is by
+// far the most expensive part of the computation, each time.
+struct EllipsizeCacheEntry
+{
+    // All the inputs affecting the result: note that the replacement width
+    // depends on the DC state (scale factor etc.) beside the font, so
+    // comparing it too protects us from reusing a result computed for the
+    // same font in a differently configured DC.
+    wxString label;
+    wxFont font;
+    wxEllipsizeMode mode;
+    int maxFinalWidth;
+    int replacementWidth;
+    int flags;
+
+    wxString result;
+};
+
+// Cached entries, most recently used first.
+wxVector<EllipsizeCacheEntry> gs_ellipsizeCache;
+
+// An arbitrary limit big enough for repainting even a window full of labels
+// without evicting anything, while keeping lookups and memory use cheap.
+const size_t ELLIPSIZE_CACHE_MAX_SIZE = 50;
+
+// Module ensuring the cache is emptied on library shutdown, as the fonts
+// stored in it can't be used, nor even destroyed, after it.
+class wxEllipsizeCacheModule : public wxModule
+{
+public:
+    wxEllipsizeCacheModule() { }
+
+    bool OnInit() wxOVERRIDE { return true; }
+    void OnExit() wxOVERRIDE { gs_ellipsizeCache.clear(); }
+
+private:
+    wxDECLARE_DYNAMIC_CLASS(wxEllipsizeCacheModule);
+};
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxEllipsizeCacheModule, wxModule);
+
 } // anonymous namespace
 
 
@@ -580,13 +626,43 @@ wxString wxControlBase::Ellipsize(const wxString& label, const wxDC& dc,
     if (mode == wxELLIPSIZE_NONE)
         return label;
 
-    wxString ret;
-
     // these cannot be cached between different Ellipsize() calls as they can
     // change because of e.g. a font change; however we calculate them only once
     // when ellipsizing multiline labels:
     int replacementWidth = dc.GetTextExtent(wxELLIPSE_REPLACEMENT).GetWidth();
 
+    // Only use the cache when the DC has a valid font: without one the result
+    // depends on some implicit default font which we have no way to compare.
+    const wxFont& font = dc.GetFont();
+    const bool useCache = font.IsOk();
+    if ( useCache )
+    {
+        for ( size_t n = 0; n < gs_ellipsizeCache.size(); n++ )
+        {
+            const EllipsizeCacheEntry& entry = gs_ellipsizeCache[n];
+            if ( entry.maxFinalWidth == maxFinalWidth &&
+                    entry.mode == mode &&
+                    entry.flags == flags &&
+                    entry.replacementWidth == replacementWidth &&
+                    entry.label == label &&
+                    entry.font == font )
+            {
+                // Move the entry to the front to keep the vector ordered by
+                // recency of use.
+                if ( n > 0 )
+                {
+                    const EllipsizeCacheEntry hit = entry;
+                    gs_ellipsizeCache.erase(gs_ellipsizeCache.begin() + n);
+                    gs_ellipsizeCache.insert(gs_ellipsizeCache.begin(), hit);
+                }
+
+                return gs_ellipsizeCache.front().result;
+            }
+        }
+    }
+
+    wxString ret;
+
     // NB: we must handle correctly labels with newlines:
     wxString curLine;
     for ( wxString::const_iterator pc = label.begin(); ; ++pc )
@@ -617,6 +693,22 @@ wxString wxControlBase::Ellipsize(const wxString& label, const wxDC& dc,
         }
     }
 
+    if ( useCache )
+    {
+        EllipsizeCacheEntry entry;
+        entry.label = label;
+        entry.font = font;
+        entry.mode = mode;
+        entry.maxFinalWidth = maxFinalWidth;
+        entry.replacementWidth = replacementWidth;
+        entry.flags = flags;
+        entry.result = ret;
+
+        gs_ellipsizeCache.insert(gs_ellipsizeCache.begin(), entry);
+        if ( gs_ellipsizeCache.size() > ELLIPSIZE_CACHE_MAX_SIZE )
+            gs_ellipsizeCache.pop_back();
+    }
+
     return ret;
 }
 
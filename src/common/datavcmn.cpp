@@ -132,12 +132,76 @@ bool wxDataViewModelNotifier::ItemsChanged( const wxDataViewItemArray &items )
     return true;
 }
 
+// ---------------------------------------------------------
+// wxDataViewModelBatch
+// ---------------------------------------------------------
+
+// Holds the change notifications queued between BeginBatch() and EndBatch()
+// calls: consecutive notifications of the same kind with the same parent are
+// merged together so that they can be sent as a single batch notification.
+class wxDataViewModelBatch
+{
+public:
+    enum NotificationKind
+    {
+        Kind_ItemsAdded,
+        Kind_ItemsDeleted,
+        Kind_ItemsChanged,
+        Kind_ValueChanged
+    };
+
+    struct Notification
+    {
+        NotificationKind kind;
+        wxDataViewItem parent;      // used by Kind_ItemsAdded/Deleted only
+        wxDataViewItemArray items;
+        unsigned int col;           // used by Kind_ValueChanged only
+    };
+
+    wxDataViewModelBatch() : m_level(1) {}
+
+    void Queue(NotificationKind kind,
+               const wxDataViewItem& parent,
+               const wxDataViewItem& item,
+               unsigned int col = 0)
+    {
+        if ( m_notifications.empty() ||
+                !CanMergeWith(m_notifications.back(), kind, parent, col) )
+        {
+            Notification notification;
+            notification.kind = kind;
+            notification.parent = parent;
+            notification.col = col;
+            m_notifications.push_back(notification);
+        }
+
+        m_notifications.back().items.Add(item);
+    }
+
+    wxVector<Notification> m_notifications;
+
+    // nesting level of the BeginBatch() calls
+    int m_level;
+
+private:
+    static bool CanMergeWith(const Notification& last,
+                             NotificationKind kind,
+                             const wxDataViewItem& parent,
+                             unsigned int col)
+    {
+        return last.kind == kind &&
+                last.parent == parent &&
+                (kind != Kind_ValueChanged || last.col == col);
+    }
+};
+
 // ---------------------------------------------------------
 // wxDataViewModel
 // ---------------------------------------------------------
 
 wxDataViewModel::wxDataViewModel()
 {
+    m_batch = NULL;
 }
 
 wxDataViewModel::~wxDataViewModel()
@@ -147,10 +211,20 @@ wxDataViewModel::~wxDataViewModel()
     {
         delete *iter;
     }
+
+    // the batch, if any, is abandoned without sending its notifications as
+    // there is nothing left to notify about
+    delete m_batch;
 }
 
 bool wxDataViewModel::ItemAdded( const wxDataViewItem &parent, const wxDataViewItem &item )
 {
+    if ( m_batch )
+    {
+        m_batch->Queue(wxDataViewModelBatch::Kind_ItemsAdded, parent, item);
+        return true;
+    }
+
     bool ret = true;
 
     wxDataViewModelNotifiers::iterator iter;
@@ -166,6 +240,12 @@ bool wxDataViewModel::ItemAdded( const wxDataViewItem &parent, const wxDataViewI
 
 bool wxDataViewModel::ItemDeleted( const wxDataViewItem &parent, const wxDataViewItem &item )
 {
+    if ( m_batch )
+    {
+        m_batch->Queue(wxDataViewModelBatch::Kind_ItemsDeleted, parent, item);
+        return true;
+    }
+
     bool ret = true;
 
     wxDataViewModelNotifiers::iterator iter;
@@ -181,6 +261,13 @@ bool wxDataViewModel::ItemDeleted( const wxDataViewItem &parent, const wxDataVie
 
 bool wxDataViewModel::ItemChanged( const wxDataViewItem &item )
 {
+    if ( m_batch )
+    {
+        m_batch->Queue(wxDataViewModelBatch::Kind_ItemsChanged,
+                       wxDataViewItem(), item);
+        return true;
+    }
+
     bool ret = true;
 
     wxDataViewModelNotifiers::iterator iter;
@@ -196,6 +283,14 @@ bool wxDataViewModel::ItemChanged( const wxDataViewItem &item )
 
 bool wxDataViewModel::ItemsAdded( const wxDataViewItem &parent, const wxDataViewItemArray &items )
 {
+    if ( m_batch )
+    {
+        for ( size_t i = 0; i < items.GetCount(); i++ )
+            m_batch->Queue(wxDataViewModelBatch::Kind_ItemsAdded,
+                           parent, items[i]);
+        return true;
+    }
+
     bool ret = true;
 
     wxDataViewModelNotifiers::iterator iter;
@@ -211,6 +306,14 @@ bool wxDataViewModel::ItemsAdded( const wxDataViewItem &parent, const wxDataView
 
 bool wxDataViewModel::ItemsDeleted( const wxDataViewItem &parent, const wxDataViewItemArray &items )
 {
+    if ( m_batch )
+    {
+        for ( size_t i = 0; i < items.GetCount(); i++ )
+            m_batch->Queue(wxDataViewModelBatch::Kind_ItemsDeleted,
+                           parent, items[i]);
+        return true;
+    }
+
     bool ret = true;
 
     wxDataViewModelNotifiers::iterator iter;
@@ -226,6 +329,14 @@ bool wxDataViewModel::ItemsDeleted( const wxDataViewItem &parent, const wxDataVi
 
 bool wxDataViewModel::ItemsChanged( const wxDataViewItemArray &items )
 {
+    if ( m_batch )
+    {
+        for ( size_t i = 0; i < items.GetCount(); i++ )
+            m_batch->Queue(wxDataViewModelBatch::Kind_ItemsChanged,
+                           wxDataViewItem(), items[i]);
+        return true;
+    }
+
     bool ret = true;
 
     wxDataViewModelNotifiers::iterator iter;
@@ -241,6 +352,13 @@ bool wxDataViewModel::ItemsChanged( const wxDataViewItemArray &items )
 
 bool wxDataViewModel::ValueChanged( const wxDataViewItem &item, unsigned int col )
 {
+    if ( m_batch )
+    {
+        m_batch->Queue(wxDataViewModelBatch::Kind_ValueChanged,
+                       wxDataViewItem(), item, col);
+        return true;
+    }
+
     bool ret = true;
 
     wxDataViewModelNotifiers::iterator iter;
@@ -256,6 +374,13 @@ bool wxDataViewModel::ValueChanged( const wxDataViewItem &item, unsigned int col
 
 bool wxDataViewModel::Cleared()
 {
+    if ( m_batch )
+    {
+        // everything queued so far is made obsolete by clearing the model, so
+        // just drop it and let the notification itself through immediately
+        m_batch->m_notifications.clear();
+    }
+
     bool ret = true;
 
     wxDataViewModelNotifiers::iterator iter;
@@ -301,6 +426,13 @@ bool wxDataViewModel::AfterReset()
 
 void wxDataViewModel::Resort()
 {
+    if ( m_batch )
+    {
+        // the queued notifications must be sent before resorting to preserve
+        // the relative order of the changes
+        SendBatchedNotifications(*m_batch);
+    }
+
     wxDataViewModelNotifiers::iterator iter;
     for (iter = m_notifiers.begin(); iter != m_notifiers.end(); ++iter)
     {
@@ -309,6 +441,64 @@ void wxDataViewModel::Resort()
     }
 }
 
+void wxDataViewModel::BeginBatch()
+{
+    if ( m_batch )
+        m_batch->m_level++;
+    else
+        m_batch = new wxDataViewModelBatch;
+}
+
+void wxDataViewModel::EndBatch()
+{
+    wxCHECK_RET( m_batch, "EndBatch() called without matching BeginBatch()" );
+
+    if ( --m_batch->m_level )
+        return;
+
+    wxDataViewModelBatch* const batch = m_batch;
+    m_batch = NULL;
+    SendBatchedNotifications(*batch);
+    delete batch;
+}
+
+void wxDataViewModel::SendBatchedNotifications(wxDataViewModelBatch& batch)
+{
+    // reset m_batch while sending so that the notifications are really sent
+    // instead of being queued again
+    wxDataViewModelBatch* const outer = m_batch;
+    m_batch = NULL;
+
+    for ( size_t n = 0; n < batch.m_notifications.size(); n++ )
+    {
+        const wxDataViewModelBatch::Notification&
+            notification = batch.m_notifications[n];
+        switch ( notification.kind )
+        {
+            case wxDataViewModelBatch::Kind_ItemsAdded:
+                ItemsAdded(notification.parent, notification.items);
+                break;
+
+            case wxDataViewModelBatch::Kind_ItemsDeleted:
+                ItemsDeleted(notification.parent, notification.items);
+                break;
+
+            case wxDataViewModelBatch::Kind_ItemsChanged:
+                ItemsChanged(notification.items);
+                break;
+
+            case wxDataViewModelBatch::Kind_ValueChanged:
+                for ( size_t i = 0; i < notification.items.GetCount(); i++ )
+                    ValueChanged(notification.items[i], notification.col);
+                break;
+        }
+    }
+
+    batch.m_notifications.clear();
+
+    m_batch = outer;
+}
+
 void wxDataViewModel::AddNotifier( wxDataViewModelNotifier *notifier )
 {
     m_notifiers.push_back( notifier );
@@ -1039,7 +1229,7 @@ wxDataViewCustomRendererBase::WXCallRender(wxRect rectCell, wxDC *dc, int state)
 
     wxDCFontChanger changeFont(*dc);
     if ( m_attr.HasFont() )
-        changeFont.Set(m_attr.GetEffectiveFont(dc->GetFont()));
+        changeFont.Set(GetEffectiveFontWithCache(dc->GetFont()));
 
 #ifdef DEBUG_RENDER_EXTENTS
     {
@@ -1058,13 +1248,34 @@ wxDataViewCustomRendererBase::WXCallRender(wxRect rectCell, wxDC *dc, int state)
     Render(rectItem, dc, state);
 }
 
+const wxFont&
+wxDataViewCustomRendererBase::GetEffectiveFontWithCache(const wxFont& font) const
+{
+    // This function is only called when the attribute uses a non-default
+    // font.
+    wxASSERT( m_attr.HasFont() );
+
+    const int flags = (m_attr.GetBold() ? 1 : 0) |
+                      (m_attr.GetItalic() ? 2 : 0) |
+                      (m_attr.GetStrikethrough() ? 4 : 0);
+
+    if ( flags != m_effectiveFontFlags || font != m_effectiveFontBase )
+    {
+        m_effectiveFontBase = font;
+        m_effectiveFontFlags = flags;
+        m_effectiveFont = m_attr.GetEffectiveFont(font);
+    }
+
+    return m_effectiveFont;
+}
+
 wxSize wxDataViewCustomRendererBase::GetTextExtent(const wxString& str) const
 {
     const wxDataViewCtrl *view = GetView();
 
     if ( m_attr.HasFont() )
     {
-        wxFont font(m_attr.GetEffectiveFont(view->GetFont()));
+        const wxFont& font = GetEffectiveFontWithCache(view->GetFont());
         wxSize size;
         view->GetTextExtent(str, &size.x, &size.y, NULL, NULL, &font);
         return size;
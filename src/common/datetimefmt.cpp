@@ -140,11 +140,16 @@ enum
 // can be either DateLang_Local (default) to interpret string as a localized
 // month name or DateLang_English to parse it as a standard English name or
 // their combination to interpret it in any way
+//
+// namesFull and namesAbbr may point to arrays of 12 cached localized month
+// names to use instead of querying the locale for each candidate
 wxDateTime::Month
 GetMonthFromName(wxString::const_iterator& p,
                  const wxString::const_iterator& end,
                  int flags,
-                 int lang)
+                 int lang,
+                 const wxString* namesFull = NULL,
+                 const wxString* namesAbbr = NULL)
 {
     const wxString::const_iterator pOrig = p;
     const wxString name = GetAlphaToken(p, end);
@@ -167,8 +172,10 @@ GetMonthFromName(wxString::const_iterator& p,
 
             if ( lang & DateLang_Local )
             {
-                if ( name.CmpNoCase(wxDateTime::GetMonthName(mon,
-                        wxDateTime::Name_Full)) == 0 )
+                if ( name.CmpNoCase(namesFull
+                        ? namesFull[mon]
+                        : wxDateTime::GetMonthName(mon,
+                            wxDateTime::Name_Full)) == 0 )
                     break;
             }
         }
@@ -187,8 +194,9 @@ GetMonthFromName(wxString::const_iterator& p,
                 // some locales (e.g. French one) use periods for the
                 // abbreviated month names but it's never part of name so
                 // compare it specially
-                wxString nameAbbr = wxDateTime::GetMonthName(mon,
-                    wxDateTime::Name_Abbr);
+                wxString nameAbbr = namesAbbr
+                    ? namesAbbr[mon]
+                    : wxDateTime::GetMonthName(mon, wxDateTime::Name_Abbr);
                 const bool hasPeriod = *nameAbbr.rbegin() == '.';
                 if ( hasPeriod )
                     nameAbbr.erase(nameAbbr.end() - 1);
@@ -219,11 +227,14 @@ GetMonthFromName(wxString::const_iterator& p,
 // return the weekday if the string is a weekday name or Inv_WeekDay otherwise
 //
 // flags and lang parameters have the same meaning as for GetMonthFromName()
-// above
+// above, namesFull and namesAbbr may point to arrays of 7 cached localized
+// weekday names
 wxDateTime::WeekDay
 GetWeekDayFromName(wxString::const_iterator& p,
                    const wxString::const_iterator& end,
-                   int flags, int lang)
+                   int flags, int lang,
+                   const wxString* namesFull = NULL,
+                   const wxString* namesAbbr = NULL)
 {
     const wxString::const_iterator pOrig = p;
     const wxString name = GetAlphaToken(p, end);
@@ -244,8 +255,10 @@ GetWeekDayFromName(wxString::const_iterator& p,
 
             if ( lang & DateLang_Local )
             {
-                if ( name.CmpNoCase(wxDateTime::GetWeekDayName(wd,
-                        wxDateTime::Name_Full)) == 0 )
+                if ( name.CmpNoCase(namesFull
+                        ? namesFull[wd]
+                        : wxDateTime::GetWeekDayName(wd,
+                            wxDateTime::Name_Full)) == 0 )
                     break;
             }
         }
@@ -261,8 +274,10 @@ GetWeekDayFromName(wxString::const_iterator& p,
 
             if ( lang & DateLang_Local )
             {
-                if ( name.CmpNoCase(wxDateTime::GetWeekDayName(wd,
-                        wxDateTime::Name_Abbr)) == 0 )
+                if ( name.CmpNoCase(namesAbbr
+                        ? namesAbbr[wd]
+                        : wxDateTime::GetWeekDayName(wd,
+                            wxDateTime::Name_Abbr)) == 0 )
                     break;
             }
         }
@@ -309,67 +324,270 @@ ParseFormatAt(wxString::const_iterator& p,
 } // anonymous namespace
 
 // ----------------------------------------------------------------------------
-// wxDateTime to/from text representations
+// wxDateTimeFormat
 // ----------------------------------------------------------------------------
 
-wxString wxDateTime::Format(const wxString& formatp, const TimeZone& tz) const
+void wxDateTimeFormat::Init()
 {
-    wxCHECK_MSG( !formatp.empty(), wxEmptyString,
-                 wxT("NULL format in wxDateTime::Format") );
+    m_canUseStrftime = false;
+
+    m_haveMonthNames =
+    m_haveWeekDayNames =
+    m_haveAmPmStrings = false;
+}
 
-    wxString format = formatp;
+void wxDateTimeFormat::Compile(const wxString& format)
+{
+    Init();
+
+    m_ops.clear();
+
+    m_format = format;
 #ifdef __WXOSX__
-    if ( format.Contains("%c") )
-        format.Replace("%c", wxLocale::GetInfo(wxLOCALE_DATE_TIME_FMT));
-    if ( format.Contains("%x") )
-        format.Replace("%x", wxLocale::GetInfo(wxLOCALE_SHORT_DATE_FMT));
-    if ( format.Contains("%X") )
-        format.Replace("%X", wxLocale::GetInfo(wxLOCALE_TIME_FMT));
+    if ( m_format.Contains("%c") )
+        m_format.Replace("%c", wxLocale::GetInfo(wxLOCALE_DATE_TIME_FMT));
+    if ( m_format.Contains("%x") )
+        m_format.Replace("%x", wxLocale::GetInfo(wxLOCALE_SHORT_DATE_FMT));
+    if ( m_format.Contains("%X") )
+        m_format.Replace("%X", wxLocale::GetInfo(wxLOCALE_TIME_FMT));
 #endif
-    // we have to use our own implementation if the date is out of range of
-    // strftime()
+
 #ifdef wxHAS_STRFTIME
-    time_t time = GetTicks();
+    m_canUseStrftime = true;
+#endif
 
-    bool canUseStrftime = time != (time_t)-1;
-    bool isPercent = false;
+    // the literal run being accumulated, flushed whenever a "%" is found
+    Op literal;
 
-    // We also can't use strftime() if we use non standard specifier: either
-    // our own extension "%l" or one of "%g", "%G", "%V", "%z" which are POSIX
-    // but not supported under Windows.
-    for ( wxString::const_iterator p = format.begin();
-          canUseStrftime && p != format.end();
+    for ( wxString::const_iterator p = m_format.begin();
+          p != m_format.end();
           ++p )
     {
-        if (!isPercent)
+        if ( *p != wxT('%') )
         {
-            isPercent = *p == '%';
+            literal.text += *p;
+
             continue;
         }
-        isPercent = false;
 
-        // set the default format
+        if ( !literal.text.empty() )
+        {
+            m_ops.push_back(literal);
+            literal.text.clear();
+        }
+
+        if ( ++p == m_format.end() )
+        {
+            wxFAIL_MSG(wxT("missing format at the end of string"));
+
+            // just put the '%' which was the last char in format
+            literal.text += wxT('%');
+            break;
+        }
+
+        // We can't use strftime() if we use a non standard specifier: either
+        // our own extension "%l" or one of "%g", "%G", "%V", "%z" which are
+        // POSIX but not supported under Windows. Notice that, as in the code
+        // this replaces, only the character directly following the "%" is
+        // examined here.
         switch ( (*p).GetValue() )
         {
-            case 'l':
+            case wxT('l'):
 #ifdef __WINDOWS__
-            case 'g':
-            case 'G':
-            case 'V':
-            case 'z':
+            case wxT('g'):
+            case wxT('G'):
+            case wxT('V'):
+            case wxT('z'):
 #endif // __WINDOWS__
-                canUseStrftime = false;
+                m_canUseStrftime = false;
                 break;
         }
+
+        // collect the optional printf()-like flags and field width
+        wxString flags;
+        bool digitsOnly = true;
+        while ( p != m_format.end() &&
+                    (*p == wxT('-') || *p == wxT('+') ||
+                        *p == wxT(' ') || wxIsdigit(*p)) )
+        {
+            if ( !wxIsdigit(*p) )
+                digitsOnly = false;
+
+            flags += *p++;
+        }
+
+        if ( p == m_format.end() )
+        {
+            wxFAIL_MSG(wxT("missing format at the end of string"));
+
+            literal.text += wxT('%');
+            break;
+        }
+
+        Op op;
+        op.spec = *p;
+
+        // only a plain field width may be used when parsing
+        op.parseable = digitsOnly;
+
+        unsigned long width = 0;
+        if ( digitsOnly && !flags.empty() )
+            flags.ToULong(&width);
+        op.width = width;
+
+        if ( !op.width )
+        {
+            // the default widths for the various fields used when parsing
+            switch ( op.spec.GetValue() )
+            {
+                case wxT('Y'):               // year has 4 digits
+                    op.width = 4;
+                    break;
+
+                case wxT('j'):               // day of year has 3 digits
+                case wxT('l'):               // milliseconds have 3 digits
+                    op.width = 3;
+                    break;
+
+                case wxT('w'):               // week day as number has only one
+                    op.width = 1;
+                    break;
+
+                default:
+                    // default for all other fields
+                    op.width = 2;
+            }
+        }
+
+        if ( !flags.empty() )
+        {
+            // an explicit field width overrides the default format
+            op.text << wxT('%') << flags << wxT('d');
+        }
+        else
+        {
+            // set the default format used for output
+            switch ( op.spec.GetValue() )
+            {
+                case wxT('Y'):               // year has 4 digits
+                case wxT('G'):               // (and ISO week year too)
+                case wxT('z'):               // time zone as well
+                    op.text = wxT("%04d");
+                    break;
+
+                case wxT('j'):               // day of year has 3 digits
+                case wxT('l'):               // milliseconds have 3 digits
+                    op.text = wxT("%03d");
+                    break;
+
+                case wxT('w'):               // week day as number has only one
+                    op.text = wxT("%d");
+                    break;
+
+                default:
+                    // it's either another valid format specifier in which
+                    // case the format is "%02d" (for all the rest) or an
+                    // unknown one which doesn't use the format anyhow
+                    op.text = wxT("%02d");
+            }
+        }
+
+        m_ops.push_back(op);
+    }
+
+    if ( !literal.text.empty() )
+        m_ops.push_back(literal);
+}
+
+const wxString* wxDateTimeFormat::GetMonthNames(wxDateTime::NameFlags flags) const
+{
+    if ( !m_haveMonthNames )
+    {
+        for ( wxDateTime::Month mon = wxDateTime::Jan;
+              mon < wxDateTime::Inv_Month;
+              wxNextMonth(mon) )
+        {
+            m_monthNames[0][mon] =
+                wxDateTime::GetMonthName(mon, wxDateTime::Name_Full);
+            m_monthNames[1][mon] =
+                wxDateTime::GetMonthName(mon, wxDateTime::Name_Abbr);
+        }
+
+        m_haveMonthNames = true;
+    }
+
+    return m_monthNames[flags == wxDateTime::Name_Abbr ? 1 : 0];
+}
+
+const wxString* wxDateTimeFormat::GetWeekDayNames(wxDateTime::NameFlags flags) const
+{
+    if ( !m_haveWeekDayNames )
+    {
+        for ( wxDateTime::WeekDay wd = wxDateTime::Sun;
+              wd < wxDateTime::Inv_WeekDay;
+              wxNextWDay(wd) )
+        {
+            m_weekDayNames[0][wd] =
+                wxDateTime::GetWeekDayName(wd, wxDateTime::Name_Full);
+            m_weekDayNames[1][wd] =
+                wxDateTime::GetWeekDayName(wd, wxDateTime::Name_Abbr);
+        }
+
+        m_haveWeekDayNames = true;
+    }
+
+    return m_weekDayNames[flags == wxDateTime::Name_Abbr ? 1 : 0];
+}
+
+void wxDateTimeFormat::GetCachedAmPmStrings(wxString* am, wxString* pm) const
+{
+    if ( !m_haveAmPmStrings )
+    {
+        wxDateTime::GetAmPmStrings(&m_amString, &m_pmString);
+
+        m_haveAmPmStrings = true;
     }
 
-    if ( canUseStrftime )
+    if ( am )
+        *am = m_amString;
+    if ( pm )
+        *pm = m_pmString;
+}
+
+// ----------------------------------------------------------------------------
+// wxDateTime to/from text representations
+// ----------------------------------------------------------------------------
+
+wxString wxDateTime::Format(const wxString& formatp, const TimeZone& tz) const
+{
+    wxCHECK_MSG( !formatp.empty(), wxEmptyString,
+                 wxT("NULL format in wxDateTime::Format") );
+
+    // compiling the format is cheap compared to using it, so just compile it
+    // for a single use here
+    return Format(wxDateTimeFormat(formatp), tz);
+}
+
+wxString
+wxDateTime::Format(const wxDateTimeFormat& format, const TimeZone& tz) const
+{
+    wxCHECK_MSG( format.IsOk(), wxEmptyString,
+                 wxT("uncompiled format in wxDateTime::Format") );
+
+    // we have to use our own implementation if the date is out of range of
+    // strftime() or if the format uses the specifiers it doesn't support
+#ifdef wxHAS_STRFTIME
+    if ( format.m_canUseStrftime )
     {
-        // Try using strftime()
-        struct tm tmstruct;
-        if ( const tm* tm = wxTryGetTm(tmstruct, time, tz) )
+        time_t time = GetTicks();
+        if ( time != (time_t)-1 )
         {
-            return wxCallStrftime(format, tm);
+            // Try using strftime()
+            struct tm tmstruct;
+            if ( const tm* tm = wxTryGetTm(tmstruct, time, tz) )
+            {
+                return wxCallStrftime(format.m_format, tm);
+            }
         }
     }
     //else: use generic code below
@@ -391,345 +609,294 @@ wxString wxDateTime::Format(const wxString& formatp, const TimeZone& tz) const
     tmTimeOnly.tm_year = 76;
     tmTimeOnly.tm_isdst = 0;        // no DST, we adjust for tz ourselves
 
-    wxString tmp, res, fmt;
-    for ( wxString::const_iterator p = format.begin(); p != format.end(); ++p )
+    wxString res;
+    for ( wxVector<wxDateTimeFormat::Op>::const_iterator
+            it = format.m_ops.begin(); it != format.m_ops.end(); ++it )
     {
-        if ( *p != wxT('%') )
+        const wxDateTimeFormat::Op& op = *it;
+
+        if ( !op.spec )
         {
-            // copy as is
-            res += *p;
+            // copy the literal as is
+            res += op.text;
 
             continue;
         }
 
-        // set the default format
-        switch ( (*++p).GetValue() )
-        {
-            case wxT('Y'):               // year has 4 digits
-            case wxT('G'):               // (and ISO week year too)
-            case wxT('z'):               // time zone as well
-                fmt = wxT("%04d");
-                break;
+        // the printf() format for the numeric fields, computed when the
+        // format was compiled
+        const wxString& fmt = op.text;
 
-            case wxT('j'):               // day of year has 3 digits
-            case wxT('l'):               // milliseconds have 3 digits
-                fmt = wxT("%03d");
+        // start of the format specification
+        switch ( op.spec.GetValue() )
+        {
+            case wxT('a'):       // a weekday name
+            case wxT('A'):
+                res += format.GetWeekDayNames(
+                            op.spec == wxT('a') ? Name_Abbr : Name_Full
+                        )[tm.GetWeekDay()];
                 break;
 
-            case wxT('w'):               // week day as number has only one
-                fmt = wxT("%d");
+            case wxT('b'):       // a month name
+            case wxT('B'):
+                res += format.GetMonthNames(
+                            op.spec == wxT('b') ? Name_Abbr : Name_Full
+                        )[tm.mon];
                 break;
 
-            default:
-                // it's either another valid format specifier in which case
-                // the format is "%02d" (for all the rest) or we have the
-                // field width preceding the format in which case it will
-                // override the default format anyhow
-                fmt = wxT("%02d");
-        }
+            case wxT('c'):       // locale default date and time  representation
+            case wxT('x'):       // locale default date representation
+#ifdef wxHAS_STRFTIME
+                //
+                // the problem: there is no way to know what do these format
+                // specifications correspond to for the current locale.
+                //
+                // the solution: use a hack and still use strftime(): first
+                // find the YEAR which is a year in the strftime() range (1970
+                // - 2038) whose Jan 1 falls on the same week day as the Jan 1
+                // of the real year. Then make a copy of the format and
+                // replace all occurrences of YEAR in it with some unique
+                // string not appearing anywhere else in it, then use
+                // strftime() to format the date in year YEAR and then replace
+                // YEAR back by the real year and the unique replacement
+                // string back with YEAR. Notice that "all occurrences of YEAR"
+                // means all occurrences of 4 digit as well as 2 digit form!
+                //
+                // the bugs: we assume that neither of %c nor %x contains any
+                // fields which may change between the YEAR and real year. For
+                // example, the week number (%U, %W) and the day number (%j)
+                // will change if one of these years is leap and the other one
+                // is not!
+                {
+                    // find the YEAR: normally, for any year X, Jan 1 of the
+                    // year X + 28 is the same weekday as Jan 1 of X (because
+                    // the weekday advances by 1 for each normal X and by 2
+                    // for each leap X, hence by 5 every 4 years or by 35
+                    // which is 0 mod 7 every 28 years) but this rule breaks
+                    // down if there are years between X and Y which are
+                    // divisible by 4 but not leap (i.e. divisible by 100 but
+                    // not 400), hence the correction.
+
+                    int yearReal = GetYear(tz);
+                    int mod28 = yearReal % 28;
+
+                    // be careful to not go too far - we risk to leave the
+                    // supported range
+                    int year;
+                    if ( mod28 < 10 )
+                    {
+                        year = 1988 + mod28;      // 1988 == 0 (mod 28)
+                    }
+                    else
+                    {
+                        year = 1970 + mod28 - 10; // 1970 == 10 (mod 28)
+                    }
 
-        bool restart = true;
-        while ( restart )
-        {
-            restart = false;
+                    int nCentury = year / 100,
+                        nCenturyReal = yearReal / 100;
 
-            // start of the format specification
-            switch ( (*p).GetValue() )
-            {
-                case wxT('a'):       // a weekday name
-                case wxT('A'):
-                    // second parameter should be true for abbreviated names
-                    res += GetWeekDayName(tm.GetWeekDay(),
-                                          *p == wxT('a') ? Name_Abbr : Name_Full);
-                    break;
+                    // need to adjust for the years divisble by 400 which are
+                    // not leap but are counted like leap ones if we just take
+                    // the number of centuries in between for nLostWeekDays
+                    int nLostWeekDays = (nCentury - nCenturyReal) -
+                                        (nCentury / 4 - nCenturyReal / 4);
 
-                case wxT('b'):       // a month name
-                case wxT('B'):
-                    res += GetMonthName(tm.mon,
-                                        *p == wxT('b') ? Name_Abbr : Name_Full);
-                    break;
-
-                case wxT('c'):       // locale default date and time  representation
-                case wxT('x'):       // locale default date representation
-#ifdef wxHAS_STRFTIME
-                    //
-                    // the problem: there is no way to know what do these format
-                    // specifications correspond to for the current locale.
-                    //
-                    // the solution: use a hack and still use strftime(): first
-                    // find the YEAR which is a year in the strftime() range (1970
-                    // - 2038) whose Jan 1 falls on the same week day as the Jan 1
-                    // of the real year. Then make a copy of the format and
-                    // replace all occurrences of YEAR in it with some unique
-                    // string not appearing anywhere else in it, then use
-                    // strftime() to format the date in year YEAR and then replace
-                    // YEAR back by the real year and the unique replacement
-                    // string back with YEAR. Notice that "all occurrences of YEAR"
-                    // means all occurrences of 4 digit as well as 2 digit form!
-                    //
-                    // the bugs: we assume that neither of %c nor %x contains any
-                    // fields which may change between the YEAR and real year. For
-                    // example, the week number (%U, %W) and the day number (%j)
-                    // will change if one of these years is leap and the other one
-                    // is not!
+                    // we have to gain back the "lost" weekdays: note that the
+                    // effect of this loop is to not do anything to
+                    // nLostWeekDays (which we won't use any more), but to
+                    // (indirectly) set the year correctly
+                    while ( (nLostWeekDays % 7) != 0 )
                     {
-                        // find the YEAR: normally, for any year X, Jan 1 of the
-                        // year X + 28 is the same weekday as Jan 1 of X (because
-                        // the weekday advances by 1 for each normal X and by 2
-                        // for each leap X, hence by 5 every 4 years or by 35
-                        // which is 0 mod 7 every 28 years) but this rule breaks
-                        // down if there are years between X and Y which are
-                        // divisible by 4 but not leap (i.e. divisible by 100 but
-                        // not 400), hence the correction.
-
-                        int yearReal = GetYear(tz);
-                        int mod28 = yearReal % 28;
-
-                        // be careful to not go too far - we risk to leave the
-                        // supported range
-                        int year;
-                        if ( mod28 < 10 )
-                        {
-                            year = 1988 + mod28;      // 1988 == 0 (mod 28)
-                        }
-                        else
-                        {
-                            year = 1970 + mod28 - 10; // 1970 == 10 (mod 28)
-                        }
+                        nLostWeekDays += (year++ % 4) ? 1 : 2;
+                    }
 
-                        int nCentury = year / 100,
-                            nCenturyReal = yearReal / 100;
+                    // finally move the year below 2000 so that the 2-digit
+                    // year number can never match the month or day of the
+                    // month when we do the replacements below
+                    if ( year >= 2000 )
+                        year -= 28;
 
-                        // need to adjust for the years divisble by 400 which are
-                        // not leap but are counted like leap ones if we just take
-                        // the number of centuries in between for nLostWeekDays
-                        int nLostWeekDays = (nCentury - nCenturyReal) -
-                                            (nCentury / 4 - nCenturyReal / 4);
+                    wxASSERT_MSG( year >= 1970 && year < 2000,
+                                  wxT("logic error in wxDateTime::Format") );
 
-                        // we have to gain back the "lost" weekdays: note that the
-                        // effect of this loop is to not do anything to
-                        // nLostWeekDays (which we won't use any more), but to
-                        // (indirectly) set the year correctly
-                        while ( (nLostWeekDays % 7) != 0 )
-                        {
-                            nLostWeekDays += (year++ % 4) ? 1 : 2;
-                        }
 
-                        // finally move the year below 2000 so that the 2-digit
-                        // year number can never match the month or day of the
-                        // month when we do the replacements below
-                        if ( year >= 2000 )
-                            year -= 28;
-
-                        wxASSERT_MSG( year >= 1970 && year < 2000,
-                                      wxT("logic error in wxDateTime::Format") );
-
-
-                        // use strftime() to format the same date but in supported
-                        // year
-                        //
-                        // NB: we assume that strftime() doesn't check for the
-                        //     date validity and will happily format the date
-                        //     corresponding to Feb 29 of a non leap year (which
-                        //     may happen if yearReal was leap and year is not)
-                        struct tm tmAdjusted;
-                        wxInitTm(tmAdjusted);
-                        tmAdjusted.tm_hour = tm.hour;
-                        tmAdjusted.tm_min = tm.min;
-                        tmAdjusted.tm_sec = tm.sec;
-                        tmAdjusted.tm_wday = tm.GetWeekDay();
-                        tmAdjusted.tm_yday = GetDayOfYear();
-                        tmAdjusted.tm_mday = tm.mday;
-                        tmAdjusted.tm_mon = tm.mon;
-                        tmAdjusted.tm_year = year - 1900;
-                        tmAdjusted.tm_isdst = 0; // no DST, already adjusted
-                        wxString str = wxCallStrftime(*p == wxT('c') ? wxT("%c")
-                                                                  : wxT("%x"),
-                                                    &tmAdjusted);
-
-                        // now replace the replacement year with the real year:
-                        // notice that we have to replace the 4 digit year with
-                        // a unique string not appearing in strftime() output
-                        // first to prevent the 2 digit year from matching any
-                        // substring of the 4 digit year (but any day, month,
-                        // hours or minutes components should be safe because
-                        // they are never in 70-99 range)
-                        wxString replacement("|");
-                        while ( str.find(replacement) != wxString::npos )
-                            replacement += '|';
-
-                        str.Replace(wxString::Format("%d", year),
-                                    replacement);
-                        str.Replace(wxString::Format("%d", year % 100),
-                                    wxString::Format("%d", yearReal % 100));
-                        str.Replace(replacement,
-                                    wxString::Format("%d", yearReal));
-
-                        res += str;
-                    }
+                    // use strftime() to format the same date but in supported
+                    // year
+                    //
+                    // NB: we assume that strftime() doesn't check for the
+                    //     date validity and will happily format the date
+                    //     corresponding to Feb 29 of a non leap year (which
+                    //     may happen if yearReal was leap and year is not)
+                    struct tm tmAdjusted;
+                    wxInitTm(tmAdjusted);
+                    tmAdjusted.tm_hour = tm.hour;
+                    tmAdjusted.tm_min = tm.min;
+                    tmAdjusted.tm_sec = tm.sec;
+                    tmAdjusted.tm_wday = tm.GetWeekDay();
+                    tmAdjusted.tm_yday = GetDayOfYear();
+                    tmAdjusted.tm_mday = tm.mday;
+                    tmAdjusted.tm_mon = tm.mon;
+                    tmAdjusted.tm_year = year - 1900;
+                    tmAdjusted.tm_isdst = 0; // no DST, already adjusted
+                    wxString str = wxCallStrftime(op.spec == wxT('c')
+                                                    ? wxT("%c")
+                                                    : wxT("%x"),
+                                                &tmAdjusted);
+
+                    // now replace the replacement year with the real year:
+                    // notice that we have to replace the 4 digit year with
+                    // a unique string not appearing in strftime() output
+                    // first to prevent the 2 digit year from matching any
+                    // substring of the 4 digit year (but any day, month,
+                    // hours or minutes components should be safe because
+                    // they are never in 70-99 range)
+                    wxString replacement("|");
+                    while ( str.find(replacement) != wxString::npos )
+                        replacement += '|';
+
+                    str.Replace(wxString::Format("%d", year),
+                                replacement);
+                    str.Replace(wxString::Format("%d", year % 100),
+                                wxString::Format("%d", yearReal % 100));
+                    str.Replace(replacement,
+                                wxString::Format("%d", yearReal));
+
+                    res += str;
+                }
 #else // !wxHAS_STRFTIME
-                    // Use "%m/%d/%y %H:%M:%S" format instead
-                    res += wxString::Format(wxT("%02d/%02d/%04d %02d:%02d:%02d"),
-                            tm.mon+1,tm.mday, tm.year, tm.hour, tm.min, tm.sec);
+                // Use "%m/%d/%y %H:%M:%S" format instead
+                res += wxString::Format(wxT("%02d/%02d/%04d %02d:%02d:%02d"),
+                        tm.mon+1,tm.mday, tm.year, tm.hour, tm.min, tm.sec);
 #endif // wxHAS_STRFTIME/!wxHAS_STRFTIME
-                    break;
+                break;
 
-                case wxT('d'):       // day of a month (01-31)
-                    res += wxString::Format(fmt, tm.mday);
-                    break;
+            case wxT('d'):       // day of a month (01-31)
+                res += wxString::Format(fmt, tm.mday);
+                break;
 
-                case wxT('g'):      // 2-digit week-based year
-                    res += wxString::Format(fmt, GetWeekBasedYear() % 100);
-                    break;
+            case wxT('g'):      // 2-digit week-based year
+                res += wxString::Format(fmt, GetWeekBasedYear() % 100);
+                break;
 
-                case wxT('G'):       // week-based year with century
-                    res += wxString::Format(fmt, GetWeekBasedYear());
-                    break;
+            case wxT('G'):       // week-based year with century
+                res += wxString::Format(fmt, GetWeekBasedYear());
+                break;
 
-                case wxT('H'):       // hour in 24h format (00-23)
-                    res += wxString::Format(fmt, tm.hour);
-                    break;
+            case wxT('H'):       // hour in 24h format (00-23)
+                res += wxString::Format(fmt, tm.hour);
+                break;
 
-                case wxT('I'):       // hour in 12h format (01-12)
-                    {
-                        // 24h -> 12h, 0h -> 12h too
-                        int hour12 = tm.hour > 12 ? tm.hour - 12
-                                                  : tm.hour ? tm.hour : 12;
-                        res += wxString::Format(fmt, hour12);
-                    }
-                    break;
+            case wxT('I'):       // hour in 12h format (01-12)
+                {
+                    // 24h -> 12h, 0h -> 12h too
+                    int hour12 = tm.hour > 12 ? tm.hour - 12
+                                              : tm.hour ? tm.hour : 12;
+                    res += wxString::Format(fmt, hour12);
+                }
+                break;
 
-                case wxT('j'):       // day of the year
-                    res += wxString::Format(fmt, GetDayOfYear(tz));
-                    break;
+            case wxT('j'):       // day of the year
+                res += wxString::Format(fmt, GetDayOfYear(tz));
+                break;
 
-                case wxT('l'):       // milliseconds (NOT STANDARD)
-                    res += wxString::Format(fmt, GetMillisecond(tz));
-                    break;
+            case wxT('l'):       // milliseconds (NOT STANDARD)
+                res += wxString::Format(fmt, GetMillisecond(tz));
+                break;
 
-                case wxT('m'):       // month as a number (01-12)
-                    res += wxString::Format(fmt, tm.mon + 1);
-                    break;
+            case wxT('m'):       // month as a number (01-12)
+                res += wxString::Format(fmt, tm.mon + 1);
+                break;
 
-                case wxT('M'):       // minute as a decimal number (00-59)
-                    res += wxString::Format(fmt, tm.min);
-                    break;
+            case wxT('M'):       // minute as a decimal number (00-59)
+                res += wxString::Format(fmt, tm.min);
+                break;
 
-                case wxT('p'):       // AM or PM string
+            case wxT('p'):       // AM or PM string
 #ifdef wxHAS_STRFTIME
-                    res += wxCallStrftime(wxS("%p"), &tmTimeOnly);
+                res += wxCallStrftime(wxS("%p"), &tmTimeOnly);
 #else // !wxHAS_STRFTIME
-                    res += (tmTimeOnly.tm_hour > 12) ? wxT("pm") : wxT("am");
+                res += (tmTimeOnly.tm_hour > 12) ? wxT("pm") : wxT("am");
 #endif // wxHAS_STRFTIME/!wxHAS_STRFTIME
-                    break;
+                break;
 
-                case wxT('S'):       // second as a decimal number (00-61)
-                    res += wxString::Format(fmt, tm.sec);
-                    break;
+            case wxT('S'):       // second as a decimal number (00-61)
+                res += wxString::Format(fmt, tm.sec);
+                break;
 
-                case wxT('U'):       // week number in the year (Sunday 1st week day)
-                    res += wxString::Format(fmt, GetWeekOfYear(Sunday_First, tz));
-                    break;
+            case wxT('U'):       // week number in the year (Sunday 1st week day)
+                res += wxString::Format(fmt, GetWeekOfYear(Sunday_First, tz));
+                break;
 
-                case wxT('V'):       // ISO week number
-                case wxT('W'):       // week number in the year (Monday 1st week day)
-                    res += wxString::Format(fmt, GetWeekOfYear(Monday_First, tz));
-                    break;
+            case wxT('V'):       // ISO week number
+            case wxT('W'):       // week number in the year (Monday 1st week day)
+                res += wxString::Format(fmt, GetWeekOfYear(Monday_First, tz));
+                break;
 
-                case wxT('w'):       // weekday as a number (0-6), Sunday = 0
-                    res += wxString::Format(fmt, tm.GetWeekDay());
-                    break;
+            case wxT('w'):       // weekday as a number (0-6), Sunday = 0
+                res += wxString::Format(fmt, tm.GetWeekDay());
+                break;
 
-                // case wxT('x'): -- handled with "%c"
+            // case wxT('x'): -- handled with "%c"
 
-                case wxT('X'):       // locale default time representation
-                    // just use strftime() to format the time for us
+            case wxT('X'):       // locale default time representation
+                // just use strftime() to format the time for us
 #ifdef wxHAS_STRFTIME
-                    res += wxCallStrftime(wxS("%X"), &tmTimeOnly);
+                res += wxCallStrftime(wxS("%X"), &tmTimeOnly);
 #else // !wxHAS_STRFTIME
-                    res += wxString::Format(wxT("%02d:%02d:%02d"),tm.hour, tm.min, tm.sec);
+                res += wxString::Format(wxT("%02d:%02d:%02d"),tm.hour, tm.min, tm.sec);
 #endif // wxHAS_STRFTIME/!wxHAS_STRFTIME
-                    break;
-
-                case wxT('y'):       // year without century (00-99)
-                    res += wxString::Format(fmt, tm.year % 100);
-                    break;
-
-                case wxT('Y'):       // year with century
-                    res += wxString::Format(fmt, tm.year);
-                    break;
+                break;
 
-                case wxT('z'):       // time zone as [-+]HHMM
-                    {
-                        int ofs = tz.GetOffset();
+            case wxT('y'):       // year without century (00-99)
+                res += wxString::Format(fmt, tm.year % 100);
+                break;
 
-                        // The time zone offset does not include the DST, but
-                        // we do need to take it into account when showing the
-                        // time in the local time zone to the user.
-                        if ( ofs == -wxGetTimeZone() && IsDST() == 1 )
-                        {
-                            ofs += DST_OFFSET;
-                        }
+            case wxT('Y'):       // year with century
+                res += wxString::Format(fmt, tm.year);
+                break;
 
-                        if ( ofs < 0 )
-                        {
-                            res += '-';
-                            ofs = -ofs;
-                        }
-                        else
-                        {
-                            res += '+';
-                        }
+            case wxT('z'):       // time zone as [-+]HHMM
+                {
+                    int ofs = tz.GetOffset();
 
-                        // Converts seconds to HHMM representation.
-                        res += wxString::Format(fmt,
-                                                100*(ofs/3600) + (ofs/60)%60);
+                    // The time zone offset does not include the DST, but
+                    // we do need to take it into account when showing the
+                    // time in the local time zone to the user.
+                    if ( ofs == -wxGetTimeZone() && IsDST() == 1 )
+                    {
+                        ofs += DST_OFFSET;
                     }
-                    break;
-
-                case wxT('Z'):       // timezone name
-#ifdef wxHAS_STRFTIME
-                    res += wxCallStrftime(wxS("%Z"), &tmTimeOnly);
-#endif
-                    break;
 
-                default:
-                    // is it the format width?
-                    for ( fmt.clear();
-                          *p == wxT('-') || *p == wxT('+') ||
-                            *p == wxT(' ') || wxIsdigit(*p);
-                          ++p )
+                    if ( ofs < 0 )
                     {
-                        fmt += *p;
+                        res += '-';
+                        ofs = -ofs;
                     }
-
-                    if ( !fmt.empty() )
+                    else
                     {
-                        // we've only got the flags and width so far in fmt
-                        fmt.Prepend(wxT('%'));
-                        fmt.Append(wxT('d'));
-
-                        restart = true;
-
-                        break;
+                        res += '+';
                     }
 
-                    // no, it wasn't the width
-                    wxFAIL_MSG(wxT("unknown format specifier"));
+                    // Converts seconds to HHMM representation.
+                    res += wxString::Format(fmt,
+                                            100*(ofs/3600) + (ofs/60)%60);
+                }
+                break;
 
-                    wxFALLTHROUGH;
+            case wxT('Z'):       // timezone name
+#ifdef wxHAS_STRFTIME
+                res += wxCallStrftime(wxS("%Z"), &tmTimeOnly);
+#endif
+                break;
 
-                case wxT('%'):       // a percent sign
-                    res += *p;
-                    break;
+            default:
+                wxFAIL_MSG(wxT("unknown format specifier"));
 
-                case 0:             // the end of string
-                    wxFAIL_MSG(wxT("missing format at the end of string"));
+                wxFALLTHROUGH;
 
-                    // just put the '%' which was the last char in format
-                    res += wxT('%');
-                    break;
-            }
+            case wxT('%'):       // a percent sign
+                res += op.spec;
+                break;
         }
     }
 
@@ -985,6 +1152,19 @@ wxDateTime::ParseFormat(const wxString& date,
                         wxString::const_iterator *endParse)
 {
     wxCHECK_MSG( !format.empty(), false, "format can't be empty" );
+
+    // compiling the format is cheap compared to using it, so just compile it
+    // for a single use here
+    return ParseFormat(date, wxDateTimeFormat(format), dateDef, endParse);
+}
+
+bool
+wxDateTime::ParseFormat(const wxString& date,
+                        const wxDateTimeFormat& format,
+                        const wxDateTime& dateDef,
+                        wxString::const_iterator *endParse)
+{
+    wxCHECK_MSG( format.IsOk(), false, "format can't be empty" );
     wxCHECK_MSG( endParse, false, "end iterator pointer must be specified" );
 
     wxString str;
@@ -1020,70 +1200,57 @@ wxDateTime::ParseFormat(const wxString& date,
 
     wxString::const_iterator input = date.begin();
     const wxString::const_iterator end = date.end();
-    for ( wxString::const_iterator fmt = format.begin(); fmt != format.end(); ++fmt )
+    for ( wxVector<wxDateTimeFormat::Op>::const_iterator
+            it = format.m_ops.begin(); it != format.m_ops.end(); ++it )
     {
-        if ( *fmt != wxT('%') )
+        const wxDateTimeFormat::Op& op = *it;
+
+        if ( !op.spec )
         {
-            if ( wxIsspace(*fmt) )
+            for ( wxString::const_iterator fmt = op.text.begin();
+                  fmt != op.text.end();
+                  ++fmt )
             {
-                // a white space in the format string matches 0 or more white
-                // spaces in the input
-                while ( input != end && wxIsspace(*input) )
+                if ( wxIsspace(*fmt) )
                 {
-                    ++input;
+                    // a white space in the format string matches 0 or more
+                    // white spaces in the input
+                    while ( input != end && wxIsspace(*input) )
+                    {
+                        ++input;
+                    }
                 }
-            }
-            else // !space
-            {
-                // any other character (not whitespace, not '%') must be
-                // matched by itself in the input
-                if ( input == end || *input++ != *fmt )
+                else // !space
                 {
-                    // no match
-                    return false;
+                    // any other character (not whitespace, not '%') must be
+                    // matched by itself in the input
+                    if ( input == end || *input++ != *fmt )
+                    {
+                        // no match
+                        return false;
+                    }
                 }
             }
 
-            // done with this format char
+            // done with this literal
             continue;
         }
 
         // start of a format specification
 
-        // parse the optional width
-        size_t width = 0;
-        while ( wxIsdigit(*++fmt) )
+        if ( !op.parseable )
         {
-            width *= 10;
-            width += *fmt - '0';
+            // the printf() flags used when formatting have no meaning when
+            // parsing
+            return false;
         }
 
-        // the default widths for the various fields
-        if ( !width )
-        {
-            switch ( (*fmt).GetValue() )
-            {
-                case wxT('Y'):               // year has 4 digits
-                    width = 4;
-                    break;
-
-                case wxT('j'):               // day of year has 3 digits
-                case wxT('l'):               // milliseconds have 3 digits
-                    width = 3;
-                    break;
-
-                case wxT('w'):               // week day as number has only one
-                    width = 1;
-                    break;
-
-                default:
-                    // default for all other fields
-                    width = 2;
-            }
-        }
+        // the explicit or default field width, computed when the format was
+        // compiled
+        const size_t width = op.width;
 
         // then the format itself
-        switch ( (*fmt).GetValue() )
+        switch ( op.spec.GetValue() )
         {
             case wxT('a'):       // a weekday name
             case wxT('A'):
@@ -1091,8 +1258,10 @@ wxDateTime::ParseFormat(const wxString& date,
                     wday = GetWeekDayFromName
                            (
                             input, end,
-                            *fmt == 'a' ? Name_Abbr : Name_Full,
-                            DateLang_Local
+                            op.spec == 'a' ? Name_Abbr : Name_Full,
+                            DateLang_Local,
+                            format.GetWeekDayNames(Name_Full),
+                            format.GetWeekDayNames(Name_Abbr)
                            );
                     if ( wday == Inv_WeekDay )
                     {
@@ -1109,8 +1278,10 @@ wxDateTime::ParseFormat(const wxString& date,
                     mon = GetMonthFromName
                           (
                             input, end,
-                            *fmt == 'b' ? Name_Abbr : Name_Full,
-                            DateLang_Local
+                            op.spec == 'b' ? Name_Abbr : Name_Full,
+                            DateLang_Local,
+                            format.GetMonthNames(Name_Full),
+                            format.GetMonthNames(Name_Abbr)
                           );
                     if ( mon == Inv_Month )
                     {
@@ -1248,7 +1419,7 @@ wxDateTime::ParseFormat(const wxString& date,
             case wxT('p'):       // AM or PM string
                 {
                     wxString am, pm;
-                    GetAmPmStrings(&am, &pm);
+                    format.GetCachedAmPmStrings(&am, &pm);
 
                     // we can never match %p in locales which don't use AM/PM
                     if ( am.empty() || pm.empty() )
@@ -1553,11 +1724,6 @@ wxDateTime::ParseFormat(const wxString& date,
                 }
                 break;
 
-            case 0:             // the end of string
-                wxFAIL_MSG(wxT("unexpected format end"));
-
-                wxFALLTHROUGH;
-
             default:            // not a known format spec
                 return false;
         }
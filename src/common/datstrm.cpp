@@ -312,23 +312,27 @@ static
 void DoWriteI64(const T *buffer, size_t size, wxOutputStream *output, bool be_order)
 {
   typedef T DataType;
-  if ( be_order )
+
+  if ( be_order == (wxBYTE_ORDER == wxBIG_ENDIAN) )
   {
-    for ( size_t i = 0; i < size; i++ )
-    {
-      DataType i64 = wxUINT64_SWAP_ON_LE(*buffer);
-      buffer++;
-      output->Write(&i64, 8);
-    }
+    // The data is already in the stream byte order, no conversion needed.
+    output->Write(buffer, size * 8);
+    return;
   }
-  else // little endian
+
+  // Swap the values into a chunk and write it out as one block instead of
+  // doing a separate Write() call for every value.
+  DataType chunk[512];
+  while ( size != 0 )
   {
-    for ( size_t i=0; i < size; i++ )
-    {
-      DataType i64 = wxUINT64_SWAP_ON_BE(*buffer);
-      buffer++;
-      output->Write(&i64, 8);
-    }
+    const size_t n = size < WXSIZEOF(chunk) ? size : WXSIZEOF(chunk);
+    for ( size_t i = 0; i < n; i++ )
+      chunk[i] = wxUINT64_SWAP_ALWAYS(buffer[i]);
+
+    output->Write(chunk, n * 8);
+
+    buffer += n;
+    size -= n;
   }
 }
 
@@ -437,20 +441,78 @@ void wxDataInputStream::Read8(wxUint8 *buffer, size_t size)
 
 void wxDataInputStream::ReadDouble(double *buffer, size_t size)
 {
+#if wxUSE_APPLE_IEEE
+  if ( m_useExtendedPrecision )
+  {
+    for (wxUint32 i=0; i<size; i++)
+    {
+      *(buffer++) = ReadDouble();
+    }
+
+    return;
+  }
+#endif // wxUSE_APPLE_IEEE
+
+#if wxHAS_INT64
+  // Each double is stored as its IEEE 754 representation in the stream byte
+  // order, so we can read the whole block at once and swap the bytes in
+  // place, which is much faster than reading the values one by one. Going
+  // through memcpy() is needed to avoid aliasing problems and is optimized
+  // away by all commonly used compilers (which also vectorize this loop).
+  m_input->Read(buffer, size * 8);
+
+  if ( m_be_order != (wxBYTE_ORDER == wxBIG_ENDIAN) )
+  {
+    for ( size_t i = 0; i < size; i++ )
+    {
+      wxUint64 v;
+      memcpy(&v, &buffer[i], 8);
+      v = wxUINT64_SWAP_ALWAYS(v);
+      memcpy(&buffer[i], &v, 8);
+    }
+  }
+#else // !wxHAS_INT64
   for (wxUint32 i=0; i<size; i++)
   {
     *(buffer++) = ReadDouble();
   }
+#endif // wxHAS_INT64/!wxHAS_INT64
 }
 
 void wxDataInputStream::ReadFloat(float *buffer, size_t size)
 {
-  for (wxUint32 i=0; i<size; i++)
+#if wxUSE_APPLE_IEEE
+  if ( m_useExtendedPrecision )
   {
-    *(buffer++) = ReadFloat();
+    for (wxUint32 i=0; i<size; i++)
+    {
+      *(buffer++) = ReadFloat();
+    }
+
+    return;
+  }
+#endif // wxUSE_APPLE_IEEE
+
+  // See the comment in ReadDouble() above.
+  m_input->Read(buffer, size * 4);
+
+  if ( m_be_order != (wxBYTE_ORDER == wxBIG_ENDIAN) )
+  {
+    for ( size_t i = 0; i < size; i++ )
+    {
+      wxUint32 v;
+      memcpy(&v, &buffer[i], 4);
+      v = wxUINT32_SWAP_ALWAYS(v);
+      memcpy(&buffer[i], &v, 4);
+    }
   }
 }
 
+void wxDataInputStream::ReadRaw(void *buffer, size_t size)
+{
+  m_input->Read(buffer, size);
+}
+
 wxDataInputStream& wxDataInputStream::operator>>(wxString& s)
 {
   s = ReadString();
@@ -700,45 +762,48 @@ void wxDataOutputStream::WriteLL(const wxULongLong &ll)
 
 void wxDataOutputStream::Write32(const wxUint32 *buffer, size_t size)
 {
-  if (m_be_order)
+  if ( m_be_order == (wxBYTE_ORDER == wxBIG_ENDIAN) )
   {
-    for (wxUint32 i=0; i<size ;i++)
-    {
-      wxUint32 i32 = wxUINT32_SWAP_ON_LE(*buffer);
-      buffer++;
-      m_output->Write(&i32, 4);
-    }
+    // The data is already in the stream byte order, write it out directly.
+    m_output->Write(buffer, size * 4);
+    return;
   }
-  else
+
+  // Swap the values into a chunk and write it out as one block instead of
+  // doing a separate Write() call for every value.
+  wxUint32 chunk[1024];
+  while ( size != 0 )
   {
-    for (wxUint32 i=0; i<size ;i++)
-    {
-      wxUint32 i32 = wxUINT32_SWAP_ON_BE(*buffer);
-      buffer++;
-      m_output->Write(&i32, 4);
-    }
+    const size_t n = size < WXSIZEOF(chunk) ? size : WXSIZEOF(chunk);
+    for ( size_t i = 0; i < n; i++ )
+      chunk[i] = wxUINT32_SWAP_ALWAYS(buffer[i]);
+
+    m_output->Write(chunk, n * 4);
+
+    buffer += n;
+    size -= n;
   }
 }
 
 void wxDataOutputStream::Write16(const wxUint16 *buffer, size_t size)
 {
-  if (m_be_order)
+  if ( m_be_order == (wxBYTE_ORDER == wxBIG_ENDIAN) )
   {
-    for (wxUint32 i=0; i<size ;i++)
-    {
-      wxUint16 i16 = wxUINT16_SWAP_ON_LE(*buffer);
-      buffer++;
-      m_output->Write(&i16, 2);
-    }
+    m_output->Write(buffer, size * 2);
+    return;
   }
-  else
+
+  wxUint16 chunk[2048];
+  while ( size != 0 )
   {
-    for (wxUint32 i=0; i<size ;i++)
-    {
-      wxUint16 i16 = wxUINT16_SWAP_ON_BE(*buffer);
-      buffer++;
-      m_output->Write(&i16, 2);
-    }
+    const size_t n = size < WXSIZEOF(chunk) ? size : WXSIZEOF(chunk);
+    for ( size_t i = 0; i < n; i++ )
+      chunk[i] = wxUINT16_SWAP_ALWAYS(buffer[i]);
+
+    m_output->Write(chunk, n * 2);
+
+    buffer += n;
+    size -= n;
   }
 }
 
@@ -749,18 +814,92 @@ void wxDataOutputStream::Write8(const wxUint8 *buffer, size_t size)
 
 void wxDataOutputStream::WriteDouble(const double *buffer, size_t size)
 {
+#if wxUSE_APPLE_IEEE
+  if ( m_useExtendedPrecision )
+  {
+    for (wxUint32 i=0; i<size; i++)
+    {
+      WriteDouble(*(buffer++));
+    }
+
+    return;
+  }
+#endif // wxUSE_APPLE_IEEE
+
+#if wxHAS_INT64
+  // As in wxDataInputStream::ReadDouble(), the stream format is just the
+  // IEEE 754 representation in the stream byte order.
+  if ( m_be_order == (wxBYTE_ORDER == wxBIG_ENDIAN) )
+  {
+    m_output->Write(buffer, size * 8);
+    return;
+  }
+
+  wxUint64 chunk[512];
+  while ( size != 0 )
+  {
+    const size_t n = size < WXSIZEOF(chunk) ? size : WXSIZEOF(chunk);
+    for ( size_t i = 0; i < n; i++ )
+    {
+      wxUint64 v;
+      memcpy(&v, &buffer[i], 8);
+      chunk[i] = wxUINT64_SWAP_ALWAYS(v);
+    }
+
+    m_output->Write(chunk, n * 8);
+
+    buffer += n;
+    size -= n;
+  }
+#else // !wxHAS_INT64
   for (wxUint32 i=0; i<size; i++)
   {
     WriteDouble(*(buffer++));
   }
+#endif // wxHAS_INT64/!wxHAS_INT64
 }
 
 void wxDataOutputStream::WriteFloat(const float *buffer, size_t size)
 {
-  for (wxUint32 i=0; i<size; i++)
+#if wxUSE_APPLE_IEEE
+  if ( m_useExtendedPrecision )
   {
-    WriteFloat(*(buffer++));
+    for (wxUint32 i=0; i<size; i++)
+    {
+      WriteFloat(*(buffer++));
+    }
+
+    return;
   }
+#endif // wxUSE_APPLE_IEEE
+
+  if ( m_be_order == (wxBYTE_ORDER == wxBIG_ENDIAN) )
+  {
+    m_output->Write(buffer, size * 4);
+    return;
+  }
+
+  wxUint32 chunk[1024];
+  while ( size != 0 )
+  {
+    const size_t n = size < WXSIZEOF(chunk) ? size : WXSIZEOF(chunk);
+    for ( size_t i = 0; i < n; i++ )
+    {
+      wxUint32 v;
+      memcpy(&v, &buffer[i], 4);
+      chunk[i] = wxUINT32_SWAP_ALWAYS(v);
+    }
+
+    m_output->Write(chunk, n * 4);
+
+    buffer += n;
+    size -= n;
+  }
+}
+
+void wxDataOutputStream::WriteRaw(const void *buffer, size_t size)
+{
+  m_output->Write(buffer, size);
 }
 
 wxDataOutputStream& wxDataOutputStream::operator<<(const wxString& string)
@@ -35,8 +35,13 @@
     #include "wx/window.h"
 #endif
 
+#include "wx/hashmap.h"
+#include "wx/vector.h"
+
 #include "wx/private/textmeasure.h"
 
+#include <algorithm>
+
 #ifdef __WXMSW__
     #include "wx/msw/dcclient.h"
     #include "wx/msw/dcmemory.h"
@@ -1155,12 +1160,385 @@ void wxDCImpl::DoGetFontMetrics(int *height,
         *internalLeading = 0;
 }
 
+//-----------------------------------------------------------------------------
+// wxTextExtentCache
+//-----------------------------------------------------------------------------
+
+namespace
+{
+
+struct wxTextExtentCacheEntry
+{
+    wxSize extent;
+    wxCoord descent;
+    wxCoord externalLeading;
+
+    // Pseudo-time of the last use of this entry, used for evicting the least
+    // recently used entries when the cache becomes too big.
+    wxUint32 lastUsed;
+};
+
+WX_DECLARE_STRING_HASH_MAP(wxTextExtentCacheEntry, wxTextExtentCacheMap);
+
+bool gs_textExtentCacheEnabled = false;
+size_t gs_textExtentCacheMaxSize = 4096;
+wxUint32 gs_textExtentCacheTime = 0;
+wxTextExtentCache::Stats gs_textExtentCacheStats = { 0, 0, 0 };
+
+wxTextExtentCacheMap& GetTextExtentCacheMap()
+{
+    static wxTextExtentCacheMap s_map;
+    return s_map;
+}
+
+} // anonymous namespace
+
+void wxTextExtentCache::Enable(bool enable)
+{
+    gs_textExtentCacheEnabled = enable;
+}
+
+bool wxTextExtentCache::IsEnabled()
+{
+    return gs_textExtentCacheEnabled;
+}
+
+void wxTextExtentCache::SetMaxSize(size_t maxSize)
+{
+    // The new size is only applied when the next entry is added, there is no
+    // need to trim the cache immediately.
+    gs_textExtentCacheMaxSize = maxSize;
+}
+
+void wxTextExtentCache::Clear()
+{
+    GetTextExtentCacheMap().clear();
+}
+
+wxTextExtentCache::Stats wxTextExtentCache::GetStats()
+{
+    return gs_textExtentCacheStats;
+}
+
+void wxTextExtentCache::ResetStats()
+{
+    gs_textExtentCacheStats.hits =
+    gs_textExtentCacheStats.misses =
+    gs_textExtentCacheStats.evictions = 0;
+}
+
+wxString
+wxTextExtentCache::BuildKey(const wxDC& dc,
+                            const wxFont& font,
+                            const wxString& string)
+{
+    double userScaleX, userScaleY;
+    dc.GetUserScale(&userScaleX, &userScaleY);
+
+    double logicalScaleX, logicalScaleY;
+    dc.GetLogicalScale(&logicalScaleX, &logicalScaleY);
+
+    // Use the native font description and not e.g. the address of the font
+    // reference data, which could be reused by a different font later: with
+    // a purely value-based key, font or DPI changes can never return stale
+    // extents and no explicit invalidation is needed.
+    wxString key;
+    key << font.GetNativeFontInfoDesc() << '\n'
+        << dc.GetContentScaleFactor() << ','
+        << userScaleX << ',' << userScaleY << ','
+        << logicalScaleX << ',' << logicalScaleY << '\n'
+        << string;
+    return key;
+}
+
+bool
+wxTextExtentCache::Find(const wxString& key, wxSize& extent,
+                        wxCoord& descent, wxCoord& externalLeading)
+{
+    wxTextExtentCacheMap& map = GetTextExtentCacheMap();
+
+    wxTextExtentCacheMap::iterator it = map.find(key);
+    if ( it == map.end() )
+    {
+        gs_textExtentCacheStats.misses++;
+        return false;
+    }
+
+    it->second.lastUsed = ++gs_textExtentCacheTime;
+
+    extent = it->second.extent;
+    descent = it->second.descent;
+    externalLeading = it->second.externalLeading;
+
+    gs_textExtentCacheStats.hits++;
+
+    return true;
+}
+
+void
+wxTextExtentCache::Add(const wxString& key, const wxSize& extent,
+                       wxCoord descent, wxCoord externalLeading)
+{
+    wxTextExtentCacheMap& map = GetTextExtentCacheMap();
+
+    if ( map.size() >= gs_textExtentCacheMaxSize && map.count(key) == 0 )
+    {
+        // Evict the least recently used half of the entries: this keeps the
+        // hot strings while bounding both the cache size and the (rare)
+        // eviction cost.
+        wxVector<wxUint32> times;
+        times.reserve(map.size());
+
+        wxTextExtentCacheMap::iterator it;
+        for ( it = map.begin(); it != map.end(); ++it )
+            times.push_back(it->second.lastUsed);
+
+        wxVector<wxUint32>::iterator mid = times.begin() + times.size() / 2;
+        std::nth_element(times.begin(), mid, times.end());
+        const wxUint32 cutoff = *mid;
+
+        wxVector<wxString> doomed;
+        for ( it = map.begin(); it != map.end(); ++it )
+        {
+            if ( it->second.lastUsed <= cutoff )
+                doomed.push_back(it->first);
+        }
+
+        for ( size_t n = 0; n < doomed.size(); n++ )
+            map.erase(doomed[n]);
+
+        gs_textExtentCacheStats.evictions += doomed.size();
+    }
+
+    wxTextExtentCacheEntry entry;
+    entry.extent = extent;
+    entry.descent = descent;
+    entry.externalLeading = externalLeading;
+    entry.lastUsed = ++gs_textExtentCacheTime;
+
+    map[key] = entry;
+}
+
+//-----------------------------------------------------------------------------
+// wxDCStats
+//-----------------------------------------------------------------------------
+
+bool wxDCStats::ms_enabled = false;
+unsigned long wxDCStats::ms_counts[wxDC_STATS_MAX] = { 0 };
+
+namespace
+{
+
+// total pixels covered by the counted area calls, see OnCallArea()
+wxULongLong gs_dcStatsPixels(0, 0);
+
+} // anonymous namespace
+
+void wxDCStats::Enable(bool enable)
+{
+    // start every counting session from a clean slate
+    if ( enable && !ms_enabled )
+        Reset();
+
+    ms_enabled = enable;
+}
+
+void wxDCStats::Reset()
+{
+    for ( int n = 0; n < wxDC_STATS_MAX; n++ )
+        ms_counts[n] = 0;
+
+    gs_dcStatsPixels = wxULongLong(0, 0);
+}
+
+void wxDCStats::DoAddPixels(wxCoord w, wxCoord h)
+{
+    if ( w > 0 && h > 0 )
+        gs_dcStatsPixels += (unsigned long)w * (unsigned long)h;
+}
+
+unsigned long wxDCStats::GetCount(wxDCStatsCategory cat)
+{
+    wxCHECK_MSG( cat < wxDC_STATS_MAX, 0, wxS("invalid draw call category") );
+
+    return ms_counts[cat];
+}
+
+unsigned long wxDCStats::GetTotalCount()
+{
+    unsigned long total = 0;
+    for ( int n = 0; n < wxDC_STATS_MAX; n++ )
+        total += ms_counts[n];
+
+    return total;
+}
+
+wxULongLong wxDCStats::GetPixelsTouched()
+{
+    return gs_dcStatsPixels;
+}
+
+/* static */
+wxString wxDCStats::GetCategoryName(wxDCStatsCategory cat)
+{
+    switch ( cat )
+    {
+        case wxDC_STATS_LINES:
+            return wxS("lines");
+        case wxDC_STATS_RECTANGLES:
+            return wxS("rectangles");
+        case wxDC_STATS_ELLIPSES:
+            return wxS("ellipses");
+        case wxDC_STATS_POLYGONS:
+            return wxS("polygons");
+        case wxDC_STATS_BITMAPS:
+            return wxS("bitmaps");
+        case wxDC_STATS_TEXT:
+            return wxS("text");
+        case wxDC_STATS_TEXT_EXTENTS:
+            return wxS("text extents");
+        case wxDC_STATS_BLITS:
+            return wxS("blits");
+        case wxDC_STATS_CLIP_CHANGES:
+            return wxS("clip changes");
+        case wxDC_STATS_OTHER:
+            return wxS("other");
+        case wxDC_STATS_MAX:
+            break;
+    }
+
+    wxFAIL_MSG( wxS("invalid draw call category") );
+
+    return wxString();
+}
+
+wxString wxDCStats::GetSummary()
+{
+    wxString s = wxString::Format(wxS("%lu draw calls"), GetTotalCount());
+
+    for ( int n = 0; n < wxDC_STATS_MAX; n++ )
+    {
+        if ( ms_counts[n] )
+        {
+            s += wxString::Format(wxS(", %s: %lu"),
+                                  GetCategoryName((wxDCStatsCategory)n),
+                                  ms_counts[n]);
+        }
+    }
+
+    s += wxString::Format(wxS(", ~%s pixels touched"),
+                          gs_dcStatsPixels.ToString());
+
+    return s;
+}
+
+void wxDCStats::DrawOverlay(wxDC& dc, const wxPoint& pos)
+{
+    // the overlay's own draw calls shouldn't pollute the counters
+    const bool wasEnabled = ms_enabled;
+    ms_enabled = false;
+
+    wxVector<wxString> lines;
+    lines.push_back(wxString::Format(wxS("draw calls: %lu"),
+                                     GetTotalCount()));
+    for ( int n = 0; n < wxDC_STATS_MAX; n++ )
+    {
+        if ( ms_counts[n] )
+        {
+            lines.push_back(wxString::Format(wxS("%s: %lu"),
+                                GetCategoryName((wxDCStatsCategory)n),
+                                ms_counts[n]));
+        }
+    }
+    lines.push_back(wxS("pixels: ~") + gs_dcStatsPixels.ToString());
+
+    dc.SetFont(*wxSMALL_FONT);
+
+    wxCoord widthMax = 0,
+            heightLine = 0;
+    for ( size_t n = 0; n < lines.size(); n++ )
+    {
+        wxCoord w, h;
+        dc.GetTextExtent(lines[n], &w, &h);
+        if ( w > widthMax )
+            widthMax = w;
+        if ( h > heightLine )
+            heightLine = h;
+    }
+
+    const wxCoord heightTotal = heightLine*(wxCoord)lines.size();
+
+    const wxCoord MARGIN = 4;
+
+    // translucent black background where the DC supports alpha, solid
+    // black elsewhere
+    dc.SetPen(*wxTRANSPARENT_PEN);
+    dc.SetBrush(wxBrush(wxColour(0, 0, 0, 160)));
+    dc.DrawRectangle(pos.x, pos.y,
+                     widthMax + 2*MARGIN, heightTotal + 2*MARGIN);
+
+    dc.SetTextForeground(*wxWHITE);
+    wxCoord y = pos.y + MARGIN;
+    for ( size_t n = 0; n < lines.size(); n++ )
+    {
+        dc.DrawText(lines[n], pos.x + MARGIN, y);
+        y += heightLine;
+    }
+
+    ms_enabled = wasEnabled;
+}
+
 //-----------------------------------------------------------------------------
 // wxDC
 //-----------------------------------------------------------------------------
 
 wxIMPLEMENT_ABSTRACT_CLASS(wxDC, wxObject);
 
+void wxDC::GetTextExtent(const wxString& string,
+                         wxCoord *x, wxCoord *y,
+                         wxCoord *descent,
+                         wxCoord *externalLeading,
+                         const wxFont *theFont) const
+{
+    wxDCStats::OnCall(wxDC_STATS_TEXT_EXTENTS);
+
+    if ( wxTextExtentCache::IsEnabled() )
+    {
+        const wxFont& font = theFont ? *theFont : m_pimpl->GetFont();
+        if ( font.IsOk() )
+        {
+            const wxString
+                key = wxTextExtentCache::BuildKey(*this, font, string);
+
+            wxSize extent;
+            wxCoord descentReal, externalLeadingReal;
+            if ( !wxTextExtentCache::Find(key, extent,
+                                          descentReal, externalLeadingReal) )
+            {
+                m_pimpl->DoGetTextExtent(string, &extent.x, &extent.y,
+                                         &descentReal, &externalLeadingReal,
+                                         theFont);
+
+                wxTextExtentCache::Add(key, extent,
+                                       descentReal, externalLeadingReal);
+            }
+
+            if ( x )
+                *x = extent.x;
+            if ( y )
+                *y = extent.y;
+            if ( descent )
+                *descent = descentReal;
+            if ( externalLeading )
+                *externalLeading = externalLeadingReal;
+
+            return;
+        }
+    }
+
+    m_pimpl->DoGetTextExtent(string, x, y, descent, externalLeading, theFont);
+}
+
 void wxDC::CopyAttributes(const wxDC& dc)
 {
     SetFont(dc.GetFont());
@@ -1348,9 +1726,9 @@ void wxDC::GetTextExtent(const wxString& string,
                        const wxFont *theFont) const
     {
         wxCoord x2, y2, descent2, externalLeading2;
-        m_pimpl->DoGetTextExtent(string, &x2, &y2,
-                        &descent2, &externalLeading2,
-                        theFont);
+        GetTextExtent(string, &x2, &y2,
+                      &descent2, &externalLeading2,
+                      theFont);
         if ( x )
             *x = x2;
         if ( y )
@@ -34,7 +34,8 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxBufferedDC, wxMemoryDC);
 wxIMPLEMENT_ABSTRACT_CLASS(wxBufferedPaintDC, wxBufferedDC);
 
 // ----------------------------------------------------------------------------
-// wxSharedDCBufferManager: helper class maintaining backing store bitmap
+// wxSharedDCBufferManager: helper class maintaining a small pool of backing
+// store bitmaps shared by all buffered DCs
 // ----------------------------------------------------------------------------
 
 class wxSharedDCBufferManager : public wxModule
@@ -43,37 +44,65 @@ public:
     wxSharedDCBufferManager() { }
 
     virtual bool OnInit() wxOVERRIDE { return true; }
-    virtual void OnExit() wxOVERRIDE { wxDELETE(ms_buffer); }
+    virtual void OnExit() wxOVERRIDE
+    {
+        for ( size_t n = 0; n < NUM_BUFFERS; n++ )
+            wxDELETE(ms_buffers[n].bitmap);
+    }
 
     static wxBitmap* GetBuffer(wxDC* dc, int w, int h)
     {
-        if ( ms_usingSharedBuffer )
-            return DoCreateBuffer(dc, w, h);
+        // first look for a pooled buffer which is free and already big enough
+        SharedBuffer* bufFree = NULL;
+        for ( size_t n = 0; n < NUM_BUFFERS; n++ )
+        {
+            SharedBuffer& buf = ms_buffers[n];
+            if ( buf.inUse )
+                continue;
+
+            if ( buf.bitmap &&
+                    w <= buf.bitmap->GetScaledWidth() &&
+                        h <= buf.bitmap->GetScaledHeight() )
+            {
+                buf.inUse = true;
+                return buf.bitmap;
+            }
+
+            if ( !bufFree )
+                bufFree = &buf;
+        }
 
-        if ( !ms_buffer ||
-                w > ms_buffer->GetScaledWidth() ||
-                    h > ms_buffer->GetScaledHeight() )
+        // no buffer can be reused as is, but there is a free slot: (re)create
+        // its bitmap, rounding the size up so that all the windows of roughly
+        // the same size end up sharing the same buffer and small resizes
+        // don't reallocate it
+        if ( bufFree )
         {
-            delete ms_buffer;
+            delete bufFree->bitmap;
 
-            ms_buffer = DoCreateBuffer(dc, w, h);
+            bufFree->bitmap = DoCreateBuffer(dc, RoundUpSize(w), RoundUpSize(h));
+            bufFree->inUse = true;
+            return bufFree->bitmap;
         }
 
-        ms_usingSharedBuffer = true;
-        return ms_buffer;
+        // all the pooled buffers are in use, fall back to a throw-away one
+        return DoCreateBuffer(dc, w, h);
     }
 
     static void ReleaseBuffer(wxBitmap* buffer)
     {
-        if ( buffer == ms_buffer )
+        for ( size_t n = 0; n < NUM_BUFFERS; n++ )
         {
-            wxASSERT_MSG( ms_usingSharedBuffer, wxT("shared buffer already released") );
-            ms_usingSharedBuffer = false;
-        }
-        else
-        {
-            delete buffer;
+            if ( buffer == ms_buffers[n].bitmap )
+            {
+                wxASSERT_MSG( ms_buffers[n].inUse,
+                              wxT("shared buffer already released") );
+                ms_buffers[n].inUse = false;
+                return;
+            }
         }
+
+        delete buffer;
     }
 
 private:
@@ -89,14 +118,36 @@ private:
         return buffer;
     }
 
-    static wxBitmap *ms_buffer;
-    static bool ms_usingSharedBuffer;
+    // round the size up to group the buffers into size classes: this lets
+    // windows of slightly different sizes reuse the same buffer instead of
+    // reallocating it for each of them
+    static int RoundUpSize(int size)
+    {
+        static const int SIZE_GRANULARITY = 64;
+
+        return (size + SIZE_GRANULARITY - 1)/SIZE_GRANULARITY
+                    * SIZE_GRANULARITY;
+    }
+
+    // having more than one buffer allows reusing them for nested buffered
+    // painting too, e.g. when repainting a child from inside the parent
+    // repaint, instead of creating and destroying a bitmap for each nested
+    // paint cycle
+    enum { NUM_BUFFERS = 4 };
+
+    struct SharedBuffer
+    {
+        wxBitmap* bitmap;
+        bool inUse;
+    };
+
+    static SharedBuffer ms_buffers[NUM_BUFFERS];
 
     wxDECLARE_DYNAMIC_CLASS(wxSharedDCBufferManager);
 };
 
-wxBitmap* wxSharedDCBufferManager::ms_buffer = NULL;
-bool wxSharedDCBufferManager::ms_usingSharedBuffer = false;
+wxSharedDCBufferManager::SharedBuffer
+wxSharedDCBufferManager::ms_buffers[NUM_BUFFERS];
 
 wxIMPLEMENT_DYNAMIC_CLASS(wxSharedDCBufferManager, wxModule);
 
@@ -139,6 +190,31 @@ void wxBufferedDC::UnMask()
     // Ensure the scale matches the device
     SetUserScale(1.0, 1.0);
 
+    if ( m_style & wxBUFFER_UPDATE_AREA )
+    {
+        // The buffer covers only the damaged rectangle, so blit it back to
+        // the place it was taken from, clamping the size in case the window
+        // shrank in the meantime. Note that the source coordinates are
+        // logical ones and the buffered rectangle position is the logical
+        // origin here, see Init().
+        int widthDC,
+            heightDC;
+        m_dc->GetSize(&widthDC, &heightDC);
+
+        const int width = wxMin(m_area.x, widthDC - m_bufferedPos.x),
+                  height = wxMin(m_area.y, heightDC - m_bufferedPos.y);
+
+        m_dc->Blit(m_bufferedPos.x, m_bufferedPos.y, width, height,
+                   this, m_bufferedPos.x, m_bufferedPos.y);
+
+        m_dc = NULL;
+
+        if ( m_style & wxBUFFER_USES_SHARED_BUFFER )
+            wxSharedDCBufferManager::ReleaseBuffer(m_buffer);
+
+        return;
+    }
+
     if ( m_style & wxBUFFER_CLIENT_AREA )
         GetDeviceOrigin(&x, &y);
 
@@ -129,6 +129,22 @@ void wxGCDC::ReleaseHDC(WXHDC hdc)
 }
 #endif // __WXMSW__
 
+void wxGCDC::DrawLinesBatch(size_t count, const size_t* sizes,
+                            const wxPoint2DDouble* points,
+                            const wxPen* pens)
+{
+    static_cast<wxGCDCImpl*>(GetImpl())->DrawLinesBatch(count, sizes,
+                                                        points, pens);
+}
+
+void wxGCDC::DrawLinesBatch(size_t count, const size_t* sizes,
+                            const wxDouble* coords,
+                            const wxPen* pens)
+{
+    static_cast<wxGCDCImpl*>(GetImpl())->DrawLinesBatch(count, sizes,
+                                                        coords, pens);
+}
+
 wxIMPLEMENT_ABSTRACT_CLASS(wxGCDCImpl, wxDCImpl);
 
 wxGCDCImpl::wxGCDCImpl(wxDC *owner, wxGraphicsContext* context) :
@@ -855,6 +871,50 @@ void wxGCDCImpl::DoDrawLines(int n, const wxPoint points[],
     CalcBoundingBox(maxX + xoffset, maxY + yoffset);
 }
 
+void wxGCDCImpl::DrawLinesBatch(size_t count, const size_t* sizes,
+                                const wxPoint2DDouble* points,
+                                const wxPen* pens)
+{
+    wxCHECK_RET( IsOk(), wxT("wxGCDC(cg)::DrawLinesBatch - invalid DC") );
+
+    if ( !m_logicalFunctionSupported )
+        return;
+
+    m_graphicContext->StrokeLinesBatch(count, sizes, points, pens);
+
+    // The per-polyline pens change the pen of the context behind our back,
+    // so re-apply the pen of this dc.
+    if ( pens && count )
+        m_graphicContext->SetPen(m_pen);
+
+    size_t total = 0;
+    for ( size_t i = 0; i < count; ++i )
+        total += sizes[i];
+    for ( size_t j = 0; j < total; ++j )
+        CalcBoundingBox(wxCoord(points[j].m_x), wxCoord(points[j].m_y));
+}
+
+void wxGCDCImpl::DrawLinesBatch(size_t count, const size_t* sizes,
+                                const wxDouble* coords,
+                                const wxPen* pens)
+{
+    wxCHECK_RET( IsOk(), wxT("wxGCDC(cg)::DrawLinesBatch - invalid DC") );
+
+    if ( !m_logicalFunctionSupported )
+        return;
+
+    m_graphicContext->StrokeLinesBatch(count, sizes, coords, pens);
+
+    if ( pens && count )
+        m_graphicContext->SetPen(m_pen);
+
+    size_t total = 0;
+    for ( size_t i = 0; i < count; ++i )
+        total += sizes[i];
+    for ( size_t j = 0; j < total; ++j )
+        CalcBoundingBox(wxCoord(coords[2*j]), wxCoord(coords[2*j + 1]));
+}
+
 #if wxUSE_SPLINES
 void wxGCDCImpl::DoDrawSpline(const wxPointList *points)
 {
@@ -38,6 +38,10 @@
 namespace
 {
 
+// The output is accumulated in a memory buffer and only flushed to the file
+// in chunks of (at least) this size, as doing many small writes is slow.
+const size_t SVG_OUTPUT_CHUNK_SIZE = 64*1024;
+
 // This function returns a string representation of a floating point number in
 // C locale (i.e. always using "." for the decimal separator) and with the
 // fixed precision (which is 2 for some unknown reason but this is what it was
@@ -543,6 +547,8 @@ void wxSVGFileDCImpl::Init(const wxString& filename, int width, int height,
     else
         m_outfile.reset(new wxFileOutputStream(m_filename));
 
+    m_OK = m_outfile && m_outfile->IsOk();
+
     wxString s;
     s += wxS("<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>\n");
     s += wxS("<!DOCTYPE svg PUBLIC \"-//W3C//DTD SVG 1.0//EN\" \"http://www.w3.org/TR/2001/REC-SVG-20010904/DTD/svg10.dtd\">\n\n");
@@ -564,6 +570,8 @@ wxSVGFileDCImpl::~wxSVGFileDCImpl()
 
     s += wxS("</g>\n</svg>\n");
     write(s);
+
+    FlushOutput();
 }
 
 void wxSVGFileDCImpl::DoGetSizeMM(int* width, int* height) const
@@ -610,23 +618,28 @@ void wxSVGFileDCImpl::DoDrawLines(int n, const wxPoint points[], wxCoord xoffset
     if (n > 1)
     {
         NewGraphicsIfNeeded();
-        wxString s;
 
-        s = wxString::Format(wxS("  <path d=\"M%d %d"),
-            (points[0].x + xoffset), (points[0].y + yoffset));
+        // Stream the path data directly into the output buffer as building a
+        // single wxString from it gets very slow for long polylines.
+        writeLiteral("  <path d=\"M");
+        writeNumber(points[0].x + xoffset);
+        writeLiteral(" ");
+        writeNumber(points[0].y + yoffset);
 
         CalcBoundingBox(points[0].x + xoffset, points[0].y + yoffset);
 
         for (int i = 1; i < n; ++i)
         {
-            s += wxString::Format(wxS(" L%d %d"), (points[i].x + xoffset), (points[i].y + yoffset));
+            writeLiteral(" L");
+            writeNumber(points[i].x + xoffset);
+            writeLiteral(" ");
+            writeNumber(points[i].y + yoffset);
+
             CalcBoundingBox(points[i].x + xoffset, points[i].y + yoffset);
         }
 
-        s += wxString::Format(wxS("\" style=\"fill:none\" %s %s/>\n"),
-            GetRenderMode(m_renderingMode), GetPenPattern(m_pen));
-
-        write(s);
+        write(wxString::Format(wxS("\" style=\"fill:none\" %s %s/>\n"),
+            GetRenderMode(m_renderingMode), GetPenPattern(m_pen)));
     }
 }
 
@@ -646,10 +659,14 @@ void wxSVGFileDCImpl::DoDrawSpline(const wxPointList* points)
     wxPoint2DDouble p2(*pt);
     wxPoint2DDouble p3 = (p1 + p2) / 2.0;
 
-    wxString s = "  <path d=\"";
-
-    s += wxString::Format("M %s %s L %s %s",
-                          NumStr(p1.m_x), NumStr(p1.m_y), NumStr(p3.m_x), NumStr(p3.m_y));
+    writeLiteral("  <path d=\"M ");
+    writeNumber(p1.m_x);
+    writeLiteral(" ");
+    writeNumber(p1.m_y);
+    writeLiteral(" L ");
+    writeNumber(p3.m_x);
+    writeLiteral(" ");
+    writeNumber(p3.m_y);
     CalcBoundingBox(wxRound(p1.m_x), wxRound(p1.m_y));
     CalcBoundingBox(wxRound(p3.m_x), wxRound(p3.m_y));
 
@@ -666,18 +683,30 @@ void wxSVGFileDCImpl::DoDrawSpline(const wxPointList* points)
         wxPoint2DDouble c1 = (p0 + (p1 * 2.0)) / 3.0;
         wxPoint2DDouble c2 = ((p1 * 2.0) + p3) / 3.0;
 
-        s += wxString::Format(" C %s %s, %s %s, %s %s",
-             NumStr(c1.m_x), NumStr(c1.m_y), NumStr(c2.m_x), NumStr(c2.m_y), NumStr(p3.m_x), NumStr(p3.m_y));
+        writeLiteral(" C ");
+        writeNumber(c1.m_x);
+        writeLiteral(" ");
+        writeNumber(c1.m_y);
+        writeLiteral(", ");
+        writeNumber(c2.m_x);
+        writeLiteral(" ");
+        writeNumber(c2.m_y);
+        writeLiteral(", ");
+        writeNumber(p3.m_x);
+        writeLiteral(" ");
+        writeNumber(p3.m_y);
 
         CalcBoundingBox(wxRound(p0.m_x), wxRound(p0.m_y));
         CalcBoundingBox(wxRound(p3.m_x), wxRound(p3.m_y));
     }
-    s += wxString::Format(" L %s %s", NumStr(p2.m_x), NumStr(p2.m_y));
+    writeLiteral(" L ");
+    writeNumber(p2.m_x);
+    writeLiteral(" ");
+    writeNumber(p2.m_y);
     CalcBoundingBox(wxRound(p2.m_x), wxRound(p2.m_y));
 
-    s += wxString::Format("\" style=\"fill:none\" %s %s/>\n",
-                          GetRenderMode(m_renderingMode), GetPenPattern(m_pen));
-    write(s);
+    write(wxString::Format("\" style=\"fill:none\" %s %s/>\n",
+                           GetRenderMode(m_renderingMode), GetPenPattern(m_pen)));
 }
 #endif // wxUSE_SPLINES
 
@@ -842,21 +871,21 @@ void wxSVGFileDCImpl::DoDrawPolygon(int n, const wxPoint points[],
 {
     NewGraphicsIfNeeded();
 
-    wxString s;
-
-    s = wxS("  <polygon points=\"");
+    writeLiteral("  <polygon points=\"");
 
     for (int i = 0; i < n; i++)
     {
-        s += wxString::Format(wxS("%d %d "), points[i].x + xoffset, points[i].y + yoffset);
+        writeNumber(points[i].x + xoffset);
+        writeLiteral(" ");
+        writeNumber(points[i].y + yoffset);
+        writeLiteral(" ");
+
         CalcBoundingBox(points[i].x + xoffset, points[i].y + yoffset);
     }
 
-    s += wxString::Format(wxS("\" %s %s %s style=\"fill-rule:%s;\"/>\n"),
+    write(wxString::Format(wxS("\" %s %s %s style=\"fill-rule:%s;\"/>\n"),
         GetRenderMode(m_renderingMode), GetPenPattern(m_pen), GetBrushPattern(m_brush),
-        fillStyle == wxODDEVEN_RULE ? wxS("evenodd") : wxS("nonzero"));
-
-    write(s);
+        fillStyle == wxODDEVEN_RULE ? wxS("evenodd") : wxS("nonzero")));
 }
 
 void wxSVGFileDCImpl::DoDrawPolyPolygon(int n, const int count[], const wxPoint points[],
@@ -1402,6 +1431,10 @@ void wxSVGFileDCImpl::DoDrawBitmap(const wxBitmap& bmp, wxCoord x, wxCoord y,
     if ( !m_bmp_handler )
         m_bmp_handler.reset(new wxSVGBitmapFileHandler(m_filename));
 
+    // The bitmap handler writes to the stream directly, bypassing our output
+    // buffer, so flush any pending output first to keep the elements ordered.
+    FlushOutput();
+
     m_OK = m_outfile && m_outfile->IsOk();
     if (!m_OK)
         return;
@@ -1412,13 +1445,114 @@ void wxSVGFileDCImpl::DoDrawBitmap(const wxBitmap& bmp, wxCoord x, wxCoord y,
 
 void wxSVGFileDCImpl::write(const wxString& s)
 {
-    m_OK = m_outfile && m_outfile->IsOk();
-    if (!m_OK)
+    const wxScopedCharBuffer buf = s.utf8_str();
+    writeData(buf.data(), buf.length());
+}
+
+void wxSVGFileDCImpl::writeData(const void* data, size_t len)
+{
+    if ( !m_OK )
         return;
 
-    const wxCharBuffer buf = s.utf8_str();
-    m_outfile->Write(buf, strlen((const char*)buf));
-    m_OK = m_outfile->IsOk();
+    m_outBuffer.AppendData(data, len);
+
+    if ( m_outBuffer.GetDataLen() >= SVG_OUTPUT_CHUNK_SIZE )
+        FlushOutput();
+}
+
+void wxSVGFileDCImpl::writeLiteral(const char* s)
+{
+    writeData(s, strlen(s));
+}
+
+void wxSVGFileDCImpl::writeNumber(wxCoord n)
+{
+    // Format the number manually instead of going through the printf-like
+    // functions: parsing the format string is a measurable cost when writing
+    // out paths with many thousands of elements.
+    char buf[16];
+    char* p = buf + WXSIZEOF(buf);
+
+    unsigned u = static_cast<unsigned>(n);
+    if ( n < 0 )
+        u = 0u - u;
+
+    do
+    {
+        *--p = static_cast<char>('0' + u % 10);
+        u /= 10;
+    }
+    while ( u != 0 );
+
+    if ( n < 0 )
+        *--p = '-';
+
+    writeData(p, buf + WXSIZEOF(buf) - p);
+}
+
+void wxSVGFileDCImpl::writeNumber(double f)
+{
+    // Produce the same output as NumStr(), i.e. "%.2f" in C locale, but
+    // without printf-like parsing nor wxString allocation. The only possible
+    // difference is the rounding direction of the last digit for the values
+    // falling exactly half-way between two representable ones, which doesn't
+    // matter for the SVG output.
+
+    // Handle this case specially to avoid generating "-0.00" in the output.
+    if ( f == 0 )
+    {
+        writeLiteral("0.00");
+        return;
+    }
+
+    const bool negative = f < 0;
+    const double d = negative ? -f : f;
+
+    // Fall back to the generic conversion for huge (or NaN) values which
+    // wouldn't fit into the fixed-size buffer below and couldn't be
+    // represented exactly anyhow.
+    if ( !(d < 9e15) )
+    {
+        write(NumStr(f));
+        return;
+    }
+
+    wxUint64 scaled = static_cast<wxUint64>(d*100 + 0.5);
+
+    char buf[24];
+    char* p = buf + WXSIZEOF(buf);
+
+    *--p = static_cast<char>('0' + scaled % 10);
+    scaled /= 10;
+    *--p = static_cast<char>('0' + scaled % 10);
+    scaled /= 10;
+    *--p = '.';
+
+    do
+    {
+        *--p = static_cast<char>('0' + scaled % 10);
+        scaled /= 10;
+    }
+    while ( scaled != 0 );
+
+    if ( negative )
+        *--p = '-';
+
+    writeData(p, buf + WXSIZEOF(buf) - p);
+}
+
+void wxSVGFileDCImpl::FlushOutput()
+{
+    if ( m_outBuffer.IsEmpty() )
+        return;
+
+    if ( m_OK )
+    {
+        m_outfile->Write(m_outBuffer.GetData(), m_outBuffer.GetDataLen());
+        m_OK = m_outfile->IsOk();
+    }
+
+    m_outBuffer.SetDataLen(0);
 }
 
 #endif // wxUSE_SVG
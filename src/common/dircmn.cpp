@@ -30,6 +30,8 @@
 
 #include "wx/dir.h"
 #include "wx/filename.h"
+#include "wx/opctx.h"
+#include "wx/thread.h"
 
 // ============================================================================
 // implementation
@@ -68,6 +70,52 @@ bool wxDir::HasSubDirs(const wxString& spec) const
 
 #endif // !Unix
 
+// ----------------------------------------------------------------------------
+// wxDir::GetEntries()
+// ----------------------------------------------------------------------------
+
+// the Unix version reads the metadata directly while scanning the directory,
+// everywhere else fall back on stat()ing each entry returned by GetNext()
+#if (defined(__CYGWIN__) && defined(__WINDOWS__)) || !defined(__UNIX_LIKE__) || defined(__WINE__)
+
+size_t wxDir::GetEntries(wxDirEntries *entries,
+                         const wxString& filespec,
+                         int flags) const
+{
+    wxCHECK_MSG( IsOpened(), (size_t)-1, wxT("must wxDir::Open() first") );
+
+    wxCHECK_MSG( entries, (size_t)-1,
+                 wxT("bad pointer in wxDir::GetEntries()") );
+
+    const wxString prefix = GetNameWithSep();
+
+    size_t count = 0;
+    wxString filename;
+    for ( bool cont = GetFirst(&filename, filespec, flags);
+          cont;
+          cont = GetNext(&filename) )
+    {
+        wxDirEntry entry;
+        entry.name = filename;
+
+        wxStructStat st;
+        if ( wxStat(prefix + filename, &st) == 0 )
+        {
+            entry.isDir = (st.st_mode & S_IFMT) == S_IFDIR;
+            if ( !entry.isDir )
+                entry.size = st.st_size;
+            entry.mtime = st.st_mtime;
+        }
+
+        entries->push_back(entry);
+        count++;
+    }
+
+    return count;
+}
+
+#endif // !Unix
+
 // ----------------------------------------------------------------------------
 // wxDir::GetNameWithSep()
 // ----------------------------------------------------------------------------
@@ -96,7 +144,8 @@ wxString wxDir::GetNameWithSep() const
 
 size_t wxDir::Traverse(wxDirTraverser& sink,
                        const wxString& filespec,
-                       int flags) const
+                       int flags,
+                       wxOperationContext* context) const
 {
     wxCHECK_MSG( IsOpened(), (size_t)-1,
                  wxT("dir must be opened before traversing it") );
@@ -117,6 +166,10 @@ size_t wxDir::Traverse(wxDirTraverser& sink,
               cont;
               cont = cont && GetNext(&dirname) )
         {
+            // each visited entry counts as one unit of progress
+            if ( context && !context->AddProgress() )
+                break;
+
             const wxString fulldirname = prefix + dirname;
 
             switch ( sink.OnDir(fulldirname) )
@@ -173,7 +226,8 @@ size_t wxDir::Traverse(wxDirTraverser& sink,
 
                         if ( ok )
                         {
-                            nFiles += subdir.Traverse(sink, filespec, flags);
+                            nFiles += subdir.Traverse(sink, filespec, flags,
+                                                      context);
                         }
                     }
                     break;
@@ -194,6 +248,9 @@ size_t wxDir::Traverse(wxDirTraverser& sink,
         bool cont = GetFirst(&filename, filespec, flags);
         while ( cont )
         {
+            if ( context && !context->AddProgress() )
+                break;
+
             wxDirTraverseResult res = sink.OnFile(prefix + filename);
             if ( res == wxDIR_STOP )
                 break;
@@ -257,6 +314,242 @@ size_t wxDir::GetAllFiles(const wxString& dirname,
     return nFiles;
 }
 
+// ----------------------------------------------------------------------------
+// wxDir::GetAllEntries()
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Shared queue of the directories remaining to be scanned: each directory is
+// enumerated in a single GetEntries() call and its subdirectories are pushed
+// back onto the queue, so independent subtrees can be scanned concurrently
+// by several threads running Work().
+class wxDirScanQueue
+{
+public:
+    wxDirScanQueue(wxDirEntries *entries, const wxString& filespec, int flags)
+        : m_entries(entries),
+          m_filespec(filespec),
+          m_flags(flags)
+    {
+        m_pending =
+        m_count = 0;
+        m_waiters = 1;
+        m_done = false;
+    }
+
+    void AddDir(const wxString& dirname)
+    {
+        {
+            wxCRIT_SECT_LOCKER(lock, m_cs);
+            m_dirs.push_back(dirname);
+            m_pending++;
+        }
+
+#if wxUSE_THREADS
+        m_semWork.Post();
+#endif
+    }
+
+#if wxUSE_THREADS
+    // called once per thread taking part in the scan, including the main one
+    void AddWaiter()
+    {
+        wxCRIT_SECT_LOCKER(lock, m_cs);
+        m_waiters++;
+
+        // if everything was already scanned before this thread even started,
+        // it still needs to be woken up so that it can return
+        if ( m_done )
+            m_semWork.Post();
+    }
+#endif // wxUSE_THREADS
+
+    // scan queued directories until there is nothing left to do
+    void Work()
+    {
+        for ( ;; )
+        {
+#if wxUSE_THREADS
+            m_semWork.Wait();
+#endif
+
+            wxString dirname;
+            {
+                wxCRIT_SECT_LOCKER(lock, m_cs);
+                if ( m_done )
+                    return;
+
+                dirname = m_dirs.back();
+                m_dirs.pop_back();
+            }
+
+            ScanDir(dirname);
+
+            wxCRIT_SECT_LOCKER(lock, m_cs);
+            if ( !--m_pending )
+            {
+                m_done = true;
+
+#if wxUSE_THREADS
+                // wake up all the other threads so that they can return too
+                for ( size_t n = 0; n < m_waiters; n++ )
+                    m_semWork.Post();
+#endif
+            }
+        }
+    }
+
+    size_t GetCount() const { return m_count; }
+
+private:
+    void ScanDir(const wxString& dirname)
+    {
+        wxDir dir;
+        {
+            // as in Traverse(), failing to open a directory (e.g. due to
+            // insufficient privileges) is not an error, just skip it
+            wxLogNull noLog;
+            if ( !dir.Open(dirname) )
+                return;
+        }
+
+        // we always need the subdirectories for the recursion, the caller
+        // flags are only applied when deciding what to keep below
+        wxDirEntries local;
+        dir.GetEntries(&local, wxEmptyString,
+                       (m_flags & ~wxDIR_DOTDOT) | wxDIR_FILES | wxDIR_DIRS);
+
+        const wxString prefix = dir.GetNameWithSep();
+
+        wxDirEntries matched;
+        for ( size_t n = 0; n < local.size(); n++ )
+        {
+            wxDirEntry& entry = local[n];
+
+            if ( entry.isDir )
+            {
+                AddDir(prefix + entry.name);
+
+                if ( !(m_flags & wxDIR_DIRS) )
+                    continue;
+            }
+            else // a file
+            {
+                if ( !(m_flags & wxDIR_FILES) )
+                    continue;
+
+                if ( !m_filespec.empty() &&
+                        !wxMatchWild(m_filespec, entry.name,
+                                     !(m_flags & wxDIR_HIDDEN)) )
+                    continue;
+            }
+
+            entry.name = prefix + entry.name;
+            matched.push_back(entry);
+        }
+
+        wxCRIT_SECT_LOCKER(lock, m_cs);
+        for ( size_t n = 0; n < matched.size(); n++ )
+            m_entries->push_back(matched[n]);
+        m_count += matched.size();
+    }
+
+    wxDirEntries * const m_entries;
+    const wxString m_filespec;
+    const int m_flags;
+
+    wxCRIT_SECT_DECLARE_MEMBER(m_cs);
+#if wxUSE_THREADS
+    wxSemaphore m_semWork;
+#endif
+    wxVector<wxString> m_dirs;
+    size_t m_pending,
+           m_count,
+           m_waiters;
+    bool m_done;
+
+    wxDECLARE_NO_COPY_CLASS(wxDirScanQueue);
+};
+
+#if wxUSE_THREADS
+
+class wxDirScanThread : public wxThread
+{
+public:
+    wxDirScanThread(wxDirScanQueue& queue)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_queue(queue)
+    {
+        m_queue.AddWaiter();
+    }
+
+protected:
+    virtual ExitCode Entry() wxOVERRIDE
+    {
+        m_queue.Work();
+        return 0;
+    }
+
+private:
+    wxDirScanQueue& m_queue;
+
+    wxDECLARE_NO_COPY_CLASS(wxDirScanThread);
+};
+
+#endif // wxUSE_THREADS
+
+} // anonymous namespace
+
+/* static */
+size_t wxDir::GetAllEntries(const wxString& dirname,
+                            wxDirEntries *entries,
+                            const wxString& filespec,
+                            int flags,
+                            int threads)
+{
+    wxCHECK_MSG( entries, (size_t)-1,
+                 wxT("NULL pointer in wxDir::GetAllEntries") );
+
+    wxDirScanQueue queue(entries, filespec, flags);
+    queue.AddDir(dirname);
+
+#if wxUSE_THREADS
+    if ( threads == -1 )
+        threads = wxThread::GetCPUCount();
+
+    wxVector<wxDirScanThread *> workers;
+    for ( int n = 1; n < threads; n++ )
+    {
+        wxDirScanThread *thread = new wxDirScanThread(queue);
+        if ( thread->Create() != wxTHREAD_NO_ERROR ||
+                thread->Run() != wxTHREAD_NO_ERROR )
+        {
+            delete thread;
+            break;
+        }
+
+        workers.push_back(thread);
+    }
+#else // !wxUSE_THREADS
+    wxUnusedVar(threads);
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+
+    // the calling thread takes part in the scan too
+    queue.Work();
+
+#if wxUSE_THREADS
+    for ( size_t n = 0; n < workers.size(); n++ )
+    {
+        workers[n]->Wait();
+        delete workers[n];
+    }
+#endif // wxUSE_THREADS
+
+    return queue.GetCount();
+}
+
 // ----------------------------------------------------------------------------
 // wxDir::FindFirst()
 // ----------------------------------------------------------------------------
@@ -261,9 +261,13 @@ static inline wxMBConv& GetConv(const wxDataFormat& format)
 
 size_t wxTextDataObject::GetDataSize(const wxDataFormat& format) const
 {
-    wxCharBuffer buffer = GetConv(format).cWX2MB( GetText().c_str() );
+    // Remember the conversion result so that GetDataHere(), which is always
+    // called just afterwards when the data is actually pasted, doesn't have
+    // to redo it.
+    m_convCache = GetConv(format).cWX2MB( GetText().c_str() );
+    m_convCacheFormat = format;
 
-    return buffer ? strlen( buffer ) : 0;
+    return m_convCache ? strlen( m_convCache ) : 0;
 }
 
 bool wxTextDataObject::GetDataHere(const wxDataFormat& format, void *buf) const
@@ -271,12 +275,20 @@ bool wxTextDataObject::GetDataHere(const wxDataFormat& format, void *buf) const
     if ( !buf )
         return false;
 
-    wxCharBuffer buffer = GetConv(format).cWX2MB( GetText().c_str() );
+    wxCharBuffer buffer;
+    if ( m_convCache && format == m_convCacheFormat )
+        buffer = m_convCache;
+    else
+        buffer = GetConv(format).cWX2MB( GetText().c_str() );
+
+    // Don't keep the cache alive beyond this call, the text could change
+    // before the next one.
+    m_convCache = wxCharBuffer();
+
     if ( !buffer )
         return false;
 
-    memcpy( (char*) buf, buffer, GetDataSize(format) );
-    // strcpy( (char*) buf, buffer );
+    memcpy( (char*) buf, buffer, strlen( buffer ) );
 
     return true;
 }
@@ -301,12 +313,16 @@ size_t wxTextDataObject::GetDataSize(const wxDataFormat& format) const
     const wxString& text = GetText();
     if ( format == wxDF_UNICODETEXT || wxLocaleIsUtf8 )
     {
+        // Nothing to cache, the UTF-8 representation is available directly.
         return text.utf8_length();
     }
     else // wxDF_TEXT
     {
-        const wxCharBuffer buf(wxConvLocal.cWC2MB(text.wc_str()));
-        return buf ? strlen(buf) : 0;
+        // Cache the conversion for reuse by the following GetDataHere() call.
+        m_convCache = wxConvLocal.cWC2MB(text.wc_str());
+        m_convCacheFormat = format;
+
+        return m_convCache ? strlen(m_convCache) : 0;
     }
 }
 
@@ -322,7 +338,16 @@ bool wxTextDataObject::GetDataHere(const wxDataFormat& format, void *buf) const
     }
     else // wxDF_TEXT
     {
-        const wxCharBuffer bufLocal(wxConvLocal.cWC2MB(text.wc_str()));
+        wxCharBuffer bufLocal;
+        if ( m_convCache && format == m_convCacheFormat )
+            bufLocal = m_convCache;
+        else
+            bufLocal = wxConvLocal.cWC2MB(text.wc_str());
+
+        // Don't keep the cache alive beyond this call, the text could change
+        // before the next one.
+        m_convCache = wxCharBuffer();
+
         if ( !bufLocal )
             return false;
 
@@ -376,7 +401,13 @@ inline wxMBConv& GetConv(const wxDataFormat& format)
 
 size_t wxTextDataObject::GetDataSize(const wxDataFormat& format) const
 {
-    return GetConv(format).WC2MB(NULL, GetText().wc_str(), 0);
+    // Do the full conversion instead of just computing the length so that
+    // GetDataHere(), which is always called just afterwards when the data is
+    // actually pasted, can reuse the result.
+    m_convCache = GetConv(format).cWX2MB(GetText().c_str());
+    m_convCacheFormat = format;
+
+    return m_convCache ? m_convCache.length() : 0;
 }
 
 bool wxTextDataObject::GetDataHere(const wxDataFormat& format, void *buf) const
@@ -384,7 +415,15 @@ bool wxTextDataObject::GetDataHere(const wxDataFormat& format, void *buf) const
     if ( buf == NULL )
         return false;
 
-    wxCharBuffer buffer(GetConv(format).cWX2MB(GetText().c_str()));
+    wxCharBuffer buffer;
+    if ( m_convCache && format == m_convCacheFormat )
+        buffer = m_convCache;
+    else
+        buffer = GetConv(format).cWX2MB(GetText().c_str());
+
+    // Don't keep the cache alive beyond this call, the text could change
+    // before the next one.
+    m_convCache = wxCharBuffer();
 
     memcpy(buf, buffer.data(), buffer.length());
 
@@ -412,12 +451,23 @@ bool wxTextDataObject::SetData(const wxDataFormat& format,
 
 size_t wxTextDataObject::GetDataSize() const
 {
-    return (wxTextBuffer::Translate(GetText()).length() + 1)*sizeof(wxChar);
+    // Remember the translated text so that GetDataHere(), which is always
+    // called just afterwards when the data is actually pasted, doesn't have
+    // to translate it again.
+    m_translateCache = wxTextBuffer::Translate(GetText());
+
+    return (m_translateCache.length() + 1)*sizeof(wxChar);
 }
 
 bool wxTextDataObject::GetDataHere(void *buf) const
 {
-    const wxString textNative = wxTextBuffer::Translate(GetText());
+    const wxString textNative = m_translateCache.empty()
+                                    ? wxTextBuffer::Translate(GetText())
+                                    : m_translateCache;
+
+    // Don't keep the cache alive beyond this call, the text could change
+    // before the next one.
+    m_translateCache.clear();
 
     // NOTE: use wxTmemcpy() instead of wxStrncpy() to allow
     //       retrieval of strings with embedded NULLs
@@ -48,6 +48,7 @@
 #include "wx/confbase.h"
 #include "wx/filename.h"
 #include "wx/file.h"
+#include "wx/mstream.h"
 #include "wx/ffile.h"
 #include "wx/cmdproc.h"
 #include "wx/tokenzr.h"
@@ -72,6 +73,7 @@
 // wxWidgets macros
 // ----------------------------------------------------------------------------
 
+wxIMPLEMENT_DYNAMIC_CLASS(wxDocumentUpdateHint, wxObject);
 wxIMPLEMENT_ABSTRACT_CLASS(wxDocument, wxEvtHandler);
 wxIMPLEMENT_ABSTRACT_CLASS(wxView, wxEvtHandler);
 wxIMPLEMENT_ABSTRACT_CLASS(wxDocTemplate, wxObject);
@@ -121,6 +123,9 @@ wxDocument::wxDocument(wxDocument *parent)
 
     m_commandProcessor = NULL;
     m_savedYet = false;
+
+    m_pendingUpdateSender = NULL;
+    m_hasPendingUpdate = false;
 }
 
 bool wxDocument::DeleteContents()
@@ -566,6 +571,10 @@ bool wxDocument::RemoveView(wxView *view)
     if ( !m_documentViews.DeleteObject(view) )
         return false;
 
+    // don't leave a dangling sender in the pending update, if any
+    if ( m_pendingUpdateSender == view )
+        m_pendingUpdateSender = NULL;
+
     OnChangedViewList();
     return true;
 }
@@ -586,16 +595,63 @@ void wxDocument::OnChangedViewList()
 
 void wxDocument::UpdateAllViews(wxView *sender, wxObject *hint)
 {
+    const wxDocumentUpdateHint* const
+        updateHint = wxDynamicCast(hint, wxDocumentUpdateHint);
+
     wxList::compatibility_iterator node = m_documentViews.GetFirst();
     while (node)
     {
         wxView *view = (wxView *)node->GetData();
         if (view != sender)
-            view->OnUpdate(sender, hint);
+        {
+            // don't disturb the views not subscribed to any of the
+            // categories of this change
+            if ( !updateHint ||
+                    (view->GetUpdateCategories() & updateHint->GetCategories()) )
+                view->OnUpdate(sender, hint);
+        }
         node = node->GetNext();
     }
 }
 
+void wxDocument::UpdateAllViewsLater(wxView *sender,
+                                     const wxDocumentUpdateHint& hint)
+{
+    if ( m_hasPendingUpdate )
+    {
+        // coalesce with the already scheduled update
+        m_pendingUpdateHint.Merge(hint);
+
+        // updates coming from different senders can only be merged by not
+        // excluding any view from the combined one
+        if ( m_pendingUpdateSender != sender )
+            m_pendingUpdateSender = NULL;
+    }
+    else // first update scheduled in this event loop iteration
+    {
+        m_pendingUpdateHint = hint;
+        m_pendingUpdateSender = sender;
+        m_hasPendingUpdate = true;
+
+        CallAfter(&wxDocument::FlushUpdateAllViews);
+    }
+}
+
+void wxDocument::FlushUpdateAllViews()
+{
+    if ( !m_hasPendingUpdate )
+        return;
+
+    // reset the pending update first so that any updates scheduled from the
+    // OnUpdate() handlers themselves start a new batch
+    m_hasPendingUpdate = false;
+    wxDocumentUpdateHint hint = m_pendingUpdateHint;
+    wxView* const sender = m_pendingUpdateSender;
+    m_pendingUpdateSender = NULL;
+
+    UpdateAllViews(sender, &hint);
+}
+
 void wxDocument::NotifyClosing()
 {
     wxList::compatibility_iterator node = m_documentViews.GetFirst();
@@ -656,22 +712,48 @@ bool wxDocument::DoOpenDocument(const wxString& file)
 #if wxUSE_STD_IOSTREAM
     wxSTD ifstream store(file.mb_str(), wxSTD ios::binary);
     if ( !store )
-#else
-    wxFileInputStream store(file);
-    if (store.GetLastError() != wxSTREAM_NO_ERROR || !store.IsOk())
-#endif
     {
         wxLogError(_("File \"%s\" could not be opened for reading."), file);
         return false;
     }
 
-#if wxUSE_STD_IOSTREAM
     LoadObject(store);
     if ( !store )
-#else
+    {
+        wxLogError(_("Failed to read document from the file \"%s\"."), file);
+        return false;
+    }
+
+    return true;
+#else // !wxUSE_STD_IOSTREAM
+#ifdef wxHAS_MAPPED_INPUT_STREAM
+    // Prefer reading via a memory mapping: this avoids copying the file
+    // contents and lets the OS page them in on demand, which matters a lot
+    // for big documents. Fall back to a plain file stream if the file can't
+    // be mapped (e.g. it is too big for the address space).
+    wxMappedInputStream mmstore(file);
+    if ( mmstore.IsOk() )
+        return DoLoadDocument(mmstore, file);
+#endif // wxHAS_MAPPED_INPUT_STREAM
+
+    wxFileInputStream store(file);
+    if (store.GetLastError() != wxSTREAM_NO_ERROR || !store.IsOk())
+    {
+        wxLogError(_("File \"%s\" could not be opened for reading."), file);
+        return false;
+    }
+
+    return DoLoadDocument(store, file);
+#endif // wxUSE_STD_IOSTREAM/!wxUSE_STD_IOSTREAM
+}
+
+#if !wxUSE_STD_IOSTREAM
+
+// common part of DoOpenDocument() for both stream kinds
+bool wxDocument::DoLoadDocument(wxInputStream& store, const wxString& file)
+{
     int res = LoadObject(store).GetLastError();
     if ( res != wxSTREAM_NO_ERROR && res != wxSTREAM_EOF )
-#endif
     {
         wxLogError(_("Failed to read document from the file \"%s\"."), file);
         return false;
@@ -680,6 +762,8 @@ bool wxDocument::DoOpenDocument(const wxString& file)
     return true;
 }
 
+#endif // !wxUSE_STD_IOSTREAM
+
 
 // ----------------------------------------------------------------------------
 // Document view
@@ -692,6 +776,8 @@ wxView::wxView()
     m_viewFrame = NULL;
 
     m_docChildFrame = NULL;
+
+    m_updateCategories = wxDOC_UPDATE_ALL_CATEGORIES;
 }
 
 wxView::~wxView()
@@ -21,8 +21,19 @@
 
 
 #include "wx/event.h"
+#include "wx/alloctrack.h"
 #include "wx/eventfilter.h"
 #include "wx/evtloop.h"
+#include "wx/hashmap.h"
+#include "wx/tls.h"
+
+// Use a lock-free queue for the events posted from the other threads if we
+// can, i.e. if the compiler provides the atomic primitives needed for it.
+#if __cplusplus >= 201103L || wxCHECK_VISUALC_VERSION(14)
+    #include <atomic>
+
+    #define wxHAS_LOCKFREE_EVENT_QUEUE
+#endif
 
 #ifndef WX_PRECOMP
     #include "wx/list.h"
@@ -36,6 +47,7 @@
         #include "wx/window.h"
         #include "wx/control.h"
         #include "wx/dc.h"
+        #include "wx/settings.h"
         #include "wx/spinbutt.h"
         #include "wx/textentry.h"
         #include "wx/validate.h"
@@ -340,6 +352,7 @@ wxDEFINE_EVENT( wxEVT_DETAILED_HELP, wxHelpEvent );
 #if wxUSE_BASE
 
 wxIdleMode wxIdleEvent::sm_idleMode = wxIDLE_PROCESS_ALL;
+long wxIdleEvent::sm_dispatchBudget = 0;
 
 // ============================================================================
 // implementation
@@ -376,6 +389,96 @@ wxEventFunctor::~wxEventFunctor()
  *
  */
 
+#if !wxUSE_MEMORY_TRACING
+
+// ----------------------------------------------------------------------------
+// wxEvent memory pool
+// ----------------------------------------------------------------------------
+
+// Per-thread cache of the memory blocks of recently deleted events, bucketed
+// by (rounded up) size so that all the concrete event classes share it. The
+// cache is bounded, anything not fitting into it simply goes to the heap, and
+// events freed on a different thread than the one which allocated them just
+// migrate between the per-thread caches, so no locking is ever needed.
+//
+// As with the small string cache in stringimpl.cpp, the few KiB cached by
+// each thread are not returned to the heap on thread exit.
+
+namespace
+{
+
+// all sizes are in bytes
+const size_t wxEVENT_POOL_GRANULARITY = 64;
+const size_t wxEVENT_POOL_MAX_SIZE = 512;
+const size_t wxEVENT_POOL_BUCKETS =
+    wxEVENT_POOL_MAX_SIZE / wxEVENT_POOL_GRANULARITY;
+
+// maximal number of blocks cached per bucket and thread
+const size_t wxEVENT_POOL_BUCKET_CAPACITY = 32;
+
+struct wxEventMemoryPool
+{
+    void *blocks[wxEVENT_POOL_BUCKETS][wxEVENT_POOL_BUCKET_CAPACITY];
+    size_t count[wxEVENT_POOL_BUCKETS];
+};
+
+} // anonymous namespace
+
+static wxTLS_TYPE_REF(wxEventMemoryPool) GetEventMemoryPoolVar()
+{
+    static wxTLS_TYPE(wxEventMemoryPool) s_pool;
+
+    return s_pool;
+}
+
+#define wxEVENT_MEMORY_POOL wxTLS_VALUE(GetEventMemoryPoolVar())
+
+void* wxEvent::operator new(size_t size)
+{
+    // note that the pooled blocks are reported as allocated as long as the
+    // event owns them: the pool only caches blocks between two events
+    wxAllocationTracker::OnAlloc(wxALLOC_TAG_EVENTS, size);
+
+    if ( size <= wxEVENT_POOL_MAX_SIZE )
+    {
+        // round the size up so that the block can be reused by any event
+        // class falling into the same bucket
+        const size_t bucket = (size - 1) / wxEVENT_POOL_GRANULARITY;
+
+        wxEventMemoryPool& pool = wxEVENT_MEMORY_POOL;
+        if ( pool.count[bucket] )
+            return pool.blocks[bucket][--pool.count[bucket]];
+
+        size = (bucket + 1)*wxEVENT_POOL_GRANULARITY;
+    }
+
+    return ::operator new(size);
+}
+
+void wxEvent::operator delete(void* ptr, size_t size)
+{
+    if ( !ptr )
+        return;
+
+    wxAllocationTracker::OnFree(wxALLOC_TAG_EVENTS, size);
+
+    if ( size <= wxEVENT_POOL_MAX_SIZE )
+    {
+        const size_t bucket = (size - 1) / wxEVENT_POOL_GRANULARITY;
+
+        wxEventMemoryPool& pool = wxEVENT_MEMORY_POOL;
+        if ( pool.count[bucket] < wxEVENT_POOL_BUCKET_CAPACITY )
+        {
+            pool.blocks[bucket][pool.count[bucket]++] = ptr;
+            return;
+        }
+    }
+
+    ::operator delete(ptr);
+}
+
+#endif // !wxUSE_MEMORY_TRACING
+
 wxEvent::wxEvent(int theId, wxEventType commandType)
     : m_eventType(commandType)
 {
@@ -384,6 +487,7 @@ wxEvent::wxEvent(int theId, wxEventType commandType)
     m_id = theId;
     m_skipped = false;
     m_callbackUserData = NULL;
+    m_nextPending = NULL;
     m_handlerToProcessOnlyIn = NULL;
     m_isCommandEvent = false;
     m_propagationLevel = wxEVENT_PROPAGATE_NONE;
@@ -399,6 +503,7 @@ wxEvent::wxEvent(const wxEvent& src)
     , m_timeStamp(src.m_timeStamp)
     , m_id(src.m_id)
     , m_callbackUserData(src.m_callbackUserData)
+    , m_nextPending(NULL)
     , m_handlerToProcessOnlyIn(NULL)
     , m_propagationLevel(src.m_propagationLevel)
     , m_propagatedFrom(NULL)
@@ -937,10 +1042,43 @@ wxHelpEvent::Origin wxHelpEvent::GuessOrigin(Origin origin)
     return origin;
 }
 
+// ----------------------------------------------------------------------------
+// wxSysColourChangedEvent
+// ----------------------------------------------------------------------------
+
+wxSysColourChangedEvent::wxSysColourChangedEvent()
+    : wxEvent(0, wxEVT_SYS_COLOUR_CHANGED)
+{
+    // creating this event means that the system colours (may) have changed,
+    // so flush the values cached by wxSystemSettings before any handler,
+    // including the user-defined ones, can query them
+    wxSystemSettings::InvalidateCache();
+}
+
+// ----------------------------------------------------------------------------
+// wxDisplayChangedEvent
+// ----------------------------------------------------------------------------
+
+wxDisplayChangedEvent::wxDisplayChangedEvent()
+    : wxEvent(0, wxEVT_DISPLAY_CHANGED)
+{
+    // the display metrics cached by wxSystemSettings are invalid now
+    wxSystemSettings::InvalidateCache();
+}
+
 // ----------------------------------------------------------------------------
 // wxDPIChangedEvent
 // ----------------------------------------------------------------------------
 
+wxDPIChangedEvent::wxDPIChangedEvent(const wxSize& oldDPI, const wxSize& newDPI)
+    : wxEvent(0, wxEVT_DPI_CHANGED),
+      m_oldDPI(oldDPI),
+      m_newDPI(newDPI)
+{
+    // the DPI-dependent metrics cached by wxSystemSettings are invalid now
+    wxSystemSettings::InvalidateCache();
+}
+
 wxSize wxDPIChangedEvent::Scale(wxSize sz) const
 {
     return wxRescaleCoord(sz).From(m_oldDPI).To(m_newDPI);
@@ -1149,6 +1287,125 @@ void wxEventHashTable::GrowEventTypeTable()
     delete[] oldEventTypeTable;
 }
 
+// ----------------------------------------------------------------------------
+// wxEvtHandler::DynamicEventsIndex
+// ----------------------------------------------------------------------------
+
+WX_DECLARE_HASH_MAP(int, wxVector<size_t>, wxIntegerHash, wxIntegerEqual,
+                    wxDynamicEventTypeMap);
+
+// Hash index over the dynamic event table: maps an event type to the indices
+// of all the entries for this type in m_dynamicEvents, in binding order. This
+// plays the same role for Bind()-ed handlers as wxEventHashTable does for the
+// static event tables and turns dispatching into a scan over the entries for
+// the type of the event being processed only instead of over all of them.
+//
+// The indices stored here stay valid as long as the table is only appended to
+// or has entries nulled in place; whenever the table is compacted the index
+// must be rebuilt using Rebuild().
+class wxEvtHandler::DynamicEventsIndex
+{
+public:
+    // add a newly bound entry stored at the index n in the table
+    void Add(wxEventType eventType, size_t n)
+    {
+        m_map[eventType].push_back(n);
+    }
+
+    // return the indices of the entries for the given type or NULL if there
+    // are none
+    const wxVector<size_t> *Find(wxEventType eventType) const
+    {
+        wxDynamicEventTypeMap::const_iterator it = m_map.find(eventType);
+
+        return it == m_map.end() ? NULL : &it->second;
+    }
+
+    // rebuild the index from scratch after the table has been compacted
+    void Rebuild(const DynamicEvents& dynamicEvents)
+    {
+        m_map.clear();
+
+        const size_t count = dynamicEvents.size();
+        for ( size_t n = 0; n < count; n++ )
+        {
+            wxDynamicEventTableEntry* const entry = dynamicEvents[n];
+            if ( entry )
+                m_map[entry->m_eventType].push_back(n);
+        }
+    }
+
+private:
+    wxDynamicEventTypeMap m_map;
+};
+
+// ----------------------------------------------------------------------------
+// wxEvtHandler::PendingEventsQueue
+// ----------------------------------------------------------------------------
+
+#ifdef wxHAS_LOCKFREE_EVENT_QUEUE
+
+// Multiple-producers/single-consumer queue of the events posted with
+// QueueEvent(): any number of threads may Push() events concurrently without
+// taking any locks, while the consumer (the thread running the event loop)
+// periodically detaches everything accumulated so far with DetachAll().
+//
+// The implementation is an intrusive Treiber stack using wxEvent's
+// m_nextPending link, reversed into FIFO order when draining it.
+class wxEvtHandler::PendingEventsQueue
+{
+public:
+    PendingEventsQueue() : m_head(NULL) { }
+
+    // Push an event, return true if the queue was empty before, meaning that
+    // the caller must ensure that the handler is registered as having
+    // pending events.
+    bool Push(wxEvent* event)
+    {
+        wxEvent* head = m_head.load(std::memory_order_relaxed);
+        do
+        {
+            event->m_nextPending = head;
+        }
+        while ( !m_head.compare_exchange_weak(head, event,
+                                              std::memory_order_release,
+                                              std::memory_order_relaxed) );
+
+        return !head;
+    }
+
+    bool IsEmpty() const
+    {
+        return !m_head.load(std::memory_order_acquire);
+    }
+
+    // Atomically empty the queue and return the events in the order in which
+    // they were pushed, linked via their m_nextPending fields (NULL if none).
+    wxEvent* DetachAll()
+    {
+        wxEvent* event = m_head.exchange(NULL, std::memory_order_acquire);
+
+        // the stack is in LIFO order, reverse it
+        wxEvent* fifo = NULL;
+        while ( event )
+        {
+            wxEvent* const next = event->m_nextPending;
+            event->m_nextPending = fifo;
+            fifo = event;
+            event = next;
+        }
+
+        return fifo;
+    }
+
+private:
+    std::atomic<wxEvent*> m_head;
+
+    wxDECLARE_NO_COPY_CLASS(PendingEventsQueue);
+};
+
+#endif // wxHAS_LOCKFREE_EVENT_QUEUE
+
 // ----------------------------------------------------------------------------
 // wxEvtHandler
 // ----------------------------------------------------------------------------
@@ -1159,6 +1416,12 @@ wxEvtHandler::wxEvtHandler()
     m_previousHandler = NULL;
     m_enabled = true;
     m_dynamicEvents = NULL;
+    m_dynamicEventsIndex = NULL;
+#ifdef wxHAS_LOCKFREE_EVENT_QUEUE
+    m_pendingQueue = new PendingEventsQueue;
+#else
+    m_pendingQueue = NULL;
+#endif
     m_pendingEvents = NULL;
 
     // no client data (yet)
@@ -1195,6 +1458,7 @@ wxEvtHandler::~wxEvtHandler()
             delete entry;
         }
         delete m_dynamicEvents;
+        delete m_dynamicEventsIndex;
     }
 
     // Remove us from the list of the pending events if necessary.
@@ -1203,6 +1467,10 @@ wxEvtHandler::~wxEvtHandler()
 
     DeletePendingEvents();
 
+#ifdef wxHAS_LOCKFREE_EVENT_QUEUE
+    delete m_pendingQueue;
+#endif
+
     // we only delete object data, not untyped
     if ( m_clientDataType == wxClientData_Object )
         delete m_clientObject;
@@ -1298,6 +1566,20 @@ void wxEvtHandler::QueueEvent(wxEvent *event)
         return;
     }
 
+#ifdef wxHAS_LOCKFREE_EVENT_QUEUE
+    // 1) Push the event to the lock-free queue: this can be done from any
+    //    number of threads concurrently without taking any locks at all.
+    //
+    // 2) If the queue was empty before our push, this handler may not be in
+    //    the list of event handlers with pending events any more, so (re-)add
+    //    it to it. This keeps the invariant that a handler with any pending
+    //    events is in the list: the events are only drained from the queue in
+    //    DrainPendingQueue() and ProcessPendingEvents() re-adds the handler
+    //    to the list if more events were pushed concurrently with removing it
+    //    (see there).
+    if ( m_pendingQueue->Push(event) )
+        wxTheApp->AppendPendingEventHandler(this);
+#else // !wxHAS_LOCKFREE_EVENT_QUEUE
     // 1) Add this event to our list of pending events
     wxENTER_CRIT_SECT( m_pendingEventsLock );
 
@@ -1318,6 +1600,7 @@ void wxEvtHandler::QueueEvent(wxEvent *event)
     // breaking the invariant that a handler should be in the list iff it has
     // any pending events to process
     wxLEAVE_CRIT_SECT( m_pendingEventsLock );
+#endif // wxHAS_LOCKFREE_EVENT_QUEUE/!wxHAS_LOCKFREE_EVENT_QUEUE
 
     // 3) Inform the system that new pending events are somewhere,
     //    and that these should be processed in idle time.
@@ -1326,11 +1609,37 @@ void wxEvtHandler::QueueEvent(wxEvent *event)
 
 void wxEvtHandler::DeletePendingEvents()
 {
+    wxENTER_CRIT_SECT( m_pendingEventsLock );
+    DrainPendingQueue();
+    wxLEAVE_CRIT_SECT( m_pendingEventsLock );
+
     if (m_pendingEvents)
         m_pendingEvents->DeleteContents(true);
     wxDELETE(m_pendingEvents);
 }
 
+// Move all the events accumulated in the lock-free queue, if any, to
+// m_pendingEvents; must be called with m_pendingEventsLock held.
+void wxEvtHandler::DrainPendingQueue()
+{
+#ifdef wxHAS_LOCKFREE_EVENT_QUEUE
+    wxEvent* event = m_pendingQueue->DetachAll();
+    if ( !event )
+        return;
+
+    if ( !m_pendingEvents )
+        m_pendingEvents = new wxList;
+
+    while ( event )
+    {
+        wxEvent* const next = event->m_nextPending;
+        event->m_nextPending = NULL;
+        m_pendingEvents->Append(event);
+        event = next;
+    }
+#endif // wxHAS_LOCKFREE_EVENT_QUEUE
+}
+
 void wxEvtHandler::ProcessPendingEvents()
 {
     if (!wxTheApp)
@@ -1347,6 +1656,10 @@ void wxEvtHandler::ProcessPendingEvents()
 
     wxENTER_CRIT_SECT( m_pendingEventsLock );
 
+    // take ownership of anything posted to the lock-free queue since the
+    // last time we were called
+    DrainPendingQueue();
+
     // this method is only called by wxApp if this handler does have
     // pending events
     wxCHECK_RET( m_pendingEvents && !m_pendingEvents->IsEmpty(),
@@ -1391,11 +1704,37 @@ void wxEvtHandler::ProcessPendingEvents()
         // if there are no more pending events left, we don't need to
         // stay in this list
         wxTheApp->RemovePendingEventHandler(this);
+
+#ifdef wxHAS_LOCKFREE_EVENT_QUEUE
+        // More events could have been pushed to the lock-free queue while we
+        // were removing ourselves from the list above: the producer may have
+        // seen a non-empty queue and so didn't re-add us to it, so check for
+        // this and re-add ourselves if necessary (this is harmless if the
+        // producer did re-add us first as AppendPendingEventHandler() does
+        // nothing in this case).
+        if ( !m_pendingQueue->IsEmpty() )
+            wxTheApp->AppendPendingEventHandler(this);
+#endif // wxHAS_LOCKFREE_EVENT_QUEUE
     }
 
     wxLEAVE_CRIT_SECT( m_pendingEventsLock );
 
-    ProcessEvent(*event);
+    if ( evtLoop && evtLoop->AreStatsEnabled() )
+    {
+        // remember everything needed for the statistics before processing the
+        // event because this object may be deleted by its handler
+        const wxString handlerClass = GetClassInfo()->GetClassName();
+        const wxEventType eventType = event->GetEventType();
+
+        wxStopWatch sw;
+        ProcessEvent(*event);
+
+        evtLoop->RecordHandlerTime(handlerClass, eventType, sw.TimeInMicro());
+    }
+    else
+    {
+        ProcessEvent(*event);
+    }
 
     // careful: this object could have been deleted by the event handler
     // executed by the above ProcessEvent() call, so we can't access any fields
@@ -1778,6 +2117,10 @@ void wxEvtHandler::DoBind(int id,
     // than inserting the element at the front.
     m_dynamicEvents->push_back(entry);
 
+    if ( !m_dynamicEventsIndex )
+        m_dynamicEventsIndex = new DynamicEventsIndex;
+    m_dynamicEventsIndex->Add(eventType, m_dynamicEvents->size() - 1);
+
     // Make sure we get to know when a sink is destroyed
     wxEvtHandler *eventSink = func->GetEvtHandler();
     if ( eventSink && eventSink != this )
@@ -1874,15 +2217,26 @@ bool wxEvtHandler::SearchDynamicEventTable( wxEvent& event )
 
     DynamicEvents& dynamicEvents = *m_dynamicEvents;
 
+    // Only the entries for the type of this event can match, and the index
+    // gives us exactly those, so we don't need to scan the entire table. If
+    // there is no bucket for this type at all, no handler was ever bound for
+    // it and we have nothing to do (any still unpruned deleted entries will
+    // be pruned when processing an unhandled event of a type that does have a
+    // bucket, which is good enough as pruning is only an optimization).
+    const wxVector<size_t>* const
+        indices = m_dynamicEventsIndex->Find(event.GetEventType());
+    if ( !indices )
+        return false;
+
     bool needToPruneDeleted = false;
 
     // We can't use Get{First,Next}DynamicEntry() here as they hide the deleted
     // but not yet pruned entries from the caller, but here we do want to know
     // about them, so iterate directly. Remember to do it in the reverse order
     // to honour the order of handlers connection.
-    for ( size_t n = dynamicEvents.size(); n; n-- )
+    for ( size_t i = indices->size(); i; i-- )
     {
-        wxDynamicEventTableEntry* const entry = dynamicEvents[n - 1];
+        wxDynamicEventTableEntry* const entry = dynamicEvents[(*indices)[i - 1]];
 
         if ( !entry )
         {
@@ -1893,7 +2247,7 @@ bool wxEvtHandler::SearchDynamicEventTable( wxEvent& event )
             continue;
         }
 
-        if ( event.GetEventType() == entry->m_eventType )
+        // the index only contains entries for this event type
         {
             wxEvtHandler *handler = entry->m_fn->GetEvtHandler();
             if ( !handler )
@@ -1929,6 +2283,10 @@ bool wxEvtHandler::SearchDynamicEventTable( wxEvent& event )
 
         wxASSERT( nNew != dynamicEvents.size() );
         dynamicEvents.resize(nNew);
+
+        // compacting the table invalidated all the indices stored in the
+        // index, so recreate it
+        m_dynamicEventsIndex->Rebuild(dynamicEvents);
     }
 
     return false;
@@ -16,10 +16,12 @@
 
 #ifndef WX_PRECOMP
     #include "wx/app.h"
+    #include "wx/log.h"
 #endif //WX_PRECOMP
 
 #include "wx/scopeguard.h"
 #include "wx/apptrait.h"
+#include "wx/stopwatch.h"
 #include "wx/private/eventloopsourcesmanager.h"
 
 // Counts currently existing event loops.
@@ -28,6 +30,54 @@
 // protect accesses to this variable.
 static int gs_eventLoopCount = 0;
 
+namespace
+{
+
+// Accumulate the time elapsed during the lifetime of this object into the
+// given counter, used for the phase timings of an instrumented event loop.
+class wxEventLoopPhaseTimer
+{
+public:
+    wxEventLoopPhaseTimer(bool enabled, wxLongLong& counter)
+        : m_enabled(enabled),
+          m_counter(counter)
+    {
+    }
+
+    ~wxEventLoopPhaseTimer()
+    {
+        if ( m_enabled )
+            m_counter += m_watch.TimeInMicro();
+    }
+
+private:
+    const bool m_enabled;
+    wxLongLong& m_counter;
+    wxStopWatch m_watch;
+
+    wxDECLARE_NO_COPY_CLASS(wxEventLoopPhaseTimer);
+};
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// wxEventLoopStats
+// ----------------------------------------------------------------------------
+
+void wxEventLoopStats::Reset()
+{
+    iterations =
+    eventsProcessed =
+    slowHandlers = 0;
+
+    dispatchTime =
+    pendingTime =
+    idleTime = 0;
+
+    for ( int n = 0; n < HistogramSize; n++ )
+        handlerTimes[n] = 0;
+}
+
 // ----------------------------------------------------------------------------
 // wxEventLoopBase
 // ----------------------------------------------------------------------------
@@ -42,6 +92,10 @@ wxEventLoopBase::wxEventLoopBase()
     m_shouldExit = false;
     m_yieldLevel = 0;
     m_eventsToProcessInsideYield = wxEVT_CATEGORY_ALL;
+    m_yieldDeadline = 0;
+    m_statsEnabled = false;
+    m_slowHandlerThreshold = 0;
+    m_slowHandlerCallback = NULL;
 }
 
 wxEventLoopBase::~wxEventLoopBase()
@@ -104,6 +158,41 @@ bool wxEventLoopBase::ProcessIdle()
     return wxTheApp && wxTheApp->ProcessIdle();
 }
 
+void wxEventLoopBase::RecordHandlerTime(const wxString& handlerClass,
+                                        wxEventType eventType,
+                                        const wxLongLong& timeMicro)
+{
+    m_stats.eventsProcessed++;
+
+    // find the histogram bucket corresponding to this execution time, i.e.
+    // the position of the highest set bit of the time in microseconds,
+    // clamped to the last bucket
+    int bucket = 0;
+    for ( wxLongLong t = timeMicro;
+          t > 1 && bucket < wxEventLoopStats::HistogramSize - 1;
+          t >>= 1 )
+        bucket++;
+    m_stats.handlerTimes[bucket]++;
+
+    if ( m_slowHandlerThreshold > 0 &&
+            timeMicro >= wxLongLong(m_slowHandlerThreshold) * 1000 )
+    {
+        m_stats.slowHandlers++;
+
+        if ( m_slowHandlerCallback )
+        {
+            (*m_slowHandlerCallback)(handlerClass, eventType, timeMicro);
+        }
+        else
+        {
+            wxLogDebug(wxS("Slow event handler: %s took %ldms to process an event of type %d"),
+                       handlerClass,
+                       (timeMicro / 1000).ToLong(),
+                       eventType);
+        }
+    }
+}
+
 bool wxEventLoopBase::Yield(bool onlyIfNeeded)
 {
     if ( onlyIfNeeded && IsYielding() )
@@ -156,6 +245,27 @@ bool wxEventLoopBase::YieldFor(long eventsToProcess)
     return true;
 }
 
+bool wxEventLoopBase::PumpFor(long milliseconds, long eventsToProcess)
+{
+    // save the outer deadline to keep nested calls working: the inner call
+    // may only shorten the budget, never extend it
+    const wxLongLong deadlineOld = m_yieldDeadline;
+
+    wxLongLong deadline = wxGetUTCTimeMillis() + milliseconds;
+    if ( deadlineOld != 0 && deadlineOld < deadline )
+        deadline = deadlineOld;
+
+    m_yieldDeadline = deadline;
+    wxON_BLOCK_EXIT_SET(m_yieldDeadline, deadlineOld);
+
+    return YieldFor(eventsToProcess);
+}
+
+bool wxEventLoopBase::YieldDeadlineExpired() const
+{
+    return m_yieldDeadline != 0 && wxGetUTCTimeMillis() >= m_yieldDeadline;
+}
+
 void wxEventLoopBase::DoYieldFor(long eventsToProcess)
 {
     // Normally yielding dispatches not only the pending native events, but
@@ -222,7 +332,12 @@ bool wxEventLoopManual::ProcessEvents()
     // executed)
     if ( wxTheApp )
     {
-        wxTheApp->ProcessPendingEvents();
+        {
+            wxEventLoopPhaseTimer phaseTimer(m_statsEnabled,
+                                             m_stats.pendingTime);
+
+            wxTheApp->ProcessPendingEvents();
+        }
 
         // One of the pending event handlers could have decided to exit the
         // loop so check for the flag before trying to dispatch more events
@@ -231,7 +346,12 @@ bool wxEventLoopManual::ProcessEvents()
             return false;
     }
 
-    const bool res = Dispatch();
+    bool res;
+    {
+        wxEventLoopPhaseTimer phaseTimer(m_statsEnabled, m_stats.dispatchTime);
+
+        res = Dispatch();
+    }
 
 #if wxUSE_EXCEPTIONS
     // Rethrow any exceptions which could have been produced by the handlers
@@ -264,6 +384,9 @@ int wxEventLoopManual::DoRun()
                 // give them the possibility to do whatever they want
                 OnNextIteration();
 
+                if ( m_statsEnabled )
+                    m_stats.iterations++;
+
                 // generate and process idle events for as long as we don't
                 // have anything else to do, but stop doing this if Exit() is
                 // called by one of the idle handlers
@@ -272,11 +395,16 @@ int wxEventLoopManual::DoRun()
                 // underlying toolkit, but not our own pending events added by
                 // QueueEvent(), so we need to call HasPendingEvents() to check
                 // for them too
-                while ( !m_shouldExit
-                            && !Pending()
-                                && !(wxTheApp && wxTheApp->HasPendingEvents())
-                                    && ProcessIdle() )
-                    ;
+                {
+                    wxEventLoopPhaseTimer phaseTimer(m_statsEnabled,
+                                                     m_stats.idleTime);
+
+                    while ( !m_shouldExit
+                                && !Pending()
+                                    && !(wxTheApp && wxTheApp->HasPendingEvents())
+                                        && ProcessIdle() )
+                        ;
+                }
 
                 // if Exit() was called, don't dispatch any more events here
                 if ( m_shouldExit )
@@ -28,11 +28,21 @@
 #include "wx/private/selectdispatcher.h"
 #ifdef __UNIX__
     #include "wx/unix/private/epolldispatcher.h"
+    #include "wx/unix/private/kqueuedispatcher.h"
 #endif
 
 static
 wxFDIODispatcher *gs_dispatcher = NULL;
 
+// the kind of dispatcher requested by SetKind(), used by the first call to
+// Get()
+static
+wxFDIODispatcher::Kind gs_dispatcherKind = wxFDIODispatcher::Kind_Default;
+
+// the kind of the dispatcher actually created
+static
+wxFDIODispatcher::Kind gs_dispatcherKindUsed = wxFDIODispatcher::Kind_Default;
+
 // ============================================================================
 // implementation
 // ============================================================================
@@ -47,11 +57,32 @@ wxFDIODispatcher *wxFDIODispatcher::Get()
     if ( !gs_dispatcher )
     {
 #if wxUSE_EPOLL_DISPATCHER
-        gs_dispatcher = wxEpollDispatcher::Create();
-        if ( !gs_dispatcher )
+        if ( gs_dispatcherKind == Kind_Default ||
+                gs_dispatcherKind == Kind_Epoll )
+        {
+            gs_dispatcher = wxEpollDispatcher::Create();
+            if ( gs_dispatcher )
+                gs_dispatcherKindUsed = Kind_Epoll;
+        }
 #endif // wxUSE_EPOLL_DISPATCHER
+#if wxUSE_KQUEUE_DISPATCHER
+        if ( !gs_dispatcher &&
+                (gs_dispatcherKind == Kind_Default ||
+                    gs_dispatcherKind == Kind_Kqueue) )
+        {
+            gs_dispatcher = wxKqueueDispatcher::Create();
+            if ( gs_dispatcher )
+                gs_dispatcherKindUsed = Kind_Kqueue;
+        }
+#endif // wxUSE_KQUEUE_DISPATCHER
 #if wxUSE_SELECT_DISPATCHER
+        // fall back to select() which always works, even if another kind was
+        // requested but couldn't be created
+        if ( !gs_dispatcher )
+        {
             gs_dispatcher = new wxSelectDispatcher();
+            gs_dispatcherKindUsed = Kind_Select;
+        }
 #endif // wxUSE_SELECT_DISPATCHER
     }
 
@@ -60,6 +91,47 @@ wxFDIODispatcher *wxFDIODispatcher::Get()
     return gs_dispatcher;
 }
 
+/* static */
+bool wxFDIODispatcher::SetKind(Kind kind)
+{
+    wxCHECK_MSG( !gs_dispatcher, false,
+                 "dispatcher kind must be set before first using Get()" );
+
+    switch ( kind )
+    {
+        case Kind_Default:
+            break;
+
+        case Kind_Select:
+#if !wxUSE_SELECT_DISPATCHER
+            return false;
+#endif
+            break;
+
+        case Kind_Epoll:
+#if !wxUSE_EPOLL_DISPATCHER
+            return false;
+#endif
+            break;
+
+        case Kind_Kqueue:
+#if !wxUSE_KQUEUE_DISPATCHER
+            return false;
+#endif
+            break;
+    }
+
+    gs_dispatcherKind = kind;
+
+    return true;
+}
+
+/* static */
+wxFDIODispatcher::Kind wxFDIODispatcher::GetKind()
+{
+    return gs_dispatcherKindUsed;
+}
+
 /* static */
 void wxFDIODispatcher::DispatchPending()
 {
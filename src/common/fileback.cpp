@@ -21,6 +21,11 @@
 
 #include "wx/private/filename.h"
 
+#if wxUSE_THREADS
+    #include "wx/thread.h"
+    #include "wx/vector.h"
+#endif
+
 // Prefer wxFFile unless wxFile has large file support but wxFFile does not.
 //
 #if wxUSE_FFILE && (defined wxHAS_LARGE_FFILES || !defined wxHAS_LARGE_FILES)
@@ -39,7 +44,9 @@ class wxBackingFileImpl
 public:
     wxBackingFileImpl(wxInputStream *stream,
                       size_t bufsize,
-                      const wxString& prefix);
+                      const wxString& prefix,
+                      size_t highWatermark,
+                      size_t lowWatermark);
     ~wxBackingFileImpl();
 
     void Release() { if (--m_refcount == 0) delete this; }
@@ -48,7 +55,20 @@ public:
     wxStreamError ReadAt(wxFileOffset pos, void *buffer, size_t *size);
     wxFileOffset GetLength() const;
 
+#if wxUSE_THREADS
+    // the body of the background writer thread
+    wxThread::ExitCode WriterEntry();
+#endif
+
 private:
+    // hand the current buffer contents over for spilling (synchronously or
+    // to the writer thread) so that the buffer can be refilled
+    wxStreamError SpillBuffer();
+
+    // read size1 bytes of already spilled data at pos, updating *size
+    wxStreamError ReadSpilled(wxFileOffset pos, void *buffer,
+                              size_t size1, size_t *size);
+
     int m_refcount;
 
     wxInputStream *m_stream;
@@ -61,12 +81,62 @@ private:
     wxString m_prefix;
     wxString m_filename;
     wxBFFile m_file;
+
+    // total bytes spilled: on disk plus, with a background writer, still
+    // queued for writing
     wxFileOffset m_filelen;
+
+#if wxUSE_THREADS
+    // a chunk of data handed over to the writer thread
+    struct Chunk
+    {
+        char *data;
+        size_t len;
+    };
+
+    bool StartWriter();
+
+    wxThread *m_writer;
+    wxMutex m_queueMutex;           // protects all the queue state below
+    wxCondition m_queueNotEmpty;    // signalled when a chunk is queued
+    wxCondition m_queueDrained;     // signalled when the queue drains
+    wxVector<Chunk> m_queue;        // chunks not yet written, in order
+    size_t m_queuedLen;             // total length of the queued chunks
+    wxFileOffset m_diskLen;         // bytes actually written to the file
+    size_t m_highWatermark;         // max bytes to queue before blocking
+    size_t m_lowWatermark;          // unblock when queue drains to this
+    bool m_writerError;             // the writer failed to write
+    bool m_writerQuit;              // tells the writer to terminate
+    wxMutex m_fileMutex;            // serializes seek+read/write on m_file
+#endif // wxUSE_THREADS
 };
 
+#if wxUSE_THREADS
+
+// The background writer thread: spills the chunks queued by the reader to
+// the backing file.
+class wxBackingFileWriterThread : public wxThread
+{
+public:
+    wxBackingFileWriterThread(wxBackingFileImpl *impl)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_impl(impl)
+    {
+    }
+
+    virtual ExitCode Entry() wxOVERRIDE { return m_impl->WriterEntry(); }
+
+private:
+    wxBackingFileImpl *m_impl;
+};
+
+#endif // wxUSE_THREADS
+
 wxBackingFileImpl::wxBackingFileImpl(wxInputStream *stream,
                                      size_t bufsize,
-                                     const wxString& prefix)
+                                     const wxString& prefix,
+                                     size_t highWatermark,
+                                     size_t lowWatermark)
   : m_refcount(1),
     m_stream(stream),
     m_parenterror(wxSTREAM_NO_ERROR),
@@ -75,11 +145,40 @@ wxBackingFileImpl::wxBackingFileImpl(wxInputStream *stream,
     m_buflen(0),
     m_prefix(prefix),
     m_filelen(0)
+#if wxUSE_THREADS
+    , m_writer(NULL),
+    m_queueNotEmpty(m_queueMutex),
+    m_queueDrained(m_queueMutex),
+    m_queuedLen(0),
+    m_diskLen(0),
+    m_highWatermark(highWatermark),
+    m_lowWatermark(lowWatermark),
+    m_writerError(false),
+    m_writerQuit(false)
+#endif
 {
+#if !wxUSE_THREADS
+    wxUnusedVar(highWatermark);
+    wxUnusedVar(lowWatermark);
+#endif
+
     wxFileOffset len = m_stream->GetLength();
 
     if (len >= 0 && len + size_t(1) < m_bufsize)
+    {
         m_bufsize = size_t(len + 1);
+#if wxUSE_THREADS
+        // the stream fits into memory, a writer thread would be useless
+        m_highWatermark = 0;
+#endif
+    }
+
+#if wxUSE_THREADS
+    if (m_highWatermark && m_highWatermark < m_bufsize)
+        m_highWatermark = m_bufsize;
+    if (!m_lowWatermark || m_lowWatermark > m_highWatermark)
+        m_lowWatermark = m_highWatermark / 2;
+#endif
 
     if (m_bufsize)
         m_buf = new char[m_bufsize];
@@ -87,6 +186,25 @@ wxBackingFileImpl::wxBackingFileImpl(wxInputStream *stream,
 
 wxBackingFileImpl::~wxBackingFileImpl()
 {
+#if wxUSE_THREADS
+    if (m_writer)
+    {
+        // tell the writer to finish and wait for it
+        {
+            wxMutexLocker lock(m_queueMutex);
+            m_writerQuit = true;
+            m_queueNotEmpty.Signal();
+        }
+
+        m_writer->Wait();
+        delete m_writer;
+
+        // free any chunks the writer didn't get to
+        for (size_t n = 0; n < m_queue.size(); n++)
+            delete [] m_queue[n].data;
+    }
+#endif // wxUSE_THREADS
+
     delete m_stream;
     delete [] m_buf;
 
@@ -94,6 +212,215 @@ wxBackingFileImpl::~wxBackingFileImpl()
         wxRemoveFile(m_filename);
 }
 
+#if wxUSE_THREADS
+
+bool wxBackingFileImpl::StartWriter()
+{
+    m_writer = new wxBackingFileWriterThread(this);
+
+    if (m_writer->Run() != wxTHREAD_NO_ERROR)
+    {
+        delete m_writer;
+        m_writer = NULL;
+        return false;
+    }
+
+    return true;
+}
+
+wxThread::ExitCode wxBackingFileImpl::WriterEntry()
+{
+    m_queueMutex.Lock();
+
+    for (;;)
+    {
+        while (m_queue.empty() && !m_writerQuit)
+            m_queueNotEmpty.Wait();
+
+        if (m_writerQuit || m_queue.empty())
+            break;
+
+        Chunk chunk = m_queue.front();
+
+        // write without holding the queue lock so that the reader can keep
+        // queueing and copying in the meantime; the chunk stays in the
+        // queue until it is safely on disk
+        m_queueMutex.Unlock();
+
+        bool ok = m_file.IsOpened()
+                    ? true
+                    : wxCreateTempFile(m_prefix, &m_file, &m_filename);
+
+        if (ok)
+        {
+            wxMutexLocker flock(m_fileMutex);
+
+            ok = m_file.Seek(m_diskLen) != wxBadSeek &&
+                 m_file.Write(chunk.data, chunk.len) == chunk.len;
+        }
+
+        m_queueMutex.Lock();
+
+        if (!ok)
+        {
+            m_writerError = true;
+            m_queueDrained.Broadcast();
+            break;
+        }
+
+        m_diskLen += chunk.len;
+        m_queuedLen -= chunk.len;
+        m_queue.erase(m_queue.begin());
+        delete [] chunk.data;
+
+        if (m_queuedLen <= m_lowWatermark)
+            m_queueDrained.Broadcast();
+    }
+
+    m_queueMutex.Unlock();
+
+    return 0;
+}
+
+#endif // wxUSE_THREADS
+
+wxStreamError wxBackingFileImpl::SpillBuffer()
+{
+#if wxUSE_THREADS
+    if (m_highWatermark)
+    {
+        if (m_writer || StartWriter())
+        {
+            wxMutexLocker lock(m_queueMutex);
+
+            // apply back pressure: wait for the writer to catch up rather
+            // than buffering without bound
+            while (m_queuedLen >= m_highWatermark && !m_writerError)
+                m_queueDrained.Wait();
+
+            if (m_writerError)
+            {
+                wxDELETE(m_stream);
+                m_parenterror = wxSTREAM_READ_ERROR;
+                return m_parenterror;
+            }
+
+            Chunk chunk;
+            chunk.data = m_buf;
+            chunk.len = m_buflen;
+            m_queue.push_back(chunk);
+            m_queuedLen += m_buflen;
+            m_queueNotEmpty.Signal();
+
+            m_filelen += m_buflen;
+            m_buflen = 0;
+
+            // the old buffer now belongs to the queue
+            m_buf = m_stream ? new char[m_bufsize] : NULL;
+
+            return wxSTREAM_NO_ERROR;
+        }
+
+        // couldn't start the writer thread, fall back to synchronous writes
+        m_highWatermark = 0;
+    }
+#endif // wxUSE_THREADS
+
+    if (!m_file.IsOpened())
+        if (!wxCreateTempFile(m_prefix, &m_file, &m_filename))
+            return wxSTREAM_READ_ERROR;
+
+    if (m_file.Seek(m_filelen) == wxBadSeek)
+        return wxSTREAM_READ_ERROR;
+
+    size_t count = m_file.Write(m_buf, m_buflen);
+    m_filelen += count;
+
+    if (count < m_buflen) {
+        wxDELETE(m_stream);
+        if (count > 0) {
+            wxDELETEA(m_buf);
+            m_buflen = 0;
+        }
+        m_parenterror = wxSTREAM_READ_ERROR;
+        return m_parenterror;
+    }
+
+    m_buflen = 0;
+
+    if (!m_stream) {
+        wxDELETEA(m_buf);
+    }
+
+    return wxSTREAM_NO_ERROR;
+}
+
+wxStreamError wxBackingFileImpl::ReadSpilled(wxFileOffset pos,
+                                             void *buffer,
+                                             size_t size1,
+                                             size_t *size)
+{
+    size_t ondisk = size1;
+
+#if wxUSE_THREADS
+    if (m_writer)
+    {
+        // Even after a writer error the data spilled so far stays readable:
+        // the failed chunk and everything after it are still in the queue.
+        wxMutexLocker lock(m_queueMutex);
+
+        // the queue covers [m_diskLen, m_filelen): copy the part of the
+        // request falling into it from memory while holding the lock
+        const wxFileOffset end = pos + wxFileOffset(size1);
+
+        if (end > m_diskLen)
+        {
+            ondisk = pos < m_diskLen ? size_t(m_diskLen - pos) : 0;
+
+            wxFileOffset chunkPos = m_diskLen;
+
+            for (size_t n = 0; n < m_queue.size() && chunkPos < end; n++)
+            {
+                const Chunk& chunk = m_queue[n];
+                const wxFileOffset from = wxMax(pos, chunkPos);
+                const wxFileOffset to = wxMin(end,
+                                              chunkPos + wxFileOffset(chunk.len));
+
+                if (from < to)
+                    memcpy((char*)buffer + size_t(from - pos),
+                           chunk.data + size_t(from - chunkPos),
+                           size_t(to - from));
+
+                chunkPos += chunk.len;
+            }
+        }
+    }
+#endif // wxUSE_THREADS
+
+    // read the part already written to the backing file
+    if (ondisk)
+    {
+#if wxUSE_THREADS
+        wxMutexLocker flock(m_fileMutex);
+#endif
+
+        if (m_file.Seek(pos) == wxBadSeek)
+            return wxSTREAM_READ_ERROR;
+
+        ssize_t n = m_file.Read(buffer, ondisk);
+        if (n < 0 || size_t(n) < ondisk)
+        {
+            if (n > 0)
+                *size += n;
+            return wxSTREAM_READ_ERROR;
+        }
+    }
+
+    *size += size1;
+
+    return wxSTREAM_NO_ERROR;
+}
+
 wxStreamError wxBackingFileImpl::ReadAt(wxFileOffset pos,
                                         void *buffer,
                                         size_t *size)
@@ -120,18 +447,13 @@ wxStreamError wxBackingFileImpl::ReadAt(wxFileOffset pos,
     if (pos < 0)
         return wxSTREAM_READ_ERROR;
 
-    // read the backing file
+    // read the backed data, from the file and, with a background writer,
+    // possibly from the chunks still waiting to be written
     if (size1) {
-        if (m_file.Seek(pos) == wxBadSeek)
-            return wxSTREAM_READ_ERROR;
-
-        ssize_t n = m_file.Read(buffer, size1);
-        if (n > 0) {
-            *size = n;
-            pos += n;
-        }
+        wxStreamError err = ReadSpilled(pos, buffer, size1, size);
+        pos += *size;
 
-        if (*size < size1)
+        if (err != wxSTREAM_NO_ERROR || *size < size1)
             return wxSTREAM_READ_ERROR;
     }
 
@@ -149,35 +471,13 @@ wxStreamError wxBackingFileImpl::ReadAt(wxFileOffset pos,
                 if (!m_stream && m_filelen == 0)
                     return m_parenterror;
 
-                // before refilling the buffer write out the current buffer
-                // to the backing file if there is anything in it
+                // before refilling the buffer spill the current buffer
+                // contents to the backing file if there is anything in it
                 if (m_buflen)
                 {
-                    if (!m_file.IsOpened())
-                        if (!wxCreateTempFile(m_prefix, &m_file, &m_filename))
-                            return wxSTREAM_READ_ERROR;
-
-                    if (m_file.Seek(m_filelen) == wxBadSeek)
-                        return wxSTREAM_READ_ERROR;
-
-                    size_t count = m_file.Write(m_buf, m_buflen);
-                    m_filelen += count;
-
-                    if (count < m_buflen) {
-                        wxDELETE(m_stream);
-                        if (count > 0) {
-                            wxDELETEA(m_buf);
-                            m_buflen = 0;
-                        }
-                        m_parenterror = wxSTREAM_READ_ERROR;
-                        return m_parenterror;
-                    }
-
-                    m_buflen = 0;
-
-                    if (!m_stream) {
-                        wxDELETEA(m_buf);
-                    }
+                    wxStreamError err = SpillBuffer();
+                    if (err != wxSTREAM_NO_ERROR)
+                        return err;
                 }
 
                 if (!m_stream)
@@ -222,8 +522,11 @@ wxFileOffset wxBackingFileImpl::GetLength() const
 
 wxBackingFile::wxBackingFile(wxInputStream *stream,
                              size_t bufsize,
-                             const wxString& prefix)
-  : m_impl(new wxBackingFileImpl(stream, bufsize, prefix))
+                             const wxString& prefix,
+                             size_t highWatermark,
+                             size_t lowWatermark)
+  : m_impl(new wxBackingFileImpl(stream, bufsize, prefix,
+                                 highWatermark, lowWatermark))
 {
 }
 
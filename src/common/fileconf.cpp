@@ -42,6 +42,10 @@
 
 #include  "wx/stdpaths.h"
 
+#if wxUSE_THREADS
+    #include  "wx/thread.h"
+#endif // wxUSE_THREADS
+
 #if defined(__WINDOWS__)
     #include "wx/msw/private.h"
 #endif  //windows.h
@@ -88,6 +92,23 @@ static wxString FilterOutEntryName(const wxString& str);
     WX_DEFINE_SORTED_ARRAY(wxFileConfigGroup *, ArrayGroups);
 #endif
 
+// hash index allowing to find the entries by name without comparing the
+// strings (wxFileConfigGroupHashMap playing the same role for the subgroups
+// is declared in the header as it's also used for the path cache there)
+WX_DECLARE_STRING_HASH_MAP(wxFileConfigEntry *, wxFileConfigEntryHashMap);
+
+// get the key used for a name in the hash indices: the names are compared
+// case-insensitively unless wxCONFIG_CASE_SENSITIVE is set, so the keys must
+// follow the same convention
+static inline wxString GetIndexKey(const wxString& name)
+{
+#if wxCONFIG_CASE_SENSITIVE
+    return name;
+#else
+    return name.Lower();
+#endif
+}
+
 // ----------------------------------------------------------------------------
 // wxFileConfigLineList
 // ----------------------------------------------------------------------------
@@ -172,6 +193,9 @@ private:
   wxFileConfigGroup  *m_pParent;    // parent group (NULL for root group)
   ArrayEntries  m_aEntries;         // entries in this group
   ArrayGroups   m_aSubgroups;       // subgroups
+
+  wxFileConfigEntryHashMap m_entryIndex;  // name => entry/subgroup indices
+  wxFileConfigGroupHashMap m_groupIndex;  // kept in sync with the arrays
   wxString      m_strName;          // group's name
   wxFileConfigLineList *m_pLine;    // pointer to our line in the linked list
   wxFileConfigEntry *m_pLastEntry;  // last entry/subgroup of this group in the
@@ -341,6 +365,7 @@ void wxFileConfig::Init()
 
     m_isDirty = false;
     m_autosave = true;
+    m_writer = NULL;
 }
 
 // constructor supports creation of wxFileConfig objects of any type
@@ -394,6 +419,7 @@ wxFileConfig::wxFileConfig(wxInputStream &inStream, const wxMBConv& conv)
 {
     m_isDirty = false;
     m_autosave = true;
+    m_writer = NULL;
 
     // always local_file when this constructor is called (?)
     SetStyle(GetStyle() | wxCONFIG_USE_LOCAL_FILE);
@@ -474,6 +500,8 @@ wxFileConfig::wxFileConfig(wxInputStream &inStream, const wxMBConv& conv)
 
 void wxFileConfig::CleanUp()
 {
+    m_pathCache.clear();
+
     delete m_pRootGroup;
 
     wxFileConfigLineList *pCur = m_linesHead;
@@ -486,6 +514,9 @@ void wxFileConfig::CleanUp()
 
 wxFileConfig::~wxFileConfig()
 {
+    // this waits for any scheduled write to be done
+    DisableWriteBehind();
+
     if ( m_autosave )
         Flush();
 
@@ -505,11 +536,10 @@ void wxFileConfig::Parse(const wxTextBuffer& buffer, bool bLocal)
 
   for ( size_t n = 0; n < nLineCount; n++ )
   {
-    wxString strLine = buffer[n];
-    // FIXME-UTF8: rewrite using iterators, without this buffer
-    wxWxCharBuffer buf(strLine.c_str());
-    const wxChar *pStart;
-    const wxChar *pEnd;
+    const wxString& strLine = buffer[n];
+    const wxString::const_iterator pLineEnd = strLine.end();
+    wxString::const_iterator pStart;
+    wxString::const_iterator pEnd;
 
     // add the line to linked list
     if ( bLocal )
@@ -517,39 +547,39 @@ void wxFileConfig::Parse(const wxTextBuffer& buffer, bool bLocal)
 
 
     // skip leading spaces
-    for ( pStart = buf; wxIsspace(*pStart); pStart++ )
+    for ( pStart = strLine.begin();
+          pStart != pLineEnd && wxIsspace(*pStart);
+          ++pStart )
       ;
 
     // skip blank/comment lines
-    if ( *pStart == wxT('\0')|| *pStart == wxT(';') || *pStart == wxT('#') )
+    if ( pStart == pLineEnd || *pStart == wxT(';') || *pStart == wxT('#') )
       continue;
 
     if ( *pStart == wxT('[') ) {          // a new group
       pEnd = pStart;
 
-      while ( *++pEnd != wxT(']') ) {
+      while ( ++pEnd != pLineEnd && *pEnd != wxT(']') ) {
         if ( *pEnd == wxT('\\') ) {
             // the next char is escaped, so skip it even if it is ']'
-            pEnd++;
-        }
-
-        if ( *pEnd == wxT('\n') || *pEnd == wxT('\0') ) {
-            // we reached the end of line, break out of the loop
-            break;
+            if ( ++pEnd == pLineEnd ) {
+                // we reached the end of line, break out of the loop
+                break;
+            }
         }
       }
 
-      if ( *pEnd != wxT(']') ) {
-        wxLogError(_("file '%s': unexpected character %c at line %zu."),
-                   buffer.GetName(), *pEnd, n + 1);
+      if ( pEnd == pLineEnd || *pEnd != wxT(']') ) {
+        wxLogError(_("file '%s': unexpected end of line %zu."),
+                   buffer.GetName(), n + 1);
         continue; // skip this line
       }
 
       // group name here is always considered as abs path
       wxString strGroup;
-      pStart++;
+      ++pStart;
       strGroup << wxCONFIG_PATH_SEPARATOR
-               << FilterInEntryName(wxString(pStart, pEnd - pStart));
+               << FilterInEntryName(wxString(pStart, pEnd));
 
       // will create it if doesn't yet exist
       SetPath(strGroup);
@@ -563,8 +593,8 @@ void wxFileConfig::Parse(const wxTextBuffer& buffer, bool bLocal)
 
       // check that there is nothing except comments left on this line
       bool bCont = true;
-      while ( *++pEnd != wxT('\0') && bCont ) {
-        switch ( *pEnd ) {
+      while ( ++pEnd != pLineEnd && bCont ) {
+        switch ( (*pEnd).GetValue() ) {
           case wxT('#'):
           case wxT(';'):
             bCont = false;
@@ -577,34 +607,34 @@ void wxFileConfig::Parse(const wxTextBuffer& buffer, bool bLocal)
 
           default:
             wxLogWarning(_("file '%s', line %zu: '%s' ignored after group header."),
-                         buffer.GetName(), n + 1, pEnd);
+                         buffer.GetName(), n + 1, wxString(pEnd, pLineEnd));
             bCont = false;
         }
       }
     }
     else {                        // a key
       pEnd = pStart;
-      while ( *pEnd && *pEnd != wxT('=') /* && !wxIsspace(*pEnd)*/ ) {
+      while ( pEnd != pLineEnd && *pEnd != wxT('=') /* && !wxIsspace(*pEnd)*/ ) {
         if ( *pEnd == wxT('\\') ) {
           // next character may be space or not - still take it because it's
           // quoted (unless there is nothing)
-          pEnd++;
-          if ( !*pEnd ) {
+          ++pEnd;
+          if ( pEnd == pLineEnd ) {
             // the error message will be given below anyhow
             break;
           }
         }
 
-        pEnd++;
+        ++pEnd;
       }
 
       wxString strKey(FilterInEntryName(wxString(pStart, pEnd).Trim()));
 
       // skip whitespace
-      while ( wxIsspace(*pEnd) )
-        pEnd++;
+      while ( pEnd != pLineEnd && wxIsspace(*pEnd) )
+        ++pEnd;
 
-      if ( *pEnd++ != wxT('=') ) {
+      if ( pEnd == pLineEnd || *pEnd++ != wxT('=') ) {
         wxLogError(_("file '%s', line %zu: '=' expected."),
                    buffer.GetName(), n + 1);
       }
@@ -638,10 +668,10 @@ void wxFileConfig::Parse(const wxTextBuffer& buffer, bool bLocal)
           pEntry->SetLine(m_linesTail);
 
         // skip whitespace
-        while ( wxIsspace(*pEnd) )
-          pEnd++;
+        while ( pEnd != pLineEnd && wxIsspace(*pEnd) )
+          ++pEnd;
 
-        wxString value = pEnd;
+        wxString value(pEnd, pLineEnd);
         if ( !(GetStyle() & wxCONFIG_USE_NO_ESCAPE_CHARACTERS) )
             value = FilterInValue(value);
 
@@ -672,7 +702,18 @@ wxFileConfig::DoSetPath(const wxString& strPath, bool createMissingComponents)
     }
 
     if ( strPath[0] == wxCONFIG_PATH_SEPARATOR ) {
-        // absolute path
+        // absolute path: as the same (possibly deep) paths tend to be reused
+        // over and over again, check the cache of the already resolved ones
+        // first -- it only contains normalized paths, so looking up the path
+        // as given can never yield a wrong result, just miss
+        wxFileConfigGroupHashMap::const_iterator it = m_pathCache.find(strPath);
+        if ( it != m_pathCache.end() )
+        {
+            m_pCurrentGroup = it->second;
+            m_strPath = strPath;
+            return true;
+        }
+
         wxSplitPath(aParts, strPath);
     }
     else {
@@ -704,6 +745,11 @@ wxFileConfig::DoSetPath(const wxString& strPath, bool createMissingComponents)
         m_strPath << wxCONFIG_PATH_SEPARATOR << aParts[n];
     }
 
+    // cache the result of the lookup under the normalized path (the root
+    // group is always found immediately, don't bother caching it)
+    if ( !m_strPath.empty() )
+        m_pathCache[m_strPath] = m_pCurrentGroup;
+
     return true;
 }
 
@@ -971,6 +1017,166 @@ bool wxFileConfig::DoWriteBinary(const wxString& key, const wxMemoryBuffer& buf)
 
 #endif // wxUSE_BASE64
 
+#if wxUSE_THREADS
+
+// ----------------------------------------------------------------------------
+// wxFileConfigWriterThread: the background writer used in write-behind mode
+// ----------------------------------------------------------------------------
+
+// This thread receives snapshots of the file contents from the main thread
+// and writes the most recent one to disk (atomically, via wxTempFile) at
+// most once per interval, so that a burst of changes results in a single
+// rewrite of the file.
+class wxFileConfigWriterThread : public wxThread
+{
+public:
+    wxFileConfigWriterThread(const wxString& path,
+                             const wxMBConv& conv,
+#ifdef __UNIX__
+                             int umask,
+#endif // __UNIX__
+                             int intervalMs)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_path(path),
+          m_conv(conv),
+          m_interval(intervalMs)
+    {
+#ifdef __UNIX__
+        m_umask = umask;
+#endif // __UNIX__
+        m_hasPending = false;
+        m_quit = false;
+        m_ok = true;
+    }
+
+    // replace any not yet written snapshot with this one
+    void Schedule(const wxString& text)
+    {
+        bool wake;
+        {
+            wxCriticalSectionLocker lock(m_cs);
+            m_pending = text;
+            wake = !m_hasPending;
+            m_hasPending = true;
+        }
+
+        if ( wake )
+            m_semWork.Post();
+    }
+
+    // forget the pending snapshot, e.g. after a synchronous Flush()
+    void CancelPending()
+    {
+        wxCriticalSectionLocker lock(m_cs);
+        m_hasPending = false;
+        m_pending.clear();
+    }
+
+    // write out anything still pending and stop the thread, return false if
+    // any of the writes done by this thread had failed
+    bool Quit()
+    {
+        {
+            wxCriticalSectionLocker lock(m_cs);
+            m_quit = true;
+        }
+
+        m_semWork.Post();
+        Wait();
+
+        return m_ok;
+    }
+
+protected:
+    virtual ExitCode Entry() wxOVERRIDE
+    {
+        for ( ;; )
+        {
+            m_semWork.Wait();
+
+            bool quit;
+            {
+                wxCriticalSectionLocker lock(m_cs);
+                quit = m_quit;
+            }
+
+            // wait a bit to coalesce the changes arriving close together
+            // into a single write -- unless we're being asked to finish
+            if ( !quit && m_interval )
+                wxMilliSleep(m_interval);
+
+            wxString text;
+            bool hasText = false;
+            {
+                wxCriticalSectionLocker lock(m_cs);
+                if ( m_hasPending )
+                {
+                    text.swap(m_pending);
+                    m_hasPending = false;
+                    hasText = true;
+                }
+
+                quit = m_quit;
+            }
+
+            if ( hasText && !DoWrite(text) )
+                m_ok = false;
+
+            if ( quit )
+                return 0;
+        }
+    }
+
+private:
+    bool DoWrite(const wxString& text)
+    {
+#ifdef __UNIX__
+        wxCHANGE_UMASK(m_umask);
+#endif // __UNIX__
+
+        wxTempFile file(m_path);
+
+        if ( !file.IsOpened() || !file.Write(text, m_conv) || !file.Commit() )
+        {
+            wxLogError(_("Failed to update user configuration file."));
+
+            return false;
+        }
+
+        return true;
+    }
+
+    const wxString m_path;
+    const wxMBConv& m_conv;
+    const int m_interval;
+#ifdef __UNIX__
+    int m_umask;
+#endif // __UNIX__
+
+    wxCriticalSection m_cs;
+    wxSemaphore m_semWork;
+    wxString m_pending;
+    bool m_hasPending,
+         m_quit,
+         m_ok;
+
+    wxDECLARE_NO_COPY_CLASS(wxFileConfigWriterThread);
+};
+
+#endif // wxUSE_THREADS
+
+wxString wxFileConfig::GetFileText() const
+{
+  wxString filetext;
+  filetext.reserve(4096);
+  for ( wxFileConfigLineList *p = m_linesHead; p != NULL; p = p->Next() )
+  {
+    filetext << p->Text() << wxTextFile::GetEOL();
+  }
+
+  return filetext;
+}
+
 bool wxFileConfig::Flush(bool /* bCurrentOnly */)
 {
   if ( !IsDirty() || !m_fnLocalFile.GetFullPath() )
@@ -988,14 +1194,7 @@ bool wxFileConfig::Flush(bool /* bCurrentOnly */)
   }
 
   // write all strings to file
-  wxString filetext;
-  filetext.reserve(4096);
-  for ( wxFileConfigLineList *p = m_linesHead; p != NULL; p = p->Next() )
-  {
-    filetext << p->Text() << wxTextFile::GetEOL();
-  }
-
-  if ( !file.Write(filetext, *m_conv) )
+  if ( !file.Write(GetFileText(), *m_conv) )
   {
     wxLogError(_("can't write user configuration file."));
     return false;
@@ -1008,11 +1207,100 @@ bool wxFileConfig::Flush(bool /* bCurrentOnly */)
       return false;
   }
 
+#if wxUSE_THREADS
+  // whatever was scheduled for the background writer is now stale
+  if ( m_writer )
+      m_writer->CancelPending();
+#endif // wxUSE_THREADS
+
   ResetDirty();
 
   return true;
 }
 
+void wxFileConfig::SetDirty()
+{
+  m_isDirty = true;
+
+#if wxUSE_THREADS
+  // in write-behind mode snapshot the new contents for the background
+  // writer: rendering the text in memory here is cheap compared to the file
+  // write itself and it avoids having to share the tree with another thread
+  if ( m_writer )
+      m_writer->Schedule(GetFileText());
+#endif // wxUSE_THREADS
+}
+
+// ----------------------------------------------------------------------------
+// write-behind mode
+// ----------------------------------------------------------------------------
+
+#if wxUSE_THREADS
+
+bool wxFileConfig::EnableWriteBehind(int intervalMs)
+{
+    wxCHECK_MSG( intervalMs >= 0, false,
+                 wxT("invalid write-behind interval") );
+
+    if ( m_writer )
+        return true;
+
+    // nothing to write behind without a local file
+    if ( !m_fnLocalFile.GetFullPath() )
+        return false;
+
+    wxFileConfigWriterThread *
+        writer = new wxFileConfigWriterThread(m_fnLocalFile.GetFullPath(),
+                                              *m_conv,
+#ifdef __UNIX__
+                                              m_umask,
+#endif // __UNIX__
+                                              intervalMs);
+
+    if ( writer->Create() != wxTHREAD_NO_ERROR ||
+            writer->Run() != wxTHREAD_NO_ERROR )
+    {
+        delete writer;
+        return false;
+    }
+
+    m_writer = writer;
+
+    // schedule any changes made before entering write-behind mode
+    if ( IsDirty() )
+        m_writer->Schedule(GetFileText());
+
+    return true;
+}
+
+void wxFileConfig::DisableWriteBehind()
+{
+    if ( !m_writer )
+        return;
+
+    // this writes out anything still pending
+    const bool ok = m_writer->Quit();
+
+    delete m_writer;
+    m_writer = NULL;
+
+    if ( ok )
+        ResetDirty();
+}
+
+#else // !wxUSE_THREADS
+
+bool wxFileConfig::EnableWriteBehind(int WXUNUSED(intervalMs))
+{
+    return false;
+}
+
+void wxFileConfig::DisableWriteBehind()
+{
+}
+
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+
 #if wxUSE_STREAMS
 
 bool wxFileConfig::Save(wxOutputStream& os, const wxMBConv& conv)
@@ -1085,6 +1373,9 @@ bool wxFileConfig::RenameGroup(const wxString& oldName,
 
     group->Rename(newName);
 
+    // the paths of the group and all of its subgroups changed
+    m_pathCache.clear();
+
     SetDirty();
 
     return true;
@@ -1107,7 +1398,8 @@ bool wxFileConfig::DeleteEntry(const wxString& key, bool bGroupIfEmptyAlso)
     if ( m_pCurrentGroup != m_pRootGroup ) {
       wxFileConfigGroup *pGroup = m_pCurrentGroup;
       SetPath(wxT(".."));  // changes m_pCurrentGroup!
-      m_pCurrentGroup->DeleteSubgroupByName(pGroup->Name());
+      if ( m_pCurrentGroup->DeleteSubgroupByName(pGroup->Name()) )
+        m_pathCache.clear();
     }
     //else: never delete the root group
   }
@@ -1122,6 +1414,9 @@ bool wxFileConfig::DeleteGroup(const wxString& key)
   if ( !m_pCurrentGroup->DeleteSubgroupByName(path.Name()) )
       return false;
 
+  // the deleted group (or one of its subgroups) could be cached
+  m_pathCache.clear();
+
   path.UpdateIfDeleted();
 
   SetDirty();
@@ -1509,10 +1804,12 @@ void wxFileConfigGroup::Rename(const wxString& newName)
     // we need to remove the group from the parent and it back under the new
     // name to keep the parents array of subgroups alphabetically sorted
     m_pParent->m_aSubgroups.Remove(this);
+    m_pParent->m_groupIndex.erase(GetIndexKey(m_strName));
 
     m_strName = newName;
 
     m_pParent->m_aSubgroups.Add(this);
+    m_pParent->m_groupIndex[GetIndexKey(newName)] = this;
 
     // update the group lines recursively
     UpdateGroupAndSubgroupsLines();
@@ -1531,67 +1828,24 @@ wxString wxFileConfigGroup::GetFullName() const
 // find an item
 // ----------------------------------------------------------------------------
 
-// use binary search because the array is sorted
+// use the hash indices: the sorted arrays are only kept for the enumeration
+// functions which must return the items in alphabetical order
 wxFileConfigEntry *
 wxFileConfigGroup::FindEntry(const wxString& name) const
 {
-  size_t
-       lo = 0,
-       hi = m_aEntries.GetCount();
-  wxFileConfigEntry *pEntry;
-
-  while ( lo < hi ) {
-    size_t i;
-    i = (lo + hi)/2;
-    pEntry = m_aEntries[i];
-
-    int res;
-    #if wxCONFIG_CASE_SENSITIVE
-      res = pEntry->Name().compare(name);
-    #else
-      res = pEntry->Name().CmpNoCase(name);
-    #endif
-
-    if ( res > 0 )
-      hi = i;
-    else if ( res < 0 )
-      lo = i + 1;
-    else
-      return pEntry;
-  }
+  wxFileConfigEntryHashMap::const_iterator
+    it = m_entryIndex.find(GetIndexKey(name));
 
-  return NULL;
+  return it == m_entryIndex.end() ? NULL : it->second;
 }
 
 wxFileConfigGroup *
 wxFileConfigGroup::FindSubgroup(const wxString& name) const
 {
-  size_t
-       lo = 0,
-       hi = m_aSubgroups.GetCount();
-  wxFileConfigGroup *pGroup;
-
-  while ( lo < hi ) {
-    size_t i;
-    i = (lo + hi)/2;
-    pGroup = m_aSubgroups[i];
-
-    int res;
-    #if wxCONFIG_CASE_SENSITIVE
-      res = pGroup->Name().compare(name);
-    #else
-      res = pGroup->Name().CmpNoCase(name);
-    #endif
-
-    if ( res > 0 )
-      hi = i;
-    else if ( res < 0 )
-      lo = i + 1;
-    else
-      return pGroup;
-  }
+  wxFileConfigGroupHashMap::const_iterator
+    it = m_groupIndex.find(GetIndexKey(name));
 
-  return NULL;
+  return it == m_groupIndex.end() ? NULL : it->second;
 }
 
 // ----------------------------------------------------------------------------
@@ -1606,6 +1860,11 @@ wxFileConfigEntry *wxFileConfigGroup::AddEntry(const wxString& strName, int nLin
     wxFileConfigEntry   *pEntry = new wxFileConfigEntry(this, strName, nLine);
 
     m_aEntries.Add(pEntry);
+
+    // use the name of the entry itself and not strName because the former has
+    // the immutable prefix removed and this is what FindEntry() is called with
+    m_entryIndex[GetIndexKey(pEntry->Name())] = pEntry;
+
     return pEntry;
 }
 
@@ -1617,6 +1876,8 @@ wxFileConfigGroup *wxFileConfigGroup::AddSubgroup(const wxString& strName)
     wxFileConfigGroup   *pGroup = new wxFileConfigGroup(this, strName, m_pConfig);
 
     m_aSubgroups.Add(pGroup);
+    m_groupIndex[GetIndexKey(strName)] = pGroup;
+
     return pGroup;
 }
 
@@ -1747,6 +2008,7 @@ bool wxFileConfigGroup::DeleteSubgroup(wxFileConfigGroup *pGroup)
     }
 
     m_aSubgroups.Remove(pGroup);
+    m_groupIndex.erase(GetIndexKey(pGroup->Name()));
     delete pGroup;
 
     return true;
@@ -1795,6 +2057,7 @@ bool wxFileConfigGroup::DeleteEntry(const wxString& name)
   }
 
   m_aEntries.Remove(pEntry);
+  m_entryIndex.erase(GetIndexKey(pEntry->Name()));
   delete pEntry;
 
   return true;
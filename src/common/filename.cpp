@@ -367,6 +367,17 @@ bool StatAny(wxStructStat& st, const wxFileName& fn)
 
 #endif // wxHAVE_LSTAT
 
+// Directory components repeat heavily across sibling paths (every file in a
+// directory shares all its prefix components), so route them through a
+// shared interning table: all the wxFileName objects then hold the same
+// small set of canonical component strings instead of private copies.
+const wxString& InternDirComponent(const wxString& dir)
+{
+    static wxStringInterner s_dirInterner;
+
+    return s_dirInterner.Intern(dir);
+}
+
 } // anonymous namespace
 
 // ============================================================================
@@ -386,6 +397,12 @@ void wxFileName::Assign( const wxFileName &filepath )
     m_relative = filepath.m_relative;
     m_hasExt = filepath.m_hasExt;
     m_dontFollowLinks = filepath.m_dontFollowLinks;
+
+    // the memoized state remains valid for an identical object
+    m_fullpath = filepath.m_fullpath;
+    m_fullpathFormat = filepath.m_fullpathFormat;
+    m_fullpathValid = filepath.m_fullpathValid;
+    m_normFlags = filepath.m_normFlags;
 }
 
 void wxFileName::Assign(const wxString& volume,
@@ -416,6 +433,8 @@ void wxFileName::SetPath( const wxString& path, wxPathFormat format )
 void
 wxFileName::DoSetPath(const wxString& pathOrig, wxPathFormat format, int flags)
 {
+    InvalidateCache();
+
     m_dirs.Clear();
 
     if ( pathOrig.empty() )
@@ -514,7 +533,7 @@ wxFileName::DoSetPath(const wxString& pathOrig, wxPathFormat format, int flags)
         }
         else
         {
-           m_dirs.Add( token );
+           m_dirs.Add( InternDirComponent(token) );
         }
     }
 }
@@ -595,6 +614,11 @@ void wxFileName::Clear()
 
     // follow symlinks by default
     m_dontFollowLinks = false;
+
+    m_fullpath.clear();
+    m_fullpathFormat = wxPATH_NATIVE;
+    m_fullpathValid = false;
+    m_normFlags = 0;
 }
 
 /* static */
@@ -1416,6 +1440,14 @@ bool wxFileName::Normalize(int flags,
                            const wxString& cwd,
                            wxPathFormat format)
 {
+    // normalization is idempotent, so if all the requested transformations
+    // have already been applied since the last modification there is
+    // nothing left to do
+    if ( flags && (flags & ~m_normFlags) == 0 )
+        return true;
+
+    InvalidateCache();
+
     // deal with env vars renaming first as this may seriously change the path
     if ( flags & wxPATH_NORM_ENV_VARS )
     {
@@ -1575,6 +1607,13 @@ bool wxFileName::Normalize(int flags,
         }
     }
 
+    // remember which normalizations have been applied (the helpers called
+    // above have reset this together with the full path cache), except that
+    // making the path absolute is only done once it has succeeded
+    m_normFlags = flags;
+    if ( m_relative )
+        m_normFlags &= ~wxPATH_NORM_ABSOLUTE;
+
     return true;
 }
 
@@ -1834,6 +1873,8 @@ bool wxFileName::MakeRelativeTo(const wxString& pathBase, wxPathFormat format)
 
     m_relative = true;
 
+    InvalidateCache();
+
     // we were modified
     return true;
 }
@@ -2027,7 +2068,8 @@ bool wxFileName::AppendDir( const wxString& dir )
 {
     if (!IsValidDirComponent(dir))
         return false;
-    m_dirs.Add(dir);
+    m_dirs.Add(InternDirComponent(dir));
+    InvalidateCache();
     return true;
 }
 
@@ -2040,13 +2082,15 @@ bool wxFileName::InsertDir(size_t before, const wxString& dir)
 {
     if (!IsValidDirComponent(dir))
         return false;
-    m_dirs.Insert(dir, before);
+    m_dirs.Insert(InternDirComponent(dir), before);
+    InvalidateCache();
     return true;
 }
 
 void wxFileName::RemoveDir(size_t pos)
 {
     m_dirs.RemoveAt(pos);
+    InvalidateCache();
 }
 
 // ----------------------------------------------------------------------------
@@ -2057,6 +2101,7 @@ void wxFileName::SetFullName(const wxString& fullname)
 {
     SplitPath(fullname, NULL /* no volume */, NULL /* no path */,
                         &m_name, &m_ext, &m_hasExt);
+    InvalidateCache();
 }
 
 wxString wxFileName::GetFullName() const
@@ -2176,6 +2221,13 @@ wxString wxFileName::GetPath( int flags, wxPathFormat format ) const
 
 wxString wxFileName::GetFullPath( wxPathFormat format ) const
 {
+    format = GetFormat(format);
+
+    // building the path is relatively expensive, so return the memoized
+    // result while the object is unchanged
+    if ( m_fullpathValid && format == m_fullpathFormat )
+        return m_fullpath;
+
     // we already have a function to get the path
     wxString fullpath = GetPath(wxPATH_GET_VOLUME | wxPATH_GET_SEPARATOR,
                                 format);
@@ -2183,6 +2235,10 @@ wxString wxFileName::GetFullPath( wxPathFormat format ) const
     // now just add the file name and extension to it
     fullpath += GetFullName();
 
+    m_fullpath = fullpath;
+    m_fullpathFormat = format;
+    m_fullpathValid = true;
+
     return fullpath;
 }
 
@@ -331,6 +331,18 @@ wxIMPLEMENT_ABSTRACT_CLASS(wxFSFile, wxObject);
 
 wxList wxFileSystem::m_Handlers;
 
+WX_DECLARE_STRING_HASH_MAP(wxFileSystemHandler*, wxFSHandlerByProtocolHash);
+
+// This hash maps the protocol of a location to the first handler in
+// m_Handlers able to open it, so that opening many files using the same
+// protocol, which is by far the most common case, doesn't need to query all
+// the handlers for each of them. Handlers are expected to decide whether they
+// can open a location from its protocol alone (as all the standard ones do),
+// but to stay on the safe side the cached handler is still asked to confirm
+// via CanOpen() before being used. The hash is flushed whenever the list of
+// the handlers changes.
+static wxFSHandlerByProtocolHash gs_handlerByProtocol;
+
 
 wxFileSystem::~wxFileSystem()
 {
@@ -452,6 +464,64 @@ wxFileSystemHandler *wxFileSystem::MakeLocal(wxFileSystemHandler *h)
 
 
 
+/* static */
+wxFileSystemHandler *wxFileSystem::FindHandler(const wxString& location)
+{
+    const wxString protocol = wxFileSystemHandler::GetProtocol(location);
+
+    wxFSHandlerByProtocolHash::iterator it = gs_handlerByProtocol.find(protocol);
+    if (it != gs_handlerByProtocol.end() && it->second->CanOpen(location))
+        return it->second;
+
+    for ( wxList::compatibility_iterator node = m_Handlers.GetFirst();
+          node; node = node->GetNext() )
+    {
+        wxFileSystemHandler *h = (wxFileSystemHandler*) node->GetData();
+        if (h->CanOpen(location))
+        {
+            if (gs_handlerByProtocol.find(protocol) == gs_handlerByProtocol.end())
+                gs_handlerByProtocol[protocol] = h;
+            return h;
+        }
+    }
+
+    return NULL;
+}
+
+wxFSFile* wxFileSystem::DoOpenFile(const wxString& location)
+{
+    const wxString protocol = wxFileSystemHandler::GetProtocol(location);
+
+    // first try the handler previously found for this protocol, if any
+    wxFSHandlerByProtocolHash::iterator it = gs_handlerByProtocol.find(protocol);
+    if (it != gs_handlerByProtocol.end() && it->second->CanOpen(location))
+    {
+        wxFSFile *s = MakeLocal(it->second)->OpenFile(*this, location);
+        if (s)
+            return s;
+    }
+
+    // query all the handlers: notice that a handler able to open the location
+    // can still fail to do it (e.g. if the file doesn't exist inside an
+    // archive), in which case the following ones are tried as before
+    for ( wxList::compatibility_iterator node = m_Handlers.GetFirst();
+          node; node = node->GetNext() )
+    {
+        wxFileSystemHandler *h = (wxFileSystemHandler*) node->GetData();
+        if (h->CanOpen(location))
+        {
+            if (gs_handlerByProtocol.find(protocol) == gs_handlerByProtocol.end())
+                gs_handlerByProtocol[protocol] = h;
+
+            wxFSFile *s = MakeLocal(h)->OpenFile(*this, location);
+            if (s)
+                return s;
+        }
+    }
+
+    return NULL;
+}
+
 wxFSFile* wxFileSystem::OpenFile(const wxString& location, int flags)
 {
     if ((flags & wxFS_READ) == 0)
@@ -461,7 +531,6 @@ wxFSFile* wxFileSystem::OpenFile(const wxString& location, int flags)
     unsigned i, ln;
     wxChar meta;
     wxFSFile *s = NULL;
-    wxList::compatibility_iterator node;
 
     ln = loc.length();
     meta = 0;
@@ -481,33 +550,17 @@ wxFSFile* wxFileSystem::OpenFile(const wxString& location, int flags)
     if (meta != wxT(':') && !m_Path.empty())
     {
         const wxString fullloc = m_Path + loc;
-        node = m_Handlers.GetFirst();
-        while (node)
-        {
-            wxFileSystemHandler *h = (wxFileSystemHandler*) node -> GetData();
-            if (h->CanOpen(fullloc))
-            {
-                s = MakeLocal(h)->OpenFile(*this, fullloc);
-                if (s) { m_LastName = fullloc; break; }
-            }
-            node = node->GetNext();
-        }
+        s = DoOpenFile(fullloc);
+        if (s)
+            m_LastName = fullloc;
     }
 
     // if failed, try absolute paths :
     if (s == NULL)
     {
-        node = m_Handlers.GetFirst();
-        while (node)
-        {
-            wxFileSystemHandler *h = (wxFileSystemHandler*) node->GetData();
-            if (h->CanOpen(loc))
-            {
-                s = MakeLocal(h)->OpenFile(*this, loc);
-                if (s) { m_LastName = loc; break; }
-            }
-            node = node->GetNext();
-        }
+        s = DoOpenFile(loc);
+        if (s)
+            m_LastName = loc;
     }
 
     if (s && (flags & wxFS_SEEKABLE) != 0 && !s->GetStream()->IsSeekable())
@@ -525,7 +578,6 @@ wxFSFile* wxFileSystem::OpenFile(const wxString& location, int flags)
 
 wxString wxFileSystem::FindFirst(const wxString& spec, int flags)
 {
-    wxList::compatibility_iterator node;
     wxString spec2(spec);
 
     m_FindFileHandler = NULL;
@@ -533,28 +585,18 @@ wxString wxFileSystem::FindFirst(const wxString& spec, int flags)
     for (int i = spec2.length()-1; i >= 0; i--)
         if (spec2[(unsigned int) i] == wxT('\\')) spec2.GetWritableChar(i) = wxT('/'); // Want to be windows-safe
 
-    node = m_Handlers.GetFirst();
-    while (node)
+    wxFileSystemHandler *h = FindHandler(m_Path + spec2);
+    if (h)
     {
-        wxFileSystemHandler *h = (wxFileSystemHandler*) node -> GetData();
-        if (h -> CanOpen(m_Path + spec2))
-        {
-            m_FindFileHandler = MakeLocal(h);
-            return m_FindFileHandler -> FindFirst(m_Path + spec2, flags);
-        }
-        node = node->GetNext();
+        m_FindFileHandler = MakeLocal(h);
+        return m_FindFileHandler -> FindFirst(m_Path + spec2, flags);
     }
 
-    node = m_Handlers.GetFirst();
-    while (node)
+    h = FindHandler(spec2);
+    if (h)
     {
-        wxFileSystemHandler *h = (wxFileSystemHandler*) node -> GetData();
-        if (h -> CanOpen(spec2))
-        {
-            m_FindFileHandler = MakeLocal(h);
-            return m_FindFileHandler -> FindFirst(spec2, flags);
-        }
-        node = node->GetNext();
+        m_FindFileHandler = MakeLocal(h);
+        return m_FindFileHandler -> FindFirst(spec2, flags);
     }
 
     return wxEmptyString;
@@ -608,6 +650,8 @@ void wxFileSystem::AddHandler(wxFileSystemHandler *handler)
     // prepend the handler to the beginning of the list because handlers added
     // last should have the highest priority to allow overriding them
     m_Handlers.Insert((size_t)0, handler);
+
+    gs_handlerByProtocol.clear();
 }
 
 wxFileSystemHandler* wxFileSystem::RemoveHandler(wxFileSystemHandler *handler)
@@ -620,25 +664,21 @@ wxFileSystemHandler* wxFileSystem::RemoveHandler(wxFileSystemHandler *handler)
     if (!m_Handlers.DeleteObject(handler))
         return NULL;
 
+    gs_handlerByProtocol.clear();
+
     return handler;
 }
 
 
 bool wxFileSystem::HasHandlerForPath(const wxString &location)
 {
-    for ( wxList::compatibility_iterator node = m_Handlers.GetFirst();
-           node; node = node->GetNext() )
-    {
-        wxFileSystemHandler *h = (wxFileSystemHandler*) node->GetData();
-        if (h->CanOpen(location))
-            return true;
-    }
-
-    return false;
+    return FindHandler(location) != NULL;
 }
 
 void wxFileSystem::CleanUpHandlers()
 {
+    gs_handlerByProtocol.clear();
+
     WX_CLEAR_LIST(wxList, m_Handlers);
 }
 
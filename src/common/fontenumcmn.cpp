@@ -83,11 +83,31 @@ public:
 /* static */
 wxArrayString wxFontEnumerator::GetFacenames(wxFontEncoding encoding, bool fixedWidthOnly)
 {
+    // Enumerating the fonts can be slow (it typically hits fontconfig or GDI)
+    // and many controls ask for the full list, so cache the result of the
+    // most common query for the duration of the session: the cache is only
+    // cleared by InvalidateCache(), called e.g. by wxFont::AddPrivateFont().
+    const bool
+        useCache = encoding == wxFONTENCODING_SYSTEM && !fixedWidthOnly;
+    if ( useCache && !gs_allFacenames.empty() )
+        return gs_allFacenames;
+
     wxSimpleFontEnumerator temp;
     temp.EnumerateFacenames(encoding, fixedWidthOnly);
+
+    if ( useCache )
+        gs_allFacenames = temp.m_arrFacenames;
+
     return temp.m_arrFacenames;
 }
 
+/* static */
+void wxFontEnumerator::CacheFacenames()
+{
+    if ( gs_allFacenames.empty() )
+        (void)GetFacenames();
+}
+
 /* static */
 wxArrayString wxFontEnumerator::GetEncodings(const wxString& facename)
 {
@@ -99,10 +119,9 @@ wxArrayString wxFontEnumerator::GetEncodings(const wxString& facename)
 /* static */
 bool wxFontEnumerator::IsValidFacename(const wxString &facename)
 {
-    // we cache the result of wxFontEnumerator::GetFacenames supposing that
-    // the array of face names won't change in the session of this program
-    if ( gs_allFacenames.empty() )
-        gs_allFacenames = wxFontEnumerator::GetFacenames();
+    // ensure that gs_allFacenames, which is filled as a side effect of
+    // enumerating all the facenames, is populated
+    CacheFacenames();
 
 #ifdef __WXMSW__
     // Quoting the MSDN:
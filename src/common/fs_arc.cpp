@@ -27,9 +27,8 @@
 // non-seekable stream, a copy of its backing file.
 //
 // This class is actually the reference counted implementation for the
-// wxArchiveFSCacheData class below. It was done that way to allow sharing
-// between instances of wxFileSystem, though that's a feature not used in this
-// version.
+// wxArchiveFSCacheData class below. It is done that way to allow sharing
+// between instances of wxFileSystem.
 //---------------------------------------------------------------------------
 
 WX_DECLARE_STRING_HASH_MAP(wxArchiveEntry*, wxArchiveFSEntryHash);
@@ -250,8 +249,14 @@ wxArchiveFSCacheData& wxArchiveFSCacheData::operator=(
 // wxArchiveFSCache
 //
 // wxArchiveFSCacheData caches a single archive, and this class holds a
-// collection of them to cache all the archives accessed by this instance
-// of wxFileSystem.
+// collection of them to cache all the archives accessed through the archive
+// handlers.
+//
+// Scanning an archive to build its catalog is expensive, so a single cache is
+// shared by all the archive handlers in the program: this way the help files
+// and other resources accessed through different wxFileSystem instances only
+// have their archives scanned once. The cache is kept alive by the references
+// held by the handlers and deleted together with the last of them.
 //---------------------------------------------------------------------------
 
 WX_DECLARE_STRING_HASH_MAP(wxArchiveFSCacheData, wxArchiveFSCacheDataHash);
@@ -259,8 +264,11 @@ WX_DECLARE_STRING_HASH_MAP(wxArchiveFSCacheData, wxArchiveFSCacheDataHash);
 class wxArchiveFSCache
 {
 public:
-    wxArchiveFSCache() { }
-    ~wxArchiveFSCache() { }
+    wxArchiveFSCache() : m_refcount(1) { }
+    ~wxArchiveFSCache();
+
+    void Release() { if (--m_refcount == 0) delete this; }
+    wxArchiveFSCache *AddRef() { m_refcount++; return this; }
 
     wxArchiveFSCacheData* Add(const wxString& name,
                               const wxArchiveClassFactory& factory,
@@ -269,9 +277,20 @@ public:
     wxArchiveFSCacheData *Get(const wxString& name);
 
 private:
+    int m_refcount;
+
     wxArchiveFSCacheDataHash m_hash;
 };
 
+// weak pointer to the shared cache, the handlers hold the real references
+static wxArchiveFSCache *gs_cache = NULL;
+
+wxArchiveFSCache::~wxArchiveFSCache()
+{
+    if (gs_cache == this)
+        gs_cache = NULL;
+}
+
 wxArchiveFSCacheData* wxArchiveFSCache::Add(
         const wxString& name,
         const wxArchiveClassFactory& factory,
@@ -316,7 +335,9 @@ wxArchiveFSHandler::wxArchiveFSHandler()
 wxArchiveFSHandler::~wxArchiveFSHandler()
 {
     Cleanup();
-    delete m_cache;
+
+    if (m_cache)
+        m_cache->Release();
 }
 
 void wxArchiveFSHandler::Cleanup()
@@ -350,7 +371,12 @@ wxFSFile* wxArchiveFSHandler::OpenFile(
     if (!right.empty() && right.GetChar(0) == wxT('/')) right = right.Mid(1);
 
     if (!m_cache)
-        m_cache = new wxArchiveFSCache;
+    {
+        if (gs_cache)
+            m_cache = gs_cache->AddRef();
+        else
+            m_cache = gs_cache = new wxArchiveFSCache;
+    }
 
     const wxArchiveClassFactory *factory;
     factory = wxArchiveClassFactory::Find(protocol);
@@ -413,7 +439,12 @@ wxString wxArchiveFSHandler::FindFirst(const wxString& spec, int flags)
     if (!right.empty() && right.Last() == wxT('/')) right.RemoveLast();
 
     if (!m_cache)
-        m_cache = new wxArchiveFSCache;
+    {
+        if (gs_cache)
+            m_cache = gs_cache->AddRef();
+        else
+            m_cache = gs_cache = new wxArchiveFSCache;
+    }
 
     const wxArchiveClassFactory *factory;
     factory = wxArchiveClassFactory::Find(protocol);
@@ -16,10 +16,39 @@
 #include "wx/fswatcher.h"
 #include "wx/private/fswatcher.h"
 
+#if wxUSE_TIMER
+    #include "wx/timer.h"
+#endif
+
 // ============================================================================
 // helpers
 // ============================================================================
 
+#if wxUSE_TIMER
+
+// Flushes the events accumulated by the owning watcher when the coalescing
+// window ends.
+class wxFSWCoalesceTimer : public wxTimer
+{
+public:
+    wxFSWCoalesceTimer(wxFileSystemWatcherBase* watcher) :
+        m_watcher(watcher)
+    {
+    }
+
+    virtual void Notify() wxOVERRIDE
+    {
+        m_watcher->FlushCoalescedEvents();
+    }
+
+private:
+    wxFileSystemWatcherBase* m_watcher;
+
+    wxDECLARE_NO_COPY_CLASS(wxFSWCoalesceTimer);
+};
+
+#endif // wxUSE_TIMER
+
 wxDEFINE_EVENT(wxEVT_FSWATCHER, wxFileSystemWatcherEvent);
 
 static wxString GetFSWEventChangeTypeName(int type)
@@ -77,7 +106,7 @@ wxString wxFileSystemWatcherEvent::ToString() const
 // ============================================================================
 
 wxFileSystemWatcherBase::wxFileSystemWatcherBase() :
-    m_service(0), m_owner(this)
+    m_service(0), m_owner(this), m_coalesceInterval(0), m_coalesceTimer(NULL)
 {
 }
 
@@ -85,6 +114,119 @@ wxFileSystemWatcherBase::~wxFileSystemWatcherBase()
 {
     RemoveAll();
     delete m_service;
+#if wxUSE_TIMER
+    delete m_coalesceTimer;
+#endif
+}
+
+void wxFileSystemWatcherBase::SetCoalesceInterval(int milliseconds)
+{
+#if wxUSE_TIMER
+    m_coalesceInterval = milliseconds;
+
+    // don't keep anything pending longer than the new window
+    if ( m_coalesceInterval <= 0 )
+        FlushCoalescedEvents();
+#else
+    wxUnusedVar(milliseconds);
+#endif
+}
+
+void wxFileSystemWatcherBase::DeliverEvent(wxFileSystemWatcherEvent& event)
+{
+#if wxUSE_TIMER
+    // only simple changes to a single path can be merged meaningfully:
+    // renames, warnings and errors are always delivered at once
+    const int coalescable = wxFSW_EVENT_CREATE | wxFSW_EVENT_DELETE |
+                            wxFSW_EVENT_MODIFY | wxFSW_EVENT_ACCESS |
+                            wxFSW_EVENT_ATTRIB;
+
+    const int flags = event.GetChangeType();
+
+    if ( m_coalesceInterval > 0 && flags && (flags & ~coalescable) == 0 )
+    {
+        wxFSWPendingChange&
+            pending = m_pendingChanges[event.GetPath().GetFullPath()];
+
+        // work out the net effect of the old and the new change
+        if ( flags & wxFSW_EVENT_DELETE )
+        {
+            // deletion undoes a pending creation, otherwise it wins
+            pending.flags = pending.flags & wxFSW_EVENT_CREATE
+                                ? 0
+                                : wxFSW_EVENT_DELETE;
+        }
+        else if ( flags & wxFSW_EVENT_CREATE )
+        {
+            // recreating a just deleted path amounts to modifying it
+            pending.flags = pending.flags & wxFSW_EVENT_DELETE
+                                ? wxFSW_EVENT_MODIFY
+                                : wxFSW_EVENT_CREATE;
+        }
+        else // modification, attribute or access change
+        {
+            // such changes don't alter the net effect for a path already
+            // created or deleted within the window; otherwise keep the
+            // most informative of the accumulated change types
+            if ( pending.flags & (wxFSW_EVENT_CREATE | wxFSW_EVENT_DELETE) )
+                ; // leave pending.flags as is
+            else if ( (pending.flags | flags) & wxFSW_EVENT_MODIFY )
+                pending.flags = wxFSW_EVENT_MODIFY;
+            else if ( (pending.flags | flags) & wxFSW_EVENT_ATTRIB )
+                pending.flags = wxFSW_EVENT_ATTRIB;
+            else
+                pending.flags = wxFSW_EVENT_ACCESS;
+        }
+
+        pending.count += event.GetChangeCount();
+
+        if ( !m_coalesceTimer )
+            m_coalesceTimer = new wxFSWCoalesceTimer(this);
+
+        // the window starts with the first pending event, later ones
+        // falling into it don't extend it
+        if ( !m_coalesceTimer->IsRunning() )
+            m_coalesceTimer->StartOnce(m_coalesceInterval);
+
+        return;
+    }
+
+    // deliver everything accumulated so far first to keep the relative
+    // order of the events for the same path
+    FlushCoalescedEvents();
+#endif // wxUSE_TIMER
+
+    GetOwner()->ProcessEvent(event);
+}
+
+void wxFileSystemWatcherBase::FlushCoalescedEvents()
+{
+#if wxUSE_TIMER
+    if ( m_coalesceTimer && m_coalesceTimer->IsRunning() )
+        m_coalesceTimer->Stop();
+
+    if ( m_pendingChanges.empty() )
+        return;
+
+    // the handlers of the delivered events may watch new paths or generate
+    // more events, so detach the accumulated ones before delivering them
+    wxFSWPendingChangeMap changes(m_pendingChanges);
+    m_pendingChanges.clear();
+
+    for ( wxFSWPendingChangeMap::iterator it = changes.begin();
+          it != changes.end();
+          ++it )
+    {
+        // a creation cancelled by a deletion leaves no net change
+        if ( !it->second.flags )
+            continue;
+
+        const wxFileName path(it->first);
+        wxFileSystemWatcherEvent event(it->second.flags, path, path);
+        event.SetChangeCount(it->second.count);
+        GetOwner()->ProcessEvent(event);
+    }
+#endif // wxUSE_TIMER
 }
 
 bool wxFileSystemWatcherBase::Add(const wxFileName& path, int events)
@@ -22,6 +22,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "wx/gifdecod.h"
+#include "wx/mstream.h"
 #include "wx/scopedarray.h"
 #include "wx/scopedptr.h"
 #include "wx/scopeguard.h"
@@ -39,6 +40,12 @@ enum
 
 #define GetFrame(n)     ((GIFImage*)m_frames[n])
 
+// Number of decoded frames kept in memory simultaneously: frames are decoded
+// on demand from the (much smaller) compressed raster data, so this bounds
+// the memory used by a loaded animation at the price of decompressing a
+// frame again whenever it is accessed after having been evicted.
+static const unsigned int wxGIF_FRAME_CACHE_SIZE = 4;
+
 //---------------------------------------------------------------------------
 // GIFImage
 //---------------------------------------------------------------------------
@@ -49,6 +56,7 @@ class GIFImage
 public:
     // def ctor
     GIFImage();
+    ~GIFImage();
 
     unsigned int w;                 // width
     unsigned int h;                 // height
@@ -57,9 +65,13 @@ public:
     int transparent;                // transparent color index (-1 = none)
     wxAnimationDisposal disposal;   // disposal method
     long delay;                     // delay in ms (-1 = unused)
-    unsigned char *p;               // bitmap
+    unsigned char *p;               // bitmap (NULL while not decoded)
     unsigned char *pal;             // palette
     unsigned int ncolours;          // number of colours
+    unsigned char *raster;          // still compressed raster data
+    unsigned int rastersize;        // size of raster data, in bytes
+    int bits;                       // initial LZW code size
+    int interl;                     // 1 if the frame is interlaced
     wxString comment;
 
     wxDECLARE_NO_COPY_CLASS(GIFImage);
@@ -84,6 +96,17 @@ GIFImage::GIFImage()
     p = (unsigned char *) NULL;
     pal = (unsigned char *) NULL;
     ncolours = 0;
+    raster = (unsigned char *) NULL;
+    rastersize = 0;
+    bits = 0;
+    interl = 0;
+}
+
+GIFImage::~GIFImage()
+{
+    free(p);
+    free(pal);
+    free(raster);
 }
 
 //---------------------------------------------------------------------------
@@ -103,14 +126,10 @@ void wxGIFDecoder::Destroy()
 {
     wxASSERT(m_nFrames==m_frames.GetCount());
     for (unsigned int i=0; i<m_nFrames; i++)
-    {
-        GIFImage *f = (GIFImage*)m_frames[i];
-        free(f->p);
-        free(f->pal);
-        delete f;
-    }
+        delete GetFrame(i);
 
     m_frames.Clear();
+    m_cachedFrames.clear();
     m_nFrames = 0;
 }
 
@@ -142,6 +161,8 @@ bool wxGIFDecoder::ConvertToImage(unsigned int frame, wxImage *image) const
 
     pal = GetPalette(frame);
     src = GetData(frame);
+    if (src == NULL)
+        return false;
     dst = image->GetData();
     transparent = GetTransparentColourIndex(frame);
 
@@ -273,7 +294,67 @@ wxColour wxGIFDecoder::GetTransparentColour(unsigned int frame) const
                     pal[n*3 + 2]);
 }
 
-unsigned char* wxGIFDecoder::GetData(unsigned int frame) const    { return (GetFrame(frame)->p); }
+unsigned char* wxGIFDecoder::GetData(unsigned int frame) const
+{
+    // decoding a frame updates the cache, but doesn't change the visible
+    // state of the decoder
+    wxGIFDecoder * const self = wxConstCast(this, wxGIFDecoder);
+    if ( self->EnsureFrameDecoded(frame) != wxGIF_OK )
+        return NULL;
+
+    return GetFrame(frame)->p;
+}
+
+wxGIFErrorCode wxGIFDecoder::EnsureFrameDecoded(unsigned int frame)
+{
+    wxCHECK_MSG( frame < m_nFrames, wxGIF_INVFORMAT, wxT("invalid GIF frame") );
+
+    GIFImage * const img = GetFrame(frame);
+
+    if ( img->p != NULL )
+    {
+        // already decoded, just move it to the most recently used position
+        for ( size_t i = 0; i < m_cachedFrames.size(); i++ )
+        {
+            if ( m_cachedFrames[i] == frame )
+            {
+                m_cachedFrames.erase(m_cachedFrames.begin() + i);
+                break;
+            }
+        }
+        m_cachedFrames.push_back(frame);
+
+        return wxGIF_OK;
+    }
+
+    img->p = (unsigned char *) malloc(img->w * img->h);
+    if ( img->p == NULL )
+        return wxGIF_MEMERR;
+
+    wxMemoryInputStream mstream(img->raster, img->rastersize);
+
+    const wxGIFErrorCode result = dgif(mstream, img, img->interl, img->bits);
+    if ( result != wxGIF_OK )
+    {
+        free(img->p);
+        img->p = NULL;
+        return result;
+    }
+
+    // evict the least recently used frame if the cache is full: its raster
+    // data is kept, so it can always be decoded again later
+    if ( m_cachedFrames.size() >= wxGIF_FRAME_CACHE_SIZE )
+    {
+        GIFImage * const evicted = GetFrame(m_cachedFrames[0]);
+        free(evicted->p);
+        evicted->p = NULL;
+        m_cachedFrames.erase(m_cachedFrames.begin());
+    }
+
+    m_cachedFrames.push_back(frame);
+
+    return wxGIF_OK;
+}
 unsigned char* wxGIFDecoder::GetPalette(unsigned int frame) const { return (GetFrame(frame)->pal); }
 unsigned int wxGIFDecoder::GetNcolours(unsigned int frame) const  { return (GetFrame(frame)->ncolours); }
 int wxGIFDecoder::GetTransparentColourIndex(unsigned int frame) const  { return (GetFrame(frame)->transparent); }
@@ -622,7 +703,6 @@ wxGIFErrorCode wxGIFDecoder::LoadGIF(wxInputStream& stream)
     unsigned int  global_ncolors = 0;
     int           bits, interl, i;
     wxAnimationDisposal disposal;
-    long          size;
     long          delay;
     unsigned char type = 0;
     unsigned char pal[768];
@@ -832,17 +912,17 @@ wxGIFErrorCode wxGIFDecoder::LoadGIF(wxInputStream& stream)
                 }
 
                 interl = ((buf[8] & 0x40)? 1 : 0);
-                size = pimg->w * pimg->h;
 
                 pimg->transparent = transparent;
                 pimg->disposal = disposal;
                 pimg->delay = delay;
+                pimg->interl = interl;
 
-                // allocate memory for image and palette
-                pimg->p   = (unsigned char *) malloc((unsigned int)size);
+                // allocate memory for the palette only: the image itself is
+                // only decoded on demand, see EnsureFrameDecoded()
                 pimg->pal = (unsigned char *) malloc(768);
 
-                if ((!pimg->p) || (!pimg->pal))
+                if (!pimg->pal)
                     return wxGIF_MEMERR;
 
                 // load local color map if available, else use global map
@@ -865,11 +945,42 @@ wxGIFErrorCode wxGIFDecoder::LoadGIF(wxInputStream& stream)
                 bits = stream.GetC();
                 if (bits == 0)
                     return wxGIF_INVFORMAT;
+                pimg->bits = bits;
+
+                // store the compressed raster data without decoding it: the
+                // frames are decoded on demand, so that loading an animation
+                // costs memory proportional to the file size instead of the
+                // total decoded size of all its frames
+                unsigned int rasterAlloc = 0;
+                for ( ;; )
+                {
+                    i = stream.GetC();
+                    if (stream.Eof() || (stream.LastRead() == 0))
+                        i = 0;  // truncated, terminate the data ourselves
 
-                // decode image
-                wxGIFErrorCode result = dgif(stream, pimg.get(), interl, bits);
-                if (result != wxGIF_OK)
-                    return result;
+                    if (pimg->rastersize + (unsigned int)i + 1 > rasterAlloc)
+                    {
+                        rasterAlloc = rasterAlloc ? 2*rasterAlloc : 1024;
+
+                        unsigned char *larger = (unsigned char *)
+                            realloc(pimg->raster, rasterAlloc);
+                        if (!larger)
+                            return wxGIF_MEMERR;
+                        pimg->raster = larger;
+                    }
+
+                    // keep the sub-block length bytes: dgif() reads the data
+                    // in exactly the same format as it appears in the file
+                    pimg->raster[pimg->rastersize++] = (unsigned char)i;
+                    if (i == 0)
+                        break;
+
+                    stream.Read(pimg->raster + pimg->rastersize, i);
+                    const unsigned int numRead = stream.LastRead();
+                    pimg->rastersize += numRead;
+                    if ((int)numRead != i)
+                        break;  // truncated, decode what we have
+                }
 
                 guardDestroy.Dismiss();
 
@@ -891,6 +1002,16 @@ wxGIFErrorCode wxGIFDecoder::LoadGIF(wxInputStream& stream)
         return wxGIF_INVFORMAT;
     }
 
+    // decode the first frame now: it is normally shown immediately after
+    // loading anyhow and this validates its raster data, so that corrupted
+    // single image GIFs still fail to load instead of failing to convert
+    const wxGIFErrorCode errDecode = EnsureFrameDecoded(0);
+    if (errDecode != wxGIF_OK)
+    {
+        Destroy();
+        return errDecode;
+    }
+
     // try to read to the end of the stream
     while (type != GIF_MARKER_ENDOFDATA)
     {
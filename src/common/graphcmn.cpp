@@ -34,6 +34,8 @@
 #endif
 
 #include "wx/private/graphics.h"
+#include "wx/scopedptr.h"
+#include "wx/stopwatch.h"
 
 //-----------------------------------------------------------------------------
 
@@ -291,6 +293,13 @@ void wxGraphicsPath::CloseSubpath()
     GetPathData()->CloseSubpath();
 }
 
+// removes all points and subpaths
+void wxGraphicsPath::Clear()
+{
+    AllocExclusive();
+    GetPathData()->Clear();
+}
+
 // gets the last point of the current path, (0,0) if not yet set
 void wxGraphicsPath::GetCurrentPoint( wxDouble* x, wxDouble* y) const
 {
@@ -697,6 +706,22 @@ void wxGraphicsContext::DrawPath( const wxGraphicsPath& path, wxPolygonFillMode
     StrokePath( path );
 }
 
+void wxGraphicsContext::DrawPath( const wxGraphicsPath& path, size_t n,
+                                  const wxPoint2DDouble* offsets,
+                                  wxPolygonFillMode fillStyle )
+{
+    // Default implementation simply draws the path once per offset, but this
+    // still avoids recreating the path for every instance and backends can
+    // override this with a real batched draw.
+    const wxGraphicsMatrix transform = GetTransform();
+    for ( size_t i = 0; i < n; i++ )
+    {
+        Translate(offsets[i].m_x, offsets[i].m_y);
+        DrawPath(path, fillStyle);
+        SetTransform(transform);
+    }
+}
+
 void
 wxGraphicsContext::DoDrawRotatedText(const wxString &str,
                                      wxDouble x,
@@ -831,6 +856,77 @@ void wxGraphicsContext::StrokeLines( size_t n, const wxPoint2DDouble *beginPoint
     StrokePath( path );
 }
 
+void wxGraphicsContext::StrokeLinesBatch( size_t count, const size_t* sizes,
+                                          const wxPoint2DDouble* points,
+                                          const wxPen* pens )
+{
+    // All the polylines up to the next pen change are accumulated into a
+    // single path, so the per-stroke backend overhead is paid once per pen
+    // and not once per polyline.
+    wxGraphicsPath path = CreatePath();
+    bool pathUsed = false;
+    for ( size_t i = 0; i < count; ++i )
+    {
+        if ( pens && (i == 0 || pens[i] != pens[i - 1]) )
+        {
+            if ( pathUsed )
+            {
+                StrokePath( path );
+                path.Clear();
+                pathUsed = false;
+            }
+            SetPen( pens[i] );
+        }
+
+        const size_t size = sizes[i];
+        if ( size > 1 )
+        {
+            path.MoveToPoint(points[0].m_x, points[0].m_y);
+            for ( size_t j = 1; j < size; ++j )
+                path.AddLineToPoint( points[j].m_x, points[j].m_y );
+            pathUsed = true;
+        }
+        points += size;
+    }
+
+    if ( pathUsed )
+        StrokePath( path );
+}
+
+void wxGraphicsContext::StrokeLinesBatch( size_t count, const size_t* sizes,
+                                          const wxDouble* coords,
+                                          const wxPen* pens )
+{
+    wxGraphicsPath path = CreatePath();
+    bool pathUsed = false;
+    for ( size_t i = 0; i < count; ++i )
+    {
+        if ( pens && (i == 0 || pens[i] != pens[i - 1]) )
+        {
+            if ( pathUsed )
+            {
+                StrokePath( path );
+                path.Clear();
+                pathUsed = false;
+            }
+            SetPen( pens[i] );
+        }
+
+        const size_t size = sizes[i];
+        if ( size > 1 )
+        {
+            path.MoveToPoint(coords[0], coords[1]);
+            for ( size_t j = 1; j < size; ++j )
+                path.AddLineToPoint( coords[2*j], coords[2*j + 1] );
+            pathUsed = true;
+        }
+        coords += 2*size;
+    }
+
+    if ( pathUsed )
+        StrokePath( path );
+}
+
 // create a 'native' matrix corresponding to these values
 wxGraphicsMatrix wxGraphicsContext::CreateMatrix( wxDouble a, wxDouble b, wxDouble c, wxDouble d,
     wxDouble tx, wxDouble ty) const
@@ -1044,6 +1140,740 @@ wxGraphicsContext* wxGraphicsContext::Create()
     return wxGraphicsRenderer::GetDefaultRenderer()->CreateMeasuringContext();
 }
 
+//-----------------------------------------------------------------------------
+// wxGraphicsCommandList and the recording context
+//-----------------------------------------------------------------------------
+
+// Base class of all the recorded commands: each command knows how to
+// re-issue itself on the replay context. The transform the context had when
+// the replay started is passed to every command as the recorded absolute
+// transforms must be reinterpreted relatively to it.
+class wxGraphicsRecordedCommand
+{
+public:
+    virtual ~wxGraphicsRecordedCommand() {}
+
+    virtual void Replay(wxGraphicsContext& gc,
+                        const wxGraphicsMatrix& initialTransform) const = 0;
+};
+
+namespace
+{
+
+class wxRecordedSetPen : public wxGraphicsRecordedCommand
+{
+public:
+    explicit wxRecordedSetPen(const wxGraphicsPen& pen) : m_pen(pen) {}
+
+    virtual void Replay(wxGraphicsContext& gc,
+                        const wxGraphicsMatrix& WXUNUSED(initialTransform)) const wxOVERRIDE
+    {
+        gc.SetPen(m_pen);
+    }
+
+private:
+    const wxGraphicsPen m_pen;
+};
+
+class wxRecordedSetBrush : public wxGraphicsRecordedCommand
+{
+public:
+    explicit wxRecordedSetBrush(const wxGraphicsBrush& brush) : m_brush(brush) {}
+
+    virtual void Replay(wxGraphicsContext& gc,
+                        const wxGraphicsMatrix& WXUNUSED(initialTransform)) const wxOVERRIDE
+    {
+        gc.SetBrush(m_brush);
+    }
+
+private:
+    const wxGraphicsBrush m_brush;
+};
+
+class wxRecordedSetFont : public wxGraphicsRecordedCommand
+{
+public:
+    explicit wxRecordedSetFont(const wxGraphicsFont& font) : m_font(font) {}
+
+    virtual void Replay(wxGraphicsContext& gc,
+                        const wxGraphicsMatrix& WXUNUSED(initialTransform)) const wxOVERRIDE
+    {
+        gc.SetFont(m_font);
+    }
+
+private:
+    const wxGraphicsFont m_font;
+};
+
+class wxRecordedStrokePath : public wxGraphicsRecordedCommand
+{
+public:
+    explicit wxRecordedStrokePath(const wxGraphicsPath& path) : m_path(path) {}
+
+    virtual void Replay(wxGraphicsContext& gc,
+                        const wxGraphicsMatrix& WXUNUSED(initialTransform)) const wxOVERRIDE
+    {
+        gc.StrokePath(m_path);
+    }
+
+private:
+    const wxGraphicsPath m_path;
+};
+
+class wxRecordedFillPath : public wxGraphicsRecordedCommand
+{
+public:
+    wxRecordedFillPath(const wxGraphicsPath& path, wxPolygonFillMode fillStyle)
+        : m_path(path), m_fillStyle(fillStyle) {}
+
+    virtual void Replay(wxGraphicsContext& gc,
+                        const wxGraphicsMatrix& WXUNUSED(initialTransform)) const wxOVERRIDE
+    {
+        gc.FillPath(m_path, m_fillStyle);
+    }
+
+private:
+    const wxGraphicsPath m_path;
+    const wxPolygonFillMode m_fillStyle;
+};
+
+class wxRecordedClearRectangle : public wxGraphicsRecordedCommand
+{
+public:
+    wxRecordedClearRectangle(wxDouble x, wxDouble y, wxDouble w, wxDouble h)
+        : m_x(x), m_y(y), m_w(w), m_h(h) {}
+
+    virtual void Replay(wxGraphicsContext& gc,
+                        const wxGraphicsMatrix& WXUNUSED(initialTransform)) const wxOVERRIDE
+    {
+        gc.ClearRectangle(m_x, m_y, m_w, m_h);
+    }
+
+private:
+    const wxDouble m_x, m_y, m_w, m_h;
+};
+
+class wxRecordedDrawText : public wxGraphicsRecordedCommand
+{
+public:
+    wxRecordedDrawText(const wxString& str, wxDouble x, wxDouble y)
+        : m_str(str), m_x(x), m_y(y) {}
+
+    virtual void Replay(wxGraphicsContext& gc,
+                        const wxGraphicsMatrix& WXUNUSED(initialTransform)) const wxOVERRIDE
+    {
+        gc.DrawText(m_str, m_x, m_y);
+    }
+
+private:
+    const wxString m_str;
+    const wxDouble m_x, m_y;
+};
+
+class wxRecordedDrawBitmap : public wxGraphicsRecordedCommand
+{
+public:
+    wxRecordedDrawBitmap(const wxGraphicsBitmap& bmp,
+                         wxDouble x, wxDouble y, wxDouble w, wxDouble h)
+        : m_bmp(bmp), m_x(x), m_y(y), m_w(w), m_h(h) {}
+
+    virtual void Replay(wxGraphicsContext& gc,
+                        const wxGraphicsMatrix& WXUNUSED(initialTransform)) const wxOVERRIDE
+    {
+        gc.DrawBitmap(m_bmp, m_x, m_y, m_w, m_h);
+    }
+
+private:
+    const wxGraphicsBitmap m_bmp;
+    const wxDouble m_x, m_y, m_w, m_h;
+};
+
+class wxRecordedDrawIcon : public wxGraphicsRecordedCommand
+{
+public:
+    wxRecordedDrawIcon(const wxIcon& icon,
+                       wxDouble x, wxDouble y, wxDouble w, wxDouble h)
+        : m_icon(icon), m_x(x), m_y(y), m_w(w), m_h(h) {}
+
+    virtual void Replay(wxGraphicsContext& gc,
+                        const wxGraphicsMatrix& WXUNUSED(initialTransform)) const wxOVERRIDE
+    {
+        gc.DrawIcon(m_icon, m_x, m_y, m_w, m_h);
+    }
+
+private:
+    const wxIcon m_icon;
+    const wxDouble m_x, m_y, m_w, m_h;
+};
+
+class wxRecordedClipRect : public wxGraphicsRecordedCommand
+{
+public:
+    wxRecordedClipRect(wxDouble x, wxDouble y, wxDouble w, wxDouble h)
+        : m_x(x), m_y(y), m_w(w), m_h(h) {}
+
+    virtual void Replay(wxGraphicsContext& gc,
+                        const wxGraphicsMatrix& WXUNUSED(initialTransform)) const wxOVERRIDE
+    {
+        gc.Clip(m_x, m_y, m_w, m_h);
+    }
+
+private:
+    const wxDouble m_x, m_y, m_w, m_h;
+};
+
+class wxRecordedClipRegion : public wxGraphicsRecordedCommand
+{
+public:
+    explicit wxRecordedClipRegion(const wxRegion& region) : m_region(region) {}
+
+    virtual void Replay(wxGraphicsContext& gc,
+                        const wxGraphicsMatrix& WXUNUSED(initialTransform)) const wxOVERRIDE
+    {
+        gc.Clip(m_region);
+    }
+
+private:
+    const wxRegion m_region;
+};
+
+class wxRecordedResetClip : public wxGraphicsRecordedCommand
+{
+public:
+    virtual void Replay(wxGraphicsContext& gc,
+                        const wxGraphicsMatrix& WXUNUSED(initialTransform)) const wxOVERRIDE
+    {
+        gc.ResetClip();
+    }
+};
+
+class wxRecordedTranslate : public wxGraphicsRecordedCommand
+{
+public:
+    wxRecordedTranslate(wxDouble dx, wxDouble dy) : m_dx(dx), m_dy(dy) {}
+
+    virtual void Replay(wxGraphicsContext& gc,
+                        const wxGraphicsMatrix& WXUNUSED(initialTransform)) const wxOVERRIDE
+    {
+        gc.Translate(m_dx, m_dy);
+    }
+
+private:
+    const wxDouble m_dx, m_dy;
+};
+
+class wxRecordedScale : public wxGraphicsRecordedCommand
+{
+public:
+    wxRecordedScale(wxDouble xScale, wxDouble yScale)
+        : m_xScale(xScale), m_yScale(yScale) {}
+
+    virtual void Replay(wxGraphicsContext& gc,
+                        const wxGraphicsMatrix& WXUNUSED(initialTransform)) const wxOVERRIDE
+    {
+        gc.Scale(m_xScale, m_yScale);
+    }
+
+private:
+    const wxDouble m_xScale, m_yScale;
+};
+
+class wxRecordedRotate : public wxGraphicsRecordedCommand
+{
+public:
+    explicit wxRecordedRotate(wxDouble angle) : m_angle(angle) {}
+
+    virtual void Replay(wxGraphicsContext& gc,
+                        const wxGraphicsMatrix& WXUNUSED(initialTransform)) const wxOVERRIDE
+    {
+        gc.Rotate(m_angle);
+    }
+
+private:
+    const wxDouble m_angle;
+};
+
+class wxRecordedConcatTransform : public wxGraphicsRecordedCommand
+{
+public:
+    explicit wxRecordedConcatTransform(const wxGraphicsMatrix& matrix)
+        : m_matrix(matrix) {}
+
+    virtual void Replay(wxGraphicsContext& gc,
+                        const wxGraphicsMatrix& WXUNUSED(initialTransform)) const wxOVERRIDE
+    {
+        gc.ConcatTransform(m_matrix);
+    }
+
+private:
+    const wxGraphicsMatrix m_matrix;
+};
+
+class wxRecordedSetTransform : public wxGraphicsRecordedCommand
+{
+public:
+    explicit wxRecordedSetTransform(const wxGraphicsMatrix& matrix)
+        : m_matrix(matrix) {}
+
+    virtual void Replay(wxGraphicsContext& gc,
+                        const wxGraphicsMatrix& initialTransform) const wxOVERRIDE
+    {
+        // The recorded transform was relative to the initial state of the
+        // recording context, so reinterpret it relatively to the transform
+        // the replay started with instead of just overwriting it.
+        wxGraphicsMatrix m = initialTransform;
+        m.Concat(m_matrix);
+        gc.SetTransform(m);
+    }
+
+private:
+    const wxGraphicsMatrix m_matrix;
+};
+
+class wxRecordedPushState : public wxGraphicsRecordedCommand
+{
+public:
+    virtual void Replay(wxGraphicsContext& gc,
+                        const wxGraphicsMatrix& WXUNUSED(initialTransform)) const wxOVERRIDE
+    {
+        gc.PushState();
+    }
+};
+
+class wxRecordedPopState : public wxGraphicsRecordedCommand
+{
+public:
+    virtual void Replay(wxGraphicsContext& gc,
+                        const wxGraphicsMatrix& WXUNUSED(initialTransform)) const wxOVERRIDE
+    {
+        gc.PopState();
+    }
+};
+
+class wxRecordedBeginLayer : public wxGraphicsRecordedCommand
+{
+public:
+    explicit wxRecordedBeginLayer(wxDouble opacity) : m_opacity(opacity) {}
+
+    virtual void Replay(wxGraphicsContext& gc,
+                        const wxGraphicsMatrix& WXUNUSED(initialTransform)) const wxOVERRIDE
+    {
+        gc.BeginLayer(m_opacity);
+    }
+
+private:
+    const wxDouble m_opacity;
+};
+
+class wxRecordedEndLayer : public wxGraphicsRecordedCommand
+{
+public:
+    virtual void Replay(wxGraphicsContext& gc,
+                        const wxGraphicsMatrix& WXUNUSED(initialTransform)) const wxOVERRIDE
+    {
+        gc.EndLayer();
+    }
+};
+
+class wxRecordedSetAntialiasMode : public wxGraphicsRecordedCommand
+{
+public:
+    explicit wxRecordedSetAntialiasMode(wxAntialiasMode antialias)
+        : m_antialias(antialias) {}
+
+    virtual void Replay(wxGraphicsContext& gc,
+                        const wxGraphicsMatrix& WXUNUSED(initialTransform)) const wxOVERRIDE
+    {
+        gc.SetAntialiasMode(m_antialias);
+    }
+
+private:
+    const wxAntialiasMode m_antialias;
+};
+
+class wxRecordedSetInterpolationQuality : public wxGraphicsRecordedCommand
+{
+public:
+    explicit wxRecordedSetInterpolationQuality(wxInterpolationQuality interpolation)
+        : m_interpolation(interpolation) {}
+
+    virtual void Replay(wxGraphicsContext& gc,
+                        const wxGraphicsMatrix& WXUNUSED(initialTransform)) const wxOVERRIDE
+    {
+        gc.SetInterpolationQuality(m_interpolation);
+    }
+
+private:
+    const wxInterpolationQuality m_interpolation;
+};
+
+class wxRecordedSetCompositionMode : public wxGraphicsRecordedCommand
+{
+public:
+    explicit wxRecordedSetCompositionMode(wxCompositionMode composition)
+        : m_composition(composition) {}
+
+    virtual void Replay(wxGraphicsContext& gc,
+                        const wxGraphicsMatrix& WXUNUSED(initialTransform)) const wxOVERRIDE
+    {
+        gc.SetCompositionMode(m_composition);
+    }
+
+private:
+    const wxCompositionMode m_composition;
+};
+
+} // anonymous namespace
+
+// The recording context stores all the drawing commands issued on it in a
+// wxGraphicsCommandList instead of executing them. It still keeps track of
+// the transform, so that GetTransform() works, and uses a measuring context
+// of the same renderer for the text measurement requests.
+class wxGraphicsRecordingContext : public wxGraphicsContext
+{
+public:
+    wxGraphicsRecordingContext(wxGraphicsRenderer* renderer,
+                               wxGraphicsCommandList& commands)
+        : wxGraphicsContext(renderer),
+          m_commands(commands)
+    {
+        m_width =
+        m_height = 0;
+
+        m_transform = renderer->CreateMatrix();
+        m_measuringGC = renderer->CreateMeasuringContext();
+
+        commands.m_renderer = renderer;
+    }
+
+    virtual ~wxGraphicsRecordingContext()
+    {
+        delete m_measuringGC;
+    }
+
+    virtual void PushState() wxOVERRIDE
+    {
+        m_transformStack.push_back(m_transform);
+        Record(new wxRecordedPushState);
+    }
+
+    virtual void PopState() wxOVERRIDE
+    {
+        wxCHECK_RET( !m_transformStack.empty(),
+                     wxS("PushState()/PopState() calls not balanced") );
+
+        m_transform = m_transformStack.back();
+        m_transformStack.pop_back();
+        Record(new wxRecordedPopState);
+    }
+
+    virtual void Clip(const wxRegion& region) wxOVERRIDE
+    {
+        Record(new wxRecordedClipRegion(region));
+    }
+
+    virtual void Clip(wxDouble x, wxDouble y, wxDouble w, wxDouble h) wxOVERRIDE
+    {
+        Record(new wxRecordedClipRect(x, y, w, h));
+    }
+
+    virtual void ResetClip() wxOVERRIDE
+    {
+        Record(new wxRecordedResetClip);
+    }
+
+    virtual void GetClipBox(wxDouble* x, wxDouble* y,
+                            wxDouble* w, wxDouble* h) wxOVERRIDE
+    {
+        // The effective clip box can only be known when replaying.
+        wxFAIL_MSG( wxS("Clip box not available on a recording context") );
+
+        if ( x )
+            *x = 0;
+        if ( y )
+            *y = 0;
+        if ( w )
+            *w = 0;
+        if ( h )
+            *h = 0;
+    }
+
+    virtual void* GetNativeContext() wxOVERRIDE
+    {
+        return NULL;
+    }
+
+    virtual bool SetAntialiasMode(wxAntialiasMode antialias) wxOVERRIDE
+    {
+        if ( m_antialias != antialias )
+        {
+            m_antialias = antialias;
+            Record(new wxRecordedSetAntialiasMode(antialias));
+        }
+
+        return true;
+    }
+
+    virtual bool SetInterpolationQuality(wxInterpolationQuality interpolation) wxOVERRIDE
+    {
+        if ( m_interpolation != interpolation )
+        {
+            m_interpolation = interpolation;
+            Record(new wxRecordedSetInterpolationQuality(interpolation));
+        }
+
+        return true;
+    }
+
+    virtual bool SetCompositionMode(wxCompositionMode op) wxOVERRIDE
+    {
+        if ( m_composition != op )
+        {
+            m_composition = op;
+            Record(new wxRecordedSetCompositionMode(op));
+        }
+
+        return true;
+    }
+
+    virtual void BeginLayer(wxDouble opacity) wxOVERRIDE
+    {
+        Record(new wxRecordedBeginLayer(opacity));
+    }
+
+    virtual void EndLayer() wxOVERRIDE
+    {
+        Record(new wxRecordedEndLayer);
+    }
+
+    virtual void Translate(wxDouble dx, wxDouble dy) wxOVERRIDE
+    {
+        m_transform.Translate(dx, dy);
+        Record(new wxRecordedTranslate(dx, dy));
+    }
+
+    virtual void Scale(wxDouble xScale, wxDouble yScale) wxOVERRIDE
+    {
+        m_transform.Scale(xScale, yScale);
+        Record(new wxRecordedScale(xScale, yScale));
+    }
+
+    virtual void Rotate(wxDouble angle) wxOVERRIDE
+    {
+        m_transform.Rotate(angle);
+        Record(new wxRecordedRotate(angle));
+    }
+
+    virtual void ConcatTransform(const wxGraphicsMatrix& matrix) wxOVERRIDE
+    {
+        m_transform.Concat(matrix);
+        Record(new wxRecordedConcatTransform(matrix));
+    }
+
+    virtual void SetTransform(const wxGraphicsMatrix& matrix) wxOVERRIDE
+    {
+        m_transform = matrix;
+        Record(new wxRecordedSetTransform(matrix));
+    }
+
+    virtual wxGraphicsMatrix GetTransform() const wxOVERRIDE
+    {
+        return m_transform;
+    }
+
+    virtual void SetPen(const wxGraphicsPen& pen) wxOVERRIDE
+    {
+        wxGraphicsContext::SetPen(pen);
+        Record(new wxRecordedSetPen(pen));
+    }
+
+    virtual void SetBrush(const wxGraphicsBrush& brush) wxOVERRIDE
+    {
+        wxGraphicsContext::SetBrush(brush);
+        Record(new wxRecordedSetBrush(brush));
+    }
+
+    virtual void SetFont(const wxGraphicsFont& font) wxOVERRIDE
+    {
+        wxGraphicsContext::SetFont(font);
+
+        if ( m_measuringGC )
+            m_measuringGC->SetFont(font);
+
+        Record(new wxRecordedSetFont(font));
+    }
+
+    virtual void StrokePath(const wxGraphicsPath& path) wxOVERRIDE
+    {
+        Record(new wxRecordedStrokePath(path));
+    }
+
+    virtual void FillPath(const wxGraphicsPath& path,
+                          wxPolygonFillMode fillStyle = wxODDEVEN_RULE) wxOVERRIDE
+    {
+        Record(new wxRecordedFillPath(path, fillStyle));
+    }
+
+    virtual void ClearRectangle(wxDouble x, wxDouble y,
+                                wxDouble w, wxDouble h) wxOVERRIDE
+    {
+        Record(new wxRecordedClearRectangle(x, y, w, h));
+    }
+
+    virtual void GetTextExtent(const wxString& text,
+                               wxDouble* width, wxDouble* height,
+                               wxDouble* descent = NULL,
+                               wxDouble* externalLeading = NULL) const wxOVERRIDE
+    {
+        if ( m_measuringGC )
+        {
+            m_measuringGC->GetTextExtent(text, width, height,
+                                         descent, externalLeading);
+            return;
+        }
+
+        if ( width )
+            *width = 0;
+        if ( height )
+            *height = 0;
+        if ( descent )
+            *descent = 0;
+        if ( externalLeading )
+            *externalLeading = 0;
+    }
+
+    virtual void GetPartialTextExtents(const wxString& text,
+                                       wxArrayDouble& widths) const wxOVERRIDE
+    {
+        if ( m_measuringGC )
+            m_measuringGC->GetPartialTextExtents(text, widths);
+        else
+            widths.Clear();
+    }
+
+    virtual void DrawBitmap(const wxGraphicsBitmap& bmp,
+                            wxDouble x, wxDouble y,
+                            wxDouble w, wxDouble h) wxOVERRIDE
+    {
+        Record(new wxRecordedDrawBitmap(bmp, x, y, w, h));
+    }
+
+    virtual void DrawBitmap(const wxBitmap& bmp,
+                            wxDouble x, wxDouble y,
+                            wxDouble w, wxDouble h) wxOVERRIDE
+    {
+        // Convert to a renderer-specific bitmap once at recording time, the
+        // replays will be able to reuse it directly.
+        DrawBitmap(CreateBitmap(bmp), x, y, w, h);
+    }
+
+    virtual void DrawIcon(const wxIcon& icon,
+                          wxDouble x, wxDouble y,
+                          wxDouble w, wxDouble h) wxOVERRIDE
+    {
+        Record(new wxRecordedDrawIcon(icon, x, y, w, h));
+    }
+
+#ifdef __WXMSW__
+    virtual WXHDC GetNativeHDC() wxOVERRIDE { return NULL; }
+    virtual void ReleaseNativeHDC(WXHDC WXUNUSED(hdc)) wxOVERRIDE { }
+#endif // __WXMSW__
+
+protected:
+    virtual void DoDrawText(const wxString& str, wxDouble x, wxDouble y) wxOVERRIDE
+    {
+        Record(new wxRecordedDrawText(str, x, y));
+    }
+
+private:
+    void Record(wxGraphicsRecordedCommand* command)
+    {
+        m_commands.Append(command);
+    }
+
+    wxGraphicsCommandList& m_commands;
+
+    // The current transform and the transforms saved by PushState().
+    wxGraphicsMatrix m_transform;
+    wxVector<wxGraphicsMatrix> m_transformStack;
+
+    // Used for implementing the text measurement functions, may be NULL.
+    wxGraphicsContext* m_measuringGC;
+
+    wxDECLARE_NO_COPY_CLASS(wxGraphicsRecordingContext);
+};
+
+wxGraphicsCommandList::wxGraphicsCommandList()
+{
+    m_renderer = NULL;
+}
+
+wxGraphicsCommandList::~wxGraphicsCommandList()
+{
+    Clear();
+}
+
+void wxGraphicsCommandList::Clear()
+{
+    for ( size_t n = 0; n < m_commands.size(); n++ )
+        delete m_commands[n];
+    m_commands.clear();
+
+    m_renderer = NULL;
+}
+
+void wxGraphicsCommandList::Append(wxGraphicsRecordedCommand* command)
+{
+    m_commands.push_back(command);
+}
+
+void wxGraphicsCommandList::Replay(wxGraphicsContext* gc) const
+{
+    wxCHECK_RET( gc, wxS("NULL graphics context") );
+
+    Replay(gc, gc->CreateMatrix());
+}
+
+void
+wxGraphicsCommandList::Replay(wxGraphicsContext* gc,
+                              const wxGraphicsMatrix& transform) const
+{
+    wxCHECK_RET( gc, wxS("NULL graphics context") );
+
+    if ( m_commands.empty() )
+        return;
+
+    wxCHECK_RET( !m_renderer || gc->GetRenderer() == m_renderer,
+                 wxS("must replay on a context using the same renderer") );
+
+    // Save the clip and transform of the context, but notice that its pen,
+    // brush and font are intentionally not preserved: replaying changes them
+    // just as issuing the recorded calls directly would have done.
+    gc->PushState();
+
+    gc->ConcatTransform(transform);
+
+    const wxGraphicsMatrix initialTransform = gc->GetTransform();
+
+    for ( size_t n = 0; n < m_commands.size(); n++ )
+        m_commands[n]->Replay(*gc, initialTransform);
+
+    gc->PopState();
+}
+
+/* static */
+wxGraphicsContext*
+wxGraphicsContext::CreateRecording(wxGraphicsCommandList& commands,
+                                   wxGraphicsRenderer* renderer)
+{
+    if ( !renderer )
+        renderer = wxGraphicsRenderer::GetDefaultRenderer();
+
+    wxCHECK_MSG( renderer, NULL, wxS("no graphics renderer available") );
+
+    return new wxGraphicsRecordingContext(renderer, commands);
+}
+
 //-----------------------------------------------------------------------------
 // wxGraphicsRenderer
 //-----------------------------------------------------------------------------
@@ -1073,4 +1903,203 @@ wxGraphicsContext* wxGraphicsRenderer::CreateContextFromUnknownDC(const wxDC& dc
     return NULL;
 }
 
+/* static */
+wxVector<wxGraphicsRenderer*> wxGraphicsRenderer::GetAllRenderers()
+{
+    wxVector<wxGraphicsRenderer*> renderers;
+
+    wxGraphicsRenderer* const def = GetDefaultRenderer();
+    if ( def )
+        renderers.push_back(def);
+
+#ifdef __WXMSW__
+#if wxUSE_GRAPHICS_GDIPLUS
+    wxGraphicsRenderer* const gdiplus = GetGDIPlusRenderer();
+    if ( gdiplus && gdiplus != def )
+        renderers.push_back(gdiplus);
+#endif
+
+#if wxUSE_GRAPHICS_DIRECT2D
+    // May be unavailable at run-time even when compiled in.
+    wxGraphicsRenderer* const d2d = GetDirect2DRenderer();
+    if ( d2d && d2d != def )
+        renderers.push_back(d2d);
+#endif
+#endif // __WXMSW__
+
+    wxGraphicsRenderer* const cairo = GetCairoRenderer();
+    if ( cairo && cairo != def )
+        renderers.push_back(cairo);
+
+    return renderers;
+}
+
+#if wxUSE_IMAGE
+
+namespace
+{
+
+// The fastest renderer for each operation class as measured by the last call
+// to wxGraphicsRenderer::BenchmarkAll().
+wxGraphicsRenderer* gs_fastestRenderer[wxGRAPHICS_BENCHMARK_OP_COUNT] = { NULL };
+
+// Minimal linear congruential generator: the benchmark must draw exactly the
+// same scene with every renderer, so don't use rand() whose state could
+// differ between the runs.
+inline unsigned BenchmarkRand(unsigned& seed)
+{
+    seed = seed*1664525 + 1013904223;
+    return seed >> 16;
+}
+
+} // anonymous namespace
+
+wxGraphicsBenchmarkResult wxGraphicsRenderer::Benchmark(int width, int height)
+{
+    wxGraphicsBenchmarkResult result;
+
+    wxImage image(width, height);
+    wxScopedPtr<wxGraphicsContext> gc(CreateContextFromImage(image));
+    if ( !gc )
+        return result;
+
+    gc->SetPen(wxPen(*wxBLUE));
+    gc->SetBrush(wxBrush(*wxGREEN));
+    gc->SetFont(*wxNORMAL_FONT, *wxBLACK);
+
+    const wxBitmap bmp(wxImage(32, 32));
+
+    // Enough operations for meaningful timings without making the total run
+    // time annoying when benchmarking several renderers at startup.
+    static const int NUM_OPS = 1000;
+
+    unsigned seed = 0x12345678;
+    int n;
+    wxStopWatch sw;
+
+    // Anti-aliased lines are the most backend-sensitive operation.
+    for ( n = 0; n < NUM_OPS; n++ )
+    {
+        gc->StrokeLine(BenchmarkRand(seed) % width,
+                       BenchmarkRand(seed) % height,
+                       BenchmarkRand(seed) % width,
+                       BenchmarkRand(seed) % height);
+    }
+    gc->Flush();
+    result.ms[wxGRAPHICS_BENCHMARK_LINES] = sw.TimeInMicro().ToDouble() / 1000.0;
+
+    sw.Start();
+    for ( n = 0; n < NUM_OPS; n++ )
+    {
+        gc->DrawRectangle(BenchmarkRand(seed) % width,
+                          BenchmarkRand(seed) % height,
+                          1 + BenchmarkRand(seed) % 64,
+                          1 + BenchmarkRand(seed) % 64);
+    }
+    gc->Flush();
+    result.ms[wxGRAPHICS_BENCHMARK_RECTANGLES] = sw.TimeInMicro().ToDouble() / 1000.0;
+
+    sw.Start();
+    for ( n = 0; n < NUM_OPS; n++ )
+    {
+        gc->DrawEllipse(BenchmarkRand(seed) % width,
+                        BenchmarkRand(seed) % height,
+                        1 + BenchmarkRand(seed) % 64,
+                        1 + BenchmarkRand(seed) % 64);
+    }
+    gc->Flush();
+    result.ms[wxGRAPHICS_BENCHMARK_ELLIPSES] = sw.TimeInMicro().ToDouble() / 1000.0;
+
+    sw.Start();
+    for ( n = 0; n < NUM_OPS; n++ )
+    {
+        wxGraphicsPath path = gc->CreatePath();
+        path.MoveToPoint(BenchmarkRand(seed) % width,
+                         BenchmarkRand(seed) % height);
+        path.AddCurveToPoint(BenchmarkRand(seed) % width,
+                             BenchmarkRand(seed) % height,
+                             BenchmarkRand(seed) % width,
+                             BenchmarkRand(seed) % height,
+                             BenchmarkRand(seed) % width,
+                             BenchmarkRand(seed) % height);
+        gc->StrokePath(path);
+    }
+    gc->Flush();
+    result.ms[wxGRAPHICS_BENCHMARK_CURVES] = sw.TimeInMicro().ToDouble() / 1000.0;
+
+    sw.Start();
+    for ( n = 0; n < NUM_OPS; n++ )
+    {
+        gc->DrawBitmap(bmp,
+                       BenchmarkRand(seed) % width,
+                       BenchmarkRand(seed) % height,
+                       32, 32);
+    }
+    gc->Flush();
+    result.ms[wxGRAPHICS_BENCHMARK_BITMAPS] = sw.TimeInMicro().ToDouble() / 1000.0;
+
+    sw.Start();
+    for ( n = 0; n < NUM_OPS; n++ )
+    {
+        gc->DrawText(wxS("Benchmark"),
+                     BenchmarkRand(seed) % width,
+                     BenchmarkRand(seed) % height);
+    }
+    gc->Flush();
+    result.ms[wxGRAPHICS_BENCHMARK_TEXT] = sw.TimeInMicro().ToDouble() / 1000.0;
+
+    return result;
+}
+
+/* static */
+wxGraphicsRenderer*
+wxGraphicsRenderer::BenchmarkAll(wxVector<wxGraphicsBenchmarkResult>* results)
+{
+    if ( results )
+        results->clear();
+
+    const wxVector<wxGraphicsRenderer*> renderers = GetAllRenderers();
+
+    wxGraphicsRenderer* best = NULL;
+    double bestTotal = 0.0;
+    double bestOp[wxGRAPHICS_BENCHMARK_OP_COUNT];
+
+    for ( size_t n = 0; n < renderers.size(); n++ )
+    {
+        const wxGraphicsBenchmarkResult result = renderers[n]->Benchmark();
+        if ( results )
+            results->push_back(result);
+
+        for ( int op = 0; op < wxGRAPHICS_BENCHMARK_OP_COUNT; op++ )
+        {
+            if ( n == 0 || result.ms[op] < bestOp[op] )
+            {
+                bestOp[op] = result.ms[op];
+                gs_fastestRenderer[op] = renderers[n];
+            }
+        }
+
+        const double total = result.Total();
+        if ( !best || total < bestTotal )
+        {
+            best = renderers[n];
+            bestTotal = total;
+        }
+    }
+
+    return best;
+}
+
+/* static */
+wxGraphicsRenderer* wxGraphicsRenderer::GetFastestRenderer(wxGraphicsBenchmarkOp op)
+{
+    wxCHECK_MSG( op >= 0 && op < wxGRAPHICS_BENCHMARK_OP_COUNT, NULL,
+                 wxS("invalid graphics benchmark operation") );
+
+    return gs_fastestRenderer[op] ? gs_fastestRenderer[op]
+                                  : GetDefaultRenderer();
+}
+
+#endif // wxUSE_IMAGE
+
 #endif // wxUSE_GRAPHICS_CONTEXT
@@ -21,39 +21,94 @@
 // the library. This function should be in a separate file as some compilers
 // link against the whole object file as long as just one of is function is called!
 
+// the handlers are registered lazily, i.e. only created when first used, so
+// we need a factory function for each of them
+#if wxUSE_LIBPNG
+static wxImageHandler *wxCreatePNGHandler() { return new wxPNGHandler; }
+#endif
+#if wxUSE_LIBJPEG
+static wxImageHandler *wxCreateJPEGHandler() { return new wxJPEGHandler; }
+#endif
+#if wxUSE_LIBTIFF
+static wxImageHandler *wxCreateTIFFHandler() { return new wxTIFFHandler; }
+#endif
+#if wxUSE_GIF
+static wxImageHandler *wxCreateGIFHandler() { return new wxGIFHandler; }
+#endif
+#if wxUSE_PNM
+static wxImageHandler *wxCreatePNMHandler() { return new wxPNMHandler; }
+#endif
+#if wxUSE_PCX
+static wxImageHandler *wxCreatePCXHandler() { return new wxPCXHandler; }
+#endif
+#if wxUSE_IFF
+static wxImageHandler *wxCreateIFFHandler() { return new wxIFFHandler; }
+#endif
+#if wxUSE_ICO_CUR
+static wxImageHandler *wxCreateICOHandler() { return new wxICOHandler; }
+static wxImageHandler *wxCreateCURHandler() { return new wxCURHandler; }
+static wxImageHandler *wxCreateANIHandler() { return new wxANIHandler; }
+#endif
+#if wxUSE_TGA
+static wxImageHandler *wxCreateTGAHandler() { return new wxTGAHandler; }
+#endif
+#if wxUSE_XPM
+static wxImageHandler *wxCreateXPMHandler() { return new wxXPMHandler; }
+#endif
+
 void wxInitAllImageHandlers()
 {
+    // register all the handlers lazily, with the magic bytes identifying
+    // their formats: none of them is actually created until used, and the
+    // signatures allow loading code to create only the right one
 #if wxUSE_LIBPNG
-  wxImage::AddHandler( new wxPNGHandler );
+    wxImage::AddLazyHandler( wxCreatePNGHandler, wxBITMAP_TYPE_PNG,
+                             "\x89PNG\r\n\x1a\n", 8 );
 #endif
 #if wxUSE_LIBJPEG
-  wxImage::AddHandler( new wxJPEGHandler );
+    wxImage::AddLazyHandler( wxCreateJPEGHandler, wxBITMAP_TYPE_JPEG,
+                             "\xff\xd8", 2 );
 #endif
 #if wxUSE_LIBTIFF
-  wxImage::AddHandler( new wxTIFFHandler );
+    // TIFF has two signatures, for the little and big endian variants
+    wxImage::AddLazyHandler( wxCreateTIFFHandler, wxBITMAP_TYPE_TIFF,
+                             "II\x2a\x00", 4 );
+    wxImage::AddLazyHandler( wxCreateTIFFHandler, wxBITMAP_TYPE_TIFF,
+                             "MM\x00\x2a", 4 );
 #endif
 #if wxUSE_GIF
-  wxImage::AddHandler( new wxGIFHandler );
+    wxImage::AddLazyHandler( wxCreateGIFHandler, wxBITMAP_TYPE_GIF,
+                             "GIF8", 4 );
 #endif
 #if wxUSE_PNM
-  wxImage::AddHandler( new wxPNMHandler );
+    // just "P", the following format character is checked by the handler
+    wxImage::AddLazyHandler( wxCreatePNMHandler, wxBITMAP_TYPE_PNM,
+                             "P", 1 );
 #endif
 #if wxUSE_PCX
-  wxImage::AddHandler( new wxPCXHandler );
+    // only the manufacturer byte, so the handler must confirm the match
+    wxImage::AddLazyHandler( wxCreatePCXHandler, wxBITMAP_TYPE_PCX,
+                             "\x0a", 1 );
 #endif
 #if wxUSE_IFF
-  wxImage::AddHandler( new wxIFFHandler );
+    wxImage::AddLazyHandler( wxCreateIFFHandler, wxBITMAP_TYPE_IFF,
+                             "FORM", 4 );
 #endif
 #if wxUSE_ICO_CUR
-  wxImage::AddHandler( new wxICOHandler );
-  wxImage::AddHandler( new wxCURHandler );
-  wxImage::AddHandler( new wxANIHandler );
+    wxImage::AddLazyHandler( wxCreateICOHandler, wxBITMAP_TYPE_ICO,
+                             "\x00\x00\x01\x00", 4 );
+    wxImage::AddLazyHandler( wxCreateCURHandler, wxBITMAP_TYPE_CUR,
+                             "\x00\x00\x02\x00", 4 );
+    wxImage::AddLazyHandler( wxCreateANIHandler, wxBITMAP_TYPE_ANI,
+                             "RIFF", 4 );
 #endif
 #if wxUSE_TGA
-  wxImage::AddHandler( new wxTGAHandler );
+    // TGA files have no signature at all
+    wxImage::AddLazyHandler( wxCreateTGAHandler, wxBITMAP_TYPE_TGA );
 #endif
 #if wxUSE_XPM
-  wxImage::AddHandler( new wxXPMHandler );
+    wxImage::AddLazyHandler( wxCreateXPMHandler, wxBITMAP_TYPE_XPM,
+                             "/* XPM */", 9 );
 #endif
 }
 
@@ -16,7 +16,6 @@
 
 #ifndef WX_PRECOMP
     #include "wx/log.h"
-    #include "wx/hash.h"
     #include "wx/utils.h"
     #include "wx/math.h"
     #include "wx/module.h"
@@ -25,6 +24,9 @@
     #include "wx/colour.h"
 #endif
 
+#include "wx/alloctrack.h"
+#include "wx/thread.h"
+#include "wx/private/rowband.h"
 #include "wx/wfstream.h"
 #include "wx/xpmdecod.h"
 
@@ -84,6 +86,9 @@ public:
     // same as m_static but for m_alpha
     bool            m_staticAlpha;
 
+    // if true, m_data values are premultiplied by m_alpha
+    bool            m_alphaPremultiplied;
+
     // global and per-object flags determining LoadFile() behaviour
     int             m_loadFlags;
     static int      sm_defaultLoadFlags;
@@ -116,7 +121,8 @@ wxImageRefData::wxImageRefData()
 
     m_ok = false;
     m_static =
-    m_staticAlpha = false;
+    m_staticAlpha =
+    m_alphaPremultiplied = false;
 
     m_loadFlags = sm_defaultLoadFlags;
 }
@@ -124,9 +130,19 @@ wxImageRefData::wxImageRefData()
 wxImageRefData::~wxImageRefData()
 {
     if ( !m_static )
+    {
+        if ( m_data )
+            wxAllocationTracker::OnFree(wxALLOC_TAG_IMAGES,
+                                        m_width*(size_t)m_height*3);
         free( m_data );
+    }
     if ( !m_staticAlpha )
+    {
+        if ( m_alpha )
+            wxAllocationTracker::OnFree(wxALLOC_TAG_IMAGES,
+                                        m_width*(size_t)m_height);
         free( m_alpha );
+    }
 }
 
 
@@ -136,6 +152,19 @@ wxImageRefData::~wxImageRefData()
 
 #define M_IMGDATA static_cast<wxImageRefData*>(m_refData)
 
+// report the given RGB or alpha buffer of a width*height image to
+// wxAllocationTracker: buffers owned by the application (static_data == true)
+// are not accounted for
+static inline size_t wxImageDataSize(int width, int height)
+{
+    return size_t(width)*size_t(height)*3;
+}
+
+static inline size_t wxImageAlphaSize(int width, int height)
+{
+    return size_t(width)*size_t(height);
+}
+
 wxIMPLEMENT_DYNAMIC_CLASS(wxImage, wxObject);
 
 bool wxImage::Create(const char* const* xpmData)
@@ -165,6 +194,9 @@ bool wxImage::Create( int width, int height, bool clear )
         return false;
     }
 
+    wxAllocationTracker::OnAlloc(wxALLOC_TAG_IMAGES,
+                                 wxImageDataSize(width, height));
+
     M_IMGDATA->m_width = width;
     M_IMGDATA->m_height = height;
     M_IMGDATA->m_ok = true;
@@ -185,6 +217,13 @@ bool wxImage::Create( int width, int height, unsigned char* data, bool static_da
 
     m_refData = new wxImageRefData();
 
+    if ( !static_data )
+    {
+        // the buffer now belongs to this image, account for it
+        wxAllocationTracker::OnAlloc(wxALLOC_TAG_IMAGES,
+                                     wxImageDataSize(width, height));
+    }
+
     M_IMGDATA->m_data = data;
     M_IMGDATA->m_width = width;
     M_IMGDATA->m_height = height;
@@ -194,6 +233,39 @@ bool wxImage::Create( int width, int height, unsigned char* data, bool static_da
     return true;
 }
 
+bool wxImage::Create( int width, int height, unsigned char* data, size_t stride,
+                      bool static_data )
+{
+    wxCHECK_MSG( data, false, wxT("NULL data in wxImage::Create") );
+    wxCHECK_MSG( stride >= (size_t)width*3, false,
+                 wxT("invalid stride in wxImage::Create") );
+
+    // a packed buffer can be used (or taken over) directly
+    if ( stride == (size_t)width*3 )
+        return Create(width, height, data, static_data);
+
+    // otherwise the row padding must be stripped, so copy the rows into a
+    // packed buffer of our own
+    if ( !Create(width, height, false) )
+        return false;
+
+    const unsigned char *src = data;
+    unsigned char *dst = M_IMGDATA->m_data;
+    for ( int y = 0; y < height; y++ )
+    {
+        memcpy(dst, src, (size_t)width*3);
+        dst += (size_t)width*3;
+        src += stride;
+    }
+
+    // without static_data the caller handed the buffer over to us, so
+    // dispose of it now that its contents have been copied
+    if ( !static_data )
+        free(data);
+
+    return true;
+}
+
 bool wxImage::Create( int width, int height, unsigned char* data, unsigned char* alpha, bool static_data )
 {
     UnRef();
@@ -202,6 +274,16 @@ bool wxImage::Create( int width, int height, unsigned char* data, unsigned char*
 
     m_refData = new wxImageRefData();
 
+    if ( !static_data )
+    {
+        // the buffers now belong to this image, account for them
+        wxAllocationTracker::OnAlloc(wxALLOC_TAG_IMAGES,
+                                     wxImageDataSize(width, height));
+        if ( alpha )
+            wxAllocationTracker::OnAlloc(wxALLOC_TAG_IMAGES,
+                                         wxImageAlphaSize(width, height));
+    }
+
     M_IMGDATA->m_data = data;
     M_IMGDATA->m_alpha = alpha;
     M_IMGDATA->m_width = width;
@@ -246,10 +328,13 @@ wxObjectRefData* wxImage::CloneRefData(const wxObjectRefData* that) const
     {
         refData_new->m_alpha = (unsigned char*)malloc(size);
         memcpy(refData_new->m_alpha, refData->m_alpha, size);
+        wxAllocationTracker::OnAlloc(wxALLOC_TAG_IMAGES, size);
+        refData_new->m_alphaPremultiplied = refData->m_alphaPremultiplied;
     }
     size *= 3;
     refData_new->m_data = (unsigned char*)malloc(size);
     memcpy(refData_new->m_data, refData->m_data, size);
+    wxAllocationTracker::OnAlloc(wxALLOC_TAG_IMAGES, size);
 #if wxUSE_PALETTE
     refData_new->m_palette = refData->m_palette;
 #endif
@@ -283,6 +368,11 @@ wxImage wxImage::MakeEmptyClone(int flags) const
         image.SetAlpha();
         wxCHECK2_MSG( image.GetAlpha(), return wxImage(),
                       wxS("unable to create alpha channel") );
+
+        // the callers all fill the clone by copying or interpolating the
+        // original pixel values, which preserves premultipliedness
+        if ( M_IMGDATA->m_alphaPremultiplied )
+            image.SetPremultipliedAlpha();
     }
 
     if ( M_IMGDATA->m_hasMask )
@@ -496,6 +586,10 @@ wxImage::Scale( int width, int height, wxImageResizeQuality quality ) const
         image.SetOption(wxIMAGE_OPTION_CUR_HOTSPOT_Y,
                 (GetOptionInt(wxIMAGE_OPTION_CUR_HOTSPOT_Y)*height)/old_height);
 
+    // interpolating premultiplied values yields premultiplied values again
+    if ( HasPremultipliedAlpha() && image.HasAlpha() )
+        image.SetPremultipliedAlpha();
+
     return image;
 }
 
@@ -623,47 +717,77 @@ void ResampleBoxPrecalc(wxVector<BoxPrecalc>& boxes, int oldDim)
 
 } // anonymous namespace
 
-wxImage wxImage::ResampleBox(int width, int height) const
+// ----------------------------------------------------------------------------
+// row-band parallelization of the resampling loops
+// ----------------------------------------------------------------------------
+
+namespace
 {
-    // This function implements a simple pre-blur/box averaging method for
-    // downsampling that gives reasonably smooth results To scale the image
-    // down we will need to gather a grid of pixels of the size of the scale
-    // factor in each direction and then do an averaging of the pixels.
 
-    wxImage ret_image(width, height, false);
+int gs_resampleThreadCount = 1;
 
-    wxVector<BoxPrecalc> vPrecalcs(height);
-    wxVector<BoxPrecalc> hPrecalcs(width);
+} // anonymous namespace
 
-    ResampleBoxPrecalc(vPrecalcs, M_IMGDATA->m_height);
-    ResampleBoxPrecalc(hPrecalcs, M_IMGDATA->m_width);
+/* static */ void wxImage::SetResampleThreadCount(int count)
+{
+    gs_resampleThreadCount = count;
+}
 
+/* static */ int wxImage::GetResampleThreadCount()
+{
+    return gs_resampleThreadCount;
+}
 
-    const unsigned char* src_data = M_IMGDATA->m_data;
-    const unsigned char* src_alpha = M_IMGDATA->m_alpha;
-    unsigned char* dst_data = ret_image.GetData();
-    unsigned char* dst_alpha = NULL;
+// Run the given worker over all the rows of the destination image, splitting
+// them into bands processed concurrently if this was enabled using
+// wxImage::SetResampleThreadCount(). Each output row depends only on the
+// shared read-only source data, so the results are bit-identical to those of
+// the serial loop whatever the number of threads used.
+template <typename Params>
+static void
+wxImageRunRowBands(void (*worker)(const Params&, int, int),
+                   const Params& params,
+                   int height,
+                   int width)
+{
+    wxRunRowBands(worker, params, height, width, gs_resampleThreadCount);
+}
 
-    wxCHECK_MSG( dst_data, ret_image, wxS("unable to create image") );
+namespace
+{
 
-    if ( src_alpha )
-    {
-        ret_image.SetAlpha();
-        dst_alpha = ret_image.GetAlpha();
-    }
+struct ResampleBoxParams
+{
+    const BoxPrecalc* vPrecalcs;
+    const BoxPrecalc* hPrecalcs;
+    const unsigned char* src_data;
+    const unsigned char* src_alpha;
+    unsigned char* dst_data;
+    unsigned char* dst_alpha;
+    int width;      // destination image width
+    int srcWidth;   // source image width
+};
+
+void ResampleBoxRows(const ResampleBoxParams& p, int rowFirst, int rowLast)
+{
+    const unsigned char* const src_data = p.src_data;
+    const unsigned char* const src_alpha = p.src_alpha;
+    unsigned char* dst_data = p.dst_data + (size_t)rowFirst*p.width*3;
+    unsigned char* dst_alpha = src_alpha ? p.dst_alpha + (size_t)rowFirst*p.width
+                                         : NULL;
 
     int averaged_pixels, src_pixel_index;
     double sum_r, sum_g, sum_b, sum_a;
 
-    for ( int y = 0; y < height; y++ )         // Destination image - Y direction
+    for ( int y = rowFirst; y < rowLast; y++ )  // Destination image - Y direction
     {
         // Source pixel in the Y direction
-        const BoxPrecalc& vPrecalc = vPrecalcs[y];
+        const BoxPrecalc& vPrecalc = p.vPrecalcs[y];
 
-        for ( int x = 0; x < width; x++ )      // Destination image - X direction
+        for ( int x = 0; x < p.width; x++ )     // Destination image - X direction
         {
             // Source pixel in the X direction
-            const BoxPrecalc& hPrecalc = hPrecalcs[x];
+            const BoxPrecalc& hPrecalc = p.hPrecalcs[x];
 
             // Box of pixels to average
             averaged_pixels = 0;
@@ -674,7 +798,7 @@ wxImage wxImage::ResampleBox(int width, int height) const
                 for ( int i = hPrecalc.boxStart; i <= hPrecalc.boxEnd; ++i )
                 {
                     // Calculate the actual index in our source pixels
-                    src_pixel_index = j * M_IMGDATA->m_width + i;
+                    src_pixel_index = j * p.srcWidth + i;
 
                     if (src_alpha)
                     {
@@ -720,6 +844,45 @@ wxImage wxImage::ResampleBox(int width, int height) const
             dst_data += 3;
         }
     }
+}
+
+} // anonymous namespace
+
+wxImage wxImage::ResampleBox(int width, int height) const
+{
+    // This function implements a simple pre-blur/box averaging method for
+    // downsampling that gives reasonably smooth results To scale the image
+    // down we will need to gather a grid of pixels of the size of the scale
+    // factor in each direction and then do an averaging of the pixels.
+
+    wxImage ret_image(width, height, false);
+
+    wxVector<BoxPrecalc> vPrecalcs(height);
+    wxVector<BoxPrecalc> hPrecalcs(width);
+
+    ResampleBoxPrecalc(vPrecalcs, M_IMGDATA->m_height);
+    ResampleBoxPrecalc(hPrecalcs, M_IMGDATA->m_width);
+
+
+    ResampleBoxParams params;
+    params.vPrecalcs = &vPrecalcs[0];
+    params.hPrecalcs = &hPrecalcs[0];
+    params.src_data = M_IMGDATA->m_data;
+    params.src_alpha = M_IMGDATA->m_alpha;
+    params.dst_data = ret_image.GetData();
+    params.dst_alpha = NULL;
+    params.width = width;
+    params.srcWidth = M_IMGDATA->m_width;
+
+    wxCHECK_MSG( params.dst_data, ret_image, wxS("unable to create image") );
+
+    if ( params.src_alpha )
+    {
+        ret_image.SetAlpha();
+        params.dst_alpha = ret_image.GetAlpha();
+    }
+
+    wxImageRunRowBands(ResampleBoxRows, params, height, width);
 
     return ret_image;
 }
@@ -934,70 +1097,36 @@ void ResampleBicubicPrecalc(wxVector<BicubicPrecalc> &aWeight, int oldDim)
     }
 }
 
-} // anonymous namespace
-
-// This is the bicubic resampling algorithm
-wxImage wxImage::ResampleBicubic(int width, int height) const
+struct ResampleBicubicParams
 {
-    // This function implements a Bicubic B-Spline algorithm for resampling.
-    // This method is certainly a little slower than wxImage's default pixel
-    // replication method, however for most reasonably sized images not being
-    // upsampled too much on a fairly average CPU this difference is hardly
-    // noticeable and the results are far more pleasing to look at.
-    //
-    // This particular bicubic algorithm does pixel weighting according to a
-    // B-Spline that basically implements a Gaussian bell-like weighting
-    // kernel. Because of this method the results may appear a bit blurry when
-    // upsampling by large factors.  This is basically because a slight
-    // gaussian blur is being performed to get the smooth look of the upsampled
-    // image.
-
-    // Edge pixels: 3-4 possible solutions
-    // - (Wrap/tile) Wrap the image, take the color value from the opposite
-    // side of the image.
-    // - (Mirror)    Duplicate edge pixels, so that pixel at coordinate (2, n),
-    // where n is nonpositive, will have the value of (2, 1).
-    // - (Ignore)    Simply ignore the edge pixels and apply the kernel only to
-    // pixels which do have all neighbours.
-    // - (Clamp)     Choose the nearest pixel along the border. This takes the
-    // border pixels and extends them out to infinity.
-    //
-    // NOTE: below the y_offset and x_offset variables are being set for edge
-    // pixels using the "Mirror" method mentioned above
-
-    wxImage ret_image;
-
-    ret_image.Create(width, height, false);
-
-    const unsigned char* src_data = M_IMGDATA->m_data;
-    const unsigned char* src_alpha = M_IMGDATA->m_alpha;
-    unsigned char* dst_data = ret_image.GetData();
-    unsigned char* dst_alpha = NULL;
+    const BicubicPrecalc* vPrecalcs;
+    const BicubicPrecalc* hPrecalcs;
+    const unsigned char* src_data;
+    const unsigned char* src_alpha;
+    unsigned char* dst_data;
+    unsigned char* dst_alpha;
+    int width;      // destination image width
+    int srcWidth;   // source image width
+};
 
-    wxCHECK_MSG( dst_data, ret_image, wxS("unable to create image") );
+void ResampleBicubicRows(const ResampleBicubicParams& p,
+                         int rowFirst, int rowLast)
+{
+    const unsigned char* const src_data = p.src_data;
+    const unsigned char* const src_alpha = p.src_alpha;
+    unsigned char* dst_data = p.dst_data + (size_t)rowFirst*p.width*3;
+    unsigned char* dst_alpha = src_alpha ? p.dst_alpha + (size_t)rowFirst*p.width
+                                         : NULL;
 
-    if ( src_alpha )
-    {
-        ret_image.SetAlpha();
-        dst_alpha = ret_image.GetAlpha();
-    }
-
-    // Precalculate weights
-    wxVector<BicubicPrecalc> vPrecalcs(height);
-    wxVector<BicubicPrecalc> hPrecalcs(width);
-
-    ResampleBicubicPrecalc(vPrecalcs, M_IMGDATA->m_height);
-    ResampleBicubicPrecalc(hPrecalcs, M_IMGDATA->m_width);
-
-    for ( int dsty = 0; dsty < height; dsty++ )
+    for ( int dsty = rowFirst; dsty < rowLast; dsty++ )
     {
         // We need to calculate the source pixel to interpolate from - Y-axis
-        const BicubicPrecalc& vPrecalc = vPrecalcs[dsty];
+        const BicubicPrecalc& vPrecalc = p.vPrecalcs[dsty];
 
-        for ( int dstx = 0; dstx < width; dstx++ )
+        for ( int dstx = 0; dstx < p.width; dstx++ )
         {
             // X-axis of pixel to interpolate from
-            const BicubicPrecalc& hPrecalc = hPrecalcs[dstx];
+            const BicubicPrecalc& hPrecalc = p.hPrecalcs[dstx];
 
             // Sums for each color channel
             double sum_r = 0, sum_g = 0, sum_b = 0, sum_a = 0;
@@ -1016,7 +1145,7 @@ wxImage wxImage::ResampleBicubic(int width, int height) const
 
                     // Calculate the exact position where the source data
                     // should be pulled from based on the x_offset and y_offset
-                    int src_pixel_index = y_offset*M_IMGDATA->m_width + x_offset;
+                    int src_pixel_index = y_offset*p.srcWidth + x_offset;
 
                     // Calculate the weight for the specified pixel according
                     // to the bicubic b-spline kernel we're using for
@@ -1070,28 +1199,105 @@ wxImage wxImage::ResampleBicubic(int width, int height) const
             dst_data += 3;
         }
     }
+}
+
+} // anonymous namespace
+
+// This is the bicubic resampling algorithm
+wxImage wxImage::ResampleBicubic(int width, int height) const
+{
+    // This function implements a Bicubic B-Spline algorithm for resampling.
+    // This method is certainly a little slower than wxImage's default pixel
+    // replication method, however for most reasonably sized images not being
+    // upsampled too much on a fairly average CPU this difference is hardly
+    // noticeable and the results are far more pleasing to look at.
+    //
+    // This particular bicubic algorithm does pixel weighting according to a
+    // B-Spline that basically implements a Gaussian bell-like weighting
+    // kernel. Because of this method the results may appear a bit blurry when
+    // upsampling by large factors.  This is basically because a slight
+    // gaussian blur is being performed to get the smooth look of the upsampled
+    // image.
+
+    // Edge pixels: 3-4 possible solutions
+    // - (Wrap/tile) Wrap the image, take the color value from the opposite
+    // side of the image.
+    // - (Mirror)    Duplicate edge pixels, so that pixel at coordinate (2, n),
+    // where n is nonpositive, will have the value of (2, 1).
+    // - (Ignore)    Simply ignore the edge pixels and apply the kernel only to
+    // pixels which do have all neighbours.
+    // - (Clamp)     Choose the nearest pixel along the border. This takes the
+    // border pixels and extends them out to infinity.
+    //
+    // NOTE: below the y_offset and x_offset variables are being set for edge
+    // pixels using the "Mirror" method mentioned above
+
+    wxImage ret_image;
+
+    ret_image.Create(width, height, false);
+
+    // Precalculate weights
+    wxVector<BicubicPrecalc> vPrecalcs(height);
+    wxVector<BicubicPrecalc> hPrecalcs(width);
+
+    ResampleBicubicPrecalc(vPrecalcs, M_IMGDATA->m_height);
+    ResampleBicubicPrecalc(hPrecalcs, M_IMGDATA->m_width);
+
+    ResampleBicubicParams params;
+    params.vPrecalcs = &vPrecalcs[0];
+    params.hPrecalcs = &hPrecalcs[0];
+    params.src_data = M_IMGDATA->m_data;
+    params.src_alpha = M_IMGDATA->m_alpha;
+    params.dst_data = ret_image.GetData();
+    params.dst_alpha = NULL;
+    params.width = width;
+    params.srcWidth = M_IMGDATA->m_width;
+
+    wxCHECK_MSG( params.dst_data, ret_image, wxS("unable to create image") );
+
+    if ( params.src_alpha )
+    {
+        ret_image.SetAlpha();
+        params.dst_alpha = ret_image.GetAlpha();
+    }
+
+    wxImageRunRowBands(ResampleBicubicRows, params, height, width);
 
     return ret_image;
 }
 
-// Blur in the horizontal direction
-wxImage wxImage::BlurHorizontal(int blurRadius) const
+namespace
 {
-    wxImage ret_image(MakeEmptyClone());
 
-    wxCHECK( ret_image.IsOk(), ret_image );
+struct BlurParams
+{
+    const unsigned char* src_data;
+    const unsigned char* src_alpha;
+    unsigned char* dst_data;
+    unsigned char* dst_alpha;
+    int width;
+    int height;
+    int blurRadius;
+};
 
-    const unsigned char* src_data = M_IMGDATA->m_data;
-    unsigned char* dst_data = ret_image.GetData();
-    const unsigned char* src_alpha = M_IMGDATA->m_alpha;
-    unsigned char* dst_alpha = ret_image.GetAlpha();
+// Horizontal blurring algorithm - average all pixels in the specified blur
+// radius in the X or horizontal direction: the average is maintained as a
+// running sum which is updated in constant time when moving to the next
+// pixel, whatever the radius. Each row is independent of the others, so the
+// rows can be split into bands processed concurrently.
+void BlurHorizontalRows(const BlurParams& p, int rowFirst, int rowLast)
+{
+    const unsigned char* const src_data = p.src_data;
+    const unsigned char* const src_alpha = p.src_alpha;
+    unsigned char* const dst_data = p.dst_data;
+    unsigned char* const dst_alpha = p.dst_alpha;
+    const int width = p.width;
+    const int blurRadius = p.blurRadius;
 
     // number of pixels we average over
     const int blurArea = blurRadius*2 + 1;
 
-    // Horizontal blurring algorithm - average all pixels in the specified blur
-    // radius in the X or horizontal direction
-    for ( int y = 0; y < M_IMGDATA->m_height; y++ )
+    for ( int y = rowFirst; y < rowLast; y++ )
     {
         // Variables used in the blurring algorithm
         long sum_r = 0,
@@ -1111,9 +1317,9 @@ wxImage wxImage::BlurHorizontal(int blurRadius) const
             // grabbing GOK values from memory at negative indices of the
             // image's data or grabbing from the previous row
             if ( kernel_x < 0 )
-                pixel_idx = y * M_IMGDATA->m_width;
+                pixel_idx = y * width;
             else
-                pixel_idx = kernel_x + y * M_IMGDATA->m_width;
+                pixel_idx = kernel_x + y * width;
 
             src = src_data + pixel_idx*3;
             sum_r += src[0];
@@ -1123,23 +1329,23 @@ wxImage wxImage::BlurHorizontal(int blurRadius) const
                 sum_a += src_alpha[pixel_idx];
         }
 
-        dst = dst_data + y * M_IMGDATA->m_width*3;
+        dst = dst_data + y * width*3;
         dst[0] = (unsigned char)(sum_r / blurArea);
         dst[1] = (unsigned char)(sum_g / blurArea);
         dst[2] = (unsigned char)(sum_b / blurArea);
         if ( src_alpha )
-            dst_alpha[y * M_IMGDATA->m_width] = (unsigned char)(sum_a / blurArea);
+            dst_alpha[y * width] = (unsigned char)(sum_a / blurArea);
 
         // Now average the values of the rest of the pixels by just moving the
         // blur radius box along the row
-        for ( int x = 1; x < M_IMGDATA->m_width; x++ )
+        for ( int x = 1; x < width; x++ )
         {
             // Take care of edge pixels on the left edge by essentially
             // duplicating the edge pixel
             if ( x - blurRadius - 1 < 0 )
-                pixel_idx = y * M_IMGDATA->m_width;
+                pixel_idx = y * width;
             else
-                pixel_idx = (x - blurRadius - 1) + y * M_IMGDATA->m_width;
+                pixel_idx = (x - blurRadius - 1) + y * width;
 
             // Subtract the value of the pixel at the left side of the blur
             // radius box
@@ -1151,10 +1357,10 @@ wxImage wxImage::BlurHorizontal(int blurRadius) const
                 sum_a -= src_alpha[pixel_idx];
 
             // Take care of edge pixels on the right edge
-            if ( x + blurRadius > M_IMGDATA->m_width - 1 )
-                pixel_idx = M_IMGDATA->m_width - 1 + y * M_IMGDATA->m_width;
+            if ( x + blurRadius > width - 1 )
+                pixel_idx = width - 1 + y * width;
             else
-                pixel_idx = x + blurRadius + y * M_IMGDATA->m_width;
+                pixel_idx = x + blurRadius + y * width;
 
             // Add the value of the pixel being added to the end of our box
             src = src_data + pixel_idx*3;
@@ -1165,134 +1371,173 @@ wxImage wxImage::BlurHorizontal(int blurRadius) const
                 sum_a += src_alpha[pixel_idx];
 
             // Save off the averaged data
-            dst = dst_data + x*3 + y*M_IMGDATA->m_width*3;
+            dst = dst_data + x*3 + y*width*3;
             dst[0] = (unsigned char)(sum_r / blurArea);
             dst[1] = (unsigned char)(sum_g / blurArea);
             dst[2] = (unsigned char)(sum_b / blurArea);
             if ( src_alpha )
-                dst_alpha[x + y * M_IMGDATA->m_width] = (unsigned char)(sum_a / blurArea);
+                dst_alpha[x + y * width] = (unsigned char)(sum_a / blurArea);
         }
     }
-
-    return ret_image;
 }
 
-// Blur in the vertical direction
-wxImage wxImage::BlurVertical(int blurRadius) const
+// Vertical blurring algorithm - the same sliding window as the horizontal
+// one, but with a running sum per column, all of them advanced one row at a
+// time: this accesses the image strictly sequentially instead of striding
+// through it column by column. A band recomputes the sums for its first row
+// from scratch, so every output row only depends on the read-only source
+// data and the bands can run concurrently with bit-identical results.
+void BlurVerticalRows(const BlurParams& p, int rowFirst, int rowLast)
 {
-    wxImage ret_image(MakeEmptyClone());
-
-    wxCHECK( ret_image.IsOk(), ret_image );
-
-    const unsigned char* src_data = M_IMGDATA->m_data;
-    unsigned char* dst_data = ret_image.GetData();
-    const unsigned char* src_alpha = M_IMGDATA->m_alpha;
-    unsigned char* dst_alpha = ret_image.GetAlpha();
+    const unsigned char* const src_data = p.src_data;
+    const unsigned char* const src_alpha = p.src_alpha;
+    const int width = p.width;
+    const int height = p.height;
+    const int blurRadius = p.blurRadius;
 
     // number of pixels we average over
     const int blurArea = blurRadius*2 + 1;
 
-    // Vertical blurring algorithm - same as horizontal but switched the
-    // opposite direction
-    for ( int x = 0; x < M_IMGDATA->m_width; x++ )
+    // The running sums for all the columns, stored channel by channel.
+    wxVector<long> sums((size_t)width*4, 0);
+    long* const sum_r = &sums[0];
+    long* const sum_g = sum_r + width;
+    long* const sum_b = sum_g + width;
+    long* const sum_a = sum_b + width;
+
+    // Calculate the sums for the window centered on the first row of the
+    // band, duplicating the edge rows for the parts of the window beyond
+    // the top (or, for huge radii, bottom) edge of the image.
+    for ( int kernel_y = rowFirst - blurRadius;
+          kernel_y <= rowFirst + blurRadius;
+          kernel_y++ )
     {
-        // Variables used in the blurring algorithm
-        long sum_r = 0,
-             sum_g = 0,
-             sum_b = 0,
-             sum_a = 0;
-
-        long pixel_idx;
-        const unsigned char *src;
-        unsigned char *dst;
+        int row = kernel_y;
+        if ( row < 0 )
+            row = 0;
+        else if ( row > height - 1 )
+            row = height - 1;
+
+        const unsigned char* src = src_data + (size_t)row*width*3;
+        for ( int x = 0; x < width; x++, src += 3 )
+        {
+            sum_r[x] += src[0];
+            sum_g[x] += src[1];
+            sum_b[x] += src[2];
+        }
 
-        // Calculate the average of all pixels in our blur radius box for the
-        // first pixel of the column
-        for ( int kernel_y = -blurRadius; kernel_y <= blurRadius; kernel_y++ )
+        if ( src_alpha )
         {
-            // To deal with the pixels at the start of a column so it's not
-            // grabbing GOK values from memory at negative indices of the
-            // image's data or grabbing from the previous column
-            if ( kernel_y < 0 )
-                pixel_idx = x;
-            else
-                pixel_idx = x + kernel_y * M_IMGDATA->m_width;
+            const unsigned char* srcA = src_alpha + (size_t)row*width;
+            for ( int x = 0; x < width; x++ )
+                sum_a[x] += srcA[x];
+        }
+    }
 
-            src = src_data + pixel_idx*3;
-            sum_r += src[0];
-            sum_g += src[1];
-            sum_b += src[2];
-            if ( src_alpha )
-                sum_a += src_alpha[pixel_idx];
+    for ( int y = rowFirst; ; )
+    {
+        // Save off the averaged data for the current row
+        unsigned char* dst = p.dst_data + (size_t)y*width*3;
+        for ( int x = 0; x < width; x++, dst += 3 )
+        {
+            dst[0] = (unsigned char)(sum_r[x] / blurArea);
+            dst[1] = (unsigned char)(sum_g[x] / blurArea);
+            dst[2] = (unsigned char)(sum_b[x] / blurArea);
         }
 
-        dst = dst_data + x*3;
-        dst[0] = (unsigned char)(sum_r / blurArea);
-        dst[1] = (unsigned char)(sum_g / blurArea);
-        dst[2] = (unsigned char)(sum_b / blurArea);
         if ( src_alpha )
-            dst_alpha[x] = (unsigned char)(sum_a / blurArea);
-
-        // Now average the values of the rest of the pixels by just moving the
-        // box along the column from top to bottom
-        for ( int y = 1; y < M_IMGDATA->m_height; y++ )
         {
-            // Take care of pixels that would be beyond the top edge by
-            // duplicating the top edge pixel for the column
-            if ( y - blurRadius - 1 < 0 )
-                pixel_idx = x;
-            else
-                pixel_idx = x + (y - blurRadius - 1) * M_IMGDATA->m_width;
+            unsigned char* dstA = p.dst_alpha + (size_t)y*width;
+            for ( int x = 0; x < width; x++ )
+                dstA[x] = (unsigned char)(sum_a[x] / blurArea);
+        }
 
-            // Subtract the value of the pixel at the top of our blur radius box
-            src = src_data + pixel_idx*3;
-            sum_r -= src[0];
-            sum_g -= src[1];
-            sum_b -= src[2];
-            if ( src_alpha )
-                sum_a -= src_alpha[pixel_idx];
+        if ( ++y >= rowLast )
+            break;
 
-            // Take care of the pixels that would be beyond the bottom edge of
-            // the image similar to the top edge
-            if ( y + blurRadius > M_IMGDATA->m_height - 1 )
-                pixel_idx = x + (M_IMGDATA->m_height - 1) * M_IMGDATA->m_width;
-            else
-                pixel_idx = x + (blurRadius + y) * M_IMGDATA->m_width;
+        // Move the box one row down: subtract the row leaving it at the top
+        // and add the one entering it at the bottom, duplicating the edge
+        // rows as above.
+        int rowOut = y - blurRadius - 1;
+        if ( rowOut < 0 )
+            rowOut = 0;
 
-            // Add the value of the pixel being added to the end of our box
-            src = src_data + pixel_idx*3;
-            sum_r += src[0];
-            sum_g += src[1];
-            sum_b += src[2];
-            if ( src_alpha )
-                sum_a += src_alpha[pixel_idx];
+        int rowIn = y + blurRadius;
+        if ( rowIn > height - 1 )
+            rowIn = height - 1;
 
-            // Save off the averaged data
-            dst = dst_data + (x + y * M_IMGDATA->m_width) * 3;
-            dst[0] = (unsigned char)(sum_r / blurArea);
-            dst[1] = (unsigned char)(sum_g / blurArea);
-            dst[2] = (unsigned char)(sum_b / blurArea);
-            if ( src_alpha )
-                dst_alpha[x + y * M_IMGDATA->m_width] = (unsigned char)(sum_a / blurArea);
+        const unsigned char* srcOut = src_data + (size_t)rowOut*width*3;
+        const unsigned char* srcIn = src_data + (size_t)rowIn*width*3;
+        for ( int x = 0; x < width; x++, srcOut += 3, srcIn += 3 )
+        {
+            sum_r[x] += srcIn[0] - srcOut[0];
+            sum_g[x] += srcIn[1] - srcOut[1];
+            sum_b[x] += srcIn[2] - srcOut[2];
+        }
+
+        if ( src_alpha )
+        {
+            const unsigned char* srcOutA = src_alpha + (size_t)rowOut*width;
+            const unsigned char* srcInA = src_alpha + (size_t)rowIn*width;
+            for ( int x = 0; x < width; x++ )
+                sum_a[x] += srcInA[x] - srcOutA[x];
         }
     }
+}
+
+} // anonymous namespace
+
+// Blur in the horizontal direction
+wxImage wxImage::BlurHorizontal(int blurRadius) const
+{
+    wxImage ret_image(MakeEmptyClone());
+
+    wxCHECK( ret_image.IsOk(), ret_image );
+
+    BlurParams params;
+    params.src_data = M_IMGDATA->m_data;
+    params.src_alpha = M_IMGDATA->m_alpha;
+    params.dst_data = ret_image.GetData();
+    params.dst_alpha = ret_image.GetAlpha();
+    params.width = M_IMGDATA->m_width;
+    params.height = M_IMGDATA->m_height;
+    params.blurRadius = blurRadius;
+
+    wxImageRunRowBands(BlurHorizontalRows, params,
+                       params.height, params.width);
 
     return ret_image;
 }
 
-// The new blur function
-wxImage wxImage::Blur(int blurRadius) const
+// Blur in the vertical direction
+wxImage wxImage::BlurVertical(int blurRadius) const
 {
-    wxImage ret_image;
-    ret_image.Create(M_IMGDATA->m_width, M_IMGDATA->m_height, false);
+    wxImage ret_image(MakeEmptyClone());
 
-    // Blur the image in each direction
-    ret_image = BlurHorizontal(blurRadius);
-    ret_image = ret_image.BlurVertical(blurRadius);
+    wxCHECK( ret_image.IsOk(), ret_image );
+
+    BlurParams params;
+    params.src_data = M_IMGDATA->m_data;
+    params.src_alpha = M_IMGDATA->m_alpha;
+    params.dst_data = ret_image.GetData();
+    params.dst_alpha = ret_image.GetAlpha();
+    params.width = M_IMGDATA->m_width;
+    params.height = M_IMGDATA->m_height;
+    params.blurRadius = blurRadius;
+
+    wxImageRunRowBands(BlurVerticalRows, params,
+                       params.height, params.width);
 
     return ret_image;
 }
 
+// The new blur function
+wxImage wxImage::Blur(int blurRadius) const
+{
+    // Blur the image in each direction
+    return BlurHorizontal(blurRadius).BlurVertical(blurRadius);
+}
+
 wxImage wxImage::Rotate90( bool clockwise ) const
 {
     wxImage image(MakeEmptyClone(Clone_SwapOrientation));
@@ -1543,6 +1788,9 @@ wxImage wxImage::GetSubImage( const wxRect &rect ) const
         image.SetAlpha();
         subalpha = image.GetAlpha();
         wxCHECK_MSG( subalpha, image, wxT("unable to create alpha channel"));
+
+        if ( M_IMGDATA->m_alphaPremultiplied )
+            image.SetPremultipliedAlpha();
     }
 
     if (M_IMGDATA->m_hasMask)
@@ -1569,6 +1817,40 @@ wxImage wxImage::GetSubImage( const wxRect &rect ) const
     return image;
 }
 
+wxImage wxImage::SubImageView( const wxRect &rect ) const
+{
+    wxImage image;
+
+    wxCHECK_MSG( IsOk(), image, wxT("invalid image") );
+
+    wxCHECK_MSG( (rect.GetLeft()>=0) && (rect.GetTop()>=0) &&
+                 (rect.GetRight()<=GetWidth()) && (rect.GetBottom()<=GetHeight()),
+                 image, wxT("invalid subimage size") );
+
+    // Only a full width band can alias the original buffer, as the rows of
+    // an image must be contiguous.
+    if ( rect.GetLeft() != 0 || rect.GetWidth() != GetWidth() )
+        return GetSubImage(rect);
+
+    const size_t pixsoff = (size_t)rect.GetTop()*GetWidth();
+
+    image.Create(GetWidth(), rect.GetHeight(),
+                 M_IMGDATA->m_data + 3*pixsoff, true /* shared, not owned */);
+
+    if ( M_IMGDATA->m_alpha )
+    {
+        image.SetAlpha(M_IMGDATA->m_alpha + pixsoff, true);
+
+        if ( M_IMGDATA->m_alphaPremultiplied )
+            image.SetPremultipliedAlpha();
+    }
+
+    if (M_IMGDATA->m_hasMask)
+        image.SetMaskColour( M_IMGDATA->m_maskRed, M_IMGDATA->m_maskGreen, M_IMGDATA->m_maskBlue );
+
+    return image;
+}
+
 wxImage wxImage::Size( const wxSize& size, const wxPoint& pos,
                        int r_, int g_, int b_ ) const
 {
@@ -1841,35 +2123,80 @@ wxImage wxImage::ConvertToGreyscale() const
     return ConvertToGreyscale(0.299, 0.587, 0.114);
 }
 
-namespace
+// Apply an independent per-channel lookup table to all pixels of the image,
+// skipping the pixels with the mask colour, if any. This is much faster than
+// using ApplyToAllPixels() with a kernel recomputing the same 256 possible
+// values over and over with floating point math and an indirect call for
+// every pixel.
+static void wxImageApplyChannelLUT(wxImage& image, const unsigned char lut[256])
 {
+    unsigned char* data = image.GetData();
+    const unsigned char* const
+        end = data + (size_t)3*image.GetWidth()*image.GetHeight();
 
-// red, green and blue are doubles in the range [0.0..1.0], they are used
-// internally by DoMakeGrey() only.
-class WeightValue
-{
-public:
-    WeightValue(double r = 0.0, double g = 0.0, double b = 0.0)
-        : red(r), green(g), blue(b) {}
-    double red;
-    double green;
-    double blue;
-};
-
-} // anonymous namespace
-
-// TODO-C++11: Replace with a lambda function.
-static void DoMakeGrey(wxImage *image, unsigned char *rgb, WeightValue weight)
-{
-    if ( !image->HasMask() || rgb[0] != image->GetMaskRed() ||
-         rgb[1] != image->GetMaskGreen() || rgb[2] != image->GetMaskBlue() )
-        wxColour::MakeGrey(rgb, rgb + 1, rgb + 2, weight.red, weight.green, weight.blue);
+    if ( image.HasMask() )
+    {
+        const unsigned char maskRed = image.GetMaskRed(),
+                            maskGreen = image.GetMaskGreen(),
+                            maskBlue = image.GetMaskBlue();
+
+        for ( ; data != end; data += 3 )
+        {
+            if ( data[0] == maskRed &&
+                 data[1] == maskGreen &&
+                 data[2] == maskBlue )
+                continue;
+
+            data[0] = lut[data[0]];
+            data[1] = lut[data[1]];
+            data[2] = lut[data[2]];
+        }
+    }
+    else // no mask, all channels of all pixels are transformed
+    {
+        for ( ; data != end; data++ )
+            *data = lut[*data];
+    }
 }
 
 wxImage wxImage::ConvertToGreyscale(double weight_r, double weight_g, double weight_b) const
 {
     wxImage image = *this;
-    image.ApplyToAllPixels(&DoMakeGrey, WeightValue(weight_r, weight_g, weight_b));
+
+    unsigned char* data = image.GetData();
+    wxCHECK_MSG( data, image, wxT("invalid image") );
+
+    // Precompute the contribution of each channel value: the sum below is
+    // formed in the same order as in wxColour::MakeGrey(), so the results
+    // are bit-identical to applying it to every pixel, just without
+    // recomputing the same products again and again.
+    double lutR[256], lutG[256], lutB[256];
+    for ( int i = 0; i < 256; i++ )
+    {
+        lutR[i] = i*weight_r;
+        lutG[i] = i*weight_g;
+        lutB[i] = i*weight_b;
+    }
+
+    const bool hasMask = image.HasMask();
+    const unsigned char maskRed = image.GetMaskRed(),
+                        maskGreen = image.GetMaskGreen(),
+                        maskBlue = image.GetMaskBlue();
+
+    const unsigned char* const
+        end = data + (size_t)3*image.GetWidth()*image.GetHeight();
+    for ( ; data != end; data += 3 )
+    {
+        if ( hasMask && data[0] == maskRed &&
+             data[1] == maskGreen && data[2] == maskBlue )
+            continue;
+
+        const double luma = lutR[data[0]] + lutG[data[1]] + lutB[data[2]];
+        data[0] =
+        data[1] =
+        data[2] = (wxByte)wxRound(luma);
+    }
+
     return image;
 }
 
@@ -1896,34 +2223,50 @@ wxImage wxImage::ConvertToMono(unsigned char r, unsigned char g, unsigned char b
     return image;
 }
 
-// TODO-C++11: Replace with a lambda function.
-static void DoMakeDisabled(wxImage *image, unsigned char *rgb, unsigned char brightness)
-{
-    if ( !image->HasMask() || rgb[0] != image->GetMaskRed() ||
-         rgb[1] != image->GetMaskGreen() || rgb[2] != image->GetMaskBlue() )
-        wxColour::MakeDisabled(rgb, rgb + 1, rgb + 2, brightness);
-}
-
 wxImage wxImage::ConvertToDisabled(unsigned char brightness) const
 {
     wxImage image = *this;
-    image.ApplyToAllPixels(&DoMakeDisabled, brightness);
-    return image;
-}
 
-// TODO-C++11: Replace with a lambda function.
-static void DoChangeLightness(wxImage *image, unsigned char *rgb, int alpha)
-{
-    if ( !image->HasMask() || rgb[0] != image->GetMaskRed() ||
-         rgb[1] != image->GetMaskGreen() || rgb[2] != image->GetMaskBlue() )
-        wxColour::ChangeLightness(rgb, rgb + 1, rgb + 2, alpha);
+    wxCHECK_MSG( image.GetData(), image, wxT("invalid image") );
+
+    // wxColour::MakeDisabled() transforms each channel independently of the
+    // others, so tabulate it for all the possible channel values.
+    unsigned char lut[256];
+    for ( int i = 0; i < 256; i++ )
+    {
+        unsigned char r = (unsigned char)i,
+                      g = (unsigned char)i,
+                      b = (unsigned char)i;
+        wxColour::MakeDisabled(&r, &g, &b, brightness);
+        lut[i] = r;
+    }
+
+    wxImageApplyChannelLUT(image, lut);
+
+    return image;
 }
 
 wxImage wxImage::ChangeLightness(int alpha) const
 {
     wxASSERT(alpha >= 0 && alpha <= 200);
     wxImage image = *this;
-    image.ApplyToAllPixels(&DoChangeLightness, alpha);
+
+    wxCHECK_MSG( image.GetData(), image, wxT("invalid image") );
+
+    // As in ConvertToDisabled() above, wxColour::ChangeLightness() is
+    // independent per channel and can be tabulated.
+    unsigned char lut[256];
+    for ( int i = 0; i < 256; i++ )
+    {
+        unsigned char r = (unsigned char)i,
+                      g = (unsigned char)i,
+                      b = (unsigned char)i;
+        wxColour::ChangeLightness(&r, &g, &b, alpha);
+        lut[i] = r;
+    }
+
+    wxImageApplyChannelLUT(image, lut);
+
     return image;
 }
 
@@ -2179,11 +2522,27 @@ void wxImage::SetAlpha( unsigned char *alpha, bool static_data )
         alpha = (unsigned char *)malloc(M_IMGDATA->m_width*M_IMGDATA->m_height);
     }
 
+    if ( !static_data )
+    {
+        wxAllocationTracker::OnAlloc(wxALLOC_TAG_IMAGES,
+                                     wxImageAlphaSize(M_IMGDATA->m_width,
+                                                      M_IMGDATA->m_height));
+    }
+
     if( !M_IMGDATA->m_staticAlpha )
+    {
+        if ( M_IMGDATA->m_alpha )
+            wxAllocationTracker::OnFree(wxALLOC_TAG_IMAGES,
+                                        wxImageAlphaSize(M_IMGDATA->m_width,
+                                                         M_IMGDATA->m_height));
         free(M_IMGDATA->m_alpha);
+    }
 
     M_IMGDATA->m_alpha = alpha;
     M_IMGDATA->m_staticAlpha = static_data;
+
+    // whatever the RGB data was premultiplied by, it wasn't this channel
+    M_IMGDATA->m_alphaPremultiplied = false;
 }
 
 unsigned char *wxImage::GetAlpha() const
@@ -2236,9 +2595,125 @@ void wxImage::ClearAlpha()
     AllocExclusive();
 
     if ( !M_IMGDATA->m_staticAlpha )
+    {
+        wxAllocationTracker::OnFree(wxALLOC_TAG_IMAGES,
+                                    wxImageAlphaSize(M_IMGDATA->m_width,
+                                                     M_IMGDATA->m_height));
         free( M_IMGDATA->m_alpha );
+    }
 
     M_IMGDATA->m_alpha = NULL;
+    M_IMGDATA->m_alphaPremultiplied = false;
+}
+
+// ----------------------------------------------------------------------------
+// premultiplied alpha
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Divide by 255 with correct rounding, i.e. the exact equivalent of
+// (v + 127)/255, but without the division.
+inline unsigned char wxDiv255(unsigned v)
+{
+    return (unsigned char)((v + 128 + ((v + 128) >> 8)) >> 8);
+}
+
+struct wxPremultiplyParams
+{
+    unsigned char* rgb;
+    const unsigned char* alpha;
+    int width;
+};
+
+void wxPremultiplyRows(const wxPremultiplyParams& p, int rowFirst, int rowLast)
+{
+    unsigned char* rgb = p.rgb + (size_t)rowFirst*p.width*3;
+    const unsigned char* alpha = p.alpha + (size_t)rowFirst*p.width;
+
+    for ( const unsigned char* const
+            alphaEnd = p.alpha + (size_t)rowLast*p.width;
+          alpha < alphaEnd;
+          alpha++, rgb += 3 )
+    {
+        const unsigned a = *alpha;
+        if ( a == 255 )
+            continue;
+
+        rgb[0] = wxDiv255(rgb[0]*a);
+        rgb[1] = wxDiv255(rgb[1]*a);
+        rgb[2] = wxDiv255(rgb[2]*a);
+    }
+}
+
+} // anonymous namespace
+
+bool wxImage::HasPremultipliedAlpha() const
+{
+    wxCHECK_MSG( IsOk(), false, wxT("invalid image") );
+
+    return M_IMGDATA->m_alpha && M_IMGDATA->m_alphaPremultiplied;
+}
+
+void wxImage::PremultiplyAlpha()
+{
+    wxCHECK_RET( HasAlpha(), wxT("image doesn't have an alpha channel") );
+
+    if ( M_IMGDATA->m_alphaPremultiplied )
+        return;
+
+    AllocExclusive();
+
+    wxPremultiplyParams params;
+    params.rgb = M_IMGDATA->m_data;
+    params.alpha = M_IMGDATA->m_alpha;
+    params.width = M_IMGDATA->m_width;
+
+    wxRunRowBands(wxPremultiplyRows, params, M_IMGDATA->m_height,
+                  M_IMGDATA->m_width, 0);
+
+    M_IMGDATA->m_alphaPremultiplied = true;
+}
+
+void wxImage::UnpremultiplyAlpha()
+{
+    wxCHECK_RET( HasAlpha(), wxT("image doesn't have an alpha channel") );
+
+    if ( !M_IMGDATA->m_alphaPremultiplied )
+        return;
+
+    AllocExclusive();
+
+    unsigned char* rgb = M_IMGDATA->m_data;
+    const unsigned char* alpha = M_IMGDATA->m_alpha;
+
+    for ( const unsigned char* const
+            alphaEnd = alpha + (size_t)M_IMGDATA->m_width*M_IMGDATA->m_height;
+          alpha < alphaEnd;
+          alpha++, rgb += 3 )
+    {
+        const unsigned a = *alpha;
+        if ( a == 0 || a == 255 )
+            continue;
+
+        // premultiplied values can't exceed their alpha, so no clamping is
+        // needed here
+        rgb[0] = (unsigned char)((rgb[0]*255)/a);
+        rgb[1] = (unsigned char)((rgb[1]*255)/a);
+        rgb[2] = (unsigned char)((rgb[2]*255)/a);
+    }
+
+    M_IMGDATA->m_alphaPremultiplied = false;
+}
+
+void wxImage::SetPremultipliedAlpha(bool premultiplied)
+{
+    wxCHECK_RET( HasAlpha(), wxT("image doesn't have an alpha channel") );
+
+    AllocExclusive();
+
+    M_IMGDATA->m_alphaPremultiplied = premultiplied;
 }
 
 
@@ -2439,7 +2914,12 @@ bool wxImage::ConvertAlphaToMask(unsigned char mr,
     }
 
     if ( !M_IMGDATA->m_staticAlpha )
+    {
+        wxAllocationTracker::OnFree(wxALLOC_TAG_IMAGES,
+                                    wxImageAlphaSize(M_IMGDATA->m_width,
+                                                     M_IMGDATA->m_height));
         free(M_IMGDATA->m_alpha);
+    }
 
     M_IMGDATA->m_alpha = NULL;
     M_IMGDATA->m_staticAlpha = false;
@@ -2772,10 +3252,101 @@ int wxImage::GetImageCount( const wxString& WXUNUSED_UNLESS_STREAMS(name),
   return 0;
 }
 
+// ----------------------------------------------------------------------------
+// lazy handler registry
+// ----------------------------------------------------------------------------
+
+// the registry of the handlers registered with AddLazyHandler(): it both
+// delays the handler creation until the handler is really needed and maps
+// the leading magic bytes of the corresponding formats to the handler types,
+// the latter remaining useful even after the handlers have been created
+namespace
+{
+
+struct wxLazyImageHandlerEntry
+{
+    wxImageHandler *(*factory)();
+    wxBitmapType type;
+    const void *signature;
+    size_t sigLength;
+    bool created;
+};
+
+} // anonymous namespace
+
+static wxVector<wxLazyImageHandlerEntry> gs_lazyHandlers;
+
+// create all the lazy handlers which hadn't been created yet: this must be
+// done before any operation relying on the full handlers list, e.g. looking
+// up a handler by name or extension or probing all of them
+static void wxCreateLazyHandlers()
+{
+    for ( size_t n = 0; n < gs_lazyHandlers.size(); n++ )
+    {
+        wxLazyImageHandlerEntry& entry = gs_lazyHandlers[n];
+        if ( entry.created )
+            continue;
+
+        entry.created = true;
+
+        // formats with several signatures are registered several times with
+        // the same type, so check that the handler wasn't created yet for
+        // another entry
+        if ( !wxImage::FindHandler(entry.type) )
+            wxImage::AddHandler((*entry.factory)());
+    }
+}
+
 #if wxUSE_STREAMS
 
+// try to recognize the format of the stream from its leading bytes using the
+// signatures of the lazily registered handlers: this reads the header just
+// once instead of letting every handler do its own seek/read cycle; returns
+// the handler, created on demand if necessary and verified with CanRead(), or
+// NULL if the signature isn't recognized and the caller must fall back to
+// probing all the handlers
+static wxImageHandler *wxFindHandlerBySignature(wxInputStream& stream)
+{
+    if ( !stream.IsSeekable() )
+        return NULL;
+
+    // long enough for the longest registered signature ("/* XPM */")
+    char hdr[16];
+
+    const wxFileOffset posOld = stream.TellI();
+    stream.Read(hdr, WXSIZEOF(hdr));
+    const size_t lenHdr = stream.LastRead();
+    if ( stream.SeekI(posOld) == wxInvalidOffset )
+        return NULL;
+
+    for ( size_t n = 0; n < gs_lazyHandlers.size(); n++ )
+    {
+        const wxLazyImageHandlerEntry& entry = gs_lazyHandlers[n];
+        if ( !entry.sigLength || entry.sigLength > lenHdr )
+            continue;
+
+        if ( memcmp(hdr, entry.signature, entry.sigLength) != 0 )
+            continue;
+
+        // this creates the handler if it hadn't been created yet
+        wxImageHandler * const handler = wxImage::FindHandler(entry.type);
+
+        // still let the handler examine the stream itself: the short
+        // signatures (e.g. the single version byte of PCX) can match by
+        // accident
+        if ( handler && handler->CanRead(stream) )
+            return handler;
+    }
+
+    return NULL;
+}
+
 bool wxImage::CanRead( wxInputStream &stream )
 {
+    // try to recognize the format from the header directly first
+    if ( wxFindHandlerBySignature(stream) )
+        return true;
+
     const wxList& list = GetHandlers();
 
     for ( wxList::compatibility_iterator node = list.GetFirst(); node; node = node->GetNext() )
@@ -2794,6 +3365,14 @@ int wxImage::GetImageCount( wxInputStream &stream, wxBitmapType type )
 
     if ( type == wxBITMAP_TYPE_ANY )
     {
+        handler = wxFindHandlerBySignature(stream);
+        if ( handler )
+        {
+            const int count = handler->GetImageCount(stream);
+            if ( count >= 0 )
+                return count;
+        }
+
         const wxList& list = GetHandlers();
 
         for ( wxList::compatibility_iterator node = list.GetFirst();
@@ -2917,6 +3496,13 @@ bool wxImage::LoadFile( wxInputStream& stream, wxBitmapType type, int index )
             return false;
         }
 
+        // if the header matches a known signature, a single handler needs to
+        // be created and tried
+        handler = wxFindHandlerBySignature(stream);
+        if ( handler && DoLoad(*handler, stream, index) )
+            return true;
+
+        // fall back to probing all the handlers
         const wxList& list = GetHandlers();
         for ( wxList::compatibility_iterator node = list.GetFirst();
               node;
@@ -3034,6 +3620,27 @@ bool wxImage::SaveFile( wxOutputStream& stream, const wxString& mimetype ) const
 // image I/O handlers
 // ----------------------------------------------------------------------------
 
+void wxImage::AddLazyHandler( wxImageHandler *(*factory)(),
+                              wxBitmapType type,
+                              const void *signature,
+                              size_t sigLength )
+{
+    wxCHECK_RET( factory, wxT("NULL image handler factory") );
+
+    const wxLazyImageHandlerEntry entry =
+        { factory, type, signature, sigLength, false };
+    gs_lazyHandlers.push_back(entry);
+}
+
+/* static */ wxList& wxImage::GetHandlers()
+{
+    // the callers iterating over the returned list expect to see all the
+    // handlers, so the lazily registered ones must be created first
+    wxCreateLazyHandlers();
+
+    return sm_handlers;
+}
+
 void wxImage::AddHandler( wxImageHandler *handler )
 {
     // Check for an existing handler of the type being added.
@@ -3086,6 +3693,9 @@ bool wxImage::RemoveHandler( const wxString& name )
 
 wxImageHandler *wxImage::FindHandler( const wxString& name )
 {
+    // name lookups can only be done on real handler objects
+    wxCreateLazyHandlers();
+
     wxList::compatibility_iterator node = sm_handlers.GetFirst();
     while (node)
     {
@@ -3099,6 +3709,9 @@ wxImageHandler *wxImage::FindHandler( const wxString& name )
 
 wxImageHandler *wxImage::FindHandler( const wxString& extension, wxBitmapType bitmapType )
 {
+    // as above, extensions are only known to the handlers themselves
+    wxCreateLazyHandlers();
+
     wxList::compatibility_iterator node = sm_handlers.GetFirst();
     while (node)
     {
@@ -3124,11 +3737,32 @@ wxImageHandler *wxImage::FindHandler(wxBitmapType bitmapType )
         if (handler->GetType() == bitmapType) return handler;
         node = node->GetNext();
     }
+
+    // check if a handler of this type was registered lazily and create it
+    // now if so
+    for ( size_t n = 0; n < gs_lazyHandlers.size(); n++ )
+    {
+        wxLazyImageHandlerEntry& entry = gs_lazyHandlers[n];
+        if ( entry.created || entry.type != bitmapType )
+            continue;
+
+        // mark it as created first to avoid infinite recursion, as
+        // AddHandler() below calls us back to check for duplicates
+        entry.created = true;
+
+        wxImageHandler * const handler = (*entry.factory)();
+        AddHandler(handler);
+        return handler;
+    }
+
     return NULL;
 }
 
 wxImageHandler *wxImage::FindHandlerMime( const wxString& mimetype )
 {
+    // MIME types are also only known to the handlers themselves
+    wxCreateLazyHandlers();
+
     wxList::compatibility_iterator node = sm_handlers.GetFirst();
     while (node)
     {
@@ -3158,6 +3792,10 @@ void wxImage::CleanUpHandlers()
     }
 
     sm_handlers.Clear();
+
+    // forget the lazy handlers too, wxInitAllImageHandlers() will register
+    // them again if it is called again
+    gs_lazyHandlers.clear();
 }
 
 wxString wxImage::GetImageExtWildcard()
@@ -3326,6 +3964,13 @@ static void DoRotateHue(wxImage *WXUNUSED(image), unsigned char *rgb, double ang
     rgb[2] = rgbValue.blue;
 }
 
+/* static */
+void wxImage::RotateHue(unsigned char *rgb, size_t numPixels, double angle)
+{
+    for ( size_t n = 0; n < numPixels; n++, rgb += 3 )
+        DoRotateHue(NULL, rgb, angle);
+}
+
 // Rotates the hue of each pixel in the image by angle, which is a double in the
 // range [-1.0..+1.0], where -1.0 corresponds to -360 degrees and +1.0 corresponds
 // to +360 degrees.
@@ -3335,7 +3980,7 @@ void wxImage::RotateHue(double angle)
         return;
 
     wxASSERT(angle >= -1.0 && angle <= 1.0);
-    ApplyToAllPixels(&DoRotateHue, angle);
+    DoAdjustHSV(angle, 0.0, 0.0);
 }
 
 // TODO-C++11: Replace with a lambda function.
@@ -3357,6 +4002,14 @@ static void DoChangeSaturation(wxImage *WXUNUSED(image), unsigned char *rgb, dou
     rgb[2] = rgbValue.blue;
 }
 
+/* static */
+void wxImage::ChangeSaturation(unsigned char *rgb, size_t numPixels,
+                               double factor)
+{
+    for ( size_t n = 0; n < numPixels; n++, rgb += 3 )
+        DoChangeSaturation(NULL, rgb, factor);
+}
+
 // Changes the saturation of each pixel in the image. factor is a double in the
 // range [-1.0..+1.0], where -1.0 corresponds to -100 percent and +1.0 corresponds
 // to +100 percent.
@@ -3366,7 +4019,7 @@ void wxImage::ChangeSaturation(double factor)
         return;
 
     wxASSERT(factor >= -1.0 && factor <= 1.0);
-    ApplyToAllPixels(&DoChangeSaturation, factor);
+    DoAdjustHSV(0.0, factor, 0.0);
 }
 
 // TODO-C++11: Replace with a lambda function.
@@ -3388,6 +4041,14 @@ static void DoChangeBrightness(wxImage *WXUNUSED(image), unsigned char *rgb, dou
     rgb[2] = rgbValue.blue;
 }
 
+/* static */
+void wxImage::ChangeBrightness(unsigned char *rgb, size_t numPixels,
+                               double factor)
+{
+    for ( size_t n = 0; n < numPixels; n++, rgb += 3 )
+        DoChangeBrightness(NULL, rgb, factor);
+}
+
 // Changes the brightness (value) of each pixel in the image. factor is a double
 // in the range [-1.0..+1.0], where -1.0 corresponds to -100 percent and +1.0
 // corresponds to +100 percent.
@@ -3397,7 +4058,7 @@ void wxImage::ChangeBrightness(double factor)
         return;
 
     wxASSERT(factor >= -1.0 && factor <= 1.0);
-    ApplyToAllPixels(&DoChangeBrightness, factor);
+    DoAdjustHSV(0.0, 0.0, factor);
 }
 
 // TODO-C++11: Replace with a lambda function.
@@ -3413,6 +4074,16 @@ static void DoChangeHSV(wxImage *image, unsigned char *rgb, wxImage::HSVValue hs
         DoChangeBrightness(image, rgb, hsvValue.value);
 }
 
+/* static */
+void wxImage::ChangeHSV(unsigned char *rgb, size_t numPixels,
+                        double angleH, double factorS, double factorV)
+{
+    const HSVValue adjust(angleH, factorS, factorV);
+
+    for ( size_t n = 0; n < numPixels; n++, rgb += 3 )
+        DoChangeHSV(NULL, rgb, adjust);
+}
+
 // Changes the hue, the saturation and the brightness (value) of each pixel in
 // the image. angleH is a double in the range [-1.0..+1.0], where -1.0 corresponds
 // to -360 degrees and +1.0 corresponds to +360 degrees, factorS is a double in
@@ -3426,7 +4097,44 @@ void wxImage::ChangeHSV(double angleH, double factorS, double factorV)
 
     wxASSERT(angleH >= -1.0 && angleH <= 1.0 && factorS >= -1.0 &&
              factorS <= 1.0 && factorV >= -1.0 && factorV <= 1.0);
-    ApplyToAllPixels(&DoChangeHSV, HSVValue(angleH, factorS, factorV));
+    DoAdjustHSV(angleH, factorS, factorV);
+}
+
+namespace
+{
+
+struct AdjustHSVParams
+{
+    unsigned char *data;
+    int width;
+    double angleH,
+           factorS,
+           factorV;
+};
+
+void AdjustHSVRows(const AdjustHSVParams& params, int rowFirst, int rowLast)
+{
+    wxImage::ChangeHSV(params.data + (size_t)rowFirst*params.width*3,
+                       (size_t)(rowLast - rowFirst)*params.width,
+                       params.angleH, params.factorS, params.factorV);
+}
+
+} // anonymous namespace
+
+void wxImage::DoAdjustHSV(double angleH, double factorS, double factorV)
+{
+    AllocExclusive();
+
+    AdjustHSVParams params;
+    params.data = GetData();
+    params.width = GetWidth();
+    params.angleH = angleH;
+    params.factorS = factorS;
+    params.factorV = factorV;
+
+    // every pixel is adjusted independently of all the others, so the rows
+    // can be processed in parallel
+    wxImageRunRowBands(AdjustHSVRows, params, GetHeight(), GetWidth());
 }
 
 //-----------------------------------------------------------------------------
@@ -3436,6 +4144,46 @@ void wxImage::ChangeHSV(double angleH, double factorS, double factorV)
 wxIMPLEMENT_ABSTRACT_CLASS(wxImageHandler, wxObject);
 
 #if wxUSE_STREAMS
+bool wxImageHandler::LoadRegion( wxImage *image, wxInputStream& stream,
+                                 const wxRect& rect, int downscale,
+                                 bool verbose, int index )
+{
+    wxCHECK_MSG( image, false, wxT("NULL image pointer") );
+    wxCHECK_MSG( rect.width > 0 && rect.height > 0, false,
+                 wxT("invalid image region") );
+    wxCHECK_MSG( downscale >= 1, false, wxT("invalid downscale factor") );
+
+    // Generic fallback for the formats which can only be decoded as a
+    // whole: load everything and throw away what wasn't asked for.
+    if ( !LoadFile(image, stream, verbose, index) )
+        return false;
+
+    return ExtractRegion(image, rect,
+                         wxSize(wxMax(1, rect.width/downscale),
+                                wxMax(1, rect.height/downscale)));
+}
+
+/* static */
+bool wxImageHandler::ExtractRegion(wxImage *image, const wxRect& rect,
+                                   const wxSize& sizeTarget)
+{
+    wxRect r = rect;
+    r.Intersect(wxRect(image->GetSize()));
+    if ( r.IsEmpty() )
+    {
+        image->Destroy();
+        return false;
+    }
+
+    if ( r != wxRect(image->GetSize()) )
+        *image = image->GetSubImage(r);
+
+    if ( image->GetSize() != sizeTarget )
+        image->Rescale(sizeTarget.x, sizeTarget.y, wxIMAGE_QUALITY_HIGH);
+
+    return true;
+}
+
 int wxImageHandler::GetImageCount( wxInputStream& stream )
 {
     // NOTE: this code is the same of wxAnimationDecoder::CanRead and
@@ -3537,6 +4285,66 @@ wxImageHandler::GetResolutionFromOptions(const wxImage& image, int *x, int *y)
 // image histogram stuff
 // ----------------------------------------------------------------------------
 
+namespace
+{
+
+// A bit set with one bit per possible 24 bit RGB value: when every pixel of a
+// big image needs to be visited just to know which colours are used, setting
+// a bit is much faster than inserting into a hash map and the 2MiB it uses
+// are only needed transiently.
+class wxImageColourSet
+{
+public:
+    wxImageColourSet()
+    {
+        m_bits = static_cast<unsigned char *>(calloc(1 << 21, 1));
+    }
+
+    ~wxImageColourSet()
+    {
+        free(m_bits);
+    }
+
+    // returns false if the bits couldn't be allocated and the caller should
+    // fall back to using wxImageHistogram
+    bool IsOk() const { return m_bits != NULL; }
+
+    // add the colour with the given key, returning true if it wasn't present
+    bool Add(unsigned long key)
+    {
+        unsigned char& byte = m_bits[key >> 3];
+        const unsigned char mask = static_cast<unsigned char>(1 << (key & 7));
+        if ( byte & mask )
+            return false;
+
+        byte |= mask;
+        return true;
+    }
+
+    bool Has(unsigned long key) const
+    {
+        return (m_bits[key >> 3] & (1 << (key & 7))) != 0;
+    }
+
+    // add all the pixels of the given RGB data
+    void AddPixels(const unsigned char *p, unsigned long numPixels)
+    {
+        for ( unsigned long n = 0; n < numPixels; n++, p += 3 )
+        {
+            const unsigned long key =
+                wxImageHistogram::MakeKey(p[0], p[1], p[2]);
+            m_bits[key >> 3] |= static_cast<unsigned char>(1 << (key & 7));
+        }
+    }
+
+private:
+    unsigned char *m_bits;
+
+    wxDECLARE_NO_COPY_CLASS(wxImageColourSet);
+};
+
+} // anonymous namespace
+
 bool
 wxImage::FindFirstUnusedColour(unsigned char *r,
                                unsigned char *g,
@@ -3545,11 +4353,49 @@ wxImage::FindFirstUnusedColour(unsigned char *r,
                                unsigned char g2,
                                unsigned char b2) const
 {
-    wxImageHistogram histogram;
+    wxImageColourSet colours;
+    if ( !colours.IsOk() )
+    {
+        // allocating the bit set failed, use the slower histogram instead
+        wxImageHistogram histogram;
+        ComputeHistogram(histogram);
+
+        return histogram.FindFirstUnusedColour(r, g, b, r2, g2, b2);
+    }
+
+    colours.AddPixels(GetData(),
+                      static_cast<unsigned long>(GetWidth()) * GetHeight());
+
+    // advance through the colours in the same order as the histogram version
+    // in wx/image.h does
+    while ( colours.Has(wxImageHistogram::MakeKey(r2, g2, b2)) )
+    {
+        // colour already used
+        r2++;
+        if ( r2 >= 255 )
+        {
+            r2 = 0;
+            g2++;
+            if ( g2 >= 255 )
+            {
+                g2 = 0;
+                b2++;
+                if ( b2 >= 255 )
+                {
+                    return false;
+                }
+            }
+        }
+    }
 
-    ComputeHistogram(histogram);
+    if ( r )
+        *r = r2;
+    if ( g )
+        *g = g2;
+    if ( b )
+        *b = b2;
 
-    return histogram.FindFirstUnusedColour(r, g, b, r2, g2, b2);
+    return true;
 }
 
 
@@ -3563,8 +4409,6 @@ wxImage::FindFirstUnusedColour(unsigned char *r,
 //
 unsigned long wxImage::CountColours( unsigned long stopafter ) const
 {
-    wxHashTable h;
-    wxObject dummy;
     unsigned char *p;
     unsigned long size, nentries;
 
@@ -3572,20 +4416,18 @@ unsigned long wxImage::CountColours( unsigned long stopafter ) const
     size = static_cast<unsigned long>(GetWidth()) * GetHeight();
     nentries = 0;
 
+    wxImageColourSet colours;
+    wxCHECK_MSG( colours.IsOk(), 0, wxT("out of memory") );
+
     for (unsigned long j = 0; (j < size) && (nentries <= stopafter) ; j++)
     {
         unsigned char r, g, b;
-        unsigned long key;
         r = *(p++);
         g = *(p++);
         b = *(p++);
-        key = wxImageHistogram::MakeKey(r, g, b);
 
-        if (h.Get(key) == NULL)
-        {
-            h.Put(key, &dummy);
+        if ( colours.Add(wxImageHistogram::MakeKey(r, g, b)) )
             nentries++;
-        }
     }
 
     return nentries;
@@ -3601,6 +4443,13 @@ unsigned long wxImage::ComputeHistogram( wxImageHistogram &h ) const
 
     const unsigned long size = static_cast<unsigned long>(GetWidth()) * GetHeight();
 
+#ifdef wxNEEDS_WX_HASH_MAP
+    // grow the table in advance to avoid the first few rehashes (don't use
+    // the pixel count itself as the bound, images with many distinct colours
+    // would overcommit a lot of memory for the rare ones actually using them)
+    h.reserve(wxMin(size, 4096ul));
+#endif // wxNEEDS_WX_HASH_MAP
+
     for ( unsigned long n = 0; n < size; n++ )
     {
         unsigned char r, g, b;
@@ -21,6 +21,7 @@
     #include "wx/intl.h"
     #include "wx/bitmap.h"
     #include "wx/module.h"
+    #include "wx/utils.h"
 #endif
 
 // A hack based on one from tif_jpeg.c to overcome the problem on Windows
@@ -237,9 +238,10 @@ bool wxJPEGHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
     wx_error_mgr jerr;
     unsigned char *ptr;
 
-    // save this before calling Destroy()
+    // save these before calling Destroy()
     const unsigned maxWidth = image->GetOptionInt(wxIMAGE_OPTION_MAX_WIDTH),
                    maxHeight = image->GetOptionInt(wxIMAGE_OPTION_MAX_HEIGHT);
+    const int scaleDenom = image->GetOptionInt(wxIMAGE_OPTION_JPEG_SCALE_DENOM);
     image->Destroy();
 
     cinfo.err = jpeg_std_error( &jerr );
@@ -279,6 +281,16 @@ bool wxJPEGHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
         bytesPerPixel = 3;
     }
 
+    // start with the explicitly requested reduced-scale decoding factor, if
+    // any: libjpeg only supports scaling by 1/2, 1/4 and 1/8, so round down
+    // to the nearest power of 2 not greater than 8
+    if ( scaleDenom > 1 )
+    {
+        unsigned& scale = cinfo.scale_denom;
+        while ( 2*scale <= wxMin(static_cast<unsigned>(scaleDenom), 8u) )
+            scale *= 2;
+    }
+
     // scale the picture to fit in the specified max size if necessary
     if ( maxWidth > 0 || maxHeight > 0 )
     {
@@ -302,19 +314,34 @@ bool wxJPEGHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
     ptr = image->GetData();
 
     unsigned stride = cinfo.output_width * bytesPerPixel;
-    JSAMPARRAY tempbuf = (*cinfo.mem->alloc_sarray)
-                            ((j_common_ptr) &cinfo, JPOOL_IMAGE, stride, 1 );
 
-    while ( cinfo.output_scanline < cinfo.output_height )
+    if (cinfo.out_color_space == JCS_RGB)
     {
-        jpeg_read_scanlines( &cinfo, tempbuf, 1 );
-        if (cinfo.out_color_space == JCS_RGB)
+        // Decode straight into the image buffer, as many scanlines per call
+        // as libjpeg can produce, instead of copying them one by one through
+        // an intermediate buffer: the copy is pure overhead. The row pointer
+        // array is allocated from the JPOOL_IMAGE pool so that it is freed
+        // even if wx_error_exit() is called during decoding.
+        JSAMPROW *rows = (JSAMPROW *)(*cinfo.mem->alloc_small)
+                            ((j_common_ptr) &cinfo, JPOOL_IMAGE,
+                             cinfo.output_height * sizeof(JSAMPROW) );
+        for (JDIMENSION i = 0; i < cinfo.output_height; i++)
+            rows[i] = ptr + (size_t)i * stride;
+
+        while ( cinfo.output_scanline < cinfo.output_height )
         {
-            memcpy( ptr, tempbuf[0], stride );
-            ptr += stride;
+            jpeg_read_scanlines( &cinfo, rows + cinfo.output_scanline,
+                                 cinfo.output_height - cinfo.output_scanline );
         }
-        else // CMYK
+    }
+    else // CMYK
+    {
+        JSAMPARRAY tempbuf = (*cinfo.mem->alloc_sarray)
+                                ((j_common_ptr) &cinfo, JPOOL_IMAGE, stride, 1 );
+
+        while ( cinfo.output_scanline < cinfo.output_height )
         {
+            jpeg_read_scanlines( &cinfo, tempbuf, 1 );
             const unsigned char* inptr = (const unsigned char*) tempbuf[0];
             for (size_t i = 0; i < cinfo.output_width; i++)
             {
@@ -348,6 +375,41 @@ bool wxJPEGHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
     return true;
 }
 
+bool wxJPEGHandler::LoadRegion( wxImage *image, wxInputStream& stream,
+                                const wxRect& rect, int downscale,
+                                bool verbose, int index )
+{
+    wxCHECK_MSG( image, false, "NULL image pointer" );
+    wxCHECK_MSG( rect.width > 0 && rect.height > 0, false,
+                 wxT("invalid image region") );
+    wxCHECK_MSG( downscale >= 1, false, wxT("invalid downscale factor") );
+
+    // Let libjpeg do as much of the reduction as possible in the DCT
+    // domain: it supports scaling by 1/2, 1/4 and 1/8, which makes the
+    // decoding itself correspondingly cheaper; the crop and any remaining
+    // reduction are then done on the (much smaller) decoded image.
+    image->SetOption(wxIMAGE_OPTION_JPEG_SCALE_DENOM, downscale);
+
+    if ( !LoadFile(image, stream, verbose, index) )
+        return false;
+
+    // the scale actually applied by LoadFile(), see above
+    int applied = 1;
+    while ( 2*applied <= wxMin(downscale, 8) )
+        applied *= 2;
+
+    // the region in the coordinates of the reduced image, rounded outwards
+    wxRect r;
+    r.x = rect.x/applied;
+    r.y = rect.y/applied;
+    r.width = (rect.x + rect.width + applied - 1)/applied - r.x;
+    r.height = (rect.y + rect.height + applied - 1)/applied - r.y;
+
+    return ExtractRegion(image, r,
+                         wxSize(wxMax(1, rect.width/downscale),
+                                wxMax(1, rect.height/downscale)));
+}
+
 typedef struct {
     struct jpeg_destination_mgr pub;
 
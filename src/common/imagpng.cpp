@@ -22,6 +22,7 @@
 
 #include "wx/imagpng.h"
 #include "wx/versioninfo.h"
+#include "wx/private/rowband.h"
 
 #ifndef WX_PRECOMP
     #include "wx/log.h"
@@ -486,6 +487,126 @@ static long PaletteAdd(PaletteMap *palette, const png_color_8& clr)
     return index;
 }
 
+// ----------------------------------------------------------------------------
+// SaveFile() row conversion
+// ----------------------------------------------------------------------------
+
+// Everything needed to convert rows of wxImage data into the libpng row
+// format chosen by SaveFile(): filled once per image and then shared,
+// read-only, by all the threads converting its rows.
+struct wxPNGRowConvParams
+{
+    const unsigned char *rgb;   // RGB data the rows are converted from
+    const unsigned char *alpha; // its alpha channel or NULL
+    const PaletteMap *palette;  // used with wxPNG_TYPE_PALETTE only
+    unsigned char *dst;         // output buffer for the current band
+    size_t dstRowBytes;         // size of one converted row in dst
+    int rowFirst;               // source row corresponding to the band start
+    int width;
+    int colorType;              // wxPNG_TYPE_XXX
+    int bitDepth;
+    png_color_8 mask;
+    bool usePalette;
+    bool useAlpha;
+    bool hasMask;
+};
+
+// Convert the band rows [rowBandFirst, rowBandLast), counted from
+// params.rowFirst, into the band buffer. This is the body of the old
+// SaveFile() per-row loop, parameterized by the row range so that the rows
+// of a band can be converted on several CPUs concurrently.
+static void
+wxPNGConvertRows(const wxPNGRowConvParams& p, int rowBandFirst, int rowBandLast)
+{
+    for ( int row = rowBandFirst; row < rowBandLast; row++ )
+    {
+        const int y = p.rowFirst + row;
+
+        const unsigned char *pColors = p.rgb + (size_t)y*p.width*3;
+        const unsigned char *pAlpha = p.alpha ? p.alpha + (size_t)y*p.width
+                                              : NULL;
+        unsigned char *pData = p.dst + (size_t)row*p.dstRowBytes;
+
+        for (int x = 0; x != p.width; x++)
+        {
+            png_color_8 clr;
+            clr.red   = *pColors++;
+            clr.green = *pColors++;
+            clr.blue  = *pColors++;
+            clr.gray  = 0;
+            clr.alpha = (p.usePalette && pAlpha) ? *pAlpha++ : 0; // use with wxPNG_TYPE_PALETTE only
+
+            switch ( p.colorType )
+            {
+                default:
+                    wxFAIL_MSG( wxT("unknown wxPNG_TYPE_XXX") );
+                    wxFALLTHROUGH;
+
+                case wxPNG_TYPE_COLOUR:
+                    *pData++ = clr.red;
+                    if ( p.bitDepth == 16 )
+                        *pData++ = 0;
+                    *pData++ = clr.green;
+                    if ( p.bitDepth == 16 )
+                        *pData++ = 0;
+                    *pData++ = clr.blue;
+                    if ( p.bitDepth == 16 )
+                        *pData++ = 0;
+                    break;
+
+                case wxPNG_TYPE_GREY:
+                    {
+                        // where do these coefficients come from? maybe we
+                        // should have image options for them as well?
+                        unsigned uiColor =
+                            (unsigned) (76.544*(unsigned)clr.red +
+                                        150.272*(unsigned)clr.green +
+                                        36.864*(unsigned)clr.blue);
+
+                        *pData++ = (unsigned char)((uiColor >> 8) & 0xFF);
+                        if ( p.bitDepth == 16 )
+                            *pData++ = (unsigned char)(uiColor & 0xFF);
+                    }
+                    break;
+
+                case wxPNG_TYPE_GREY_RED:
+                    *pData++ = clr.red;
+                    if ( p.bitDepth == 16 )
+                        *pData++ = 0;
+                    break;
+
+                case wxPNG_TYPE_PALETTE:
+                    *pData++ = (unsigned char) PaletteFind(*p.palette, clr);
+                    break;
+            }
+
+            if ( p.useAlpha )
+            {
+                unsigned char uchAlpha = 255;
+                if ( pAlpha )
+                    uchAlpha = *pAlpha++;
+
+                if ( p.hasMask )
+                {
+                    if ( (clr.red == p.mask.red)
+                            && (clr.green == p.mask.green)
+                                && (clr.blue == p.mask.blue) )
+                        uchAlpha = 0;
+                }
+
+                *pData++ = uchAlpha;
+                if ( p.bitDepth == 16 )
+                    *pData++ = 0;
+            }
+        }
+    }
+}
+
+// The rows are converted and compressed in bands of up to this many rows:
+// this bounds the size of the conversion buffer while leaving big images
+// with enough rows per band to share among all the CPUs.
+static const int wxPNG_SAVE_BAND_ROWS = 256;
+
 // ----------------------------------------------------------------------------
 // writing PNGs
 // ----------------------------------------------------------------------------
@@ -739,102 +860,269 @@ bool wxPNGHandler::SaveFile( wxImage *image, wxOutputStream& stream, bool verbos
     png_set_shift( png_ptr, &sig_bit );
     png_set_packing( png_ptr );
 
-    unsigned char *
-        data = (unsigned char *)malloc( image->GetWidth() * iElements );
-    if ( !data )
+    // Convert and compress the image band by band: each band is converted
+    // into the libpng row format, using all the available CPUs for big
+    // enough images, and then handed over to libpng which filters and
+    // compresses it (serially, as zlib needs the rows in order anyhow).
+    const int bandRows = wxMin(iHeight, wxPNG_SAVE_BAND_ROWS);
+    const size_t dstRowBytes = (size_t)iWidth*iElements;
+
+    unsigned char *data = (unsigned char *)malloc( bandRows*dstRowBytes );
+    png_bytep *rowPtrs = (png_bytep *)malloc( bandRows*sizeof(png_bytep) );
+    if ( !data || !rowPtrs )
     {
+        free(rowPtrs);
+        free(data);
         png_destroy_write_struct( &png_ptr, (png_infopp)NULL );
         return false;
     }
 
-    const unsigned char *
-        pAlpha = (const unsigned char *)(bHasAlpha ? image->GetAlpha() : NULL);
+    for ( int row = 0; row < bandRows; row++ )
+        rowPtrs[row] = data + (size_t)row*dstRowBytes;
+
+    wxPNGRowConvParams params;
+    params.rgb = image->GetData();
+    params.alpha = bHasAlpha ? image->GetAlpha() : NULL;
+    params.palette = &palette;
+    params.dst = data;
+    params.dstRowBytes = dstRowBytes;
+    params.width = iWidth;
+    params.colorType = iColorType;
+    params.bitDepth = iBitDepth;
+    params.mask = mask;
+    params.usePalette = bUsePalette;
+    params.useAlpha = bUseAlpha;
+    params.hasMask = bHasMask;
+
+    const int numThreads = image->HasOption(wxIMAGE_OPTION_PNG_THREADS)
+                            ? image->GetOptionInt(wxIMAGE_OPTION_PNG_THREADS)
+                            : 0;
+
+    for ( int y = 0; y < iHeight; y += bandRows )
+    {
+        const int numRows = wxMin(bandRows, iHeight - y);
+
+        params.rowFirst = y;
+        wxRunRowBands(wxPNGConvertRows, params, numRows, iWidth, numThreads);
+
+        png_write_rows( png_ptr, rowPtrs, numRows );
+    }
+
+    free(rowPtrs);
+    free(data);
+    png_write_end( png_ptr, info_ptr );
+    png_destroy_write_struct( &png_ptr, (png_infopp)&info_ptr );
 
-    const unsigned char *pColors = image->GetData();
+    return true;
+}
 
-    for (int y = 0; y != iHeight; ++y)
+// ============================================================================
+// wxPNGStreamEncoder
+// ============================================================================
+
+// The libpng state of an encoder between Start() and Finish(). Note that the
+// jmp_buf inside wxinfo may only be used while a wxPNGStreamEncoder method
+// is running, so every method calling libpng re-arms it with setjmp() first.
+class wxPNGEncoderImpl
+{
+public:
+    wxPNGInfoStruct wxinfo;
+    png_structp png_ptr;
+    png_infop info_ptr;
+    int width,
+        height;
+    int rowsWritten;
+    bool withAlpha;
+};
+
+wxPNGStreamEncoder::wxPNGStreamEncoder()
+{
+    m_impl = NULL;
+    m_compressionLevel = -1;
+    m_numThreads = 0;
+}
+
+wxPNGStreamEncoder::~wxPNGStreamEncoder()
+{
+    if ( m_impl )
     {
-        unsigned char *pData = data;
-        for (int x = 0; x != iWidth; x++)
-        {
-            png_color_8 clr;
-            clr.red   = *pColors++;
-            clr.green = *pColors++;
-            clr.blue  = *pColors++;
-            clr.gray  = 0;
-            clr.alpha = (bUsePalette && pAlpha) ? *pAlpha++ : 0; // use with wxPNG_TYPE_PALETTE only
+        // Finish() wasn't called (or failed half-way): just abandon the
+        // partially written file.
+        png_destroy_write_struct(&m_impl->png_ptr,
+                                 (png_infopp)&m_impl->info_ptr);
+        delete m_impl;
+    }
+}
 
-            switch ( iColorType )
-            {
-                default:
-                    wxFAIL_MSG( wxT("unknown wxPNG_TYPE_XXX") );
-                    wxFALLTHROUGH;
+bool
+wxPNGStreamEncoder::Start(wxOutputStream& stream,
+                          int width,
+                          int height,
+                          bool withAlpha)
+{
+    wxCHECK_MSG( !m_impl, false, wxT("encoding already in progress") );
+    wxCHECK_MSG( width > 0 && height > 0, false, wxT("invalid image size") );
+
+    wxPNGEncoderImpl* const impl = new wxPNGEncoderImpl;
+    impl->wxinfo.verbose = false;
+    impl->wxinfo.stream.out = &stream;
+    impl->width = width;
+    impl->height = height;
+    impl->rowsWritten = 0;
+    impl->withAlpha = withAlpha;
+
+    impl->png_ptr = png_create_write_struct
+                    (
+                      PNG_LIBPNG_VER_STRING,
+                      NULL,
+                      wx_PNG_error,
+                      wx_PNG_warning
+                    );
+    if ( !impl->png_ptr )
+    {
+        delete impl;
+        return false;
+    }
 
-                case wxPNG_TYPE_COLOUR:
-                    *pData++ = clr.red;
-                    if ( iBitDepth == 16 )
-                        *pData++ = 0;
-                    *pData++ = clr.green;
-                    if ( iBitDepth == 16 )
-                        *pData++ = 0;
-                    *pData++ = clr.blue;
-                    if ( iBitDepth == 16 )
-                        *pData++ = 0;
-                    break;
+    impl->info_ptr = png_create_info_struct(impl->png_ptr);
+    if ( !impl->info_ptr )
+    {
+        png_destroy_write_struct(&impl->png_ptr, (png_infopp)NULL);
+        delete impl;
+        return false;
+    }
 
-                case wxPNG_TYPE_GREY:
-                    {
-                        // where do these coefficients come from? maybe we
-                        // should have image options for them as well?
-                        unsigned uiColor =
-                            (unsigned) (76.544*(unsigned)clr.red +
-                                        150.272*(unsigned)clr.green +
-                                        36.864*(unsigned)clr.blue);
+    if ( setjmp(impl->wxinfo.jmpbuf) )
+    {
+        png_destroy_write_struct(&impl->png_ptr, (png_infopp)&impl->info_ptr);
+        delete impl;
+        return false;
+    }
 
-                        *pData++ = (unsigned char)((uiColor >> 8) & 0xFF);
-                        if ( iBitDepth == 16 )
-                            *pData++ = (unsigned char)(uiColor & 0xFF);
-                    }
-                    break;
+    // NB: please see the comment near wxPNGInfoStruct declaration for
+    //     explanation why this line is mandatory
+    png_set_write_fn(impl->png_ptr, &impl->wxinfo, wx_PNG_stream_writer, NULL);
 
-                case wxPNG_TYPE_GREY_RED:
-                    *pData++ = clr.red;
-                    if ( iBitDepth == 16 )
-                        *pData++ = 0;
-                    break;
+    if ( m_compressionLevel != -1 )
+        png_set_compression_level(impl->png_ptr, m_compressionLevel);
 
-                case wxPNG_TYPE_PALETTE:
-                    *pData++ = (unsigned char) PaletteFind(palette, clr);
-                    break;
-            }
+    png_set_IHDR(impl->png_ptr, impl->info_ptr, width, height, 8,
+                 withAlpha ? PNG_COLOR_TYPE_RGB_ALPHA : PNG_COLOR_TYPE_RGB,
+                 PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE,
+                 PNG_FILTER_TYPE_BASE);
+    png_write_info(impl->png_ptr, impl->info_ptr);
 
-            if ( bUseAlpha )
-            {
-                unsigned char uchAlpha = 255;
-                if ( bHasAlpha )
-                    uchAlpha = *pAlpha++;
+    m_impl = impl;
 
-                if ( bHasMask )
-                {
-                    if ( (clr.red == mask.red)
-                            && (clr.green == mask.green)
-                                && (clr.blue == mask.blue) )
-                        uchAlpha = 0;
-                }
+    return true;
+}
 
-                *pData++ = uchAlpha;
-                if ( iBitDepth == 16 )
-                    *pData++ = 0;
-            }
+bool
+wxPNGStreamEncoder::WriteRows(const unsigned char *rgb,
+                              const unsigned char *alpha,
+                              int numRows)
+{
+    wxCHECK_MSG( m_impl, false, wxT("must call Start() first") );
+    wxCHECK_MSG( rgb, false, wxT("NULL image data") );
+    wxCHECK_MSG( !m_impl->withAlpha || alpha, false,
+                 wxT("alpha channel data must be provided") );
+    wxCHECK_MSG( numRows > 0 &&
+                    numRows <= m_impl->height - m_impl->rowsWritten,
+                 false, wxT("invalid number of rows") );
+
+    const int width = m_impl->width;
+
+    unsigned char *data = NULL;
+    png_bytep *rowPtrs = (png_bytep *)malloc( numRows*sizeof(png_bytep) );
+    if ( !rowPtrs )
+        return false;
+
+    if ( m_impl->withAlpha )
+    {
+        // Interleave the alpha channel with the RGB data as libpng expects,
+        // using all the available CPUs for big enough bands.
+        const size_t dstRowBytes = (size_t)width*4;
+
+        data = (unsigned char *)malloc( numRows*dstRowBytes );
+        if ( !data )
+        {
+            free(rowPtrs);
+            return false;
         }
 
-        png_bytep row_ptr = data;
-        png_write_rows( png_ptr, &row_ptr, 1 );
+        const png_color_8 noMask = { 0, 0, 0, 0, 0 };
+
+        wxPNGRowConvParams params;
+        params.rgb = rgb;
+        params.alpha = alpha;
+        params.palette = NULL;
+        params.dst = data;
+        params.dstRowBytes = dstRowBytes;
+        params.rowFirst = 0;
+        params.width = width;
+        params.colorType = wxPNG_TYPE_COLOUR;
+        params.bitDepth = 8;
+        params.mask = noMask;
+        params.usePalette = false;
+        params.useAlpha = true;
+        params.hasMask = false;
+
+        wxRunRowBands(wxPNGConvertRows, params, numRows, width, m_numThreads);
+
+        for ( int row = 0; row < numRows; row++ )
+            rowPtrs[row] = data + (size_t)row*dstRowBytes;
     }
+    else // no alpha: the RGB rows are already in the format libpng expects
+    {
+        for ( int row = 0; row < numRows; row++ )
+        {
+            rowPtrs[row] = const_cast<unsigned char *>(rgb)
+                                + (size_t)row*width*3;
+        }
+    }
+
+    if ( setjmp(m_impl->wxinfo.jmpbuf) )
+    {
+        // The stream write failed, this file can't be completed any more.
+        free(rowPtrs);
+        free(data);
+        png_destroy_write_struct(&m_impl->png_ptr,
+                                 (png_infopp)&m_impl->info_ptr);
+        delete m_impl;
+        m_impl = NULL;
+        return false;
+    }
+
+    png_write_rows(m_impl->png_ptr, rowPtrs, numRows);
 
+    m_impl->rowsWritten += numRows;
+
+    free(rowPtrs);
     free(data);
-    png_write_end( png_ptr, info_ptr );
-    png_destroy_write_struct( &png_ptr, (png_infopp)&info_ptr );
+
+    return true;
+}
+
+bool wxPNGStreamEncoder::Finish()
+{
+    wxCHECK_MSG( m_impl, false, wxT("must call Start() first") );
+    wxCHECK_MSG( m_impl->rowsWritten == m_impl->height, false,
+                 wxT("not all rows have been written yet") );
+
+    // Whatever happens below, the encoding is over.
+    wxPNGEncoderImpl* const impl = m_impl;
+    m_impl = NULL;
+
+    if ( setjmp(impl->wxinfo.jmpbuf) )
+    {
+        png_destroy_write_struct(&impl->png_ptr, (png_infopp)&impl->info_ptr);
+        delete impl;
+        return false;
+    }
+
+    png_write_end(impl->png_ptr, impl->info_ptr);
+    png_destroy_write_struct(&impl->png_ptr, (png_infopp)&impl->info_ptr);
+    delete impl;
 
     return true;
 }
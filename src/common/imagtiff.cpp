@@ -574,6 +574,194 @@ bool wxTIFFHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
     return true;
 }
 
+bool wxTIFFHandler::LoadRegion( wxImage *image, wxInputStream& stream,
+                                const wxRect& rect, int downscale,
+                                bool verbose, int index )
+{
+    wxCHECK_MSG( image, false, wxT("NULL image pointer") );
+    wxCHECK_MSG( rect.width > 0 && rect.height > 0, false,
+                 wxT("invalid image region") );
+    wxCHECK_MSG( downscale >= 1, false, wxT("invalid downscale factor") );
+
+    if (index == -1)
+        index = 0;
+
+    image->Destroy();
+
+    TIFF *tif = TIFFwxOpen( stream, "image", "r" );
+
+    if (!tif)
+    {
+        if (verbose)
+        {
+            wxLogError( _("TIFF: Error loading image.") );
+        }
+
+        return false;
+    }
+
+    if (!TIFFSetDirectory( tif, (tdir_t)index ))
+    {
+        if (verbose)
+        {
+            wxLogError( _("Invalid TIFF image index.") );
+        }
+
+        TIFFClose( tif );
+
+        return false;
+    }
+
+    uint32 w, h;
+    TIFFGetField( tif, TIFFTAG_IMAGEWIDTH, &w );
+    TIFFGetField( tif, TIFFTAG_IMAGELENGTH, &h );
+
+    wxRect r = rect;
+    r.Intersect(wxRect(0, 0, (int)w, (int)h));
+    if ( r.IsEmpty() )
+    {
+        TIFFClose( tif );
+
+        return false;
+    }
+
+    uint16 samplesPerPixel = 0;
+    (void) TIFFGetFieldDefaulted(tif, TIFFTAG_SAMPLESPERPIXEL, &samplesPerPixel);
+
+    uint16 extraSamples;
+    uint16* samplesInfo;
+    TIFFGetFieldDefaulted(tif, TIFFTAG_EXTRASAMPLES,
+                          &extraSamples, &samplesInfo);
+
+    uint16 photometric;
+    if (!TIFFGetField(tif, TIFFTAG_PHOTOMETRIC, &photometric))
+    {
+        photometric = PHOTOMETRIC_MINISWHITE;
+    }
+    const bool hasAlpha = (extraSamples >= 1
+        && ((samplesInfo[0] == EXTRASAMPLE_UNSPECIFIED)
+            || samplesInfo[0] == EXTRASAMPLE_ASSOCALPHA
+            || samplesInfo[0] == EXTRASAMPLE_UNASSALPHA))
+        || (extraSamples == 0 && samplesPerPixel == 4
+            && photometric == PHOTOMETRIC_RGB);
+
+    // guard against integer overflow during multiplication which could result
+    // in allocating a too small buffer and then overflowing it
+    const double bytesNeeded = (double)r.width * (double)r.height * sizeof(uint32);
+    if ( bytesNeeded >= wxUINT32_MAX )
+    {
+        if ( verbose )
+        {
+            wxLogError( _("TIFF: Image size is abnormally big.") );
+        }
+
+        TIFFClose(tif);
+
+        return false;
+    }
+
+    uint32 *raster = (uint32*) _TIFFmalloc( (uint32)bytesNeeded );
+
+    if (!raster)
+    {
+        if (verbose)
+        {
+            wxLogError( _("TIFF: Couldn't allocate memory.") );
+        }
+
+        TIFFClose( tif );
+
+        return false;
+    }
+
+    /*
+    Decode just the region: TIFFRGBAImageGet() with a row and column offset
+    only reads the strips or tiles overlapping the requested rows and
+    columns, so viewing a small part of a huge image doesn't decode all of
+    it. Unlike LoadFile(), no attempt is made here to handle the exotic
+    greyscale-with-alpha layouts TIFFRGBAImageOK() rejects.
+    */
+    char msg[1024] = "";
+    TIFFRGBAImage img;
+    bool ok = TIFFRGBAImageOK(tif, msg) != 0 &&
+                TIFFRGBAImageBegin(&img, tif, 0, msg) != 0;
+    if (ok)
+    {
+        img.req_orientation = ORIENTATION_TOPLEFT;
+        img.row_offset = (uint32)r.y;
+        img.col_offset = (uint32)r.x;
+
+        ok = TIFFRGBAImageGet(&img, raster, r.width, r.height) != 0;
+
+        TIFFRGBAImageEnd(&img);
+    }
+
+    if (!ok)
+    {
+        if (verbose)
+        {
+            wxLogError( _("TIFF: Error reading image.") );
+        }
+
+        _TIFFfree( raster );
+        TIFFClose( tif );
+
+        return false;
+    }
+
+    image->Create( r.width, r.height );
+    if (!image->IsOk())
+    {
+        if (verbose)
+        {
+            wxLogError( _("TIFF: Couldn't allocate memory.") );
+        }
+
+        _TIFFfree( raster );
+        TIFFClose( tif );
+
+        return false;
+    }
+
+    if ( hasAlpha )
+        image->SetAlpha();
+
+    unsigned char *ptr = image->GetData();
+
+    unsigned char *alpha = image->GetAlpha();
+
+    uint32 pos = 0;
+
+    for (int i = 0; i < r.height; i++)
+    {
+        for (int j = 0; j < r.width; j++)
+        {
+            *(ptr++) = (unsigned char)TIFFGetR(raster[pos]);
+            *(ptr++) = (unsigned char)TIFFGetG(raster[pos]);
+            *(ptr++) = (unsigned char)TIFFGetB(raster[pos]);
+            if ( hasAlpha )
+                *(alpha++) = (unsigned char)TIFFGetA(raster[pos]);
+
+            pos++;
+        }
+    }
+
+    image->SetOption(wxIMAGE_OPTION_TIFF_PHOTOMETRIC, photometric);
+
+    _TIFFfree( raster );
+
+    TIFFClose( tif );
+
+    if ( downscale > 1 )
+    {
+        return ExtractRegion(image, wxRect(image->GetSize()),
+                             wxSize(wxMax(1, rect.width/downscale),
+                                    wxMax(1, rect.height/downscale)));
+    }
+
+    return true;
+}
+
 int wxTIFFHandler::DoGetImageCount( wxInputStream& stream )
 {
     TIFF *tif = TIFFwxOpen( stream, "image", "r" );
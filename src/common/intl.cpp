@@ -197,6 +197,71 @@ wxString wxLanguageInfo::GetLocaleName() const
 static wxLanguageInfos gs_languagesDB;
 static bool gs_languagesDBInitialized = false;
 
+namespace
+{
+
+// Indices into gs_languagesDB used to avoid linear searches over its
+// hundreds of entries: one maps the wxLanguage code, the others the
+// lower-cased canonical name/description and the language part of the
+// canonical name (e.g. "fr" for "fr_FR"). They're built on first use and
+// kept in sync by AddLanguage().
+WX_DECLARE_HASH_MAP(int, size_t, wxIntegerHash, wxIntegerEqual,
+                    wxLanguageIndexByCode);
+WX_DECLARE_STRING_HASH_MAP(size_t, wxLanguageIndexByName);
+
+wxLanguageIndexByCode gs_languageIndexByCode;
+wxLanguageIndexByName gs_languageIndexByName;
+wxLanguageIndexByName gs_languageIndexByPrefix;
+bool gs_languageIndexValid = false;
+
+// add the entry at the given index to the indices, keeping the first of any
+// duplicates to match the behaviour of the old linear searches
+void IndexLanguageEntry(size_t n)
+{
+    const wxLanguageInfo& info = gs_languagesDB[n];
+
+    if ( gs_languageIndexByCode.find(info.Language) ==
+            gs_languageIndexByCode.end() )
+        gs_languageIndexByCode[info.Language] = n;
+
+    const wxString canonical = info.CanonicalName.Lower();
+    if ( gs_languageIndexByName.find(canonical) ==
+            gs_languageIndexByName.end() )
+        gs_languageIndexByName[canonical] = n;
+
+    const wxString description = info.Description.Lower();
+    if ( gs_languageIndexByName.find(description) ==
+            gs_languageIndexByName.end() )
+        gs_languageIndexByName[description] = n;
+
+    const wxString prefix = canonical.BeforeFirst(wxS('_'));
+    if ( gs_languageIndexByPrefix.find(prefix) ==
+            gs_languageIndexByPrefix.end() )
+        gs_languageIndexByPrefix[prefix] = n;
+}
+
+void EnsureLanguageIndex()
+{
+    if ( gs_languageIndexValid )
+        return;
+
+    gs_languageIndexValid = true;
+
+    const size_t count = gs_languagesDB.size();
+    for ( size_t n = 0; n < count; n++ )
+        IndexLanguageEntry(n);
+}
+
+void ClearLanguageIndex()
+{
+    gs_languageIndexByCode.clear();
+    gs_languageIndexByName.clear();
+    gs_languageIndexByPrefix.clear();
+    gs_languageIndexValid = false;
+}
+
+} // anonymous namespace
+
 const wxLanguageInfos& wxGetLanguageInfos()
 {
     wxLocale::CreateLanguagesDB();
@@ -219,6 +284,7 @@ const wxLanguageInfos& wxGetLanguageInfos()
     if (gs_languagesDBInitialized)
     {
         gs_languagesDB.clear();
+        ClearLanguageIndex();
         gs_languagesDBInitialized = false;
     }
 }
@@ -851,6 +917,9 @@ void wxLocale::AddLanguage(const wxLanguageInfo& info)
 {
     CreateLanguagesDB();
     gs_languagesDB.push_back(info);
+
+    if ( gs_languageIndexValid )
+        IndexLanguageEntry(gs_languagesDB.size() - 1);
 }
 
 /* static */
@@ -866,14 +935,13 @@ const wxLanguageInfo *wxLocale::GetLanguageInfo(int lang)
     if ( lang == wxLANGUAGE_UNKNOWN )
         return NULL;
 
-    const size_t count = gs_languagesDB.size();
-    for ( size_t i = 0; i < count; i++ )
-    {
-        if ( gs_languagesDB[i].Language == lang )
-            return &gs_languagesDB[i];
-    }
+    EnsureLanguageIndex();
 
-    return NULL;
+    wxLanguageIndexByCode::const_iterator
+        it = gs_languageIndexByCode.find(lang);
+
+    return it == gs_languageIndexByCode.end() ? NULL
+                                              : &gs_languagesDB[it->second];
 }
 
 /* static */
@@ -910,36 +978,24 @@ wxString wxLocale::GetLanguageCanonicalName(int lang)
 const wxLanguageInfo *wxLocale::FindLanguageInfo(const wxString& locale)
 {
     CreateLanguagesDB();
+    EnsureLanguageIndex();
 
-    const wxLanguageInfo *infoRet = NULL;
+    const wxString key = locale.Lower();
 
-    const size_t count = gs_languagesDB.size();
-    for ( size_t i = 0; i < count; i++ )
-    {
-        const wxLanguageInfo *info = &gs_languagesDB[i];
+    // first look for an exact match of the canonical name or description
+    wxLanguageIndexByName::const_iterator
+        it = gs_languageIndexByName.find(key);
+    if ( it != gs_languageIndexByName.end() )
+        return &gs_languagesDB[it->second];
 
-        if ( wxStricmp(locale, info->CanonicalName) == 0 ||
-                wxStricmp(locale, info->Description) == 0 )
-        {
-            // exact match, stop searching
-            infoRet = info;
-            break;
-        }
-
-        if ( wxStricmp(locale, info->CanonicalName.BeforeFirst(wxS('_'))) == 0 )
-        {
-            // a match -- but maybe we'll find an exact one later, so continue
-            // looking
-            //
-            // OTOH, maybe we had already found a language match and in this
-            // case don't overwrite it because the entry for the default
-            // country always appears first in gs_languagesDB
-            if ( !infoRet )
-                infoRet = info;
-        }
-    }
+    // fall back to matching just the language: the index maps each language
+    // to the entry for its default country, which always appears first in
+    // gs_languagesDB
+    it = gs_languageIndexByPrefix.find(key);
+    if ( it != gs_languageIndexByPrefix.end() )
+        return &gs_languagesDB[it->second];
 
-    return infoRet;
+    return NULL;
 }
 
 wxString wxLocale::GetSysName() const
@@ -38,6 +38,7 @@
 #include "wx/msgout.h"
 #include "wx/textfile.h"
 #include "wx/thread.h"
+#include "wx/msgqueue.h"
 #include "wx/private/threadinfo.h"
 #include "wx/crt.h"
 #include "wx/vector.h"
@@ -873,6 +874,46 @@ void wxLogBuffer::DoLogTextAtLevel(wxLogLevel level, const wxString& msg)
     }
 }
 
+// ----------------------------------------------------------------------------
+// wxLogRingBuffer implementation
+// ----------------------------------------------------------------------------
+
+const wxLogRecord& wxLogRingBuffer::GetRecord(size_t n) const
+{
+    wxASSERT_MSG( n < m_records.size(),
+                  wxS("invalid wxLogRingBuffer record index") );
+
+    // m_next is the index of the oldest record once the buffer has wrapped
+    // and 0, making this a no-op, before it does
+    return m_records[(m_next + n) % m_records.size()];
+}
+
+void wxLogRingBuffer::Clear()
+{
+    m_records.clear();
+    m_next = 0;
+}
+
+void wxLogRingBuffer::DoLogRecord(wxLogLevel level,
+                                  const wxString& msg,
+                                  const wxLogRecordInfo& info)
+{
+    const wxLogRecord rec(level, msg, info);
+
+    if ( m_records.size() < m_maxRecords )
+    {
+        m_records.push_back(rec);
+    }
+    else // buffer full, overwrite the oldest record
+    {
+        m_records[m_next] = rec;
+        if ( ++m_next == m_maxRecords )
+            m_next = 0;
+    }
+
+    OnRecordAdded();
+}
+
 // ----------------------------------------------------------------------------
 // wxLogStderr class implementation
 // ----------------------------------------------------------------------------
@@ -1018,6 +1059,234 @@ wxLogInterposerTemp::wxLogInterposerTemp()
     #pragma warning(default:4355)
 #endif // VC++
 
+#if wxUSE_THREADS
+
+// ----------------------------------------------------------------------------
+// wxLogAsync
+// ----------------------------------------------------------------------------
+
+// an entry of the wxLogAsync queue: either a log record or a control message
+// for the worker thread
+struct wxLogAsyncMessage
+{
+    enum Type
+    {
+        Type_Record,    // write out the record
+        Type_Flush,     // flush the target and post to the semaphore
+        Type_Quit       // exit the worker thread
+    };
+
+    wxLogAsyncMessage() : type(Type_Quit), record(NULL), done(NULL) { }
+
+    explicit wxLogAsyncMessage(wxLogRecord *record_)
+        : type(Type_Record), record(record_), done(NULL)
+    {
+    }
+
+    explicit wxLogAsyncMessage(wxSemaphore *done_)
+        : type(Type_Flush), record(NULL), done(done_)
+    {
+    }
+
+    Type type;
+    wxLogRecord *record;    // owned by the consumer, for Type_Record only
+    wxSemaphore *done;      // owned by the caller, for Type_Flush only
+};
+
+// the worker thread of wxLogAsync: receives the records via a bounded queue
+// and hands them over to the real log target
+class wxLogAsyncThread : public wxThread
+{
+public:
+    wxLogAsyncThread(wxLog *target, size_t capacity, wxLogAsync::Overflow overflow)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_target(target),
+          m_capacity(capacity),
+          m_overflow(overflow),
+          m_numQueued(0),
+          m_numDropped(0),
+          m_semNotFull(0, 0)
+    {
+    }
+
+    // called from the producer threads, applies the overflow policy; takes
+    // ownership of the record
+    void Enqueue(wxLogRecord *record)
+    {
+        for ( ;; )
+        {
+            {
+                wxCriticalSectionLocker lock(m_cs);
+
+                if ( (size_t)m_numQueued < m_capacity )
+                {
+                    // if anything was dropped before, account for it now
+                    // that we have space again
+                    if ( m_numDropped )
+                    {
+                        wxLogRecordInfo info;
+                        m_queue.Post(wxLogAsyncMessage(new wxLogRecord
+                            (
+                                wxLOG_Warning,
+                                wxString::Format
+                                (
+                                    wxS("%lu log messages were dropped."),
+                                    (unsigned long)m_numDropped
+                                ),
+                                info
+                            )));
+                        m_numDropped = 0;
+                        m_numQueued++;
+                    }
+
+                    m_numQueued++;
+                    m_queue.Post(wxLogAsyncMessage(record));
+                    return;
+                }
+
+                if ( m_overflow == wxLogAsync::Overflow_Drop )
+                {
+                    m_numDropped++;
+                    delete record;
+                    return;
+                }
+            }
+
+            // Overflow_Wait: wait for the worker to make space, the
+            // semaphore is posted to whenever the queue shrinks below the
+            // capacity
+            m_semNotFull.Wait();
+        }
+    }
+
+    // write out everything queued so far and flush the target, doesn't
+    // return before it's done
+    void FlushTarget()
+    {
+        wxSemaphore done;
+        m_queue.Post(wxLogAsyncMessage(&done));
+        done.Wait();
+    }
+
+    // make the thread exit after writing out all queued records, the caller
+    // must Wait() for it afterwards
+    void Quit()
+    {
+        m_queue.Post(wxLogAsyncMessage());
+    }
+
+protected:
+    virtual ExitCode Entry() wxOVERRIDE
+    {
+        for ( ;; )
+        {
+            wxLogAsyncMessage msg;
+            if ( m_queue.Receive(msg) != wxMSGQUEUE_NO_ERROR )
+                break;
+
+            switch ( msg.type )
+            {
+                case wxLogAsyncMessage::Type_Record:
+                    {
+                        wxCriticalSectionLocker lock(m_cs);
+                        m_numQueued--;
+                    }
+                    if ( m_overflow == wxLogAsync::Overflow_Wait )
+                        m_semNotFull.Post();
+
+                    m_target->LogRecord(msg.record->level,
+                                        msg.record->msg,
+                                        msg.record->info);
+                    delete msg.record;
+                    break;
+
+                case wxLogAsyncMessage::Type_Flush:
+                    m_target->Flush();
+                    msg.done->Post();
+                    break;
+
+                case wxLogAsyncMessage::Type_Quit:
+                    return NULL;
+            }
+        }
+
+        return NULL;
+    }
+
+private:
+    wxLog* const m_target;
+    const size_t m_capacity;
+    const wxLogAsync::Overflow m_overflow;
+
+    // the queue itself is unbounded, we enforce m_capacity ourselves in
+    // Enqueue() to be able to implement the overflow policies
+    wxMessageQueue<wxLogAsyncMessage> m_queue;
+
+    // protects m_numQueued and m_numDropped
+    wxCriticalSection m_cs;
+    long m_numQueued;
+    long m_numDropped;
+
+    // used with Overflow_Wait only
+    wxSemaphore m_semNotFull;
+
+    wxDECLARE_NO_COPY_CLASS(wxLogAsyncThread);
+};
+
+wxLogAsync::wxLogAsync(wxLog *target, size_t capacity, Overflow overflow)
+          : m_target(target)
+{
+    wxASSERT_MSG( target, wxS("wxLogAsync target can't be NULL") );
+
+    m_thread = new wxLogAsyncThread(target, capacity, overflow);
+    if ( m_thread->Run() != wxTHREAD_NO_ERROR )
+    {
+        wxDELETE(m_thread);
+    }
+}
+
+wxLogAsync::~wxLogAsync()
+{
+    if ( m_thread )
+    {
+        m_thread->Quit();
+        m_thread->Wait();
+        delete m_thread;
+    }
+
+    delete m_target;
+}
+
+void wxLogAsync::Flush()
+{
+    if ( m_thread )
+        m_thread->FlushTarget();
+    else
+        m_target->Flush();
+}
+
+void wxLogAsync::DoLogRecord(wxLogLevel level,
+                             const wxString& msg,
+                             const wxLogRecordInfo& info)
+{
+    if ( !m_thread )
+    {
+        // creating the worker thread failed for some reason, degrade to
+        // synchronous logging instead of losing the messages
+        m_target->LogRecord(level, msg, info);
+        return;
+    }
+
+    m_thread->Enqueue(new wxLogRecord(level, msg, info));
+
+    // a fatal error usually means the program is about to terminate, so
+    // make sure the message is actually written out before this happens
+    if ( level == wxLOG_FatalError )
+        Flush();
+}
+
+#endif // wxUSE_THREADS
+
 // ============================================================================
 // Global functions/variables
 // ============================================================================
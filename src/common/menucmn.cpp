@@ -378,6 +378,11 @@ wxMenuItem* wxMenuBase::DoAppend(wxMenuItem *item)
         AddSubMenu(item->GetSubMenu());
     }
 
+#if wxUSE_MENUBAR
+    if ( wxMenuBar* const menubar = GetMenuBar() )
+        menubar->InvalidateFindItemCache();
+#endif // wxUSE_MENUBAR
+
     return item;
 }
 
@@ -412,6 +417,11 @@ wxMenuItem* wxMenuBase::DoInsert(size_t pos, wxMenuItem *item)
         AddSubMenu(item->GetSubMenu());
     }
 
+#if wxUSE_MENUBAR
+    if ( wxMenuBar* const menubar = GetMenuBar() )
+        menubar->InvalidateFindItemCache();
+#endif // wxUSE_MENUBAR
+
     return item;
 }
 
@@ -433,6 +443,11 @@ wxMenuItem *wxMenuBase::Remove(wxMenuItem *item)
     // DetachNode() here!)
     m_items.Erase(node);
 
+#if wxUSE_MENUBAR
+    if ( wxMenuBar* const menubar = GetMenuBar() )
+        menubar->InvalidateFindItemCache();
+#endif // wxUSE_MENUBAR
+
     return item2;
 }
 
@@ -868,6 +883,9 @@ wxMenuBarBase::wxMenuBarBase()
 {
     // not attached yet
     m_menuBarFrame = NULL;
+
+    // the item lookup map is only filled on demand
+    m_itemsByIdValid = false;
 }
 
 wxMenuBarBase::~wxMenuBarBase()
@@ -896,6 +914,8 @@ bool wxMenuBarBase::Append(wxMenu *menu, const wxString& title)
     m_menus.Append(menu);
     menu->Attach(this);
 
+    InvalidateFindItemCache();
+
     return true;
 }
 
@@ -916,6 +936,8 @@ bool wxMenuBarBase::Insert(size_t pos, wxMenu *menu,
         m_menus.Insert(node, menu);
         menu->Attach(this);
 
+        InvalidateFindItemCache();
+
         return true;
     }
 }
@@ -934,6 +956,8 @@ wxMenu *wxMenuBarBase::Replace(size_t pos, wxMenu *menu,
     menu->Attach(this);
     menuOld->Detach();
 
+    InvalidateFindItemCache();
+
     return menuOld;
 }
 
@@ -946,6 +970,8 @@ wxMenu *wxMenuBarBase::Remove(size_t pos)
     m_menus.Erase(node);
     menu->Detach();
 
+    InvalidateFindItemCache();
+
     return menu;
 }
 
@@ -993,19 +1019,45 @@ void wxMenuBarBase::Detach()
 // wxMenuBar searching for items
 // ----------------------------------------------------------------------------
 
-wxMenuItem *wxMenuBarBase::FindItem(int itemid, wxMenu **menu) const
+void wxMenuBarBase::DoCacheMenuItems(const wxMenuBase *menu) const
 {
-    if ( menu )
-        *menu = NULL;
+    for ( wxMenuItemList::compatibility_iterator
+            node = menu->GetMenuItems().GetFirst();
+          node;
+          node = node->GetNext() )
+    {
+        wxMenuItem* const item = node->GetData();
 
-    wxMenuItem *item = NULL;
-    size_t count = GetMenuCount(), i;
-    wxMenuList::const_iterator it;
-    for ( i = 0, it = m_menus.begin(); !item && (i < count); i++, ++it )
+        // in case of (bogus, but possible) duplicate ids keep the first item
+        // found, as the linear search over the menus used to do
+        if ( m_itemsById.find(item->GetId()) == m_itemsById.end() )
+            m_itemsById[item->GetId()] = item;
+
+        if ( item->IsSubMenu() )
+            DoCacheMenuItems(item->GetSubMenu());
+    }
+}
+
+wxMenuItem *wxMenuBarBase::FindItem(int itemid, wxMenu **menu) const
+{
+    if ( !m_itemsByIdValid )
     {
-        item = (*it)->FindItem(itemid, menu);
+        for ( wxMenuList::const_iterator it = m_menus.begin();
+              it != m_menus.end();
+              ++it )
+        {
+            DoCacheMenuItems(*it);
+        }
+
+        m_itemsByIdValid = true;
     }
 
+    const wxMenuItemIdMap::const_iterator it = m_itemsById.find(itemid);
+    wxMenuItem* const item = it == m_itemsById.end() ? NULL : it->second;
+
+    if ( menu )
+        *menu = item ? item->GetMenu() : NULL;
+
     return item;
 }
 
@@ -20,6 +20,8 @@
     #include "wx/log.h"
 #endif
 
+#include "wx/hashmap.h"
+
 #define TRACE_MODULE wxT("module")
 
 wxIMPLEMENT_ABSTRACT_CLASS(wxModule, wxObject)
@@ -27,10 +29,18 @@ wxIMPLEMENT_ABSTRACT_CLASS(wxModule, wxObject)
 wxModuleList wxModule::ms_modules;
 bool wxModule::ms_areInitialized = false;
 
+// map allowing to find a registered module from its class info in O(1)
+// instead of scanning the whole modules list every time
+WX_DECLARE_HASH_MAP(wxClassInfo*, wxModule*,
+                    wxPointerHash, wxPointerEqual, wxModuleByClassMap);
+
+static wxModuleByClassMap gs_modulesByClass;
+
 void wxModule::RegisterModule(wxModule* module)
 {
     module->m_state = State_Registered;
     ms_modules.push_back(module);
+    gs_modulesByClass[module->GetClassInfo()] = module;
 }
 
 void wxModule::UnregisterModule(wxModule* module)
@@ -46,6 +56,8 @@ void wxModule::UnregisterModule(wxModule* module)
         }
     }
 
+    gs_modulesByClass.erase(module->GetClassInfo());
+
     delete module;
 }
 
@@ -93,43 +105,26 @@ bool wxModule::DoInitializeModule(wxModule *module,
     {
         wxClassInfo * cinfo = dependencies[i];
 
-        // Check if the module is already initialized
-        wxModuleList::const_iterator it;
-        for ( it = initializedModules.begin();
-              it != initializedModules.end();
-              ++it )
+        // find the module in the registered modules map
+        const wxModuleByClassMap::iterator it = gs_modulesByClass.find(cinfo);
+        if ( it == gs_modulesByClass.end() )
         {
-            if ( (*it)->GetClassInfo() == cinfo )
-                break;
+            wxLogError(_("Dependency \"%s\" of module \"%s\" doesn't exist."),
+                       cinfo->GetClassName(),
+                       module->GetClassInfo()->GetClassName());
+            return false;
         }
 
-        if ( it != initializedModules.end() )
+        wxModule * const moduleDep = it->second;
+        if ( moduleDep->m_state == State_Initialized )
         {
             // this dependency is already initialized, nothing to do
             continue;
         }
 
-        // find the module in the registered modules list
-        for ( it = ms_modules.begin(); it != ms_modules.end(); ++it )
-        {
-            wxModule *moduleDep = *it;
-            if ( moduleDep->GetClassInfo() == cinfo )
-            {
-                if ( !DoInitializeModule(moduleDep, initializedModules ) )
-                {
-                    // failed to initialize a dependency, so fail this one too
-                    return false;
-                }
-
-                break;
-            }
-        }
-
-        if ( it == ms_modules.end() )
+        if ( !DoInitializeModule(moduleDep, initializedModules ) )
         {
-            wxLogError(_("Dependency \"%s\" of module \"%s\" doesn't exist."),
-                       cinfo->GetClassName(),
-                       module->GetClassInfo()->GetClassName());
+            // failed to initialize a dependency, so fail this one too
             return false;
         }
     }
@@ -161,6 +156,11 @@ bool wxModule::InitializeModules()
     {
         wxModule *module = *it;
 
+        // on demand modules are only initialized when actually used, by
+        // EnsureInitialized() (or as dependencies of other modules)
+        if ( module->m_lazy )
+            continue;
+
         // the module could have been already initialized as dependency of
         // another one
         if ( module->m_state == State_Registered )
@@ -176,6 +176,17 @@ bool wxModule::InitializeModules()
         }
     }
 
+    // the on demand modules which weren't initialized even as dependencies
+    // must be kept too: EnsureInitialized() may still initialize them later
+    // and they must be deleted during cleanup in any case
+    for ( wxModuleList::const_iterator it = ms_modules.begin();
+          it != ms_modules.end();
+          ++it )
+    {
+        if ( (*it)->m_state == State_Registered )
+            initializedModules.push_back(*it);
+    }
+
     // remember the real initialisation order
     ms_modules = initializedModules;
 
@@ -200,13 +211,18 @@ void wxModule::DoCleanUpModules(const wxModuleList& modules)
           rit != modules.rend();
           ++rit )
     {
-        wxLogTrace(TRACE_MODULE, wxT("Cleanup module %s"),
-                   (*rit)->GetClassInfo()->GetClassName());
-
         wxModule * module = *rit;
 
-        wxASSERT_MSG( module->m_state == State_Initialized,
-                        wxT("not initialized module being cleaned up") );
+        if ( module->m_state != State_Initialized )
+        {
+            // on demand modules which were never used don't need cleanup
+            wxASSERT_MSG( module->m_lazy,
+                            wxT("not initialized module being cleaned up") );
+            continue;
+        }
+
+        wxLogTrace(TRACE_MODULE, wxT("Cleanup module %s"),
+                   module->GetClassInfo()->GetClassName());
 
         module->Exit();
         module->m_state = State_Registered;
@@ -221,6 +237,66 @@ void wxModule::DoCleanUpModules(const wxModuleList& modules)
     }
 
     ms_modules.clear();
+    gs_modulesByClass.clear();
+}
+
+bool wxModule::EnsureInitialized(wxClassInfo *classInfo)
+{
+    wxCHECK_MSG( classInfo, false, wxT("NULL module class info") );
+    wxCHECK_MSG( ms_areInitialized, false,
+                 wxT("modules not initialized yet, is wxWidgets initialized?") );
+
+    const wxModuleByClassMap::iterator it = gs_modulesByClass.find(classInfo);
+    if ( it == gs_modulesByClass.end() )
+    {
+        wxLogError(_("Module \"%s\" doesn't exist."),
+                   classInfo->GetClassName());
+        return false;
+    }
+
+    wxModule * const module = it->second;
+    if ( module->m_state == State_Initialized )
+        return true;
+
+    wxModuleList initializedModules;
+    if ( !DoInitializeModule(module, initializedModules) )
+    {
+        // unlike during startup, a failure here is not fatal, so just undo
+        // the partial initialization instead of cleaning everything up
+        for ( wxModuleList::reverse_iterator rit =
+                initializedModules.rbegin();
+              rit != initializedModules.rend();
+              ++rit )
+        {
+            (*rit)->Exit();
+            (*rit)->m_state = State_Registered;
+        }
+
+        return false;
+    }
+
+    // move the newly initialized modules to the end of ms_modules, keeping
+    // their initialization order, so that the cleanup still happens in the
+    // reverse order of initialization
+    for ( wxModuleList::const_iterator itNew = initializedModules.begin();
+          itNew != initializedModules.end();
+          ++itNew )
+    {
+        for ( wxModuleList::iterator itOld = ms_modules.begin();
+              itOld != ms_modules.end();
+              ++itOld )
+        {
+            if ( *itOld == *itNew )
+            {
+                ms_modules.erase(itOld);
+                break;
+            }
+        }
+
+        ms_modules.push_back(*itNew);
+    }
+
+    return true;
 }
 
 bool wxModule::ResolveNamedDependencies()
@@ -30,6 +30,17 @@
 
 #include <stdlib.h>
 
+#ifdef wxHAS_MAPPED_INPUT_STREAM
+    #ifdef __WINDOWS__
+        #include "wx/msw/wrapwin.h"
+    #else // __UNIX__
+        #include <sys/mman.h>
+        #include <sys/stat.h>
+        #include <fcntl.h>
+        #include <unistd.h>
+    #endif
+#endif // wxHAS_MAPPED_INPUT_STREAM
+
 // ============================================================================
 // implementation
 // ============================================================================
@@ -41,6 +52,11 @@
 wxIMPLEMENT_ABSTRACT_CLASS(wxMemoryInputStream, wxInputStream);
 
 wxMemoryInputStream::wxMemoryInputStream(const void *data, size_t len)
+{
+    InitBuffer(data, len);
+}
+
+void wxMemoryInputStream::InitBuffer(const void *data, size_t len)
 {
     m_i_streambuf = new wxStreamBuffer(wxStreamBuffer::read);
     m_i_streambuf->SetBufferIO(const_cast<void *>(data), len);
@@ -145,6 +161,168 @@ wxFileOffset wxMemoryInputStream::OnSysTell() const
     return m_i_streambuf->Tell();
 }
 
+// ----------------------------------------------------------------------------
+// wxMappedInputStream
+// ----------------------------------------------------------------------------
+
+#ifdef wxHAS_MAPPED_INPUT_STREAM
+
+wxIMPLEMENT_ABSTRACT_CLASS(wxMappedInputStream, wxMemoryInputStream);
+
+wxMappedInputStream::wxMappedInputStream(const wxString& filename)
+{
+    m_addr = NULL;
+    m_mapLength = 0;
+#ifdef __WINDOWS__
+    m_hFile = INVALID_HANDLE_VALUE;
+    m_hMapping = NULL;
+#endif
+
+    // assume failure until everything below succeeds
+    m_lasterror = wxSTREAM_READ_ERROR;
+
+#ifdef __WINDOWS__
+    m_hFile = ::CreateFile(filename.t_str(), GENERIC_READ, FILE_SHARE_READ,
+                           NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if ( m_hFile == INVALID_HANDLE_VALUE )
+        return;
+
+    LARGE_INTEGER size;
+    if ( !::GetFileSizeEx(m_hFile, &size) )
+        return;
+
+    const wxFileOffset lenFile = size.QuadPart;
+    const size_t len = wx_truncate_cast(size_t, lenFile);
+    if ( (wxFileOffset)len != lenFile )
+        return; // file too big to be mapped into our address space
+
+    if ( len == 0 )
+    {
+        // an empty file can't be mapped but the stream is still valid
+        InitBuffer(NULL, 0);
+        m_lasterror = wxSTREAM_NO_ERROR;
+        return;
+    }
+
+    m_hMapping = ::CreateFileMapping(m_hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    if ( !m_hMapping )
+        return;
+
+    m_addr = ::MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0);
+    if ( !m_addr )
+        return;
+
+    m_mapLength = len;
+#else // __UNIX__
+    const int fd = open(filename.fn_str(), O_RDONLY);
+    if ( fd == -1 )
+        return;
+
+    struct stat st;
+    if ( fstat(fd, &st) == -1 || !S_ISREG(st.st_mode) )
+    {
+        close(fd);
+        return;
+    }
+
+    const wxFileOffset lenFile = st.st_size;
+    const size_t len = wx_truncate_cast(size_t, lenFile);
+    if ( (wxFileOffset)len != lenFile )
+    {
+        close(fd);
+        return; // file too big to be mapped into our address space
+    }
+
+    if ( len == 0 )
+    {
+        // an empty file can't be mapped but the stream is still valid
+        close(fd);
+        InitBuffer(NULL, 0);
+        m_lasterror = wxSTREAM_NO_ERROR;
+        return;
+    }
+
+    void * const addr = mmap(NULL, len, PROT_READ, MAP_SHARED, fd, 0);
+
+    // the mapping remains valid after the descriptor is closed
+    close(fd);
+
+    if ( addr == MAP_FAILED )
+        return;
+
+    m_addr = addr;
+    m_mapLength = len;
+#endif // __WINDOWS__/__UNIX__
+
+    InitBuffer(m_addr, m_mapLength);
+    m_lasterror = wxSTREAM_NO_ERROR;
+}
+
+wxMappedInputStream::~wxMappedInputStream()
+{
+    Unmap();
+}
+
+void wxMappedInputStream::Advise(wxMappedAccess access)
+{
+    if ( !m_addr )
+        return;
+
+#if defined(__UNIX__) && defined(POSIX_MADV_NORMAL)
+    int advice;
+    switch ( access )
+    {
+        case wxMAPPED_ACCESS_SEQUENTIAL:
+            advice = POSIX_MADV_SEQUENTIAL;
+            break;
+
+        case wxMAPPED_ACCESS_RANDOM:
+            advice = POSIX_MADV_RANDOM;
+            break;
+
+        case wxMAPPED_ACCESS_WILLNEED:
+            advice = POSIX_MADV_WILLNEED;
+            break;
+
+        default:
+            wxFAIL_MSG( wxT("unknown access pattern") );
+            wxFALLTHROUGH;
+
+        case wxMAPPED_ACCESS_NORMAL:
+            advice = POSIX_MADV_NORMAL;
+            break;
+    }
+
+    // this is just a hint, so ignore any errors
+    posix_madvise(m_addr, m_mapLength, advice);
+#else // !POSIX_MADV_NORMAL
+    wxUnusedVar(access);
+#endif
+}
+
+void wxMappedInputStream::Unmap()
+{
+#ifdef __WINDOWS__
+    if ( m_addr )
+        ::UnmapViewOfFile(m_addr);
+    if ( m_hMapping )
+        ::CloseHandle(m_hMapping);
+    if ( m_hFile != INVALID_HANDLE_VALUE )
+        ::CloseHandle(m_hFile);
+
+    m_hMapping = NULL;
+    m_hFile = INVALID_HANDLE_VALUE;
+#else // __UNIX__
+    if ( m_addr )
+        munmap(m_addr, m_mapLength);
+#endif // __WINDOWS__/__UNIX__
+
+    m_addr = NULL;
+    m_mapLength = 0;
+}
+
+#endif // wxHAS_MAPPED_INPUT_STREAM
+
 // ----------------------------------------------------------------------------
 // wxMemoryOutputStream
 // ----------------------------------------------------------------------------
@@ -200,4 +378,126 @@ size_t wxMemoryOutputStream::CopyTo(void *buffer, size_t len) const
     return len;
 }
 
+// ----------------------------------------------------------------------------
+// wxMappedOutputStream
+// ----------------------------------------------------------------------------
+
+#ifdef wxHAS_MAPPED_INPUT_STREAM
+
+wxIMPLEMENT_ABSTRACT_CLASS(wxMappedOutputStream, wxMemoryOutputStream);
+
+wxMappedOutputStream::wxMappedOutputStream(const wxString& filename,
+                                           wxFileOffset len)
+{
+    m_addr = NULL;
+    m_mapLength = 0;
+#ifdef __WINDOWS__
+    m_hFile = INVALID_HANDLE_VALUE;
+    m_hMapping = NULL;
+#endif
+
+    // assume failure until everything below succeeds
+    m_lasterror = wxSTREAM_WRITE_ERROR;
+
+    // the buffer must be fixed as we can't grow the mapping if it
+    // overflows; do it before attempting to map so that writes to an
+    // invalid stream fail instead of silently going to a heap buffer
+    m_o_streambuf->Fixed(true);
+
+    const size_t size = wx_truncate_cast(size_t, len);
+    if ( len <= 0 || (wxFileOffset)size != len )
+        return; // invalid size or too big for our address space
+
+#ifdef __WINDOWS__
+    m_hFile = ::CreateFile(filename.t_str(), GENERIC_READ | GENERIC_WRITE, 0,
+                           NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if ( m_hFile == INVALID_HANDLE_VALUE )
+        return;
+
+    // this also extends the file to the given size
+    const wxUint64 len64 = len;
+    m_hMapping = ::CreateFileMapping(m_hFile, NULL, PAGE_READWRITE,
+                                     wxUint32(len64 >> 32), wxUint32(len64),
+                                     NULL);
+    if ( !m_hMapping )
+        return;
+
+    m_addr = ::MapViewOfFile(m_hMapping, FILE_MAP_WRITE, 0, 0, 0);
+    if ( !m_addr )
+        return;
+
+    m_mapLength = size;
+#else // __UNIX__
+    const int fd = open(filename.fn_str(),
+                        O_RDWR | O_CREAT | O_TRUNC, 0666);
+    if ( fd == -1 )
+        return;
+
+    // preallocate the file as we can't map anything beyond its end
+    if ( ftruncate(fd, len) == -1 )
+    {
+        close(fd);
+        return;
+    }
+
+    void * const addr = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                             MAP_SHARED, fd, 0);
+
+    // the mapping remains valid after the descriptor is closed
+    close(fd);
+
+    if ( addr == MAP_FAILED )
+        return;
+
+    m_addr = addr;
+    m_mapLength = size;
+#endif // __WINDOWS__/__UNIX__
+
+    // make the base class stream write directly into the mapping (the
+    // buffer is not owned by the stream, so it won't try to free it)
+    m_o_streambuf->SetBufferIO(m_addr, m_mapLength);
+
+    m_lasterror = wxSTREAM_NO_ERROR;
+}
+
+wxMappedOutputStream::~wxMappedOutputStream()
+{
+    Unmap();
+}
+
+bool wxMappedOutputStream::Flush()
+{
+    if ( !m_addr )
+        return false;
+
+#ifdef __WINDOWS__
+    return ::FlushViewOfFile(m_addr, 0) != 0;
+#else // __UNIX__
+    return msync(m_addr, m_mapLength, MS_SYNC) == 0;
+#endif // __WINDOWS__/__UNIX__
+}
+
+void wxMappedOutputStream::Unmap()
+{
+#ifdef __WINDOWS__
+    if ( m_addr )
+        ::UnmapViewOfFile(m_addr);
+    if ( m_hMapping )
+        ::CloseHandle(m_hMapping);
+    if ( m_hFile != INVALID_HANDLE_VALUE )
+        ::CloseHandle(m_hFile);
+
+    m_hMapping = NULL;
+    m_hFile = INVALID_HANDLE_VALUE;
+#else // __UNIX__
+    if ( m_addr )
+        munmap(m_addr, m_mapLength);
+#endif // __WINDOWS__/__UNIX__
+
+    m_addr = NULL;
+    m_mapLength = 0;
+}
+
+#endif // wxHAS_MAPPED_INPUT_STREAM
+
 #endif // wxUSE_STREAMS
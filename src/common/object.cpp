@@ -335,7 +335,11 @@ void wxRefCounter::DecRef()
 {
     wxASSERT_MSG( m_count > 0, "invalid ref data count" );
 
+#ifdef wxHAS_ATOMIC_REF_COUNT
+    if ( wxAtomicDec(m_count) == 0 )
+#else
     if ( --m_count == 0 )
+#endif
         delete this;
 }
 
@@ -159,27 +159,65 @@ void wxOverlayImpl::Init( wxDC* dc, int x , int y , int width , int height )
     dcMem.Blit(0, 0, m_width, m_height,
         dc, x, y);
     dcMem.SelectObject( wxNullBitmap );
+
+    m_rectDrawn = wxRect();
 }
 
 void wxOverlayImpl::Clear(wxDC* dc)
 {
-    wxMemoryDC dcMem ;
-    dcMem.SelectObject( m_bmpSaved );
-    dc->Blit( m_x, m_y, m_width, m_height , &dcMem , 0 , 0 );
-    dcMem.SelectObject( wxNullBitmap );
+    // Restore only the area drawn over since the last call: for the typical
+    // rubber band or crosshair overlays this is a tiny part of a possibly
+    // very big window and copying the entire saved bitmap back on every
+    // mouse move would dwarf the cost of the drawing itself.
+    wxRect rect(m_rectDrawn);
+    rect.Intersect(wxRect(m_x, m_y, m_width, m_height));
+    if ( !rect.IsEmpty() )
+    {
+        wxMemoryDC dcMem ;
+        dcMem.SelectObject( m_bmpSaved );
+        dc->Blit( rect.x, rect.y, rect.width, rect.height, &dcMem,
+                  rect.x - m_x, rect.y - m_y );
+        dcMem.SelectObject( wxNullBitmap );
+    }
+
+    m_rectDrawn = wxRect();
+
+    // Start tracking the extent of the new drawing, see EndDrawing().
+    dc->ResetBoundingBox();
 }
 
 void wxOverlayImpl::Reset()
 {
     m_bmpSaved = wxBitmap();
+    m_rectDrawn = wxRect();
 }
 
-void wxOverlayImpl::BeginDrawing(wxDC*  WXUNUSED(dc))
+void wxOverlayImpl::BeginDrawing(wxDC* dc)
 {
+    // Drawing without calling Clear() first must be tracked too, so reset
+    // the bounding box here as well and not only in Clear().
+    dc->ResetBoundingBox();
 }
 
-void wxOverlayImpl::EndDrawing(wxDC* WXUNUSED(dc))
+void wxOverlayImpl::EndDrawing(wxDC* dc)
 {
+    // Remember the extent of the drawing done since BeginDrawing() so that
+    // the next Clear() can restore just this area. The bounding box tracks
+    // the coordinates passed to the drawing functions, not the pixels they
+    // actually touch, so grow it to account for the pen width (the pen still
+    // selected into the dc is our best guess) and for anti-aliasing.
+    wxRect rect(wxPoint(dc->MinX(), dc->MinY()),
+                wxPoint(dc->MaxX(), dc->MaxY()));
+
+    int slack = 2;
+    const wxPen& pen = dc->GetPen();
+    if ( pen.IsOk() && pen.GetWidth() > slack )
+        slack = pen.GetWidth();
+    rect.Inflate(slack);
+
+    // Accumulate in case the overlay is drawn on more than once before being
+    // cleared again.
+    m_rectDrawn.Union(rect);
 }
 
 #endif // !wxHAS_NATIVE_OVERLAY
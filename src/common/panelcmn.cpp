@@ -30,6 +30,8 @@
     #include "wx/containr.h"
 #endif
 
+#include "wx/lazypanel.h"
+
 // ----------------------------------------------------------------------------
 // XTI
 // ----------------------------------------------------------------------------
@@ -85,6 +87,8 @@ wxCONSTRUCTOR_6( wxPanel, wxWindow*, Parent, wxWindowID, Id, \
 // implementation
 // ============================================================================
 
+wxIMPLEMENT_ABSTRACT_CLASS(wxLazyPanel, wxPanel);
+
 // ----------------------------------------------------------------------------
 // wxPanelBase creation
 // ----------------------------------------------------------------------------
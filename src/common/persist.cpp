@@ -127,6 +127,53 @@ bool wxPersistenceManager::Restore(void *obj)
     return it->second->Restore();
 }
 
+void wxPersistenceManager::BeginSaveBatch()
+{
+    m_saveBatchDepth++;
+}
+
+void wxPersistenceManager::EndSaveBatch()
+{
+    wxCHECK_RET( m_saveBatchDepth, "EndSaveBatch() without BeginSaveBatch()" );
+
+    if ( --m_saveBatchDepth )
+        return;
+
+    if ( m_batchedValues.empty() )
+        return;
+
+    wxConfigBase* const conf = GetConfig();
+    if ( conf )
+    {
+        for ( wxPersistenceBatchedValuesMap::const_iterator
+                it = m_batchedValues.begin();
+              it != m_batchedValues.end();
+              ++it )
+        {
+            const wxPersistenceBatchedValue& value = it->second;
+            switch ( value.type )
+            {
+                case wxPersistenceBatchedValue::Type_Bool:
+                    conf->Write(it->first, value.numValue != 0);
+                    break;
+
+                case wxPersistenceBatchedValue::Type_Long:
+                    conf->Write(it->first, value.numValue);
+                    break;
+
+                case wxPersistenceBatchedValue::Type_String:
+                    conf->Write(it->first, value.strValue);
+                    break;
+            }
+        }
+
+        // flush only once for all the values written above
+        conf->Flush();
+    }
+
+    m_batchedValues.clear();
+}
+
 namespace
 {
 
@@ -144,6 +191,73 @@ DoRestoreValue(wxConfigBase *conf, const wxString& key, T *value)
     return conf && conf->Read(key, value);
 }
 
+// overloads storing a value of each supported type in the buffer used while
+// a save batch is active: the numeric values are all stored as long, just as
+// wxConfig itself does when writing them out
+inline void AssignBatchedValue(wxPersistenceBatchedValue& v, bool value)
+{
+    v.type = wxPersistenceBatchedValue::Type_Bool;
+    v.numValue = value ? 1 : 0;
+}
+
+inline void AssignBatchedValue(wxPersistenceBatchedValue& v, int value)
+{
+    v.type = wxPersistenceBatchedValue::Type_Long;
+    v.numValue = value;
+}
+
+inline void AssignBatchedValue(wxPersistenceBatchedValue& v, long value)
+{
+    v.type = wxPersistenceBatchedValue::Type_Long;
+    v.numValue = value;
+}
+
+inline void AssignBatchedValue(wxPersistenceBatchedValue& v,
+                               const wxString& value)
+{
+    v.type = wxPersistenceBatchedValue::Type_String;
+    v.strValue = value;
+}
+
+// counterparts of the above used by RestoreValue() so that the values not
+// yet written out are still visible to it, return false on type mismatch
+inline bool QueryBatchedValue(const wxPersistenceBatchedValue& v, bool *value)
+{
+    if ( v.type != wxPersistenceBatchedValue::Type_Bool )
+        return false;
+
+    *value = v.numValue != 0;
+    return true;
+}
+
+inline bool QueryBatchedValue(const wxPersistenceBatchedValue& v, int *value)
+{
+    if ( v.type != wxPersistenceBatchedValue::Type_Long )
+        return false;
+
+    *value = static_cast<int>(v.numValue);
+    return true;
+}
+
+inline bool QueryBatchedValue(const wxPersistenceBatchedValue& v, long *value)
+{
+    if ( v.type != wxPersistenceBatchedValue::Type_Long )
+        return false;
+
+    *value = v.numValue;
+    return true;
+}
+
+inline bool
+QueryBatchedValue(const wxPersistenceBatchedValue& v, wxString *value)
+{
+    if ( v.type != wxPersistenceBatchedValue::Type_String )
+        return false;
+
+    *value = v.strValue;
+    return true;
+}
+
 } // anonymous namespace
 
 #define wxPERSIST_DEFINE_SAVE_RESTORE_FOR(Type)                               \
@@ -151,6 +265,15 @@ DoRestoreValue(wxConfigBase *conf, const wxString& key, T *value)
                                          const wxString& name,                \
                                          Type value)                          \
     {                                                                         \
+        if ( m_saveBatchDepth )                                               \
+        {                                                                     \
+            if ( !GetConfig() )                                               \
+                return false;                                                 \
+                                                                              \
+            AssignBatchedValue(m_batchedValues[GetKey(who, name)], value);    \
+            return true;                                                      \
+        }                                                                     \
+                                                                              \
         return DoSaveValue(GetConfig(), GetKey(who, name), value);            \
     }                                                                         \
                                                                               \
@@ -158,6 +281,15 @@ DoRestoreValue(wxConfigBase *conf, const wxString& key, T *value)
                                             const wxString& name,             \
                                             Type *value)                      \
     {                                                                         \
+        if ( m_saveBatchDepth )                                               \
+        {                                                                     \
+            const wxPersistenceBatchedValuesMap::const_iterator               \
+                it = m_batchedValues.find(GetKey(who, name));                 \
+            if ( it != m_batchedValues.end() &&                               \
+                    QueryBatchedValue(it->second, value) )                    \
+                return true;                                                  \
+        }                                                                     \
+                                                                              \
         return DoRestoreValue(GetConfig(), GetKey(who, name), value);         \
     }
 
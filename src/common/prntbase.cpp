@@ -596,6 +596,7 @@ wxPrintout::wxPrintout(const wxString& title)
     m_PPIPrinterX = 0;
     m_PPIPrinterY = 0;
     m_preview = NULL;
+    m_bandHeight = 0;
 }
 
 wxPrintout::~wxPrintout()
@@ -625,6 +626,35 @@ bool wxPrintout::HasPage(int page)
     return (page == 1);
 }
 
+bool wxPrintout::PrintPage(int page)
+{
+    if ( m_bandHeight <= 0 )
+        return OnPrintPage(page);
+
+    wxDC * const dc = GetDC();
+    wxCHECK_MSG( dc, false, wxT("printout DC must be set before printing") );
+
+    // Print the page as a sequence of horizontal bands with the DC clipped
+    // to each band in turn: a backend rasterizing the page then only needs
+    // memory for a single band at a time, however high the resolution. The
+    // clipping region is set in device coordinates so that it keeps
+    // covering the same band even if OnPrintPage() changes the mapping.
+    bool cont = true;
+    for ( int y = 0; cont && y < m_pageHeightPixels; y += m_bandHeight )
+    {
+        m_bandRect = wxRect(0, y, m_pageWidthPixels,
+                            wxMin(m_bandHeight, m_pageHeightPixels - y));
+
+        dc->SetDeviceClippingRegion(wxRegion(m_bandRect));
+        cont = OnPrintPage(page);
+        dc->DestroyClippingRegion();
+    }
+
+    m_bandRect = wxRect();
+
+    return cont;
+}
+
 void wxPrintout::GetPageInfo(int *minPage, int *maxPage, int *fromPage, int *toPage)
 {
     *minPage = 1;
@@ -1864,6 +1894,9 @@ void wxPrintPreviewBase::Init(wxPrintout *printout,
     m_printingPrepared = false;
     m_minPage = 1;
     m_maxPage = 1;
+
+    // Enough for the current page and two pre-rendered pages on either side.
+    m_pageCacheSize = 5;
 }
 
 wxPrintPreviewBase::~wxPrintPreviewBase()
@@ -1953,7 +1986,12 @@ void wxPrintPreviewBase::InvalidatePreviewBitmap()
 bool wxPrintPreviewBase::UpdatePageRendering()
 {
     if ( m_previewBitmap )
+    {
+        // The shown page is up to date, so use the idle time to pre-render
+        // the pages adjacent to it instead, making flipping to them fast.
+        PreRenderAdjacentPage();
         return false;
+    }
 
     if ( m_previewFailed )
         return false;
@@ -2056,6 +2094,114 @@ bool wxPrintPreviewBase::RenderPageIntoBitmap(wxBitmap& bmp, int pageNum)
     return RenderPageIntoDC(memoryDC, pageNum);
 }
 
+size_t wxPrintPreviewBase::FindCachedPage(int pageNum, const wxSize& size) const
+{
+    size_t n;
+    for ( n = 0; n < m_pageCache.size(); n++ )
+    {
+        const CachedPage& entry = m_pageCache[n];
+        if ( entry.page == pageNum &&
+                entry.bitmap.GetWidth() == size.x &&
+                    entry.bitmap.GetHeight() == size.y )
+            break;
+    }
+
+    return n;
+}
+
+bool wxPrintPreviewBase::GetRenderedPage(int pageNum, const wxSize& size, wxBitmap& bmp)
+{
+    const size_t n = FindCachedPage(pageNum, size);
+    if ( n < m_pageCache.size() )
+    {
+        bmp = m_pageCache[n].bitmap;
+        return true;
+    }
+
+    // Drop any stale rendering of this page at a different size, e.g. left
+    // over from before a zoom or canvas size change.
+    for ( size_t i = 0; i < m_pageCache.size(); i++ )
+    {
+        if ( m_pageCache[i].page == pageNum )
+        {
+            m_pageCache.erase(m_pageCache.begin() + i);
+            break;
+        }
+    }
+
+    wxBitmap rendered(size.x, size.y);
+    if ( !rendered.IsOk() || !RenderPageIntoBitmap(rendered, pageNum) )
+        return false;
+
+    // Make room for the new page by evicting the one farthest from the
+    // current page, so that jumping to a distant page quickly repopulates
+    // the cache with its new neighbours.
+    while ( m_pageCache.size() >= (size_t)m_pageCacheSize )
+    {
+        size_t farthest = 0;
+        for ( size_t i = 1; i < m_pageCache.size(); i++ )
+        {
+            if ( abs(m_pageCache[i].page - m_currentPage) >
+                    abs(m_pageCache[farthest].page - m_currentPage) )
+                farthest = i;
+        }
+
+        m_pageCache.erase(m_pageCache.begin() + farthest);
+    }
+
+    CachedPage entry;
+    entry.page = pageNum;
+    entry.bitmap = rendered;
+    m_pageCache.push_back(entry);
+
+    bmp = rendered;
+    return true;
+}
+
+void wxPrintPreviewBase::PreRenderAdjacentPage()
+{
+    if ( m_pageCacheSize <= 1 || !m_previewCanvas )
+        return;
+
+    wxRect pageRect, paperRect;
+    CalcRects(m_previewCanvas, pageRect, paperRect);
+
+    // Enumerate the neighbours of the current page in the order of
+    // increasing distance from it, starting with the following one as
+    // paging forward is more common.
+    for ( int dist = 1; dist < m_pageCacheSize; dist++ )
+    {
+        const int delta = (dist + 1) / 2;
+        const int page = m_currentPage + (dist % 2 ? delta : -delta);
+
+        if ( page < m_minPage || page > m_maxPage || page == m_currentPage )
+            continue;
+
+        if ( FindCachedPage(page, pageRect.GetSize()) < m_pageCache.size() )
+            continue;
+
+        // Render only a single page per idle event to keep the UI
+        // responsive: this also means that pre-rendering effectively stops
+        // as soon as the user jumps to a distant page, as the pages around
+        // the new current page take priority from the next idle event on.
+        wxBitmap bmp;
+        if ( GetRenderedPage(page, pageRect.GetSize(), bmp) )
+            wxWakeUpIdle();
+
+        return;
+    }
+}
+
+void wxPrintPreviewBase::SetPageCacheSize(int count)
+{
+    wxCHECK_RET( count >= 1, wxT("preview page cache can't be empty") );
+
+    m_pageCacheSize = count;
+
+    while ( m_pageCache.size() > (size_t)m_pageCacheSize )
+        m_pageCache.pop_back();
+}
+
 bool wxPrintPreviewBase::RenderPage(int pageNum)
 {
     wxBusyCursor busy;
@@ -2069,25 +2215,27 @@ bool wxPrintPreviewBase::RenderPage(int pageNum)
     wxRect pageRect, paperRect;
     CalcRects(m_previewCanvas, pageRect, paperRect);
 
-    if (!m_previewBitmap)
+    // If we're asked to re-render a page which was already rendered, really
+    // do it: drop both the current bitmap and any cached copy of the page.
+    if (m_previewBitmap)
     {
-        m_previewBitmap = new wxBitmap(pageRect.width, pageRect.height);
+        InvalidatePreviewBitmap();
 
-        if (!m_previewBitmap || !m_previewBitmap->IsOk())
-        {
-            InvalidatePreviewBitmap();
-            wxMessageBox(_("Sorry, not enough memory to create a preview."), _("Print Preview Failure"), wxOK);
-            return false;
-        }
+        const size_t n = FindCachedPage(pageNum, pageRect.GetSize());
+        if ( n < m_pageCache.size() )
+            m_pageCache.erase(m_pageCache.begin() + n);
     }
 
-    if ( !RenderPageIntoBitmap(*m_previewBitmap, pageNum) )
+    wxBitmap bmp;
+    if ( !GetRenderedPage(pageNum, pageRect.GetSize(), bmp) )
     {
         InvalidatePreviewBitmap();
         wxMessageBox(_("Sorry, not enough memory to create a preview."), _("Print Preview Failure"), wxOK);
         return false;
     }
 
+    m_previewBitmap = new wxBitmap(bmp);
+
 #if wxUSE_STATUSBAR
     wxString status;
     if (m_maxPage != 0)
@@ -2277,6 +2425,16 @@ int wxPrintPreview::GetZoom() const
     return m_pimpl->GetZoom();
 }
 
+void wxPrintPreview::SetPageCacheSize(int count)
+{
+    m_pimpl->SetPageCacheSize( count );
+}
+
+int wxPrintPreview::GetPageCacheSize() const
+{
+    return m_pimpl->GetPageCacheSize();
+}
+
 wxPrintDialogData& wxPrintPreview::GetPrintDialogData()
 {
     return m_pimpl->GetPrintDialogData();
@@ -0,0 +1,258 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/profiler.cpp
+// Purpose:     Lightweight zone profiler producing chrome://tracing output
+// Author:      wxWidgets team
+// Created:     2022-04-10
+// Copyright:   (c) 2022 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+
+#include "wx/profiler.h"
+
+#ifndef WX_PRECOMP
+    #include "wx/log.h"
+    #include "wx/utils.h"
+#endif //WX_PRECOMP
+
+#include "wx/ffile.h"
+#include "wx/module.h"
+#include "wx/thread.h"
+#include "wx/tls.h"
+#include "wx/vector.h"
+
+// ----------------------------------------------------------------------------
+// private data
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Ring buffer holding the zones recorded by a single thread.
+//
+// Only the owning thread ever writes to it, so recording doesn't need any
+// locking, the global list of all the buffers below is only locked when a
+// thread records its first zone and when dumping.
+struct wxProfilerThreadBuffer
+{
+    wxProfilerZone *zones;
+    size_t capacity;
+
+    // total number of zones stored, at most capacity
+    size_t count;
+
+    // index at which the next zone will be stored
+    size_t next;
+
+    // identifier of the owning thread, for the dump only
+    wxUIntPtr threadId;
+};
+
+// All the buffers created so far: they are kept until the program shutdown
+// even after their threads exit, both because the zones they contain are
+// still needed for the dump and because the thread-specific pointers
+// referencing them can't be reset from another thread.
+wxVector<wxProfilerThreadBuffer *> gs_profilerBuffers;
+
+#if wxUSE_THREADS
+// Protects gs_profilerBuffers and gs_profilerCapacity.
+wxCriticalSection gs_profilerLock;
+#endif // wxUSE_THREADS
+
+// Capacity used for the buffers created after the last Enable() call.
+size_t gs_profilerCapacity = 0;
+
+} // anonymous namespace
+
+static wxTLS_TYPE_REF(wxProfilerThreadBuffer *) GetProfilerBufferVar()
+{
+    static wxTLS_TYPE(wxProfilerThreadBuffer *) s_buffer;
+
+    return s_buffer;
+}
+
+#define wxPROFILER_BUFFER wxTLS_VALUE(GetProfilerBufferVar())
+
+// ----------------------------------------------------------------------------
+// wxProfiler
+// ----------------------------------------------------------------------------
+
+bool wxProfiler::ms_enabled = false;
+
+void wxProfiler::Enable(size_t zonesPerThread)
+{
+    wxCHECK_RET( zonesPerThread, wxS("profiler buffer can't be empty") );
+
+#if wxUSE_THREADS
+    wxCriticalSectionLocker lock(gs_profilerLock);
+#endif
+
+    gs_profilerCapacity = zonesPerThread;
+
+    ms_enabled = true;
+}
+
+void wxProfiler::Disable()
+{
+    ms_enabled = false;
+}
+
+void wxProfiler::RecordZone(const char *name,
+                            wxLongLong_t start,
+                            wxLongLong_t end)
+{
+    // checked by wxProfileZone already, but be safe if called directly
+    if ( !ms_enabled )
+        return;
+
+    wxProfilerThreadBuffer *buffer = wxPROFILER_BUFFER;
+    if ( !buffer )
+    {
+        buffer = new wxProfilerThreadBuffer;
+#if wxUSE_THREADS
+        buffer->threadId = (wxUIntPtr)wxThread::GetCurrentId();
+#else
+        buffer->threadId = 0;
+#endif
+        buffer->count =
+        buffer->next = 0;
+
+        // the buffer must be fully initialized before it is published in the
+        // global list as the dump can iterate over it at any moment
+        {
+#if wxUSE_THREADS
+            wxCriticalSectionLocker lock(gs_profilerLock);
+#endif
+            buffer->capacity = gs_profilerCapacity;
+            buffer->zones = new wxProfilerZone[buffer->capacity];
+            gs_profilerBuffers.push_back(buffer);
+        }
+
+        wxPROFILER_BUFFER = buffer;
+    }
+
+    wxProfilerZone& zone = buffer->zones[buffer->next];
+    zone.name = name;
+    zone.start = start;
+    zone.end = end;
+
+    if ( ++buffer->next == buffer->capacity )
+        buffer->next = 0;
+    if ( buffer->count < buffer->capacity )
+        buffer->count++;
+}
+
+bool wxProfiler::DumpToFile(const wxString& filename)
+{
+#if wxUSE_FFILE
+    wxFFile file(filename, wxS("w"));
+    if ( !file.IsOpened() )
+        return false;
+
+    const unsigned long pid = wxGetProcessId();
+
+    wxString out;
+    out.reserve(4096);
+    out << wxS("{\"traceEvents\":[\n");
+
+    bool first = true;
+
+#if wxUSE_THREADS
+    wxCriticalSectionLocker lock(gs_profilerLock);
+#endif
+
+    for ( size_t n = 0; n < gs_profilerBuffers.size(); n++ )
+    {
+        const wxProfilerThreadBuffer* const buffer = gs_profilerBuffers[n];
+
+        // start with the oldest zone if the ring buffer has wrapped around
+        size_t pos = buffer->count == buffer->capacity ? buffer->next : 0;
+        for ( size_t i = 0; i < buffer->count; i++ )
+        {
+            const wxProfilerZone& zone = buffer->zones[pos];
+            if ( ++pos == buffer->capacity )
+                pos = 0;
+
+            if ( !first )
+                out << wxS(",\n");
+            first = false;
+
+            out << wxS("{\"name\":\"") << zone.name
+                << wxS("\",\"ph\":\"X\",\"ts\":") << zone.start
+                << wxS(",\"dur\":") << zone.end - zone.start
+                << wxS(",\"pid\":") << pid
+                << wxS(",\"tid\":") << buffer->threadId
+                << wxS("}");
+
+            // don't let the buffer grow without bounds for big dumps
+            if ( out.length() > 65536 )
+            {
+                if ( !file.Write(out) )
+                    return false;
+                out.clear();
+            }
+        }
+    }
+
+    out << wxS("\n]}\n");
+
+    return file.Write(out) && file.Close();
+#else // !wxUSE_FFILE
+    wxUnusedVar(filename);
+
+    return false;
+#endif // wxUSE_FFILE/!wxUSE_FFILE
+}
+
+void wxProfiler::Clear()
+{
+#if wxUSE_THREADS
+    wxCriticalSectionLocker lock(gs_profilerLock);
+#endif
+
+    // The buffers themselves are kept, see the comment before
+    // gs_profilerBuffers, only their contents is discarded. Threads still
+    // recording concurrently may leave a few zones behind, which is
+    // harmless.
+    for ( size_t n = 0; n < gs_profilerBuffers.size(); n++ )
+    {
+        gs_profilerBuffers[n]->count =
+        gs_profilerBuffers[n]->next = 0;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// wxProfilerModule
+// ----------------------------------------------------------------------------
+
+// Frees the buffers of all the threads during the library shutdown.
+class wxProfilerModule : public wxModule
+{
+public:
+    virtual bool OnInit() wxOVERRIDE { return true; }
+
+    virtual void OnExit() wxOVERRIDE
+    {
+        wxProfiler::Disable();
+
+#if wxUSE_THREADS
+        wxCriticalSectionLocker lock(gs_profilerLock);
+#endif
+
+        for ( size_t n = 0; n < gs_profilerBuffers.size(); n++ )
+        {
+            delete [] gs_profilerBuffers[n]->zones;
+            delete gs_profilerBuffers[n];
+        }
+
+        gs_profilerBuffers.clear();
+    }
+
+private:
+    wxDECLARE_DYNAMIC_CLASS(wxProfilerModule);
+};
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxProfilerModule, wxModule);
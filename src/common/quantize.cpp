@@ -45,6 +45,11 @@
     #include "wx/msw/private.h"
 #endif
 
+#if wxUSE_THREADS
+    #include "wx/thread.h"
+    #include "wx/vector.h"
+#endif
+
 #include <stdlib.h>
 #include <string.h>
 
@@ -297,16 +302,17 @@ typedef my_cquantizer * my_cquantize_ptr;
  */
 
 void
-prescan_quantize (j_decompress_ptr cinfo, JSAMPARRAY input_buf,
-          JSAMPARRAY WXUNUSED(output_buf), int num_rows)
+accumulate_histogram (hist3d histogram, JSAMPARRAY input_buf, int num_rows,
+          JDIMENSION width)
+/* Count the colors of the given rows into the given histogram, which is not
+ * necessarily the one of the quantizer: this allows the threads used for the
+ * parallel prescan to accumulate into their own private histograms.
+ */
 {
-  my_cquantize_ptr cquantize = (my_cquantize_ptr) cinfo->cquantize;
   JSAMPROW ptr;
   histptr histp;
-  hist3d histogram = cquantize->histogram;
   int row;
   JDIMENSION col;
-  JDIMENSION width = cinfo->output_width;
 
   for (row = 0; row < num_rows; row++) {
     ptr = input_buf[row];
@@ -327,6 +333,77 @@ prescan_quantize (j_decompress_ptr cinfo, JSAMPARRAY input_buf,
   }
 }
 
+void
+prescan_quantize (j_decompress_ptr cinfo, JSAMPARRAY input_buf,
+          JSAMPARRAY WXUNUSED(output_buf), int num_rows)
+{
+  my_cquantize_ptr cquantize = (my_cquantize_ptr) cinfo->cquantize;
+
+  accumulate_histogram(cquantize->histogram, input_buf, num_rows,
+               cinfo->output_width);
+}
+
+#if wxUSE_THREADS
+
+// Worker thread used by the parallel prescan: accumulates the histogram of
+// its share of the image rows into a private histogram which is then merged
+// into the quantizer's one by the main thread.
+class wxQuantizePrescanThread : public wxThread
+{
+public:
+    wxQuantizePrescanThread(JSAMPARRAY rows, int numRows, JDIMENSION width)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_rows(rows),
+          m_numRows(numRows),
+          m_width(width)
+    {
+        m_histogram = (hist3d) malloc(HIST_C0_ELEMS * sizeof(hist2d));
+        for (int i = 0; i < HIST_C0_ELEMS; i++) {
+            m_histogram[i] = (hist2d) malloc(HIST_C1_ELEMS*HIST_C2_ELEMS * sizeof(histcell));
+            memset(m_histogram[i], 0, HIST_C1_ELEMS*HIST_C2_ELEMS * sizeof(histcell));
+        }
+    }
+
+    virtual ~wxQuantizePrescanThread()
+    {
+        for (int i = 0; i < HIST_C0_ELEMS; i++)
+            free(m_histogram[i]);
+        free(m_histogram);
+    }
+
+    virtual ExitCode Entry() wxOVERRIDE
+    {
+        accumulate_histogram(m_histogram, m_rows, m_numRows, m_width);
+        return NULL;
+    }
+
+    // Add the counts accumulated by this thread to the given histogram,
+    // saturating the cells at the maximal representable value, just as the
+    // accumulation itself does, so that the result is identical to the one
+    // of a serial prescan whatever the number of threads used.
+    void MergeInto(hist3d histogram) const
+    {
+        for (int i = 0; i < HIST_C0_ELEMS; i++) {
+            histptr src = (histptr) m_histogram[i];
+            histptr dst = (histptr) histogram[i];
+            for (int j = 0; j < HIST_C1_ELEMS*HIST_C2_ELEMS; j++) {
+                const unsigned int total = (unsigned int) dst[j] + src[j];
+                dst[j] = total > 0xFFFF ? (histcell) 0xFFFF : (histcell) total;
+            }
+        }
+    }
+
+private:
+    hist3d m_histogram;
+    const JSAMPARRAY m_rows;
+    const int m_numRows;
+    const JDIMENSION m_width;
+
+    wxDECLARE_NO_COPY_CLASS(wxQuantizePrescanThread);
+};
+
+#endif // wxUSE_THREADS
+
 
 /*
  * Next we have the really interesting routines: selection of a colormap
@@ -1419,7 +1496,7 @@ prepare_range_limit_table (j_decompress_ptr cinfo)
 wxIMPLEMENT_DYNAMIC_CLASS(wxQuantize, wxObject);
 
 void wxQuantize::DoQuantize(unsigned w, unsigned h, unsigned char **in_rows, unsigned char **out_rows,
-    unsigned char *palette, int desiredNoColours)
+    unsigned char *palette, int desiredNoColours, int numThreads)
 {
     j_decompress dec;
     my_cquantize_ptr cquantize;
@@ -1433,9 +1510,71 @@ void wxQuantize::DoQuantize(unsigned w, unsigned h, unsigned char **in_rows, uns
 
 
     cquantize->pub.start_pass(&dec, true);
-    cquantize->pub.color_quantize(&dec, in_rows, out_rows, h);
+
+#if wxUSE_THREADS
+    if (numThreads <= 0)
+    {
+        numThreads = wxThread::GetCPUCount();
+        if (numThreads <= 0)
+            numThreads = 1;
+    }
+
+    // Splitting the prescan in chunks of fewer rows than this is not worth
+    // the overhead of creating the threads and merging their histograms.
+    const unsigned minRowsPerThread = 64;
+    if (numThreads > int(h / minRowsPerThread))
+        numThreads = h / minRowsPerThread;
+
+    if (numThreads > 1)
+    {
+        wxVector<wxQuantizePrescanThread*> threads;
+        const int rowsPerThread = h / numThreads;
+
+        // The first chunk is processed by this thread, the others are given
+        // to the workers, with the last one also getting the remainder.
+        int rowsDone = rowsPerThread;
+        for (int n = 1; n < numThreads; n++)
+        {
+            const int numRows = n == numThreads - 1 ? h - rowsDone
+                                                    : rowsPerThread;
+            wxQuantizePrescanThread* thread =
+                new wxQuantizePrescanThread(in_rows + rowsDone, numRows, w);
+            if (thread->Run() != wxTHREAD_NO_ERROR)
+            {
+                // Failing to create a thread is not fatal, the remaining
+                // rows are simply processed in this thread below.
+                delete thread;
+                break;
+            }
+
+            threads.push_back(thread);
+            rowsDone += numRows;
+        }
+
+        accumulate_histogram(cquantize->histogram, in_rows, rowsPerThread, w);
+        if (rowsDone < int(h))
+            accumulate_histogram(cquantize->histogram, in_rows + rowsDone,
+                                 h - rowsDone, w);
+
+        for (size_t n = 0; n < threads.size(); n++)
+        {
+            threads[n]->Wait();
+            threads[n]->MergeInto(cquantize->histogram);
+            delete threads[n];
+        }
+    }
+    else
+#endif // wxUSE_THREADS
+    {
+        cquantize->pub.color_quantize(&dec, in_rows, out_rows, h);
+    }
+
     cquantize->pub.finish_pass(&dec);
 
+    // Note that the second pass can't be parallelized in the same way: the
+    // Floyd-Steinberg dithering used by it propagates the quantization error
+    // between neighbouring rows and the threads would also race on using the
+    // histogram as the inverse colormap cache.
     cquantize->pub.start_pass(&dec, false);
     cquantize->pub.color_quantize(&dec, in_rows, out_rows, h);
     cquantize->pub.finish_pass(&dec);
@@ -1469,7 +1608,8 @@ bool wxQuantize::Quantize(const wxImage& src, wxImage& dest,
                           wxPalette** pPalette,
                           int desiredNoColours,
                           unsigned char** eightBitData,
-                          int flags)
+                          int flags,
+                          int numThreads)
 
 {
     int i;
@@ -1506,7 +1646,7 @@ bool wxQuantize::Quantize(const wxImage& src, wxImage& dest,
         outrows[i] = data8bit + w * i;
 
     //RGB->palette
-    DoQuantize(w, h, rows, outrows, palette, desiredNoColours);
+    DoQuantize(w, h, rows, outrows, palette, desiredNoColours, numThreads);
 
     delete[] rows;
     delete[] outrows;
@@ -1604,10 +1744,11 @@ bool wxQuantize::Quantize(const wxImage& src,
                           wxImage& dest,
                           int desiredNoColours,
                           unsigned char** eightBitData,
-                          int flags)
+                          int flags,
+                          int numThreads)
 {
     wxPalette* palette = NULL;
-    if ( !Quantize(src, dest, & palette, desiredNoColours, eightBitData, flags) )
+    if ( !Quantize(src, dest, & palette, desiredNoColours, eightBitData, flags, numThreads) )
         return false;
 
 #if wxUSE_PALETTE
@@ -30,8 +30,14 @@
     #include "wx/log.h"
     #include "wx/intl.h"
     #include "wx/crt.h"
+    #include "wx/hashmap.h"
+    #include "wx/module.h"
 #endif //WX_PRECOMP
 
+#if wxUSE_THREADS
+    #include "wx/thread.h"
+#endif
+
 // At least FreeBSD requires this.
 #if defined(__UNIX__)
 #   include <sys/types.h>
@@ -109,6 +115,8 @@ enum
 
 typedef size_t regoff_t;
 
+struct wxPcreCacheEntry;
+
 struct regex_t
 {
     // This is the only "public" field -- not that it really matters anyhow for
@@ -118,6 +126,9 @@ struct regex_t
     pcre2_code* code;
     pcre2_match_data* match_data;
 
+    // non-NULL if the code is shared via the compiled pattern cache
+    wxPcreCacheEntry* cache_entry;
+
     int errorcode;
     regoff_t erroroffset;
 };
@@ -128,6 +139,81 @@ struct regmatch_t
     regoff_t rm_eo;
 };
 
+// ----------------------------------------------------------------------------
+// cache of compiled patterns
+// ----------------------------------------------------------------------------
+
+// Compiling non-trivial patterns is expensive while a pcre2_code, once
+// created, is immutable and can be shared by any number of matches (each
+// regex_t still has its own match data), so keep the compiled programs in a
+// process-wide map keyed by the pattern and its compilation options: code
+// repeatedly creating wxRegEx objects from the same patterns then skips the
+// compilation entirely.
+
+struct wxPcreCacheEntry
+{
+    pcre2_code* code;
+
+    // number of regex_t currently sharing this code: entries are never freed
+    // while it is non-zero, idle entries stay cached and can be evicted
+    int refs;
+};
+
+WX_DECLARE_STRING_HASH_MAP(wxPcreCacheEntry*, wxPcreCache);
+
+wxPcreCache gs_pcreCache;
+
+// maximal number of cached programs: enough for a typical application using
+// a fixed set of patterns while still bounding the memory used if the
+// patterns are generated dynamically
+const size_t wxPCRE_CACHE_MAX_SIZE = 500;
+
+#if wxUSE_THREADS
+wxCriticalSection gs_pcreCacheCS;
+#define wxLOCK_PCRE_CACHE() wxCriticalSectionLocker lockCache(gs_pcreCacheCS)
+#else
+#define wxLOCK_PCRE_CACHE()
+#endif
+
+wxString wxPcreCacheKey(const wxRegChar* pattern, int options)
+{
+    wxString key;
+    key << options << wxS(':');
+#if PCRE2_CODE_UNIT_WIDTH == 8
+    key += wxString::FromUTF8(pattern);
+#else
+    key += pattern;
+#endif
+    return key;
+}
+
+// free all the currently unused cache entries, called on shutdown and when
+// the cache grows too big
+//
+// must be called with the cache lock held
+void wxPcreCachePurgeIdle()
+{
+    for ( wxPcreCache::iterator it = gs_pcreCache.begin();
+          it != gs_pcreCache.end(); )
+    {
+        wxPcreCacheEntry* const entry = it->second;
+        if ( entry->refs )
+        {
+            ++it;
+        }
+        else
+        {
+            pcre2_code_free(entry->code);
+            delete entry;
+
+            wxPcreCache::iterator next = it;
+            ++next;
+            gs_pcreCache.erase(it);
+            it = next;
+        }
+    }
+}
+
 int wx_regcomp(regex_t* preg, const wxRegChar* pattern, int cflags)
 {
     // PCRE2_UTF is required in order to handle non-ASCII characters when using
@@ -150,6 +236,28 @@ int wx_regcomp(regex_t* preg, const wxRegChar* pattern, int cflags)
     else
         options |= PCRE2_DOTALL;
 
+    const wxString key = wxPcreCacheKey(pattern, options);
+
+    preg->cache_entry = NULL;
+
+    {
+        wxLOCK_PCRE_CACHE();
+
+        wxPcreCache::iterator it = gs_pcreCache.find(key);
+        if ( it != gs_pcreCache.end() )
+        {
+            wxPcreCacheEntry* const entry = it->second;
+            entry->refs++;
+
+            preg->code = entry->code;
+            preg->cache_entry = entry;
+            preg->match_data =
+                pcre2_match_data_create_from_pattern(preg->code, NULL);
+
+            return REG_NOERROR;
+        }
+    }
+
     preg->code = pcre2_compile
                  (
                     (PCRE2_SPTR)pattern,
@@ -168,6 +276,42 @@ int wx_regcomp(regex_t* preg, const wxRegChar* pattern, int cflags)
         return REG_BADPAT;
     }
 
+    // remember the compiled program for the next time the same pattern is
+    // used
+    {
+        wxLOCK_PCRE_CACHE();
+
+        // another thread could have compiled the same pattern concurrently,
+        // share its code in this case and drop ours
+        wxPcreCache::iterator it = gs_pcreCache.find(key);
+        if ( it != gs_pcreCache.end() )
+        {
+            pcre2_code_free(preg->code);
+
+            wxPcreCacheEntry* const entry = it->second;
+            entry->refs++;
+            preg->code = entry->code;
+            preg->cache_entry = entry;
+        }
+        else // not in the cache yet
+        {
+            if ( gs_pcreCache.size() >= wxPCRE_CACHE_MAX_SIZE )
+                wxPcreCachePurgeIdle();
+
+            if ( gs_pcreCache.size() < wxPCRE_CACHE_MAX_SIZE )
+            {
+                wxPcreCacheEntry* const entry = new wxPcreCacheEntry;
+                entry->code = preg->code;
+                entry->refs = 1;
+
+                gs_pcreCache[key] = entry;
+                preg->cache_entry = entry;
+            }
+            //else: all the cached programs are currently in use, don't cache
+            //      this one at all
+        }
+    }
+
     preg->match_data = pcre2_match_data_create_from_pattern(preg->code, NULL);
 
     return REG_NOERROR;
@@ -254,9 +398,40 @@ wx_regerror(int errcode, const regex_t* preg, wxRegErrorChar* errbuf, size_t err
 void wx_regfree(regex_t* preg)
 {
     pcre2_match_data_free(preg->match_data);
-    pcre2_code_free(preg->code);
+
+    if ( preg->cache_entry )
+    {
+        // the code is shared, just release our reference: the entry itself
+        // stays cached for possible reuse until the cache needs the space
+        wxLOCK_PCRE_CACHE();
+        preg->cache_entry->refs--;
+    }
+    else
+    {
+        pcre2_code_free(preg->code);
+    }
 }
 
+// module freeing the cached compiled patterns which are not used any longer
+// during the library shutdown
+class wxRegExModule : public wxModule
+{
+public:
+    virtual bool OnInit() wxOVERRIDE { return true; }
+
+    virtual void OnExit() wxOVERRIDE
+    {
+        wxLOCK_PCRE_CACHE();
+
+        wxPcreCachePurgeIdle();
+    }
+
+private:
+    wxDECLARE_DYNAMIC_CLASS(wxRegExModule);
+};
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxRegExModule, wxModule);
+
 } // anonymous namespace
 
 #else // !wxUSE_PCRE
@@ -357,6 +532,72 @@ private:
 
 #endif // WXREGEX_USING_RE_SEARCH
 
+#if wxUSE_PCRE
+
+// Boyer-Moore-Horspool searcher used for the pure literal patterns: when a
+// pattern contains no metacharacters at all there is no need to involve the
+// regex engine in matching it, a substring search is much faster.
+class wxRegExLiteral
+{
+public:
+    wxRegExLiteral(const wxRegChar* pattern, size_t len)
+        : m_len(len)
+    {
+        m_pattern = new wxRegChar[len];
+        memcpy(m_pattern, pattern, len*sizeof(wxRegChar));
+
+        // the usual bad character table, indexed by the low byte of the
+        // character so that it works for the wide characters too
+        for ( size_t i = 0; i < WXSIZEOF(m_skip); i++ )
+            m_skip[i] = len;
+        for ( size_t i = 0; i + 1 < len; i++ )
+            m_skip[SkipIndex(m_pattern[i])] = len - i - 1;
+    }
+
+    ~wxRegExLiteral() { delete [] m_pattern; }
+
+    // return the position of the first occurrence of the pattern in the
+    // given string or wxString::npos if it doesn't occur in it
+    size_t Find(const wxRegChar* str, size_t len) const
+    {
+        // empty pattern matches at the start, as for the regex engine
+        if ( !m_len )
+            return 0;
+
+        size_t pos = 0;
+        while ( pos + m_len <= len )
+        {
+            size_t i = m_len - 1;
+            while ( str[pos + i] == m_pattern[i] )
+            {
+                if ( !i )
+                    return pos;
+                i--;
+            }
+
+            pos += m_skip[SkipIndex(str[pos + m_len - 1])];
+        }
+
+        return wxString::npos;
+    }
+
+    size_t GetLength() const { return m_len; }
+
+private:
+    static size_t SkipIndex(wxRegChar c)
+    {
+        return static_cast<size_t>(c) & 0xff;
+    }
+
+    wxRegChar* m_pattern;
+    size_t m_len;
+    size_t m_skip[256];
+
+    wxDECLARE_NO_COPY_CLASS(wxRegExLiteral);
+};
+
+#endif // wxUSE_PCRE
+
 // the real implementation of wxRegEx
 class wxRegExImpl
 {
@@ -386,11 +627,22 @@ private:
         m_isCompiled = false;
         m_Matches = NULL;
         m_nMatches = 0;
+#if wxUSE_PCRE
+        m_literal = NULL;
+#endif
     }
 
     // free the RE if compiled
     void Free()
     {
+#if wxUSE_PCRE
+        if ( m_literal )
+        {
+            // the regex engine was never involved at all
+            wxDELETE(m_literal);
+        }
+        else
+#endif
         if ( IsValid() )
         {
             wx_regfree(&m_RegEx);
@@ -415,6 +667,12 @@ private:
 
     // true if m_RegEx is valid
     bool            m_isCompiled;
+
+#if wxUSE_PCRE
+    // if the pattern is a pure literal string, this is used for matching it
+    // instead of m_RegEx, which is not compiled at all in this case
+    wxRegExLiteral *m_literal;
+#endif
 };
 
 
@@ -1056,6 +1314,28 @@ bool wxRegExImpl::Compile(wxString expr, int flags)
     {
         expr = ConvertWordBoundaries(expr);
     }
+
+    // If, after all the conversions, the pattern doesn't contain any special
+    // characters at all, don't involve the regex engine and use a plain (and
+    // much faster) substring search for it -- except in the case insensitive
+    // case, which a simple search can't handle correctly for Unicode.
+    if ( !(flags & wxRE_ICASE) &&
+            expr.find_first_of(wxS("\\^$.[]()*+?{}|")) == wxString::npos )
+    {
+#ifdef WXREGEX_CONVERT_TO_MB
+        const wxScopedCharBuffer exprbufLit = expr.utf8_str();
+        m_literal = new wxRegExLiteral(exprbufLit.data(), exprbufLit.length());
+#else
+        m_literal = new wxRegExLiteral(expr.wx_str(), expr.length());
+#endif
+
+        // there are no bracketed subexpressions in a literal string, just
+        // the whole match
+        m_nMatches = (flags & wxRE_NOSUB) ? 0 : 1;
+        m_isCompiled = true;
+
+        return true;
+    }
 #endif // wxUSE_PCRE
 
     // translate our flags to regcomp() ones
@@ -1204,6 +1484,24 @@ bool wxRegExImpl::Matches(const wxRegChar *str,
 
     wxRegExMatches::match_type matches = m_Matches ? m_Matches->get() : NULL;
 
+#if wxUSE_PCRE
+    // use the substring search for the literal patterns
+    if ( m_literal )
+    {
+        const size_t pos = m_literal->Find(str, len);
+        if ( pos == wxString::npos )
+            return false;
+
+        if ( matches )
+        {
+            matches[0].rm_so = pos;
+            matches[0].rm_eo = pos + m_literal->GetLength();
+        }
+
+        return true;
+    }
+#endif // wxUSE_PCRE
+
     // do match it
 #if defined WXREGEX_USING_BUILTIN
     int rc = wx_re_exec(&self->m_RegEx, str, len, NULL, m_nMatches, matches, flagsRE);
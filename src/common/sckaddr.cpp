@@ -38,6 +38,8 @@
 
 #include "wx/socket.h"
 #include "wx/sckaddr.h"
+#include "wx/hashmap.h"
+#include "wx/time.h"
 #include "wx/private/socket.h"
 #include "wx/private/sckaddr.h"
 
@@ -499,6 +501,103 @@ bool wxSockAddressImpl::SetPortName(const wxString& name, const char *protocol)
     return SetPort(port);
 }
 
+// ----------------------------------------------------------------------------
+// name lookup cache
+// ----------------------------------------------------------------------------
+
+// Cache of the successful host name lookups: resolving a name can block for
+// up to several seconds, so remember the results for a while instead of
+// hitting the resolver again for every address object using the same name.
+// Notice that the system resolver functions don't give us access to the TTLs
+// of the DNS records, so a single fixed TTL is used for all the entries.
+
+namespace
+{
+
+struct wxNameLookupCacheEntry
+{
+    wxUint32 addr;      // IPv4 address in network byte order
+    wxLongLong expiry;  // as returned by wxGetUTCTimeMillis()
+};
+
+WX_DECLARE_STRING_HASH_MAP(wxNameLookupCacheEntry, wxNameLookupCacheMap);
+
+wxNameLookupCacheMap gs_nameLookupCache;
+
+int gs_nameLookupCacheTTL = 60; // seconds
+
+#if wxUSE_THREADS
+// protects both the map and the TTL above
+wxMutex gs_nameLookupCacheMutex;
+    #define wxLOCK_LOOKUP_CACHE() wxMutexLocker lock(gs_nameLookupCacheMutex)
+#else
+    #define wxLOCK_LOOKUP_CACHE()
+#endif
+
+// return true and fill the address if we have an unexpired entry for this name
+bool wxGetCachedHostAddress(const wxString& name, wxUint32 *addr)
+{
+    wxLOCK_LOOKUP_CACHE();
+
+    if ( !gs_nameLookupCacheTTL )
+        return false;
+
+    wxNameLookupCacheMap::iterator it = gs_nameLookupCache.find(name);
+    if ( it == gs_nameLookupCache.end() )
+        return false;
+
+    if ( wxGetUTCTimeMillis() > it->second.expiry )
+    {
+        gs_nameLookupCache.erase(it);
+        return false;
+    }
+
+    *addr = it->second.addr;
+
+    return true;
+}
+
+void wxCacheHostAddress(const wxString& name, wxUint32 addr)
+{
+    wxLOCK_LOOKUP_CACHE();
+
+    if ( !gs_nameLookupCacheTTL )
+        return;
+
+    wxNameLookupCacheEntry entry;
+    entry.addr = addr;
+    entry.expiry = wxGetUTCTimeMillis() + 1000*gs_nameLookupCacheTTL;
+    gs_nameLookupCache[name] = entry;
+}
+
+} // anonymous namespace
+
+/* static */
+void wxSockAddress::SetNameLookupCacheTTL(int seconds)
+{
+    wxLOCK_LOOKUP_CACHE();
+
+    gs_nameLookupCacheTTL = seconds;
+    if ( !seconds )
+        gs_nameLookupCache.clear();
+}
+
+/* static */
+int wxSockAddress::GetNameLookupCacheTTL()
+{
+    wxLOCK_LOOKUP_CACHE();
+
+    return gs_nameLookupCacheTTL;
+}
+
+/* static */
+void wxSockAddress::ClearNameLookupCache()
+{
+    wxLOCK_LOOKUP_CACHE();
+
+    gs_nameLookupCache.clear();
+}
+
 // ----------------------------------------------------------------------------
 // INET address family
 // ----------------------------------------------------------------------------
@@ -532,7 +631,12 @@ bool wxSockAddressImpl::SetHostName4(const wxString& name)
     #error "Neither inet_aton() nor inet_addr() is available?"
 #endif
 
-    // it's a host name, resolve it
+    // it's a host name, check the cache first to avoid hitting the resolver,
+    // which can block for a long time, for the recently used names
+    if ( wxGetCachedHostAddress(name, &addr->sin_addr.s_addr) )
+        return true;
+
+    // not cached, really resolve it
     hostent he;
     wxGethostBuf buffer;
     int err;
@@ -540,6 +644,9 @@ bool wxSockAddressImpl::SetHostName4(const wxString& name)
         return false;
 
     addr->sin_addr.s_addr = ((in_addr *)he.h_addr)->s_addr;
+
+    wxCacheHostAddress(name, addr->sin_addr.s_addr);
+
     return true;
 }
 
@@ -186,7 +186,7 @@ public:
     wxIPCSocketStreams(wxSocketBase& sock)
         : m_socketStream(sock),
 #ifdef USE_BUFFER
-          m_bufferedOut(m_socketStream, 1448),
+          m_bufferedOut(m_socketStream, BUFFER_SIZE),
 #else
           m_bufferedOut(m_socketStream),
 #endif
@@ -195,6 +195,19 @@ public:
     {
     }
 
+    // return true if a data block of this size should be written with
+    // WriteDirect() instead of going through the buffered stream
+    static bool ShouldWriteDirect(size_t size) { return size >= BUFFER_SIZE; }
+
+    // write a large data block directly to the socket: copying it through
+    // the small message-coalescing buffer above would just chop it into
+    // many separate socket writes and copy all of it once more
+    void WriteDirect(const void *data, size_t size)
+    {
+        Flush();
+        m_socketStream.Write(data, size);
+    }
+
     // expose the IO methods needed by IPC code (notice that writing is only
     // done via IPCOutput)
 
@@ -263,6 +276,10 @@ public:
     wxOutputStream& GetUnformattedOut() { return m_bufferedOut; }
 
 private:
+    // size of the output buffer: matches the typical Ethernet MTU minus the
+    // TCP header overhead, see the ctor
+    enum { BUFFER_SIZE = 1448 };
+
     // this is the low-level underlying stream using the connection socket
     wxSocketStream m_socketStream;
 
@@ -330,7 +347,11 @@ public:
     void WriteData(const void *data, size_t size)
     {
         m_streams.GetDataOut().Write32(size);
-        m_streams.GetUnformattedOut().Write(data, size);
+
+        if ( wxIPCSocketStreams::ShouldWriteDirect(size) )
+            m_streams.WriteDirect(data, size);
+        else
+            m_streams.GetUnformattedOut().Write(data, size);
     }
 
 
@@ -260,7 +260,13 @@ int wxSelectDispatcher::Dispatch(int timeout)
             return 0;
 
         default:
-            return ProcessSets(sets);
+            {
+                const int numEvents = ProcessSets(sets);
+
+                UpdateStats(numEvents);
+
+                return numEvents;
+            }
     }
 }
 
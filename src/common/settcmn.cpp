@@ -22,6 +22,7 @@
 
 #ifndef WX_PRECOMP
     #include "wx/utils.h"
+    #include "wx/module.h"
 #endif //WX_PRECOMP
 
 // ----------------------------------------------------------------------------
@@ -30,6 +31,107 @@
 
 wxSystemScreenType wxSystemSettings::ms_screen = wxSYS_SCREEN_NONE;
 
+// ----------------------------------------------------------------------------
+// settings cache
+// ----------------------------------------------------------------------------
+
+// Querying the native theme engine can be slow on some platforms and the
+// drawing code calls the functions below for every repaint, so the values
+// returned by wxSystemSettingsNative are cached here; the cache is flushed
+// by InvalidateCache() whenever the system settings (may) have changed,
+// which happens before any event handlers can re-query them.
+
+namespace
+{
+
+wxColour gs_cachedColours[wxSYS_COLOUR_MAX];
+
+// the font indices don't start from 0, the array is indexed by the offset
+// from the first valid value
+const int wxSYS_FONT_FIRST = wxSYS_OEM_FIXED_FONT;
+const int wxSYS_FONT_LAST = wxSYS_DEFAULT_GUI_FONT;
+
+wxFont gs_cachedFonts[wxSYS_FONT_LAST - wxSYS_FONT_FIRST + 1];
+
+// the metrics can be negative for the unsupported ones, so a separate flag
+// is needed to know whether a cached value is valid
+int gs_cachedMetrics[wxSYS_CARET_TIMEOUT_MSEC + 1];
+bool gs_cachedMetricsValid[wxSYS_CARET_TIMEOUT_MSEC + 1];
+
+// Module emptying the cache on library shutdown: the GDI objects stored in
+// it can't be used, nor even destroyed, after it.
+class wxSystemSettingsCacheModule : public wxModule
+{
+public:
+    wxSystemSettingsCacheModule() { }
+
+    bool OnInit() wxOVERRIDE { return true; }
+    void OnExit() wxOVERRIDE { wxSystemSettings::InvalidateCache(); }
+
+private:
+    wxDECLARE_DYNAMIC_CLASS(wxSystemSettingsCacheModule);
+};
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxSystemSettingsCacheModule, wxModule);
+
+} // anonymous namespace
+
+#ifndef __WXUNIVERSAL__
+
+wxColour wxSystemSettings::GetColour(wxSystemColour index)
+{
+    if ( index < 0 || index >= wxSYS_COLOUR_MAX )
+        return wxSystemSettingsNative::GetColour(index);
+
+    wxColour& col = gs_cachedColours[index];
+    if ( !col.IsOk() )
+        col = wxSystemSettingsNative::GetColour(index);
+
+    return col;
+}
+
+int wxSystemSettings::GetMetric(wxSystemMetric index, const wxWindow* win)
+{
+    // the metrics may be window-dependent, only cache the global values
+    if ( win ||
+            index < wxSYS_MOUSE_BUTTONS || index > wxSYS_CARET_TIMEOUT_MSEC )
+        return wxSystemSettingsNative::GetMetric(index, win);
+
+    if ( !gs_cachedMetricsValid[index] )
+    {
+        gs_cachedMetrics[index] = wxSystemSettingsNative::GetMetric(index);
+        gs_cachedMetricsValid[index] = true;
+    }
+
+    return gs_cachedMetrics[index];
+}
+
+#endif // !__WXUNIVERSAL__
+
+wxFont wxSystemSettings::GetFont(wxSystemFont index)
+{
+    if ( index < wxSYS_FONT_FIRST || index > wxSYS_FONT_LAST )
+        return wxSystemSettingsNative::GetFont(index);
+
+    wxFont& font = gs_cachedFonts[index - wxSYS_FONT_FIRST];
+    if ( !font.IsOk() )
+        font = wxSystemSettingsNative::GetFont(index);
+
+    return font;
+}
+
+void wxSystemSettings::InvalidateCache()
+{
+    for ( int n = 0; n < wxSYS_COLOUR_MAX; n++ )
+        gs_cachedColours[n] = wxNullColour;
+
+    for ( int n = 0; n <= wxSYS_FONT_LAST - wxSYS_FONT_FIRST; n++ )
+        gs_cachedFonts[n] = wxNullFont;
+
+    for ( int n = 0; n <= wxSYS_CARET_TIMEOUT_MSEC; n++ )
+        gs_cachedMetricsValid[n] = false;
+}
+
 // ----------------------------------------------------------------------------
 // ----------------------------------------------------------------------------
 
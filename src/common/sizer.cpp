@@ -14,6 +14,7 @@
 
 
 #include "wx/sizer.h"
+#include "wx/alloctrack.h"
 #include "wx/private/flagscheck.h"
 
 #ifndef WX_PRECOMP
@@ -305,6 +306,8 @@ void wxSizerItem::Init(const wxSizerFlags& flags)
 
 wxSizerItem::wxSizerItem()
 {
+    wxAllocationTracker::OnAlloc(wxALLOC_TAG_SIZERS, sizeof(*this));
+
     Init();
 
     m_proportion = 0;
@@ -329,6 +332,8 @@ void wxSizerItem::DoSetWindow(wxWindow *window)
 
     // aspect ratio calculated from initial size
     SetRatio(m_minSize);
+
+    InvalidateContainingSizer();
 }
 
 wxSizerItem::wxSizerItem(wxWindow *window,
@@ -341,8 +346,11 @@ wxSizerItem::wxSizerItem(wxWindow *window,
              m_border(border),
              m_flag(flag),
              m_id(wxID_NONE),
-             m_userData(userData)
+             m_userData(userData),
+             m_containingSizer(NULL)
 {
+    wxAllocationTracker::OnAlloc(wxALLOC_TAG_SIZERS, sizeof(*this));
+
     ASSERT_VALID_SIZER_FLAGS( m_flag );
 
     DoSetWindow(window);
@@ -353,6 +361,13 @@ void wxSizerItem::DoSetSizer(wxSizer *sizer)
 {
     m_kind = Item_Sizer;
     m_sizer = sizer;
+
+    // keep the min size caching chain intact if a new sub-sizer is assigned
+    // to an item which already belongs to a sizer
+    if ( m_containingSizer && sizer )
+        sizer->m_parentSizer = m_containingSizer;
+
+    InvalidateContainingSizer();
 }
 
 wxSizerItem::wxSizerItem(wxSizer *sizer,
@@ -367,8 +382,11 @@ wxSizerItem::wxSizerItem(wxSizer *sizer,
              m_flag(flag),
              m_id(wxID_NONE),
              m_ratio(0),
-             m_userData(userData)
+             m_userData(userData),
+             m_containingSizer(NULL)
 {
+    wxAllocationTracker::OnAlloc(wxALLOC_TAG_SIZERS, sizeof(*this));
+
     ASSERT_VALID_SIZER_FLAGS( m_flag );
 
     DoSetSizer(sizer);
@@ -383,6 +401,8 @@ void wxSizerItem::DoSetSpacer(const wxSize& size)
     m_spacer = new wxSizerSpacer(size);
     m_minSize = size;
     SetRatio(size);
+
+    InvalidateContainingSizer();
 }
 
 wxSize wxSizerItem::AddBorderToSize(const wxSize& size) const
@@ -425,8 +445,11 @@ wxSizerItem::wxSizerItem(int width,
              m_border(border),
              m_flag(flag),
              m_id(wxID_NONE),
-             m_userData(userData)
+             m_userData(userData),
+             m_containingSizer(NULL)
 {
+    wxAllocationTracker::OnAlloc(wxALLOC_TAG_SIZERS, sizeof(*this));
+
     ASSERT_VALID_SIZER_FLAGS( m_flag );
 
     DoSetSpacer(wxSize(width, height));
@@ -434,6 +457,8 @@ wxSizerItem::wxSizerItem(int width,
 
 wxSizerItem::~wxSizerItem()
 {
+    wxAllocationTracker::OnFree(wxALLOC_TAG_SIZERS, sizeof(*this));
+
     delete m_userData;
     Free();
 }
@@ -762,6 +787,16 @@ void wxSizerItem::Show( bool show )
         default:
             wxFAIL_MSG( wxT("unexpected wxSizerItem::m_kind") );
     }
+
+    // windows and sub-sizers invalidate the cached min size themselves but
+    // spacers don't, so do it here for all the item kinds
+    InvalidateContainingSizer();
+}
+
+void wxSizerItem::InvalidateContainingSizer()
+{
+    if ( m_containingSizer )
+        m_containingSizer->InvalidateCachedMinSize();
 }
 
 bool wxSizerItem::IsShown() const
@@ -851,10 +886,17 @@ wxSizerItem* wxSizer::DoInsert( size_t index, wxSizerItem *item )
     }
 
     if ( item->GetSizer() )
+    {
         item->GetSizer()->SetContainingWindow( m_containingWindow );
+        item->GetSizer()->m_parentSizer = this;
+    }
+
+    item->SetContainingSizer( this );
 
     m_children.Insert( index, item );
 
+    InvalidateCachedMinSize();
+
     return guard.Release();
 }
 
@@ -902,6 +944,7 @@ bool wxSizer::Remove( wxSizer *sizer )
         {
             delete item;
             m_children.Erase( node );
+            InvalidateCachedMinSize();
             return true;
         }
 
@@ -924,6 +967,8 @@ bool wxSizer::Remove( int index )
     delete node->GetData();
     m_children.Erase( node );
 
+    InvalidateCachedMinSize();
+
     return true;
 }
 
@@ -938,9 +983,11 @@ bool wxSizer::Detach( wxSizer *sizer )
 
         if (item->GetSizer() == sizer)
         {
+            sizer->m_parentSizer = NULL;
             item->DetachSizer();
             delete item;
             m_children.Erase( node );
+            InvalidateCachedMinSize();
             return true;
         }
         node = node->GetNext();
@@ -962,6 +1009,7 @@ bool wxSizer::Detach( wxWindow *window )
         {
             delete item;
             m_children.Erase( node );
+            InvalidateCachedMinSize();
             return true;
         }
         node = node->GetNext();
@@ -983,10 +1031,14 @@ bool wxSizer::Detach( int index )
     wxSizerItem *item = node->GetData();
 
     if ( item->IsSizer() )
+    {
+        item->GetSizer()->m_parentSizer = NULL;
         item->DetachSizer();
+    }
 
     delete item;
     m_children.Erase( node );
+    InvalidateCachedMinSize();
     return true;
 }
 
@@ -1004,6 +1056,7 @@ bool wxSizer::Replace( wxWindow *oldwin, wxWindow *newwin, bool recursive )
         {
             item->AssignWindow(newwin);
             newwin->SetContainingSizer( this );
+            InvalidateCachedMinSize();
             return true;
         }
         else if (recursive && item->IsSizer())
@@ -1031,6 +1084,8 @@ bool wxSizer::Replace( wxSizer *oldsz, wxSizer *newsz, bool recursive )
         if (item->GetSizer() == oldsz)
         {
             item->AssignSizer(newsz);
+            newsz->m_parentSizer = this;
+            InvalidateCachedMinSize();
             return true;
         }
         else if (recursive && item->IsSizer())
@@ -1064,6 +1119,12 @@ bool wxSizer::Replace( size_t old, wxSizerItem *newitem )
 
     if (wxWindow* const w = newitem->GetWindow())
         w->SetContainingSizer(this);
+    else if (wxSizer* const sz = newitem->GetSizer())
+        sz->m_parentSizer = this;
+
+    newitem->SetContainingSizer(this);
+
+    InvalidateCachedMinSize();
 
     return true;
 }
@@ -1087,6 +1148,8 @@ void wxSizer::Clear( bool delete_windows )
 
     // Now empty the list
     WX_CLEAR_LIST(wxSizerItemList, m_children);
+
+    InvalidateCachedMinSize();
 }
 
 void wxSizer::DeleteWindows()
@@ -1101,6 +1164,105 @@ void wxSizer::DeleteWindows()
     }
 }
 
+bool wxSizer::ReconcileWindows( const wxVector<wxWindow*>& windows,
+                                const wxSizerFlags& flags,
+                                bool delete_windows )
+{
+    bool changed = false;
+
+    // First collect the windows we manage which don't appear in the new list
+    // any more: they can't be detached while iterating as Detach() may be
+    // overridden (e.g. by wxStaticBoxSizer) and modify the list itself.
+    wxVector<wxWindow*> unwanted;
+
+    wxSizerItemList::compatibility_iterator node;
+    for ( node = m_children.GetFirst(); node; node = node->GetNext() )
+    {
+        wxSizerItem * const item = node->GetData();
+        if ( !item->IsWindow() )
+            continue;
+
+        wxWindow * const w = item->GetWindow();
+
+        bool wanted = false;
+        for ( size_t n = 0; n < windows.size(); n++ )
+        {
+            if ( windows[n] == w )
+            {
+                wanted = true;
+                break;
+            }
+        }
+
+        if ( !wanted )
+            unwanted.push_back(w);
+    }
+
+    for ( size_t n = 0; n < unwanted.size(); n++ )
+    {
+        Detach(unwanted[n]);
+
+        if ( delete_windows )
+            unwanted[n]->Destroy();
+
+        changed = true;
+    }
+
+    // Now bring the remaining windows into the required order, touching as
+    // few items as possible: the windows which are already in the right
+    // relative order are left alone, so any spacers or subsizers between
+    // them keep their positions too.
+    int pos = -1;   // index of the item of the last processed window
+    for ( size_t n = 0; n < windows.size(); n++ )
+    {
+        wxWindow * const w = windows[n];
+        wxCHECK_MSG( w, changed, wxT("NULL window in ReconcileWindows()") );
+
+        // do we already have an item for this window?
+        int cur = wxNOT_FOUND;
+        int i = 0;
+        for ( node = m_children.GetFirst(); node; node = node->GetNext(), i++ )
+        {
+            if ( node->GetData()->GetWindow() == w )
+            {
+                cur = i;
+                break;
+            }
+        }
+
+        if ( cur == wxNOT_FOUND )
+        {
+            // this window is new, insert it after the previous one
+            Insert( (size_t)(pos + 1), w, flags );
+
+            pos++;
+            changed = true;
+        }
+        else if ( cur > pos )
+        {
+            // already in the right order, nothing to do for it
+            pos = cur;
+        }
+        else // cur <= pos, i.e. out of order
+        {
+            // move its existing item, preserving the flags stored in it, to
+            // just after the item of the previous window: as erasing the
+            // node shifted the following items down by one, inserting at
+            // pos puts it exactly there
+            wxSizerItem * const item = node->GetData();
+            m_children.Erase( node );
+            m_children.Insert( (size_t)pos, item );
+
+            changed = true;
+        }
+    }
+
+    if ( changed )
+        InvalidateCachedMinSize();
+
+    return changed;
+}
+
 wxSize wxSizer::ComputeFittingClientSize(wxWindow *window)
 {
     wxCHECK_MSG( window, wxDefaultSize, "window can't be NULL" );
@@ -1183,7 +1345,7 @@ void wxSizer::Layout()
 {
     // (re)calculates minimums needed for each item and other preparations
     // for layout
-    const wxSize minSize = CalcMin();
+    const wxSize minSize = CalcMinCached();
 
     // Applies the layout and repositions/resizes the items
     wxWindow::ChildrenRepositioningGuard repositionGuard(m_containingWindow);
@@ -1236,16 +1398,42 @@ wxSize wxSizer::VirtualFitSize( wxWindow *window )
 
 wxSize wxSizer::GetMinSize()
 {
-    wxSize ret( CalcMin() );
+    wxSize ret( CalcMinCached() );
     if (ret.x < m_minSize.x) ret.x = m_minSize.x;
     if (ret.y < m_minSize.y) ret.y = m_minSize.y;
     return ret;
 }
 
+wxSize wxSizer::CalcMinCached()
+{
+    if ( !m_cachedMinSizeValid )
+    {
+        m_cachedMinSize = CalcMin();
+        m_cachedMinSizeValid = true;
+    }
+
+    return m_cachedMinSize;
+}
+
+void wxSizer::InvalidateCachedMinSize()
+{
+    // Invalidating a sizer always invalidates all the sizers containing it,
+    // so if this one is already invalid, all its ancestors must be too and
+    // we can stop climbing as soon as we find a sizer which is not valid.
+    for ( wxSizer* sizer = this;
+          sizer && sizer->m_cachedMinSizeValid;
+          sizer = sizer->m_parentSizer )
+    {
+        sizer->m_cachedMinSizeValid = false;
+    }
+}
+
 void wxSizer::DoSetMinSize( int width, int height )
 {
     m_minSize.x = width;
     m_minSize.y = height;
+
+    InvalidateCachedMinSize();
 }
 
 bool wxSizer::DoSetItemMinSize( wxWindow *window, int width, int height )
@@ -1262,6 +1450,7 @@ bool wxSizer::DoSetItemMinSize( wxWindow *window, int width, int height )
         if (item->GetWindow() == window)
         {
             item->SetMinSize( width, height );
+            InvalidateCachedMinSize();
             return true;
         }
         node = node->GetNext();
@@ -1341,6 +1530,7 @@ bool wxSizer::DoSetItemMinSize( size_t index, int width, int height )
     {
         // ... but the minimal size of spacers and windows is stored via the item
         item->SetMinSize( width, height );
+        InvalidateCachedMinSize();
     }
 
     return true;
@@ -1441,6 +1631,7 @@ bool wxSizer::Show( wxWindow *window, bool show, bool recursive )
     if ( item )
     {
          item->Show( show );
+         InvalidateCachedMinSize();
          return true;
     }
 
@@ -1454,6 +1645,7 @@ bool wxSizer::Show( wxSizer *sizer, bool show, bool recursive )
     if ( item )
     {
          item->Show( show );
+         InvalidateCachedMinSize();
          return true;
     }
 
@@ -1467,6 +1659,7 @@ bool wxSizer::Show( size_t index, bool show)
     if ( item )
     {
          item->Show( show );
+         InvalidateCachedMinSize();
          return true;
     }
 
@@ -1481,6 +1674,8 @@ void wxSizer::ShowItems( bool show )
         node->GetData()->Show( show );
         node = node->GetNext();
     }
+
+    InvalidateCachedMinSize();
 }
 
 bool wxSizer::AreAnyItemsShown() const
@@ -1653,6 +1848,23 @@ int wxGridSizer::CalcRowsCols(int& nrows, int& ncols) const
     return nitems;
 }
 
+// Copy the items into a contiguous array: the layout passes below go over
+// the items several times (and the grid sizers additionally access them by
+// index) and iterating over an array is much more cache-friendly than
+// chasing list nodes.
+static void
+wxCopySizerItems(wxVector<wxSizerItem*>& items, const wxSizerItemList& list)
+{
+    items.clear();
+    items.reserve(list.GetCount());
+    for ( wxSizerItemList::const_iterator i = list.begin();
+          i != list.end();
+          ++i )
+    {
+        items.push_back(*i);
+    }
+}
+
 void wxGridSizer::RepositionChildren(const wxSize& WXUNUSED(minSize))
 {
     int nitems, nrows, ncols;
@@ -1662,6 +1874,9 @@ void wxGridSizer::RepositionChildren(const wxSize& WXUNUSED(minSize))
     wxSize sz( GetSize() );
     wxPoint pt( GetPosition() );
 
+    wxVector<wxSizerItem*> items;
+    wxCopySizerItems(items, m_children);
+
     int w = (sz.x - (ncols - 1) * m_hgap) / ncols;
     int h = (sz.y - (nrows - 1) * m_vgap) / nrows;
 
@@ -1674,11 +1889,7 @@ void wxGridSizer::RepositionChildren(const wxSize& WXUNUSED(minSize))
             int i = r * ncols + c;
             if (i < nitems)
             {
-                wxSizerItemList::compatibility_iterator node = m_children.Item( i );
-
-                wxASSERT_MSG( node, wxT("Failed to find SizerItemList node") );
-
-                SetItemBounds( node->GetData(), x, y, w, h);
+                SetItemBounds( items[i], x, y, w, h);
             }
             y = y + h + m_vgap;
         }
@@ -1696,44 +1907,37 @@ wxSize wxGridSizer::CalcMin()
     int w = 0;
     int h = 0;
 
-    wxSizerItemList::compatibility_iterator node = m_children.GetFirst();
-    while (node)
+    wxVector<wxSizerItem*> items;
+    wxCopySizerItems(items, m_children);
+
+    const size_t count = items.size();
+    size_t n;
+    for ( n = 0; n < count; n++ )
     {
-        wxSizerItem     *item = node->GetData();
-        wxSize           sz( item->CalcMin() );
+        wxSize sz( items[n]->CalcMin() );
 
         w = wxMax( w, sz.x );
         h = wxMax( h, sz.y );
-
-        node = node->GetNext();
     }
 
     // In case we have a nested sizer with a two step algo , give it
     // a chance to adjust to that (we give it width component)
-    node = m_children.GetFirst();
     bool didChangeMinSize = false;
-    while (node)
+    for ( n = 0; n < count; n++ )
     {
-        wxSizerItem     *item = node->GetData();
-        didChangeMinSize |= item->InformFirstDirection( wxHORIZONTAL, w, -1 );
-
-        node = node->GetNext();
+        didChangeMinSize |= items[n]->InformFirstDirection( wxHORIZONTAL, w, -1 );
     }
 
     // And redo iteration in case min size changed
     if( didChangeMinSize )
     {
-        node = m_children.GetFirst();
         w = h = 0;
-        while (node)
+        for ( n = 0; n < count; n++ )
         {
-            wxSizerItem     *item = node->GetData();
-            wxSize           sz( item->GetMinSizeWithBorder() );
+            wxSize sz( items[n]->GetMinSizeWithBorder() );
 
             w = wxMax( w, sz.x );
             h = wxMax( h, sz.y );
-
-            node = node->GetNext();
         }
     }
 
@@ -2356,9 +2560,12 @@ void wxBoxSizer::RepositionChildren(const wxSize& minSize)
     // stretchable items (i.e. those with non zero proportion)
     int delta = totalMajorSize - GetSizeInMajorDir(minSize);
 
+    wxVector<wxSizerItem*> items;
+    wxCopySizerItems(items, m_children);
+
     // declare loop variables used below:
-    wxSizerItemList::const_iterator i;  // iterator in m_children list
-    unsigned n = 0;                     // item index in majorSizes array
+    const unsigned count = items.size(); // number of items in the sizer
+    unsigned n;                          // item index in majorSizes array
 
 
     // First, inform item about the available size in minor direction as this
@@ -2366,9 +2573,9 @@ void wxBoxSizer::RepositionChildren(const wxSize& minSize)
     // visible items and sum of their min sizes in major direction.
 
     int minMajorSize = 0;
-    for ( i = m_children.begin(); i != m_children.end(); ++i )
+    for ( n = 0; n < count; n++ )
     {
-        wxSizerItem * const item = *i;
+        wxSizerItem * const item = items[n];
 
         if ( !item->IsShown() )
             continue;
@@ -2407,9 +2614,9 @@ void wxBoxSizer::RepositionChildren(const wxSize& minSize)
     {
         // Second degenerated case pass: allocate min size to all fixed size
         // items.
-        for ( i = m_children.begin(), n = 0; i != m_children.end(); ++i, ++n )
+        for ( n = 0; n < count; n++ )
         {
-            wxSizerItem * const item = *i;
+            wxSizerItem * const item = items[n];
 
             if ( !item->IsShown() )
                 continue;
@@ -2424,9 +2631,9 @@ void wxBoxSizer::RepositionChildren(const wxSize& minSize)
 
         // Third degenerated case pass: allocate min size to all the remaining,
         // i.e. non-fixed size, items.
-        for ( i = m_children.begin(), n = 0; i != m_children.end(); ++i, ++n )
+        for ( n = 0; n < count; n++ )
         {
-            wxSizerItem * const item = *i;
+            wxSizerItem * const item = items[n];
 
             if ( !item->IsShown() )
                 continue;
@@ -2452,11 +2659,10 @@ void wxBoxSizer::RepositionChildren(const wxSize& minSize)
         // still reduces into a linear one if there is enough space for all the
         // min sizes).
         bool nonFixedSpaceChanged = false;
-        for ( i = m_children.begin(), n = 0; ; ++i, ++n )
+        for ( n = 0; ; n++ )
         {
             if ( nonFixedSpaceChanged )
             {
-                i = m_children.begin();
                 n = 0;
                 nonFixedSpaceChanged = false;
             }
@@ -2464,10 +2670,10 @@ void wxBoxSizer::RepositionChildren(const wxSize& minSize)
             // check for the end of the loop only after the check above as
             // otherwise we wouldn't do another pass if the last child resulted
             // in non fixed space reduction
-            if ( i == m_children.end() )
+            if ( n == count )
                 break;
 
-            wxSizerItem * const item = *i;
+            wxSizerItem * const item = items[n];
 
             if ( !item->IsShown() )
                 continue;
@@ -2524,11 +2730,10 @@ void wxBoxSizer::RepositionChildren(const wxSize& minSize)
         // is less than what we would allocate to them taking their proportion
         // into account.
         nonFixedSpaceChanged = false;
-        for ( i = m_children.begin(), n = 0; ; ++i, ++n )
+        for ( n = 0; ; n++ )
         {
             if ( nonFixedSpaceChanged )
             {
-                i = m_children.begin();
                 n = 0;
                 nonFixedSpaceChanged = false;
             }
@@ -2536,10 +2741,10 @@ void wxBoxSizer::RepositionChildren(const wxSize& minSize)
             // check for the end of the loop only after the check above as
             // otherwise we wouldn't do another pass if the last child resulted
             // in non fixed space reduction
-            if ( i == m_children.end() )
+            if ( n == count )
                 break;
 
-            wxSizerItem * const item = *i;
+            wxSizerItem * const item = items[n];
 
             if ( !item->IsShown() )
                 continue;
@@ -2583,9 +2788,9 @@ void wxBoxSizer::RepositionChildren(const wxSize& minSize)
 
         // Last by one pass: distribute the remaining space among the non-fixed
         // items whose size weren't fixed yet according to their proportions.
-        for ( i = m_children.begin(), n = 0; i != m_children.end(); ++i, ++n )
+        for ( n = 0; n < count; n++ )
         {
-            wxSizerItem * const item = *i;
+            wxSizerItem * const item = items[n];
 
             if ( !item->IsShown() )
                 continue;
@@ -2608,9 +2813,9 @@ void wxBoxSizer::RepositionChildren(const wxSize& minSize)
 
     // Final pass: finally do position the items correctly using their sizes as
     // determined above.
-    for ( i = m_children.begin(), n = 0; i != m_children.end(); ++i, ++n )
+    for ( n = 0; n < count; n++ )
     {
-        wxSizerItem * const item = *i;
+        wxSizerItem * const item = items[n];
 
         if ( !item->IsShown() )
             continue;
@@ -44,9 +44,11 @@
 
 #include "wx/private/fd.h"
 #include "wx/private/socket.h"
+#include "wx/vector.h"
 
 #ifdef __UNIX__
     #include <errno.h>
+    #include <sys/uio.h>
 #endif
 
 // we use MSG_NOSIGNAL to avoid getting SIGPIPE when sending data to a remote
@@ -679,6 +681,207 @@ int wxSocketImpl::SendStream(const void *buffer, int size)
     return ret;
 }
 
+// ----------------------------------------------------------------------------
+// scatter/gather counterparts of the functions above
+// ----------------------------------------------------------------------------
+
+// maximal number of buffers transferred in a single system call: this is the
+// minimal value of IOV_MAX allowed by POSIX (and is small enough to put the
+// intermediate array on the stack), anything beyond it is transferred by the
+// following calls in wxSocketBase::DoReadV/WriteV() loops
+static const int wxSOCKET_MAX_IOVEC = 16;
+
+#ifdef __WINDOWS__
+
+// convert our buffer descriptors to WSABUFs, returning their number
+static DWORD wxConvertIOVec(WSABUF *out, const wxSocketIOVec *buffers, int count)
+{
+    if ( count > wxSOCKET_MAX_IOVEC )
+        count = wxSOCKET_MAX_IOVEC;
+
+    for ( int n = 0; n < count; n++ )
+    {
+        out[n].buf = static_cast<CHAR *>(buffers[n].buf);
+        out[n].len = buffers[n].len;
+    }
+
+    return count;
+}
+
+#else // !__WINDOWS__
+
+// convert our buffer descriptors to iovecs, returning their number
+static int wxConvertIOVec(struct iovec *out, const wxSocketIOVec *buffers, int count)
+{
+    if ( count > wxSOCKET_MAX_IOVEC )
+        count = wxSOCKET_MAX_IOVEC;
+
+    for ( int n = 0; n < count; n++ )
+    {
+        out[n].iov_base = buffers[n].buf;
+        out[n].iov_len = buffers[n].len;
+    }
+
+    return count;
+}
+
+#endif // __WINDOWS__/!__WINDOWS__
+
+int wxSocketImpl::RecvStreamV(const wxSocketIOVec *buffers, int count)
+{
+    int ret;
+
+#ifdef __WINDOWS__
+    WSABUF bufs[wxSOCKET_MAX_IOVEC];
+    const DWORD n = wxConvertIOVec(bufs, buffers, count);
+
+    DWORD numRead,
+          flags = 0;
+    if ( WSARecv(m_fd, bufs, n, &numRead, &flags, NULL, NULL) == SOCKET_ERROR )
+        ret = SOCKET_ERROR;
+    else
+        ret = numRead;
+#else // !__WINDOWS__
+    struct iovec iov[wxSOCKET_MAX_IOVEC];
+    const int n = wxConvertIOVec(iov, buffers, count);
+
+    DO_WHILE_EINTR( ret, readv(m_fd, iov, n) );
+#endif // __WINDOWS__/!__WINDOWS__
+
+    if ( !ret )
+    {
+        // as in RecvStream(), reading 0 bytes from a TCP socket means that
+        // the peer closed the connection
+        m_establishing = false;
+        NotifyOnStateChange(wxSOCKET_LOST);
+
+        Shutdown();
+    }
+
+    return ret;
+}
+
+int wxSocketImpl::SendStreamV(const wxSocketIOVec *buffers, int count)
+{
+    int ret;
+
+#ifdef __WINDOWS__
+    WSABUF bufs[wxSOCKET_MAX_IOVEC];
+    const DWORD n = wxConvertIOVec(bufs, buffers, count);
+
+    DWORD numWritten;
+    if ( WSASend(m_fd, bufs, n, &numWritten, 0, NULL, NULL) == SOCKET_ERROR )
+        ret = SOCKET_ERROR;
+    else
+        ret = numWritten;
+#else // !__WINDOWS__
+#ifdef wxNEEDS_IGNORE_SIGPIPE
+    IgnoreSignal ignore(SIGPIPE);
+#endif
+
+    struct iovec iov[wxSOCKET_MAX_IOVEC];
+
+    // use sendmsg() and not writev() because only the former allows passing
+    // MSG_NOSIGNAL preventing us from dying from SIGPIPE
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = wxConvertIOVec(iov, buffers, count);
+
+    DO_WHILE_EINTR( ret, sendmsg(m_fd, &msg, wxSOCKET_MSG_NOSIGNAL) );
+#endif // __WINDOWS__/!__WINDOWS__
+
+    return ret;
+}
+
+int wxSocketImpl::RecvDgramV(const wxSocketIOVec *buffers, int count)
+{
+    wxSockAddressStorage from;
+    WX_SOCKLEN_T fromlen = sizeof(from);
+
+    int ret;
+
+#ifdef __WINDOWS__
+    WSABUF bufs[wxSOCKET_MAX_IOVEC];
+    const DWORD n = wxConvertIOVec(bufs, buffers, count);
+
+    DWORD numRead,
+          flags = 0;
+    if ( WSARecvFrom(m_fd, bufs, n, &numRead, &flags,
+                     &from.addr, &fromlen, NULL, NULL) == SOCKET_ERROR )
+        return SOCKET_ERROR;
+
+    ret = numRead;
+#else // !__WINDOWS__
+    struct iovec iov[wxSOCKET_MAX_IOVEC];
+
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_name = &from.addr;
+    msg.msg_namelen = fromlen;
+    msg.msg_iov = iov;
+    msg.msg_iovlen = wxConvertIOVec(iov, buffers, count);
+
+    DO_WHILE_EINTR( ret, recvmsg(m_fd, &msg, 0) );
+
+    if ( ret == SOCKET_ERROR )
+        return SOCKET_ERROR;
+
+    fromlen = msg.msg_namelen;
+#endif // __WINDOWS__/!__WINDOWS__
+
+    m_peer = wxSockAddressImpl(from.addr, fromlen);
+    if ( !m_peer.IsOk() )
+        return -1;
+
+    return ret;
+}
+
+int wxSocketImpl::SendDgramV(const wxSocketIOVec *buffers, int count)
+{
+    if ( !m_peer.IsOk() )
+    {
+        m_error = wxSOCKET_INVADDR;
+        return -1;
+    }
+
+    // unlike for the stream sockets, we can't send the extra buffers with the
+    // following calls as this would split the datagram, so fail outright
+    if ( count > wxSOCKET_MAX_IOVEC )
+    {
+        m_error = wxSOCKET_INVOP;
+        return -1;
+    }
+
+    int ret;
+
+#ifdef __WINDOWS__
+    WSABUF bufs[wxSOCKET_MAX_IOVEC];
+    const DWORD n = wxConvertIOVec(bufs, buffers, count);
+
+    DWORD numWritten;
+    if ( WSASendTo(m_fd, bufs, n, &numWritten, 0,
+                   m_peer.GetAddr(), m_peer.GetLen(), NULL, NULL)
+            == SOCKET_ERROR )
+        ret = SOCKET_ERROR;
+    else
+        ret = numWritten;
+#else // !__WINDOWS__
+    struct iovec iov[wxSOCKET_MAX_IOVEC];
+
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_name = const_cast<sockaddr *>(m_peer.GetAddr());
+    msg.msg_namelen = m_peer.GetLen();
+    msg.msg_iov = iov;
+    msg.msg_iovlen = wxConvertIOVec(iov, buffers, count);
+
+    DO_WHILE_EINTR( ret, sendmsg(m_fd, &msg, wxSOCKET_MSG_NOSIGNAL) );
+#endif // __WINDOWS__/!__WINDOWS__
+
+    return ret;
+}
+
 int wxSocketImpl::RecvDgram(void *buffer, int size)
 {
     wxSockAddressStorage from;
@@ -746,6 +949,39 @@ int wxSocketImpl::Write(const void *buffer, int size)
     return ret;
 }
 
+int wxSocketImpl::ReadV(const wxSocketIOVec *buffers, int count)
+{
+    // server sockets can't be used for IO, only to accept new connections
+    if ( m_fd == INVALID_SOCKET || m_server )
+    {
+        m_error = wxSOCKET_INVSOCK;
+        return -1;
+    }
+
+    int ret = m_stream ? RecvStreamV(buffers, count)
+                       : RecvDgramV(buffers, count);
+
+    m_error = ret == SOCKET_ERROR ? GetLastError() : wxSOCKET_NOERROR;
+
+    return ret;
+}
+
+int wxSocketImpl::WriteV(const wxSocketIOVec *buffers, int count)
+{
+    if ( m_fd == INVALID_SOCKET || m_server )
+    {
+        m_error = wxSOCKET_INVSOCK;
+        return -1;
+    }
+
+    int ret = m_stream ? SendStreamV(buffers, count)
+                       : SendDgramV(buffers, count);
+
+    m_error = ret == SOCKET_ERROR ? GetLastError() : wxSOCKET_NOERROR;
+
+    return ret;
+}
+
 // ==========================================================================
 // wxSocketBase
 // ==========================================================================
@@ -1053,6 +1289,134 @@ wxUint32 wxSocketBase::DoRead(void* buffer_, wxUint32 nbytes)
     return total;
 }
 
+// helper of DoReadV() and DoWriteV(): skip the first "transferred" bytes of
+// the given buffers by adjusting them and advancing the "first" index, also
+// skipping any buffers which become -- or already were -- empty
+static void wxAdvanceIOVec(wxSocketIOVec *buffers,
+                           size_t count,
+                           size_t& first,
+                           wxUint32 transferred)
+{
+    while ( first < count )
+    {
+        wxSocketIOVec& buf = buffers[first];
+        if ( transferred >= buf.len )
+        {
+            // this buffer was fully transferred (or is empty), skip it
+            transferred -= buf.len;
+            first++;
+        }
+        else
+        {
+            // partially transferred buffer: skip its consumed part
+            buf.buf = static_cast<char *>(buf.buf) + transferred;
+            buf.len -= transferred;
+            break;
+        }
+    }
+}
+
+wxSocketBase& wxSocketBase::ReadV(const wxSocketIOVec *buffers, size_t count)
+{
+    wxSocketReadGuard read(this);
+
+    m_lcount_read = DoReadV(buffers, count);
+    m_lcount = m_lcount_read;
+
+    return *this;
+}
+
+// This function is the scatter/gather version of DoRead(), please see the
+// comments there for the explanation of the logic common to both of them.
+wxUint32 wxSocketBase::DoReadV(const wxSocketIOVec *buffers, size_t count)
+{
+    wxCHECK_MSG( m_impl, 0, "socket must be valid" );
+    wxCHECK_MSG( buffers || !count, 0, "NULL buffers" );
+
+    if ( !count )
+        return 0;
+
+    // we need our own copy of the buffer descriptors as we adjust them as
+    // the data gets transferred
+    wxVector<wxSocketIOVec> bufs;
+    bufs.reserve(count);
+    for ( size_t n = 0; n < count; n++ )
+        bufs.push_back(buffers[n]);
+
+    wxUint32 total = 0;
+    size_t first = 0;
+
+    // skip any initially empty buffers
+    wxAdvanceIOVec(&bufs[0], count, first, 0);
+
+    // try the push back buffer first, as in DoRead()
+    while ( first < count )
+    {
+        const wxUint32 requested = bufs[first].len;
+        const wxUint32 len = GetPushback(bufs[first].buf, requested, false);
+        if ( !len )
+            break;
+
+        total += len;
+        wxAdvanceIOVec(&bufs[0], count, first, len);
+
+        if ( len < requested )
+        {
+            // the push back buffer is exhausted
+            break;
+        }
+    }
+
+    while ( first < count )
+    {
+        const int ret = !m_impl->m_stream || m_connected
+                            ? m_impl->ReadV(&bufs[0] + first,
+                                            static_cast<int>(count - first))
+                            : 0;
+        if ( ret == -1 )
+        {
+            if ( m_impl->GetLastError() == wxSOCKET_WOULDBLOCK )
+            {
+                if ( m_flags & wxSOCKET_NOWAIT_READ )
+                {
+                    SetError(wxSOCKET_NOERROR);
+                    break;
+                }
+
+                if ( !DoWaitWithTimeout(wxSOCKET_INPUT_FLAG) )
+                {
+                    SetError(wxSOCKET_TIMEDOUT);
+                    break;
+                }
+
+                continue;
+            }
+            else // "real" error
+            {
+                SetError(wxSOCKET_IOERR);
+                break;
+            }
+        }
+        else if ( ret == 0 )
+        {
+            m_closed = true;
+
+            if ( (m_flags & wxSOCKET_WAITALL_READ) || !total )
+                SetError(wxSOCKET_IOERR);
+            break;
+        }
+
+        total += ret;
+
+        if ( !(m_flags & wxSOCKET_WAITALL_READ) )
+            break;
+
+        wxAdvanceIOVec(&bufs[0], count, first, ret);
+    }
+
+    return total;
+}
+
 wxSocketBase& wxSocketBase::ReadMsg(void* buffer, wxUint32 nbytes)
 {
     struct
@@ -1208,6 +1572,81 @@ wxUint32 wxSocketBase::DoWrite(const void *buffer_, wxUint32 nbytes)
     return total;
 }
 
+wxSocketBase& wxSocketBase::WriteV(const wxSocketIOVec *buffers, size_t count)
+{
+    wxSocketWriteGuard write(this);
+
+    m_lcount_write = DoWriteV(buffers, count);
+    m_lcount = m_lcount_write;
+
+    return *this;
+}
+
+// The scatter/gather version of DoWrite(), see the comments there and in
+// DoRead().
+wxUint32 wxSocketBase::DoWriteV(const wxSocketIOVec *buffers, size_t count)
+{
+    wxCHECK_MSG( m_impl, 0, "socket must be valid" );
+    wxCHECK_MSG( buffers || !count, 0, "NULL buffers" );
+
+    if ( !count )
+        return 0;
+
+    wxVector<wxSocketIOVec> bufs;
+    bufs.reserve(count);
+    for ( size_t n = 0; n < count; n++ )
+        bufs.push_back(buffers[n]);
+
+    wxUint32 total = 0;
+    size_t first = 0;
+
+    // skip any initially empty buffers
+    wxAdvanceIOVec(&bufs[0], count, first, 0);
+
+    while ( first < count )
+    {
+        if ( m_impl->m_stream && !m_connected )
+        {
+            if ( (m_flags & wxSOCKET_WAITALL_WRITE) || !total )
+                SetError(wxSOCKET_IOERR);
+            break;
+        }
+
+        const int ret = m_impl->WriteV(&bufs[0] + first,
+                                       static_cast<int>(count - first));
+        if ( ret == -1 )
+        {
+            if ( m_impl->GetLastError() == wxSOCKET_WOULDBLOCK )
+            {
+                if ( m_flags & wxSOCKET_NOWAIT_WRITE )
+                    break;
+
+                if ( !DoWaitWithTimeout(wxSOCKET_OUTPUT_FLAG) )
+                {
+                    SetError(wxSOCKET_TIMEDOUT);
+                    break;
+                }
+
+                continue;
+            }
+            else // "real" error
+            {
+                SetError(wxSOCKET_IOERR);
+                break;
+            }
+        }
+
+        total += ret;
+
+        if ( !(m_flags & wxSOCKET_WAITALL_WRITE) )
+            break;
+
+        wxAdvanceIOVec(&bufs[0], count, first, ret);
+    }
+
+    return total;
+}
+
 wxSocketBase& wxSocketBase::WriteMsg(const void *buffer, wxUint32 nbytes)
 {
     struct
@@ -1977,6 +2416,168 @@ bool wxSocketBase::SetLocal(const wxIPV4address& local)
 // wxSocketClient
 // ==========================================================================
 
+#if wxUSE_THREADS
+
+// --------------------------------------------------------------------------
+// Asynchronous host name resolution used by ConnectAsync()
+// --------------------------------------------------------------------------
+
+// The resolution itself is done in a detached worker thread which passes its
+// result back to the main thread via an event. As the socket may be destroyed
+// or reused for another connection attempt while the lookup is running, the
+// threads don't keep any pointer to it: instead, every lookup is identified
+// by a unique token and a map of the tokens of the lookups still being
+// waited for allows to find the socket -- or to discard the result.
+
+namespace
+{
+
+// protects everything below
+wxCriticalSection gs_resolveCS;
+
+long gs_resolveLastToken = 0;
+
+WX_DECLARE_HASH_MAP(long, wxSocketClient*, wxIntegerHash, wxIntegerEqual,
+                    wxSocketResolveMap);
+
+wxSocketResolveMap gs_resolvesInProgress;
+
+class wxSocketResolveCoordinator;
+wxSocketResolveCoordinator *gs_resolveCoordinator = NULL;
+
+// event used to pass the lookup results to the main thread
+class wxSocketResolveEvent;
+wxDEFINE_EVENT(wxEVT_SOCKET_RESOLVE_DONE, wxSocketResolveEvent);
+
+class wxSocketResolveEvent : public wxEvent
+{
+public:
+    wxSocketResolveEvent(long token,
+                         bool ok,
+                         wxUint32 hostAddress,
+                         unsigned short port)
+        : wxEvent(wxID_ANY, wxEVT_SOCKET_RESOLVE_DONE),
+          m_token(token),
+          m_ok(ok),
+          m_hostAddress(hostAddress),
+          m_port(port)
+    {
+    }
+
+    virtual wxEvent *Clone() const wxOVERRIDE
+    {
+        return new wxSocketResolveEvent(*this);
+    }
+
+    const long m_token;
+    const bool m_ok;
+    const wxUint32 m_hostAddress;   // in host byte order
+    const unsigned short m_port;
+};
+
+// handler living in the main thread which dispatches the lookup results to
+// the sockets still interested in them
+class wxSocketResolveCoordinator : public wxEvtHandler
+{
+public:
+    wxSocketResolveCoordinator()
+    {
+        Bind(wxEVT_SOCKET_RESOLVE_DONE,
+             &wxSocketResolveCoordinator::OnResolveDone, this);
+    }
+
+private:
+    void OnResolveDone(wxSocketResolveEvent& event)
+    {
+        wxSocketClient *client = NULL;
+
+        {
+            wxCriticalSectionLocker lock(gs_resolveCS);
+
+            wxSocketResolveMap::iterator
+                it = gs_resolvesInProgress.find(event.m_token);
+            if ( it != gs_resolvesInProgress.end() )
+            {
+                client = it->second;
+                gs_resolvesInProgress.erase(it);
+            }
+        }
+
+        // the socket could have been destroyed or reused for another
+        // connection attempt while the lookup was running
+        if ( client )
+        {
+            client->OnAsyncResolveDone(event.m_ok,
+                                       event.m_hostAddress,
+                                       event.m_port);
+        }
+    }
+
+    wxDECLARE_NO_COPY_CLASS(wxSocketResolveCoordinator);
+};
+
+// worker thread performing a single lookup: it only uses its own data and
+// the (MT-safe) name lookup functions, so needs no synchronization with the
+// socket whatsoever
+class wxSocketResolverThread : public wxThread
+{
+public:
+    wxSocketResolverThread(long token,
+                           const wxString& host,
+                           unsigned short port)
+        : wxThread(wxTHREAD_DETACHED),
+          m_token(token),
+          m_host(host.Clone()),   // deep copy for passing between threads
+          m_port(port)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() wxOVERRIDE
+    {
+        // This blocks, which is the whole point of doing it in this thread.
+        // It also populates the wxSockAddress name lookup cache, so that the
+        // following lookups of the same name don't block any more.
+        wxIPV4address addr;
+        wxUint32 hostAddress = 0;
+        const bool ok = addr.Hostname(m_host) &&
+                            addr.GetAddress().GetHostAddress(&hostAddress);
+
+        wxCriticalSectionLocker lock(gs_resolveCS);
+
+        // don't bother posting the result if nobody waits for it any more
+        if ( gs_resolveCoordinator &&
+                gs_resolvesInProgress.count(m_token) )
+        {
+            gs_resolveCoordinator->QueueEvent(
+                new wxSocketResolveEvent(m_token, ok, hostAddress, m_port));
+        }
+
+        return NULL;
+    }
+
+private:
+    const long m_token;
+    const wxString m_host;
+    const unsigned short m_port;
+
+    wxDECLARE_NO_COPY_CLASS(wxSocketResolverThread);
+};
+
+// called during the library shutdown to free the coordinator and ensure that
+// the threads which didn't finish yet discard their results
+void wxSocketResolveShutdown()
+{
+    wxCriticalSectionLocker lock(gs_resolveCS);
+
+    gs_resolvesInProgress.clear();
+    wxDELETE(gs_resolveCoordinator);
+}
+
+} // anonymous namespace
+
+#endif // wxUSE_THREADS
+
 // --------------------------------------------------------------------------
 // Ctor and dtor
 // --------------------------------------------------------------------------
@@ -1995,6 +2596,17 @@ wxSocketClient::wxSocketClient(wxSocketFlags flags)
 
     m_initialRecvBufferSize =
     m_initialSendBufferSize = -1;
+
+#if wxUSE_THREADS
+    m_asyncResolveToken = 0;
+#endif
+}
+
+wxSocketClient::~wxSocketClient()
+{
+#if wxUSE_THREADS
+    CancelAsyncResolve();
+#endif
 }
 
 // --------------------------------------------------------------------------
@@ -2005,6 +2617,12 @@ bool wxSocketClient::DoConnect(const wxSockAddress& remote,
                                const wxSockAddress* local,
                                bool wait)
 {
+#if wxUSE_THREADS
+    // if an asynchronous lookup is still in progress, its result doesn't
+    // interest us any longer
+    CancelAsyncResolve();
+#endif
+
     if ( m_impl )
     {
         // Shutdown and destroy the old socket
@@ -2072,6 +2690,103 @@ bool wxSocketClient::Connect(const wxSockAddress& remote,
     return DoConnect(remote, &local, wait);
 }
 
+#if wxUSE_THREADS
+
+bool wxSocketClient::ConnectAsync(const wxString& host, unsigned short port)
+{
+    wxCHECK_MSG( wxIsMainThread(), false,
+                 "ConnectAsync() may only be called from the main thread" );
+
+    // forget about any previous pending lookup
+    CancelAsyncResolve();
+
+    long token;
+    {
+        wxCriticalSectionLocker lock(gs_resolveCS);
+
+        if ( !gs_resolveCoordinator )
+            gs_resolveCoordinator = new wxSocketResolveCoordinator;
+
+        token = ++gs_resolveLastToken;
+        gs_resolvesInProgress[token] = this;
+    }
+
+    wxSocketResolverThread * const
+        thread = new wxSocketResolverThread(token, host, port);
+    if ( thread->Run() != wxTHREAD_NO_ERROR )
+    {
+        delete thread;
+
+        wxCriticalSectionLocker lock(gs_resolveCS);
+        gs_resolvesInProgress.erase(token);
+
+        return false;
+    }
+
+    m_asyncResolveToken = token;
+    m_connected = false;
+    m_establishing = true;
+
+    return true;
+}
+
+void wxSocketClient::OnAsyncResolveDone(bool ok,
+                                        wxUint32 hostAddress,
+                                        unsigned short port)
+{
+    m_asyncResolveToken = 0;
+
+    if ( !ok )
+    {
+        m_establishing = false;
+
+        // we may not have the implementation object yet if this was the
+        // first connection attempt, but we need it to store the error code
+        // so that LastError() can return it
+        if ( !m_impl )
+        {
+            wxSocketManager * const manager = wxSocketManager::Get();
+            m_impl = manager ? manager->CreateSocket(*this) : NULL;
+        }
+
+        if ( m_impl )
+            SetError(wxSOCKET_NOHOST);
+
+        OnRequest(wxSOCKET_LOST);
+        return;
+    }
+
+    wxIPV4address addr;
+    addr.Hostname(static_cast<unsigned long>(hostAddress));
+    addr.Service(port);
+
+    if ( DoConnect(addr, NULL, false) )
+    {
+        // connected immediately, notify in the same way as if it had taken
+        // some time
+        OnRequest(wxSOCKET_CONNECTION);
+    }
+    else if ( !m_establishing )
+    {
+        // failed outright, without even starting to connect
+        OnRequest(wxSOCKET_LOST);
+    }
+    //else: connection in progress, the usual events will be generated
+}
+
+void wxSocketClient::CancelAsyncResolve()
+{
+    if ( !m_asyncResolveToken )
+        return;
+
+    wxCriticalSectionLocker lock(gs_resolveCS);
+
+    gs_resolvesInProgress.erase(m_asyncResolveToken);
+    m_asyncResolveToken = 0;
+}
+
+#endif // wxUSE_THREADS
+
 bool wxSocketClient::WaitOnConnect(long seconds, long milliseconds)
 {
     if ( m_connected )
@@ -2167,6 +2882,10 @@ public:
 
     virtual void OnExit() wxOVERRIDE
     {
+#if wxUSE_THREADS
+        wxSocketResolveShutdown();
+#endif
+
         if ( wxSocketBase::IsInitialized() )
             wxSocketBase::Shutdown();
     }
@@ -909,6 +909,70 @@ size_t wxMBConvUTF7::FromWChar(char *dst, size_t dstLen,
 // UTF-8
 // ----------------------------------------------------------------------------
 
+// Helpers for bulk conversion of pure ASCII runs: most "UTF-8" data processed
+// by real programs is predominantly ASCII, so both directions of the
+// conversion first skip over as many ASCII characters as possible a block at
+// a time and only use the generic, one code point at a time, loop for the
+// rest.
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+    #define wxHAVE_UTF8_BLOCK_CONV
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define wxHAVE_UTF8_BLOCK_CONV
+#endif
+
+// Return the length of the leading run of ASCII (i.e. with the high bit
+// clear) bytes, which is at most len.
+static size_t wxUTF8ScanAscii(const char *src, size_t len)
+{
+    size_t n = 0;
+
+#ifdef wxHAVE_UTF8_BLOCK_CONV
+    while ( len - n >= 16 )
+    {
+#if defined(__SSE2__)
+        const __m128i block =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + n));
+        const int mask = _mm_movemask_epi8(block);
+        if ( mask )
+        {
+            // the lowest set bit gives the first non-ASCII byte
+            unsigned bit = 0;
+            while ( !(mask & (1 << bit)) )
+                bit++;
+            return n + bit;
+        }
+#else // NEON
+        const uint8x16_t block =
+            vld1q_u8(reinterpret_cast<const uint8_t *>(src + n));
+        if ( vmaxvq_u8(block) & 0x80 )
+            break;
+#endif
+        n += 16;
+    }
+#endif // wxHAVE_UTF8_BLOCK_CONV
+
+    // scalar tail (and fallback when no vector unit is available): unrolling
+    // via word-sized loads isn't worth the alignment complications here
+    while ( n < len && !(static_cast<unsigned char>(src[n]) & 0x80) )
+        n++;
+
+    return n;
+}
+
+// Return the length of the leading run of wide characters representable as a
+// single ASCII byte, at most len.
+static size_t wxUTF8ScanAsciiW(const wchar_t *src, size_t len)
+{
+    size_t n = 0;
+    while ( n < len && static_cast<wxUint32>(src[n]) <= 0x7F )
+        n++;
+
+    return n;
+}
+
 static const wxUint32 utf8_max[]=
     { 0x7f, 0x7ff, 0xffff, 0x1fffff, 0x3ffffff, 0x7fffffff, 0xffffffff };
 
@@ -964,6 +1028,32 @@ wxMBConvStrictUTF8::ToWChar(wchar_t *dst, size_t dstLen,
 
     for ( const char *p = src; ; p++ )
     {
+        // Bulk-convert any leading ASCII run: this is only done when the
+        // length is known in advance as we may not look ahead past the
+        // terminating NUL otherwise.
+        if ( srcLen != wxNO_LEN && srcLen )
+        {
+            size_t run = wxUTF8ScanAscii(p, srcLen);
+            if ( out && run > dstLen )
+                run = dstLen;
+
+            if ( run )
+            {
+                if ( out )
+                {
+                    for ( size_t i = 0; i < run; i++ )
+                        out[i] = (wchar_t)(unsigned char)p[i];
+
+                    out += run;
+                    dstLen -= run;
+                }
+
+                written += run;
+                srcLen -= run;
+                p += run;
+            }
+        }
+
         if ( (srcLen == wxNO_LEN ? !*p : !srcLen) )
         {
             // all done successfully, just add the trailing NULL if we are not
@@ -1077,6 +1167,30 @@ wxMBConvStrictUTF8::FromWChar(char *dst, size_t dstLen,
     const wchar_t* const end = srcLen == wxNO_LEN ? NULL : src + srcLen;
     for ( const wchar_t *wp = src; ; )
     {
+        // Bulk-convert any leading run of characters encoded as a single
+        // ASCII byte, see the comment before wxUTF8ScanAscii().
+        if ( end )
+        {
+            size_t run = wxUTF8ScanAsciiW(wp, end - wp);
+            if ( out && run > dstLen )
+                run = dstLen;
+
+            if ( run )
+            {
+                if ( out )
+                {
+                    for ( size_t i = 0; i < run; i++ )
+                        out[i] = (char)wp[i];
+
+                    out += run;
+                    dstLen -= run;
+                }
+
+                written += run;
+                wp += run;
+            }
+        }
+
         if ( end ? wp == end : !*wp )
         {
             // all done successfully, just add the trailing NULL if we are not
@@ -31,9 +31,14 @@
 
 #include <ctype.h>
 #include "wx/datstrm.h"
+#include "wx/opctx.h"
 #include "wx/textfile.h"
 #include "wx/scopeguard.h"
 
+#if wxUSE_THREADS
+    #include "wx/thread.h"
+#endif
+
 // ----------------------------------------------------------------------------
 // constants
 // ----------------------------------------------------------------------------
@@ -41,10 +46,162 @@
 // the temporary buffer size used when copying from stream to stream
 #define BUF_TEMP_SIZE 4096
 
+// adaptive read buffers are never grown beyond this size
+#define ADAPTIVE_BUF_MAX_SIZE (256*1024)
+
 // ============================================================================
 // implementation
 // ============================================================================
 
+#if wxUSE_THREADS
+
+// ----------------------------------------------------------------------------
+// wxStreamBufferReadAhead
+// ----------------------------------------------------------------------------
+
+// worker thread used by wxStreamBuffer::EnableReadAhead(): reads the next
+// block from the underlying stream into its own buffer while the data already
+// in the stream buffer is being consumed
+class wxStreamBufferReadAhead : public wxThread
+{
+public:
+    wxStreamBufferReadAhead(wxStreamBuffer *owner)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_owner(owner),
+          m_buffer(NULL),
+          m_size(0),
+          m_count(0),
+          m_pending(false),
+          m_quit(false),
+          m_semRequest(0, 0),
+          m_semDone(0, 0)
+    {
+    }
+
+    virtual ~wxStreamBufferReadAhead()
+    {
+        free(m_buffer);
+    }
+
+    // start reading the next block of the given size, there must be no other
+    // read outstanding
+    bool Start(size_t size)
+    {
+        wxCHECK_MSG( !m_pending, false, wxT("read ahead already in progress") );
+
+        if ( size != m_size )
+        {
+            void * const p = realloc(m_buffer, size);
+            if ( !p )
+                return false;
+
+            m_buffer = static_cast<char *>(p);
+            m_size = size;
+        }
+
+        m_pending = true;
+        m_semRequest.Post();
+
+        return true;
+    }
+
+    // is there an outstanding (or already completed but not yet consumed)
+    // read?
+    bool IsPending() const { return m_pending; }
+
+    // wait until the outstanding read completes and take its result: our
+    // filled buffer is exchanged with the given one, which will be used for
+    // the next read, to avoid copying the data
+    size_t Finish(char **buffer, size_t bufferSize)
+    {
+        m_semDone.Wait();
+        m_pending = false;
+
+        char * const filled = m_buffer;
+        m_buffer = *buffer;
+        m_size = bufferSize;
+        *buffer = filled;
+
+        return m_count;
+    }
+
+    // return the number of bytes read in advance and still unconsumed,
+    // waiting for the read to complete if necessary: they have already been
+    // taken from the underlying stream, so its position is ahead by as much
+    size_t GetPendingCount()
+    {
+        if ( !m_pending )
+            return 0;
+
+        // wait for the read to finish but leave it pending: re-post the
+        // semaphore for the later Finish() or Cancel() call
+        m_semDone.Wait();
+        m_semDone.Post();
+
+        return m_count;
+    }
+
+    // discard the result of the outstanding read, if any, seeking the
+    // underlying stream back over the bytes read in advance
+    void Cancel()
+    {
+        if ( !m_pending )
+            return;
+
+        m_semDone.Wait();
+        m_pending = false;
+
+        if ( m_count )
+            m_owner->SeekStreamBack(m_count);
+    }
+
+    // make the thread exit, the caller must Wait() for it afterwards and
+    // there must be no read outstanding
+    void Quit()
+    {
+        m_quit = true;
+        m_semRequest.Post();
+    }
+
+protected:
+    virtual ExitCode Entry() wxOVERRIDE
+    {
+        for ( ;; )
+        {
+            m_semRequest.Wait();
+
+            if ( m_quit )
+                break;
+
+            m_count = m_owner->ReadFromStream(m_buffer, m_size);
+            m_semDone.Post();
+        }
+
+        return NULL;
+    }
+
+private:
+    wxStreamBuffer * const m_owner;
+
+    // our own buffer, exchanged with the stream buffer one by Finish()
+    char *m_buffer;
+    size_t m_size;
+
+    // the result of the last read, only valid after m_semDone was posted
+    size_t m_count;
+
+    bool m_pending;
+    bool m_quit;
+
+    // posted for every block to read and once it was read respectively
+    wxSemaphore m_semRequest,
+                m_semDone;
+
+    wxDECLARE_NO_COPY_CLASS(wxStreamBufferReadAhead);
+};
+
+#endif // wxUSE_THREADS
+
 // ----------------------------------------------------------------------------
 // wxStreamBuffer
 // ----------------------------------------------------------------------------
@@ -70,6 +227,10 @@ void wxStreamBuffer::Init()
     InitBuffer();
 
     m_fixed = true;
+    m_adaptive = false;
+    m_nConsecutiveFills = 0;
+    m_readAhead = NULL;
+    m_readAheadCapacity = 0;
 }
 
 void wxStreamBuffer::InitWithStream(wxStreamBase& stream, BufMode mode)
@@ -107,6 +268,12 @@ wxStreamBuffer::wxStreamBuffer(const wxStreamBuffer& buffer)
     m_stream = buffer.m_stream;
     m_mode = buffer.m_mode;
     m_destroybuf = false;
+
+    // neither the adaptivity nor the read ahead thread are inherited
+    m_adaptive = false;
+    m_nConsecutiveFills = 0;
+    m_readAhead = NULL;
+    m_readAheadCapacity = 0;
 }
 
 void wxStreamBuffer::FreeBuffer()
@@ -120,6 +287,8 @@ void wxStreamBuffer::FreeBuffer()
 
 wxStreamBuffer::~wxStreamBuffer()
 {
+    StopReadAhead();
+
     FreeBuffer();
 }
 
@@ -145,6 +314,10 @@ void wxStreamBuffer::SetBufferIO(void *start,
                                  size_t len,
                                  bool takeOwnership)
 {
+    // the old buffer contents, including any data read in advance, is lost
+    CancelReadAhead();
+    m_readAheadCapacity = len;
+
     // start by freeing the old buffer
     FreeBuffer();
 
@@ -180,6 +353,9 @@ void wxStreamBuffer::ResetBuffer()
         m_stream->m_lastcount = 0;
     }
 
+    // the access is not sequential any more
+    m_nConsecutiveFills = 0;
+
     m_buffer_pos = m_mode == read && m_flushable
                         ? m_buffer_end
                         : m_buffer_start;
@@ -215,6 +391,14 @@ bool wxStreamBuffer::FillBuffer()
     if ( !inStream )
         return false;
 
+#if wxUSE_THREADS
+    if ( m_readAhead )
+        return FillBufferFromReadAhead();
+#endif // wxUSE_THREADS
+
+    if ( m_adaptive )
+        GrowIfSequential();
+
     size_t count = inStream->OnSysRead(GetBufferStart(), GetBufferSize());
     if ( !count )
         return false;
@@ -225,6 +409,138 @@ bool wxStreamBuffer::FillBuffer()
     return true;
 }
 
+// grow the buffer of an adaptive read stream while it keeps being refilled
+// without any seeks: sequentially reading through it in bigger and bigger
+// blocks reduces the number of calls to the underlying stream
+void wxStreamBuffer::GrowIfSequential()
+{
+    // only grow after the entire buffer was consumed at least once
+    if ( m_nConsecutiveFills++ == 0 )
+        return;
+
+    const size_t size = GetBufferSize();
+    if ( !size || size >= ADAPTIVE_BUF_MAX_SIZE || !m_destroybuf )
+        return;
+
+    size_t new_size = size*4;
+    if ( new_size > ADAPTIVE_BUF_MAX_SIZE )
+        new_size = ADAPTIVE_BUF_MAX_SIZE;
+
+    char * const p = static_cast<char *>(realloc(m_buffer_start, new_size));
+    if ( !p )
+    {
+        // not a problem, just continue using the old, smaller buffer
+        return;
+    }
+
+    m_buffer_start = p;
+    m_buffer_end = m_buffer_start + new_size;
+
+    // the buffer is empty when we're called from FillBuffer()
+    m_buffer_pos = m_buffer_end;
+}
+
+size_t wxStreamBuffer::ReadFromStream(void *buffer, size_t size)
+{
+    wxInputStream * const inStream = GetInputStream();
+
+    return inStream ? inStream->OnSysRead(buffer, size) : 0;
+}
+
+void wxStreamBuffer::SeekStreamBack(size_t size)
+{
+    m_stream->OnSysSeek(-(wxFileOffset)size, wxFromCurrent);
+}
+
+bool wxStreamBuffer::EnableReadAhead(bool enable)
+{
+#if wxUSE_THREADS
+    if ( !enable )
+    {
+        StopReadAhead();
+        return true;
+    }
+
+    if ( m_readAhead )
+        return true;
+
+    // we exchange the buffer with the thread, so it must be ours, and we need
+    // a stream to read from
+    wxCHECK_MSG( m_mode == read, false,
+                 wxT("read ahead only makes sense for read buffers") );
+    if ( !HasBuffer() || !m_destroybuf || !GetInputStream() )
+        return false;
+
+    m_readAheadCapacity = GetBufferSize();
+
+    m_readAhead = new wxStreamBufferReadAhead(this);
+    if ( m_readAhead->Run() != wxTHREAD_NO_ERROR )
+    {
+        wxDELETE(m_readAhead);
+        return false;
+    }
+
+    return true;
+#else // !wxUSE_THREADS
+    wxUnusedVar(enable);
+
+    return false;
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+}
+
+void wxStreamBuffer::CancelReadAhead()
+{
+#if wxUSE_THREADS
+    if ( m_readAhead )
+        m_readAhead->Cancel();
+#endif // wxUSE_THREADS
+}
+
+void wxStreamBuffer::StopReadAhead()
+{
+#if wxUSE_THREADS
+    if ( !m_readAhead )
+        return;
+
+    m_readAhead->Cancel();
+    m_readAhead->Quit();
+    m_readAhead->Wait();
+    wxDELETE(m_readAhead);
+#endif // wxUSE_THREADS
+}
+
+#if wxUSE_THREADS
+
+bool wxStreamBuffer::FillBufferFromReadAhead()
+{
+    const size_t capacity = m_readAheadCapacity;
+
+    size_t count;
+    if ( m_readAhead->IsPending() )
+    {
+        // take the block read in advance, recycling our current buffer for
+        // the next one
+        count = m_readAhead->Finish(&m_buffer_start, capacity);
+    }
+    else // first fill or just after a seek
+    {
+        count = ReadFromStream(m_buffer_start, capacity);
+    }
+
+    m_buffer_end = m_buffer_start + count;
+    m_buffer_pos = m_buffer_start;
+
+    if ( !count )
+        return false;
+
+    // start fetching the next block already
+    m_readAhead->Start(capacity);
+
+    return true;
+}
+
+#endif // wxUSE_THREADS
+
 // write the buffer contents to the stream (only for write buffers)
 bool wxStreamBuffer::FlushBuffer()
 {
@@ -612,6 +928,7 @@ wxFileOffset wxStreamBuffer::Seek(wxFileOffset pos, wxSeekMode mode)
     {
         case wxFromStart:
             // We'll try to compute an internal position later ...
+            CancelReadAhead();
             ret_off = m_stream->OnSysSeek(pos, wxFromStart);
             ResetBuffer();
             return ret_off;
@@ -623,6 +940,7 @@ wxFileOffset wxStreamBuffer::Seek(wxFileOffset pos, wxSeekMode mode)
             {
                 // We must take into account the fact that we have read
                 // something previously.
+                CancelReadAhead();
                 ret_off = m_stream->OnSysSeek(diff-last_access, wxFromCurrent);
                 ResetBuffer();
                 return ret_off;
@@ -637,6 +955,7 @@ wxFileOffset wxStreamBuffer::Seek(wxFileOffset pos, wxSeekMode mode)
 
         case wxFromEnd:
             // Hard to compute: always seek to the requested position.
+            CancelReadAhead();
             ret_off = m_stream->OnSysSeek(pos, wxFromEnd);
             ResetBuffer();
             return ret_off;
@@ -649,6 +968,15 @@ wxFileOffset wxStreamBuffer::Tell() const
 {
     wxFileOffset pos;
 
+#if wxUSE_THREADS
+    // the stream position is ahead by whatever was already read by the read
+    // ahead thread: wait for any read in progress to finish first, both to
+    // know its size and because querying the stream position while the
+    // worker is using the stream wouldn't be safe
+    const wxFileOffset pendingReadAhead =
+        m_readAhead ? m_readAhead->GetPendingCount() : 0;
+#endif // wxUSE_THREADS
+
     // ask the stream for position if we have a real one
     if ( m_stream )
     {
@@ -666,6 +994,10 @@ wxFileOffset wxStreamBuffer::Tell() const
     if ( m_mode == read && m_flushable )
         pos -= GetLastAccess();
 
+#if wxUSE_THREADS
+    pos -= pendingReadAhead;
+#endif // wxUSE_THREADS
+
     return pos;
 }
 
@@ -888,6 +1220,19 @@ char wxInputStream::Peek()
 }
 
 wxInputStream& wxInputStream::Read(wxOutputStream& stream_out)
+{
+    return DoCopyTo(stream_out, NULL);
+}
+
+wxInputStream&
+wxInputStream::Read(wxOutputStream& stream_out, wxOperationContext& context)
+{
+    return DoCopyTo(stream_out, &context);
+}
+
+wxInputStream&
+wxInputStream::DoCopyTo(wxOutputStream& stream_out,
+                        wxOperationContext* context)
 {
     size_t lastcount = 0;
     char buf[BUF_TEMP_SIZE];
@@ -902,6 +1247,11 @@ wxInputStream& wxInputStream::Read(wxOutputStream& stream_out)
             break;
 
         lastcount += bytes_read;
+
+        // stop copying, without draining the rest of the stream, if we were
+        // asked to cancel
+        if ( context && !context->AddProgress(bytes_read) )
+            break;
     }
 
     m_lastcount = lastcount;
@@ -1330,6 +1680,11 @@ wxBufferedInputStream::wxBufferedInputStream(wxInputStream& stream,
                      : wxFilterInputStream(stream)
 {
     m_i_streambuf = CreateBufferIfNeeded(*this, buffer);
+
+    // let our default buffer grow when the stream is read sequentially, but
+    // don't touch a caller-provided buffer
+    if ( !buffer )
+        m_i_streambuf->Adaptive(true);
 }
 
 wxBufferedInputStream::wxBufferedInputStream(wxInputStream& stream,
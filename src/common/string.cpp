@@ -30,8 +30,12 @@
 
 #include <string.h>
 #include <stdlib.h>
+#include <limits.h>
 
 #include "wx/hashmap.h"
+#include "wx/hashset.h"
+#include "wx/module.h"
+#include "wx/thread.h"
 #include "wx/vector.h"
 #include "wx/xlocale.h"
 
@@ -552,8 +556,23 @@ const char *wxString::AsChar(const wxMBConv& conv) const
 // shrink to minimal size (releasing extra memory)
 bool wxString::Shrink()
 {
-  wxString tmp(begin(), end());
-  swap(tmp);
+  // free the cached conversion buffers: they can hold another full copy of
+  // the string contents and are recreated on demand anyhow (note that swap()
+  // below doesn't touch them, so this must be done explicitly)
+#if wxUSE_UNICODE
+  m_convertedToChar.Free();
+#endif
+#if !wxUSE_UNICODE_WCHAR
+  m_convertedToWChar.Free();
+#endif
+
+  // only reallocate the buffer if there really is some slack to release
+  if ( m_impl.capacity() > m_impl.length() )
+  {
+      wxString tmp(begin(), end());
+      swap(tmp);
+  }
+
   return true;
 }
 
@@ -713,6 +732,11 @@ bool wxString::IsSameAs(wxUniChar c, bool compareWithCase) const
 
 int wxString::compare(const wxString& str) const
 {
+    // Strings sharing their buffer (e.g. interned ones, see
+    // wxStringInterner) are equal without comparing the data.
+    if ( m_impl.c_str() == str.m_impl.c_str() )
+        return 0;
+
     return m_impl.compare(str.m_impl);
 }
 
@@ -790,6 +814,11 @@ static inline int wxDoCmp(const wxStringCharType* s1, size_t l1,
 
 int wxString::compare(const wxString& str) const
 {
+    // Strings sharing their buffer (e.g. interned ones, see
+    // wxStringInterner) are equal without comparing the data.
+    if ( m_impl.c_str() == str.m_impl.c_str() )
+        return 0;
+
     return ::wxDoCmp(m_impl.data(), m_impl.length(),
                      str.m_impl.data(), str.m_impl.length());
 }
@@ -1069,8 +1098,104 @@ size_t wxString::find_last_not_of(const wxOtherCharType* sz, size_t nStart,
 // other common string functions
 // ===========================================================================
 
+// ----------------------------------------------------------------------------
+// ASCII fast paths for the case-insensitive functions
+// ----------------------------------------------------------------------------
+
+// The functions below work on raw code units a block at a time and are only
+// correct for ASCII: the callers must fall back to the full Unicode-aware
+// (and much slower) code as soon as anything non-ASCII is detected.
+
+// Process this many code units per iteration: the simple reductions over a
+// fixed-size block used here are recognized and vectorized by the compilers,
+// unlike the equivalent per-character conditional code.
+static const size_t wxASCII_BLOCK_LEN = 16;
+
+static inline int wxAsciiToLower(wxStringCharType c)
+{
+    return c >= 'A' && c <= 'Z' ? c + ('a' - 'A') : c;
+}
+
+// return true if all len code units of p are ASCII
+static bool wxIsAsciiData(const wxStringCharType *p, size_t len)
+{
+    for ( size_t i = 0; i < len; i += wxASCII_BLOCK_LEN )
+    {
+        size_t blockEnd = i + wxASCII_BLOCK_LEN;
+        if ( blockEnd > len )
+            blockEnd = len;
+
+        unsigned mask = 0;
+        for ( size_t j = i; j < blockEnd; j++ )
+            mask |= static_cast<unsigned>(p[j]);
+
+        if ( mask & ~0x7fu )
+            return false;
+    }
+
+    return true;
+}
+
+// case-insensitively compare the two ASCII-only strings: returns true if the
+// comparison could be done, with the result in rc, or false if a non-ASCII
+// code unit was found, in which case the caller must redo everything using
+// the Unicode-aware code path
+static bool
+wxDoCmpNoCaseAscii(const wxStringCharType *p1, size_t len1,
+                   const wxStringCharType *p2, size_t len2,
+                   int *rc)
+{
+    const size_t len = len1 < len2 ? len1 : len2;
+
+    for ( size_t i = 0; i < len; i += wxASCII_BLOCK_LEN )
+    {
+        size_t blockEnd = i + wxASCII_BLOCK_LEN;
+        if ( blockEnd > len )
+            blockEnd = len;
+
+        // Check that the entire block is ASCII on both sides first.
+        unsigned mask = 0;
+        for ( size_t j = i; j < blockEnd; j++ )
+        {
+            mask |= static_cast<unsigned>(p1[j]) |
+                    static_cast<unsigned>(p2[j]);
+        }
+
+        if ( mask & ~0x7fu )
+            return false;
+
+        for ( size_t j = i; j < blockEnd; j++ )
+        {
+            const int c1 = wxAsciiToLower(p1[j]);
+            const int c2 = wxAsciiToLower(p2[j]);
+            if ( c1 != c2 )
+            {
+                *rc = c1 < c2 ? -1 : 1;
+                return true;
+            }
+        }
+    }
+
+    *rc = len1 == len2 ? 0 : len1 < len2 ? -1 : 1;
+    return true;
+}
+
 int wxString::CmpNoCase(const wxString& s) const
 {
+    // Strings sharing their buffer are trivially equal.
+    if ( m_impl.c_str() == s.m_impl.c_str() )
+        return 0;
+
+    // Try the fast ASCII-only path first: notice that working on the code
+    // units and not the characters is fine here because any non-ASCII
+    // character, in any encoding, contains at least one non-ASCII code unit,
+    // which makes us take the generic path below.
+    int rcAscii;
+    if ( wxDoCmpNoCaseAscii(m_impl.c_str(), m_impl.length(),
+                            s.m_impl.c_str(), s.m_impl.length(),
+                            &rcAscii) )
+        return rcAscii;
+
 #if !wxUSE_UNICODE_UTF8
     // We compare NUL-delimited chunks of the strings inside the loop. We will
     // do as many iterations as there are embedded NULs in the string, i.e.
@@ -1654,10 +1779,228 @@ int wxString::Find(wxUniChar ch, bool bFromEnd) const
     return (idx == npos) ? wxNOT_FOUND : (int)idx;
 }
 
+// find a substring case-insensitively
+int wxString::FindNoCase(const wxString& sub) const
+{
+    // ASCII fast path: if both strings are pure ASCII we can search the raw
+    // code units with trivial case folding, and then the code unit index of
+    // the match is also its character index, in all builds.
+    const wxStringCharType * const hay = m_impl.c_str();
+    const size_t hayLen = m_impl.length();
+    const wxStringCharType * const ndl = sub.m_impl.c_str();
+    const size_t ndlLen = sub.m_impl.length();
+
+    if ( wxIsAsciiData(hay, hayLen) && wxIsAsciiData(ndl, ndlLen) )
+    {
+        if ( ndlLen > hayLen )
+            return wxNOT_FOUND;
+
+        const int first = ndlLen ? wxAsciiToLower(ndl[0]) : 0;
+        const size_t last = hayLen - ndlLen;
+        for ( size_t i = 0; i <= last; i++ )
+        {
+            if ( ndlLen && wxAsciiToLower(hay[i]) != first )
+                continue;
+
+            size_t j = 1;
+            while ( j < ndlLen &&
+                        wxAsciiToLower(hay[i + j]) == wxAsciiToLower(ndl[j]) )
+                j++;
+
+            if ( j >= ndlLen )
+                return (int)i;
+        }
+
+        return wxNOT_FOUND;
+    }
+
+    // Unicode path: fold one character at a time, as CmpNoCase() does.
+    const size_t len = length();
+    const size_t subLen = sub.length();
+    if ( subLen > len )
+        return wxNOT_FOUND;
+
+    const_iterator start = begin();
+    for ( size_t i = 0; i <= len - subLen; ++i, ++start )
+    {
+        const_iterator p = start;
+        const_iterator q = sub.begin();
+
+        size_t j = 0;
+        for ( ; j < subLen; ++j, ++p, ++q )
+        {
+            if ( (wxChar)wxTolower(*p) != (wxChar)wxTolower(*q) )
+                break;
+        }
+
+        if ( j == subLen )
+            return (int)i;
+    }
+
+    return wxNOT_FOUND;
+}
+
 // ----------------------------------------------------------------------------
 // conversion to numbers
 // ----------------------------------------------------------------------------
 
+namespace
+{
+
+// Fast paths for parsing numbers in the common decimal formats: the standard
+// strtol()/strtod() functions pay for locale handling and many rarely used
+// formats on every call, which really adds up when parsing millions of
+// numbers. The helpers below handle the usual cases directly on the string
+// buffer and return false for everything else (leading whitespace, bases
+// other than 10, hex floats, huge values, "inf"/"nan", ...), letting the
+// caller fall back to the standard functions, so behaviour doesn't change.
+
+// Parse an optionally signed sequence of decimal digits. Returns false if
+// the input doesn't start with one or the magnitude overflows; on success
+// *end points to the first unparsed character.
+bool wxTryParseDecInteger(const wxStringCharType *p,
+                          bool *negative,
+                          wxULongLong_t *magnitude,
+                          const wxStringCharType **end)
+{
+    *negative = false;
+    if ( *p == wxS('-') )
+    {
+        *negative = true;
+        ++p;
+    }
+    else if ( *p == wxS('+') )
+    {
+        ++p;
+    }
+
+    if ( *p < wxS('0') || *p > wxS('9') )
+        return false;
+
+    wxULongLong_t acc = 0;
+    for ( ; *p >= wxS('0') && *p <= wxS('9'); ++p )
+    {
+        const unsigned digit = (unsigned)(*p - wxS('0'));
+        if ( acc > (wxUINT64_MAX - digit)/10 )
+            return false;
+
+        acc = acc*10 + digit;
+    }
+
+    *magnitude = acc;
+    *end = p;
+
+    return true;
+}
+
+// The powers of 10 exactly representable as doubles.
+const double gs_pow10[] =
+{
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10,
+    1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// Parse a decimal floating point number. Returns false if the input is not
+// in a form which is guaranteed to produce the same correctly rounded value
+// as strtod(): both the mantissa and the power of 10 must be exactly
+// representable as doubles, so that the single multiplication (or division)
+// below is exact up to the final IEEE rounding.
+bool wxTryParseDecDouble(const wxStringCharType *p,
+                         double *val,
+                         const wxStringCharType **end)
+{
+    bool negative = false;
+    if ( *p == wxS('-') )
+    {
+        negative = true;
+        ++p;
+    }
+    else if ( *p == wxS('+') )
+    {
+        ++p;
+    }
+
+    wxULongLong_t mantissa = 0;
+    int digits = 0;
+    int exp10 = 0;
+
+    for ( ; *p >= wxS('0') && *p <= wxS('9'); ++p )
+    {
+        if ( ++digits > 19 )
+            return false;
+
+        mantissa = mantissa*10 + (unsigned)(*p - wxS('0'));
+    }
+
+    // don't misparse the "0x..." hex floats as 0 followed by junk
+    if ( *p == wxS('x') || *p == wxS('X') )
+        return false;
+
+    if ( *p == wxS('.') )
+    {
+        for ( ++p; *p >= wxS('0') && *p <= wxS('9'); ++p )
+        {
+            if ( ++digits > 19 )
+                return false;
+
+            mantissa = mantissa*10 + (unsigned)(*p - wxS('0'));
+            exp10--;
+        }
+    }
+
+    if ( !digits )
+        return false;   // no digits at all: could be "inf", "nan", ...
+
+    if ( *p == wxS('e') || *p == wxS('E') )
+    {
+        const wxStringCharType *q = p + 1;
+        bool expNegative = false;
+        if ( *q == wxS('-') )
+        {
+            expNegative = true;
+            ++q;
+        }
+        else if ( *q == wxS('+') )
+        {
+            ++q;
+        }
+
+        if ( *q >= wxS('0') && *q <= wxS('9') )
+        {
+            int e = 0;
+            for ( ; *q >= wxS('0') && *q <= wxS('9'); ++q )
+            {
+                if ( e < 10000 )
+                    e = e*10 + (*q - wxS('0'));
+            }
+
+            exp10 += expNegative ? -e : e;
+            p = q;
+        }
+        //else: no exponent digits, strtod() wouldn't consume the "e" either
+    }
+
+    // the mantissa must fit into the 53 bits of the double significand
+    if ( mantissa >= (wxULL(1) << 53) )
+        return false;
+
+    if ( exp10 < -22 || exp10 > 22 )
+        return false;
+
+    double d = (double)(wxLongLong_t)mantissa;
+    if ( exp10 < 0 )
+        d /= gs_pow10[-exp10];
+    else
+        d *= gs_pow10[exp10];
+
+    *val = negative ? -d : d;
+    *end = p;
+
+    return true;
+}
+
+} // anonymous namespace
+
 // The implementation of all the functions below is exactly the same so factor
 // it out. Note that number extraction works correctly on UTF-8 strings, so
 // we can use wxStringCharType and wx_str() for maximum efficiency.
@@ -1677,10 +2020,53 @@ int wxString::Find(wxUniChar ch, bool bFromEnd) const
     *pVal = val;                                                            \
     return !*end;
 
+// These macros try the decimal fast path first and fall through to the code
+// using the standard functions below them if it doesn't apply. Overflowing
+// values return false without modifying the output, just as with ERANGE.
+#define WX_STRING_TO_SIGNED_FAST(T, Tmax, Tmin)                             \
+    if ( base == 10 )                                                       \
+    {                                                                       \
+        wxCHECK_MSG( pVal, false, wxT("NULL output pointer") );             \
+        bool negative;                                                      \
+        wxULongLong_t magnitude;                                            \
+        const wxStringCharType *endFast;                                    \
+        if ( wxTryParseDecInteger(wx_str(), &negative,                      \
+                                  &magnitude, &endFast) )                   \
+        {                                                                   \
+            if ( magnitude > (wxULongLong_t)(Tmax) + (negative ? 1u : 0u) ) \
+                return false;                                               \
+            if ( negative )                                                 \
+                *pVal = magnitude > (wxULongLong_t)(Tmax) ? (Tmin)          \
+                                                          : -(T)magnitude; \
+            else                                                            \
+                *pVal = (T)magnitude;                                       \
+            return !*endFast;                                               \
+        }                                                                   \
+    }
+
+#define WX_STRING_TO_UNSIGNED_FAST(T, Tmax)                                 \
+    if ( base == 10 )                                                       \
+    {                                                                       \
+        wxCHECK_MSG( pVal, false, wxT("NULL output pointer") );             \
+        bool negative;                                                      \
+        wxULongLong_t magnitude;                                            \
+        const wxStringCharType *endFast;                                    \
+        if ( wxTryParseDecInteger(wx_str(), &negative,                      \
+                                  &magnitude, &endFast) )                   \
+        {                                                                   \
+            if ( magnitude > (wxULongLong_t)(Tmax) )                        \
+                return false;                                               \
+            *pVal = negative ? (T)0 - (T)magnitude : (T)magnitude;          \
+            return !*endFast;                                               \
+        }                                                                   \
+    }
+
 bool wxString::ToLong(long *pVal, int base) const
 {
     wxASSERT_MSG( !base || (base > 1 && base <= 36), wxT("invalid base") );
 
+    WX_STRING_TO_SIGNED_FAST(long, LONG_MAX, LONG_MIN)
+
     WX_STRING_TO_X_TYPE_START
     long val = wxStrtol(start, &end, base);
     WX_STRING_TO_X_TYPE_END
@@ -1690,6 +2076,8 @@ bool wxString::ToULong(unsigned long *pVal, int base) const
 {
     wxASSERT_MSG( !base || (base > 1 && base <= 36), wxT("invalid base") );
 
+    WX_STRING_TO_UNSIGNED_FAST(unsigned long, ULONG_MAX)
+
     WX_STRING_TO_X_TYPE_START
     unsigned long val = wxStrtoul(start, &end, base);
     WX_STRING_TO_X_TYPE_END
@@ -1699,6 +2087,8 @@ bool wxString::ToLongLong(wxLongLong_t *pVal, int base) const
 {
     wxASSERT_MSG( !base || (base > 1 && base <= 36), wxT("invalid base") );
 
+    WX_STRING_TO_SIGNED_FAST(wxLongLong_t, wxINT64_MAX, wxINT64_MIN)
+
     WX_STRING_TO_X_TYPE_START
     wxLongLong_t val = wxStrtoll(start, &end, base);
     WX_STRING_TO_X_TYPE_END
@@ -1708,6 +2098,8 @@ bool wxString::ToULongLong(wxULongLong_t *pVal, int base) const
 {
     wxASSERT_MSG( !base || (base > 1 && base <= 36), wxT("invalid base") );
 
+    WX_STRING_TO_UNSIGNED_FAST(wxULongLong_t, wxUINT64_MAX)
+
     WX_STRING_TO_X_TYPE_START
     wxULongLong_t val = wxStrtoull(start, &end, base);
     WX_STRING_TO_X_TYPE_END
@@ -1726,6 +2118,8 @@ bool wxString::ToCLong(long *pVal, int base) const
 {
     wxASSERT_MSG( !base || (base > 1 && base <= 36), wxT("invalid base") );
 
+    WX_STRING_TO_SIGNED_FAST(long, LONG_MAX, LONG_MIN)
+
     WX_STRING_TO_X_TYPE_START
 #if (wxUSE_UNICODE_UTF8 || !wxUSE_UNICODE) && defined(wxHAS_XLOCALE_SUPPORT)
     long val = wxStrtol_lA(start, &end, base, wxCLocale);
@@ -1739,6 +2133,8 @@ bool wxString::ToCULong(unsigned long *pVal, int base) const
 {
     wxASSERT_MSG( !base || (base > 1 && base <= 36), wxT("invalid base") );
 
+    WX_STRING_TO_UNSIGNED_FAST(unsigned long, ULONG_MAX)
+
     WX_STRING_TO_X_TYPE_START
 #if (wxUSE_UNICODE_UTF8 || !wxUSE_UNICODE) && defined(wxHAS_XLOCALE_SUPPORT)
     unsigned long val = wxStrtoul_lA(start, &end, base, wxCLocale);
@@ -1750,6 +2146,18 @@ bool wxString::ToCULong(unsigned long *pVal, int base) const
 
 bool wxString::ToCDouble(double *pVal) const
 {
+    wxCHECK_MSG( pVal, false, wxT("NULL output pointer") );
+
+    // Try the exact decimal fast path first, it covers the vast majority of
+    // the values found in the wild much faster than strtod().
+    double valFast;
+    const wxStringCharType *endFast;
+    if ( wxTryParseDecDouble(wx_str(), &valFast, &endFast) )
+    {
+        *pVal = valFast;
+        return !*endFast;
+    }
+
     WX_STRING_TO_X_TYPE_START
 #if (wxUSE_UNICODE_UTF8 || !wxUSE_UNICODE) && defined(wxHAS_XLOCALE_SUPPORT)
     double val = wxStrtod_lA(start, &end, wxCLocale);
@@ -1780,6 +2188,18 @@ bool wxString::ToCULong(unsigned long *pVal, int base) const
 // point which is different in different locales.
 bool wxString::ToCDouble(double *pVal) const
 {
+    wxCHECK_MSG( pVal, false, wxT("NULL output pointer") );
+
+    // The locale-independent fast path can be used whatever the current
+    // locale decimal separator is.
+    double valFast;
+    const wxStringCharType *endFast;
+    if ( wxTryParseDecDouble(wx_str(), &valFast, &endFast) )
+    {
+        *pVal = valFast;
+        return !*endFast;
+    }
+
     // See the explanations in FromCDouble() below for the reasons for all this.
 
     // Create a copy of this string using the decimal point instead of whatever
@@ -2004,7 +2424,63 @@ template<typename BufferType>
 static int DoStringPrintfV(wxString& str,
                            const wxString& format, va_list argptr)
 {
-    size_t size = 1024;
+#if wxUSE_UNICODE_UTF8
+    typedef typename BufferType::CharType CharType;
+#else
+    typedef wxChar CharType;
+#endif
+
+    // Most formatted strings are short, so format into a buffer on the stack
+    // first: if the result fits, the only heap allocation made here is that
+    // of the string itself, which is also sized exactly instead of being
+    // overallocated and shrunk afterwards.
+    CharType stackBuf[1024];
+
+    va_list argptrcopy;
+    wxVaCopy(argptrcopy, argptr);
+
+    // Set errno to 0 to make it determinate if wxVsnprintf fails to set it.
+    errno = 0;
+    int len = wxVsnprintf(stackBuf, WXSIZEOF(stackBuf) - 1, format, argptrcopy);
+    va_end(argptrcopy);
+
+    if ( len >= 0 && static_cast<size_t>(len) < WXSIZEOF(stackBuf) - 1 )
+    {
+        // see the comment about NUL termination in the loop below
+        stackBuf[len] = wxT('\0');
+
+        {
+#if wxUSE_UNICODE_UTF8
+            BufferType tmp(str, len + 1);
+            typename BufferType::CharType *buf = tmp;
+#else
+            wxStringBuffer tmp(str, len + 1);
+            wxChar *buf = tmp;
+#endif
+
+            if ( !buf )
+            {
+                // out of memory
+                return -1;
+            }
+
+            memcpy(buf, stackBuf, (len + 1)*sizeof(CharType));
+        }
+
+        return str.length();
+    }
+
+    if ( len < 0 && ((errno == EILSEQ) || (errno == EINVAL)) )
+    {
+        // This is a hard error, retrying with a bigger buffer can't help.
+        return -1;
+    }
+
+    // The result doesn't fit into the stack buffer, so fall back to a heap
+    // buffer of either exactly the needed size, if it is known, or twice the
+    // size which was just found to be insufficient.
+    size_t size = len >= 0 ? static_cast<size_t>(len) + 1
+                           : 2*WXSIZEOF(stackBuf);
 
     for ( ;; )
     {
@@ -2277,3 +2753,97 @@ int wxString::Freq(wxUniChar ch) const
     return count;
 }
 
+// ----------------------------------------------------------------------------
+// wxStringInterner
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+WX_DECLARE_HASH_SET(wxString, wxStringHash, wxStringEqual, wxStringInternSet);
+
+} // anonymous namespace
+
+// All the data of wxStringInterner lives here to avoid having to include the
+// hash set and thread headers from wx/string.h.
+class wxStringInternerData
+{
+public:
+    wxStringInternSet m_strings;
+
+    wxCRIT_SECT_DECLARE_MEMBER(m_cs);
+};
+
+wxStringInterner::wxStringInterner()
+{
+    m_data = new wxStringInternerData;
+}
+
+wxStringInterner::~wxStringInterner()
+{
+    delete m_data;
+}
+
+const wxString& wxStringInterner::Intern(const wxString& s)
+{
+    wxCRIT_SECT_LOCKER(lock, m_data->m_cs);
+
+    // The hash set is node-based, so the canonical instance is never moved
+    // and the returned reference stays valid even if the set is rehashed.
+    return *m_data->m_strings.insert(s).first;
+}
+
+size_t wxStringInterner::GetCount() const
+{
+    wxCRIT_SECT_LOCKER(lock, m_data->m_cs);
+
+    return m_data->m_strings.size();
+}
+
+void wxStringInterner::Clear()
+{
+    wxCRIT_SECT_LOCKER(lock, m_data->m_cs);
+
+    m_data->m_strings.clear();
+}
+
+namespace
+{
+
+wxStringInterner *gs_defaultInterner = NULL;
+
+wxCRIT_SECT_DECLARE(gs_defaultInternerCS);
+
+} // anonymous namespace
+
+/* static */
+wxStringInterner& wxStringInterner::GetDefault()
+{
+    wxCRIT_SECT_LOCKER(lock, gs_defaultInternerCS);
+
+    if ( !gs_defaultInterner )
+        gs_defaultInterner = new wxStringInterner;
+
+    return *gs_defaultInterner;
+}
+
+// module deleting the default interner on shutdown
+class wxStringInternerModule : public wxModule
+{
+public:
+    wxStringInternerModule() { }
+
+    virtual bool OnInit() wxOVERRIDE { return true; }
+
+    virtual void OnExit() wxOVERRIDE
+    {
+        wxCRIT_SECT_LOCKER(lock, gs_defaultInternerCS);
+
+        wxDELETE(gs_defaultInterner);
+    }
+
+    wxDECLARE_DYNAMIC_CLASS(wxStringInternerModule);
+};
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxStringInternerModule, wxModule)
+
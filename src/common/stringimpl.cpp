@@ -29,6 +29,9 @@
     #include "wx/wxcrt.h"
 #endif
 
+#include "wx/alloctrack.h"
+#include "wx/tls.h"
+
 #include <ctype.h>
 
 #include <errno.h>
@@ -134,17 +137,85 @@ const wxStringCharType WXDLLIMPEXP_BASE *wxEmptyString = &g_strEmpty.dummy;
   #define STATISTICS_ADD(av, val)
 #endif // WXSTRING_STATISTICS
 
+// ----------------------------------------------------------------------------
+// allocation tracking
+// ----------------------------------------------------------------------------
+
+// total size in bytes of a block whose capacity is nAllocLength characters,
+// used for reporting the buffer sizes to wxAllocationTracker
+static inline size_t wxStringBlockSize(size_t nAllocLength)
+{
+    return sizeof(wxStringData) + (nAllocLength + 1)*sizeof(wxStringCharType);
+}
+
+// ----------------------------------------------------------------------------
+// small string block cache
+// ----------------------------------------------------------------------------
+
+// Short strings vastly outnumber long ones in a typical GUI program, so keep
+// a per-thread cache of recently freed blocks just big enough for
+// wxSTRING_SMALL_CAPACITY characters and satisfy small allocations from it
+// instead of going to the heap every time. The invariant relied upon here is
+// that every block with nAllocLength == N occupies exactly
+// sizeof(wxStringData) + (N + 1)*sizeof(wxStringCharType) bytes, so any block
+// whose capacity is exactly wxSTRING_SMALL_CAPACITY may be recycled.
+//
+// Blocks still in the cache when a thread exits are not returned to the heap,
+// but the cache is small (a couple of KiB per thread at most), so this
+// doesn't matter in practice.
+
+// capacity, excluding the terminating NUL, of the cached blocks
+static const size_t wxSTRING_SMALL_CAPACITY = 16;
+
+// maximal number of blocks cached per thread
+static const size_t wxSTRING_SMALL_CACHE_SIZE = 64;
+
+namespace
+{
+
+struct wxStringSmallBlockCache
+{
+    wxStringData *blocks[wxSTRING_SMALL_CACHE_SIZE];
+    size_t count;
+};
+
+} // anonymous namespace
+
+// we must use an accessor function and not a simple static variable because
+// it can be used from other static objects ctors/dtors (same problem as with
+// wxString::Cache in string.cpp)
+static wxTLS_TYPE_REF(wxStringSmallBlockCache) GetSmallBlockCacheVar()
+{
+    static wxTLS_TYPE(wxStringSmallBlockCache) s_cache;
+
+    return s_cache;
+}
+
+#define wxSMALL_BLOCK_CACHE wxTLS_VALUE(GetSmallBlockCacheVar())
+
 // ===========================================================================
 // wxStringData class deallocation
 // ===========================================================================
 
-#if defined(__VISUALC__) && defined(_MT) && !defined(_DLL)
-#  pragma message (__FILE__ ": building with Multithreaded non DLL runtime has a performance impact on wxString!")
 void wxStringData::Free()
 {
+    if ( nAllocLength == wxSTRING_SMALL_CAPACITY )
+    {
+        wxStringSmallBlockCache& cache = wxSMALL_BLOCK_CACHE;
+        if ( cache.count < wxSTRING_SMALL_CACHE_SIZE )
+        {
+            // the block stays allocated, so it remains accounted for by
+            // wxAllocationTracker until it is really freed
+            cache.blocks[cache.count++] = this;
+            return;
+        }
+    }
+
+    wxAllocationTracker::OnFree(wxALLOC_TAG_STRINGS,
+                                wxStringBlockSize(nAllocLength));
+
     free(this);
 }
-#endif
 
 // ===========================================================================
 // wxStringImpl
@@ -211,20 +282,43 @@ bool wxStringImpl::AllocBuffer(size_t nLen)
 
   STATISTICS_ADD(Length, nLen);
 
+  size_t nAllocLen = nLen + EXTRA_ALLOC;
+  if ( nLen <= wxSTRING_SMALL_CAPACITY ) {
+    // first try to reuse a cached block
+    wxStringSmallBlockCache& cache = wxSMALL_BLOCK_CACHE;
+    if ( cache.count ) {
+      wxStringData* const pData = cache.blocks[--cache.count];
+
+      pData->nRefs       = 1;
+      pData->nDataLength = nLen;
+      // nAllocLength of a cached block is still wxSTRING_SMALL_CAPACITY
+      m_pchData          = pData->data();
+      m_pchData[nLen]    = wxT('\0');
+      return true;
+    }
+
+    // no cached block: allocate one with exactly the small capacity so that
+    // it becomes eligible for caching once it is freed
+    nAllocLen = wxSTRING_SMALL_CAPACITY;
+  }
+
   // allocate memory:
   // 1) one extra character for '\0' termination
   // 2) sizeof(wxStringData) for housekeeping info
   wxStringData* pData = (wxStringData*)
-    malloc(sizeof(wxStringData) + (nLen + EXTRA_ALLOC + 1)*sizeof(wxStringCharType));
+    malloc(wxStringBlockSize(nAllocLen));
 
   if ( pData == NULL ) {
     // allocation failures are handled by the caller
     return false;
   }
 
+  wxAllocationTracker::OnAlloc(wxALLOC_TAG_STRINGS,
+                               wxStringBlockSize(nAllocLen));
+
   pData->nRefs        = 1;
   pData->nDataLength  = nLen;
-  pData->nAllocLength = nLen + EXTRA_ALLOC;
+  pData->nAllocLength = nAllocLen;
   m_pchData           = pData->data();  // data starts after wxStringData
   m_pchData[nLen]     = wxT('\0');
   return true;
@@ -273,9 +367,10 @@ bool wxStringImpl::AllocBeforeWrite(size_t nLen)
 
       nLen += EXTRA_ALLOC;
 
+      const size_t nOldSize = wxStringBlockSize(pData->nAllocLength);
+
       pData = (wxStringData*)
-          realloc(pData,
-                  sizeof(wxStringData) + (nLen + 1)*sizeof(wxStringCharType));
+          realloc(pData, wxStringBlockSize(nLen));
 
       if ( pData == NULL ) {
         // allocation failures are handled by the caller
@@ -283,6 +378,10 @@ bool wxStringImpl::AllocBeforeWrite(size_t nLen)
         return false;
       }
 
+      wxAllocationTracker::OnFree(wxALLOC_TAG_STRINGS, nOldSize);
+      wxAllocationTracker::OnAlloc(wxALLOC_TAG_STRINGS,
+                                   wxStringBlockSize(nLen));
+
       pData->nAllocLength = nLen;
       m_pchData = pData->data();
     }
@@ -339,13 +438,16 @@ bool wxStringImpl::Alloc(size_t nLen)
       nLen += EXTRA_ALLOC;
 
       pData = (wxStringData *)
-             malloc(sizeof(wxStringData) + (nLen + 1)*sizeof(wxStringCharType));
+             malloc(wxStringBlockSize(nLen));
 
       if ( pData == NULL ) {
         // allocation failure handled by caller
         return false;
       }
 
+      wxAllocationTracker::OnAlloc(wxALLOC_TAG_STRINGS,
+                                   wxStringBlockSize(nLen));
+
       pData->nRefs = 1;
       pData->nDataLength = 0;
       pData->nAllocLength = nLen;
@@ -366,8 +468,10 @@ bool wxStringImpl::Alloc(size_t nLen)
     else {
       nLen += EXTRA_ALLOC;
 
+      const size_t nOldSize = wxStringBlockSize(pData->nAllocLength);
+
       pData = (wxStringData *)
-        realloc(pData, sizeof(wxStringData) + (nLen + 1)*sizeof(wxStringCharType));
+        realloc(pData, wxStringBlockSize(nLen));
 
       if ( pData == NULL ) {
         // allocation failure handled by caller
@@ -375,6 +479,10 @@ bool wxStringImpl::Alloc(size_t nLen)
         return false;
       }
 
+      wxAllocationTracker::OnFree(wxALLOC_TAG_STRINGS, nOldSize);
+      wxAllocationTracker::OnAlloc(wxALLOC_TAG_STRINGS,
+                                   wxStringBlockSize(nLen));
+
       // it's not important if the pointer changed or not (the check for this
       // is not faster than assigning to m_pchData in all cases)
       pData->nAllocLength = nLen;
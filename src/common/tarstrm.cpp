@@ -22,6 +22,7 @@
 
 #include "wx/buffer.h"
 #include "wx/datetime.h"
+#include "wx/datstrm.h"
 #include "wx/scopedptr.h"
 #include "wx/filename.h"
 #include "wx/thread.h"
@@ -660,6 +661,7 @@ void wxTarInputStream::Init()
     m_hdr = new wxTarHeaderBlock;
     m_HeaderRecs = NULL;
     m_GlobalHeaderRecs = NULL;
+    m_index = NULL;
     m_lasterror = m_parent_i_stream->GetLastError();
 }
 
@@ -668,6 +670,7 @@ wxTarInputStream::~wxTarInputStream()
     delete m_hdr;
     delete m_HeaderRecs;
     delete m_GlobalHeaderRecs;
+    ClearIndex();
 }
 
 wxTarEntry *wxTarInputStream::GetNextEntry()
@@ -741,6 +744,139 @@ bool wxTarInputStream::OpenEntry(wxArchiveEntry& entry)
     return tarEntry ? OpenEntry(*tarEntry) : false;
 }
 
+// Scan the remaining headers into a name to entry map. The data of each
+// entry is skipped over using seeks, so for a large archive this reads
+// just a few blocks per entry.
+//
+bool wxTarInputStream::BuildIndex()
+{
+    wxCHECK_MSG(m_parent_i_stream->IsSeekable(), false,
+                wxT("tar index requires a seekable stream"));
+
+    ClearIndex();
+    m_index = new wxTarIndex;
+
+    wxTarEntryPtr entry(GetNextEntry());
+
+    while (entry.get()) {
+        wxTarEntry*& slot = (*m_index)[entry->GetInternalName()];
+        delete slot;
+        slot = entry.release();
+        entry.reset(GetNextEntry());
+    }
+
+    // the scan stops at the end of the archive
+    return GetLastError() == wxSTREAM_EOF;
+}
+
+void wxTarInputStream::ClearIndex()
+{
+    if (m_index) {
+        for (wxTarIndex::iterator it = m_index->begin();
+                it != m_index->end(); ++it)
+            delete it->second;
+        delete m_index;
+        m_index = NULL;
+    }
+}
+
+// Look up an entry in the index. The returned entry remains owned by the
+// stream.
+//
+wxTarEntry *wxTarInputStream::FindEntry(const wxString& name) const
+{
+    wxCHECK_MSG(m_index, NULL,
+                wxT("no index, call BuildIndex() or LoadIndex() first"));
+
+    wxTarIndex::const_iterator it =
+        m_index->find(wxTarEntry::GetInternalName(name));
+
+    return it != m_index->end() ? it->second : NULL;
+}
+
+bool wxTarInputStream::OpenEntry(const wxString& name)
+{
+    wxTarEntry *entry = FindEntry(name);
+    return entry ? OpenEntry(*entry) : false;
+}
+
+// The index is saved as a header followed by one record per entry, giving
+// the name, the offset of the entry's data and enough of the metadata for
+// OpenEntry() to work.
+
+enum {
+    TAR_INDEX_MAGIC   = 0x58494154,     // "TAIX"
+    TAR_INDEX_VERSION = 1
+};
+
+bool wxTarInputStream::SaveIndex(wxOutputStream& stream) const
+{
+    wxCHECK_MSG(m_index, false, wxT("no index to save"));
+
+    wxDataOutputStream ds(stream);
+
+    ds << wxUint32(TAR_INDEX_MAGIC) << wxUint32(TAR_INDEX_VERSION)
+       << wxUint32(m_index->size());
+
+    for (wxTarIndex::const_iterator it = m_index->begin();
+            it != m_index->end(); ++it) {
+        const wxTarEntry& entry = *it->second;
+        ds.WriteString(entry.GetInternalName());
+        ds.Write64(wxUint64(entry.GetOffset()));
+        ds.Write64(wxUint64(entry.GetSize()));
+        ds.Write8(wxUint8(entry.GetTypeFlag()));
+    }
+
+    return stream.IsOk();
+}
+
+bool wxTarInputStream::LoadIndex(wxInputStream& stream)
+{
+    wxDataInputStream ds(stream);
+
+    wxUint32 magic = ds.Read32();
+    wxUint32 version = ds.Read32();
+    wxUint32 count = ds.Read32();
+
+    if (!stream.IsOk() || magic != TAR_INDEX_MAGIC
+            || version != TAR_INDEX_VERSION) {
+        wxLogError(_("invalid tar index"));
+        return false;
+    }
+
+    wxTarIndex *index = new wxTarIndex;
+
+    for (wxUint32 i = 0; i < count; i++) {
+        wxString name = ds.ReadString();
+        wxUint64 offset = ds.Read64();
+        wxUint64 size = ds.Read64();
+        int type = ds.Read8();
+
+        if (!stream.IsOk()) {
+            for (wxTarIndex::iterator it = index->begin();
+                    it != index->end(); ++it)
+                delete it->second;
+            delete index;
+            wxLogError(_("invalid tar index"));
+            return false;
+        }
+
+        wxTarEntryPtr entry(new wxTarEntry);
+        entry->SetName(name, wxPATH_UNIX);
+        entry->SetSize(wxFileOffset(size));
+        entry->SetOffset(wxFileOffset(offset));
+        entry->SetTypeFlag(type);
+
+        wxTarEntry*& slot = (*index)[entry->GetInternalName()];
+        delete slot;
+        slot = entry.release();
+    }
+
+    ClearIndex();
+    m_index = index;
+    return true;
+}
+
 bool wxTarInputStream::CloseEntry()
 {
     if (m_lasterror == wxSTREAM_READ_ERROR)
@@ -128,14 +128,30 @@ wxString wxTextBuffer::ms_eof;
 
 wxTextBuffer::wxTextBuffer(const wxString& strBufferName)
             : m_strBufferName(strBufferName)
+{
+    Init();
+}
+
+void wxTextBuffer::Init()
 {
     m_nCurLine = 0;
     m_isOpened = false;
+
+    m_mapData = NULL;
+    m_mapLen = 0;
+    m_mapConv = NULL;
+    m_mapIndexBuilt = false;
+    for ( size_t n = 0; n < MappedCacheSize; n++ )
+        m_mapCacheLine[n] = (size_t)-1;
+    m_mapCacheNext = 0;
 }
 
 wxTextBuffer::~wxTextBuffer()
 {
-    // required here for Darwin
+    // the derived class must have called UnmapIfNeeded() from its own dtor,
+    // we can't do it from here as OnUnmap() can't be called any longer, but
+    // at least free the conversion object
+    delete m_mapConv;
 }
 
 // ----------------------------------------------------------------------------
@@ -193,6 +209,204 @@ bool wxTextBuffer::Open(const wxMBConv& conv)
     return m_isOpened;
 }
 
+bool wxTextBuffer::OpenMapped(const wxString& strBufferName, const wxMBConv& conv)
+{
+    m_strBufferName = strBufferName;
+
+    return OpenMapped(conv);
+}
+
+bool wxTextBuffer::OpenMapped(const wxMBConv& conv)
+{
+    // buffer name must be either given in ctor or in OpenMapped(wxString)
+    wxASSERT( !m_strBufferName.empty() );
+
+    if ( !OnOpen(m_strBufferName, ReadAccess) )
+        return false;
+
+    size_t len = 0;
+    const char *data = OnMap(&len);
+
+    if ( data )
+    {
+        // we index the lines by scanning the raw bytes for "\r" and "\n", so
+        // we can only deal with ASCII-compatible encodings: if the buffer
+        // starts with an UTF-16 or UTF-32 BOM, give up on mapping it
+        if ( (len >= 2 && data[0] == '\xff' && data[1] == '\xfe') ||
+             (len >= 2 && data[0] == '\xfe' && data[1] == '\xff') ||
+             (len >= 4 && data[0] == '\0' && data[1] == '\0' &&
+                          data[2] == '\xfe' && data[3] == '\xff') )
+        {
+            OnUnmap(data, len);
+            data = NULL;
+        }
+    }
+
+    if ( !data )
+    {
+        // mapping is not supported or can't be used, degrade to reading
+        // everything in memory as Open() does
+        m_isOpened = OnRead(conv);
+
+        OnClose();
+
+        return m_isOpened;
+    }
+
+    // the mapping stays valid after closing the buffer itself
+    OnClose();
+
+    m_mapData = data;
+    m_mapLen = len;
+    m_mapConv = conv.Clone();
+    m_mapIndexBuilt = false;
+    m_nCurLine = 0;
+
+    m_isOpened = true;
+
+    return true;
+}
+
+void wxTextBuffer::UnmapIfNeeded()
+{
+    if ( !m_mapData )
+        return;
+
+    OnUnmap(m_mapData, m_mapLen);
+    m_mapData = NULL;
+    m_mapLen = 0;
+
+    wxDELETE(m_mapConv);
+
+    m_mapLineStarts.clear();
+    m_mapLineTypes.clear();
+    m_mapIndexBuilt = false;
+
+    for ( size_t n = 0; n < MappedCacheSize; n++ )
+    {
+        m_mapCacheLine[n] = (size_t)-1;
+        m_mapCacheStr[n].clear();
+    }
+    m_mapCacheNext = 0;
+}
+
+void wxTextBuffer::BuildMappedIndex() const
+{
+    if ( m_mapIndexBuilt )
+        return;
+
+    m_mapIndexBuilt = true;
+
+    const char * const start = m_mapData;
+    const char * const end = start + m_mapLen;
+
+    const char *lineStart = start;
+
+    // skip the UTF-8 BOM, if any: the conversion is applied to each line
+    // separately and would choke on (or preserve) it otherwise
+    if ( m_mapLen >= 3 && memcmp(start, "\xef\xbb\xbf", 3) == 0 )
+        lineStart += 3;
+
+    while ( lineStart < end )
+    {
+        // find the next line terminator of either kind: using memchr() here
+        // is much faster than examining the bytes one by one
+        const char *cr = static_cast<const char *>(
+                            memchr(lineStart, '\r', end - lineStart));
+        const char *lf = static_cast<const char *>(
+                            memchr(lineStart, '\n',
+                                   cr ? cr - lineStart : end - lineStart));
+
+        m_mapLineStarts.push_back(lineStart - start);
+
+        if ( lf )       // "\n" before any "\r"
+        {
+            m_mapLineTypes.push_back(wxTextFileType_Unix);
+            lineStart = lf + 1;
+        }
+        else if ( cr )  // "\r\n" or a bare "\r"
+        {
+            if ( cr + 1 != end && cr[1] == '\n' )
+            {
+                m_mapLineTypes.push_back(wxTextFileType_Dos);
+                lineStart = cr + 2;
+            }
+            else
+            {
+                m_mapLineTypes.push_back(wxTextFileType_Mac);
+                lineStart = cr + 1;
+            }
+        }
+        else            // no terminator at all in the last line
+        {
+            m_mapLineTypes.push_back(wxTextFileType_None);
+            lineStart = end;
+        }
+    }
+}
+
+size_t wxTextBuffer::GetMappedLineCount() const
+{
+    BuildMappedIndex();
+
+    return m_mapLineStarts.size();
+}
+
+wxTextFileType wxTextBuffer::GetMappedLineType(size_t n) const
+{
+    BuildMappedIndex();
+
+    return m_mapLineTypes[n];
+}
+
+wxString& wxTextBuffer::GetMappedLine(size_t n) const
+{
+    BuildMappedIndex();
+
+    wxCHECK_MSG( n < m_mapLineStarts.size(), ms_eof,
+                 wxT("invalid line index in wxTextBuffer::GetLine") );
+
+    // did we convert this line recently?
+    for ( size_t slot = 0; slot < MappedCacheSize; slot++ )
+    {
+        if ( m_mapCacheLine[slot] == n )
+            return m_mapCacheStr[slot];
+    }
+
+    // compute the extent of the line: it ends where the next one starts,
+    // minus its own terminator
+    const size_t posStart = m_mapLineStarts[n];
+    size_t posEnd;
+    if ( n + 1 < m_mapLineStarts.size() )
+        posEnd = m_mapLineStarts[n + 1];
+    else
+        posEnd = m_mapLen;
+
+    switch ( m_mapLineTypes[n] )
+    {
+        case wxTextFileType_Dos:
+            posEnd -= 2;
+            break;
+
+        case wxTextFileType_Unix:
+        case wxTextFileType_Mac:
+            posEnd--;
+            break;
+
+        case wxTextFileType_None:
+        case wxTextFileType_Os2:
+            break;
+    }
+
+    // convert it now and remember it, replacing the oldest cached line
+    const size_t slot = m_mapCacheNext++ % MappedCacheSize;
+    m_mapCacheLine[slot] = n;
+    m_mapCacheStr[slot] = wxString(m_mapData + posStart, *m_mapConv,
+                                   posEnd - posStart);
+
+    return m_mapCacheStr[slot];
+}
+
 // analyse some lines of the buffer trying to guess it's type.
 // if it fails, it assumes the native type for our platform.
 wxTextFileType wxTextBuffer::GuessType() const
@@ -206,11 +420,11 @@ wxTextFileType wxTextBuffer::GuessType() const
 
     // we take MAX_LINES_SCAN in the beginning, middle and the end of buffer
     #define MAX_LINES_SCAN    (10)
-    size_t nCount = m_aLines.GetCount() / 3,
+    size_t nCount = GetLineCount() / 3,
         nScan =  nCount > 3*MAX_LINES_SCAN ? MAX_LINES_SCAN : nCount / 3;
 
     #define   AnalyseLine(n)              \
-        switch ( m_aTypes[n] ) {            \
+        switch ( GetLineType(n) ) {            \
             case wxTextFileType_Unix: nUnix++; break;   \
             case wxTextFileType_Dos:  nDos++;  break;   \
             case wxTextFileType_Mac:  nMac++;  break;   \
@@ -994,6 +994,86 @@ bool wxTextAreaBase::SaveFile(const wxString& filename, int fileType)
     return DoSaveFile(filenameToUse, fileType);
 }
 
+// ----------------------------------------------------------------------------
+// coalesced appends
+// ----------------------------------------------------------------------------
+
+void wxTextCtrlBase::EnableAppendCoalescing(bool enable, unsigned long maxLines)
+{
+    m_appendMaxLines = maxLines;
+
+    if ( !enable && m_coalesceAppend )
+    {
+        m_coalesceAppend = false;
+
+        // don't lose the text buffered so far
+        FlushAppendedText();
+    }
+    else
+    {
+        m_coalesceAppend = enable;
+    }
+}
+
+bool wxTextCtrlBase::DoCoalesceAppend(const wxString& text)
+{
+    if ( !m_coalesceAppend )
+        return false;
+
+    m_appendPending += text;
+    m_appendPendingLines += text.Freq(wxT('\n'));
+
+    if ( m_appendMaxLines && m_appendPendingLines > m_appendMaxLines )
+    {
+        // the oldest lines would be removed during the flush anyhow, so
+        // don't even insert them into the control but drop them from the
+        // buffer directly
+        unsigned long numDrop = m_appendPendingLines - m_appendMaxLines;
+        size_t pos = 0;
+        while ( numDrop-- )
+            pos = m_appendPending.find(wxT('\n'), pos) + 1;
+
+        m_appendPending.erase(0, pos);
+        m_appendPendingLines = m_appendMaxLines;
+    }
+
+    if ( !m_appendFlushScheduled )
+    {
+        m_appendFlushScheduled = true;
+
+        CallAfter(&wxTextCtrlBase::FlushAppendedText);
+    }
+
+    return true;
+}
+
+void wxTextCtrlBase::FlushAppendedText()
+{
+    m_appendFlushScheduled = false;
+
+    if ( !m_appendPending.empty() )
+    {
+        wxString text;
+        text.swap(m_appendPending);
+        m_appendPendingLines = 0;
+
+        // temporarily disable the buffering to really insert the text this
+        // time, using the virtual function to let the port-specific code,
+        // e.g. scrolling to the end of the control, run as usual
+        const bool coalesce = m_coalesceAppend;
+        m_coalesceAppend = false;
+        AppendText(text);
+        m_coalesceAppend = coalesce;
+    }
+
+    if ( m_appendMaxLines )
+    {
+        const long excess = GetNumberOfLines() - (long)m_appendMaxLines;
+        if ( excess > 0 )
+            Remove(0, XYToPosition(0, excess));
+    }
+}
+
 // ----------------------------------------------------------------------------
 // stream-like insertion operator
 // ----------------------------------------------------------------------------
@@ -33,6 +33,13 @@
 #include "wx/filename.h"
 #include "wx/buffer.h"
 
+#if defined(__UNIX__)
+    #include <sys/mman.h>
+#elif defined(__WINDOWS__)
+    #include "wx/msw/private.h"
+    #include <io.h>
+#endif
+
 // ============================================================================
 // wxTextFile class implementation
 // ============================================================================
@@ -145,6 +152,61 @@ bool wxTextFile::OnRead(const wxMBConv& conv)
 }
 
 
+const char *wxTextFile::OnMap(size_t *len)
+{
+    // file should be opened
+    wxASSERT_MSG( m_file.IsOpened(), wxT("can't map closed file") );
+
+    const wxFileOffset length = m_file.Length();
+    if ( length <= 0 || (wxFileOffset)(size_t)length != length )
+        return NULL;
+
+#if defined(__UNIX__)
+    void * const p = mmap(NULL, (size_t)length, PROT_READ, MAP_SHARED,
+                          m_file.fd(), 0);
+    if ( p == MAP_FAILED )
+        return NULL;
+#elif defined(__WINDOWS__)
+    const HANDLE hFile = (HANDLE)_get_osfhandle(m_file.fd());
+    if ( hFile == INVALID_HANDLE_VALUE )
+        return NULL;
+
+    const HANDLE hMapping = ::CreateFileMapping(hFile, NULL, PAGE_READONLY,
+                                                0, 0, NULL);
+    if ( !hMapping )
+        return NULL;
+
+    void * const p = ::MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+
+    // the view, if we got one, keeps the mapping object alive
+    ::CloseHandle(hMapping);
+
+    if ( !p )
+        return NULL;
+#else // no memory mapped files support
+    return NULL;
+#endif
+
+    *len = (size_t)length;
+
+    return static_cast<const char *>(p);
+}
+
+
+void wxTextFile::OnUnmap(const char *data, size_t len)
+{
+#if defined(__UNIX__)
+    munmap(const_cast<char *>(data), len);
+#elif defined(__WINDOWS__)
+    wxUnusedVar(len);
+    ::UnmapViewOfFile(data);
+#else
+    wxUnusedVar(data);
+    wxUnusedVar(len);
+#endif
+}
+
+
 bool wxTextFile::OnWrite(wxTextFileType typeNew, const wxMBConv& conv)
 {
     wxFileName fn = m_strBufferName;
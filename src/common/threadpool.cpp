@@ -0,0 +1,692 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/threadpool.cpp
+// Purpose:     wxThreadPool implementation
+// Created:     2022-04-18
+// Copyright:   (c) 2022 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// For compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+
+#include "wx/threadpool.h"
+
+#if wxUSE_THREADS
+
+#ifndef WX_PRECOMP
+    #include "wx/app.h"
+    #include "wx/log.h"
+    #include "wx/module.h"
+    #include "wx/utils.h"
+#endif // WX_PRECOMP
+
+namespace
+{
+
+// ----------------------------------------------------------------------------
+// wxThreadPoolCompletionCall: functor used with CallAfter()
+// ----------------------------------------------------------------------------
+
+// This object takes over the reference to the task held by the pool and
+// releases it after delivering the completion notification in the main
+// thread.
+struct wxThreadPoolCompletionCall
+{
+    explicit wxThreadPoolCompletionCall(wxThreadPoolTask* task)
+        : m_task(task)
+    {
+    }
+
+    void operator()()
+    {
+        m_task->OnCompleted();
+        m_task->DecRef();
+    }
+
+    wxThreadPoolTask* m_task;
+};
+
+// the default pool returned by wxThreadPool::GetDefault() and the critical
+// section protecting its creation
+wxThreadPool* gs_defaultPool = NULL;
+wxCriticalSection gs_defaultPoolCS;
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// wxThreadPoolWorker: the thread running wxThreadPool::WorkerLoop()
+// ----------------------------------------------------------------------------
+
+class wxThreadPoolWorker : public wxThread
+{
+public:
+    wxThreadPoolWorker(wxThreadPool& pool, size_t indexWorker)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_pool(pool),
+          m_indexWorker(indexWorker)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() wxOVERRIDE
+    {
+        m_pool.WorkerLoop(m_indexWorker);
+
+        return NULL;
+    }
+
+private:
+    wxThreadPool& m_pool;
+    const size_t m_indexWorker;
+
+    wxDECLARE_NO_COPY_CLASS(wxThreadPoolWorker);
+};
+
+// ============================================================================
+// implementation
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// wxThreadPoolTask
+// ----------------------------------------------------------------------------
+
+wxThreadPoolTask::wxThreadPoolTask()
+    : m_refCount(1),
+      m_state(State_Pending),
+      m_stateCond(m_stateMutex)
+{
+}
+
+wxThreadPoolTask::~wxThreadPoolTask()
+{
+}
+
+wxThreadPoolTask::State wxThreadPoolTask::GetState() const
+{
+    wxMutexLocker lock(const_cast<wxThreadPoolTask*>(this)->m_stateMutex);
+
+    return m_state;
+}
+
+void wxThreadPoolTask::SetState(State state)
+{
+    wxMutexLocker lock(m_stateMutex);
+
+    m_state = state;
+
+    // only the final states can be waited for
+    if ( state == State_Completed || state == State_Cancelled )
+        m_stateCond.Broadcast();
+}
+
+bool wxThreadPoolTask::Wait()
+{
+    wxMutexLocker lock(m_stateMutex);
+
+    while ( m_state == State_Pending || m_state == State_Running )
+        m_stateCond.Wait();
+
+    return m_state == State_Completed;
+}
+
+void wxThreadPoolTask::IncRef()
+{
+    wxAtomicInc(m_refCount);
+}
+
+void wxThreadPoolTask::DecRef()
+{
+    if ( wxAtomicDec(m_refCount) == 0 )
+        delete this;
+}
+
+// ----------------------------------------------------------------------------
+// wxThreadPool
+// ----------------------------------------------------------------------------
+
+wxThreadPool::wxThreadPool(int numThreads)
+    : m_maxThreads(numThreads > 0 ? numThreads
+                                  : wxMax(1, wxThread::GetCPUCount())),
+      m_condHasWork(m_mutex),
+      m_condIdle(m_mutex),
+      m_numActive(0),
+      m_numIdle(0),
+      m_shuttingDown(false)
+{
+}
+
+wxThreadPool::~wxThreadPool()
+{
+    m_mutex.Lock();
+
+    m_shuttingDown = true;
+
+    // cancel all the tasks which didn't start executing yet
+    while ( !m_queue.empty() )
+    {
+        wxThreadPoolTask* const task = m_queue.front().task;
+        m_queue.pop_front();
+
+        task->SetState(wxThreadPoolTask::State_Cancelled);
+        task->DecRef();
+    }
+
+    for ( size_t n = 0; n < m_workerQueues.size(); n++ )
+    {
+        std::deque<wxThreadPoolTask*>& queue = m_workerQueues[n];
+        while ( !queue.empty() )
+        {
+            wxThreadPoolTask* const task = queue.front();
+            queue.pop_front();
+
+            task->SetState(wxThreadPoolTask::State_Cancelled);
+            task->DecRef();
+        }
+    }
+
+    // and wake up all the idle workers so that they notice the shutdown
+    m_condHasWork.Broadcast();
+
+    m_mutex.Unlock();
+
+    // the running tasks are allowed to finish, so this can block for as long
+    // as the longest of them takes
+    for ( size_t n = 0; n < m_workers.size(); n++ )
+    {
+        m_workers[n]->Wait();
+        delete m_workers[n];
+    }
+}
+
+bool wxThreadPool::AddTask(wxThreadPoolTask* task, int priority)
+{
+    wxCHECK_MSG( task, false, wxT("NULL task can't be queued") );
+
+    wxMutexLocker lock(m_mutex);
+
+    if ( m_shuttingDown )
+        return false;
+
+    // this is the reference owned by the pool, released after delivering the
+    // completion notification (or when the task is cancelled)
+    task->IncRef();
+
+    const int indexWorker = GetCurrentWorkerIndex();
+    if ( indexWorker != wxNOT_FOUND )
+    {
+        // tasks spawned by another task go to the deque of the worker
+        // running it, the newest task is executed first for cache locality
+        m_workerQueues[indexWorker].push_back(task);
+    }
+    else
+    {
+        // keep the global queue sorted by decreasing priority with FIFO
+        // order among the tasks of the same priority
+        std::deque<QueuedTask>::iterator it = m_queue.begin();
+        while ( it != m_queue.end() && it->priority >= priority )
+            ++it;
+
+        m_queue.insert(it, QueuedTask(task, priority));
+    }
+
+    // start a new worker if all the existing ones are busy and we may still
+    // create more of them
+    if ( m_numIdle == 0 && m_workers.size() < m_maxThreads )
+    {
+        wxThreadPoolWorker* const
+            worker = new wxThreadPoolWorker(*this, m_workers.size());
+        if ( worker->Run() == wxTHREAD_NO_ERROR )
+        {
+            m_workers.push_back(worker);
+            m_workerQueues.push_back(std::deque<wxThreadPoolTask*>());
+        }
+        else
+        {
+            // don't fail: one of the already running workers will pick the
+            // task up eventually
+            wxLogDebug(wxS("Failed to start a thread pool worker."));
+            delete worker;
+        }
+    }
+
+    m_condHasWork.Signal();
+
+    return true;
+}
+
+void wxThreadPool::WaitForAll()
+{
+    wxMutexLocker lock(m_mutex);
+
+    wxCHECK_RET( GetCurrentWorkerIndex() == wxNOT_FOUND,
+                 wxT("can't wait for the pool from one of its own tasks") );
+
+    for ( ;; )
+    {
+        bool hasWork = m_numActive != 0 || !m_queue.empty();
+        for ( size_t n = 0; !hasWork && n < m_workerQueues.size(); n++ )
+        {
+            if ( !m_workerQueues[n].empty() )
+                hasWork = true;
+        }
+
+        if ( !hasWork )
+            break;
+
+        m_condIdle.Wait();
+    }
+}
+
+/* static */
+wxThreadPool& wxThreadPool::GetDefault()
+{
+    wxCriticalSectionLocker lock(gs_defaultPoolCS);
+
+    if ( !gs_defaultPool )
+        gs_defaultPool = new wxThreadPool();
+
+    return *gs_defaultPool;
+}
+
+int wxThreadPool::GetCurrentWorkerIndex() const
+{
+    wxThread* const self = wxThread::This();
+
+    for ( size_t n = 0; n < m_workers.size(); n++ )
+    {
+        if ( m_workers[n] == self )
+            return static_cast<int>(n);
+    }
+
+    return wxNOT_FOUND;
+}
+
+wxThreadPoolTask* wxThreadPool::FindWork(size_t indexWorker)
+{
+    // our own tasks first, newest one for locality
+    std::deque<wxThreadPoolTask*>& ownQueue = m_workerQueues[indexWorker];
+    if ( !ownQueue.empty() )
+    {
+        wxThreadPoolTask* const task = ownQueue.back();
+        ownQueue.pop_back();
+        return task;
+    }
+
+    // then the tasks queued from outside of the pool, in priority order
+    if ( !m_queue.empty() )
+    {
+        wxThreadPoolTask* const task = m_queue.front().task;
+        m_queue.pop_front();
+        return task;
+    }
+
+    // and finally try stealing the oldest task of another worker
+    for ( size_t n = 0; n < m_workerQueues.size(); n++ )
+    {
+        std::deque<wxThreadPoolTask*>& queue = m_workerQueues[n];
+        if ( !queue.empty() )
+        {
+            wxThreadPoolTask* const task = queue.front();
+            queue.pop_front();
+            return task;
+        }
+    }
+
+    return NULL;
+}
+
+void wxThreadPool::WorkerLoop(size_t indexWorker)
+{
+    m_mutex.Lock();
+
+    for ( ;; )
+    {
+        wxThreadPoolTask* task = FindWork(indexWorker);
+        while ( !task )
+        {
+            if ( m_shuttingDown )
+            {
+                m_mutex.Unlock();
+                return;
+            }
+
+            m_numIdle++;
+            m_condHasWork.Wait();
+            m_numIdle--;
+
+            task = FindWork(indexWorker);
+        }
+
+        m_numActive++;
+
+        m_mutex.Unlock();
+
+        RunTask(task);
+
+        m_mutex.Lock();
+
+        if ( !--m_numActive )
+            m_condIdle.Broadcast();
+    }
+}
+
+void wxThreadPool::RunTask(wxThreadPoolTask* task)
+{
+    task->SetState(wxThreadPoolTask::State_Running);
+    task->Execute();
+    task->SetState(wxThreadPoolTask::State_Completed);
+
+    // deliver the notification in the main thread if we can or directly
+    // from here otherwise, transferring our reference to the task in both
+    // cases
+    wxThreadPoolCompletionCall call(task);
+    if ( wxTheApp )
+        wxTheApp->CallAfter(call);
+    else
+        call();
+}
+
+// ----------------------------------------------------------------------------
+// wxTaskGraphRunner: the pool task executing a single graph node
+// ----------------------------------------------------------------------------
+
+class wxTaskGraphRunner : public wxThreadPoolTask
+{
+public:
+    wxTaskGraphRunner(wxTaskGraph* graph, wxTaskGraphNode* node)
+        : m_graph(graph),
+          m_node(node)
+    {
+    }
+
+    virtual void Execute() wxOVERRIDE
+    {
+        m_graph->RunNode(m_node);
+    }
+
+private:
+    wxTaskGraph* const m_graph;
+    wxTaskGraphNode* const m_node;
+
+    wxDECLARE_NO_COPY_CLASS(wxTaskGraphRunner);
+};
+
+namespace
+{
+
+// Functor used with CallAfter() to run a GUI-affine node in the main thread,
+// releasing the reference to the runner afterwards.
+struct wxTaskGraphGuiCall
+{
+    explicit wxTaskGraphGuiCall(wxTaskGraphRunner* runner)
+        : m_runner(runner)
+    {
+    }
+
+    void operator()()
+    {
+        m_runner->Execute();
+        m_runner->DecRef();
+    }
+
+    wxTaskGraphRunner* m_runner;
+};
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// wxTaskGraph
+// ----------------------------------------------------------------------------
+
+wxTaskGraph::wxTaskGraph(wxThreadPool* pool)
+    : m_pool(pool ? pool : &wxThreadPool::GetDefault()),
+      m_condDone(m_mutex),
+      m_numRemaining(0),
+      m_submitted(false)
+{
+}
+
+wxTaskGraph::~wxTaskGraph()
+{
+    if ( m_submitted )
+        Wait();
+
+    for ( size_t n = 0; n < m_nodes.size(); n++ )
+    {
+        wxTaskGraphNode* const node = m_nodes[n];
+
+        // if the graph was never submitted, its tasks will never run
+        if ( node->m_task->GetState() == wxThreadPoolTask::State_Pending )
+            node->m_task->SetState(wxThreadPoolTask::State_Cancelled);
+
+        node->m_task->DecRef();
+
+        delete node;
+    }
+}
+
+wxTaskGraphNode* wxTaskGraph::AddTask(wxThreadPoolTask* task,
+                                      bool runInMainThread)
+{
+    wxCHECK_MSG( task, NULL, wxT("NULL task can't be added to a graph") );
+    wxCHECK_MSG( !m_submitted, NULL,
+                 wxT("can't add tasks to an already submitted graph") );
+
+    task->IncRef();
+
+    wxTaskGraphNode* const
+        node = new wxTaskGraphNode(task, m_nodes.size(), runInMainThread);
+    m_nodes.push_back(node);
+
+    return node;
+}
+
+void
+wxTaskGraph::AddDependency(wxTaskGraphNode* node, wxTaskGraphNode* predecessor)
+{
+    wxCHECK_RET( node && predecessor, wxT("NULL node in AddDependency()") );
+    wxCHECK_RET( !m_submitted,
+                 wxT("can't add dependencies to an already submitted graph") );
+    wxCHECK_RET( node->m_index < m_nodes.size() &&
+                 m_nodes[node->m_index] == node &&
+                 predecessor->m_index < m_nodes.size() &&
+                 m_nodes[predecessor->m_index] == predecessor,
+                 wxT("both nodes must belong to this graph") );
+
+    predecessor->m_dependents.push_back(node);
+    node->m_numPendingPreds++;
+}
+
+bool wxTaskGraph::Submit()
+{
+    wxCHECK_MSG( !m_submitted, false, wxT("graph already submitted") );
+
+    const size_t count = m_nodes.size();
+
+    // Before starting anything, verify that the dependencies don't contain
+    // any cycles by simulating the execution order.
+    wxVector<size_t> numPreds;
+    numPreds.reserve(count);
+
+    wxVector<size_t> ready;
+    for ( size_t n = 0; n < count; n++ )
+    {
+        numPreds.push_back(m_nodes[n]->m_numPendingPreds);
+        if ( !numPreds[n] )
+            ready.push_back(n);
+    }
+
+    size_t numOrdered = 0;
+    while ( !ready.empty() )
+    {
+        const wxTaskGraphNode* const node = m_nodes[ready.back()];
+        ready.pop_back();
+        numOrdered++;
+
+        for ( size_t n = 0; n < node->m_dependents.size(); n++ )
+        {
+            const size_t indexDep = node->m_dependents[n]->m_index;
+            if ( !--numPreds[indexDep] )
+                ready.push_back(indexDep);
+        }
+    }
+
+    if ( numOrdered != count )
+    {
+        wxFAIL_MSG( wxT("task graph dependencies contain a cycle") );
+
+        return false;
+    }
+
+    m_submitted = true;
+    m_numRemaining = count;
+
+    // Now really start all the tasks without any predecessors.
+    for ( size_t n = 0; n < count; n++ )
+    {
+        if ( !m_nodes[n]->m_numPendingPreds )
+            StartNode(m_nodes[n]);
+    }
+
+    return true;
+}
+
+void wxTaskGraph::Wait()
+{
+    wxCHECK_RET( m_submitted, wxT("call Submit() before Wait()") );
+
+    wxMutexLocker lock(m_mutex);
+
+    while ( m_numRemaining )
+        m_condDone.Wait();
+}
+
+void wxTaskGraph::StartNode(wxTaskGraphNode* node)
+{
+    if ( node->m_cancelled )
+    {
+        // one of our predecessors didn't run, so this task can't run either
+        CancelNode(node);
+        return;
+    }
+
+    wxTaskGraphRunner* const runner = new wxTaskGraphRunner(this, node);
+
+    if ( node->m_runInMain && wxTheApp )
+    {
+        // deliver the task to the main thread using the pending events
+        // mechanism, the functor keeps our reference to the runner
+        wxTaskGraphGuiCall call(runner);
+        wxTheApp->CallAfter(call);
+    }
+    else if ( m_pool->AddTask(runner) )
+    {
+        // the pool took its own reference, release ours
+        runner->DecRef();
+    }
+    else // the pool is shutting down and won't run the task
+    {
+        runner->DecRef();
+
+        CancelNode(node);
+    }
+}
+
+void wxTaskGraph::RunNode(wxTaskGraphNode* node)
+{
+    wxThreadPoolTask* const task = node->m_task;
+
+    task->SetState(wxThreadPoolTask::State_Running);
+    task->Execute();
+    task->SetState(wxThreadPoolTask::State_Completed);
+
+    // Deliver the completion notification as wxThreadPool does, in the main
+    // thread if possible, with a new reference as we keep ours until the
+    // graph is destroyed.
+    task->IncRef();
+    wxThreadPoolCompletionCall call(task);
+    if ( wxTheApp )
+        wxTheApp->CallAfter(call);
+    else
+        call();
+
+    wxVector<wxTaskGraphNode*> ready;
+
+    m_mutex.Lock();
+    CompleteNode(node, ready);
+    m_mutex.Unlock();
+
+    for ( size_t n = 0; n < ready.size(); n++ )
+        StartNode(ready[n]);
+}
+
+void wxTaskGraph::CancelNode(wxTaskGraphNode* node)
+{
+    node->m_task->SetState(wxThreadPoolTask::State_Cancelled);
+
+    wxVector<wxTaskGraphNode*> ready;
+
+    m_mutex.Lock();
+
+    // the dependents of a task that didn't run can't run either
+    for ( size_t n = 0; n < node->m_dependents.size(); n++ )
+        node->m_dependents[n]->m_cancelled = true;
+
+    CompleteNode(node, ready);
+
+    m_mutex.Unlock();
+
+    // this cancels them because of the flag set above
+    for ( size_t n = 0; n < ready.size(); n++ )
+        StartNode(ready[n]);
+}
+
+void
+wxTaskGraph::CompleteNode(wxTaskGraphNode* node,
+                          wxVector<wxTaskGraphNode*>& ready)
+{
+    for ( size_t n = 0; n < node->m_dependents.size(); n++ )
+    {
+        wxTaskGraphNode* const dep = node->m_dependents[n];
+        if ( !--dep->m_numPendingPreds )
+            ready.push_back(dep);
+    }
+
+    if ( !--m_numRemaining )
+        m_condDone.Broadcast();
+}
+
+// ----------------------------------------------------------------------------
+// wxThreadPoolModule
+// ----------------------------------------------------------------------------
+
+// this module ensures that the default pool is destroyed, waiting for its
+// still running tasks, before the library cleanup
+class wxThreadPoolModule : public wxModule
+{
+public:
+    virtual bool OnInit() wxOVERRIDE { return true; }
+
+    virtual void OnExit() wxOVERRIDE
+    {
+        wxCriticalSectionLocker lock(gs_defaultPoolCS);
+
+        wxDELETE(gs_defaultPool);
+    }
+
+private:
+    wxDECLARE_DYNAMIC_CLASS(wxThreadPoolModule);
+};
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxThreadPoolModule, wxModule);
+
+#endif // wxUSE_THREADS
@@ -42,17 +42,22 @@
 #include "wx/file.h"
 #include "wx/filename.h"
 #include "wx/tokenzr.h"
+#include "wx/vector.h"
 #include "wx/fontmap.h"
 #include "wx/scopedptr.h"
 #include "wx/stdpaths.h"
 #include "wx/version.h"
 #include "wx/private/threadinfo.h"
 
+#ifdef __UNIX__
+    #include <sys/mman.h>
+#endif
 #ifdef __WINDOWS__
     #include "wx/dynlib.h"
     #include "wx/scopedarray.h"
     #include "wx/msw/wrapwin.h"
     #include "wx/msw/missing.h"
+    #include <io.h>
 #endif
 #ifdef __WXOSX__
     #include "wx/osx/core/cfstring.h"
@@ -624,7 +629,10 @@ wxPluralFormsNode::evaluate(wxPluralFormsToken::Number n) const
 class wxPluralFormsCalculator
 {
 public:
-    wxPluralFormsCalculator() : m_nplurals(0), m_plural(0) {}
+    wxPluralFormsCalculator() : m_nplurals(0), m_plural(0)
+    {
+        memset(m_cache, -1, sizeof(m_cache));
+    }
 
     // input: number, returns msgstr index
     int evaluate(int n) const;
@@ -639,8 +647,36 @@ public:
     void  init(wxPluralFormsToken::Number nplurals, wxPluralFormsNode* plural);
 
 private:
+    // a single instruction of the compiled, postfix ("reverse Polish") form
+    // of the plural expression, see compile()
+    struct Op
+    {
+        wxPluralFormsToken::Type type;
+        wxPluralFormsToken::Number number;  // for T_NUMBER only
+    };
+
+    // the size of the evaluation stack used by run(): enough for any sane
+    // expression as only the leaves, i.e. "n" and numbers, grow the stack
+    enum { MaxStackDepth = 32 };
+
+    // append the postfix form of the expression rooted at the given node to
+    // m_program; depth is the number of values already on the stack when it
+    // is evaluated, return false if MaxStackDepth would be exceeded
+    bool compile(const wxPluralFormsNode* node, int depth);
+
+    // evaluate m_program, which must not be empty
+    wxPluralFormsToken::Number run(wxPluralFormsToken::Number n) const;
+
     wxPluralFormsToken::Number m_nplurals;
     wxPluralFormsNodePtr m_plural;
+
+    // the compiled form of the expression, evaluated without chasing the tree
+    // pointers (empty if the expression was too complex to compile)
+    wxVector<Op> m_program;
+
+    // memoized results for small n, which cover almost all real calls
+    // (-1 means "not computed yet")
+    mutable signed char m_cache[33];
 };
 
 wxDEFINE_SCOPED_PTR(wxPluralFormsCalculator, wxPluralFormsCalculatorPtr)
@@ -650,6 +686,142 @@ void wxPluralFormsCalculator::init(wxPluralFormsToken::Number nplurals,
 {
     m_nplurals = nplurals;
     m_plural.reset(plural);
+
+    m_program.clear();
+    memset(m_cache, -1, sizeof(m_cache));
+
+    if (plural && !compile(plural, 0))
+    {
+        // the expression is too deep for the fixed size stack of run(),
+        // evaluate() will fall back to walking the tree directly
+        m_program.clear();
+    }
+}
+
+bool wxPluralFormsCalculator::compile(const wxPluralFormsNode* node, int depth)
+{
+    const wxPluralFormsToken::Type type = node->token().type();
+    switch (type)
+    {
+        // leaves are the only instructions making the stack deeper
+        case wxPluralFormsToken::T_NUMBER:
+        case wxPluralFormsToken::T_N:
+            if (depth >= MaxStackDepth)
+            {
+                return false;
+            }
+            break;
+
+        // 2 args
+        case wxPluralFormsToken::T_EQUAL:
+        case wxPluralFormsToken::T_NOT_EQUAL:
+        case wxPluralFormsToken::T_GREATER:
+        case wxPluralFormsToken::T_GREATER_OR_EQUAL:
+        case wxPluralFormsToken::T_LESS:
+        case wxPluralFormsToken::T_LESS_OR_EQUAL:
+        case wxPluralFormsToken::T_REMINDER:
+        case wxPluralFormsToken::T_LOGICAL_AND:
+        case wxPluralFormsToken::T_LOGICAL_OR:
+            if (!compile(node->node(0), depth) ||
+                    !compile(node->node(1), depth + 1))
+            {
+                return false;
+            }
+            break;
+
+        // 3 args
+        case wxPluralFormsToken::T_QUESTION:
+            if (!compile(node->node(0), depth) ||
+                    !compile(node->node(1), depth + 1) ||
+                        !compile(node->node(2), depth + 2))
+            {
+                return false;
+            }
+            break;
+
+        default:
+            // shouldn't happen for a successfully parsed expression
+            return false;
+    }
+
+    Op op;
+    op.type = type;
+    op.number = type == wxPluralFormsToken::T_NUMBER ? node->token().number()
+                                                     : 0;
+    m_program.push_back(op);
+
+    return true;
+}
+
+wxPluralFormsToken::Number
+wxPluralFormsCalculator::run(wxPluralFormsToken::Number n) const
+{
+    // notice that, unlike in wxPluralFormsNode::evaluate(), "&&", "||" and
+    // "?:" evaluate all of their operands, but this cannot be observed as the
+    // operands have no side effects ("%" by zero included, see below)
+    wxPluralFormsToken::Number stack[MaxStackDepth];
+    int sp = 0;
+
+    for ( wxVector<Op>::const_iterator it = m_program.begin();
+          it != m_program.end();
+          ++it )
+    {
+        switch (it->type)
+        {
+            case wxPluralFormsToken::T_NUMBER:
+                stack[sp++] = it->number;
+                break;
+            case wxPluralFormsToken::T_N:
+                stack[sp++] = n;
+                break;
+            case wxPluralFormsToken::T_EQUAL:
+                --sp;
+                stack[sp - 1] = stack[sp - 1] == stack[sp];
+                break;
+            case wxPluralFormsToken::T_NOT_EQUAL:
+                --sp;
+                stack[sp - 1] = stack[sp - 1] != stack[sp];
+                break;
+            case wxPluralFormsToken::T_GREATER:
+                --sp;
+                stack[sp - 1] = stack[sp - 1] > stack[sp];
+                break;
+            case wxPluralFormsToken::T_GREATER_OR_EQUAL:
+                --sp;
+                stack[sp - 1] = stack[sp - 1] >= stack[sp];
+                break;
+            case wxPluralFormsToken::T_LESS:
+                --sp;
+                stack[sp - 1] = stack[sp - 1] < stack[sp];
+                break;
+            case wxPluralFormsToken::T_LESS_OR_EQUAL:
+                --sp;
+                stack[sp - 1] = stack[sp - 1] <= stack[sp];
+                break;
+            case wxPluralFormsToken::T_REMINDER:
+                --sp;
+                stack[sp - 1] = stack[sp] != 0 ? stack[sp - 1] % stack[sp] : 0;
+                break;
+            case wxPluralFormsToken::T_LOGICAL_AND:
+                --sp;
+                stack[sp - 1] = stack[sp - 1] && stack[sp];
+                break;
+            case wxPluralFormsToken::T_LOGICAL_OR:
+                --sp;
+                stack[sp - 1] = stack[sp - 1] || stack[sp];
+                break;
+            case wxPluralFormsToken::T_QUESTION:
+                sp -= 2;
+                stack[sp - 1] = stack[sp - 1] ? stack[sp] : stack[sp + 1];
+                break;
+            default:
+                // compile() doesn't emit anything else
+                return 0;
+        }
+    }
+
+    // compile() ensured that exactly one value remains on the stack
+    return stack[0];
 }
 
 int wxPluralFormsCalculator::evaluate(int n) const
@@ -658,11 +830,25 @@ int wxPluralFormsCalculator::evaluate(int n) const
     {
         return 0;
     }
-    wxPluralFormsToken::Number number = m_plural->evaluate(n);
+
+    const bool cacheable = n >= 0 && n < (int)WXSIZEOF(m_cache);
+    if (cacheable && m_cache[n] != -1)
+    {
+        return m_cache[n];
+    }
+
+    wxPluralFormsToken::Number number = m_program.empty() ? m_plural->evaluate(n)
+                                                          : run(n);
     if (number < 0 || number > m_nplurals)
     {
-        return 0;
+        number = 0;
     }
+
+    if (cacheable && number <= SCHAR_MAX)
+    {
+        m_cache[n] = (signed char)number;
+    }
+
     return number;
 }
 
@@ -1032,6 +1218,18 @@ public:
     // fills the hash with string-translation pairs
     bool FillHash(wxStringToStringHashMap& hash, const wxString& domain) const;
 
+    // return true if the strings can be looked up directly in the catalog
+    // data with LookupString(), i.e. without converting them all into a hash
+    // upfront: this is the case when comparing the raw bytes of the strings
+    // is enough, i.e. when the catalog is in UTF-8
+    bool CanLookupInPlace() const;
+
+    // return the translation of the given original string or NULL if it is
+    // not found; the returned pointer is into the catalog data and the length
+    // of the translation, which may contain embedded NULs separating the
+    // plural forms, is returned in lenTrans
+    const char *LookupString(const char *msgid, size_t32 *lenTrans) const;
+
     // return the charset of the strings in this catalog or empty string if
     // none/unknown
     wxString GetCharset() const { return m_charset; }
@@ -1058,15 +1256,27 @@ private:
                   ofsHashTable;   //        +18:  offset of hash table start
     };
 
+    // map the file in memory and return a pointer to the mapping or NULL if
+    // it failed (e.g. memory mapped files are not supported here); the
+    // mapping remains valid for the life time of this object
+    const char *MapFile(wxFile& file, size_t len);
+
     // all data is stored here
     DataBuffer m_data;
 
+    // the memory mapping underlying m_data, if any
+    const char *m_mapAddr;
+    size_t      m_mapLen;
+
     // data description
     size_t32          m_numStrings;   // number of strings in this domain
     const
     wxMsgTableEntry  *m_pOrigTable,   // pointer to original   strings
                      *m_pTransTable;  //            translated
 
+    const size_t32   *m_pHashTable;   // the built-in hash table, may be NULL
+    size_t32          m_nHashSize;    // number of its entries
+
     wxString m_charset;               // from the message catalog header
 
 
@@ -1103,10 +1313,58 @@ private:
 
 wxMsgCatalogFile::wxMsgCatalogFile()
 {
+    m_mapAddr = NULL;
+    m_mapLen = 0;
+    m_pHashTable = NULL;
+    m_nHashSize = 0;
 }
 
 wxMsgCatalogFile::~wxMsgCatalogFile()
 {
+#if defined(__UNIX__)
+    if ( m_mapAddr )
+        munmap(const_cast<char *>(m_mapAddr), m_mapLen);
+#elif defined(__WINDOWS__)
+    if ( m_mapAddr )
+        ::UnmapViewOfFile(m_mapAddr);
+#endif
+}
+
+const char *wxMsgCatalogFile::MapFile(wxFile& file, size_t len)
+{
+    if ( !len )
+        return NULL;
+
+#if defined(__UNIX__)
+    void * const p = mmap(NULL, len, PROT_READ, MAP_SHARED, file.fd(), 0);
+    if ( p == MAP_FAILED )
+        return NULL;
+#elif defined(__WINDOWS__)
+    const HANDLE hFile = (HANDLE)_get_osfhandle(file.fd());
+    if ( hFile == INVALID_HANDLE_VALUE )
+        return NULL;
+
+    const HANDLE hMapping = ::CreateFileMapping(hFile, NULL, PAGE_READONLY,
+                                                0, 0, NULL);
+    if ( !hMapping )
+        return NULL;
+
+    void * const p = ::MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+
+    // the view, if we got one, keeps the mapping object alive
+    ::CloseHandle(hMapping);
+
+    if ( !p )
+        return NULL;
+#else // no memory mapped files support
+    wxUnusedVar(file);
+    return NULL;
+#endif
+
+    m_mapAddr = static_cast<const char *>(p);
+    m_mapLen = len;
+
+    return m_mapAddr;
 }
 
 // open disk file and read in it's contents
@@ -1125,20 +1383,29 @@ bool wxMsgCatalogFile::LoadFile(const wxString& filename,
     size_t nSize = wx_truncate_cast(size_t, lenFile);
     wxASSERT_MSG( nSize == lenFile + size_t(0), wxS("message catalog bigger than 4GB?") );
 
-    wxMemoryBuffer filedata;
+    DataBuffer data;
 
-    // read the whole file in memory
-    if ( fileMsg.Read(filedata.GetWriteBuf(nSize), nSize) != lenFile )
-        return false;
+    // try to map the file in memory first: the mapping is shared with the
+    // system file cache (and any other process using the same catalog) and
+    // the strings which are never fetched don't even need to be paged in
+    const char * const mapped = MapFile(fileMsg, nSize);
+    if ( mapped )
+    {
+        data = DataBuffer::CreateNonOwned(mapped, nSize);
+    }
+    else // fall back to reading the whole file in memory
+    {
+        wxMemoryBuffer filedata;
+
+        if ( fileMsg.Read(filedata.GetWriteBuf(nSize), nSize) != lenFile )
+            return false;
+
+        filedata.UngetWriteBuf(nSize);
 
-    filedata.UngetWriteBuf(nSize);
+        data = DataBuffer::CreateOwned((char*)filedata.release(), nSize);
+    }
 
-    bool ok = LoadData
-              (
-                  DataBuffer::CreateOwned((char*)filedata.release(), nSize),
-                  rPluralFormsCalculator
-              );
-    if ( !ok )
+    if ( !LoadData(data, rPluralFormsCalculator) )
     {
         wxLogWarning(_("'%s' is not a valid message catalog."), filename);
         return false;
@@ -1178,6 +1445,19 @@ bool wxMsgCatalogFile::LoadData(const DataBuffer& data,
     m_pTransTable = reinterpret_cast<const wxMsgTableEntry*>(data.data() +
                     Swap(pHeader->ofsTransTable));
 
+    // the built-in hash table is optional, only use it if it is present and
+    // sane: LookupString() falls back to a binary search in the original
+    // strings table without it
+    const size_t32 nHashSize = Swap(pHeader->nHashSize);
+    const size_t32 ofsHashTable = Swap(pHeader->ofsHashTable);
+    if ( nHashSize > 2 &&
+            (size_t)ofsHashTable + nHashSize*sizeof(size_t32) <= data.length() )
+    {
+        m_nHashSize = nHashSize;
+        m_pHashTable = reinterpret_cast<const size_t32*>(data.data() +
+                       ofsHashTable);
+    }
+
     // now parse catalog's header and try to extract catalog charset and
     // plural forms formula from it:
 
@@ -1238,6 +1518,106 @@ bool wxMsgCatalogFile::LoadData(const DataBuffer& data,
     return true;
 }
 
+bool wxMsgCatalogFile::CanLookupInPlace() const
+{
+    // looking up the strings in the catalog data compares their raw bytes,
+    // which is only correct if no charset conversion may change them, i.e.
+    // when the catalog is in UTF-8 (the msgids are supposed to be in ASCII
+    // and hence are valid UTF-8 too)
+    wxString cs(m_charset);
+    cs.Replace(wxS("-"), wxString());
+
+    return cs.CmpNoCase(wxS("UTF8")) == 0;
+}
+
+const char *
+wxMsgCatalogFile::LookupString(const char *msgid, size_t32 *lenTrans) const
+{
+    size_t32 n = m_numStrings;  // invalid index means "not found"
+
+    if ( m_pHashTable )
+    {
+        // use the same hash function as GNU gettext (hashpjw from the Dragon
+        // book) and its open addressing probing scheme
+        size_t32 hval = 0;
+        for ( const char *p = msgid; *p; p++ )
+        {
+            hval = (hval << 4) + (unsigned char)*p;
+            const size_t32 g = hval & 0xf0000000;
+            if ( g )
+            {
+                hval ^= g >> 24;
+                hval ^= g;
+            }
+        }
+
+        const size_t32 incr = 1 + hval % (m_nHashSize - 2);
+        size_t32 idx = hval % m_nHashSize;
+
+        // a valid hash table always has free slots, but bound the number of
+        // probes anyhow to not loop forever on a corrupt catalog
+        for ( size_t32 probe = 0; probe < m_nHashSize; probe++ )
+        {
+            // the stored indices are 1-based, 0 marks a free slot
+            const size_t32 i = Swap(m_pHashTable[idx]);
+            if ( i == 0 )
+                break;
+
+            if ( i <= m_numStrings )
+            {
+                const char * const orig = StringAtOfs(m_pOrigTable, i - 1);
+                if ( orig && strcmp(orig, msgid) == 0 )
+                {
+                    n = i - 1;
+                    break;
+                }
+            }
+            //else: corrupt entry, skip it
+
+            if ( idx >= m_nHashSize - incr )
+                idx -= m_nHashSize - incr;
+            else
+                idx += incr;
+        }
+    }
+    else // no hash table: the original strings table is sorted, bisect it
+    {
+        size_t32 lo = 0,
+                 hi = m_numStrings;
+        while ( lo < hi )
+        {
+            const size_t32 mid = (lo + hi)/2;
+            const char * const orig = StringAtOfs(m_pOrigTable, mid);
+            if ( !orig )
+                return NULL;
+
+            const int cmp = strcmp(msgid, orig);
+            if ( cmp < 0 )
+            {
+                hi = mid;
+            }
+            else if ( cmp > 0 )
+            {
+                lo = mid + 1;
+            }
+            else
+            {
+                n = mid;
+                break;
+            }
+        }
+    }
+
+    if ( n == m_numStrings )
+        return NULL;
+
+    const char * const trans = StringAtOfs(m_pTransTable, n);
+    if ( trans )
+        *lenTrans = Swap(m_pTransTable[n].nLen);
+
+    return trans;
+}
+
 bool wxMsgCatalogFile::FillHash(wxStringToStringHashMap& hash,
                                 const wxString& domain) const
 {
@@ -1344,9 +1724,11 @@ bool wxMsgCatalogFile::FillHash(wxStringToStringHashMap& hash,
 // wxMsgCatalog class
 // ----------------------------------------------------------------------------
 
-#if !wxUSE_UNICODE
 wxMsgCatalog::~wxMsgCatalog()
 {
+    delete m_file;
+
+#if !wxUSE_UNICODE
     if ( m_conv )
     {
         if ( wxConvUI == m_conv )
@@ -1358,8 +1740,8 @@ wxMsgCatalog::~wxMsgCatalog()
 
         delete m_conv;
     }
-}
 #endif // !wxUSE_UNICODE
+}
 
 /* static */
 wxMsgCatalog *wxMsgCatalog::CreateFromFile(const wxString& filename,
@@ -1367,12 +1749,22 @@ wxMsgCatalog *wxMsgCatalog::CreateFromFile(const wxString& filename,
 {
     wxScopedPtr<wxMsgCatalog> cat(new wxMsgCatalog(domain));
 
-    wxMsgCatalogFile file;
+    wxScopedPtr<wxMsgCatalogFile> file(new wxMsgCatalogFile);
 
-    if ( !file.LoadFile(filename, cat->m_pluralFormsCalculator) )
+    if ( !file->LoadFile(filename, cat->m_pluralFormsCalculator) )
         return NULL;
 
-    if ( !file.FillHash(cat->m_messages, domain) )
+#if wxUSE_UNICODE
+    if ( file->CanLookupInPlace() )
+    {
+        // don't convert all the strings now: GetString() will find them in
+        // the catalog data itself and convert them on first fetch
+        cat->m_file = file.release();
+        return cat.release();
+    }
+#endif // wxUSE_UNICODE
+
+    if ( !file->FillHash(cat->m_messages, domain) )
         return NULL;
 
     return cat.release();
@@ -1384,12 +1776,22 @@ wxMsgCatalog *wxMsgCatalog::CreateFromData(const wxScopedCharBuffer& data,
 {
     wxScopedPtr<wxMsgCatalog> cat(new wxMsgCatalog(domain));
 
-    wxMsgCatalogFile file;
+    wxScopedPtr<wxMsgCatalogFile> file(new wxMsgCatalogFile);
 
-    if ( !file.LoadData(data, cat->m_pluralFormsCalculator) )
+    if ( !file->LoadData(data, cat->m_pluralFormsCalculator) )
         return NULL;
 
-    if ( !file.FillHash(cat->m_messages, domain) )
+#if wxUSE_UNICODE
+    if ( file->CanLookupInPlace() )
+    {
+        // as above, defer the conversion of the strings until they are
+        // actually used (the buffer is ref-counted, so it stays alive)
+        cat->m_file = file.release();
+        return cat.release();
+    }
+#endif // wxUSE_UNICODE
+
+    if ( !file->FillHash(cat->m_messages, domain) )
         return NULL;
 
     return cat.release();
@@ -1402,28 +1804,58 @@ const wxString *wxMsgCatalog::GetString(const wxString& str, unsigned n, const w
     {
         index = m_pluralFormsCalculator->evaluate(n);
     }
-    wxStringToStringHashMap::const_iterator i;
-    if (index != 0)
-    {
-        if (context.IsEmpty())
-            i = m_messages.find(wxString(str) + wxChar(index));   // plural, no context
-        else
-            i = m_messages.find(wxString(context) + wxString('\x04') + wxString(str) + wxChar(index));   // plural, context
-    }
-    else
-    {
-        if (context.IsEmpty())
-            i = m_messages.find(str); // no context
-        else
-            i = m_messages.find(wxString(context) + wxString('\x04') + wxString(str)); // context
-    }
 
+    // the context, if any, is prepended to the string gettext-style
+    wxString key(str);
+    if ( !context.IsEmpty() )
+        key = wxString(context) + wxString('\x04') + key;
+    if ( index != 0 )
+        key += wxChar(index);   // plural
+
+    wxStringToStringHashMap::const_iterator i = m_messages.find(key);
     if ( i != m_messages.end() )
     {
         return &i->second;
     }
-    else
-        return NULL;
+
+#if wxUSE_UNICODE
+    if ( m_file )
+    {
+        // the string hadn't been fetched yet, look it up in the catalog data
+        // itself (which is in UTF-8, see CanLookupInPlace()) and cache it
+        wxString msgid(str);
+        if ( !context.IsEmpty() )
+            msgid = wxString(context) + wxString('\x04') + msgid;
+
+        size_t32 transLen = 0;
+        const char *trans = m_file->LookupString(msgid.utf8_str(), &transLen);
+
+        // find the plural form we need among the NUL-separated strings
+        for ( int m = 0; m < index && trans; m++ )
+        {
+            const size_t skip = wxStrnlen(trans, transLen);
+            if ( skip == transLen )
+            {
+                // no more forms in this translation
+                trans = NULL;
+                break;
+            }
+
+            trans += skip + 1;
+            transLen -= skip + 1;
+        }
+
+        // as in FillHash(), empty translations are not used
+        if ( trans && *trans )
+        {
+            wxString& msgstr = m_messages[key];
+            msgstr = wxString::FromUTF8(trans, wxStrnlen(trans, transLen));
+            return &msgstr;
+        }
+    }
+#endif // wxUSE_UNICODE
+
+    return NULL;
 }
 
 
@@ -1831,10 +2263,70 @@ wxString GetMsgCatalogSubdirs(const wxString& prefix, const wxString& lang)
     return searchPath;
 }
 
+// Entry of the directory scan cache below: the names of the "*.mo" files in
+// one directory and its modification time at the moment of the scan, used to
+// detect any changes to it.
+struct wxMsgCatalogDirCacheEntry
+{
+    wxMsgCatalogDirCacheEntry() : mtime((time_t)-1) { }
+
+    time_t mtime;
+    wxSortedArrayString files;
+};
+
+WX_DECLARE_STRING_HASH_MAP(wxMsgCatalogDirCacheEntry, wxMsgCatalogDirCache);
+
+// Maps a directory to the catalog files found in it the last time it was
+// scanned. Repeated catalog lookups, e.g. AddCatalog() being called once per
+// plugin for the same language, then cost one stat() per directory to
+// validate the cache instead of one per candidate file, and the directories
+// themselves are listed only once until they change.
+wxMsgCatalogDirCache gs_catalogDirCache;
+
+const wxMsgCatalogDirCacheEntry& GetCatalogsInDir(const wxString& dir)
+{
+    wxMsgCatalogDirCacheEntry& entry = gs_catalogDirCache[dir];
+
+    wxStructStat st;
+    const time_t mtime = wxStat(dir, &st) == 0 ? st.st_mtime : (time_t)-1;
+
+    // this also covers non-existent directories: they're never scanned and
+    // the (empty) entry is reused as long as they don't appear
+    if ( entry.mtime == mtime )
+        return entry;
+
+    entry.mtime = mtime;
+    entry.files.Clear();
+
+    if ( mtime == (time_t)-1 )
+        return entry;
+
+    wxDir d(dir);
+    if ( d.IsOpened() )
+    {
+        wxString name;
+        for ( bool ok = d.GetFirst(&name, wxS("*.mo"), wxDIR_FILES);
+              ok;
+              ok = d.GetNext(&name) )
+        {
+            entry.files.Add(name);
+        }
+    }
+
+    return entry;
+}
+
+bool DirContainsMsgCatalog(const wxString& dir, const wxString& domain)
+{
+    const wxMsgCatalogDirCacheEntry& entry = GetCatalogsInDir(dir);
+
+    return entry.files.Index(domain + wxS(".mo")) != wxNOT_FOUND;
+}
+
 bool HasMsgCatalogInDir(const wxString& dir, const wxString& domain)
 {
-    return wxFileName(dir, domain, "mo").FileExists() ||
-           wxFileName(dir + wxFILE_SEP_PATH + "LC_MESSAGES", domain, "mo").FileExists();
+    return DirContainsMsgCatalog(dir, domain) ||
+           DirContainsMsgCatalog(dir + wxFILE_SEP_PATH + "LC_MESSAGES", domain);
 }
 
 // get prefixes to locale directories; if lang is empty, don't point to
@@ -1934,8 +2426,20 @@ wxMsgCatalog *wxFileTranslationsLoader::LoadCatalog(const wxString& domain,
     wxFileName fn(domain);
     fn.SetExt(wxS("mo"));
 
+    // look for the catalog using the cached directory scans instead of
+    // stat()ing every candidate path
     wxString strFullName;
-    if ( !wxFindFileInPath(&strFullName, searchPath, fn.GetFullPath()) )
+    const wxArrayString dirs = wxSplit(searchPath, wxPATH_SEP[0]);
+    for ( wxArrayString::const_iterator i = dirs.begin(); i != dirs.end(); ++i )
+    {
+        if ( !i->empty() && DirContainsMsgCatalog(*i, domain) )
+        {
+            strFullName = *i + wxFILE_SEP_PATH + fn.GetFullPath();
+            break;
+        }
+    }
+
+    if ( strFullName.empty() )
         return NULL;
 
     // open file and read its data
@@ -2102,6 +2606,8 @@ public:
                 delete gs_translations;
             gs_translations = NULL;
             gs_translationsOwned = true;
+
+            gs_catalogDirCache.clear();
         }
 };
 
@@ -55,7 +55,7 @@ wxVariant::wxVariant()
 
 bool wxVariant::IsNull() const
 {
-     return (m_refData == NULL);
+     return (m_small.m_type == Small_None && m_refData == NULL);
 }
 
 void wxVariant::MakeNull()
@@ -63,6 +63,31 @@ void wxVariant::MakeNull()
     UnRef();
 }
 
+void wxVariant::Ref(const wxVariant& clone)
+{
+    // An inline value, if any, is copied directly and only heap-allocated
+    // data, if any, is shared in the usual COW manner.
+    if ( clone.m_small.m_type == Small_String )
+        m_smallString = clone.m_smallString;
+    else if ( m_small.m_type == Small_String )
+        m_smallString.clear();
+    m_small = clone.m_small;
+
+    wxObject::Ref(clone);
+}
+
+void wxVariant::UnRef()
+{
+    if ( m_small.m_type != Small_None )
+    {
+        if ( m_small.m_type == Small_String )
+            m_smallString.clear();
+        m_small.m_type = Small_None;
+    }
+
+    wxObject::UnRef();
+}
+
 void wxVariant::Clear()
 {
     m_name.clear();
@@ -118,6 +143,27 @@ bool wxVariant::operator== (const wxVariant& variant) const
     if (IsNull() || variant.IsNull())
         return (IsNull() == variant.IsNull());
 
+    // Compare two inline values directly, without materializing any
+    // wxVariantData.
+    if ( m_small.m_type != Small_None &&
+            m_small.m_type == variant.m_small.m_type )
+    {
+        switch ( m_small.m_type )
+        {
+            case Small_Bool:
+                return m_small.m_bool == variant.m_small.m_bool;
+            case Small_Long:
+                return m_small.m_long == variant.m_small.m_long;
+            case Small_Double:
+                return wxIsSameDouble(m_small.m_double,
+                                      variant.m_small.m_double);
+            case Small_String:
+                return m_smallString == variant.m_smallString;
+            case Small_None:
+                break;
+        }
+    }
+
     if (GetType() != variant.GetType())
         return false;
 
@@ -132,6 +178,25 @@ bool wxVariant::operator!= (const wxVariant& variant) const
 wxString wxVariant::MakeString() const
 {
     wxString str;
+    switch ( m_small.m_type )
+    {
+        // These formats must match those used by the Write() functions of
+        // the corresponding wxVariantData classes.
+        case Small_Bool:
+            str.Printf(wxT("%d"), (int) m_small.m_bool);
+            return str;
+        case Small_Long:
+            str.Printf(wxT("%ld"), m_small.m_long);
+            return str;
+        case Small_Double:
+            str.Printf(wxT("%.14g"), m_small.m_double);
+            return str;
+        case Small_String:
+            return m_smallString;
+        case Small_None:
+            break;
+    }
+
     if (!IsNull())
         GetData()->Write(str);
     return str;
@@ -158,6 +223,20 @@ bool wxVariant::Unshare()
 // e.g. "string", "bool", "list", "double", "long"
 wxString wxVariant::GetType() const
 {
+    switch ( m_small.m_type )
+    {
+        case Small_Bool:
+            return wxString(wxT("bool"));
+        case Small_Long:
+            return wxString(wxT("long"));
+        case Small_Double:
+            return wxString(wxT("double"));
+        case Small_String:
+            return wxString(wxT("string"));
+        case Small_None:
+            break;
+    }
+
     if (IsNull())
         return wxString(wxT("null"));
     else
@@ -208,6 +287,20 @@ wxVariant::wxVariant(const wxAny& any)
 
 wxAny wxVariant::GetAny() const
 {
+    switch ( m_small.m_type )
+    {
+        case Small_Bool:
+            return wxAny(m_small.m_bool);
+        case Small_Long:
+            return wxAny(m_small.m_long);
+        case Small_Double:
+            return wxAny(m_small.m_double);
+        case Small_String:
+            return wxAny(m_smallString);
+        case Small_None:
+            break;
+    }
+
     if ( IsNull() )
         return wxAny();
 
@@ -336,19 +429,22 @@ bool wxVariantDataLong::Read(wxString& str)
 
 wxVariant::wxVariant(long val, const wxString& name)
 {
-    m_refData = new wxVariantDataLong(val);
+    m_small.m_type = Small_Long;
+    m_small.m_long = val;
     m_name = name;
 }
 
 wxVariant::wxVariant(int val, const wxString& name)
 {
-    m_refData = new wxVariantDataLong((long)val);
+    m_small.m_type = Small_Long;
+    m_small.m_long = (long)val;
     m_name = name;
 }
 
 wxVariant::wxVariant(short val, const wxString& name)
 {
-    m_refData = new wxVariantDataLong((long)val);
+    m_small.m_type = Small_Long;
+    m_small.m_long = (long)val;
     m_name = name;
 }
 
@@ -368,7 +464,9 @@ bool wxVariant::operator!= (long value) const
 
 void wxVariant::operator= (long value)
 {
-    if (GetType() == wxT("long") &&
+    // Update materialized data in place so that pointers previously
+    // returned by GetData() remain valid.
+    if (m_refData && GetData()->GetType() == wxT("long") &&
         m_refData->GetRefCount() == 1)
     {
         ((wxVariantDataLong*)GetData())->SetValue(value);
@@ -376,7 +474,8 @@ void wxVariant::operator= (long value)
     else
     {
         UnRef();
-        m_refData = new wxVariantDataLong(value);
+        m_small.m_type = Small_Long;
+        m_small.m_long = value;
     }
 }
 
@@ -488,7 +587,8 @@ bool wxVariantDoubleData::Read(wxString& str)
 
 wxVariant::wxVariant(double val, const wxString& name)
 {
-    m_refData = new wxVariantDoubleData(val);
+    m_small.m_type = Small_Double;
+    m_small.m_double = val;
     m_name = name;
 }
 
@@ -508,7 +608,7 @@ bool wxVariant::operator!= (double value) const
 
 void wxVariant::operator= (double value)
 {
-    if (GetType() == wxT("double") &&
+    if (m_refData && GetData()->GetType() == wxT("double") &&
         m_refData->GetRefCount() == 1)
     {
         ((wxVariantDoubleData*)GetData())->SetValue(value);
@@ -516,7 +616,8 @@ void wxVariant::operator= (double value)
     else
     {
         UnRef();
-        m_refData = new wxVariantDoubleData(value);
+        m_small.m_type = Small_Double;
+        m_small.m_double = value;
     }
 }
 
@@ -631,7 +732,8 @@ bool wxVariantDataBool::Read(wxString& str)
 
 wxVariant::wxVariant(bool val, const wxString& name)
 {
-    m_refData = new wxVariantDataBool(val);
+    m_small.m_type = Small_Bool;
+    m_small.m_bool = val;
     m_name = name;
 }
 
@@ -651,7 +753,7 @@ bool wxVariant::operator!= (bool value) const
 
 void wxVariant::operator= (bool value)
 {
-    if (GetType() == wxT("bool") &&
+    if (m_refData && GetData()->GetType() == wxT("bool") &&
         m_refData->GetRefCount() == 1)
     {
         ((wxVariantDataBool*)GetData())->SetValue(value);
@@ -659,7 +761,8 @@ void wxVariant::operator= (bool value)
     else
     {
         UnRef();
-        m_refData = new wxVariantDataBool(value);
+        m_small.m_type = Small_Bool;
+        m_small.m_bool = value;
     }
 }
 
@@ -931,54 +1034,91 @@ bool wxVariantDataString::Read(wxString& str)
     return true;
 }
 
+// Create the wxVariantData corresponding to the value stored inline in the
+// variant itself: this is only done on demand, when somebody actually asks
+// for the data object, see GetData().
+void wxVariant::MaterializeSmallData()
+{
+    wxVariantData* data = NULL;
+    switch ( m_small.m_type )
+    {
+        case Small_Bool:
+            data = new wxVariantDataBool(m_small.m_bool);
+            break;
+        case Small_Long:
+            data = new wxVariantDataLong(m_small.m_long);
+            break;
+        case Small_Double:
+            data = new wxVariantDoubleData(m_small.m_double);
+            break;
+        case Small_String:
+            data = new wxVariantDataString(m_smallString);
+            m_smallString.clear();
+            break;
+        case Small_None:
+            return;
+    }
+
+    m_small.m_type = Small_None;
+    m_refData = data;
+}
+
 // wxVariant ****
 
 wxVariant::wxVariant(const wxString& val, const wxString& name)
 {
-    m_refData = new wxVariantDataString(val);
+    m_small.m_type = Small_String;
+    m_smallString = val;
     m_name = name;
 }
 
 wxVariant::wxVariant(const char* val, const wxString& name)
 {
-    m_refData = new wxVariantDataString(wxString(val));
+    m_small.m_type = Small_String;
+    m_smallString = wxString(val);
     m_name = name;
 }
 
 wxVariant::wxVariant(const wchar_t* val, const wxString& name)
 {
-    m_refData = new wxVariantDataString(wxString(val));
+    m_small.m_type = Small_String;
+    m_smallString = wxString(val);
     m_name = name;
 }
 
 wxVariant::wxVariant(const wxCStrData& val, const wxString& name)
 {
-    m_refData = new wxVariantDataString(val.AsString());
+    m_small.m_type = Small_String;
+    m_smallString = val.AsString();
     m_name = name;
 }
 
 wxVariant::wxVariant(const wxScopedCharBuffer& val, const wxString& name)
 {
-    m_refData = new wxVariantDataString(wxString(val));
+    m_small.m_type = Small_String;
+    m_smallString = wxString(val);
     m_name = name;
 }
 
 wxVariant::wxVariant(const wxScopedWCharBuffer& val, const wxString& name)
 {
-    m_refData = new wxVariantDataString(wxString(val));
+    m_small.m_type = Small_String;
+    m_smallString = wxString(val);
     m_name = name;
 }
 
 #if wxUSE_STD_STRING
 wxVariant::wxVariant(const std::string& val, const wxString& name)
 {
-    m_refData = new wxVariantDataString(wxString(val));
+    m_small.m_type = Small_String;
+    m_smallString = wxString(val);
     m_name = name;
 }
 
 wxVariant::wxVariant(const wxStdWideString& val, const wxString& name)
 {
-    m_refData = new wxVariantDataString(wxString(val));
+    m_small.m_type = Small_String;
+    m_smallString = wxString(val);
     m_name = name;
 }
 #endif // wxUSE_STD_STRING
@@ -999,15 +1139,20 @@ bool wxVariant::operator!= (const wxString& value) const
 
 wxVariant& wxVariant::operator= (const wxString& value)
 {
-    if (GetType() == wxT("string") &&
+    if (m_refData && GetData()->GetType() == wxT("string") &&
         m_refData->GetRefCount() == 1)
     {
         ((wxVariantDataString*)GetData())->SetValue(value);
     }
+    else if (m_small.m_type == Small_String)
+    {
+        m_smallString = value;
+    }
     else
     {
         UnRef();
-        m_refData = new wxVariantDataString(value);
+        m_small.m_type = Small_String;
+        m_smallString = value;
     }
     return *this;
 }
@@ -2247,6 +2392,24 @@ size_t wxVariant::GetCount() const
 
 bool wxVariant::Convert(long* value) const
 {
+    switch ( m_small.m_type )
+    {
+        case Small_Long:
+            *value = m_small.m_long;
+            return true;
+        case Small_Bool:
+            *value = (long) m_small.m_bool;
+            return true;
+        case Small_Double:
+            *value = (long) m_small.m_double;
+            return true;
+        case Small_String:
+            *value = wxAtol(m_smallString);
+            return true;
+        case Small_None:
+            break;
+    }
+
     wxString type(GetType());
     if (type == wxS("double"))
         *value = (long) (((wxVariantDoubleData*)GetData())->GetValue());
@@ -2282,6 +2445,22 @@ bool wxVariant::Convert(long* value) const
 
 bool wxVariant::Convert(bool* value) const
 {
+    switch ( m_small.m_type )
+    {
+        case Small_Bool:
+            *value = m_small.m_bool;
+            return true;
+        case Small_Long:
+            *value = (m_small.m_long != 0);
+            return true;
+        case Small_Double:
+            *value = ((int) m_small.m_double != 0);
+            return true;
+        case Small_String:
+        case Small_None:
+            break;
+    }
+
     wxString type(GetType());
     if (type == wxT("double"))
         *value = ((int) (((wxVariantDoubleData*)GetData())->GetValue()) != 0);
@@ -2291,7 +2470,9 @@ bool wxVariant::Convert(bool* value) const
         *value = ((wxVariantDataBool*)GetData())->GetValue();
     else if (type == wxT("string"))
     {
-        wxString val(((wxVariantDataString*)GetData())->GetValue());
+        wxString val(m_small.m_type == Small_String
+                        ? m_smallString
+                        : ((wxVariantDataString*)GetData())->GetValue());
         val.MakeLower();
         if (val == wxT("true") || val == wxT("yes") || val == wxT('1') )
             *value = true;
@@ -2308,6 +2489,24 @@ bool wxVariant::Convert(bool* value) const
 
 bool wxVariant::Convert(double* value) const
 {
+    switch ( m_small.m_type )
+    {
+        case Small_Double:
+            *value = m_small.m_double;
+            return true;
+        case Small_Long:
+            *value = (double) m_small.m_long;
+            return true;
+        case Small_Bool:
+            *value = (double) m_small.m_bool;
+            return true;
+        case Small_String:
+            *value = (double) wxAtof(m_smallString);
+            return true;
+        case Small_None:
+            break;
+    }
+
     wxString type(GetType());
     if (type == wxT("double"))
         *value = ((wxVariantDoubleData*)GetData())->GetValue();
@@ -2335,6 +2534,25 @@ bool wxVariant::Convert(double* value) const
 
 bool wxVariant::Convert(wxUniChar* value) const
 {
+    switch ( m_small.m_type )
+    {
+        case Small_Long:
+            *value = (char) m_small.m_long;
+            return true;
+        case Small_Bool:
+            *value = (char) m_small.m_bool;
+            return true;
+        case Small_String:
+            // Also accept strings of length 1
+            if ( m_smallString.length() != 1 )
+                return false;
+            *value = m_smallString[0];
+            return true;
+        case Small_Double:
+        case Small_None:
+            break;
+    }
+
     wxString type(GetType());
     if (type == wxT("char"))
         *value = ((wxVariantDataChar*)GetData())->GetValue();
@@ -2384,6 +2602,36 @@ bool wxVariant::Convert(wxString* value) const
 #if wxUSE_LONGLONG
 bool wxVariant::Convert(wxLongLong* value) const
 {
+    switch ( m_small.m_type )
+    {
+        case Small_Long:
+            *value = m_small.m_long;
+            return true;
+        case Small_Bool:
+            *value = (long) m_small.m_bool;
+            return true;
+        case Small_Double:
+            value->Assign(m_small.m_double);
+            return true;
+        case Small_String:
+        {
+#ifdef wxLongLong_t
+            wxLongLong_t value_t;
+            if ( !m_smallString.ToLongLong(&value_t) )
+                return false;
+            *value = value_t;
+#else
+            long l_value;
+            if ( !m_smallString.ToLong(&l_value) )
+                return false;
+            *value = l_value;
+#endif
+            return true;
+        }
+        case Small_None:
+            break;
+    }
+
     wxString type(GetType());
     if (type == wxS("longlong"))
         *value = ((wxVariantDataLongLong*)GetData())->GetValue();
@@ -2420,6 +2668,47 @@ bool wxVariant::Convert(wxLongLong* value) const
 
 bool wxVariant::Convert(wxULongLong* value) const
 {
+    switch ( m_small.m_type )
+    {
+        case Small_Long:
+            *value = m_small.m_long;
+            return true;
+        case Small_Bool:
+            *value = (long) m_small.m_bool;
+            return true;
+        case Small_Double:
+        {
+            if ( m_small.m_double < 0.0 )
+                return false;
+
+#ifdef wxLongLong_t
+            *value = (wxULongLong_t) m_small.m_double;
+#else
+            wxLongLong temp;
+            temp.Assign(m_small.m_double);
+            *value = temp;
+#endif
+            return true;
+        }
+        case Small_String:
+        {
+#ifdef wxLongLong_t
+            wxULongLong_t value_t;
+            if ( !m_smallString.ToULongLong(&value_t) )
+                return false;
+            *value = value_t;
+#else
+            unsigned long l_value;
+            if ( !m_smallString.ToULong(&l_value) )
+                return false;
+            *value = l_value;
+#endif
+            return true;
+        }
+        case Small_None:
+            break;
+    }
+
     wxString type(GetType());
     if (type == wxS("ulonglong"))
         *value = ((wxVariantDataULongLong*)GetData())->GetValue();
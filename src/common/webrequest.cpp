@@ -149,6 +149,19 @@ wxWebRequestImpl::SetData(wxScopedPtr<wxInputStream>& dataStream,
     return true;
 }
 
+bool wxWebRequestImpl::SetSink(wxOutputStream* sink)
+{
+    // Take ownership of the sink in any case to avoid leaking it.
+    m_sink.reset(sink);
+
+    wxCHECK_MSG( sink, false, "can't use NULL sink stream" );
+    wxCHECK_MSG( sink->IsOk(), false, "can't use invalid sink stream" );
+
+    m_storage = wxWebRequest::Storage_Sink;
+
+    return true;
+}
+
 wxFileOffset wxWebRequestImpl::GetBytesReceived() const
 {
     return m_bytesReceived;
@@ -466,6 +479,16 @@ wxWebRequest::Storage wxWebRequest::GetStorage() const
     return m_impl->GetStorage();
 }
 
+bool wxWebRequest::SetSink(wxOutputStream* sink)
+{
+    // Ensure that the stream is destroyed even if we return below.
+    wxScopedPtr<wxOutputStream> sinkPtr(sink);
+
+    wxCHECK_IMPL( false );
+
+    return m_impl->SetSink(sinkPtr.release());
+}
+
 void wxWebRequest::Start()
 {
     wxCHECK_IMPL_VOID();
@@ -486,6 +509,26 @@ void wxWebRequest::Cancel()
     m_impl->Cancel();
 }
 
+bool wxWebRequest::Pause()
+{
+    wxCHECK_IMPL( false );
+
+    wxCHECK_MSG( m_impl->GetState() == wxWebRequest::State_Active, false,
+                 "Only active requests can be paused" );
+
+    return m_impl->Pause();
+}
+
+bool wxWebRequest::Resume()
+{
+    wxCHECK_IMPL( false );
+
+    wxCHECK_MSG( m_impl->GetState() == wxWebRequest::State_Active, false,
+                 "Only active requests can be resumed" );
+
+    return m_impl->Resume();
+}
+
 wxWebResponse wxWebRequest::GetResponse() const
 {
     wxCHECK_IMPL( wxWebResponse() );
@@ -669,6 +712,7 @@ wxInputStream * wxWebResponseImpl::GetStream() const
                 m_stream->SeekI(0);
                 break;
             case wxWebRequest::Storage_None:
+            case wxWebRequest::Storage_Sink:
                 // No stream available
                 break;
         }
@@ -746,6 +790,18 @@ void wxWebResponseImpl::ReportDataReceived(size_t sizeReceived)
             m_readBuffer.Clear();
             break;
 
+        case wxWebRequest::Storage_Sink:
+            // This is only used by the backends not passing the data to the
+            // sink directly via SinkData(): forward it now, with an extra
+            // copy through our buffer.
+            {
+                wxOutputStream* const sink = m_request.GetSink();
+                if ( sink )
+                    sink->Write(m_readBuffer.GetData(), m_readBuffer.GetDataLen());
+            }
+            m_readBuffer.Clear();
+            break;
+
         case wxWebRequest::Storage_None:
             wxWebRequestEvent* const evt = new wxWebRequestEvent
                                                (
@@ -765,6 +821,21 @@ void wxWebResponseImpl::ReportDataReceived(size_t sizeReceived)
     }
 }
 
+bool wxWebResponseImpl::SinkData(const void* buffer, size_t size)
+{
+    wxOutputStream* const sink = m_request.GetSink();
+
+    wxCHECK_MSG( sink, false, "no sink stream to write to" );
+
+    sink->Write(buffer, size);
+    if ( sink->LastWrite() != size )
+        return false;
+
+    m_request.ReportDataReceived(size);
+
+    return true;
+}
+
 wxString wxWebResponseImpl::GetDataFile() const
 {
     return m_file.GetName();
@@ -772,8 +843,22 @@ wxString wxWebResponseImpl::GetDataFile() const
 
 void wxWebResponseImpl::Finalize()
 {
-    if ( m_request.GetStorage() == wxWebRequest::Storage_File )
-        m_file.Close();
+    switch ( m_request.GetStorage() )
+    {
+        case wxWebRequest::Storage_File:
+            m_file.Close();
+            break;
+
+        case wxWebRequest::Storage_Sink:
+            // Flush anything buffered by the sink stream itself.
+            if ( m_request.GetSink() )
+                m_request.GetSink()->Close();
+            break;
+
+        case wxWebRequest::Storage_Memory:
+        case wxWebRequest::Storage_None:
+            break;
+    }
 }
 
 //
@@ -890,6 +975,11 @@ wxStringWebSessionFactoryMap gs_factoryMap;
 } // anonymous namespace
 
 wxWebSessionImpl::wxWebSessionImpl()
+    : m_maxConnections(0),
+      m_maxConnectionsPerHost(0),
+      m_keepAliveIdle(0),
+      m_keepAliveInterval(0),
+      m_enableHTTP2(false)
 {
     // Initialize the user-Agent header with a reasonable default
     AddCommonHeader("User-Agent", wxString::Format("%s/1 wxWidgets/%d.%d.%d",
@@ -1051,6 +1141,27 @@ wxString wxWebSession::GetTempDir() const
     return m_impl->GetTempDir();
 }
 
+void wxWebSession::SetMaxConnections(int maxTotal, int maxPerHost)
+{
+    wxCHECK_IMPL_VOID();
+
+    m_impl->SetMaxConnections(maxTotal, maxPerHost);
+}
+
+void wxWebSession::SetKeepAliveTimes(int idleSeconds, int intervalSeconds)
+{
+    wxCHECK_IMPL_VOID();
+
+    m_impl->SetKeepAliveTimes(idleSeconds, intervalSeconds);
+}
+
+void wxWebSession::EnableHTTP2(bool enable)
+{
+    wxCHECK_IMPL_VOID();
+
+    m_impl->EnableHTTP2(enable);
+}
+
 bool wxWebSession::IsOpened() const
 {
     return m_impl.get() != NULL;
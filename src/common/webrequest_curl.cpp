@@ -119,6 +119,14 @@ wxWebResponseCURL::wxWebResponseCURL(wxWebRequestCURL& request) :
 
 size_t wxWebResponseCURL::CURLOnWrite(void* buffer, size_t size)
 {
+    if ( m_request.GetStorage() == wxWebRequest::Storage_Sink )
+    {
+        // Hand the libcurl transfer buffer directly to the sink stream,
+        // without copying it anywhere: returning anything other than the
+        // full size makes libcurl abort the transfer with a write error.
+        return SinkData(buffer, size) ? size : 0;
+    }
+
     void* buf = GetDataBuffer(size);
     memcpy(buf, buffer, size);
     ReportDataReceived(size);
@@ -257,6 +265,42 @@ wxWebRequestCURL::wxWebRequestCURL(wxWebSession & session,
     // Enable all supported authentication methods
     curl_easy_setopt(m_handle, CURLOPT_HTTPAUTH, CURLAUTH_ANY);
     curl_easy_setopt(m_handle, CURLOPT_PROXYAUTH, CURLAUTH_ANY);
+
+#if CURL_AT_LEAST_VERSION(7, 25, 0)
+    // Use TCP keep-alives to prevent the pooled connections from being
+    // silently dropped, if the session was configured to do it.
+    if ( (sessionImpl.GetKeepAliveIdle() > 0 ||
+            sessionImpl.GetKeepAliveInterval() > 0) &&
+                wxWebSessionCURL::CurlRuntimeAtLeastVersion(7, 25, 0) )
+    {
+        curl_easy_setopt(m_handle, CURLOPT_TCP_KEEPALIVE, 1L);
+
+        if ( sessionImpl.GetKeepAliveIdle() > 0 )
+        {
+            curl_easy_setopt(m_handle, CURLOPT_TCP_KEEPIDLE,
+                             static_cast<long>(sessionImpl.GetKeepAliveIdle()));
+        }
+
+        if ( sessionImpl.GetKeepAliveInterval() > 0 )
+        {
+            curl_easy_setopt(m_handle, CURLOPT_TCP_KEEPINTVL,
+                             static_cast<long>(sessionImpl.GetKeepAliveInterval()));
+        }
+    }
+#endif // curl >= 7.25
+
+#if CURL_AT_LEAST_VERSION(7, 47, 0)
+    if ( sessionImpl.IsHTTP2Enabled() &&
+            wxWebSessionCURL::CurlRuntimeAtLeastVersion(7, 47, 0) )
+    {
+        // Negotiate HTTP/2 when using TLS (plain HTTP keeps using HTTP/1.1)
+        // and prefer waiting for an existing connection to become available
+        // for multiplexing to opening a new one.
+        curl_easy_setopt(m_handle, CURLOPT_HTTP_VERSION,
+                         CURL_HTTP_VERSION_2TLS);
+        curl_easy_setopt(m_handle, CURLOPT_PIPEWAIT, 1L);
+    }
+#endif // curl >= 7.47
 }
 
 wxWebRequestCURL::~wxWebRequestCURL()
@@ -317,6 +361,20 @@ void wxWebRequestCURL::Start()
     StartRequest();
 }
 
+bool wxWebRequestCURL::Pause()
+{
+    // Pausing is used for backpressure: it makes libcurl stop reading from
+    // the socket, so that the server eventually stops sending once the TCP
+    // (or HTTP/2 flow control) window fills up. It is explicitly allowed to
+    // call curl_easy_pause() from inside the transfer callbacks.
+    return curl_easy_pause(m_handle, CURLPAUSE_ALL) == CURLE_OK;
+}
+
+bool wxWebRequestCURL::Resume()
+{
+    return m_sessionImpl.ResumeRequest(*this);
+}
+
 bool wxWebRequestCURL::StartRequest()
 {
     m_bytesSent = 0;
@@ -933,6 +991,43 @@ wxWebSessionCURL::CreateRequest(wxWebSession& session,
             curl_multi_setopt(m_handle, CURLMOPT_SOCKETFUNCTION, SocketCallback);
             curl_multi_setopt(m_handle, CURLMOPT_TIMERDATA, this);
             curl_multi_setopt(m_handle, CURLMOPT_TIMERFUNCTION, TimerCallback);
+
+            // Apply the connection pool configuration set at the session
+            // level, if any, see the wxWebSession methods of the same names.
+            if ( GetMaxConnections() > 0 )
+            {
+                // This determines how many connections are kept alive in the
+                // cache for later reuse.
+                curl_multi_setopt(m_handle, CURLMOPT_MAXCONNECTS,
+                                  static_cast<long>(GetMaxConnections()));
+            }
+
+#if CURL_AT_LEAST_VERSION(7, 30, 0)
+            if ( CurlRuntimeAtLeastVersion(7, 30, 0) )
+            {
+                if ( GetMaxConnections() > 0 )
+                {
+                    curl_multi_setopt(m_handle, CURLMOPT_MAX_TOTAL_CONNECTIONS,
+                                      static_cast<long>(GetMaxConnections()));
+                }
+
+                if ( GetMaxConnectionsPerHost() > 0 )
+                {
+                    curl_multi_setopt(m_handle, CURLMOPT_MAX_HOST_CONNECTIONS,
+                                      static_cast<long>(GetMaxConnectionsPerHost()));
+                }
+            }
+#endif // curl >= 7.30
+
+#if CURL_AT_LEAST_VERSION(7, 43, 0)
+            // Allow multiplexing concurrent requests over a single HTTP/2
+            // connection instead of opening one connection per request.
+            if ( IsHTTP2Enabled() && CurlRuntimeAtLeastVersion(7, 43, 0) )
+            {
+                curl_multi_setopt(m_handle, CURLMOPT_PIPELINING,
+                                  CURLPIPE_MULTIPLEX);
+            }
+#endif // curl >= 7.43
         }
     }
 
@@ -963,6 +1058,20 @@ bool wxWebSessionCURL::StartRequest(wxWebRequestCURL & request)
     }
 }
 
+bool wxWebSessionCURL::ResumeRequest(wxWebRequestCURL& request)
+{
+    if ( curl_easy_pause(request.GetHandle(), CURLPAUSE_CONT) != CURLE_OK )
+        return false;
+
+    // Unpausing may have to deliver the data buffered by libcurl while the
+    // transfer was paused, which won't happen without prodding the multi
+    // handle. Don't call curl_multi_socket_action() here directly as we may
+    // be called from inside a libcurl callback, where doing this is invalid.
+    CallAfter(&wxWebSessionCURL::ProcessTimeoutNotification);
+
+    return true;
+}
+
 void wxWebSessionCURL::CancelRequest(wxWebRequestCURL* request)
 {
     // If this transfer is currently active, stop it.
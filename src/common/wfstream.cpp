@@ -22,12 +22,35 @@
 
 #include <stdio.h>
 
+#ifdef __UNIX__
+    #include <fcntl.h>
+#endif
+
 #if wxUSE_FILE
 
 // ----------------------------------------------------------------------------
 // wxFileInputStream
 // ----------------------------------------------------------------------------
 
+namespace
+{
+
+// tell the OS that the file is going to be read sequentially, which is the
+// typical access pattern for the files opened by wxFileInputStream: this
+// makes the kernel read ahead more aggressively, it's only a hint and random
+// access still works as usual
+void AdviseSequentialAccess(wxFile& file)
+{
+#ifdef POSIX_FADV_SEQUENTIAL
+    if ( file.IsOpened() )
+        posix_fadvise(file.fd(), 0, 0, POSIX_FADV_SEQUENTIAL);
+#else
+    wxUnusedVar(file);
+#endif
+}
+
+} // anonymous namespace
+
 wxFileInputStream::wxFileInputStream(const wxString& fileName)
   : wxInputStream()
 {
@@ -35,6 +58,8 @@ wxFileInputStream::wxFileInputStream(const wxString& fileName)
     m_file_destroy = true;
     if ( !m_file->IsOpened() )
         m_lasterror = wxSTREAM_READ_ERROR;
+
+    AdviseSequentialAccess(*m_file);
 }
 
 wxFileInputStream::wxFileInputStream()
@@ -71,12 +71,23 @@
     #include "wx/sysopt.h"
 #endif
 
+#if wxUSE_TIMER
+    #include "wx/timer.h"
+    #include "wx/time.h"
+#endif // wxUSE_TIMER
+
+#include "wx/hashmap.h"
+
 #include "wx/display.h"
 #include "wx/platinfo.h"
 #include "wx/recguard.h"
 #include "wx/private/rescale.h"
 #include "wx/private/window.h"
 
+// trace mask for the best size computations: counting the messages logged
+// with it per window is a simple way of finding layout hot spots
+#define TRACE_BESTSIZE wxT("bestsize")
+
 // Windows List
 WXDLLIMPEXP_DATA_CORE(wxWindowList) wxTopLevelWindows;
 
@@ -99,6 +110,7 @@ bool IsInCaptureStack(wxWindowBase* win);
 // static data
 // ----------------------------------------------------------------------------
 
+wxWindowList wxWindowBase::ms_idleWindows;
 
 wxIMPLEMENT_ABSTRACT_CLASS(wxWindowBase, wxEvtHandler);
 
@@ -309,6 +321,8 @@ wxWindowBase::wxWindowBase()
     m_windowSizer = NULL;
     m_containingSizer = NULL;
     m_autoLayout = false;
+    m_layoutDirty = false;
+    m_deferLayoutCount = 0;
 
     m_disableFocusFromKbd = false;
 
@@ -351,6 +365,12 @@ wxWindowBase::wxWindowBase()
     m_isBeingDeleted = false;
 
     m_freezeCount = 0;
+
+#if wxUSE_TIMER
+    m_refreshScheduler = NULL;
+#endif // wxUSE_TIMER
+
+    m_childLookupIndex = NULL;
 }
 
 // common part of window creation process
@@ -438,6 +458,21 @@ bool wxWindowBase::ToggleWindowStyle(int flag)
     return rc;
 }
 
+void wxWindowBase::SetExtraStyle(long exStyle)
+{
+    // Keep the list of windows subscribed to idle events in sync with the
+    // wxWS_EX_PROCESS_IDLE bit.
+    if ( (exStyle ^ m_exStyle) & wxWS_EX_PROCESS_IDLE )
+    {
+        if ( exStyle & wxWS_EX_PROCESS_IDLE )
+            ms_idleWindows.Append((wxWindow *)this);
+        else
+            ms_idleWindows.DeleteObject((wxWindow *)this);
+    }
+
+    m_exStyle = exStyle;
+}
+
 // ----------------------------------------------------------------------------
 // destruction
 // ----------------------------------------------------------------------------
@@ -460,6 +495,11 @@ wxWindowBase::~wxWindowBase()
     // we weren't a dialog class
     wxTopLevelWindows.DeleteObject(this);
 
+    // Remove this window from the list of idle event subscribers if it had
+    // asked for idle events.
+    if ( HasExtraStyle(wxWS_EX_PROCESS_IDLE) )
+        ms_idleWindows.DeleteObject((wxWindow *)this);
+
     // Any additional event handlers should be popped before the window is
     // deleted as otherwise the last handler will be left with a dangling
     // pointer to this window result in a difficult to diagnose crash later on.
@@ -483,6 +523,13 @@ wxWindowBase::~wxWindowBase()
     delete m_caret;
 #endif // wxUSE_CARET
 
+#if wxUSE_TIMER
+    // this also stops its timer if it is running
+    delete m_refreshScheduler;
+#endif // wxUSE_TIMER
+
+    delete m_childLookupIndex;
+
 #if wxUSE_VALIDATORS
     delete m_windowValidator;
 #endif // wxUSE_VALIDATORS
@@ -652,8 +699,23 @@ static bool wxHasRealChildren(const wxWindowBase* win)
 
 void wxWindowBase::InvalidateBestSize()
 {
+    // if our cached size is already invalid, the containing sizer and the
+    // ancestors were invalidated together with it and, as any size
+    // computation depending on ours would have refilled our cache (see
+    // GetBestSize()), nothing could have cached a value depending on us since
+    // then: don't walk up the entire ancestor chain again, this function is
+    // called very liberally and doing it made repeated invalidations
+    // quadratic in the depth of the window hierarchy
+    if ( m_bestSizeCache == wxDefaultSize )
+        return;
+
     m_bestSizeCache = wxDefaultSize;
 
+    // the min size of the sizer containing this window depends on its best
+    // size, so its cached value can't be used any more either
+    if ( m_containingSizer )
+        m_containingSizer->InvalidateCachedMinSize();
+
     // parent's best size calculation may depend on its children's
     // as long as child window we are in is not top level window itself
     // (because the TLW size is never resized automatically)
@@ -897,6 +959,11 @@ wxSize wxWindowBase::GetBestSize() const
     if ( !m_windowSizer && m_bestSizeCache.IsFullySpecified() )
         return m_bestSizeCache;
 
+    wxLogTrace(TRACE_BESTSIZE, wxT("Recomputing best size of %s(%p, \"%s\")"),
+               GetClassInfo()->GetClassName(),
+               static_cast<const void*>(this),
+               GetName());
+
     // call DoGetBestClientSize() first, if a derived class overrides it wants
     // it to be used
     wxSize size = DoGetBestClientSize();
@@ -1160,6 +1227,11 @@ bool wxWindowBase::Show(bool show)
     {
         m_isShown = show;
 
+        // hidden windows are normally not taken into account by the sizer
+        // containing them, so its cached min size is not valid any more
+        if ( m_containingSizer )
+            m_containingSizer->InvalidateCachedMinSize();
+
         return true;
     }
     else
@@ -1295,6 +1367,136 @@ void wxWindowBase::Thaw()
     }
 }
 
+// ----------------------------------------------------------------------------
+// refresh rate limiting
+// ----------------------------------------------------------------------------
+
+#if wxUSE_TIMER
+
+// object implementing SetRefreshRateLimit(): it accumulates the damage from
+// the Refresh() calls arriving faster than the rate limit allows and flushes
+// it to the native layer when its timer fires
+class wxWindowRefreshScheduler : public wxTimer
+{
+public:
+    explicit wxWindowRefreshScheduler(wxWindowBase *win)
+        : m_win(win)
+    {
+        rateLimit = 0;
+        full = false;
+        erase = false;
+        flushing = false;
+        numCoalesced = 0;
+    }
+
+    virtual void Notify() wxOVERRIDE
+    {
+        m_win->FlushPendingRefresh();
+    }
+
+    int rateLimit;              // minimal interval between refreshes (ms)
+    wxLongLong timeLastFlush;   // time of the last native refresh
+    wxRegion pendingRegion;     // the damage accumulated since then
+    bool full;                  // refresh the whole window?
+    bool erase;                 // erase the background when refreshing?
+    bool flushing;              // true while inside FlushPendingRefresh()
+    unsigned int numCoalesced;  // total number of deferred Refresh() calls
+
+private:
+    wxWindowBase * const m_win;
+
+    wxDECLARE_NO_COPY_CLASS(wxWindowRefreshScheduler);
+};
+
+void wxWindowBase::SetRefreshRateLimit(int milliseconds)
+{
+    wxCHECK_RET( milliseconds >= 0, wxS("refresh rate limit can't be negative") );
+
+    if ( !m_refreshScheduler )
+    {
+        if ( !milliseconds )
+            return;
+
+        m_refreshScheduler = new wxWindowRefreshScheduler(this);
+    }
+
+    m_refreshScheduler->rateLimit = milliseconds;
+
+    // don't let any already accumulated damage wait for the old, possibly
+    // much longer, interval to elapse
+    if ( !milliseconds && m_refreshScheduler->IsRunning() )
+    {
+        m_refreshScheduler->Stop();
+        FlushPendingRefresh();
+    }
+}
+
+int wxWindowBase::GetRefreshRateLimit() const
+{
+    return m_refreshScheduler ? m_refreshScheduler->rateLimit : 0;
+}
+
+unsigned int wxWindowBase::GetCoalescedRefreshCount() const
+{
+    return m_refreshScheduler ? m_refreshScheduler->numCoalesced : 0;
+}
+
+bool wxWindowBase::QueueThrottledRefresh(bool eraseBackground, const wxRect *rect)
+{
+    wxWindowRefreshScheduler * const sched = m_refreshScheduler;
+    if ( !sched || !sched->rateLimit || sched->flushing )
+        return false;
+
+    const wxLongLong now = wxGetUTCTimeMillis();
+    const wxLongLong elapsed = now - sched->timeLastFlush;
+    if ( !sched->IsRunning() && elapsed >= sched->rateLimit )
+    {
+        // this is the first refresh in this frame interval, let it through
+        sched->timeLastFlush = now;
+        return false;
+    }
+
+    // defer it: just accumulate the damage and do a single native refresh
+    // when the rest of the interval elapses
+    if ( rect )
+        sched->pendingRegion.Union(*rect);
+    else
+        sched->full = true;
+
+    if ( eraseBackground )
+        sched->erase = true;
+
+    sched->numCoalesced++;
+
+    if ( !sched->IsRunning() )
+        sched->StartOnce(sched->rateLimit - elapsed.ToLong());
+
+    return true;
+}
+
+void wxWindowBase::FlushPendingRefresh()
+{
+    wxWindowRefreshScheduler * const sched = m_refreshScheduler;
+    if ( !sched || (!sched->full && sched->pendingRegion.IsEmpty()) )
+        return;
+
+    const bool full = sched->full;
+    const bool erase = sched->erase;
+    const wxRect box = sched->pendingRegion.GetBox();
+
+    sched->full = false;
+    sched->erase = false;
+    sched->pendingRegion.Clear();
+    sched->timeLastFlush = wxGetUTCTimeMillis();
+
+    // prevent the call below from being deferred in its turn
+    sched->flushing = true;
+    Refresh(erase, full ? NULL : &box);
+    sched->flushing = false;
+}
+
+#endif // wxUSE_TIMER
+
 // ----------------------------------------------------------------------------
 // Dealing with parents and children.
 // ----------------------------------------------------------------------------
@@ -1333,6 +1535,15 @@ void wxWindowBase::AddChild(wxWindowBase *child)
     // it had been already present when we were frozen
     if ( IsFrozen() && !child->IsTopLevel() )
         child->Freeze();
+
+    // similarly defer its layout if ours is currently deferred so that
+    // creating many children between BeginDeferLayout() and EndDeferLayout()
+    // results in a single layout pass
+    if ( IsLayoutDeferred() && !child->IsTopLevel() )
+        child->BeginDeferLayout();
+
+    // the lookup indexes covering us don't know about the new child yet
+    InvalidateChildLookupIndex();
 }
 
 void wxWindowBase::RemoveChild(wxWindowBase *child)
@@ -1347,8 +1558,15 @@ void wxWindowBase::RemoveChild(wxWindowBase *child)
     if ( IsFrozen() && !child->IsBeingDeleted() && !child->IsTopLevel() )
         child->Thaw();
 
+    // and balance the BeginDeferLayout() done when it was added
+    if ( IsLayoutDeferred() && !child->IsBeingDeleted() && !child->IsTopLevel() )
+        child->EndDeferLayout();
+
     GetChildren().DeleteObject((wxWindow *)child);
     child->SetParent(NULL);
+
+    // the lookup indexes covering us may still refer to the removed child
+    InvalidateChildLookupIndex();
 }
 
 void wxWindowBase::SetParent(wxWindowBase *parent)
@@ -1841,11 +2059,196 @@ void wxWindowBase::ClearBackground()
 // find child window by id or name
 // ----------------------------------------------------------------------------
 
+WX_DECLARE_HASH_MAP(long, wxWindow*,
+                    wxIntegerHash, wxIntegerEqual, wxWindowIdIndexMap);
+WX_DECLARE_STRING_HASH_MAP(wxWindow*, wxWindowNameIndexMap);
+
+// hash index created by EnableChildLookupIndex() and used by FindWindow() to
+// avoid walking the children tree on every call: it maps the ids and names of
+// all the windows below its root to the windows themselves, a NULL value
+// meaning that the key is ambiguous, i.e. used by more than one window
+class wxWindowLookupIndex
+{
+public:
+    wxWindowLookupIndex() { m_valid = false; }
+
+    // must be called whenever anything the index depends on changes, it will
+    // be lazily rebuilt by the next lookup
+    void Invalidate() { m_valid = false; }
+
+    // rebuild the index from the given root if it had been invalidated
+    void Update(const wxWindowBase *root)
+    {
+        if ( m_valid )
+            return;
+
+        m_ids.clear();
+        m_names.clear();
+        Add(root);
+        m_valid = true;
+    }
+
+    // return true if the index gives a definitive answer for this key:
+    // either the only window using it (which may still lie outside of the
+    // subtree the caller is interested in) or NULL if no window does; return
+    // false if the key is ambiguous and the caller must fall back to walking
+    // the tree itself
+    bool FindById(long id, wxWindow **win) const
+    {
+        const wxWindowIdIndexMap::const_iterator it = m_ids.find(id);
+        if ( it == m_ids.end() )
+        {
+            *win = NULL;
+            return true;
+        }
+
+        *win = it->second;
+        return *win != NULL;
+    }
+
+    bool FindByName(const wxString& name, wxWindow **win) const
+    {
+        const wxWindowNameIndexMap::const_iterator it = m_names.find(name);
+        if ( it == m_names.end() )
+        {
+            *win = NULL;
+            return true;
+        }
+
+        *win = it->second;
+        return *win != NULL;
+    }
+
+private:
+    void Add(const wxWindowBase *winBase)
+    {
+        wxWindow * const
+            win = const_cast<wxWindow*>(static_cast<const wxWindow*>(winBase));
+
+        // remember the first window using each key and mark the keys used
+        // more than once (wxID_ANY, notably) as ambiguous
+        wxWindowIdIndexMap::iterator itId = m_ids.find(win->GetId());
+        if ( itId == m_ids.end() )
+            m_ids[win->GetId()] = win;
+        else
+            itId->second = NULL;
+
+        wxWindowNameIndexMap::iterator itName = m_names.find(win->GetName());
+        if ( itName == m_names.end() )
+            m_names[win->GetName()] = win;
+        else
+            itName->second = NULL;
+
+        for ( wxWindowList::compatibility_iterator node =
+                winBase->GetChildren().GetFirst();
+              node;
+              node = node->GetNext() )
+        {
+            const wxWindowBase * const child = node->GetData();
+
+            // FindWindow() never recurses into child dialogs, so neither
+            // should the index
+            if ( child->IsTopLevel() )
+                continue;
+
+            Add(child);
+        }
+    }
+
+    wxWindowIdIndexMap m_ids;
+    wxWindowNameIndexMap m_names;
+    bool m_valid;
+
+    wxDECLARE_NO_COPY_CLASS(wxWindowLookupIndex);
+};
+
+void wxWindowBase::EnableChildLookupIndex(bool enable)
+{
+    if ( enable )
+    {
+        if ( !m_childLookupIndex )
+            m_childLookupIndex = new wxWindowLookupIndex;
+    }
+    else // disable
+    {
+        wxDELETE(m_childLookupIndex);
+    }
+}
+
+void wxWindowBase::InvalidateChildLookupIndex()
+{
+    // all the indexes rooted at our ancestors cover this window, so
+    // invalidate every one of them, but don't cross the top level boundary:
+    // the windows beyond it don't include us in their indexes
+    for ( wxWindowBase *win = this; win; win = win->GetParent() )
+    {
+        if ( win->m_childLookupIndex )
+            win->m_childLookupIndex->Invalidate();
+
+        if ( win->IsTopLevel() )
+            break;
+    }
+}
+
+wxWindowLookupIndex *wxWindowBase::GetChildLookupIndex() const
+{
+    for ( const wxWindowBase *win = this; win; win = win->GetParent() )
+    {
+        if ( win->m_childLookupIndex )
+        {
+            win->m_childLookupIndex->Update(win);
+            return win->m_childLookupIndex;
+        }
+
+        if ( win->IsTopLevel() )
+            break;
+    }
+
+    return NULL;
+}
+
+void wxWindowBase::SetName(const wxString& name)
+{
+    if ( name == m_windowName )
+        return;
+
+    m_windowName = name;
+
+    InvalidateChildLookupIndex();
+}
+
+void wxWindowBase::SetId(wxWindowID winid)
+{
+    if ( winid == m_windowId )
+        return;
+
+    m_windowId = winid;
+
+    InvalidateChildLookupIndex();
+}
+
 wxWindow *wxWindowBase::FindWindow(long id) const
 {
     if ( id == m_windowId )
         return const_cast<wxWindow*>(static_cast<const wxWindow*>(this));
 
+    // check if a hash index covering this window exists before falling back
+    // to recursing into the children
+    wxWindowLookupIndex * const index = GetChildLookupIndex();
+    if ( index )
+    {
+        wxWindow *win;
+        if ( index->FindById(id, &win) )
+        {
+            // the index may be rooted above us, so the (unique) window using
+            // this id is only a match if it is really one of our descendants
+            return win && IsDescendant(win) ? win : NULL;
+        }
+        //else: the id is used by several windows and the index can't tell
+        //      which one of them comes first in the search order, find out
+        //      ourselves below
+    }
+
     wxWindowBase *res = NULL;
     wxWindowList::compatibility_iterator node;
     for ( node = m_children.GetFirst(); node && !res; node = node->GetNext() )
@@ -1868,6 +2271,14 @@ wxWindow *wxWindowBase::FindWindow(const wxString& name) const
     if ( name == m_windowName )
         return const_cast<wxWindow*>(static_cast<const wxWindow*>(this));
 
+    wxWindowLookupIndex * const index = GetChildLookupIndex();
+    if ( index )
+    {
+        wxWindow *win;
+        if ( index->FindByName(name, &win) )
+            return win && IsDescendant(win) ? win : NULL;
+    }
+
     wxWindowBase *res = NULL;
     wxWindowList::compatibility_iterator node;
     for ( node = m_children.GetFirst(); node && !res; node = node->GetNext() )
@@ -2514,6 +2925,16 @@ void wxWindowBase::SatisfyConstraints()
 
 bool wxWindowBase::Layout()
 {
+    // just remember that the layout is needed if it is currently deferred,
+    // it will be done by EndDeferLayout()
+    if ( m_deferLayoutCount )
+    {
+        m_layoutDirty = true;
+        return true;
+    }
+
+    m_layoutDirty = false;
+
     // If there is a sizer, use it instead of the constraints
     if ( GetSizer() )
     {
@@ -2532,10 +2953,64 @@ bool wxWindowBase::Layout()
     return true;
 }
 
+void wxWindowBase::BeginDeferLayout()
+{
+    if ( !m_deferLayoutCount++ )
+    {
+        // recursively defer the layout of all children too as laying out any
+        // of them could also lay out (part of) this window
+        for ( wxWindowList::iterator i = GetChildren().begin();
+              i != GetChildren().end(); ++i )
+        {
+            wxWindow *child = *i;
+            if ( child->IsTopLevel() )
+                continue;
+
+            child->BeginDeferLayout();
+        }
+    }
+}
+
+void wxWindowBase::EndDeferLayout()
+{
+    wxASSERT_MSG( m_deferLayoutCount,
+                  "EndDeferLayout() without matching BeginDeferLayout()" );
+
+    if ( !--m_deferLayoutCount )
+    {
+        // lay out this window first: doing it top-down ensures that any
+        // children resized by our sizer are laid out with their final sizes
+        // by the recursive calls below and not twice
+        if ( m_layoutDirty )
+        {
+            // reset the flag ourselves as Layout() overrides wouldn't do it
+            m_layoutDirty = false;
+            Layout();
+        }
+
+        for ( wxWindowList::iterator i = GetChildren().begin();
+              i != GetChildren().end(); ++i )
+        {
+            wxWindow *child = *i;
+            if ( child->IsTopLevel() )
+                continue;
+
+            child->EndDeferLayout();
+        }
+    }
+}
+
 void wxWindowBase::InternalOnSize(wxSizeEvent& event)
 {
     if ( GetAutoLayout() )
-        Layout();
+    {
+        // checking this here and not only in Layout() itself is necessary to
+        // also defer the layout of the windows overriding that function
+        if ( IsLayoutDeferred() )
+            m_layoutDirty = true;
+        else
+            Layout();
+    }
 
     event.Skip();
 }
@@ -2831,9 +3306,11 @@ bool wxWindowBase::SendIdleEvents(wxIdleEvent& event)
 
     OnInternalIdle();
 
-    // should we send idle event to this window?
-    if (wxIdleEvent::GetMode() == wxIDLE_PROCESS_ALL ||
-        HasExtraStyle(wxWS_EX_PROCESS_IDLE))
+    // should we send idle event to this window? note that in
+    // wxIDLE_PROCESS_SPECIFIED mode the windows which requested idle events
+    // are sent them directly by wxApp::ProcessIdle() using the list
+    // returned by GetIdleWindows(), without walking the window tree
+    if (wxIdleEvent::GetMode() == wxIDLE_PROCESS_ALL)
     {
         event.SetEventObject(this);
         HandleWindowEvent(event);
@@ -26,8 +26,13 @@
 #include "wx/mstream.h"
 #include "wx/scopedptr.h"
 #include "wx/wfstream.h"
+#include "wx/vector.h"
 #include "zlib.h"
 
+#if wxUSE_THREADS
+    #include "wx/thread.h"
+#endif
+
 // value for the 'version needed to extract' field (20 means 2.0)
 enum {
     VERSION_NEEDED_TO_EXTRACT = 20,
@@ -603,6 +608,365 @@ bool wxZlibInputStream2::Open(wxInputStream& stream)
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+// Parallel deflate output stream
+//
+// Splits the entry data into fixed size chunks and compresses them on a
+// pool of worker threads, writing the compressed chunks to the parent
+// stream in order. Every chunk except the last is terminated with a sync
+// flush, which ends its last deflate block on a byte boundary without
+// setting the final-block bit, and each chunk is primed with the tail of
+// the previous chunk as a dictionary. The concatenation of the chunks is
+// therefore a single standard deflate stream, readable by any unzip.
+
+#if wxUSE_THREADS
+
+// A worker thread owning a deflater, compressing one chunk at a time.
+//
+class wxZipDeflateWorker : public wxThread
+{
+public:
+    enum {
+        CHUNK_SIZE = 128 * 1024,
+        DICT_SIZE = 32 * 1024
+    };
+
+    wxZipDeflateWorker(int level);
+    virtual ~wxZipDeflateWorker();
+
+    bool IsOk() const { return m_ok; }
+
+    // The caller fills this with the next chunk before calling Compress()
+    char *GetInput() const { return m_in; }
+
+    // Start compressing len bytes of the input buffer on the worker
+    // thread. The dictionary is copied before this returns.
+    void Compress(size_t len, const char *dict, size_t dictLen, bool final);
+
+    // Wait for the compressed chunk, returns NULL on error
+    const char *Finish(size_t *len);
+
+    // Stop the worker thread, must be called before destruction
+    void Quit();
+
+protected:
+    ExitCode Entry() wxOVERRIDE;
+
+private:
+    wxSemaphore m_semRequest;
+    wxSemaphore m_semDone;
+    z_stream m_z;
+    char *m_in;
+    char *m_out;
+    char *m_dict;
+    size_t m_inLen;
+    size_t m_outLen;
+    size_t m_outSize;
+    size_t m_dictLen;
+    bool m_final;
+    bool m_error;
+    bool m_quit;
+    bool m_ok;
+
+    wxDECLARE_NO_COPY_CLASS(wxZipDeflateWorker);
+};
+
+wxZipDeflateWorker::wxZipDeflateWorker(int level)
+  : wxThread(wxTHREAD_JOINABLE),
+    m_in(NULL), m_out(NULL), m_dict(NULL),
+    m_inLen(0), m_outLen(0), m_outSize(0), m_dictLen(0),
+    m_final(false), m_error(false), m_quit(false)
+{
+    memset(&m_z, 0, sizeof(m_z));
+    m_ok = deflateInit2(&m_z, level, Z_DEFLATED, -MAX_WBITS, 8,
+                        Z_DEFAULT_STRATEGY) == Z_OK;
+
+    if (m_ok) {
+        m_outSize = deflateBound(&m_z, CHUNK_SIZE) + 16;
+        m_in = new char[CHUNK_SIZE];
+        m_out = new char[m_outSize];
+        m_dict = new char[DICT_SIZE];
+        m_ok = Create() == wxTHREAD_NO_ERROR && Run() == wxTHREAD_NO_ERROR;
+    }
+}
+
+wxZipDeflateWorker::~wxZipDeflateWorker()
+{
+    deflateEnd(&m_z);
+    delete [] m_in;
+    delete [] m_out;
+    delete [] m_dict;
+}
+
+void wxZipDeflateWorker::Compress(size_t len,
+                                  const char *dict,
+                                  size_t dictLen,
+                                  bool final)
+{
+    m_inLen = len;
+    m_dictLen = dictLen;
+    if (dictLen)
+        memcpy(m_dict, dict, dictLen);
+    m_final = final;
+    m_semRequest.Post();
+}
+
+const char *wxZipDeflateWorker::Finish(size_t *len)
+{
+    m_semDone.Wait();
+    *len = m_outLen;
+    return m_error ? NULL : m_out;
+}
+
+void wxZipDeflateWorker::Quit()
+{
+    if (IsRunning()) {
+        m_quit = true;
+        m_semRequest.Post();
+        Wait();
+    }
+}
+
+wxThread::ExitCode wxZipDeflateWorker::Entry()
+{
+    for (;;) {
+        m_semRequest.Wait();
+        if (m_quit)
+            break;
+
+        deflateReset(&m_z);
+        if (m_dictLen)
+            deflateSetDictionary(&m_z, (const Bytef*)m_dict, m_dictLen);
+
+        m_z.next_in = (Bytef*)m_in;
+        m_z.avail_in = m_inLen;
+        m_z.next_out = (Bytef*)m_out;
+        m_z.avail_out = m_outSize;
+
+        // the output buffer is large enough for the worst case, so a
+        // single call always consumes the whole chunk
+        int err = deflate(&m_z, m_final ? Z_FINISH : Z_SYNC_FLUSH);
+
+        m_error = m_z.avail_in != 0 ||
+                  err != (m_final ? Z_STREAM_END : Z_OK);
+        m_outLen = m_outSize - m_z.avail_out;
+        m_semDone.Post();
+    }
+
+    return 0;
+}
+
+// The compressor itself, dispatching chunks round-robin to the workers.
+// Like wxZlibOutputStream2 it can be reused for the next entry by calling
+// Open() after Close().
+//
+class wxParallelZlibOutputStream : public wxFilterOutputStream
+{
+public:
+    wxParallelZlibOutputStream(wxOutputStream& stream, int level, int count);
+    virtual ~wxParallelZlibOutputStream();
+
+    // false if the worker threads could not be created
+    bool HasWorkers() const { return !m_workers.empty(); }
+
+    bool Open(wxOutputStream& stream);
+    bool Close() wxOVERRIDE;
+    void Sync() wxOVERRIDE;
+
+protected:
+    virtual size_t OnSysWrite(const void *buffer, size_t size) wxOVERRIDE;
+    virtual wxFileOffset OnSysTell() const wxOVERRIDE { return m_pos; }
+
+private:
+    wxZipDeflateWorker& CurrentWorker()
+        { return *m_workers[m_count % m_workers.size()]; }
+
+    // wait for the oldest busy worker and write its output
+    bool DrainOldest();
+
+    // hand the current chunk to a worker
+    void DispatchChunk(bool final);
+
+    wxVector<wxZipDeflateWorker*> m_workers;
+    char *m_dict;           // tail of the previously dispatched chunk
+    size_t m_dictLen;
+    size_t m_chunkLen;      // bytes in the current worker's input buffer
+    size_t m_count;         // chunks dispatched for the current entry
+    size_t m_busy;          // chunks dispatched but not yet drained
+    wxFileOffset m_pos;
+
+    wxDECLARE_NO_COPY_CLASS(wxParallelZlibOutputStream);
+};
+
+wxParallelZlibOutputStream::wxParallelZlibOutputStream(wxOutputStream& stream,
+                                                       int level,
+                                                       int count)
+  : wxFilterOutputStream(stream),
+    m_dict(new char[wxZipDeflateWorker::DICT_SIZE]),
+    m_dictLen(0),
+    m_chunkLen(0),
+    m_count(0),
+    m_busy(0),
+    m_pos(0)
+{
+    for (int i = 0; i < count; i++) {
+        wxZipDeflateWorker *worker = new wxZipDeflateWorker(level);
+        if (!worker->IsOk()) {
+            worker->Quit();
+            delete worker;
+            break;
+        }
+        m_workers.push_back(worker);
+    }
+
+    // no point without at least two workers
+    if (m_workers.size() < 2) {
+        while (!m_workers.empty()) {
+            m_workers.back()->Quit();
+            delete m_workers.back();
+            m_workers.pop_back();
+        }
+    }
+}
+
+wxParallelZlibOutputStream::~wxParallelZlibOutputStream()
+{
+    size_t len;
+    while (m_busy) {
+        m_workers[(m_count - m_busy) % m_workers.size()]->Finish(&len);
+        m_busy--;
+    }
+
+    for (size_t i = 0; i < m_workers.size(); i++) {
+        m_workers[i]->Quit();
+        delete m_workers[i];
+    }
+
+    delete [] m_dict;
+}
+
+bool wxParallelZlibOutputStream::Open(wxOutputStream& stream)
+{
+    wxCHECK(m_pos == wxInvalidOffset, false);
+    wxASSERT(m_busy == 0);
+
+    m_dictLen = 0;
+    m_chunkLen = 0;
+    m_count = 0;
+    m_pos = 0;
+    m_lasterror = wxSTREAM_NO_ERROR;
+    m_parent_o_stream = &stream;
+
+    return true;
+}
+
+bool wxParallelZlibOutputStream::DrainOldest()
+{
+    wxZipDeflateWorker& worker =
+        *m_workers[(m_count - m_busy) % m_workers.size()];
+    m_busy--;
+
+    size_t len;
+    const char *data = worker.Finish(&len);
+
+    if (!data || (len &&
+            m_parent_o_stream->Write(data, len).LastWrite() != len)) {
+        m_lasterror = wxSTREAM_WRITE_ERROR;
+        return false;
+    }
+
+    return true;
+}
+
+void wxParallelZlibOutputStream::DispatchChunk(bool final)
+{
+    wxZipDeflateWorker& worker = CurrentWorker();
+
+    worker.Compress(m_chunkLen, m_dict, m_dictLen, final);
+    m_busy++;
+    m_count++;
+
+    // keep the tail of this chunk to prime the next one (the worker only
+    // reads its input buffer, so copying from it here is safe)
+    if (m_chunkLen) {
+        m_dictLen = wxMin(size_t(wxZipDeflateWorker::DICT_SIZE), m_chunkLen);
+        memcpy(m_dict, worker.GetInput() + m_chunkLen - m_dictLen, m_dictLen);
+    }
+
+    m_chunkLen = 0;
+}
+
+size_t wxParallelZlibOutputStream::OnSysWrite(const void *buffer, size_t size)
+{
+    const char *data = (const char*)buffer;
+    size_t count = 0;
+
+    while (count < size && IsOk()) {
+        // before reusing a worker's input buffer wait for its last chunk
+        if (m_chunkLen == 0 && m_busy == m_workers.size() && !DrainOldest())
+            break;
+
+        size_t n = wxMin(size - count,
+                         wxZipDeflateWorker::CHUNK_SIZE - m_chunkLen);
+        memcpy(CurrentWorker().GetInput() + m_chunkLen, data + count, n);
+        m_chunkLen += n;
+        count += n;
+
+        if (m_chunkLen == wxZipDeflateWorker::CHUNK_SIZE)
+            DispatchChunk(false);
+    }
+
+    m_pos += count;
+    return count;
+}
+
+void wxParallelZlibOutputStream::Sync()
+{
+    if (!IsOk())
+        return;
+
+    if (m_chunkLen) {
+        if (m_busy == m_workers.size() && !DrainOldest())
+            return;
+        DispatchChunk(false);
+    }
+
+    while (m_busy)
+        if (!DrainOldest())
+            return;
+
+    m_parent_o_stream->Sync();
+    m_lasterror = m_parent_o_stream->GetLastError();
+}
+
+bool wxParallelZlibOutputStream::Close()
+{
+    // the last chunk, possibly empty, is always dispatched since it is the
+    // one that terminates the deflate stream with a final block
+    if (IsOk() && m_busy == m_workers.size())
+        DrainOldest();
+    if (IsOk())
+        DispatchChunk(true);
+
+    while (m_busy)
+        if (!DrainOldest())
+            break;
+
+    // on error leave no chunk in flight so that the workers stay reusable
+    size_t len;
+    while (m_busy) {
+        m_workers[(m_count - m_busy) % m_workers.size()]->Finish(&len);
+        m_busy--;
+    }
+
+    m_chunkLen = 0;
+    m_pos = wxInvalidOffset;
+    return IsOk();
+}
+
+#endif // wxUSE_THREADS
+
+
 /////////////////////////////////////////////////////////////////////////////
 // Class to hold wxZipEntry's Extra and LocalExtra fields
 
@@ -1556,6 +1920,48 @@ bool wxZipEndRec::Read(wxInputStream& stream, wxMBConv& conv)
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+// Index of the central directory by entry name, used to implement O(1)
+// opening of entries by name (see wxZipInputStream::OpenEntry(wxString))
+
+WX_DECLARE_STRING_HASH_MAP(wxZipEntry*, wxZipEntryNameMap_);
+
+class wxZipEntryIndex
+{
+public:
+    wxZipEntryIndex() { }
+
+    ~wxZipEntryIndex()
+    {
+        for (wxZipEntryNameMap_::iterator it = m_entries.begin();
+                it != m_entries.end(); ++it)
+            delete it->second;
+    }
+
+    // takes ownership of the entry; if there are several entries with the
+    // same name keep the first one, as that is the one a sequential scan
+    // with GetNextEntry() would have found
+    void Add(wxZipEntry *entry)
+    {
+        if (!m_entries.insert(
+                wxZipEntryNameMap_::value_type(entry->GetInternalName(),
+                                               entry)).second)
+            delete entry;
+    }
+
+    wxZipEntry *Find(const wxString& name) const
+    {
+        wxZipEntryNameMap_::const_iterator it = m_entries.find(name);
+        return it != m_entries.end() ? it->second : NULL;
+    }
+
+private:
+    wxZipEntryNameMap_ m_entries;
+
+    wxDECLARE_NO_COPY_CLASS(wxZipEntryIndex);
+};
+
+
 /////////////////////////////////////////////////////////////////////////////
 // A weak link from an input stream to an output stream
 
@@ -1618,8 +2024,10 @@ void wxZipInputStream::Init()
     m_streamlink = NULL;
     m_offsetAdjustment = 0;
     m_position = wxInvalidOffset;
+    m_centralOffset = wxInvalidOffset;
     m_signature = 0;
     m_TotalEntries = 0;
+    m_index = NULL;
     m_lasterror = m_parent_i_stream->GetLastError();
 }
 
@@ -1630,6 +2038,7 @@ wxZipInputStream::~wxZipInputStream()
     delete m_store;
     delete m_inflate;
     delete m_rawin;
+    delete m_index;
 
     m_weaklinks->Release(this);
 
@@ -1724,6 +2133,7 @@ bool wxZipInputStream::LoadEndRecord()
             ReadSignature() == magic) {
         m_signature = magic;
         m_position = endrec.GetOffset();
+        m_centralOffset = m_position;
         m_offsetAdjustment = 0;
         return true;
     }
@@ -1737,6 +2147,7 @@ bool wxZipInputStream::LoadEndRecord()
                 ReadSignature() == magic) {
         m_signature = magic;
         m_position = endPos - recSize;
+        m_centralOffset = m_position;
         if ( endrec.GetOffset() >= 0 && endrec.GetOffset() < m_position )
         {
             m_offsetAdjustment = m_position - endrec.GetOffset();
@@ -1868,6 +2279,68 @@ wxStreamError wxZipInputStream::ReadCentral()
     return wxSTREAM_NO_ERROR;
 }
 
+// Scan the whole central directory once and index the entries by name.
+//
+bool wxZipInputStream::BuildNameIndex()
+{
+    if (m_index)
+        return true;
+
+    if (m_position == wxInvalidOffset)
+        if (!LoadEndRecord())
+            return false;
+
+    // random access needs the central directory, which can only be found
+    // when the parent stream is seekable
+    if (!m_parentSeekable || m_centralOffset == wxInvalidOffset)
+        return false;
+
+    // scanning the central directory modifies the same state as
+    // GetNextEntry(), so save it here and restore it below to avoid
+    // disturbing an iteration that may be in progress
+    const wxFileOffset position = m_position;
+    const wxUint32 signature = m_signature;
+    const wxZipEntry entry(m_entry);
+
+    if (QuietSeek(*m_parent_i_stream, m_centralOffset) == wxInvalidOffset)
+        return false;
+    m_position = m_centralOffset;
+    m_signature = ReadSignature();
+
+    m_index = new wxZipEntryIndex;
+    wxStreamError err;
+    while ((err = ReadCentral()) == wxSTREAM_NO_ERROR)
+        m_index->Add(new wxZipEntry(m_entry));
+
+    m_position = position;
+    m_signature = signature;
+    m_entry = entry;
+
+    if (err != wxSTREAM_EOF) {
+        wxDELETE(m_index);
+        return false;
+    }
+
+    return true;
+}
+
+// Open the entry with the given name directly, without scanning the headers
+// preceding it. The central directory index is built on first use.
+//
+bool wxZipInputStream::OpenEntry(const wxString& name)
+{
+    if (!BuildNameIndex())
+        return false;
+
+    wxZipEntry *entry = m_index->Find(wxZipEntry::GetInternalName(name));
+    if (!entry) {
+        m_lasterror = wxSTREAM_READ_ERROR;
+        return false;
+    }
+
+    return DoOpen(entry);
+}
+
 wxStreamError wxZipInputStream::ReadLocal(bool readEndRec /*=false*/)
 {
     if (!AtHeader())
@@ -2191,6 +2664,8 @@ void wxZipOutputStream::Init(int level)
 {
     m_store = new wxStoredOutputStream(*m_parent_o_stream);
     m_deflate = NULL;
+    m_parallel = NULL;
+    m_numThreads = 1;
     m_backlink = NULL;
     m_initialData = new char[OUTPUT_LATENCY];
     m_initialSize = 0;
@@ -2212,6 +2687,9 @@ wxZipOutputStream::~wxZipOutputStream()
     WX_CLEAR_LIST(wxZipEntryList_, m_entries);
     delete m_store;
     delete m_deflate;
+#if wxUSE_THREADS
+    delete m_parallel;
+#endif
     delete m_pending;
     delete [] m_initialData;
     if (m_backlink)
@@ -2287,10 +2765,39 @@ void wxZipOutputStream::SetLevel(int level)
         if (m_comp != m_deflate)
             delete m_deflate;
         m_deflate = NULL;
+#if wxUSE_THREADS
+        if (m_comp != m_parallel)
+            delete m_parallel;
+        m_parallel = NULL;
+#endif
         m_level = level;
     }
 }
 
+bool wxZipOutputStream::SetCompressionThreads(int count)
+{
+#if wxUSE_THREADS
+    wxCHECK_MSG(!IsOpened(), false,
+                wxT("can't change compression threads of an open entry"));
+
+    if (count == -1)
+        count = wxThread::GetCPUCount();
+    if (count < 1)
+        count = 1;
+
+    if (count != m_numThreads) {
+        delete m_parallel;
+        m_parallel = NULL;
+        m_numThreads = count;
+    }
+
+    return true;
+#else
+    wxUnusedVar(count);
+    return false;
+#endif
+}
+
 bool wxZipOutputStream::DoCreate(wxZipEntry *entry, bool raw /*=false*/)
 {
     CloseEntry();
@@ -2378,6 +2885,26 @@ wxOutputStream *wxZipOutputStream::OpenCompressor(
             entry.SetFlags((entry.GetFlags() & ~wxZIP_DEFLATE_MASK) |
                             defbits | wxZIP_SUMS_FOLLOW);
 
+#if wxUSE_THREADS
+            if (m_numThreads > 1) {
+                if (!m_parallel) {
+                    m_parallel = new wxParallelZlibOutputStream(
+                                        stream, GetLevel(), m_numThreads);
+                    if (!m_parallel->HasWorkers()) {
+                        // couldn't create the worker threads, fall back to
+                        // compressing on the calling thread
+                        wxDELETE(m_parallel);
+                        m_numThreads = 1;
+                    }
+                } else {
+                    m_parallel->Open(stream);
+                }
+
+                if (m_parallel)
+                    return m_parallel;
+            }
+#endif // wxUSE_THREADS
+
             if (!m_deflate)
                 m_deflate = new wxZlibOutputStream2(stream, GetLevel());
             else
@@ -2397,6 +2924,10 @@ bool wxZipOutputStream::CloseCompressor(wxOutputStream *comp)
 {
     if (comp == m_deflate)
         m_deflate->Close();
+#if wxUSE_THREADS
+    else if (m_parallel && comp == m_parallel)
+        m_parallel->Close();
+#endif
     else if (comp != m_store)
         delete comp;
     return true;
@@ -208,7 +208,7 @@ void wxGUIEventLoop::DoYieldFor(long eventsToProcess)
     // TODO: implement event filtering using the eventsToProcess mask
 
     // process all pending events:
-    while ( Pending() )
+    while ( Pending() && !YieldDeadlineExpired() )
         Dispatch();
 
     // handle timers, sockets etc.
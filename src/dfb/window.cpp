@@ -575,8 +575,13 @@ void wxWindowDFB::DoGetTextExtent(const wxString& string,
 // painting
 // ---------------------------------------------------------------------------
 
-void wxWindowDFB::Refresh(bool WXUNUSED(eraseBack), const wxRect *rect)
+void wxWindowDFB::Refresh(bool eraseBack, const wxRect *rect)
 {
+#if wxUSE_TIMER
+    if ( QueueThrottledRefresh(eraseBack, rect) )
+        return;
+#endif // wxUSE_TIMER
+
     if ( !IsShown() || IsFrozen() )
         return;
 
@@ -46,6 +46,8 @@
 #include "wx/imaglist.h"
 #include "wx/headerctrl.h"
 #include "wx/dnd.h"
+#include "wx/hashset.h"
+#include "wx/private/parallelsort.h"
 #include "wx/selstore.h"
 #include "wx/stopwatch.h"
 #include "wx/weakref.h"
@@ -54,6 +56,8 @@
 #include "wx/generic/private/widthcalc.h"
 #if wxUSE_ACCESSIBILITY
 #include "wx/private/markupparser.h"
+
+#include <algorithm>
 #endif // wxUSE_ACCESSIBILITY
 
 //-----------------------------------------------------------------------------
@@ -71,6 +75,9 @@ class wxDataViewCtrl;
 // the cell padding on the left/right
 static const int PADDING_RIGHTLEFT = 3;
 
+// a set of item identifiers used by the batch notification handlers
+WX_DECLARE_HASH_SET(void*, wxPointerHash, wxPointerEqual, wxDataViewItemIDSet);
+
 namespace
 {
 
@@ -489,6 +496,7 @@ public:
     wxDataViewTreeNode(wxDataViewTreeNode *parent, const wxDataViewItem& item)
         : m_parent(parent),
           m_item(item),
+          m_indexInParent(0),
           m_branchData(NULL)
     {
     }
@@ -666,6 +674,13 @@ private:
     // Corresponding model item.
     wxDataViewItem       m_item;
 
+    // Index of this node in its parent's child list, maintained by
+    // BranchNodeData functions below and only valid while the node is
+    // attached to the parent: it allows to find the node among its siblings
+    // in constant time, which matters when a single item of a huge list
+    // changes, see PutChildInSortOrder().
+    unsigned             m_indexInParent;
+
     // Data specific to non-leaf (branch, inner) nodes. They are kept in a
     // separate struct in order to conserve memory.
     struct BranchNodeData
@@ -679,11 +694,19 @@ private:
         void InsertChild(wxDataViewTreeNode* node, unsigned index)
         {
             children.insert(children.begin() + index, node);
+
+            // The insertion shifted all the following children.
+            for ( unsigned n = index; n < children.size(); n++ )
+                children[n]->m_indexInParent = n;
         }
 
         void RemoveChild(unsigned index)
         {
             children.erase(children.begin() + index);
+
+            // The removal shifted all the following children.
+            for ( unsigned n = index; n < children.size(); n++ )
+                children[n]->m_indexInParent = n;
         }
 
         // Child nodes. Note that this may be empty even if m_hasChildren in
@@ -732,6 +755,11 @@ public:
     {
         return DoItemChanged(item, wxNOT_FOUND);
     }
+    bool ItemsAdded( const wxDataViewItem &parent,
+                     const wxDataViewItemArray &items );
+    bool ItemsDeleted( const wxDataViewItem &parent,
+                       const wxDataViewItemArray &items );
+    bool ItemsChanged( const wxDataViewItemArray &items );
     bool ValueChanged( const wxDataViewItem &item, unsigned int model_column );
     bool Cleared();
     void Resort()
@@ -883,6 +911,17 @@ public:
     // We did not need this temporarily
     // wxDataViewTreeNode * GetTreeNodeByItem( const wxDataViewItem & item );
 
+    // Filtering, see wxDataViewCtrl::SetFilter().
+    bool HasFilter() const { return GetOwner()->GetFilter() != NULL; }
+
+    // Return true if the item is visible, i.e. there is no filter or the item
+    // matches it.
+    bool MatchesFilter(const wxDataViewItem& item) const;
+
+    // Re-evaluate the current filter, if any, for all items. Called by
+    // wxDataViewCtrl::SetFilter().
+    void ApplyFilter();
+
     // Methods for building the mapping tree
     void BuildTree( wxDataViewModel  * model );
     void DestroyTree();
@@ -957,6 +996,13 @@ private:
 
     int RecalculateCount() const;
 
+    // Rebuild m_filteredRows from scratch, only used for virtual list models.
+    void RebuildFilteredRows();
+
+    // Return the visible row showing the given model row or -1 if it is
+    // filtered out. Only used when a filter is set on a virtual list model.
+    int FilteredRowIndex(unsigned int modelRow) const;
+
     // Return false only if the event was vetoed by its handler.
     bool SendExpanderEvent(wxEventType type, const wxDataViewItem& item);
 
@@ -1049,6 +1095,11 @@ private:
     wxDataViewTreeNode * m_root;
     int m_count;
 
+    // Sorted mapping of visible rows to model rows, only used when a filter
+    // is set on a virtual list model (tree models exclude the items filtered
+    // out from the tree structure itself instead).
+    wxVector<unsigned int> m_filteredRows;
+
     // This is the tree node under the cursor
     wxDataViewTreeNode * m_underMouse;
 
@@ -1079,6 +1130,12 @@ public:
         { return m_mainWindow->ItemDeleted( parent, item ); }
     virtual bool ItemChanged( const wxDataViewItem & item ) wxOVERRIDE
         { return m_mainWindow->ItemChanged(item);  }
+    virtual bool ItemsAdded( const wxDataViewItem &parent, const wxDataViewItemArray &items ) wxOVERRIDE
+        { return m_mainWindow->ItemsAdded( parent, items ); }
+    virtual bool ItemsDeleted( const wxDataViewItem &parent, const wxDataViewItemArray &items ) wxOVERRIDE
+        { return m_mainWindow->ItemsDeleted( parent, items ); }
+    virtual bool ItemsChanged( const wxDataViewItemArray &items ) wxOVERRIDE
+        { return m_mainWindow->ItemsChanged( items ); }
     virtual bool ValueChanged( const wxDataViewItem & item , unsigned int col ) wxOVERRIDE
         { return m_mainWindow->ValueChanged( item, col ); }
     virtual bool Cleared() wxOVERRIDE
@@ -1908,9 +1965,16 @@ void wxDataViewTreeNode::Resort(wxDataViewMainWindow* window)
         // using model-specific sort order, which can change at any time.
         if ( m_branchData->sortOrder != sortOrder || !sortOrder.UsesColumn() )
         {
-            std::sort(m_branchData->children.begin(),
-                      m_branchData->children.end(),
-                      wxGenericTreeModelNodeCmp(window, sortOrder));
+            // Use a stable sort which may parallelize the work for very
+            // big branches; the model comparator only looks at the items
+            // themselves, so calling it concurrently is safe.
+            wxParallelStableSort(m_branchData->children.begin(),
+                                 m_branchData->children.end(),
+                                 wxGenericTreeModelNodeCmp(window, sortOrder));
+
+            // Sorting rearranged the nodes, so fix up their indices.
+            for ( unsigned n = 0; n < nodes.size(); n++ )
+                nodes[n]->m_indexInParent = n;
 
             m_branchData->sortOrder = sortOrder;
         }
@@ -1950,18 +2014,13 @@ wxDataViewTreeNode::PutChildInSortOrder(wxDataViewMainWindow* window,
     // We should already be sorted in the right order.
     wxASSERT(m_branchData->sortOrder == window->GetSortOrder());
 
-    // First find the node in the current child list
+    // The node knows its own position in the child list, just check that it
+    // is consistent: scanning the entire list instead would be prohibitively
+    // expensive when a single item of a huge list changes.
     int hi = nodes.size();
-    int oldLocation = wxNOT_FOUND;
-    for ( int index = 0; index < hi; ++index )
-    {
-        if ( nodes[index] == childNode )
-        {
-            oldLocation = index;
-            break;
-        }
-    }
-    wxCHECK_RET( oldLocation >= 0, "not our child?" );
+    const int oldLocation = childNode->m_indexInParent;
+    wxCHECK_RET( oldLocation < hi && nodes[oldLocation] == childNode,
+                 "not our child?" );
 
     wxGenericTreeModelNodeCmp cmp(window, m_branchData->sortOrder);
 
@@ -2480,6 +2539,20 @@ wxBitmap wxDataViewMainWindow::CreateItemBitmap( unsigned int row, int &indent )
 
 #endif // wxUSE_DRAG_AND_DROP
 
+namespace
+{
+
+// Information about a row being repainted which is shared by all its cells
+// and so is computed only once per row instead of once per cell.
+struct wxDataViewRowToPaint
+{
+    wxDataViewTreeNode *node;   // NULL for virtual list models
+    int height;
+    bool selected;
+};
+
+} // anonymous namespace
+
 void wxDataViewMainWindow::OnPaint( wxPaintEvent &WXUNUSED(event) )
 {
     wxDataViewModel *model = GetModel();
@@ -2561,6 +2634,22 @@ void wxDataViewMainWindow::OnPaint( wxPaintEvent &WXUNUSED(event) )
     // using it, so there is no need to use two different approaches).
     const unsigned int first_line_start = GetLineStart(item_start);
 
+    // Look up the per-row information used repeatedly below only once per
+    // row: all the cells of the same row share it and finding the tree node
+    // corresponding to a row, in particular, is too expensive to redo for
+    // every column.
+    const bool isVirtualList = IsVirtualList();
+    wxVector<wxDataViewRowToPaint> rowsToPaint;
+    rowsToPaint.reserve(item_count);
+    for (unsigned int item = item_start; item < item_last; item++)
+    {
+        wxDataViewRowToPaint row;
+        row.node = isVirtualList ? NULL : GetTreeNodeByRow(item);
+        row.height = GetLineHeight(item);
+        row.selected = m_selection.IsSelected(item);
+        rowsToPaint.push_back(row);
+    }
+
     // Draw background of alternate rows specially if required
     if ( m_owner->HasFlag(wxDV_ROW_LINES) )
     {
@@ -2586,7 +2675,7 @@ void wxDataViewMainWindow::OnPaint( wxPaintEvent &WXUNUSED(event) )
         unsigned int cur_line_start = first_line_start;
         for (unsigned int item = item_start; item < item_last; item++)
         {
-            const int h = GetLineHeight(item);
+            const int h = rowsToPaint[item - item_start].height;
             if ( item % 2 )
             {
                 dc.DrawRectangle(xRect, cur_line_start, widthRect, h);
@@ -2604,9 +2693,11 @@ void wxDataViewMainWindow::OnPaint( wxPaintEvent &WXUNUSED(event) )
         unsigned int cur_line_start = first_line_start;
         for (unsigned int i = item_start; i <= item_last; i++)
         {
-            const int h = GetLineHeight(i);
             dc.DrawLine(x_start, cur_line_start, x_last, cur_line_start);
-            cur_line_start += h;
+
+            // The height of the row after the last one isn't needed.
+            if ( i < item_last )
+                cur_line_start += rowsToPaint[i - item_start].height;
         }
     }
 
@@ -2640,8 +2731,9 @@ void wxDataViewMainWindow::OnPaint( wxPaintEvent &WXUNUSED(event) )
     unsigned int cur_line_start = first_line_start;
     for (unsigned int item = item_start; item < item_last; item++)
     {
-        bool selected = m_selection.IsSelected(item);
-        const int line_height = GetLineHeight(item);
+        const wxDataViewRowToPaint& rowToPaint = rowsToPaint[item - item_start];
+        const bool selected = rowToPaint.selected;
+        const int line_height = rowToPaint.height;
 
         if (selected || item == m_currentRow)
         {
@@ -2665,8 +2757,7 @@ void wxDataViewMainWindow::OnPaint( wxPaintEvent &WXUNUSED(event) )
                     // If there is just a single value, render full-row focus:
                     if ( !IsList() )
                     {
-                        wxDataViewTreeNode *node = GetTreeNodeByRow(item);
-                        if ( IsItemSingleValued(node->GetItem()) )
+                        if ( IsItemSingleValued(rowToPaint.node->GetItem()) )
                             renderColumnFocus = false;
                     }
                 }
@@ -2799,15 +2890,18 @@ void wxDataViewMainWindow::OnPaint( wxPaintEvent &WXUNUSED(event) )
         cell_rect.y = first_line_start;
         for (unsigned int item = item_start; item < item_last; item++)
         {
+            const wxDataViewRowToPaint& rowToPaint =
+                rowsToPaint[item - item_start];
+
             // get the cell value and set it into the renderer
             wxDataViewTreeNode *node = NULL;
             wxDataViewItem dataitem;
-            const int line_height = GetLineHeight(item);
+            const int line_height = rowToPaint.height;
             bool hasValue = true;
 
-            if (!IsVirtualList())
+            if (!isVirtualList)
             {
-                node = GetTreeNodeByRow(item);
+                node = rowToPaint.node;
                 if (node == NULL)
                 {
                     cell_rect.y += line_height;
@@ -2828,7 +2922,7 @@ void wxDataViewMainWindow::OnPaint( wxPaintEvent &WXUNUSED(event) )
             // update cell_rect
             cell_rect.height = line_height;
 
-            bool selected = m_selection.IsSelected(item);
+            const bool selected = rowToPaint.selected;
 
             int state = 0;
             if (m_hasFocus && selected)
@@ -3080,10 +3174,34 @@ bool wxDataViewMainWindow::ItemAdded(const wxDataViewItem & parent, const wxData
     {
         wxDataViewVirtualListModel *list_model =
             (wxDataViewVirtualListModel*) GetModel();
-        m_count = list_model->GetCount();
+
+        if ( HasFilter() )
+        {
+            // Shift the model rows following the added one and insert it into
+            // the visible index if it matches the filter.
+            const unsigned int modelRow = wxPtrToUInt(item.GetID()) - 1;
+            wxVector<unsigned int>::iterator it =
+                std::lower_bound(m_filteredRows.begin(), m_filteredRows.end(),
+                                 modelRow);
+            for ( wxVector<unsigned int>::iterator i = it;
+                  i != m_filteredRows.end();
+                  ++i )
+                (*i)++;
+
+            if ( MatchesFilter(item) )
+                m_filteredRows.insert(it, modelRow);
+
+            m_count = m_filteredRows.size();
+        }
+        else
+            m_count = list_model->GetCount();
     }
     else
     {
+        // An item not matching the filter, if any, doesn't get a node at all.
+        if ( !MatchesFilter(item) )
+            return true;
+
         // specific position (row) is unclear, so clear whole height cache
         ClearRowHeightCache();
 
@@ -3160,7 +3278,138 @@ bool wxDataViewMainWindow::ItemAdded(const wxDataViewItem & parent, const wxData
         InvalidateCount();
     }
 
-    m_selection.OnItemsInserted(GetRowByItem(item), 1);
+    // The item may be invisible, i.e. filtered out, in which case there is
+    // nothing to update in the selection.
+    const int row = GetRowByItem(item);
+    if ( row != -1 )
+        m_selection.OnItemsInserted(row, 1);
+
+    GetOwner()->InvalidateColBestWidths();
+    UpdateDisplay();
+
+    return true;
+}
+
+bool wxDataViewMainWindow::ItemsAdded(const wxDataViewItem& parent,
+                                      const wxDataViewItemArray& items)
+{
+    if ( items.size() == 1 )
+        return ItemAdded(parent, items[0]);
+
+    if (IsVirtualList())
+    {
+        wxDataViewVirtualListModel *list_model =
+            (wxDataViewVirtualListModel*) GetModel();
+
+        if ( HasFilter() )
+        {
+            // Unlike in ItemAdded(), the positions of the added items are
+            // too hard to recover one by one here, so re-evaluate the filter
+            // for the whole model.
+            RebuildFilteredRows();
+            m_count = m_filteredRows.size();
+        }
+        else
+            m_count = list_model->GetCount();
+    }
+    else
+    {
+        // specific positions (rows) are unclear, so clear whole height cache
+        ClearRowHeightCache();
+
+        wxDataViewTreeNode *parentNode = FindNode(parent);
+
+        if ( !parentNode )
+            return false;
+
+        parentNode->SetHasChildren(true);
+
+        if ( GetSortOrder().IsNone() )
+        {
+            // Without sorting the nodes must appear in the same order as the
+            // corresponding items in the model, so merge the new items into
+            // the (possibly incomplete) list of the existing nodes in a
+            // single pass over the model children instead of searching for
+            // the insertion position of every item separately, which would be
+            // quadratic in the number of items.
+            wxDataViewItemArray modelSiblings;
+            GetModel()->GetChildren(parent, modelSiblings);
+            const size_t modelSiblingsSize = modelSiblings.size();
+
+            wxDataViewItemIDSet newItems;
+            for ( size_t i = 0; i < items.size(); i++ )
+                newItems.insert(items[i].GetID());
+
+            unsigned int nodePos = 0;
+            size_t numAdded = 0;
+            for ( size_t posInModel = 0;
+                  posInModel < modelSiblingsSize;
+                  posInModel++ )
+            {
+                const wxDataViewItem& modelItem = modelSiblings[posInModel];
+                const wxDataViewTreeNodes& nodeSiblings = parentNode->GetChildNodes();
+                if ( newItems.count(modelItem.GetID()) )
+                {
+                    numAdded++;
+
+                    // New items not matching the filter, if any, don't get
+                    // nodes, just as in ItemAdded().
+                    if ( !MatchesFilter(modelItem) )
+                        continue;
+
+                    wxDataViewTreeNode *itemNode =
+                        new wxDataViewTreeNode(parentNode, modelItem);
+                    itemNode->SetHasChildren(GetModel()->IsContainer(modelItem));
+
+                    parentNode->ChangeSubTreeCount(+1);
+                    parentNode->InsertChild(this, itemNode, nodePos);
+                    nodePos++;
+                }
+                else if ( nodePos < nodeSiblings.size() &&
+                            nodeSiblings[nodePos]->GetItem() == modelItem )
+                {
+                    // an already existing node, just skip it
+                    nodePos++;
+                }
+                //else: an old item without a node, i.e. a never shown one
+            }
+
+            wxCHECK_MSG( numAdded == items.size(), false,
+                         "adding non-existent items?" );
+        }
+        else
+        {
+            // Node list is or will be sorted, so InsertChild do not need
+            // insertion position and every item is inserted in O(log n) using
+            // binary search.
+            for ( size_t i = 0; i < items.size(); i++ )
+            {
+                if ( !MatchesFilter(items[i]) )
+                    continue;
+
+                wxDataViewTreeNode *itemNode =
+                    new wxDataViewTreeNode(parentNode, items[i]);
+                itemNode->SetHasChildren(GetModel()->IsContainer(items[i]));
+
+                parentNode->ChangeSubTreeCount(+1);
+                parentNode->InsertChild(this, itemNode, 0);
+            }
+        }
+
+        InvalidateCount();
+    }
+
+    // Unlike in ItemAdded(), only update the selection if there is anything
+    // to update at all, as computing the row of every item is not cheap.
+    if ( !m_selection.IsEmpty() )
+    {
+        for ( size_t i = 0; i < items.size(); i++ )
+        {
+            const int row = GetRowByItem(items[i]);
+            if ( row != -1 )
+                m_selection.OnItemsInserted(row, 1);
+        }
+    }
 
     GetOwner()->InvalidateColBestWidths();
     UpdateDisplay();
@@ -3175,9 +3424,35 @@ bool wxDataViewMainWindow::ItemDeleted(const wxDataViewItem& parent,
     {
         wxDataViewVirtualListModel *list_model =
             (wxDataViewVirtualListModel*) GetModel();
-        m_count = list_model->GetCount();
 
-        m_selection.OnItemDelete(GetRowByItem(item));
+        if ( HasFilter() )
+        {
+            // The item ID is the model row before the deletion, see the
+            // comment in ItemAdded().
+            const unsigned int modelRow = wxPtrToUInt(item.GetID()) - 1;
+
+            wxVector<unsigned int>::iterator it = std::lower_bound(
+                m_filteredRows.begin(), m_filteredRows.end(), modelRow);
+
+            if ( it != m_filteredRows.end() && *it == modelRow )
+            {
+                m_selection.OnItemDelete(it - m_filteredRows.begin());
+                it = m_filteredRows.erase(it);
+            }
+            //else: the deleted item was filtered out, nothing to remove.
+
+            // The model rows of all the following items shift down by one.
+            for ( ; it != m_filteredRows.end(); ++it )
+                (*it)--;
+
+            m_count = m_filteredRows.size();
+        }
+        else
+        {
+            m_count = list_model->GetCount();
+
+            m_selection.OnItemDelete(GetRowByItem(item));
+        }
     }
     else // general case
     {
@@ -3285,24 +3560,215 @@ bool wxDataViewMainWindow::ItemDeleted(const wxDataViewItem& parent,
     return true;
 }
 
+bool wxDataViewMainWindow::ItemsDeleted(const wxDataViewItem& parent,
+                                        const wxDataViewItemArray& items)
+{
+    if ( items.size() == 1 )
+        return ItemDeleted(parent, items[0]);
+
+    if (IsVirtualList())
+    {
+        wxDataViewVirtualListModel *list_model =
+            (wxDataViewVirtualListModel*) GetModel();
+
+        if ( HasFilter() )
+        {
+            // As in ItemsAdded(), the old rows of the deleted items are too
+            // hard to recover one by one, so re-evaluate the filter for the
+            // whole model and reset the selection, which can't be maintained
+            // across such wholesale changes.
+            RebuildFilteredRows();
+            m_count = m_filteredRows.size();
+
+            m_selection.Clear();
+        }
+        else
+        {
+            m_count = list_model->GetCount();
+
+            for ( size_t i = 0; i < items.size(); i++ )
+                m_selection.OnItemDelete(GetRowByItem(items[i]));
+        }
+    }
+    else // general case
+    {
+        wxDataViewTreeNode *parentNode = FindNode(parent);
+
+        // As in ItemDeleted(), it's not an error if we don't know anything
+        // about the parent of the deleted items.
+        if ( !parentNode )
+            return true;
+
+        wxCHECK_MSG( parentNode->HasChildren(), false, "parent node doesn't have children?" );
+
+        wxDataViewItemIDSet deletedIds;
+        for ( size_t i = 0; i < items.size(); i++ )
+            deletedIds.insert(items[i].GetID());
+
+        const wxDataViewTreeNodes& parentsChildren = parentNode->GetChildNodes();
+
+        // The row occupied by the first child of the parent.
+        const int firstChildRow = GetRowByItem(parentNode->GetItem()) + 1;
+
+        // Find the nodes corresponding to the deleted items in a single pass
+        // over the child list and remember the row each of them currently
+        // occupies.
+        wxVector<unsigned int> positions;
+        wxVector<int> rows;
+        int rowOffset = 0;
+        for ( unsigned int pos = 0; pos < parentsChildren.size(); pos++ )
+        {
+            wxDataViewTreeNode* const node = parentsChildren[pos];
+            if ( deletedIds.count(node->GetItem().GetID()) )
+            {
+                positions.push_back(pos);
+                rows.push_back(firstChildRow + rowOffset);
+            }
+
+            rowOffset += 1 + node->GetSubTreeCount();
+        }
+
+        // Notice that it is possible that some (or even all) of the deleted
+        // items had no nodes at all, e.g. because their parent was never
+        // expanded: there is nothing to do for them.
+        if ( !positions.empty() )
+        {
+            if ( m_rowHeightCache )
+                m_rowHeightCache->Remove(rows.front());
+
+            const bool updateSelection = !m_selection.IsEmpty();
+
+            // Delete the nodes from the last one to the first one, so that
+            // the positions and rows of the remaining ones aren't affected.
+            for ( size_t k = positions.size(); k > 0; k-- )
+            {
+                const unsigned int pos = positions[k - 1];
+                wxDataViewTreeNode* const itemNode = parentsChildren[pos];
+
+                const int itemsDeleted = 1 + itemNode->GetSubTreeCount();
+
+                parentNode->RemoveChild(pos);
+                delete itemNode;
+                parentNode->ChangeSubTreeCount(-itemsDeleted);
+
+                if ( updateSelection )
+                    m_selection.OnItemsDeleted(rows[k - 1], itemsDeleted);
+            }
+
+            // Make the row number invalid and get a new valid one when user
+            // call GetRowCount
+            InvalidateCount();
+        }
+
+        // If the last children were removed, it's possible the parent node
+        // became a leaf. Let's ask the model about it.
+        if ( parentNode->GetChildNodes().empty() )
+        {
+            bool isContainer = GetModel()->IsContainer(parent);
+            parentNode->SetHasChildren(isContainer);
+            if ( isContainer )
+            {
+                // If it's still a container, make sure we show "+" icon for it
+                // and not "-" one as there is nothing to collapse any more.
+                if ( parentNode->IsOpen() )
+                    parentNode->ToggleOpen(this);
+            }
+        }
+    }
+
+    // Change the current row to the last row if the current exceed the max row number
+    if ( m_currentRow >= GetRowCount() )
+        ChangeCurrentRow(m_count - 1);
+
+    GetOwner()->InvalidateColBestWidths();
+    UpdateDisplay();
+
+    return true;
+}
+
 bool wxDataViewMainWindow::DoItemChanged(const wxDataViewItem & item, int view_column)
 {
-    if ( !IsVirtualList() )
+    if ( IsVirtualList() )
     {
-        if ( m_rowHeightCache )
-            m_rowHeightCache->Remove(GetRowByItem(item));
+        if ( HasFilter() )
+        {
+            // The new value may change whether the item matches the filter,
+            // so re-evaluate it for this row only.
+            const unsigned int modelRow = wxPtrToUInt(item.GetID()) - 1;
 
-        // Move this node to its new correct place after it was updated.
-        //
-        // In principle, we could skip the call to PutInSortOrder() if the modified
-        // column is not the sort column, but in real-world applications it's fully
-        // possible and likely that custom compare uses not only the selected model
-        // column but also falls back to other values for comparison. To ensure
-        // consistency it is better to treat a value change as if it was an item
-        // change.
-        wxDataViewTreeNode* const node = FindNode(item);
-        wxCHECK_MSG( node, false, "invalid item" );
-        node->PutInSortOrder(this);
+            wxVector<unsigned int>::iterator it = std::lower_bound(
+                m_filteredRows.begin(), m_filteredRows.end(), modelRow);
+
+            const bool wasShown = it != m_filteredRows.end() &&
+                                    *it == modelRow;
+
+            if ( MatchesFilter(item) )
+            {
+                if ( !wasShown )
+                {
+                    const unsigned int row = it - m_filteredRows.begin();
+                    m_filteredRows.insert(it, modelRow);
+                    m_selection.OnItemsInserted(row, 1);
+                    m_count = m_filteredRows.size();
+                    UpdateDisplay();
+                }
+            }
+            else if ( wasShown )
+            {
+                m_selection.OnItemDelete(it - m_filteredRows.begin());
+                m_filteredRows.erase(it);
+                m_count = m_filteredRows.size();
+                UpdateDisplay();
+            }
+        }
+    }
+    else // not a virtual list
+    {
+        wxDataViewTreeNode* node = FindNode(item);
+
+        if ( HasFilter() )
+        {
+            // The new value may change whether the item matches the filter,
+            // so splice its node in or out of the tree as needed, reusing the
+            // usual item addition/removal machinery.
+            if ( MatchesFilter(item) )
+            {
+                if ( !node )
+                {
+                    ItemAdded(GetModel()->GetParent(item), item);
+                    node = FindNode(item);
+                }
+            }
+            else if ( node )
+            {
+                ItemDeleted(GetModel()->GetParent(item), item);
+                node = NULL;
+            }
+        }
+        else
+        {
+            wxCHECK_MSG( node, false, "invalid item" );
+        }
+
+        if ( node )
+        {
+            if ( m_rowHeightCache )
+            {
+                // Only the changed item may have a different height now, the
+                // cached heights of all the other rows remain valid.
+                m_rowHeightCache->InvalidateRow(GetRowByItem(item));
+            }
+
+            // Move this node to its new correct place after it was updated.
+            //
+            // In principle, we could skip the call to PutInSortOrder() if the modified
+            // column is not the sort column, but in real-world applications it's fully
+            // possible and likely that custom compare uses not only the selected model
+            // column but also falls back to other values for comparison. To ensure
+            // consistency it is better to treat a value change as if it was an item
+            // change.
+            node->PutInSortOrder(this);
+        }
     }
 
     wxDataViewColumn* column;
@@ -3317,8 +3783,11 @@ bool wxDataViewMainWindow::DoItemChanged(const wxDataViewItem & item, int view_c
         GetOwner()->InvalidateColBestWidth(view_column);
     }
 
-    // Update the displayed value(s).
-    RefreshRow(GetRowByItem(item));
+    // Update the displayed value(s), unless the item is currently filtered
+    // out and so has no row at all.
+    const int row = GetRowByItem(item);
+    if ( row != -1 )
+        RefreshRow(row);
 
     // Send event
     wxDataViewEvent le(wxEVT_DATAVIEW_ITEM_VALUE_CHANGED, m_owner, column, item);
@@ -3327,6 +3796,56 @@ bool wxDataViewMainWindow::DoItemChanged(const wxDataViewItem & item, int view_c
     return true;
 }
 
+bool wxDataViewMainWindow::ItemsChanged( const wxDataViewItemArray &items )
+{
+    if ( items.size() == 1 )
+        return ItemChanged(items[0]);
+
+    if ( HasFilter() )
+    {
+        // The new values may change which of the items match the filter, so
+        // process them one by one to update the set of visible rows
+        // incrementally.
+        for ( size_t i = 0; i < items.size(); i++ )
+            ItemChanged(items[i]);
+
+        return true;
+    }
+
+    if ( !IsVirtualList() )
+    {
+        // Computing the row of every single item just to invalidate its
+        // cached height would be too expensive here, so drop the whole cache.
+        ClearRowHeightCache();
+
+        // As in DoItemChanged(), the items must be put into their new correct
+        // places if the list is sorted, but this is a cheap no-op otherwise.
+        if ( !GetSortOrder().IsNone() )
+        {
+            for ( size_t i = 0; i < items.size(); i++ )
+            {
+                wxDataViewTreeNode* const node = FindNode(items[i]);
+                wxCHECK_MSG( node, false, "invalid item" );
+                node->PutInSortOrder(this);
+            }
+        }
+    }
+
+    GetOwner()->InvalidateColBestWidths();
+
+    // Send the events but, unlike when processing the items one by one,
+    // update the display only once at the end.
+    for ( size_t i = 0; i < items.size(); i++ )
+    {
+        wxDataViewEvent le(wxEVT_DATAVIEW_ITEM_VALUE_CHANGED, m_owner, NULL, items[i]);
+        m_owner->ProcessWindowEvent(le);
+    }
+
+    UpdateDisplay();
+
+    return true;
+}
+
 bool wxDataViewMainWindow::ValueChanged( const wxDataViewItem & item, unsigned int model_column )
 {
     int view_column = m_owner->GetModelColumnIndex(model_column);
@@ -3870,7 +4389,12 @@ wxDataViewItem wxDataViewMainWindow::GetItemByRow(unsigned int row) const
     wxDataViewItem item;
     if (IsVirtualList())
     {
-        if ( row < GetRowCount() )
+        if ( HasFilter() )
+        {
+            if ( row < m_filteredRows.size() )
+                item = wxDataViewItem(wxUIntToPtr(m_filteredRows[row] + 1));
+        }
+        else if ( row < GetRowCount() )
             item = wxDataViewItem(wxUIntToPtr(row+1));
     }
     else
@@ -4234,6 +4758,9 @@ int wxDataViewMainWindow::RecalculateCount() const
 {
     if (IsVirtualList())
     {
+        if ( HasFilter() )
+            return m_filteredRows.size();
+
         const wxDataViewVirtualListModel* list_model =
             static_cast<const wxDataViewVirtualListModel*>(GetModel());
 
@@ -4245,6 +4772,35 @@ int wxDataViewMainWindow::RecalculateCount() const
     }
 }
 
+int wxDataViewMainWindow::FilteredRowIndex(unsigned int modelRow) const
+{
+    wxVector<unsigned int>::const_iterator it =
+        std::lower_bound(m_filteredRows.begin(), m_filteredRows.end(),
+                         modelRow);
+    if ( it == m_filteredRows.end() || *it != modelRow )
+        return -1;
+
+    return it - m_filteredRows.begin();
+}
+
+void wxDataViewMainWindow::RebuildFilteredRows()
+{
+    m_filteredRows.clear();
+
+    if ( !HasFilter() )
+        return;
+
+    const wxDataViewVirtualListModel* list_model =
+        static_cast<const wxDataViewVirtualListModel*>(GetModel());
+
+    const unsigned int count = list_model->GetCount();
+    for ( unsigned int row = 0; row < count; row++ )
+    {
+        if ( MatchesFilter(wxDataViewItem(wxUIntToPtr(row + 1))) )
+            m_filteredRows.push_back(row);
+    }
+}
+
 class ItemToRowJob : public DoJob
 {
 public:
@@ -4304,7 +4860,12 @@ wxDataViewMainWindow::GetRowByItem(const wxDataViewItem & item,
 
     if (IsVirtualList())
     {
-        return wxPtrToUInt( item.GetID() ) -1;
+        const unsigned int modelRow = wxPtrToUInt( item.GetID() ) -1;
+
+        if ( HasFilter() )
+            return FilteredRowIndex(modelRow);
+
+        return modelRow;
     }
     else
     {
@@ -4333,6 +4894,39 @@ wxDataViewMainWindow::GetRowByItem(const wxDataViewItem & item,
     }
 }
 
+bool wxDataViewMainWindow::MatchesFilter(const wxDataViewItem& item) const
+{
+    wxDataViewFilter* const filter = GetOwner()->GetFilter();
+
+    return !filter || filter->Matches(GetModel(), item);
+}
+
+void wxDataViewMainWindow::ApplyFilter()
+{
+    // The set of visible rows changes wholesale, so there is no reasonable
+    // way of preserving the selection, which is stored in terms of rows.
+    m_selection.Clear();
+    m_currentRow = (unsigned)-1;
+
+    ClearRowHeightCache();
+
+    if ( IsVirtualList() )
+    {
+        RebuildFilteredRows();
+        InvalidateCount();
+    }
+    else
+    {
+        // Rebuild the tree skipping the items filtered out. Subsequent value
+        // changes are handled incrementally in DoItemChanged(), so this full
+        // rebuild only happens when the filter itself changes.
+        BuildTree(GetModel());
+    }
+
+    GetOwner()->InvalidateColBestWidths();
+    UpdateDisplay();
+}
+
 static void BuildTreeHelper( wxDataViewMainWindow *window, const wxDataViewModel * model,
                              const wxDataViewItem & item, wxDataViewTreeNode * node)
 {
@@ -4342,18 +4936,24 @@ static void BuildTreeHelper( wxDataViewMainWindow *window, const wxDataViewModel
     wxDataViewItemArray children;
     unsigned int num = model->GetChildren( item, children);
 
-    for ( unsigned int index = 0; index < num; index++ )
+    unsigned int index = 0;
+    for ( unsigned int pos = 0; pos < num; pos++ )
     {
-        wxDataViewTreeNode *n = new wxDataViewTreeNode(node, children[index]);
+        // Items not matching the current filter, if any, get no nodes and so
+        // their (possibly realized later) children don't either.
+        if ( !window->MatchesFilter(children[pos]) )
+            continue;
 
-        if( model->IsContainer(children[index]) )
+        wxDataViewTreeNode *n = new wxDataViewTreeNode(node, children[pos]);
+
+        if( model->IsContainer(children[pos]) )
             n->SetHasChildren( true );
 
-        node->InsertChild(window, n, index);
+        node->InsertChild(window, n, index++);
     }
 
     if ( node->IsOpen() )
-        node->ChangeSubTreeCount(+num);
+        node->ChangeSubTreeCount(+index);
 }
 
 void wxDataViewMainWindow::BuildTree(wxDataViewModel * model)
@@ -4362,6 +4962,7 @@ void wxDataViewMainWindow::BuildTree(wxDataViewModel * model)
 
     if (GetModel()->IsVirtualListModel())
     {
+        RebuildFilteredRows();
         InvalidateCount();
         return;
     }
@@ -5530,6 +6131,8 @@ void wxDataViewCtrl::Init()
     m_colsDirty = false;
 
     m_allowMultiColumnSort = false;
+
+    m_filter = NULL;
 }
 
 bool wxDataViewCtrl::Create(wxWindow *parent,
@@ -5602,6 +6205,14 @@ wxHeaderCtrl* wxDataViewCtrl::GenericGetHeader() const
     return m_headerArea;
 }
 
+void wxDataViewCtrl::SetFilter(wxDataViewFilter* filter)
+{
+    m_filter = filter;
+
+    if ( m_clientArea && GetModel() )
+        m_clientArea->ApplyFilter();
+}
+
 #ifdef __WXMSW__
 WXLRESULT wxDataViewCtrl::MSWWindowProc(WXUINT nMsg,
                                         WXWPARAM wParam,
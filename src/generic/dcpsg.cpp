@@ -31,6 +31,12 @@
 #include "wx/filename.h"
 #include "wx/stdpaths.h"
 
+#if wxUSE_AFM_FOR_POSTSCRIPT
+    #include "wx/hashmap.h"
+    #include "wx/module.h"
+    #include "wx/vector.h"
+#endif
+
 #ifdef __WXMSW__
 
 #ifdef DrawText
@@ -1916,6 +1922,63 @@ void wxPostScriptDCImpl::PsPrint( const wxString& str )
     }
 }
 
+#if wxUSE_AFM_FOR_POSTSCRIPT
+
+namespace
+{
+
+WX_DECLARE_STRING_HASH_MAP(long, wxPSStringWidthMap);
+
+// Metrics parsed from one AFM file, together with a cache of the summed
+// widths of the strings already measured with this font. All the values are
+// expressed in 1/1000 of the font size, so a single entry serves every point
+// size of the same font.
+struct wxPSFontMetrics
+{
+    int family;
+    int style;
+    int weight;
+
+    int widths[256];
+    int descender;
+    double underlinePosition;
+    double underlineThickness;
+
+    wxPSStringWidthMap stringWidths;
+};
+
+// All the AFM files parsed so far: there are only a few (family, style,
+// weight) combinations mapping to different files, so a linear scan is fine.
+wxVector<wxPSFontMetrics*> gs_afmCache;
+
+// Don't let the per-font string width cache grow without bounds if the
+// program measures an unlimited variety of strings.
+const size_t PS_STRING_WIDTH_MAP_MAX_SIZE = 10000;
+
+// Module used to free the cached metrics on library shutdown.
+class wxPSFontMetricsCacheModule : public wxModule
+{
+public:
+    wxPSFontMetricsCacheModule() { }
+
+    bool OnInit() wxOVERRIDE { return true; }
+    void OnExit() wxOVERRIDE
+    {
+        for ( size_t n = 0; n < gs_afmCache.size(); n++ )
+            delete gs_afmCache[n];
+        gs_afmCache.clear();
+    }
+
+private:
+    wxDECLARE_DYNAMIC_CLASS(wxPSFontMetricsCacheModule);
+};
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxPSFontMetricsCacheModule, wxModule);
+
+} // anonymous namespace
+
+#endif // wxUSE_AFM_FOR_POSTSCRIPT
+
 void wxPostScriptDCImpl::DoGetTextExtent(const wxString& string,
                                      wxCoord *x, wxCoord *y,
                                      wxCoord *descent, wxCoord *externalLeading,
@@ -1962,10 +2025,10 @@ void wxPostScriptDCImpl::DoGetTextExtent(const wxString& string,
     /  read in the AFM (adobe font metrics) file for the
     /  actual font, parse it and extract the character widths
     /  and also the descender. this may be improved, but for now
-    /  it works well. the AFM file is only read in if the
-    /  font is changed. this may be chached in the future.
-    /  calls to GetTextExtent with the font unchanged are rather
-    /  efficient!!!
+    /  it works well. each AFM file is only read in once and the
+    /  parsed metrics are kept for the rest of the session, together
+    /  with the summed widths of the strings already measured, so
+    /  repeated calls to GetTextExtent are rather efficient!!!
     /
     /  for each font and style used there is an AFM file necessary.
     /  currently i have only files for the roman font family.
@@ -1996,31 +2059,40 @@ void wxPostScriptDCImpl::DoGetTextExtent(const wxString& string,
     /  created: 10.09.94
     /  updated: 14.05.95 */
 
-    /* these static vars are for storing the state between calls */
-    static int lastFamily= INT_MIN;
-    static int lastSize= INT_MIN;
-    static int lastStyle= INT_MIN;
-    static int lastWeight= INT_MIN;
-    static int lastDescender = INT_MIN;
-    static int lastWidths[256]; /* widths of the characters */
-
-    double UnderlinePosition = 0.0;
-    double UnderlineThickness = 0.0;
-
     // Get actual parameters
     int Family = fontToUse->GetFamily();
-    int Size =   fontToUse->GetPointSize();
     int Style =  fontToUse->GetStyle();
     int Weight = fontToUse->GetWeight();
 
-    // If we have another font, read the font-metrics
-    if (Family!=lastFamily || Size!=lastSize || Style!=lastStyle || Weight!=lastWeight)
+    // Look up the parsed metrics of this font: the widths stored in them are
+    // relative to the font size, so the point size is not part of the key.
+    wxPSFontMetrics *metrics = NULL;
+    for ( size_t n = 0; n < gs_afmCache.size(); n++ )
     {
-        // Store actual values
-        lastFamily = Family;
-        lastSize =   Size;
-        lastStyle =  Style;
-        lastWeight = Weight;
+        wxPSFontMetrics* const m = gs_afmCache[n];
+        if ( m->family == Family && m->style == Style && m->weight == Weight )
+        {
+            metrics = m;
+            break;
+        }
+    }
+
+    // If this font hadn't been used yet, read the font-metrics
+    if ( !metrics )
+    {
+        metrics = new wxPSFontMetrics;
+        metrics->family = Family;
+        metrics->style = Style;
+        metrics->weight = Weight;
+        metrics->descender = INT_MIN;
+        metrics->underlinePosition = 0.0;
+        metrics->underlineThickness = 0.0;
+        gs_afmCache.push_back(metrics);
+
+        int* const lastWidths = metrics->widths;
+        int& lastDescender = metrics->descender;
+        double& UnderlinePosition = metrics->underlinePosition;
+        double& UnderlineThickness = metrics->underlineThickness;
 
         const wxChar *name;
 
@@ -2215,43 +2287,60 @@ void wxPostScriptDCImpl::DoGetTextExtent(const wxString& string,
         lastWidths[252] = lastWidths[(int)'u'];  // U+00FC u Umlaute
         lastWidths[223] = lastWidths[(int)251];  // U+00DF eszett (scharfes s)
 
-        /* JC: calculate UnderlineThickness/UnderlinePosition */
-
-        m_underlinePosition  = YLOG2DEVREL(int(UnderlinePosition  * double(fontSize))) / 1000.0;
-        m_underlineThickness = YLOG2DEVREL(int(UnderlineThickness * double(fontSize))) / 1000.0;
     }
 
+    /* JC: calculate UnderlineThickness/UnderlinePosition */
+
+    m_underlinePosition  = YLOG2DEVREL(int(metrics->underlinePosition  * double(fontSize))) / 1000.0;
+    m_underlineThickness = YLOG2DEVREL(int(metrics->underlineThickness * double(fontSize))) / 1000.0;
+
 
     /* 3. now the font metrics are read in, calc size this
        /  is done by adding the widths of the characters in the
        /  string. they are given in 1/1000 of the size! */
 
-    long sum=0;
+    /* the summed width is relative to the font size just as the individual
+       widths are, so each distinct (font, string) pair only needs to be
+       measured once */
+    long sum;
     float height=fontSize; /* by default */
-    const unsigned char *p=reinterpret_cast<const unsigned char *>(static_cast<const char *>(strbuf));
-    if(!p)
+    wxPSStringWidthMap::const_iterator it = metrics->stringWidths.find(string);
+    if ( it != metrics->stringWidths.end() )
     {
-        // String couldn't be converted which used to SEGV as reported here:
-        // http://bugs.debian.org/702378
-        // https://trac.wxwidgets.org/ticket/15300
-        // Upstream suggests "just return if the conversion failed".
-        if (x) (*x) = 0;
-        if (y) (*y) = 0;
-        if (descent) (*descent) = 0;
-        if (externalLeading) (*externalLeading) = 0;
-        return;
+        sum = it->second;
     }
-    for(; *p; p++)
+    else
     {
-        if(lastWidths[*p]== INT_MIN)
+        sum = 0;
+        const unsigned char *p=reinterpret_cast<const unsigned char *>(static_cast<const char *>(strbuf));
+        if(!p)
         {
-            wxLogDebug(wxT("GetTextExtent: undefined width for character '%c' (%d)"), *p,*p);
-            sum += lastWidths[(unsigned char)' ']; /* assume space */
+            // String couldn't be converted which used to SEGV as reported here:
+            // http://bugs.debian.org/702378
+            // https://trac.wxwidgets.org/ticket/15300
+            // Upstream suggests "just return if the conversion failed".
+            if (x) (*x) = 0;
+            if (y) (*y) = 0;
+            if (descent) (*descent) = 0;
+            if (externalLeading) (*externalLeading) = 0;
+            return;
         }
-        else
+        for(; *p; p++)
         {
-            sum += lastWidths[*p];
+            if(metrics->widths[*p]== INT_MIN)
+            {
+                wxLogDebug(wxT("GetTextExtent: undefined width for character '%c' (%d)"), *p,*p);
+                sum += metrics->widths[(unsigned char)' ']; /* assume space */
+            }
+            else
+            {
+                sum += metrics->widths[*p];
+            }
         }
+
+        if ( metrics->stringWidths.size() >= PS_STRING_WIDTH_MAP_MAX_SIZE )
+            metrics->stringWidths.clear();
+        metrics->stringWidths[string] = sum;
     }
 
     /* add descender to height (it is usually a negative value) */
@@ -2271,9 +2360,9 @@ void wxPostScriptDCImpl::DoGetTextExtent(const wxString& string,
     /* return other parameters */
     if (descent)
     {
-        if(lastDescender!=INT_MIN)
+        if(metrics->descender!=INT_MIN)
         {
-            *descent = (wxCoord)(((-lastDescender)/1000.0F) * fontSize); /* MATTHEW: forgot scale */
+            *descent = (wxCoord)(((-metrics->descender)/1000.0F) * fontSize); /* MATTHEW: forgot scale */
         }
         else
         {
@@ -42,6 +42,7 @@
 #include "wx/dir.h"
 #include "wx/artprov.h"
 #include "wx/mimetype.h"
+#include "wx/wupdlock.h"
 
 #if wxUSE_STATLINE
     #include "wx/statline.h"
@@ -434,6 +435,7 @@ void wxGenericDirCtrl::Init()
     m_currentFilterStr.clear(); // Default: any file
     m_treeCtrl = NULL;
     m_filterListCtrl = NULL;
+    m_useChildListCache = false;
 }
 
 wxTreeCtrl* wxGenericDirCtrl::CreateTreeCtrl(wxWindow *parent, wxWindowID treeid, const wxPoint& pos, const wxSize& size, long treeStyle)
@@ -441,6 +443,14 @@ wxTreeCtrl* wxGenericDirCtrl::CreateTreeCtrl(wxWindow *parent, wxWindowID treeid
     return new wxTreeCtrl(parent, treeid, pos, size, treeStyle);
 }
 
+void wxGenericDirCtrl::EnableChildListCache(bool enable)
+{
+    m_useChildListCache = enable;
+
+    if ( !enable )
+        m_childListCache.clear();
+}
+
 void wxGenericDirCtrl::ShowHidden( bool show )
 {
     if ( m_showHidden == show )
@@ -448,6 +458,9 @@ void wxGenericDirCtrl::ShowHidden( bool show )
 
     m_showHidden = show;
 
+    // the cached child lists were filtered with the old setting
+    m_childListCache.clear();
+
     if ( HasFlag(wxDIRCTRL_MULTIPLE) )
     {
         wxArrayString paths;
@@ -643,6 +656,67 @@ void wxGenericDirCtrl::CollapseDir(wxTreeItemId parentId)
     m_treeCtrl->Thaw();
 }
 
+void
+wxGenericDirCtrl::FindChildren(const wxString& dirName,
+                               wxArrayString& dirs,
+                               wxArrayString& filenames)
+{
+    wxDir d;
+    wxString eachFilename;
+
+    d.Open(dirName);
+
+    if (d.IsOpened())
+    {
+        int style = wxDIR_DIRS;
+        if (m_showHidden) style |= wxDIR_HIDDEN;
+        if (d.GetFirst(& eachFilename, wxEmptyString, style))
+        {
+            do
+            {
+                if ((eachFilename != wxT(".")) && (eachFilename != wxT("..")))
+                {
+                    dirs.Add(eachFilename);
+                }
+            }
+            while (d.GetNext(&eachFilename));
+        }
+    }
+    dirs.Sort(wxDirCtrlStringCompareFunction);
+
+    // Now do the filenames -- but only if we're allowed to
+    if (!HasFlag(wxDIRCTRL_DIR_ONLY))
+    {
+        d.Open(dirName);
+
+        if (d.IsOpened())
+        {
+            int style = wxDIR_FILES;
+            if (m_showHidden) style |= wxDIR_HIDDEN;
+            // Process each filter (ex: "JPEG Files (*.jpg;*.jpeg)|*.jpg;*.jpeg")
+            wxStringTokenizer strTok;
+            wxString curFilter;
+            strTok.SetString(m_currentFilterStr,wxT(";"));
+            while(strTok.HasMoreTokens())
+            {
+                curFilter = strTok.GetNextToken();
+                if (d.GetFirst(& eachFilename, curFilter, style))
+                {
+                    do
+                    {
+                        if ((eachFilename != wxT(".")) && (eachFilename != wxT("..")))
+                        {
+                            filenames.Add(eachFilename);
+                        }
+                    }
+                    while (d.GetNext(& eachFilename));
+                }
+            }
+        }
+        filenames.Sort(wxDirCtrlStringCompareFunction);
+    }
+}
+
 void wxGenericDirCtrl::PopulateNode(wxTreeItemId parentId)
 {
     wxDirItemData *data = GetItemData(parentId);
@@ -686,62 +760,57 @@ void wxGenericDirCtrl::PopulateNode(wxTreeItemId parentId)
     wxArrayString dirs;
     wxArrayString filenames;
 
-    wxDir d;
     wxString eachFilename;
 
     wxLogNull log;
-    d.Open(dirName);
 
-    if (d.IsOpened())
+    // If we visited this directory recently and it hasn't changed since then,
+    // reuse the last enumeration result: a single stat() is much cheaper than
+    // a full enumeration, especially for remote file systems.
+    bool listsValid = false;
+    time_t mtime = 0;
+    if ( m_useChildListCache )
     {
-        int style = wxDIR_DIRS;
-        if (m_showHidden) style |= wxDIR_HIDDEN;
-        if (d.GetFirst(& eachFilename, wxEmptyString, style))
+        mtime = wxFileModificationTime(dirName);
+
+        wxDirCtrlChildListsMap::iterator it = m_childListCache.find(dirName);
+        if ( it != m_childListCache.end() )
         {
-            do
+            if ( mtime != 0 && it->second.mtime == mtime )
             {
-                if ((eachFilename != wxT(".")) && (eachFilename != wxT("..")))
-                {
-                    dirs.Add(eachFilename);
-                }
+                dirs = it->second.dirs;
+                filenames = it->second.filenames;
+                listsValid = true;
+            }
+            else // stale entry
+            {
+                m_childListCache.erase(it);
             }
-            while (d.GetNext(&eachFilename));
         }
     }
-    dirs.Sort(wxDirCtrlStringCompareFunction);
 
-    // Now do the filenames -- but only if we're allowed to
-    if (!HasFlag(wxDIRCTRL_DIR_ONLY))
+    if ( !listsValid )
     {
-        d.Open(dirName);
+        FindChildren(dirName, dirs, filenames);
 
-        if (d.IsOpened())
+        if ( m_useChildListCache && mtime != 0 )
         {
-            int style = wxDIR_FILES;
-            if (m_showHidden) style |= wxDIR_HIDDEN;
-            // Process each filter (ex: "JPEG Files (*.jpg;*.jpeg)|*.jpg;*.jpeg")
-            wxStringTokenizer strTok;
-            wxString curFilter;
-            strTok.SetString(m_currentFilterStr,wxT(";"));
-            while(strTok.HasMoreTokens())
-            {
-                curFilter = strTok.GetNextToken();
-                if (d.GetFirst(& eachFilename, curFilter, style))
-                {
-                    do
-                    {
-                        if ((eachFilename != wxT(".")) && (eachFilename != wxT("..")))
-                        {
-                            filenames.Add(eachFilename);
-                        }
-                    }
-                    while (d.GetNext(& eachFilename));
-                }
-            }
+            // don't let the cache grow without bounds in very long-lived
+            // controls
+            if ( m_childListCache.size() >= 200 )
+                m_childListCache.clear();
+
+            wxDirCtrlChildLists& lists = m_childListCache[dirName];
+            lists.mtime = mtime;
+            lists.dirs = dirs;
+            lists.filenames = filenames;
         }
-        filenames.Sort(wxDirCtrlStringCompareFunction);
     }
 
+    // Don't redraw the tree after each item addition below but just once at
+    // the end, adding many children one by one is visibly slow otherwise.
+    wxWindowUpdateLocker lockUpdates(m_treeCtrl);
+
     // Now we really know whether we have any children so tell the tree control
     // about it.
     m_treeCtrl->SetItemHasChildren(parentId, !dirs.empty() || !filenames.empty());
@@ -1134,6 +1203,9 @@ void wxGenericDirCtrl::SetFilterIndex(int n)
 #else
         m_currentFilterStr = wxT("*.*");
 #endif
+
+    // the cached child lists correspond to the previous filter
+    m_childListCache.clear();
 }
 
 void wxGenericDirCtrl::SetFilter(const wxString& filter)
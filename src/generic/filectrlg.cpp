@@ -361,14 +361,25 @@ wxBEGIN_EVENT_TABLE(wxFileListCtrl,wxListCtrl)
     EVT_LIST_END_LABEL_EDIT(wxID_ANY, wxFileListCtrl::OnListEndLabelEdit)
     EVT_LIST_COL_CLICK(wxID_ANY, wxFileListCtrl::OnListColClick)
     EVT_SIZE (wxFileListCtrl::OnSize)
+    EVT_TIMER (wxID_ANY, wxFileListCtrl::OnUpdateTimer)
 wxEND_EVENT_TABLE()
 
+// number of entries added to the list control in one go: the first chunk is
+// added directly from UpdateFiles() and the following ones, if any, from a
+// timer event each
+static const size_t wxFILE_LIST_UPDATE_CHUNK = 1000;
 
 wxFileListCtrl::wxFileListCtrl()
 {
     m_showHidden = false;
     m_sort_forward = true;
     m_sort_field = wxFileData::FileList_Name;
+
+    m_updateDir = NULL;
+    m_updateFlags = 0;
+    m_updateEnumDirs = false;
+    m_updateEnumStarted = false;
+    m_updateTimer.SetOwner(this);
 }
 
 wxFileListCtrl::wxFileListCtrl(wxWindow *win,
@@ -392,6 +403,12 @@ wxFileListCtrl::wxFileListCtrl(wxWindow *win,
     m_sort_forward = true;
     m_sort_field = wxFileData::FileList_Name;
 
+    m_updateDir = NULL;
+    m_updateFlags = 0;
+    m_updateEnumDirs = false;
+    m_updateEnumStarted = false;
+    m_updateTimer.SetOwner(this);
+
     m_dirName = wxT("*");
 
     if (style & wxLC_REPORT)
@@ -489,6 +506,8 @@ void wxFileListCtrl::UpdateFiles()
 
     wxBusyCursor bcur; // this may take a while...
 
+    AbortPendingUpdate();
+
     DeleteAllItems();
 
     wxListItem item;
@@ -550,54 +569,130 @@ void wxFileListCtrl::UpdateFiles()
             dirname = wxFILE_SEP_PATH;
 
         wxLogNull logNull;
-        wxDir dir(dirname);
+        wxDir *dir = new wxDir(dirname);
 
-        if ( dir.IsOpened() )
+        if ( dir->IsOpened() )
         {
-            wxString dirPrefix(dirname);
-            if (dirPrefix.Last() != wxFILE_SEP_PATH)
-                dirPrefix += wxFILE_SEP_PATH;
+            m_updateDir = dir;
 
-            int hiddenFlag = m_showHidden ? wxDIR_HIDDEN : 0;
+            m_updatePrefix = dirname;
+            if (m_updatePrefix.Last() != wxFILE_SEP_PATH)
+                m_updatePrefix += wxFILE_SEP_PATH;
 
-            bool cont;
-            wxString f;
+            m_updateFlags = m_showHidden ? wxDIR_HIDDEN : 0;
 
-            // Get the directories first (not matched against wildcards):
-            cont = dir.GetFirst(&f, wxEmptyString, wxDIR_DIRS | hiddenFlag);
-            while (cont)
-            {
-                wxFileData *fd = new wxFileData(dirPrefix + f, f, wxFileData::is_dir, wxFileIconsTable::folder);
-                if (Add(fd, item) != -1)
-                    item.m_itemId++;
-                else
-                    delete fd;
-
-                cont = dir.GetNext(&f);
-            }
+            // The directories are enumerated first (not matched against
+            // wildcards), the files matching each wildcard afterwards.
+            m_updateEnumDirs = true;
+            m_updateEnumStarted = false;
 
             // Tokenize the wildcard string, so we can handle more than 1
             // search pattern in a wildcard.
+            m_updateWild.clear();
             wxStringTokenizer tokenWild(m_wild, wxT(";"));
             while ( tokenWild.HasMoreTokens() )
+                m_updateWild.push_back(tokenWild.GetNextToken());
+
+            // Add the first chunk of entries directly: small directories are
+            // fully shown on return from here, as before, while huge ones
+            // continue to be populated from timer events so that the UI stays
+            // responsive while they load.
+            DoUpdateChunk(wxFILE_LIST_UPDATE_CHUNK);
+        }
+        else
+        {
+            delete dir;
+        }
+    }
+
+    if ( m_updateDir )
+        m_updateTimer.StartOnce(1);
+    else
+        SortItems(m_sort_field, m_sort_forward);
+}
+
+void wxFileListCtrl::AbortPendingUpdate()
+{
+    m_updateTimer.Stop();
+    wxDELETE(m_updateDir);
+}
+
+bool wxFileListCtrl::DoUpdateChunk(size_t maxEntries)
+{
+    if ( !m_updateDir )
+        return true;
+
+    wxLogNull logNull;
+
+    wxListItem item;
+    item.m_itemId = GetItemCount();
+    item.m_col = 0;
+
+    size_t added = 0;
+    wxString f;
+    for ( ;; )
+    {
+        bool cont;
+        if ( !m_updateEnumStarted )
+        {
+            if ( m_updateEnumDirs )
+            {
+                cont = m_updateDir->GetFirst(&f, wxEmptyString,
+                                             wxDIR_DIRS | m_updateFlags);
+            }
+            else if ( !m_updateWild.empty() )
+            {
+                cont = m_updateDir->GetFirst(&f, m_updateWild[0],
+                                             wxDIR_FILES | m_updateFlags);
+            }
+            else // nothing left to enumerate
             {
-                cont = dir.GetFirst(&f, tokenWild.GetNextToken(),
-                                        wxDIR_FILES | hiddenFlag);
-                while (cont)
-                {
-                    wxFileData *fd = new wxFileData(dirPrefix + f, f, wxFileData::is_file, wxFileIconsTable::file);
-                    if (Add(fd, item) != -1)
-                        item.m_itemId++;
-                    else
-                        delete fd;
-
-                    cont = dir.GetNext(&f);
-                }
+                wxDELETE(m_updateDir);
+                return true;
             }
+
+            m_updateEnumStarted = true;
+        }
+        else // continue the enumeration started during an earlier call
+        {
+            cont = m_updateDir->GetNext(&f);
         }
+
+        if ( !cont )
+        {
+            // This phase is exhausted, switch to the next one.
+            m_updateEnumStarted = false;
+            if ( m_updateEnumDirs )
+                m_updateEnumDirs = false;
+            else
+                m_updateWild.RemoveAt(0);
+            continue;
+        }
+
+        wxFileData *fd;
+        if ( m_updateEnumDirs )
+            fd = new wxFileData(m_updatePrefix + f, f, wxFileData::is_dir,
+                                wxFileIconsTable::folder);
+        else
+            fd = new wxFileData(m_updatePrefix + f, f, wxFileData::is_file,
+                                wxFileIconsTable::file);
+
+        if (Add(fd, item) != -1)
+            item.m_itemId++;
+        else
+            delete fd;
+
+        if ( ++added == maxEntries )
+            return false;
     }
+}
 
-    SortItems(m_sort_field, m_sort_forward);
+void wxFileListCtrl::OnUpdateTimer(wxTimerEvent& WXUNUSED(event))
+{
+    if ( DoUpdateChunk(wxFILE_LIST_UPDATE_CHUNK) )
+        SortItems(m_sort_field, m_sort_forward);
+    else
+        m_updateTimer.StartOnce(1);
 }
 
 void wxFileListCtrl::SetWild( const wxString &wild )
@@ -854,6 +949,8 @@ void wxFileListCtrl::SortItems(wxFileData::fileListFieldType field, bool forward
 
 wxFileListCtrl::~wxFileListCtrl()
 {
+    AbortPendingUpdate();
+
     // Normally the data are freed via an EVT_LIST_DELETE_ALL_ITEMS event and
     // wxFileListCtrl::OnListDeleteAllItems. But if the event is generated after
     // the destruction of the wxFileListCtrl we need to free any data here:
@@ -38,6 +38,7 @@ bool wxCairoInit();
 #endif
 
 #include "wx/private/graphics.h"
+#include "wx/module.h"
 #include "wx/rawbmp.h"
 #include "wx/vector.h"
 #ifdef __WXMSW__
@@ -153,6 +154,9 @@ public :
     // closes the current sub-path
     virtual void CloseSubpath() wxOVERRIDE;
 
+    // removes all points and subpaths, retaining the path context
+    virtual void Clear() wxOVERRIDE;
+
     //
     // These are convenience functions which - if not available natively will be assembled
     // using the primitives from above
@@ -1222,6 +1226,69 @@ void wxCairoFontData::Apply( wxGraphicsContext* context )
 // wxCairoPathData implementation
 //-----------------------------------------------------------------------------
 
+namespace
+{
+
+// Pool of contexts reused by wxCairoPathData: creating a cairo context just
+// to build a path in it is relatively expensive and applications drawing
+// many small paths, e.g. plot markers, create and destroy huge numbers of
+// them per frame.
+wxVector<cairo_t*> gs_pathContextPool;
+
+// Bounds the memory kept alive by the pool.
+const size_t PATH_CONTEXT_POOL_MAX_SIZE = 64;
+
+cairo_t* AcquirePathContext()
+{
+    if ( !gs_pathContextPool.empty() )
+    {
+        cairo_t* const context = gs_pathContextPool.back();
+        gs_pathContextPool.pop_back();
+        return context;
+    }
+
+    cairo_surface_t* surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32,1,1);
+    cairo_t* const context = cairo_create(surface);
+    cairo_surface_destroy (surface);
+    return context;
+}
+
+void ReleasePathContext(cairo_t* context)
+{
+    if ( gs_pathContextPool.size() < PATH_CONTEXT_POOL_MAX_SIZE )
+    {
+        cairo_new_path(context);
+        gs_pathContextPool.push_back(context);
+    }
+    else
+    {
+        cairo_destroy(context);
+    }
+}
+
+// Module ensuring the pooled contexts are destroyed on library shutdown,
+// while the cairo library itself is still loaded.
+class wxCairoPathPoolModule : public wxModule
+{
+public:
+    wxCairoPathPoolModule() { }
+
+    bool OnInit() wxOVERRIDE { return true; }
+    void OnExit() wxOVERRIDE
+    {
+        for ( size_t n = 0; n < gs_pathContextPool.size(); n++ )
+            cairo_destroy(gs_pathContextPool[n]);
+        gs_pathContextPool.clear();
+    }
+
+private:
+    wxDECLARE_DYNAMIC_CLASS(wxCairoPathPoolModule);
+};
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxCairoPathPoolModule, wxModule);
+
+} // anonymous namespace
+
 wxCairoPathData::wxCairoPathData( wxGraphicsRenderer* renderer, cairo_t* pathcontext)
     : wxGraphicsPathData(renderer)
 {
@@ -1231,22 +1298,18 @@ wxCairoPathData::wxCairoPathData( wxGraphicsRenderer* renderer, cairo_t* pathcon
     }
     else
     {
-        cairo_surface_t* surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32,1,1);
-        m_pathContext = cairo_create(surface);
-        cairo_surface_destroy (surface);
+        m_pathContext = AcquirePathContext();
     }
 }
 
 wxCairoPathData::~wxCairoPathData()
 {
-    cairo_destroy(m_pathContext);
+    ReleasePathContext(m_pathContext);
 }
 
 wxGraphicsObjectRefData *wxCairoPathData::Clone() const
 {
-    cairo_surface_t* surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32,1,1);
-    cairo_t* pathcontext = cairo_create(surface);
-    cairo_surface_destroy (surface);
+    cairo_t* pathcontext = AcquirePathContext();
 
     cairo_path_t* path = cairo_copy_path(m_pathContext);
     cairo_append_path(pathcontext, path);
@@ -1291,6 +1354,11 @@ void wxCairoPathData::CloseSubpath()
     cairo_close_path(m_pathContext);
 }
 
+void wxCairoPathData::Clear()
+{
+    cairo_new_path(m_pathContext);
+}
+
 void wxCairoPathData::AddCurveToPoint( wxDouble cx1, wxDouble cy1, wxDouble cx2, wxDouble cy2, wxDouble x, wxDouble y )
 {
     cairo_curve_to(m_pathContext,cx1,cy1,cx2,cy2,x,y);
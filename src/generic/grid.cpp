@@ -63,6 +63,11 @@ const char wxGridNameStr[] = "grid";
 WX_DECLARE_HASH_SET_WITH_DECL_PTR(int, wxIntegerHash, wxIntegerEqual,
                                   wxGridFixedIndicesSet, class WXDLLIMPEXP_ADV);
 
+// set of cells scheduled for repainting, keyed by CoordsToKey() below: used
+// by DrawGridCellArea() to avoid searching the coordinate arrays linearly
+WX_DECLARE_HASH_SET(wxLongLong_t, wxIntegerHash, wxIntegerEqual,
+                    wxGridCellKeySet);
+
 
 // ----------------------------------------------------------------------------
 // globals
@@ -454,6 +459,30 @@ wxGridCellAttr *wxGridCellAttr::Clone() const
     return attr;
 }
 
+bool wxGridCellAttr::IsSameAs(const wxGridCellAttr& other) const
+{
+    // compare the fonts first checking their validity: comparing an invalid
+    // font with a valid one is not supported by wxFont itself
+    if ( m_font.IsOk() != other.m_font.IsOk() )
+        return false;
+
+    if ( m_font.IsOk() && m_font != other.m_font )
+        return false;
+
+    return m_colText == other.m_colText &&
+           m_colBack == other.m_colBack &&
+           m_hAlign == other.m_hAlign &&
+           m_vAlign == other.m_vAlign &&
+           m_sizeRows == other.m_sizeRows &&
+           m_sizeCols == other.m_sizeCols &&
+           m_fitMode == other.m_fitMode &&
+           m_renderer == other.m_renderer &&
+           m_editor == other.m_editor &&
+           m_defGridAttr == other.m_defGridAttr &&
+           m_isReadOnly == other.m_isReadOnly &&
+           m_attrkind == other.m_attrkind;
+}
+
 void wxGridCellAttr::MergeWith(wxGridCellAttr *mergefrom)
 {
     if ( !HasTextColour() && mergefrom->HasTextColour() )
@@ -1130,6 +1159,455 @@ void wxGridRowOrColAttrData::UpdateAttrRowsOrCols( size_t pos, int numRowsOrCols
     }
 }
 
+// ----------------------------------------------------------------------------
+// wxGridRowOrColIntervalAttrData
+// ----------------------------------------------------------------------------
+
+wxGridRowOrColIntervalAttrData::~wxGridRowOrColIntervalAttrData()
+{
+    for ( size_t n = 0; n < m_intervals.size(); n++ )
+    {
+        m_intervals[n].attr->DecRef();
+    }
+}
+
+size_t wxGridRowOrColIntervalAttrData::FindInterval(int rowOrCol) const
+{
+    // binary search for the first interval ending at or after rowOrCol
+    size_t lo = 0,
+           hi = m_intervals.size();
+    while ( lo < hi )
+    {
+        const size_t mid = (lo + hi) / 2;
+        if ( m_intervals[mid].last < rowOrCol )
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+wxGridCellAttr *wxGridRowOrColIntervalAttrData::GetAttr(int rowOrCol) const
+{
+    wxGridCellAttr *attr = NULL;
+
+    const size_t n = FindInterval(rowOrCol);
+    if ( n < m_intervals.size() && m_intervals[n].first <= rowOrCol )
+    {
+        attr = m_intervals[n].attr;
+        attr->IncRef();
+    }
+
+    return attr;
+}
+
+void wxGridRowOrColIntervalAttrData::SetAttr(wxGridCellAttr *attr,
+                                             int first, int last)
+{
+    wxCHECK_RET( first >= 0 && first <= last,
+                 wxT("invalid attribute interval") );
+
+    // start with carving [first, last] out of any existing intervals
+    // overlapping it
+    size_t n = FindInterval(first);
+    while ( n < m_intervals.size() && m_intervals[n].first <= last )
+    {
+        wxGridAttrInterval& iv = m_intervals[n];
+        if ( iv.first < first )
+        {
+            if ( iv.last > last )
+            {
+                // the interval extends beyond the new one at both ends, so
+                // it must be split in two
+                wxGridAttrInterval tail = iv;
+                tail.first = last + 1;
+                tail.attr->IncRef();
+                iv.last = first - 1;
+                m_intervals.insert(m_intervals.begin() + n + 1, tail);
+            }
+            else // only trim its end
+            {
+                iv.last = first - 1;
+            }
+
+            n++;
+        }
+        else if ( iv.last > last )
+        {
+            // trim its start, which also ends the scan as the intervals are
+            // sorted
+            iv.first = last + 1;
+        }
+        else // the interval lies entirely inside [first, last]
+        {
+            iv.attr->DecRef();
+            m_intervals.erase(m_intervals.begin() + n);
+        }
+    }
+
+    if ( attr )
+    {
+        n = FindInterval(first);
+
+        // coalesce with the neighbouring intervals if they use the same
+        // attribute to keep the storage minimal
+        int newFirst = first,
+            newLast = last;
+        if ( n > 0 && m_intervals[n - 1].attr == attr &&
+                m_intervals[n - 1].last == first - 1 )
+        {
+            n--;
+            newFirst = m_intervals[n].first;
+            m_intervals[n].attr->DecRef();
+            m_intervals.erase(m_intervals.begin() + n);
+        }
+
+        if ( n < m_intervals.size() && m_intervals[n].attr == attr &&
+                m_intervals[n].first == last + 1 )
+        {
+            newLast = m_intervals[n].last;
+            m_intervals[n].attr->DecRef();
+            m_intervals.erase(m_intervals.begin() + n);
+        }
+
+        // store the new interval, taking ownership of the attribute
+        m_intervals.insert(m_intervals.begin() + n,
+                           wxGridAttrInterval(newFirst, newLast, attr));
+    }
+}
+
+void
+wxGridRowOrColIntervalAttrData::UpdateAttrRowsOrCols( size_t pos,
+                                                      int numRowsOrCols )
+{
+    const int p = (int)pos;
+    for ( size_t n = 0; n < m_intervals.size(); n++ )
+    {
+        wxGridAttrInterval& iv = m_intervals[n];
+        if ( numRowsOrCols > 0 )
+        {
+            // If rows or cols inserted, shift the interval ends where
+            // necessary; notice that an insertion strictly inside an interval
+            // extends it, so that the new rows or columns inherit the
+            // attribute of the band they appear in.
+            if ( iv.first >= p )
+                iv.first += numRowsOrCols;
+            if ( iv.last >= p )
+                iv.last += numRowsOrCols;
+        }
+        else if ( numRowsOrCols < 0 )
+        {
+            // If rows/cols deleted, shrink or shift the interval and remove
+            // it entirely if nothing is left of it.
+            const int numDeleted = -numRowsOrCols;
+            if ( iv.first >= p )
+                iv.first = wxMax(iv.first - numDeleted, p);
+            if ( iv.last >= p )
+            {
+                iv.last = iv.last >= p + numDeleted ? iv.last - numDeleted
+                                                    : p - 1;
+            }
+
+            if ( iv.first > iv.last )
+            {
+                iv.attr->DecRef();
+                m_intervals.erase(m_intervals.begin() + n);
+                n--;
+            }
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// wxGridBlockAttrData
+// ----------------------------------------------------------------------------
+
+wxGridBlockAttrData::~wxGridBlockAttrData()
+{
+    for ( size_t n = 0; n < m_blocks.size(); n++ )
+    {
+        m_blocks[n].attr->DecRef();
+    }
+}
+
+void wxGridBlockAttrData::SetAttr(wxGridCellAttr *attr,
+                                  int topRow, int leftCol,
+                                  int bottomRow, int rightCol)
+{
+    wxCHECK_RET( topRow >= 0 && topRow <= bottomRow &&
+                 leftCol >= 0 && leftCol <= rightCol,
+                 wxT("invalid attribute block") );
+
+    // setting an attribute for exactly the same block replaces (or, for a
+    // NULL attribute, removes) the old one
+    for ( size_t n = 0; n < m_blocks.size(); n++ )
+    {
+        wxGridAttrBlock& block = m_blocks[n];
+        if ( block.topRow == topRow && block.leftCol == leftCol &&
+                block.bottomRow == bottomRow && block.rightCol == rightCol )
+        {
+            // See note near DecRef() in wxGridRowOrColAttrData::SetAttr for
+            // why this also works when old and new attribute are the same.
+            block.attr->DecRef();
+
+            if ( attr )
+                block.attr = attr;
+            else
+                m_blocks.erase(m_blocks.begin() + n);
+
+            return;
+        }
+    }
+
+    if ( attr )
+    {
+        // store the new block, taking ownership of the attribute
+        wxGridAttrBlock block;
+        block.topRow = topRow;
+        block.leftCol = leftCol;
+        block.bottomRow = bottomRow;
+        block.rightCol = rightCol;
+        block.attr = attr;
+        m_blocks.push_back(block);
+    }
+}
+
+wxGridCellAttr *wxGridBlockAttrData::GetAttr(int row, int col) const
+{
+    // scan from the end so that the most recently set block wins for the
+    // cells covered by several blocks
+    for ( size_t n = m_blocks.size(); n > 0; n-- )
+    {
+        const wxGridAttrBlock& block = m_blocks[n - 1];
+        if ( row >= block.topRow && row <= block.bottomRow &&
+                col >= block.leftCol && col <= block.rightCol )
+        {
+            block.attr->IncRef();
+            return block.attr;
+        }
+    }
+
+    return NULL;
+}
+
+void wxGridBlockAttrData::UpdateAttrRows( size_t pos, int numRows )
+{
+    const int p = (int)pos;
+    for ( size_t n = 0; n < m_blocks.size(); n++ )
+    {
+        wxGridAttrBlock& block = m_blocks[n];
+        if ( numRows > 0 )
+        {
+            if ( block.topRow >= p )
+                block.topRow += numRows;
+            if ( block.bottomRow >= p )
+                block.bottomRow += numRows;
+        }
+        else if ( numRows < 0 )
+        {
+            const int numDeleted = -numRows;
+            if ( block.topRow >= p )
+                block.topRow = wxMax(block.topRow - numDeleted, p);
+            if ( block.bottomRow >= p )
+            {
+                block.bottomRow = block.bottomRow >= p + numDeleted
+                                    ? block.bottomRow - numDeleted
+                                    : p - 1;
+            }
+
+            if ( block.topRow > block.bottomRow )
+            {
+                block.attr->DecRef();
+                m_blocks.erase(m_blocks.begin() + n);
+                n--;
+            }
+        }
+    }
+}
+
+void wxGridBlockAttrData::UpdateAttrCols( size_t pos, int numCols )
+{
+    const int p = (int)pos;
+    for ( size_t n = 0; n < m_blocks.size(); n++ )
+    {
+        wxGridAttrBlock& block = m_blocks[n];
+        if ( numCols > 0 )
+        {
+            if ( block.leftCol >= p )
+                block.leftCol += numCols;
+            if ( block.rightCol >= p )
+                block.rightCol += numCols;
+        }
+        else if ( numCols < 0 )
+        {
+            const int numDeleted = -numCols;
+            if ( block.leftCol >= p )
+                block.leftCol = wxMax(block.leftCol - numDeleted, p);
+            if ( block.rightCol >= p )
+            {
+                block.rightCol = block.rightCol >= p + numDeleted
+                                    ? block.rightCol - numDeleted
+                                    : p - 1;
+            }
+
+            if ( block.leftCol > block.rightCol )
+            {
+                block.attr->DecRef();
+                m_blocks.erase(m_blocks.begin() + n);
+                n--;
+            }
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// wxGridMergedAttrCache
+// ----------------------------------------------------------------------------
+
+void wxGridMergedAttrCache::Disable()
+{
+    wxCHECK_RET( m_enableCount, wxT("unbalanced attribute caching calls") );
+
+    if ( !--m_enableCount )
+        Clear();
+}
+
+wxGridCellAttr *wxGridMergedAttrCache::Find(const wxGridCellAttr *cell,
+                                            const wxGridCellAttr *block,
+                                            const wxGridCellAttr *col,
+                                            const wxGridCellAttr *row) const
+{
+    // a linear scan is fine here: a repainted area rarely uses more than a
+    // handful of distinct attribute combinations
+    for ( size_t n = 0; n < m_entries.size(); n++ )
+    {
+        const wxGridMergedAttrEntry& entry = m_entries[n];
+        if ( entry.cell == cell && entry.block == block &&
+                entry.col == col && entry.row == row )
+        {
+            entry.merged->IncRef();
+            return entry.merged;
+        }
+    }
+
+    return NULL;
+}
+
+void wxGridMergedAttrCache::Add(const wxGridCellAttr *cell,
+                                const wxGridCellAttr *block,
+                                const wxGridCellAttr *col,
+                                const wxGridCellAttr *row,
+                                wxGridCellAttr *merged)
+{
+    wxGridMergedAttrEntry entry;
+    entry.cell = cell;
+    entry.block = block;
+    entry.col = col;
+    entry.row = row;
+    entry.merged = merged;
+    merged->IncRef();
+
+    m_entries.push_back(entry);
+}
+
+void wxGridMergedAttrCache::Clear()
+{
+    for ( size_t n = 0; n < m_entries.size(); n++ )
+    {
+        m_entries[n].merged->DecRef();
+    }
+
+    m_entries.clear();
+}
+
+// ----------------------------------------------------------------------------
+// wxGridAttrInternPool
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// don't let the pool grow without bound if the program really does use a huge
+// number of distinct attributes: scanning it linearly would become slower
+// than just storing the duplicates
+const size_t wxGRID_ATTR_POOL_MAX_SIZE = 256;
+
+} // anonymous namespace
+
+wxGridAttrInternPool::~wxGridAttrInternPool()
+{
+    for ( size_t n = 0; n < m_attrs.GetCount(); n++ )
+    {
+        m_attrs[n]->DecRef();
+    }
+}
+
+wxGridCellAttr *wxGridAttrInternPool::Intern(wxGridCellAttr *attr)
+{
+    if ( !attr->CanBeShared() )
+        return attr;
+
+    // as with the merged attributes cache, a linear scan is good enough
+    // here: even a heavily styled grid rarely uses more than a handful of
+    // distinct attributes
+    for ( size_t n = 0; n < m_attrs.GetCount(); n++ )
+    {
+        wxGridCellAttr * const canon = m_attrs[n];
+        if ( canon == attr )
+            return attr;
+
+        if ( canon->IsSameAs(*attr) )
+        {
+            canon->IncRef();
+            attr->DecRef();
+            return canon;
+        }
+    }
+
+    if ( m_attrs.GetCount() >= wxGRID_ATTR_POOL_MAX_SIZE )
+    {
+        Prune();
+
+        if ( m_attrs.GetCount() >= wxGRID_ATTR_POOL_MAX_SIZE )
+            return attr;
+    }
+
+    attr->IncRef();
+    m_attrs.Add(attr);
+
+    return attr;
+}
+
+bool wxGridAttrInternPool::Contains(const wxGridCellAttr *attr) const
+{
+    for ( size_t n = 0; n < m_attrs.GetCount(); n++ )
+    {
+        if ( m_attrs[n] == attr )
+            return true;
+    }
+
+    return false;
+}
+
+void wxGridAttrInternPool::Prune()
+{
+    for ( size_t n = 0; n < m_attrs.GetCount(); )
+    {
+        wxGridCellAttr * const canon = m_attrs[n];
+        if ( canon->GetRefCount() == 1 )
+        {
+            // only the pool itself still references it
+            canon->DecRef();
+            m_attrs.RemoveAt(n);
+        }
+        else
+        {
+            n++;
+        }
+    }
+}
+
 // ----------------------------------------------------------------------------
 // wxGridCellAttrProvider
 // ----------------------------------------------------------------------------
@@ -1158,43 +1636,67 @@ wxGridCellAttr *wxGridCellAttrProvider::GetAttr(int row, int col,
         switch (kind)
         {
             case (wxGridCellAttr::Any):
-                // Get cached merge attributes.
-                // Currently not used as no cache implemented as not mutable
-                // attr = m_data->m_mergeAttr.GetAttr(row, col);
-                if (!attr)
                 {
-                    // Basically implement old version.
-                    // Also check merge cache, so we don't have to re-merge every time..
+                    // Get all the attributes applying to this cell: the more
+                    // specific single row/column attributes take precedence
+                    // over the interval ones.
                     wxGridCellAttr *attrcell = m_data->m_cellAttrs.GetAttr(row, col);
+                    wxGridCellAttr *attrblock = m_data->m_blockAttrs.GetAttr(row, col);
                     wxGridCellAttr *attrrow = m_data->m_rowAttrs.GetAttr(row);
+                    if (!attrrow)
+                        attrrow = m_data->m_rowIntervalAttrs.GetAttr(row);
                     wxGridCellAttr *attrcol = m_data->m_colAttrs.GetAttr(col);
-
-                    if ((attrcell != attrrow) && (attrrow != attrcol) && (attrcell != attrcol))
+                    if (!attrcol)
+                        attrcol = m_data->m_colIntervalAttrs.GetAttr(col);
+
+                    int numFound = 0;
+                    if (attrcell)
+                        numFound++;
+                    if (attrblock)
+                        numFound++;
+                    if (attrcol)
+                        numFound++;
+                    if (attrrow)
+                        numFound++;
+
+                    if (numFound > 1)
                     {
-                        // Two or more are non NULL
-                        attr = new wxGridCellAttr;
-                        attr->SetKind(wxGridCellAttr::Merged);
+                        // Two or more are non NULL, so a merged attribute is
+                        // needed. While repainting, the same combination
+                        // recurs for every cell of an identically styled
+                        // region, so check the cache of the merged attributes
+                        // first instead of re-merging every time.
+                        wxGridMergedAttrCache& cache = m_data->m_mergedAttrs;
+                        if ( cache.IsEnabled() )
+                            attr = cache.Find(attrcell, attrblock, attrcol, attrrow);
+
+                        if (!attr)
+                        {
+                            attr = new wxGridCellAttr;
+                            attr->SetKind(wxGridCellAttr::Merged);
+
+                            // Order is important..
+                            if (attrcell)
+                                attr->MergeWith(attrcell);
+                            if (attrblock)
+                                attr->MergeWith(attrblock);
+                            if (attrcol)
+                                attr->MergeWith(attrcol);
+                            if (attrrow)
+                                attr->MergeWith(attrrow);
+
+                            if ( cache.IsEnabled() )
+                                cache.Add(attrcell, attrblock, attrcol, attrrow, attr);
+                        }
 
-                        // Order is important..
                         if (attrcell)
-                        {
-                            attr->MergeWith(attrcell);
                             attrcell->DecRef();
-                        }
+                        if (attrblock)
+                            attrblock->DecRef();
                         if (attrcol)
-                        {
-                            attr->MergeWith(attrcol);
                             attrcol->DecRef();
-                        }
                         if (attrrow)
-                        {
-                            attr->MergeWith(attrrow);
                             attrrow->DecRef();
-                        }
-
-                        // store merge attr if cache implemented
-                        //attr->IncRef();
-                        //m_data->m_mergeAttr.SetAttr(attr, row, col);
                     }
                     else
                     {
@@ -1202,17 +1704,11 @@ wxGridCellAttr *wxGridCellAttrProvider::GetAttr(int row, int col,
                         if (attrrow)
                             attr = attrrow;
                         if (attrcol)
-                        {
-                            if (attr)
-                                attr->DecRef();
                             attr = attrcol;
-                        }
+                        if (attrblock)
+                            attr = attrblock;
                         if (attrcell)
-                        {
-                            if (attr)
-                                attr->DecRef();
                             attr = attrcell;
-                        }
                     }
                 }
                 break;
@@ -1223,10 +1719,14 @@ wxGridCellAttr *wxGridCellAttrProvider::GetAttr(int row, int col,
 
             case (wxGridCellAttr::Col):
                 attr = m_data->m_colAttrs.GetAttr(col);
+                if (!attr)
+                    attr = m_data->m_colIntervalAttrs.GetAttr(col);
                 break;
 
             case (wxGridCellAttr::Row):
                 attr = m_data->m_rowAttrs.GetAttr(row);
+                if (!attr)
+                    attr = m_data->m_rowIntervalAttrs.GetAttr(row);
                 break;
 
             default:
@@ -1246,14 +1746,52 @@ void wxGridCellAttrProvider::SetAttr(wxGridCellAttr *attr,
     if ( !m_data )
         InitData();
 
+    // intern the attribute so that setting equal attributes for many cells
+    // one by one shares a single object between all of them: this is only
+    // done for the individual cell attributes because they are the only ones
+    // which can realistically number in the thousands, the row, column and
+    // block attributes are few by construction
+    if ( attr )
+        attr = m_data->m_attrPool.Intern(attr);
+
+    m_data->m_mergedAttrs.Clear();
     m_data->m_cellAttrs.SetAttr(attr, row, col);
 }
 
+wxGridCellAttr *
+wxGridCellAttrProvider::UnshareAttr(wxGridCellAttr *attr, int row, int col)
+{
+    // the attribute can only be shared if it's one of the pooled canonical
+    // ones referenced from somewhere beside the pool, this cell and the
+    // caller, which account for one reference each; note that transient
+    // references, e.g. from the grid attribute cache, may make us copy an
+    // attribute used by a single cell, but this is harmless
+    if ( !m_data ||
+            !m_data->m_attrPool.Contains(attr) ||
+                attr->GetRefCount() <= 3 )
+        return attr;
+
+    wxGridCellAttr * const attrNew = attr->Clone();
+
+    // an extra reference for the caller, as for attr itself on entry
+    attrNew->IncRef();
+
+    // store the copy directly, without going through SetAttr() which would
+    // just intern it back into the shared attribute
+    m_data->m_mergedAttrs.Clear();
+    m_data->m_cellAttrs.SetAttr(attrNew, row, col);
+
+    attr->DecRef();
+
+    return attrNew;
+}
+
 void wxGridCellAttrProvider::SetRowAttr(wxGridCellAttr *attr, int row)
 {
     if ( !m_data )
         InitData();
 
+    m_data->m_mergedAttrs.Clear();
     m_data->m_rowAttrs.SetAttr(attr, row);
 }
 
@@ -1262,36 +1800,93 @@ void wxGridCellAttrProvider::SetColAttr(wxGridCellAttr *attr, int col)
     if ( !m_data )
         InitData();
 
+    m_data->m_mergedAttrs.Clear();
     m_data->m_colAttrs.SetAttr(attr, col);
 }
 
-void wxGridCellAttrProvider::UpdateAttrRows( size_t pos, int numRows )
+void wxGridCellAttrProvider::SetRowsAttr(wxGridCellAttr *attr,
+                                         int rowFirst, int rowLast)
 {
-    if ( m_data )
-    {
-        m_data->m_cellAttrs.UpdateAttrRows( pos, numRows );
+    if ( !m_data )
+        InitData();
 
-        m_data->m_rowAttrs.UpdateAttrRowsOrCols( pos, numRows );
-    }
+    m_data->m_mergedAttrs.Clear();
+    m_data->m_rowIntervalAttrs.SetAttr(attr, rowFirst, rowLast);
 }
 
-void wxGridCellAttrProvider::UpdateAttrCols( size_t pos, int numCols )
+void wxGridCellAttrProvider::SetColsAttr(wxGridCellAttr *attr,
+                                         int colFirst, int colLast)
 {
-    if ( m_data )
-    {
-        m_data->m_cellAttrs.UpdateAttrCols( pos, numCols );
+    if ( !m_data )
+        InitData();
 
-        m_data->m_colAttrs.UpdateAttrRowsOrCols( pos, numCols );
-    }
+    m_data->m_mergedAttrs.Clear();
+    m_data->m_colIntervalAttrs.SetAttr(attr, colFirst, colLast);
 }
 
-const wxGridColumnHeaderRenderer&
-wxGridCellAttrProvider::GetColumnHeaderRenderer(int WXUNUSED(col))
+void wxGridCellAttrProvider::SetBlockAttr(wxGridCellAttr *attr,
+                                          int topRow, int leftCol,
+                                          int bottomRow, int rightCol)
 {
-    return gs_defaultHeaderRenderers.colRenderer;
+    if ( !m_data )
+        InitData();
+
+    m_data->m_mergedAttrs.Clear();
+    m_data->m_blockAttrs.SetAttr(attr, topRow, leftCol, bottomRow, rightCol);
 }
 
-const wxGridRowHeaderRenderer&
+void wxGridCellAttrProvider::BeginAttrCaching()
+{
+    if ( !m_data )
+        InitData();
+
+    m_data->m_mergedAttrs.Enable();
+}
+
+void wxGridCellAttrProvider::EndAttrCaching()
+{
+    wxCHECK_RET( m_data, wxT("mismatched EndAttrCaching() call") );
+
+    m_data->m_mergedAttrs.Disable();
+}
+
+void wxGridCellAttrProvider::UpdateAttrRows( size_t pos, int numRows )
+{
+    if ( m_data )
+    {
+        m_data->m_mergedAttrs.Clear();
+
+        m_data->m_cellAttrs.UpdateAttrRows( pos, numRows );
+
+        m_data->m_rowAttrs.UpdateAttrRowsOrCols( pos, numRows );
+        m_data->m_rowIntervalAttrs.UpdateAttrRowsOrCols( pos, numRows );
+
+        m_data->m_blockAttrs.UpdateAttrRows( pos, numRows );
+    }
+}
+
+void wxGridCellAttrProvider::UpdateAttrCols( size_t pos, int numCols )
+{
+    if ( m_data )
+    {
+        m_data->m_mergedAttrs.Clear();
+
+        m_data->m_cellAttrs.UpdateAttrCols( pos, numCols );
+
+        m_data->m_colAttrs.UpdateAttrRowsOrCols( pos, numCols );
+        m_data->m_colIntervalAttrs.UpdateAttrRowsOrCols( pos, numCols );
+
+        m_data->m_blockAttrs.UpdateAttrCols( pos, numCols );
+    }
+}
+
+const wxGridColumnHeaderRenderer&
+wxGridCellAttrProvider::GetColumnHeaderRenderer(int WXUNUSED(col))
+{
+    return gs_defaultHeaderRenderers.colRenderer;
+}
+
+const wxGridRowHeaderRenderer&
 wxGridCellAttrProvider::GetRowHeaderRenderer(int WXUNUSED(row))
 {
     return gs_defaultHeaderRenderers.rowRenderer;
@@ -1637,6 +2232,27 @@ bool wxGridTableBase::DeleteCols( size_t WXUNUSED(pos),
     return false;
 }
 
+void wxGridTableBase::GetValues( int rowFirst, int rowLast,
+                                 int colFirst, int colLast,
+                                 wxGridStringArray& values )
+{
+    values.Empty();
+    values.Alloc( rowLast - rowFirst + 1 );
+
+    for ( int row = rowFirst; row <= rowLast; row++ )
+    {
+        wxArrayString rowValues;
+        rowValues.Alloc( colLast - colFirst + 1 );
+
+        for ( int col = colFirst; col <= colLast; col++ )
+        {
+            rowValues.Add( GetValue( row, col ) );
+        }
+
+        values.Add( rowValues );
+    }
+}
+
 wxString wxGridTableBase::GetRowLabelValue( int row )
 {
     wxString s;
@@ -1777,71 +2393,489 @@ wxGridStringTable::wxGridStringTable()
     m_numCols = 0;
 }
 
-wxGridStringTable::wxGridStringTable( int numRows, int numCols )
-        : wxGridTableBase()
+wxGridStringTable::wxGridStringTable( int numRows, int numCols )
+        : wxGridTableBase()
+{
+    m_numCols = numCols;
+
+    m_data.Alloc( numRows );
+
+    wxArrayString sa;
+    sa.Alloc( numCols );
+    sa.Add( wxEmptyString, numCols );
+
+    m_data.Add( sa, numRows );
+}
+
+wxString wxGridStringTable::GetValue( int row, int col )
+{
+    wxCHECK_MSG( (row >= 0 && row < GetNumberRows()) &&
+                 (col >= 0 && col < GetNumberCols()),
+                 wxEmptyString,
+                 wxT("invalid row or column index in wxGridStringTable") );
+
+    return m_data[row][col];
+}
+
+void wxGridStringTable::SetValue( int row, int col, const wxString& value )
+{
+    wxCHECK_RET( (row >= 0 && row < GetNumberRows()) &&
+                 (col >= 0 && col < GetNumberCols()),
+                 wxT("invalid row or column index in wxGridStringTable") );
+
+    m_data[row][col] = value;
+}
+
+void wxGridStringTable::Clear()
+{
+    int numRows;
+    numRows = m_data.GetCount();
+    if ( numRows > 0 )
+    {
+        int numCols;
+        numCols = m_data[0].GetCount();
+
+        int row;
+        for ( row = 0; row < numRows; row++ )
+        {
+            int col;
+            for ( col = 0; col < numCols; col++ )
+            {
+                m_data[row][col].clear();
+            }
+        }
+    }
+}
+
+bool wxGridStringTable::InsertRows( size_t pos, size_t numRows )
+{
+    if ( pos >= m_data.size() )
+    {
+        return AppendRows( numRows );
+    }
+
+    wxArrayString sa;
+    sa.Alloc( m_numCols );
+    sa.Add( wxEmptyString, m_numCols );
+    m_data.Insert( sa, pos, numRows );
+
+    if ( GetView() )
+    {
+        wxGridTableMessage msg( this,
+                                wxGRIDTABLE_NOTIFY_ROWS_INSERTED,
+                                pos,
+                                numRows );
+
+        GetView()->ProcessTableMessage( msg );
+    }
+
+    return true;
+}
+
+bool wxGridStringTable::AppendRows( size_t numRows )
+{
+    wxArrayString sa;
+    if ( m_numCols > 0 )
+    {
+        sa.Alloc( m_numCols );
+        sa.Add( wxEmptyString, m_numCols );
+    }
+
+    m_data.Add( sa, numRows );
+
+    if ( GetView() )
+    {
+        wxGridTableMessage msg( this,
+                                wxGRIDTABLE_NOTIFY_ROWS_APPENDED,
+                                numRows );
+
+        GetView()->ProcessTableMessage( msg );
+    }
+
+    return true;
+}
+
+bool wxGridStringTable::DeleteRows( size_t pos, size_t numRows )
+{
+    size_t curNumRows = m_data.GetCount();
+
+    if ( pos >= curNumRows )
+    {
+        wxFAIL_MSG( wxString::Format
+                    (
+                        wxT("Called wxGridStringTable::DeleteRows(pos=%lu, N=%lu)\nPos value is invalid for present table with %lu rows"),
+                        (unsigned long)pos,
+                        (unsigned long)numRows,
+                        (unsigned long)curNumRows
+                    ) );
+
+        return false;
+    }
+
+    if ( numRows > curNumRows - pos )
+    {
+        numRows = curNumRows - pos;
+    }
+
+    if ( numRows >= curNumRows )
+    {
+        m_data.Clear();
+    }
+    else
+    {
+        m_data.RemoveAt( pos, numRows );
+    }
+
+    if ( GetView() )
+    {
+        wxGridTableMessage msg( this,
+                                wxGRIDTABLE_NOTIFY_ROWS_DELETED,
+                                pos,
+                                numRows );
+
+        GetView()->ProcessTableMessage( msg );
+    }
+
+    return true;
+}
+
+bool wxGridStringTable::InsertCols( size_t pos, size_t numCols )
+{
+    if ( pos >= static_cast<size_t>(m_numCols) )
+    {
+        return AppendCols( numCols );
+    }
+
+    if ( !m_colLabels.IsEmpty() )
+    {
+        m_colLabels.Insert( wxEmptyString, pos, numCols );
+
+        for ( size_t i = pos; i < pos + numCols; i++ )
+            m_colLabels[i] = wxGridTableBase::GetColLabelValue( i );
+    }
+
+    for ( size_t row = 0; row < m_data.size(); row++ )
+    {
+        for ( size_t col = pos; col < pos + numCols; col++ )
+        {
+            m_data[row].Insert( wxEmptyString, col );
+        }
+    }
+
+    m_numCols += numCols;
+
+    if ( GetView() )
+    {
+        wxGridTableMessage msg( this,
+                                wxGRIDTABLE_NOTIFY_COLS_INSERTED,
+                                pos,
+                                numCols );
+
+        GetView()->ProcessTableMessage( msg );
+    }
+
+    return true;
+}
+
+bool wxGridStringTable::AppendCols( size_t numCols )
+{
+    for ( size_t row = 0; row < m_data.size(); row++ )
+    {
+        m_data[row].Add( wxEmptyString, numCols );
+    }
+
+    m_numCols += numCols;
+
+    if ( GetView() )
+    {
+        wxGridTableMessage msg( this,
+                                wxGRIDTABLE_NOTIFY_COLS_APPENDED,
+                                numCols );
+
+        GetView()->ProcessTableMessage( msg );
+    }
+
+    return true;
+}
+
+bool wxGridStringTable::DeleteCols( size_t pos, size_t numCols )
+{
+    size_t row;
+
+    size_t curNumRows = m_data.GetCount();
+    size_t curNumCols = m_numCols;
+
+    if ( pos >= curNumCols )
+    {
+        wxFAIL_MSG( wxString::Format
+                    (
+                        wxT("Called wxGridStringTable::DeleteCols(pos=%lu, N=%lu)\nPos value is invalid for present table with %lu cols"),
+                        (unsigned long)pos,
+                        (unsigned long)numCols,
+                        (unsigned long)curNumCols
+                    ) );
+        return false;
+    }
+
+    int colID;
+    if ( GetView() )
+        colID = GetView()->GetColAt( pos );
+    else
+        colID = pos;
+
+    if ( numCols > curNumCols - colID )
+    {
+        numCols = curNumCols - colID;
+    }
+
+    if ( !m_colLabels.IsEmpty() )
+    {
+        // m_colLabels stores just as many elements as it needs, e.g. if only
+        // the label of the first column had been set it would have only one
+        // element and not numCols, so account for it
+        int numRemaining = m_colLabels.size() - colID;
+        if (numRemaining > 0)
+            m_colLabels.RemoveAt( colID, wxMin(numCols, numRemaining) );
+    }
+
+    if ( numCols >= curNumCols )
+    {
+        for ( row = 0; row < curNumRows; row++ )
+        {
+            m_data[row].Clear();
+        }
+
+        m_numCols = 0;
+    }
+    else // something will be left
+    {
+        for ( row = 0; row < curNumRows; row++ )
+        {
+            m_data[row].RemoveAt( colID, numCols );
+        }
+
+        m_numCols -= numCols;
+    }
+
+    if ( GetView() )
+    {
+        wxGridTableMessage msg( this,
+                                wxGRIDTABLE_NOTIFY_COLS_DELETED,
+                                pos,
+                                numCols );
+
+        GetView()->ProcessTableMessage( msg );
+    }
+
+    return true;
+}
+
+wxString wxGridStringTable::GetRowLabelValue( int row )
+{
+    if ( row > (int)(m_rowLabels.GetCount()) - 1 )
+    {
+        // using default label
+        //
+        return wxGridTableBase::GetRowLabelValue( row );
+    }
+    else
+    {
+        return m_rowLabels[row];
+    }
+}
+
+wxString wxGridStringTable::GetColLabelValue( int col )
+{
+    if ( col > (int)(m_colLabels.GetCount()) - 1 )
+    {
+        // using default label
+        //
+        return wxGridTableBase::GetColLabelValue( col );
+    }
+    else
+    {
+        return m_colLabels[col];
+    }
+}
+
+void wxGridStringTable::SetRowLabelValue( int row, const wxString& value )
+{
+    if ( row > (int)(m_rowLabels.GetCount()) - 1 )
+    {
+        int n = m_rowLabels.GetCount();
+        int i;
+
+        for ( i = n; i <= row; i++ )
+        {
+            m_rowLabels.Add( wxGridTableBase::GetRowLabelValue(i) );
+        }
+    }
+
+    m_rowLabels[row] = value;
+}
+
+void wxGridStringTable::SetColLabelValue( int col, const wxString& value )
+{
+    if ( col > (int)(m_colLabels.GetCount()) - 1 )
+    {
+        int n = m_colLabels.GetCount();
+        int i;
+
+        for ( i = n; i <= col; i++ )
+        {
+            m_colLabels.Add( wxGridTableBase::GetColLabelValue(i) );
+        }
+    }
+
+    m_colLabels[col] = value;
+}
+
+void wxGridStringTable::SetCornerLabelValue( const wxString& value )
+{
+    m_cornerLabel = value;
+}
+
+wxString wxGridStringTable::GetCornerLabelValue() const
+{
+    return m_cornerLabel;
+}
+
+//////////////////////////////////////////////////////////////////////
+//
+//  wxGridSparseStringTable
+//
+//////////////////////////////////////////////////////////////////////
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxGridSparseStringTable, wxGridTableBase);
+
+wxGridSparseStringTable::wxGridSparseStringTable()
+        : wxGridTableBase()
+{
+    m_numRows = 0;
+    m_numCols = 0;
+}
+
+wxGridSparseStringTable::wxGridSparseStringTable( int numRows, int numCols )
+        : wxGridTableBase()
+{
+    m_numRows = numRows;
+    m_numCols = numCols;
+}
+
+wxString wxGridSparseStringTable::GetValue( int row, int col )
+{
+    wxCHECK_MSG( (row >= 0 && row < GetNumberRows()) &&
+                 (col >= 0 && col < GetNumberCols()),
+                 wxEmptyString,
+                 wxT("invalid row or column index in wxGridSparseStringTable") );
+
+    wxGridSparseRowMap::const_iterator it = m_rows.find(row);
+    if ( it == m_rows.end() )
+        return wxEmptyString;
+
+    wxGridSparseCellMap::const_iterator cell = it->second.find(col);
+    return cell == it->second.end() ? wxString() : cell->second;
+}
+
+void wxGridSparseStringTable::SetValue( int row, int col, const wxString& value )
+{
+    wxCHECK_RET( (row >= 0 && row < GetNumberRows()) &&
+                 (col >= 0 && col < GetNumberCols()),
+                 wxT("invalid row or column index in wxGridSparseStringTable") );
+
+    if ( value.empty() )
+    {
+        // setting a cell to the empty string removes it from the storage to
+        // keep the memory use proportional to the populated cells only
+        wxGridSparseRowMap::iterator it = m_rows.find(row);
+        if ( it != m_rows.end() )
+        {
+            it->second.erase(col);
+            if ( it->second.empty() )
+                m_rows.erase(it);
+        }
+    }
+    else
+    {
+        m_rows[row][col] = value;
+    }
+}
+
+bool wxGridSparseStringTable::IsEmptyCell( int row, int col )
 {
-    m_numCols = numCols;
-
-    m_data.Alloc( numRows );
-
-    wxArrayString sa;
-    sa.Alloc( numCols );
-    sa.Add( wxEmptyString, numCols );
+    wxGridSparseRowMap::const_iterator it = m_rows.find(row);
+    if ( it == m_rows.end() )
+        return true;
 
-    m_data.Add( sa, numRows );
+    return it->second.find(col) == it->second.end();
 }
 
-wxString wxGridStringTable::GetValue( int row, int col )
+void wxGridSparseStringTable::Clear()
 {
-    wxCHECK_MSG( (row >= 0 && row < GetNumberRows()) &&
-                 (col >= 0 && col < GetNumberCols()),
-                 wxEmptyString,
-                 wxT("invalid row or column index in wxGridStringTable") );
-
-    return m_data[row][col];
+    m_rows.clear();
 }
 
-void wxGridStringTable::SetValue( int row, int col, const wxString& value )
+void wxGridSparseStringTable::ShiftRows( int pos, int offset )
 {
-    wxCHECK_RET( (row >= 0 && row < GetNumberRows()) &&
-                 (col >= 0 && col < GetNumberCols()),
-                 wxT("invalid row or column index in wxGridStringTable") );
+    wxGridSparseRowMap rows;
+    rows.swap(m_rows);
 
-    m_data[row][col] = value;
+    for ( wxGridSparseRowMap::iterator it = rows.begin();
+          it != rows.end();
+          ++it )
+    {
+        int row = it->first;
+        if ( row >= pos )
+        {
+            row += offset;
+            if ( row < pos )
+                continue;       // deleted row, drop its cells
+        }
+
+        m_rows[row].swap(it->second);
+    }
 }
 
-void wxGridStringTable::Clear()
+void wxGridSparseStringTable::ShiftCols( int pos, int offset )
 {
-    int numRows;
-    numRows = m_data.GetCount();
-    if ( numRows > 0 )
+    for ( wxGridSparseRowMap::iterator it = m_rows.begin();
+          it != m_rows.end();
+          ++it )
     {
-        int numCols;
-        numCols = m_data[0].GetCount();
+        wxGridSparseCellMap cells;
+        cells.swap(it->second);
 
-        int row;
-        for ( row = 0; row < numRows; row++ )
+        for ( wxGridSparseCellMap::iterator cell = cells.begin();
+              cell != cells.end();
+              ++cell )
         {
-            int col;
-            for ( col = 0; col < numCols; col++ )
+            int col = cell->first;
+            if ( col >= pos )
             {
-                m_data[row][col].clear();
+                col += offset;
+                if ( col < pos )
+                    continue;   // deleted column, drop the cell
             }
+
+            it->second[col] = cell->second;
         }
     }
 }
 
-bool wxGridStringTable::InsertRows( size_t pos, size_t numRows )
+bool wxGridSparseStringTable::InsertRows( size_t pos, size_t numRows )
 {
-    if ( pos >= m_data.size() )
+    if ( pos >= static_cast<size_t>(m_numRows) )
     {
         return AppendRows( numRows );
     }
 
-    wxArrayString sa;
-    sa.Alloc( m_numCols );
-    sa.Add( wxEmptyString, m_numCols );
-    m_data.Insert( sa, pos, numRows );
+    ShiftRows( pos, numRows );
+    m_numRows += numRows;
+
+    if ( !m_rowLabels.IsEmpty() )
+    {
+        m_rowLabels.Insert( wxEmptyString, pos, numRows );
+    }
 
     if ( GetView() )
     {
@@ -1856,16 +2890,9 @@ bool wxGridStringTable::InsertRows( size_t pos, size_t numRows )
     return true;
 }
 
-bool wxGridStringTable::AppendRows( size_t numRows )
+bool wxGridSparseStringTable::AppendRows( size_t numRows )
 {
-    wxArrayString sa;
-    if ( m_numCols > 0 )
-    {
-        sa.Alloc( m_numCols );
-        sa.Add( wxEmptyString, m_numCols );
-    }
-
-    m_data.Add( sa, numRows );
+    m_numRows += numRows;
 
     if ( GetView() )
     {
@@ -1879,15 +2906,15 @@ bool wxGridStringTable::AppendRows( size_t numRows )
     return true;
 }
 
-bool wxGridStringTable::DeleteRows( size_t pos, size_t numRows )
+bool wxGridSparseStringTable::DeleteRows( size_t pos, size_t numRows )
 {
-    size_t curNumRows = m_data.GetCount();
+    size_t curNumRows = m_numRows;
 
     if ( pos >= curNumRows )
     {
         wxFAIL_MSG( wxString::Format
                     (
-                        wxT("Called wxGridStringTable::DeleteRows(pos=%lu, N=%lu)\nPos value is invalid for present table with %lu rows"),
+                        wxT("Called wxGridSparseStringTable::DeleteRows(pos=%lu, N=%lu)\nPos value is invalid for present table with %lu rows"),
                         (unsigned long)pos,
                         (unsigned long)numRows,
                         (unsigned long)curNumRows
@@ -1901,13 +2928,22 @@ bool wxGridStringTable::DeleteRows( size_t pos, size_t numRows )
         numRows = curNumRows - pos;
     }
 
+    if ( !m_rowLabels.IsEmpty() )
+    {
+        int numRemaining = m_rowLabels.size() - pos;
+        if (numRemaining > 0)
+            m_rowLabels.RemoveAt( pos, wxMin(numRows, (size_t)numRemaining) );
+    }
+
     if ( numRows >= curNumRows )
     {
-        m_data.Clear();
+        m_rows.clear();
+        m_numRows = 0;
     }
     else
     {
-        m_data.RemoveAt( pos, numRows );
+        ShiftRows( pos, -static_cast<int>(numRows) );
+        m_numRows -= numRows;
     }
 
     if ( GetView() )
@@ -1923,7 +2959,7 @@ bool wxGridStringTable::DeleteRows( size_t pos, size_t numRows )
     return true;
 }
 
-bool wxGridStringTable::InsertCols( size_t pos, size_t numCols )
+bool wxGridSparseStringTable::InsertCols( size_t pos, size_t numCols )
 {
     if ( pos >= static_cast<size_t>(m_numCols) )
     {
@@ -1933,19 +2969,9 @@ bool wxGridStringTable::InsertCols( size_t pos, size_t numCols )
     if ( !m_colLabels.IsEmpty() )
     {
         m_colLabels.Insert( wxEmptyString, pos, numCols );
-
-        for ( size_t i = pos; i < pos + numCols; i++ )
-            m_colLabels[i] = wxGridTableBase::GetColLabelValue( i );
-    }
-
-    for ( size_t row = 0; row < m_data.size(); row++ )
-    {
-        for ( size_t col = pos; col < pos + numCols; col++ )
-        {
-            m_data[row].Insert( wxEmptyString, col );
-        }
     }
 
+    ShiftCols( pos, numCols );
     m_numCols += numCols;
 
     if ( GetView() )
@@ -1961,13 +2987,8 @@ bool wxGridStringTable::InsertCols( size_t pos, size_t numCols )
     return true;
 }
 
-bool wxGridStringTable::AppendCols( size_t numCols )
+bool wxGridSparseStringTable::AppendCols( size_t numCols )
 {
-    for ( size_t row = 0; row < m_data.size(); row++ )
-    {
-        m_data[row].Add( wxEmptyString, numCols );
-    }
-
     m_numCols += numCols;
 
     if ( GetView() )
@@ -1982,22 +3003,20 @@ bool wxGridStringTable::AppendCols( size_t numCols )
     return true;
 }
 
-bool wxGridStringTable::DeleteCols( size_t pos, size_t numCols )
+bool wxGridSparseStringTable::DeleteCols( size_t pos, size_t numCols )
 {
-    size_t row;
-
-    size_t curNumRows = m_data.GetCount();
     size_t curNumCols = m_numCols;
 
     if ( pos >= curNumCols )
     {
         wxFAIL_MSG( wxString::Format
                     (
-                        wxT("Called wxGridStringTable::DeleteCols(pos=%lu, N=%lu)\nPos value is invalid for present table with %lu cols"),
+                        wxT("Called wxGridSparseStringTable::DeleteCols(pos=%lu, N=%lu)\nPos value is invalid for present table with %lu cols"),
                         (unsigned long)pos,
                         (unsigned long)numCols,
                         (unsigned long)curNumCols
                     ) );
+
         return false;
     }
 
@@ -2014,30 +3033,19 @@ bool wxGridStringTable::DeleteCols( size_t pos, size_t numCols )
 
     if ( !m_colLabels.IsEmpty() )
     {
-        // m_colLabels stores just as many elements as it needs, e.g. if only
-        // the label of the first column had been set it would have only one
-        // element and not numCols, so account for it
         int numRemaining = m_colLabels.size() - colID;
         if (numRemaining > 0)
-            m_colLabels.RemoveAt( colID, wxMin(numCols, numRemaining) );
+            m_colLabels.RemoveAt( colID, wxMin(numCols, (size_t)numRemaining) );
     }
 
     if ( numCols >= curNumCols )
     {
-        for ( row = 0; row < curNumRows; row++ )
-        {
-            m_data[row].Clear();
-        }
-
+        m_rows.clear();
         m_numCols = 0;
     }
-    else // something will be left
+    else
     {
-        for ( row = 0; row < curNumRows; row++ )
-        {
-            m_data[row].RemoveAt( colID, numCols );
-        }
-
+        ShiftCols( colID, -static_cast<int>(numCols) );
         m_numCols -= numCols;
     }
 
@@ -2054,7 +3062,7 @@ bool wxGridStringTable::DeleteCols( size_t pos, size_t numCols )
     return true;
 }
 
-wxString wxGridStringTable::GetRowLabelValue( int row )
+wxString wxGridSparseStringTable::GetRowLabelValue( int row )
 {
     if ( row > (int)(m_rowLabels.GetCount()) - 1 )
     {
@@ -2068,7 +3076,7 @@ wxString wxGridStringTable::GetRowLabelValue( int row )
     }
 }
 
-wxString wxGridStringTable::GetColLabelValue( int col )
+wxString wxGridSparseStringTable::GetColLabelValue( int col )
 {
     if ( col > (int)(m_colLabels.GetCount()) - 1 )
     {
@@ -2082,7 +3090,7 @@ wxString wxGridStringTable::GetColLabelValue( int col )
     }
 }
 
-void wxGridStringTable::SetRowLabelValue( int row, const wxString& value )
+void wxGridSparseStringTable::SetRowLabelValue( int row, const wxString& value )
 {
     if ( row > (int)(m_rowLabels.GetCount()) - 1 )
     {
@@ -2098,7 +3106,7 @@ void wxGridStringTable::SetRowLabelValue( int row, const wxString& value )
     m_rowLabels[row] = value;
 }
 
-void wxGridStringTable::SetColLabelValue( int col, const wxString& value )
+void wxGridSparseStringTable::SetColLabelValue( int col, const wxString& value )
 {
     if ( col > (int)(m_colLabels.GetCount()) - 1 )
     {
@@ -2114,12 +3122,12 @@ void wxGridStringTable::SetColLabelValue( int col, const wxString& value )
     m_colLabels[col] = value;
 }
 
-void wxGridStringTable::SetCornerLabelValue( const wxString& value )
+void wxGridSparseStringTable::SetCornerLabelValue( const wxString& value )
 {
     m_cornerLabel = value;
 }
 
-wxString wxGridStringTable::GetCornerLabelValue() const
+wxString wxGridSparseStringTable::GetCornerLabelValue() const
 {
     return m_cornerLabel;
 }
@@ -2859,6 +3867,17 @@ bool wxGrid::CreateGrid( int numRows, int numCols,
     return SetTable(new wxGridStringTable(numRows, numCols), true, selmode);
 }
 
+bool wxGrid::CreateSparseGrid( int numRows, int numCols,
+                               wxGridSelectionModes selmode )
+{
+    wxCHECK_MSG( !m_created,
+                 false,
+                 wxT("wxGrid::CreateSparseGrid or wxGrid::SetTable called more than once") );
+
+    return SetTable(new wxGridSparseStringTable(numRows, numCols),
+                    true, selmode);
+}
+
 void wxGrid::SetSelectionMode(wxGridSelectionModes selmode)
 {
     wxCHECK_RET( m_created,
@@ -2917,6 +3936,11 @@ wxGrid::SetTable(wxGridTableBase *table,
         m_colRights.Empty();
         m_rowHeights.Empty();
         m_rowBottoms.Empty();
+
+        m_rowBottomsPendingFrom =
+        m_colRightsPendingFrom = -1;
+        m_rowBottomsPendingDiff =
+        m_colRightsPendingDiff = 0;
     }
 
     if (table)
@@ -2969,6 +3993,10 @@ void wxGrid::Init()
     m_table = NULL;
     m_ownTable = false;
 
+    m_prefetchedRowFirst = 0;
+    m_prefetchedColFirst = 0;
+    m_prefetchActive = false;
+
     m_selection = NULL;
     m_defaultCellAttr = NULL;
     m_typeRegistry = NULL;
@@ -3005,6 +4033,14 @@ void wxGrid::Init()
     m_minAcceptableColWidth  =
     m_minAcceptableRowHeight = 0;
 
+    m_uniformRows =
+    m_uniformCols = -1;
+
+    m_rowBottomsPendingFrom =
+    m_colRightsPendingFrom = -1;
+    m_rowBottomsPendingDiff =
+    m_colRightsPendingDiff = 0;
+
     m_gridLineColour = wxSystemSettings::GetColour(wxSYS_COLOUR_BTNFACE);
     m_gridLinesEnabled = true;
     m_gridLinesClipHorz =
@@ -3093,6 +4129,12 @@ void wxGrid::InitRowHeights()
         rowBottom += m_defaultRowHeight;
         m_rowBottoms.Add( rowBottom );
     }
+
+    // all the heights are default ones initially
+    m_uniformRows = 1;
+
+    m_rowBottomsPendingFrom = -1;
+    m_rowBottomsPendingDiff = 0;
 }
 
 void wxGrid::InitColWidths()
@@ -3110,6 +4152,82 @@ void wxGrid::InitColWidths()
         int colRight = ( GetColPos( i ) + 1 ) * m_defaultColWidth;
         m_colRights.Add( colRight );
     }
+
+    // all the widths are default ones initially
+    m_uniformCols = 1;
+
+    m_colRightsPendingFrom = -1;
+    m_colRightsPendingDiff = 0;
+}
+
+void wxGrid::FlushPendingRowBottoms()
+{
+    if ( m_rowBottomsPendingFrom == -1 )
+        return;
+
+    const int count = m_rowBottoms.size();
+    for ( int i = m_rowBottomsPendingFrom; i < count; i++ )
+        m_rowBottoms[i] += m_rowBottomsPendingDiff;
+
+    m_rowBottomsPendingFrom = -1;
+    m_rowBottomsPendingDiff = 0;
+}
+
+void wxGrid::FlushPendingColRights()
+{
+    if ( m_colRightsPendingFrom == -1 )
+        return;
+
+    // the pending delta is only ever recorded while the columns are in their
+    // natural order, so the positions correspond to the indices here
+    const int count = m_colRights.size();
+    for ( int i = m_colRightsPendingFrom; i < count; i++ )
+        m_colRights[i] += m_colRightsPendingDiff;
+
+    m_colRightsPendingFrom = -1;
+    m_colRightsPendingDiff = 0;
+}
+
+bool wxGrid::HasUniformRowSizes() const
+{
+    if ( m_uniformRows == -1 )
+    {
+        m_uniformRows = 1;
+
+        const size_t count = m_rowHeights.size();
+        for ( size_t i = 0; i < count; i++ )
+        {
+            // notice that this also detects the hidden rows as their heights
+            // are stored as negative values
+            if ( m_rowHeights[i] != m_defaultRowHeight )
+            {
+                m_uniformRows = 0;
+                break;
+            }
+        }
+    }
+
+    return m_uniformRows != 0;
+}
+
+bool wxGrid::HasUniformColSizes() const
+{
+    if ( m_uniformCols == -1 )
+    {
+        m_uniformCols = 1;
+
+        const size_t count = m_colWidths.size();
+        for ( size_t i = 0; i < count; i++ )
+        {
+            if ( m_colWidths[i] != m_defaultColWidth )
+            {
+                m_uniformCols = 0;
+                break;
+            }
+        }
+    }
+
+    return m_uniformCols != 0;
 }
 
 int wxGrid::GetColWidth(int col) const
@@ -3126,13 +4244,19 @@ int wxGrid::GetColLeft(int col) const
     if ( m_colRights.IsEmpty() )
         return GetColPos( col ) * m_defaultColWidth;
 
-    return m_colRights[col] - GetColWidth(col);
+    return GetColRight(col) - GetColWidth(col);
 }
 
 int wxGrid::GetColRight(int col) const
 {
-    return m_colRights.IsEmpty() ? (GetColPos( col ) + 1) * m_defaultColWidth
-                                 : m_colRights[col];
+    if ( m_colRights.IsEmpty() )
+        return (GetColPos( col ) + 1) * m_defaultColWidth;
+
+    int right = m_colRights[col];
+    if ( m_colRightsPendingFrom != -1 && col >= m_colRightsPendingFrom )
+        right += m_colRightsPendingDiff;
+
+    return right;
 }
 
 int wxGrid::GetRowHeight(int row) const
@@ -3150,13 +4274,19 @@ int wxGrid::GetRowTop(int row) const
     if ( m_rowBottoms.IsEmpty() )
         return row * m_defaultRowHeight;
 
-    return m_rowBottoms[row] - GetRowHeight(row);
+    return GetRowBottom(row) - GetRowHeight(row);
 }
 
 int wxGrid::GetRowBottom(int row) const
 {
-    return m_rowBottoms.IsEmpty() ? (row + 1) * m_defaultRowHeight
-                                  : m_rowBottoms[row];
+    if ( m_rowBottoms.IsEmpty() )
+        return (row + 1) * m_defaultRowHeight;
+
+    int bottom = m_rowBottoms[row];
+    if ( m_rowBottomsPendingFrom != -1 && row >= m_rowBottomsPendingFrom )
+        bottom += m_rowBottomsPendingDiff;
+
+    return bottom;
 }
 
 void wxGrid::CalcDimensions()
@@ -3291,6 +4421,11 @@ bool wxGrid::Redimension( wxGridTableMessage& msg )
     // cell it might want to save that stuff to might no longer exist.
     HideCellEditControl();
 
+    // the code below accesses and partially rebuilds the cumulative size
+    // arrays directly, so bring them up to date first
+    FlushPendingRowBottoms();
+    FlushPendingColRights();
+
     switch ( msg.GetId() )
     {
         case wxGRIDTABLE_NOTIFY_ROWS_INSERTED:
@@ -3375,6 +4510,10 @@ bool wxGrid::Redimension( wxGridTableMessage& msg )
                 m_rowHeights.RemoveAt( pos, numRows );
                 m_rowBottoms.RemoveAt( pos, numRows );
 
+                // the deleted rows could have been the only ones with a
+                // custom height
+                m_uniformRows = -1;
+
                 int h = 0;
                 for ( i = 0; i < m_numRows; i++ )
                 {
@@ -3554,6 +4693,10 @@ bool wxGrid::Redimension( wxGridTableMessage& msg )
                 m_colWidths.RemoveAt( pos, numCols );
                 m_colRights.RemoveAt( pos, numCols );
 
+                // the deleted columns could have been the only ones with a
+                // custom width
+                m_uniformCols = -1;
+
                 int w = 0;
                 int colPos;
                 for ( colPos = 0; colPos < m_numCols; colPos++ )
@@ -5152,6 +6295,10 @@ void wxGrid::RefreshAfterColPosChange()
     // same and it's easy to do
     if ( !m_colWidths.empty() )
     {
+        // recomputing from the widths supersedes any pending delta
+        m_colRightsPendingFrom = -1;
+        m_colRightsPendingDiff = 0;
+
         int colRight = 0;
         for ( int colPos = 0; colPos < m_numCols; colPos++ )
         {
@@ -5759,6 +6906,13 @@ void wxGrid::OnDPIChanged(wxDPIChangedEvent& event)
 {
     InitPixelFields();
 
+    // The cumulative arrays are recomputed from the (rescaled) sizes below,
+    // superseding any pending deltas.
+    m_rowBottomsPendingFrom =
+    m_colRightsPendingFrom = -1;
+    m_rowBottomsPendingDiff =
+    m_colRightsPendingDiff = 0;
+
     // If we have any non-default row sizes, we need to scale them (default
     // ones will be scaled due to the reinitialization of m_defaultRowHeight
     // inside InitPixelFields() above).
@@ -6310,14 +7464,106 @@ bool wxGrid::SetCurrentCell( const wxGridCellCoords& coords )
 // exposed cells (usually set from the update region by
 // CalcExposedCells)
 //
+bool wxGrid::PrefetchCellValues( const wxGridCellCoordsArray& cells )
+{
+    // don't reenter: the outermost caller keeps its (larger) block
+    if ( m_prefetchActive || !m_table || cells.IsEmpty() )
+        return false;
+
+    int rowFirst = cells[0].GetRow(),
+        rowLast = rowFirst,
+        colFirst = cells[0].GetCol(),
+        colLast = colFirst;
+
+    const size_t numCells = cells.GetCount();
+    for ( size_t n = 1; n < numCells; n++ )
+    {
+        const int row = cells[n].GetRow(),
+                  col = cells[n].GetCol();
+
+        if ( row < rowFirst )
+            rowFirst = row;
+        if ( row > rowLast )
+            rowLast = row;
+        if ( col < colFirst )
+            colFirst = col;
+        if ( col > colLast )
+            colLast = col;
+    }
+
+    // if the cells only sparsely cover their bounding block (e.g. when
+    // repainting two opposite corners), batch fetching it could be more
+    // expensive than getting the drawn cells one by one
+    const size_t area = (size_t)(rowLast - rowFirst + 1) *
+                            (size_t)(colLast - colFirst + 1);
+    if ( area > 2*numCells )
+        return false;
+
+    m_table->GetValues( rowFirst, rowLast, colFirst, colLast,
+                        m_prefetchedValues );
+    m_prefetchedRowFirst = rowFirst;
+    m_prefetchedColFirst = colFirst;
+    m_prefetchActive = true;
+
+    return true;
+}
+
+void wxGrid::ClearPrefetchedCellValues()
+{
+    m_prefetchedValues.Empty();
+    m_prefetchActive = false;
+}
+
+const wxString *wxGrid::GetPrefetchedValue( int row, int col ) const
+{
+    row -= m_prefetchedRowFirst;
+    if ( row < 0 || (size_t)row >= m_prefetchedValues.GetCount() )
+        return NULL;
+
+    const wxArrayString& rowValues = m_prefetchedValues[row];
+
+    col -= m_prefetchedColFirst;
+    if ( col < 0 || (size_t)col >= rowValues.GetCount() )
+        return NULL;
+
+    return &rowValues[col];
+}
+
 void wxGrid::DrawGridCellArea( wxDC& dc, const wxGridCellCoordsArray& cells )
 {
     if ( !m_numRows || !m_numCols )
         return;
 
+    // let the table fetch all the values of the repainted area at once
+    const bool prefetched = PrefetchCellValues( cells );
+
+    // also cache the merged attributes for the duration of the repaint as
+    // many cells typically share the same row and column attributes
+    wxGridCellAttrProvider * const
+        attrProvider = m_table ? m_table->GetAttrProvider() : NULL;
+    if ( attrProvider )
+        attrProvider->BeginAttrCaching();
+
     int i, numCells = cells.GetCount();
     wxGridCellCoordsArray redrawCells;
 
+    // all the cells which are either part of the repainted area or were
+    // already added to redrawCells: checking this set is much faster than
+    // searching both arrays for every candidate cell
+    wxGridCellKeySet paintedCells;
+    for ( i = 0; i < numCells; i++ )
+        paintedCells.insert(CoordsToKey(cells[i].GetRow(), cells[i].GetCol()));
+
+    // remember the result of the last scan for an overflow source to the
+    // left: all the cells between lastScanFound (exclusive) and lastScanStart
+    // (exclusive) in lastScanRow are known to contain nothing to draw, so the
+    // scans for the neighbouring empty cells can reuse it instead of
+    // rescanning most of the row for each of them
+    int lastScanRow = -1,
+        lastScanStart = -1,
+        lastScanLeft = -1,
+        lastScanFound = -1;
+
     for ( i = numCells - 1; i >= 0; i-- )
     {
         int row, col, cell_rows, cell_cols;
@@ -6328,31 +7574,9 @@ void wxGrid::DrawGridCellArea( wxDC& dc, const wxGridCellCoordsArray& cells )
         if ( GetCellSize( row, col, &cell_rows, &cell_cols ) == CellSpan_Inside )
         {
             wxGridCellCoords cell( row + cell_rows, col + cell_cols );
-            bool marked = false;
-            for ( int j = 0; j < numCells; j++ )
-            {
-                if ( cell == cells[j] )
-                {
-                    marked = true;
-                    break;
-                }
-            }
-
-            if (!marked)
-            {
-                int count = redrawCells.GetCount();
-                for (int j = 0; j < count; j++)
-                {
-                    if ( cell == redrawCells[j] )
-                    {
-                        marked = true;
-                        break;
-                    }
-                }
-
-                if (!marked)
-                    redrawCells.Add( cell );
-            }
+            if ( paintedCells.insert(
+                    CoordsToKey(cell.GetRow(), cell.GetCol())).second )
+                redrawCells.Add( cell );
 
             // don't bother drawing this cell
             continue;
@@ -6375,49 +7599,49 @@ void wxGrid::DrawGridCellArea( wxDC& dc, const wxGridCellCoordsArray& cells )
                 if (left == col)
                     left = 0; // oh well
 
-                for (int j = col - 1; j >= left; j--)
+                // find the first non-empty cell, skipping the inside cells of
+                // the multicell blocks, to the left of this one
+                int found;
+                if ( row + l == lastScanRow && col <= lastScanStart &&
+                        (lastScanFound >= 0 ? lastScanFound < col
+                                            : left >= lastScanLeft) )
                 {
-                    if (!m_table->IsEmptyCell(row + l, j))
+                    // the last scan already covers this range
+                    found = lastScanFound >= left ? lastScanFound : -1;
+                }
+                else // do scan the row
+                {
+                    found = -1;
+                    for (int j = col - 1; j >= left; j--)
                     {
+                        if (m_table->IsEmptyCell(row + l, j))
+                            continue;
+
+                        // As above: don't bother drawing inside cells.
                         wxGridCellAttrPtr attr = GetCellAttrPtr(row + l, j);
                         int numRows, numCols;
                         attr->GetSize(&numRows, &numCols);
                         if ( GetCellSpan(numRows, numCols)
                                  == wxGrid::CellSpan_Inside )
-                            // As above: don't bother drawing inside cells.
                             continue;
 
-                        if ( attr->CanOverflow() )
-                        {
-                            wxGridCellCoords cell(row + l, j);
-                            bool marked = false;
-
-                            for (int k = 0; k < numCells; k++)
-                            {
-                                if ( cell == cells[k] )
-                                {
-                                    marked = true;
-                                    break;
-                                }
-                            }
-
-                            if (!marked)
-                            {
-                                int count = redrawCells.GetCount();
-                                for (int k = 0; k < count; k++)
-                                {
-                                    if ( cell == redrawCells[k] )
-                                    {
-                                        marked = true;
-                                        break;
-                                    }
-                                }
-                                if (!marked)
-                                    redrawCells.Add( cell );
-                            }
-                        }
+                        found = j;
                         break;
                     }
+
+                    lastScanRow = row + l;
+                    lastScanStart = col;
+                    lastScanLeft = left;
+                    lastScanFound = found;
+                }
+
+                if ( found >= 0 &&
+                        GetCellAttrPtr(row + l, found)->CanOverflow() )
+                {
+                    wxGridCellCoords cell(row + l, found);
+                    if ( paintedCells.insert(
+                            CoordsToKey(row + l, found)).second )
+                        redrawCells.Add( cell );
                 }
             }
         }
@@ -6431,6 +7655,12 @@ void wxGrid::DrawGridCellArea( wxDC& dc, const wxGridCellCoordsArray& cells )
     {
         DrawCell( dc, redrawCells[i] );
     }
+
+    if ( attrProvider )
+        attrProvider->EndAttrCaching();
+
+    if ( prefetched )
+        ClearPrefetchedCellValues();
 }
 
 void wxGrid::DrawGridSpace( wxDC& dc, wxGridWindow *gridWindow )
@@ -7019,7 +8249,7 @@ void wxGrid::DrawCornerLabel(wxDC& dc)
     {
         rect.Deflate(1);
 
-        wxRendererNative::Get().DrawHeaderButton(m_cornerLabelWin, dc, rect, 0);
+        wxRendererNative::GetCached().DrawHeaderButton(m_cornerLabelWin, dc, rect, 0);
     }
     else
     {
@@ -7057,7 +8287,9 @@ void wxGrid::DrawColLabel(wxDC& dc, int col)
 
     if ( m_nativeColumnLabels )
     {
-        wxRendererNative::Get().DrawHeaderButton
+        // use the caching renderer: with many columns this blits the shared
+        // background bitmap instead of re-rendering it for every label
+        wxRendererNative::GetCached().DrawHeaderButton
                                 (
                                     GetColLabelWindow(),
                                     dc,
@@ -7778,9 +9010,10 @@ int wxGrid::PosToLinePos(int coord,
     int minPos = oper.GetFirstLine(this, gridWindow);
 
     // check for the simplest case: if we have no explicit line sizes
-    // configured, then we already know the line this position falls in
+    // configured, or if all of them still have the default size, then we
+    // already know the line this position falls in
     const wxArrayInt& lineEnds = oper.GetLineEnds(this);
-    if ( lineEnds.empty() )
+    if ( lineEnds.empty() || oper.HasUniformLineSizes(this) )
     {
         if ( maxPos < (numLines + minPos) )
             return maxPos;
@@ -7794,33 +9027,37 @@ int wxGrid::PosToLinePos(int coord,
     // necessary to determine if it really is a performance bottleneck
     maxPos = numLines + minPos - 1;
 
+    // note that the line ends must be accessed using GetLineEndPos() and not
+    // directly via lineEnds as the latter may not include a pending size
+    // delta from an interactive resize yet
+
     // check if the position is beyond the last column
     const int lineAtMaxPos = oper.GetLineAt(this, maxPos);
-    if ( coord >= lineEnds[lineAtMaxPos] )
+    if ( coord >= oper.GetLineEndPos(this, lineAtMaxPos) )
         return clipToMinMax ? maxPos : wxNOT_FOUND;
 
     // or before the first one
     const int lineAt0 = oper.GetLineAt(this, minPos);
     if ( coord < oper.GetLineStartPos(this, lineAt0) )
         return clipToMinMax ? minPos : wxNOT_FOUND;
-    else if ( coord < lineEnds[lineAt0] )
+    else if ( coord < oper.GetLineEndPos(this, lineAt0) )
         return minPos;
 
     // finally do perform the binary search
     while ( minPos < maxPos )
     {
-        wxCHECK_MSG( lineEnds[oper.GetLineAt(this, minPos)] <= coord &&
-                        coord < lineEnds[oper.GetLineAt(this, maxPos)],
+        wxCHECK_MSG( oper.GetLineEndPos(this, oper.GetLineAt(this, minPos)) <= coord &&
+                        coord < oper.GetLineEndPos(this, oper.GetLineAt(this, maxPos)),
                      -1,
                      "wxGrid: internal error in PosToLinePos()" );
 
-        if ( coord >= lineEnds[oper.GetLineAt(this, maxPos - 1)] )
+        if ( coord >= oper.GetLineEndPos(this, oper.GetLineAt(this, maxPos - 1)) )
             return maxPos;
         else
             maxPos--;
 
         const int median = minPos + (maxPos - minPos + 1) / 2;
-        if ( coord < lineEnds[oper.GetLineAt(this, median)] )
+        if ( coord < oper.GetLineEndPos(this, oper.GetLineAt(this, median)) )
             maxPos = median;
         else
             minPos = median;
@@ -9427,6 +10664,26 @@ wxGridCellAttr *wxGrid::GetOrCreateCellAttr(int row, int col) const
         attr->IncRef();
         m_table->SetAttr(attr, row, col);
     }
+    else // an existing attribute which the caller is going to modify
+    {
+        // if the attribute is shared with the other cells because of the
+        // interning done by the provider, replace it with a private copy
+        // first, as modifying it in place would change all of them
+        wxGridCellAttrProvider * const provider = m_table->GetAttrProvider();
+        if ( provider )
+        {
+            wxGridCellAttr * const
+                attrNew = provider->UnshareAttr(attr, row, col);
+            if ( attrNew != attr )
+            {
+                attr = attrNew;
+
+                // the cached attribute for this cell may still be the old
+                // shared one
+                const_cast<wxGrid *>(this)->ClearAttrCache();
+            }
+        }
+    }
 
     return attr;
 }
@@ -9741,6 +10998,9 @@ void wxGrid::SetDefaultRowSize( int height, bool resizeExistingRows )
 {
     m_defaultRowHeight = wxMax( height, m_minAcceptableRowHeight );
 
+    // any explicit heights must be compared with the new default now
+    m_uniformRows = -1;
+
     if ( resizeExistingRows )
     {
         // since we are resizing all rows to the default row size,
@@ -9749,6 +11009,8 @@ void wxGrid::SetDefaultRowSize( int height, bool resizeExistingRows )
         // some speed optimisations)
         m_rowHeights.Empty();
         m_rowBottoms.Empty();
+        m_rowBottomsPendingFrom = -1;
+        m_rowBottomsPendingDiff = 0;
         CalcDimensions();
     }
 }
@@ -9849,10 +11111,18 @@ void wxGrid::DoSetRowSize( int row, int height )
     if ( !diff )
         return;
 
-    for ( int i = row; i < m_numRows; i++ )
-    {
-        m_rowBottoms[i] += diff;
-    }
+    // this row may (not) have the default height now
+    m_uniformRows = -1;
+
+    // don't update the bottoms of all the following rows immediately: when a
+    // row is resized interactively we get here for every mouse move and
+    // doing this would make the drag quadratic in the number of rows, so
+    // just accumulate the delta as long as the same row keeps changing
+    if ( m_rowBottomsPendingFrom != -1 && m_rowBottomsPendingFrom != row )
+        FlushPendingRowBottoms();
+
+    m_rowBottomsPendingFrom = row;
+    m_rowBottomsPendingDiff += diff;
 
     InvalidateBestSize();
 
@@ -9951,6 +11221,9 @@ void wxGrid::SetDefaultColSize( int width, bool resizeExistingCols )
     // we dont allow zero default column width
     m_defaultColWidth = wxMax( wxMax( width, m_minAcceptableColWidth ), 1 );
 
+    // any explicit widths must be compared with the new default now
+    m_uniformCols = -1;
+
     if ( resizeExistingCols )
     {
         // since we are resizing all columns to the default column size,
@@ -9959,6 +11232,8 @@ void wxGrid::SetDefaultColSize( int width, bool resizeExistingCols )
         // some speed optimisations)
         m_colWidths.Empty();
         m_colRights.Empty();
+        m_colRightsPendingFrom = -1;
+        m_colRightsPendingDiff = 0;
 
         CalcDimensions();
     }
@@ -10026,6 +11301,9 @@ void wxGrid::DoSetColSize( int col, int width )
     if ( !diff )
         return;
 
+    // this column may (not) have the default width now
+    m_uniformCols = -1;
+
     if ( m_useNativeHeader )
     {
         // We have to update the native control if we're called from the
@@ -10039,9 +11317,25 @@ void wxGrid::DoSetColSize( int col, int width )
     }
     //else: will be refreshed when the header is redrawn
 
-    for ( int colPos = GetColPos(col); colPos < m_numCols; colPos++ )
+    if ( m_colAt.IsEmpty() )
+    {
+        // defer updating the rights of the following columns, see the
+        // comment in DoSetRowSize()
+        if ( m_colRightsPendingFrom != -1 && m_colRightsPendingFrom != col )
+            FlushPendingColRights();
+
+        m_colRightsPendingFrom = col;
+        m_colRightsPendingDiff += diff;
+    }
+    else // reordered columns: positions don't correspond to indices
     {
-        m_colRights[GetColAt(colPos)] += diff;
+        // there should be no pending delta in this case, but be safe
+        FlushPendingColRights();
+
+        for ( int colPos = GetColPos(col); colPos < m_numCols; colPos++ )
+        {
+            m_colRights[GetColAt(colPos)] += diff;
+        }
     }
 
     InvalidateBestSize();
@@ -25,6 +25,7 @@
     #include "wx/checkbox.h"
 #endif // WX_PRECOMP
 
+#include "wx/hashmap.h"
 #include "wx/numformatter.h"
 #include "wx/tokenzr.h"
 #include "wx/renderer.h"
@@ -71,6 +72,27 @@ void wxGridCellRenderer::Draw(wxGrid& grid,
     dc.DrawRectangle(rect);
 }
 
+// Changing the DC attributes can be relatively expensive, so only do it when
+// the value really changes: when repainting a grid, almost all the cells use
+// the same colours and font as the previous one.
+static void wxSetTextBackgroundIfNeeded(wxDC& dc, const wxColour& clr)
+{
+    if ( dc.GetTextBackground() != clr )
+        dc.SetTextBackground(clr);
+}
+
+static void wxSetTextForegroundIfNeeded(wxDC& dc, const wxColour& clr)
+{
+    if ( dc.GetTextForeground() != clr )
+        dc.SetTextForeground(clr);
+}
+
+static void wxSetFontIfNeeded(wxDC& dc, const wxFont& font)
+{
+    if ( dc.GetFont() != font )
+        dc.SetFont(font);
+}
+
 void wxGridCellRenderer::SetTextColoursAndFont(const wxGrid& grid,
                                                const wxGridCellAttr& attr,
                                                wxDC& dc,
@@ -90,22 +112,22 @@ void wxGridCellRenderer::SetTextColoursAndFont(const wxGrid& grid,
                 clr = grid.GetSelectionBackground();
             else
                 clr = wxSystemSettings::GetColour(wxSYS_COLOUR_BTNSHADOW);
-            dc.SetTextBackground( clr );
-            dc.SetTextForeground( grid.GetSelectionForeground() );
+            wxSetTextBackgroundIfNeeded( dc, clr );
+            wxSetTextForegroundIfNeeded( dc, grid.GetSelectionForeground() );
         }
         else
         {
-            dc.SetTextBackground( attr.GetBackgroundColour() );
-            dc.SetTextForeground( attr.GetTextColour() );
+            wxSetTextBackgroundIfNeeded( dc, attr.GetBackgroundColour() );
+            wxSetTextForegroundIfNeeded( dc, attr.GetTextColour() );
         }
     }
     else
     {
-        dc.SetTextBackground(wxSystemSettings::GetColour(wxSYS_COLOUR_BTNFACE));
-        dc.SetTextForeground(wxSystemSettings::GetColour(wxSYS_COLOUR_GRAYTEXT));
+        wxSetTextBackgroundIfNeeded(dc, wxSystemSettings::GetColour(wxSYS_COLOUR_BTNFACE));
+        wxSetTextForegroundIfNeeded(dc, wxSystemSettings::GetColour(wxSYS_COLOUR_GRAYTEXT));
     }
 
-    dc.SetFont( attr.GetFont() );
+    wxSetFontIfNeeded( dc, attr.GetFont() );
 }
 
 // ----------------------------------------------------------------------------
@@ -607,16 +629,87 @@ wxGridCellAutoWrapStringRenderer::GetBestWidth(wxGrid& grid,
     return width;
 }
 
+// ----------------------------------------------------------------------------
+// wxGridCellStringExtentCache
+// ----------------------------------------------------------------------------
+
+WX_DECLARE_STRING_HASH_MAP(wxSize, wxGridCellStringExtentMap);
+
+// Measuring text is by far the most expensive part of painting string cells
+// and the same values are measured again on every repaint, so cache the
+// extents, keyed by the cell value itself: entries for changed values simply
+// remain unused and are thrown away when the cache is flushed.
+class wxGridCellStringExtentCache
+{
+public:
+    wxGridCellStringExtentCache() { }
+
+    wxSize GetExtent(wxDC& dc, const wxString& text)
+    {
+        // All the cached extents were computed using the same font and
+        // resolution, so the cache must be flushed when either changes --
+        // which happens rarely, if ever, during the lifetime of a grid.
+        if ( dc.GetFont() != m_font || dc.GetPPI() != m_ppi )
+        {
+            m_map.clear();
+            m_font = dc.GetFont();
+            m_ppi = dc.GetPPI();
+        }
+
+        wxGridCellStringExtentMap::const_iterator it = m_map.find(text);
+        if ( it != m_map.end() )
+            return it->second;
+
+        const wxSize size = dc.GetMultiLineTextExtent(text);
+
+        // don't let the cache grow without bounds if the table contents
+        // keeps changing
+        if ( m_map.size() >= MAX_SIZE )
+            m_map.clear();
+
+        m_map[text] = size;
+
+        return size;
+    }
+
+private:
+    enum { MAX_SIZE = 4096 };
+
+    wxFont m_font;
+    wxSize m_ppi;
+    wxGridCellStringExtentMap m_map;
+
+    wxDECLARE_NO_COPY_CLASS(wxGridCellStringExtentCache);
+};
+
 // ----------------------------------------------------------------------------
 // wxGridCellStringRenderer
 // ----------------------------------------------------------------------------
 
+wxGridCellStringRenderer::wxGridCellStringRenderer()
+    : m_extentCache(new wxGridCellStringExtentCache)
+{
+}
+
+wxGridCellStringRenderer::wxGridCellStringRenderer(
+        const wxGridCellStringRenderer& WXUNUSED(other))
+    : m_extentCache(new wxGridCellStringExtentCache)
+{
+    // there is no point in sharing or copying the cache contents, so this
+    // copy ctor only exists to prevent copying the pointer itself
+}
+
+wxGridCellStringRenderer::~wxGridCellStringRenderer()
+{
+    delete m_extentCache;
+}
+
 wxSize wxGridCellStringRenderer::DoGetBestSize(const wxGridCellAttr& attr,
                                                wxDC& dc,
                                                const wxString& text)
 {
     dc.SetFont(attr.GetFont());
-    return dc.GetMultiLineTextExtent(text);
+    return m_extentCache->GetExtent(dc, text);
 }
 
 wxSize wxGridCellStringRenderer::GetBestSize(wxGrid& grid,
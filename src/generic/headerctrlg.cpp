@@ -563,7 +563,9 @@ void wxHeaderCtrl::OnPaint(wxPaintEvent& WXUNUSED(event))
         }
 #endif
 
-        wxRendererNative::Get().DrawHeaderButton
+        // use the caching renderer: the column backgrounds only differ in
+        // their size and state, so most of them are blitted from the cache
+        wxRendererNative::GetCached().DrawHeaderButton
                                 (
                                     this,
                                     dc,
@@ -580,7 +582,7 @@ void wxHeaderCtrl::OnPaint(wxPaintEvent& WXUNUSED(event))
         int state = wxCONTROL_DIRTY;
         if (!IsEnabled())
             state |= wxCONTROL_DISABLED;
-        wxRendererNative::Get().DrawHeaderButton(
+        wxRendererNative::GetCached().DrawHeaderButton(
             this, dc, wxRect(xpos, 0, w - xpos, h), state);
     }
 }
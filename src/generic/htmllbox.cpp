@@ -21,6 +21,7 @@
 
 
 #ifndef WX_PRECOMP
+    #include "wx/app.h"
     #include "wx/dcclient.h"
 #endif //WX_PRECOMP
 
@@ -65,30 +66,58 @@ private:
         wxDELETE(m_cells[n]);
     }
 
-public:
-    wxHtmlListBoxCache()
+    // allocate the arrays for the given number of the items, they start empty
+    void Alloc(size_t size)
     {
-        for ( size_t n = 0; n < SIZE; n++ )
+        m_size = size ? size : 1;
+        m_next = 0;
+
+        m_cells = new wxHtmlCell *[m_size];
+        m_items = new size_t[m_size];
+        for ( size_t n = 0; n < m_size; n++ )
         {
             m_items[n] = (size_t)-1;
             m_cells[n] = NULL;
         }
-
-        m_next = 0;
     }
 
-    ~wxHtmlListBoxCache()
+    // free the arrays and all the cells stored in them
+    void Free()
     {
-        for ( size_t n = 0; n < SIZE; n++ )
+        for ( size_t n = 0; n < m_size; n++ )
         {
             delete m_cells[n];
         }
+
+        delete [] m_cells;
+        delete [] m_items;
+    }
+
+public:
+    wxHtmlListBoxCache()
+    {
+        Alloc(DEFAULT_SIZE);
+    }
+
+    ~wxHtmlListBoxCache()
+    {
+        Free();
+    }
+
+    // get or change the number of the items we cache: changing the size
+    // drops all the currently cached cells
+    size_t GetSize() const { return m_size; }
+
+    void SetSize(size_t size)
+    {
+        Free();
+        Alloc(size);
     }
 
     // completely invalidate the cache
     void Clear()
     {
-        for ( size_t n = 0; n < SIZE; n++ )
+        for ( size_t n = 0; n < m_size; n++ )
         {
             InvalidateItem(n);
         }
@@ -97,7 +126,7 @@ public:
     // return the cached cell for this index or NULL if none
     wxHtmlCell *Get(size_t item) const
     {
-        for ( size_t n = 0; n < SIZE; n++ )
+        for ( size_t n = 0; n < m_size; n++ )
         {
             if ( m_items[n] == item )
                 return m_cells[n];
@@ -117,14 +146,14 @@ public:
         m_items[m_next] = item;
 
         // advance to the next item wrapping around if there are no more
-        if ( ++m_next == SIZE )
+        if ( ++m_next == m_size )
             m_next = 0;
     }
 
     // forget the cached value of the item(s) between the given ones (inclusive)
     void InvalidateRange(size_t from, size_t to)
     {
-        for ( size_t n = 0; n < SIZE; n++ )
+        for ( size_t n = 0; n < m_size; n++ )
         {
             if ( m_items[n] >= from && m_items[n] <= to )
             {
@@ -134,17 +163,20 @@ public:
     }
 
 private:
-    // the max number of the items we cache
-    enum { SIZE = 50 };
+    // the max number of the items we cache by default
+    enum { DEFAULT_SIZE = 50 };
+
+    // the current max number of the items we cache
+    size_t m_size;
 
     // the index of the LRU (oldest) cell
     size_t m_next;
 
     // the parsed representation of the cached item or NULL
-    wxHtmlCell *m_cells[SIZE];
+    wxHtmlCell **m_cells;
 
     // the index of the currently cached item (only valid if m_cells != NULL)
-    size_t m_items[SIZE];
+    size_t *m_items;
 };
 
 // ----------------------------------------------------------------------------
@@ -327,7 +359,79 @@ wxHtmlCell* wxHtmlListBox::CreateCellForItem(size_t n) const
 void wxHtmlListBox::CacheItem(size_t n) const
 {
     if ( !m_cache->Has(n) )
-        m_cache->Store(n, CreateCellForItem(n));
+    {
+        wxHtmlCell * const cell = CreateCellForItem(n);
+        m_cache->Store(n, cell);
+
+        // measuring the item later would parse it again, so remember its
+        // height while we have its cells anyhow
+        CacheRowHeight(n, cell);
+    }
+}
+
+void wxHtmlListBox::SetCellCacheSize(size_t size)
+{
+    m_cache->SetSize(size);
+}
+
+size_t wxHtmlListBox::GetCellCacheSize() const
+{
+    return m_cache->GetSize();
+}
+
+void wxHtmlListBox::CacheRowHeight(size_t n, const wxHtmlCell *cell) const
+{
+    if ( cell && n < m_rowHeights.size() )
+        m_rowHeights[n] = cell->GetHeight() + cell->GetDescent() + 4;
+}
+
+void wxHtmlListBox::InvalidateRowHeights(size_t from, size_t to)
+{
+    if ( to >= m_rowHeights.size() )
+        to = m_rowHeights.size() ? m_rowHeights.size() - 1 : 0;
+
+    for ( size_t n = from; n <= to && n < m_rowHeights.size(); n++ )
+        m_rowHeights[n] = wxDefaultCoord;
+}
+
+bool wxHtmlListBox::PreCacheAdjacentItem()
+{
+    const size_t count = GetItemCount();
+    if ( !count || !IsShownOnScreen() )
+        return false;
+
+    const size_t first = GetVisibleBegin(),
+                 last = GetVisibleEnd();    // exclusive
+    const size_t numVisible = last - first;
+
+    // don't pre-parse anything if this could evict the cells of the visible
+    // items themselves from the cache
+    const size_t size = m_cache->GetSize();
+    if ( size <= numVisible + 1 )
+        return false;
+
+    // look at most this far beyond the visible area in each direction
+    const size_t lookAhead = (size - numVisible) / 2;
+
+    for ( size_t dist = 1; dist <= lookAhead; dist++ )
+    {
+        // prefer the items below the visible area as scrolling down is more
+        // common than scrolling up
+        const size_t below = last + dist - 1;
+        if ( below < count && !m_cache->Has(below) )
+        {
+            CacheItem(below);
+            return true;
+        }
+
+        if ( first >= dist && !m_cache->Has(first - dist) )
+        {
+            CacheItem(first - dist);
+            return true;
+        }
+    }
+
+    return false;
 }
 
 void wxHtmlListBox::OnSize(wxSizeEvent& event)
@@ -335,12 +439,16 @@ void wxHtmlListBox::OnSize(wxSizeEvent& event)
     // we need to relayout all the cached cells
     m_cache->Clear();
 
+    // and the heights are measured for the old width, so remeasure them too
+    InvalidateRowHeights(0, m_rowHeights.size());
+
     event.Skip();
 }
 
 void wxHtmlListBox::RefreshRow(size_t line)
 {
     m_cache->InvalidateRange(line, line);
+    InvalidateRowHeights(line, line);
 
     wxVListBox::RefreshRow(line);
 }
@@ -348,6 +456,7 @@ void wxHtmlListBox::RefreshRow(size_t line)
 void wxHtmlListBox::RefreshRows(size_t from, size_t to)
 {
     m_cache->InvalidateRange(from, to);
+    InvalidateRowHeights(from, to);
 
     wxVListBox::RefreshRows(from, to);
 }
@@ -355,6 +464,7 @@ void wxHtmlListBox::RefreshRows(size_t from, size_t to)
 void wxHtmlListBox::RefreshAll()
 {
     m_cache->Clear();
+    InvalidateRowHeights(0, m_rowHeights.size());
 
     wxVListBox::RefreshAll();
 }
@@ -363,6 +473,7 @@ void wxHtmlListBox::SetItemCount(size_t count)
 {
     // the items are going to change, forget the old ones
     m_cache->Clear();
+    m_rowHeights.assign(count, wxDefaultCoord);
 
     wxVListBox::SetItemCount(count);
 }
@@ -427,6 +538,11 @@ void wxHtmlListBox::OnDrawItem(wxDC& dc, const wxRect& rect, size_t n) const
 
 wxCoord wxHtmlListBox::OnMeasureItem(size_t n) const
 {
+    // use the height remembered from the last time this item was parsed, if
+    // any: this makes scrolling over the already seen items parse-free
+    if ( n < m_rowHeights.size() && m_rowHeights[n] != wxDefaultCoord )
+        return m_rowHeights[n];
+
     // Notice that we can't cache the cell here because we could be called from
     // some code updating an existing cell which could be displaced from the
     // cache if we called CacheItem() and destroyed -- resulting in a crash
@@ -438,6 +554,9 @@ wxCoord wxHtmlListBox::OnMeasureItem(size_t n) const
     const wxCoord h = cell->GetHeight() + cell->GetDescent() + 4;
     delete cell;
 
+    if ( n < m_rowHeights.size() )
+        m_rowHeights[n] = h;
+
     return h;
 }
 
@@ -564,6 +683,12 @@ void wxHtmlListBox::OnInternalIdle()
 {
     wxVListBox::OnInternalIdle();
 
+    // pre-parse the items around the visible area, one per idle iteration to
+    // avoid blocking the GUI, so that scrolling to them doesn't need to parse
+    // them any more
+    if ( PreCacheAdjacentItem() )
+        wxWakeUpIdle();
+
     if ( wxHtmlWindowMouseHelper::DidMouseMove() )
     {
         wxPoint pos = ScreenToClient(wxGetMousePosition());
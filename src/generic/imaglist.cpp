@@ -20,6 +20,7 @@
     #include "wx/image.h"
 #endif
 
+#include "wx/dcmemory.h"
 #include "wx/settings.h"
 
 //-----------------------------------------------------------------------------
@@ -31,11 +32,17 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxImageList, wxGenericImageList);
 
 wxGenericImageList::wxGenericImageList()
 {
+    m_atlasDC = NULL;
+    m_atlasValid = false;
+
     Create(0, 0, false);
 }
 
 wxGenericImageList::wxGenericImageList( int width, int height, bool mask, int initialCount )
 {
+    m_atlasDC = NULL;
+    m_atlasValid = false;
+
     (void)Create(width, height, mask, initialCount);
 }
 
@@ -49,6 +56,11 @@ void wxGenericImageList::Destroy()
 
 wxGenericImageList::~wxGenericImageList()
 {
+    if ( m_atlasDC )
+    {
+        m_atlasDC->SelectObject(wxNullBitmap);
+        delete m_atlasDC;
+    }
 }
 
 int wxGenericImageList::GetImageCount() const
@@ -160,6 +172,57 @@ wxBitmap GetImageListBitmap(const wxBitmap& bitmap, bool useMask, const wxSize&
 }
 };
 
+void wxGenericImageList::InvalidateAtlas()
+{
+    if ( m_atlasDC )
+        m_atlasDC->SelectObject(wxNullBitmap);
+    m_atlas = wxNullBitmap;
+    m_atlasValid = false;
+}
+
+void wxGenericImageList::BuildAtlas() const
+{
+    // Whether building the atlas succeeds or not, don't try again until the
+    // list contents changes.
+    m_atlasValid = true;
+
+#if wxUSE_IMAGE
+    const size_t count = m_images.size();
+
+    // A single image can just as well be drawn directly.
+    if ( count < 2 )
+        return;
+
+    // The atlas always uses alpha for transparency: a single mask couldn't
+    // represent images using different mask colours.
+    const wxSize physSize = m_scaleFactor * m_size;
+
+    wxImage atlasImg(count * physSize.x, physSize.y);
+    for ( size_t n = 0; n < count; n++ )
+    {
+        wxImage img = m_images[n].ConvertToImage();
+        if ( !img.IsOk() )
+            return;
+
+        // Convert the mask, if any, to alpha (and make images without any
+        // transparency fully opaque): pasting an image with alpha but
+        // without mask simply copies both the pixels and the alpha values.
+        if ( !img.HasAlpha() )
+            img.InitAlpha();
+
+        atlasImg.Paste(img, n * physSize.x, 0);
+    }
+
+    m_atlas = wxBitmap(atlasImg, -1, m_scaleFactor);
+    if ( !m_atlas.IsOk() )
+        return;
+
+    if ( !m_atlasDC )
+        m_atlasDC = new wxMemoryDC;
+    m_atlasDC->SelectObject(m_atlas);
+#endif // wxUSE_IMAGE
+}
+
 int wxGenericImageList::Add( const wxBitmap &bitmap )
 {
     // Cannot add image to invalid list
@@ -203,6 +266,8 @@ int wxGenericImageList::Add( const wxBitmap &bitmap )
         return -1;
     }
 
+    InvalidateAtlas();
+
     return GetImageCount() - 1;
 }
 
@@ -272,6 +337,8 @@ wxGenericImageList::Replace(int index,
 
     m_images[index] = GetImageListBitmap(bmp, m_useMask, m_size, m_scaleFactor);
 
+    InvalidateAtlas();
+
     return true;
 }
 
@@ -282,6 +349,8 @@ bool wxGenericImageList::Remove( int index )
 
     m_images.erase(m_images.begin() + index);
 
+    InvalidateAtlas();
+
     return true;
 }
 
@@ -289,6 +358,8 @@ bool wxGenericImageList::RemoveAll()
 {
     m_images.clear();
 
+    InvalidateAtlas();
+
     return true;
 }
 
@@ -309,6 +380,24 @@ bool wxGenericImageList::Draw( int index, wxDC &dc, int x, int y,
     if ( !bmp )
         return false;
 
+    // The atlas represents transparency using alpha, so it can only be used
+    // for transparent drawing, but this is by far the most common case and
+    // the only one mattering for performance, as the controls drawing many
+    // images in a row always use it.
+    if ( flags & wxIMAGELIST_DRAW_TRANSPARENT )
+    {
+        if ( !m_atlasValid )
+            BuildAtlas();
+
+        if ( m_atlasDC && m_atlas.IsOk() )
+        {
+            dc.Blit(x, y, m_size.x, m_size.y,
+                    m_atlasDC, index * m_size.x, 0,
+                    wxCOPY, true /* use mask/alpha */);
+            return true;
+        }
+    }
+
     dc.DrawBitmap(*bmp, x, y, (flags & wxIMAGELIST_DRAW_TRANSPARENT) != 0);
 
     return true;
@@ -37,6 +37,7 @@
 #include "wx/renderer.h"
 #include "wx/generic/private/listctrl.h"
 #include "wx/generic/private/widthcalc.h"
+#include "wx/private/parallelsort.h"
 
 #ifdef __WXMAC__
     #include "wx/osx/private.h"
@@ -137,6 +138,10 @@ void wxListItemData::Init()
     m_data = 0;
 
     m_attr = NULL;
+
+    m_textWidth =
+    m_textHeight = 0;
+    m_extentsGeneration = 0;
 }
 
 wxListItemData::wxListItemData(wxListMainWindow *owner)
@@ -212,6 +217,26 @@ void wxListItemData::SetSize( int width, int height )
         m_rect->height = height;
 }
 
+void wxListItemData::GetTextExtentCached(wxDC& dc, wxCoord *width, wxCoord *height)
+{
+    if ( m_extentsGeneration != m_owner->GetExtentsGeneration() )
+    {
+        // measure the text as it is drawn, i.e. with the line breaks replaced
+        // by spaces (see wxListLineData::DrawTextFormatted())
+        wxString text(m_text);
+        text.Replace(wxT("\n"), wxT(" "));
+
+        dc.GetTextExtent(text, &m_textWidth, &m_textHeight);
+
+        m_extentsGeneration = m_owner->GetExtentsGeneration();
+    }
+
+    if ( width )
+        *width = m_textWidth;
+    if ( height )
+        *height = m_textHeight;
+}
+
 bool wxListItemData::IsHit( int x, int y ) const
 {
     wxCHECK_MSG( m_rect, false, wxT("can't be called in this mode") );
@@ -856,12 +881,12 @@ void wxListLineData::DrawInReportMode( wxDC *dc,
         }
 
         if ( item->HasText() )
-            DrawTextFormatted(dc, item->GetText(), col, xOld, yMid, width);
+            DrawTextFormatted(dc, item, col, xOld, yMid, width);
     }
 }
 
 void wxListLineData::DrawTextFormatted(wxDC *dc,
-                                       const wxString& textOrig,
+                                       wxListItemData *item,
                                        int col,
                                        int x,
                                        int yMid,
@@ -869,11 +894,13 @@ void wxListLineData::DrawTextFormatted(wxDC *dc,
 {
     // we don't support displaying multiple lines currently (and neither does
     // wxMSW FWIW) so just merge all the lines
-    wxString text(textOrig);
+    wxString text(item->GetText());
     text.Replace(wxT("\n"), wxT(" "));
 
+    // use the cached extent to avoid remeasuring the whole string every time
+    // the line is repainted
     wxCoord w, h;
-    dc->GetTextExtent(text, &w, &h);
+    item->GetTextExtentCached(*dc, &w, &h);
 
     const wxCoord y = yMid - (h + 1)/2;
 
@@ -1579,6 +1606,8 @@ void wxListMainWindow::Init()
     m_headerWidth =
     m_lineHeight = 0;
 
+    m_extentsGeneration = 1;
+
     m_small_image_list = NULL;
     m_normal_image_list = NULL;
 
@@ -3426,8 +3455,10 @@ class wxListCtrlMaxWidthCalculator : public wxMaxWidthCalculatorBase
 public:
     wxListCtrlMaxWidthCalculator(wxListMainWindow *listmain, unsigned int column)
         : wxMaxWidthCalculatorBase(column),
-          m_listmain(listmain)
+          m_listmain(listmain),
+          m_dc(listmain)
     {
+        m_dc.SetFont(listmain->GetFont());
     }
 
     virtual void UpdateWithRow(int row) wxOVERRIDE
@@ -3437,16 +3468,15 @@ public:
 
         wxCHECK_RET( n, wxS("no subitem?") );
 
-        wxListItemData* const itemData = n->GetData();
-
-        wxListItem item;
-        itemData->GetItem(item);
-
-        UpdateWithWidth(m_listmain->GetItemWidthWithImage(&item));
+        UpdateWithWidth(m_listmain->GetItemWidthWithImage(n->GetData(), m_dc));
     }
 
 private:
     wxListMainWindow* const m_listmain;
+
+    // shared by all the rows: creating a new wxClientDC for each of them is
+    // far too slow when computing the best width of a column with many rows
+    wxClientDC m_dc;
 };
 
 
@@ -4708,6 +4738,27 @@ int wxListMainWindow::GetItemWidthWithImage(wxListItem * item)
     return width;
 }
 
+int wxListMainWindow::GetItemWidthWithImage(wxListItemData *itemData, wxDC& dc)
+{
+    int width = 0;
+
+    if (itemData->HasImage())
+    {
+        int ix, iy;
+        GetImageSize( itemData->GetImage(), ix, iy );
+        width += ix + IMAGE_MARGIN_IN_REPORT_MODE;
+    }
+
+    if (itemData->HasText())
+    {
+        wxCoord w;
+        itemData->GetTextExtentCached( dc, &w, NULL );
+        width += w;
+    }
+
+    return width;
+}
+
 // ----------------------------------------------------------------------------
 // sorting
 // ----------------------------------------------------------------------------
@@ -4742,7 +4793,12 @@ void wxListMainWindow::SortItems( wxListCtrlCompare fn, wxIntPtr data )
     HighlightAll(false);
     ResetCurrent();
 
-    std::sort(m_lines.begin(), m_lines.end(), wxListLineComparator(fn, data));
+    // Use a stable sort which may parallelize the work for very long lists;
+    // the caller-provided comparator only receives the item data values, so
+    // calling it concurrently is safe as long as it is a pure function, which
+    // sorting comparators must be anyhow.
+    wxParallelStableSort(m_lines.begin(), m_lines.end(),
+                         wxListLineComparator(fn, data));
 
     m_dirty = true;
 }
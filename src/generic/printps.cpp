@@ -183,7 +183,7 @@ bool wxPostScriptPrinter::Print(wxWindow *parent, wxPrintout *printout, bool pro
                if(progressDialog->Update(printedPages++, msg))
                {
                   dc->StartPage();
-                  printout->OnPrintPage(pn);
+                  printout->PrintPage(pn);
                   dc->EndPage();
                }
                else
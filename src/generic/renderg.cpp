@@ -31,7 +31,10 @@
     #include "wx/control.h"
 #endif //WX_PRECOMP
 
+#include "wx/dcmemory.h"
 #include "wx/dcmirror.h"
+#include "wx/eventfilter.h"
+#include "wx/hashmap.h"
 #include "wx/math.h"
 #include "wx/splitter.h"
 
@@ -1010,6 +1013,262 @@ wxRendererGeneric::DrawItemText(wxWindow* WXUNUSED(win),
     dc.DrawLabel(paintText, rect, align);
 }
 
+// ============================================================================
+// wxCachedRendererNative implementation
+// ============================================================================
+
+WX_DECLARE_STRING_HASH_MAP(wxBitmap, wxRendererPartBitmaps);
+
+// The cache itself: it also acts as an event filter in order to notice the
+// system colour (i.e. theme) changes sent to any window and drop the cached
+// bitmaps rendered with the old theme.
+class wxRendererPartCache : public wxEventFilter
+{
+public:
+    wxRendererPartCache()
+    {
+        wxEvtHandler::AddFilter(this);
+    }
+
+    virtual ~wxRendererPartCache()
+    {
+        wxEvtHandler::RemoveFilter(this);
+    }
+
+    virtual int FilterEvent(wxEvent& event) wxOVERRIDE
+    {
+        const wxEventType t = event.GetEventType();
+        if ( t == wxEVT_SYS_COLOUR_CHANGED || t == wxEVT_DPI_CHANGED )
+            bitmaps.clear();
+
+        return Event_Skip;
+    }
+
+    wxRendererPartBitmaps bitmaps;
+
+    wxDECLARE_NO_COPY_CLASS(wxRendererPartCache);
+};
+
+wxCachedRendererNative::wxCachedRendererNative(wxRendererNative& rendererNative)
+    : wxDelegateRendererNative(rendererNative),
+      m_cache(new wxRendererPartCache)
+{
+}
+
+wxCachedRendererNative::~wxCachedRendererNative()
+{
+    delete m_cache;
+}
+
+void wxCachedRendererNative::InvalidateCache()
+{
+    m_cache->bitmaps.clear();
+}
+
+wxBitmap
+wxCachedRendererNative::CachePart(CachedPart part,
+                                  wxWindow *win,
+                                  const wxSize& size,
+                                  int flags)
+{
+    if ( size.x <= 0 || size.y <= 0 )
+        return wxBitmap();
+
+    // parts not filling their rectangle completely are composed on the
+    // window background, so it must be part of the key too
+    const wxColour bg = win->GetBackgroundColour();
+    const double scale = win->GetContentScaleFactor();
+
+    const wxString key = wxString::Format
+                         (
+                            wxS("%d-%08x-%dx%d-%08x-%g"),
+                            static_cast<int>(part),
+                            static_cast<unsigned>(flags),
+                            size.x, size.y,
+                            static_cast<unsigned>(bg.GetRGBA()),
+                            scale
+                         );
+
+    wxRendererPartBitmaps::iterator it = m_cache->bitmaps.find(key);
+    if ( it != m_cache->bitmaps.end() )
+        return it->second;
+
+    wxBitmap bmp;
+    if ( !bmp.CreateScaled(size.x, size.y, wxBITMAP_SCREEN_DEPTH, scale) )
+        return wxBitmap();
+
+    const wxRect rect(size);
+
+    {
+        wxMemoryDC dc(bmp);
+        if ( !dc.IsOk() )
+            return wxBitmap();
+
+        dc.SetBackground(wxBrush(bg));
+        dc.Clear();
+
+        switch ( part )
+        {
+            case Part_HeaderButton:
+                // render the background only: the label and the sort arrow
+                // are drawn separately by our DrawHeaderButton()
+                m_rendererNative.DrawHeaderButton(win, dc, rect, flags);
+                break;
+
+            case Part_TreeItemButton:
+                m_rendererNative.DrawTreeItemButton(win, dc, rect, flags);
+                break;
+
+            case Part_ComboBoxDropButton:
+                m_rendererNative.DrawComboBoxDropButton(win, dc, rect, flags);
+                break;
+
+            case Part_CheckBox:
+                m_rendererNative.DrawCheckBox(win, dc, rect, flags);
+                break;
+
+            case Part_CheckMark:
+                m_rendererNative.DrawCheckMark(win, dc, rect, flags);
+                break;
+
+            case Part_CollapseButton:
+                m_rendererNative.DrawCollapseButton(win, dc, rect, flags);
+                break;
+
+            case Part_RadioBitmap:
+                m_rendererNative.DrawRadioBitmap(win, dc, rect, flags);
+                break;
+        }
+    }
+
+    m_cache->bitmaps[key] = bmp;
+
+    return bmp;
+}
+
+int
+wxCachedRendererNative::DrawHeaderButton(wxWindow *win,
+                                         wxDC& dc,
+                                         const wxRect& rect,
+                                         int flags,
+                                         wxHeaderSortIconType sortArrow,
+                                         wxHeaderButtonParams* params)
+{
+    wxBitmap bmp = CachePart(Part_HeaderButton, win, rect.GetSize(), flags);
+    if ( !bmp.IsOk() )
+        return m_rendererNative.DrawHeaderButton(win, dc, rect, flags,
+                                                 sortArrow, params);
+
+    dc.DrawBitmap(bmp, rect.x, rect.y);
+
+    // the label and the sort arrow differ from column to column, so they
+    // are always drawn directly
+    return m_rendererNative.DrawHeaderButtonContents(win, dc, rect, flags,
+                                                     sortArrow, params);
+}
+
+void
+wxCachedRendererNative::DrawTreeItemButton(wxWindow *win,
+                                           wxDC& dc,
+                                           const wxRect& rect,
+                                           int flags)
+{
+    wxBitmap bmp = CachePart(Part_TreeItemButton, win, rect.GetSize(), flags);
+    if ( bmp.IsOk() )
+        dc.DrawBitmap(bmp, rect.x, rect.y);
+    else
+        m_rendererNative.DrawTreeItemButton(win, dc, rect, flags);
+}
+
+void
+wxCachedRendererNative::DrawComboBoxDropButton(wxWindow *win,
+                                               wxDC& dc,
+                                               const wxRect& rect,
+                                               int flags)
+{
+    wxBitmap bmp = CachePart(Part_ComboBoxDropButton, win,
+                             rect.GetSize(), flags);
+    if ( bmp.IsOk() )
+        dc.DrawBitmap(bmp, rect.x, rect.y);
+    else
+        m_rendererNative.DrawComboBoxDropButton(win, dc, rect, flags);
+}
+
+void
+wxCachedRendererNative::DrawCheckBox(wxWindow *win,
+                                     wxDC& dc,
+                                     const wxRect& rect,
+                                     int flags)
+{
+    wxBitmap bmp = CachePart(Part_CheckBox, win, rect.GetSize(), flags);
+    if ( bmp.IsOk() )
+        dc.DrawBitmap(bmp, rect.x, rect.y);
+    else
+        m_rendererNative.DrawCheckBox(win, dc, rect, flags);
+}
+
+void
+wxCachedRendererNative::DrawCheckMark(wxWindow *win,
+                                      wxDC& dc,
+                                      const wxRect& rect,
+                                      int flags)
+{
+    wxBitmap bmp = CachePart(Part_CheckMark, win, rect.GetSize(), flags);
+    if ( bmp.IsOk() )
+        dc.DrawBitmap(bmp, rect.x, rect.y);
+    else
+        m_rendererNative.DrawCheckMark(win, dc, rect, flags);
+}
+
+void
+wxCachedRendererNative::DrawCollapseButton(wxWindow *win,
+                                           wxDC& dc,
+                                           const wxRect& rect,
+                                           int flags)
+{
+    wxBitmap bmp = CachePart(Part_CollapseButton, win, rect.GetSize(), flags);
+    if ( bmp.IsOk() )
+        dc.DrawBitmap(bmp, rect.x, rect.y);
+    else
+        m_rendererNative.DrawCollapseButton(win, dc, rect, flags);
+}
+
+void
+wxCachedRendererNative::DrawRadioBitmap(wxWindow *win,
+                                        wxDC& dc,
+                                        const wxRect& rect,
+                                        int flags)
+{
+    wxBitmap bmp = CachePart(Part_RadioBitmap, win, rect.GetSize(), flags);
+    if ( bmp.IsOk() )
+        dc.DrawBitmap(bmp, rect.x, rect.y);
+    else
+        m_rendererNative.DrawRadioBitmap(win, dc, rect, flags);
+}
+
+// ----------------------------------------------------------------------------
+// wxRendererNative::GetCached()
+// ----------------------------------------------------------------------------
+
+// the global caching proxy and the renderer it was created for: if the
+// active renderer is replaced with Set(), the proxy is recreated
+static wxCachedRendererNative *gs_cachedRenderer = NULL;
+static wxRendererNative *gs_cachedRendererTarget = NULL;
+
+/* static */
+wxRendererNative& wxRendererNative::GetCached()
+{
+    wxRendererNative& current = Get();
+    if ( !gs_cachedRenderer || gs_cachedRendererTarget != &current )
+    {
+        delete gs_cachedRenderer;
+        gs_cachedRenderer = new wxCachedRendererNative(current);
+        gs_cachedRendererTarget = &current;
+    }
+
+    return *gs_cachedRenderer;
+}
+
 // ----------------------------------------------------------------------------
 // A module to allow cleanup of generic renderer.
 // ----------------------------------------------------------------------------
@@ -1020,7 +1279,13 @@ class wxGenericRendererModule: public wxModule
 public:
     wxGenericRendererModule() {}
     bool OnInit() wxOVERRIDE { return true; }
-    void OnExit() wxOVERRIDE { wxRendererGeneric::Cleanup(); }
+    void OnExit() wxOVERRIDE
+    {
+        wxDELETE(gs_cachedRenderer);
+        gs_cachedRendererTarget = NULL;
+
+        wxRendererGeneric::Cleanup();
+    }
 };
 
 wxIMPLEMENT_DYNAMIC_CLASS(wxGenericRendererModule, wxModule);
@@ -31,15 +31,42 @@
 // RowRanges
 // ----------------------------------------------------------------------------
 
+size_t RowRanges::FindRange(unsigned int row) const
+{
+    // binary search for the first range ending after row: the ranges are
+    // sorted and don't overlap, so it is the only one which could contain it
+    size_t lo = 0;
+    size_t hi = m_ranges.size();
+    while (lo < hi)
+    {
+        const size_t mid = (lo + hi) / 2;
+        if (m_ranges[mid].to <= row)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
 void RowRanges::Add(unsigned int row)
 {
-    size_t count = m_ranges.size();
-    size_t rngIdx = 0;
-    for (rngIdx = 0; rngIdx < count; ++rngIdx)
+    size_t rngIdx = FindRange(row);
+
+    if (rngIdx > 0 && m_ranges[rngIdx - 1].to == row)
+    {
+        // extend the previous range at the end (set to row+1 because 'to' is
+        // not including)
+        m_ranges[rngIdx - 1].to = row + 1;
+        m_countsValid = false;
+        CleanUp(rngIdx - 1);
+        return;
+    }
+
+    if (rngIdx < m_ranges.size())
     {
         RowRange &rng = m_ranges[rngIdx];
 
-        if (row >= rng.from && rng.to > row)
+        if (row >= rng.from)
         {
             // index already in range
             return;
@@ -49,54 +76,74 @@ void RowRanges::Add(unsigned int row)
         {
             // extend range at the beginning (to the left)
             rng.from = row;
+            m_countsValid = false;
             // no cleanup necessary
             return;
         }
-        if (row == rng.to)
-        {
-            // extend range at the end (set to row+1 because 'to' is not
-            // including)
-            rng.to = row + 1;
-            CleanUp(rngIdx);
-            return;
-        }
-
-        if (rng.from > row + 1)
-        {
-            // this range is already behind row index, so break here and insert
-            // a new range before
-            break;
-        }
     }
 
     RowRange newRange;
     newRange.from = row;
     newRange.to = row + 1;
     m_ranges.insert(m_ranges.begin() + rngIdx, newRange);
+    m_countsValid = false;
 }
 
 void RowRanges::Remove(unsigned int row)
 {
-    size_t count = m_ranges.size();
-    size_t rngIdx = 0;
-    while (rngIdx < count)
+    // all the ranges starting behind row index are removed entirely and the
+    // one containing it, if any, is cut off at row index to exclude row
+    size_t rngIdx = FindRange(row);
+    if (rngIdx == m_ranges.size())
+        return;
+
+    if (m_ranges[rngIdx].from < row)
     {
-        RowRange &rng = m_ranges[rngIdx];
-        if (rng.from >= row)
-        {
-            // this range starts behind row index, so remove it
-            m_ranges.erase(m_ranges.begin() + rngIdx);
-            count--;
-            continue;
-        }
-        if (rng.to > row)
-        {
-            // this ranges includes row, so cut off at row index to exclude row
-            rng.to = row;
-        }
+        m_ranges[rngIdx].to = row;
+        rngIdx++;
+    }
 
-        rngIdx += 1;
+    m_ranges.erase(m_ranges.begin() + rngIdx, m_ranges.end());
+    m_countsValid = false;
+}
+
+void RowRanges::RemoveSingle(unsigned int row)
+{
+    const size_t rngIdx = FindRange(row);
+    if (rngIdx == m_ranges.size())
+        return;
+
+    RowRange &rng = m_ranges[rngIdx];
+    if (row < rng.from)
+    {
+        // not contained in any range
+        return;
+    }
+
+    if (rng.to - rng.from == 1)
+    {
+        // the range contains only this row
+        m_ranges.erase(m_ranges.begin() + rngIdx);
+    }
+    else if (row == rng.from)
+    {
+        rng.from = row + 1;
+    }
+    else if (row == rng.to - 1)
+    {
+        rng.to = row;
     }
+    else
+    {
+        // the row lies strictly inside the range which must be split in two
+        RowRange tail;
+        tail.from = row + 1;
+        tail.to = rng.to;
+        rng.to = row;
+        m_ranges.insert(m_ranges.begin() + rngIdx + 1, tail);
+    }
+
+    m_countsValid = false;
 }
 
 
@@ -137,50 +184,47 @@ void RowRanges::CleanUp(unsigned int idx)
 
 bool RowRanges::Has(unsigned int row) const
 {
-    size_t count = m_ranges.size();
-    for (size_t rngIdx = 0; rngIdx < count; rngIdx++)
-    {
-        const RowRange &rng = m_ranges[rngIdx];
-        if (rng.from <= row && row < rng.to)
-        {
-            return true;
-        }
-    }
-    return false;
+    const size_t rngIdx = FindRange(row);
+    return rngIdx < m_ranges.size() && m_ranges[rngIdx].from <= row;
 }
 
-unsigned int RowRanges::CountAll() const
+void RowRanges::UpdateCounts() const
 {
+    m_countTo.clear();
+    m_countTo.reserve(m_ranges.size());
+
     unsigned int ctr = 0;
     size_t count = m_ranges.size();
     for (size_t rngIdx = 0; rngIdx < count; rngIdx++)
     {
         const RowRange &rng = m_ranges[rngIdx];
         ctr += rng.to - rng.from;
+        m_countTo.push_back(ctr);
     }
-    return ctr;
+
+    m_countsValid = true;
+}
+
+unsigned int RowRanges::CountAll() const
+{
+    if (!m_countsValid)
+        UpdateCounts();
+
+    return m_countTo.empty() ? 0 : m_countTo.back();
 }
 
 unsigned int RowRanges::CountTo(unsigned int row) const
 {
-    unsigned int ctr = 0;
-    size_t count = m_ranges.size();
-    for (size_t rngIdx = 0; rngIdx < count; rngIdx++)
+    if (!m_countsValid)
+        UpdateCounts();
+
+    // all the ranges before the one found are entirely below row, so their
+    // cached cumulative count can be used directly
+    const size_t rngIdx = FindRange(row);
+    unsigned int ctr = rngIdx > 0 ? m_countTo[rngIdx - 1] : 0;
+    if (rngIdx < m_ranges.size() && m_ranges[rngIdx].from < row)
     {
-        const RowRange &rng = m_ranges[rngIdx];
-        if (rng.from > row)
-        {
-            break;
-        }
-        else if (rng.to < row)
-        {
-            ctr += rng.to - rng.from;
-        }
-        else
-        {
-            ctr += row - rng.from;
-            break;
-        }
+        ctr += row - m_ranges[rngIdx].from;
     }
     return ctr;
 }
@@ -193,6 +237,7 @@ bool HeightCache::GetLineInfo(unsigned int row, int &start, int &height)
 {
     int y = 0;
     bool found = false;
+    unsigned int countTo = 0;
     HeightToRowRangesMap::iterator it;
     for (it = m_heightToRowRange.begin(); it != m_heightToRowRange.end(); ++it)
     {
@@ -203,13 +248,20 @@ bool HeightCache::GetLineInfo(unsigned int row, int &start, int &height)
             height = rowHeight;
             found = true;
         }
-        y += rowHeight * (rowRanges->CountTo(row));
+        unsigned int rowsBefore = rowRanges->CountTo(row);
+        countTo += rowsBefore;
+        y += rowHeight * rowsBefore;
     }
-    if (found)
+    if (found && countTo == row)
     {
+        // the start position is only known if all the rows before this one
+        // are cached too: if some of them were invalidated (see
+        // InvalidateRow()), report the row as unknown so that the caller
+        // measures the missing rows again and fills the gap
         start = y;
+        return true;
     }
-    return found;
+    return false;
 }
 
 bool HeightCache::GetLineStart(unsigned int row, int &start)
@@ -311,6 +363,16 @@ void HeightCache::Remove(unsigned int row)
     }
 }
 
+void HeightCache::InvalidateRow(unsigned int row)
+{
+    HeightToRowRangesMap::iterator it;
+    for (it = m_heightToRowRange.begin(); it != m_heightToRowRange.end(); ++it)
+    {
+        RowRanges* rowRanges = it->second;
+        rowRanges->RemoveSingle(row);
+    }
+}
+
 void HeightCache::Clear()
 {
     HeightToRowRangesMap::iterator it;
@@ -346,6 +346,8 @@ wxScrollHelperBase::wxScrollHelperBase(wxWindow *win)
     m_xScrollingEnabled =
     m_yScrollingEnabled = true;
 
+    m_pixelReuseEnabled = false;
+
     m_scaleX =
     m_scaleY = 1.0;
 #if wxUSE_MOUSEWHEEL
@@ -508,32 +510,27 @@ void wxScrollHelperBase::HandleOnScroll(wxScrollWinEvent& event)
     int orient = event.GetOrientation();
     if (orient == wxHORIZONTAL)
     {
-       if ( m_xScrollingEnabled )
-       {
-           dx = -m_xScrollPixelsPerLine * nScrollInc;
-       }
-       else
+       dx = -m_xScrollPixelsPerLine * nScrollInc;
+       if ( !m_xScrollingEnabled )
        {
            needsRefresh = true;
        }
     }
     else
     {
-        if ( m_yScrollingEnabled )
-        {
-            dy = -m_yScrollPixelsPerLine * nScrollInc;
-        }
-        else
+        dy = -m_yScrollPixelsPerLine * nScrollInc;
+        if ( !m_yScrollingEnabled )
         {
             needsRefresh = true;
         }
     }
 
-    if ( !needsRefresh )
+    if ( !needsRefresh || m_pixelReuseEnabled )
     {
         // flush all pending repaints before we change m_{x,y}ScrollPosition, as
         // otherwise invalidated area could be updated incorrectly later when
-        // ScrollWindow() makes sure they're repainted before scrolling them
+        // ScrollWindow() (or our own blit in pixel reuse mode) makes sure
+        // they're repainted before scrolling them
 #ifdef __WXMAC__
         // wxWindowMac is taking care of making sure the update area is correctly
         // set up, while not forcing an immediate redraw
@@ -553,13 +550,98 @@ void wxScrollHelperBase::HandleOnScroll(wxScrollWinEvent& event)
         m_win->SetScrollPos(wxVERTICAL, m_yScrollPosition);
     }
 
-    if ( needsRefresh )
+    if ( !needsRefresh )
+    {
+        m_targetWindow->ScrollWindow(dx, dy, GetScrollRect());
+    }
+    else if ( m_pixelReuseEnabled )
+    {
+        ScrollByPixelReuse(dx, dy);
+    }
+    else
     {
         m_targetWindow->Refresh(true, GetScrollRect());
     }
+}
+
+void wxScrollHelperBase::ScrollByPixelReuse(int dx, int dy)
+{
+    const wxRect * const scrollRect = GetScrollRect();
+    const wxRect rect = scrollRect
+                            ? *scrollRect
+                            : wxRect(m_targetWindow->GetClientSize());
+
+    m_pixelReuseStats.scrolls++;
+
+    const int adx = abs(dx),
+              ady = abs(dy);
+
+    // The still valid part of the window contents at its new position.
+    const int w = rect.width - adx,
+              h = rect.height - ady;
+
+    if ( w <= 0 || h <= 0 )
+    {
+        // Nothing to reuse at all, redraw everything as before.
+        m_pixelReuseStats.pixelsRedrawn +=
+            (wxScrollPixelReuseStats::PixelCount)rect.width*rect.height;
+
+        m_targetWindow->Refresh(true, scrollRect);
+        return;
+    }
+
+    // Make sure the pixels we are going to reuse are up to date first.
+    m_targetWindow->Update();
+
+    int xSrc = rect.x,
+        ySrc = rect.y,
+        xDst = rect.x,
+        yDst = rect.y;
+    if ( dx > 0 )
+        xDst += dx;
     else
+        xSrc += adx;
+    if ( dy > 0 )
+        yDst += dy;
+    else
+        ySrc += ady;
+
     {
-        m_targetWindow->ScrollWindow(dx, dy, GetScrollRect());
+        wxClientDC dc(m_targetWindow);
+        dc.Blit(xDst, yDst, w, h, &dc, xSrc, ySrc);
+    }
+
+    m_pixelReuseStats.pixelsBlitted += (wxScrollPixelReuseStats::PixelCount)w*h;
+
+    // Compute the exposed strips and refresh each of them separately, so
+    // that the paint handler is invoked with a clip rectangle restricted to
+    // the area which really needs redrawing. The vertical strip spans the
+    // full height, the horizontal one covers only the remaining columns to
+    // avoid repainting their common corner twice.
+    if ( adx )
+    {
+        wxRect strip(rect.x, rect.y, adx, rect.height);
+        if ( dx < 0 )
+            strip.x = rect.x + rect.width - adx;
+
+        m_pixelReuseStats.pixelsRedrawn +=
+            (wxScrollPixelReuseStats::PixelCount)strip.width*strip.height;
+
+        m_targetWindow->Refresh(true, &strip);
+        m_targetWindow->Update();
+    }
+
+    if ( ady )
+    {
+        wxRect strip(xDst, rect.y, w, ady);
+        if ( dy < 0 )
+            strip.y = rect.y + rect.height - ady;
+
+        m_pixelReuseStats.pixelsRedrawn +=
+            (wxScrollPixelReuseStats::PixelCount)strip.width*strip.height;
+
+        m_targetWindow->Refresh(true, &strip);
+        m_targetWindow->Update();
     }
 }
 
@@ -1427,6 +1509,8 @@ void wxScrollHelper::AdjustScrollbars()
        if (m_xScrollingEnabled)
             m_targetWindow->ScrollWindow( m_xScrollPixelsPerLine * (oldXScroll - m_xScrollPosition), 0,
                                           GetScrollRect() );
+       else if (m_pixelReuseEnabled)
+            ScrollByPixelReuse( m_xScrollPixelsPerLine * (oldXScroll - m_xScrollPosition), 0 );
        else
             m_targetWindow->Refresh(true, GetScrollRect());
     }
@@ -1436,6 +1520,8 @@ void wxScrollHelper::AdjustScrollbars()
         if (m_yScrollingEnabled)
             m_targetWindow->ScrollWindow( 0, m_yScrollPixelsPerLine * (oldYScroll-m_yScrollPosition),
                                           GetScrollRect() );
+        else if (m_pixelReuseEnabled)
+            ScrollByPixelReuse( 0, m_yScrollPixelsPerLine * (oldYScroll - m_yScrollPosition) );
         else
             m_targetWindow->Refresh(true, GetScrollRect());
     }
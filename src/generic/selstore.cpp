@@ -18,6 +18,9 @@
 
 #include "wx/wxprec.h"
 
+#ifndef WX_PRECOMP
+    #include "wx/utils.h"       // for wxMin/wxMax
+#endif
 
 #include "wx/selstore.h"
 
@@ -31,46 +34,125 @@ const unsigned wxSelectionStore::NO_SELECTION = static_cast<unsigned>(-1);
 // tests
 // ----------------------------------------------------------------------------
 
+size_t wxSelectionStore::FindRange(unsigned item) const
+{
+    // binary search for the first range ending at or after the item
+    size_t lo = 0,
+           hi = m_ranges.size();
+    while ( lo < hi )
+    {
+        const size_t mid = (lo + hi) / 2;
+        if ( m_ranges[mid].last < item )
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
 bool wxSelectionStore::IsSelected(unsigned item) const
 {
-    bool isSel = m_itemsSel.Index(item) != wxNOT_FOUND;
+    const size_t idx = FindRange(item);
 
-    // if the default state is to be selected, being in m_itemsSel means that
-    // the item is not selected, so we have to inverse the logic
-    return m_defaultState ? !isSel : isSel;
+    return idx < m_ranges.size() && m_ranges[idx].first <= item;
 }
 
 // ----------------------------------------------------------------------------
-// Select*()
+// range operations
 // ----------------------------------------------------------------------------
 
-bool wxSelectionStore::SelectItem(unsigned item, bool select)
+void wxSelectionStore::DoSelectRange(unsigned itemFrom, unsigned itemTo)
 {
-    // search for the item ourselves as like this we get the index where to
-    // insert it later if needed, so we do only one search in the array instead
-    // of two (adding item to a sorted array requires a search)
-    size_t index = m_itemsSel.IndexForInsert(item);
-    bool isSel = index < m_itemsSel.GetCount() && m_itemsSel[index] == item;
+    // find all the ranges overlapping or adjacent to [itemFrom, itemTo]: they
+    // are all merged with it into a single bigger range
+    const size_t first = FindRange(itemFrom == 0 ? 0 : itemFrom - 1);
+
+    wxSelectedRange range(itemFrom, itemTo);
 
-    if ( select != m_defaultState )
+    size_t last = first;
+    while ( last < m_ranges.size() && m_ranges[last].first <= itemTo + 1 )
     {
-        if ( !isSel )
-        {
-            m_itemsSel.AddAt(item, index);
+        if ( m_ranges[last].first < range.first )
+            range.first = m_ranges[last].first;
+        if ( m_ranges[last].last > range.last )
+            range.last = m_ranges[last].last;
 
-            return true;
-        }
+        m_selectedCount -= m_ranges[last].GetLength();
+
+        last++;
     }
-    else // reset to default state
+
+    m_ranges.erase(m_ranges.begin() + first, m_ranges.begin() + last);
+    m_ranges.insert(m_ranges.begin() + first, range);
+
+    m_selectedCount += range.GetLength();
+}
+
+void wxSelectionStore::DoDeselectRange(unsigned itemFrom, unsigned itemTo)
+{
+    size_t idx = FindRange(itemFrom);
+
+    // check if the first affected range extends beyond the deselected items
+    // on either side and so has to be truncated or even split in two
+    if ( idx < m_ranges.size() && m_ranges[idx].first < itemFrom )
     {
-        if ( isSel )
+        if ( m_ranges[idx].last > itemTo )
         {
-            m_itemsSel.RemoveAt(index);
-            return true;
+            // the deselected items are in the middle of this range, so keep
+            // both of its ends, i.e. split it in two
+            const wxSelectedRange tail(itemTo + 1, m_ranges[idx].last);
+            m_ranges[idx].last = itemFrom - 1;
+            m_ranges.insert(m_ranges.begin() + idx + 1, tail);
+
+            m_selectedCount -= itemTo - itemFrom + 1;
+            return;
         }
+
+        if ( m_ranges[idx].last >= itemFrom )
+        {
+            // only the tail of this range is deselected
+            m_selectedCount -= m_ranges[idx].last - itemFrom + 1;
+            m_ranges[idx].last = itemFrom - 1;
+        }
+
+        idx++;
     }
 
-    return false;
+    // remove the ranges lying entirely inside the deselected one
+    size_t last = idx;
+    while ( last < m_ranges.size() && m_ranges[last].last <= itemTo )
+    {
+        m_selectedCount -= m_ranges[last].GetLength();
+
+        last++;
+    }
+
+    m_ranges.erase(m_ranges.begin() + idx, m_ranges.begin() + last);
+
+    // and truncate the head of the following range if it is also affected
+    if ( idx < m_ranges.size() && m_ranges[idx].first <= itemTo )
+    {
+        m_selectedCount -= itemTo - m_ranges[idx].first + 1;
+        m_ranges[idx].first = itemTo + 1;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Select*()
+// ----------------------------------------------------------------------------
+
+bool wxSelectionStore::SelectItem(unsigned item, bool select)
+{
+    if ( IsSelected(item) == select )
+        return false;
+
+    if ( select )
+        DoSelectRange(item, item);
+    else
+        DoDeselectRange(item, item);
+
+    return true;
 }
 
 bool wxSelectionStore::SelectRange(unsigned itemFrom, unsigned itemTo,
@@ -84,103 +166,63 @@ bool wxSelectionStore::SelectRange(unsigned itemFrom, unsigned itemTo,
 
     wxASSERT_MSG( itemFrom <= itemTo, wxT("should be in order") );
 
-    // are we going to have more [un]selected items than the other ones?
-    if ( itemTo - itemFrom > m_count/2 )
+    if ( itemsChanged )
     {
-        if ( select != m_defaultState )
+        itemsChanged->Empty();
+
+        // enumerate the items in the range which are going to change state:
+        // these are the gaps between the existing ranges if we're selecting
+        // or the parts covered by the existing ranges if we're deselecting
+        unsigned item = itemFrom;
+        size_t idx = FindRange(itemFrom);
+        while ( itemsChanged && item <= itemTo )
         {
-            // the default state now becomes the same as 'select'
-            m_defaultState = select;
-
-            // so all the old selections (which had state select) shouldn't be
-            // selected any more, but all the other ones should
-            wxSelectedIndices selOld = m_itemsSel;
-            m_itemsSel.Empty();
-
-            // TODO: it should be possible to optimize the searches a bit
-            //       knowing the possible range
-
-            unsigned item;
-            for ( item = 0; item < itemFrom; item++ )
+            // [selFrom, selTo] is the next run of currently selected items
+            // intersected with the range we're changing
+            unsigned selFrom,
+                     selTo;
+            if ( idx < m_ranges.size() && m_ranges[idx].first <= itemTo )
             {
-                if ( selOld.Index(item) == wxNOT_FOUND )
-                    m_itemsSel.Add(item);
+                selFrom = wxMax(m_ranges[idx].first, item);
+                selTo = wxMin(m_ranges[idx].last, itemTo);
+                idx++;
             }
-
-            for ( item = itemTo + 1; item < m_count; item++ )
+            else // no more selected items in the range
             {
-                if ( selOld.Index(item) == wxNOT_FOUND )
-                    m_itemsSel.Add(item);
+                selFrom = itemTo + 1;
+                selTo = itemTo;
             }
 
-            // many items (> half) changed state
-            itemsChanged = NULL;
-        }
-        else // select == m_defaultState
-        {
-            // get the inclusive range of items between itemFrom and itemTo
-            size_t count = m_itemsSel.GetCount(),
-                   start = m_itemsSel.IndexForInsert(itemFrom),
-                   end = m_itemsSel.IndexForInsert(itemTo);
-
-            if ( start == count || m_itemsSel[start] < itemFrom )
-            {
-                start++;
-            }
+            // the items changing state are those before the run when
+            // selecting and those inside it when deselecting
+            const unsigned changedFrom = select ? item : selFrom,
+                           changedTo = select ? selFrom - 1 : selTo;
 
-            if ( end == count || m_itemsSel[end] > itemTo )
+            for ( unsigned n = changedFrom;
+                  n != changedTo + 1 && n <= itemTo;
+                  n++ )
             {
-                end--;
-            }
-
-            if ( start <= end )
-            {
-                // delete all of them (from end to avoid changing indices)
-                for ( int i = end; i >= (int)start; i-- )
-                {
-                    if ( itemsChanged )
-                    {
-                        if ( itemsChanged->GetCount() > MANY_ITEMS )
-                        {
-                            // stop counting (see comment below)
-                            itemsChanged = NULL;
-                        }
-                        else
-                        {
-                            itemsChanged->Add(m_itemsSel[i]);
-                        }
-                    }
-
-                    m_itemsSel.RemoveAt(i);
-                }
-            }
-        }
-    }
-    else // "few" items change state
-    {
-        if ( itemsChanged )
-        {
-            itemsChanged->Empty();
-        }
-
-        // just add the items to the selection
-        for ( unsigned item = itemFrom; item <= itemTo; item++ )
-        {
-            if ( SelectItem(item, select) && itemsChanged )
-            {
-                itemsChanged->Add(item);
-
                 if ( itemsChanged->GetCount() > MANY_ITEMS )
                 {
                     // stop counting them, we'll just eat gobs of memory
                     // for nothing at all - faster to refresh everything in
                     // this case
                     itemsChanged = NULL;
+                    break;
                 }
+
+                itemsChanged->Add(n);
             }
+
+            item = selTo + 1;
         }
     }
 
+    if ( select )
+        DoSelectRange(itemFrom, itemTo);
+    else
+        DoDeselectRange(itemFrom, itemTo);
+
     // we set it to NULL if there are many items changing state
     return itemsChanged != NULL;
 }
@@ -191,24 +233,24 @@ bool wxSelectionStore::SelectRange(unsigned itemFrom, unsigned itemTo,
 
 void wxSelectionStore::OnItemsInserted(unsigned item, unsigned numItems)
 {
-    const size_t count = m_itemsSel.GetCount();
+    size_t idx = FindRange(item);
 
-    size_t idx = m_itemsSel.IndexForInsert(item);
-
-    for ( size_t i = idx; i < count; i++ )
+    // split the range containing the insertion point, if any, as the newly
+    // inserted items are not selected
+    if ( idx < m_ranges.size() && m_ranges[idx].first < item )
     {
-        m_itemsSel[i] += numItems;
+        const wxSelectedRange tail(item, m_ranges[idx].last);
+        m_ranges[idx].last = item - 1;
+        m_ranges.insert(m_ranges.begin() + idx + 1, tail);
+
+        idx++;
     }
 
-    if ( m_defaultState )
+    // and shift all the following ranges
+    for ( ; idx < m_ranges.size(); idx++ )
     {
-        // All newly inserted items are not selected, so if the default state
-        // is to be selected, we need to manually add them to the deselected
-        // items indices.
-        for ( unsigned n = item; n < item + numItems; n++ )
-        {
-            m_itemsSel.AddAt(n, idx++);
-        }
+        m_ranges[idx].first += numItems;
+        m_ranges[idx].last += numItems;
     }
 
     m_count += numItems;
@@ -216,60 +258,41 @@ void wxSelectionStore::OnItemsInserted(unsigned item, unsigned numItems)
 
 void wxSelectionStore::OnItemDelete(unsigned item)
 {
-    size_t count = m_itemsSel.GetCount(),
-           i = m_itemsSel.IndexForInsert(item);
-
-    if ( i < count && m_itemsSel[i] == item )
-    {
-        // this item itself was in m_itemsSel, remove it from there
-        m_itemsSel.RemoveAt(i);
-
-        count--;
-    }
-
-    // and adjust the index of all which follow it
-    while ( i < count )
-    {
-        // all following elements must be greater than the one we deleted
-        wxASSERT_MSG( m_itemsSel[i] > item, wxT("logic error") );
-
-        m_itemsSel[i++]--;
-    }
-
-    m_count--;
+    OnItemsDeleted(item, 1);
 }
 
 bool wxSelectionStore::OnItemsDeleted(unsigned item, unsigned numItems)
 {
-    bool anyDeletedInSelItems = false,
-         allDeletedInSelItems = true;
+    const unsigned itemLast = item + numItems - 1;
 
-    size_t i = m_itemsSel.IndexForInsert(item);
+    // check whether any of the deleted items was selected before forgetting
+    // about them
+    size_t idx = FindRange(item);
+    const bool anySelected = idx < m_ranges.size() &&
+                                m_ranges[idx].first <= itemLast;
 
-    const unsigned firstAfterDeleted = item + numItems;
-    while ( i < m_itemsSel.size() )
-    {
-        if ( m_itemsSel[i] < firstAfterDeleted )
-        {
-            // This item is going to be deleted, so remove it from the
-            // selected indices entirely. Notice that we do not update i here
-            // as it now refers to the next element.
-            m_itemsSel.RemoveAt(i);
+    DoDeselectRange(item, itemLast);
 
-            anyDeletedInSelItems = true;
-        }
-        else
-        {
-            // This item remains, just update its index.
-            m_itemsSel[i++] -= numItems;
+    // shift the following ranges: deselecting above ensured that the first
+    // range found now lies entirely beyond the deleted items
+    const size_t idxShifted = FindRange(item);
+    for ( idx = idxShifted; idx < m_ranges.size(); idx++ )
+    {
+        m_ranges[idx].first -= numItems;
+        m_ranges[idx].last -= numItems;
+    }
 
-            allDeletedInSelItems = false;
-        }
+    // the deletion could have brought two ranges together, merge them then
+    if ( idxShifted != 0 && idxShifted < m_ranges.size() &&
+            m_ranges[idxShifted - 1].last + 1 == m_ranges[idxShifted].first )
+    {
+        m_ranges[idxShifted - 1].last = m_ranges[idxShifted].last;
+        m_ranges.erase(m_ranges.begin() + idxShifted);
     }
 
     m_count -= numItems;
 
-    return m_defaultState ? allDeletedInSelItems : anyDeletedInSelItems;
+    return anySelected;
 }
 
 
@@ -277,14 +300,8 @@ void wxSelectionStore::SetItemCount(unsigned count)
 {
     // forget about all items whose indices are now invalid if the size
     // decreased
-    if ( count < m_count )
-    {
-        for ( size_t i = m_itemsSel.GetCount(); i > 0; i-- )
-        {
-            if ( m_itemsSel[i - 1] >= count )
-                m_itemsSel.RemoveAt(i - 1);
-        }
-    }
+    if ( !m_ranges.empty() && m_ranges.back().last >= count )
+        DoDeselectRange(count, m_ranges.back().last);
 
     // remember the new number of items
     m_count = count;
@@ -303,28 +320,14 @@ unsigned wxSelectionStore::GetFirstSelectedItem(IterationState& cookie) const
 
 unsigned wxSelectionStore::GetNextSelectedItem(IterationState& cookie) const
 {
-    if ( m_defaultState )
-    {
-        // We have no choice but to iterate over all items in this case. It
-        // shouldn't be that bad in practice because (almost) all items are
-        // supposed to be selected if m_defaultState == true anyhow.
-        for ( unsigned item = cookie; ; item++ )
-        {
-            if ( item >= m_count )
-                return NO_SELECTION;
+    // the cookie is just the index of the next item to examine
+    const size_t idx = FindRange(static_cast<unsigned>(cookie));
+    if ( idx == m_ranges.size() )
+        return NO_SELECTION;
 
-            if ( IsSelected(item) )
-            {
-                cookie = item + 1;
-                return item;
-            }
-        }
-    }
-    else // Simple case when we directly have the selected items.
-    {
-        if ( cookie >= m_itemsSel.size() )
-            return NO_SELECTION;
+    const unsigned item = wxMax(m_ranges[idx].first,
+                                static_cast<unsigned>(cookie));
+    cookie = item + 1;
 
-        return m_itemsSel[cookie++];
-    }
+    return item;
 }
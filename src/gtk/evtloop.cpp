@@ -375,7 +375,7 @@ void wxGUIEventLoop::DoYieldFor(long eventsToProcess)
     //       In particular in this way we also process input from sources like
     //       GIOChannels (this is needed for e.g. wxGUIAppTraits::WaitForChild).
     gdk_event_handler_set(wxgtk_main_do_event, this, NULL);
-    while (Pending())   // avoid false positives from our idle source
+    while (Pending() && !YieldDeadlineExpired())   // avoid false positives from our idle source
         gtk_main_iteration();
 
     wxGCC_WARNING_SUPPRESS_CAST_FUNCTION_TYPE()
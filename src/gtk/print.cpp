@@ -1159,7 +1159,7 @@ void wxGtkPrinter::DrawPage(wxPrintout *printout,
     if (printout->HasPage(numPageToDraw))
     {
         m_dc->StartPage();
-        printout->OnPrintPage(numPageToDraw);
+        printout->PrintPage(numPageToDraw);
         m_dc->EndPage();
     }
 
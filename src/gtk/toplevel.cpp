@@ -1014,8 +1014,13 @@ bool wxTopLevelWindowGTK::ShowFullScreen(bool show, long)
 // overridden wxWindow methods
 // ----------------------------------------------------------------------------
 
-void wxTopLevelWindowGTK::Refresh( bool WXUNUSED(eraseBackground), const wxRect *WXUNUSED(rect) )
+void wxTopLevelWindowGTK::Refresh( bool eraseBackground, const wxRect *rect )
 {
+#if wxUSE_TIMER
+    if ( QueueThrottledRefresh(eraseBackground, rect) )
+        return;
+#endif // wxUSE_TIMER
+
     wxCHECK_RET( m_widget, wxT("invalid frame") );
 
     gtk_widget_queue_draw( m_widget );
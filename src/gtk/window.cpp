@@ -5093,9 +5093,14 @@ bool wxWindowGTK::ScrollPages(int pages)
     return DoScrollByUnits(ScrollDir_Vert, ScrollUnit_Page, pages);
 }
 
-void wxWindowGTK::Refresh(bool WXUNUSED(eraseBackground),
+void wxWindowGTK::Refresh(bool eraseBackground,
                           const wxRect *rect)
 {
+#if wxUSE_TIMER
+    if ( QueueThrottledRefresh(eraseBackground, rect) )
+        return;
+#endif // wxUSE_TIMER
+
     if (m_wxwindow)
     {
         if (gtk_widget_get_mapped(m_wxwindow))
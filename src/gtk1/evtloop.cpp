@@ -154,7 +154,7 @@ void wxGUIEventLoop::DoYieldFor(long eventsToProcess)
     wxTheApp->RemoveIdleTag();
 
     // TODO: implement event filtering using the eventsToProcess mask
-    while (gtk_events_pending())
+    while (gtk_events_pending() && !YieldDeadlineExpired())
         gtk_main_iteration();
 
     wxEventLoopBase::DoYieldFor(eventsToProcess);
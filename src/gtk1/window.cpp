@@ -3431,6 +3431,11 @@ void wxWindowGTK::WarpPointer( int x, int y )
 
 void wxWindowGTK::Refresh( bool eraseBackground, const wxRect *rect )
 {
+#if wxUSE_TIMER
+    if ( QueueThrottledRefresh(eraseBackground, rect) )
+        return;
+#endif // wxUSE_TIMER
+
     if (!m_widget)
         return;
     if (!m_widget->window)
@@ -263,6 +263,7 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxHtmlHelpData, wxObject);
 
 wxHtmlHelpData::wxHtmlHelpData()
 {
+    m_indexSorted = true;
 }
 
 wxHtmlHelpData::~wxHtmlHelpData()
@@ -325,23 +326,28 @@ inline static wxInt32 CacheReadInt32(wxInputStream *f)
     return wxINT32_SWAP_ON_BE(x);
 }
 
-inline static void CacheWriteString(wxOutputStream *f, const wxString& str)
+// In the version 6 format the cached book is a single binary blob which is
+// read at once instead of doing many small per-item reads: after the header
+// come fixed-width records describing all the contents and index items,
+// followed by a string table storing their strings as NUL-terminated UTF-8.
+struct wxHtmlCachedBookRecord
 {
-    const wxWX2MBbuf mbstr = str.mb_str(wxConvUTF8);
-    size_t len = strlen((const char*)mbstr)+1;
-    CacheWriteInt32(f, len);
-    f->Write((const char*)mbstr, len);
-}
+    wxInt32 level;
+    wxInt32 id;         // MS id for contents items, parent shift for index
+    wxInt32 name;       // offsets of the strings in the string table
+    wxInt32 page;
+};
 
-inline static wxString CacheReadString(wxInputStream *f)
+// appends the string to the string table and returns its offset in it
+inline static wxInt32 CacheAddString(wxMemoryBuffer& strings, const wxString& str)
 {
-    size_t len = (size_t)CacheReadInt32(f);
-    wxCharBuffer str(len-1);
-    f->Read(str.data(), len);
-    return wxString(str, wxConvUTF8);
+    const wxScopedCharBuffer utf(str.utf8_str());
+    const wxInt32 ofs = strings.GetDataLen();
+    strings.AppendData(utf.data(), utf.length() + 1);
+    return ofs;
 }
 
-#define CURRENT_CACHED_BOOK_VERSION     5
+#define CURRENT_CACHED_BOOK_VERSION     6
 
 // Additional flags to detect incompatibilities of the runtime environment:
 #define CACHED_BOOK_FORMAT_FLAGS \
@@ -350,7 +356,7 @@ inline static wxString CacheReadString(wxInputStream *f)
 
 bool wxHtmlHelpData::LoadCachedBook(wxHtmlBookRecord *book, wxInputStream *f)
 {
-    int i, st, newsize;
+    int i;
     wxInt32 version;
 
     /* load header - version info : */
@@ -368,33 +374,76 @@ bool wxHtmlHelpData::LoadCachedBook(wxHtmlBookRecord *book, wxInputStream *f)
     if (CacheReadInt32(f) != CACHED_BOOK_FORMAT_FLAGS)
         return false;
 
+    const wxInt32 numContents = CacheReadInt32(f);
+    const wxInt32 numIndex = CacheReadInt32(f);
+    const wxInt32 lenStrings = CacheReadInt32(f);
+    const wxInt32 numRecords = numContents + numIndex;
+    if (numContents < 0 || numIndex < 0 || lenStrings <= 0 ||
+            numRecords > wxINT32_MAX / (wxInt32)sizeof(wxHtmlCachedBookRecord))
+        return false;
+
+    /* read the rest of the file in a single blob: */
+    const size_t lenBlob = numRecords*sizeof(wxHtmlCachedBookRecord)
+                            + lenStrings;
+    wxMemoryBuffer blob;
+    char * const p = (char *)blob.GetWriteBuf(lenBlob);
+    size_t done = 0;
+    while (done < lenBlob)
+    {
+        f->Read(p + done, lenBlob - done);
+        const size_t lastRead = f->LastRead();
+        if (lastRead == 0)
+            return false; // truncated file
+        done += lastRead;
+    }
+
+    const wxHtmlCachedBookRecord *
+        rec = (const wxHtmlCachedBookRecord *)p;
+    const char * const strings = p + numRecords*sizeof(*rec);
+    if (strings[lenStrings - 1] != '\0')
+        return false;
+
+    /* verify the records before creating any items so that a corrupted
+       cache can still be rejected as a whole: */
+    for (i = 0; i < numRecords; i++)
+    {
+        if ((wxUint32)wxINT32_SWAP_ON_BE(rec[i].name) >= (wxUint32)lenStrings ||
+            (wxUint32)wxINT32_SWAP_ON_BE(rec[i].page) >= (wxUint32)lenStrings)
+            return false;
+
+        // for the index records the id field stores the shift to the parent
+        // item, which can only refer to one of the preceding records
+        if (i >= numContents)
+        {
+            const wxInt32 parentShift = wxINT32_SWAP_ON_BE(rec[i].id);
+            if (parentShift < 0 || parentShift > i - numContents)
+                return false;
+        }
+    }
+
     /* load contents : */
-    st = m_contents.size();
-    newsize = st + CacheReadInt32(f);
-    m_contents.Alloc(newsize);
-    for (i = st; i < newsize; i++)
+    m_contents.Alloc(m_contents.size() + numContents);
+    for (i = 0; i < numContents; i++, rec++)
     {
         wxHtmlHelpDataItem *item = new wxHtmlHelpDataItem;
-        item->level = CacheReadInt32(f);
-        item->id = CacheReadInt32(f);
-        item->name = CacheReadString(f);
-        item->page = CacheReadString(f);
+        item->level = wxINT32_SWAP_ON_BE(rec->level);
+        item->id = wxINT32_SWAP_ON_BE(rec->id);
+        item->name = wxString::FromUTF8(strings + wxINT32_SWAP_ON_BE(rec->name));
+        item->page = wxString::FromUTF8(strings + wxINT32_SWAP_ON_BE(rec->page));
         item->book = book;
         m_contents.Add(item);
     }
 
     /* load index : */
-    st = m_index.size();
-    newsize = st + CacheReadInt32(f);
-    m_index.Alloc(newsize);
-    for (i = st; i < newsize; i++)
+    m_index.Alloc(m_index.size() + numIndex);
+    for (i = 0; i < numIndex; i++, rec++)
     {
         wxHtmlHelpDataItem *item = new wxHtmlHelpDataItem;
-        item->name = CacheReadString(f);
-        item->page = CacheReadString(f);
-        item->level = CacheReadInt32(f);
+        item->name = wxString::FromUTF8(strings + wxINT32_SWAP_ON_BE(rec->name));
+        item->page = wxString::FromUTF8(strings + wxINT32_SWAP_ON_BE(rec->page));
+        item->level = wxINT32_SWAP_ON_BE(rec->level);
         item->book = book;
-        int parentShift = CacheReadInt32(f);
+        int parentShift = wxINT32_SWAP_ON_BE(rec->id);
         if (parentShift != 0)
             item->parent = &m_index[m_index.size() - parentShift];
         m_index.Add(item);
@@ -406,63 +455,69 @@ bool wxHtmlHelpData::LoadCachedBook(wxHtmlBookRecord *book, wxInputStream *f)
 bool wxHtmlHelpData::SaveCachedBook(wxHtmlBookRecord *book, wxOutputStream *f)
 {
     int i;
-    wxInt32 cnt;
+    wxInt32 cntContents = 0,
+            cntIndex = 0;
+    wxMemoryBuffer records,
+                   strings;
+    wxHtmlCachedBookRecord rec;
 
-    /* save header - version info : */
-    CacheWriteInt32(f, CURRENT_CACHED_BOOK_VERSION);
-    CacheWriteInt32(f, CACHED_BOOK_FORMAT_FLAGS);
+    // the string table is never empty, even if the book is: this also makes
+    // the offset 0 mean an empty string
+    strings.AppendByte('\0');
 
-    /* save contents : */
+    /* fill the records and the string table for the contents : */
     int len = m_contents.size();
-    for (cnt = 0, i = 0; i < len; i++)
-        if (m_contents[i].book == book && m_contents[i].level > 0)
-            cnt++;
-    CacheWriteInt32(f, cnt);
-
     for (i = 0; i < len; i++)
     {
         if (m_contents[i].book != book || m_contents[i].level == 0)
             continue;
-        CacheWriteInt32(f, m_contents[i].level);
-        CacheWriteInt32(f, m_contents[i].id);
-        CacheWriteString(f, m_contents[i].name);
-        CacheWriteString(f, m_contents[i].page);
+        rec.level = wxINT32_SWAP_ON_BE((wxInt32)m_contents[i].level);
+        rec.id = wxINT32_SWAP_ON_BE((wxInt32)m_contents[i].id);
+        rec.name = wxINT32_SWAP_ON_BE(CacheAddString(strings, m_contents[i].name));
+        rec.page = wxINT32_SWAP_ON_BE(CacheAddString(strings, m_contents[i].page));
+        records.AppendData(&rec, sizeof(rec));
+        cntContents++;
     }
 
-    /* save index : */
+    /* and for the index : */
     len = m_index.size();
-    for (cnt = 0, i = 0; i < len; i++)
-        if (m_index[i].book == book && m_index[i].level > 0)
-            cnt++;
-    CacheWriteInt32(f, cnt);
-
     for (i = 0; i < len; i++)
     {
         if (m_index[i].book != book || m_index[i].level == 0)
             continue;
-        CacheWriteString(f, m_index[i].name);
-        CacheWriteString(f, m_index[i].page);
-        CacheWriteInt32(f, m_index[i].level);
-        // save distance to parent item, if any:
-        if (m_index[i].parent == NULL)
+        // compute distance to parent item, if any:
+        wxInt32 parentShift = 0;
+        if (m_index[i].parent != NULL)
         {
-            CacheWriteInt32(f, 0);
-        }
-        else
-        {
-            int cnt2 = 0;
             wxHtmlHelpDataItem *parent = m_index[i].parent;
             for (int j = i-1; j >= 0; j--)
             {
                 if (m_index[j].book == book && m_index[j].level > 0)
-                    cnt2++;
+                    parentShift++;
                 if (&m_index[j] == parent)
                     break;
             }
-            wxASSERT(cnt2 > 0);
-            CacheWriteInt32(f, cnt2);
+            wxASSERT(parentShift > 0);
         }
+        rec.level = wxINT32_SWAP_ON_BE((wxInt32)m_index[i].level);
+        rec.id = wxINT32_SWAP_ON_BE(parentShift);
+        rec.name = wxINT32_SWAP_ON_BE(CacheAddString(strings, m_index[i].name));
+        rec.page = wxINT32_SWAP_ON_BE(CacheAddString(strings, m_index[i].page));
+        records.AppendData(&rec, sizeof(rec));
+        cntIndex++;
     }
+
+    /* save header - version info and the sizes of the tables : */
+    CacheWriteInt32(f, CURRENT_CACHED_BOOK_VERSION);
+    CacheWriteInt32(f, CACHED_BOOK_FORMAT_FLAGS);
+    CacheWriteInt32(f, cntContents);
+    CacheWriteInt32(f, cntIndex);
+    CacheWriteInt32(f, (wxInt32)strings.GetDataLen());
+
+    /* and the blob itself : */
+    f->Write(records.GetData(), records.GetDataLen());
+    f->Write(strings.GetData(), strings.GetDataLen());
+
     return true;
 }
 
@@ -606,15 +661,31 @@ bool wxHtmlHelpData::AddBookParam(const wxFSFile& bookfile,
     }
 
     m_bookRecords.Add(bookr);
-    if (!m_index.empty())
+    if ((int)m_index.size() != IndexOld)
     {
-        m_index.Sort(wxHtmlHelpIndexCompareFunc);
+        // don't sort the index after every book, it is enough to do it once,
+        // when it is used for the first time
+        m_indexSorted = false;
     }
 
     return true;
 }
 
 
+void wxHtmlHelpData::SortIndexIfNeeded() const
+{
+    if (m_indexSorted)
+        return;
+
+    m_indexSorted = true;
+
+    if (!m_index.empty())
+    {
+        m_index.Sort(wxHtmlHelpIndexCompareFunc);
+    }
+}
+
+
 bool wxHtmlHelpData::AddBook(const wxString& book)
 {
     wxString extension(book.Right(4).Lower());
@@ -757,6 +828,7 @@ wxString wxHtmlHelpData::FindPageByName(const wxString& x)
 
 
     // 4. try to find in index:
+    SortIndexIfNeeded();
     cnt = m_index.size();
     for (i = 0; i < cnt; i++)
     {
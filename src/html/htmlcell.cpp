@@ -680,6 +680,9 @@ wxHtmlContainerCell::wxHtmlContainerCell(wxHtmlContainerCell *parent) : wxHtmlCe
     m_MinHeight = 0;
     m_MinHeightAlign = wxHTML_ALIGN_TOP;
     m_LastLayout = -1;
+    m_LastLayoutWidth = -1;
+    m_nStateCells = -1;
+    m_ChildrenYSorted = false;
 }
 
 wxHtmlContainerCell::~wxHtmlContainerCell()
@@ -757,7 +760,6 @@ void wxHtmlContainerCell::Layout(int w)
 
     if (m_LastLayout == w)
         return;
-    m_LastLayout = w;
 
     // VS: Any attempt to layout with negative or zero width leads to hell,
     // but we can't ignore such attempts completely, since it sometimes
@@ -766,6 +768,31 @@ void wxHtmlContainerCell::Layout(int w)
     if (w < 1)
         w = 1;
 
+    // compute our width for the new total width first: if it is the same as
+    // the last time, e.g. because this is a fixed width container, the cached
+    // layout, including the line breaks and the positions of all the
+    // children, is still valid and there is nothing to redo
+    int width;
+    if (m_WidthFloatUnits == wxHTML_UNITS_PERCENT)
+    {
+        if (m_WidthFloat < 0) width = (100 + m_WidthFloat) * w / 100;
+        else width = m_WidthFloat * w / 100;
+    }
+    else
+    {
+        if (m_WidthFloat < 0) width = w + m_WidthFloat;
+        else width = m_WidthFloat;
+    }
+
+    if (m_LastLayout != -1 && width == m_LastLayoutWidth)
+    {
+        m_LastLayout = w;
+        return;
+    }
+
+    m_LastLayout = w;
+    m_LastLayoutWidth = width;
+
     wxHtmlCell *nextCell;
     long xpos = 0, ypos = m_IndentTop;
     int xdelta = 0, ybasicpos = 0;
@@ -782,16 +809,7 @@ void wxHtmlContainerCell::Layout(int w)
 
     */
 
-    if (m_WidthFloatUnits == wxHTML_UNITS_PERCENT)
-    {
-        if (m_WidthFloat < 0) m_Width = (100 + m_WidthFloat) * w / 100;
-        else m_Width = m_WidthFloat * w / 100;
-    }
-    else
-    {
-        if (m_WidthFloat < 0) m_Width = w + m_WidthFloat;
-        else m_Width = m_WidthFloat;
-    }
+    m_Width = width;
 
     if (m_Cells)
     {
@@ -1009,6 +1027,22 @@ void wxHtmlContainerCell::Layout(int w)
     m_MaxTotalWidth += s_indent + ((m_IndentRight < 0) ? (-m_IndentRight * m_Width / 100) : m_IndentRight);
     MaxLineWidth += s_indent + ((m_IndentRight < 0) ? (-m_IndentRight * m_Width / 100) : m_IndentRight);
     if (m_Width < MaxLineWidth) m_Width = MaxLineWidth;
+
+    // finally cache the information allowing Draw() to avoid walking the
+    // parts of the tree which are outside of the visible area
+    m_nStateCells = 0;
+    m_ChildrenYSorted = true;
+    int ymax = 0;
+    for (cell = m_Cells; cell; cell = cell->GetNext())
+    {
+        if (cell->AffectsRenderingState())
+            m_nStateCells++;
+
+        if (cell == m_Cells || cell->GetPosY() >= ymax)
+            ymax = cell->GetPosY();
+        else
+            m_ChildrenYSorted = false;
+    }
 }
 
 void wxHtmlContainerCell::UpdateRenderingStatePre(wxHtmlRenderingInfo& info,
@@ -1124,9 +1158,20 @@ void wxHtmlContainerCell::Draw(wxDC& dc, int x, int y, int view_y1, int view_y2,
     }
     if (m_Cells)
     {
+        // Unless there is a selection (whose rendering depends on seeing
+        // every cell, visible or not, see UpdateRenderingStatePre()), the
+        // off-screen cells only need to be visited if their DrawInvisible()
+        // does something, and once none of them remains we can stop entirely
+        // as soon as we get below the visible area.
+        const bool canSkip = info.GetSelection() == NULL && m_nStateCells != -1;
+        int stateCellsLeft = m_nStateCells;
+
         // draw container's contents:
         for (wxHtmlCell *cell = m_Cells; cell; cell = cell->GetNext())
         {
+            const bool stateCell = cell->AffectsRenderingState();
+            if (stateCell)
+                stateCellsLeft--;
 
             // optimize drawing: don't render off-screen content:
             if ((ylocal + cell->GetPosY() <= view_y2) &&
@@ -1139,12 +1184,19 @@ void wxHtmlContainerCell::Draw(wxDC& dc, int x, int y, int view_y1, int view_y2,
                            info);
                 UpdateRenderingStatePost(info, cell);
             }
-            else
+            else if (!canSkip || stateCell)
             {
                 // the cell is off-screen, proceed with font+color+etc.
                 // changes only:
                 cell->DrawInvisible(dc, xlocal, ylocal, info);
             }
+            else if (m_ChildrenYSorted && stateCellsLeft == 0 &&
+                     ylocal + cell->GetPosY() > view_y2)
+            {
+                // all the following cells are below the visible area too and
+                // none of them can change the rendering state
+                break;
+            }
         }
     }
 }
@@ -1156,8 +1208,15 @@ void wxHtmlContainerCell::DrawInvisible(wxDC& dc, int x, int y,
 {
     if (m_Cells)
     {
+        // as in Draw() above, cells with trivial DrawInvisible() can only be
+        // skipped when there is no selection to keep track of
+        const bool canSkip = info.GetSelection() == NULL && m_nStateCells != -1;
+
         for (wxHtmlCell *cell = m_Cells; cell; cell = cell->GetNext())
         {
+            if (canSkip && !cell->AffectsRenderingState())
+                continue;
+
             UpdateRenderingStatePre(info, cell);
             cell->DrawInvisible(dc, x + m_PosX, y + m_PosY, info);
             UpdateRenderingStatePost(info, cell);
@@ -129,6 +129,17 @@ void wxHtmlParser::SetSource(const wxString& src)
     m_CurTextPiece = 0;
 }
 
+void wxHtmlParser::ReplaceSource(const wxString& src)
+{
+    // The DOM tree keeps iterators into m_Source, so the source can only be
+    // replaced when there is no tree, i.e. when parsing is not in progress.
+    wxCHECK_RET( !m_Tags && !m_SavedStates,
+                 wxT("ReplaceSource() can't be called while parsing") );
+
+    delete m_Source;
+    m_Source = new wxString(src);
+}
+
 void wxHtmlParser::CreateDOMTree()
 {
     wxHtmlTagsCache cache(*m_Source);
@@ -154,7 +165,7 @@ void wxHtmlParser::CreateDOMSubTree(wxHtmlTag *cur,
     // and ending tag verbosely. Setting i=end_pos will skip to the very
     // end of this function where text piece is added, bypassing any child
     // tags parsing (CDATA element can't have child elements by definition):
-    if (cur != NULL && wxIsCDATAElement(cur->GetName()))
+    if (cur != NULL && wxIsCDATAElement(cur->m_Name))
     {
         i = end_pos;
     }
@@ -202,6 +213,10 @@ void wxHtmlParser::CreateDOMSubTree(wxHtmlTag *cur,
                     }
                 }
 
+                // remember the id of the tag name so that AddTag() can find
+                // the handler for it without hashing the name again:
+                chd->m_NameId = GetTagNameId(chd->m_Name);
+
                 if (chd->HasEnding())
                 {
                     CreateDOMSubTree(chd,
@@ -302,15 +317,19 @@ void wxHtmlParser::AddTag(const wxHtmlTag& tag)
 {
     bool inner = false;
 
-    wxHtmlTagHandlersHash::const_iterator h = m_HandlersHash.find(tag.GetName());
-    if (h != m_HandlersHash.end())
+    wxHtmlTagHandler * const handler =
+        tag.m_NameId != wxNOT_FOUND &&
+            tag.m_NameId < (int)m_HandlersById.size()
+                ? m_HandlersById[tag.m_NameId]
+                : NULL;
+    if (handler)
     {
-        inner = h->second->HandleTag(tag);
+        inner = handler->HandleTag(tag);
         if (m_stopParsing)
             return;
     }
 #if wxDEBUG_LEVEL
-    else if (m_HandlersHash.empty())
+    else if (m_HandlersSet.empty())
     {
         wxFAIL_MSG( "No HTML tag handlers registered, is your program linked "
                     "correctly (you might need to use FORCE_WXHTML_MODULES)?" );
@@ -323,13 +342,33 @@ void wxHtmlParser::AddTag(const wxHtmlTag& tag)
     }
 }
 
+int wxHtmlParser::GetTagNameId(const wxString& name)
+{
+    wxStringToNumHashMap::const_iterator it = m_TagNameIds.find(name);
+    if (it != m_TagNameIds.end())
+        return (int)it->second;
+
+    const int id = (int)m_TagNameIds.size();
+    m_TagNameIds[name] = id;
+    return id;
+}
+
+void wxHtmlParser::SetHandlerForTag(const wxString& name,
+                                    wxHtmlTagHandler *handler)
+{
+    const size_t id = GetTagNameId(name);
+    if (id >= m_HandlersById.size())
+        m_HandlersById.resize(id + 1, NULL);
+    m_HandlersById[id] = handler;
+}
+
 void wxHtmlParser::AddTagHandler(wxHtmlTagHandler *handler)
 {
     wxString s(handler->GetSupportedTags());
     wxStringTokenizer tokenizer(s, wxT(", "));
 
     while (tokenizer.HasMoreTokens())
-        m_HandlersHash[tokenizer.GetNextToken()] = handler;
+        SetHandlerForTag(tokenizer.GetNextToken(), handler);
 
     m_HandlersSet.insert(handler);
 
@@ -339,15 +378,11 @@ void wxHtmlParser::AddTagHandler(wxHtmlTagHandler *handler)
 void wxHtmlParser::PushTagHandler(wxHtmlTagHandler *handler, const wxString& tags)
 {
     wxStringTokenizer tokenizer(tags, wxT(", "));
-    wxString key;
 
-    m_HandlersStack.push_back(new wxHtmlTagHandlersHash(m_HandlersHash));
+    m_HandlersStack.push_back(new wxVector<wxHtmlTagHandler*>(m_HandlersById));
 
     while (tokenizer.HasMoreTokens())
-    {
-        key = tokenizer.GetNextToken();
-        m_HandlersHash[key] = handler;
-    }
+        SetHandlerForTag(tokenizer.GetNextToken(), handler);
 }
 
 void wxHtmlParser::PopTagHandler()
@@ -355,9 +390,9 @@ void wxHtmlParser::PopTagHandler()
     wxCHECK_RET( !m_HandlersStack.empty(),
                  "attempt to remove HTML tag handler from empty stack" );
 
-    wxHtmlTagHandlersHash *prev = m_HandlersStack.back();
+    wxVector<wxHtmlTagHandler*> *prev = m_HandlersStack.back();
     m_HandlersStack.pop_back();
-    m_HandlersHash = *prev;
+    m_HandlersById = *prev;
     delete prev;
 }
 
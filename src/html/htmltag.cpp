@@ -316,6 +316,8 @@ wxHtmlTag::wxHtmlTag(wxHtmlTag *parent,
     else
         m_Prev = NULL;
 
+    m_NameId = wxNOT_FOUND;
+
     /* Find parameters and their values: */
 
     wxChar c wxDUMMY_INITIALIZE(0);
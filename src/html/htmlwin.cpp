@@ -35,6 +35,15 @@
 // uncomment this line to visually show the extent of the selection
 //#define DEBUG_HTML_SELECTION
 
+// if laying the page out takes longer than this many milliseconds, OnSize()
+// stops doing it for every size event generated during interactive resizing
+// and coalesces the relayouts until the size stops changing instead
+static const long wxHTML_MAX_IMMEDIATE_LAYOUT_TIME = 20;
+
+// how long, in milliseconds, the size must remain unchanged for the
+// coalesced relayout to be finally done
+static const int wxHTML_COALESCED_LAYOUT_DELAY = 100;
+
 // HTML events:
 wxIMPLEMENT_DYNAMIC_CLASS(wxHtmlLinkEvent, wxCommandEvent);
 wxIMPLEMENT_DYNAMIC_CLASS(wxHtmlCellEvent, wxCommandEvent);
@@ -320,6 +329,10 @@ void wxHtmlWindow::Init()
     SetBorders(10);
     m_selection = NULL;
     m_makingSelection = false;
+    m_lastLayoutTime = 0;
+#if wxUSE_TIMER
+    m_timerRelayout.SetOwner(this);
+#endif // wxUSE_TIMER
 #if wxUSE_CLIPBOARD
     m_timerAutoScroll = NULL;
     m_lastDoubleClick = 0;
@@ -517,7 +530,96 @@ bool wxHtmlWindow::DoSetPage(const wxString& source)
 
 bool wxHtmlWindow::AppendToPage(const wxString& source)
 {
-    return DoSetPage(*(GetParser()->GetSource()) + source);
+    // The incremental path below doesn't run the HTML processors over the
+    // combined source, so fall back to reparsing everything if any are
+    // installed (or if there is nothing to append to yet).
+    if ( !m_Cell || m_Processors || m_GlobalProcessors )
+        return DoSetPage(*(GetParser()->GetSource()) + source);
+
+    return DoAppendPage(source);
+}
+
+bool wxHtmlWindow::DoAppendPage(const wxString& source)
+{
+    // The full source must remain available from the parser, e.g. for
+    // re-layouting the page after a SetFonts() call, so combine it before
+    // parsing replaces the currently stored source.
+    const wxString fullsource = *(m_Parser->GetSource()) + source;
+
+    wxDELETE(m_selection);
+    m_tmpSelFromCell = NULL;
+
+    wxClientDC dc(this);
+    dc.SetMapMode(wxMM_TEXT);
+
+    double pixelScale = 1.0;
+#ifndef wxHAVE_DPI_INDEPENDENT_PIXELS
+    pixelScale = GetDPIScaleFactor();
+#endif
+
+    m_Parser->SetDC(&dc, pixelScale, 1.0);
+
+    wxHtmlContainerCell * const
+        cells = (wxHtmlContainerCell*) m_Parser->Parse(source);
+
+    m_Parser->SetDC(NULL);
+
+    m_Parser->ReplaceSource(fullsource);
+
+    // Find the container which would have received the new text if the
+    // whole document had been reparsed: this is the last container of the
+    // page, or the one before it if the last one is the empty container
+    // which wxHtmlWinParser::GetProduct() leaves at the end.
+    wxHtmlCell *prev = NULL;
+    wxHtmlCell *last = m_Cell->GetFirstChild();
+    while ( last && last->GetNext() )
+    {
+        prev = last;
+        last = last->GetNext();
+    }
+
+    wxHtmlContainerCell *target = NULL;
+    if ( last && !last->IsTerminalCell() )
+    {
+        target = static_cast<wxHtmlContainerCell*>(last);
+        if ( !target->GetFirstChild() && prev && !prev->IsTerminalCell() )
+            target = static_cast<wxHtmlContainerCell*>(prev);
+    }
+
+    // The first container of the new fragment continues the last paragraph
+    // of the existing page, just as it would have done if the full document
+    // had been reparsed, so merge its contents into the target container.
+    wxHtmlCell * const first = cells->GetFirstChild();
+    if ( target && first && !first->IsTerminalCell() )
+    {
+        wxHtmlContainerCell * const
+            firstCont = static_cast<wxHtmlContainerCell*>(first);
+
+        while ( wxHtmlCell *cell = firstCont->GetFirstChild() )
+        {
+            firstCont->Detach(cell);
+            target->InsertCell(cell);
+        }
+
+        cells->Detach(firstCont);
+        delete firstCont;
+    }
+
+    // Append the remaining containers to the existing page; this also
+    // invalidates the cached layout of m_Cell, so that CreateLayout() below
+    // takes the new contents into account.
+    while ( wxHtmlCell *cell = cells->GetFirstChild() )
+    {
+        cells->Detach(cell);
+        m_Cell->InsertCell(cell);
+    }
+
+    delete cells;
+
+    CreateLayout();
+    if (m_tmpCanDrawLocks == 0)
+        Refresh();
+    return true;
 }
 
 bool wxHtmlWindow::LoadPage(const wxString& location)
@@ -738,6 +840,10 @@ void wxHtmlWindow::CreateLayout()
     if (!m_Cell)
         return;
 
+    // time the layout to know whether it is too slow to be redone for every
+    // size event, see OnSize()
+    wxStopWatch sw;
+
     if ( HasFlag(wxHW_SCROLLBAR_NEVER) )
     {
         m_Cell->Layout(GetClientSize().GetWidth());
@@ -763,6 +869,8 @@ void wxHtmlWindow::CreateLayout()
             SetVirtualSize(m_Cell->GetWidth(), m_Cell->GetHeight());
         }
     }
+
+    m_lastLayoutTime = sw.Time();
 }
 
 #if wxUSE_CONFIG
@@ -1306,6 +1414,32 @@ void wxHtmlWindow::OnSize(wxSizeEvent& event)
 
     m_backBuffer = wxNullBitmap;
 
+#if wxUSE_TIMER
+    // Relaying a long page out can easily take longer than the interval
+    // between two size events generated during interactive resizing, making
+    // the resize unbearably slow. Once the layout becomes too slow, do it
+    // only when the size stops changing.
+    if ( m_timerRelayout.IsRunning() ||
+            m_lastLayoutTime > wxHTML_MAX_IMMEDIATE_LAYOUT_TIME )
+    {
+        m_timerRelayout.StartOnce(wxHTML_COALESCED_LAYOUT_DELAY);
+        Refresh();
+        return;
+    }
+#endif // wxUSE_TIMER
+
+    DoSizeRelayout();
+}
+
+#if wxUSE_TIMER
+void wxHtmlWindow::OnRelayoutTimer(wxTimerEvent& WXUNUSED(event))
+{
+    DoSizeRelayout();
+}
+#endif // wxUSE_TIMER
+
+void wxHtmlWindow::DoSizeRelayout()
+{
     CreateLayout();
 
     // Recompute selection if necessary:
@@ -1765,6 +1899,9 @@ wxIMPLEMENT_DYNAMIC_CLASS_XTI(wxHtmlWindow, wxScrolledWindow, "wx/html/htmlwin.h
 
 wxBEGIN_EVENT_TABLE(wxHtmlWindow, wxScrolledWindow)
     EVT_SIZE(wxHtmlWindow::OnSize)
+#if wxUSE_TIMER
+    EVT_TIMER(wxID_ANY, wxHtmlWindow::OnRelayoutTimer)
+#endif // wxUSE_TIMER
     EVT_DPI_CHANGED(wxHtmlWindow::OnDPIChanged)
     EVT_LEFT_DOWN(wxHtmlWindow::OnMouseDown)
     EVT_LEFT_UP(wxHtmlWindow::OnMouseUp)
@@ -85,6 +85,10 @@ private:
     // number of actual column (ranging from 0..m_NumCols)
     int m_ActualCol, m_ActualRow;
 
+    // number of rows already measured by ComputeMinMaxWidths(), so that
+    // rows appended later only require measuring the new cells
+    int m_NumRowsMeasured;
+
     // default values (for table and row):
     wxColour m_tBkg, m_rBkg;
     wxString m_tValign, m_rValign;
@@ -112,8 +116,9 @@ private:
     void ReallocCols(int cols);
     void ReallocRows(int rows);
 
-    // Computes minimal and maximal widths of columns. Needs to be called
-    // only once, before first Layout().
+    // Computes minimal and maximal widths of columns. Only the rows added
+    // since the last call are measured, so calling it before every Layout()
+    // is cheap.
     void ComputeMinMaxWidths();
 
     wxDECLARE_NO_COPY_CLASS(wxHtmlTableCell);
@@ -129,6 +134,7 @@ wxHtmlTableCell::wxHtmlTableCell(wxHtmlContainerCell *parent, const wxHtmlTag& t
     m_NumCols = m_NumRows = m_NumAllocatedRows = 0;
     m_CellInfo = NULL;
     m_ActualCol = m_ActualRow = -1;
+    m_NumRowsMeasured = 0;
 
     /* scan params: */
     if (tag.GetParamAsColour(wxT("BGCOLOR"), &m_tBkg))
@@ -372,17 +378,20 @@ void wxHtmlTableCell::AddCell(wxHtmlContainerCell *cell, const wxHtmlTag& tag)
     m_CellInfo[r][c].nowrap = tag.HasParam(wxT("NOWRAP"));
 
     cell->SetIndent(m_Padding, wxHTML_INDENT_ALL, wxHTML_UNITS_PIXELS);
+
+    // the contents of the table changed, so it can't reuse its last layout
+    m_LastLayout = -1;
 }
 
 void wxHtmlTableCell::ComputeMinMaxWidths()
 {
-    if (m_NumCols == 0 || m_ColsInfo[0].minWidth != wxDefaultCoord) return;
+    if (m_NumCols == 0 || m_NumRowsMeasured == m_NumRows) return;
 
-    m_MaxTotalWidth = 0;
-    int percentage = 0;
-    for (int c = 0; c < m_NumCols; c++)
+    // measure the cells of the rows which weren't measured yet (normally
+    // all of them, unless rows were appended to an already measured table):
+    for (int r = m_NumRowsMeasured; r < m_NumRows; r++)
     {
-        for (int r = 0; r < m_NumRows; r++)
+        for (int c = 0; c < m_NumCols; c++)
         {
             cellStruct& cell = m_CellInfo[r][c];
             if (cell.flag == cellUsed)
@@ -403,7 +412,14 @@ void wxHtmlTableCell::ComputeMinMaxWidths()
                 }
             }
         }
-        // Calculate maximum table width, required for nested tables
+    }
+    m_NumRowsMeasured = m_NumRows;
+
+    // Calculate maximum table width, required for nested tables
+    m_MaxTotalWidth = 0;
+    int percentage = 0;
+    for (int c = 0; c < m_NumCols; c++)
+    {
         if (m_ColsInfo[c].units == wxHTML_UNITS_PIXELS)
             m_MaxTotalWidth += wxMax(m_ColsInfo[c].width, m_ColsInfo[c].minWidth);
         else if ((m_ColsInfo[c].units == wxHTML_UNITS_PERCENT) && (m_ColsInfo[c].width != 0))
@@ -428,6 +444,14 @@ void wxHtmlTableCell::Layout(int w)
 {
     ComputeMinMaxWidths();
 
+    // Unlike in the generic container the table layout depends only on the
+    // width given to it, so it can be skipped entirely if it didn't change:
+    // m_LastLayout is reset whenever the contents of the table or anything
+    // else influencing its layout changes.
+    if (m_LastLayout == w)
+        return;
+    m_LastLayout = w;
+
     wxHtmlCell::Layout(w);
 
     /*
@@ -635,14 +659,24 @@ void wxHtmlTableCell::Layout(int w)
             {
                 if (m_CellInfo[actrow][actcol].flag != cellUsed) continue;
                 actcell = m_CellInfo[actrow][actcol].cont;
-                actcell->SetMinHeight(
-                                 ypos[actrow + m_CellInfo[actrow][actcol].rowspan] - ypos[actrow] -  m_Spacing,
-                                 m_CellInfo[actrow][actcol].valign);
-                fullwid = 0;
-                for (int i = actcol; i < m_CellInfo[actrow][actcol].colspan + actcol; i++)
-                    fullwid += m_ColsInfo[i].pixwidth;
-                fullwid += (m_CellInfo[actrow][actcol].colspan - 1) * m_Spacing;
-                actcell->Layout(fullwid);
+                const int rowheight =
+                    ypos[actrow + m_CellInfo[actrow][actcol].rowspan] -
+                        ypos[actrow] - m_Spacing;
+
+                // don't lay out the cell again if it is already as high as
+                // the row, which is common (e.g. in single-column tables or
+                // for the highest cell of the row): growing it to rowheight
+                // wouldn't move anything inside it
+                if (actcell->GetHeight() != rowheight)
+                {
+                    actcell->SetMinHeight(rowheight,
+                                          m_CellInfo[actrow][actcol].valign);
+                    fullwid = 0;
+                    for (int i = actcol; i < m_CellInfo[actrow][actcol].colspan + actcol; i++)
+                        fullwid += m_ColsInfo[i].pixwidth;
+                    fullwid += (m_CellInfo[actrow][actcol].colspan - 1) * m_Spacing;
+                    actcell->Layout(fullwid);
+                }
                 actcell->SetPos(m_ColsInfo[actcol].leftpos, ypos[actrow]);
             }
         }
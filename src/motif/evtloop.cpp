@@ -132,7 +132,7 @@ void wxGUIEventLoop::ScheduleExit(int rc)
 
 void wxGUIEventLoop::DoYieldFor(long eventsToProcess)
 {
-    while (wxTheApp && wxTheApp->Pending())
+    while (wxTheApp && wxTheApp->Pending() && !YieldDeadlineExpired())
         // TODO: implement event filtering using the eventsToProcess mask
         wxTheApp->Dispatch();
 
@@ -1504,6 +1504,11 @@ void wxWindow::AddUpdateRect(int x, int y, int w, int h)
 
 void wxWindow::Refresh(bool eraseBack, const wxRect *rect)
 {
+#if wxUSE_TIMER
+    if ( QueueThrottledRefresh(eraseBack, rect) )
+        return;
+#endif // wxUSE_TIMER
+
     Widget widget = (Widget) GetMainWidget();
     if (!widget)
         return;
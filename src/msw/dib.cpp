@@ -651,6 +651,12 @@ bool wxDIB::Create(const wxImage& image, PixelFormat pf, int dstDepth)
     // but use monochrome if requested (to support wxMask)
     const bool hasAlpha = image.HasAlpha();
     wxCHECK_MSG(!hasAlpha || dstDepth != 1, false, "alpha not supported in monochrome bitmaps");
+
+    // if the image already stores premultiplied values, a straight copy is
+    // all that is needed to produce an ::AlphaBlend()-compatible DIB
+    if ( pf == PixelFormat_PreMultiplied && image.HasPremultipliedAlpha() )
+        pf = PixelFormat_NotPreMultiplied;
+
     const int srcBpp = hasAlpha ? 32 : 24;
     dstDepth = dstDepth != -1 ? dstDepth : srcBpp;
 
@@ -259,7 +259,8 @@ void wxGUIEventLoop::DoYieldFor(long eventsToProcess)
     // the main event loop in order to stop it
     MSG msg;
     int nPaintsReceived = 0;
-    while ( PeekMessage(&msg, (HWND)0, 0, 0, PM_NOREMOVE) &&
+    while ( !YieldDeadlineExpired() &&
+            PeekMessage(&msg, (HWND)0, 0, 0, PM_NOREMOVE) &&
             msg.message != WM_QUIT )
     {
 #if wxUSE_THREADS
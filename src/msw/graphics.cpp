@@ -166,6 +166,9 @@ public :
     // closes the current sub-path
     virtual void CloseSubpath() wxOVERRIDE;
 
+    // removes all points and subpaths, retaining the native path object
+    virtual void Clear() wxOVERRIDE;
+
     //
     // These are convenience functions which - if not available natively will be assembled
     // using the primitives from above
@@ -1513,6 +1516,16 @@ void wxGDIPlusPathData::CloseSubpath()
     }
 }
 
+void wxGDIPlusPathData::Clear()
+{
+    // Reset() empties the path but keeps the native object, so rebuilding
+    // the path doesn't pay the allocation cost again.
+    m_path->Reset();
+    m_logCurrentPointSet = false;
+    m_figureOpened = false;
+    m_figureStart = PointF(0.0, 0.0);
+}
+
 void wxGDIPlusPathData::AddCurveToPoint( wxDouble cx1, wxDouble cy1, wxDouble cx2, wxDouble cy2, wxDouble x, wxDouble y )
 {
     PointF c1(cx1,cy1);
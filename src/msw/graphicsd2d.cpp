@@ -1358,6 +1358,9 @@ public :
     // closes the current sub-path
     void CloseSubpath() wxOVERRIDE;
 
+    // removes all points and subpaths
+    void Clear() wxOVERRIDE;
+
     // returns the native path
     void* GetNativePath() const wxOVERRIDE;
 
@@ -2013,6 +2016,32 @@ void wxD2DPathData::CloseSubpath()
     }
 }
 
+void wxD2DPathData::Clear()
+{
+    // Path geometries are write-once in Direct2D, so unlike in the other
+    // backends the native object can't be reused and we have to create a
+    // new one, exactly as the constructor does.
+    for ( size_t i = 0; i < m_pTransformedGeometries.size(); i++ )
+    {
+        m_pTransformedGeometries[i]->Release();
+    }
+    m_pTransformedGeometries.clear();
+    m_combinedGeometry.reset();
+    m_geometrySink.reset();
+    m_pathGeometry.reset();
+
+    m_currentPointSet = false;
+    m_currentPoint = D2D1::Point2F(0.0f, 0.0f);
+    m_figureOpened = false;
+    m_figureStart = D2D1::Point2F(0.0f, 0.0f);
+    m_figureLogStartSet = false;
+    m_figureLogStart = D2D1::Point2F(0.0f, 0.0f);
+    m_geometryWritable = true;
+
+    m_direct2dfactory->CreatePathGeometry(&m_pathGeometry);
+    m_pathGeometry->Open(&m_geometrySink);
+}
+
 void* wxD2DPathData::GetNativePath() const
 {
     return GetFullGeometry(GetFillMode());
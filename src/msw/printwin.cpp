@@ -208,7 +208,7 @@ bool wxWindowsPrinter::Print(wxWindow *parent, wxPrintout *printout, bool prompt
             }
 
             dc->StartPage();
-            bool cont = printout->OnPrintPage(pn);
+            bool cont = printout->PrintPage(pn);
             dc->EndPage();
 
             if ( !cont )
@@ -1392,6 +1392,9 @@ void wxTextCtrl::DoWriteText(const wxString& value, int flags)
 
 void wxTextCtrl::AppendText(const wxString& text)
 {
+    if ( DoCoalesceAppend(text) )
+        return;
+
     wxTextEntry::AppendText(text);
 
 #if wxUSE_RICHEDIT
@@ -24,6 +24,7 @@
 #ifndef WX_PRECOMP
     #include "wx/intl.h"
     #include "wx/app.h"
+    #include "wx/dynarray.h"
     #include "wx/log.h"
     #include "wx/module.h"
     #include "wx/msgout.h"
@@ -31,6 +32,7 @@
 
 #include "wx/apptrait.h"
 #include "wx/scopeguard.h"
+#include "wx/vector.h"
 
 #include "wx/msw/private.h"
 #include "wx/msw/missing.h"
@@ -1014,6 +1016,123 @@ bool wxThread::SetConcurrency(size_t level)
     return true;
 }
 
+// ----------------------------------------------------------------------------
+// wxCpuTopology
+// ----------------------------------------------------------------------------
+
+// Retrieve the processor topology information from the system, returns an
+// empty vector on error.
+static wxVector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> wxMSWGetCpuInfo()
+{
+    wxVector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> info;
+
+    DWORD len = 0;
+    if ( !::GetLogicalProcessorInformation(NULL, &len) &&
+            ::GetLastError() == ERROR_INSUFFICIENT_BUFFER &&
+                len >= sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION) )
+    {
+        info.resize(len / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+        if ( !::GetLogicalProcessorInformation(&info[0], &len) )
+        {
+            wxLogLastError(wxT("GetLogicalProcessorInformation"));
+
+            info.clear();
+        }
+    }
+
+    return info;
+}
+
+int wxCpuTopology::GetLogicalCpuCount()
+{
+    const int count = wxThread::GetCPUCount();
+
+    return count > 0 ? count : 1;
+}
+
+int wxCpuTopology::GetCoreCount()
+{
+    const wxVector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> info = wxMSWGetCpuInfo();
+
+    int cores = 0;
+    for ( size_t n = 0; n < info.size(); n++ )
+    {
+        if ( info[n].Relationship == RelationProcessorCore )
+            cores++;
+    }
+
+    return cores > 0 ? cores : GetLogicalCpuCount();
+}
+
+wxArrayInt wxCpuTopology::GetSmtSiblings(int cpu)
+{
+    wxArrayInt siblings;
+
+    if ( cpu >= 0 && (unsigned)cpu < 8*sizeof(ULONG_PTR) )
+    {
+        const wxVector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> info =
+            wxMSWGetCpuInfo();
+
+        for ( size_t n = 0; n < info.size(); n++ )
+        {
+            if ( info[n].Relationship != RelationProcessorCore )
+                continue;
+
+            const ULONG_PTR mask = info[n].ProcessorMask;
+            if ( !(mask & ((ULONG_PTR)1 << cpu)) )
+                continue;
+
+            for ( unsigned bit = 0; bit < 8*sizeof(ULONG_PTR); bit++ )
+            {
+                if ( mask & ((ULONG_PTR)1 << bit) )
+                    siblings.Add((int)bit);
+            }
+
+            break;
+        }
+    }
+
+    if ( siblings.IsEmpty() )
+    {
+        // a CPU is always its own sibling
+        siblings.Add(cpu);
+    }
+
+    return siblings;
+}
+
+int wxCpuTopology::GetNumaNodeCount()
+{
+    const wxVector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> info = wxMSWGetCpuInfo();
+
+    int nodes = 0;
+    for ( size_t n = 0; n < info.size(); n++ )
+    {
+        if ( info[n].Relationship == RelationNumaNode )
+            nodes++;
+    }
+
+    return nodes > 0 ? nodes : 1;
+}
+
+int wxCpuTopology::GetCpuNumaNode(int cpu)
+{
+    if ( cpu >= 0 && (unsigned)cpu < 8*sizeof(ULONG_PTR) )
+    {
+        const wxVector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> info =
+            wxMSWGetCpuInfo();
+
+        for ( size_t n = 0; n < info.size(); n++ )
+        {
+            if ( info[n].Relationship == RelationNumaNode &&
+                    (info[n].ProcessorMask & ((ULONG_PTR)1 << cpu)) )
+                return (int)info[n].NumaNode.NodeNumber;
+        }
+    }
+
+    return 0;
+}
+
 // ctor and dtor
 // -------------
 
@@ -1164,6 +1283,39 @@ unsigned int wxThread::GetPriority() const
     return m_internal->GetPriority();
 }
 
+bool wxThread::SetAffinity(const wxArrayInt& cpus)
+{
+    wxCHECK_MSG( !cpus.empty(), false,
+                 wxT("affinity CPU set must not be empty") );
+
+    wxCriticalSectionLocker lock(m_critsect);
+
+    HANDLE hThread = m_internal->GetHandle();
+    wxCHECK_MSG( hThread, false, wxT("thread must be created first") );
+
+    // build the affinity bit mask: notice that this limits us to the CPUs of
+    // the current processor group, i.e. at most 64 of them
+    DWORD_PTR dwMask = 0;
+    const size_t count = cpus.size();
+    for ( size_t n = 0; n < count; n++ )
+    {
+        const int cpu = cpus[n];
+        wxCHECK_MSG( cpu >= 0 && (unsigned)cpu < 8*sizeof(DWORD_PTR), false,
+                     wxT("invalid CPU index") );
+
+        dwMask |= (DWORD_PTR)1 << cpu;
+    }
+
+    if ( !::SetThreadAffinityMask(hThread, dwMask) )
+    {
+        wxLogLastError(wxT("SetThreadAffinityMask"));
+
+        return false;
+    }
+
+    return true;
+}
+
 unsigned long wxThread::GetId() const
 {
     wxCriticalSectionLocker lock(const_cast<wxCriticalSection &>(m_critsect));
@@ -1687,6 +1687,11 @@ void wxWindowMSW::DoThaw()
 
 void wxWindowMSW::Refresh(bool eraseBack, const wxRect *rect)
 {
+#if wxUSE_TIMER
+    if ( QueueThrottledRefresh(eraseBack, rect) )
+        return;
+#endif // wxUSE_TIMER
+
     HWND hWnd = GetHwnd();
     if ( hWnd )
     {
@@ -1176,6 +1176,9 @@ public :
     // closes the current sub-path
     virtual void CloseSubpath() wxOVERRIDE;
 
+    // removes all points and subpaths
+    virtual void Clear() wxOVERRIDE;
+
     // gets the last point of the current path, (0,0) if not yet set
     virtual void GetCurrentPoint( wxDouble* x, wxDouble* y) const wxOVERRIDE;
 
@@ -1333,6 +1336,14 @@ void wxMacCoreGraphicsPathData::CloseSubpath()
     }
 }
 
+void wxMacCoreGraphicsPathData::Clear()
+{
+    // CGPath provides no way to empty an existing path, so replace it with
+    // a new one (which is cheap with CoreGraphics).
+    CGPathRelease( m_path );
+    m_path = CGPathCreateMutable();
+}
+
 // gets the last point of the current path, (0,0) if not yet set
 void wxMacCoreGraphicsPathData::GetCurrentPoint( wxDouble* x, wxDouble* y) const
 {
@@ -184,7 +184,7 @@ void wxMacWakeUp()
 void wxCFEventLoop::DoYieldFor(long eventsToProcess)
 {
     // process all pending events:
-    while ( DoProcessEvents() == 1 )
+    while ( DoProcessEvents() == 1 && !YieldDeadlineExpired() )
         ;
 
     wxEventLoopBase::DoYieldFor(eventsToProcess);
@@ -657,7 +657,7 @@ bool wxMacPrinter::Print(wxWindow *parent, wxPrintout *printout, bool prompt)
         else
         {
                 dc->StartPage();
-                keepGoing = printout->OnPrintPage(pn);
+                keepGoing = printout->PrintPage(pn);
                 dc->EndPage();
         }
     }
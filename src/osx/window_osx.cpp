@@ -1339,8 +1339,13 @@ void wxWindowMac::DoGetTextExtent(const wxString& str,
  * we always intersect with the entire window, not only with the client area
  */
 
-void wxWindowMac::Refresh(bool WXUNUSED(eraseBack), const wxRect *rect)
+void wxWindowMac::Refresh(bool eraseBack, const wxRect *rect)
 {
+#if wxUSE_TIMER
+    if ( QueueThrottledRefresh(eraseBack, rect) )
+        return ;
+#endif // wxUSE_TIMER
+
     if ( GetPeer() == NULL )
         return ;
 
@@ -485,22 +485,41 @@ wxPGProperty* wxPropertyGridPageState::BaseGetPropertyByName( const wxString& na
 
 // -----------------------------------------------------------------------
 
+void wxPropertyGridPageState::DoAddToNameDict( wxPGProperty* p )
+{
+    if ( !p->GetBaseName().empty() )
+        m_dictName[p->GetName()] = (void*) p;
+
+    for ( unsigned int i = 0; i < p->GetChildCount(); i++ )
+        DoAddToNameDict( p->Item(i) );
+}
+
+// -----------------------------------------------------------------------
+
+void wxPropertyGridPageState::DoRemoveFromNameDict( wxPGProperty* p )
+{
+    if ( !p->GetBaseName().empty() )
+        m_dictName.erase( p->GetName() );
+
+    for ( unsigned int i = 0; i < p->GetChildCount(); i++ )
+        DoRemoveFromNameDict( p->Item(i) );
+}
+
+// -----------------------------------------------------------------------
+
 void wxPropertyGridPageState::DoSetPropertyName( wxPGProperty* p,
                                                  const wxString& newName )
 {
     wxCHECK_RET( p, wxS("invalid property id") );
 
-    wxPGProperty* parent = p->GetParent();
-
-    if ( parent->IsCategory() || parent->IsRoot() )
-    {
-        if ( !p->GetBaseName().empty() )
-            m_dictName.erase( p->GetBaseName() );
-        if ( !newName.empty() )
-            m_dictName[newName] = (void*) p;
-    }
+    // Properties are indexed by their full names, which for a child
+    // property depend on the names of its parents, so the whole subtree
+    // must be re-indexed.
+    DoRemoveFromNameDict( p );
 
     p->DoSetName(newName);
+
+    DoAddToNameDict( p );
 }
 
 // -----------------------------------------------------------------------
@@ -1711,10 +1730,10 @@ wxPGProperty* wxPropertyGridPageState::DoInsert( wxPGProperty* parent, int index
             m_abcArray->DoAddChild( property, index, true );
     }
 
-    // Only add name to hashmap if parent is root or category
-    if ( !property->GetBaseName().empty() &&
-        (parentIsCategory || parentIsRoot) )
-        m_dictName[property->GetBaseName()] = (void*) property;
+    // Add full names of the property and all of its children to the
+    // hashmap. Children added before the property itself do not pass
+    // through here, so the whole subtree must be indexed at once.
+    DoAddToNameDict( property );
 
     VirtualHeightChanged();
 
@@ -1978,9 +1997,10 @@ void wxPropertyGridPageState::DoDelete( wxPGProperty* item, bool doDelete )
         }
     }
 
-    if ( !item->GetBaseName().empty() &&
-         (parent->IsCategory() || parent->IsRoot()) )
-        m_dictName.erase(item->GetBaseName());
+    // Remove full names of the item and any remaining children (e.g.
+    // fixed children of an aggregate, which are not deleted through
+    // DoDelete()) from the hashmap.
+    DoRemoveFromNameDict( item );
 
     // We need to clear parent grid's m_propHover, if it matches item
     if ( pg && pg->m_propHover == item )
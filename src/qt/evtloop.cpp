@@ -11,6 +11,7 @@
 #include "wx/app.h"
 #include "wx/apptrait.h"
 #include "wx/evtloop.h"
+#include "wx/time.h"
 #include "wx/private/eventloopsourcesmanager.h"
 
 #include <QtCore/QCoreApplication>
@@ -160,7 +161,18 @@ void wxQtEventLoopBase::DoYieldFor(long eventsToProcess)
     if ( !(eventsToProcess & wxEVT_CATEGORY_SOCKET) )
         flags |= QEventLoop::ExcludeSocketNotifiers;
 
-    m_qtEventLoop->processEvents(flags);
+    if ( m_yieldDeadline != 0 )
+    {
+        // PumpFor() limited the time we may spend here, use the bounded
+        // processEvents() overload.
+        const wxLongLong remaining = m_yieldDeadline - wxGetUTCTimeMillis();
+        if ( remaining > 0 )
+            m_qtEventLoop->processEvents(flags, remaining.ToLong());
+    }
+    else
+    {
+        m_qtEventLoop->processEvents(flags);
+    }
 
     wxEventLoopBase::DoYieldFor(eventsToProcess);
 }
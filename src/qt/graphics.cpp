@@ -553,6 +553,13 @@ public:
         MoveToPoint(firstElement.x, firstElement.y);
     }
 
+    // removes all points and subpaths
+    virtual void Clear() wxOVERRIDE
+    {
+        *m_path = QPainterPath();
+        m_current_subpath_start = -1;
+    }
+
     //
     // These are convenience functions which - if not available natively will
     // be assembled using the primitives from above
@@ -540,8 +540,13 @@ void wxWindowQt::Update()
     }
 }
 
-void wxWindowQt::Refresh( bool WXUNUSED( eraseBackground ), const wxRect *rect )
+void wxWindowQt::Refresh( bool eraseBackground, const wxRect *rect )
 {
+#if wxUSE_TIMER
+    if ( QueueThrottledRefresh(eraseBackground, rect) )
+        return;
+#endif // wxUSE_TIMER
+
     QWidget *widget;
 
     // get the inner widget in scroll areas:
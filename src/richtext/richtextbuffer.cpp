@@ -1768,6 +1768,20 @@ void wxRichTextCompositeObject::Dump(wxTextOutputStream& stream)
     }
 }
 
+/// Estimate the memory used by this object and its children
+size_t wxRichTextCompositeObject::GetApproximateSize() const
+{
+    size_t size = wxRichTextObject::GetApproximateSize();
+
+    wxRichTextObjectList::compatibility_iterator node = m_children.GetFirst();
+    while (node)
+    {
+        size += node->GetData()->GetApproximateSize();
+        node = node->GetNext();
+    }
+    return size;
+}
+
 /// Get/set the object size for the given range. Returns false if the range
 /// is invalid for this object.
 bool wxRichTextCompositeObject::GetRangeSize(const wxRichTextRange& range, wxSize& size, int& descent, wxDC& dc, wxRichTextDrawingContext& context, int flags, const wxPoint& position, const wxSize& parentSize, wxArrayInt* partialExtents) const
@@ -4803,6 +4817,20 @@ wxRichTextParagraph::wxRichTextParagraph(const wxString& text, wxRichTextObject*
 void wxRichTextParagraph::Init()
 {
     m_impactedByFloatingObjects = -1;
+    m_cachedLayoutWidth = 0;
+    m_layoutDirty = true;
+}
+
+/// Invalidate the given range: also marks the cached lines as unusable
+void wxRichTextParagraph::Invalidate(const wxRichTextRange& invalidRange)
+{
+    wxRichTextCompositeObject::Invalidate(invalidRange);
+
+    // wxRICHTEXT_NONE means "mark the content as valid", which concerns the
+    // containers' invalid ranges and not our cached lines, which remain
+    // usable.
+    if (invalidRange != wxRICHTEXT_NONE)
+        m_layoutDirty = true;
 }
 
 wxRichTextParagraph::~wxRichTextParagraph()
@@ -4984,6 +5012,70 @@ bool wxRichTextParagraph::Layout(wxDC& dc, wxRichTextDrawingContext& context, co
 
     wxRichTextFloatCollector* collector = GetContainer()->GetFloatCollector();
 
+    // Check whether the lines cached by the last layout can be reused: they
+    // can if the content and style are unchanged and the new available width
+    // either is the same as the one used the last time, or doesn't matter
+    // because the paragraph fits into it without wrapping anyhow.
+    if (!m_layoutDirty && m_cachedLayoutWidth != 0 && !m_cachedLines.IsEmpty())
+    {
+        bool canReuse;
+        if (rect.GetWidth() == m_cachedLayoutWidth)
+        {
+            canReuse = true;
+        }
+        else if (rect.GetWidth() >= GetMaxSize().x &&
+                 m_cachedLayoutWidth >= GetMaxSize().x)
+        {
+            // Without wrapping, the line positions still depend on the
+            // available width for the non-default alignments.
+            wxRichTextAttr combinedAttr = GetCombinedAttributes();
+            canReuse = !combinedAttr.HasAlignment() ||
+                        combinedAttr.GetAlignment() == wxTEXT_ALIGNMENT_LEFT;
+        }
+        else
+        {
+            canReuse = false;
+        }
+
+        // Floating objects can change the wrapping independently of the
+        // paragraph itself, so don't take any chances if any are involved.
+        if (canReuse && wxRichTextBuffer::GetFloatingLayoutMode())
+        {
+            if (!collector || collector->HasFloats())
+            {
+                canReuse = false;
+            }
+            else
+            {
+                wxRichTextObjectList::compatibility_iterator node = m_children.GetFirst();
+                while (canReuse && node)
+                {
+                    if (node->GetData()->IsFloating())
+                        canReuse = false;
+                    node = node->GetNext();
+                }
+            }
+        }
+
+        if (canReuse)
+        {
+            if (wxRichTextBuffer::GetFloatingLayoutMode() && collector &&
+                    m_impactedByFloatingObjects == -1)
+            {
+                if (collector->GetLastRectBottom() >= rect.GetTop())
+                    m_impactedByFloatingObjects = 1;
+                else
+                    m_impactedByFloatingObjects = 0;
+            }
+
+            // This moves the children too, but the lines are stored relative
+            // to the paragraph, so they remain valid.
+            Move(rect.GetPosition());
+
+            return true;
+        }
+    }
+
     if (wxRichTextBuffer::GetFloatingLayoutMode())
     {
         wxASSERT(collector != NULL);
@@ -5574,6 +5666,52 @@ bool wxRichTextParagraph::Layout(wxDC& dc, wxRichTextDrawingContext& context, co
 #endif
 #endif
 
+    // Remember the layout input so that the cached lines can be reused by the
+    // next Layout() call if nothing changes in the meanwhile.
+    m_cachedLayoutWidth = rect.GetWidth();
+    m_layoutDirty = false;
+
+    return true;
+}
+
+/// Lays out the object first with the given available space, and again with
+/// the minimum size if no width was specified in the attributes: same as the
+/// base class version, except that the second pass is skipped when the cached
+/// lines are already laid out for exactly the minimum width, as invalidating
+/// and redoing the layout would then needlessly throw the cache away.
+bool wxRichTextParagraph::LayoutToBestSize(wxDC& dc, wxRichTextDrawingContext& context, wxRichTextBuffer* buffer,
+    const wxRichTextAttr& parentAttr, const wxRichTextAttr& attr,
+    const wxRect& availableParentSpace, const wxRect& availableContainerSpace,
+    int style)
+{
+    wxRect availableChildRect = AdjustAvailableSpace(dc, buffer, parentAttr, attr, availableParentSpace, availableContainerSpace);
+
+    Layout(dc, context, availableChildRect, availableContainerSpace, style);
+
+    wxSize maxSize = GetMaxSize();
+
+    // Don't ignore if maxSize.x is zero, since we need to redo the paragraph's lines
+    // on this basis
+    if (!attr.GetTextBoxAttr().GetWidth().IsValid() && maxSize.x < availableChildRect.width)
+    {
+        if (!attr.HasAlignment() || attr.GetAlignment() == wxTEXT_ALIGNMENT_LEFT)
+        {
+            // Redo the layout with a fixed, minimum size this time.
+            wxRichTextAttr newAttr(attr);
+            newAttr.GetTextBoxAttr().GetWidth().SetValue(maxSize.x, wxTEXT_ATTR_UNITS_PIXELS);
+            newAttr.GetTextBoxAttr().GetWidth().SetPosition(wxTEXT_BOX_ATTR_POSITION_ABSOLUTE);
+
+            availableChildRect = AdjustAvailableSpace(dc, buffer, parentAttr, newAttr, availableParentSpace, availableContainerSpace);
+
+            if (m_layoutDirty || availableChildRect.GetWidth() != m_cachedLayoutWidth)
+            {
+                Invalidate(wxRICHTEXT_ALL);
+
+                Layout(dc, context, availableChildRect, availableContainerSpace, style);
+            }
+        }
+    }
+
     return true;
 }
 
@@ -5691,6 +5829,10 @@ void wxRichTextParagraph::Copy(const wxRichTextParagraph& obj)
 {
     wxRichTextCompositeObject::Copy(obj);
     m_impactedByFloatingObjects = obj.m_impactedByFloatingObjects;
+
+    // The lines are not copied, so the copy must be laid out from scratch.
+    m_cachedLayoutWidth = 0;
+    m_layoutDirty = true;
 }
 
 /// Clear the cached lines
@@ -7782,7 +7924,7 @@ bool                        wxRichTextBuffer::sm_floatingLayoutMode = true;
 /// Initialisation
 void wxRichTextBuffer::Init()
 {
-    m_commandProcessor = new wxCommandProcessor;
+    m_commandProcessor = new wxRichTextCommandProcessor;
     m_styleSheet = NULL;
     m_modified = false;
     m_batchedCommandDepth = 0;
@@ -7815,6 +7957,19 @@ void wxRichTextBuffer::ResetAndClearCommands()
     Invalidate(wxRICHTEXT_ALL);
 }
 
+void wxRichTextBuffer::SetUndoMemoryBudget(size_t budget)
+{
+    wxRichTextCommandProcessor* processor = wxDynamicCast(m_commandProcessor, wxRichTextCommandProcessor);
+    if (processor)
+        processor->SetMemoryBudget(budget);
+}
+
+size_t wxRichTextBuffer::GetUndoMemoryBudget() const
+{
+    wxRichTextCommandProcessor* processor = wxDynamicCast(m_commandProcessor, wxRichTextCommandProcessor);
+    return processor ? processor->GetMemoryBudget() : 0;
+}
+
 void wxRichTextBuffer::Copy(const wxRichTextBuffer& obj)
 {
     wxRichTextParagraphLayoutBox::Copy(obj);
@@ -11703,16 +11858,20 @@ void wxRichTextModuleInit()
  *
  */
 
+wxIMPLEMENT_CLASS(wxRichTextCommand, wxCommand);
+
 wxRichTextCommand::wxRichTextCommand(const wxString& name, wxRichTextCommandId id, wxRichTextBuffer* buffer,
                                      wxRichTextParagraphLayoutBox* container, wxRichTextCtrl* ctrl, bool ignoreFirstTime): wxCommand(true, name)
 {
     m_freeze = ctrl ? ctrl->IsFrozen() : false;
+    m_cachedSize = 0;
     /* wxRichTextAction* action = */ new wxRichTextAction(this, name, id, buffer, container, ctrl, ignoreFirstTime);
 }
 
 wxRichTextCommand::wxRichTextCommand(const wxString& name): wxCommand(true, name)
 {
     m_freeze = false;
+    m_cachedSize = 0;
 }
 
 wxRichTextCommand::~wxRichTextCommand()
@@ -11723,7 +11882,10 @@ wxRichTextCommand::~wxRichTextCommand()
 void wxRichTextCommand::AddAction(wxRichTextAction* action)
 {
     if (!m_actions.Member(action))
+    {
         m_actions.Append(action);
+        m_cachedSize = 0;
+    }
 
     if (!m_freeze && action->GetRichTextCtrl() && action->GetRichTextCtrl()->IsFrozen())
         m_freeze = true;
@@ -11766,6 +11928,80 @@ bool wxRichTextCommand::Undo()
 void wxRichTextCommand::ClearActions()
 {
     WX_CLEAR_LIST(wxList, m_actions);
+    m_cachedSize = 0;
+}
+
+size_t wxRichTextCommand::GetApproximateSize() const
+{
+    if (m_cachedSize == 0)
+    {
+        size_t size = sizeof(*this);
+        for (wxList::compatibility_iterator node = m_actions.GetFirst(); node; node = node->GetNext())
+            size += ((wxRichTextAction*) node->GetData())->GetApproximateSize();
+
+        m_cachedSize = size;
+    }
+    return m_cachedSize;
+}
+
+/*!
+ * Command processor with an optional memory budget for the undo history
+ *
+ */
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxRichTextCommandProcessor, wxCommandProcessor);
+
+void wxRichTextCommandProcessor::Store(wxCommand* command)
+{
+    wxCommandProcessor::Store(command);
+
+    TrimCommands();
+}
+
+size_t wxRichTextCommandProcessor::GetApproximateSize() const
+{
+    size_t size = 0;
+    for (wxList::compatibility_iterator node = GetCommands().GetFirst(); node; node = node->GetNext())
+        size += GetCommandSize((wxCommand*) node->GetData());
+
+    return size;
+}
+
+size_t wxRichTextCommandProcessor::GetCommandSize(wxCommand* command)
+{
+    wxRichTextCommand* richTextCommand = wxDynamicCast(command, wxRichTextCommand);
+    if (richTextCommand)
+        return richTextCommand->GetApproximateSize();
+
+    // A foreign command whose memory use we know nothing about
+    return 256;
+}
+
+void wxRichTextCommandProcessor::TrimCommands()
+{
+    if (m_memoryBudget == 0)
+        return;
+
+    size_t size = GetApproximateSize();
+    while (size > m_memoryBudget && m_commands.GetCount() > 1)
+    {
+        wxList::compatibility_iterator firstNode = m_commands.GetFirst();
+
+        // Never drop the current command, so that at least one undo level
+        // always remains, and never drop commands when everything has been
+        // undone, since they would be needed for redo.
+        if (!m_currentCommand || firstNode == m_currentCommand)
+            break;
+
+        // Make sure m_lastSavedCommand won't point to freed memory
+        if (m_lastSavedCommand && m_lastSavedCommand == firstNode)
+            m_lastSavedCommand = wxList::compatibility_iterator();
+
+        wxCommand* command = (wxCommand*) firstNode->GetData();
+        size -= wxMin(size, GetCommandSize(command));
+        delete command;
+        m_commands.Erase(firstNode);
+    }
 }
 
 /*!
@@ -11797,6 +12033,16 @@ wxRichTextAction::~wxRichTextAction()
         delete m_object;
 }
 
+size_t wxRichTextAction::GetApproximateSize() const
+{
+    size_t size = sizeof(*this);
+    size += m_newParagraphs.GetApproximateSize();
+    size += m_oldParagraphs.GetApproximateSize();
+    if (m_object)
+        size += m_object->GetApproximateSize();
+    return size;
+}
+
 // Returns the container that this action refers to, using the container address and top-level buffer.
 wxRichTextParagraphLayoutBox* wxRichTextAction::GetContainer() const
 {
@@ -34,6 +34,8 @@
 wxRichTextPrintout::wxRichTextPrintout(const wxString& title) : wxPrintout(title)
 {
     m_numPages = wxRICHTEXT_PRINT_MAX_PAGES;
+    m_pageBreaksValid = false;
+    m_cachedBufferScale = 1.0;
 
     SetMargins(); // to default values
 }
@@ -46,12 +48,6 @@ void wxRichTextPrintout::OnPreparePrinting()
 {
     wxBusyCursor wait;
 
-    m_numPages = 1;
-
-    m_pageBreaksStart.Clear();
-    m_pageBreaksEnd.Clear();
-    m_pageYOffsets.Clear();
-
     int lastStartPos = 0;
 
     wxRect rect, headerRect, footerRect;
@@ -59,6 +55,31 @@ void wxRichTextPrintout::OnPreparePrinting()
     /// Sets the DC scaling and returns important page rectangles
     CalculateScaling(GetDC(), rect, headerRect, footerRect);
 
+    if (GetRichTextBuffer())
+    {
+        // Reuse the cached page break table if nothing affecting pagination
+        // changed since it was computed: laying out the whole buffer for the
+        // printer DC is far too expensive to repeat for every preview
+        // operation.
+        if (m_pageBreaksValid &&
+            rect == m_cachedTextRect &&
+            GetRichTextBuffer()->GetScale() == m_cachedBufferScale &&
+            !GetRichTextBuffer()->IsDirty())
+            return;
+
+        m_pageBreaksValid = true;
+        m_cachedTextRect = rect;
+        m_cachedBufferScale = GetRichTextBuffer()->GetScale();
+    }
+    else
+        m_pageBreaksValid = false;
+
+    m_numPages = 1;
+
+    m_pageBreaksStart.Clear();
+    m_pageBreaksEnd.Clear();
+    m_pageYOffsets.Clear();
+
     if (GetRichTextBuffer())
     {
         GetRichTextBuffer()->Invalidate(wxRICHTEXT_ALL);
@@ -315,6 +336,8 @@ void wxRichTextPrintout::SetMargins(int top, int bottom, int left, int right)
     m_marginBottom = bottom;
     m_marginLeft = left;
     m_marginRight = right;
+
+    InvalidatePagination();
 }
 
 /// Calculate scaling and rectangles, setting the device context scaling
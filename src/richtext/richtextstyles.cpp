@@ -89,6 +89,11 @@ wxRichTextAttr wxRichTextStyleDefinition::GetStyleMergedWithBase(const wxRichTex
             def = NULL;
     }
 
+    // Let the sheet cache the merged result: reapplying the whole chain for
+    // every paragraph using this style would be needlessly expensive.
+    if (sheet)
+        return sheet->GetMergedStyle(this, styles);
+
     wxRichTextAttr attr;
     wxList::compatibility_iterator node = styles.GetFirst();
     while (node)
@@ -326,6 +331,7 @@ bool wxRichTextStyleSheet::RemoveStyle(wxList& list, wxRichTextStyleDefinition*
     {
         wxRichTextStyleDefinition* nodeDef = (wxRichTextStyleDefinition*) node->GetData();
         list.Erase(node);
+        ClearStyleCaches();
         if (deleteStyle)
             delete nodeDef;
         return true;
@@ -364,6 +370,86 @@ wxRichTextStyleDefinition* wxRichTextStyleSheet::FindStyle(const wxList& list, c
     return NULL;
 }
 
+/// Find a definition by name, using and updating the given lookup cache
+wxRichTextStyleDefinition* wxRichTextStyleSheet::FindStyle(const wxList& list, wxRichTextStyleDefinitionHashMap& cache, const wxString& name, bool recurse) const
+{
+    wxRichTextStyleDefinitionHashMap::iterator it = cache.find(name);
+    if (it != cache.end())
+    {
+        // The definition may have been renamed since it was cached, in
+        // which case the entry is stale and must be dropped.
+        if (it->second->GetName() == name)
+            return it->second;
+
+        cache.erase(it);
+    }
+
+    for (wxList::compatibility_iterator node = list.GetFirst(); node; node = node->GetNext())
+    {
+        wxRichTextStyleDefinition* def = (wxRichTextStyleDefinition*) node->GetData();
+        if (def->GetName() == name)
+        {
+            cache[name] = def;
+            return def;
+        }
+    }
+
+    if (m_nextSheet && recurse)
+        return m_nextSheet->FindStyle(list, cache, name, recurse);
+
+    return NULL;
+}
+
+/// Return the result of applying all the styles in the given list in order
+wxRichTextAttr wxRichTextStyleSheet::GetMergedStyle(const wxRichTextStyleDefinition* def, const wxList& styles) const
+{
+    wxList::compatibility_iterator node;
+
+    wxRichTextMergedStyleHashMap::iterator it = m_mergedStyleCache.find(def);
+    if (it != m_mergedStyleCache.end())
+    {
+        // Reuse the cached result only if it was computed from the same
+        // attributes, i.e. no definition in the base style chain was
+        // modified in place since then.
+        bool upToDate = it->second.m_sourceStyles.size() == styles.GetCount();
+
+        size_t i = 0;
+        for (node = styles.GetFirst(); upToDate && node; node = node->GetNext(), i++)
+        {
+            wxRichTextStyleDefinition* nodeDef = (wxRichTextStyleDefinition*) node->GetData();
+            if (!(it->second.m_sourceStyles[i] == nodeDef->GetStyle()))
+                upToDate = false;
+        }
+
+        if (upToDate)
+            return it->second.m_mergedStyle;
+
+        m_mergedStyleCache.erase(it);
+    }
+
+    wxRichTextMergedStyle merged;
+    for (node = styles.GetFirst(); node; node = node->GetNext())
+    {
+        wxRichTextStyleDefinition* nodeDef = (wxRichTextStyleDefinition*) node->GetData();
+        merged.m_sourceStyles.push_back(nodeDef->GetStyle());
+        merged.m_mergedStyle.Apply(nodeDef->GetStyle(), NULL);
+    }
+
+    m_mergedStyleCache[def] = merged;
+
+    return merged.m_mergedStyle;
+}
+
+/// Clear the name lookup and merged style caches
+void wxRichTextStyleSheet::ClearStyleCaches()
+{
+    m_characterStyleCache.clear();
+    m_paragraphStyleCache.clear();
+    m_listStyleCache.clear();
+    m_boxStyleCache.clear();
+    m_mergedStyleCache.clear();
+}
+
 /// Delete all styles
 void wxRichTextStyleSheet::DeleteStyles()
 {
@@ -371,6 +457,7 @@ void wxRichTextStyleSheet::DeleteStyles()
     WX_CLEAR_LIST(wxList, m_paragraphStyleDefinitions);
     WX_CLEAR_LIST(wxList, m_listStyleDefinitions);
     WX_CLEAR_LIST(wxList, m_boxStyleDefinitions);
+    ClearStyleCaches();
 }
 
 /// Insert into list of style sheets
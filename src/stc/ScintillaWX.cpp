@@ -1269,6 +1269,18 @@ void ScintillaWX::DoOnIdle(wxIdleEvent& evt) {
         SetIdle(false);
 }
 
+void ScintillaWX::SetStylingBudget(double seconds) {
+    // Clamp to sane values: styling less than a millisecond at a time would
+    // make no progress on huge documents, while budgets of more than a second
+    // would freeze the UI, which is exactly what the budget is meant to avoid.
+    if ( seconds < 0.001 )
+        seconds = 0.001;
+    else if ( seconds > 1.0 )
+        seconds = 1.0;
+
+    secondsAllowedStyling = seconds;
+}
+
 //----------------------------------------------------------------------
 
 #if wxUSE_DRAG_AND_DROP
@@ -192,6 +192,8 @@ public:
     void FullPaintDC(wxDC* dc);
     bool CanPaste() wxOVERRIDE;
     bool GetHideSelection() { return view.hideSelection; }
+    void SetStylingBudget(double seconds);
+    double GetStylingBudget() const { return secondsAllowedStyling; }
     void DoScrollToLine(int line);
     void DoScrollToColumn(int column);
     void ClipChildren(wxDC& dc, PRectangle rect);
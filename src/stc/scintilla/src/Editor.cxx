@@ -176,6 +176,7 @@ Editor::Editor() {
 	willRedrawAll = false;
 	idleStyling = SC_IDLESTYLING_NONE;
 	needIdleStyling = false;
+	secondsAllowedStyling = 0.02;
 
 	modEventMask = SC_MODEVENTMASKALL;
 
@@ -5054,7 +5055,8 @@ int Editor::PositionAfterMaxStyling(int posMax, bool scrolling) const {
 
 	// Try to keep time taken by styling reasonable so interaction remains smooth.
 	// When scrolling, allow less time to ensure responsive
-	const double secondsAllowed = scrolling ? 0.005 : 0.02;
+	const double secondsAllowed = scrolling ? secondsAllowedStyling / 4.0
+		: secondsAllowedStyling;
 
 	const int linesToStyle = Platform::Clamp(static_cast<int>(secondsAllowed / pdoc->durationStyleOneLine),
 		10, 0x10000);
@@ -235,6 +235,7 @@ protected:	// ScintillaBase subclass needs access to much of Editor
 	WorkNeeded workNeeded;
 	int idleStyling;
 	bool needIdleStyling;
+	double secondsAllowedStyling;
 
 	int modEventMask;
 
@@ -4763,6 +4763,19 @@ int wxStyledTextCtrl::GetCurrentLine() {
 }
 
 
+// Set the time budget, in seconds, spent styling text in one idle event
+// when idle styling is enabled with SetIdleStyling().
+void wxStyledTextCtrl::SetIdleStylingBudget(double seconds) {
+    m_swx->SetStylingBudget(seconds);
+}
+
+
+// Get the time budget, in seconds, spent styling text in one idle event.
+double wxStyledTextCtrl::GetIdleStylingBudget() const {
+    return m_swx->GetStylingBudget();
+}
+
+
 // Extract style settings from a spec-string which is composed of one or
 // more of the following comma separated elements:
 //
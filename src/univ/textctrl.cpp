@@ -785,7 +785,11 @@ wxTextCtrl::~wxTextCtrl()
 
 void wxTextCtrl::DoSetValue(const wxString& value, int flags)
 {
-    if ( value != GetValue() )
+    // comparing with GetValue() is expensive for big multiline controls as it
+    // rebuilds the entire contents from the individual lines, so compare the
+    // lengths first: they're different for different contents and the length
+    // of the current value is cached
+    if ( value.length() != (size_t)GetLastPosition() || value != GetValue() )
     {
         EventsSuppressor noeventsIf(this, !(flags & SetValue_SendEvent));
 
@@ -1035,17 +1039,33 @@ void wxTextCtrl::Replace(wxTextPos from, wxTextPos to, const wxString& text)
 
         // (1) join lines
         const wxArrayString& linesOld = GetLines();
-        wxString textOrig;
         wxTextCoord line;
+
+        // compute the length of the text in the replaced range without
+        // concatenating it first: if the replacement overwrites the range
+        // entirely, as notably happens when SetValue() replaces everything,
+        // we can avoid making a copy of the old text just to throw it away
+        size_t lenOrig = (size_t)(lineEnd - lineStart);
         for ( line = lineStart; line <= lineEnd; line++ )
+            lenOrig += linesOld[line].length();
+
+        // adjust for index shift: to is relative to colStart, not 0
+        const size_t toRel = (size_t)((to - from) + colStart);
+
+        wxString textOrig;
+        if ( colStart > 0 || toRel < lenOrig )
         {
-            if ( line > lineStart )
+            textOrig.reserve(lenOrig);
+            for ( line = lineStart; line <= lineEnd; line++ )
             {
-                // from the previous line
-                textOrig += wxT('\n');
-            }
+                if ( line > lineStart )
+                {
+                    // from the previous line
+                    textOrig += wxT('\n');
+                }
 
-            textOrig += linesOld[line];
+                textOrig += linesOld[line];
+            }
         }
 
         // we need to append the '\n' for the last line unless there is no
@@ -1074,10 +1094,7 @@ void wxTextCtrl::Replace(wxTextPos from, wxTextPos to, const wxString& text)
         textNew += text;
 
         // (2c) and append the end of the old text
-
-        // adjust for index shift: to is relative to colStart, not 0
-        size_t toRel = (size_t)((to - from) + colStart);
-        if ( toRel < textOrig.length() )
+        if ( toRel < lenOrig )
         {
             textNew += textOrig.c_str() + toRel;
         }
@@ -1296,6 +1313,9 @@ void wxTextCtrl::WriteText(const wxString& text)
 
 void wxTextCtrl::AppendText(const wxString& text)
 {
+    if ( DoCoalesceAppend(text) )
+        return;
+
     SetInsertionPointEnd();
     WriteText(text);
 }
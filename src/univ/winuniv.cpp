@@ -437,6 +437,11 @@ void wxWindow::DoDraw(wxControlRenderer * WXUNUSED(renderer))
 
 void wxWindow::Refresh(bool eraseBackground, const wxRect *rect)
 {
+#if wxUSE_TIMER
+    if ( QueueThrottledRefresh(eraseBackground, rect) )
+        return;
+#endif // wxUSE_TIMER
+
     wxRect rectClient; // the same rectangle in client coordinates
     wxPoint origin = GetClientAreaOrigin();
 
@@ -32,6 +32,7 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <unistd.h>
+#include <fcntl.h>              // for AT_SYMLINK_NOFOLLOW
 
 #include <dirent.h>
 
@@ -59,6 +60,7 @@ public:
 
     void Rewind() { rewinddir(m_dir); }
     bool Read(wxString *filename);
+    size_t ReadEntries(wxDirEntries *entries);
 
     const wxString& GetName() const { return m_dirname; }
 
@@ -183,6 +185,78 @@ bool wxDirData::Read(wxString *filename)
     return true;
 }
 
+size_t wxDirData::ReadEntries(wxDirEntries *entries)
+{
+    const int fdDir = dirfd(m_dir);
+
+    size_t count = 0;
+    for ( ;; )
+    {
+        dirent *de = readdir(m_dir);
+        if ( !de )
+            break;
+
+        // don't return "." and ".." unless asked for
+        const bool isDot = de->d_name[0] == '.' &&
+             ((de->d_name[1] == '.' && de->d_name[2] == '\0') ||
+              (de->d_name[1] == '\0'));
+        if ( isDot && !(m_flags & wxDIR_DOTDOT) )
+            continue;
+
+#if wxUSE_UNICODE
+        const wxString de_d_name(de->d_name, *wxConvFileName);
+#else
+        const wxString de_d_name(de->d_name);
+#endif
+
+        // get the metadata while we're here anyhow: using fstatat() with the
+        // directory fd avoids traversing the path for every entry
+        wxStructStat st;
+        const bool hasStat = fstatat
+                             (
+                                fdDir,
+                                de->d_name,
+                                &st,
+                                m_flags & wxDIR_NO_FOLLOW ? AT_SYMLINK_NOFOLLOW
+                                                          : 0
+                             ) == 0;
+        const bool isDir = hasStat && S_ISDIR(st.st_mode);
+
+        if ( !isDot )
+        {
+            // apply the same type and name filters as Read() does
+            if ( isDir ? !(m_flags & wxDIR_DIRS) : !(m_flags & wxDIR_FILES) )
+                continue;
+
+            if ( m_filespec.empty() )
+            {
+                if ( !(m_flags & wxDIR_HIDDEN) && de->d_name[0] == '.' )
+                    continue;
+            }
+            else if ( !wxMatchWild(m_filespec, de_d_name,
+                                   !(m_flags & wxDIR_HIDDEN)) )
+            {
+                continue;
+            }
+        }
+
+        wxDirEntry entry;
+        entry.name = de_d_name;
+        entry.isDir = isDir;
+        if ( hasStat )
+        {
+            if ( !isDir )
+                entry.size = st.st_size;
+            entry.mtime = st.st_mtime;
+        }
+
+        entries->push_back(entry);
+        count++;
+    }
+
+    return count;
+}
+
 #else // old VMS (TODO)
 
 wxDirData::wxDirData(const wxString& WXUNUSED(dirname))
@@ -199,6 +273,11 @@ bool wxDirData::Read(wxString * WXUNUSED(filename))
     return false;
 }
 
+size_t wxDirData::ReadEntries(wxDirEntries * WXUNUSED(entries))
+{
+    return 0;
+}
+
 #endif // not or new VMS/old VMS
 
 // ----------------------------------------------------------------------------
@@ -333,3 +412,20 @@ bool wxDir::HasSubDirs(const wxString& spec) const
     return GetFirst(&s, spec, wxDIR_DIRS | wxDIR_HIDDEN);
 }
 
+size_t wxDir::GetEntries(wxDirEntries *entries,
+                         const wxString& filespec,
+                         int flags) const
+{
+    wxCHECK_MSG( IsOpened(), (size_t)-1, wxT("must wxDir::Open() first") );
+
+    wxCHECK_MSG( entries, (size_t)-1,
+                 wxT("bad pointer in wxDir::GetEntries()") );
+
+    M_DIR->Rewind();
+
+    M_DIR->SetFileSpec(filespec);
+    M_DIR->SetFlags(flags);
+
+    return M_DIR->ReadEntries(entries);
+}
+
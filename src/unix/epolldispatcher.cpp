@@ -68,6 +68,13 @@ static uint32_t GetEpollMask(int flags, int fd)
                    wxT("Registered fd %d for exceptional events"), fd);
     }
 
+    if ( flags & wxFDIO_EDGE_TRIGGERED )
+    {
+        ep |= EPOLLET;
+        wxLogTrace(wxEpollDispatcher_Trace,
+                   wxT("Registered fd %d as edge-triggered"), fd);
+    }
+
     return ep;
 }
 
@@ -204,7 +211,10 @@ bool wxEpollDispatcher::HasPending() const
 
 int wxEpollDispatcher::Dispatch(int timeout)
 {
-    epoll_event events[16];
+    // deliver the events in reasonably large batches: with many active
+    // connections this reduces the number of epoll_wait() calls per handled
+    // event considerably
+    epoll_event events[64];
 
     const int rc = DoPoll(events, WXSIZEOF(events), timeout);
 
@@ -241,6 +251,8 @@ int wxEpollDispatcher::Dispatch(int timeout)
         numEvents++;
     }
 
+    UpdateStats(numEvents);
+
     return numEvents;
 }
 
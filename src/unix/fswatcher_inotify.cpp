@@ -42,7 +42,9 @@ public:
     wxFSWatcherImplUnix(wxFileSystemWatcherBase* watcher) :
         wxFSWatcherImpl(watcher),
         m_source(NULL),
-        m_ifd(-1)
+        m_ifd(-1),
+        m_pendingFlags(0),
+        m_pendingCount(0)
     {
         m_handler = new wxFSWSourceHandler(this);
     }
@@ -172,7 +174,9 @@ public:
 
         // read events
         // TODO differentiate depending on params
-        char buf[128 * sizeof(inotify_event)];
+        // the buffer is large enough to drain a busy queue in a few reads:
+        // a build touching many files can easily produce thousands of events
+        char buf[64 * 1024];
         int left = ReadEventsToBuf(buf, sizeof(buf));
         if (left == -1)
             return -1;
@@ -196,6 +200,9 @@ public:
         // take care of unmatched renames
         ProcessRenames();
 
+        // deliver whatever is still being coalesced
+        FlushCoalescedEvent();
+
         wxLogTrace(wxTRACE_FSWATCHER, "We had %d native events", event_count);
         return event_count;
     }
@@ -488,8 +495,10 @@ protected:
             // For files, check that it matches any filespec
             if ( MatchesFilespec(path, watch.GetFilespec()) )
             {
-                wxFileSystemWatcherEvent event(flags, path, path);
-                SendEvent(event);
+                // these events often arrive in bursts of identical entries
+                // (e.g. one IN_MODIFY per write() to the same file), so
+                // coalesce them instead of flooding the event loop
+                SendCoalescableEvent(flags, path);
             }
         }
     }
@@ -536,9 +545,48 @@ protected:
     }
 
     void SendEvent(wxFileSystemWatcherEvent& evt)
+    {
+        // deliver any coalesced event first to preserve the event order
+        FlushCoalescedEvent();
+        DoSendEvent(evt);
+    }
+
+    // Accumulate consecutive identical events into a single one carrying a
+    // change count; anything else sent in between flushes the pending event.
+    void SendCoalescableEvent(int flags, const wxFileName& path)
+    {
+        if ( m_pendingCount &&
+                flags == m_pendingFlags &&
+                    path.GetFullPath() == m_pendingPath.GetFullPath() )
+        {
+            m_pendingCount++;
+            return;
+        }
+
+        FlushCoalescedEvent();
+
+        m_pendingFlags = flags;
+        m_pendingPath = path;
+        m_pendingCount = 1;
+    }
+
+    void FlushCoalescedEvent()
+    {
+        if ( !m_pendingCount )
+            return;
+
+        wxFileSystemWatcherEvent event(m_pendingFlags,
+                                       m_pendingPath, m_pendingPath);
+        event.SetChangeCount(m_pendingCount);
+        m_pendingCount = 0;
+
+        DoSendEvent(event);
+    }
+
+    void DoSendEvent(wxFileSystemWatcherEvent& evt)
     {
         wxLogTrace(wxTRACE_FSWATCHER, evt.ToString());
-        m_watcher->GetOwner()->ProcessEvent(evt);
+        m_watcher->DeliverEvent(evt);
     }
 
     int ReadEventsToBuf(char* buf, int size)
@@ -659,6 +707,11 @@ protected:
 
     // file descriptor created by inotify_init()
     int m_ifd;
+
+    // the event currently being coalesced, valid when m_pendingCount > 0
+    int m_pendingFlags;
+    wxFileName m_pendingPath;
+    int m_pendingCount;
 };
 
 
@@ -0,0 +1,275 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/unix/kqueuedispatcher.cpp
+// Purpose:     implements dispatcher for kevent() call
+// Created:     2022-04-18
+// Copyright:   (c) 2022 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+#if wxUSE_KQUEUE_DISPATCHER
+
+#include "wx/unix/private/kqueuedispatcher.h"
+#include "wx/stopwatch.h"
+
+#ifndef WX_PRECOMP
+    #include "wx/log.h"
+    #include "wx/intl.h"
+#endif
+
+#include <sys/types.h>
+#include <sys/event.h>
+#include <sys/time.h>
+#include <errno.h>
+#include <unistd.h>
+
+#define wxKqueueDispatcher_Trace wxT("kqueuedispatcher")
+
+// ============================================================================
+// implementation
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// wxKqueueDispatcher
+// ----------------------------------------------------------------------------
+
+/* static */
+wxKqueueDispatcher *wxKqueueDispatcher::Create()
+{
+    int kqueueDescriptor = kqueue();
+    if ( kqueueDescriptor == -1 )
+    {
+        wxLogSysError(_("Failed to create kqueue descriptor"));
+        return NULL;
+    }
+    wxLogTrace(wxKqueueDispatcher_Trace,
+               wxT("Kqueue fd %d created"), kqueueDescriptor);
+    return new wxKqueueDispatcher(kqueueDescriptor);
+}
+
+wxKqueueDispatcher::wxKqueueDispatcher(int kqueueDescriptor)
+{
+    wxASSERT_MSG( kqueueDescriptor != -1, wxT("invalid descriptor") );
+
+    m_kqueueDescriptor = kqueueDescriptor;
+}
+
+wxKqueueDispatcher::~wxKqueueDispatcher()
+{
+    if ( close(m_kqueueDescriptor) != 0 )
+    {
+        wxLogSysError(_("Error closing kqueue descriptor"));
+    }
+}
+
+bool
+wxKqueueDispatcher::DoUpdateFilters(int fd,
+                                    wxFDIOHandler* WXUNUSED(handler),
+                                    int flags,
+                                    int oldFlags)
+{
+    // kqueue doesn't have any counterpart of wxFDIO_EXCEPTION: errors are
+    // reported via EV_ERROR/EV_EOF on the read and write filters themselves,
+    // so only the input and output flags matter here
+    const unsigned short evflagsAdd =
+        EV_ADD | ((flags & wxFDIO_EDGE_TRIGGERED) ? EV_CLEAR : 0);
+
+    struct kevent changes[2];
+    int numChanges = 0;
+
+    if ( flags & wxFDIO_INPUT )
+    {
+        EV_SET(&changes[numChanges++], fd, EVFILT_READ, evflagsAdd, 0, 0, 0);
+    }
+    else if ( oldFlags & wxFDIO_INPUT )
+    {
+        EV_SET(&changes[numChanges++], fd, EVFILT_READ, EV_DELETE, 0, 0, 0);
+    }
+
+    if ( flags & wxFDIO_OUTPUT )
+    {
+        EV_SET(&changes[numChanges++], fd, EVFILT_WRITE, evflagsAdd, 0, 0, 0);
+    }
+    else if ( oldFlags & wxFDIO_OUTPUT )
+    {
+        EV_SET(&changes[numChanges++], fd, EVFILT_WRITE, EV_DELETE, 0, 0, 0);
+    }
+
+    if ( !numChanges )
+        return true;
+
+    if ( kevent(m_kqueueDescriptor, changes, numChanges, NULL, 0, NULL) != 0 )
+    {
+        wxLogSysError(_("Failed to update descriptor %d in kqueue descriptor %d"),
+                      fd, m_kqueueDescriptor);
+
+        return false;
+    }
+
+    return true;
+}
+
+bool wxKqueueDispatcher::RegisterFD(int fd, wxFDIOHandler* handler, int flags)
+{
+    if ( !wxMappedFDIODispatcher::RegisterFD(fd, handler, flags) )
+        return false;
+
+    if ( !DoUpdateFilters(fd, handler, flags, 0) )
+        return false;
+
+    wxLogTrace(wxKqueueDispatcher_Trace,
+               wxT("Added fd %d (handler %p) to kqueue %d"),
+               fd, handler, m_kqueueDescriptor);
+
+    return true;
+}
+
+bool wxKqueueDispatcher::ModifyFD(int fd, wxFDIOHandler* handler, int flags)
+{
+    // we need the currently registered flags to remove the filters which are
+    // not wanted any more
+    int oldFlags = 0;
+    const wxFDIOHandlerMap::const_iterator it = m_handlers.find(fd);
+    if ( it != m_handlers.end() )
+        oldFlags = it->second.flags;
+
+    if ( !wxMappedFDIODispatcher::ModifyFD(fd, handler, flags) )
+        return false;
+
+    if ( !DoUpdateFilters(fd, handler, flags, oldFlags) )
+        return false;
+
+    wxLogTrace(wxKqueueDispatcher_Trace,
+               wxT("Modified fd %d (handler: %p) on kqueue %d"),
+               fd, handler, m_kqueueDescriptor);
+
+    return true;
+}
+
+bool wxKqueueDispatcher::UnregisterFD(int fd)
+{
+    int oldFlags = 0;
+    const wxFDIOHandlerMap::const_iterator it = m_handlers.find(fd);
+    if ( it != m_handlers.end() )
+        oldFlags = it->second.flags;
+
+    if ( !wxMappedFDIODispatcher::UnregisterFD(fd) )
+        return false;
+
+    // this removes all the filters registered for this fd
+    DoUpdateFilters(fd, NULL, 0, oldFlags);
+
+    wxLogTrace(wxKqueueDispatcher_Trace,
+               wxT("removed fd %d from %d"), fd, m_kqueueDescriptor);
+
+    return true;
+}
+
+int
+wxKqueueDispatcher::DoPoll(struct kevent *events,
+                           int numEvents,
+                           int timeout) const
+{
+    struct timespec ts,
+                   *pts;
+    if ( timeout != TIMEOUT_INFINITE )
+    {
+        pts = &ts;
+        ts.tv_sec = timeout / 1000;
+        ts.tv_nsec = (timeout % 1000)*1000000;
+    }
+    else // no timeout
+    {
+        pts = NULL;
+    }
+
+    wxMilliClock_t timeEnd;
+    if ( timeout > 0 )
+        timeEnd = wxGetLocalTimeMillis();
+
+    int rc;
+    for ( ;; )
+    {
+        rc = kevent(m_kqueueDescriptor, NULL, 0, events, numEvents, pts);
+        if ( rc != -1 || errno != EINTR )
+            break;
+
+        // we got interrupted, update the timeout and restart
+        if ( timeout > 0 )
+        {
+            timeout = wxMilliClockToLong(timeEnd - wxGetLocalTimeMillis());
+            if ( timeout < 0 )
+                return 0;
+
+            ts.tv_sec = timeout / 1000;
+            ts.tv_nsec = (timeout % 1000)*1000000;
+        }
+    }
+
+    return rc;
+}
+
+bool wxKqueueDispatcher::HasPending() const
+{
+    struct kevent event;
+
+    return DoPoll(&event, 1, 0) >= 1;
+}
+
+int wxKqueueDispatcher::Dispatch(int timeout)
+{
+    // as in wxEpollDispatcher, deliver the events in large batches to reduce
+    // the number of system calls per handled event
+    struct kevent events[64];
+
+    const int rc = DoPoll(events, WXSIZEOF(events), timeout);
+
+    if ( rc == -1 )
+    {
+        wxLogSysError(_("Waiting for IO on kqueue descriptor %d failed"),
+                      m_kqueueDescriptor);
+        return -1;
+    }
+
+    int numEvents = 0;
+    for ( struct kevent *p = events; p < events + rc; p++ )
+    {
+        // look the handler up instead of using the kevent udata field: the
+        // handler might have been unregistered by one of the callbacks run
+        // from this very loop and must not be used any more in this case
+        wxFDIOHandler * const handler = FindHandler(p->ident);
+        if ( !handler )
+            continue;
+
+        // read and write readiness is reported as separate kevents, so unlike
+        // in the other dispatchers there is at most one callback to invoke
+        // here; EV_EOF is handled by the read callback which will see the
+        // closed connection when reading, as with select()
+        if ( p->flags & EV_ERROR )
+            handler->OnExceptionWaiting();
+        else if ( p->filter == EVFILT_READ )
+            handler->OnReadWaiting();
+        else if ( p->filter == EVFILT_WRITE )
+            handler->OnWriteWaiting();
+        else
+            continue;
+
+        numEvents++;
+    }
+
+    UpdateStats(numEvents);
+
+    return numEvents;
+}
+
+#endif // wxUSE_KQUEUE_DISPATCHER
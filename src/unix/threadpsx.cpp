@@ -61,9 +61,12 @@
     #include <sys/resource.h>   // for setpriority()
 #endif
 
-// we use wxFFile under Linux in GetCPUCount()
+// we use wxFFile under Linux in GetCPUCount() and for reading the CPU
+// topology information from sysfs in wxCpuTopology
 #ifdef __LINUX__
     #include "wx/ffile.h"
+    #include "wx/filefn.h"
+    #include "wx/tokenzr.h"
 #endif
 
 // We don't provide wxAtomicLong and it doesn't seem really useful to add it
@@ -1352,6 +1355,151 @@ bool wxThread::SetConcurrency(size_t level)
     return true;
 }
 
+// -----------------------------------------------------------------------------
+// wxCpuTopology
+// -----------------------------------------------------------------------------
+
+#if defined(__LINUX__) && wxUSE_FFILE
+
+// Read a sysfs CPU list file, e.g. "0-3,8,10-11", into the given array.
+static bool wxReadSysFsCpuList(const wxString& path, wxArrayInt& cpus)
+{
+    cpus.Empty();
+
+    wxLogNull nolog;
+
+    wxFFile file(path);
+    wxString s;
+    if ( !file.IsOpened() || !file.ReadAll(&s) )
+        return false;
+
+    wxStringTokenizer tk(s.Trim(), wxT(","));
+    while ( tk.HasMoreTokens() )
+    {
+        const wxString token = tk.GetNextToken();
+
+        long first,
+             last;
+        const size_t posDash = token.find(wxT('-'));
+        if ( posDash == wxString::npos )
+        {
+            if ( !token.ToLong(&first) )
+                return false;
+
+            last = first;
+        }
+        else // a "first-last" range
+        {
+            if ( !token.Left(posDash).ToLong(&first) ||
+                 !token.Mid(posDash + 1).ToLong(&last) )
+                return false;
+        }
+
+        for ( long n = first; n <= last; n++ )
+            cpus.Add((int)n);
+    }
+
+    return !cpus.IsEmpty();
+}
+
+#endif // __LINUX__ && wxUSE_FFILE
+
+int wxCpuTopology::GetLogicalCpuCount()
+{
+    const int count = wxThread::GetCPUCount();
+
+    return count > 0 ? count : 1;
+}
+
+int wxCpuTopology::GetCoreCount()
+{
+#if defined(__LINUX__) && wxUSE_FFILE
+    const int cpuCount = GetLogicalCpuCount();
+
+    int cores = 0;
+    for ( int cpu = 0; cpu < cpuCount; cpu++ )
+    {
+        wxArrayInt siblings;
+        if ( !wxReadSysFsCpuList(
+                wxString::Format(
+                    wxT("/sys/devices/system/cpu/cpu%d/topology/thread_siblings_list"),
+                    cpu),
+                siblings) )
+        {
+            // topology information is incomplete, don't trust it at all
+            cores = 0;
+            break;
+        }
+
+        // count each physical core once by attributing it to its first
+        // (lowest numbered) logical CPU
+        if ( siblings[0] == cpu )
+            cores++;
+    }
+
+    if ( cores > 0 )
+        return cores;
+#endif // __LINUX__ && wxUSE_FFILE
+
+    return GetLogicalCpuCount();
+}
+
+wxArrayInt wxCpuTopology::GetSmtSiblings(int cpu)
+{
+    wxArrayInt siblings;
+
+#if defined(__LINUX__) && wxUSE_FFILE
+    wxReadSysFsCpuList(
+        wxString::Format(
+            wxT("/sys/devices/system/cpu/cpu%d/topology/thread_siblings_list"),
+            cpu),
+        siblings);
+#endif // __LINUX__ && wxUSE_FFILE
+
+    if ( siblings.IsEmpty() )
+    {
+        // a CPU is always its own sibling
+        siblings.Add(cpu);
+    }
+
+    return siblings;
+}
+
+int wxCpuTopology::GetNumaNodeCount()
+{
+#if defined(__LINUX__) && wxUSE_FFILE
+    wxArrayInt nodes;
+    if ( wxReadSysFsCpuList(wxT("/sys/devices/system/node/online"), nodes) )
+        return (int)nodes.size();
+#endif // __LINUX__ && wxUSE_FFILE
+
+    return 1;
+}
+
+int wxCpuTopology::GetCpuNumaNode(int cpu)
+{
+#if defined(__LINUX__) && wxUSE_FFILE
+    wxArrayInt nodes;
+    if ( wxReadSysFsCpuList(wxT("/sys/devices/system/node/online"), nodes) )
+    {
+        const size_t count = nodes.size();
+        for ( size_t n = 0; n < count; n++ )
+        {
+            // each node directory contains symlinks to the CPUs belonging to
+            // this node
+            if ( wxDirExists(wxString::Format(
+                    wxT("/sys/devices/system/node/node%d/cpu%d"),
+                    nodes[n], cpu)) )
+                return nodes[n];
+        }
+    }
+#else // !Linux
+    wxUnusedVar(cpu);
+#endif // Linux/!Linux
+
+    return 0;
+}
+
 // -----------------------------------------------------------------------------
 // creating thread
 // -----------------------------------------------------------------------------
@@ -1489,6 +1637,49 @@ unsigned int wxThread::GetPriority() const
     return m_internal->GetPriority();
 }
 
+bool wxThread::SetAffinity(const wxArrayInt& cpus)
+{
+    wxCHECK_MSG( !cpus.empty(), false,
+                 wxT("affinity CPU set must not be empty") );
+
+    // CPU_SETSIZE is only defined by glibc sched.h when the GNU extensions,
+    // including pthread_setaffinity_np(), are available.
+#if defined(__LINUX__) && defined(CPU_SETSIZE)
+    wxCriticalSectionLocker lock(m_critsect);
+
+    wxCHECK_MSG( m_internal->GetState() != STATE_NEW &&
+                 m_internal->GetState() != STATE_EXITED,
+                 false,
+                 wxT("thread must be created first") );
+
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+
+    const size_t count = cpus.size();
+    for ( size_t n = 0; n < count; n++ )
+    {
+        const int cpu = cpus[n];
+        wxCHECK_MSG( cpu >= 0 && cpu < CPU_SETSIZE, false,
+                     wxT("invalid CPU index") );
+
+        CPU_SET(cpu, &cpuset);
+    }
+
+    const int rc = pthread_setaffinity_np(m_internal->GetId(),
+                                          sizeof(cpuset), &cpuset);
+    if ( rc != 0 )
+    {
+        wxLogSysError(rc, _("Failed to set thread affinity."));
+        return false;
+    }
+
+    return true;
+#else // !Linux
+    // binding threads to CPUs is not implemented for this platform
+    return false;
+#endif // Linux/!Linux
+}
+
 wxThreadIdType wxThread::GetId() const
 {
     return (wxThreadIdType) m_internal->GetId();
@@ -38,9 +38,6 @@
 
 #include "wx/unix/private/timer.h"
 
-#include "wx/listimpl.cpp"
-WX_DEFINE_LIST(wxTimerList)
-
 // trace mask for the debugging messages used here
 #define wxTrace_Timer wxT("timer")
 
@@ -52,7 +49,7 @@ wxTimerScheduler *wxTimerScheduler::ms_instance = NULL;
 
 wxTimerScheduler::~wxTimerScheduler()
 {
-    for ( wxTimerList::iterator node = m_timers.begin();
+    for ( wxVector<wxTimerSchedule *>::iterator node = m_timers.begin();
           node != m_timers.end();
           ++node )
     {
@@ -62,23 +59,22 @@ wxTimerScheduler::~wxTimerScheduler()
 
 void wxTimerScheduler::AddTimer(wxUnixTimerImpl *timer, wxUsecClock_t expiration)
 {
-    DoAddTimer(new wxTimerSchedule(timer, expiration));
+    wxASSERT_MSG( !timer->GetSchedule(),
+                  wxT("adding the same timer twice?") );
+
+    wxTimerSchedule * const s = new wxTimerSchedule(timer, expiration);
+    timer->SetSchedule(s);
+
+    DoAddTimer(s);
 }
 
 void wxTimerScheduler::DoAddTimer(wxTimerSchedule *s)
 {
-    // do an insertion sort to keep the list sorted in expiration order
-    wxTimerList::iterator node;
-    for ( node = m_timers.begin(); node != m_timers.end(); ++node )
-    {
-        wxASSERT_MSG( (*node)->m_timer != s->m_timer,
-                      wxT("adding the same timer twice?") );
-
-        if ( (*node)->m_expiration > s->m_expiration )
-            break;
-    }
-
-    m_timers.insert(node, s);
+    // put the new entry at the end of the heap and let it bubble up to its
+    // place
+    s->m_heapIndex = m_timers.size();
+    m_timers.push_back(s);
+    SiftUp(s->m_heapIndex);
 
     wxLogTrace(wxTrace_Timer, wxT("Inserted timer %d expiring at %s"),
                s->m_timer->GetId(),
@@ -89,19 +85,84 @@ void wxTimerScheduler::RemoveTimer(wxUnixTimerImpl *timer)
 {
     wxLogTrace(wxTrace_Timer, wxT("Removing timer %d"), timer->GetId());
 
-    for ( wxTimerList::iterator node = m_timers.begin();
-          node != m_timers.end();
-          ++node )
+    wxTimerSchedule * const s = timer->GetSchedule();
+    wxCHECK_RET( s, wxT("removing inexistent timer?") );
+
+    DoRemoveAt(s->m_heapIndex);
+    timer->SetSchedule(NULL);
+    delete s;
+}
+
+wxTimerSchedule *wxTimerScheduler::DoRemoveAt(size_t index)
+{
+    wxTimerSchedule * const s = m_timers[index];
+
+    const size_t last = m_timers.size() - 1;
+    if ( index != last )
     {
-        if ( (*node)->m_timer == timer )
-        {
-            delete *node;
-            m_timers.erase(node);
-            return;
-        }
+        // replace the removed entry with the last one and move the latter
+        // to its correct place, which can be in either direction
+        Swap(index, last);
+        m_timers.pop_back();
+
+        SiftDown(index);
+        SiftUp(index);
+    }
+    else // removing the last entry, nothing to fix up
+    {
+        m_timers.pop_back();
+    }
+
+    return s;
+}
+
+void wxTimerScheduler::Swap(size_t index1, size_t index2)
+{
+    wxTimerSchedule * const s = m_timers[index1];
+    m_timers[index1] = m_timers[index2];
+    m_timers[index2] = s;
+
+    m_timers[index1]->m_heapIndex = index1;
+    m_timers[index2]->m_heapIndex = index2;
+}
+
+void wxTimerScheduler::SiftUp(size_t index)
+{
+    while ( index )
+    {
+        const size_t parent = (index - 1)/2;
+        if ( m_timers[parent]->m_expiration <= m_timers[index]->m_expiration )
+            break;
+
+        Swap(parent, index);
+        index = parent;
     }
+}
 
-    wxFAIL_MSG( wxT("removing inexistent timer?") );
+void wxTimerScheduler::SiftDown(size_t index)
+{
+    const size_t size = m_timers.size();
+    for ( ;; )
+    {
+        size_t smallest = index;
+
+        const size_t left = 2*index + 1,
+                     right = left + 1;
+        if ( left < size &&
+                m_timers[left]->m_expiration <
+                    m_timers[smallest]->m_expiration )
+            smallest = left;
+        if ( right < size &&
+                m_timers[right]->m_expiration <
+                    m_timers[smallest]->m_expiration )
+            smallest = right;
+
+        if ( smallest == index )
+            break;
+
+        Swap(smallest, index);
+        index = smallest;
+    }
 }
 
 bool wxTimerScheduler::GetNext(wxUsecClock_t *remaining) const
@@ -130,32 +191,24 @@ bool wxTimerScheduler::NotifyExpired()
 
     typedef wxVector<wxUnixTimerImpl *> TimerImpls;
     TimerImpls toNotify;
-    for ( wxTimerList::iterator next,
-            cur = m_timers.begin(); cur != m_timers.end(); cur = next )
-    {
-        wxTimerSchedule * const s = *cur;
-        if ( s->m_expiration > now )
-        {
-            // as the list is sorted by expiration time, we can skip the rest
-            break;
-        }
 
-        // remember next as we will delete the node pointed to by cur
-        next = cur;
-        ++next;
-
-        m_timers.erase(cur);
+    // all the due timers are extracted by repeatedly removing the heap root,
+    // so a single tick dispatches all of them without rescanning the rest
+    while ( !m_timers.empty() && m_timers[0]->m_expiration <= now )
+    {
+        wxTimerSchedule * const s = DoRemoveAt(0);
 
         // check whether we need to keep this timer
         wxUnixTimerImpl * const timer = s->m_timer;
         if ( timer->IsOneShot() )
         {
             // the timer needs to be stopped but don't call its Stop() from
-            // here as it would attempt to remove the timer from our list and
+            // here as it would attempt to remove the timer from our heap and
             // we had already done it, so we just need to reset its state
             timer->MarkStopped();
 
             // don't need it any more
+            timer->SetSchedule(NULL);
             delete s;
         }
         else // reschedule the next timer expiration
@@ -170,8 +223,7 @@ bool wxTimerScheduler::NotifyExpired()
 
         // we can't notify the timer from this loop as the timer event handler
         // could modify m_timers (for example, but not only, by stopping this
-        // timer) which would render our iterators invalid, so do it after the
-        // loop end
+        // timer), so do it after the loop end
         toNotify.push_back(timer);
     }
 
@@ -197,6 +249,7 @@ wxUnixTimerImpl::wxUnixTimerImpl(wxTimer* timer)
                : wxTimerImpl(timer)
 {
     m_isRunning = false;
+    m_schedule = NULL;
 }
 
 bool wxUnixTimerImpl::Start(int milliseconds, bool oneShot)
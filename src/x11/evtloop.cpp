@@ -255,7 +255,7 @@ void wxGUIEventLoop::DoYieldFor(long eventsToProcess)
         wxTheApp->Dispatch();
 
         // TODO: implement event filtering using the eventsToProcess mask
-        while (wxTheApp && wxTheApp->Pending())
+        while (wxTheApp && wxTheApp->Pending() && !YieldDeadlineExpired())
             wxTheApp->Dispatch();
 
 #if wxUSE_TIMER
@@ -1191,6 +1191,11 @@ void wxWindowX11::DoGetTextExtent(const wxString& string,
 
 void wxWindowX11::Refresh(bool eraseBack, const wxRect *rect)
 {
+#if wxUSE_TIMER
+    if ( QueueThrottledRefresh(eraseBack, rect) )
+        return;
+#endif // wxUSE_TIMER
+
     if (eraseBack)
     {
         if (rect)
@@ -26,10 +26,22 @@
 #include "wx/zstream.h"
 #include "wx/strconv.h"
 #include "wx/scopedptr.h"
+#include "wx/hashmap.h"
+#include "wx/tls.h"
 #include "wx/versioninfo.h"
 
 #include "expat.h" // from Expat
 
+namespace
+{
+
+// Signature identifying documents in the binary format, see SaveBinary().
+// Notice that the terminating NUL is part of it: it can't occur in a
+// well-formed XML document, so even a truncated read can't be ambiguous.
+const char wxBinaryXmlSignature[] = "wxBinXML";
+
+} // anonymous namespace
+
 // DLL options compatibility check:
 WX_CHECK_BUILD_OPTIONS("wxXML")
 
@@ -41,6 +53,120 @@ wxIMPLEMENT_CLASS(wxXmlDocument, wxObject);
 static bool wxIsWhiteOnly(const wxString& buf);
 
 
+//-----------------------------------------------------------------------------
+//  Memory pool for wxXmlNode and wxXmlAttribute
+//-----------------------------------------------------------------------------
+
+// Loading a big document creates (and its destruction frees) millions of
+// nodes and attributes, so satisfy their allocations from per-thread free
+// lists of fixed-size blocks instead of hitting the heap for each of them.
+
+#if !wxUSE_MEMORY_TRACING
+
+namespace
+{
+
+// Maximal number of free blocks of each kind kept around for reuse.
+const size_t wxXML_POOL_MAX_FREE = 4096;
+
+// Free blocks are linked through their first pointer-sized word.
+struct wxXmlMemoryPool
+{
+    void *nodes;
+    size_t numNodes;
+    void *attrs;
+    size_t numAttrs;
+};
+
+wxTLS_TYPE_REF(wxXmlMemoryPool) GetXmlMemoryPoolVar()
+{
+    static wxTLS_TYPE(wxXmlMemoryPool) s_pool;
+    return s_pool;
+}
+
+#define wxXML_MEMORY_POOL wxTLS_VALUE(GetXmlMemoryPoolVar())
+
+void *wxXmlPoolAlloc(void *& head, size_t& count, size_t size)
+{
+    if ( head )
+    {
+        void * const ptr = head;
+        head = *static_cast<void**>(ptr);
+        count--;
+        return ptr;
+    }
+
+    return ::operator new(size);
+}
+
+void wxXmlPoolFree(void *& head, size_t& count, void *ptr)
+{
+    if ( count < wxXML_POOL_MAX_FREE )
+    {
+        *static_cast<void**>(ptr) = head;
+        head = ptr;
+        count++;
+    }
+    else
+    {
+        ::operator delete(ptr);
+    }
+}
+
+} // anonymous namespace
+
+void* wxXmlNode::operator new(size_t size)
+{
+    // allocations of derived classes don't go through the pool
+    if ( size != sizeof(wxXmlNode) )
+        return ::operator new(size);
+
+    wxXmlMemoryPool& pool = wxXML_MEMORY_POOL;
+    return wxXmlPoolAlloc(pool.nodes, pool.numNodes, size);
+}
+
+void wxXmlNode::operator delete(void* ptr, size_t size)
+{
+    if ( !ptr )
+        return;
+
+    if ( size != sizeof(wxXmlNode) )
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    wxXmlMemoryPool& pool = wxXML_MEMORY_POOL;
+    wxXmlPoolFree(pool.nodes, pool.numNodes, ptr);
+}
+
+void* wxXmlAttribute::operator new(size_t size)
+{
+    if ( size != sizeof(wxXmlAttribute) )
+        return ::operator new(size);
+
+    wxXmlMemoryPool& pool = wxXML_MEMORY_POOL;
+    return wxXmlPoolAlloc(pool.attrs, pool.numAttrs, size);
+}
+
+void wxXmlAttribute::operator delete(void* ptr, size_t size)
+{
+    if ( !ptr )
+        return;
+
+    if ( size != sizeof(wxXmlAttribute) )
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    wxXmlMemoryPool& pool = wxXML_MEMORY_POOL;
+    wxXmlPoolFree(pool.attrs, pool.numAttrs, ptr);
+}
+
+#endif // !wxUSE_MEMORY_TRACING
+
+
 //-----------------------------------------------------------------------------
 //  wxXmlNode
 //-----------------------------------------------------------------------------
@@ -144,36 +270,76 @@ void wxXmlNode::DoCopy(const wxXmlNode& node)
     }
 }
 
-bool wxXmlNode::HasAttribute(const wxString& attrName) const
+wxUint32 wxXmlAttribute::HashName(const wxString& name)
 {
-    wxXmlAttribute *attr = GetAttributes();
+    // Use the simple FNV-1a hash: it doesn't need to be especially strong as
+    // it is only used to quickly reject the names which can't match, a match
+    // is always confirmed by the full string comparison.
+    wxUint32 hash = 0x811c9dc5;
+    for ( wxString::const_iterator i = name.begin(); i != name.end(); ++i )
+    {
+        hash ^= static_cast<wxUint32>((*i).GetValue());
+        hash *= 0x01000193;
+    }
 
-    while (attr)
+    return hash;
+}
+
+// Common part of the attribute lookup functions below: find the attribute
+// with the given name, whose hash must be passed as well, in the linked list
+// starting at attr.
+static wxXmlAttribute *
+wxFindAttribute(wxXmlAttribute *attr, const wxString& name, wxUint32 nameHash)
+{
+    for ( ; attr; attr = attr->GetNext() )
     {
-        if (attr->GetName() == attrName) return true;
-        attr = attr->GetNext();
+        if ( attr->GetNameHash() == nameHash && attr->GetName() == name )
+            break;
     }
 
-    return false;
+    return attr;
+}
+
+bool wxXmlNode::HasAttribute(const wxString& attrName) const
+{
+    return wxFindAttribute(GetAttributes(), attrName,
+                           wxXmlAttribute::HashName(attrName)) != NULL;
+}
+
+bool wxXmlNode::HasAttribute(const wxXmlAttrName& attrName) const
+{
+    return wxFindAttribute(GetAttributes(), attrName.GetName(),
+                           attrName.GetHash()) != NULL;
 }
 
 bool wxXmlNode::GetAttribute(const wxString& attrName, wxString *value) const
 {
     wxCHECK_MSG( value, false, "value argument must not be NULL" );
 
-    wxXmlAttribute *attr = GetAttributes();
+    const wxXmlAttribute * const
+        attr = wxFindAttribute(GetAttributes(), attrName,
+                               wxXmlAttribute::HashName(attrName));
+    if ( !attr )
+        return false;
 
-    while (attr)
-    {
-        if (attr->GetName() == attrName)
-        {
-            *value = attr->GetValue();
-            return true;
-        }
-        attr = attr->GetNext();
-    }
+    *value = attr->GetValue();
 
-    return false;
+    return true;
+}
+
+bool wxXmlNode::GetAttribute(const wxXmlAttrName& attrName, wxString *value) const
+{
+    wxCHECK_MSG( value, false, "value argument must not be NULL" );
+
+    const wxXmlAttribute * const
+        attr = wxFindAttribute(GetAttributes(), attrName.GetName(),
+                               attrName.GetHash());
+    if ( !attr )
+        return false;
+
+    *value = attr->GetValue();
+
+    return true;
 }
 
 wxString wxXmlNode::GetAttribute(const wxString& attrName, const wxString& defaultVal) const
@@ -185,6 +351,15 @@ wxString wxXmlNode::GetAttribute(const wxString& attrName, const wxString& defau
     return defaultVal;
 }
 
+wxString wxXmlNode::GetAttribute(const wxXmlAttrName& attrName, const wxString& defaultVal) const
+{
+    wxString tmp;
+    if (GetAttribute(attrName, &tmp))
+        return tmp;
+
+    return defaultVal;
+}
+
 void wxXmlNode::AddChild(wxXmlNode *child)
 {
     if (m_children == NULL)
@@ -885,6 +1060,15 @@ bool wxXmlDocument::Load(wxInputStream& stream, const wxString& encoding, int fl
     m_encoding = encoding;
 #endif
 
+    // Check for the binary format signature first, so that the callers
+    // don't need to know in which of the two formats a document was saved.
+    char sig[WXSIZEOF(wxBinaryXmlSignature)];
+    size_t sigLen = stream.Read(sig, sizeof(sig)).LastRead();
+    if ( sigLen == sizeof(sig) &&
+            memcmp(sig, wxBinaryXmlSignature, sizeof(sig)) == 0 )
+        return DoLoadBinary(stream);
+    stream.Ungetch(sig, sigLen);
+
     const size_t BUFSIZE = 1024;
     char buf[BUFSIZE];
     wxXmlParsingContext ctx;
@@ -955,6 +1139,383 @@ bool wxXmlDocument::Load(wxInputStream& stream, const wxString& encoding, int fl
 
 
 
+//-----------------------------------------------------------------------------
+//  wxXmlSaxParser
+//-----------------------------------------------------------------------------
+
+wxString wxXmlSaxAttributes::GetValueByName(const wxString& name) const
+{
+    const size_t count = GetCount();
+    for ( size_t n = 0; n < count; n++ )
+    {
+        if ( GetName(n) == name )
+            return GetValue(n);
+    }
+
+    return wxString();
+}
+
+// The counterpart of wxXmlParsingContext for streaming parsing: it doesn't
+// accumulate anything but the current run of character data.
+struct wxXmlSaxContext
+{
+    wxXmlSaxContext()
+    {
+        parser = NULL;
+        conv = NULL;
+    }
+
+    // Deliver any pending character data before an element boundary.
+    void FlushText()
+    {
+        if ( !text.empty() )
+        {
+            parser->OnText(text);
+            text.clear();
+        }
+    }
+
+    wxXmlSaxParser *parser;
+    wxMBConv *conv;
+    wxXmlSaxAttributes attrs;
+    wxString text;
+};
+
+extern "C" {
+
+static void SaxStartElementHnd(void *userData, const char *name, const char **atts)
+{
+    wxXmlSaxContext *ctx = (wxXmlSaxContext*)userData;
+
+    if ( ctx->parser->IsStopped() )
+        return;
+
+    ctx->FlushText();
+
+    ctx->attrs.Clear();
+    for ( const char **a = atts; *a; a += 2 )
+        ctx->attrs.Add(CharToString(ctx->conv, a[0]),
+                       CharToString(ctx->conv, a[1]));
+
+    ctx->parser->OnStartElement(CharToString(ctx->conv, name), ctx->attrs);
+}
+
+static void SaxEndElementHnd(void *userData, const char *name)
+{
+    wxXmlSaxContext *ctx = (wxXmlSaxContext*)userData;
+
+    if ( ctx->parser->IsStopped() )
+        return;
+
+    ctx->FlushText();
+
+    ctx->parser->OnEndElement(CharToString(ctx->conv, name));
+}
+
+static void SaxTextHnd(void *userData, const char *s, int len)
+{
+    wxXmlSaxContext *ctx = (wxXmlSaxContext*)userData;
+
+    if ( ctx->parser->IsStopped() )
+        return;
+
+    ctx->text += CharToString(ctx->conv, s, len);
+}
+
+} // extern "C"
+
+bool wxXmlSaxParser::ParseFile(const wxString& filename,
+                               const wxString& encoding)
+{
+    wxFileInputStream stream(filename);
+    if (!stream.IsOk())
+        return false;
+    return Parse(stream, encoding);
+}
+
+bool wxXmlSaxParser::Parse(wxInputStream& stream, const wxString& encoding)
+{
+    m_error.clear();
+    m_stopped = false;
+
+    const size_t BUFSIZE = 16384;
+    char buf[BUFSIZE];
+    wxXmlSaxContext ctx;
+    XML_Parser parser = XML_ParserCreate(NULL);
+
+    ctx.parser = this;
+#if !wxUSE_UNICODE
+    if ( encoding.CmpNoCase(wxS("UTF-8")) != 0 )
+        ctx.conv = new wxCSConv(encoding);
+#else
+    wxUnusedVar(encoding);
+#endif
+
+    XML_SetUserData(parser, (void*)&ctx);
+    XML_SetElementHandler(parser, SaxStartElementHnd, SaxEndElementHnd);
+    XML_SetCharacterDataHandler(parser, SaxTextHnd);
+    XML_SetUnknownEncodingHandler(parser, UnknownEncodingHnd, NULL);
+
+    bool ok = true;
+    bool done;
+    do
+    {
+        size_t len = stream.Read(buf, BUFSIZE).LastRead();
+        done = (len < BUFSIZE);
+        if (!XML_Parse(parser, buf, len, done))
+        {
+            wxString error(XML_ErrorString(XML_GetErrorCode(parser)),
+                           *wxConvCurrent);
+            m_error.Printf(_("XML parsing error: '%s' at line %d"),
+                           error.c_str(),
+                           (int)XML_GetCurrentLineNumber(parser));
+            wxLogError(wxS("%s"), m_error);
+            ok = false;
+            break;
+        }
+    } while (!done && !m_stopped);
+
+    XML_ParserFree(parser);
+#if !wxUSE_UNICODE
+    delete ctx.conv;
+#endif
+
+    return ok && !m_stopped;
+}
+
+//-----------------------------------------------------------------------------
+//  wxXmlDocument binary format
+//-----------------------------------------------------------------------------
+
+// The format is a signature followed by a format version number, the document
+// properties, a table of all the strings used in the document and finally the
+// node tree itself, with all the strings replaced by their indices in the
+// table. Unlike XML text, it can be read back without any parsing or charset
+// conversion of the bulk of the data.
+
+namespace
+{
+
+const wxUint32 wxBinaryXmlVersion = 1;
+
+WX_DECLARE_STRING_HASH_MAP(wxUint32, wxXmlStringTableHash);
+
+// Table of the unique strings of a document, in order of first appearance.
+class wxXmlStringTable
+{
+public:
+    wxXmlStringTable() { }
+
+    wxUint32 Intern(const wxString& str)
+    {
+        wxXmlStringTableHash::const_iterator it = m_index.find(str);
+        if ( it != m_index.end() )
+            return it->second;
+
+        const wxUint32 id = static_cast<wxUint32>(m_strings.size());
+        m_index[str] = id;
+        m_strings.push_back(str);
+        return id;
+    }
+
+    void Write(wxDataOutputStream& ds) const
+    {
+        const size_t count = m_strings.size();
+        ds.Write32(static_cast<wxUint32>(count));
+        for ( size_t n = 0; n < count; n++ )
+            ds.WriteString(m_strings[n]);
+    }
+
+private:
+    wxArrayString m_strings;
+    wxXmlStringTableHash m_index;
+
+    wxDECLARE_NO_COPY_CLASS(wxXmlStringTable);
+};
+
+// First pass of the writer: collect all the strings used by the subtree.
+void wxXmlCollectStrings(const wxXmlNode* node, wxXmlStringTable& table)
+{
+    for ( ; node; node = node->GetNext() )
+    {
+        table.Intern(node->GetName());
+        table.Intern(node->GetContent());
+
+        for ( wxXmlAttribute* attr = node->GetAttributes();
+              attr;
+              attr = attr->GetNext() )
+        {
+            table.Intern(attr->GetName());
+            table.Intern(attr->GetValue());
+        }
+
+        wxXmlCollectStrings(node->GetChildren(), table);
+    }
+}
+
+// Second pass: write a node and its siblings as table references.
+void wxXmlWriteNodes(wxDataOutputStream& ds,
+                     const wxXmlNode* node,
+                     wxXmlStringTable& table)
+{
+    wxUint32 count = 0;
+    for ( const wxXmlNode* n = node; n; n = n->GetNext() )
+        count++;
+    ds.Write32(count);
+
+    for ( ; node; node = node->GetNext() )
+    {
+        ds.Write8(static_cast<wxUint8>(node->GetType()));
+        ds.Write32(table.Intern(node->GetName()));
+        ds.Write32(table.Intern(node->GetContent()));
+        ds.Write32(static_cast<wxUint32>(node->GetLineNumber()));
+
+        count = 0;
+        for ( wxXmlAttribute* attr = node->GetAttributes();
+              attr;
+              attr = attr->GetNext() )
+            count++;
+        ds.Write32(count);
+
+        for ( wxXmlAttribute* attr = node->GetAttributes();
+              attr;
+              attr = attr->GetNext() )
+        {
+            ds.Write32(table.Intern(attr->GetName()));
+            ds.Write32(table.Intern(attr->GetValue()));
+        }
+
+        wxXmlWriteNodes(ds, node->GetChildren(), table);
+    }
+}
+
+// Read back the children of the given node written by wxXmlWriteNodes().
+bool wxXmlReadNodes(wxDataInputStream& ds,
+                    wxXmlNode* parent,
+                    const wxArrayString& table)
+{
+    const wxUint32 countNodes = ds.Read32();
+
+    wxXmlNode* prev = NULL;
+    for ( wxUint32 n = 0; n < countNodes; n++ )
+    {
+        const wxXmlNodeType type = static_cast<wxXmlNodeType>(ds.Read8());
+        const wxUint32 name = ds.Read32();
+        const wxUint32 content = ds.Read32();
+        const int lineNo = static_cast<wxInt32>(ds.Read32());
+        if ( name >= table.size() || content >= table.size() )
+            return false;
+
+        wxXmlNode* const
+            node = new wxXmlNode(type, table[name], table[content], lineNo);
+        parent->InsertChildAfter(node, prev);
+        prev = node;
+
+        const wxUint32 countAttrs = ds.Read32();
+        for ( wxUint32 a = 0; a < countAttrs; a++ )
+        {
+            const wxUint32 attrName = ds.Read32();
+            const wxUint32 attrValue = ds.Read32();
+            if ( attrName >= table.size() || attrValue >= table.size() )
+                return false;
+
+            node->AddAttribute(table[attrName], table[attrValue]);
+        }
+
+        if ( !wxXmlReadNodes(ds, node, table) )
+            return false;
+    }
+
+    return true;
+}
+
+} // anonymous namespace
+
+bool wxXmlDocument::SaveBinary(const wxString& filename) const
+{
+    wxFileOutputStream stream(filename);
+    if (!stream.IsOk())
+        return false;
+    return SaveBinary(stream);
+}
+
+bool wxXmlDocument::SaveBinary(wxOutputStream& stream) const
+{
+    wxCHECK_MSG( IsOk(), false, "invalid XML document" );
+
+    stream.Write(wxBinaryXmlSignature, sizeof(wxBinaryXmlSignature));
+
+    wxDataOutputStream ds(stream);
+    ds.Write32(wxBinaryXmlVersion);
+    ds.WriteString(GetVersion());
+    ds.WriteString(GetFileEncoding());
+    ds.WriteString(m_doctype.GetRootName());
+    ds.WriteString(m_doctype.GetSystemId());
+    ds.WriteString(m_doctype.GetPublicId());
+
+    wxXmlStringTable table;
+    wxXmlCollectStrings(m_docNode->GetChildren(), table);
+    table.Write(ds);
+
+    wxXmlWriteNodes(ds, m_docNode->GetChildren(), table);
+
+    return stream.IsOk();
+}
+
+bool wxXmlDocument::LoadBinary(wxInputStream& stream)
+{
+    char sig[WXSIZEOF(wxBinaryXmlSignature)];
+    if ( stream.Read(sig, sizeof(sig)).LastRead() != sizeof(sig) ||
+            memcmp(sig, wxBinaryXmlSignature, sizeof(sig)) != 0 )
+        return false;
+
+    return DoLoadBinary(stream);
+}
+
+// Common part of LoadBinary() and Load(), called after reading the signature.
+bool wxXmlDocument::DoLoadBinary(wxInputStream& stream)
+{
+    wxDataInputStream ds(stream);
+
+    const wxUint32 version = ds.Read32();
+    if ( version != wxBinaryXmlVersion )
+    {
+        wxLogError(_("Unsupported binary XML document version %lu"),
+                   static_cast<unsigned long>(version));
+        return false;
+    }
+
+    const wxString docVersion = ds.ReadString();
+    const wxString fileEncoding = ds.ReadString();
+    const wxString doctypeRoot = ds.ReadString();
+    const wxString doctypeSystemId = ds.ReadString();
+    const wxString doctypePublicId = ds.ReadString();
+
+    const wxUint32 count = ds.Read32();
+    wxArrayString table;
+    table.reserve(count);
+    for ( wxUint32 n = 0; n < count && stream.IsOk(); n++ )
+        table.push_back(ds.ReadString());
+
+    wxScopedPtr<wxXmlNode>
+        docNode(new wxXmlNode(wxXML_DOCUMENT_NODE, wxEmptyString));
+
+    if ( table.size() != count ||
+            !wxXmlReadNodes(ds, docNode.get(), table) ||
+                !stream.IsOk() )
+    {
+        wxLogError(_("Malformed binary XML document"));
+        return false;
+    }
+
+    SetVersion(docVersion);
+    SetFileEncoding(fileEncoding);
+    SetDoctype(wxXmlDoctype(doctypeRoot, doctypeSystemId, doctypePublicId));
+    SetDocumentNode(docNode.release());
+
+    return true;
+}
+
 //-----------------------------------------------------------------------------
 //  wxXmlDocument saving routines
 //-----------------------------------------------------------------------------
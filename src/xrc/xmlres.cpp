@@ -470,6 +470,7 @@ void wxXmlResource::AddHandler(wxXmlResourceHandler *handler)
     handler->SetImpl(impl);
     m_handlers.push_back(handler);
     handler->SetParentResource(this);
+    m_handlerByClass.clear();
 }
 
 void wxXmlResource::InsertHandler(wxXmlResourceHandler *handler)
@@ -478,6 +479,7 @@ void wxXmlResource::InsertHandler(wxXmlResourceHandler *handler)
     handler->SetImpl(impl);
     m_handlers.insert(m_handlers.begin(), handler);
     handler->SetParentResource(this);
+    m_handlerByClass.clear();
 }
 
 
@@ -488,6 +490,7 @@ void wxXmlResource::ClearHandlers()
           i != m_handlers.end(); ++i )
         delete *i;
     m_handlers.clear();
+    m_handlerByClass.clear();
 }
 
 
@@ -768,6 +771,9 @@ wxXmlDocument *wxXmlResource::DoLoadFile(const wxString& filename)
     }
 #endif
 
+    // Notice that this also loads files in the precompiled binary format
+    // produced by "wxrc -b", as wxXmlDocument recognizes it automatically,
+    // and skips XML parsing entirely for them.
     wxScopedPtr<wxXmlDocument> doc(new wxXmlDocument);
     if (!doc->Load(*stream, encoding))
     {
@@ -1087,12 +1093,33 @@ wxXmlResource::DoCreateResFromNode(wxXmlNode& node,
     }
     else if (node.GetName() == wxT("object"))
     {
+        const wxString classname = node.GetAttribute(wxT("class"), wxEmptyString);
+
+        // Check if we already know which handler to use for this class: with
+        // dozens of registered handlers, asking each of them in turn for
+        // every node is expensive, so remember the handler used the last time
+        // and try it first. Note that we still need to ask it whether it can
+        // handle this particular node as CanHandle() may depend on more than
+        // just the class name (e.g. on the parent node).
+        if ( !classname.empty() )
+        {
+            wxXmlResourceHandlerMap::iterator it =
+                m_handlerByClass.find(classname);
+            if ( it != m_handlerByClass.end() && it->second->CanHandle(&node) )
+                return it->second->CreateResource(&node, parent, instance);
+        }
+
         for ( wxVector<wxXmlResourceHandler*>::iterator h = m_handlers.begin();
               h != m_handlers.end(); ++h )
         {
             wxXmlResourceHandler *handler = *h;
             if (handler->CanHandle(&node))
+            {
+                if ( !classname.empty() )
+                    m_handlerByClass[classname] = handler;
+
                 return handler->CreateResource(&node, parent, instance);
+            }
         }
     }
 
@@ -16,10 +16,90 @@
 
 #include "archivetest.h"
 #include "wx/tarstrm.h"
+#include "wx/mstream.h"
 
 using std::string;
 
 
+///////////////////////////////////////////////////////////////////////////////
+// Test random access to entries via the index, and that a saved index can
+// be reloaded and used in place of rescanning the headers
+
+class TarIndexTestCase : public CppUnit::TestCase
+{
+public:
+    TarIndexTestCase(string name) :
+        CppUnit::TestCase(TestId::MakeId() + name)
+    { }
+
+protected:
+    void runTest() wxOVERRIDE;
+};
+
+void TarIndexTestCase::runTest()
+{
+    wxMemoryOutputStream out;
+
+    {
+        wxTarOutputStream tar(out);
+
+        for (int i = 0; i < 10; i++) {
+            wxString name = wxString::Format(wxT("file%d.txt"), i);
+            wxString text = wxString::Format(wxT("contents of %s"), name);
+            const wxWX2MBbuf buf = text.mb_str();
+            tar.PutNextEntry(name, wxDateTime::Now(), strlen(buf));
+            tar.Write(buf.data(), strlen(buf));
+        }
+
+        CPPUNIT_ASSERT(tar.Close());
+    }
+
+    wxMemoryOutputStream savedIndex;
+
+    {
+        wxMemoryInputStream in(out);
+        wxTarInputStream tar(in);
+
+        CPPUNIT_ASSERT(!tar.HasIndex());
+        CPPUNIT_ASSERT(tar.BuildIndex());
+        CPPUNIT_ASSERT(tar.HasIndex());
+        CPPUNIT_ASSERT(tar.FindEntry(wxT("no-such-file")) == NULL);
+
+        // open entries out of order
+        for (int i = 9; i >= 0; i--) {
+            wxString name = wxString::Format(wxT("file%d.txt"), i);
+            wxString text = wxString::Format(wxT("contents of %s"), name);
+
+            wxTarEntry *entry = tar.FindEntry(name);
+            CPPUNIT_ASSERT(entry != NULL);
+            CPPUNIT_ASSERT(entry->GetName() == name);
+
+            CPPUNIT_ASSERT(tar.OpenEntry(name));
+            char buf[64];
+            size_t len = tar.Read(buf, sizeof(buf)).LastRead();
+            CPPUNIT_ASSERT(wxString(buf, *wxConvCurrent, len) == text);
+        }
+
+        CPPUNIT_ASSERT(tar.SaveIndex(savedIndex));
+    }
+
+    // repeat access using the saved index, without scanning the headers
+    {
+        wxMemoryInputStream in(out);
+        wxTarInputStream tar(in);
+        wxMemoryInputStream indexIn(savedIndex);
+
+        CPPUNIT_ASSERT(tar.LoadIndex(indexIn));
+
+        CPPUNIT_ASSERT(tar.OpenEntry(wxT("file7.txt")));
+        char buf[64];
+        size_t len = tar.Read(buf, sizeof(buf)).LastRead();
+        CPPUNIT_ASSERT(wxString(buf, *wxConvCurrent, len) ==
+                       wxT("contents of file7.txt"));
+    }
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // Tar suite
 
@@ -28,7 +108,13 @@ class tartest : public ArchiveTestSuite
 public:
     tartest();
 
-    void runTest() wxOVERRIDE { DoRunTest(); }
+    void runTest() wxOVERRIDE
+    {
+        DoRunTest();
+
+        TarIndexTestCase indexTest("TarIndexTestCase");
+        indexTest.runTest();
+    }
 
 protected:
     CppUnit::Test *makeTest(string descr, int options,
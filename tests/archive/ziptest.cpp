@@ -16,6 +16,7 @@
 
 #include "archivetest.h"
 #include "wx/zipstrm.h"
+#include "wx/mstream.h"
 
 using std::string;
 
@@ -201,6 +202,74 @@ void ZipPipeTestCase::runTest()
 }
 
 
+///////////////////////////////////////////////////////////////////////////////
+// Test that archives created with multi-threaded compression can be read
+// back, including entries large enough to span several compression chunks
+
+#if wxUSE_THREADS
+
+class ZipParallelTestCase : public CppUnit::TestCase
+{
+public:
+    ZipParallelTestCase(string name) :
+        CppUnit::TestCase(TestId::MakeId() + name)
+    { }
+
+protected:
+    void runTest() wxOVERRIDE;
+};
+
+void ZipParallelTestCase::runTest()
+{
+    // moderately compressible test data, larger than one 128K chunk
+    wxCharBuffer buf(1024 * 1024);
+    for (size_t i = 0; i < buf.length(); i++)
+        buf.data()[i] = char('a' + ((i + i / 327) % 26));
+
+    wxMemoryOutputStream out;
+
+    {
+        wxZipOutputStream zip(out);
+        CPPUNIT_ASSERT(zip.SetCompressionThreads(3));
+        CPPUNIT_ASSERT_EQUAL(3, zip.GetCompressionThreads());
+
+        zip.PutNextEntry(wxT("big"));
+        zip.Write(buf.data(), buf.length());
+        zip.PutNextEntry(wxT("small"));
+        zip.Write("lorem ipsum", 11);
+        zip.PutNextEntry(wxT("empty"));
+        CPPUNIT_ASSERT(zip.Close());
+    }
+
+    wxMemoryInputStream in(out);
+    wxZipInputStream zip(in);
+
+    wxScopedPtr<wxZipEntry> entry(zip.GetNextEntry());
+    CPPUNIT_ASSERT(entry.get() != NULL);
+    CPPUNIT_ASSERT(entry->GetName() == wxT("big"));
+    wxCharBuffer buf2(buf.length());
+    CPPUNIT_ASSERT_EQUAL(buf.length(),
+                         zip.Read(buf2.data(), buf2.length()).LastRead());
+    CPPUNIT_ASSERT(memcmp(buf.data(), buf2.data(), buf.length()) == 0);
+
+    entry.reset(zip.GetNextEntry());
+    CPPUNIT_ASSERT(entry.get() != NULL);
+    CPPUNIT_ASSERT(entry->GetName() == wxT("small"));
+    char small[16];
+    CPPUNIT_ASSERT_EQUAL(size_t(11), zip.Read(small, sizeof(small)).LastRead());
+    CPPUNIT_ASSERT(memcmp(small, "lorem ipsum", 11) == 0);
+
+    entry.reset(zip.GetNextEntry());
+    CPPUNIT_ASSERT(entry.get() != NULL);
+    CPPUNIT_ASSERT(entry->GetName() == wxT("empty"));
+    CPPUNIT_ASSERT_EQUAL(wxFileOffset(0), entry->GetSize());
+
+    CPPUNIT_ASSERT(zip.GetNextEntry() == NULL);
+}
+
+#endif // wxUSE_THREADS
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // Zip suite
 
@@ -209,7 +278,15 @@ class ziptest : public ArchiveTestSuite
 public:
     ziptest();
 
-    void runTest() wxOVERRIDE { DoRunTest(); }
+    void runTest() wxOVERRIDE
+    {
+        DoRunTest();
+
+#if wxUSE_THREADS
+        ZipParallelTestCase parallelTest("ZipParallelTestCase");
+        parallelTest.runTest();
+#endif
+    }
 
 protected:
     CppUnit::Test *makeTest(string descr, int options,
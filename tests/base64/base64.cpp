@@ -87,6 +87,7 @@ private:
         CPPUNIT_TEST( EncodeDecodePatternC );
         CPPUNIT_TEST( EncodeDecodeRandom );
         CPPUNIT_TEST( DecodeInvalid );
+        CPPUNIT_TEST( DecodeIncremental );
     CPPUNIT_TEST_SUITE_END();
 
     void EncodeDecodeEmpty();
@@ -100,6 +101,7 @@ private:
     void EncodeDecodePatternC();
     void EncodeDecodeRandom();
     void DecodeInvalid();
+    void DecodeIncremental();
 
     wxDECLARE_NO_COPY_CLASS(Base64TestCase);
 };
@@ -303,4 +305,47 @@ void Base64TestCase::DecodeInvalid()
     CPPUNIT_ASSERT( !wxBase64Decode("wxGetApp()").GetDataLen() );
 }
 
+void Base64TestCase::DecodeIncremental()
+{
+    unsigned char buff[256];
+    for ( size_t n = 0; n < WXSIZEOF(buff); n++ )
+        buff[n] = (unsigned char)n;
+
+    const char *encoded = encoded0to255;
+    const size_t encLen = strlen(encoded);
+
+    // decoding the input split at any position must give the same result as
+    // decoding it at once
+    for ( size_t split = 0; split <= encLen; split++ )
+    {
+        wxBase64Decoder dec;
+        unsigned char out[WXSIZEOF(buff) + 3];
+
+        size_t len = dec.Decode(out, WXSIZEOF(out), encoded, split);
+        CPPUNIT_ASSERT( len != wxCONV_FAILED );
+
+        const size_t len2 = dec.Decode(out + len, WXSIZEOF(out) - len,
+                                       encoded + split, encLen - split);
+        CPPUNIT_ASSERT( len2 != wxCONV_FAILED );
+        CPPUNIT_ASSERT( dec.IsComplete() );
+
+        len += len2;
+        CPPUNIT_ASSERT_EQUAL( WXSIZEOF(buff), len );
+        CPPUNIT_ASSERT( memcmp(out, buff, WXSIZEOF(buff)) == 0 );
+    }
+
+    // the error position is relative to the whole input, not the last chunk
+    wxBase64Decoder dec;
+    unsigned char out[16];
+    CPPUNIT_ASSERT( dec.Decode(out, WXSIZEOF(out), "QUJD", 4) != wxCONV_FAILED );
+    CPPUNIT_ASSERT_EQUAL( wxCONV_FAILED,
+                          dec.Decode(out, WXSIZEOF(out), "EF!G", 4) );
+    CPPUNIT_ASSERT_EQUAL( 6, dec.GetErrorPos() );
+
+    // input stopping in the middle of a quartet is incomplete
+    dec.Reset();
+    CPPUNIT_ASSERT( dec.Decode(out, WXSIZEOF(out), "QQ", 2) != wxCONV_FAILED );
+    CPPUNIT_ASSERT( !dec.IsComplete() );
+}
+
 #endif // wxUSE_BASE64
@@ -35,6 +35,7 @@ static const char OPTION_SINGLE = '1';
 static const char OPTION_AVG_COUNT = 'a';
 static const char OPTION_NUM_RUNS = 'n';
 static const char OPTION_NUMERIC_PARAM = 'p';
+static const char OPTION_OUTPUT = 'o';
 static const char OPTION_STRING_PARAM = 's';
 
 // ----------------------------------------------------------------------------
@@ -73,6 +74,9 @@ private:
          m_avgCount,
          m_numParam;
     wxString m_strParam;
+
+    // file to write the results to in CSV format, if specified
+    wxString m_outputName;
 };
 
 wxIMPLEMENT_APP_CONSOLE(BenchApp);
@@ -158,6 +162,10 @@ void BenchApp::OnInitCmdLine(wxCmdLineParser& parser)
                          m_numParam
                      ),
                      wxCMD_LINE_VAL_NUMBER);
+    parser.AddOption(OPTION_OUTPUT,
+                     "output",
+                     "also write machine-readable (CSV) results to this file",
+                     wxCMD_LINE_VAL_STRING);
     parser.AddOption(OPTION_STRING_PARAM,
                      "str-param",
                      "string parameter used by some benchmark functions "
@@ -194,6 +202,7 @@ bool BenchApp::OnCmdLineParsed(wxCmdLineParser& parser)
     if ( parser.Found(OPTION_NUM_RUNS, &m_numRuns) )
         numRunsSpecified = true;
     parser.Found(OPTION_NUMERIC_PARAM, &m_numParam);
+    parser.Found(OPTION_OUTPUT, &m_outputName);
     parser.Found(OPTION_STRING_PARAM, &m_strParam);
     if ( parser.Found(OPTION_SINGLE) )
     {
@@ -234,6 +243,20 @@ bool BenchApp::OnCmdLineParsed(wxCmdLineParser& parser)
 
 int BenchApp::OnRun()
 {
+    FILE *csv = NULL;
+    if ( !m_outputName.empty() )
+    {
+        csv = wxFopen(m_outputName, wxT("w"));
+        if ( !csv )
+        {
+            wxFprintf(stderr, "Failed to open output file \"%s\".\n",
+                      m_outputName);
+            return EXIT_FAILURE;
+        }
+
+        wxFprintf(csv, "benchmark,loops,avg_ms,min_ms,max_ms,total_ms\n");
+    }
+
     int rc = EXIT_SUCCESS;
     for ( Bench::Function *func = Bench::Function::GetFirst();
           func;
@@ -285,6 +308,7 @@ int BenchApp::OnRun()
         }
         else
         {
+            const long timeRaw = timeTotal;
             wxPrintf("%ldms total, ", timeTotal);
 
             long times = m_avgCount;
@@ -294,13 +318,24 @@ int BenchApp::OnRun()
                 times -= 2;
             }
 
+            const float timeAvg = (float)timeTotal / times;
             wxPrintf("%.2f avg (min=%ld, max=%ld)\n",
-                     (float)timeTotal / times, timeMin, timeMax);
+                     timeAvg, timeMin, timeMax);
+
+            if ( csv )
+            {
+                wxFprintf(csv, "%s,%ld,%.2f,%ld,%ld,%ld\n",
+                          func->GetName(), m_numRuns,
+                          timeAvg, timeMin, timeMax, timeRaw);
+            }
         }
 
         fflush(stdout);
     }
 
+    if ( csv )
+        fclose(csv);
+
     return rc;
 }
 
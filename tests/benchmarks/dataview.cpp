@@ -0,0 +1,76 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/dataview.cpp
+// Purpose:     wxDataViewCtrl benchmarks
+// Author:      wxWidgets team
+// Created:     2022-04-17
+// Copyright:   (c) 2022 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/app.h"
+
+#if wxUSE_DATAVIEWCTRL
+
+#include "wx/dataview.h"
+
+#include "bench.h"
+
+namespace
+{
+
+const int BENCH_DVC_ROWS = 1000;
+
+wxDataViewListCtrl *gs_dvc = NULL;
+
+void AppendBenchRow(int n)
+{
+    wxVector<wxVariant> data;
+    data.push_back(wxVariant(wxString::Format("Item %d", n)));
+    data.push_back(wxVariant(wxString::Format("Value %d", n)));
+    gs_dvc->AppendItem(data);
+}
+
+bool InitDataView()
+{
+    gs_dvc = new wxDataViewListCtrl(wxTheApp->GetTopWindow(), wxID_ANY,
+                                    wxDefaultPosition, wxSize(400, 300));
+    gs_dvc->AppendTextColumn("Name");
+    gs_dvc->AppendTextColumn("Value");
+
+    for ( int n = 0; n < BENCH_DVC_ROWS; n++ )
+        AppendBenchRow(n);
+
+    return true;
+}
+
+void DoneDataView()
+{
+    gs_dvc->Destroy();
+    gs_dvc = NULL;
+}
+
+} // anonymous namespace
+
+// Jump between the two ends of the control: this exercises the same row
+// positioning code as scrolling through a big list.
+BENCHMARK_FUNC_WITH_INIT(DataViewScroll, InitDataView, DoneDataView)
+{
+    gs_dvc->EnsureVisible(gs_dvc->RowToItem(BENCH_DVC_ROWS - 1));
+    gs_dvc->EnsureVisible(gs_dvc->RowToItem(0));
+
+    return true;
+}
+
+// Repopulate the control: each appended row goes through the model change
+// notification machinery.
+BENCHMARK_FUNC_WITH_INIT(DataViewAppend, InitDataView, DoneDataView)
+{
+    gs_dvc->DeleteAllItems();
+
+    for ( int n = 0; n < 100; n++ )
+        AppendBenchRow(n);
+
+    return gs_dvc->GetItemCount() == 100u;
+}
+
+#endif // wxUSE_DATAVIEWCTRL
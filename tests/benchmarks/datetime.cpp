@@ -17,3 +17,38 @@ BENCHMARK_FUNC(ParseDate)
     return dt.ParseDate("May 23, 2011") && dt.GetMonth() == wxDateTime::May;
 }
 
+// Use a format with "%l" to ensure that we exercise our own code and not just
+// strftime() which doesn't support it.
+BENCHMARK_FUNC(Format)
+{
+    static const wxDateTime dt(23, wxDateTime::May, 2011, 12, 34, 56, 789);
+
+    return !dt.Format("%Y-%m-%d %H:%M:%S.%l").empty();
+}
+
+BENCHMARK_FUNC(FormatCompiled)
+{
+    static const wxDateTime dt(23, wxDateTime::May, 2011, 12, 34, 56, 789);
+    static const wxDateTimeFormat fmt("%Y-%m-%d %H:%M:%S.%l");
+
+    return !dt.Format(fmt).empty();
+}
+
+BENCHMARK_FUNC(ParseFormat)
+{
+    wxDateTime dt;
+    wxString::const_iterator end;
+    return dt.ParseFormat("23 May 2011 12:34:56", "%d %b %Y %H:%M:%S", &end) &&
+                dt.GetMonth() == wxDateTime::May;
+}
+
+BENCHMARK_FUNC(ParseFormatCompiled)
+{
+    static const wxDateTimeFormat fmt("%d %b %Y %H:%M:%S");
+
+    wxDateTime dt;
+    wxString::const_iterator end;
+    return dt.ParseFormat("23 May 2011 12:34:56", fmt, &end) &&
+                dt.GetMonth() == wxDateTime::May;
+}
+
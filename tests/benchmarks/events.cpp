@@ -0,0 +1,93 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/events.cpp
+// Purpose:     Event dispatch benchmarks
+// Author:      wxWidgets team
+// Created:     2022-04-17
+// Copyright:   (c) 2022 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/app.h"
+#include "wx/event.h"
+#include "wx/panel.h"
+
+#include "bench.h"
+
+namespace
+{
+
+// the root of the window chain used by the benchmarks below and its
+// deepest descendant from which the events are sent
+wxPanel *gs_chainRoot = NULL;
+wxWindow *gs_chainLeaf = NULL;
+
+// incremented by the handler bound to the root
+unsigned gs_numEventsHandled = 0;
+
+void OnBenchCommand(wxCommandEvent& event)
+{
+    gs_numEventsHandled++;
+    event.Skip();
+}
+
+bool InitEventChain()
+{
+    gs_chainRoot = new wxPanel(wxTheApp->GetTopWindow());
+    gs_chainRoot->Bind(wxEVT_BUTTON, OnBenchCommand);
+
+    // create a chain of 20 nested panels, roughly as deep as the window
+    // hierarchy of a complex dialog
+    wxWindow *parent = gs_chainRoot;
+    for ( int depth = 0; depth < 20; depth++ )
+        parent = new wxPanel(parent);
+
+    gs_chainLeaf = parent;
+
+    return true;
+}
+
+void DoneEventChain()
+{
+    gs_chainRoot->Destroy();
+    gs_chainRoot = NULL;
+    gs_chainLeaf = NULL;
+}
+
+} // anonymous namespace
+
+// Dispatch a command event from the deepest window: it has to propagate
+// through all the intermediate handlers before reaching the handler bound
+// to the root.
+BENCHMARK_FUNC_WITH_INIT(EventPropagation, InitEventChain, DoneEventChain)
+{
+    gs_numEventsHandled = 0;
+
+    wxCommandEvent event(wxEVT_BUTTON);
+    gs_chainLeaf->ProcessWindowEvent(event);
+
+    return gs_numEventsHandled == 1;
+}
+
+// Dispatch directly to the window the handler is bound to, measuring the
+// cost of the event table lookup and handler invocation alone.
+BENCHMARK_FUNC_WITH_INIT(EventDirect, InitEventChain, DoneEventChain)
+{
+    gs_numEventsHandled = 0;
+
+    wxCommandEvent event(wxEVT_BUTTON);
+    gs_chainRoot->ProcessWindowEvent(event);
+
+    return gs_numEventsHandled == 1;
+}
+
+// Dispatch an event nobody is interested in: this is the common case for
+// e.g. mouse move events and should be as cheap as possible.
+BENCHMARK_FUNC_WITH_INIT(EventUnhandled, InitEventChain, DoneEventChain)
+{
+    gs_numEventsHandled = 0;
+
+    wxCommandEvent event(wxEVT_CHECKBOX);
+    gs_chainLeaf->ProcessWindowEvent(event);
+
+    return gs_numEventsHandled == 0;
+}
@@ -0,0 +1,79 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/grid.cpp
+// Purpose:     wxGrid benchmarks
+// Author:      wxWidgets team
+// Created:     2022-04-17
+// Copyright:   (c) 2022 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/app.h"
+
+#if wxUSE_GRID
+
+#include "wx/bitmap.h"
+#include "wx/dcmemory.h"
+#include "wx/grid.h"
+
+#include "bench.h"
+
+namespace
+{
+
+const int BENCH_GRID_ROWS = 100;
+const int BENCH_GRID_COLS = 10;
+
+wxGrid *gs_grid = NULL;
+wxBitmap gs_bitmap;
+
+bool InitGrid()
+{
+    gs_grid = new wxGrid(wxTheApp->GetTopWindow(), wxID_ANY);
+    gs_grid->CreateGrid(BENCH_GRID_ROWS, BENCH_GRID_COLS);
+
+    for ( int row = 0; row < BENCH_GRID_ROWS; row++ )
+    {
+        for ( int col = 0; col < BENCH_GRID_COLS; col++ )
+        {
+            gs_grid->SetCellValue(row, col,
+                                  wxString::Format("(%d, %d)", row, col));
+        }
+    }
+
+    gs_bitmap.Create(800, 600);
+
+    return true;
+}
+
+void DoneGrid()
+{
+    gs_bitmap = wxBitmap();
+
+    gs_grid->Destroy();
+    gs_grid = NULL;
+}
+
+} // anonymous namespace
+
+// Draw the whole grid into a memory DC: this exercises the same cell
+// drawing code as the paint handler, without needing the window to be
+// shown on screen.
+BENCHMARK_FUNC_WITH_INIT(GridRender, InitGrid, DoneGrid)
+{
+    wxMemoryDC dc(gs_bitmap);
+    gs_grid->Render(dc);
+
+    return true;
+}
+
+// Update every cell of a column: each change goes through the grid table
+// and its notification machinery.
+BENCHMARK_FUNC_WITH_INIT(GridSetCellValue, InitGrid, DoneGrid)
+{
+    for ( int row = 0; row < BENCH_GRID_ROWS; row++ )
+        gs_grid->SetCellValue(row, 0, "updated");
+
+    return true;
+}
+
+#endif // wxUSE_GRID
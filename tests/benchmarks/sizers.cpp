@@ -0,0 +1,104 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/sizers.cpp
+// Purpose:     Sizer layout benchmarks
+// Author:      wxWidgets team
+// Created:     2022-04-17
+// Copyright:   (c) 2022 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/app.h"
+#include "wx/panel.h"
+#include "wx/sizer.h"
+
+#include "bench.h"
+
+namespace
+{
+
+// the panel whose layout is being benchmarked
+wxPanel *gs_panel = NULL;
+
+wxWindow *MakeChild(wxWindow *parent)
+{
+    wxWindow *win = new wxWindow(parent, wxID_ANY);
+    win->SetMinSize(wxSize(40, 20));
+    return win;
+}
+
+void DoneSizerPanel()
+{
+    gs_panel->Destroy();
+    gs_panel = NULL;
+}
+
+} // anonymous namespace
+
+// Lay out a wide tree: a form-like grid of 30 rows with 10 windows each,
+// representative of a big dialog.
+static bool InitSizerWide()
+{
+    gs_panel = new wxPanel(wxTheApp->GetTopWindow());
+
+    wxBoxSizer * const sizer = new wxBoxSizer(wxVERTICAL);
+    for ( int row = 0; row < 30; row++ )
+    {
+        wxBoxSizer * const rowSizer = new wxBoxSizer(wxHORIZONTAL);
+        for ( int col = 0; col < 10; col++ )
+        {
+            rowSizer->Add(MakeChild(gs_panel),
+                          wxSizerFlags(1).Expand().Border());
+        }
+
+        sizer->Add(rowSizer, wxSizerFlags().Expand());
+    }
+
+    gs_panel->SetSizer(sizer);
+    gs_panel->SetSize(800, 600);
+
+    return true;
+}
+
+BENCHMARK_FUNC_WITH_INIT(SizerLayoutWide, InitSizerWide, DoneSizerPanel)
+{
+    return gs_panel->Layout();
+}
+
+// Lay out a deep tree: 50 nested box sizers with a couple of windows at
+// each level, representative of heavily nested custom layouts.
+static bool InitSizerDeep()
+{
+    gs_panel = new wxPanel(wxTheApp->GetTopWindow());
+
+    wxBoxSizer * const sizer = new wxBoxSizer(wxVERTICAL);
+    wxSizer *innermost = sizer;
+    for ( int depth = 0; depth < 50; depth++ )
+    {
+        innermost->Add(MakeChild(gs_panel), wxSizerFlags().Border());
+
+        wxBoxSizer * const child =
+            new wxBoxSizer(depth % 2 ? wxVERTICAL : wxHORIZONTAL);
+        innermost->Add(child, wxSizerFlags(1).Expand());
+        innermost = child;
+    }
+
+    innermost->Add(MakeChild(gs_panel), wxSizerFlags(1).Expand());
+
+    gs_panel->SetSizer(sizer);
+    gs_panel->SetSize(800, 600);
+
+    return true;
+}
+
+BENCHMARK_FUNC_WITH_INIT(SizerLayoutDeep, InitSizerDeep, DoneSizerPanel)
+{
+    return gs_panel->Layout();
+}
+
+// Measure the best size computation alone: this is what happens when a
+// change somewhere in the tree invalidates the cached best sizes.
+BENCHMARK_FUNC_WITH_INIT(SizerBestSize, InitSizerWide, DoneSizerPanel)
+{
+    gs_panel->InvalidateBestSize();
+    return gs_panel->GetBestSize().x > 0;
+}
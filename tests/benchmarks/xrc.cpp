@@ -0,0 +1,125 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/xrc.cpp
+// Purpose:     XRC loading benchmarks
+// Author:      wxWidgets team
+// Created:     2022-04-17
+// Copyright:   (c) 2022 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/app.h"
+
+#if wxUSE_XRC
+
+#include "wx/dialog.h"
+#include "wx/scopedptr.h"
+#include "wx/sstream.h"
+#include "wx/xml/xml.h"
+#include "wx/xrc/xmlres.h"
+
+#include "bench.h"
+
+namespace
+{
+
+// Build the markup of a typical form-like dialog: 25 rows with a label, a
+// text control and a checkbox each, all inside nested box sizers.
+const wxString& GetBenchXrc()
+{
+    static wxString s_xrc;
+    if ( s_xrc.empty() )
+    {
+        s_xrc = "<?xml version=\"1.0\"?>"
+                "<resource>"
+                "<object class=\"wxDialog\" name=\"benchdlg\">"
+                "<title>Benchmark</title>"
+                "<object class=\"wxBoxSizer\"><orient>wxVERTICAL</orient>";
+
+        for ( int n = 0; n < 25; n++ )
+        {
+            s_xrc += wxString::Format(
+                "<object class=\"sizeritem\"><flag>wxEXPAND</flag>"
+                "<object class=\"wxBoxSizer\"><orient>wxHORIZONTAL</orient>"
+                "<object class=\"sizeritem\">"
+                  "<object class=\"wxStaticText\" name=\"label%d\">"
+                    "<label>Label %d</label></object></object>"
+                "<object class=\"sizeritem\"><option>1</option>"
+                  "<object class=\"wxTextCtrl\" name=\"text%d\">"
+                    "<value>value</value></object></object>"
+                "<object class=\"sizeritem\">"
+                  "<object class=\"wxCheckBox\" name=\"check%d\">"
+                    "<label>Enable</label></object></object>"
+                "</object></object>",
+                n, n, n, n);
+        }
+
+        s_xrc += "</object></object></resource>";
+    }
+
+    return s_xrc;
+}
+
+void InitXrcHandlers()
+{
+    static bool s_handlersAdded = false;
+    if ( !s_handlersAdded )
+    {
+        s_handlersAdded = true;
+        wxXmlResource::Get()->InitAllHandlers();
+    }
+}
+
+bool LoadBenchXrc(const wxString& name)
+{
+    wxStringInputStream sis(GetBenchXrc());
+    wxScopedPtr<wxXmlDocument> xmlDoc(new wxXmlDocument(sis, "UTF-8"));
+    if ( !xmlDoc->IsOk() )
+        return false;
+
+    return wxXmlResource::Get()->LoadDocument(xmlDoc.release(), name);
+}
+
+bool InitXrcLoad()
+{
+    InitXrcHandlers();
+
+    return true;
+}
+
+bool InitXrcDialog()
+{
+    InitXrcHandlers();
+
+    return LoadBenchXrc("benchdlg.xrc");
+}
+
+void DoneXrcDialog()
+{
+    wxXmlResource::Get()->Unload("benchdlg.xrc");
+}
+
+} // anonymous namespace
+
+// Parse the markup and load it into the resource: this is the cost paid
+// once per XRC file at startup.
+BENCHMARK_FUNC_WITH_INIT(XrcLoad, InitXrcLoad, NULL)
+{
+    if ( !LoadBenchXrc("bench.xrc") )
+        return false;
+
+    return wxXmlResource::Get()->Unload("bench.xrc");
+}
+
+// Instantiate the dialog from an already loaded resource: this is the cost
+// paid every time a window is created from XRC.
+BENCHMARK_FUNC_WITH_INIT(XrcCreateDialog, InitXrcDialog, DoneXrcDialog)
+{
+    wxDialog dlg;
+    if ( !wxXmlResource::Get()->LoadDialog(&dlg, wxTheApp->GetTopWindow(),
+                                           "benchdlg") )
+        return false;
+
+    return dlg.GetChildren().GetCount() != 0;
+}
+
+#endif // wxUSE_XRC
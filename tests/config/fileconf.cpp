@@ -19,8 +19,11 @@
 #endif // WX_PRECOMP
 
 #include "wx/fileconf.h"
+#include "wx/ffile.h"
+#include "wx/filename.h"
 #include "wx/sstream.h"
 #include "wx/log.h"
+#include "wx/utils.h"
 
 static const char *testconfig =
 "[root]\n"
@@ -639,5 +642,60 @@ TEST_CASE("wxFileConfig::LongLong", "[fileconfig][config][longlong]")
     CHECK( ll == val );
 }
 
+#if wxUSE_THREADS
+
+TEST_CASE("wxFileConfig::WriteBehind", "[fileconfig][config]")
+{
+    const wxString path = wxFileName::CreateTempFileName("fileconf");
+    REQUIRE( !path.empty() );
+
+    {
+        wxFileConfig fc(wxEmptyString, wxEmptyString, path, wxEmptyString,
+                        wxCONFIG_USE_LOCAL_FILE);
+
+        CHECK( !fc.IsWriteBehindEnabled() );
+        REQUIRE( fc.EnableWriteBehind(50) );
+        CHECK( fc.IsWriteBehindEnabled() );
+
+        fc.Write("key", "value");
+
+        // the change must be written out without any explicit Flush()
+        wxString text;
+        for ( int i = 0; i < 100 && !text.Contains("key=value"); i++ )
+        {
+            wxMilliSleep(50);
+
+            wxFFile file(path);
+            REQUIRE( file.IsOpened() );
+            file.ReadAll(&text);
+        }
+
+        CHECK( text.Contains("key=value") );
+
+        // an explicit Flush() still works synchronously
+        fc.Write("key2", "value2");
+        REQUIRE( fc.Flush() );
+
+        wxFFile file(path);
+        REQUIRE( file.IsOpened() );
+        file.ReadAll(&text);
+        CHECK( text.Contains("key2=value2") );
+
+        // anything still pending is written by the destructor
+        fc.Write("key3", "value3");
+    }
+
+    wxString text;
+    wxFFile file(path);
+    REQUIRE( file.IsOpened() );
+    file.ReadAll(&text);
+    CHECK( text.Contains("key3=value3") );
+
+    file.Close();
+    wxRemoveFile(path);
+}
+
+#endif // wxUSE_THREADS
+
 #endif // wxUSE_FILECONFIG
 
@@ -155,6 +155,74 @@ TEST_CASE_METHOD(DirTestCase, "Dir::Traverse", "[dir]")
     CHECK( traverser.dirs.size() == 6 );
 }
 
+TEST_CASE_METHOD(DirTestCase, "Dir::GetEntries", "[dir]")
+{
+    wxDir dir(DIRTEST_FOLDER);
+    CHECK( dir.IsOpened() );
+
+    wxDirEntries entries;
+    CHECK( dir.GetEntries(&entries) == 4 );
+    CHECK( entries.size() == 4 );
+
+    for ( size_t n = 0; n < entries.size(); n++ )
+    {
+        const wxDirEntry& e = entries[n];
+
+        INFO("Entry " << e.name);
+        if ( e.name == "dummy" )
+        {
+            CHECK( !e.isDir );
+            CHECK( e.size == 15 ); // length of "dummy test file"
+            CHECK( e.mtime != 0 );
+        }
+        else
+        {
+            CHECK( e.isDir );
+            CHECK( e.size == wxInvalidOffset );
+        }
+    }
+
+    // the same filters as for GetFirst/GetNext() apply
+    entries.clear();
+    CHECK( dir.GetEntries(&entries, wxEmptyString, wxDIR_DIRS) == 3 );
+
+    entries.clear();
+    CHECK( dir.GetEntries(&entries, "*.o*", wxDIR_DEFAULT) == 0 );
+}
+
+TEST_CASE_METHOD(DirTestCase, "Dir::GetAllEntries", "[dir]")
+{
+    // the recursive scan must find the same files as GetAllFiles()
+    wxDirEntries entries;
+    CHECK( wxDir::GetAllEntries(DIRTEST_FOLDER, &entries, wxEmptyString,
+                                wxDIR_FILES | wxDIR_HIDDEN) == 4 );
+
+    // directories can be included too
+    entries.clear();
+    CHECK( wxDir::GetAllEntries(DIRTEST_FOLDER, &entries) == 10 );
+
+    // the parallel version must return the same entries, although possibly
+    // in a different order
+    wxDirEntries parallel;
+    CHECK( wxDir::GetAllEntries(DIRTEST_FOLDER, &parallel, wxEmptyString,
+                                wxDIR_DEFAULT, 4) == entries.size() );
+
+    wxArrayString names1, names2;
+    for ( size_t n = 0; n < entries.size(); n++ )
+        names1.push_back(entries[n].name);
+    for ( size_t n = 0; n < parallel.size(); n++ )
+        names2.push_back(parallel[n].name);
+    names1.Sort();
+    names2.Sort();
+    CHECK( names1 == names2 );
+
+    // filespec only applies to the files, not to the traversal
+    entries.clear();
+    CHECK( wxDir::GetAllEntries(DIRTEST_FOLDER, &entries, "*.foo",
+                                wxDIR_FILES | wxDIR_HIDDEN) == 1 );
+    CHECK( entries[0].name.EndsWith("dummy.foo") );
+}
+
 TEST_CASE_METHOD(DirTestCase, "Dir::Exists", "[dir]")
 {
     struct
@@ -245,6 +245,56 @@ TEST_CASE("wxFileName::SetPath", "[filename]")
     CHECK( fn.SameAs(wxFileName("/usr/local/bin/ls", wxPATH_UNIX)) );
 }
 
+TEST_CASE("wxFileName::FullPathCache", "[filename]")
+{
+    // GetFullPath() memoizes its result, so check that every kind of
+    // modification correctly invalidates it
+    wxFileName fn("/usr/local/bin/ls", wxPATH_UNIX);
+    CHECK( fn.GetFullPath(wxPATH_UNIX) == "/usr/local/bin/ls" );
+    CHECK( fn.GetFullPath(wxPATH_UNIX) == "/usr/local/bin/ls" );
+
+    fn.SetName("cp");
+    CHECK( fn.GetFullPath(wxPATH_UNIX) == "/usr/local/bin/cp" );
+
+    fn.SetExt("exe");
+    CHECK( fn.GetFullPath(wxPATH_UNIX) == "/usr/local/bin/cp.exe" );
+
+    fn.ClearExt();
+    CHECK( fn.GetFullPath(wxPATH_UNIX) == "/usr/local/bin/cp" );
+
+    fn.RemoveLastDir();
+    CHECK( fn.GetFullPath(wxPATH_UNIX) == "/usr/local/cp" );
+
+    fn.AppendDir("share");
+    CHECK( fn.GetFullPath(wxPATH_UNIX) == "/usr/local/share/cp" );
+
+    fn.PrependDir("opt");
+    CHECK( fn.GetFullPath(wxPATH_UNIX) == "/opt/usr/local/share/cp" );
+
+    fn.SetPath("/tmp", wxPATH_UNIX);
+    CHECK( fn.GetFullPath(wxPATH_UNIX) == "/tmp/cp" );
+
+    fn.SetFullName("mv.exe");
+    CHECK( fn.GetFullPath(wxPATH_UNIX) == "/tmp/mv.exe" );
+
+    wxFileName fn2(fn);
+    fn2.SetName("ln");
+    CHECK( fn.GetFullPath(wxPATH_UNIX) == "/tmp/mv.exe" );
+    CHECK( fn2.GetFullPath(wxPATH_UNIX) == "/tmp/ln.exe" );
+
+    fn.Assign("/a/b/../c/ls", wxPATH_UNIX);
+    CHECK( fn.GetFullPath(wxPATH_UNIX) == "/a/b/../c/ls" );
+    CHECK( fn.Normalize(wxPATH_NORM_DOTS, wxEmptyString, wxPATH_UNIX) );
+    CHECK( fn.GetFullPath(wxPATH_UNIX) == "/a/c/ls" );
+
+    // repeating the same normalization is a no-op
+    CHECK( fn.Normalize(wxPATH_NORM_DOTS, wxEmptyString, wxPATH_UNIX) );
+    CHECK( fn.GetFullPath(wxPATH_UNIX) == "/a/c/ls" );
+
+    fn.Clear();
+    CHECK( fn.GetFullPath(wxPATH_UNIX).empty() );
+}
+
 TEST_CASE("wxFileName::Normalize", "[filename]")
 {
     // prepare some data to be used later
@@ -44,6 +44,7 @@ private:
         WXUISIM_TEST( LinkClick );
 #endif // wxUSE_UIACTIONSIMULATOR
         CPPUNIT_TEST( AppendToPage );
+        CPPUNIT_TEST( Relayout );
     CPPUNIT_TEST_SUITE_END();
 
     void SelectionToText();
@@ -51,6 +52,7 @@ private:
     void CellClick();
     void LinkClick();
     void AppendToPage();
+    void Relayout();
 
     wxHtmlWindow *m_win;
 
@@ -166,4 +168,47 @@ void HtmlWindowTestCase::AppendToPage()
 #endif // wxUSE_CLIPBOARD
 }
 
+void HtmlWindowTestCase::Relayout()
+{
+    m_win->SetPage(TEST_MARKUP);
+
+    wxHtmlContainerCell* const cell = m_win->GetInternalRepresentation();
+    CPPUNIT_ASSERT( cell );
+
+    cell->Layout(400);
+    const int height400 = cell->GetHeight();
+
+    // Relaying out at another width and then at the original one again must
+    // give exactly the same results as the initial layout, whether the
+    // intermediate results were cached or not.
+    cell->Layout(200);
+    cell->Layout(400);
+    CPPUNIT_ASSERT_EQUAL( height400, cell->GetHeight() );
+
+    // Relayout at the same width must be a no-op, i.e. keep the geometry.
+    cell->Layout(400);
+    CPPUNIT_ASSERT_EQUAL( height400, cell->GetHeight() );
+
+    // The same must hold for pages containing tables, which use their own
+    // layout algorithm with its own caching.
+    m_win->SetPage("<html><body><table border=1>"
+                   "<tr><td>a</td><td>some longer text</td></tr>"
+                   "<tr><td rowspan=2>b</td><td>c</td></tr>"
+                   "<tr><td>d</td></tr>"
+                   "</table></body></html>");
+
+    wxHtmlContainerCell* const tableCell = m_win->GetInternalRepresentation();
+    CPPUNIT_ASSERT( tableCell );
+
+    tableCell->Layout(400);
+    const int tableHeight400 = tableCell->GetHeight();
+
+    tableCell->Layout(200);
+    tableCell->Layout(400);
+    CPPUNIT_ASSERT_EQUAL( tableHeight400, tableCell->GetHeight() );
+
+    tableCell->Layout(400);
+    CPPUNIT_ASSERT_EQUAL( tableHeight400, tableCell->GetHeight() );
+}
+
 #endif //wxUSE_HTML
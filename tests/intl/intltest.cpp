@@ -18,6 +18,8 @@
 #endif // WX_PRECOMP
 
 #include "wx/intl.h"
+#include "wx/scopedptr.h"
+#include "wx/translation.h"
 #include "wx/uilocale.h"
 
 #if wxUSE_INTL
@@ -238,6 +240,29 @@ TEST_CASE("wxLocale::Default", "[locale]")
     REQUIRE( loc.Init(wxLANGUAGE_DEFAULT, wxLOCALE_DONT_LOAD_DEFAULT) );
 }
 
+TEST_CASE("wxMsgCatalog::Lookup", "[translations]")
+{
+    // This catalog is in UTF-8 and has a hash table, so this exercises the
+    // direct lookup in the catalog data used in this case.
+    wxScopedPtr<wxMsgCatalog>
+        cat(wxMsgCatalog::CreateFromFile("./intl/fr/internat.mo", "internat"));
+    REQUIRE( cat );
+
+    const wxString* s = cat->GetString("&Open bogus file");
+    REQUIRE( s );
+    CHECK( *s == wxString::FromUTF8("&Ouvrir un fichier") );
+
+    // Looking up the same string again must return the cached copy.
+    CHECK( cat->GetString("&Open bogus file") == s );
+
+    CHECK( !cat->GetString("No such string in the catalog") );
+
+    // The catalog header is accessible as the translation of "".
+    s = cat->GetString(wxString());
+    REQUIRE( s );
+    CHECK( s->Contains("Project-Id-Version") );
+}
+
 #endif // wxUSE_UNICODE
 
 // Under MSW and macOS all the locales used below should be supported, but
@@ -185,6 +185,59 @@ TEST_CASE("RowHeightCacheTestCase::TestRowRangesCleanUp2", "[dataview][heightcac
     CHECK(rr.GetSize() == 1);
 }
 
+// ----------------------------------------------------------------------------
+// TestRowRangesRemoveSingle
+// ----------------------------------------------------------------------------
+TEST_CASE("RowHeightCacheTestCase::TestRowRangesRemoveSingle", "[dataview][heightcache]")
+{
+    RowRanges rr;
+    for (unsigned int i = 0; i < 10; i++)
+    {
+        rr.Add(i);
+    }
+
+    rr.RemoveSingle(5); // splits [0..10) into [0..5) and [6..10)
+
+    CHECK(rr.GetSize() == 2);
+    CHECK(rr.Has(5) == false);
+    CHECK(rr.Has(4) == true);
+    CHECK(rr.Has(6) == true);
+    CHECK(rr.CountAll() == 9);
+    CHECK(rr.CountTo(5) == 5);
+    CHECK(rr.CountTo(6) == 5);
+    CHECK(rr.CountTo(10) == 9);
+
+    rr.RemoveSingle(6); // removes the first row of [6..10)
+
+    CHECK(rr.GetSize() == 2);
+    CHECK(rr.Has(6) == false);
+    CHECK(rr.CountAll() == 8);
+
+    rr.RemoveSingle(4); // removes the last row of [0..5)
+
+    CHECK(rr.GetSize() == 2);
+    CHECK(rr.Has(4) == false);
+    CHECK(rr.CountAll() == 7);
+
+    rr.RemoveSingle(5); // row 5 is not contained -> does nothing
+
+    CHECK(rr.GetSize() == 2);
+    CHECK(rr.CountAll() == 7);
+
+    rr.Add(4);
+    rr.Add(5);
+    rr.Add(6); // everything is merged back into one range
+
+    CHECK(rr.GetSize() == 1);
+    CHECK(rr.CountAll() == 10);
+
+    rr.Remove(1);
+    rr.RemoveSingle(0); // removing the only row of a range discards it
+
+    CHECK(rr.GetSize() == 0);
+    CHECK(rr.CountAll() == 0);
+}
+
 // ----------------------------------------------------------------------------
 // TestHeightCache
 // ----------------------------------------------------------------------------
@@ -270,3 +323,43 @@ TEST_CASE("RowHeightCacheTestCase::TestHeightCache", "[dataview][heightcache]")
     CHECK(hc.GetLineAt(22180, row) == false);
     CHECK(row == 666);
 }
+
+// ----------------------------------------------------------------------------
+// TestHeightCacheInvalidateRow
+// ----------------------------------------------------------------------------
+TEST_CASE("RowHeightCacheTestCase::TestHeightCacheInvalidateRow", "[dataview][heightcache]")
+{
+    HeightCache hc;
+
+    for (unsigned int i = 0; i < 100; i++)
+    {
+        hc.Put(i, 22);
+    }
+
+    hc.InvalidateRow(50); // Forget row 50 but keep all the rows after it
+
+    int start = 0;
+    int height = 0;
+    unsigned int row = 666;
+
+    CHECK(hc.GetLineHeight(50, height) == false);
+
+    // the heights of the following rows are still cached...
+    CHECK(hc.GetLineHeight(51, height) == true);
+    CHECK(height == 22);
+
+    // ... but their start can't be known until the gap is filled again
+    CHECK(hc.GetLineStart(51, start) == false);
+    CHECK(hc.GetLineAt(51 * 22, row) == false);
+
+    CHECK(hc.GetLineStart(49, start) == true);
+    CHECK(start == 49 * 22);
+
+    hc.Put(50, 42); // the changed row turned out to be higher
+
+    CHECK(hc.GetLineStart(51, start) == true);
+    CHECK(start == 50 * 22 + 42);
+
+    CHECK(hc.GetLineAt(50 * 22 + 42, row) == true);
+    CHECK(row == 51);
+}
@@ -46,6 +46,8 @@ private:
         CPPUNIT_TEST( Int64RW );
 #endif
         CPPUNIT_TEST( NaNRW );
+        CPPUNIT_TEST( FloatArrayRW );
+        CPPUNIT_TEST( RawRW );
         CPPUNIT_TEST( PseudoTest_UseBigEndian );
         CPPUNIT_TEST( FloatRW );
         CPPUNIT_TEST( DoubleRW );
@@ -74,6 +76,8 @@ private:
     void Int64RW();
 #endif
     void NaNRW();
+    void FloatArrayRW();
+    void RawRW();
 
     void PseudoTest_UseBigEndian() { ms_useBigEndianFormat = true; }
     void PseudoTest_UseLittleEndian() { ms_useBigEndianFormat = false; }
@@ -311,4 +315,95 @@ void DataStreamTestCase::NaNRW()
     //TODO?
 }
 
+void DataStreamTestCase::FloatArrayRW()
+{
+    static const double doubles[] = { 0.0, 1.0, -1.0, 1e100, -3.14, 1.0/3.0 };
+    static const float floats[] = { 0.0f, 1.0f, -1.0f, 2.5e10f, -3.14f };
+
+    // check both byte orders to exercise the byte-swapping code paths
+    for ( int be = 0; be < 2; be++ )
+    {
+        TempFile f("mytext.dat");
+
+        {
+            wxFileOutputStream fileOut( f.GetName() );
+            wxDataOutputStream dataOut( fileOut );
+            dataOut.BigEndianOrdered(be != 0);
+            dataOut.UseBasicPrecisions();
+
+            dataOut.WriteDouble(doubles, WXSIZEOF(doubles));
+            dataOut.WriteFloat(floats, WXSIZEOF(floats));
+        }
+
+        // read the values back one by one to check that the array format is
+        // compatible with the scalar one
+        {
+            wxFileInputStream fileIn( f.GetName() );
+            wxDataInputStream dataIn( fileIn );
+            dataIn.BigEndianOrdered(be != 0);
+            dataIn.UseBasicPrecisions();
+
+            for ( size_t n = 0; n < WXSIZEOF(doubles); n++ )
+                CPPUNIT_ASSERT_EQUAL( doubles[n], dataIn.ReadDouble() );
+            for ( size_t n = 0; n < WXSIZEOF(floats); n++ )
+                CPPUNIT_ASSERT_EQUAL( floats[n], dataIn.ReadFloat() );
+        }
+
+        // and also as whole blocks
+        {
+            wxFileInputStream fileIn( f.GetName() );
+            wxDataInputStream dataIn( fileIn );
+            dataIn.BigEndianOrdered(be != 0);
+            dataIn.UseBasicPrecisions();
+
+            double doublesIn[WXSIZEOF(doubles)];
+            dataIn.ReadDouble(doublesIn, WXSIZEOF(doublesIn));
+            for ( size_t n = 0; n < WXSIZEOF(doubles); n++ )
+                CPPUNIT_ASSERT_EQUAL( doubles[n], doublesIn[n] );
+
+            float floatsIn[WXSIZEOF(floats)];
+            dataIn.ReadFloat(floatsIn, WXSIZEOF(floatsIn));
+            for ( size_t n = 0; n < WXSIZEOF(floats); n++ )
+                CPPUNIT_ASSERT_EQUAL( floats[n], floatsIn[n] );
+        }
+    }
+}
+
+void DataStreamTestCase::RawRW()
+{
+    // a fixed-layout record as could be used with the raw API
+    struct Record
+    {
+        wxUint32 n;
+        wxUint32 flags;
+        double d;
+    };
+
+    Record records[3];
+    memset(records, 0, sizeof(records));
+    for ( size_t n = 0; n < WXSIZEOF(records); n++ )
+    {
+        records[n].n = (wxUint32)n;
+        records[n].flags = 0xdeadbeef;
+        records[n].d = 3.14*n;
+    }
+
+    TempFile f("mytext.dat");
+
+    {
+        wxFileOutputStream fileOut( f.GetName() );
+        wxDataOutputStream dataOut( fileOut );
+
+        dataOut.WriteRaw(records, sizeof(records));
+    }
+
+    wxFileInputStream fileIn( f.GetName() );
+    wxDataInputStream dataIn( fileIn );
+
+    Record recordsIn[WXSIZEOF(records)];
+    dataIn.ReadRaw(recordsIn, sizeof(recordsIn));
+
+    CPPUNIT_ASSERT( memcmp(records, recordsIn, sizeof(records)) == 0 );
+}
+
 
@@ -56,6 +56,7 @@ private:
         CPPUNIT_TEST( ReadUTF16 );
 #endif // wxUSE_UNICODE
         CPPUNIT_TEST( ReadBig );
+        CPPUNIT_TEST( ReadMapped );
     CPPUNIT_TEST_SUITE_END();
 
     void ReadEmpty();
@@ -73,6 +74,7 @@ private:
     void ReadUTF16();
 #endif // wxUSE_UNICODE
     void ReadBig();
+    void ReadMapped();
 
     // return the name of the test file we use
     static const char *GetTestFileName() { return "textfiletest.txt"; }
@@ -335,6 +337,50 @@ void TextFileTestCase::ReadBig()
                           f[NUM_LINES - 1] );
 }
 
+void TextFileTestCase::ReadMapped()
+{
+    CreateTestFile("foo\r\nbar\nbaz\rlast line");
+
+    wxTextFile f;
+    CPPUNIT_ASSERT( f.OpenMapped(wxString::FromAscii(GetTestFileName())) );
+
+    // whether the file could really be mapped depends on the platform, but
+    // the buffer must behave in the same way in both cases
+    CPPUNIT_ASSERT_EQUAL( (size_t)4, f.GetLineCount() );
+    CPPUNIT_ASSERT_EQUAL( wxTextFileType_Dos, f.GetLineType(0) );
+    CPPUNIT_ASSERT_EQUAL( wxTextFileType_Unix, f.GetLineType(1) );
+    CPPUNIT_ASSERT_EQUAL( wxTextFileType_Mac, f.GetLineType(2) );
+    CPPUNIT_ASSERT_EQUAL( wxTextFileType_None, f.GetLineType(3) );
+
+    CPPUNIT_ASSERT_EQUAL( wxString(wxT("foo")), f.GetFirstLine() );
+    CPPUNIT_ASSERT_EQUAL( wxString(wxT("baz")), f.GetLine(2) );
+    CPPUNIT_ASSERT_EQUAL( wxString(wxT("last line")), f.GetLastLine() );
+
+    wxString all;
+    for ( wxString str = f.GetFirstLine(); !f.Eof(); str = f.GetNextLine() )
+        all += str + wxT('|');
+
+    CPPUNIT_ASSERT_EQUAL( "foo|bar|baz|last line|", all );
+
+    CPPUNIT_ASSERT( f.Close() );
+
+#if wxUSE_UNICODE
+    // check that a file with an UTF-16 BOM still works in this mode by
+    // falling back to reading it in memory
+    CreateTestFile(18,
+                   "\xff\xfe"
+                   "\x1f\x04\x0d\x00\x0a\x00"
+                   "\x40\x04\x38\x04\x32\x04\x35\x04\x42\x04");
+
+    CPPUNIT_ASSERT( f.OpenMapped(wxString::FromAscii(GetTestFileName())) );
+    CPPUNIT_ASSERT( !f.IsMapped() );
+    CPPUNIT_ASSERT_EQUAL( (size_t)2, f.GetLineCount() );
+#ifdef wxHAVE_U_ESCAPE
+    CPPUNIT_ASSERT_EQUAL( wxString(L"\u041f"), f.GetFirstLine() );
+#endif // wxHAVE_U_ESCAPE
+#endif // wxUSE_UNICODE
+}
+
 #ifdef __LINUX__
 
 // Check if using wxTextFile with special files, whose reported size doesn't
@@ -226,6 +226,7 @@ public:
 private:
     void ParseParams(const wxCmdLineParser& cmdline);
     void CompileRes();
+    void MakePackageBinary();
     wxArrayString PrepareTempFiles();
     void FindFilesInXML(wxXmlNode *node, wxArrayString& flist, const wxString& inputPath);
 
@@ -241,7 +242,7 @@ private:
 
     bool Validate();
 
-    bool flagVerbose, flagCPP, flagPython, flagGettext, flagValidate, flagValidateOnly;
+    bool flagVerbose, flagCPP, flagPython, flagBinary, flagGettext, flagValidate, flagValidateOnly;
     wxString parOutput, parFuncname, parOutputPath, parSchemaFile;
     wxArrayString parFiles;
     int retCode;
@@ -262,6 +263,7 @@ int XmlResApp::OnRun()
         { wxCMD_LINE_SWITCH, "e", "extra-cpp-code",  "output C++ header file with XRC derived classes" },
         { wxCMD_LINE_SWITCH, "c", "cpp-code",  "output C++ source rather than .rsc file" },
         { wxCMD_LINE_SWITCH, "p", "python-code",  "output wxPython source rather than .rsc file" },
+        { wxCMD_LINE_SWITCH, "b", "binary",  "output precompiled binary resource rather than .rsc file" },
         { wxCMD_LINE_SWITCH, "g", "gettext",  "output list of translatable strings (to stdout or file if -o used)" },
         { wxCMD_LINE_OPTION, "n", "function",  "C++/Python function name (with -c or -p) [InitXmlResource]" },
         { wxCMD_LINE_OPTION, "o", "output",  "output file [resource.xrs/cpp]" },
@@ -315,6 +317,7 @@ void XmlResApp::ParseParams(const wxCmdLineParser& cmdline)
     flagVerbose = cmdline.Found("v");
     flagCPP = cmdline.Found("c");
     flagPython = cmdline.Found("p");
+    flagBinary = cmdline.Found("b");
     flagH = flagCPP && cmdline.Found("e");
     flagValidateOnly = cmdline.Found("validate-only");
     flagValidate = flagValidateOnly || cmdline.Found("validate");
@@ -331,6 +334,8 @@ void XmlResApp::ParseParams(const wxCmdLineParser& cmdline)
                 parOutput = wxT("resource.cpp");
             else if (flagPython)
                 parOutput = wxT("resource.py");
+            else if (flagBinary)
+                parOutput = wxT("resource.xrb");
             else
                 parOutput = wxT("resource.xrs");
         }
@@ -365,6 +370,14 @@ void XmlResApp::ParseParams(const wxCmdLineParser& cmdline)
 
 void XmlResApp::CompileRes()
 {
+    if (flagBinary)
+    {
+        // the input file is converted as-is, without extracting the
+        // referenced files, so the temporary copies are not needed
+        MakePackageBinary();
+        return;
+    }
+
     wxArrayString files = PrepareTempFiles();
 
     if ( wxFileExists(parOutput) )
@@ -387,6 +400,41 @@ void XmlResApp::CompileRes()
 }
 
 
+// Converts the input file to the binary precompiled format which
+// wxXmlResource can load without parsing any XML, see
+// wxXmlDocument::SaveBinary().
+void XmlResApp::MakePackageBinary()
+{
+    if (parFiles.GetCount() != 1)
+    {
+        wxLogError(wxT("Exactly one input file must be given with -b."));
+        retCode = 1;
+        return;
+    }
+
+    if (flagVerbose)
+        wxPrintf(wxT("compiling ") + parFiles[0] + wxT("...\n"));
+
+    wxXmlDocument doc;
+    if (!doc.Load(parFiles[0]))
+    {
+        wxLogError(wxT("Error parsing file ") + parFiles[0]);
+        retCode = 1;
+        return;
+    }
+
+    if ( wxFileExists(parOutput) )
+        wxRemoveFile(parOutput);
+
+    if (!doc.SaveBinary(parOutput))
+    {
+        wxLogError(wxT("Error writing ") + parOutput);
+        retCode = 1;
+    }
+}
+
+
+
 wxString XmlResApp::GetInternalFileName(const wxString& name, const wxArrayString& flist)
 {
     wxString name2 = name;